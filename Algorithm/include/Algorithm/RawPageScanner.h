@@ -0,0 +1,168 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALGORITHM_RAWPAGESCANNER_H
+#define ALGORITHM_RAWPAGESCANNER_H
+
+/// @file   RawPageScanner.h
+/// @brief  Bulk scan of the RAWDataHeader pages of a raw data buffer
+
+#include "Headers/RAWDataHeader.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2
+{
+
+namespace algorithm
+{
+
+/// @struct RawPageDescriptor
+/// Position and origin of one raw data page, i.e. a RAWDataHeader and its
+/// payload, within a buffer
+struct RawPageDescriptor {
+  size_t offset = 0;           ///< offset of the RDH from the start of the buffer
+  uint32_t size = 0;           ///< size of the page in memory including the RDH
+  uint16_t feeId = 0;          ///< FEE identifier
+  uint8_t linkID = 0;          ///< link identifier
+  uint32_t heartbeatOrbit = 0; ///< orbit of the heartbeat frame of the page
+};
+
+struct RawHBFDescriptor {
+  size_t offset = 0;           ///< offset of the RDH of the first page from the start of the buffer
+  size_t size = 0;             ///< from the first RDH to the end of the last page
+  uint32_t nPages = 0;         ///< number of pages of the frame
+  uint16_t feeId = 0;          ///< FEE identifier
+  uint8_t linkID = 0;          ///< link identifier
+  uint32_t heartbeatOrbit = 0; ///< orbit of the heartbeat frame
+};
+
+/**
+ * Scan a buffer of consecutive raw data pages in one go and fill a
+ * descriptor for every page, in the order of the pages in the buffer.
+ *
+ * The pages are chained by the RDH field offsetToNext, the page content is
+ * given by memorySize. Only the RDHs are read, the payload is not touched
+ * and nothing is copied, so that the decoders can process the pages from
+ * the descriptors directly, e.g. grouped by link and on several threads.
+ *
+ * Like the Parser, the complete buffer must be consistent: the descriptors
+ * are only added to the target if the chain of pages ends exactly at the
+ * end of the buffer.
+ *
+ * Usage:
+ *   std::vector<o2::algorithm::RawPageDescriptor> pages;
+ *   if (o2::algorithm::scanRawPages(ptr, size, pages) < 0) {
+ *     // format error
+ *   }
+ *   for (auto const& page : pages) {
+ *     auto rdh = reinterpret_cast<const o2::header::RAWDataHeader*>(ptr + page.offset);
+ *     // decode page
+ *   }
+ *
+ * @return number of pages, 0 for an empty buffer, -1 if a page header is
+ *         inconsistent or a page is exceeding the buffer
+ */
+template <typename RDHT = o2::header::RAWDataHeader, typename InputType>
+int scanRawPages(const InputType* buffer, size_t bufferSize, std::vector<RawPageDescriptor>& pages)
+{
+  static_assert(sizeof(InputType) == 1,
+                "scanRawPages currently only supports byte type buffer");
+  if (buffer == nullptr || bufferSize == 0) {
+    return 0;
+  }
+  auto const nInitial = pages.size();
+  size_t position = 0;
+  while (position < bufferSize) {
+    if (position + sizeof(RDHT) > bufferSize) {
+      break;
+    }
+    auto const* rdh = reinterpret_cast<const RDHT*>(buffer + position);
+    // the header must be contained in the page, and the page in the
+    // memory up to the next one
+    if (rdh->headerSize < sizeof(RDHT) || rdh->memorySize < rdh->headerSize ||
+        rdh->offsetToNext < rdh->memorySize || position + rdh->memorySize > bufferSize) {
+      break;
+    }
+    RawPageDescriptor page;
+    page.offset = position;
+    page.size = rdh->memorySize;
+    page.feeId = rdh->feeId;
+    page.linkID = rdh->linkID;
+    page.heartbeatOrbit = rdh->heartbeatOrbit;
+    pages.emplace_back(page);
+    position += rdh->offsetToNext;
+  }
+
+  // the last page can be shorter than the offset to the next one, e.g. if
+  // the buffer has been cut after the last payload
+  if (position >= bufferSize && pages.size() > nInitial &&
+      pages.back().offset + pages.back().size <= bufferSize) {
+    return pages.size() - nInitial;
+  }
+
+  // format error detected, the complete block must be consistent
+  pages.resize(nInitial);
+  return -1;
+}
+
+/**
+ * Split a buffer of consecutive raw data pages, e.g. a readout superpage, into
+ * its heartbeat frames: the runs of consecutive pages of the same link and
+ * heartbeat orbit. A descriptor is a view of the frame in the buffer, with the
+ * pages chained as in the buffer, nothing is copied.
+ *
+ * Usage:
+ *   std::vector<o2::algorithm::RawHBFDescriptor> frames;
+ *   o2::algorithm::scanHeartbeatFrames(ptr, size, frames);
+ *   for (auto const& frame : frames) {
+ *     // decode the pages in [ptr + frame.offset, ptr + frame.offset + frame.size)
+ *   }
+ *
+ * @return number of frames, 0 for an empty buffer, -1 if the pages are
+ *         inconsistent (see scanRawPages), nothing is added in that case
+ */
+template <typename RDHT = o2::header::RAWDataHeader, typename InputType>
+int scanHeartbeatFrames(const InputType* buffer, size_t bufferSize, std::vector<RawHBFDescriptor>& frames)
+{
+  // the page descriptors are kept from call to call to avoid the allocations
+  thread_local std::vector<RawPageDescriptor> pages;
+  pages.clear();
+  if (scanRawPages<RDHT>(buffer, bufferSize, pages) < 0) {
+    return -1;
+  }
+  auto const nInitial = frames.size();
+  for (auto const& page : pages) {
+    if (frames.size() > nInitial) {
+      auto& frame = frames.back();
+      if (frame.heartbeatOrbit == page.heartbeatOrbit && frame.feeId == page.feeId && frame.linkID == page.linkID) {
+        frame.size = page.offset + page.size - frame.offset;
+        frame.nPages++;
+        continue;
+      }
+    }
+    RawHBFDescriptor frame;
+    frame.offset = page.offset;
+    frame.size = page.size;
+    frame.nPages = 1;
+    frame.feeId = page.feeId;
+    frame.linkID = page.linkID;
+    frame.heartbeatOrbit = page.heartbeatOrbit;
+    frames.emplace_back(frame);
+  }
+  return frames.size() - nInitial;
+}
+
+} // namespace algorithm
+
+} // namespace o2
+
+#endif // ALGORITHM_RAWPAGESCANNER_H
@@ -0,0 +1,130 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+//  @file   test_RawPageScanner.cxx
+//  @brief  Test program for the bulk scan of raw data pages
+
+#define BOOST_TEST_MODULE Algorithm RawPageScanner test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "../include/Algorithm/RawPageScanner.h"
+#include "Headers/RAWDataHeader.h"
+#include <cstring>
+#include <vector>
+
+using RDH = o2::header::RAWDataHeader;
+using RawPageDescriptor = o2::algorithm::RawPageDescriptor;
+using RawHBFDescriptor = o2::algorithm::RawHBFDescriptor;
+
+// append a page with the given payload size, padded to the offset to next
+void addPage(std::vector<unsigned char>& buffer, uint16_t feeId, uint8_t linkID, size_t payloadSize, size_t pageSize,
+             uint32_t orbit = 0)
+{
+  RDH rdh;
+  rdh.feeId = feeId;
+  rdh.linkID = linkID;
+  rdh.heartbeatOrbit = orbit;
+  rdh.memorySize = sizeof(RDH) + payloadSize;
+  rdh.offsetToNext = pageSize;
+  auto position = buffer.size();
+  buffer.resize(position + pageSize, 0);
+  std::memcpy(buffer.data() + position, &rdh, sizeof(RDH));
+  std::memset(buffer.data() + position + sizeof(RDH), linkID, payloadSize);
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_pages)
+{
+  std::vector<unsigned char> buffer;
+  addPage(buffer, 0x10, 0, 400, 8192);
+  addPage(buffer, 0x10, 1, 8192 - sizeof(RDH), 8192);
+  addPage(buffer, 0x21, 2, 0, 64);
+  addPage(buffer, 0x21, 0, 100, 1024);
+
+  std::vector<RawPageDescriptor> pages;
+  BOOST_REQUIRE_EQUAL(o2::algorithm::scanRawPages(buffer.data(), buffer.size(), pages), 4);
+  BOOST_REQUIRE_EQUAL(pages.size(), 4);
+  std::vector<size_t> offsets{ 0, 8192, 16384, 16448 };
+  std::vector<uint32_t> sizes{ sizeof(RDH) + 400, 8192, sizeof(RDH), sizeof(RDH) + 100 };
+  std::vector<uint8_t> links{ 0, 1, 2, 0 };
+  for (size_t i = 0; i < pages.size(); i++) {
+    BOOST_CHECK_EQUAL(pages[i].offset, offsets[i]);
+    BOOST_CHECK_EQUAL(pages[i].size, sizes[i]);
+    BOOST_CHECK_EQUAL(pages[i].linkID, links[i]);
+    BOOST_CHECK_EQUAL(pages[i].feeId, i < 2 ? 0x10 : 0x21);
+  }
+
+  // the last page may end right after its payload
+  buffer.resize(buffer.size() - 1024 + sizeof(RDH) + 100);
+  BOOST_CHECK_EQUAL(o2::algorithm::scanRawPages(buffer.data(), buffer.size(), pages), 4);
+  BOOST_CHECK_EQUAL(pages.size(), 8);
+
+  // empty buffer
+  BOOST_CHECK_EQUAL(o2::algorithm::scanRawPages(buffer.data(), 0, pages), 0);
+  BOOST_CHECK_EQUAL(pages.size(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_pages_format_error)
+{
+  std::vector<unsigned char> buffer;
+  addPage(buffer, 0x10, 0, 400, 8192);
+  addPage(buffer, 0x10, 1, 400, 8192);
+  std::vector<RawPageDescriptor> pages;
+
+  // truncated payload of the last page
+  BOOST_CHECK_EQUAL(o2::algorithm::scanRawPages(buffer.data(), 8192 + sizeof(RDH) + 10, pages), -1);
+  BOOST_CHECK(pages.empty());
+
+  // a zero offset to the next page would loop forever
+  auto rdh = reinterpret_cast<RDH*>(buffer.data() + 8192);
+  rdh->offsetToNext = 0;
+  BOOST_CHECK_EQUAL(o2::algorithm::scanRawPages(buffer.data(), buffer.size(), pages), -1);
+  BOOST_CHECK(pages.empty());
+
+  // a page exceeding the buffer
+  rdh->offsetToNext = 8192;
+  rdh->memorySize = 8193;
+  BOOST_CHECK_EQUAL(o2::algorithm::scanRawPages(buffer.data(), buffer.size(), pages), -1);
+  BOOST_CHECK(pages.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_heartbeat_frames)
+{
+  // a superpage of one link with three frames, the second of three pages
+  std::vector<unsigned char> buffer;
+  addPage(buffer, 0x10, 3, 400, 8192, 100);
+  addPage(buffer, 0x10, 3, 8192 - sizeof(RDH), 8192, 101);
+  addPage(buffer, 0x10, 3, 8192 - sizeof(RDH), 8192, 101);
+  addPage(buffer, 0x10, 3, 100, 8192, 101);
+  addPage(buffer, 0x10, 3, 0, 64, 102);
+
+  std::vector<RawHBFDescriptor> frames;
+  BOOST_REQUIRE_EQUAL(o2::algorithm::scanHeartbeatFrames(buffer.data(), buffer.size(), frames), 3);
+  BOOST_REQUIRE_EQUAL(frames.size(), 3);
+  std::vector<size_t> offsets{ 0, 8192, 32768 };
+  std::vector<size_t> sizes{ sizeof(RDH) + 400, 2 * 8192 + sizeof(RDH) + 100, sizeof(RDH) };
+  std::vector<uint32_t> nPages{ 1, 3, 1 };
+  for (size_t i = 0; i < frames.size(); i++) {
+    BOOST_CHECK_EQUAL(frames[i].offset, offsets[i]);
+    BOOST_CHECK_EQUAL(frames[i].size, sizes[i]);
+    BOOST_CHECK_EQUAL(frames[i].nPages, nPages[i]);
+    BOOST_CHECK_EQUAL(frames[i].heartbeatOrbit, 100 + i);
+    BOOST_CHECK_EQUAL(frames[i].linkID, 3);
+  }
+
+  // the same orbit on another link is another frame
+  addPage(buffer, 0x10, 4, 0, 64, 102);
+  frames.clear();
+  BOOST_CHECK_EQUAL(o2::algorithm::scanHeartbeatFrames(buffer.data(), buffer.size(), frames), 4);
+
+  // inconsistent pages leave the frames untouched
+  BOOST_CHECK_EQUAL(o2::algorithm::scanHeartbeatFrames(buffer.data(), 8192 + sizeof(RDH) + 10, frames), -1);
+  BOOST_CHECK_EQUAL(frames.size(), 4);
+}
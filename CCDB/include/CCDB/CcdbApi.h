@@ -20,6 +20,7 @@
 #include <memory>
 #include <iostream>
 #include <map>
+#include <vector>
 #include <curl/curl.h>
 #include <TObject.h>
 
@@ -44,6 +45,9 @@ class CcdbApi //: public DatabaseInterface
   /// \brief Default destructor
   virtual ~CcdbApi();
 
+  CcdbApi(const CcdbApi&) = delete;
+  CcdbApi& operator=(const CcdbApi&) = delete;
+
   /**
    * Initialize connection to CCDB
    *
@@ -51,6 +55,40 @@ class CcdbApi //: public DatabaseInterface
    */
   void init(std::string host);
 
+  /**
+   * Keep the retrieved objects in memory, together with their validity interval, such that
+   * the objects valid for the requested timestamp are retrieved again without any network access.
+   * The objects are still deserialized for each retrieval, the caller owns the returned object.
+   * The in-memory cache is active by default.
+   *
+   * @param active Whether the in-memory cache is used.
+   */
+  void setInMemoryCache(bool active) { mInMemoryCache = active; }
+
+  /**
+   * Store the retrieved objects in a local directory, e.g. shared by all the processes of a node.
+   * There is one file per object and validity interval, the objects valid for the requested timestamp
+   * are read there instead of the server. This cache is also activated by init if the environment
+   * variable ALICEO2_CCDB_LOCALCACHE gives the directory.
+   *
+   * @param directory The cache directory, empty to deactivate the local cache.
+   * @param revalidate If true, the objects found locally are revalidated with the server (If-None-Match request
+   * with their ETag), only the unchanged objects are not downloaded again.
+   */
+  void setLocalCache(std::string directory, bool revalidate = false)
+  {
+    mLocalCacheDir = directory;
+    mRevalidateLocalCache = revalidate;
+  }
+
+  /**
+   * Use HTTP/2 for the requests, such that the concurrent retrievals of retrieveMany are multiplexed
+   * over one connection. The requests fall back to HTTP/1.1 if the server does not support it.
+   *
+   * @param active Whether HTTP/2 is requested.
+   */
+  void setHttp2(bool active) { mHttp2 = active; }
+
   /**
    * Stores an object in the CCDB
    *
@@ -74,6 +112,18 @@ class CcdbApi //: public DatabaseInterface
   TObject* retrieve(std::string path, std::map<std::string, std::string> metadata,
                     long timestamp = -1);
 
+  /**
+   * Retrieve the objects at the given paths for the given timestamp, the requests to the server being
+   * sent concurrently. The caches are used as in retrieve.
+   *
+   * @param paths The paths where the objects are to be found.
+   * @param metadata Key-values representing the metadata to filter out objects, the same for all the paths.
+   * @param timestamp Timestamp of the objects to retrieve. If omitted, current timestamp is used.
+   * @return the objects in the order of the paths, nullptr for the ones which were not found.
+   */
+  std::vector<TObject*> retrieveMany(const std::vector<std::string>& paths,
+                                     const std::map<std::string, std::string>& metadata = {}, long timestamp = -1);
+
   //    std::vector<std::string> getListOfTasksWithPublications();
   //    std::vector<std::string> getPublishedObjectNames(std::string taskName);
 
@@ -166,8 +216,82 @@ class CcdbApi //: public DatabaseInterface
    */
   void curlInit();
 
+  /// Serialized object with its validity interval, as kept in the caches
+  struct CachedObject {
+    long validFrom = 0;     ///< start of validity (ms)
+    long validUntil = 0;    ///< end of validity (ms), excluded
+    std::string etag;       ///< ETag given by the server
+    std::vector<char> blob; ///< serialized object
+    bool isValid(long timestamp) const { return validFrom <= timestamp && timestamp < validUntil; }
+  };
+
+  /// A retrieval, from the caches or the server
+  struct Retrieval {
+    enum class Source { Memory,
+                        Local,
+                        Server };
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    long timestamp = 0;
+    Source source = Source::Server;
+    std::string localDir;      ///< directory in the local cache, empty if none
+    bool haveLocal = false;    ///< an object valid at the timestamp is in the local cache
+    CachedObject local;        ///< object of the local cache
+    CachedObject object;       ///< retrieved object
+    long responseCode = -1;    ///< HTTP response code of the server
+    TObject* result = nullptr; ///< deserialized object, when found in memory
+  };
+
+  /// Look up the caches, return true if the object has to be downloaded (or revalidated)
+  bool prepareRetrieval(Retrieval& retrieval);
+  /// Handle the response of the server and fill the caches, return the deserialized object
+  TObject* completeRetrieval(Retrieval& retrieval);
+
+  /**
+   * Download an object.
+   *
+   * @param url The full url of the object.
+   * @param etag If not empty, the object is only downloaded if its ETag differs.
+   * @param object The downloaded object and its validity.
+   * @return the HTTP response code, or -1 in case of failure of the request.
+   */
+  long download(const std::string& url, const std::string& etag, CachedObject& object);
+  /// Set the options of a download on a handle, the headers list is to be freed by the caller
+  void setupDownload(CURL* handle, const std::string& url, const std::string& etag, CachedObject& object,
+                     curl_slist*& headers);
+  /// Get the HTTP response code of a finished download, the object is cleared if it was not received
+  long finishDownload(CURL* handle, CURLcode result, CachedObject& object);
+
+  /// Get an easy handle from the pool, which keeps the connections to the server alive
+  CURL* getCurlHandle();
+  /// Give a handle back to the pool
+  void releaseCurlHandle(CURL* handle);
+
+  /// Deserialize an object, which is owned by the caller.
+  TObject* deserialize(CachedObject& object, const std::string& path);
+
+  /// Key of the in-memory cache for a path and metadata
+  std::string getMemoryCacheKey(const std::string& path, const std::map<std::string, std::string>& metadata);
+  /// Directory of the local cache for a path and metadata
+  std::string getLocalCachePath(const std::string& path, const std::map<std::string, std::string>& metadata);
+  /// Find an object valid at timestamp in the local cache, return true if found
+  bool readLocalCache(const std::string& dir, long timestamp, CachedObject& object);
+  /// Store an object in the local cache
+  void writeLocalCache(const std::string& dir, const CachedObject& object);
+
   /// Base URL of the CCDB (with port)
   std::string mUrl;
+
+  bool mInMemoryCache = true;                                    ///< keep the retrieved objects in memory
+  std::map<std::string, std::vector<CachedObject>> mMemoryCache; ///< objects kept in memory, per path and metadata
+  std::string mLocalCacheDir;                                    ///< directory of the local cache, empty if none
+  bool mRevalidateLocalCache = false;                            ///< revalidate the local objects with the server
+
+  /// Maximum number of connections opened by retrieveMany
+  static constexpr long MaxParallelConnections = 8;
+  bool mHttp2 = false;                                           ///< request HTTP/2
+  std::vector<CURL*> mCurlHandles;                               ///< pool of idle easy handles
+  CURLM* mCurlMulti = nullptr;                                   ///< multi handle of retrieveMany
 };
 } // namespace ccdb
 } // namespace o2
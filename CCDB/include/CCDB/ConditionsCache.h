@@ -0,0 +1,101 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_CDB_CONDITIONSCACHE_H_
+#define ALICEO2_CDB_CONDITIONSCACHE_H_
+
+//  class  ConditionsCache                                          //
+//  cache of the serialized conditions served by the MQ server      //
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace ccdb
+{
+
+/// Thread safe cache of serialized condition objects, keyed by path and run range: a request for a run
+/// is served by the cached payload of the same path whose run range contains the run.
+/// On a miss the payload is fetched by the caller, while the concurrent requests for the same path and run
+/// wait for the result of this fetch instead of fetching it again. The least recently used payloads are
+/// evicted above the maximum size.
+class ConditionsCache
+{
+ public:
+  using Payload = std::shared_ptr<const std::vector<char>>;
+
+  /// A fetched payload and the run range in which it is valid, a negative first run meaning all the runs.
+  /// A null payload (object not found) is not cached.
+  struct Fetched {
+    Payload payload;
+    int firstRun;
+    int lastRun;
+  };
+  using Fetcher = std::function<Fetched()>;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;    // requests which fetched the payload
+    uint64_t coalesced = 0; // requests which waited for the fetch of another one
+    uint64_t evictions = 0;
+  };
+
+  explicit ConditionsCache(size_t maxBytes = 512 << 20) : mMaxBytes(maxBytes) {}
+
+  /// \return the payload of path for run, calling fetch on a miss. The exceptions of fetch are passed
+  /// to all the requests waiting for it.
+  Payload get(const std::string& path, int run, const Fetcher& fetch);
+
+  /// \return the cached payload of path for run, null if not cached
+  Payload find(const std::string& path, int run);
+
+  /// Remove all the cached payloads
+  void clear();
+
+  /// \return number of cached payloads
+  size_t size() const;
+
+  /// \return total size of the cached payloads
+  size_t getBytes() const;
+
+  Stats getStats() const;
+
+ private:
+  struct Entry {
+    int firstRun;
+    int lastRun;
+    Payload payload;
+    uint64_t lastUse;
+  };
+
+  Payload findLocked(const std::string& path, int run);
+  void insertLocked(const std::string& path, const Fetched& fetched);
+  void evictLocked();
+
+  size_t mMaxBytes;
+  size_t mBytes = 0;
+  uint64_t mUseCounter = 0;
+  Stats mStats;
+  std::map<std::string, std::vector<Entry>> mEntries;
+  std::map<std::pair<std::string, int>, std::shared_future<Payload>> mPending; // fetches in progress
+  mutable std::mutex mMutex;
+};
+} // namespace ccdb
+} // namespace o2
+
+#endif
@@ -18,8 +18,15 @@
 #ifndef ALICEO2_CDB_CONDITIONSMQSERVER_H_
 #define ALICEO2_CDB_CONDITIONSMQSERVER_H_
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "CCDB/ConditionsCache.h"
 #include "CCDB/Manager.h"
 #include "ParameterMQServer.h"
 
@@ -28,6 +35,11 @@ namespace o2
 namespace ccdb
 {
 
+/// Serves the conditions requested on the data-get channel. The serialized OCDB objects are kept in a
+/// ConditionsCache (--cache-size-mb), so that the requests of all the devices of a run for the same objects
+/// are served from memory. With a rep data-get channel the requests are answered one by one, with a router
+/// one they are answered asynchronously: the cache misses are fetched by --fetch-threads workers while the
+/// cache hits are answered immediately, and concurrent requests for the same object share one fetch.
 class ConditionsMQServer : public ParameterMQServer
 {
  public:
@@ -42,7 +54,38 @@ class ConditionsMQServer : public ParameterMQServer
  private:
   Manager* mCdbManager;
 
-  void getFromOCDB(std::string key);
+  std::unique_ptr<ConditionsCache> mCache;
+  std::mutex mManagerMutex; // the Manager is not thread safe
+
+  /// a request of a router data-get channel and its reply
+  struct Request {
+    std::vector<std::unique_ptr<FairMQMessage>> envelope; // routing frames of the requester
+    std::string key;
+    ConditionsCache::Payload payload;
+  };
+  std::vector<std::thread> mWorkers;
+  std::deque<std::unique_ptr<Request>> mRequests; // to be fetched
+  std::deque<std::unique_ptr<Request>> mReplies;  // to be sent
+  std::mutex mQueueMutex;
+  std::condition_variable mQueueCondition;
+  bool mStopWorkers = false;
+  size_t mInFlight = 0; // requests received and not replied yet
+
+  /// Split the key of a request into the path and the run of the condition
+  static void parseKey(std::string key, std::string& identifier, int& runId);
+
+  /// \return the serialized condition of key, from the cache or the OCDB, null if not found
+  ConditionsCache::Payload getFromOCDB(std::string key);
+
+  /// Fetch the condition of path for run from the OCDB and serialize it
+  ConditionsCache::Fetched fetchFromOCDB(const std::string& path, int runId);
+
+  /// Send payload, or an empty message if null, on data-get after the envelope (if any)
+  void sendReply(std::vector<std::unique_ptr<FairMQMessage>>& envelope, ConditionsCache::Payload payload);
+
+  void startWorkers(int nThreads);
+  void stopWorkers();
+  void workerLoop();
 
   /// Parses a serialized message for a data source entry
   void ParseDataSource(std::string& dataSource, const std::string& data);
@@ -14,7 +14,10 @@
 #include "CCDB/Manager.h"  // for StorageFactory, StorageParameters
 #include "Rtypes.h"   // for Bool_t, Int_t, ClassDef, kFALSE, etc
 #include "CCDB/Storage.h"  // for Storage
+#include "CCDB/IdRunRangeIndex.h" // for IdRunRangeIndex
 #include "TString.h"  // for TString
+#include <map>
+#include <string>
 
 class TFile;  // lines 8-8
 class TList;
@@ -84,6 +87,9 @@ class FileStorage : public Storage
   //	Bool_t getId(const  ConditionId& query,  ConditionId& result);
   ConditionId* getId(const ConditionId& query);
 
+  /// Index of the run ranges of the keys of a path, the current directory being the one of the path
+  const IdRunRangeIndex& getIndex(const TString& path);
+
   void queryValidFiles() override;
 
   void getEntriesForLevel0(const ConditionId& query, TList* result);
@@ -93,6 +99,8 @@ class FileStorage : public Storage
   TFile* mFile;     // FileStorage file
   Bool_t mReadOnly; // ReadOnly flag
 
+  std::map<std::string, IdRunRangeIndex> mIndices; //! indices of the paths already queried
+
   ClassDefOverride(FileStorage, 0)
 };
 
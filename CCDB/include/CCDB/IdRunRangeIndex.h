@@ -0,0 +1,118 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_CDB_IDRUNRANGEINDEX_H_
+#define ALICEO2_CDB_IDRUNRANGEINDEX_H_
+
+//  class  IdRunRangeIndex                                          //
+//  index of the run ranges of the objects stored under one path    //
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+namespace o2
+{
+namespace ccdb
+{
+
+/// Index of the identifiers (run range, version, subversion) of the objects stored under one path,
+/// such that the storages find the objects of a run range without parsing all the file (or key) names.
+/// The entries are sorted by first run, with a tree of the maximum last run over the entries:
+/// the entries with firstRun <= maxFirstRun and lastRun >= minLastRun are visited in O(log n + k).
+/// The entries can be added one by one, the tree is built again at the next query.
+class IdRunRangeIndex
+{
+ public:
+  struct Entry {
+    int firstRun;
+    int lastRun;
+    int version;
+    int subVersion;
+  };
+
+  /// Remove all the entries
+  void clear();
+
+  /// Add an entry
+  void add(const Entry& entry);
+
+  /// \return number of entries
+  size_t size() const { return mEntries.size(); }
+
+  /// Execute func on the entries containing the run range [firstRun, lastRun], as well as
+  /// on the entries without run range. A negative run range selects all the entries.
+  template <typename CALLABLE>
+  void forEachSuperset(int firstRun, int lastRun, CALLABLE&& func) const
+  {
+    if (firstRun < 0 || lastRun < 0) {
+      forEachCandidate(INT_MAX, INT_MIN, func);
+    } else {
+      forEachCandidate(firstRun, lastRun, func);
+    }
+  }
+
+  /// Execute func on the entries overlapping the run range [firstRun, lastRun], as well as
+  /// on the entries without run range. A negative run range selects all the entries.
+  template <typename CALLABLE>
+  void forEachOverlapping(int firstRun, int lastRun, CALLABLE&& func) const
+  {
+    if (firstRun < 0 || lastRun < 0) {
+      forEachCandidate(INT_MAX, INT_MIN, func);
+    } else {
+      forEachCandidate(lastRun, firstRun, func);
+    }
+  }
+
+ private:
+  /// Execute func on the entries with firstRun <= maxFirstRun and lastRun >= minLastRun,
+  /// the entries without run range being always selected
+  template <typename CALLABLE>
+  void forEachCandidate(int maxFirstRun, int minLastRun, CALLABLE& func) const
+  {
+    if (mEntries.empty()) {
+      return;
+    }
+    if (mDirty) {
+      build();
+    }
+    // the entries [0, last) start before maxFirstRun
+    auto last = std::upper_bound(mEntries.begin(), mEntries.end(), maxFirstRun,
+                                 [](int run, const Entry& entry) { return run < entry.firstRun; }) -
+                mEntries.begin();
+    visit(1, 0, mEntries.size(), last, minLastRun, func);
+  }
+
+  template <typename CALLABLE>
+  void visit(size_t node, size_t begin, size_t end, size_t last, int minLastRun, CALLABLE& func) const
+  {
+    if (begin >= last || mMaxLastRun[node] < minLastRun) {
+      return;
+    }
+    if (end - begin == 1) {
+      func(mEntries[begin]);
+      return;
+    }
+    size_t middle = (begin + end) / 2;
+    visit(2 * node, begin, middle, last, minLastRun, func);
+    visit(2 * node + 1, middle, end, last, minLastRun, func);
+  }
+
+  /// Sort the entries and build the tree of the maximum last run
+  void build() const;
+  int build(size_t node, size_t begin, size_t end) const;
+
+  mutable std::vector<Entry> mEntries;  ///< entries, sorted by first run once built
+  mutable std::vector<int> mMaxLastRun; ///< maximum last run of the entries below each node
+  mutable bool mDirty = false;          ///< entries added since the last build
+};
+}
+}
+#endif
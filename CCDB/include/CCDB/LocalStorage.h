@@ -16,7 +16,10 @@
 #include "CCDB/Manager.h"  // for StorageFactory, StorageParameters
 #include "Rtypes.h"   // for Bool_t, Int_t, ClassDef, LocalStorage::Class, etc
 #include "CCDB/Storage.h"  // for Storage
+#include "CCDB/IdRunRangeIndex.h" // for IdRunRangeIndex
 #include "TString.h"  // for TString
+#include <map>
+#include <string>
 
 class TList;
 
@@ -81,6 +84,9 @@ class LocalStorage : public Storage
   //	Bool_t getId(const  ConditionId& query,  ConditionId& result);
   ConditionId* getId(const ConditionId& query);
 
+  /// Index of the run ranges of the files of a path, nullptr if the directory does not exist
+  const IdRunRangeIndex* getIndex(const TString& path);
+
   void queryValidFiles() override;
 
   void queryValidCVMFSFiles(TString& cvmfsOcdbTag);
@@ -91,6 +97,13 @@ class LocalStorage : public Storage
 
   TString mBaseDirectory; // path of the DB folder
 
+  struct PathIndex {
+    IdRunRangeIndex index; // run ranges of the files of the path
+    Long_t modTime = -1;   // modification time of the directory when indexed
+    Long_t buildTime = -1; // time when the index was built
+  };
+  std::map<std::string, PathIndex> mIndices; //! indices of the paths already queried
+
   ClassDefOverride(LocalStorage, 0) // access class to a DataBase in a local storage
 };
 
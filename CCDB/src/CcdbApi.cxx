@@ -19,6 +19,12 @@
 #include <TMessage.h>
 #include <sstream>
 #include <CommonUtils/StringUtils.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <unistd.h>
 
 namespace o2
 {
@@ -33,6 +39,12 @@ CcdbApi::CcdbApi() : mUrl("")
 
 CcdbApi::~CcdbApi()
 {
+  for (auto handle : mCurlHandles) {
+    curl_easy_cleanup(handle);
+  }
+  if (mCurlMulti != nullptr) {
+    curl_multi_cleanup(mCurlMulti);
+  }
   curl_global_cleanup();
 }
 
@@ -42,10 +54,33 @@ void CcdbApi::curlInit()
   curl_global_init(CURL_GLOBAL_DEFAULT);
 }
 
+CURL* CcdbApi::getCurlHandle()
+{
+  if (mCurlHandles.empty()) {
+    return curl_easy_init();
+  }
+  auto handle = mCurlHandles.back();
+  mCurlHandles.pop_back();
+  return handle;
+}
+
+void CcdbApi::releaseCurlHandle(CURL* handle)
+{
+  if (handle == nullptr) {
+    return;
+  }
+  // the options are reset, the connections of the handle are kept alive for the next requests
+  curl_easy_reset(handle);
+  mCurlHandles.push_back(handle);
+}
+
 void CcdbApi::init(std::string host)
 {
   mUrl = host;
   curlInit();
+  if (auto localCacheDir = getenv("ALICEO2_CCDB_LOCALCACHE")) {
+    setLocalCache(localCacheDir);
+  }
 }
 
 void CcdbApi::store(TObject* rootObject, std::string path, std::map<std::string, std::string> metadata,
@@ -87,7 +122,7 @@ void CcdbApi::store(TObject* rootObject, std::string path, std::map<std::string,
                CURLFORM_BUFFERLENGTH, message.Length(),
                CURLFORM_END);
 
-  curl = curl_easy_init();
+  curl = getCurlHandle();
   headerlist = curl_slist_append(headerlist, buf);
   if (curl != nullptr) {
     /* what URL that receives this POST */
@@ -104,7 +139,7 @@ void CcdbApi::store(TObject* rootObject, std::string path, std::map<std::string,
     }
 
     /* always cleanup */
-    curl_easy_cleanup(curl);
+    releaseCurlHandle(curl);
 
     /* then cleanup the formpost chain */
     curl_formfree(formpost);
@@ -142,124 +177,341 @@ string CcdbApi::getFullUrlForRetrieval(const string& path, const map<string, str
   return fullUrl;
 }
 
-/**
- * Struct to store the data we will receive from the CCDB with CURL.
- */
-struct MemoryStruct {
-  char* memory;
-  unsigned int size;
-};
-
 /**
  * Callback used by CURL to store the data received from the CCDB.
- * See https://curl.haxx.se/libcurl/c/getinmemory.html
  * @param contents
  * @param size
  * @param nmemb
- * @param userp a MemoryStruct where data is stored.
+ * @param userp a std::vector<char> where data is stored.
  * @return the size of the data we received and stored at userp.
  */
 static size_t WriteMemoryCallback(void* contents, size_t size, size_t nmemb, void* userp)
 {
   size_t realsize = size * nmemb;
-  auto* mem = (struct MemoryStruct*)userp;
-
-  mem->memory = (char*)realloc(mem->memory, mem->size + realsize + 1);
-  if (mem->memory == nullptr) {
-    printf("not enough memory (realloc returned NULL)\n");
+  auto* mem = static_cast<std::vector<char>*>(userp);
+  try {
+    mem->insert(mem->end(), (char*)contents, (char*)contents + realsize);
+  } catch (std::bad_alloc& e) {
+    cerr << "memory error when getting data from CCDB" << endl;
     return 0;
   }
-
-  memcpy(&(mem->memory[mem->size]), contents, realsize);
-  mem->size += realsize;
-  mem->memory[mem->size] = 0;
-
   return realsize;
 }
 
-TObject* CcdbApi::retrieve(std::string path, std::map<std::string, std::string> metadata,
-                           long timestamp)
+void CcdbApi::setupDownload(CURL* handle, const std::string& url, const std::string& etag, CachedObject& object,
+                            curl_slist*& headers)
 {
-  // Note : based on https://curl.haxx.se/libcurl/c/getinmemory.html
-  // Thus it does not comply to our coding guidelines as it is a copy paste.
-
-  string fullUrl = getFullUrlForRetrieval(path, metadata, timestamp);
-
-  // Prepare CURL
-  CURL* curl_handle;
-  CURLcode res;
-  struct MemoryStruct chunk {
-    (char*)malloc(1) /*memory*/, 0 /*size*/
-  };
-  TObject* result = nullptr;
-
-  /* init the curl session */
-  curl_handle = curl_easy_init();
+  object = CachedObject();
 
   /* specify URL to get */
-  curl_easy_setopt(curl_handle, CURLOPT_URL, fullUrl.c_str());
+  curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
 
   /* send all data to this function  */
-  curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
+  curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
+  curl_easy_setopt(handle, CURLOPT_WRITEDATA, (void*)&object.blob);
+
+  /* the validity and ETag of the object are given in the headers */
+  size_t (*headerCallback)(char*, size_t, size_t, void*) = [](char* buffer, size_t size, size_t nitems, void* userdata) {
+    string line(buffer, size * nitems);
+    auto colon = line.find(':');
+    if (colon != string::npos) {
+      string key = line.substr(0, colon);
+      string value = line.substr(colon + 1);
+      utils::trim(key);
+      utils::trim(value);
+      std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+      auto object = static_cast<CachedObject*>(userdata);
+      try {
+        if (key == "valid-from") {
+          object->validFrom = std::stol(value);
+        } else if (key == "valid-until") {
+          object->validUntil = std::stol(value);
+        } else if (key == "etag") {
+          object->etag = value;
+        }
+      } catch (std::exception& e) {
+        cerr << "invalid header " << line << endl;
+      }
+    }
+    return size * nitems;
+  };
+  curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, headerCallback);
+  curl_easy_setopt(handle, CURLOPT_HEADERDATA, (void*)&object);
 
-  /* we pass our 'chunk' struct to the callback function */
-  curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, (void*)&chunk);
+  /* revalidation of a cached object */
+  if (!etag.empty()) {
+    headers = curl_slist_append(headers, ("If-None-Match: " + etag).c_str());
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers);
+  }
+
+  if (mHttp2) {
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2_0);
+    /* wait for a connection to multiplex on rather than opening a new one */
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+  }
 
   /* some servers don't like requests that are made without a user-agent
      field, so we provide one */
-  curl_easy_setopt(curl_handle, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+  curl_easy_setopt(handle, CURLOPT_USERAGENT, "libcurl-agent/1.0");
 
   /* if redirected , we tell libcurl to follow redirection */
-  curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1L);
-
-  /* get it! */
-  res = curl_easy_perform(curl_handle);
-
-  /* check for errors */
-  if (res != CURLE_OK) {
-    fprintf(stderr, "curl_easy_perform() failed: %s\n",
-            curl_easy_strerror(res));
-  } else {
-    /*
-     * Now, our chunk.memory points to a memory block that is chunk.size
-     * bytes big and contains the remote file.
-     */
-
-    //    printf("%lu bytes retrieved\n", (long) chunk.size);
-
-    long response_code;
-    res = curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &response_code);
-    if ((res == CURLE_OK) && (response_code != 404)) {
-      TMessage mess(kMESS_OBJECT);
-      mess.SetBuffer(chunk.memory, chunk.size, kFALSE);
-      mess.SetReadMode();
-      mess.Reset();
-      result = (TObject*)(mess.ReadObjectAny(mess.GetClass()));
-      if (result == nullptr) {
-        cerr << "couldn't retrieve the object " << path << endl;
+  curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+}
+
+long CcdbApi::finishDownload(CURL* handle, CURLcode result, CachedObject& object)
+{
+  long responseCode = -1;
+  if (result != CURLE_OK) {
+    fprintf(stderr, "curl_easy_perform() failed: %s\n", curl_easy_strerror(result));
+  } else if (curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &responseCode) != CURLE_OK) {
+    responseCode = -1;
+  }
+  if (responseCode != 200) {
+    object.blob.clear();
+  }
+  return responseCode;
+}
+
+long CcdbApi::download(const std::string& url, const std::string& etag, CachedObject& object)
+{
+  CURL* handle = getCurlHandle();
+  curl_slist* headers = nullptr;
+  setupDownload(handle, url, etag, object, headers);
+  auto responseCode = finishDownload(handle, curl_easy_perform(handle), object);
+  curl_slist_free_all(headers);
+  releaseCurlHandle(handle);
+  return responseCode;
+}
+
+TObject* CcdbApi::deserialize(CachedObject& object, const std::string& path)
+{
+  TMessage mess(kMESS_OBJECT);
+  mess.SetBuffer(object.blob.data(), object.blob.size(), kFALSE);
+  mess.SetReadMode();
+  mess.Reset();
+  auto result = (TObject*)(mess.ReadObjectAny(mess.GetClass()));
+  if (result == nullptr) {
+    cerr << "couldn't retrieve the object " << path << endl;
+  }
+  return result;
+}
+
+std::string CcdbApi::getMemoryCacheKey(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  string key = path;
+  for (auto& kv : metadata) {
+    key += "/" + kv.first + "=" + kv.second;
+  }
+  return key;
+}
+
+std::string CcdbApi::getLocalCachePath(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  // one sub-directory per path and set of metadata
+  string metadataString;
+  for (auto& kv : metadata) {
+    metadataString += kv.first + "=" + kv.second + "/";
+  }
+  stringstream dir;
+  dir << mLocalCacheDir << "/" << path << "/" << std::hex << std::hash<std::string>{}(metadataString);
+  return dir.str();
+}
+
+bool CcdbApi::readLocalCache(const std::string& dir, long timestamp, CachedObject& object)
+{
+  // the files of the objects are named <validFrom>_<validUntil>, with their ETag in <validFrom>_<validUntil>.etag
+  boost::system::error_code ec;
+  if (!boost::filesystem::is_directory(dir, ec)) {
+    return false;
+  }
+  for (boost::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+    const auto name = it->path().filename().string();
+    long validFrom = 0, validUntil = 0;
+    char extra = 0;
+    if (sscanf(name.c_str(), "%ld_%ld%c", &validFrom, &validUntil, &extra) != 2) {
+      continue; // not an object file
+    }
+    if (validFrom > timestamp || timestamp >= validUntil) {
+      continue;
+    }
+    std::ifstream file(it->path().string(), std::ios::binary | std::ios::ate);
+    if (!file) {
+      continue;
+    }
+    object.validFrom = validFrom;
+    object.validUntil = validUntil;
+    object.blob.resize(file.tellg());
+    file.seekg(0);
+    if (!file.read(object.blob.data(), object.blob.size())) {
+      continue;
+    }
+    std::ifstream etagFile(it->path().string() + ".etag");
+    object.etag.clear();
+    std::getline(etagFile, object.etag);
+    return true;
+  }
+  return false;
+}
+
+void CcdbApi::writeLocalCache(const std::string& dir, const CachedObject& object)
+{
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(dir, ec);
+  stringstream name;
+  name << dir << "/" << object.validFrom << "_" << object.validUntil;
+  // written to temporary files first and renamed, the cache can be filled by several processes at once
+  const string tmpSuffix = ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream etagFile(name.str() + ".etag" + tmpSuffix);
+    etagFile << object.etag << endl;
+  }
+  std::ofstream file(name.str() + tmpSuffix, std::ios::binary);
+  if (!file.write(object.blob.data(), object.blob.size())) {
+    cerr << "failed to write " << name.str() << " to the local CCDB cache" << endl;
+    return;
+  }
+  file.close();
+  boost::filesystem::rename(name.str() + ".etag" + tmpSuffix, name.str() + ".etag", ec);
+  boost::filesystem::rename(name.str() + tmpSuffix, name.str(), ec);
+}
+
+bool CcdbApi::prepareRetrieval(Retrieval& retrieval)
+{
+  // 1) the objects already retrieved by this process
+  if (mInMemoryCache) {
+    for (auto& object : mMemoryCache[getMemoryCacheKey(retrieval.path, retrieval.metadata)]) {
+      if (object.isValid(retrieval.timestamp)) {
+        retrieval.source = Retrieval::Source::Memory;
+        retrieval.result = deserialize(object, retrieval.path);
+        return false;
       }
-    } else {
-      cerr << "invalid URL : " << fullUrl << endl;
     }
+  }
 
-    // Print data
-    //    cout << "size : " << chunk.size << endl;
-    //    cout << "data : " << endl;
-    //    char* mem = (char*)chunk.memory;
-    //    for (int i = 0 ; i < chunk.size/4 ; i++)  {
-    //      cout << mem;
-    //      mem += 4;
-    //    }
+  // 2) the local cache
+  if (!mLocalCacheDir.empty()) {
+    retrieval.localDir = getLocalCachePath(retrieval.path, retrieval.metadata);
+    retrieval.haveLocal = readLocalCache(retrieval.localDir, retrieval.timestamp, retrieval.local);
+  }
+  if (retrieval.haveLocal && !mRevalidateLocalCache) {
+    retrieval.source = Retrieval::Source::Local;
+    retrieval.object = std::move(retrieval.local);
+    return false;
   }
 
-  /* cleanup curl stuff */
-  curl_easy_cleanup(curl_handle);
+  // 3) the server, revalidating the local object if requested
+  retrieval.source = Retrieval::Source::Server;
+  return true;
+}
 
-  free(chunk.memory);
+TObject* CcdbApi::completeRetrieval(Retrieval& retrieval)
+{
+  if (retrieval.source == Retrieval::Source::Memory) {
+    return retrieval.result;
+  }
+  auto& object = retrieval.object;
+  if (retrieval.source == Retrieval::Source::Server) {
+    if (retrieval.responseCode == 304 && retrieval.haveLocal) {
+      object = std::move(retrieval.local);
+    } else if (retrieval.responseCode == 200) {
+      if (!retrieval.localDir.empty() && object.validUntil > object.validFrom) {
+        writeLocalCache(retrieval.localDir, object);
+      }
+    } else if (retrieval.haveLocal && retrieval.responseCode < 0) {
+      cerr << "CCDB not reachable, using the local copy of " << retrieval.path << endl;
+      object = std::move(retrieval.local);
+    } else {
+      cerr << "invalid URL : " << getFullUrlForRetrieval(retrieval.path, retrieval.metadata, retrieval.timestamp)
+           << endl;
+      return nullptr;
+    }
+  }
 
+  TObject* result = deserialize(object, retrieval.path);
+  if (mInMemoryCache && result && object.validUntil > object.validFrom) {
+    mMemoryCache[getMemoryCacheKey(retrieval.path, retrieval.metadata)].emplace_back(std::move(object));
+  }
   return result;
 }
 
+TObject* CcdbApi::retrieve(std::string path, std::map<std::string, std::string> metadata,
+                           long timestamp)
+{
+  Retrieval retrieval;
+  retrieval.path = path;
+  retrieval.metadata = metadata;
+  retrieval.timestamp = timestamp < 0 ? getCurrentTimestamp() : timestamp;
+  if (prepareRetrieval(retrieval)) {
+    retrieval.responseCode = download(getFullUrlForRetrieval(path, metadata, retrieval.timestamp),
+                                      retrieval.haveLocal ? retrieval.local.etag : "", retrieval.object);
+  }
+  return completeRetrieval(retrieval);
+}
+
+std::vector<TObject*> CcdbApi::retrieveMany(const std::vector<std::string>& paths,
+                                            const std::map<std::string, std::string>& metadata, long timestamp)
+{
+  const long sanitizedTimestamp = timestamp < 0 ? getCurrentTimestamp() : timestamp;
+  std::vector<Retrieval> retrievals(paths.size());
+  std::vector<CURL*> handles(paths.size(), nullptr);
+  std::vector<curl_slist*> headers(paths.size(), nullptr);
+
+  if (mCurlMulti == nullptr) {
+    mCurlMulti = curl_multi_init();
+    curl_multi_setopt(mCurlMulti, CURLMOPT_MAX_TOTAL_CONNECTIONS, MaxParallelConnections);
+  }
+  curl_multi_setopt(mCurlMulti, CURLMOPT_PIPELINING, mHttp2 ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+
+  // the objects which are not in the caches are requested all at once
+  for (size_t i = 0; i < paths.size(); i++) {
+    auto& retrieval = retrievals[i];
+    retrieval.path = paths[i];
+    retrieval.metadata = metadata;
+    retrieval.timestamp = sanitizedTimestamp;
+    if (prepareRetrieval(retrieval)) {
+      handles[i] = getCurlHandle();
+      setupDownload(handles[i], getFullUrlForRetrieval(retrieval.path, metadata, sanitizedTimestamp),
+                    retrieval.haveLocal ? retrieval.local.etag : "", retrieval.object, headers[i]);
+      curl_multi_add_handle(mCurlMulti, handles[i]);
+    }
+  }
+
+  int running = 0;
+  do {
+    CURLMcode mc = curl_multi_perform(mCurlMulti, &running);
+    if (mc == CURLM_OK && running) {
+      mc = curl_multi_wait(mCurlMulti, nullptr, 0, 1000, nullptr);
+    }
+    if (mc != CURLM_OK) {
+      fprintf(stderr, "curl_multi failed: %s\n", curl_multi_strerror(mc));
+      break;
+    }
+  } while (running);
+
+  // the transfers which did not complete keep the response code -1
+  CURLMsg* msg = nullptr;
+  int nMessages = 0;
+  while ((msg = curl_multi_info_read(mCurlMulti, &nMessages)) != nullptr) {
+    if (msg->msg != CURLMSG_DONE) {
+      continue;
+    }
+    auto i = std::find(handles.begin(), handles.end(), msg->easy_handle) - handles.begin();
+    retrievals[i].responseCode = finishDownload(handles[i], msg->data.result, retrievals[i].object);
+  }
+
+  std::vector<TObject*> results;
+  results.reserve(paths.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    if (handles[i] != nullptr) {
+      curl_multi_remove_handle(mCurlMulti, handles[i]);
+      curl_slist_free_all(headers[i]);
+      releaseCurlHandle(handles[i]);
+    }
+    results.push_back(completeRetrieval(retrievals[i]));
+  }
+  return results;
+}
+
 size_t CurlWrite_CallbackFunc_StdString2(void* contents, size_t size, size_t nmemb, std::string* s)
 {
   size_t newLength = size * nmemb;
@@ -284,7 +536,7 @@ std::string CcdbApi::list(std::string path, bool latestOnly, std::string returnF
   fullUrl += path;
   std::string result;
 
-  curl = curl_easy_init();
+  curl = getCurlHandle();
   if (curl != nullptr) {
 
     curl_easy_setopt(curl, CURLOPT_URL, fullUrl.c_str());
@@ -302,7 +554,7 @@ std::string CcdbApi::list(std::string path, bool latestOnly, std::string returnF
       fprintf(stderr, "curl_easy_perform() failed: %s\n", curl_easy_strerror(res));
     }
     curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    releaseCurlHandle(curl);
   }
 
   return result;
@@ -343,7 +595,7 @@ void CcdbApi::deleteObject(std::string path, long timestamp)
 
   fullUrl << mUrl << "/" << path << "/" << timestampLocal;
 
-  curl = curl_easy_init();
+  curl = getCurlHandle();
   if (curl != nullptr) {
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
     curl_easy_setopt(curl, CURLOPT_URL, fullUrl.str().c_str());
@@ -353,7 +605,7 @@ void CcdbApi::deleteObject(std::string path, long timestamp)
     if (res != CURLE_OK) {
       fprintf(stderr, "curl_easy_perform() failed: %s\n", curl_easy_strerror(res));
     }
-    curl_easy_cleanup(curl);
+    releaseCurlHandle(curl);
   }
 }
 
@@ -364,7 +616,7 @@ void CcdbApi::truncate(std::string path)
   stringstream fullUrl;
   fullUrl << mUrl << "/truncate/" << path;
 
-  curl = curl_easy_init();
+  curl = getCurlHandle();
   if (curl != nullptr) {
     curl_easy_setopt(curl, CURLOPT_URL, fullUrl.str().c_str());
 
@@ -373,7 +625,7 @@ void CcdbApi::truncate(std::string path)
     if (res != CURLE_OK) {
       fprintf(stderr, "curl_easy_perform() failed: %s\n", curl_easy_strerror(res));
     }
-    curl_easy_cleanup(curl);
+    releaseCurlHandle(curl);
   }
 }
 } // namespace ccdb
@@ -0,0 +1,141 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "CCDB/ConditionsCache.h"
+
+using namespace o2::ccdb;
+
+ConditionsCache::Payload ConditionsCache::get(const std::string& path, int run, const Fetcher& fetch)
+{
+  std::promise<Payload> promise;
+  std::pair<std::string, int> key{ path, run };
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (auto payload = findLocked(path, run)) {
+      mStats.hits++;
+      return payload;
+    }
+    auto pending = mPending.find(key);
+    if (pending != mPending.end()) {
+      mStats.coalesced++;
+      auto future = pending->second;
+      lock.unlock();
+      return future.get();
+    }
+    mStats.misses++;
+    mPending.emplace(key, promise.get_future().share());
+  }
+
+  Fetched fetched;
+  try {
+    fetched = fetch();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPending.erase(key);
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (fetched.payload) {
+      insertLocked(path, fetched);
+    }
+    mPending.erase(key);
+  }
+  promise.set_value(fetched.payload);
+  return fetched.payload;
+}
+
+ConditionsCache::Payload ConditionsCache::find(const std::string& path, int run)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return findLocked(path, run);
+}
+
+ConditionsCache::Payload ConditionsCache::findLocked(const std::string& path, int run)
+{
+  auto iter = mEntries.find(path);
+  if (iter == mEntries.end()) {
+    return nullptr;
+  }
+  for (auto& entry : iter->second) {
+    if (entry.firstRun < 0 || (entry.firstRun <= run && run <= entry.lastRun)) {
+      entry.lastUse = ++mUseCounter;
+      return entry.payload;
+    }
+  }
+  return nullptr;
+}
+
+void ConditionsCache::insertLocked(const std::string& path, const Fetched& fetched)
+{
+  auto& entries = mEntries[path];
+  for (auto& entry : entries) {
+    // a concurrent fetch for another run of the same range
+    if (entry.firstRun == fetched.firstRun && entry.lastRun == fetched.lastRun) {
+      return;
+    }
+  }
+  entries.push_back({ fetched.firstRun, fetched.lastRun, fetched.payload, ++mUseCounter });
+  mBytes += fetched.payload->size();
+  evictLocked();
+}
+
+void ConditionsCache::evictLocked()
+{
+  // the last inserted payload is kept, even above the maximum size
+  while (mBytes > mMaxBytes) {
+    std::vector<Entry>* oldestEntries = nullptr;
+    size_t oldest = 0;
+    for (auto& e : mEntries) {
+      for (size_t i = 0; i < e.second.size(); ++i) {
+        if (!oldestEntries || e.second[i].lastUse < (*oldestEntries)[oldest].lastUse) {
+          oldestEntries = &e.second;
+          oldest = i;
+        }
+      }
+    }
+    if (!oldestEntries || (*oldestEntries)[oldest].lastUse == mUseCounter) {
+      return;
+    }
+    mBytes -= (*oldestEntries)[oldest].payload->size();
+    oldestEntries->erase(oldestEntries->begin() + oldest);
+    mStats.evictions++;
+  }
+}
+
+void ConditionsCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+  mBytes = 0;
+}
+
+size_t ConditionsCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  size_t n = 0;
+  for (auto& e : mEntries) {
+    n += e.second.size();
+  }
+  return n;
+}
+
+size_t ConditionsCache::getBytes() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mBytes;
+}
+
+ConditionsCache::Stats ConditionsCache::getStats() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mStats;
+}
@@ -23,6 +23,7 @@
 #include "CCDB/IdPath.h"
 #include "O2Device/Compatibility.h"
 #include <FairMQLogger.h>
+#include <FairMQParts.h>
 #include <FairMQPoller.h>
 
 // Google protocol buffers headers
@@ -31,6 +32,8 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+
 using namespace o2::ccdb;
 using std::endl;
 using std::cout;
@@ -59,11 +62,13 @@ void ConditionsMQServer::InitTask()
       mCdbManager->setDefaultStorage(GetOutputName().c_str());
     }
   }
+
+  mCache = std::make_unique<ConditionsCache>(size_t(fConfig->GetValue<int>("cache-size-mb")) << 20);
 }
 
-void free_tmessage(void* data, void* hint)
+void free_payload(void* data, void* hint)
 {
-  delete static_cast<TMessage*>(hint);
+  delete static_cast<ConditionsCache::Payload*>(hint);
 }
 
 void ConditionsMQServer::ParseDataSource(std::string& dataSource, const std::string& data)
@@ -93,18 +98,43 @@ void ConditionsMQServer::Run()
   std::unique_ptr<FairMQPoller> poller(
     fTransportFactory->CreatePoller(fChannels, { "data-put", "data-get", "broker-get" }));
 
+  // with a router socket the requests come with the routing frames of their requester
+  const bool asynchronous = fChannels.at("data-get").at(0).GetType() == "router";
+  if (asynchronous) {
+    startWorkers(fConfig->GetValue<int>("fetch-threads"));
+  }
+
   while (compatibility::FairMQ13<FairMQDevice>::IsRunning(this)) {
 
-    poller->Poll(-1);
+    // wake up regularly to send the replies fetched by the workers
+    poller->Poll(mInFlight ? 1 : 100);
+
+    if (asynchronous) {
+      std::deque<std::unique_ptr<Request>> replies;
+      {
+        std::lock_guard<std::mutex> lock(mQueueMutex);
+        replies.swap(mReplies);
+      }
+      for (auto& request : replies) {
+        sendReply(request->envelope, request->payload);
+        mInFlight--;
+      }
+    }
 
     if (poller->CheckInput("data-get", 0)) {
-      std::unique_ptr<FairMQMessage> input(fTransportFactory->CreateMessage());
+      FairMQParts parts;
 
-      if (Receive(input, "data-get") > 0) {
+      if (Receive(parts, "data-get") > 0 && parts.Size() > 0) {
+        auto& input = parts.At(parts.Size() - 1);
         std::string serialString(static_cast<char*>(input->GetData()), input->GetSize());
 
         //LOG(DEBUG) << "Received a GET client message: " << serialString;
 
+        std::vector<std::unique_ptr<FairMQMessage>> envelope;
+        for (int i = 0; i < parts.Size() - 1; ++i) {
+          envelope.push_back(std::move(parts.At(i)));
+        }
+
         std::string dataSource;
         ParseDataSource(dataSource, serialString);
 
@@ -113,10 +143,30 @@ void ConditionsMQServer::Run()
           std::string key;
           Deserialize(serialString, key);
 
-          getFromOCDB(key);
+          if (!asynchronous) {
+            sendReply(envelope, getFromOCDB(key));
+          } else {
+            // the hits are answered right away, the misses by the workers
+            std::string identifier;
+            int runId;
+            parseKey(key, identifier, runId);
+            if (auto payload = mCache->find(identifier, runId)) {
+              sendReply(envelope, payload);
+            } else {
+              std::lock_guard<std::mutex> lock(mQueueMutex);
+              mRequests.emplace_back(new Request{ std::move(envelope), key, nullptr });
+              mInFlight++;
+              mQueueCondition.notify_one();
+            }
+          }
         } else if (dataSource == "Riak") {
-          // No need to de-serialize, just forward message to the broker
-          fChannels.at("broker-get").at(0).Send(input);
+          if (asynchronous) {
+            LOG(ERROR) << "The Riak data source needs a rep data-get channel";
+            sendReply(envelope, nullptr);
+          } else {
+            // No need to de-serialize, just forward message to the broker
+            fChannels.at("broker-get").at(0).Send(input);
+          }
         }
       }
     }
@@ -151,37 +201,120 @@ void ConditionsMQServer::Run()
       }
     }
   }
+
+  stopWorkers();
+  auto stats = mCache->getStats();
+  LOG(INFO) << "Conditions cache: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.coalesced
+            << " coalesced requests, " << stats.evictions << " evictions, " << mCache->size() << " objects of "
+            << mCache->getBytes() << " bytes";
+}
+
+void ConditionsMQServer::sendReply(std::vector<std::unique_ptr<FairMQMessage>>& envelope, ConditionsCache::Payload payload)
+{
+  FairMQParts reply;
+  for (auto& frame : envelope) {
+    reply.AddPart(std::move(frame));
+  }
+  if (payload) {
+    // the message refers to the cached payload, which it keeps alive
+    auto hint = new ConditionsCache::Payload(payload);
+    reply.AddPart(fTransportFactory->CreateMessage(const_cast<char*>(payload->data()), payload->size(), free_payload, hint));
+  } else {
+    // an empty reply, the requests of a rep socket have to be answered
+    reply.AddPart(fTransportFactory->CreateMessage());
+  }
+  fChannels.at("data-get").at(0).Send(reply);
+}
+
+void ConditionsMQServer::startWorkers(int nThreads)
+{
+  mStopWorkers = false;
+  for (int i = 0; i < std::max(1, nThreads); ++i) {
+    mWorkers.emplace_back(&ConditionsMQServer::workerLoop, this);
+  }
+}
+
+void ConditionsMQServer::stopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(mQueueMutex);
+    mStopWorkers = true;
+  }
+  mQueueCondition.notify_all();
+  for (auto& worker : mWorkers) {
+    worker.join();
+  }
+  mWorkers.clear();
+  mRequests.clear();
+  mReplies.clear();
+  mInFlight = 0;
+}
+
+void ConditionsMQServer::workerLoop()
+{
+  while (true) {
+    std::unique_ptr<Request> request;
+    {
+      std::unique_lock<std::mutex> lock(mQueueMutex);
+      mQueueCondition.wait(lock, [this]() { return mStopWorkers || !mRequests.empty(); });
+      if (mStopWorkers) {
+        return;
+      }
+      request = std::move(mRequests.front());
+      mRequests.pop_front();
+    }
+    try {
+      request->payload = getFromOCDB(request->key);
+    } catch (std::exception& e) {
+      LOG(ERROR) << "Could not get a condition for " << request->key << ": " << e.what();
+    }
+    std::lock_guard<std::mutex> lock(mQueueMutex);
+    mReplies.push_back(std::move(request));
+  }
 }
 
-// Query OCDB for the condition
-void ConditionsMQServer::getFromOCDB(std::string key)
+void ConditionsMQServer::parseKey(std::string key, std::string& identifier, int& runId)
 {
   // Change key from i.e. "/DET/Calib/Histo/Run2008_2008_v1_s0" to (DET/Calib/Histo, 2008)
   // FIXME: This will have to be changed in the future by adapting IdPath and getObject accordingly
   std::size_t pos = key.rfind("/");
-  std::string identifier = key.substr(0, pos);
+  identifier = key.substr(0, pos);
   key.erase(0, pos + 4);
   std::size_t pos2 = key.find("_");
-  int runId = atoi(key.substr(0, pos2).c_str());
+  runId = atoi(key.substr(0, pos2).c_str());
+}
+
+// Query the cache, and on a miss the OCDB, for the condition
+ConditionsCache::Payload ConditionsMQServer::getFromOCDB(std::string key)
+{
+  std::string identifier;
+  int runId;
+  parseKey(key, identifier, runId);
 
+  auto payload = mCache->get(identifier, runId, [&]() { return fetchFromOCDB(identifier, runId); });
+  if (!payload) {
+    LOG(ERROR) << R"(Could not get a condition for ")" << identifier << R"(" and run )" << runId << "!";
+  }
+  return payload;
+}
+
+ConditionsCache::Fetched ConditionsMQServer::fetchFromOCDB(const std::string& identifier, int runId)
+{
+  std::lock_guard<std::mutex> lock(mManagerMutex);
   Condition* aCondition = nullptr;
 
   mCdbManager->setRun(runId);
   aCondition = mCdbManager->getCondition(IdPath(identifier), runId);
 
-  if (aCondition) {
-    LOG(DEBUG) << "Sending following parameter to the client:";
-    aCondition->printConditionMetaData();
-    TMessage* tmsg = new TMessage(kMESS_OBJECT);
-    tmsg->WriteObject(aCondition);
-
-    std::unique_ptr<FairMQMessage> message(
-      fTransportFactory->CreateMessage(tmsg->Buffer(), tmsg->BufferSize(), free_tmessage, tmsg));
-
-    fChannels.at("data-get").at(0).Send(message);
-  } else {
-    LOG(ERROR) << R"(Could not get a condition for ")" << key << R"(" and run )" << runId << "!";
+  if (!aCondition) {
+    return { nullptr, runId, runId };
   }
+  LOG(DEBUG) << "Serializing following parameter for the clients:";
+  aCondition->printConditionMetaData();
+  TMessage tmsg(kMESS_OBJECT);
+  tmsg.WriteObject(aCondition);
+  auto payload = std::make_shared<const std::vector<char>>(tmsg.Buffer(), tmsg.Buffer() + tmsg.BufferSize());
+  return { payload, aCondition->getId().getFirstRun(), aCondition->getId().getLastRun() };
 }
 
 ConditionsMQServer::~ConditionsMQServer()
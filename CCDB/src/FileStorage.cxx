@@ -151,62 +151,48 @@ Bool_t FileStorage::prepareId(ConditionId &id)
 {
   // prepare id (version, subVersion) of the object that will be stored (called by putCondition)
 
-  IdRunRange aIdRunRange;                         // the runRange got from filename
   IdRunRange lastIdRunRange(-1, -1);              // highest runRange found
-  Int_t aVersion, aSubVersion;                // the version subVersion got from filename
   Int_t lastVersion = 0, lastSubVersion = -1; // highest version and subVersion found
 
-  TIter iter(gDirectory->GetListOfKeys());
-  TKey *key;
+  const IdRunRangeIndex& index = getIndex(id.getPathString());
 
   if (!id.hasVersion()) { // version not specified: look for highest version & subVersion
 
-    while ((key = (TKey *) iter.Next())) { // loop on keys
-
-      const char *keyName = key->GetName();
-
-      if (!keyNameToId(keyName, aIdRunRange, aVersion, aSubVersion)) {
-        LOG(DEBUG) << "Bad keyname <" << keyName << ">!I'll skip it.";
-        continue;
-      }
+    index.forEachOverlapping(id.getFirstRun(), id.getLastRun(), [&](const IdRunRangeIndex::Entry& entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
+      Int_t aVersion = entry.version, aSubVersion = entry.subVersion;
 
       if (!aIdRunRange.isOverlappingWith(id.getIdRunRange())) {
-        continue;
+        return;
       }
       if (aVersion < lastVersion) {
-        continue;
+        return;
       }
       if (aVersion > lastVersion) {
         lastSubVersion = -1;
       }
       if (aSubVersion < lastSubVersion) {
-        continue;
+        return;
       }
       lastVersion = aVersion;
       lastSubVersion = aSubVersion;
       lastIdRunRange = aIdRunRange;
-    }
+    });
 
     id.setVersion(lastVersion);
     id.setSubVersion(lastSubVersion + 1);
 
   } else { // version specified, look for highest subVersion only
 
-    while ((key = (TKey *) iter.Next())) { // loop on the keys
+    index.forEachOverlapping(id.getFirstRun(), id.getLastRun(), [&](const IdRunRangeIndex::Entry& entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
 
-      const char *keyName = key->GetName();
-
-      if (!keyNameToId(keyName, aIdRunRange, aVersion, aSubVersion)) {
-        LOG(DEBUG) << "Bad keyname <" << keyName << ">!I'll skip it.";
-        continue;
-      }
-
-      if (aIdRunRange.isOverlappingWith(id.getIdRunRange()) && aVersion == id.getVersion() &&
-          aSubVersion > lastSubVersion) {
-        lastSubVersion = aSubVersion;
+      if (aIdRunRange.isOverlappingWith(id.getIdRunRange()) && entry.version == id.getVersion() &&
+          entry.subVersion > lastSubVersion) {
+        lastSubVersion = entry.subVersion;
         lastIdRunRange = aIdRunRange;
       }
-    }
+    });
 
     id.setSubVersion(lastSubVersion + 1);
   }
@@ -236,27 +222,22 @@ ConditionId *FileStorage::getId(const ConditionId &query)
 {
   // look for filename matching query (called by getCondition)
 
-  IdRunRange aIdRunRange;          // the runRange got from filename
-  Int_t aVersion, aSubVersion; // the version and subVersion got from filename
-
-  TIter iter(gDirectory->GetListOfKeys());
-  TKey *key;
+  const IdRunRangeIndex& index = getIndex(query.getPathString());
 
   ConditionId *result = new ConditionId();
   result->setPath(query.getPathString());
 
+  Bool_t ambiguous = kFALSE; // more than one object valid for the query
+
   if (!query.hasVersion()) { // neither version and subversion specified -> look for highest version
     // and subVersion
 
-    while ((key = (TKey *) iter.Next())) { // loop on the keys
-
-      if (!keyNameToId(key->GetName(), aIdRunRange, aVersion, aSubVersion)) {
-        continue;
-      }
-      // aIdRunRange, aVersion, aSubVersion filled from filename
+    index.forEachSuperset(query.getFirstRun(), query.getLastRun(), [&](const IdRunRangeIndex::Entry& entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
+      Int_t aVersion = entry.version, aSubVersion = entry.subVersion;
 
-      if (!aIdRunRange.isSupersetOf(query.getIdRunRange())) {
-        continue;
+      if (ambiguous || !aIdRunRange.isSupersetOf(query.getIdRunRange())) {
+        return;
       }
       // aIdRunRange contains requested run!
 
@@ -276,39 +257,34 @@ ConditionId *FileStorage::getId(const ConditionId &query)
       } else if (result->getVersion() == aVersion && result->getSubVersion() == aSubVersion) {
         LOG(ERROR) << "More than one object valid for run " << query.getFirstRun() << ", version " << aVersion << "_"
                    << aSubVersion << "!";
-
-        delete result;
-        return nullptr;
+        ambiguous = kTRUE;
       }
-    }
+    });
 
   } else if (!query.hasSubVersion()) { // version specified but not subversion -> look for highest
     // subVersion
 
     result->setVersion(query.getVersion());
 
-    while ((key = (TKey *) iter.Next())) { // loop on the keys
+    index.forEachSuperset(query.getFirstRun(), query.getLastRun(), [&](const IdRunRangeIndex::Entry& entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
+      Int_t aVersion = entry.version, aSubVersion = entry.subVersion;
 
-      if (!keyNameToId(key->GetName(), aIdRunRange, aVersion, aSubVersion)) {
-        continue;
-      }
-      // aIdRunRange, aVersion, aSubVersion filled from filename
-
-      if (!aIdRunRange.isSupersetOf(query.getIdRunRange())) {
-        continue;
+      if (ambiguous || !aIdRunRange.isSupersetOf(query.getIdRunRange())) {
+        return;
       }
       // aIdRunRange contains requested run!
 
       if (query.getVersion() != aVersion) {
-        continue;
+        return;
       }
       // aVersion is requested version!
 
       if (result->getSubVersion() == aSubVersion) {
         LOG(ERROR) << "More than one object valid for run " << query.getFirstRun() << " version " << aVersion << "_"
                    << aSubVersion << "!";
-        delete result;
-        return nullptr;
+        ambiguous = kTRUE;
+        return;
       }
       if (result->getSubVersion() < aSubVersion) {
 
@@ -317,43 +293,75 @@ ConditionId *FileStorage::getId(const ConditionId &query)
         result->setFirstRun(aIdRunRange.getFirstRun());
         result->setLastRun(aIdRunRange.getLastRun());
       }
-    }
+    });
 
   } else { // both version and subversion specified
 
-    while ((key = (TKey *) iter.Next())) { // loop on the keys
-
-      if (!keyNameToId(key->GetName(), aIdRunRange, aVersion, aSubVersion)) {
-        continue;
-      }
-      // aIdRunRange, aVersion, aSubVersion filled from filename
+    index.forEachSuperset(query.getFirstRun(), query.getLastRun(), [&](const IdRunRangeIndex::Entry& entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
+      Int_t aVersion = entry.version, aSubVersion = entry.subVersion;
 
-      if (!aIdRunRange.isSupersetOf(query.getIdRunRange())) {
-        continue;
+      if (ambiguous || !aIdRunRange.isSupersetOf(query.getIdRunRange())) {
+        return;
       }
       // aIdRunRange contains requested run!
 
       if (query.getVersion() != aVersion || query.getSubVersion() != aSubVersion) {
-        continue;
+        return;
       }
       // aVersion and aSubVersion are requested version and subVersion!
 
       if (result->getVersion() == aVersion && result->getSubVersion() == aSubVersion) {
         LOG(ERROR) << "More than one object valid for run " << query.getFirstRun() << " version " << aVersion << "_"
                    << aSubVersion << "!";
-        delete result;
-        return nullptr;
+        ambiguous = kTRUE;
+        return;
       }
       result->setVersion(aVersion);
       result->setSubVersion(aSubVersion);
       result->setFirstRun(aIdRunRange.getFirstRun());
       result->setLastRun(aIdRunRange.getLastRun());
-    }
+    });
+  }
+
+  if (ambiguous) {
+    delete result;
+    return nullptr;
   }
 
   return result;
 }
 
+const IdRunRangeIndex& FileStorage::getIndex(const TString& path)
+{
+  // get the index of the run ranges of the keys of a path, gDirectory being the directory of the path.
+  // The index is built at the first query and updated by putCondition.
+
+  auto pathIndex = mIndices.find(path.Data());
+  if (pathIndex != mIndices.end()) {
+    return pathIndex->second;
+  }
+
+  auto& index = mIndices[path.Data()];
+
+  IdRunRange aIdRunRange;          // the runRange got from keyname
+  Int_t aVersion, aSubVersion; // the version and subVersion got from keyname
+
+  TIter iter(gDirectory->GetListOfKeys());
+  TKey *key;
+
+  while ((key = (TKey *) iter.Next())) { // loop on the keys
+
+    if (!keyNameToId(key->GetName(), aIdRunRange, aVersion, aSubVersion)) {
+      continue;
+    }
+
+    index.add({ aIdRunRange.getFirstRun(), aIdRunRange.getLastRun(), aVersion, aSubVersion });
+  }
+
+  return index;
+}
+
 Condition *FileStorage::getCondition(const ConditionId &queryId)
 {
   // get  Condition from the database
@@ -568,6 +576,10 @@ Bool_t FileStorage::putCondition(Condition *entry, const char *mirrors)
   }
 
   if (result) {
+    auto pathIndex = mIndices.find(id.getPathString().Data());
+    if (pathIndex != mIndices.end()) {
+      pathIndex->second.add({ id.getFirstRun(), id.getLastRun(), id.getVersion(), id.getSubVersion() });
+    }
     LOG(INFO) << "CDB object stored into file " << mFile->GetName();
     LOG(INFO) << "TDirectory/key name: " << id.getPathString().Data() << "/" << keyname.Data();
   }
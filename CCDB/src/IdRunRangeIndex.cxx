@@ -0,0 +1,49 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+//  index of the run ranges of the objects stored under one path
+
+#include "CCDB/IdRunRangeIndex.h"
+#include <algorithm>
+
+using namespace o2::ccdb;
+
+void IdRunRangeIndex::clear()
+{
+  mEntries.clear();
+  mMaxLastRun.clear();
+  mDirty = false;
+}
+
+void IdRunRangeIndex::add(const Entry& entry)
+{
+  mEntries.push_back(entry);
+  mDirty = true;
+}
+
+void IdRunRangeIndex::build() const
+{
+  std::stable_sort(mEntries.begin(), mEntries.end(),
+                   [](const Entry& a, const Entry& b) { return a.firstRun < b.firstRun; });
+  mMaxLastRun.assign(4 * mEntries.size(), INT_MIN);
+  build(1, 0, mEntries.size());
+  mDirty = false;
+}
+
+int IdRunRangeIndex::build(size_t node, size_t begin, size_t end) const
+{
+  if (end - begin == 1) {
+    // the entries without run range contain any run
+    const auto& entry = mEntries[begin];
+    return mMaxLastRun[node] = entry.firstRun < 0 ? INT_MAX : entry.lastRun;
+  }
+  size_t middle = (begin + end) / 2;
+  return mMaxLastRun[node] = std::max(build(2 * node, begin, middle), build(2 * node + 1, middle, end));
+}
@@ -17,6 +17,7 @@
 #include <TRegexp.h>            // for TRegexp
 #include <TSystem.h>            // for TSystem, gSystem
 #include "CCDB/Condition.h"          // for Condition
+#include <ctime>                     // for time
 
 using namespace o2::ccdb;
 
@@ -125,72 +126,58 @@ Bool_t LocalStorage::prepareId(ConditionId &id)
     }
   }
 
-  const char *filename;
-  IdRunRange aIdRunRange;                         // the runRange got from filename
+  gSystem->FreeDirectory(dirPtr);
+
+  const IdRunRangeIndex *index = getIndex(id.getPathString());
+  if (!index) {
+    LOG(ERROR) << R"(Can't open directory ")" << dirName.Data() << R"("!)";
+    return kFALSE;
+  }
+
   IdRunRange lastIdRunRange(-1, -1);              // highest runRange found
-  Int_t aVersion, aSubVersion;                // the version subVersion got from filename
   Int_t lastVersion = 0, lastSubVersion = -1; // highest version and subVersion found
 
   if (!id.hasVersion()) { // version not specified: look for highest version & subVersion
 
-    while ((filename = gSystem->GetDirEntry(dirPtr))) { // loop on the files
-
-      TString aString(filename);
-      if (aString == "." || aString == "..") {
-        continue;
-      }
-
-      if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
-        LOG(DEBUG) << "Bad filename <" << filename << ">! I'll skip it.";
-        continue;
-      }
+    index->forEachOverlapping(id.getFirstRun(), id.getLastRun(), [&](const IdRunRangeIndex::Entry &entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
+      Int_t aVersion = entry.version, aSubVersion = entry.subVersion;
 
       if (!aIdRunRange.isOverlappingWith(id.getIdRunRange())) {
-        continue;
+        return;
       }
       if (aVersion < lastVersion) {
-        continue;
+        return;
       }
       if (aVersion > lastVersion) {
         lastSubVersion = -1;
       }
       if (aSubVersion < lastSubVersion) {
-        continue;
+        return;
       }
       lastVersion = aVersion;
       lastSubVersion = aSubVersion;
       lastIdRunRange = aIdRunRange;
-    }
+    });
 
     id.setVersion(lastVersion);
     id.setSubVersion(lastSubVersion + 1);
 
   } else { // version specified, look for highest subVersion only
 
-    while ((filename = gSystem->GetDirEntry(dirPtr))) { // loop on the files
+    index->forEachOverlapping(id.getFirstRun(), id.getLastRun(), [&](const IdRunRangeIndex::Entry &entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
 
-      TString aString(filename);
-      if (aString == "." || aString == "..") {
-        continue;
-      }
-
-      if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
-        LOG(DEBUG) << "Bad filename <" << filename << ">!I'll skip it.";
-        continue;
-      }
-
-      if (aIdRunRange.isOverlappingWith(id.getIdRunRange()) && aVersion == id.getVersion() &&
-          aSubVersion > lastSubVersion) {
-        lastSubVersion = aSubVersion;
+      if (aIdRunRange.isOverlappingWith(id.getIdRunRange()) && entry.version == id.getVersion() &&
+          entry.subVersion > lastSubVersion) {
+        lastSubVersion = entry.subVersion;
         lastIdRunRange = aIdRunRange;
       }
-    }
+    });
 
     id.setSubVersion(lastSubVersion + 1);
   }
 
-  gSystem->FreeDirectory(dirPtr);
-
   TString lastStorage = id.getLastStorage();
   if (lastStorage.Contains(TString("grid"), TString::kIgnoreCase) && id.getSubVersion() > 0) {
     LOG(ERROR) << "GridStorage to LocalStorage Storage error! local object with version v" << id.getVersion() << "_s"
@@ -234,45 +221,31 @@ ConditionId *LocalStorage::getId(const ConditionId &query)
     return result;
   }
 
-  // otherwise browse in the local filesystem CDB storage
-  TString dirName = Form("%s/%s", mBaseDirectory.Data(), query.getPathString().Data());
-
-  void *dirPtr = gSystem->OpenDirectory(dirName);
-  if (!dirPtr) {
+  // otherwise look in the index of the local filesystem CDB storage
+  const IdRunRangeIndex *index = getIndex(query.getPathString());
+  if (!index) {
     LOG(DEBUG) << "Directory <" << (query.getPathString()).Data() << "> not found";
     LOG(DEBUG) << "in DB folder " << mBaseDirectory.Data();
     return nullptr;
   }
 
-  const char *filename;
   ConditionId *result = new ConditionId();
   result->setPath(query.getPathString());
 
-  IdRunRange aIdRunRange;          // the runRange got from filename
-  Int_t aVersion, aSubVersion; // the version and subVersion got from filename
+  Bool_t ambiguous = kFALSE; // more than one object valid for the query
 
   if (!query.hasVersion()) { // neither version and subversion specified -> look for highest version
     // and subVersion
 
-    while ((filename = gSystem->GetDirEntry(dirPtr))) { // loop on files
-
-      TString aString(filename);
-      if (aString.BeginsWith('.')) {
-        continue;
-      }
-
-      if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
-        continue;
-      }
-      // aIdRunRange, aVersion, aSubVersion filled from filename
+    index->forEachSuperset(query.getFirstRun(), query.getLastRun(), [&](const IdRunRangeIndex::Entry &entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
+      Int_t aVersion = entry.version, aSubVersion = entry.subVersion;
 
-      if (!aIdRunRange.isSupersetOf(query.getIdRunRange())) {
-        continue;
+      if (ambiguous || !aIdRunRange.isSupersetOf(query.getIdRunRange())) {
+        return;
       }
       // aIdRunRange contains requested run!
 
-      LOG(DEBUG) << "Filename " << filename << " matches\n";
-
       if (result->getVersion() < aVersion) {
         result->setVersion(aVersion);
         result->setSubVersion(aSubVersion);
@@ -289,44 +262,33 @@ ConditionId *LocalStorage::getId(const ConditionId &query)
       } else if (result->getVersion() == aVersion && result->getSubVersion() == aSubVersion) {
         LOG(ERROR) << "More than one object valid for run " << query.getFirstRun() << " version " << aVersion << "_"
                    << aSubVersion << "!";
-        gSystem->FreeDirectory(dirPtr);
-        delete result;
-        return nullptr;
+        ambiguous = kTRUE;
       }
-    }
+    });
 
   } else if (!query.hasSubVersion()) { // version specified but not subversion -> look for highest
     // subVersion
     result->setVersion(query.getVersion());
 
-    while ((filename = gSystem->GetDirEntry(dirPtr))) { // loop on files
+    index->forEachSuperset(query.getFirstRun(), query.getLastRun(), [&](const IdRunRangeIndex::Entry &entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
+      Int_t aVersion = entry.version, aSubVersion = entry.subVersion;
 
-      TString aString(filename);
-      if (aString.BeginsWith('.')) {
-        continue;
-      }
-
-      if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
-        continue;
-      }
-      // aIdRunRange, aVersion, aSubVersion filled from filename
-
-      if (!aIdRunRange.isSupersetOf(query.getIdRunRange())) {
-        continue;
+      if (ambiguous || !aIdRunRange.isSupersetOf(query.getIdRunRange())) {
+        return;
       }
       // aIdRunRange contains requested run!
 
       if (query.getVersion() != aVersion) {
-        continue;
+        return;
       }
       // aVersion is requested version!
 
       if (result->getSubVersion() == aSubVersion) {
         LOG(ERROR) << "More than one object valid for run " << query.getFirstRun() << " version " << aVersion << "_"
                    << aSubVersion << "!";
-        gSystem->FreeDirectory(dirPtr);
-        delete result;
-        return nullptr;
+        ambiguous = kTRUE;
+        return;
       }
       if (result->getSubVersion() < aSubVersion) {
 
@@ -335,46 +297,93 @@ ConditionId *LocalStorage::getId(const ConditionId &query)
         result->setFirstRun(aIdRunRange.getFirstRun());
         result->setLastRun(aIdRunRange.getLastRun());
       }
-    }
+    });
 
   } else { // both version and subversion specified
 
-    // ConditionId dataId(queryId.getPathString(), -1, -1, -1, -1);
-    // Bool_t result;
-    while ((filename = gSystem->GetDirEntry(dirPtr))) { // loop on files
-
-      TString aString(filename);
-      if (aString.BeginsWith('.')) {
-        continue;
-      }
+    Bool_t found = kFALSE;
+    index->forEachSuperset(query.getFirstRun(), query.getLastRun(), [&](const IdRunRangeIndex::Entry &entry) {
+      IdRunRange aIdRunRange(entry.firstRun, entry.lastRun);
 
-      if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
-        LOG(DEBUG) << "Could not make id from file: " << filename;
-        continue;
-      }
-      // aIdRunRange, aVersion, aSubVersion filled from filename
-
-      if (!aIdRunRange.isSupersetOf(query.getIdRunRange())) {
-        continue;
+      if (found || !aIdRunRange.isSupersetOf(query.getIdRunRange())) {
+        return;
       }
       // aIdRunRange contains requested run!
 
-      if (query.getVersion() != aVersion || query.getSubVersion() != aSubVersion) {
-        continue;
+      if (query.getVersion() != entry.version || query.getSubVersion() != entry.subVersion) {
+        return;
       }
       // aVersion and aSubVersion are requested version and subVersion!
 
-      result->setVersion(aVersion);
-      result->setSubVersion(aSubVersion);
+      result->setVersion(entry.version);
+      result->setSubVersion(entry.subVersion);
       result->setFirstRun(aIdRunRange.getFirstRun());
       result->setLastRun(aIdRunRange.getLastRun());
-      break;
+      found = kTRUE;
+    });
+  }
+
+  if (ambiguous) {
+    delete result;
+    return nullptr;
+  }
+
+  return result;
+}
+
+const IdRunRangeIndex *LocalStorage::getIndex(const TString &path)
+{
+  // get the index of the run ranges of the files of a path, (re)built when the directory was modified
+
+  TString dirName = Form("%s/%s", mBaseDirectory.Data(), path.Data());
+
+  FileStat_t dirStat;
+  if (gSystem->GetPathInfo(dirName, dirStat)) {
+    mIndices.erase(path.Data());
+    return nullptr;
+  }
+
+  // the modification time has a resolution of one second: an index built in the same second
+  // as the last modification of the directory may miss files, it is built again
+  auto &pathIndex = mIndices[path.Data()];
+  if (pathIndex.modTime == dirStat.fMtime && pathIndex.modTime < pathIndex.buildTime) {
+    return &pathIndex.index;
+  }
+
+  void *dirPtr = gSystem->OpenDirectory(dirName);
+  if (!dirPtr) {
+    mIndices.erase(path.Data());
+    return nullptr;
+  }
+
+  pathIndex.index.clear();
+  pathIndex.modTime = dirStat.fMtime;
+  pathIndex.buildTime = time(nullptr);
+
+  const char *filename;
+  IdRunRange aIdRunRange;          // the runRange got from filename
+  Int_t aVersion, aSubVersion; // the version and subVersion got from filename
+
+  while ((filename = gSystem->GetDirEntry(dirPtr))) { // loop on files
+
+    TString aString(filename);
+    if (aString.BeginsWith('.')) {
+      continue;
+    }
+
+    if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
+      LOG(DEBUG) << "Could not make id from file: " << filename;
+      continue;
     }
+
+    pathIndex.index.add({ aIdRunRange.getFirstRun(), aIdRunRange.getLastRun(), aVersion, aSubVersion });
   }
 
   gSystem->FreeDirectory(dirPtr);
 
-  return result;
+  LOG(DEBUG) << "Indexed " << pathIndex.index.size() << " files in " << dirName.Data();
+
+  return &pathIndex.index;
 }
 
 Condition *LocalStorage::getCondition(const ConditionId &queryId)
@@ -762,6 +771,15 @@ Bool_t LocalStorage::putCondition(Condition *entry, const char *mirrors)
 
   file.Close();
   if (result) {
+    // the new file is added to the index, which stays valid if it was up to date before the writing
+    auto pathIndex = mIndices.find(id.getPathString().Data());
+    if (pathIndex != mIndices.end()) {
+      pathIndex->second.index.add({ id.getFirstRun(), id.getLastRun(), id.getVersion(), id.getSubVersion() });
+      FileStat_t dirStat;
+      if (!gSystem->GetPathInfo(Form("%s/%s", mBaseDirectory.Data(), id.getPathString().Data()), dirStat)) {
+        pathIndex->second.modTime = dirStat.fMtime;
+      }
+    }
     if (!(id.getPathString().Contains("SHUTTLE/STATUS")))
       LOG(INFO) << R"(CDB object stored into file ")" << filename.Data() << R"(")";
   }
@@ -26,7 +26,9 @@ void addCustomOptions(bpo::options_description& options)
     "second-input-type", bpo::value<std::string>()->default_value("ROOT"), "Second input file type (ROOT/ASCII)")(
     "output-name", bpo::value<std::string>()->default_value(""), "Output file name")(
     "output-type", bpo::value<std::string>()->default_value("ROOT"), "Output file type")(
-    "channel-name", bpo::value<std::string>()->default_value("ROOT"), "Output channel name");
+    "channel-name", bpo::value<std::string>()->default_value("ROOT"), "Output channel name")(
+    "cache-size-mb", bpo::value<int>()->default_value(512), "Maximum size of the cached serialized conditions (MB)")(
+    "fetch-threads", bpo::value<int>()->default_value(4), "Threads fetching the conditions missing in the cache (router data-get channel)");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
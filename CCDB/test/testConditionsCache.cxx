@@ -0,0 +1,117 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CCDB ConditionsCache
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "CCDB/ConditionsCache.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace o2
+{
+namespace ccdb
+{
+namespace
+{
+ConditionsCache::Fetched makePayload(size_t size, int firstRun, int lastRun)
+{
+  return { std::make_shared<const std::vector<char>>(size, 'x'), firstRun, lastRun };
+}
+} // namespace
+
+/// \brief The payloads are found by run range
+BOOST_AUTO_TEST_CASE(ConditionsCacheRunRangeTest)
+{
+  ConditionsCache cache;
+  int fetches = 0;
+  auto fetch = [&]() {
+    fetches++;
+    return makePayload(100, 10, 19);
+  };
+  auto payload = cache.get("DET/Calib/Histo", 12, fetch);
+  BOOST_REQUIRE(payload);
+  BOOST_CHECK_EQUAL(payload->size(), 100);
+  BOOST_CHECK(cache.get("DET/Calib/Histo", 19, fetch) == payload);
+  BOOST_CHECK(cache.find("DET/Calib/Histo", 10) == payload);
+  BOOST_CHECK(!cache.find("DET/Calib/Histo", 20));
+  BOOST_CHECK(!cache.find("DET/Calib/Other", 12));
+  BOOST_CHECK_EQUAL(fetches, 1);
+
+  // not found, not cached
+  BOOST_CHECK(!cache.get("DET/Calib/Histo", 30, []() { return ConditionsCache::Fetched{ nullptr, 0, 0 }; }));
+  // valid for all the runs
+  cache.get("DET/Align/Data", 1, []() { return makePayload(10, -1, -1); });
+  BOOST_CHECK(cache.find("DET/Align/Data", 123456));
+
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK_EQUAL(cache.getBytes(), 110);
+  auto stats = cache.getStats();
+  BOOST_CHECK_EQUAL(stats.hits, 1);
+  BOOST_CHECK_EQUAL(stats.misses, 3);
+
+  BOOST_CHECK_THROW(cache.get("DET/Calib/Bad", 1, []() -> ConditionsCache::Fetched { throw std::runtime_error("backend"); }), std::runtime_error);
+  // a failed fetch is retried
+  BOOST_CHECK(cache.get("DET/Calib/Bad", 1, []() { return makePayload(1, 1, 1); }));
+}
+
+/// \brief The least recently used payloads are evicted
+BOOST_AUTO_TEST_CASE(ConditionsCacheEvictionTest)
+{
+  ConditionsCache cache(250);
+  cache.get("A", 1, []() { return makePayload(100, 1, 1); });
+  cache.get("B", 1, []() { return makePayload(100, 1, 1); });
+  cache.find("A", 1);
+  cache.get("C", 1, []() { return makePayload(100, 1, 1); });
+  BOOST_CHECK(cache.find("A", 1));
+  BOOST_CHECK(!cache.find("B", 1));
+  BOOST_CHECK(cache.find("C", 1));
+  BOOST_CHECK_EQUAL(cache.getBytes(), 200);
+  BOOST_CHECK_EQUAL(cache.getStats().evictions, 1);
+
+  // larger than the cache, kept until the next insertion
+  cache.get("D", 1, []() { return makePayload(1000, 1, 1); });
+  BOOST_CHECK(cache.find("D", 1));
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+}
+
+/// \brief Concurrent requests for the same object share one fetch
+BOOST_AUTO_TEST_CASE(ConditionsCacheCoalescingTest)
+{
+  ConditionsCache cache;
+  std::atomic<int> fetches{ 0 };
+  auto fetch = [&]() {
+    fetches++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return makePayload(100, 1, 100);
+  };
+  std::vector<ConditionsCache::Payload> payloads(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < payloads.size(); i++) {
+    threads.emplace_back([&, i]() { payloads[i] = cache.get("DET/Calib/Histo", 5, fetch); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(fetches, 1);
+  for (auto& payload : payloads) {
+    BOOST_CHECK(payload && payload == payloads[0]);
+  }
+  auto stats = cache.getStats();
+  BOOST_CHECK_EQUAL(stats.misses + stats.coalesced + stats.hits, 8);
+  BOOST_CHECK_EQUAL(stats.misses, 1);
+}
+} // namespace ccdb
+} // namespace o2
@@ -0,0 +1,67 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CCDB IdRunRangeIndex
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "CCDB/IdRunRangeIndex.h"
+#include <random>
+#include <vector>
+
+namespace o2
+{
+namespace ccdb
+{
+/// \brief Compare the entries visited by the index with a scan of all the entries
+BOOST_AUTO_TEST_CASE(IdRunRangeIndexTest)
+{
+  std::mt19937 generator(1);
+  IdRunRangeIndex index;
+  std::vector<IdRunRangeIndex::Entry> entries;
+  auto add = [&](IdRunRangeIndex::Entry entry) {
+    index.add(entry);
+    entries.push_back(entry);
+  };
+  for (int i = 0; i < 1000; i++) {
+    int firstRun = generator() % 1000;
+    add({ firstRun, firstRun + int(generator() % 50), i, 0 });
+  }
+  add({ -1, -1, 1000, 0 }); // without run range
+
+  for (int i = 0; i < 1000; i++) {
+    int firstRun = generator() % 1100;
+    int lastRun = firstRun + generator() % 5;
+    int nSuperset = 0, nOverlapping = 0;
+    index.forEachSuperset(firstRun, lastRun, [&](const IdRunRangeIndex::Entry& e) {
+      nSuperset += e.firstRun < 0 || (e.firstRun <= firstRun && e.lastRun >= lastRun);
+    });
+    index.forEachOverlapping(firstRun, lastRun, [&](const IdRunRangeIndex::Entry& e) {
+      nOverlapping += e.firstRun < 0 || (e.firstRun <= lastRun && e.lastRun >= firstRun);
+    });
+    int nSupersetScan = 0, nOverlappingScan = 0;
+    for (auto& e : entries) {
+      nSupersetScan += e.firstRun < 0 || (e.firstRun <= firstRun && e.lastRun >= lastRun);
+      nOverlappingScan += e.firstRun < 0 || (e.firstRun <= lastRun && e.lastRun >= firstRun);
+    }
+    BOOST_CHECK_EQUAL(nSuperset, nSupersetScan);
+    BOOST_CHECK_EQUAL(nOverlapping, nOverlappingScan);
+    if (i == 500) {
+      add({ 500, 600, 2000, 0 }); // the index is built again at the next query
+    }
+  }
+
+  int nAll = 0;
+  index.forEachSuperset(-1, -1, [&](const IdRunRangeIndex::Entry&) { nAll++; });
+  BOOST_CHECK_EQUAL(nAll, entries.size());
+}
+} // namespace ccdb
+} // namespace o2
@@ -29,6 +29,7 @@ constexpr float MassPionNeutral = 0.134976;
 constexpr float MassKaonCharged = 0.493677;
 constexpr float MassKaonNeutral = 0.497648;
 constexpr float MassProton = 0.938272;
+constexpr float MassLambda = 1.115683;
 constexpr float MassDeuteron = 1.875613;
 constexpr float MassTriton = 2.809250;
 constexpr float MassHelium3 = 2.809230;
@@ -15,7 +15,11 @@
 #define ALICEO2_FIELD_MAGFIELDFAST_H_
 
 #include <Rtypes.h>
+#include <array>
+#include <functional>
 #include <string>
+#include <vector>
+#include <gsl/span>
 #include "MathUtils/Cartesian3D.h"
 
 namespace o2
@@ -24,7 +28,7 @@ namespace field
 {
 // Fast polynomial parametrization of Alice magnetic field, to be used for reconstruction.
 // Solenoid part fitted by Shuto Yamasaki from AliMagWrapCheb in the |Z|<260Interface and R<500 cm
-// Dipole part: to do
+// Dipole part: optional table of the measured map on a regular grid in the forward region, interpolated trilinearly
 class MagFieldFast
 {
  public:
@@ -33,6 +37,16 @@ class MagFieldFast
   struct SolParam {
     float parBxyz[kNDim][kNPolCoefs];
   };
+  // unscaled field of the forward region beyond the solenoid parametrization at the points of a regular grid
+  struct ForwardTable {
+    int nX = 0, nY = 0, nZ = 0;       // number of grid points
+    float xMin = 0.f, yMin = 0.f, zMin = 0.f; // first grid point
+    float invStep = 0.f;              // inverse grid spacing
+    float zSolToDip = 0.f;            // points below use the dipole factor, above the solenoid one
+    float factorSol = 1.f;            // scaling of the table above zSolToDip
+    float factorDip = 1.f;            // scaling of the table below zSolToDip
+    std::vector<float> bxyz[kNDim];   // field components, x varying fastest
+  };
 
   MagFieldFast(const std::string inpFName = "");
   MagFieldFast(float factor, int nomField = 5, const std::string inpFmt = "$(O2_ROOT)/share/Common/maps/sol%dk.txt");
@@ -44,6 +58,8 @@ class MagFieldFast
   bool Field(const double xyz[3], double bxyz[3]) const;
   bool Field(const float xyz[3], float bxyz[3]) const;
   bool Field(const Point3D<float> xyz, float bxyz[3]) const;
+  int Field(int n, const float* x, const float* y, const float* z, float* bx, float* by, float* bz) const;
+  int Field(gsl::span<const Point3D<float>> xyz, gsl::span<std::array<float, 3>> bxyz) const;
   bool GetBcomp(EDim comp, const double xyz[3], double& b) const;
   bool GetBcomp(EDim comp, const float xyz[3], float& b) const;
   bool GetBcomp(EDim comp, const Point3D<float> xyz, double& b) const;
@@ -57,6 +73,19 @@ class MagFieldFast
   bool GetBz(const float xyz[3], float& bz) const { return GetBcomp(kZ, xyz, bz); }
   void setFactorSol(float v = 1.f) { mFactorSol = v; }
   float getFactorSol() const { return mFactorSol; }
+
+  // tabulate the field of the forward region |x|,|y| < xyMax, zMin < z < zMax, to be used outside of the solenoid
+  // parametrization. The unscaled field is provided by rawField, then multiplied by the solenoid factor above
+  // zSolToDip and by the dipole factor below
+  void setForwardTable(const std::function<void(const double*, double*)>& rawField, float xyMax, float zMin,
+                       float zMax, float step, float zSolToDip);
+  void setForwardFactors(float sol, float dip)
+  {
+    mForward.factorSol = sol;
+    mForward.factorDip = dip;
+  }
+  bool hasForwardTable() const { return mForward.nZ > 0; }
+  static float getSolZMax() { return kSolZMax; }
  protected:
   bool GetSegment(float x, float y, float z, int& zSeg, int& rSeg, int& quadrant) const;
   static const float kSolR2Max[kNSolRRanges]; // Rmax2 of each range
@@ -69,10 +98,12 @@ class MagFieldFast
   }
 
   float CalcPol(const float* cf, float x, float y, float z) const;
+  bool FieldForward(float x, float y, float z, float bxyz[3]) const;
 
  private:
   float mFactorSol; // scaling factor
   SolParam mSolPar[kNSolRRanges][kNSolZRanges][kNQuadrants];
+  ForwardTable mForward; //! optional table of the forward region
 
   ClassDef(MagFieldFast, 1)
 };
@@ -91,6 +122,29 @@ inline float MagFieldFast::CalcPol(const float* cf, float x, float y, float z) c
 
   return val;
 }
+
+inline bool MagFieldFast::FieldForward(float x, float y, float z, float bxyz[3]) const
+{
+  // interpolate the tabulated forward field
+  const auto& tb = mForward;
+  float fx = (x - tb.xMin) * tb.invStep, fy = (y - tb.yMin) * tb.invStep, fz = (z - tb.zMin) * tb.invStep;
+  if (!(fx >= 0.f && fy >= 0.f && fz >= 0.f && fx < tb.nX - 1 && fy < tb.nY - 1 && fz < tb.nZ - 1)) {
+    return false; // also when there is no table
+  }
+  int ix = fx, iy = fy, iz = fz;
+  float wx = fx - ix, wy = fy - iy, wz = fz - iz;
+  size_t i00 = (size_t(iz) * tb.nY + iy) * tb.nX + ix, i01 = i00 + tb.nX, i10 = i00 + size_t(tb.nX) * tb.nY,
+         i11 = i10 + tb.nX;
+  float factor = z > tb.zSolToDip ? tb.factorSol : tb.factorDip;
+  for (int c = 0; c < kNDim; c++) {
+    const float* b = tb.bxyz[c].data();
+    float v00 = b[i00] + wx * (b[i00 + 1] - b[i00]), v01 = b[i01] + wx * (b[i01 + 1] - b[i01]);
+    float v10 = b[i10] + wx * (b[i10 + 1] - b[i10]), v11 = b[i11] + wx * (b[i11 + 1] - b[i11]);
+    float v0 = v00 + wy * (v01 - v00), v1 = v10 + wy * (v11 - v10);
+    bxyz[c] = (v0 + wz * (v1 - v0)) * factor;
+  }
+  return true;
+}
 }
 }
 
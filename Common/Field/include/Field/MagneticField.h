@@ -69,8 +69,8 @@ class MagneticField : public FairField
   /// real field creation is here
   void CreateField();
 
-  /// allow fast field param
-  void AllowFastField(bool v = true);
+  /// allow fast field param, optionally with the forward region beyond the solenoid tabulated from the measured map
+  void AllowFastField(bool v = true, bool forward = false);
 
   /// Virtual methods from FairField
 
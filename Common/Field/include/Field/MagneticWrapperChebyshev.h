@@ -241,6 +241,12 @@ class MagneticWrapperChebyshev : public TNamed
     /// Finds the segment containing point xyz. If it is outside it finds the closest segment
     Int_t findDipoleSegment(const Double_t *xyz) const;
 
+    /// Same as findSolenoidSegment, but first checks the segment found by the previous call in this thread
+    Int_t findSolenoidSegmentCached(const Double_t *rpz) const;
+
+    /// Same as findDipoleSegment, but first checks the segment found by the previous call in this thread
+    Int_t findDipoleSegmentCached(const Double_t *xyz) const;
+
     static void cylindricalToCartesianCylB(const Double_t *rphiz, const Double_t *brphiz, Double_t *bxyz);
 
     static void cylindricalToCartesianCartB(const Double_t *xyz, const Double_t *brphiz, Double_t *bxyz);
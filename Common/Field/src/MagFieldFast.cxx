@@ -16,6 +16,7 @@
 #include <FairLogger.h>
 #include <TString.h>
 #include <TSystem.h>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <sstream>
@@ -109,8 +110,15 @@ bool MagFieldFast::Field(const double xyz[3], double bxyz[3]) const
 {
   // get field
   int zSeg, rSeg, quadrant;
-  if (!GetSegment(xyz[kX],xyz[kY],xyz[kZ], zSeg, rSeg, quadrant)) {
-    return false;
+  if (!GetSegment(xyz[kX], xyz[kY], xyz[kZ], zSeg, rSeg, quadrant)) {
+    float bf[kNDim];
+    if (!FieldForward(xyz[kX], xyz[kY], xyz[kZ], bf)) {
+      return false;
+    }
+    bxyz[kX] = bf[kX];
+    bxyz[kY] = bf[kY];
+    bxyz[kZ] = bf[kZ];
+    return true;
   }
   const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
   bxyz[kX] = CalcPol(par->parBxyz[kX], xyz[kX], xyz[kY], xyz[kZ]) * mFactorSol;
@@ -125,8 +133,13 @@ bool MagFieldFast::GetBcomp(EDim comp, const double xyz[3], double& b) const
 {
   // get field
   int zSeg, rSeg, quadrant;
-  if (!GetSegment(xyz[kX],xyz[kY],xyz[kZ], zSeg, rSeg, quadrant)) {
-    return false;
+  if (!GetSegment(xyz[kX], xyz[kY], xyz[kZ], zSeg, rSeg, quadrant)) {
+    float bf[kNDim];
+    if (!FieldForward(xyz[kX], xyz[kY], xyz[kZ], bf)) {
+      return false;
+    }
+    b = bf[comp];
+    return true;
   }
   const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
   b = CalcPol(par->parBxyz[comp], xyz[kX], xyz[kY], xyz[kZ]) * mFactorSol;
@@ -139,8 +152,13 @@ bool MagFieldFast::GetBcomp(EDim comp, const Point3D<float> xyz, double& b) cons
 {
   // get field
   int zSeg, rSeg, quadrant;
-  if (!GetSegment(xyz.X(),xyz.Y(),xyz.Z(), zSeg, rSeg, quadrant)) {
-    return false;
+  if (!GetSegment(xyz.X(), xyz.Y(), xyz.Z(), zSeg, rSeg, quadrant)) {
+    float bf[kNDim];
+    if (!FieldForward(xyz.X(), xyz.Y(), xyz.Z(), bf)) {
+      return false;
+    }
+    b = bf[comp];
+    return true;
   }
   const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
   b = CalcPol(par->parBxyz[comp], xyz.X(),xyz.Y(),xyz.Z()) * mFactorSol;
@@ -153,8 +171,13 @@ bool MagFieldFast::GetBcomp(EDim comp, const Point3D<float> xyz, float& b) const
 {
   // get field
   int zSeg, rSeg, quadrant;
-  if (!GetSegment(xyz.X(),xyz.Y(),xyz.Z(), zSeg, rSeg, quadrant)) {
-    return false;
+  if (!GetSegment(xyz.X(), xyz.Y(), xyz.Z(), zSeg, rSeg, quadrant)) {
+    float bf[kNDim];
+    if (!FieldForward(xyz.X(), xyz.Y(), xyz.Z(), bf)) {
+      return false;
+    }
+    b = bf[comp];
+    return true;
   }
   const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
   b = CalcPol(par->parBxyz[comp], xyz.X(),xyz.Y(),xyz.Z()) * mFactorSol;
@@ -167,8 +190,13 @@ bool MagFieldFast::GetBcomp(EDim comp, const float xyz[3], float& b) const
 {
   // get field
   int zSeg, rSeg, quadrant;
-  if (!GetSegment(xyz[kX],xyz[kY],xyz[kZ], zSeg, rSeg, quadrant)) {
-    return false;
+  if (!GetSegment(xyz[kX], xyz[kY], xyz[kZ], zSeg, rSeg, quadrant)) {
+    float bf[kNDim];
+    if (!FieldForward(xyz[kX], xyz[kY], xyz[kZ], bf)) {
+      return false;
+    }
+    b = bf[comp];
+    return true;
   }
   const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
   b = CalcPol(par->parBxyz[comp], xyz[kX], xyz[kY], xyz[kZ]) * mFactorSol;
@@ -181,8 +209,8 @@ bool MagFieldFast::Field(const float xyz[3], float bxyz[3]) const
 {
   // get field
   int zSeg, rSeg, quadrant;
-  if (!GetSegment(xyz[kX],xyz[kY],xyz[kZ], zSeg, rSeg, quadrant)) {
-    return false;
+  if (!GetSegment(xyz[kX], xyz[kY], xyz[kZ], zSeg, rSeg, quadrant)) {
+    return FieldForward(xyz[kX], xyz[kY], xyz[kZ], bxyz);
   }
   const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
   bxyz[kX] = CalcPol(par->parBxyz[kX], xyz[kX], xyz[kY], xyz[kZ]) * mFactorSol;
@@ -197,8 +225,8 @@ bool MagFieldFast::Field(const Point3D<float> xyz, float bxyz[3]) const
 {
   // get field
   int zSeg, rSeg, quadrant;
-  if (!GetSegment(xyz.X(),xyz.Y(),xyz.Z(), zSeg, rSeg, quadrant)) {
-    return false;
+  if (!GetSegment(xyz.X(), xyz.Y(), xyz.Z(), zSeg, rSeg, quadrant)) {
+    return FieldForward(xyz.X(), xyz.Y(), xyz.Z(), bxyz);
   }
   const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
   bxyz[kX] = CalcPol(par->parBxyz[kX], xyz.X(), xyz.Y(), xyz.Z()) * mFactorSol;
@@ -208,6 +236,114 @@ bool MagFieldFast::Field(const Point3D<float> xyz, float bxyz[3]) const
   return true;
 }
 
+//_______________________________________________________________________
+int MagFieldFast::Field(int n, const float* x, const float* y, const float* z, float* bx, float* by, float* bz) const
+{
+  // get field for n points given as separate arrays of coordinates, the field of points outside
+  // of the parametrization is left unchanged. Returns the number of points with the field evaluated.
+  // The segments of a block of points are found first without branching, then the polynomials
+  // of the segments are evaluated.
+  const int BlockSize = 64;
+  const float zGridSpaceInv = 1.f / (kSolZMax * 2 / kNSolZRanges);
+  const SolParam* solPar = &mSolPar[0][0][0];
+  int segment[BlockSize];
+  int nOK = 0;
+  for (int i0 = 0; i0 < n; i0 += BlockSize) {
+    const int nb = std::min(BlockSize, n - i0);
+    const float *xb = x + i0, *yb = y + i0, *zb = z + i0;
+    for (int i = 0; i < nb; i++) {
+      float rr = xb[i] * xb[i] + yb[i] * yb[i], zc = std::min(std::max(zb[i], -kSolZMax), kSolZMax);
+      int rSeg = 0;
+      for (int ir = 0; ir < kNSolRRanges; ir++) {
+        rSeg += rr >= kSolR2Max[ir];
+      }
+      int zSeg = (zc + kSolZMax) * zGridSpaceInv;
+      bool inside = zb[i] < kSolZMax && zb[i] > -kSolZMax && rSeg < kNSolRRanges;
+      segment[i] = inside ? (rSeg * kNSolZRanges + zSeg) * kNQuadrants + GetQuadrant(xb[i], yb[i]) : -1;
+    }
+    for (int i = 0; i < nb; i++) {
+      if (segment[i] < 0) {
+        float bf[kNDim];
+        if (FieldForward(xb[i], yb[i], zb[i], bf)) {
+          bx[i0 + i] = bf[kX];
+          by[i0 + i] = bf[kY];
+          bz[i0 + i] = bf[kZ];
+          nOK++;
+        }
+        continue;
+      }
+      const SolParam* par = solPar + segment[i];
+      bx[i0 + i] = CalcPol(par->parBxyz[kX], xb[i], yb[i], zb[i]) * mFactorSol;
+      by[i0 + i] = CalcPol(par->parBxyz[kY], xb[i], yb[i], zb[i]) * mFactorSol;
+      bz[i0 + i] = CalcPol(par->parBxyz[kZ], xb[i], yb[i], zb[i]) * mFactorSol;
+      nOK++;
+    }
+  }
+  return nOK;
+}
+
+//_______________________________________________________________________
+int MagFieldFast::Field(gsl::span<const Point3D<float>> xyz, gsl::span<std::array<float, 3>> bxyz) const
+{
+  // get field for the points of xyz, see the version with separate arrays of coordinates
+  const int BlockSize = 64;
+  float x[BlockSize], y[BlockSize], z[BlockSize], bx[BlockSize], by[BlockSize], bz[BlockSize];
+  int n = std::min(xyz.size(), bxyz.size()), nOK = 0;
+  for (int i0 = 0; i0 < n; i0 += BlockSize) {
+    const int nb = std::min(BlockSize, n - i0);
+    for (int i = 0; i < nb; i++) {
+      x[i] = xyz[i0 + i].X();
+      y[i] = xyz[i0 + i].Y();
+      z[i] = xyz[i0 + i].Z();
+      bx[i] = bxyz[i0 + i][kX];
+      by[i] = bxyz[i0 + i][kY];
+      bz[i] = bxyz[i0 + i][kZ];
+    }
+    nOK += Field(nb, x, y, z, bx, by, bz);
+    for (int i = 0; i < nb; i++) {
+      bxyz[i0 + i] = { bx[i], by[i], bz[i] };
+    }
+  }
+  return nOK;
+}
+
+//_______________________________________________________________________
+void MagFieldFast::setForwardTable(const std::function<void(const double*, double*)>& rawField, float xyMax,
+                                   float zMin, float zMax, float step, float zSolToDip)
+{
+  // fill the table of the forward region from the unscaled field
+  if (step <= 0.f || xyMax <= 0.f || zMax <= zMin) {
+    LOG(FATAL) << "Wrong forward field table definition: |x|,|y| < " << xyMax << ", " << zMin << " < z < " << zMax
+               << " with step " << step << FairLogger::endl;
+  }
+  auto& tb = mForward;
+  tb.nX = tb.nY = 2 * std::ceil(xyMax / step) + 1;
+  tb.nZ = std::floor((zMax - zMin) / step) + 1; // last grid point does not exceed zMax
+  tb.xMin = tb.yMin = -step * (tb.nX - 1) / 2;
+  tb.zMin = zMin;
+  tb.invStep = 1.f / step;
+  tb.zSolToDip = zSolToDip;
+  const size_t nPoints = size_t(tb.nX) * tb.nY * tb.nZ;
+  for (int c = 0; c < kNDim; c++) {
+    tb.bxyz[c].resize(nPoints);
+  }
+  size_t ip = 0;
+  for (int iz = 0; iz < tb.nZ; iz++) {
+    for (int iy = 0; iy < tb.nY; iy++) {
+      for (int ix = 0; ix < tb.nX; ix++) {
+        double xyz[3] = { tb.xMin + ix * step, tb.yMin + iy * step, tb.zMin + iz * step }, b[3];
+        rawField(xyz, b);
+        for (int c = 0; c < kNDim; c++) {
+          tb.bxyz[c][ip] = b[c];
+        }
+        ip++;
+      }
+    }
+  }
+  LOG(INFO) << "Tabulated forward field in " << tb.nX << " x " << tb.nY << " x " << tb.nZ << " points for "
+            << zMin << " < z < " << zMax << FairLogger::endl;
+}
+
 //_______________________________________________________________________
 bool MagFieldFast::GetSegment(float x, float y, float z, int& zSeg, int& rSeg, int& quadrant) const
 {
@@ -455,8 +455,10 @@ void MagneticField::setFactorSolenoid(Float_t fc)
       mMultipicativeFactorSolenoid = fc;
       break; // case kConvMap2005: mMultipicativeFactorSolenoid =  fc; break;
   }
-  if (mFastField)
+  if (mFastField) {
     mFastField->setFactorSol(getFactorSolenoid());
+    mFastField->setForwardFactors(mMultipicativeFactorSolenoid, mMultipicativeFactorDipole);
+  }
 }
 
 void MagneticField::setFactorDipole(Float_t fc)
@@ -472,6 +474,9 @@ void MagneticField::setFactorDipole(Float_t fc)
       mMultipicativeFactorDipole = fc;
       break; // case kConvMap2005: mMultipicativeFactorDipole =  fc; break;
   }
+  if (mFastField) {
+    mFastField->setForwardFactors(mMultipicativeFactorSolenoid, mMultipicativeFactorDipole);
+  }
 }
 
 Double_t MagneticField::getFactorSolenoid() const
@@ -639,11 +644,19 @@ void MagneticField::FillParContainer()
 }
 
 //_____________________________________________________________________________
-void MagneticField::AllowFastField(bool v)
+void MagneticField::AllowFastField(bool v, bool forward)
 {
   if (v) {
     if (!mFastField)
       mFastField = std::make_unique<MagFieldFast>(getFactorSolenoid(), mMapType == MagFieldParam::k2kG ? 2 : 5);
+    if (forward && mMeasuredMap && !mFastField->hasForwardTable()) {
+      // table of the unscaled map, the factors are applied as in Field
+      const float xyMax = 300., step = 10.;
+      auto rawField = [this](const double* xyz, double* b) { mMeasuredMap->Field(xyz, b); };
+      mFastField->setForwardTable(rawField, xyMax, mMeasuredMap->getMinZ() + 1., -MagFieldFast::getSolZMax() + step,
+                                  step, mDipoleOnOffFlag ? mMeasuredMap->getMinZ() : sSolenoidToDipoleZ);
+      mFastField->setForwardFactors(mMultipicativeFactorSolenoid, mMultipicativeFactorDipole);
+    }
   } else {
     mFastField.reset(nullptr);
   }
@@ -30,6 +30,26 @@ using namespace o2::math_utils;
 
 ClassImp(MagneticWrapperChebyshev)
 
+namespace
+{
+/// Segments found by the last field query of a thread. Consecutive queries, e.g. along a particle
+/// trajectory during transport, mostly fall in the same segment and skip the segment search.
+struct SegmentCache {
+  const MagneticWrapperChebyshev* owner = nullptr; ///< parameterization the segments refer to
+  int solenoid = -1;                               ///< last solenoid segment
+  int dipole = -1;                                 ///< last dipole segment
+};
+
+SegmentCache& getSegmentCache(const MagneticWrapperChebyshev* owner)
+{
+  thread_local SegmentCache cache;
+  if (cache.owner != owner) {
+    cache = SegmentCache{ owner, -1, -1 };
+  }
+  return cache;
+}
+} // namespace
+
 MagneticWrapperChebyshev::MagneticWrapperChebyshev()
   : mNumberOfParameterizationSolenoid(0),
     mNumberOfDistinctZSegmentsSolenoid(0),
@@ -431,7 +451,7 @@ void MagneticWrapperChebyshev::Field(const Double_t *xyz, Double_t *b) const
     return;
   }
 
-  int iddip = findDipoleSegment(xyz);
+  int iddip = findDipoleSegmentCached(xyz);
   if (iddip < 0) {
     return;
   }
@@ -453,7 +473,7 @@ Double_t MagneticWrapperChebyshev::getBz(const Double_t *xyz) const
     return fieldCylindricalSolenoidBz(rphiz);
   }
 
-  int iddip = findDipoleSegment(xyz);
+  int iddip = findDipoleSegmentCached(xyz);
   if (iddip < 0) {
     return 0.;
   }
@@ -597,6 +617,26 @@ Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t *rpz) const
   return mSegmentIdSolenoid[rid];
 }
 
+Int_t MagneticWrapperChebyshev::findSolenoidSegmentCached(const Double_t *rpz) const
+{
+  auto& cache = getSegmentCache(this);
+  if (cache.solenoid < 0 || cache.solenoid >= mNumberOfParameterizationSolenoid ||
+      !getParameterSolenoid(cache.solenoid)->isInside(rpz)) {
+    cache.solenoid = findSolenoidSegment(rpz);
+  }
+  return cache.solenoid;
+}
+
+Int_t MagneticWrapperChebyshev::findDipoleSegmentCached(const Double_t *xyz) const
+{
+  auto& cache = getSegmentCache(this);
+  if (cache.dipole < 0 || cache.dipole >= mNumberOfParameterizationDipole ||
+      !getParameterDipole(cache.dipole)->isInside(xyz)) {
+    cache.dipole = findDipoleSegment(xyz);
+  }
+  return cache.dipole;
+}
+
 Int_t MagneticWrapperChebyshev::findTPCSegment(const Double_t *rpz) const
 {
   if (!mNumberOfParameterizationTPC) {
@@ -734,7 +774,7 @@ void MagneticWrapperChebyshev::getTPCRatIntegral(const Double_t *xyz, Double_t *
 
 void MagneticWrapperChebyshev::fieldCylindricalSolenoid(const Double_t *rphiz, Double_t *b) const
 {
-  int id = findSolenoidSegment(rphiz);
+  int id = findSolenoidSegmentCached(rphiz);
   if (id < 0) {
     return;
   }
@@ -750,7 +790,7 @@ void MagneticWrapperChebyshev::fieldCylindricalSolenoid(const Double_t *rphiz, D
 
 Double_t MagneticWrapperChebyshev::fieldCylindricalSolenoidBz(const Double_t *rphiz) const
 {
-  int id = findSolenoidSegment(rphiz);
+  int id = findSolenoidSegmentCached(rphiz);
   if (id < 0) {
     return 0.;
   }
@@ -16,6 +16,8 @@
 #include "Field/MagneticField.h"
 #include "Field/MagFieldFast.h"
 #include <memory>
+#include <array>
+#include <vector>
 #include "FairLogger.h"                // for FairLogger
 #include <TStopwatch.h>
 #include <TRandom.h>
@@ -100,3 +102,78 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
   }
   
 }
+
+BOOST_AUTO_TEST_CASE(MagFieldFast_batch_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>
+    ("Maps","Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  fld->AllowFastField(true);
+  const MagFieldFast* fast = fld->getFastField();
+  BOOST_REQUIRE(fast);
+
+  // points inside and outside of the parametrization, not a multiple of the internal block size
+  const int ntst = 1000;
+  std::vector<float> x(ntst), y(ntst), z(ntst), bx(ntst, -999.f), by(ntst, -999.f), bz(ntst, -999.f);
+  float rnd[3];
+  int nInside = 0;
+  for (int it = 0; it < ntst; it++) {
+    gRandom->RndmArray(3, rnd);
+    x[it] = rnd[0] * 600. * TMath::Cos(rnd[1] * TMath::Pi() * 2);
+    y[it] = rnd[0] * 600. * TMath::Sin(rnd[1] * TMath::Pi() * 2);
+    z[it] = (rnd[2] - 0.5) * 1200.;
+    float xyz[3] = { x[it], y[it], z[it] }, b[3];
+    nInside += fast->Field(xyz, b);
+  }
+  BOOST_CHECK_EQUAL(fast->Field(ntst, x.data(), y.data(), z.data(), bx.data(), by.data(), bz.data()), nInside);
+  for (int it = 0; it < ntst; it++) {
+    float xyz[3] = { x[it], y[it], z[it] }, b[3];
+    if (fast->Field(xyz, b)) {
+      BOOST_CHECK_EQUAL(bx[it], b[0]);
+      BOOST_CHECK_EQUAL(by[it], b[1]);
+      BOOST_CHECK_EQUAL(bz[it], b[2]);
+    } else {
+      BOOST_CHECK_EQUAL(bx[it], -999.f);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MagFieldFast_forward_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>
+    ("Maps","Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  // exact field in the forward region, before the fast field is allowed
+  const int ntst = 1000;
+  std::vector<Point3D<float>> xyz(ntst);
+  std::vector<std::array<double, 3>> bExact(ntst);
+  float rnd[3];
+  for (int it = 0; it < ntst; it++) {
+    gRandom->RndmArray(3, rnd);
+    xyz[it].SetXYZ((rnd[0] - 0.5) * 400., (rnd[1] - 0.5) * 400., -600. - rnd[2] * 800.);
+    double pnt[3] = { xyz[it].X(), xyz[it].Y(), xyz[it].Z() };
+    fld->Field(pnt, bExact[it].data());
+  }
+
+  fld->AllowFastField(true, true);
+  const MagFieldFast* fast = fld->getFastField();
+  BOOST_REQUIRE(fast && fast->hasForwardTable());
+  std::vector<std::array<float, 3>> bFast(ntst);
+  BOOST_CHECK_EQUAL(fast->Field(xyz, bFast), ntst);
+
+  // the tabulated field follows the exact one on the scale of the dipole field
+  double mean[3] = { 0. }, rms[3] = { 0. };
+  for (int it = 0; it < ntst; it++) {
+    for (int i = 0; i < 3; i++) {
+      double df = bExact[it][i] - bFast[it][i];
+      mean[i] += df;
+      rms[i] += df * df;
+    }
+  }
+  const double nomBdip = 6.;
+  for (int i = 0; i < 3; i++) {
+    mean[i] /= ntst;
+    rms[i] = TMath::Sqrt(rms[i] / ntst - mean[i] * mean[i]);
+    LOG(INFO) << "forward deltaB" << "XYZ"[i] << ": mean=" << mean[i] << " RMS=" << rms[i] << FairLogger::endl;
+    BOOST_CHECK(TMath::Abs(mean[i] / nomBdip) < 1.e-2);
+    BOOST_CHECK(TMath::Abs(rms[i] / nomBdip) < 1.e-2);
+  }
+}
@@ -127,13 +127,13 @@ class Chebyshev3D : public TNamed
 
     Chebyshev3D &operator=(const Chebyshev3D &rhs);
 
-    void Eval(const Float_t *par, Float_t *res);
+    void Eval(const Float_t *par, Float_t *res) const;
 
-    Float_t Eval(const Float_t *par, int idim);
+    Float_t Eval(const Float_t *par, int idim) const;
 
-    void Eval(const Double_t *par, Double_t *res);
+    void Eval(const Double_t *par, Double_t *res) const;
 
-    Double_t Eval(const Double_t *par, int idim);
+    Double_t Eval(const Double_t *par, int idim) const;
 
     void evaluateDerivative(int dimd, const Float_t *par, Float_t *res);
 
@@ -279,43 +279,47 @@ inline Bool_t Chebyshev3D::isInside(const Double_t *par) const
 }
 
 /// Evaluates Chebyshev parameterization for 3d->DimOut function
-inline void Chebyshev3D::Eval(const Float_t *par, Float_t *res)
+inline void Chebyshev3D::Eval(const Float_t *par, Float_t *res) const
 {
+  Float_t mapped[3]; // local, such that the evaluation can be done from several threads
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
   for (int i = mOutputArrayDimension; i--;) {
-    res[i] = getChebyshevCalc(i)->Eval(mTemporaryCoefficient);
+    res[i] = getChebyshevCalc(i)->Eval(mapped);
   }
 }
 
 /// Evaluates Chebyshev parameterization for 3d->DimOut function
-inline void Chebyshev3D::Eval(const Double_t *par, Double_t *res)
+inline void Chebyshev3D::Eval(const Double_t *par, Double_t *res) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
   for (int i = mOutputArrayDimension; i--;) {
-    res[i] = getChebyshevCalc(i)->Eval(mTemporaryCoefficient);
+    res[i] = getChebyshevCalc(i)->Eval(mapped);
   }
 }
 
 /// Evaluates Chebyshev parameterization for idim-th output dimension of 3d->DimOut function
-inline Double_t Chebyshev3D::Eval(const Double_t *par, int idim)
+inline Double_t Chebyshev3D::Eval(const Double_t *par, int idim) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
-  return getChebyshevCalc(idim)->Eval(mTemporaryCoefficient);
+  return getChebyshevCalc(idim)->Eval(mapped);
 }
 
 /// Evaluates Chebyshev parameterization for idim-th output dimension of 3d->DimOut function
-inline Float_t Chebyshev3D::Eval(const Float_t *par, int idim)
+inline Float_t Chebyshev3D::Eval(const Float_t *par, int idim) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
-  return getChebyshevCalc(idim)->Eval(mTemporaryCoefficient);
+  return getChebyshevCalc(idim)->Eval(mapped);
 }
 
 /// Returns the gradient matrix
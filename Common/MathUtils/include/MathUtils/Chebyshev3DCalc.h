@@ -17,6 +17,7 @@
 
 #include <TNamed.h>  // for TNamed
 #include <cstdio>   // for FILE, stdout
+#include <vector>
 #include "Rtypes.h"  // for Float_t, UShort_t, Int_t, Double_t, etc
 
 class TString;
@@ -164,11 +165,24 @@ class Chebyshev3DCalc : public TNamed
     /// Reads single line from the stream, skipping empty and commented lines. EOF is not expected
     static void readLine(TString &str, FILE *stream);
 
+    /// Evaluates the parameterization, the temporaries of the summation are local to the call such that
+    /// the evaluation can be done from several threads
     Float_t Eval(const Float_t *par) const;
 
     Double_t Eval(const Double_t *par) const;
 
+    /// max number of rows or columns for which the temporaries of Eval are kept on the stack
+    static constexpr int MaxStackCoefficients = 64;
+
   private:
+    /// Evaluates the parameterization using the provided buffers for the temporaries
+    template <typename T>
+    Float_t evaluate(const T *par, Float_t *tmp2D, Float_t *tmp1D) const;
+
+    /// Evaluates the parameterization with temporaries on the stack or, for large matrices, on the heap
+    template <typename T>
+    Float_t evaluate(const T *par) const;
+
     Int_t mNumberOfCoefficients;    ///< total number of coeeficients
     Int_t mNumberOfRows;            ///< number of significant rows in the 3D coeffs matrix
     Int_t mNumberOfColumns;         ///< max number of significant cols in the 3D coeffs matrix
@@ -213,47 +227,50 @@ inline Float_t Chebyshev3DCalc::chebyshevEvaluation1D(Float_t x, const Float_t *
 }
 
 /// Evaluates Chebyshev parameterization for 3D function.
-/// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
-inline Float_t Chebyshev3DCalc::Eval(const Float_t *par) const
+template <typename T>
+inline Float_t Chebyshev3DCalc::evaluate(const T *par, Float_t *tmp2D, Float_t *tmp1D) const
 {
-  if (!mNumberOfRows) {
-    return 0.;
-  }
   int ncfRC;
   for (int id0 = mNumberOfRows; id0--;) {
     int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
     int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
     for (int id1 = nCLoc; id1--;) {
       int id = id1 + col0;
-      mTemporaryCoefficients2D[id1] = (ncfRC = mCoefficientBound2D0[id])
-                                      ? chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC)
-                                      : 0.0;
+      tmp2D[id1] = (ncfRC = mCoefficientBound2D0[id])
+                   ? chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC)
+                   : 0.0;
     }
-    mTemporaryCoefficients1D[id0] = nCLoc > 0 ? chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, nCLoc) : 0.0;
+    tmp1D[id0] = nCLoc > 0 ? chebyshevEvaluation1D(par[1], tmp2D, nCLoc) : 0.0;
   }
-  return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
+  return chebyshevEvaluation1D(par[0], tmp1D, mNumberOfRows);
 }
 
-/// Evaluates Chebyshev parameterization for 3D function.
-/// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
-inline Double_t Chebyshev3DCalc::Eval(const Double_t *par) const
+template <typename T>
+inline Float_t Chebyshev3DCalc::evaluate(const T *par) const
 {
   if (!mNumberOfRows) {
     return 0.;
   }
-  int ncfRC;
-  for (int id0 = mNumberOfRows; id0--;) {
-    int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
-    int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
-    for (int id1 = nCLoc; id1--;) {
-      int id = id1 + col0;
-      mTemporaryCoefficients2D[id1] = (ncfRC = mCoefficientBound2D0[id])
-                                      ? chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC)
-                                      : 0.0;
-    }
-    mTemporaryCoefficients1D[id0] = nCLoc > 0 ? chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, nCLoc) : 0.0;
+  if (mNumberOfRows <= MaxStackCoefficients && mNumberOfColumns <= MaxStackCoefficients) {
+    Float_t tmp2D[MaxStackCoefficients], tmp1D[MaxStackCoefficients];
+    return evaluate(par, tmp2D, tmp1D);
   }
-  return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
+  std::vector<Float_t> tmp(mNumberOfColumns + mNumberOfRows);
+  return evaluate(par, tmp.data(), tmp.data() + mNumberOfColumns);
+}
+
+/// Evaluates Chebyshev parameterization for 3D function.
+/// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
+inline Float_t Chebyshev3DCalc::Eval(const Float_t *par) const
+{
+  return evaluate(par);
+}
+
+/// Evaluates Chebyshev parameterization for 3D function.
+/// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
+inline Double_t Chebyshev3DCalc::Eval(const Double_t *par) const
+{
+  return evaluate(par);
 }
 }
 }
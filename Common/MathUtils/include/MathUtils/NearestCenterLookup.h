@@ -0,0 +1,130 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file NearestCenterLookup.h
+/// \brief Constant time lookup of the nearest of a set of cell centers along one coordinate
+///
+/// Meant for the calorimeter style geometries, where the cell hit by a direction is the one
+/// with the nearest center in eta and in phi. The centers are sorted once and the boundaries
+/// between neighbouring cells are binned on a uniform grid finer than the smallest cell, so a
+/// query costs one bin computation and at most a couple of comparisons instead of a scan.
+
+#ifndef ALICEO2_MATHUTILS_NEARESTCENTERLOOKUP_H_
+#define ALICEO2_MATHUTILS_NEARESTCENTERLOOKUP_H_
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include <gsl/span>
+
+namespace o2
+{
+namespace math_utils
+{
+
+template <typename T>
+class NearestCenterLookup
+{
+  static_assert(std::is_floating_point<T>::value, "the cell centers must be floating point");
+
+ public:
+  NearestCenterLookup() = default;
+
+  /// \param centers Cell centers, in any order
+  /// \param binsPerCell Number of grid bins per smallest distance between neighbouring centers
+  explicit NearestCenterLookup(gsl::span<const T> centers, int binsPerCell = 2)
+  {
+    const int n = centers.size();
+    mCenters.assign(centers.begin(), centers.end());
+    mIndex.resize(n);
+    std::iota(mIndex.begin(), mIndex.end(), 0);
+    std::stable_sort(mIndex.begin(), mIndex.end(), [&centers](int a, int b) { return centers[a] < centers[b]; });
+    if (n < 2) {
+      return;
+    }
+    mSorted.resize(n);
+    mEdges.resize(n - 1);
+    T minStep = 0;
+    for (int i = 0; i < n; i++) {
+      mSorted[i] = centers[mIndex[i]];
+      if (i) {
+        mEdges[i - 1] = (mSorted[i - 1] + mSorted[i]) / 2;
+        T step = mSorted[i] - mSorted[i - 1];
+        if (step > 0 && (minStep == 0 || step < minStep)) {
+          minStep = step;
+        }
+      }
+    }
+    mMin = mSorted.front();
+    T range = mSorted.back() - mMin;
+    if (minStep == 0) {
+      return; // all the centers coincide
+    }
+    T binWidth = minStep / std::max(binsPerCell, 1);
+    int nBins = std::ceil(range / binWidth) + 1;
+    mInvBinWidth = 1 / binWidth;
+    mFirstEdge.resize(nBins);
+    for (int ib = 0; ib < nBins; ib++) {
+      mFirstEdge[ib] = std::lower_bound(mEdges.begin(), mEdges.end(), mMin + ib * binWidth) - mEdges.begin();
+    }
+  }
+
+  /// \return Number of cell centers
+  size_t size() const { return mCenters.size(); }
+
+  /// Index of the center nearest to x, the lowest index on ties, as a linear scan over the
+  /// centers keeping the first minimum of |center - x| would find. -1 if there are no centers.
+  int find(T x) const
+  {
+    const int n = mCenters.size();
+    if (n < 2) {
+      return n - 1;
+    }
+    int k = 0;
+    if (!mFirstEdge.empty()) {
+      T bin = std::min(std::max((x - mMin) * mInvBinWidth, T(0)), T(mFirstEdge.size() - 1));
+      k = mFirstEdge[int(bin)];
+    }
+    while (k < n - 1 && mEdges[k] < x) {
+      k++;
+    }
+    // the boundaries are midpoints up to rounding, settle the neighbours exactly; of coincident
+    // centers the first one in the sorted order has the lowest index
+    int best = mIndex[k];
+    for (int j = std::max(k - 1, 0); j <= std::min(k + 1, n - 1); j++) {
+      int first = j;
+      while (first > 0 && mSorted[first - 1] == mSorted[j]) {
+        first--;
+      }
+      int index = mIndex[first];
+      T d = std::abs(mCenters[index] - x), dBest = std::abs(mCenters[best] - x);
+      if (d < dBest || (d == dBest && index < best)) {
+        best = index;
+      }
+    }
+    return best;
+  }
+
+ private:
+  std::vector<T> mCenters;     ///< cell centers in their original order
+  std::vector<int> mIndex;     ///< original index of the centers in increasing order
+  std::vector<T> mSorted;      ///< centers in increasing order
+  std::vector<T> mEdges;       ///< midpoints between consecutive sorted centers
+  std::vector<int> mFirstEdge; ///< first edge not below the lower end of each grid bin
+  T mMin = 0;                  ///< lower end of the grid
+  T mInvBinWidth = 0;          ///< inverse of the grid bin width
+};
+
+} // namespace math_utils
+} // namespace o2
+
+#endif
@@ -0,0 +1,167 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file RandomStream.h
+/// \brief Random numbers drawn in bulk from a PCG stream, for the digitizers
+///
+/// A RandomStream owns its generator, so every thread or digitizer has its own stream and no locking is
+/// needed; streams with the same seed and different stream ids are independent. The numbers are produced
+/// in arrays: the integers are drawn from the generator in one loop, their conversion and the transforms
+/// (Box-Muller for the normal numbers, inverse CDF tables for arbitrary distributions) run in separate
+/// loops without branches, which the compiler can vectorize where the math functions allow it.
+
+#ifndef ALICEO2_MATHUTILS_RANDOMSTREAM_H_
+#define ALICEO2_MATHUTILS_RANDOMSTREAM_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "PCG/pcg_random.hpp"
+
+namespace o2
+{
+namespace math_utils
+{
+
+/// Inverse of the cumulative distribution of a function, tabulated such that a uniform random number
+/// is turned into a random number of the distribution with one linear interpolation
+class InverseCDFTable
+{
+ public:
+  InverseCDFTable() = default;
+
+  /// \param pdf Callable returning the (not normalized) density at x, negative values count as 0
+  /// \param xmin, xmax Range of the distribution
+  /// \param nBins Number of bins of the inverse cumulative distribution
+  /// \param nPoints Number of points the density is integrated on
+  template <typename F>
+  InverseCDFTable(F&& pdf, double xmin, double xmax, int nBins = 1000, int nPoints = 10000)
+  {
+    nBins = std::max(nBins, 1);
+    nPoints = std::max(nPoints, 1);
+    // cumulative distribution with the trapezoidal rule
+    std::vector<double> cdf(nPoints + 1, 0.);
+    double dx = (xmax - xmin) / nPoints, last = std::max(double(pdf(xmin)), 0.);
+    for (int i = 1; i <= nPoints; i++) {
+      double value = std::max(double(pdf(xmin + i * dx)), 0.);
+      cdf[i] = cdf[i - 1] + 0.5 * (last + value) * dx;
+      last = value;
+    }
+    mX.resize(nBins + 1);
+    mNBins = nBins;
+    if (!(cdf.back() > 0.)) {
+      std::fill(mX.begin(), mX.end(), float(xmin)); // no probability anywhere
+      return;
+    }
+    // the x at which the cumulative distribution reaches k/nBins
+    for (int k = 0; k <= nBins; k++) {
+      double target = cdf.back() * k / nBins;
+      int i = std::lower_bound(cdf.begin(), cdf.end(), target) - cdf.begin();
+      i = std::min(std::max(i, 1), nPoints);
+      double frac = cdf[i] > cdf[i - 1] ? (target - cdf[i - 1]) / (cdf[i] - cdf[i - 1]) : 0.;
+      mX[k] = xmin + (i - 1 + frac) * dx;
+    }
+  }
+
+  /// number of bins of the table, 0 if it is not initialized
+  int getNBins() const { return mNBins; }
+
+  /// \return the value of the distribution for the uniform random number u in [0, 1)
+  float operator()(float u) const
+  {
+    float t = u * mNBins;
+    int k = std::min(int(t), mNBins - 1);
+    return mX[k] + (t - k) * (mX[k + 1] - mX[k]);
+  }
+
+ private:
+  int mNBins = 0;
+  std::vector<float> mX; ///< x at the nBins+1 equidistant values of the cumulative distribution
+};
+
+/// Uniform, normal and tabulated random numbers from a pcg32 stream of its own
+class RandomStream
+{
+ public:
+  /// \param seed Seed of the generator, on the default stream of pcg32
+  explicit RandomStream(uint64_t seed = 0) : mGenerator(seed) {}
+  /// \param seed Seed of the generator
+  /// \param stream Id of the stream, the streams of the same seed are independent
+  RandomStream(uint64_t seed, uint64_t stream) : mGenerator(seed, stream) {}
+
+  void seed(uint64_t seed) { mGenerator.seed(seed); }
+  void seed(uint64_t seed, uint64_t stream) { mGenerator.seed(seed, stream); }
+
+  /// \return a uniform random number in (0, 1)
+  float getUniform() { return toUniform(mGenerator()); }
+
+  /// uniform random numbers in (0, 1)
+  void fillUniform(float* values, size_t n)
+  {
+    uint32_t bits[Chunk];
+    while (n > 0) {
+      size_t chunk = std::min(n, Chunk);
+      for (size_t i = 0; i < chunk; i++) {
+        bits[i] = mGenerator();
+      }
+      for (size_t i = 0; i < chunk; i++) {
+        values[i] = toUniform(bits[i]);
+      }
+      values += chunk;
+      n -= chunk;
+    }
+  }
+
+  /// standard normal random numbers, two by two with the Box-Muller transform of consecutive uniform
+  /// numbers; for an odd n the second number of the last pair is dropped
+  void fillGaus(float* values, size_t n)
+  {
+    constexpr float twoPi = 2 * M_PI;
+    float uniform[2 * Chunk];
+    while (n > 0) {
+      size_t chunk = std::min(n, 2 * Chunk), nPairs = (chunk + 1) / 2;
+      fillUniform(uniform, 2 * nPairs);
+      for (size_t i = 0; i < chunk / 2; i++) {
+        float r = std::sqrt(-2.f * std::log(uniform[2 * i]));
+        values[2 * i] = r * std::cos(twoPi * uniform[2 * i + 1]);
+        values[2 * i + 1] = r * std::sin(twoPi * uniform[2 * i + 1]);
+      }
+      if (chunk & 1) {
+        values[chunk - 1] = std::sqrt(-2.f * std::log(uniform[chunk - 1])) * std::cos(twoPi * uniform[chunk]);
+      }
+      values += chunk;
+      n -= chunk;
+    }
+  }
+
+  /// random numbers of the distribution tabulated in table
+  void fill(const InverseCDFTable& table, float* values, size_t n)
+  {
+    fillUniform(values, n);
+    for (size_t i = 0; i < n; i++) {
+      values[i] = table(values[i]);
+    }
+  }
+
+ private:
+  static constexpr size_t Chunk = 64; ///< numbers drawn from the generator at once
+
+  /// the 24 high bits of the integer, centered in their bin such that neither 0 nor 1 is returned
+  static float toUniform(uint32_t bits) { return ((bits >> 8) + 0.5f) * (1.f / (1 << 24)); }
+
+  pcg32 mGenerator;
+};
+
+} // namespace math_utils
+} // namespace o2
+
+#endif
@@ -0,0 +1,246 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file RobustStatistics.h
+/// \brief Robust estimators (median, MAD, LTM) operating in place on spans
+///
+/// The functions working on unsorted data use selection (std::nth_element) instead of a
+/// full sort wherever the estimator allows it and never allocate. The variants with the
+/// suffix "Sorted" expect data sorted in increasing order and do not modify it.
+
+#ifndef ALICEO2_MATHUTILS_ROBUSTSTATISTICS_H_
+#define ALICEO2_MATHUTILS_ROBUSTSTATISTICS_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <gsl/span>
+
+namespace o2
+{
+namespace math_utils
+{
+namespace robust_stats
+{
+
+/// scale factor from the median of absolute deviations to the sigma of normally distributed data
+constexpr float MADToSigma = 1.4826f;
+
+/// Median of sorted data
+/// \param data Input data, sorted in increasing order
+/// \return Median, average of the two central values for an even number of entries
+template <typename T>
+T medianSorted(gsl::span<const T> data)
+{
+  static_assert(std::is_floating_point<T>::value, "robust statistics are only defined for floating point data");
+  const size_t n = data.size();
+  if (!n) {
+    return T(0);
+  }
+  return (n & 0x1) ? data[n / 2] : (data[n / 2 - 1] + data[n / 2]) / 2;
+}
+
+/// Median of unsorted data by selection
+/// \param data Input data, rearranged such that the central element is at its sorted position
+/// \return Median, average of the two central values for an even number of entries
+template <typename T>
+T median(gsl::span<T> data)
+{
+  static_assert(std::is_floating_point<T>::value, "robust statistics are only defined for floating point data");
+  const size_t n = data.size();
+  if (!n) {
+    return T(0);
+  }
+  auto nth = data.begin() + n / 2;
+  std::nth_element(data.begin(), nth, data.end());
+  if (n & 0x1) {
+    return *nth;
+  }
+  // all elements before nth are smaller or equal, the largest of them is the lower central value
+  return (*std::max_element(data.begin(), nth) + *nth) / 2;
+}
+
+/// Median of the absolute deviations to the median of sorted data
+/// \param data Input data, sorted in increasing order
+/// \return Median of absolute deviations, multiply by MADToSigma for a sigma estimate
+template <typename T>
+T madSorted(gsl::span<const T> data)
+{
+  const size_t n = data.size();
+  if (!n) {
+    return T(0);
+  }
+  const T med = medianSorted(data);
+  // the deviations below and above the median both increase when moving away from the center,
+  // the central deviations are found by merging the two sequences
+  std::ptrdiff_t below = static_cast<std::ptrdiff_t>(n / 2) - 1;
+  size_t above = n / 2;
+  T previous = 0;
+  T current = 0;
+  for (size_t k = 0; k <= n / 2; ++k) {
+    previous = current;
+    if (above >= n || (below >= 0 && med - data[below] <= data[above] - med)) {
+      current = med - data[below--];
+    } else {
+      current = data[above++] - med;
+    }
+  }
+  return (n & 0x1) ? current : (previous + current) / 2;
+}
+
+/// Median of the absolute deviations to the median of unsorted data by selection
+/// \param data Input data, overwritten by the absolute deviations to the median
+/// \return Median of absolute deviations, multiply by MADToSigma for a sigma estimate
+template <typename T>
+T mad(gsl::span<T> data)
+{
+  const T med = median(data);
+  for (auto& value : data) {
+    value = std::abs(value - med);
+  }
+  return median(data);
+}
+
+namespace detail
+{
+/// Finds the window of nKeep consecutive entries of sorted data with the smallest RMS.
+/// The cumulants are accumulated on the fly and rounded to float to give the same result
+/// as math_base::LTMUnbinned without a buffer, see there for the content of params.
+/// \return RMS^2 of the best window
+template <typename T>
+double ltmWindow(gsl::span<const T> data, int nKeep, std::array<float, 7>& params)
+{
+  const int nPoints = data.size();
+  double maxRMS = std::numeric_limits<double>::max();
+  params[0] = nKeep;
+  // cumulants up to the last entry of the window and up to the entry before the window
+  double sum1Hi = 0.;
+  double sum2Hi = 0.;
+  double sum1Lo = 0.;
+  double sum2Lo = 0.;
+  for (int j = 0; j < nKeep - 1; ++j) {
+    const double x = data[j];
+    sum1Hi += x;
+    sum2Hi += x * x;
+  }
+  const int limI = nPoints - nKeep + 1; // lowest possible entry to accept
+  for (int i = 0; i < limI; ++i) {
+    const int limJ = i + nKeep - 1; // highest accepted entry
+    const double xHi = data[limJ];
+    sum1Hi += xHi;
+    sum2Hi += xHi * xHi;
+    const double sum1 = static_cast<double>(static_cast<float>(sum1Hi)) - static_cast<double>(static_cast<float>(sum1Lo));
+    const double sum2 = static_cast<double>(static_cast<float>(sum2Hi)) - static_cast<double>(static_cast<float>(sum2Lo));
+    const double xLo = data[i];
+    sum1Lo += xLo;
+    sum2Lo += xLo * xLo;
+    const double mean = sum1 / nKeep;
+    const double rms2 = sum2 / nKeep - mean * mean;
+    if (rms2 > maxRMS) {
+      continue;
+    }
+    maxRMS = rms2;
+    params[1] = mean;
+    params[2] = rms2;
+    params[5] = i;
+    params[6] = limJ;
+  }
+  return maxRMS;
+}
+
+/// Converts RMS^2 in params[2] to the RMS and fills the error estimates
+inline void ltmFinalize(std::array<float, 7>& params)
+{
+  params[2] = std::sqrt(params[2]);
+  params[3] = params[2] / std::sqrt(params[0]); // error on mean
+  params[4] = params[3] / std::sqrt(2.0);       // error on RMS
+}
+} // namespace detail
+
+/// LTM : trimmed mean of sorted data, see math_base::LTMUnbinned for the definition of the output
+/// \param data Input data, sorted in increasing order
+/// \param params Array with characteristics of distribution (area, mean, rms, error of mean, error of rms, first and last accepted entry)
+/// \param fracKeep Fraction of data to be kept
+/// \return Flag if successfull
+template <typename T>
+bool ltmSorted(gsl::span<const T> data, std::array<float, 7>& params, float fracKeep)
+{
+  const int nPoints = data.size();
+  int nKeep = nPoints * fracKeep;
+  if (nKeep > nPoints) {
+    nKeep = nPoints;
+  }
+  if (nKeep < 2) {
+    return false;
+  }
+  detail::ltmWindow(data, nKeep, params);
+  if (params[2] < 0) {
+    return false; // rounding error
+  }
+  detail::ltmFinalize(params);
+  return true;
+}
+
+/// LTM : trimmed mean of unsorted data. The LTM needs the full order of the data,
+/// but sorting the values in place is considerably cheaper than building an index.
+/// \param data Input data, sorted in increasing order on return
+/// \param params Array with characteristics of distribution, indices refer to the sorted data
+/// \param fracKeep Fraction of data to be kept
+/// \return Flag if successfull
+template <typename T>
+bool ltm(gsl::span<T> data, std::array<float, 7>& params, float fracKeep)
+{
+  std::sort(data.begin(), data.end());
+  return ltmSorted(gsl::span<const T>(data.data(), data.size()), params, fracKeep);
+}
+
+/// LTM of sorted data trimmed to match a target sigma, see math_base::LTMUnbinnedSig
+/// \param data Input data, sorted in increasing order
+/// \param params Array with characteristics of distribution
+/// \param fracKeepMin Minimum fraction to keep of the input data
+/// \param sigTgt Target distribution sigma
+/// \return Flag if successfull
+template <typename T>
+bool ltmSigSorted(gsl::span<const T> data, std::array<float, 7>& params, float fracKeepMin, float sigTgt)
+{
+  const int nPoints = data.size();
+  int keepMax = nPoints;
+  int keepMin = fracKeepMin * nPoints;
+  if (keepMin > keepMax) {
+    keepMin = keepMax;
+  }
+  const float sigTgt2 = sigTgt * sigTgt;
+  while (true) {
+    const int keepN = (keepMax + keepMin) / 2;
+    if (keepN < 2) {
+      return false;
+    }
+    const double maxRMS = detail::ltmWindow(data, keepN, params);
+    if (maxRMS < sigTgt2) {
+      keepMin = keepN;
+    } else {
+      keepMax = keepN;
+    }
+    if (keepMin >= keepMax - 1) {
+      break;
+    }
+  }
+  detail::ltmFinalize(params);
+  return true;
+}
+
+} // namespace robust_stats
+} // namespace math_utils
+} // namespace o2
+
+#endif
@@ -0,0 +1,80 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Chebyshev3D
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "MathUtils/Chebyshev3D.h"
+
+using namespace o2::math_utils;
+
+namespace
+{
+void testFunction(float* inp, float* out)
+{
+  out[0] = std::sin(inp[0]) * std::cos(inp[1]) + 0.1f * inp[2];
+  out[1] = inp[0] * inp[1] - inp[2] * inp[2];
+  out[2] = std::exp(-0.1f * (inp[0] * inp[0] + inp[1] * inp[1]));
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(Chebyshev3D_eval)
+{
+  const float bmin[3] = { -2.f, -2.f, -1.f }, bmax[3] = { 2.f, 2.f, 1.f };
+  const int npoints[3] = { 15, 15, 10 };
+  const float prec = 1e-4;
+  Chebyshev3D cheb(testFunction, 3, bmin, bmax, npoints, prec);
+
+  const int nTest = 1000;
+  std::vector<float> points(3 * nTest), ref(3 * nTest);
+  for (int it = 0; it < nTest; it++) {
+    float* p = &points[3 * it];
+    for (int i = 0; i < 3; i++) {
+      p[i] = bmin[i] + (bmax[i] - bmin[i]) * ((it * (7 + 3 * i)) % nTest) / nTest;
+    }
+    cheb.Eval(p, &ref[3 * it]);
+    float exact[3];
+    testFunction(p, exact);
+    for (int i = 0; i < 3; i++) {
+      BOOST_CHECK_SMALL(ref[3 * it + i] - exact[i], 10 * prec);
+      BOOST_CHECK_EQUAL(cheb.Eval(p, i), ref[3 * it + i]);
+      double pd[3] = { p[0], p[1], p[2] };
+      BOOST_CHECK_EQUAL(cheb.Eval(pd, i), ref[3 * it + i]);
+    }
+  }
+
+  // the evaluation is const and can be done concurrently
+  const int nThreads = 4;
+  std::vector<int> nDiff(nThreads, 0);
+  std::vector<std::thread> threads;
+  for (int ith = 0; ith < nThreads; ith++) {
+    threads.emplace_back([&, ith]() {
+      for (int rep = 0; rep < 20; rep++) {
+        for (int it = 0; it < nTest; it++) {
+          float res[3];
+          cheb.Eval(&points[3 * it], res);
+          for (int i = 0; i < 3; i++) {
+            nDiff[ith] += res[i] != ref[3 * it + i];
+          }
+        }
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  for (int ith = 0; ith < nThreads; ith++) {
+    BOOST_CHECK_EQUAL(nDiff[ith], 0);
+  }
+}
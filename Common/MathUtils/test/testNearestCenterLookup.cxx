@@ -0,0 +1,72 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test NearestCenterLookup
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "MathUtils/NearestCenterLookup.h"
+
+using namespace o2::math_utils;
+
+namespace
+{
+/// the first minimum of the distance, as the geometries used to look for it
+int referenceFind(const std::vector<double>& centers, double x)
+{
+  int best = 0;
+  for (int i = 1; i < int(centers.size()); i++) {
+    if (std::abs(centers[i] - x) < std::abs(centers[best] - x)) {
+      best = i;
+    }
+  }
+  return best;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(NearestCenterLookup_test)
+{
+  // non uniform cells in decreasing order, as the eta centers of a row of towers
+  std::vector<double> centers;
+  for (int i = 0; i < 48; i++) {
+    centers.push_back(0.7 - 0.0143 * i - 0.0001 * i * i);
+  }
+  NearestCenterLookup<double> lookup(centers);
+  BOOST_CHECK_EQUAL(lookup.size(), centers.size());
+
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> flat(-0.2, 0.8);
+  int nWrong = 0;
+  for (int i = 0; i < 100000; i++) {
+    double x = flat(gen);
+    if (lookup.find(x) != referenceFind(centers, x)) {
+      nWrong++;
+    }
+  }
+  BOOST_CHECK_EQUAL(nWrong, 0);
+  for (size_t i = 0; i < centers.size(); i++) {
+    BOOST_CHECK_EQUAL(lookup.find(centers[i]), i);
+  }
+
+  // ties go to the lowest index, also for coincident centers
+  std::vector<double> ties = { 3., 1., 2., 2., 0. };
+  NearestCenterLookup<double> tieLookup(ties);
+  BOOST_CHECK_EQUAL(tieLookup.find(1.5), 1);
+  BOOST_CHECK_EQUAL(tieLookup.find(2.2), 2);
+  BOOST_CHECK_EQUAL(tieLookup.find(2.5), 0);
+  BOOST_CHECK_EQUAL(tieLookup.find(-5.), 4);
+
+  BOOST_CHECK_EQUAL(NearestCenterLookup<float>().find(1.f), -1);
+  std::vector<float> single = { 5.f };
+  BOOST_CHECK_EQUAL(NearestCenterLookup<float>(single).find(-1.f), 0);
+}
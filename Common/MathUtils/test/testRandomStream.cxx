@@ -0,0 +1,78 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test RandomStream
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include "MathUtils/RandomStream.h"
+
+using namespace o2::math_utils;
+
+namespace
+{
+void meanAndSigma(const std::vector<float>& values, double& mean, double& sigma)
+{
+  double sum = 0, sum2 = 0;
+  for (auto v : values) {
+    sum += v;
+    sum2 += v * v;
+  }
+  mean = sum / values.size();
+  sigma = std::sqrt(sum2 / values.size() - mean * mean);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(RandomStream_test)
+{
+  const size_t n = 100001; // odd, to have an incomplete chunk and pair
+  std::vector<float> values(n);
+  double mean, sigma;
+
+  RandomStream stream(1234);
+  stream.fillUniform(values.data(), n);
+  for (auto v : values) {
+    BOOST_REQUIRE(v > 0.f && v < 1.f);
+  }
+  meanAndSigma(values, mean, sigma);
+  BOOST_CHECK_SMALL(mean - 0.5, 0.005);
+  BOOST_CHECK_SMALL(sigma - std::sqrt(1. / 12), 0.005);
+
+  // same seed, same numbers, whatever the size of the requests
+  RandomStream same(1234);
+  std::vector<float> again(n);
+  same.fillUniform(again.data(), 10);
+  same.fillUniform(again.data() + 10, n - 10);
+  BOOST_CHECK(values == again);
+
+  // other stream of the same seed, other numbers
+  RandomStream other(1234, 1);
+  other.fillUniform(again.data(), n);
+  BOOST_CHECK(values != again);
+
+  stream.fillGaus(values.data(), n);
+  meanAndSigma(values, mean, sigma);
+  BOOST_CHECK_SMALL(mean, 0.01);
+  BOOST_CHECK_SMALL(sigma - 1., 0.01);
+
+  // linear density on [0, 2]: mean 4/3, cumulative x^2/4
+  InverseCDFTable table([](double x) { return x; }, 0., 2.);
+  BOOST_CHECK_EQUAL(table.getNBins(), 1000);
+  BOOST_CHECK_SMALL(table(0.25f) - 1.f, 1e-3f);
+  BOOST_CHECK_SMALL(table(0.f), 1e-3f);
+  stream.fill(table, values.data(), n);
+  for (auto v : values) {
+    BOOST_REQUIRE(v >= 0.f && v <= 2.f);
+  }
+  meanAndSigma(values, mean, sigma);
+  BOOST_CHECK_SMALL(mean - 4. / 3, 0.01);
+}
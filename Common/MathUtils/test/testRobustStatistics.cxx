@@ -0,0 +1,163 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test RobustStatistics
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "MathUtils/RobustStatistics.h"
+
+using namespace o2::math_utils::robust_stats;
+
+namespace
+{
+std::vector<float> generate(size_t n, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::normal_distribution<float> gaus(0.5f, 2.f);
+  std::vector<float> data(n);
+  for (auto& v : data) {
+    v = gaus(gen);
+  }
+  // add some outliers and duplicates
+  for (size_t i = 0; i < n / 10; ++i) {
+    data[i] = 50.f * (i & 0x1 ? 1.f : -1.f);
+  }
+  if (n > 2) {
+    data[n - 1] = data[n - 2];
+  }
+  return data;
+}
+
+float referenceMedian(std::vector<float> data)
+{
+  std::sort(data.begin(), data.end());
+  const size_t n = data.size();
+  return (n & 0x1) ? data[n / 2] : .5f * (data[n / 2 - 1] + data[n / 2]);
+}
+
+float referenceMAD(const std::vector<float>& data)
+{
+  const float med = referenceMedian(data);
+  std::vector<float> dev(data.size());
+  std::transform(data.begin(), data.end(), dev.begin(), [med](float v) { return std::abs(v - med); });
+  return referenceMedian(dev);
+}
+
+/// LTM as implemented in math_base::LTMUnbinned with a buffer of the cumulants
+void referenceLTMWindow(const std::vector<float>& sorted, int nKeep, std::array<float, 7>& params)
+{
+  const int nPoints = sorted.size();
+  std::vector<float> w(2 * nPoints);
+  double sum1 = 0., sum2 = 0.;
+  for (int i = 0; i < nPoints; i++) {
+    double x = sorted[i];
+    sum1 += x;
+    sum2 += x * x;
+    w[i] = sum1;
+    w[i + nPoints] = sum2;
+  }
+  double maxRMS = sum2 + 1e6;
+  for (int i = 0; i < nPoints - nKeep + 1; i++) {
+    const int limJ = i + nKeep - 1;
+    sum1 = static_cast<double>(w[limJ]) - static_cast<double>(i ? w[i - 1] : 0.);
+    sum2 = static_cast<double>(w[nPoints + limJ]) - static_cast<double>(i ? w[nPoints + i - 1] : 0.);
+    const double mean = sum1 / nKeep;
+    const double rms2 = sum2 / nKeep - mean * mean;
+    if (rms2 > maxRMS) {
+      continue;
+    }
+    maxRMS = rms2;
+    params[1] = mean;
+    params[2] = rms2;
+    params[5] = i;
+    params[6] = limJ;
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(RobustStatistics_median)
+{
+  for (size_t n : { 1, 2, 3, 10, 11, 1000, 1001 }) {
+    auto data = generate(n, n);
+    const float ref = referenceMedian(data);
+    auto sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    BOOST_CHECK_EQUAL(medianSorted(gsl::span<const float>(sorted)), ref);
+    BOOST_CHECK_EQUAL(median(gsl::span<float>(data)), ref);
+  }
+  std::vector<float> empty;
+  BOOST_CHECK_EQUAL(median(gsl::span<float>(empty)), 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(RobustStatistics_mad)
+{
+  for (size_t n : { 1, 2, 3, 10, 11, 1000, 1001 }) {
+    auto data = generate(n, 2 * n);
+    const float ref = referenceMAD(data);
+    auto sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    BOOST_CHECK_EQUAL(madSorted(gsl::span<const float>(sorted)), ref);
+    BOOST_CHECK_EQUAL(mad(gsl::span<float>(data)), ref);
+  }
+  // sigma of a large gaussian sample
+  std::mt19937 gen(42);
+  std::normal_distribution<float> gaus(0.f, 3.f);
+  std::vector<float> data(100000);
+  for (auto& v : data) {
+    v = gaus(gen);
+  }
+  BOOST_CHECK_CLOSE(MADToSigma * mad(gsl::span<float>(data)), 3.f, 2.);
+}
+
+BOOST_AUTO_TEST_CASE(RobustStatistics_ltm)
+{
+  for (size_t n : { 10, 101, 1000 }) {
+    auto data = generate(n, 3 * n);
+    auto sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    const float fracKeep = .75f;
+    std::array<float, 7> ref{};
+    referenceLTMWindow(sorted, n * fracKeep, ref);
+
+    std::array<float, 7> params{};
+    BOOST_REQUIRE(ltm(gsl::span<float>(data), params, fracKeep));
+    BOOST_CHECK(std::is_sorted(data.begin(), data.end()));
+    BOOST_CHECK_EQUAL(params[0], int(n * fracKeep));
+    BOOST_CHECK_EQUAL(params[1], ref[1]);
+    BOOST_CHECK_EQUAL(params[2], std::sqrt(ref[2]));
+    BOOST_CHECK_EQUAL(params[5], ref[5]);
+    BOOST_CHECK_EQUAL(params[6], ref[6]);
+    // the outliers are trimmed
+    BOOST_CHECK_SMALL(params[1] - .5f, 1.5f);
+    BOOST_CHECK_LT(params[2], 3.f);
+  }
+  std::vector<float> tooFew{ 1.f, 2.f };
+  std::array<float, 7> params{};
+  BOOST_CHECK(!ltm(gsl::span<float>(tooFew), params, .5f));
+}
+
+BOOST_AUTO_TEST_CASE(RobustStatistics_ltmSig)
+{
+  auto data = generate(1000, 7);
+  std::sort(data.begin(), data.end());
+  std::array<float, 7> params{};
+  BOOST_REQUIRE(ltmSigSorted(gsl::span<const float>(data), params, .5f, 2.f));
+  BOOST_CHECK_GE(params[0], 500);
+  BOOST_CHECK_LE(params[0], 1000);
+  BOOST_CHECK_LT(params[2], 3.f);
+  // a larger target sigma keeps at least as many points
+  std::array<float, 7> paramsWide{};
+  BOOST_REQUIRE(ltmSigSorted(gsl::span<const float>(data), paramsWide, .5f, 10.f));
+  BOOST_CHECK_GE(paramsWide[0], params[0]);
+}
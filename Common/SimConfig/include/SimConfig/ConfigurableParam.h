@@ -128,6 +128,7 @@ class ConfigurableParam
       auto changed = updateThroughStorageMap(mainkey, subkey, typeid(T), (void*)&x);
       if (changed) {
         sValueProvenanceMap->find(key)->second = kRT; // set to runtime
+        updateSnapshots();
       }
     }
   }
@@ -141,6 +142,7 @@ class ConfigurableParam
       auto changed = updateThroughStorageMapWithConversion(key, valuestring);
       if (changed) {
         sValueProvenanceMap->find(key)->second = kRT; // set to runtime
+        updateSnapshots();
       }
     }
   }
@@ -159,6 +161,12 @@ class ConfigurableParam
   // might be useful to get stuff from the command line
   static void updateFromString(std::string const&);
 
+  // registers the update function of a ParamSnapshot, called whenever
+  // the parameters are (re)initialized or changed
+  static bool registerSnapshot(void (*update)());
+  // retakes all registered snapshots
+  static void updateSnapshots();
+
  protected:
   // constructor is doing nothing else but
   // registering the concrete parameters
@@ -191,6 +199,8 @@ class ConfigurableParam
  private:
   // static registry for implementations of this type
   static std::vector<ConfigurableParam*>* sRegisteredParamClasses; //!
+  // update functions of the registered snapshots
+  static std::vector<void (*)()>* sSnapshotUpdaters; //!
   // static property tree (stocking all key - value pairs from instances of type ConfigurableParam)
   static boost::property_tree::ptree* sPtree; //!
   static bool sIsFullyInitialized;            //!
@@ -0,0 +1,64 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef COMMON_SIMCONFIG_INCLUDE_SIMCONFIG_PARAMSNAPSHOT_H_
+#define COMMON_SIMCONFIG_INCLUDE_SIMCONFIG_PARAMSNAPSHOT_H_
+
+#include "SimConfig/ConfigurableParam.h"
+
+namespace o2
+{
+namespace conf
+{
+// A frozen copy of (some of) the values of a ConfigurableParam, for the
+// stepping and digitization loops.
+//
+// The values are held in a plain struct S, which names the parameter class
+// it is taken from and is constructible from it:
+//
+// struct TPCGasValues {
+//   using Param = TPCGasParameter;
+//   TPCGasValues() = default;
+//   explicit TPCGasValues(TPCGasParameter const& p) : gasDensity(p.getGasDensity()) {}
+//   double gasDensity = 0.;
+// };
+// O2ParamSnapshotImpl(TPCGasValues); // in the source file of the parameter, after O2ParamImpl
+//
+// ParamSnapshot<TPCGasValues>::get() is then the read of a static object of known
+// type: no key lookup, no virtual call and no lock. The snapshot is taken when the
+// parameters are initialized and retaken whenever they change (updateFromString,
+// setValue, fromCCDB), hence it is valid once the configuration has been parsed;
+// it is not meant to be read before or concurrently with these updates.
+template <typename S>
+class ParamSnapshot
+{
+ public:
+  static S const& get() { return sValues; }
+
+  // retakes the values from the current state of the parameter
+  static void update() { sValues = S(S::Param::Instance()); }
+
+ private:
+  static S sValues;
+  static bool sRegistered; // defined by O2ParamSnapshotImpl
+};
+
+template <typename S>
+S ParamSnapshot<S>::sValues;
+
+} // namespace conf
+} // namespace o2
+
+// a helper macro to register a snapshot with the parameter system (in source)
+#define O2ParamSnapshotImpl(snapshot) \
+  template <>                         \
+  bool o2::conf::ParamSnapshot<snapshot>::sRegistered = o2::conf::ConfigurableParam::registerSnapshot(&o2::conf::ParamSnapshot<snapshot>::update);
+
+#endif /* COMMON_SIMCONFIG_INCLUDE_SIMCONFIG_PARAMSNAPSHOT_H_ */
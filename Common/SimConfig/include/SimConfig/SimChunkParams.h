@@ -0,0 +1,42 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_SIMCONFIG_SIMCHUNKPARAMS_H_
+#define O2_SIMCONFIG_SIMCHUNKPARAMS_H_
+
+#include "SimConfig/ConfigurableParam.h"
+#include "SimConfig/ConfigurableParamHelper.h"
+
+namespace o2
+{
+namespace conf
+{
+// parameters of the splitting of the events into primary chunks by the primary server
+// (parallel simulation), the maximal number of primaries of a chunk is given by --chunkSize
+//
+// Every primary is given an estimated transport cost, costPerPrimary + costPerGeV * E, or only
+// costPerPrimary beyond |eta| > etaMax where the particle leaves along the beam pipe. The chunks
+// are cut at equal cost instead of equal numbers of primaries, and their cost decreases towards the
+// end of the event (guided scheduling: at most the remaining cost / (tailFactor * nworkers)) such that
+// the workers finish the last chunks of an event at about the same time.
+struct SimChunkParams : public o2::conf::ConfigurableParamHelper<SimChunkParams> {
+  bool costModel = true;      // cut the chunks by estimated cost, false for fixed numbers of primaries
+  double costPerPrimary = 1.; // cost of any primary
+  double costPerGeV = 1.;     // cost per GeV of energy of the primaries within |eta| < etaMax
+  double etaMax = 8.;         // beyond, the primaries are not transported through material
+  double tailFactor = 2.;     // chunk cost at most remaining cost / (tailFactor * nworkers), 0 disables
+  int minChunkSize = 100;     // minimal number of primaries of a chunk (but the last of an event)
+
+  O2ParamDef(SimChunkParams, "SimChunkParams");
+};
+} // namespace conf
+} // namespace o2
+
+#endif /* O2_SIMCONFIG_SIMCHUNKPARAMS_H_ */
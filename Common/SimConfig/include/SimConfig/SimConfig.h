@@ -26,6 +26,7 @@ struct SimConfigData {
   std::string mGenerator;                    // chosen VMC generator
   unsigned int mNEvents;                     // number of events to be simulated
   std::string mExtKinFileName;               // file name of external kinematics file (needed for ext kinematics generator)
+  int mExtKinReadAhead = 0;                  // number of events of the external kinematics decoded in advance
   std::string mExtGenFileName;               // file name containing the external generator configuration
   std::string mExtGenFuncName;               // function call to retrieve the external generator configuration
   std::string mEmbedIntoFileName;            // filename containing the reference events to be used for the embedding
@@ -44,8 +45,9 @@ struct SimConfigData {
   int mStartSeed;                            // base for random number seeds
   int mSimWorkers = 1;                       // number of parallel sim workers (when it applies)
   bool mFilterNoHitEvents = false;           // whether to filter out events not leaving any response
+  bool mCompactHits = false;                 // whether the hit merger writes the hits in the compact format
 
-  ClassDefNV(SimConfigData, 2);
+  ClassDefNV(SimConfigData, 4);
 };
 
 // A singleton class which can be used
@@ -91,6 +93,7 @@ class SimConfig
   unsigned int getNEvents() const { return mConfigData.mNEvents; }
 
   std::string getExtKinematicsFileName() const { return mConfigData.mExtKinFileName; }
+  int getExtKinematicsReadAhead() const { return mConfigData.mExtKinReadAhead; }
   std::string getExtGeneratorFileName() const { return mConfigData.mExtGenFileName; }
   std::string getExtGeneratorFuncName() const { return mConfigData.mExtGenFuncName; }
   std::string getEmbedIntoFileName() const { return mConfigData.mEmbedIntoFileName; }
@@ -106,6 +109,7 @@ class SimConfig
   int getStartSeed() const { return mConfigData.mStartSeed; }
   int getNSimWorkers() const { return mConfigData.mSimWorkers; }
   bool isFilterOutNoHitEvents() const { return mConfigData.mFilterNoHitEvents; }
+  bool useCompactHits() const { return mConfigData.mCompactHits; }
 
  private:
   SimConfigData mConfigData; //!
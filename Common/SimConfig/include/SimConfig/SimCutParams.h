@@ -13,6 +13,8 @@
 
 #include "SimConfig/ConfigurableParam.h"
 #include "SimConfig/ConfigurableParamHelper.h"
+#include "SimConfig/ParamSnapshot.h"
+#include <string>
 
 namespace o2
 {
@@ -23,14 +25,49 @@ namespace conf
 struct SimCutParams : public o2::conf::ConfigurableParamHelper<SimCutParams> {
   bool stepFiltering = true; // if we activate the step filtering in O2BaseMCApplication
   bool trackSeed = false;    // per track seeding for track-reproducible mode
+  bool stepStatistics = false; // count the steps and time the hit processing per sensitive detector
+  // profile the steps per (volume, particle type, module): steps and secondaries are counted in every step,
+  // the transport time of 1 in stepProfiling steps is measured (0 disables); the table is written to
+  // stepProfileFile, with the process id appended, after every event
+  int stepProfiling = 0;
+  std::string stepProfileFile = "MCStepProfile";
 
   double maxRTracking = 1E20;    // max R tracking cut in cm (in the VMC sense) -- applied in addition to cutting in the stepping function
   double maxAbsZTracking = 1E20; // max |Z| tracking cut in cm (in the VMC sense) -- applied in addition to cutting in the stepping function
   double ZmaxA = 1E20;           // max Z tracking cut on A side in cm -- applied in the stepping function
   double ZmaxC = 1E20;           // max Z tracking cut on C side in cm -- applied in the stepping function
 
+  // regions in which the tracks are stopped below a kinetic energy threshold -- applied in the stepping function
+  // comma separated list of volume or module name:threshold in GeV (0 stops all tracks), e.g. "ABSO:0.01,YOKE:0"
+  std::string killRegions = "";
+
+  // fast simulation with shower libraries (DetectorsBase/ShowerLibrary.h): photons and electrons above
+  // showerLibraryEmin entering the front volumes of a detector are stopped and a library shower is deposited
+  // comma separated list of detector name:library file, e.g. "EMC:emcshowers.root,PHS:phsshowers.root"
+  std::string showerLibraries = "";
+  double showerLibraryEmin = 1.; // in GeV
+  // record the full showers of the eligible tracks to a library instead (detector name:library file), binned in
+  // the comma separated edges of the incident energy (GeV) and angle (rad); to be run with a single worker
+  std::string showerLibraryRecord = "";
+  std::string showerLibraryEnergyBins = "1,2,4,8,16,32,64,128";
+  std::string showerLibraryAngleBins = "0,0.1,0.2,0.3,0.4,0.5,0.6,0.8";
+
   O2ParamDef(SimCutParams, "SimCutParams");
 };
+
+// the SimCutParams read in every step, as a plain snapshot
+// (access with ParamSnapshot<SimCutValues>::get())
+struct SimCutValues {
+  using Param = SimCutParams;
+  SimCutValues() = default;
+  explicit SimCutValues(SimCutParams const& p) : stepFiltering(p.stepFiltering), stepStatistics(p.stepStatistics), stepProfiling(p.stepProfiling), ZmaxA(p.ZmaxA), ZmaxC(p.ZmaxC) {}
+
+  bool stepFiltering = true;
+  bool stepStatistics = false;
+  int stepProfiling = 0;
+  double ZmaxA = 1E20;
+  double ZmaxC = 1E20;
+};
 } // namespace conf
 } // namespace o2
 
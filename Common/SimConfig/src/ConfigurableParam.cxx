@@ -30,6 +30,7 @@ namespace conf
 {
 
 std::vector<ConfigurableParam*>* ConfigurableParam::sRegisteredParamClasses = nullptr;
+std::vector<void (*)()>* ConfigurableParam::sSnapshotUpdaters = nullptr;
 boost::property_tree::ptree* ConfigurableParam::sPtree = nullptr;
 std::map<std::string, std::pair<std::type_info const&, void*>>* ConfigurableParam::sKeyToStorageMap = nullptr;
 std::map<std::string, ConfigurableParam::EParamProvenance>* ConfigurableParam::sValueProvenanceMap = nullptr;
@@ -113,6 +114,7 @@ void ConfigurableParam::fromCCDB(std::string filename)
     p->initFrom(&file);
   }
   file.Close();
+  updateSnapshots();
 }
 
 // ------------------------------------------------------------------
@@ -147,6 +149,31 @@ void ConfigurableParam::initialize()
     sValueProvenanceMap->insert(std::pair<std::string, ConfigurableParam::EParamProvenance>(key.first, kCODE));
   }
   sIsFullyInitialized = true;
+  updateSnapshots();
+}
+
+// ------------------------------------------------------------------
+
+bool ConfigurableParam::registerSnapshot(void (*update)())
+{
+  // may be called during static initialization, before any other member is set up
+  if (sSnapshotUpdaters == nullptr) {
+    sSnapshotUpdaters = new std::vector<void (*)()>;
+  }
+  sSnapshotUpdaters->push_back(update);
+  return true;
+}
+
+// ------------------------------------------------------------------
+
+void ConfigurableParam::updateSnapshots()
+{
+  if (sSnapshotUpdaters == nullptr) {
+    return;
+  }
+  for (auto update : *sSnapshotUpdaters) {
+    update();
+  }
 }
 
 // ------------------------------------------------------------------
@@ -19,4 +19,6 @@
 
 #pragma link C++ class o2::conf::SimCutParams + ;
 #pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::SimCutParams > +;
+#pragma link C++ class o2::conf::SimChunkParams + ;
+#pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::SimChunkParams > +;
 #endif
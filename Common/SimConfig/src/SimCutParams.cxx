@@ -17,3 +17,4 @@
 
 #include "SimConfig/SimCutParams.h"
 O2ParamImpl(o2::conf::SimCutParams);
+O2ParamSnapshotImpl(o2::conf::SimCutValues);
@@ -10,6 +10,7 @@
 
 #include <SimConfig/ConfigurableParam.h>
 #include <SimConfig/ConfigurableParamHelper.h>
+#include <SimConfig/ParamSnapshot.h>
 #include <SimConfig/SimConfig.h>
 #include <iostream>
 #include <TInterpreter.h>
@@ -27,6 +28,14 @@ class BazParam : public o2::conf::ConfigurableParamHelper<BazParam>
 };
 O2ParamImpl(BazParam);
 
+struct BazValues {
+  using Param = BazParam;
+  BazValues() = default;
+  explicit BazValues(BazParam const& p) : gasDensity(p.getGasDensity()) {}
+  double gasDensity = 0.;
+};
+O2ParamSnapshotImpl(BazValues);
+
 int main(int argc, char* argv[])
 {
   // generate dictionary for BazParam (done here since this is just
@@ -62,5 +71,8 @@ int main(int argc, char* argv[])
   assert(d3 == BazParam::Instance().getGasDensity());
   assert(x == BazParam::Instance().getGasDensity());
 
+  // the snapshot follows the updates
+  assert(o2::conf::ParamSnapshot<BazValues>::get().gasDensity == x);
+
   o2::conf::ConfigurableParam::writeINI("newconf.ini");
 }
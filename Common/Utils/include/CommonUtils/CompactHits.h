@@ -0,0 +1,196 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CompactHits.h
+/// \brief Compact binary format of the simulated hits
+///
+/// The hits of an event are split into columns, encoded column by column and stored as one byte
+/// buffer (a std::vector<char> branch) instead of the ROOT streamed hit objects:
+/// - positions and times are rounded to fixed point numbers of a given precision, and stored as the
+///   difference to the previous hit,
+/// - track and sensor ids are stored as the difference to the previous hit,
+/// - the differences are zigzag and variable length (7 bits per byte) encoded, such that the small
+///   steps between the consecutive hits of a track take one or two bytes,
+/// - energy losses and other values without a natural precision are stored as raw 32 bit words.
+/// The rounding, differences and zigzag transforms run in separate loops over the columns, without
+/// branches, such that the compiler vectorizes them; only the byte packing is sequential.
+///
+/// A hit type supports the format by a specialization of CompactHitCodec, usually from BasicHitCodec
+/// for the fields of the basic hit classes (o2::BasicXYZVHit).
+
+#ifndef ALICEO2_COMMONUTILS_COMPACTHITS_H_
+#define ALICEO2_COMMONUTILS_COMPACTHITS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace o2
+{
+namespace utils
+{
+
+/// precision of the fixed point columns
+struct CompactHitPrecision {
+  float position = 1.e-4f; ///< cm, 1 um
+  float time = 1.e-3f;     ///< ns, 1 ps
+};
+
+/// the hits of one container, split into columns
+struct HitColumns {
+  struct FixedColumn {
+    float precision = 1.f;
+    std::vector<float> values;
+  };
+  std::vector<FixedColumn> fixed;        ///< fixed point columns, delta encoded
+  std::vector<std::vector<uint32_t>> raw; ///< raw 32 bit columns
+  std::vector<std::vector<int32_t>> ints; ///< integer columns, delta encoded
+
+  void resize(size_t nFixed, size_t nRaw, size_t nInt)
+  {
+    fixed.resize(nFixed);
+    raw.resize(nRaw);
+    ints.resize(nInt);
+  }
+
+  /// raw bits of a 32 bit value
+  template <typename T>
+  static uint32_t toRaw(T value)
+  {
+    static_assert(sizeof(T) == sizeof(uint32_t), "raw columns hold 32 bit values");
+    uint32_t word;
+    std::memcpy(&word, &value, sizeof(word));
+    return word;
+  }
+  template <typename T>
+  static T fromRaw(uint32_t word)
+  {
+    static_assert(sizeof(T) == sizeof(uint32_t), "raw columns hold 32 bit values");
+    T value;
+    std::memcpy(&value, &word, sizeof(value));
+    return value;
+  }
+};
+
+/// encode the columns, the buffer is overwritten
+void encodeHitColumns(HitColumns const& columns, std::vector<char>& buffer);
+/// decode columns encoded by encodeHitColumns, false if the buffer is not a valid encoding
+bool decodeHitColumns(const char* buffer, size_t size, HitColumns& columns);
+
+/// Codec of a hit type from and to columns, the specializations implement
+///   static void split(std::vector<Hit> const& hits, HitColumns& columns, CompactHitPrecision const& precision);
+///   static bool merge(HitColumns const& columns, std::vector<Hit>& hits); // false if the columns are inconsistent
+/// and set available to true
+template <typename Hit>
+struct CompactHitCodec {
+  static constexpr bool available = false;
+};
+
+/// Codec of the fields of the basic hit classes: position, time, hit value, track and detector id.
+/// Fixed columns 0-3 are x, y, z, time, raw column 0 the hit value, integer columns 0-1 the track
+/// and detector ids. Only for hit classes without other data members, or as the base of their codec.
+template <typename Hit>
+struct BasicHitCodec {
+  static constexpr bool available = true;
+  static constexpr size_t NFixed = 4, NRaw = 1, NInt = 2;
+
+  template <typename Container>
+  static void split(Container const& hits, HitColumns& columns, CompactHitPrecision const& precision)
+  {
+    const size_t n = hits.size();
+    columns.resize(NFixed, NRaw, NInt);
+    for (size_t c = 0; c < 3; c++) {
+      columns.fixed[c].precision = precision.position;
+      columns.fixed[c].values.resize(n);
+    }
+    columns.fixed[3].precision = precision.time;
+    columns.fixed[3].values.resize(n);
+    columns.raw[0].resize(n);
+    columns.ints[0].resize(n);
+    columns.ints[1].resize(n);
+    for (size_t i = 0; i < n; i++) {
+      auto& hit = hits[i];
+      columns.fixed[0].values[i] = hit.GetX();
+      columns.fixed[1].values[i] = hit.GetY();
+      columns.fixed[2].values[i] = hit.GetZ();
+      columns.fixed[3].values[i] = hit.GetTime();
+      columns.raw[0][i] = HitColumns::toRaw(hit.GetHitValue());
+      columns.ints[0][i] = hit.GetTrackID();
+      columns.ints[1][i] = hit.GetDetectorID();
+    }
+  }
+
+  template <typename Container>
+  static bool merge(HitColumns const& columns, Container& hits)
+  {
+    using Value = decltype(hits[0].GetHitValue());
+    const size_t n = columns.ints[0].size();
+    if (!hasSize(columns, n)) {
+      return false;
+    }
+    hits.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      auto& hit = hits[i];
+      hit.SetXYZ(columns.fixed[0].values[i], columns.fixed[1].values[i], columns.fixed[2].values[i]);
+      hit.SetTime(columns.fixed[3].values[i]);
+      hit.SetHitValue(HitColumns::fromRaw<Value>(columns.raw[0][i]));
+      hit.SetTrackID(columns.ints[0][i]);
+      hit.SetDetectorID(columns.ints[1][i]);
+    }
+    return true;
+  }
+
+  /// true if the base columns hold n values
+  static bool hasSize(HitColumns const& columns, size_t n)
+  {
+    for (size_t c = 0; c < NFixed; c++) {
+      if (columns.fixed[c].values.size() != n) {
+        return false;
+      }
+    }
+    return columns.raw[0].size() == n && columns.ints[0].size() == n && columns.ints[1].size() == n;
+  }
+};
+
+/// encode a hit container to the compact format
+template <typename Container>
+void encodeHits(Container const& hits, std::vector<char>& buffer, CompactHitPrecision const& precision = CompactHitPrecision())
+{
+  using Codec = CompactHitCodec<typename Container::value_type>;
+  static_assert(Codec::available, "no compact format for this hit type");
+  HitColumns columns;
+  Codec::split(hits, columns, precision);
+  encodeHitColumns(columns, buffer);
+}
+
+/// decode hits of the compact format, false if the buffer is not a valid encoding of the hit type
+template <typename Container>
+bool decodeHits(const char* buffer, size_t size, Container& hits)
+{
+  using Codec = CompactHitCodec<typename Container::value_type>;
+  static_assert(Codec::available, "no compact format for this hit type");
+  HitColumns columns;
+  if (!decodeHitColumns(buffer, size, columns)) {
+    return false;
+  }
+  // the layout of the columns must be the one of the codec
+  HitColumns layout;
+  Codec::split(Container(), layout, CompactHitPrecision());
+  if (layout.fixed.size() != columns.fixed.size() || layout.raw.size() != columns.raw.size() || layout.ints.size() != columns.ints.size()) {
+    return false;
+  }
+  return Codec::merge(columns, hits);
+}
+
+} // namespace utils
+} // namespace o2
+
+#endif
@@ -0,0 +1,461 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FlatSerializer.h
+/// \brief Flat, column wise binary serialization of containers of simple structs
+///
+/// An alternative to the boost serialization of BoostSerializer.h for the containers of structs
+/// exchanged between the devices. The container is stored as one column per field of the struct
+/// (structure of arrays) after a header, such that the sender computes the exact size and writes
+/// each column in one pass, and the receiver reads the columns in place (FlatView), without any
+/// deserialization:
+///
+///   FlatHeader | FlatColumnHeader[nColumns] | column 0 | column 1 | ...
+///
+/// - a fixed column holds the nEntries values of a trivially copyable field,
+/// - a variable column, for std::vector of trivially copyable items and std::string, holds the
+///   nEntries + 1 offsets (in items) of the entries followed by the items.
+/// The columns start at 8 byte boundaries. The header holds the schema version of the struct and the
+/// column headers the kind and element size of each column: fields can be appended to a struct, the
+/// readers of a previous version skip the new columns and the readers of the new version get value
+/// initialized fields for the columns missing in the buffer. Removing, reordering or changing the
+/// type of a field is detected as an incompatible column.
+///
+/// A struct supports the format by a static member template listing its fields, in order:
+///
+///   struct Hit {
+///     int id;
+///     float pos[3];
+///     std::vector<int> digits;
+///     static constexpr uint16_t FlatVersion = 1; // optional, 0 by default
+///     template <typename Self>
+///     static auto flatFields(Self& self) { return std::tie(self.id, self.pos, self.digits); }
+///   };
+
+#ifndef ALICEO2_COMMONUTILS_FLATSERIALIZER_H_
+#define ALICEO2_COMMONUTILS_FLATSERIALIZER_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace utils
+{
+
+struct FlatHeader {
+  static constexpr uint32_t Magic = 0x53463230; ///< "02FS"
+  static constexpr uint16_t LayoutVersion = 1;
+
+  uint32_t magic = Magic;
+  uint16_t layoutVersion = LayoutVersion;
+  uint16_t schemaVersion = 0; ///< FlatVersion of the struct
+  uint32_t nColumns = 0;
+  uint32_t reserved = 0;
+  uint64_t nEntries = 0;
+};
+
+struct FlatColumnHeader {
+  enum Kind : uint32_t { Fixed = 0,
+                         Variable = 1 };
+
+  uint32_t kind = Fixed;
+  uint32_t elementSize = 0; ///< size of a value (fixed) or of an item (variable)
+  uint64_t offset = 0;      ///< of the column from the start of the buffer
+  uint64_t size = 0;        ///< bytes of the column, padding included
+};
+
+/// read only contiguous range in the buffer
+template <typename T>
+class FlatSpan
+{
+ public:
+  FlatSpan() = default;
+  FlatSpan(const T* data, size_t size) : mData(data), mSize(size) {}
+
+  const T* data() const { return mData; }
+  size_t size() const { return mSize; }
+  bool empty() const { return mSize == 0; }
+  const T* begin() const { return mData; }
+  const T* end() const { return mData + mSize; }
+  const T& operator[](size_t i) const { return mData[i]; }
+
+ private:
+  const T* mData = nullptr;
+  size_t mSize = 0;
+};
+
+namespace flat_detail
+{
+template <typename F>
+struct VariableField : std::false_type {
+};
+template <typename U, typename A>
+struct VariableField<std::vector<U, A>> : std::true_type {
+  using item_type = U;
+};
+template <typename C, typename Tr, typename A>
+struct VariableField<std::basic_string<C, Tr, A>> : std::true_type {
+  using item_type = C;
+};
+
+template <typename T>
+using FieldTuple = decltype(T::flatFields(std::declval<T&>()));
+template <typename T, size_t I>
+using FieldType = std::remove_cv_t<std::remove_reference_t<std::tuple_element_t<I, FieldTuple<T>>>>;
+
+template <typename T, typename = void>
+struct SchemaVersion : std::integral_constant<uint16_t, 0> {
+};
+template <typename T>
+struct SchemaVersion<T, std::void_t<decltype(T::FlatVersion)>> : std::integral_constant<uint16_t, T::FlatVersion> {
+};
+
+constexpr uint64_t align(uint64_t size) { return (size + 7) & ~uint64_t(7); }
+
+template <typename F>
+FlatColumnHeader describe()
+{
+  FlatColumnHeader column;
+  if constexpr (VariableField<F>::value) {
+    using Item = typename VariableField<F>::item_type;
+    static_assert(std::is_trivially_copyable<Item>::value, "the items of a variable field must be trivially copyable");
+    column.kind = FlatColumnHeader::Variable;
+    column.elementSize = sizeof(Item);
+  } else {
+    static_assert(std::is_trivially_copyable<F>::value, "a fixed field must be trivially copyable");
+    column.kind = FlatColumnHeader::Fixed;
+    column.elementSize = sizeof(F);
+  }
+  return column;
+}
+
+template <size_t N, typename Function, size_t... I>
+void forEachColumn(Function&& function, std::index_sequence<I...>)
+{
+  (function(std::integral_constant<size_t, I>{}), ...);
+}
+template <size_t N, typename Function>
+void forEachColumn(Function&& function)
+{
+  forEachColumn<N>(std::forward<Function>(function), std::make_index_sequence<N>{});
+}
+
+template <typename T, size_t I, typename ContT>
+uint64_t columnSize(const ContT& data)
+{
+  using F = FieldType<T, I>;
+  if constexpr (VariableField<F>::value) {
+    uint64_t nItems = 0;
+    for (const auto& entry : data) {
+      nItems += std::get<I>(T::flatFields(entry)).size();
+    }
+    return align((data.size() + 1) * sizeof(uint64_t) + nItems * sizeof(typename VariableField<F>::item_type));
+  } else {
+    return align(data.size() * sizeof(F));
+  }
+}
+
+template <typename T, size_t I, typename ContT>
+void writeColumn(const ContT& data, char* column)
+{
+  using F = FieldType<T, I>;
+  if constexpr (VariableField<F>::value) {
+    using Item = typename VariableField<F>::item_type;
+    char* items = column + (data.size() + 1) * sizeof(uint64_t);
+    uint64_t offset = 0;
+    for (const auto& entry : data) {
+      const auto& field = std::get<I>(T::flatFields(entry));
+      std::memcpy(column, &offset, sizeof(offset));
+      if (!field.empty()) {
+        std::memcpy(items + offset * sizeof(Item), field.data(), field.size() * sizeof(Item));
+      }
+      column += sizeof(offset);
+      offset += field.size();
+    }
+    std::memcpy(column, &offset, sizeof(offset));
+  } else {
+    for (const auto& entry : data) {
+      std::memcpy(column, &std::get<I>(T::flatFields(entry)), sizeof(F));
+      column += sizeof(F);
+    }
+  }
+}
+} // namespace flat_detail
+
+/// whether the struct T lists its fields with a static flatFields
+template <typename T, typename = void>
+struct is_flat_serializable : std::false_type {
+};
+template <typename T>
+struct is_flat_serializable<T, std::void_t<flat_detail::FieldTuple<T>>> : std::true_type {
+};
+
+/// column in the buffer of the field type F, values of a fixed field
+template <typename F, bool Variable = flat_detail::VariableField<F>::value>
+class FlatColumn : public FlatSpan<F>
+{
+ public:
+  using FlatSpan<F>::FlatSpan;
+};
+
+/// column in the buffer of a variable field, with the items of each entry as a FlatSpan
+template <typename F>
+class FlatColumn<F, true>
+{
+ public:
+  using item_type = typename flat_detail::VariableField<F>::item_type;
+
+  FlatColumn() = default;
+  FlatColumn(const uint64_t* offsets, const item_type* items, size_t size) : mOffsets(offsets), mItems(items), mSize(size) {}
+
+  size_t size() const { return mSize; }
+  bool empty() const { return mSize == 0; }
+  FlatSpan<item_type> operator[](size_t i) const { return { mItems + mOffsets[i], size_t(mOffsets[i + 1] - mOffsets[i]) }; }
+  /// items of all the entries
+  FlatSpan<item_type> items() const { return { mItems, mSize ? size_t(mOffsets[mSize]) : 0 }; }
+
+ private:
+  const uint64_t* mOffsets = nullptr;
+  const item_type* mItems = nullptr;
+  size_t mSize = 0;
+};
+
+/// size of the flat serialization of the container
+template <typename ContT>
+size_t FlatSerializedSize(const ContT& data)
+{
+  using T = typename ContT::value_type;
+  static_assert(is_flat_serializable<T>::value, "the value type provides no flatFields");
+  constexpr size_t NColumns = std::tuple_size<flat_detail::FieldTuple<T>>::value;
+  uint64_t size = flat_detail::align(sizeof(FlatHeader) + NColumns * sizeof(FlatColumnHeader));
+  flat_detail::forEachColumn<NColumns>([&](auto column) {
+    size += flat_detail::columnSize<T, decltype(column)::value>(data);
+  });
+  return size;
+}
+
+/// Serialises the container (vector, array or list) of a struct with flatFields into the buffer,
+/// which must be at least FlatSerializedSize(data) long and aligned to 8 bytes.
+/// @return the number of bytes written
+template <typename ContT>
+size_t FlatSerialize(const ContT& data, char* buffer, size_t size)
+{
+  using T = typename ContT::value_type;
+  static_assert(is_flat_serializable<T>::value, "the value type provides no flatFields");
+  constexpr size_t NColumns = std::tuple_size<flat_detail::FieldTuple<T>>::value;
+
+  FlatHeader header;
+  header.schemaVersion = flat_detail::SchemaVersion<T>::value;
+  header.nColumns = NColumns;
+  header.nEntries = data.size();
+  uint64_t offset = flat_detail::align(sizeof(FlatHeader) + NColumns * sizeof(FlatColumnHeader));
+  if (size < offset) {
+    throw std::length_error("FlatSerialize: buffer of " + std::to_string(size) + " bytes too short");
+  }
+  std::memcpy(buffer, &header, sizeof(header));
+  flat_detail::forEachColumn<NColumns>([&](auto index) {
+    constexpr size_t I = decltype(index)::value;
+    auto column = flat_detail::describe<flat_detail::FieldType<T, I>>();
+    column.offset = offset;
+    column.size = flat_detail::columnSize<T, I>(data);
+    if (size < offset + column.size) {
+      throw std::length_error("FlatSerialize: buffer of " + std::to_string(size) + " bytes too short");
+    }
+    std::memcpy(buffer + sizeof(FlatHeader) + I * sizeof(FlatColumnHeader), &column, sizeof(column));
+    if (column.size) {
+      std::memset(buffer + offset + column.size - 8, 0, 8); // padding
+    }
+    flat_detail::writeColumn<T, I>(data, buffer + offset);
+    offset += column.size;
+  });
+  return offset;
+}
+
+template <typename ContT>
+std::vector<char> FlatSerialize(const ContT& data)
+{
+  /// Serialises the container in a new buffer
+  std::vector<char> buffer(FlatSerializedSize(data));
+  FlatSerialize(data, buffer.data(), buffer.size());
+  return buffer;
+}
+
+/// Read only view of a flat serialized container of T: the columns are accessed in place in the
+/// buffer, which must outlive the view. The entries can also be extracted by copy.
+template <typename T>
+class FlatView
+{
+ public:
+  using value_type = T;
+  static_assert(is_flat_serializable<T>::value, "the value type provides no flatFields");
+  static constexpr size_t NColumns = std::tuple_size<flat_detail::FieldTuple<T>>::value;
+  template <size_t I>
+  using field_type = flat_detail::FieldType<T, I>;
+
+  FlatView() = default;
+  /// throws std::runtime_error if the buffer is not a flat serialization compatible with T
+  FlatView(const char* buffer, size_t size);
+
+  size_t size() const { return mNEntries; }
+  bool empty() const { return mNEntries == 0; }
+  /// FlatVersion of the writer
+  uint16_t schemaVersion() const { return mSchemaVersion; }
+  /// whether the buffer has the column of field i, false for the fields appended after the writer version
+  bool hasColumn(size_t i) const { return i < mNColumns; }
+
+  /// column of the field I, throws std::out_of_range if not in the buffer
+  template <size_t I>
+  FlatColumn<field_type<I>> column() const;
+
+  /// copy of the entry i, the fields missing in the buffer being value initialized
+  T operator[](size_t i) const;
+
+  /// copy of all the entries
+  std::vector<T> materialize() const;
+
+ private:
+  template <typename F>
+  static void readField(F& field, const FlatColumn<F>& column, size_t i);
+
+  const char* mBuffer = nullptr;
+  uint64_t mNEntries = 0;
+  uint32_t mNColumns = 0; ///< columns of T in the buffer
+  uint16_t mSchemaVersion = 0;
+  std::array<uint64_t, NColumns> mOffsets{};
+};
+
+template <typename T>
+FlatView<T>::FlatView(const char* buffer, size_t size) : mBuffer(buffer)
+{
+  FlatHeader header;
+  if (size < sizeof(header)) {
+    throw std::runtime_error("FlatView: buffer of " + std::to_string(size) + " bytes too short");
+  }
+  std::memcpy(&header, buffer, sizeof(header));
+  if (header.magic != FlatHeader::Magic || header.layoutVersion != FlatHeader::LayoutVersion) {
+    throw std::runtime_error("FlatView: not a flat serialized buffer of layout version " +
+                             std::to_string(FlatHeader::LayoutVersion));
+  }
+  if (size < sizeof(header) + uint64_t(header.nColumns) * sizeof(FlatColumnHeader)) {
+    throw std::runtime_error("FlatView: truncated column headers");
+  }
+  mNEntries = header.nEntries;
+  mSchemaVersion = header.schemaVersion;
+  mNColumns = std::min<uint32_t>(header.nColumns, NColumns);
+  flat_detail::forEachColumn<NColumns>([&](auto index) {
+    constexpr size_t I = decltype(index)::value;
+    if (I >= mNColumns) {
+      return;
+    }
+    FlatColumnHeader column;
+    std::memcpy(&column, buffer + sizeof(FlatHeader) + I * sizeof(FlatColumnHeader), sizeof(column));
+    auto expected = flat_detail::describe<field_type<I>>();
+    if (column.kind != expected.kind || column.elementSize != expected.elementSize) {
+      throw std::runtime_error("FlatView: incompatible column " + std::to_string(I) + " of schema version " +
+                               std::to_string(mSchemaVersion));
+    }
+    uint64_t minSize = mNEntries * column.elementSize;
+    if (column.kind == FlatColumnHeader::Variable) {
+      minSize = (mNEntries + 1) * sizeof(uint64_t);
+    }
+    if (column.offset % 8 || column.offset + column.size > size || column.size < minSize) {
+      throw std::runtime_error("FlatView: column " + std::to_string(I) + " out of the buffer");
+    }
+    if (column.kind == FlatColumnHeader::Variable) {
+      uint64_t nItems;
+      std::memcpy(&nItems, buffer + column.offset + mNEntries * sizeof(uint64_t), sizeof(nItems));
+      if (minSize + nItems * column.elementSize > column.size) {
+        throw std::runtime_error("FlatView: items of column " + std::to_string(I) + " out of the buffer");
+      }
+    }
+    mOffsets[I] = column.offset;
+  });
+}
+
+template <typename T>
+template <size_t I>
+FlatColumn<flat_detail::FieldType<T, I>> FlatView<T>::column() const
+{
+  using F = field_type<I>;
+  if (I >= mNColumns) {
+    throw std::out_of_range("FlatView: no column " + std::to_string(I) + " in schema version " +
+                            std::to_string(mSchemaVersion));
+  }
+  const char* column = mBuffer + mOffsets[I];
+  if constexpr (flat_detail::VariableField<F>::value) {
+    using Item = typename flat_detail::VariableField<F>::item_type;
+    return { reinterpret_cast<const uint64_t*>(column),
+             reinterpret_cast<const Item*>(column + (mNEntries + 1) * sizeof(uint64_t)), mNEntries };
+  } else {
+    return { reinterpret_cast<const F*>(column), mNEntries };
+  }
+}
+
+template <typename T>
+template <typename F>
+void FlatView<T>::readField(F& field, const FlatColumn<F>& column, size_t i)
+{
+  if constexpr (flat_detail::VariableField<F>::value) {
+    auto items = column[i];
+    field.assign(items.begin(), items.end());
+  } else {
+    std::memcpy(&field, &column[i], sizeof(field));
+  }
+}
+
+template <typename T>
+T FlatView<T>::operator[](size_t i) const
+{
+  T entry{};
+  flat_detail::forEachColumn<NColumns>([&](auto index) {
+    constexpr size_t I = decltype(index)::value;
+    if (I < mNColumns) {
+      readField(std::get<I>(T::flatFields(entry)), column<I>(), i);
+    }
+  });
+  return entry;
+}
+
+template <typename T>
+std::vector<T> FlatView<T>::materialize() const
+{
+  std::vector<T> entries(mNEntries);
+  flat_detail::forEachColumn<NColumns>([&](auto index) {
+    constexpr size_t I = decltype(index)::value;
+    if (I < mNColumns) {
+      auto values = column<I>();
+      for (size_t i = 0; i < entries.size(); ++i) {
+        readField(std::get<I>(T::flatFields(entries[i])), values, i);
+      }
+    }
+  });
+  return entries;
+}
+
+template <typename T>
+std::vector<T> FlatDeserialize(const char* buffer, size_t size)
+{
+  /// Deserialises a flat serialized buffer in a vector of the provided type
+  return FlatView<T>(buffer, size).materialize();
+}
+
+} // namespace utils
+} // namespace o2
+
+#endif // ALICEO2_COMMONUTILS_FLATSERIALIZER_H_
@@ -19,7 +19,10 @@
 #define COMMON_UTILS_INCLUDE_COMMONUTILS_RNGHELPER_H_
 
 #include <TRandom.h>
+#include <cstdint>
 #include <fcntl.h>
+#include <unistd.h>
+#include "MathUtils/RandomStream.h"
 
 namespace o2
 {
@@ -40,6 +43,16 @@ class RngHelper
     return s;
   }
 
+  // the random stream of one unit of work of a production, e.g. the digitization of one event
+  // (entry of a source) by one detector. The stream only depends on the seed of the production and on
+  // the ids of the unit, not on the worker, thread or order processing it, so that the results are
+  // reproducible whatever the parallelism; distinct ids give independent streams
+  static o2::math_utils::RandomStream getStream(uint64_t seed, uint32_t event, uint32_t source, uint32_t unit)
+  {
+    uint64_t id = mix(mix(mix(seed) ^ event) ^ (uint64_t(source) << 32 | unit));
+    return o2::math_utils::RandomStream(mix(id ^ seed), id >> 1);
+  }
+
   // static function to get a true random number from /dev/urandom
   template <typename T>
   static T readURandom()
@@ -58,6 +71,15 @@ class RngHelper
     }
     return T(0);
   }
+
+ private:
+  // the splitmix64 finalizer, to turn related ids into unrelated seeds and streams
+  static uint64_t mix(uint64_t x)
+  {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
 };
 
 } // namespace utils
@@ -19,7 +19,9 @@
 #define COMMON_UTILS_INCLUDE_COMMONUTILS_SHMMANAGER_H_
 
 #include <list>
+#include <atomic>
 #include <cstddef>
+#include <mutex>
 
 #include <boost/interprocess/managed_external_buffer.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
@@ -33,6 +35,16 @@ namespace utils
 
 // the size dedicated to each attached worker/process
 constexpr size_t SHMPOOLSIZE = 1024 * 1024 * 1024; // 1 GB
+// each pool starts with its ShmPoolInfo, padded to a cache line
+constexpr size_t SHMPOOLHEADERSIZE = 64;
+
+// allocations up to this size (header included) are served from thread local free lists;
+// larger ones go directly to the boost allocator of the pool
+constexpr size_t SHMMAXSMALLBLOCK = 128 * 1024;
+// size of the chunks each thread carves from the pool to serve its small allocations
+constexpr size_t SHMARENASIZE = 4 * 1024 * 1024;
+// number of size classes: 32, 48, 64 bytes, then 4 classes per power of two up to SHMMAXSMALLBLOCK
+constexpr int SHMNSIZECLASSES = 47;
 
 // some meta info stored at the beginning of the global shared mem segment
 struct ShmMetaInfo {
@@ -40,6 +52,29 @@ struct ShmMetaInfo {
   std::atomic<int> counter = 0; // atomic counter .. counter number of attached processes
                                 // and used to assign a subregion to the attached processes
   std::atomic<int> failures = 0;
+  int nsegments = 0; // number of subregions (pools) in the segment
+};
+
+// some meta info stored at the beginning of each pool; filled by the worker occupying it
+// and readable by everyone attached. Only updated when memory is taken from the pool
+// (arenas and large blocks) so that the small allocations do not touch shared cache lines
+struct ShmPoolInfo {
+  int pid = -1;      // process occupying the pool
+  int numanode = -1; // NUMA node on which the pool was occupied
+  std::atomic<unsigned long long> arenabytes = 0; // bytes carved as thread arenas
+  std::atomic<unsigned long long> largebytes = 0; // bytes currently in large blocks
+  std::atomic<unsigned long long> nlarge = 0;     // number of large block allocations
+};
+
+// allocation statistics of one thread (or of the finished threads) of this process
+struct ShmAllocStats {
+  std::atomic<unsigned long long> nallocs = 0;    // number of getmemblock calls
+  std::atomic<unsigned long long> nfrees = 0;     // number of freememblock calls
+  std::atomic<unsigned long long> nrecycled = 0;  // small allocations served from a free list
+  std::atomic<unsigned long long> nlarge = 0;     // allocations sent to the boost allocator
+  std::atomic<unsigned long long> smallbytes = 0; // bytes currently in small blocks (size class)
+
+  void add(ShmAllocStats const& other);
 };
 
 // Class creating -- or attaching to -- a shared memory pool
@@ -81,7 +116,7 @@ class ShmManager
   // returns if pointer is part of the shm region under control of this manager
   bool isPointerOk(void* ptr) const
   {
-    return mBufferPtr && getPointerOffset(ptr) < SHMPOOLSIZE;
+    return mBufferPtr && getPointerOffset(ptr) < SHMPOOLSIZE - SHMPOOLHEADERSIZE;
   }
 
   // returns if shared mem setup is correctly setup/operational
@@ -96,8 +131,25 @@ class ShmManager
     };
   }
 
+  // logs the workers attached, the pools occupied and the allocation statistics of this process
   void printSegInfo() const;
 
+  // size class serving an allocation of size bytes (header included), up to SHMMAXSMALLBLOCK
+  static int sizeClass(size_t size);
+  // size in bytes of the blocks of a size class
+  static size_t classSize(int sizeclass);
+
+  // the free lists of one thread; handed over to the depot when the thread finishes.
+  // The blocks stay in the pool of this process whichever thread frees them
+  struct ThreadCache {
+    void* freelists[SHMNSIZECLASSES] = {};
+    char* arenaptr = nullptr;
+    char* arenaend = nullptr;
+    ShmAllocStats stats;
+    ThreadCache();
+    ~ThreadCache();
+  };
+
  private:
   ShmManager();
   ~ShmManager();
@@ -110,6 +162,18 @@ class ShmManager
   // helper function
   void* tryAttach(bool& success);
   size_t getPointerOffset(void* ptr) const { return (size_t)((char*)ptr - (char*)mBufferPtr); }
+  ShmPoolInfo* getPoolInfo(int pool) const;
+  void* allocateFromPool(size_t size);
+  void* allocateSmall(ThreadCache& cache, int sizeclass);
+
+  ShmPoolInfo* mPoolInfoPtr = nullptr; // meta information of the pool occupied by this process
+  std::mutex mPoolMutex;               // serializes the accesses to the boost allocator
+
+  // free lists of the finished threads and statistics of this process
+  mutable std::mutex mCacheMutex;
+  void* mDepot[SHMNSIZECLASSES] = {};
+  std::list<ThreadCache*> mCaches;
+  ShmAllocStats mRetiredStats;
 
   boost::interprocess::wmanaged_external_buffer* boostmanagedbuffer;
   boost::interprocess::allocator<char, boost::interprocess::wmanaged_external_buffer::segment_manager>* boostallocator;
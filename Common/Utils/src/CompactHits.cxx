@@ -0,0 +1,233 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CompactHits.cxx
+/// \brief Encoding of the columns of the compact hit format
+
+#include "CommonUtils/CompactHits.h"
+#include <cmath>
+
+namespace o2
+{
+namespace utils
+{
+
+namespace
+{
+// layout of the buffer: header, then the fixed columns (precision, number of values, number of bytes,
+// bytes), the raw columns (number of values, words) and the integer columns (number of values, number
+// of bytes, bytes); all in the byte order of the machine
+constexpr uint32_t Magic = 0x54484331; // "1CHT"
+
+struct Header {
+  uint32_t magic = Magic;
+  uint32_t nFixed = 0;
+  uint32_t nRaw = 0;
+  uint32_t nInt = 0;
+};
+
+template <typename T>
+void put(std::vector<char>& buffer, T value)
+{
+  auto pos = buffer.size();
+  buffer.resize(pos + sizeof(T));
+  std::memcpy(buffer.data() + pos, &value, sizeof(T));
+}
+
+// reads the buffer, remembering if it ran past the end
+struct Reader {
+  const char* pos;
+  const char* end;
+  bool ok = true;
+
+  template <typename T>
+  T get()
+  {
+    T value{};
+    if (size_t(end - pos) < sizeof(T)) {
+      ok = false;
+      pos = end;
+      return value;
+    }
+    std::memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+};
+
+// differences to the previous values, zigzag encoded (small magnitudes of both signs to small numbers)
+void toZigzagDeltas(const int64_t* values, uint64_t* deltas, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {
+    const int64_t previous = i > 0 ? values[i - 1] : 0;
+    const int64_t delta = values[i] - previous;
+    deltas[i] = (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+  }
+}
+
+// inverse of toZigzagDeltas
+void fromZigzagDeltas(const uint64_t* deltas, int64_t* values, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {
+    values[i] = int64_t(deltas[i] >> 1) ^ -int64_t(deltas[i] & 1);
+  }
+  for (size_t i = 1; i < n; i++) {
+    values[i] += values[i - 1];
+  }
+}
+
+// number of bytes, then the numbers with 7 bits per byte, the high bit marking a following byte
+void putVarints(std::vector<char>& buffer, const uint64_t* values, size_t n)
+{
+  const auto sizePos = buffer.size();
+  put<uint32_t>(buffer, 0);
+  const auto start = buffer.size();
+  buffer.reserve(start + 2 * n);
+  for (size_t i = 0; i < n; i++) {
+    uint64_t v = values[i];
+    while (v >= 0x80) {
+      buffer.push_back(char(v | 0x80));
+      v >>= 7;
+    }
+    buffer.push_back(char(v));
+  }
+  const uint32_t nBytes = buffer.size() - start;
+  std::memcpy(buffer.data() + sizePos, &nBytes, sizeof(nBytes));
+}
+
+bool getVarints(Reader& reader, uint64_t* values, size_t n)
+{
+  const auto nBytes = reader.get<uint32_t>();
+  if (!reader.ok || size_t(reader.end - reader.pos) < nBytes) {
+    return false;
+  }
+  auto pos = reinterpret_cast<const unsigned char*>(reader.pos);
+  const auto end = pos + nBytes;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t v = 0;
+    int shift = 0;
+    do {
+      if (pos == end || shift > 63) {
+        return false;
+      }
+      v |= uint64_t(*pos & 0x7f) << shift;
+      shift += 7;
+    } while (*pos++ & 0x80);
+    values[i] = v;
+  }
+  reader.pos += nBytes;
+  return pos == end;
+}
+} // namespace
+
+void encodeHitColumns(HitColumns const& columns, std::vector<char>& buffer)
+{
+  buffer.clear();
+  Header header;
+  header.nFixed = columns.fixed.size();
+  header.nRaw = columns.raw.size();
+  header.nInt = columns.ints.size();
+  put(buffer, header);
+
+  std::vector<int64_t> values;
+  std::vector<uint64_t> deltas;
+  for (auto& column : columns.fixed) {
+    const size_t n = column.values.size();
+    values.resize(n);
+    deltas.resize(n);
+    const double scale = 1. / column.precision;
+    for (size_t i = 0; i < n; i++) {
+      values[i] = std::llround(column.values[i] * scale);
+    }
+    toZigzagDeltas(values.data(), deltas.data(), n);
+    put(buffer, column.precision);
+    put<uint32_t>(buffer, n);
+    putVarints(buffer, deltas.data(), n);
+  }
+  for (auto& column : columns.raw) {
+    put<uint32_t>(buffer, column.size());
+    const auto pos = buffer.size();
+    buffer.resize(pos + column.size() * sizeof(uint32_t));
+    std::memcpy(buffer.data() + pos, column.data(), column.size() * sizeof(uint32_t));
+  }
+  for (auto& column : columns.ints) {
+    const size_t n = column.size();
+    values.assign(column.begin(), column.end());
+    deltas.resize(n);
+    toZigzagDeltas(values.data(), deltas.data(), n);
+    put<uint32_t>(buffer, n);
+    putVarints(buffer, deltas.data(), n);
+  }
+}
+
+bool decodeHitColumns(const char* buffer, size_t size, HitColumns& columns)
+{
+  Reader reader{ buffer, buffer + size };
+  const auto header = reader.get<Header>();
+  if (!reader.ok || header.magic != Magic) {
+    return false;
+  }
+  columns.resize(header.nFixed, header.nRaw, header.nInt);
+
+  std::vector<int64_t> values;
+  std::vector<uint64_t> deltas;
+  // the number of values of a column must fit into the rest of the buffer, at least one byte each
+  auto getCount = [&reader](size_t bytesPerValue) {
+    const size_t n = reader.get<uint32_t>();
+    if (n > size_t(reader.end - reader.pos) / bytesPerValue) {
+      reader.ok = false;
+    }
+    return n;
+  };
+  for (auto& column : columns.fixed) {
+    column.precision = reader.get<float>();
+    const size_t n = getCount(1);
+    if (!reader.ok) {
+      return false;
+    }
+    deltas.resize(n);
+    values.resize(n);
+    if (!getVarints(reader, deltas.data(), n)) {
+      return false;
+    }
+    fromZigzagDeltas(deltas.data(), values.data(), n);
+    column.values.resize(n);
+    const double precision = column.precision;
+    for (size_t i = 0; i < n; i++) {
+      column.values[i] = values[i] * precision;
+    }
+  }
+  for (auto& column : columns.raw) {
+    const size_t n = getCount(sizeof(uint32_t));
+    if (!reader.ok) {
+      return false;
+    }
+    column.resize(n);
+    std::memcpy(column.data(), reader.pos, n * sizeof(uint32_t));
+    reader.pos += n * sizeof(uint32_t);
+  }
+  for (auto& column : columns.ints) {
+    const size_t n = getCount(1);
+    if (!reader.ok) {
+      return false;
+    }
+    deltas.resize(n);
+    values.resize(n);
+    if (!getVarints(reader, deltas.data(), n)) {
+      return false;
+    }
+    fromZigzagDeltas(deltas.data(), values.data(), n);
+    column.assign(values.begin(), values.end());
+  }
+  return reader.pos == reader.end;
+}
+
+} // namespace utils
+} // namespace o2
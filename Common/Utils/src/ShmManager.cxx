@@ -20,7 +20,11 @@
 #include <fairlogger/Logger.h>
 #include <sys/shm.h>
 #include <sys/ipc.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
 #include <algorithm>
+#include <cstring>
 
 #include <boost/interprocess/managed_external_buffer.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
@@ -40,8 +44,109 @@ const char* SHMIDNAME = "ALICEO2_SIMSHM_SHMID";
 // a common virtual address under which this should be mapped
 const char* SHMADDRNAME = "ALICEO2_SIMSHM_COMMONADDR";
 
+namespace
+{
+// the pools start after the ShmMetaInfo, padded to a cache line to keep the alignment
+// required by the boost allocators
+constexpr size_t METAINFOSIZE = 64;
+static_assert(sizeof(ShmMetaInfo) <= METAINFOSIZE, "ShmMetaInfo does not fit the segment header");
+static_assert(sizeof(ShmPoolInfo) <= SHMPOOLHEADERSIZE, "ShmPoolInfo does not fit the pool header");
+constexpr size_t BUFFERSIZE = SHMPOOLSIZE - SHMPOOLHEADERSIZE;
+
+// the header preceding every block given out by getmemblock; keeps the 16 byte alignment
+struct BlockHeader {
+  unsigned int sizeclass; // SHMNSIZECLASSES for the large blocks
+  unsigned int magic;
+  union {
+    size_t size;       // size of a large block
+    BlockHeader* next; // next block in a free list
+  };
+};
+static_assert(sizeof(BlockHeader) == 16, "BlockHeader has to keep the alignment");
+constexpr unsigned int BLOCKMAGIC = 0x5348u;
+
+int currentNumaNode()
+{
+  unsigned int cpu = 0, node = 0;
+#ifdef SYS_getcpu
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return -1;
+}
+} // namespace
+
+void ShmAllocStats::add(ShmAllocStats const& other)
+{
+  nallocs += other.nallocs;
+  nfrees += other.nfrees;
+  nrecycled += other.nrecycled;
+  nlarge += other.nlarge;
+  smallbytes += other.smallbytes;
+}
+
+int ShmManager::sizeClass(size_t size)
+{
+  if (size <= 64) {
+    return size <= 32 ? 0 : (size - 1) / 16 - 1;
+  }
+  // 4 classes per power of two: 2^l + k * 2^(l-2), k = 1..4
+  const size_t x = size - 1;
+  const int l = 63 - __builtin_clzll(x);
+  const int k = (x - (1ull << l)) >> (l - 2);
+  return 3 + (l - 6) * 4 + k;
+}
+
+size_t ShmManager::classSize(int sizeclass)
+{
+  if (sizeclass < 3) {
+    return (sizeclass + 2) * 16;
+  }
+  const int l = (sizeclass - 3) / 4 + 6;
+  const int k = (sizeclass - 3) % 4;
+  return (1ull << l) + (k + 1) * (1ull << (l - 2));
+}
+
+// one cache per thread, registered with the manager to collect the statistics
+thread_local ShmManager::ThreadCache tShmCache;
+
+ShmManager::ThreadCache::ThreadCache()
+{
+  auto& manager = ShmManager::Instance();
+  std::lock_guard<std::mutex> lock(manager.mCacheMutex);
+  manager.mCaches.push_back(this);
+}
+
+ShmManager::ThreadCache::~ThreadCache()
+{
+  // the free blocks go to the depot so that other threads can reuse them;
+  // the rest of the arena is lost
+  auto& manager = ShmManager::Instance();
+  std::lock_guard<std::mutex> lock(manager.mCacheMutex);
+  for (int c = 0; c < SHMNSIZECLASSES; ++c) {
+    auto head = static_cast<BlockHeader*>(freelists[c]);
+    if (!head) {
+      continue;
+    }
+    auto tail = head;
+    while (tail->next) {
+      tail = tail->next;
+    }
+    tail->next = static_cast<BlockHeader*>(manager.mDepot[c]);
+    manager.mDepot[c] = head;
+  }
+  manager.mRetiredStats.add(stats);
+  manager.mCaches.remove(this);
+}
+
 ShmManager::ShmManager() = default;
 
+ShmPoolInfo* ShmManager::getPoolInfo(int pool) const
+{
+  return reinterpret_cast<ShmPoolInfo*>((char*)mSegPtr + METAINFOSIZE + pool * SHMPOOLSIZE);
+}
+
 void* ShmManager::tryAttach(bool& success)
 {
   success = false;
@@ -98,6 +203,28 @@ void ShmManager::printSegInfo() const
   if (mSegInfoPtr) {
     LOG(INFO) << "ATTACHED WORKERS " << mSegInfoPtr->counter;
     LOG(INFO) << "CONNECTION FAILURES " << mSegInfoPtr->failures;
+    const int npools = std::min(mSegInfoPtr->counter.load(), mSegInfoPtr->nsegments);
+    for (int pool = 0; pool < npools; ++pool) {
+      auto poolinfo = getPoolInfo(pool);
+      LOG(INFO) << "POOL " << pool << " PID " << poolinfo->pid << " NUMA NODE " << poolinfo->numanode
+                << " ARENA BYTES " << poolinfo->arenabytes << " LARGE BYTES " << poolinfo->largebytes
+                << " LARGE ALLOCATIONS " << poolinfo->nlarge;
+    }
+    if (mPoolInfoPtr) {
+      ShmAllocStats stats;
+      int nthreads = 0;
+      {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        stats.add(mRetiredStats);
+        for (auto cache : mCaches) {
+          stats.add(cache->stats);
+          nthreads++;
+        }
+      }
+      LOG(INFO) << "ALLOCATIONS " << stats.nallocs << " FREES " << stats.nfrees << " FROM FREE LISTS "
+                << stats.nrecycled << " LARGE " << stats.nlarge << " SMALL BYTES " << stats.smallbytes
+                << " THREADS " << nthreads;
+    }
   } else {
     LOG(INFO) << "no segment info to print";
   }
@@ -121,7 +248,7 @@ bool ShmManager::createGlobalSegment(int nsegments)
   LOG(INFO) << "CREATING SIM SHARED MEM SEGMENT FOR " << nsegments << " WORKERS";
 #ifdef USESHM
   // LOG(INFO) << "SIZEOF ShmMetaInfo " << sizeof(ShmMetaInfo);
-  const auto totalsize = sizeof(ShmMetaInfo) + SHMPOOLSIZE * nsegments;
+  const auto totalsize = METAINFOSIZE + SHMPOOLSIZE * nsegments;
   if ((mShmID = shmget(IPC_PRIVATE, totalsize, IPC_CREAT | 0666)) == -1) {
     perror("shmget: shmget failed");
   } else {
@@ -136,6 +263,7 @@ bool ShmManager::createGlobalSegment(int nsegments)
     std::memcpy(addr, &info, sizeof(info));
     mSegInfoPtr = static_cast<o2::utils::ShmMetaInfo*>(mSegPtr);
     mSegInfoPtr->allocedbytes = totalsize;
+    mSegInfoPtr->nsegments = nsegments;
 
     // communicating information about this segment via
     // an environment variable
@@ -195,12 +323,22 @@ void ShmManager::occupySegment()
     const int segmentcounter = info->counter.fetch_add(1);
     LOG(INFO) << "SEGMENTCOUNT " << segmentcounter;
 
-    const auto offset_in_bytes = sizeof(ShmMetaInfo) + segmentcounter * SHMPOOLSIZE;
-    mBufferPtr = (void*)(((char*)addr) + offset_in_bytes);
+    if (segmentcounter >= info->nsegments) {
+      LOG(WARN) << "NO FREE SUBREGION LEFT FOR THIS WORKER";
+      info->failures.fetch_add(1);
+      return;
+    }
+
+    // the pool pages are first touched from here and from the threads of this process,
+    // hence they are placed on the NUMA node(s) of this worker and not of the master
+    mPoolInfoPtr = new (getPoolInfo(segmentcounter)) ShmPoolInfo;
+    mPoolInfoPtr->pid = getpid();
+    mPoolInfoPtr->numanode = currentNumaNode();
+    mBufferPtr = (void*)((char*)mPoolInfoPtr + SHMPOOLHEADERSIZE);
 
-    assert((unsigned long long)((char*)mBufferPtr - (char*)addr) + SHMPOOLSIZE <= info->allocedbytes);
+    assert((unsigned long long)((char*)mBufferPtr - (char*)addr) + BUFFERSIZE <= info->allocedbytes);
 
-    boostmanagedbuffer = new boost::interprocess::wmanaged_external_buffer(create_only, mBufferPtr, SHMPOOLSIZE);
+    boostmanagedbuffer = new boost::interprocess::wmanaged_external_buffer(create_only, mBufferPtr, BUFFERSIZE);
     boostallocator = new boost::interprocess::allocator<char, wmanaged_external_buffer::segment_manager>(
       boostmanagedbuffer->get_segment_manager());
 
@@ -215,11 +353,11 @@ ShmManager::~ShmManager()
   release();
 }
 
-// This implements a very malloc/free mechanism ...
-// ... but we are using available boost functionality
-void* ShmManager::getmemblock(size_t size)
+void* ShmManager::allocateFromPool(size_t size)
 {
   void* addr = nullptr;
+  // the managed buffer is not thread safe (null_mutex_family)
+  std::lock_guard<std::mutex> lock(mPoolMutex);
   try {
     addr = (void*)boostallocator->allocate(size).get();
   } catch (const std::exception& e) {
@@ -228,9 +366,83 @@ void* ShmManager::getmemblock(size_t size)
   return addr;
 }
 
-void ShmManager::freememblock(void* ptr, size_t s)
+void* ShmManager::allocateSmall(ThreadCache& cache, int sizeclass)
+{
+  // 1. the free list of this thread
+  if (auto block = static_cast<BlockHeader*>(cache.freelists[sizeclass])) {
+    cache.freelists[sizeclass] = block->next;
+    cache.stats.nrecycled.fetch_add(1, std::memory_order_relaxed);
+    return block;
+  }
+  // 2. the blocks left by the finished threads
+  {
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    if (auto block = static_cast<BlockHeader*>(mDepot[sizeclass])) {
+      mDepot[sizeclass] = nullptr;
+      cache.freelists[sizeclass] = block->next;
+      cache.stats.nrecycled.fetch_add(1, std::memory_order_relaxed);
+      return block;
+    }
+  }
+  // 3. the arena of this thread, to be renewed from the pool when exhausted
+  const auto size = classSize(sizeclass);
+  if (cache.arenaptr + size > cache.arenaend) {
+    cache.arenaptr = static_cast<char*>(allocateFromPool(SHMARENASIZE));
+    cache.arenaend = cache.arenaptr + SHMARENASIZE;
+    mPoolInfoPtr->arenabytes.fetch_add(SHMARENASIZE, std::memory_order_relaxed);
+  }
+  auto block = cache.arenaptr;
+  cache.arenaptr += size;
+  return block;
+}
+
+// This implements a very malloc/free mechanism ...
+// small blocks come from size class free lists and arenas local to each thread,
+// large blocks from the boost allocator of the pool of this worker
+void* ShmManager::getmemblock(size_t size)
+{
+  auto& cache = tShmCache;
+  cache.stats.nallocs.fetch_add(1, std::memory_order_relaxed);
+  const auto total = size + sizeof(BlockHeader);
+  BlockHeader* header;
+  if (total <= SHMMAXSMALLBLOCK) {
+    const int sizeclass = sizeClass(total);
+    header = static_cast<BlockHeader*>(allocateSmall(cache, sizeclass));
+    header->sizeclass = sizeclass;
+    cache.stats.smallbytes.fetch_add(classSize(sizeclass), std::memory_order_relaxed);
+  } else {
+    header = static_cast<BlockHeader*>(allocateFromPool(total));
+    header->sizeclass = SHMNSIZECLASSES;
+    header->size = total;
+    cache.stats.nlarge.fetch_add(1, std::memory_order_relaxed);
+    mPoolInfoPtr->largebytes.fetch_add(total, std::memory_order_relaxed);
+    mPoolInfoPtr->nlarge.fetch_add(1, std::memory_order_relaxed);
+  }
+  header->magic = BLOCKMAGIC;
+  return header + 1;
+}
+
+// the size argument is ignored; it is taken from the block header
+void ShmManager::freememblock(void* ptr, size_t)
 {
-  boostallocator->deallocate((char*)ptr, s);
+  if (!ptr) {
+    return;
+  }
+  auto& cache = tShmCache;
+  cache.stats.nfrees.fetch_add(1, std::memory_order_relaxed);
+  auto header = static_cast<BlockHeader*>(ptr) - 1;
+  assert(header->magic == BLOCKMAGIC);
+  header->magic = 0;
+  const int sizeclass = header->sizeclass;
+  if (sizeclass == SHMNSIZECLASSES) {
+    mPoolInfoPtr->largebytes.fetch_sub(header->size, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mPoolMutex);
+    boostallocator->deallocate((char*)header, header->size);
+    return;
+  }
+  cache.stats.smallbytes.fetch_sub(classSize(sizeclass), std::memory_order_relaxed);
+  header->next = static_cast<BlockHeader*>(cache.freelists[sizeclass]);
+  cache.freelists[sizeclass] = header;
 }
 
 void ShmManager::release()
@@ -0,0 +1,107 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CompactHits
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include "CommonUtils/CompactHits.h"
+
+namespace
+{
+// the interface of the basic hit classes
+class TestHit
+{
+ public:
+  float GetX() const { return mX; }
+  float GetY() const { return mY; }
+  float GetZ() const { return mZ; }
+  float GetTime() const { return mTime; }
+  float GetHitValue() const { return mValue; }
+  int GetTrackID() const { return mTrackID; }
+  short GetDetectorID() const { return mDetectorID; }
+  void SetXYZ(float x, float y, float z)
+  {
+    mX = x;
+    mY = y;
+    mZ = z;
+  }
+  void SetTime(float time) { mTime = time; }
+  void SetHitValue(float value) { mValue = value; }
+  void SetTrackID(int id) { mTrackID = id; }
+  void SetDetectorID(short id) { mDetectorID = id; }
+
+ private:
+  float mX = 0, mY = 0, mZ = 0, mTime = 0, mValue = 0;
+  int mTrackID = 0;
+  short mDetectorID = 0;
+};
+} // namespace
+
+namespace o2
+{
+namespace utils
+{
+template <>
+struct CompactHitCodec<TestHit> : BasicHitCodec<TestHit> {
+};
+} // namespace utils
+} // namespace o2
+
+using namespace o2::utils;
+
+BOOST_AUTO_TEST_CASE(CompactHits_test)
+{
+  std::vector<TestHit> hits(1000);
+  for (size_t i = 0; i < hits.size(); i++) {
+    hits[i].SetXYZ(-250.f + 0.37f * i, 10.f * std::sin(0.1f * i), 3.3e-3f * i);
+    hits[i].SetTime(1.e5f - 2.5f * i);
+    hits[i].SetHitValue(1.e-6f * (i + 1));
+    hits[i].SetTrackID(i / 10 - 50);
+    hits[i].SetDetectorID(i % 7);
+  }
+  std::vector<char> buffer;
+  CompactHitPrecision precision;
+  encodeHits(hits, buffer, precision);
+  BOOST_CHECK(buffer.size() < hits.size() * sizeof(TestHit));
+
+  std::vector<TestHit> decoded;
+  BOOST_REQUIRE(decodeHits(buffer.data(), buffer.size(), decoded));
+  BOOST_REQUIRE_EQUAL(decoded.size(), hits.size());
+  for (size_t i = 0; i < hits.size(); i++) {
+    // half the precision from the rounding, the float resolution of the values on top
+    BOOST_CHECK_SMALL(decoded[i].GetX() - hits[i].GetX(), 0.5f * precision.position + 3.e-5f);
+    BOOST_CHECK_SMALL(decoded[i].GetY() - hits[i].GetY(), 0.5f * precision.position + 1.e-6f);
+    BOOST_CHECK_SMALL(decoded[i].GetZ() - hits[i].GetZ(), 0.5f * precision.position + 1.e-6f);
+    BOOST_CHECK_SMALL(decoded[i].GetTime() - hits[i].GetTime(), 0.5f * precision.time + 1.e-2f);
+    BOOST_CHECK_EQUAL(decoded[i].GetHitValue(), hits[i].GetHitValue());
+    BOOST_CHECK_EQUAL(decoded[i].GetTrackID(), hits[i].GetTrackID());
+    BOOST_CHECK_EQUAL(decoded[i].GetDetectorID(), hits[i].GetDetectorID());
+  }
+
+  // an empty container
+  std::vector<TestHit> none;
+  encodeHits(none, buffer);
+  BOOST_CHECK(decodeHits(buffer.data(), buffer.size(), decoded));
+  BOOST_CHECK(decoded.empty());
+
+  // truncated, extended or corrupted buffers are refused
+  encodeHits(hits, buffer);
+  BOOST_CHECK(!decodeHits(buffer.data(), buffer.size() - 1, decoded));
+  auto longer = buffer;
+  longer.push_back(0);
+  BOOST_CHECK(!decodeHits(longer.data(), longer.size(), decoded));
+  auto corrupted = buffer;
+  corrupted[0] ^= 1;
+  BOOST_CHECK(!decodeHits(corrupted.data(), corrupted.size(), decoded));
+  BOOST_CHECK(!decodeHits(buffer.data(), 3, decoded));
+}
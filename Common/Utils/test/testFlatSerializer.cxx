@@ -0,0 +1,178 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test FlatSerializer
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <list>
+#include <string>
+#include <vector>
+#include "CommonUtils/FlatSerializer.h"
+#include "DataFormatsMID/Cluster2D.h"
+
+using namespace o2::utils;
+
+namespace
+{
+struct TrackV1 {
+  int id;
+  float pos[3];
+  std::vector<int> digits;
+  static constexpr uint16_t FlatVersion = 1;
+  template <typename Self>
+  static auto flatFields(Self& self)
+  {
+    return std::tie(self.id, self.pos, self.digits);
+  }
+};
+
+/// TrackV1 with appended fields
+struct TrackV2 {
+  int id;
+  float pos[3];
+  std::vector<int> digits;
+  std::string name;
+  double chi2;
+  static constexpr uint16_t FlatVersion = 2;
+  template <typename Self>
+  static auto flatFields(Self& self)
+  {
+    return std::tie(self.id, self.pos, self.digits, self.name, self.chi2);
+  }
+};
+
+/// TrackV1 with a changed field type
+struct TrackBad {
+  double id;
+  template <typename Self>
+  static auto flatFields(Self& self)
+  {
+    return std::tie(self.id);
+  }
+};
+
+std::vector<TrackV2> makeTracks(size_t n)
+{
+  std::vector<TrackV2> tracks;
+  for (size_t i = 0; i < n; ++i) {
+    TrackV2 track{ int(i), { 0.1f * i, 0.2f * i, 0.3f * i }, {}, "track" + std::to_string(i), 1.5 * i };
+    for (size_t j = 0; j < i % 4; ++j) {
+      track.digits.push_back(int(10 * i + j));
+    }
+    tracks.push_back(track);
+  }
+  return tracks;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(testFlatSerialisedType)
+{
+  static_assert(is_flat_serializable<o2::mid::Cluster2D>::value, "Cluster2D lists its flat fields");
+  static_assert(is_flat_serializable<int>::value == false, "int is no struct with flat fields");
+
+  std::list<o2::mid::Cluster2D> inputV;
+  for (size_t i = 0; i < 17; i++) {
+    float iFloat = (float)i;
+    inputV.emplace_back(o2::mid::Cluster2D{ (uint8_t)i, 0.3f * iFloat, 0.5f * iFloat, 0.7f / iFloat, 0.9f / iFloat });
+  }
+
+  auto buffer = FlatSerialize(inputV);
+  BOOST_CHECK_EQUAL(buffer.size(), FlatSerializedSize(inputV));
+  FlatView<o2::mid::Cluster2D> view(buffer.data(), buffer.size());
+  BOOST_REQUIRE_EQUAL(view.size(), inputV.size());
+  BOOST_CHECK_EQUAL(view.schemaVersion(), 0);
+
+  auto deIds = view.column<0>();
+  auto xCoors = view.column<1>();
+  size_t i = 0;
+  for (auto const& test : inputV) {
+    BOOST_CHECK_EQUAL(test.deId, deIds[i]);
+    BOOST_CHECK_EQUAL(test.xCoor, xCoors[i]);
+    auto copy = view[i];
+    BOOST_CHECK_EQUAL(test.yCoor, copy.yCoor);
+    BOOST_CHECK_EQUAL(test.sigmaX2, copy.sigmaX2);
+    BOOST_CHECK_EQUAL(test.sigmaY2, copy.sigmaY2);
+    i++;
+  }
+  // the columns are read in place
+  BOOST_CHECK(reinterpret_cast<const char*>(xCoors.data()) > buffer.data());
+  BOOST_CHECK(reinterpret_cast<const char*>(xCoors.end()) <= buffer.data() + buffer.size());
+}
+
+BOOST_AUTO_TEST_CASE(testVariableColumns)
+{
+  auto tracks = makeTracks(13);
+  auto buffer = FlatSerialize(tracks);
+  FlatView<TrackV2> view(buffer.data(), buffer.size());
+  BOOST_REQUIRE_EQUAL(view.size(), tracks.size());
+  BOOST_CHECK_EQUAL(view.schemaVersion(), 2);
+
+  auto digits = view.column<2>();
+  auto names = view.column<3>();
+  size_t nDigits = 0;
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(digits[i].begin(), digits[i].end(), tracks[i].digits.begin(), tracks[i].digits.end());
+    BOOST_CHECK_EQUAL(std::string(names[i].begin(), names[i].end()), tracks[i].name);
+    BOOST_CHECK_EQUAL(view.column<1>()[i][2], tracks[i].pos[2]);
+    nDigits += tracks[i].digits.size();
+  }
+  BOOST_CHECK_EQUAL(digits.items().size(), nDigits);
+
+  auto copy = FlatDeserialize<TrackV2>(buffer.data(), buffer.size());
+  BOOST_REQUIRE_EQUAL(copy.size(), tracks.size());
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    BOOST_CHECK_EQUAL(copy[i].id, tracks[i].id);
+    BOOST_CHECK(copy[i].digits == tracks[i].digits);
+    BOOST_CHECK_EQUAL(copy[i].name, tracks[i].name);
+    BOOST_CHECK_EQUAL(copy[i].chi2, tracks[i].chi2);
+  }
+
+  std::vector<TrackV2> empty;
+  auto emptyBuffer = FlatSerialize(empty);
+  FlatView<TrackV2> emptyView(emptyBuffer.data(), emptyBuffer.size());
+  BOOST_CHECK(emptyView.empty());
+  BOOST_CHECK(emptyView.column<2>().items().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testSchemaEvolution)
+{
+  // a reader of the previous version skips the appended columns
+  auto tracks = makeTracks(7);
+  auto buffer = FlatSerialize(tracks);
+  FlatView<TrackV1> oldView(buffer.data(), buffer.size());
+  BOOST_CHECK_EQUAL(oldView.schemaVersion(), 2);
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    auto track = oldView[i];
+    BOOST_CHECK_EQUAL(track.id, tracks[i].id);
+    BOOST_CHECK(track.digits == tracks[i].digits);
+  }
+
+  // a reader of the new version gets value initialized fields for the missing columns
+  std::vector<TrackV1> oldTracks{ { 1, { 1.f, 2.f, 3.f }, { 4, 5 } }, { 2, { 6.f, 7.f, 8.f }, {} } };
+  auto oldBuffer = FlatSerialize(oldTracks);
+  FlatView<TrackV2> newView(oldBuffer.data(), oldBuffer.size());
+  BOOST_CHECK_EQUAL(newView.schemaVersion(), 1);
+  BOOST_CHECK(newView.hasColumn(2));
+  BOOST_CHECK(newView.hasColumn(3) == false);
+  BOOST_CHECK_THROW(newView.column<3>(), std::out_of_range);
+  auto track = newView[0];
+  BOOST_CHECK(track.digits == oldTracks[0].digits);
+  BOOST_CHECK(track.name.empty());
+  BOOST_CHECK_EQUAL(track.chi2, 0.);
+
+  // changed field types and corrupted buffers are detected
+  BOOST_CHECK_THROW(FlatView<TrackBad>(buffer.data(), buffer.size()), std::runtime_error);
+  BOOST_CHECK_THROW(FlatView<TrackV2>(buffer.data(), buffer.size() / 2), std::runtime_error);
+  BOOST_CHECK_THROW(FlatView<TrackV2>(buffer.data(), 8), std::runtime_error);
+  std::vector<char> shortBuffer(FlatSerializedSize(tracks) - 8);
+  BOOST_CHECK_THROW(FlatSerialize(tracks, shortBuffer.data(), shortBuffer.size()), std::length_error);
+}
@@ -0,0 +1,55 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   testRngHelper.cxx
+/// @brief  unit tests for the random streams of the units of work
+
+#include "CommonUtils/RngHelper.h"
+
+#define BOOST_TEST_MODULE RngHelper unit test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <set>
+#include <vector>
+
+using o2::utils::RngHelper;
+
+namespace
+{
+std::vector<float> draw(uint64_t seed, uint32_t event, uint32_t source, uint32_t unit)
+{
+  std::vector<float> values(100);
+  auto stream = RngHelper::getStream(seed, event, source, unit);
+  stream.fillUniform(values.data(), values.size());
+  return values;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_RngHelperStreams)
+{
+  // the same unit gets the same numbers, whatever was drawn before
+  auto first = draw(1234, 7, 0, 3);
+  draw(1234, 8, 0, 3);
+  BOOST_CHECK(draw(1234, 7, 0, 3) == first);
+
+  // any other id or seed gives other numbers
+  std::set<std::vector<float>> all;
+  for (uint64_t seed : { 1234, 1235 }) {
+    for (uint32_t event = 0; event < 10; event++) {
+      for (uint32_t source = 0; source < 2; source++) {
+        for (uint32_t unit = 0; unit < 4; unit++) {
+          all.insert(draw(seed, event, source, unit));
+        }
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(all.size(), 2 * 10 * 2 * 4);
+}
@@ -15,6 +15,8 @@
 #include "AliTPCCommonRtypes.h"
 
 #include <array>
+#include <cstdint>
+#include <string>
 #include <vector>
 #include "DetectorsCommonDataFormats/DetID.h"
 #include "MathUtils/Cartesian3D.h"
@@ -93,6 +95,29 @@ class DetMatrixCache
   const Rot2D& getMatrixT2GRot(int sensID) const { return mT2GRot.getMatrix(sensID); }
   bool isBuilt() const { return mSize != 0; }
   int getSize() const { return mSize; }
+
+  /// header of the flat buffer of the matrix caches
+  struct BlobHeader {
+    uint32_t magic = BlobMagic;                 ///< identifier of the format
+    uint16_t version = 1;                       ///< version of the format
+    uint16_t sizeofHeader = sizeof(BlobHeader); ///< size of the header in bytes
+    int32_t detID = 0;                          ///< detector ID
+    int32_t size = 0;                           ///< number of sensors
+    int32_t nL2G = 0;                           ///< number of L2G matrices
+    int32_t nT2L = 0;                           ///< number of T2L matrices
+    int32_t nT2G = 0;                           ///< number of T2G matrices
+    int32_t nT2GRot = 0;                        ///< number of T2GRot rotations
+  };
+  static constexpr uint32_t BlobMagic = 0x4358544d; ///< 'MTXC'
+
+  // The filled caches can be stored as one flat buffer: the header followed by the 12 components
+  // of each L2G, T2L and T2G matrix (double) and the cos, sin of each T2GRot rotation (float).
+  // Loading the buffer restores the caches without any access to TGeo, the size of the cache
+  // must match the one already set, if any.
+  std::vector<char> getMatrixCacheBlob() const;
+  void setMatrixCacheFromBlob(const char* data, size_t size);
+  void writeMatrixCacheToFile(const std::string& fileName) const;
+  void loadMatrixCacheFromFile(const std::string& fileName);
   //  protected:
 
   // detector derived class must define its implementation for the method to populate the matrix cache, as an
@@ -11,6 +11,8 @@
 #include "DetectorsCommonDataFormats/DetMatrixCache.h"
 #include <TGeoMatrix.h>
 #include "MathUtils/Utils.h"
+#include <cstring>
+#include <fstream>
 
 using namespace o2::detectors;
 using namespace o2::utils;
@@ -29,6 +31,130 @@ void DetMatrixCache::setSize(int s)
   mSize = s;
 }
 
+namespace
+{
+constexpr size_t NComponents3D = 12; // components of Transform3D
+constexpr size_t NComponents2D = 2;  // components of Rotation2D
+
+void appendBlob(std::vector<char>& blob, const void* src, size_t n)
+{
+  const auto* bytes = reinterpret_cast<const char*>(src);
+  blob.insert(blob.end(), bytes, bytes + n);
+}
+} // namespace
+
+//_______________________________________________________
+std::vector<char> DetMatrixCache::getMatrixCacheBlob() const
+{
+  // store the caches in a flat buffer
+  BlobHeader header;
+  header.detID = mDetID;
+  header.size = mSize;
+  header.nL2G = mL2G.getSize();
+  header.nT2L = mT2L.getSize();
+  header.nT2G = mT2G.getSize();
+  header.nT2GRot = mT2GRot.getSize();
+  std::vector<char> blob;
+  blob.reserve(sizeof(BlobHeader) + (header.nL2G + header.nT2L + header.nT2G) * NComponents3D * sizeof(double) +
+               header.nT2GRot * NComponents2D * sizeof(float));
+  appendBlob(blob, &header, sizeof(BlobHeader));
+  std::array<double, NComponents3D> comp3D;
+  for (const auto* cache : { &mL2G, &mT2L, &mT2G }) {
+    for (int i = 0; i < cache->getSize(); i++) {
+      cache->getMatrix(i).GetComponents(comp3D.begin());
+      appendBlob(blob, comp3D.data(), sizeof(comp3D));
+    }
+  }
+  std::array<float, NComponents2D> comp2D;
+  for (int i = 0; i < mT2GRot.getSize(); i++) {
+    mT2GRot.getMatrix(i).getComponents(comp2D[0], comp2D[1]);
+    appendBlob(blob, comp2D.data(), sizeof(comp2D));
+  }
+  return blob;
+}
+
+//_______________________________________________________
+void DetMatrixCache::setMatrixCacheFromBlob(const char* data, size_t size)
+{
+  // restore the caches from a flat buffer made by getMatrixCacheBlob
+  BlobHeader header;
+  if (size < sizeof(BlobHeader)) {
+    LOG(FATAL) << "Matrix cache buffer of " << size << " bytes is too small for the header";
+  }
+  std::memcpy(&header, data, sizeof(BlobHeader));
+  if (header.magic != BlobMagic || header.version != 1 || header.sizeofHeader != sizeof(BlobHeader)) {
+    LOG(FATAL) << "Unknown matrix cache buffer format";
+  }
+  if (header.detID != int(mDetID)) {
+    LOG(FATAL) << "Matrix cache buffer of detector " << header.detID << " cannot be loaded for " << getName();
+  }
+  const size_t n3D = size_t(header.nL2G) + header.nT2L + header.nT2G;
+  if (header.nL2G < 0 || header.nT2L < 0 || header.nT2G < 0 || header.nT2GRot < 0 ||
+      size != sizeof(BlobHeader) + n3D * NComponents3D * sizeof(double) + header.nT2GRot * NComponents2D * sizeof(float)) {
+    LOG(FATAL) << "Matrix cache buffer size " << size << " does not match its header";
+  }
+  if (mSize != header.size) {
+    setSize(header.size);
+  }
+  const char* ptr = data + sizeof(BlobHeader);
+  std::array<double, NComponents3D> comp3D;
+  const std::array<int, 3> n3DPerCache = { header.nL2G, header.nT2L, header.nT2G };
+  const std::array<MatrixCache<Mat3D>*, 3> caches3D = { &mL2G, &mT2L, &mT2G };
+  for (int ic = 0; ic < 3; ic++) {
+    auto& cache = *caches3D[ic];
+    if (cache.isFilled() && cache.getSize() != n3DPerCache[ic]) {
+      LOG(FATAL) << "Matrix cache was already set with size " << cache.getSize() << ", buffer has " << n3DPerCache[ic];
+    }
+    cache.setSize(n3DPerCache[ic]);
+    for (int i = 0; i < n3DPerCache[ic]; i++) {
+      std::memcpy(comp3D.data(), ptr, sizeof(comp3D));
+      ptr += sizeof(comp3D);
+      Mat3D mat;
+      mat.SetComponents(comp3D.begin(), comp3D.end());
+      cache.setMatrix(mat, i);
+    }
+  }
+  if (mT2GRot.isFilled() && mT2GRot.getSize() != header.nT2GRot) {
+    LOG(FATAL) << "Rotation cache was already set with size " << mT2GRot.getSize() << ", buffer has " << header.nT2GRot;
+  }
+  mT2GRot.setSize(header.nT2GRot);
+  std::array<float, NComponents2D> comp2D;
+  for (int i = 0; i < header.nT2GRot; i++) {
+    std::memcpy(comp2D.data(), ptr, sizeof(comp2D));
+    ptr += sizeof(comp2D);
+    mT2GRot.setMatrix(Rot2D(comp2D[0], comp2D[1]), i);
+  }
+}
+
+//_______________________________________________________
+void DetMatrixCache::writeMatrixCacheToFile(const std::string& fileName) const
+{
+  // write the flat buffer of the caches to a binary file
+  std::ofstream file(fileName, std::ios::binary);
+  const auto blob = getMatrixCacheBlob();
+  if (!file.write(blob.data(), blob.size())) {
+    LOG(FATAL) << "Failed to write " << getName() << " matrix cache to " << fileName;
+  }
+}
+
+//_______________________________________________________
+void DetMatrixCache::loadMatrixCacheFromFile(const std::string& fileName)
+{
+  // restore the caches from a binary file written with writeMatrixCacheToFile
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if (!file) {
+    LOG(FATAL) << "Failed to open matrix cache file " << fileName;
+  }
+  std::vector<char> blob(file.tellg());
+  file.seekg(0);
+  if (!file.read(blob.data(), blob.size())) {
+    LOG(FATAL) << "Failed to read matrix cache from " << fileName;
+  }
+  setMatrixCacheFromBlob(blob.data(), blob.size());
+  LOG(INFO) << "Loaded " << getName() << " matrix cache for " << mSize << " sensors from " << fileName;
+}
+
+//_______________________________________________________
 void DetMatrixCacheIndirect::setSize(int size, int sizeIndirect)
 {
   // set the size of the matrix cache, can be done only once
@@ -0,0 +1,62 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DetMatrixCache
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <array>
+#include "DetectorsCommonDataFormats/DetMatrixCache.h"
+
+using namespace o2::detectors;
+
+namespace
+{
+// cache filled with dummy matrices instead of the TGeo ones
+class TestMatrixCache : public DetMatrixCache
+{
+ public:
+  TestMatrixCache() : DetMatrixCache(DetID::ITS) {}
+  void fillMatrixCache(int mask) override
+  {
+    const int nSensors = 5;
+    setSize(nSensors);
+    mL2G.setSize(nSensors);
+    mT2GRot.setSize(nSensors);
+    for (int i = 0; i < nSensors; i++) {
+      std::array<double, 12> comp = { 1., 0., 0., 0.1 * i, 0., 1., 0., -0.2 * i, 0., 0., 1., 3. + i };
+      mL2G.setMatrix(Mat3D(comp.begin(), comp.end()), i);
+      mT2GRot.setMatrix(Rot2D(0.3f * i), i);
+    }
+  }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(DetMatrixCache_blob_test)
+{
+  TestMatrixCache filled;
+  filled.fillMatrixCache(0);
+  const auto blob = filled.getMatrixCacheBlob();
+
+  TestMatrixCache loaded;
+  loaded.setMatrixCacheFromBlob(blob.data(), blob.size());
+  BOOST_CHECK(loaded.getSize() == filled.getSize());
+  BOOST_CHECK(loaded.getCacheL2G().getSize() == filled.getSize());
+  BOOST_CHECK(!loaded.getCacheT2L().isFilled());
+  BOOST_CHECK(!loaded.getCacheT2G().isFilled());
+  for (int i = 0; i < filled.getSize(); i++) {
+    Point3D<double> pnt(1., 2., 3.);
+    BOOST_CHECK(loaded.getMatrixL2G(i)(pnt) == filled.getMatrixL2G(i)(pnt));
+    float cs0, sn0, cs1, sn1;
+    filled.getMatrixT2GRot(i).getComponents(cs0, sn0);
+    loaded.getMatrixT2GRot(i).getComponents(cs1, sn1);
+    BOOST_CHECK(cs0 == cs1 && sn0 == sn1);
+  }
+}
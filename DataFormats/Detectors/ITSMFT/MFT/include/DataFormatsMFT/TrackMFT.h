@@ -16,6 +16,7 @@
 #ifndef ALICEO2_MFT_TRACKMFT_H
 #define ALICEO2_MFT_TRACKMFT_H
 
+#include <array>
 #include <vector>
 
 #include "ReconstructionDataFormats/Track.h"
@@ -36,14 +37,29 @@ class TrackMFT : public o2::track::TrackParCov
 
  public:
   using o2::track::TrackParCov::TrackParCov;
+  static constexpr int MaxClusters = 5; ///< at most one cluster per disk
 
   TrackMFT() = default;
   TrackMFT(const TrackMFT& t) = default;
+  TrackMFT(o2::track::TrackParCov&& parcov) : TrackParCov{ parcov } {}
   TrackMFT& operator=(const TrackMFT& tr) = default;
   ~TrackMFT() = default;
 
+  Int_t getNumberOfClusters() const { return mNClusters; }
+  Int_t getClusterIndex(Int_t disk) const { return mIndex[disk]; }
+
+  void setExternalClusterIndex(Int_t disk, Int_t idx, bool newCluster = false);
+  void resetClusters();
+
+  std::uint32_t getROFrame() const { return mROFrame; }
+  void setROFrame(std::uint32_t f) { mROFrame = f; }
+
  private:
-  ClassDefNV(TrackMFT, 1)
+  short mNClusters = 0;                                           ///< Number of associated clusters
+  std::uint32_t mROFrame = 0;                                     ///< RO Frame
+  std::array<Int_t, MaxClusters> mIndex = { -1, -1, -1, -1, -1 }; ///< Indices of associated clusters, per disk
+
+  ClassDefNV(TrackMFT, 2)
 };
 }
 }
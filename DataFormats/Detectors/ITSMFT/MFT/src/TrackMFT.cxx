@@ -25,3 +25,22 @@ using namespace o2::constants::math;
 using namespace o2::track;
 
 //_____________________________________________________________________________
+void TrackMFT::setExternalClusterIndex(Int_t disk, Int_t idx, bool newCluster)
+{
+  //--------------------------------------------------------------------
+  // Set the cluster index within an external cluster array
+  //--------------------------------------------------------------------
+  if (newCluster)
+    mNClusters++;
+  mIndex[disk] = idx;
+}
+
+//_____________________________________________________________________________
+void TrackMFT::resetClusters()
+{
+  //------------------------------------------------------------------
+  // Reset the array of attached clusters.
+  //------------------------------------------------------------------
+  mNClusters = 0;
+  mIndex.fill(-1);
+}
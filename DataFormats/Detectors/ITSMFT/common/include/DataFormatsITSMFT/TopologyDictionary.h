@@ -68,6 +68,7 @@ class TopologyDictionary
   static constexpr int MinimumClassArea = RowClassSpan * ColClassSpan;                   ///< Area of the smallest class of rare topologies (used as reference)
   static constexpr int MaxNumberOfClasses = Cluster::kMaxPatternBits / MinimumClassArea; ///< Maximum number of row/column classes for the groups of rare topologies
   static constexpr int NumberOfRareGroups = MaxNumberOfClasses * MaxNumberOfClasses;     ///< Number of entries corresponding to groups of rare topologies (those whos matrix exceed the max number of bytes are empty).
+  static constexpr int MaxSmallPatternSpan = 4;                                          ///< Max. row and column span of the topologies in the direct look-up table
   /// Prints the dictionary
   friend std::ostream& operator<<(std::ostream& os, const TopologyDictionary& dictionary);
   /// Prints the dictionary in a binary file
@@ -92,15 +93,32 @@ class TopologyDictionary
   double GetFrequency(int n);
   /// Returns the number of elements in the dicionary;
   int GetSize() { return (int)mVectorOfGroupIDs.size(); }
+  /// Returns the ID of a topology with both spans <= MaxSmallPatternSpan, -1 if it is not in the dictionary
+  int GetSmallTopologyID(int nRow, int nCol, const unsigned char patt[Cluster::kMaxPatternBytes]) const
+  {
+    return mSmallPatternLUT[getSmallPatternIndex(nRow, nCol, patt)];
+  }
 
   friend BuildTopologyDictionary;
   friend LookUp;
   friend TopologyFastSimulation;
 
  private:
-  std::unordered_map<unsigned long, int> mFinalMap; ///< Map of pair <hash, position in mVectorOfGroupIDs>
-  int mSmallTopologiesLUT[8 * 255];                 ///< Look-Up Table for the topologies with 1-byte linearised matrix
-  std::vector<GroupStruct> mVectorOfGroupIDs;       ///< Vector of topologies and groups
+  /// Index in mSmallPatternLUT of a topology with both spans <= MaxSmallPatternSpan
+  int getSmallPatternIndex(int nRow, int nCol, const unsigned char patt[Cluster::kMaxPatternBytes]) const
+  {
+    // the first nRow*nCol bits of the pattern, stored from the most significant bit on, are the index in the
+    // part of the table reserved for this bounding box
+    const int nBits = nRow * nCol;
+    const unsigned int bits = ((patt[0] << 8) | patt[1]) >> (16 - nBits);
+    return mSmallPatternOffset[(nRow - 1) * MaxSmallPatternSpan + nCol - 1] + bits;
+  }
+
+  std::unordered_map<unsigned long, int> mFinalMap;                   ///< Map of pair <hash, position in mVectorOfGroupIDs>
+  int mSmallTopologiesLUT[8 * 255];                                   ///< Look-Up Table for the topologies with 1-byte linearised matrix
+  std::vector<GroupStruct> mVectorOfGroupIDs;                         ///< Vector of topologies and groups
+  std::vector<int> mSmallPatternLUT;                                  //! Direct look-up table of the topologies with spans <= MaxSmallPatternSpan
+  int mSmallPatternOffset[MaxSmallPatternSpan * MaxSmallPatternSpan]; //! Offset in mSmallPatternLUT of every bounding box
 
   ClassDefNV(TopologyDictionary, 2);
 };
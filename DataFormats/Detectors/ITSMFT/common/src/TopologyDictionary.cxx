@@ -14,6 +14,7 @@
 /// \author Luca Barioglio, University and INFN of Torino
 
 #include "DataFormatsITSMFT/TopologyDictionary.h"
+#include <algorithm>
 #include <iostream>
 
 using std::cout;
@@ -29,7 +30,18 @@ ClassImp(o2::itsmft::TopologyDictionary)
   namespace itsmft
   {
 
-  TopologyDictionary::TopologyDictionary() : mSmallTopologiesLUT{ -1 } {}
+  TopologyDictionary::TopologyDictionary() : mSmallTopologiesLUT{ -1 }
+  {
+    // every bounding box with spans <= MaxSmallPatternSpan gets 2^(nRow*nCol) entries in the direct look-up table
+    int offset = 0;
+    for (int nRow = 1; nRow <= MaxSmallPatternSpan; nRow++) {
+      for (int nCol = 1; nCol <= MaxSmallPatternSpan; nCol++) {
+        mSmallPatternOffset[(nRow - 1) * MaxSmallPatternSpan + nCol - 1] = offset;
+        offset += 1 << (nRow * nCol);
+      }
+    }
+    mSmallPatternLUT.resize(offset, -1);
+  }
 
   std::ostream& operator<<(std::ostream& os, const TopologyDictionary& dict)
   {
@@ -66,6 +78,7 @@ ClassImp(o2::itsmft::TopologyDictionary)
     mFinalMap.clear();
     for (auto& p : mSmallTopologiesLUT)
       p = -1;
+    std::fill(mSmallPatternLUT.begin(), mSmallPatternLUT.end(), -1);
     std::ifstream in(fname.data(), std::ios::in | std::ios::binary);
     GroupStruct gr;
     int groupID = 0;
@@ -84,8 +97,14 @@ ClassImp(o2::itsmft::TopologyDictionary)
         mVectorOfGroupIDs.push_back(gr);
         if (gr.mPattern.getUsedBytes() == 1)
           mSmallTopologiesLUT[(gr.mPattern.getColumnSpan() - 1) * 255 + (int)gr.mPattern.mBitmap[2]] = groupID;
-        if (((gr.mHash) & 0xffffffff) != 0)
+        if (((gr.mHash) & 0xffffffff) != 0) {
           mFinalMap.insert(std::make_pair(gr.mHash, groupID));
+          // groups of rare topologies have no pattern of their own, they are not in the direct look-up table
+          const int nRow = gr.mPattern.getRowSpan(), nCol = gr.mPattern.getColumnSpan();
+          if (nRow <= MaxSmallPatternSpan && nCol <= MaxSmallPatternSpan) {
+            mSmallPatternLUT[getSmallPatternIndex(nRow, nCol, &gr.mPattern.mBitmap[2])] = groupID;
+          }
+        }
         groupID++;
       }
     }
@@ -18,6 +18,7 @@
 
 #include <boost/serialization/access.hpp>
 #include <cstdint>
+#include <tuple>
 
 namespace o2
 {
@@ -43,6 +44,13 @@ struct Cluster2D {
     ar& sigmaX2;
     ar& sigmaY2;
   }
+
+  /// Fields of the flat serialization
+  template <typename Self>
+  static auto flatFields(Self& self)
+  {
+    return std::tie(self.deId, self.xCoor, self.yCoor, self.sigmaX2, self.sigmaY2);
+  }
 };
 } // namespace mid
 } // namespace o2
@@ -0,0 +1,48 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   DataFormatsMID/ROFRecord.h
+/// \brief  Boundaries of the objects of one readout frame in a timeframe
+
+#ifndef O2_MID_ROFRECORD_H
+#define O2_MID_ROFRECORD_H
+
+#include <boost/serialization/access.hpp>
+#include <cstdint>
+
+namespace o2
+{
+namespace mid
+{
+/// Readout frame (event) record for MID: range of the associated objects in the timeframe
+struct ROFRecord {
+  uint32_t firstEntry = 0; ///< Index of the first object of the readout frame
+  uint32_t nEntries = 0;   ///< Number of objects in the readout frame
+
+  ROFRecord() = default;
+  ROFRecord(uint32_t first, uint32_t n) : firstEntry(first), nEntries(n) {}
+
+  /// Gets the index after the last object of the readout frame
+  uint32_t getEndIndex() const { return firstEntry + nEntries; }
+
+  friend class boost::serialization::access;
+
+  /// Serializes the struct
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    ar& firstEntry;
+    ar& nEntries;
+  }
+};
+} // namespace mid
+} // namespace o2
+
+#endif /* O2_MID_ROFRECORD_H */
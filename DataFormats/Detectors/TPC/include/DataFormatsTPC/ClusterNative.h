@@ -24,6 +24,8 @@ namespace dataformats
 {
 template <class T>
 class MCTruthContainer;
+template <class T>
+class MCTruthContainerView;
 }
 }
 
@@ -119,6 +121,10 @@ struct ClusterNativeAccessFullTPC {
   unsigned int nClusters[o2::TPC::Constants::MAXSECTOR][o2::TPC::Constants::MAXGLOBALPADROW];
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* clustersMCTruth[o2::TPC::Constants::MAXSECTOR]
                                                                      [o2::TPC::Constants::MAXGLOBALPADROW];
+  // alternatively to clustersMCTruth, the labels of a sector in one flat buffer, indexed by the position
+  // of the cluster in the sector: clusterOffset of its row plus its index in the row
+  const o2::dataformats::MCTruthContainerView<o2::MCCompLabel>* clustersMCTruthView[o2::TPC::Constants::MAXSECTOR];
+  unsigned int clusterOffset[o2::TPC::Constants::MAXSECTOR][o2::TPC::Constants::MAXGLOBALPADROW];
 };
 }
 }
@@ -33,6 +33,7 @@ namespace o2
 namespace TPC
 {
 using MCLabelContainer = o2::dataformats::MCTruthContainer<o2::MCCompLabel>;
+using MCLabelContainerView = o2::dataformats::MCTruthContainerView<o2::MCCompLabel>;
 
 /// @struct ClusterNativeContainer
 /// A container class for a collection of ClusterNative object
@@ -127,6 +128,11 @@ class ClusterNativeHelper
     return nofClusters;
   }
 
+  /// merge the MC label containers of the rows of a sector buffer into one container, indexed by the
+  /// position of the clusters in the buffer; in the flat layout of MCTruthContainer, the labels of a
+  /// sector can then be indexed in place together with the clusters, see Reader::parseSector
+  static MCLabelContainer mergeSectorMCLabels(const char* buffer, size_t size, std::vector<MCLabelContainer> const& mcinput);
+
   /// @class Reader
   /// @brief A reader class for the raw cluster native data
   ///
@@ -169,16 +175,19 @@ class ClusterNativeHelper
     }
 
     static int parseSector(const char* buffer, size_t size, std::vector<MCLabelContainer>& mcinput, ClusterNativeAccessFullTPC& clusterIndex);
-    template <typename ContainerT, std::enable_if_t<std::is_pointer<ContainerT>::value, int> = 0>
-    static int parseSector(ContainerT container, std::vector<MCLabelContainer>& mcinput, ClusterNativeAccessFullTPC& clusterIndex)
+    /// index the clusters of a sector buffer with the MC labels in a view on the flat labels of the sector,
+    /// as merged by mergeSectorMCLabels; the view must stay valid for the lifetime of the index
+    static int parseSector(const char* buffer, size_t size, MCLabelContainerView const& mcinput, ClusterNativeAccessFullTPC& clusterIndex);
+    template <typename ContainerT, typename MCInputT, std::enable_if_t<std::is_pointer<ContainerT>::value, int> = 0>
+    static int parseSector(ContainerT container, MCInputT& mcinput, ClusterNativeAccessFullTPC& clusterIndex)
     {
       if (container == nullptr) {
         return 0;
       }
       return parseSector(container->data(), container->size(), mcinput, clusterIndex);
     }
-    template <typename ContainerT, std::enable_if_t<!std::is_pointer<ContainerT>::value, int> = 0>
-    static int parseSector(ContainerT container, std::vector<MCLabelContainer>& mcinput, ClusterNativeAccessFullTPC& clusterIndex)
+    template <typename ContainerT, typename MCInputT, std::enable_if_t<!std::is_pointer<ContainerT>::value, int> = 0>
+    static int parseSector(ContainerT container, MCInputT& mcinput, ClusterNativeAccessFullTPC& clusterIndex)
     {
       return parseSector(container.data(), container.size(), mcinput, clusterIndex);
     }
@@ -32,6 +32,9 @@ struct TPCSectorHeader : public o2::header::BaseHeader {
   }
 
   static constexpr int NSectors = o2::TPC::Constants::MAXSECTOR;
+  // flags of the data of a sector sent in several chunks, e.g. the digits of a long timeframe in continuous mode
+  static constexpr uint16_t ChunkContinued = 0x1; ///< not the first chunk of the sector
+  static constexpr uint16_t ChunkHasMore = 0x2;   ///< more chunks of the sector follow
   int sector;
   union {
     uint64_t activeSectorsFlags = 0;
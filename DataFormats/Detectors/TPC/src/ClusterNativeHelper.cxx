@@ -190,6 +190,70 @@ int ClusterNativeHelper::Reader::parseSector(const char* buffer, size_t size, st
   return numberOfClusters;
 }
 
+int ClusterNativeHelper::Reader::parseSector(const char* buffer, size_t size, MCLabelContainerView const& mcinput, ClusterNativeAccessFullTPC& clusterIndex)
+{
+  if (!buffer || size == 0) {
+    return 0;
+  }
+
+  using ClusterGroupParser = o2::algorithm::ForwardParser<o2::TPC::ClusterGroupHeader>;
+  ClusterGroupParser parser;
+  size_t numberOfClusters = 0;
+  parser.parse(buffer, size,
+               [](const typename ClusterGroupParser::HeaderType& h) {
+                 return true;
+               },
+               [](const typename ClusterGroupParser::HeaderType& h) {
+                 return h.nClusters * sizeof(ClusterNative) + ClusterGroupParser::totalOffset;
+               },
+               [&](typename ClusterGroupParser::FrameInfo& frame) {
+                 int sector = frame.header->sector;
+                 int padrow = frame.header->globalPadRow;
+                 int nClusters = frame.header->nClusters;
+                 clusterIndex.clusters[sector][padrow] = reinterpret_cast<const ClusterNative*>(frame.payload);
+                 clusterIndex.nClusters[sector][padrow] = nClusters;
+                 clusterIndex.clustersMCTruthView[sector] = &mcinput;
+                 clusterIndex.clusterOffset[sector][padrow] = numberOfClusters;
+                 numberOfClusters += nClusters;
+                 return true;
+               });
+  return numberOfClusters;
+}
+
+MCLabelContainer ClusterNativeHelper::mergeSectorMCLabels(const char* buffer, size_t size, std::vector<MCLabelContainer> const& mcinput)
+{
+  MCLabelContainer merged;
+  if (!buffer || size == 0) {
+    return merged;
+  }
+
+  // the label containers come in the sequence of the row groups of the buffer
+  auto mcIterator = mcinput.begin();
+  using ClusterGroupParser = o2::algorithm::ForwardParser<o2::TPC::ClusterGroupHeader>;
+  ClusterGroupParser parser;
+  size_t numberOfClusters = 0;
+  parser.parse(buffer, size,
+               [](const typename ClusterGroupParser::HeaderType& h) {
+                 return true;
+               },
+               [](const typename ClusterGroupParser::HeaderType& h) {
+                 return h.nClusters * sizeof(ClusterNative) + ClusterGroupParser::totalOffset;
+               },
+               [&](typename ClusterGroupParser::FrameInfo& frame) {
+                 if (mcIterator != mcinput.end()) {
+                   for (size_t cluster = 0; cluster < frame.header->nClusters; ++cluster) {
+                     for (auto const& label : mcIterator->getLabels(cluster)) {
+                       merged.addElement(numberOfClusters + cluster, label);
+                     }
+                   }
+                   ++mcIterator;
+                 }
+                 numberOfClusters += frame.header->nClusters;
+                 return true;
+               });
+  return merged;
+}
+
 ClusterNativeHelper::TreeWriter::~TreeWriter()
 {
   close();
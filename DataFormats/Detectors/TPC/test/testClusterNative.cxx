@@ -16,9 +16,12 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include "../include/DataFormatsTPC/ClusterNative.h"
+#include "../include/DataFormatsTPC/ClusterNativeHelper.h"
 #include <boost/test/unit_test.hpp>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 namespace o2
 {
@@ -83,5 +86,50 @@ bool checkClusterType()
 }
 
 BOOST_AUTO_TEST_CASE(test_tpc_clusternative) { checkClusterType<ClusterNative>(); }
+
+// index a sector buffer of two rows together with its MC labels in one flat container
+BOOST_AUTO_TEST_CASE(test_tpc_clusternative_flat_labels)
+{
+  const int sector = 3;
+  const int rows[2] = { 10, 42 };
+  const unsigned int nClusters[2] = { 3, 2 };
+  std::vector<char> buffer;
+  std::vector<MCLabelContainer> rowLabels(2);
+  for (int r = 0; r < 2; r++) {
+    ClusterGroupHeader header(ClusterGroupAttribute{ sector, uint8_t(rows[r]) }, nClusters[r]);
+    auto pos = buffer.size();
+    buffer.resize(pos + sizeof(header) + nClusters[r] * sizeof(ClusterNative));
+    std::memcpy(buffer.data() + pos, &header, sizeof(header));
+    auto* clusters = reinterpret_cast<ClusterNative*>(buffer.data() + pos + sizeof(header));
+    for (unsigned int c = 0; c < nClusters[r]; c++) {
+      clusters[c].qMax = 10 * r + c;
+      if (c != 1) { // a cluster without label, and one at the end of the first row
+        rowLabels[r].addElement(c, MCCompLabel(10 * r + c, 0, 0));
+      }
+    }
+  }
+
+  auto merged = ClusterNativeHelper::mergeSectorMCLabels(buffer.data(), buffer.size(), rowLabels);
+  std::vector<char> flat;
+  merged.flatten_to(flat);
+  MCLabelContainerView view(flat);
+
+  ClusterNativeAccessFullTPC clusterIndex;
+  std::memset(&clusterIndex, 0, sizeof(clusterIndex));
+  auto n = ClusterNativeHelper::Reader::parseSector(buffer.data(), buffer.size(), view, clusterIndex);
+  BOOST_CHECK_EQUAL(n, 5);
+  BOOST_CHECK(clusterIndex.clustersMCTruthView[sector] == &view);
+  for (int r = 0; r < 2; r++) {
+    BOOST_REQUIRE_EQUAL(clusterIndex.nClusters[sector][rows[r]], nClusters[r]);
+    for (unsigned int c = 0; c < nClusters[r]; c++) {
+      BOOST_CHECK_EQUAL(clusterIndex.clusters[sector][rows[r]][c].qMax, 10 * r + c);
+      auto labels = view.getLabels(clusterIndex.clusterOffset[sector][rows[r]] + c);
+      BOOST_REQUIRE_EQUAL(labels.size(), c == 1 ? 0 : 1);
+      if (c != 1) {
+        BOOST_CHECK_EQUAL(labels[0].getTrackID(), 10 * r + c);
+      }
+    }
+  }
+}
 } // namespace TPC
 } // namespace o2
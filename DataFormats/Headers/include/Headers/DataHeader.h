@@ -357,6 +357,7 @@ constexpr o2::header::SerializationMethod gSerializationMethodNone{ "NONE" };
 constexpr o2::header::SerializationMethod gSerializationMethodROOT{ "ROOT" };
 constexpr o2::header::SerializationMethod gSerializationMethodFlatBuf{ "FLATBUF" };
 constexpr o2::header::SerializationMethod gSerializationMethodArrow { "ARROW" };
+constexpr o2::header::SerializationMethod gSerializationMethodFlat{ "FLAT" };
 
 //__________________________________________________________________________________________________
 /// @struct BaseHeader
@@ -12,6 +12,7 @@
 
 #include "MemoryResources/MemoryResources.h"
 #include "Headers/DataHeader.h"
+#include <array>
 
 namespace o2
 {
@@ -31,6 +32,10 @@ namespace header
 //    Stack::Stack(const T& header1, const T& header2, ...)
 //    - arguments can be headers, or stacks, all will be concatenated in a new Stack
 ///   - returns a Stack ready to be shipped.
+///
+/// The offsets of the headers are indexed by header type at construction in a small hash table of
+/// sMaxIndexedHeaders slots, Stack::get<HeaderType>() looks up a header in constant time instead
+/// of walking the serialized headers. The index is not part of the serialized buffer.
 struct Stack {
 
   using memory_resource = o2::pmr::memory_resource;
@@ -57,6 +62,34 @@ struct Stack {
   size_t size() const { return bufferSize; }
   allocator_type get_allocator() const { return allocator; }
 
+  /// number of slots of the index, up to sMaxIndexedHeaders - 1 header types are indexed
+  static constexpr int sIndexBits = 3;
+  static constexpr size_t sMaxIndexedHeaders = size_t(1) << sIndexBits;
+
+  /// find a header of type HeaderType in the stack using the index,
+  /// use like this:
+  /// const HeaderType* h = stack.get<HeaderType>()
+  template <typename HeaderType>
+  const HeaderType* get() const noexcept
+  {
+    if (!buffer) {
+      return nullptr;
+    }
+    if (!indexComplete) {
+      return o2::header::get<HeaderType*>(buffer.get());
+    }
+    const uint64_t type = HeaderType::sHeaderType.itg[0];
+    for (size_t probe = 0, slot = indexSlot(type); probe < sMaxIndexedHeaders; ++probe, slot = (slot + 1) % sMaxIndexedHeaders) {
+      if (index[slot].type == type) {
+        return reinterpret_cast<const HeaderType*>(buffer.get() + index[slot].offset);
+      }
+      if (index[slot].type == 0) {
+        break;
+      }
+    }
+    return nullptr;
+  }
+
   //
 
   /// The magic constructors: take arbitrary number of headers and serialize them
@@ -81,12 +114,56 @@ struct Stack {
               freeobj(allocator.resource()) }
   {
     inject(buffer.get(), std::forward<Headers>(headers)...);
+    buildIndex();
   }
 
  private:
+  struct IndexEntry {
+    uint64_t type = 0; ///< the header type, 0 for an empty slot
+    uint32_t offset = 0;
+  };
+
   allocator_type allocator{ boost::container::pmr::new_delete_resource() };
   size_t bufferSize{ 0 };
   BufferType buffer{ nullptr, freeobj{ allocator.resource() } };
+  std::array<IndexEntry, sMaxIndexedHeaders> index{};
+  bool indexComplete{ true };
+
+  /// slot of a header type in the index, multiplicative hashing of the header type
+  static constexpr size_t indexSlot(uint64_t type) noexcept
+  {
+    return (type * 0x9E3779B97F4A7C15ull) >> (64 - sIndexBits);
+  }
+
+  /// index the headers of the serialized buffer, only the first header of a type is indexed,
+  /// as found by walking the stack; stacks with more header types, or with the invalid header
+  /// type, are not indexed
+  void buildIndex() noexcept
+  {
+    size_t nIndexed = 0;
+    for (const BaseHeader* current = BaseHeader::get(buffer.get()); current != nullptr; current = current->next()) {
+      const uint64_t type = current->description.itg[0];
+      if (type == 0) {
+        index.fill(IndexEntry{});
+        indexComplete = false;
+        return;
+      }
+      size_t slot = indexSlot(type);
+      while (index[slot].type != 0 && index[slot].type != type) {
+        slot = (slot + 1) % sMaxIndexedHeaders;
+      }
+      if (index[slot].type == type) {
+        continue;
+      }
+      if (++nIndexed == sMaxIndexedHeaders) {
+        // keep one slot empty, the lookup of a missing type stops at the empty slot
+        index.fill(IndexEntry{});
+        indexComplete = false;
+        return;
+      }
+      index[slot] = { type, static_cast<uint32_t>(current->data() - buffer.get()) };
+    }
+  }
 
   template <typename T, typename... Args>
   static size_t calculateSize(T&& h, Args&&... args) noexcept
@@ -152,6 +229,15 @@ struct Stack {
   }
 };
 
+/// find a header of type HeaderType in a stack, using the index of the stack
+/// use like this:
+/// HeaderType* h = get<HeaderType*>(stack)
+template <typename HeaderType, typename std::enable_if_t<std::is_pointer<HeaderType>::value, int> = 0>
+auto get(const Stack& stack)
+{
+  return stack.get<typename std::remove_pointer<HeaderType>::type>();
+}
+
 } // namespace header
 } // namespace o2
 
@@ -0,0 +1,65 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   benchmark_HeaderStack.cxx
+/// @brief  Benchmark of the header lookup in the serialized buffer and in the index of a Stack
+///
+/// The looked up header is the last one of a stack of DataHeader and a number of
+/// NameHeaders, the argument of the benchmarks is number of headers of the stack.
+
+#include <benchmark/benchmark.h>
+#include "Headers/DataHeader.h"
+#include "Headers/NameHeader.h"
+#include "Headers/Stack.h"
+
+using namespace o2::header;
+
+namespace
+{
+struct LastHeader : public BaseHeader {
+  static const o2::header::HeaderType sHeaderType;
+  static const uint32_t sVersion = 1;
+
+  LastHeader() : BaseHeader(sizeof(LastHeader), sHeaderType, gSerializationMethodNone, sVersion) {}
+
+  uint64_t value = 0;
+};
+constexpr o2::header::HeaderType LastHeader::sHeaderType = "LastHead";
+
+Stack createStack(int nHeaders)
+{
+  Stack stack{ DataHeader{ gDataDescriptionInvalid, gDataOriginInvalid, DataHeader::SubSpecificationType{ 0 }, 0 } };
+  for (int i = 2; i < nHeaders; ++i) {
+    stack = Stack{ stack, NameHeader<16>{ "header" } };
+  }
+  return Stack{ stack, LastHeader{} };
+}
+} // namespace
+
+static void BM_GetFromBuffer(benchmark::State& state)
+{
+  auto stack = createStack(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(get<LastHeader*>(stack.data()));
+  }
+}
+
+static void BM_GetFromIndex(benchmark::State& state)
+{
+  auto stack = createStack(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stack.get<LastHeader>());
+  }
+}
+
+BENCHMARK(BM_GetFromBuffer)->DenseRange(2, 8, 2)->Arg(12);
+BENCHMARK(BM_GetFromIndex)->DenseRange(2, 8, 2)->Arg(12);
+
+BENCHMARK_MAIN();
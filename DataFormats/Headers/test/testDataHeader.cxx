@@ -42,6 +42,15 @@ struct MetaHeader : public BaseHeader {
   uint64_t secret;
 };
 constexpr o2::header::HeaderType MetaHeader::sHeaderType = "MetaHead";
+
+// header types with numerical type descriptions
+template <uint64_t Type>
+struct TypedHeader : public BaseHeader {
+  static constexpr o2::header::HeaderType sHeaderType{ Type };
+  static const uint32_t sVersion = 1;
+
+  TypedHeader() : BaseHeader(sizeof(TypedHeader), sHeaderType, o2::header::gSerializationMethodNone, sVersion) {}
+};
 }
 }
 }
@@ -287,6 +296,51 @@ namespace o2 {
       BOOST_CHECK(h3->secret == 42);
     }
 
+    BOOST_AUTO_TEST_CASE(headerStack_index_test)
+    {
+      DataHeader dh{ gDataDescriptionInvalid, gDataOriginInvalid, DataHeader::SubSpecificationType{ 1 }, 0 };
+      auto meta = test::MetaHeader{ 42 };
+      Stack s1{ dh, NameHeader<9>{ "somename" }, meta };
+
+      BOOST_CHECK(s1.get<DataHeader>() == get<DataHeader*>(s1.data()));
+      BOOST_CHECK(s1.get<NameHeader<0>>() == get<NameHeader<0>*>(s1.data()));
+      BOOST_REQUIRE(get<test::MetaHeader*>(s1) != nullptr);
+      BOOST_CHECK(get<test::MetaHeader*>(s1)->secret == 42);
+
+      // stacks built from stacks are indexed as well
+      Stack s2{ Stack{}, s1 };
+      BOOST_REQUIRE(s2.get<test::MetaHeader>() != nullptr);
+      BOOST_CHECK(s2.get<test::MetaHeader>() == get<test::MetaHeader*>(s2.data()));
+      BOOST_CHECK(Stack{ dh }.get<test::MetaHeader>() == nullptr);
+      BOOST_CHECK(Stack{}.get<DataHeader>() == nullptr);
+
+      // the first header of a type is found
+      Stack s5{ dh, test::MetaHeader{ 1 }, meta };
+      BOOST_CHECK(s5.get<test::MetaHeader>()->secret == 1);
+
+      // stacks with more header types than the capacity of the index are searched by walking the stack
+      Stack s3{ dh, test::TypedHeader<1>{}, test::TypedHeader<2>{}, test::TypedHeader<3>{}, test::TypedHeader<4>{},
+                test::TypedHeader<5>{}, test::TypedHeader<6>{}, test::TypedHeader<7>{}, meta };
+      BOOST_REQUIRE(s3.get<test::MetaHeader>() != nullptr);
+      BOOST_CHECK(s3.get<test::MetaHeader>() == get<test::MetaHeader*>(s3.data()));
+      BOOST_CHECK(s3.get<test::TypedHeader<4>>() == get<test::TypedHeader<4>*>(s3.data()));
+      BOOST_CHECK(s3.get<NameHeader<0>>() == nullptr);
+
+      // all header types of a stack within the capacity of the index are found
+      Stack s6{ dh, test::TypedHeader<1>{}, test::TypedHeader<2>{}, test::TypedHeader<3>{}, test::TypedHeader<4>{},
+                test::TypedHeader<5>{}, meta };
+      BOOST_CHECK(s6.get<DataHeader>() == get<DataHeader*>(s6.data()));
+      BOOST_CHECK(s6.get<test::TypedHeader<1>>() == get<test::TypedHeader<1>*>(s6.data()));
+      BOOST_CHECK(s6.get<test::TypedHeader<5>>() == get<test::TypedHeader<5>*>(s6.data()));
+      BOOST_CHECK(s6.get<test::MetaHeader>() == get<test::MetaHeader*>(s6.data()));
+      BOOST_CHECK(s6.get<test::TypedHeader<6>>() == nullptr);
+
+      // the moved stack keeps the index
+      Stack s4{ std::move(s3) };
+      BOOST_CHECK(s4.get<test::MetaHeader>() == get<test::MetaHeader*>(s4.data()));
+      BOOST_CHECK(s3.get<test::MetaHeader>() == nullptr);
+    }
+
     BOOST_AUTO_TEST_CASE(Descriptor_benchmark)
     {
       using TestDescriptor = Descriptor<8>;
@@ -0,0 +1,127 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @brief Page locked host memory for the GPU stages: a memory resource allocating pinned
+///        buffers and the registration of existing buffers (e.g. received messages) for DMA
+///
+/// With ENABLE_CUDA or ENABLE_HIP the memory is pinned through the GPU runtime
+/// (cudaMallocHost/cudaHostRegister or hipHostMalloc/hipHostRegister), so that the
+/// GPU can copy it directly without an intermediate staging buffer. Without GPU
+/// support the memory is only locked in RAM (mlock), on a best effort basis.
+
+#ifndef ALICEO2_PINNED_MEMORY_RESOURCE_
+#define ALICEO2_PINNED_MEMORY_RESOURCE_
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/pmr/memory_resource.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <FairMQMessage.h>
+
+namespace o2
+{
+
+namespace pmr
+{
+
+//__________________________________________________________________________________________________
+/// Memory resource allocating page locked host memory, meant for the buffers the GPU stages
+/// upload from or download to. Allocations are expensive, so this is best used upstream of a
+/// pool or monotonic resource.
+class PinnedMemoryResource : public boost::container::pmr::memory_resource
+{
+ public:
+  PinnedMemoryResource() noexcept = default;
+  PinnedMemoryResource(const PinnedMemoryResource&) = delete;
+  PinnedMemoryResource& operator=(const PinnedMemoryResource&) = delete;
+
+  /// true if the memory is pinned through a GPU runtime, false for the mlock fallback
+  static bool isGPUPinned() noexcept;
+
+  /// the process wide instance
+  static PinnedMemoryResource* instance();
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+//__________________________________________________________________________________________________
+/// Registration of existing host memory with the GPU runtime, making it usable for DMA.
+/// Ranges are extended to full pages and only the parts not registered yet are passed to the
+/// runtime, so it is cheap to register every received message: once the pages of the shared
+/// memory segment are registered the following messages in them cost a lookup.
+/// Whole regions (e.g. a FairMQUnmanagedRegion) are best registered once with a
+/// ScopedHostRegistration.
+class HostMemoryRegistry
+{
+ public:
+  /// the process wide instance, the GPU runtime registration being process wide as well
+  static HostMemoryRegistry& instance();
+
+  HostMemoryRegistry() = default;
+  HostMemoryRegistry(const HostMemoryRegistry&) = delete;
+  HostMemoryRegistry& operator=(const HostMemoryRegistry&) = delete;
+  ~HostMemoryRegistry();
+
+  /// register the pages spanned by [ptr, ptr + size)
+  /// @return false if the GPU runtime refused (part of) the range
+  bool registerRange(const void* ptr, size_t size);
+  /// register the payload of a received message
+  bool registerMessage(const FairMQMessage& message) { return registerRange(message.GetData(), message.GetSize()); }
+  /// unregister the registered ranges contained in the pages spanned by [ptr, ptr + size)
+  void unregisterRange(const void* ptr, size_t size);
+  /// unregister everything
+  void clear();
+
+  /// @return true if all the pages spanned by [ptr, ptr + size) are registered
+  bool isRegistered(const void* ptr, size_t size) const;
+  /// @return the number of bytes registered, in full pages
+  size_t getRegisteredBytes() const;
+  /// @return the number of ranges passed to the GPU runtime
+  size_t getNumberOfRanges() const;
+
+ private:
+  static uintptr_t pageSize();
+
+  mutable std::mutex mMutex;
+  boost::container::flat_map<uintptr_t, uintptr_t> mRanges; ///< registered [begin, end), page aligned
+};
+
+//__________________________________________________________________________________________________
+/// Registers a region (e.g. the whole shared memory segment or an unmanaged region) for the
+/// lifetime of the object
+class ScopedHostRegistration
+{
+ public:
+  ScopedHostRegistration(const void* ptr, size_t size, HostMemoryRegistry& registry = HostMemoryRegistry::instance())
+    : mRegistry{ registry }, mPtr{ ptr }, mSize{ size }, mRegistered{ registry.registerRange(ptr, size) }
+  {
+  }
+  ScopedHostRegistration(const ScopedHostRegistration&) = delete;
+  ScopedHostRegistration& operator=(const ScopedHostRegistration&) = delete;
+  ~ScopedHostRegistration() { mRegistry.unregisterRange(mPtr, mSize); }
+
+  bool isRegistered() const { return mRegistered; }
+
+ private:
+  HostMemoryRegistry& mRegistry;
+  const void* mPtr;
+  size_t mSize;
+  bool mRegistered;
+};
+
+}; //namespace pmr
+
+}; //namespace o2
+
+#endif
@@ -0,0 +1,252 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "MemoryResources/PinnedMemoryResource.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(ENABLE_CUDA)
+#include <cuda_runtime_api.h>
+#elif defined(ENABLE_HIP)
+#include <hip/hip_runtime_api.h>
+#endif
+
+namespace o2
+{
+namespace pmr
+{
+
+namespace
+{
+// the GPU runtimes return page aligned memory, so does the fallback
+constexpr size_t PINNEDALIGNMENT = 4096;
+
+void* hostAlloc(size_t bytes)
+{
+  void* p = nullptr;
+#if defined(ENABLE_CUDA)
+  if (cudaMallocHost(&p, bytes) != cudaSuccess) {
+    return nullptr;
+  }
+#elif defined(ENABLE_HIP)
+  if (hipHostMalloc(&p, bytes, hipHostMallocDefault) != hipSuccess) {
+    return nullptr;
+  }
+#else
+  if (posix_memalign(&p, PINNEDALIGNMENT, bytes) != 0) {
+    return nullptr;
+  }
+  // may fail with a low RLIMIT_MEMLOCK, the memory is then only pageable
+  mlock(p, bytes);
+#endif
+  return p;
+}
+
+void hostFree(void* p, size_t bytes)
+{
+#if defined(ENABLE_CUDA)
+  cudaFreeHost(p);
+#elif defined(ENABLE_HIP)
+  hipHostFree(p);
+#else
+  munlock(p, bytes);
+  free(p);
+#endif
+}
+
+bool hostRegister(uintptr_t begin, uintptr_t end)
+{
+  auto p = reinterpret_cast<void*>(begin);
+#if defined(ENABLE_CUDA)
+  return cudaHostRegister(p, end - begin, cudaHostRegisterDefault) == cudaSuccess;
+#elif defined(ENABLE_HIP)
+  return hipHostRegister(p, end - begin, hipHostRegisterDefault) == hipSuccess;
+#else
+  // nothing will DMA from it, locking is best effort
+  mlock(p, end - begin);
+  return true;
+#endif
+}
+
+void hostUnregister(uintptr_t begin, uintptr_t end)
+{
+  auto p = reinterpret_cast<void*>(begin);
+#if defined(ENABLE_CUDA)
+  cudaHostUnregister(p);
+#elif defined(ENABLE_HIP)
+  hipHostUnregister(p);
+#else
+  munlock(p, end - begin);
+#endif
+}
+} // namespace
+
+//__________________________________________________________________________________________________
+bool PinnedMemoryResource::isGPUPinned() noexcept
+{
+#if defined(ENABLE_CUDA) || defined(ENABLE_HIP)
+  return true;
+#else
+  return false;
+#endif
+}
+
+PinnedMemoryResource* PinnedMemoryResource::instance()
+{
+  static PinnedMemoryResource resource;
+  return &resource;
+}
+
+void* PinnedMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+  if (alignment > PINNEDALIGNMENT) {
+    throw std::bad_alloc();
+  }
+  void* p = hostAlloc(std::max<std::size_t>(bytes, 1));
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void PinnedMemoryResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+  hostFree(p, std::max<std::size_t>(bytes, 1));
+}
+
+//__________________________________________________________________________________________________
+HostMemoryRegistry& HostMemoryRegistry::instance()
+{
+  static HostMemoryRegistry registry;
+  return registry;
+}
+
+HostMemoryRegistry::~HostMemoryRegistry()
+{
+  clear();
+}
+
+uintptr_t HostMemoryRegistry::pageSize()
+{
+  static const uintptr_t size = sysconf(_SC_PAGESIZE);
+  return size;
+}
+
+bool HostMemoryRegistry::registerRange(const void* ptr, size_t size)
+{
+  if (!size) {
+    return true;
+  }
+  const uintptr_t mask = pageSize() - 1;
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~mask;
+  const uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size + mask) & ~mask;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  // collect the gaps between the ranges already registered, the runtime refuses
+  // pages which are registered twice
+  std::vector<std::pair<uintptr_t, uintptr_t>> gaps;
+  uintptr_t current = begin;
+  auto it = mRanges.upper_bound(begin);
+  if (it != mRanges.begin()) {
+    current = std::max(current, std::prev(it)->second);
+  }
+  for (; current < end && it != mRanges.end() && it->first < end; ++it) {
+    if (current < it->first) {
+      gaps.emplace_back(current, it->first);
+    }
+    current = std::max(current, it->second);
+  }
+  if (current < end) {
+    gaps.emplace_back(current, end);
+  }
+
+  bool ok = true;
+  for (const auto& gap : gaps) {
+    if (hostRegister(gap.first, gap.second)) {
+      mRanges.emplace(gap.first, gap.second);
+    } else {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+void HostMemoryRegistry::unregisterRange(const void* ptr, size_t size)
+{
+  const uintptr_t mask = pageSize() - 1;
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~mask;
+  const uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size + mask) & ~mask;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = mRanges.lower_bound(begin);
+  while (it != mRanges.end() && it->first < end) {
+    if (it->second <= end) {
+      hostUnregister(it->first, it->second);
+      it = mRanges.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void HostMemoryRegistry::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (const auto& range : mRanges) {
+    hostUnregister(range.first, range.second);
+  }
+  mRanges.clear();
+}
+
+bool HostMemoryRegistry::isRegistered(const void* ptr, size_t size) const
+{
+  if (!size) {
+    return true;
+  }
+  const uintptr_t mask = pageSize() - 1;
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~mask;
+  const uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size + mask) & ~mask;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = mRanges.upper_bound(begin);
+  if (it == mRanges.begin()) {
+    return false;
+  }
+  uintptr_t current = std::prev(it)->second;
+  // the ranges are disjoint, the covered part has to be contiguous
+  for (; current < end && it != mRanges.end() && it->first == current; ++it) {
+    current = it->second;
+  }
+  return current >= end;
+}
+
+size_t HostMemoryRegistry::getRegisteredBytes() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  size_t bytes = 0;
+  for (const auto& range : mRanges) {
+    bytes += range.second - range.first;
+  }
+  return bytes;
+}
+
+size_t HostMemoryRegistry::getNumberOfRanges() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mRanges.size();
+}
+
+} // namespace pmr
+} // namespace o2
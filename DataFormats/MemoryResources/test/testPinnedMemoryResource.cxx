@@ -0,0 +1,83 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PinnedMemoryResource
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "MemoryResources/PinnedMemoryResource.h"
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <cstdint>
+#include <vector>
+#include <unistd.h>
+
+namespace o2
+{
+namespace pmr
+{
+
+BOOST_AUTO_TEST_CASE(pinnedresource_test)
+{
+  auto resource = PinnedMemoryResource::instance();
+  BOOST_CHECK(resource->is_equal(*PinnedMemoryResource::instance()));
+
+  std::vector<int, boost::container::pmr::polymorphic_allocator<int>> v(resource);
+  for (int i = 0; i < 10000; ++i) {
+    v.push_back(i);
+  }
+  BOOST_CHECK(v[9999] == 9999);
+  BOOST_CHECK(reinterpret_cast<uintptr_t>(v.data()) % 64 == 0);
+}
+
+BOOST_AUTO_TEST_CASE(registry_test)
+{
+  const size_t page = sysconf(_SC_PAGESIZE);
+  HostMemoryRegistry registry;
+  std::vector<char> buffer(16 * page);
+  // a page aligned base, leaving room on both sides
+  char* base = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(buffer.data()) + page - 1) & ~(page - 1));
+
+  // sub-page ranges are extended to full pages
+  BOOST_CHECK(registry.registerRange(base + 10, 100));
+  BOOST_CHECK(registry.isRegistered(base, page));
+  BOOST_CHECK(!registry.isRegistered(base, page + 1));
+  BOOST_CHECK(registry.getRegisteredBytes() == page);
+
+  // registering again is a no-op
+  BOOST_CHECK(registry.registerRange(base + 200, 300));
+  BOOST_CHECK(registry.getNumberOfRanges() == 1);
+
+  // overlapping ranges only register the missing pages
+  BOOST_CHECK(registry.registerRange(base + 3 * page, page));
+  BOOST_CHECK(registry.registerRange(base + page / 2, 4 * page));
+  BOOST_CHECK(registry.getNumberOfRanges() == 4);
+  BOOST_CHECK(registry.getRegisteredBytes() == 5 * page);
+  BOOST_CHECK(registry.isRegistered(base, 5 * page));
+  BOOST_CHECK(!registry.isRegistered(base, 6 * page));
+
+  registry.unregisterRange(base + 3 * page, page);
+  BOOST_CHECK(registry.getNumberOfRanges() == 3);
+  BOOST_CHECK(!registry.isRegistered(base, 5 * page));
+  BOOST_CHECK(registry.isRegistered(base + 4 * page, page));
+
+  {
+    ScopedHostRegistration scoped(base + 8 * page, 2 * page, registry);
+    BOOST_CHECK(scoped.isRegistered());
+    BOOST_CHECK(registry.isRegistered(base + 8 * page, 2 * page));
+  }
+  BOOST_CHECK(!registry.isRegistered(base + 8 * page, 1));
+
+  registry.clear();
+  BOOST_CHECK(registry.getNumberOfRanges() == 0);
+  BOOST_CHECK(registry.registerRange(base, 0));
+}
+
+}; // namespace pmr
+}; // namespace o2
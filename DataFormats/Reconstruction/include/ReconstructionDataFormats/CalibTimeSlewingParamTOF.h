@@ -14,6 +14,8 @@
 #ifndef ALICEO2_CALIBTIMESLEWINGPARAMTOF_H
 #define ALICEO2_CALIBTIMESLEWINGPARAMTOF_H
 
+#include <gsl/span>
+#include <utility>
 #include <vector>
 
 namespace o2
@@ -26,11 +28,42 @@ class CalibTimeSlewingParamTOF
   static const int NCHANNELS = 157248;                     //
   static const int NSECTORS = 18;                          //
   static const int NCHANNELXSECTOR = NCHANNELS / NSECTORS; //
+  static const int NLUTBINS = 32;                          // ToT nodes per channel of the compiled time slewing
 
   CalibTimeSlewingParamTOF();
 
   float evalTimeSlewing(int channel, float tot) const;
 
+  /// Compiles the time slewing into a table of NLUTBINS nodes per channel, evenly spaced between
+  /// the first and the last ToT of the channel and contiguous across the channels, so that the
+  /// evaluation is one indexed access instead of the search of the channel segment. The table is
+  /// dropped when the time slewing changes.
+  void compileLUT();
+
+  bool hasLUT() const { return !mLUT.empty(); }
+
+  /// evalTimeSlewing from the compiled table, the linear interpolation between its nodes
+  float evalTimeSlewingLUT(int channel, float tot) const
+  {
+    if (static_cast<unsigned int>(channel) >= NCHANNELS) {
+      return 0.; // something went wrong!
+    }
+    const auto& range = mLUTRange[channel];
+    if (tot < range.first) {
+      return 0.; // tot is lower than the first available value, or no value for that channel
+    }
+    const float* nodes = &mLUT[channel * NLUTBINS];
+    float x = (tot - range.first) * range.second;
+    if (x >= NLUTBINS - 1) {
+      return nodes[NLUTBINS - 1];
+    }
+    int bin = static_cast<int>(x);
+    return nodes[bin] + (x - bin) * (nodes[bin + 1] - nodes[bin]);
+  }
+
+  /// evalTimeSlewing(channels[i], tots[i]) for all i, from the compiled table if there is one
+  void evalTimeSlewing(gsl::span<const int> channels, gsl::span<const float> tots, gsl::span<float> timeSlewing) const;
+
   void addTimeSlewingInfo(int channel, float tot, float time);
 
   const std::vector<std::pair<float, float>>* getVector(int sector) const { return mTimeSlewing[sector]; }
@@ -57,6 +90,9 @@ class CalibTimeSlewingParamTOF
   CalibTimeSlewingParamTOF& operator+=(const CalibTimeSlewingParamTOF& other);
 
  private:
+  /// @return the index after the last element of a channel in the time slewing vector of its sector
+  int getChannelStop(int sector, int channel) const;
+
   // TOF channel calibrations
   int mChannelStart[NSECTORS][NCHANNELXSECTOR];           ///< array with the index of the first element of a channel in the time slewing vector (per sector)
   std::vector<std::pair<float, float>>* mTimeSlewing[18]; //! pointers to the sector vectors
@@ -84,6 +120,9 @@ class CalibTimeSlewingParamTOF
   float mSigmaPeak[NSECTORS][NCHANNELXSECTOR];         ///< array with the sigma of the peak
   float mSigmaErrPeak[NSECTORS][NCHANNELXSECTOR];      ///< array with the sigma of the peak
 
+  std::vector<float> mLUT;                        //! compiled time slewing, NLUTBINS nodes per channel
+  std::vector<std::pair<float, float>> mLUTRange; //! <tot of the first node, inverse of the tot step> per channel
+
   //  ClassDefNV(CalibTimeSlewingParamTOF, 2); // class for TOF time slewing params
 };
 }
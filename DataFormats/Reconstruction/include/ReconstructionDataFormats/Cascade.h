@@ -0,0 +1,105 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file Cascade.h
+/// \brief Cascade candidate: secondary vertex of a V0 and a bachelor track
+
+#ifndef ALICEO2_CASCADE_H
+#define ALICEO2_CASCADE_H
+
+#include <array>
+#include <cmath>
+#include "ReconstructionDataFormats/V0.h"
+
+namespace o2
+{
+namespace dataformats
+{
+
+class Cascade
+{
+  using Track = o2::track::TrackParCov;
+  using timeEst = o2::dataformats::TimeStampWithError<float, float>;
+
+ public:
+  Cascade() = default;
+  ~Cascade() = default;
+  Cascade(const std::array<float, 3>& xyz, const V0& v0, int v0ID, const Track& bachelor, int bachelorID, float dca,
+          float cosPA, const timeEst& t)
+    : mXYZ(xyz), mV0(v0), mV0ID(v0ID), mBachelor(bachelor), mBachelorID(bachelorID), mDCA(dca), mCosPA(cosPA), mTimeMUS(t)
+  {
+  }
+
+  const std::array<float, 3>& getXYZ() const { return mXYZ; }
+  float getX() const { return mXYZ[0]; }
+  float getY() const { return mXYZ[1]; }
+  float getZ() const { return mXYZ[2]; }
+  float getR() const { return std::sqrt(mXYZ[0] * mXYZ[0] + mXYZ[1] * mXYZ[1]); }
+
+  ///< V0 of the cascade
+  const V0& getV0() const { return mV0; }
+  ///< index of the V0 among the V0 candidates, -1 if it was not accepted as a V0 on its own
+  int getV0ID() const { return mV0ID; }
+
+  ///< bachelor track at the cascade vertex
+  const Track& getBachelor() const { return mBachelor; }
+  ///< index of the bachelor in the input tracks
+  int getBachelorID() const { return mBachelorID; }
+
+  ///< distance between the V0 line and the bachelor at the vertex
+  float getDCA() const { return mDCA; }
+  ///< cosine of the pointing angle to the beam line in the transverse plane
+  float getCosPA() const { return mCosPA; }
+
+  const timeEst& getTimeMUS() const { return mTimeMUS; }
+
+  ///< momentum of the cascade, sum of the V0 and bachelor momenta
+  void getPxPyPz(std::array<float, 3>& pxyz) const
+  {
+    std::array<float, 3> pBach;
+    mV0.getPxPyPz(pxyz);
+    mBachelor.getPxPyPzGlo(pBach);
+    for (int i = 0; i < 3; i++) {
+      pxyz[i] += pBach[i];
+    }
+  }
+
+  ///< invariant mass^2 for the masses of the V0 and of the bachelor
+  float calcMass2(float massV0, float massBachelor) const
+  {
+    std::array<float, 3> pV0, pBach;
+    mV0.getPxPyPz(pV0);
+    mBachelor.getPxPyPzGlo(pBach);
+    float p2V0 = 0.f, p2Bach = 0.f, p2 = 0.f;
+    for (int i = 0; i < 3; i++) {
+      p2V0 += pV0[i] * pV0[i];
+      p2Bach += pBach[i] * pBach[i];
+      p2 += (pV0[i] + pBach[i]) * (pV0[i] + pBach[i]);
+    }
+    const float e = std::sqrt(p2V0 + massV0 * massV0) + std::sqrt(p2Bach + massBachelor * massBachelor);
+    return e * e - p2;
+  }
+
+ private:
+  std::array<float, 3> mXYZ = { 0.f, 0.f, 0.f }; ///< vertex position
+  V0 mV0;                                         ///< V0 at its own vertex
+  int mV0ID = -1;                                 ///< index of the V0 among the V0 candidates
+  Track mBachelor;                                ///< bachelor at the cascade vertex
+  int mBachelorID = -1;                           ///< bachelor index in the input tracks
+  float mDCA = 0.f;                               ///< distance between the V0 and the bachelor
+  float mCosPA = 0.f;                             ///< cosine of the transverse pointing angle
+  timeEst mTimeMUS;                               ///< time estimate in \mus
+
+  ClassDefNV(Cascade, 1);
+};
+} // namespace dataformats
+} // namespace o2
+
+#endif
@@ -78,8 +78,19 @@ constexpr float HugeF = 1e33; // large float as dummy value
 // helper function
 float BetheBlochSolid(float bg, float rho = 2.33f, float kp1 = 0.20f, float kp2 = 3.00f, float meanI = 173e-9f,
                       float meanZA = 0.49848f);
+// BetheBlochSolid with the default (silicon) parameters, tabulated in bins of beta*gamma and linearly
+// interpolated, without any log or sqrt; outside of the tabulated range the parameterization is evaluated
+float BetheBlochSolidTab(float bg);
 void g3helx3(float qfield, float step, std::array<float, 7>& vect);
 
+// energy loss policies for TrackParCov::correctForMaterial
+struct BetheBlochExact {
+  static float getdEdx(float bg) { return BetheBlochSolid(bg); }
+};
+struct BetheBlochTabulated {
+  static float getdEdx(float bg) { return BetheBlochSolidTab(bg); }
+};
+
 class TrackPar
 { // track parameterization, kinematics only.
  public:
@@ -235,6 +246,8 @@ class TrackParCov : public TrackPar
   bool update(const TrackParCov& rhs, const MatrixDSym5& covInv);
   bool update(const TrackParCov& rhs);
 
+  // dEdxPolicy provides the energy loss when dedx is to be calculated on the fly
+  template <typename dEdxPolicy = BetheBlochExact>
   bool correctForMaterial(float x2x0, float xrho, float mass, bool anglecorr = false, float dedx = kCalcdEdxAuto);
 
   void resetCovariance(float s2 = 0);
@@ -0,0 +1,386 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TrackParCovBatch.h
+/// \brief Batch of N tracks with covariance in SoA layout, with the TrackParCov kernels vectorized over the tracks
+///
+/// The kernels repeat the arithmetic of TrackParCov::propagateTo, rotate and update operation by operation, in
+/// the same precision, hence they give the same results. The loops over the tracks are branch free: every track
+/// is processed and the results of the tracks failing a precondition are dropped, which leaves them unchanged as
+/// the scalar methods do. Only the trigonometric functions, which do not vectorize, are evaluated in separate
+/// scalar loops: the sin/cos of the rotation angle and the arc in the rare propagations with large curvature.
+/// Whether the compiler turns the loops into vector code depends on the FP flags: with the default math errno
+/// and trapping math gcc keeps them scalar, with -fno-math-errno -fno-trapping-math rotate and update vectorize.
+
+#ifndef ALICEO2_BASE_TRACKPARCOVBATCH
+#define ALICEO2_BASE_TRACKPARCOVBATCH
+
+#include <array>
+#include <cmath>
+#include "ReconstructionDataFormats/Track.h"
+
+namespace o2
+{
+namespace track
+{
+
+template <int N>
+class TrackParCovBatch
+{
+ public:
+  static constexpr int Size = N;
+  using Mask = std::array<bool, N>;
+
+  TrackParCovBatch() = default;
+
+  void setTrack(int i, const TrackParCov& trc)
+  {
+    mX[i] = trc.getX();
+    mAlpha[i] = trc.getAlpha();
+    for (int ip = 0; ip < kNParams; ip++) {
+      mP[ip][i] = trc.getParam(ip);
+    }
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      mC[ic][i] = trc.getCov()[ic];
+    }
+  }
+
+  TrackParCov getTrack(int i) const
+  {
+    std::array<float, kNParams> par;
+    std::array<float, kCovMatSize> cov;
+    for (int ip = 0; ip < kNParams; ip++) {
+      par[ip] = mP[ip][i];
+    }
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      cov[ic] = mC[ic][i];
+    }
+    return TrackParCov(mX[i], mAlpha[i], par, cov);
+  }
+
+  float getX(int i) const { return mX[i]; }
+  float getAlpha(int i) const { return mAlpha[i]; }
+  float getParam(int ip, int i) const { return mP[ip][i]; }
+  float getCovarElem(int ic, int i) const { return mC[ic][i]; }
+
+  /// TrackParCov::propagateTo(xk, b) for all the tracks, ok is false where it would fail
+  void propagateTo(float xk, float b, Mask& ok);
+
+  /// TrackParCov::rotate(alpha) for all the tracks, ok is false where it would fail
+  void rotate(float alpha, Mask& ok);
+
+  /// TrackParCov::update(p[i], cov[i]) for every track i, ok is false where it would fail
+  void update(const std::array<float, 2> (&p)[N], const std::array<float, 3> (&cov)[N], Mask& ok);
+
+  /// TrackParCov::update(clusters[i]) for every track i
+  template <typename T>
+  void update(const BaseCluster<T> (&clusters)[N], Mask& ok)
+  {
+    std::array<float, 2> p[N];
+    std::array<float, 3> cov[N];
+    for (int i = 0; i < N; i++) {
+      p[i] = { clusters[i].getY(), clusters[i].getZ() };
+      cov[i] = { clusters[i].getSigmaY2(), clusters[i].getSigmaYZ(), clusters[i].getSigmaZ2() };
+    }
+    update(p, cov, ok);
+  }
+
+ private:
+  /// TrackParCov::checkCovariance for the updated tracks
+  void checkCovariance(const Mask& ok);
+  static void limitDiag(float* __restrict__ diag, float* __restrict__ c0, float* __restrict__ c1,
+                        float* __restrict__ c2, float* __restrict__ c3, float max, const Mask& ok);
+
+  alignas(64) float mX[N] = { 0.f };
+  alignas(64) float mAlpha[N] = { 0.f };
+  alignas(64) float mP[kNParams][N] = { { 0.f } };
+  alignas(64) float mC[kCovMatSize][N] = { { 0.f } };
+};
+
+//______________________________________________________________
+template <int N>
+void TrackParCovBatch<N>::propagateTo(float xk, float b, Mask& ok)
+{
+  using namespace o2::constants::math;
+  Mask moved, largeArc;
+  float f1s[N], f2s[N], r1s[N], r2s[N], crvs[N];
+
+  for (int i = 0; i < N; i++) {
+    float snp = mP[kSnp][i], tgl = mP[kTgl][i], q2pt = mP[kQ2Pt][i];
+    float dx = xk - mX[i];
+    bool noop = std::abs(dx) < Almost0;
+    float crv = q2pt * b * B2C;
+    crv = (std::abs(b) < Almost0) ? 0.f : crv;
+    float x2r = crv * dx;
+    float f1 = snp, f2 = f1 + x2r;
+    bool good = !((std::abs(f1) > Almost1) | (std::abs(f2) > Almost1) | (std::abs(q2pt) < Almost0));
+    float r1 = sqrtf(std::max((1.f - f1) * (1.f + f1), 0.f));
+    float r2 = sqrtf(std::max((1.f - f2) * (1.f + f2), 0.f));
+    good = good & !(std::abs(r1) < Almost0) & !(std::abs(r2) < Almost0);
+    bool upd = good & !noop;
+    ok[i] = noop | good;
+    moved[i] = upd;
+    largeArc[i] = upd & !(std::abs(x2r) < 0.05f);
+    f1s[i] = f1;
+    f2s[i] = f2;
+    r1s[i] = r1;
+    r2s[i] = r2;
+    crvs[i] = crv;
+
+    double dy2dx = (f1 + f2) / (r1 + r2);
+    float dY = dx * dy2dx;
+    float dZ = dx * (r2 + f2 * dy2dx) * tgl; // replaced below for the large arcs
+
+    const float c00 = mC[kSigY2][i], c10 = mC[kSigZY][i], c11 = mC[kSigZ2][i], c20 = mC[kSigSnpY][i],
+                c21 = mC[kSigSnpZ][i], c22 = mC[kSigSnp2][i], c30 = mC[kSigTglY][i], c31 = mC[kSigTglZ][i],
+                c32 = mC[kSigTglSnp][i], c33 = mC[kSigTgl2][i], c40 = mC[kSigQ2PtY][i], c41 = mC[kSigQ2PtZ][i],
+                c42 = mC[kSigQ2PtSnp][i], c43 = mC[kSigQ2PtTgl][i], c44 = mC[kSigQ2Pt2][i];
+
+    // evaluate matrix in double prec.
+    double rinv = 1. / r1;
+    double r3inv = rinv * rinv * rinv;
+    double f24 = dx * b * B2C;
+    double f02 = dx * r3inv;
+    double f04 = 0.5 * f24 * f02;
+    double f12 = f02 * tgl * f1;
+    double f14 = 0.5 * f24 * f12;
+    double f13 = dx * rinv;
+
+    // b = C*ft
+    double b00 = f02 * c20 + f04 * c40, b01 = f12 * c20 + f14 * c40 + f13 * c30;
+    double b02 = f24 * c40;
+    double b10 = f02 * c21 + f04 * c41, b11 = f12 * c21 + f14 * c41 + f13 * c31;
+    double b12 = f24 * c41;
+    double b20 = f02 * c22 + f04 * c42, b21 = f12 * c22 + f14 * c42 + f13 * c32;
+    double b22 = f24 * c42;
+    double b40 = f02 * c42 + f04 * c44, b41 = f12 * c42 + f14 * c44 + f13 * c43;
+    double b42 = f24 * c44;
+    double b30 = f02 * c32 + f04 * c43, b31 = f12 * c32 + f14 * c43 + f13 * c33;
+    double b32 = f24 * c43;
+
+    // a = f*b = f*C*ft
+    double a00 = f02 * b20 + f04 * b40, a01 = f02 * b21 + f04 * b41, a02 = f02 * b22 + f04 * b42;
+    double a11 = f12 * b21 + f14 * b41 + f13 * b31, a12 = f12 * b22 + f14 * b42 + f13 * b32;
+    double a22 = f24 * b42;
+
+    // F*C*Ft = C + (b + bt + a)
+    float nY2 = c00 + (b00 + b00 + a00);
+    mC[kSigY2][i] = upd ? nY2 : c00;
+    float nZY = c10 + (b10 + b01 + a01);
+    mC[kSigZY][i] = upd ? nZY : c10;
+    float nSnpY = c20 + (b20 + b02 + a02);
+    mC[kSigSnpY][i] = upd ? nSnpY : c20;
+    float nTglY = c30 + b30;
+    mC[kSigTglY][i] = upd ? nTglY : c30;
+    float nQ2PtY = c40 + b40;
+    mC[kSigQ2PtY][i] = upd ? nQ2PtY : c40;
+    float nZ2 = c11 + (b11 + b11 + a11);
+    mC[kSigZ2][i] = upd ? nZ2 : c11;
+    float nSnpZ = c21 + (b21 + b12 + a12);
+    mC[kSigSnpZ][i] = upd ? nSnpZ : c21;
+    float nTglZ = c31 + b31;
+    mC[kSigTglZ][i] = upd ? nTglZ : c31;
+    float nQ2PtZ = c41 + b41;
+    mC[kSigQ2PtZ][i] = upd ? nQ2PtZ : c41;
+    float nSnp2 = c22 + (b22 + b22 + a22);
+    mC[kSigSnp2][i] = upd ? nSnp2 : c22;
+    float nTglSnp = c32 + b32;
+    mC[kSigTglSnp][i] = upd ? nTglSnp : c32;
+    float nQ2PtSnp = c42 + b42;
+    mC[kSigQ2PtSnp][i] = upd ? nQ2PtSnp : c42;
+
+    float y = mP[kY][i] + dY, z = mP[kZ][i] + dZ, updSnp = snp + x2r;
+    mX[i] = upd ? xk : mX[i];
+    mP[kY][i] = upd ? y : mP[kY][i];
+    mP[kZ][i] = (upd & !largeArc[i]) ? z : mP[kZ][i];
+    mP[kSnp][i] = upd ? updSnp : snp;
+  }
+
+  // Z along the arc for the large rotations, see TrackParCov::propagateTo
+  for (int i = 0; i < N; i++) {
+    if (!largeArc[i]) {
+      continue;
+    }
+    float f1 = f1s[i], f2 = f2s[i], r1 = r1s[i], r2 = r2s[i];
+    float rot = asinf(r1 * f2 - r2 * f1);
+    if (f1 * f1 + f2 * f2 > 1.f && f1 * f2 < 0.f) {
+      if (f2 > 0.f) {
+        rot = PI - rot;
+      } else {
+        rot = -PI - rot;
+      }
+    }
+    mP[kZ][i] += mP[kTgl][i] / crvs[i] * rot;
+  }
+
+  checkCovariance(moved);
+}
+
+//______________________________________________________________
+template <int N>
+void TrackParCovBatch<N>::rotate(float alpha, Mask& ok)
+{
+  using namespace o2::constants::math;
+  utils::BringToPMPi(alpha);
+  float sas[N], cas[N];
+  for (int i = 0; i < N; i++) {
+    utils::sincosf(alpha - mAlpha[i], sas[i], cas[i]);
+  }
+
+  for (int i = 0; i < N; i++) {
+    float ca = cas[i], sa = sas[i];
+    float snp = mP[kSnp][i], csp = sqrtf(std::max((1.f - snp) * (1.f + snp), 0.f));
+    float updSnp = snp * ca - csp * sa;
+    bool upd = !(std::abs(snp) > Almost1) & !((csp * ca + snp * sa) < 0) & !(std::abs(updSnp) > Almost1);
+    ok[i] = upd;
+
+    float xold = mX[i], yold = mP[kY][i];
+    float x = xold * ca + yold * sa, y = -xold * sa + yold * ca;
+    mAlpha[i] = upd ? alpha : mAlpha[i];
+    mX[i] = upd ? x : xold;
+    mP[kY][i] = upd ? y : yold;
+    mP[kSnp][i] = upd ? updSnp : snp;
+
+    csp = (std::abs(csp) < Almost0) ? Almost0 : csp;
+    float rr = (ca + snp / csp * sa);
+
+    float ca2 = ca * ca, carr = ca * rr, rr2 = rr * rr;
+    ca = upd ? ca : 1.f;
+    rr = upd ? rr : 1.f;
+    mC[kSigY2][i] *= upd ? ca2 : 1.f;
+    mC[kSigZY][i] *= ca;
+    mC[kSigSnpY][i] *= upd ? carr : 1.f;
+    mC[kSigSnpZ][i] *= rr;
+    mC[kSigSnp2][i] *= upd ? rr2 : 1.f;
+    mC[kSigTglY][i] *= ca;
+    mC[kSigTglSnp][i] *= rr;
+    mC[kSigQ2PtY][i] *= ca;
+    mC[kSigQ2PtSnp][i] *= rr;
+  }
+
+  checkCovariance(ok);
+}
+
+//______________________________________________________________
+template <int N>
+void TrackParCovBatch<N>::update(const std::array<float, 2> (&p)[N], const std::array<float, 3> (&cov)[N], Mask& ok)
+{
+  using namespace o2::constants::math;
+  for (int i = 0; i < N; i++) {
+    const float cm00 = mC[kSigY2][i], cm10 = mC[kSigZY][i], cm11 = mC[kSigZ2][i], cm20 = mC[kSigSnpY][i],
+                cm21 = mC[kSigSnpZ][i], cm22 = mC[kSigSnp2][i], cm30 = mC[kSigTglY][i], cm31 = mC[kSigTglZ][i],
+                cm32 = mC[kSigTglSnp][i], cm33 = mC[kSigTgl2][i], cm40 = mC[kSigQ2PtY][i], cm41 = mC[kSigQ2PtZ][i],
+                cm42 = mC[kSigQ2PtSnp][i], cm43 = mC[kSigQ2PtTgl][i], cm44 = mC[kSigQ2Pt2][i];
+
+    double r00 = static_cast<double>(cov[i][0]) + static_cast<double>(cm00);
+    double r01 = static_cast<double>(cov[i][1]) + static_cast<double>(cm10);
+    double r11 = static_cast<double>(cov[i][2]) + static_cast<double>(cm11);
+    double det = r00 * r11 - r01 * r01;
+    bool upd = !(std::abs(det) < Almost0);
+
+    double detI = 1. / det;
+    double tmp = r00;
+    r00 = r11 * detI;
+    r11 = tmp * detI;
+    r01 = -r01 * detI;
+
+    double k00 = cm00 * r00 + cm10 * r01, k01 = cm00 * r01 + cm10 * r11;
+    double k10 = cm10 * r00 + cm11 * r01, k11 = cm10 * r01 + cm11 * r11;
+    double k20 = cm20 * r00 + cm21 * r01, k21 = cm20 * r01 + cm21 * r11;
+    double k30 = cm30 * r00 + cm31 * r01, k31 = cm30 * r01 + cm31 * r11;
+    double k40 = cm40 * r00 + cm41 * r01, k41 = cm40 * r01 + cm41 * r11;
+
+    float dy = p[i][kY] - mP[kY][i], dz = p[i][kZ] - mP[kZ][i];
+    float dsnp = k20 * dy + k21 * dz;
+    upd = upd & !(std::abs(mP[kSnp][i] + dsnp) > Almost1);
+    ok[i] = upd;
+
+    float dY = k00 * dy + k01 * dz, dZ = k10 * dy + k11 * dz, dTgl = k30 * dy + k31 * dz, dQ2Pt = k40 * dy + k41 * dz;
+    mP[kY][i] += upd ? dY : 0.f;
+    mP[kZ][i] += upd ? dZ : 0.f;
+    mP[kSnp][i] += upd ? dsnp : 0.f;
+    mP[kTgl][i] += upd ? dTgl : 0.f;
+    mP[kQ2Pt][i] += upd ? dQ2Pt : 0.f;
+
+    double c01 = cm10, c02 = cm20, c03 = cm30, c04 = cm40;
+    double c12 = cm21, c13 = cm31, c14 = cm41;
+
+    float nY2 = cm00 - (k00 * cm00 + k01 * cm10);
+    mC[kSigY2][i] = upd ? nY2 : cm00;
+    float nZY = cm10 - (k00 * c01 + k01 * cm11);
+    mC[kSigZY][i] = upd ? nZY : cm10;
+    float nSnpY = cm20 - (k00 * c02 + k01 * c12);
+    mC[kSigSnpY][i] = upd ? nSnpY : cm20;
+    float nTglY = cm30 - (k00 * c03 + k01 * c13);
+    mC[kSigTglY][i] = upd ? nTglY : cm30;
+    float nQ2PtY = cm40 - (k00 * c04 + k01 * c14);
+    mC[kSigQ2PtY][i] = upd ? nQ2PtY : cm40;
+
+    float nZ2 = cm11 - (k10 * c01 + k11 * cm11);
+    mC[kSigZ2][i] = upd ? nZ2 : cm11;
+    float nSnpZ = cm21 - (k10 * c02 + k11 * c12);
+    mC[kSigSnpZ][i] = upd ? nSnpZ : cm21;
+    float nTglZ = cm31 - (k10 * c03 + k11 * c13);
+    mC[kSigTglZ][i] = upd ? nTglZ : cm31;
+    float nQ2PtZ = cm41 - (k10 * c04 + k11 * c14);
+    mC[kSigQ2PtZ][i] = upd ? nQ2PtZ : cm41;
+
+    float nSnp2 = cm22 - (k20 * c02 + k21 * c12);
+    mC[kSigSnp2][i] = upd ? nSnp2 : cm22;
+    float nTglSnp = cm32 - (k20 * c03 + k21 * c13);
+    mC[kSigTglSnp][i] = upd ? nTglSnp : cm32;
+    float nQ2PtSnp = cm42 - (k20 * c04 + k21 * c14);
+    mC[kSigQ2PtSnp][i] = upd ? nQ2PtSnp : cm42;
+
+    float nTgl2 = cm33 - (k30 * c03 + k31 * c13);
+    mC[kSigTgl2][i] = upd ? nTgl2 : cm33;
+    float nQ2PtTgl = cm43 - (k30 * c04 + k31 * c14);
+    mC[kSigQ2PtTgl][i] = upd ? nQ2PtTgl : cm43;
+
+    float nQ2Pt2 = cm44 - (k40 * c04 + k41 * c14);
+    mC[kSigQ2Pt2][i] = upd ? nQ2Pt2 : cm44;
+  }
+
+  checkCovariance(ok);
+}
+
+//______________________________________________________________
+template <int N>
+void TrackParCovBatch<N>::limitDiag(float* __restrict__ diag, float* __restrict__ c0, float* __restrict__ c1,
+                                    float* __restrict__ c2, float* __restrict__ c3, float max, const Mask& ok)
+{
+  for (int i = 0; i < N; i++) {
+    float d = ok[i] ? std::abs(diag[i]) : diag[i];
+    bool limit = ok[i] & (d > max);
+    float scl = sqrtf(limit ? max / d : 1.f);
+    diag[i] = limit ? max : d;
+    c0[i] *= scl;
+    c1[i] *= scl;
+    c2[i] *= scl;
+    c3[i] *= scl;
+  }
+}
+
+//______________________________________________________________
+template <int N>
+void TrackParCovBatch<N>::checkCovariance(const Mask& ok)
+{
+  // same sequence of limits as TrackParCov::checkCovariance
+  limitDiag(mC[kSigY2], mC[kSigZY], mC[kSigSnpY], mC[kSigTglY], mC[kSigQ2PtY], kCY2max, ok);
+  limitDiag(mC[kSigZ2], mC[kSigZY], mC[kSigSnpZ], mC[kSigTglZ], mC[kSigQ2PtZ], kCZ2max, ok);
+  limitDiag(mC[kSigSnp2], mC[kSigSnpY], mC[kSigSnpZ], mC[kSigTglSnp], mC[kSigQ2PtSnp], kCSnp2max, ok);
+  limitDiag(mC[kSigTgl2], mC[kSigTglY], mC[kSigTglZ], mC[kSigTglSnp], mC[kSigQ2PtTgl], kCTgl2max, ok);
+  limitDiag(mC[kSigQ2Pt2], mC[kSigQ2PtY], mC[kSigQ2PtZ], mC[kSigQ2PtSnp], mC[kSigQ2PtTgl], kC1Pt2max, ok);
+}
+
+} // namespace track
+} // namespace o2
+
+#endif
@@ -0,0 +1,102 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file V0.h
+/// \brief V0 candidate: secondary vertex of a positive and a negative track
+
+#ifndef ALICEO2_V0_H
+#define ALICEO2_V0_H
+
+#include <array>
+#include <cmath>
+#include "ReconstructionDataFormats/Track.h"
+#include "CommonDataFormat/TimeStamp.h"
+
+namespace o2
+{
+namespace dataformats
+{
+
+class V0
+{
+  using Track = o2::track::TrackParCov;
+  using timeEst = o2::dataformats::TimeStampWithError<float, float>;
+
+ public:
+  enum Prong : int { kPositive,
+                     kNegative };
+
+  V0() = default;
+  ~V0() = default;
+  V0(const std::array<float, 3>& xyz, const Track& trPos, const Track& trNeg, int idPos, int idNeg, float dca,
+     float cosPA, const timeEst& t)
+    : mXYZ(xyz), mProngs{ trPos, trNeg }, mProngIDs{ idPos, idNeg }, mDCA(dca), mCosPA(cosPA), mTimeMUS(t)
+  {
+  }
+
+  const std::array<float, 3>& getXYZ() const { return mXYZ; }
+  float getX() const { return mXYZ[0]; }
+  float getY() const { return mXYZ[1]; }
+  float getZ() const { return mXYZ[2]; }
+  float getR() const { return std::sqrt(mXYZ[0] * mXYZ[0] + mXYZ[1] * mXYZ[1]); }
+
+  ///< prong track at the V0 vertex
+  const Track& getProng(int i) const { return mProngs[i]; }
+  ///< index of the prong in the input tracks
+  int getProngID(int i) const { return mProngIDs[i]; }
+
+  ///< distance between the prongs at the vertex
+  float getDCA() const { return mDCA; }
+  ///< cosine of the pointing angle to the beam line in the transverse plane
+  float getCosPA() const { return mCosPA; }
+
+  const timeEst& getTimeMUS() const { return mTimeMUS; }
+
+  ///< momentum of the V0, sum of the prong momenta at the vertex
+  void getPxPyPz(std::array<float, 3>& pxyz) const
+  {
+    std::array<float, 3> pNeg;
+    mProngs[kPositive].getPxPyPzGlo(pxyz);
+    mProngs[kNegative].getPxPyPzGlo(pNeg);
+    for (int i = 0; i < 3; i++) {
+      pxyz[i] += pNeg[i];
+    }
+  }
+
+  ///< invariant mass^2 for the masses of the positive and negative prongs
+  float calcMass2(float massPos, float massNeg) const
+  {
+    std::array<float, 3> pPos, pNeg;
+    mProngs[kPositive].getPxPyPzGlo(pPos);
+    mProngs[kNegative].getPxPyPzGlo(pNeg);
+    float p2Pos = 0.f, p2Neg = 0.f, p2 = 0.f;
+    for (int i = 0; i < 3; i++) {
+      p2Pos += pPos[i] * pPos[i];
+      p2Neg += pNeg[i] * pNeg[i];
+      p2 += (pPos[i] + pNeg[i]) * (pPos[i] + pNeg[i]);
+    }
+    const float e = std::sqrt(p2Pos + massPos * massPos) + std::sqrt(p2Neg + massNeg * massNeg);
+    return e * e - p2;
+  }
+
+ private:
+  std::array<float, 3> mXYZ = { 0.f, 0.f, 0.f }; ///< vertex position
+  std::array<Track, 2> mProngs;                   ///< prongs at the vertex
+  std::array<int, 2> mProngIDs = { -1, -1 };      ///< prong indices in the input tracks
+  float mDCA = 0.f;                               ///< distance between the prongs
+  float mCosPA = 0.f;                             ///< cosine of the transverse pointing angle
+  timeEst mTimeMUS;                               ///< time estimate in \mus
+
+  ClassDefNV(V0, 1);
+};
+} // namespace dataformats
+} // namespace o2
+
+#endif
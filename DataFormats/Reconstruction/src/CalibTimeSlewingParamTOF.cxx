@@ -12,7 +12,9 @@
 /// \brief Class to store the output of the matching to TOF for calibration
 
 #include <algorithm>
+#include <cassert>
 #include <cstdio>
+#include <limits>
 #include "ReconstructionDataFormats/CalibTimeSlewingParamTOF.h"
 
 using namespace o2::dataformats;
@@ -60,22 +62,22 @@ float CalibTimeSlewingParamTOF::evalTimeSlewing(int channel, float tot) const
   if (sector >= NSECTORS)
     return 0.; // something went wrong!
 
-  int n = mChannelStart[sector][channel];
-  if (n < 0)
+  int nstart = mChannelStart[sector][channel];
+  if (nstart < 0)
     return 0.;
 
-  int nstop = (*(mTimeSlewing[sector])).size();
-  if (channel < NCHANNELXSECTOR - 1)
-    nstop = mChannelStart[sector][channel + 1];
+  int nstop = getChannelStop(sector, channel);
 
-  if (n >= nstop)
+  if (nstart >= nstop)
     return 0.; // something went wrong!
 
-  while (n < nstop && tot < (*(mTimeSlewing[sector]))[n].first)
+  // last point with a tot not above the requested one
+  int n = nstart;
+  while (n < nstop && tot >= (*(mTimeSlewing[sector]))[n].first)
     n++;
   n--;
 
-  if (n < 0) { // tot is lower than the first available value
+  if (n < nstart) { // tot is lower than the first available value
     return 0;
   }
 
@@ -89,6 +91,55 @@ float CalibTimeSlewingParamTOF::evalTimeSlewing(int channel, float tot) const
 }
 //______________________________________________
 
+int CalibTimeSlewingParamTOF::getChannelStop(int sector, int channel) const
+{
+  // the channels after the last filled one are not set yet
+  if (channel < NCHANNELXSECTOR - 1 && mChannelStart[sector][channel + 1] > -1)
+    return mChannelStart[sector][channel + 1];
+  return (*(mTimeSlewing[sector])).size();
+}
+//______________________________________________
+
+void CalibTimeSlewingParamTOF::compileLUT()
+{
+  mLUT.assign(NCHANNELS * NLUTBINS, 0.);
+  mLUTRange.assign(NCHANNELS, { std::numeric_limits<float>::max(), 0. });
+
+  for (int sector = 0; sector < NSECTORS; sector++) {
+    const auto& timeSlewing = *(mTimeSlewing[sector]);
+    for (int channel = 0; channel < NCHANNELXSECTOR; channel++) {
+      int nstart = mChannelStart[sector][channel];
+      int nstop = getChannelStop(sector, channel);
+      if (nstart < 0 || nstart >= nstop) {
+        continue; // no value for that channel
+      }
+      int index = sector * NCHANNELXSECTOR + channel;
+      float minTot = timeSlewing[nstart].first;
+      float step = (timeSlewing[nstop - 1].first - minTot) / (NLUTBINS - 1);
+      mLUTRange[index] = { minTot, step > 0 ? 1. / step : 0. };
+      for (int bin = 0; bin < NLUTBINS; bin++) {
+        mLUT[index * NLUTBINS + bin] = evalTimeSlewing(index, minTot + bin * step);
+      }
+    }
+  }
+}
+//______________________________________________
+
+void CalibTimeSlewingParamTOF::evalTimeSlewing(gsl::span<const int> channels, gsl::span<const float> tots, gsl::span<float> timeSlewing) const
+{
+  assert(channels.size() == tots.size() && channels.size() == timeSlewing.size());
+  if (hasLUT()) {
+    for (int i = 0; i < channels.size(); i++) {
+      timeSlewing[i] = evalTimeSlewingLUT(channels[i], tots[i]);
+    }
+  } else {
+    for (int i = 0; i < channels.size(); i++) {
+      timeSlewing[i] = evalTimeSlewing(channels[i], tots[i]);
+    }
+  }
+}
+//______________________________________________
+
 void CalibTimeSlewingParamTOF::addTimeSlewingInfo(int channel, float tot, float time)
 {
   // WE ARE ASSUMING THAT:
@@ -102,8 +153,10 @@ void CalibTimeSlewingParamTOF::addTimeSlewingInfo(int channel, float tot, float
   if (sector >= NSECTORS)
     return; // something went wrong!
 
+  mLUT.clear(); // to be compiled again
+
   int currentch = channel;
-  while (mChannelStart[sector][currentch] == -1 && currentch > -1) {
+  while (currentch > -1 && mChannelStart[sector][currentch] == -1) {
     // printf("DBG: fill channel %i\n",currentch);
     // set also all the previous ones which were not filled
     mChannelStart[sector][currentch] = (*(mTimeSlewing[sector])).size();
@@ -116,6 +169,7 @@ void CalibTimeSlewingParamTOF::addTimeSlewingInfo(int channel, float tot, float
 
 CalibTimeSlewingParamTOF& CalibTimeSlewingParamTOF::operator+=(const CalibTimeSlewingParamTOF& other)
 {
+  mLUT.clear(); // to be compiled again
   for (int i = 0; i < NSECTORS; i++) {
     if (other.mTimeSlewing[i]->size() > mTimeSlewing[i]->size()) {
 
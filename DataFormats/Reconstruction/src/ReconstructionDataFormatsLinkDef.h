@@ -22,6 +22,10 @@
 #pragma link C++ class o2::BaseCluster < float > +;
 #pragma link C++ class o2::dataformats::TrackTPCITS + ;
 #pragma link C++ class o2::dataformats::MatchInfoTOF + ;
+#pragma link C++ class o2::dataformats::V0 + ;
+#pragma link C++ class o2::dataformats::Cascade + ;
+#pragma link C++ class std::vector < o2::dataformats::V0 > +;
+#pragma link C++ class std::vector < o2::dataformats::Cascade > +;
 #pragma link C++ class o2::dataformats::CalibInfoTOFshort + ;
 #pragma link C++ class o2::dataformats::CalibInfoTOF + ;
 
@@ -34,7 +38,9 @@
 #pragma link C++ class o2::dataformats::Vertex < int > +;
 #pragma link C++ class o2::dataformats::Vertex < o2::dataformats::TimeStamp < int >> +;
 #pragma link C++ class o2::dataformats::Vertex < o2::dataformats::TimeStampWithError < double, double >> +;
+#pragma link C++ class o2::dataformats::Vertex < o2::dataformats::TimeStampWithError < float, float >> +;
 #pragma link C++ class std::vector < o2::dataformats::Vertex < o2::dataformats::TimeStamp < int >>> +;
+#pragma link C++ class std::vector < o2::dataformats::Vertex < o2::dataformats::TimeStampWithError < float, float >>> +;
 #pragma link C++ class std::vector < o2::dataformats::CalibInfoTOFshort > +;
 #pragma link C++ class std::vector < o2::dataformats::CalibInfoTOF > +;
 
@@ -10,7 +10,10 @@
 
 #include "ReconstructionDataFormats/Track.h"
 #include <FairLogger.h>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 using std::array;
 using o2::track::TrackPar;
@@ -1218,6 +1221,7 @@ bool TrackParCov::update(const array<float, 2>& p, const array<float, 3>& cov)
 }
 
 //______________________________________________
+template <typename dEdxPolicy>
 bool TrackParCov::correctForMaterial(float x2x0, float xrho, float mass, bool anglecorr, float dedx)
 {
   //------------------------------------------------------------------
@@ -1229,6 +1233,7 @@ bool TrackParCov::correctForMaterial(float x2x0, float xrho, float mass, bool an
   // "mass" - the mass of this particle (GeV/c^2). Negative mass means charge=2 particle
   // "dedx" - mean enery loss (GeV/(g/cm^2), if <=kCalcdEdxAuto : calculate on the fly
   // "anglecorr" - switch for the angular correction
+  // "dEdxPolicy" - the Bethe-Bloch to use for the dedx on the fly, exact or tabulated
   //------------------------------------------------------------------
   constexpr float kMSConst2 = 0.0136f * 0.0136f;
   constexpr float kMaxELossFrac = 0.3f; // max allowed fractional eloss
@@ -1283,7 +1288,7 @@ bool TrackParCov::correctForMaterial(float x2x0, float xrho, float mass, bool an
   float cP4 = 1.f;
   if ((xrho != 0.f) && (beta2 < 1.f)) {
     if (dedx < kCalcdEdxAuto + Almost1) { // request to calculate dedx on the fly
-      dedx = BetheBlochSolid(p / fabs(mass));
+      dedx = dEdxPolicy::getdEdx(p / fabs(mass));
       if (mass < 0) {
         dedx *= 4.f; // z=2 particle
       }
@@ -1319,6 +1324,9 @@ bool TrackParCov::correctForMaterial(float x2x0, float xrho, float mass, bool an
   return true;
 }
 
+template bool TrackParCov::correctForMaterial<o2::track::BetheBlochExact>(float, float, float, bool, float);
+template bool TrackParCov::correctForMaterial<o2::track::BetheBlochTabulated>(float, float, float, bool, float);
+
 //______________________________________________________________
 void TrackParCov::print() const
 {
@@ -1431,3 +1439,66 @@ float o2::track::BetheBlochSolid(float bg, float rho, float kp1, float kp2, floa
   }
   return mK * meanZA * (1 + bg2) / bg2 * (0.5 * log(2 * me * bg2 * maxT / (meanI * meanI)) - bg2 / (1 + bg2) - d2);
 }
+
+namespace
+{
+// BetheBlochSolid in bins of equal relative width in beta*gamma. The bin is given by the exponent and the
+// leading bits of the mantissa of the float, so that within a bin beta*gamma is linear in the remaining bits
+class BetheBlochTable
+{
+ public:
+  static constexpr float BGMin = 1e-3f, BGMax = 1e5f;
+  static constexpr int BinBits = 6;          // 64 bins per factor 2 in beta*gamma
+  static constexpr int Shift = 23 - BinBits; // mantissa bits within the bin
+  static constexpr uint32_t Mask = (1u << Shift) - 1;
+  static constexpr float InvBinSize = 1.f / (1u << Shift);
+
+  BetheBlochTable()
+  {
+    mFirstBin = toBits(BGMin) >> Shift;
+    int lastBin = toBits(BGMax) >> Shift;
+    mBGLow = fromBits(mFirstBin << Shift);
+    mBGHigh = fromBits((lastBin + 1u) << Shift);
+    mdEdx.resize(lastBin - mFirstBin + 2);
+    for (size_t ib = 0; ib < mdEdx.size(); ib++) {
+      mdEdx[ib] = o2::track::BetheBlochSolid(fromBits((mFirstBin + ib) << Shift));
+    }
+  }
+
+  float getdEdx(float bg) const
+  {
+    if (!(bg >= mBGLow && bg < mBGHigh)) {
+      return o2::track::BetheBlochSolid(bg);
+    }
+    uint32_t bits = toBits(bg);
+    int ib = (bits >> Shift) - mFirstBin;
+    float frac = (bits & Mask) * InvBinSize;
+    return mdEdx[ib] + frac * (mdEdx[ib + 1] - mdEdx[ib]);
+  }
+
+ private:
+  static uint32_t toBits(float v)
+  {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+  }
+  static float fromBits(uint32_t bits)
+  {
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+  }
+
+  uint32_t mFirstBin = 0;
+  float mBGLow = 0.f, mBGHigh = 0.f;
+  std::vector<float> mdEdx; // dE/dx at the lower edges of the bins and at the upper edge of the last one
+};
+} // namespace
+
+//____________________________________________________
+float o2::track::BetheBlochSolidTab(float bg)
+{
+  static const BetheBlochTable table;
+  return table.getdEdx(bg);
+}
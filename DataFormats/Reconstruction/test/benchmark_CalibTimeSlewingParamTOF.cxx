@@ -0,0 +1,87 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   benchmark_CalibTimeSlewingParamTOF.cxx
+/// @brief  Benchmark of the TOF time slewing evaluation, searching the points or from the compiled table
+///
+/// All the channels get 20 points, as in the output of CalibTOF, and every iteration evaluates the
+/// time slewing of 1024 clusters in random channels.
+
+#include <benchmark/benchmark.h>
+#include "ReconstructionDataFormats/CalibTimeSlewingParamTOF.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+using o2::dataformats::CalibTimeSlewingParamTOF;
+
+namespace
+{
+constexpr int NClusters = 1024;
+
+std::unique_ptr<CalibTimeSlewingParamTOF> createCalib()
+{
+  auto calib = std::make_unique<CalibTimeSlewingParamTOF>();
+  for (int ch = 0; ch < CalibTimeSlewingParamTOF::NCHANNELS; ch++) {
+    for (int i = 0; i < 20; i++) {
+      float tot = 5. + i;
+      calib->addTimeSlewingInfo(ch, tot, 300. - 10. * i + ch % 10);
+    }
+  }
+  return calib;
+}
+
+void createClusters(std::vector<int>& channels, std::vector<float>& tots)
+{
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> channel(0, CalibTimeSlewingParamTOF::NCHANNELS - 1);
+  std::uniform_real_distribution<float> tot(0., 30.);
+  for (int i = 0; i < NClusters; i++) {
+    channels.push_back(channel(gen));
+    tots.push_back(tot(gen));
+  }
+}
+} // namespace
+
+static void BM_Search(benchmark::State& state)
+{
+  auto calib = createCalib();
+  std::vector<int> channels;
+  std::vector<float> tots;
+  createClusters(channels, tots);
+  std::vector<float> results(NClusters);
+  for (auto _ : state) {
+    for (int i = 0; i < NClusters; i++) {
+      results[i] = calib->evalTimeSlewing(channels[i], tots[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * NClusters);
+}
+
+static void BM_LUT(benchmark::State& state)
+{
+  auto calib = createCalib();
+  calib->compileLUT();
+  std::vector<int> channels;
+  std::vector<float> tots;
+  createClusters(channels, tots);
+  std::vector<float> results(NClusters);
+  for (auto _ : state) {
+    calib->evalTimeSlewing(channels, tots, results);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * NClusters);
+}
+
+BENCHMARK(BM_Search);
+BENCHMARK(BM_LUT);
+
+BENCHMARK_MAIN();
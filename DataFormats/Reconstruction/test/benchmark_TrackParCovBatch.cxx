@@ -0,0 +1,99 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   benchmark_TrackParCovBatch.cxx
+/// @brief  Benchmark of the TrackParCov kernels, per track and on batches of tracks
+///
+/// Every iteration propagates, rotates and updates 1024 tracks, so that the timings of the
+/// scalar and of the batch versions compare directly.
+
+#include <benchmark/benchmark.h>
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
+#include <random>
+#include <vector>
+
+using namespace o2::track;
+
+namespace
+{
+constexpr int NTracks = 1024;
+constexpr float Bz = -5.f;
+
+std::vector<TrackParCov> createTracks()
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> uni(-1.f, 1.f);
+  std::vector<TrackParCov> tracks;
+  for (int i = 0; i < NTracks; i++) {
+    std::array<float, kNParams> par = { 5.f * uni(gen), 20.f * uni(gen), 0.5f * uni(gen), uni(gen), 2.f * uni(gen) };
+    std::array<float, kCovMatSize> cov = { 1e-2, 1e-4, 4e-2, 1e-5, 1e-6, 1e-4, 1e-6, 1e-5, 1e-7, 1e-4, 1e-4, 1e-5, 1e-5, 1e-6, 0.25 };
+    tracks.emplace_back(10.f, 0.1f, par, cov);
+  }
+  return tracks;
+}
+
+// toggle between two layers and two sectors, to keep the tracks in range over the iterations
+float layerX(int iter) { return iter & 1 ? 10.f : 12.f; }
+float sectorAlpha(int iter) { return iter & 1 ? 0.1f : 0.2f; }
+} // namespace
+
+static void BM_Scalar(benchmark::State& state)
+{
+  auto tracks = createTracks();
+  std::array<float, 2> p = { 0.f, 0.f };
+  std::array<float, 3> cov = { 1e-4, 0., 1e-4 };
+  int iter = 0;
+  for (auto _ : state) {
+    for (auto& trc : tracks) {
+      trc.propagateTo(layerX(iter), Bz);
+      trc.rotate(sectorAlpha(iter));
+      p = { trc.getY(), trc.getZ() };
+      trc.update(p, cov);
+    }
+    iter++;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * NTracks);
+}
+
+template <int N>
+static void BM_Batch(benchmark::State& state)
+{
+  auto tracks = createTracks();
+  std::vector<TrackParCovBatch<N>> batches(NTracks / N);
+  for (int i = 0; i < NTracks; i++) {
+    batches[i / N].setTrack(i % N, tracks[i]);
+  }
+  typename TrackParCovBatch<N>::Mask ok;
+  std::array<float, 2> p[N];
+  std::array<float, 3> cov[N];
+  int iter = 0;
+  for (auto _ : state) {
+    for (auto& batch : batches) {
+      batch.propagateTo(layerX(iter), Bz, ok);
+      batch.rotate(sectorAlpha(iter), ok);
+      for (int i = 0; i < N; i++) {
+        p[i] = { batch.getParam(kY, i), batch.getParam(kZ, i) };
+        cov[i] = { 1e-4, 0., 1e-4 };
+      }
+      batch.update(p, cov, ok);
+    }
+    iter++;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * NTracks);
+}
+
+BENCHMARK(BM_Scalar);
+BENCHMARK_TEMPLATE(BM_Batch, 4);
+BENCHMARK_TEMPLATE(BM_Batch, 8);
+BENCHMARK_TEMPLATE(BM_Batch, 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,69 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CalibTimeSlewingParamTOF class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ReconstructionDataFormats/CalibTimeSlewingParamTOF.h"
+#include <memory>
+#include <vector>
+
+using o2::dataformats::CalibTimeSlewingParamTOF;
+
+BOOST_AUTO_TEST_CASE(TimeSlewingEval)
+{
+  auto calib = std::make_unique<CalibTimeSlewingParamTOF>();
+  const int ch0 = 5, ch1 = CalibTimeSlewingParamTOF::NCHANNELXSECTOR + 7;
+  // a slewing falling from 300 to 100 ps between 5 and 25 ns, for channels in two sectors
+  for (int ch : { ch0, ch0 + 2, ch1 }) {
+    for (float tot = 5.; tot <= 25.; tot += 2.5) {
+      calib->addTimeSlewingInfo(ch, tot, 300. - 10. * (tot - 5.) + ch % 3);
+    }
+  }
+  // a channel with only the offset
+  calib->addTimeSlewingInfo(ch1 + 1, 0., 42.);
+
+  BOOST_CHECK_EQUAL(calib->evalTimeSlewing(ch0, 4.9), 0.);
+  BOOST_CHECK_CLOSE(calib->evalTimeSlewing(ch0, 5.), 302., 1e-4);
+  BOOST_CHECK_CLOSE(calib->evalTimeSlewing(ch0, 11.), 242., 1e-4);
+  BOOST_CHECK_CLOSE(calib->evalTimeSlewing(ch0, 40.), 102., 1e-4);
+  BOOST_CHECK_EQUAL(calib->evalTimeSlewing(ch0 + 1, 11.), 0.);
+  BOOST_CHECK_CLOSE(calib->evalTimeSlewing(ch0 + 2, 11.), 241., 1e-4);
+  BOOST_CHECK_CLOSE(calib->evalTimeSlewing(ch1, 11.), 241., 1e-4);
+  BOOST_CHECK_CLOSE(calib->evalTimeSlewing(ch1 + 1, 11.), 42., 1e-4);
+  BOOST_CHECK_EQUAL(calib->evalTimeSlewing(ch1 + 2, 11.), 0.);
+
+  // the compiled table gives the same values
+  std::vector<int> channels;
+  std::vector<float> tots;
+  for (int ch = 0; ch < ch1 + 3; ch += (ch < ch0 + 3 || ch > ch1 - 2) ? 1 : 1000) {
+    for (float tot = 0.; tot < 30.; tot += 0.7) {
+      channels.push_back(ch);
+      tots.push_back(tot);
+    }
+  }
+  std::vector<float> expected(channels.size()), results(channels.size());
+  calib->evalTimeSlewing(channels, tots, expected);
+  BOOST_CHECK(!calib->hasLUT());
+  calib->compileLUT();
+  BOOST_REQUIRE(calib->hasLUT());
+  calib->evalTimeSlewing(channels, tots, results);
+  for (size_t i = 0; i < channels.size(); i++) {
+    BOOST_CHECK_SMALL(results[i] - expected[i], 1e-3f);
+    BOOST_CHECK_EQUAL(results[i], calib->evalTimeSlewingLUT(channels[i], tots[i]));
+  }
+  BOOST_CHECK_EQUAL(calib->evalTimeSlewingLUT(CalibTimeSlewingParamTOF::NCHANNELS, 11.), 0.);
+  BOOST_CHECK_EQUAL(calib->evalTimeSlewingLUT(-1, 11.), 0.);
+
+  // the table is dropped when the time slewing changes
+  calib->addTimeSlewingInfo(ch1 + 2, 0., 1.);
+  BOOST_CHECK(!calib->hasLUT());
+}
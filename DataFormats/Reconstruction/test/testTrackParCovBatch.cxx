@@ -0,0 +1,117 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TrackParCovBatch class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
+#include <array>
+#include <cmath>
+#include <random>
+
+namespace o2
+{
+using namespace o2::track;
+constexpr int NBatch = 8;
+using Batch = TrackParCovBatch<NBatch>;
+
+// random tracks with a valid covariance matrix, with some low pt ones for the large arcs
+// and some close to snp=1 to have failures
+TrackParCov randomTrack(std::mt19937& gen)
+{
+  std::uniform_real_distribution<float> uni(-1.f, 1.f);
+  std::array<float, kNParams> par = { 5.f * uni(gen), 20.f * uni(gen), 0.99f * uni(gen), uni(gen), 10.f * uni(gen) };
+  std::array<float, kCovMatSize> cov = { 0.f };
+  std::array<float, kNParams> sig = { 0.1f, 0.2f, 0.01f, 0.01f, 0.5f };
+  for (int i = 0; i < kNParams; i++) {
+    for (int j = 0; j <= i; j++) {
+      float corr = i == j ? 1.f : 0.3f * uni(gen);
+      cov[CovarMap[i][j]] = corr * sig[i] * sig[j] * (1.f + 0.1f * uni(gen));
+    }
+  }
+  float x = 10.f + 5.f * uni(gen);
+  return TrackParCov(x, 0.3f * uni(gen), par, cov);
+}
+
+void checkSame(const TrackParCov& trc, const Batch& batch, int i)
+{
+  const float eps = 1e-5;
+  auto close = [eps](float a, float b) { return std::abs(a - b) <= eps * std::max(1.f, std::max(std::abs(a), std::abs(b))); };
+  BOOST_CHECK(close(trc.getX(), batch.getX(i)));
+  BOOST_CHECK(close(trc.getAlpha(), batch.getAlpha(i)));
+  for (int ip = 0; ip < kNParams; ip++) {
+    BOOST_CHECK(close(trc.getParam(ip), batch.getParam(ip, i)));
+  }
+  for (int ic = 0; ic < kCovMatSize; ic++) {
+    BOOST_CHECK(close(trc.getCov()[ic], batch.getCovarElem(ic, i)));
+  }
+}
+
+// the batch kernels do what the scalar ones do, including the failures
+BOOST_AUTO_TEST_CASE(TrackParCovBatch_vs_TrackParCov)
+{
+  std::mt19937 gen(1234);
+  int nFailed = 0;
+  for (int iter = 0; iter < 200; iter++) {
+    std::array<TrackParCov, NBatch> tracks;
+    Batch batch;
+    for (int i = 0; i < NBatch; i++) {
+      tracks[i] = randomTrack(gen);
+      batch.setTrack(i, tracks[i]);
+    }
+    Batch::Mask ok;
+
+    float xk = 15.f + (iter % 10) * 3.f, b = iter % 7 ? -5.f : 0.f;
+    batch.propagateTo(xk, b, ok);
+    for (int i = 0; i < NBatch; i++) {
+      BOOST_CHECK_EQUAL(tracks[i].propagateTo(xk, b), ok[i]);
+      checkSame(tracks[i], batch, i);
+      nFailed += !ok[i];
+    }
+
+    float alpha = 0.5f * (iter % 5) - 1.f;
+    batch.rotate(alpha, ok);
+    for (int i = 0; i < NBatch; i++) {
+      BOOST_CHECK_EQUAL(tracks[i].rotate(alpha), ok[i]);
+      checkSame(tracks[i], batch, i);
+    }
+
+    std::array<float, 2> p[NBatch];
+    std::array<float, 3> cov[NBatch];
+    for (int i = 0; i < NBatch; i++) {
+      p[i] = { tracks[i].getY() + 0.05f, tracks[i].getZ() - 0.1f };
+      cov[i] = { 0.01f, 0.001f, 0.02f };
+    }
+    batch.update(p, cov, ok);
+    for (int i = 0; i < NBatch; i++) {
+      BOOST_CHECK_EQUAL(tracks[i].update(p[i], cov[i]), ok[i]);
+      checkSame(tracks[i], batch, i);
+    }
+  }
+  BOOST_CHECK(nFailed > 0);
+
+  // round trip of the tracks through the batch
+  std::mt19937 gen2(42);
+  auto trc = randomTrack(gen2);
+  Batch batch;
+  batch.setTrack(3, trc);
+  auto back = batch.getTrack(3);
+  BOOST_CHECK_EQUAL(back.getX(), trc.getX());
+  BOOST_CHECK_EQUAL(back.getAlpha(), trc.getAlpha());
+  for (int ip = 0; ip < kNParams; ip++) {
+    BOOST_CHECK_EQUAL(back.getParam(ip), trc.getParam(ip));
+  }
+  for (int ic = 0; ic < kCovMatSize; ic++) {
+    BOOST_CHECK_EQUAL(back.getCov()[ic], trc.getCov()[ic]);
+  }
+}
+
+} // namespace o2
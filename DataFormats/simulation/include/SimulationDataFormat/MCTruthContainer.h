@@ -16,10 +16,14 @@
 #define ALICEO2_DATAFORMATS_MCTRUTH_H_
 
 #include <TNamed.h>
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <gsl/gsl> // for guideline support library; array_view
 #include <type_traits>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 namespace o2
 {
@@ -35,6 +39,22 @@ struct MCTruthHeaderElement {
   ClassDefNV(MCTruthHeaderElement, 1);
 };
 
+// Header of the flat, relocatable representation of a MCTruthContainer.
+// The buffer consists of this header, followed by the array of header elements
+// and the array of truth elements. The truth elements start at 'truthOffset'
+// (relative to the beginning of the buffer) which respects the alignment of the
+// truth element type. Since only offsets are stored, the buffer can be moved
+// around freely and be read in place, e.g. in the payload of a message.
+struct MCTruthFlatHeader {
+  uint16_t version = 1;
+  uint16_t sizeofHeaderElement = sizeof(MCTruthHeaderElement);
+  uint16_t sizeofTruthElement = 0;
+  uint16_t reserved = 0;
+  uint32_t nofHeaderElements = 0;
+  uint32_t nofTruthElements = 0;
+  uint64_t truthOffset = 0;
+};
+
 // A container to hold and manage MC truth information/labels.
 // The actual MCtruth type is a generic template type and can be supplied by the user
 // It is meant to manage associations from one "dataobject" identified by an index into an array
@@ -219,9 +239,163 @@ class MCTruthContainer
     }
   }
 
+  // merge a list of containers to the back of this one
+  // the required storage is allocated once and the chunks are copied
+  // using up to nthreads threads, each of them filling distinct ranges
+  void mergeAll(gsl::span<MCTruthContainer<TruthElement> const* const> others, int nthreads = 1)
+  {
+    // prefix sums of header and truth sizes define the target position of each chunk
+    std::vector<size_t> headerOffsets(others.size() + 1, mHeaderArray.size());
+    std::vector<size_t> truthOffsets(others.size() + 1, mTruthArray.size());
+    for (size_t i = 0; i < others.size(); ++i) {
+      headerOffsets[i + 1] = headerOffsets[i] + others[i]->mHeaderArray.size();
+      truthOffsets[i + 1] = truthOffsets[i] + others[i]->mTruthArray.size();
+    }
+    mHeaderArray.resize(headerOffsets.back());
+    mTruthArray.resize(truthOffsets.back());
+
+    auto copyChunk = [this, &others, &headerOffsets, &truthOffsets](size_t i) {
+      auto const& other = *others[i];
+      std::copy(other.mTruthArray.begin(), other.mTruthArray.end(), mTruthArray.begin() + truthOffsets[i]);
+      for (size_t h = 0; h < other.mHeaderArray.size(); ++h) {
+        mHeaderArray[headerOffsets[i] + h].index = other.mHeaderArray[h].index + truthOffsets[i];
+      }
+    };
+
+    const size_t nworkers = std::min<size_t>(nthreads > 1 ? nthreads : 1, others.size());
+    if (nworkers <= 1) {
+      for (size_t i = 0; i < others.size(); ++i) {
+        copyChunk(i);
+      }
+      return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(nworkers);
+    for (size_t w = 0; w < nworkers; ++w) {
+      workers.emplace_back([&copyChunk, &others, w, nworkers]() {
+        for (size_t i = w; i < others.size(); i += nworkers) {
+          copyChunk(i);
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // helper to calculate the offset of the truth elements in the flat buffer
+  static size_t getFlatTruthOffset(size_t nofHeaderElements)
+  {
+    size_t offset = sizeof(MCTruthFlatHeader) + nofHeaderElements * sizeof(MCTruthHeaderElement);
+    constexpr size_t alignment = alignof(TruthElement);
+    return ((offset + alignment - 1) / alignment) * alignment;
+  }
+
+  // return the size of the flat representation of this container
+  size_t getFlatSize() const
+  {
+    return getFlatTruthOffset(mHeaderArray.size()) + mTruthArray.size() * sizeof(TruthElement);
+  }
+
+  // write the flat representation of the container to a contiguous buffer,
+  // the buffer is resized accordingly, the content can be accessed in place
+  // by MCTruthContainerView without deserialization
+  template <typename ContainerType>
+  size_t flatten_to(ContainerType& container) const
+  {
+    static_assert(sizeof(typename ContainerType::value_type) == 1, "need a byte container");
+    static_assert(std::is_trivially_copyable<TruthElement>::value, "flat layout requires trivially copyable truth elements");
+    MCTruthFlatHeader flatheader;
+    flatheader.sizeofTruthElement = sizeof(TruthElement);
+    flatheader.nofHeaderElements = mHeaderArray.size();
+    flatheader.nofTruthElements = mTruthArray.size();
+    flatheader.truthOffset = getFlatTruthOffset(mHeaderArray.size());
+    auto size = getFlatSize();
+    container.resize(size);
+    char* target = reinterpret_cast<char*>(container.data());
+    std::memset(target, 0, flatheader.truthOffset);
+    std::memcpy(target, &flatheader, sizeof(MCTruthFlatHeader));
+    std::memcpy(target + sizeof(MCTruthFlatHeader), mHeaderArray.data(), mHeaderArray.size() * sizeof(MCTruthHeaderElement));
+    std::memcpy(target + flatheader.truthOffset, mTruthArray.data(), mTruthArray.size() * sizeof(TruthElement));
+    return size;
+  }
+
+  // restore the container from its flat representation
+  void restore_from(const char* buffer, size_t bufferSize);
+
   ClassDefNV(MCTruthContainer, 1);
 }; // end class
 
+// A read-only view on the flat representation of a MCTruthContainer, the labels
+// are accessed directly in the underlying buffer which needs to stay valid for
+// the lifetime of the view.
+template <typename TruthElement>
+class MCTruthContainerView
+{
+ public:
+  MCTruthContainerView() = default;
+  MCTruthContainerView(gsl::span<const char> buffer)
+  {
+    if (buffer.size() < sizeof(MCTruthFlatHeader)) {
+      throw std::runtime_error("MCTruthContainerView: buffer too small");
+    }
+    auto const* flatheader = reinterpret_cast<MCTruthFlatHeader const*>(buffer.data());
+    if (flatheader->version != MCTruthFlatHeader().version ||
+        flatheader->sizeofHeaderElement != sizeof(MCTruthHeaderElement) ||
+        flatheader->sizeofTruthElement != sizeof(TruthElement)) {
+      throw std::runtime_error("MCTruthContainerView: incompatible buffer format");
+    }
+    if (flatheader->truthOffset % alignof(TruthElement) != 0 ||
+        reinterpret_cast<uintptr_t>(buffer.data()) % alignof(TruthElement) != 0) {
+      throw std::runtime_error("MCTruthContainerView: misaligned buffer");
+    }
+    if (buffer.size() < flatheader->truthOffset + flatheader->nofTruthElements * sizeof(TruthElement) ||
+        flatheader->truthOffset < sizeof(MCTruthFlatHeader) + flatheader->nofHeaderElements * sizeof(MCTruthHeaderElement)) {
+      throw std::runtime_error("MCTruthContainerView: inconsistent buffer size");
+    }
+    mHeaderArray = gsl::span<const MCTruthHeaderElement>(reinterpret_cast<MCTruthHeaderElement const*>(buffer.data() + sizeof(MCTruthFlatHeader)),
+                                                         flatheader->nofHeaderElements);
+    mTruthArray = gsl::span<const TruthElement>(reinterpret_cast<TruthElement const*>(buffer.data() + flatheader->truthOffset),
+                                                flatheader->nofTruthElements);
+  }
+
+  // access
+  MCTruthHeaderElement getMCTruthHeader(uint dataindex) const { return mHeaderArray[dataindex]; }
+  TruthElement const& getElement(uint elementindex) const { return mTruthArray[elementindex]; }
+  // return the number of original data indexed here
+  size_t getIndexedSize() const { return mHeaderArray.size(); }
+  // return the number of elements managed in this container
+  size_t getNElements() const { return mTruthArray.size(); }
+
+  // get individual const "view" container for a given data index
+  gsl::span<const TruthElement> getLabels(uint dataindex) const
+  {
+    if (dataindex >= getIndexedSize()) {
+      return gsl::span<const TruthElement>();
+    }
+    const auto size = (dataindex < mHeaderArray.size() - 1)
+                        ? mHeaderArray[dataindex + 1].index - mHeaderArray[dataindex].index
+                        : mTruthArray.size() - mHeaderArray[dataindex].index;
+    return mTruthArray.subspan(mHeaderArray[dataindex].index, size);
+  }
+
+  // direct access to the underlying arrays
+  gsl::span<const MCTruthHeaderElement> getHeaderArray() const { return mHeaderArray; }
+  gsl::span<const TruthElement> getTruthArray() const { return mTruthArray; }
+
+ private:
+  gsl::span<const MCTruthHeaderElement> mHeaderArray;
+  gsl::span<const TruthElement> mTruthArray;
+};
+
+template <typename TruthElement>
+void MCTruthContainer<TruthElement>::restore_from(const char* buffer, size_t bufferSize)
+{
+  MCTruthContainerView<TruthElement> view(gsl::span<const char>(buffer, bufferSize));
+  mHeaderArray.assign(view.getHeaderArray().begin(), view.getHeaderArray().end());
+  mTruthArray.assign(view.getTruthArray().begin(), view.getTruthArray().end());
+}
+
 }
 }
 
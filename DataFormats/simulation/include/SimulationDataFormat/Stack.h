@@ -27,8 +27,8 @@
 
 #include <map>
 #include <memory>
-#include <stack>
 #include <utility>
+#include <vector>
 
 class TClonesArray;
 class TRefArray;
@@ -43,8 +43,10 @@ class Detector;
 namespace data
 {
 /// This class handles the particle stack for the transport simulation.
-/// For the stack FILO functunality, it uses the STL stack. To store
-/// the tracks during transport, a TParticle array is used.
+/// For the stack FILO functunality, it uses a vector of compact particle
+/// records whose storage is kept from one event to the next; a TParticle is
+/// only filled for the track handed out to the transport. To store
+/// the tracks during transport, a MCTrack array is used.
 /// At the end of the event, tracks satisfying the filter criteria
 /// are copied to a MCTrack array, which is stored in the output.
 ///
@@ -162,6 +164,7 @@ class Stack : public FairGenericStack
   void setMinHits(Int_t min) { mMinHits = min; }
   void SetEnergyCut(Double_t eMin) { mEnergyCut = eMin; }
   void StoreMothers(Bool_t choice = kTRUE) { mStoreMothers = choice; }
+  void setNIndexUpdateThreads(int n) { mNIndexUpdateThreads = n; }
   /// Increment number of hits for the current track in a given detector
   /// \param iDet  Detector unique identifier
   void addHit(int iDet);
@@ -220,9 +223,22 @@ class Stack : public FairGenericStack
   void updateEventStats();
 
  private:
-  /// STL stack (FILO) used to handle the TParticles for tracking
-  /// stack entries refer to
-  std::stack<TParticle> mStack; //!
+  /// compact record of a particle waiting on the stack, holding what is needed
+  /// to fill the TParticle handed out to the transport
+  struct StackParticle {
+    Int_t pdgCode;
+    Int_t trackID; // status code of the TParticle
+    Int_t mother[2];
+    Int_t daughter[2];
+    Int_t process; // unique ID of the TParticle
+    Double_t px, py, pz, e;
+    Double_t vx, vy, vz, t;
+    Double_t polx, poly, polz;
+    Double_t weight;
+  };
+
+  /// stack (FILO) of the particles to be tracked
+  std::vector<StackParticle> mStack; //!
 
   /// Array of TParticles (contains all TParticles put into or created
   /// by the transport)
@@ -243,8 +259,11 @@ class Stack : public FairGenericStack
   /// vector of reducded tracks written to the output
   std::vector<o2::MCTrack>* mTracks;
 
-  /// STL map from particle index to persistent track index
-  std::map<Int_t, Int_t> mIndexMap; //!
+  /// dense mapping from particle index to persistent track index (-1 if not kept)
+  std::vector<int> mIndexMap; //!
+
+  /// persistent index of each entry of mParticles (work space of finishCurrentPrimary)
+  std::vector<int> mPersistentIndices; //!
 
   /// cache active O2 detectors
   std::vector<o2::base::Detector*> mActiveDetectors; //!
@@ -261,6 +280,7 @@ class Stack : public FairGenericStack
   Bool_t mStoreSecondaries;
   bool mPruneKinematics = false; // whether or not we filter the output kinematics
   Int_t mMinHits;
+  int mNIndexUpdateThreads = 1; // number of threads used to update the track indices of the detectors
   Int_t mHitCounter = 0; //! counts hits communicated via addHit
   Double32_t mEnergyCut;
 
@@ -297,6 +317,11 @@ class Stack : public FairGenericStack
   /// than done with FillTrackArray which is only called once per event
   void finishCurrentPrimary();
 
+  /// conversions between the compact particle records and TParticle / MCTrack
+  static StackParticle makeStackParticle(TParticle const& p);
+  static void fillParticle(StackParticle const& record, TParticle& p);
+  static o2::MCTrack makeMCTrack(StackParticle const& record);
+
   /// Increment number of hits for an arbitrary track in a given detector
   /// \param iDet    Detector unique identifier
   /// \param iTrack  Track number
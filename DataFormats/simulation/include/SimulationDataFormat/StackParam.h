@@ -23,6 +23,7 @@ namespace sim
 struct StackParam : public o2::conf::ConfigurableParamHelper<StackParam> {
   bool storeSecondaries = true;
   bool pruneKine = true;
+  int nIndexUpdateThreads = 1; // number of threads updating the track indices of the hits at the end of the event
 
   // boilerplate stuff + make principal key "Stack"
   O2ParamDef(StackParam, "Stack");
@@ -26,10 +26,14 @@
 #include "TLorentzVector.h" // for TLorentzVector
 #include "TParticle.h"      // for TParticle
 #include "TRefArray.h"      // for TRefArray
+#include "TVector3.h"       // for TVector3
 #include "TVirtualMC.h"     // for VMC
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
+#include <thread>
 #include <cstddef> // for NULL
 #include <cmath>
 
@@ -91,6 +95,7 @@ Stack::Stack(const Stack& rhs)
     mStoreMothers(rhs.mStoreMothers),
     mStoreSecondaries(rhs.mStoreSecondaries),
     mMinHits(rhs.mMinHits),
+    mNIndexUpdateThreads(rhs.mNIndexUpdateThreads),
     mEnergyCut(rhs.mEnergyCut),
     mTrackRefs(new std::vector<o2::TrackReference>),
     mIsG4Like(rhs.mIsG4Like)
@@ -145,44 +150,54 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
                       Double_t vx, Double_t vy, Double_t vz, Double_t time, Double_t polx, Double_t poly, Double_t polz,
                       TMCProcess proc, Int_t& ntr, Double_t weight, Int_t is, Int_t secondparentID)
 {
-  // Create new TParticle and add it to the TParticle array
+  // Create new particle record; a TParticle is only made when needed
   Int_t trackId = mNumberOfEntriesInParticles;
   // Set track variable
   ntr = trackId;
 
-  Int_t nPoints = 0;
-  Int_t daughter1Id = -1;
-  Int_t daughter2Id = -1;
-
   // LOG(INFO) << "Pushing " << trackId << " with parent " << parentId << FairLogger::endl;
 
-  TParticle p(pdgCode, trackId, parentId, nPoints, daughter1Id, daughter2Id, px, py, pz, e, vx, vy, vz, time);
-  p.SetPolarisation(polx, poly, polz);
-  p.SetWeight(weight);
-  p.SetUniqueID(proc); // using the unique ID to transfer process ID
+  StackParticle p;
+  p.pdgCode = pdgCode;
+  p.trackID = trackId;
+  p.mother[0] = parentId;
+  p.mother[1] = 0;
+  p.daughter[0] = p.daughter[1] = -1;
+  p.process = proc; // as the unique ID of the TParticle, to transfer process ID
+  p.px = px;
+  p.py = py;
+  p.pz = pz;
+  p.e = e;
+  p.vx = vx;
+  p.vy = vy;
+  p.vz = vz;
+  p.t = time;
+  p.polx = polx;
+  p.poly = poly;
+  p.polz = polz;
+  p.weight = weight;
   mNumberOfEntriesInParticles++;
 
   // currently I only know of G4 who pushes particles like this (but never pops)
   // so we have to register the particles here
   if (mIsG4Like && parentId >= 0) {
-    // p.SetStatusCode(mParticles.size());
-    mParticles.emplace_back(p);
-    mTransportedIDs.emplace_back(p.GetStatusCode());
-    const auto trackID = p.GetStatusCode();
-    insertInVector(mTrackIDtoParticlesEntry, trackID, (int)(mParticles.size() - 1));
+    mParticles.emplace_back(makeMCTrack(p));
+    mTransportedIDs.emplace_back(trackId);
+    insertInVector(mTrackIDtoParticlesEntry, trackId, (int)(mParticles.size() - 1));
 
-    mCurrentParticle = p;
+    fillParticle(p, mCurrentParticle);
   }
 
   // Increment counter
   if (parentId < 0) {
     mNumberOfPrimaryParticles++;
-    mPrimaryParticles.push_back(p);
+    mPrimaryParticles.emplace_back();
+    fillParticle(p, mPrimaryParticles.back());
   }
 
   // Push particle on the stack if toBeDone is set
   if (toBeDone == 1) {
-    mStack.push(p);
+    mStack.push_back(p);
   }
 }
 
@@ -207,10 +222,62 @@ void Stack::PushTrack(int toBeDone, TParticle const& p)
 
   // Push particle on the stack if toBeDone is set
   if (toBeDone == 1) {
-    mStack.push(p);
+    mStack.push_back(makeStackParticle(p));
   }
 }
 
+Stack::StackParticle Stack::makeStackParticle(TParticle const& p)
+{
+  StackParticle record;
+  record.pdgCode = p.GetPdgCode();
+  record.trackID = p.GetStatusCode();
+  record.mother[0] = p.GetMother(0);
+  record.mother[1] = p.GetMother(1);
+  record.daughter[0] = p.GetDaughter(0);
+  record.daughter[1] = p.GetDaughter(1);
+  record.process = p.GetUniqueID();
+  record.px = p.Px();
+  record.py = p.Py();
+  record.pz = p.Pz();
+  record.e = p.Energy();
+  record.vx = p.Vx();
+  record.vy = p.Vy();
+  record.vz = p.Vz();
+  record.t = p.T();
+  TVector3 pol;
+  p.GetPolarisation(pol);
+  record.polx = pol.X();
+  record.poly = pol.Y();
+  record.polz = pol.Z();
+  record.weight = p.GetWeight();
+  return record;
+}
+
+void Stack::fillParticle(StackParticle const& record, TParticle& p)
+{
+  p.SetMomentum(record.px, record.py, record.pz, record.e);
+  p.SetProductionVertex(record.vx, record.vy, record.vz, record.t);
+  // after the momentum, from which the mass is calculated for unknown PDG codes
+  p.SetPdgCode(record.pdgCode);
+  p.SetStatusCode(record.trackID);
+  p.SetFirstMother(record.mother[0]);
+  p.SetLastMother(record.mother[1]);
+  p.SetFirstDaughter(record.daughter[0]);
+  p.SetLastDaughter(record.daughter[1]);
+  p.SetPolarisation(record.polx, record.poly, record.polz);
+  p.SetWeight(record.weight);
+  p.SetUniqueID(record.process);
+}
+
+o2::MCTrack Stack::makeMCTrack(StackParticle const& record)
+{
+  // same as the MCTrack constructor from TParticle
+  o2::MCTrack track(record.pdgCode, record.mother[0], record.px, record.py, record.pz, record.vx, record.vy, record.vz,
+                    record.t * 1e09, 0);
+  track.setProcess(record.process);
+  return track;
+}
+
 /// Set the current track number
 /// Declared in TVirtualMCStack
 /// \param iTrack track number
@@ -248,23 +315,22 @@ void Stack::notifyFinishPrimary()
 
 // calculates a hash based on particle properties
 // hash may serve as seed for this track
-ULong_t getHash(TParticle const& p)
+template <typename P>
+ULong_t getHash(P const& p)
 {
   auto asLong = [](double x) {
     return (ULong_t) * (reinterpret_cast<ULong_t*>(&x));
   };
 
   ULong_t hash;
-  o2::MCTrackT<double> track(p);
-
-  hash = asLong(track.GetStartVertexCoordinatesX());
-  hash ^= asLong(track.GetStartVertexCoordinatesY());
-  hash ^= asLong(track.GetStartVertexCoordinatesZ());
-  hash ^= asLong(track.GetStartVertexCoordinatesT());
-  hash ^= asLong(track.GetStartVertexMomentumX());
-  hash ^= asLong(track.GetStartVertexMomentumY());
-  hash ^= asLong(track.GetStartVertexMomentumZ());
-  hash += (ULong_t)track.GetPdgCode();
+  hash = asLong(p.vx);
+  hash ^= asLong(p.vy);
+  hash ^= asLong(p.vz);
+  hash ^= asLong(p.t * 1e09); // in ns as in MCTrack
+  hash ^= asLong(p.px);
+  hash ^= asLong(p.py);
+  hash ^= asLong(p.pz);
+  hash += (ULong_t)p.pdgCode;
   return hash;
 }
 
@@ -282,25 +348,26 @@ TParticle* Stack::PopNextTrack(Int_t& iTrack)
   }
 
   // If not, get next particle from stack
-  mCurrentParticle = mStack.top();
-  mStack.pop();
+  const auto record = mStack.back();
+  mStack.pop_back();
+  fillParticle(record, mCurrentParticle);
 
-  if (mCurrentParticle.GetMother(0) < 0) {
+  if (record.mother[0] < 0) {
     // particle is primary -> indicates that previous particle finished
     if (mParticles.size() > 0) {
       notifyFinishPrimary();
     }
     mIndexOfPrimaries.emplace_back(mParticles.size());
   }
-  mParticles.emplace_back(mCurrentParticle);
-  mTransportedIDs.emplace_back(mCurrentParticle.GetStatusCode());
-  insertInVector(mTrackIDtoParticlesEntry, mCurrentParticle.GetStatusCode(), (int)(mParticles.size() - 1));
+  mParticles.emplace_back(makeMCTrack(record));
+  mTransportedIDs.emplace_back(record.trackID);
+  insertInVector(mTrackIDtoParticlesEntry, record.trackID, (int)(mParticles.size() - 1));
 
-  mIndexOfCurrentTrack = mCurrentParticle.GetStatusCode();
+  mIndexOfCurrentTrack = record.trackID;
   iTrack = mIndexOfCurrentTrack;
 
   if (o2::conf::SimCutParams::Instance().trackSeed) {
-    auto hash = getHash(mCurrentParticle);
+    auto hash = getHash(record);
     // LOG(INFO) << "SEEDING NEW TRACK USING HASH" << hash;
     // init seed per track
     gRandom->SetSeed(hash);
@@ -354,25 +421,19 @@ void Stack::finishCurrentPrimary()
   auto selected = selectTracks();
   // loop over current particle buffer
   int index = 0;
-  int indexoffset = mTracks->size();
   int neglected = 0;
-  std::vector<int> indicesKept;
+  // persistent index of each entry of the particle buffer, -1 if not kept
+  mPersistentIndices.assign(mParticles.size(), -1);
   for (const auto& particle : mParticles) {
     if (particle.getStore() || !mPruneKinematics) {
       // map the global track index to the new persistent index
-      // FIXME: only fill the map for non-trivial mappings in which mTransportedIDs[index]!=mTracks->size();
-      mIndexMap[mTransportedIDs[index]] = mTracks->size();
+      insertInVector(mIndexMap, mTransportedIDs[index], (int)mTracks->size());
+      mPersistentIndices[index] = mTracks->size();
       auto mother = particle.getMotherTrackId();
       assert(mother < index);
       mTracks->emplace_back(particle);
-      indicesKept.emplace_back(index);
-      if (mother != -1) {
-        auto iter = std::find_if(indicesKept.begin(), indicesKept.end(), [mother](int x) { return x == mother; });
-        if (iter != indicesKept.end()) {
-          // complexity should be constant
-          auto newmother = std::distance(indicesKept.begin(), iter);
-          mTracks->back().SetMotherTrackId(newmother + indexoffset);
-        }
+      if (mother != -1 && mPersistentIndices[mother] != -1) {
+        mTracks->back().SetMotherTrackId(mPersistentIndices[mother]);
       }
       // LOG(INFO) << "Adding to map " << mTransportedIDs[index] << " to " << mIndexMap[mTransportedIDs[index]];
     } else {
@@ -437,16 +498,14 @@ void Stack::UpdateTrackIndex(TRefArray* detList)
   //  }
 
   // update track references
-  // use some caching since repeated trackIDs
+  const int nindices = mIndexMap.size();
   for (auto& ref : *mTrackRefs) {
     const auto id = ref.getTrackID();
-    auto iter = mIndexMap.find(id);
-    if (iter == mIndexMap.end()) {
+    const int newid = (id >= 0 && id < nindices) ? mIndexMap[id] : -1;
+    if (newid == -1) {
       LOG(INFO) << "Invalid trackref ... needs to be removed\n";
-      ref.setTrackID(-1);
-    } else {
-      ref.setTrackID(iter->second);
     }
+    ref.setTrackID(newid);
   }
 
   // sort trackrefs according to new track index
@@ -466,10 +525,34 @@ void Stack::UpdateTrackIndex(TRefArray* detList)
     }
   }
 
-  for (auto det : mActiveDetectors) {
-    // update the track indices by delegating to specialized detector functions
-    det->updateHitTrackIndices(mIndexMap);
-  } // List of active detectors
+  // update the track indices by delegating to specialized detector functions,
+  // the detectors being independent they can be treated concurrently
+  const int ndet = mActiveDetectors.size();
+  const int nthreads = std::max(1, std::min(mNIndexUpdateThreads, ndet));
+  std::atomic<int> nextdet{ 0 };
+  std::vector<std::exception_ptr> errors(nthreads);
+  auto worker = [this, ndet, &nextdet, &errors](int thread) {
+    try {
+      for (int idet = nextdet++; idet < ndet; idet = nextdet++) {
+        mActiveDetectors[idet]->updateHitTrackIndices(mIndexMap);
+      }
+    } catch (...) {
+      errors[thread] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int thread = 1; thread < nthreads; ++thread) {
+    threads.emplace_back(worker, thread);
+  }
+  worker(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
 
   LOG(DEBUG) << "Stack::UpdateTrackIndex: ...stack and " << nColl << " collections updated.";
 }
@@ -485,9 +568,7 @@ void Stack::Reset()
 {
   mIndexOfCurrentTrack = -1;
   mNumberOfPrimaryParticles = mNumberOfEntriesInParticles = mNumberOfEntriesInTracks = 0;
-  while (!mStack.empty()) {
-    mStack.pop();
-  }
+  mStack.clear(); // keeps the storage for the next event
   mParticles.clear();
   mTracks->clear();
   if (!mIsExternalMode && (mPrimariesDone != mPrimaryParticles.size())) {
@@ -499,6 +580,7 @@ void Stack::Reset()
   mTrackRefs->clear();
   mIndexedTrackRefs->clear();
   mTrackIDtoParticlesEntry.clear();
+  mIndexMap.clear();
   mHitCounter = 0;
 }
 
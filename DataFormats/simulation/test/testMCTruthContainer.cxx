@@ -264,4 +264,84 @@ BOOST_AUTO_TEST_CASE(MCTruthContainer_move)
   BOOST_CHECK(container.getNElements() == 4);
 }
 
+BOOST_AUTO_TEST_CASE(MCTruthContainer_mergeAll)
+{
+  using TruthElement = long;
+  using Container = dataformats::MCTruthContainer<TruthElement>;
+  std::vector<Container> parts(36);
+  for (size_t p = 0; p < parts.size(); ++p) {
+    for (uint i = 0; i <= p % 5; ++i) {
+      parts[p].addElement(i, TruthElement(p));
+      parts[p].addElement(i, TruthElement(100 + i));
+    }
+  }
+  std::vector<Container const*> pointers;
+  for (auto const& part : parts) {
+    pointers.push_back(&part);
+  }
+
+  // reference from sequential merging
+  Container reference;
+  reference.addElement(0, TruthElement(-1));
+  Container merged(reference);
+  Container mergedMT(reference);
+  for (auto const& part : parts) {
+    reference.mergeAtBack(part);
+  }
+  merged.mergeAll(pointers);
+  mergedMT.mergeAll(pointers, 4);
+
+  for (auto const* container : { &merged, &mergedMT }) {
+    BOOST_REQUIRE(container->getIndexedSize() == reference.getIndexedSize());
+    BOOST_REQUIRE(container->getNElements() == reference.getNElements());
+    for (uint i = 0; i < reference.getIndexedSize(); ++i) {
+      BOOST_CHECK(container->getMCTruthHeader(i).index == reference.getMCTruthHeader(i).index);
+    }
+    for (uint i = 0; i < reference.getNElements(); ++i) {
+      BOOST_CHECK(container->getElement(i) == reference.getElement(i));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MCTruthContainer_flatten)
+{
+  using TruthElement = long;
+  using Container = dataformats::MCTruthContainer<TruthElement>;
+  Container container;
+  container.addElement(0, TruthElement(1));
+  container.addElement(0, TruthElement(2));
+  container.addElement(1, TruthElement(1));
+  container.addElement(2, TruthElement(10));
+
+  std::vector<char> buffer;
+  auto size = container.flatten_to(buffer);
+  BOOST_CHECK(size == buffer.size());
+  BOOST_CHECK(size == container.getFlatSize());
+
+  // the labels are accessed in place in the buffer
+  dataformats::MCTruthContainerView<TruthElement> view(buffer);
+  BOOST_CHECK(view.getIndexedSize() == 3);
+  BOOST_CHECK(view.getNElements() == 4);
+  BOOST_CHECK(view.getLabels(0).size() == 2);
+  BOOST_CHECK(view.getLabels(0)[0] == 1);
+  BOOST_CHECK(view.getLabels(0)[1] == 2);
+  BOOST_CHECK(view.getLabels(2).size() == 1);
+  BOOST_CHECK(view.getLabels(2)[0] == 10);
+  BOOST_CHECK(view.getLabels(10).size() == 0);
+  BOOST_CHECK(reinterpret_cast<char const*>(&view.getElement(0)) >= buffer.data());
+  BOOST_CHECK(reinterpret_cast<char const*>(&view.getElement(3)) < buffer.data() + buffer.size());
+
+  Container restored;
+  restored.restore_from(buffer.data(), buffer.size());
+  BOOST_CHECK(restored.getIndexedSize() == 3);
+  BOOST_CHECK(restored.getNElements() == 4);
+  BOOST_CHECK(restored.getMCTruthHeader(1).index == 2);
+  BOOST_CHECK(restored.getLabels(1)[0] == 1);
+
+  // a buffer for a different truth element type is rejected
+  using IncompatibleView = dataformats::MCTruthContainerView<char>;
+  BOOST_CHECK_THROW(IncompatibleView(gsl::span<const char>(buffer)), std::runtime_error);
+  BOOST_CHECK_THROW(restored.restore_from(buffer.data(), sizeof(dataformats::MCTruthFlatHeader) - 1), std::runtime_error);
+}
+
 } // end namespace
@@ -0,0 +1,116 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CellAccumulator.h
+/// \brief Definition of a dense per-cell accumulator of digits, to be used by the digitizers
+
+#ifndef ALICEO2_BASE_CELLACCUMULATOR_H_
+#define ALICEO2_BASE_CELLACCUMULATOR_H_
+
+#include <algorithm>
+#include <vector>
+
+namespace o2
+{
+namespace base
+{
+
+/// \class CellAccumulator
+/// Table of the digits accumulated in each cell of a detector whose cells are numbered from
+/// 0 to nCells - 1, to be used by the digitizers instead of maps keyed by the cell id.
+/// The cells which received a digit are recorded in a list of touched cells, such that the
+/// digits can be collected and the table cleared without going through all the cells. The
+/// storage of the cells is kept when clearing, the table does not allocate once it is warm.
+///
+/// A digit added to a cell is merged (operator+=) with the first digit of the cell it can be
+/// added to (canAdd), e.g. within the same time window, otherwise it is stored as a new digit.
+template <typename T>
+class CellAccumulator
+{
+ public:
+  /// Default constructor, creates a table without cells
+  CellAccumulator() = default;
+
+  /// Constructor of a table of nCells cells
+  explicit CellAccumulator(int nCells) { setNCells(nCells); }
+
+  /// Set the number of cells, the table is cleared
+  void setNCells(int nCells)
+  {
+    clear();
+    mCells.resize(nCells);
+  }
+
+  /// \return number of cells of the table
+  int getNCells() const { return mCells.size(); }
+
+  /// \return true if cell is in the range of the table
+  bool isValid(int cell) const { return cell >= 0 && cell < getNCells(); }
+
+  /// Add a digit to a valid cell
+  /// \return stored digit the added one was merged into, valid until the next addition to this cell
+  T& add(int cell, const T& digit)
+  {
+    auto& digits = mCells[cell];
+    if (digits.empty()) {
+      mTouchedCells.push_back(cell);
+    }
+    for (auto& digit0 : digits) {
+      if (digit0.canAdd(digit)) {
+        digit0 += digit;
+        return digit0;
+      }
+    }
+    digits.push_back(digit);
+    return digits.back();
+  }
+
+  /// \return true if a digit was added to cell since the last clear
+  bool isTouched(int cell) const { return !mCells[cell].empty(); }
+
+  /// \return digits of a cell
+  const std::vector<T>& getDigits(int cell) const { return mCells[cell]; }
+  std::vector<T>& getDigits(int cell) { return mCells[cell]; }
+
+  /// \return cells which received a digit since the last clear, in the order of their first digit
+  const std::vector<int>& getTouchedCells() const { return mTouchedCells; }
+
+  /// Sort the touched cells by increasing cell number
+  void sortTouchedCells() { std::sort(mTouchedCells.begin(), mTouchedCells.end()); }
+
+  /// Execute a function on all the digits of the touched cells, in the order of the touched cells
+  template <typename CALLABLE>
+  void forEachDigit(CALLABLE&& func)
+  {
+    for (auto cell : mTouchedCells) {
+      for (auto& digit : mCells[cell]) {
+        func(digit);
+      }
+    }
+  }
+
+  /// Remove the digits of the touched cells, keeping the storage
+  void clear()
+  {
+    for (auto cell : mTouchedCells) {
+      mCells[cell].clear();
+    }
+    mTouchedCells.clear();
+  }
+
+ private:
+  std::vector<std::vector<T>> mCells; ///< digits of each cell
+  std::vector<int> mTouchedCells;     ///< cells with digits
+};
+
+} // namespace base
+} // namespace o2
+
+#endif
@@ -14,6 +14,7 @@
 #ifndef ALICEO2_BASE_DETECTOR_H_
 #define ALICEO2_BASE_DETECTOR_H_
 
+#include <deque>
 #include <map>
 #include <vector>
 #include <initializer_list>
@@ -22,6 +23,7 @@
 #include "FairDetector.h"  // for FairDetector
 #include "FairRootManager.h"
 #include "DetectorsBase/MaterialManager.h"
+#include "DetectorsBase/ShowerLibrary.h"
 #include "Rtypes.h"        // for Float_t, Int_t, Double_t, Detector::Class, etc
 #include <cxxabi.h>
 #include <typeinfo>
@@ -30,6 +32,7 @@
 #include <TMessage.h>
 #include "CommonUtils/ShmManager.h"
 #include "CommonUtils/ShmAllocator.h"
+#include "CommonUtils/CompactHits.h"
 #include <sys/shm.h>
 #include <type_traits>
 #include <unistd.h>
@@ -96,8 +99,34 @@ class Detector : public FairDetector
       return mDensityFactor;
     }
 
+    /// write the hits of the hit merger in the compact format (CommonUtils/CompactHits.h), to branches
+    /// "<hit branch name>Compact", for the detectors whose hit type supports it
+    static void setCompactHits(bool compact, o2::utils::CompactHitPrecision const& precision = o2::utils::CompactHitPrecision())
+    {
+      mCompactHits = compact;
+      mCompactHitPrecision = precision;
+    }
+
+    static bool useCompactHits() { return mCompactHits; }
+    static o2::utils::CompactHitPrecision const& getCompactHitPrecision() { return mCompactHitPrecision; }
+
     /// declare alignable volumes of detector
     virtual void addAlignableVolumes() const;
+
+    /// fast simulation with a shower library (DetectorsBase/ShowerLibrary.h):
+    /// names of the volumes whose entrance triggers the library showers, none by default
+    virtual std::vector<std::string> getShowerLibraryVolumes() const { return {}; }
+
+    /// angle to the normal of the front volume and position coordinate of the current track, entering a
+    /// library volume with the unit direction dir; by default the angle to the local z axis and no position
+    virtual void getShowerLibraryCoordinates(const double dir[3], float& angle, float& position) const;
+
+    /// create the hits of a library shower for the current track, entering at entry with the unit direction
+    /// dir, the energy (GeV) and time (ns) given
+    virtual void depositLibraryShower(ShowerLibrary::Shower const& shower, const double entry[3], const double dir[3],
+                                      double energy, double time)
+    {
+    }
     
     /// Sets per wrapper volume parameters
     virtual void defineWrapperVolume(Int_t id, Double_t rmin, Double_t rmax, Double_t zspan);
@@ -146,9 +175,10 @@ class Detector : public FairDetector
 
     // interface to update track indices of data objects
     // usually called by the Stack, at the end of an event, which might have changed
-    // the track indices due to filtering
+    // the track indices due to filtering; the mapping gives the new index for each old index
+    // (-1 for tracks which were not kept); the Stack may call it for several detectors concurrently
     // FIXME: make private friend of stack?
-    virtual void updateHitTrackIndices(std::map<int, int> const&) = 0;
+    virtual void updateHitTrackIndices(std::vector<int> const&) = 0;
 
     // interfaces to attach properly encoded hit information to a FairMQ message
     // and to decode it
@@ -163,6 +193,15 @@ class Detector : public FairDetector
     virtual void mergeHitEntries(TTree& origin, TTree& target, std::map<int, std::vector<int>> const& entries,
                                  std::map<int, std::vector<int>> const& trackoffsets) = 0;
 
+    // interfaces used by the hit merger process to reassemble the events in memory, without intermediate TTree:
+    // collectHits decodes the hits of a sub-event from the message parts and appends them to the hits of
+    // event eventID (shifting their trackIDs by trackoffset); setHitBranchAddresses attaches the collected hits of
+    // an event to the hit branches of the tree, to be filled by the next TTree::Fill, and discardHits drops them
+    // (to be called after the fill)
+    virtual void collectHits(int eventID, FairMQParts& parts, int& index, int trackoffset) = 0;
+    virtual void setHitBranchAddresses(TTree& tr, int eventID) = 0;
+    virtual void discardHits(int eventID) = 0;
+
     // hook which is called automatically to custom initialize the O2 detectors
     // all initialization not able to do in constructors should be done here
     // (typically the case for geometry related stuff, etc)
@@ -211,6 +250,9 @@ class Detector : public FairDetector
     static Float_t mDensityFactor; //! factor that is multiplied to all material densities (ONLY for
     // systematic studies)
 
+    static bool mCompactHits;                                   //! write compact hit branches in the hit merger
+    static o2::utils::CompactHitPrecision mCompactHitPrecision; //! precision of the compact hits
+
     ClassDefOverride(Detector, 1) // Base class for ALICE Modules
 };
 
@@ -293,14 +335,15 @@ class DetImpl : public o2::base::Detector
   // generic implementation for the updateHitTrackIndices interface
   // assumes Detectors have a GetHits(int) function that return some iterable
   // hits which are o2::BaseHits
-  void updateHitTrackIndices(std::map<int, int> const& indexmapping) override
+  void updateHitTrackIndices(std::vector<int> const& indexmapping) override
   {
     int probe = 0; // some Detectors have multiple hit vectors and we are probing
                    // them via a probe integer until we get a nullptr
+    const int nindices = indexmapping.size();
     while (auto hits = static_cast<Det*>(this)->Det::getHits(probe++)) {
       for (auto& hit : *hits) {
-        auto iter = indexmapping.find(hit.GetTrackID());
-        hit.SetTrackID(iter->second);
+        const int id = hit.GetTrackID();
+        hit.SetTrackID((id >= 0 && id < nindices) ? indexmapping[id] : -1);
       }
     }
   }
@@ -442,6 +485,111 @@ class DetImpl : public o2::base::Detector
     }
   }
 
+  void collectHits(int eventID, FairMQParts& parts, int& index, int trackoffset) override
+  {
+    using Hit_t = decltype(static_cast<Det*>(this)->Det::getHits(0));
+    using Container_t = typename std::remove_pointer<Hit_t>::type;
+    auto& collected = mCollectedHits[eventID];
+    int probe = 0;
+    std::string name = static_cast<Det*>(this)->getHitBranchNames(probe);
+    while (name.size() > 0) {
+      if (int(collected.size()) <= probe) {
+        collected.push_back(new Container_t);
+      }
+      auto target = static_cast<Hit_t>(collected[probe]);
+      const auto start = target->size();
+      if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
+        auto hitsptr = decodeTMessage<Hit_t>(parts, index++);
+        if (hitsptr) {
+          if (target->empty()) {
+            std::swap(*target, *hitsptr);
+          } else {
+            target->insert(target->end(), hitsptr->begin(), hitsptr->end());
+          }
+          delete hitsptr;
+        }
+      } else {
+        // the hits are read directly from the shared mem buffer of the simulation worker
+        bool* busy;
+        auto hitsptr = decodeShmMessage<Hit_t>(parts, index++, busy);
+        LOG(DEBUG2) << "GOT " << hitsptr->size() << " HITS ";
+        target->insert(target->end(), hitsptr->begin(), hitsptr->end());
+        // the buffer can be reused by the worker as soon as it is copied
+        *busy = false;
+      }
+      if (trackoffset != 0) {
+        for (auto i = start; i < target->size(); ++i) {
+          auto& hit = (*target)[i];
+          hit.SetTrackID(hit.GetTrackID() + trackoffset);
+        }
+      }
+      // next name
+      name = static_cast<Det*>(this)->getHitBranchNames(++probe);
+    }
+  }
+
+  void setHitBranchAddresses(TTree& tr, int eventID) override
+  {
+    using Hit_t = decltype(static_cast<Det*>(this)->Det::getHits(0));
+    using Container_t = typename std::remove_pointer<Hit_t>::type;
+    auto& collected = mCollectedHits[eventID];
+    int probe = 0;
+    std::string name = static_cast<Det*>(this)->getHitBranchNames(probe);
+    while (name.size() > 0) {
+      // events without hits of this detector get an empty entry as soon as the branch exists
+      if (int(collected.size()) <= probe && tr.GetBranch(name.c_str())) {
+        collected.push_back(new Container_t);
+      }
+      if (probe < int(collected.size())) {
+        if (int(mBranchAddresses.size()) <= probe) {
+          mBranchAddresses.resize(probe + 1, nullptr);
+        }
+        if constexpr (o2::utils::CompactHitCodec<typename Container_t::value_type>::available) {
+          if (useCompactHits()) {
+            setCompactHitBranchAddress<Container_t>(tr, name, probe, *static_cast<Hit_t>(collected[probe]));
+            name = static_cast<Det*>(this)->getHitBranchNames(++probe);
+            continue;
+          }
+        }
+        // the address has to stay valid until the fill
+        mBranchAddresses[probe] = collected[probe];
+        auto hitsptr = reinterpret_cast<Hit_t*>(&mBranchAddresses[probe]);
+        auto br = getOrMakeBranch(tr, name.c_str(), hitsptr);
+        br->SetAddress(static_cast<void*>(hitsptr));
+      }
+      // next name
+      name = static_cast<Det*>(this)->getHitBranchNames(++probe);
+    }
+  }
+
+  // encodes the hits to the buffer of the probe and attaches it to the compact branch of the hits
+  template <typename Container_t>
+  void setCompactHitBranchAddress(TTree& tr, std::string const& name, int probe, Container_t const& hits)
+  {
+    // growing the deque keeps the buffers already attached in place
+    if (int(mCompactBuffers.size()) <= probe) {
+      mCompactBuffers.resize(probe + 1);
+    }
+    o2::utils::encodeHits(hits, mCompactBuffers[probe], getCompactHitPrecision());
+    // the address has to stay valid until the fill
+    mBranchAddresses[probe] = &mCompactBuffers[probe];
+    auto bufferptr = reinterpret_cast<std::vector<char>**>(&mBranchAddresses[probe]);
+    auto br = getOrMakeBranch(tr, (name + "Compact").c_str(), bufferptr);
+    br->SetAddress(static_cast<void*>(bufferptr));
+  }
+
+  void discardHits(int eventID) override
+  {
+    using Hit_t = decltype(static_cast<Det*>(this)->Det::getHits(0));
+    auto iter = mCollectedHits.find(eventID);
+    if (iter != mCollectedHits.end()) {
+      for (auto ptr : iter->second) {
+        delete static_cast<Hit_t>(ptr);
+      }
+      mCollectedHits.erase(iter);
+    }
+  }
+
   // implementing CloneModule (for G4-MT mode) automatically for each deriving
   // Detector class "Det"; calls copy constructor of Det
   FairModule* CloneModule() const final
@@ -544,6 +692,9 @@ class DetImpl : public o2::base::Detector
       }
     }
     freeHitBuffers();
+    while (!mCollectedHits.empty()) {
+      discardHits(mCollectedHits.begin()->first);
+    }
   }
 
  protected:
@@ -554,6 +705,9 @@ class DetImpl : public o2::base::Detector
   std::vector<void*> mCachedPtr[NHITBUFFERS];
   int mCurrentBuffer = 0; // holding the current buffer information
   int mInitialized = false;
+  std::map<int, std::vector<void*>> mCollectedHits; //! hit containers (one per probe) collected by the hit merger per event
+  std::vector<void*> mBranchAddresses;              //! hit containers attached to the branches by the hit merger
+  std::deque<std::vector<char>> mCompactBuffers;    //! compact hits attached to the branches by the hit merger
   ClassDefOverride(DetImpl, 0);
 };
 }
@@ -46,9 +46,16 @@ namespace base
 class GeometryManager : public TObject
 {
  public:
-  ///< load geometry from file
+  ///< version of the geometry files written by writeGeometry
+  static constexpr int GeometryFileVersion = 1;
+
+  ///< load geometry from file, nothing is done if this geometry was already loaded by this process
   static void loadGeometry(std::string geomFileName = "O2geometry.root", std::string geomName = "FAIRGeom");
 
+  ///< write the closed current geometry (including the alignment, if applied) to file, together with
+  ///< its voxelization such that it does not have to be rebuilt when loading, and tagged with GeometryFileVersion
+  static void writeGeometry(std::string geomFileName = "O2geometry.root", std::string geomName = "FAIRGeom");
+
   ///< Get the global transformation matrix (ideal geometry) for a given alignable volume
   ///< The alignable volume is identified by 'symname' which has to be either a valid symbolic
   ///< name, the query being performed after alignment, or a valid volume path if the query is
@@ -0,0 +1,189 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MatBudgetLUT.h
+/// \brief Definition of a lookup table of the material budget in cylindrical voxels
+
+#ifndef ALICEO2_BASE_MATBUDGETLUT_H_
+#define ALICEO2_BASE_MATBUDGETLUT_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <gsl/span>
+#include "DetectorsBase/GeometryManager.h"
+#include "MathUtils/Cartesian3D.h"
+
+namespace o2
+{
+namespace base
+{
+
+/// \class MatBudgetLUT
+/// Lookup table of the mean density and inverse radiation length in voxels of a regular cylindrical grid
+/// in (r, phi, z), to be used instead of the TGeo navigation of GeometryManager::MeanMaterialBudget for
+/// the material corrections of the track propagation. The table is filled once from the geometry and
+/// stored as one flat, position independent buffer: a small header followed by one float array per
+/// quantity, which can be written to a file or a CCDB blob. The queries do not modify the table and
+/// can be done from any number of threads.
+///
+/// The material between two points is integrated with the midpoint rule in sub-steps not longer than
+/// half of the smallest voxel size in r and z. Points outside of the grid are considered as vacuum.
+class MatBudgetLUT
+{
+ public:
+  /// header of the flat buffer
+  struct Header {
+    uint32_t magic = Magic;                 ///< identifier of the format
+    uint16_t version = 1;                   ///< version of the format
+    uint16_t sizeofHeader = sizeof(Header); ///< size of the header in bytes
+    uint32_t nR = 0;                        ///< number of voxels in r
+    uint32_t nPhi = 0;                      ///< number of voxels in phi
+    uint32_t nZ = 0;                        ///< number of voxels in z
+    float rMin = 0.f;                       ///< lower radius of the grid (cm)
+    float rMax = 0.f;                       ///< upper radius of the grid (cm)
+    float zMax = 0.f;                       ///< the grid covers -zMax < z < zMax (cm)
+  };
+
+  static constexpr uint32_t Magic = 0x544c424d; ///< 'MBLT'
+  static constexpr int NComponents = 2;         ///< density and inverse radiation length
+
+  /// Default constructor, creates an empty table
+  MatBudgetLUT() = default;
+
+  /// Constructor of an owning table without material
+  /// \param nR number of voxels in r
+  /// \param nPhi number of voxels in phi, covering [0, 2pi)
+  /// \param nZ number of voxels in z
+  /// \param rMin lower radius of the grid (cm)
+  /// \param rMax upper radius of the grid (cm)
+  /// \param zMax half length of the grid in z (cm)
+  MatBudgetLUT(int nR, int nPhi, int nZ, float rMin, float rMax, float zMax);
+
+  /// Constructor of a table from a flat buffer as returned by getBuffer
+  /// \param buffer flat buffer, the data is copied if copy is true, otherwise the buffer must outlive the table
+  /// \param copy copy the buffer into the table
+  MatBudgetLUT(gsl::span<const char> buffer, bool copy = false);
+
+  MatBudgetLUT(const MatBudgetLUT&) = delete;
+  MatBudgetLUT& operator=(const MatBudgetLUT&) = delete;
+  MatBudgetLUT(MatBudgetLUT&&) = default;
+  MatBudgetLUT& operator=(MatBudgetLUT&&) = default;
+
+  /// \return true if the table contains a grid
+  bool isValid() const { return mHeader != nullptr; }
+
+  /// \return header of the table
+  const Header& getHeader() const { return *mHeader; }
+
+  /// \return flat buffer of the table
+  gsl::span<const char> getBuffer() const { return gsl::span<const char>(reinterpret_cast<const char*>(mHeader), getBufferSize()); }
+
+  /// \return size of the flat buffer in bytes
+  size_t getBufferSize() const { return mHeader ? sizeof(Header) + NComponents * mNVoxels * sizeof(float) : 0; }
+
+  /// Fill the table from the loaded TGeo geometry, only possible for owning tables.
+  /// The material of each voxel is averaged over nSamples x nSamples radial segments crossing
+  /// the voxel at equidistant phi and z, such that thin layers are accounted for.
+  /// \param nSamples number of segments per voxel in phi and z
+  void fillFromGeometry(int nSamples = 2);
+
+  /// Set the material of a voxel, only possible for owning tables
+  /// \param ir r index
+  /// \param iphi phi index
+  /// \param iz z index
+  /// \param rho mean density (g/cm3)
+  /// \param invX0 mean inverse radiation length (1/cm)
+  void setVoxel(int ir, int iphi, int iz, float rho, float invX0);
+
+  /// \return mean density of a voxel (g/cm3)
+  float getRho(int ir, int iphi, int iz) const { return mRho[index(ir, iphi, iz)]; }
+
+  /// \return mean inverse radiation length of a voxel (1/cm)
+  float getInvX0(int ir, int iphi, int iz) const { return mInvX0[index(ir, iphi, iz)]; }
+
+  /// Mean material budget between two points as GeometryManager::MeanMaterialBudget.
+  /// Only the density, the radiation length fraction and the length are filled.
+  /// \param start start point
+  /// \param end end point
+  GeometryManager::MatBudget getMatBudget(const Point3D<float>& start, const Point3D<float>& end) const;
+
+  /// Write the flat buffer to a binary file
+  /// \param fileName name of the output file
+  void writeToFile(const std::string& fileName) const;
+
+  /// Read a table from a binary file written with writeToFile
+  /// \param fileName name of the input file
+  /// \return owning table
+  static MatBudgetLUT readFromFile(const std::string& fileName);
+
+ private:
+  std::vector<char> mOwnedBuffer;  ///< storage of owning tables
+  const Header* mHeader = nullptr; ///< header of the flat buffer
+  const float* mRho = nullptr;     ///< mean density per voxel
+  const float* mInvX0 = nullptr;   ///< mean inverse radiation length per voxel
+  size_t mNVoxels = 0;             ///< number of voxels
+  float mInvDeltaR = 0.f;          ///< inverse of the r voxel size
+  float mInvDeltaPhi = 0.f;        ///< inverse of the phi voxel size
+  float mInvDeltaZ = 0.f;          ///< inverse of the z voxel size
+  float mMaxStep = 0.f;            ///< maximal integration sub-step
+
+  /// allocate the owned buffer and write the header
+  void allocate(const Header& header);
+
+  /// set the data pointers for the buffer starting at mHeader
+  void setupPointers();
+
+  /// linear index of a voxel
+  size_t index(int ir, int iphi, int iz) const
+  {
+    return (static_cast<size_t>(iz) * mHeader->nPhi + iphi) * mHeader->nR + ir;
+  }
+};
+
+inline GeometryManager::MatBudget MatBudgetLUT::getMatBudget(const Point3D<float>& start, const Point3D<float>& end) const
+{
+  constexpr float TwoPI = 6.28318530717958647692f;
+  GeometryManager::MatBudget budget;
+  const float dx = end.X() - start.X(), dy = end.Y() - start.Y(), dz = end.Z() - start.Z();
+  const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+  budget.length = length;
+  if (!mHeader) {
+    return budget;
+  }
+  const int nSteps = std::max(1, static_cast<int>(std::ceil(length / mMaxStep)));
+  const float frac = 1.f / nSteps;
+  float sumRho = 0.f, sumInvX0 = 0.f;
+  for (int is = 0; is < nSteps; is++) {
+    const float t = (is + 0.5f) * frac; // midpoint of the sub-step
+    const float x = start.X() + t * dx, y = start.Y() + t * dy, z = start.Z() + t * dz;
+    const float fr = (std::sqrt(x * x + y * y) - mHeader->rMin) * mInvDeltaR;
+    const float fz = (z + mHeader->zMax) * mInvDeltaZ;
+    if (fr < 0.f || fr >= mHeader->nR || fz < 0.f || fz >= mHeader->nZ) {
+      continue; // vacuum outside of the grid
+    }
+    float phi = std::atan2(y, x);
+    phi += (phi < 0.f) * TwoPI;
+    const int iphi = std::min(static_cast<int>(phi * mInvDeltaPhi), static_cast<int>(mHeader->nPhi) - 1);
+    const size_t i = index(static_cast<int>(fr), iphi, static_cast<int>(fz));
+    sumRho += mRho[i];
+    sumInvX0 += mInvX0[i];
+  }
+  budget.meanRho = sumRho * frac;
+  budget.meanX2X0 = sumInvX0 * frac * length;
+  return budget;
+}
+
+} // namespace base
+} // namespace o2
+
+#endif
@@ -16,11 +16,15 @@
 #define ALICEO2_BASE_PROPAGATOR_
 
 #include <string>
+#include <vector>
+#include <gsl/span>
 #include "CommonConstants/PhysicsConstants.h"
 #include "ReconstructionDataFormats/Track.h"
 #include "ReconstructionDataFormats/TrackLTIntegral.h"
 #include "MathUtils/Cartesian3D.h"
 
+class TGeoNavigator;
+
 namespace o2
 {
 namespace parameters
@@ -35,9 +39,28 @@ class MagFieldFast;
 
 namespace base
 {
+class MatBudgetLUT;
+
 class Propagator
 {
  public:
+  /// Propagation context of a thread: own TGeo navigator for the material queries and scratch space
+  /// of the batched propagation. It is created on the first propagation in a thread and destroyed,
+  /// removing the navigator it added, at the thread exit.
+  struct ThreadContext {
+    TGeoNavigator* navigator = nullptr; ///< navigator of the thread
+    bool ownNavigator = false;          ///< navigator was added for this context
+    std::vector<int> active;            ///< batched propagation: tracks still to propagate
+    std::vector<char> dirs;             ///< batched propagation: propagation directions
+    std::vector<char> signCorrs;        ///< batched propagation: signs of eloss corrections
+    std::vector<float> buffer;          ///< batched propagation: start points and field of a step
+
+    ThreadContext() = default;
+    ThreadContext(const ThreadContext&) = delete;
+    ThreadContext& operator=(const ThreadContext&) = delete;
+    ~ThreadContext();
+  };
+
   static Propagator* Instance()
   {
     static Propagator instance;
@@ -52,6 +75,21 @@ class Propagator
                     float maxSnp = 0.85, float maxStep = 2.0, int matCorr = 1,
                     o2::track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0);
 
+  /// Propagate a batch of tracks to the same X taking into account all three components of the field,
+  /// see the single track version for the parameters. All tracks make their steps together, such that
+  /// the field is evaluated at once for the start points of the step of all tracks still propagating.
+  /// \param status per track flag of successful propagation, resized to the number of tracks
+  /// \param tofInfo optional LT integrals, either empty or one per track
+  /// \return number of successfully propagated tracks
+  int PropagateToXBxByBz(gsl::span<o2::track::TrackParCov> tracks, float x, std::vector<char>& status,
+                         float mass = o2::constants::physics::MassPionCharged, float maxSnp = 0.85, float maxStep = 2.0,
+                         int matCorr = 1, gsl::span<o2::track::TrackLTIntegral> tofInfo = {}, int signCorr = 0);
+
+  /// Propagate a batch of tracks to the same X in constant Bz, see PropagateToXBxByBz for the batch parameters
+  int propagateToX(gsl::span<o2::track::TrackParCov> tracks, float x, float bZ, std::vector<char>& status,
+                   float mass = o2::constants::physics::MassPionCharged, float maxSnp = 0.85, float maxStep = 2.0,
+                   int matCorr = 1, gsl::span<o2::track::TrackLTIntegral> tofInfo = {}, int signCorr = 0);
+
   bool propagateToDCA(const Point3D<float>& vtx, o2::track::TrackParCov& track, float bZ,
                       float mass = o2::constants::physics::MassPionCharged, float maxStep = 2.0, int matCorr = 1,
                       o2::track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0, float maxD = 999.f);
@@ -64,6 +102,17 @@ class Propagator
   // Bz at the origin
   float getNominalBz() const { return mBz; }
 
+  // use material LUT instead of TGeo navigation for material corrections (nullptr to switch back to TGeo)
+  void setMatLUT(const MatBudgetLUT* lut) { mMatLUT = lut; }
+  const MatBudgetLUT* getMatLUT() const { return mMatLUT; }
+
+  /// Prepare the geometry for the propagation with material corrections from up to nThreads threads.
+  /// Must be called before starting the threads, the navigator of the calling thread is kept.
+  static void setMaxThreads(int nThreads);
+
+  /// \return propagation context of the calling thread
+  static ThreadContext& getThreadContext();
+
   static int initFieldFromGRP(const o2::parameters::GRPObject* grp);
   static int initFieldFromGRP(const std::string grpFileName, std::string grpName = "GRP");
 
@@ -71,8 +120,12 @@ class Propagator
   Propagator();
   ~Propagator() = default;
 
+  bool finalizeStep(o2::track::TrackParCov& track, const Point3D<float>& xyz0, float mass, float maxSnp, int matCorr,
+                    o2::track::TrackLTIntegral* tofInfo, int signCorr) const;
+
   const o2::field::MagFieldFast* mField = nullptr; ///< External fast field (barrel only for the moment)
   float mBz = 0;                                   // nominal field
+  const MatBudgetLUT* mMatLUT = nullptr;           // external material LUT, TGeo is used if not set
 
   ClassDef(Propagator, 0);
 };
@@ -0,0 +1,88 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ShowerLibrary.h
+/// \brief Library of frozen showers for the fast simulation of the calorimeters
+///
+/// The showers are the energy deposits in the sensitive volumes of a detector by the photons and
+/// electrons entering its front volumes, binned in incident energy, angle (to the normal of the front
+/// volume) and a position coordinate chosen by the detector. A deposit is stored as a spot in the frame
+/// of the incident track: distance along its direction and across it, time since the entrance and
+/// fraction of the incident energy. When a library is set for a detector, the MC application stops the
+/// eligible tracks at the entrance and the detector creates the hits of a shower drawn from their bin.
+
+#ifndef ALICEO2_BASE_SHOWERLIBRARY_H_
+#define ALICEO2_BASE_SHOWERLIBRARY_H_
+
+#include "Rtypes.h"
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace base
+{
+
+class ShowerLibrary
+{
+ public:
+  /// an energy deposit of a shower
+  struct Spot {
+    float along = 0.; ///< distance along the incident direction [cm]
+    float u = 0.;     ///< distances across the incident direction [cm]
+    float v = 0.;
+    float time = 0.;   ///< time since the entrance [ns]
+    float energy = 0.; ///< deposited energy / incident energy
+    ClassDefNV(Spot, 1);
+  };
+  using Shower = std::vector<Spot>;
+
+  ShowerLibrary() = default;
+  /// \param energyEdges, angleEdges, positionEdges increasing bin edges of the incident energy [GeV], angle
+  /// [rad] and position coordinate; an empty list of edges is one bin of any value
+  ShowerLibrary(std::vector<float> energyEdges, std::vector<float> angleEdges, std::vector<float> positionEdges = {});
+
+  /// bin of an incident track, -1 outside the library
+  int getBin(float energy, float angle, float position) const;
+
+  /// add a shower of an incident track
+  void addShower(float energy, float angle, float position, Shower shower);
+
+  /// \return a shower of the bin of the incident track, chosen by the uniform random number in [0, 1),
+  /// nullptr if the bin is empty or outside the library
+  Shower const* getShower(float energy, float angle, float position, float random) const;
+
+  size_t getNShowers() const;
+
+  /// global position of a spot of a track entering at entry with the unit direction dir
+  static void toGlobal(Spot const& spot, const double entry[3], const double dir[3], double global[3]);
+  /// spot of a global position, inverse of toGlobal
+  static Spot toSpot(const double global[3], const double entry[3], const double dir[3]);
+
+  /// library stored as "ShowerLibrary" in a ROOT file, nullptr if there is none
+  static ShowerLibrary* loadFromFile(std::string const& filename);
+  void writeToFile(std::string const& filename) const;
+
+ private:
+  static int findBin(std::vector<float> const& edges, float value);
+  int getNBins(std::vector<float> const& edges) const { return edges.empty() ? 1 : int(edges.size()) - 1; }
+
+  std::vector<float> mEnergyEdges;
+  std::vector<float> mAngleEdges;
+  std::vector<float> mPositionEdges;
+  std::vector<std::vector<Shower>> mShowers; ///< showers per bin, the position bin running fastest
+
+  ClassDefNV(ShowerLibrary, 1);
+};
+
+} // namespace base
+} // namespace o2
+
+#endif
@@ -17,6 +17,8 @@
 #include "DetectorsCommonDataFormats/DetID.h"
 #include "Field/MagneticField.h"
 #include "TString.h" // for TString
+#include <algorithm>
+#include <cmath>
 
 using std::cout;
 using std::endl;
@@ -28,6 +30,8 @@ using namespace o2::base;
 using namespace o2::detectors;
 
 Float_t Detector::mDensityFactor = 1.0;
+bool Detector::mCompactHits = false;
+o2::utils::CompactHitPrecision Detector::mCompactHitPrecision;
 
 Detector::Detector() : FairDetector(), mMapMaterial(), mMapMedium() {}
 Detector::Detector(const char* name, Bool_t Active)
@@ -146,6 +150,14 @@ void Detector::addAlignableVolumes() const
   LOG(WARNING) << "Alignable volumes are not yet defined for " << GetName() << FairLogger::endl;
 }
 
+void Detector::getShowerLibraryCoordinates(const double dir[3], float& angle, float& position) const
+{
+  double local[3];
+  TVirtualMC::GetMC()->Gmtod(const_cast<double*>(dir), local, 2);
+  angle = std::acos(std::min(std::abs(local[2]), 1.));
+  position = 0.;
+}
+
 #include <FairMQMessage.h>
 #include <FairMQParts.h>
 #include <FairMQChannel.h>
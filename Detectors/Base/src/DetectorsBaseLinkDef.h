@@ -20,5 +20,9 @@
 #pragma link C++ class o2::base::GeometryManager + ;
 #pragma link C++ class o2::base::GeometryManager::MatBudget + ;
 #pragma link C++ class o2::base::MaterialManager + ;
+#pragma link C++ class o2::base::ShowerLibrary + ;
+#pragma link C++ class o2::base::ShowerLibrary::Spot + ;
+#pragma link C++ class std::vector<o2::base::ShowerLibrary::Spot> + ;
+#pragma link C++ class std::vector<std::vector<o2::base::ShowerLibrary::Spot>> + ;
 
 #endif
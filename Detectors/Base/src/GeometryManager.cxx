@@ -19,6 +19,7 @@
 #include <TGeoPhysicalNode.h> // for TGeoPhysicalNode, TGeoPNEntry
 #include <TObjArray.h>        // for TObjArray
 #include <TObject.h>          // for TObject
+#include <TParameter.h>       // for TParameter
 
 #include <cassert>
 #include <cstddef> // for NULL
@@ -362,12 +363,46 @@ GeometryManager::MatBudget GeometryManager::MeanMaterialBudget(float x0, float y
 void GeometryManager::loadGeometry(std::string geomFileName, std::string geomName)
 {
   ///< load geometry from file
+  static TGeoManager* loadedGeometry = nullptr;
+  static std::string loadedGeometryKey;
+  const std::string key = geomFileName + ":" + geomName;
+  if (gGeoManager && gGeoManager == loadedGeometry && key == loadedGeometryKey) {
+    LOG(INFO) << "Geometry " << geomName << " from " << geomFileName << " is already loaded" << FairLogger::endl;
+    return;
+  }
   LOG(INFO) << "Loading geometry " << geomName << " from " << geomFileName << FairLogger::endl;
   TFile flGeom(geomFileName.data());
   if (flGeom.IsZombie()) {
     LOG(FATAL) << "Failed to open file " << geomFileName << FairLogger::endl;
   }
+  // files written by writeGeometry carry a version, older ones are accepted as they are
+  if (auto version = dynamic_cast<TParameter<int>*>(flGeom.Get("O2GeometryFileVersion"))) {
+    if (version->GetVal() > GeometryFileVersion) {
+      LOG(FATAL) << "Geometry file version " << version->GetVal() << " is not supported (max. " << GeometryFileVersion
+                 << ")" << FairLogger::endl;
+    }
+  }
   if (!flGeom.Get(geomName.data())) {
     LOG(FATAL) << "Did not find geometry named " << geomName << FairLogger::endl;
   }
+  loadedGeometry = gGeoManager;
+  loadedGeometryKey = key;
+}
+
+//_________________________________
+void GeometryManager::writeGeometry(std::string geomFileName, std::string geomName)
+{
+  ///< write geometry to file
+  if (!gGeoManager || !gGeoManager->IsClosed()) {
+    LOG(FATAL) << "No active geometry or geometry not yet closed!" << FairLogger::endl;
+  }
+  // the "v" option streams the voxels, which are otherwise rebuilt at each load
+  if (gGeoManager->Export(geomFileName.data(), geomName.data(), "v") <= 0) {
+    LOG(FATAL) << "Failed to write geometry to " << geomFileName << FairLogger::endl;
+  }
+  TFile flGeom(geomFileName.data(), "UPDATE");
+  TParameter<int> version("O2GeometryFileVersion", GeometryFileVersion);
+  version.Write();
+  LOG(INFO) << "Wrote geometry " << geomName << " version " << GeometryFileVersion << " to " << geomFileName
+            << FairLogger::endl;
 }
@@ -0,0 +1,169 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MatBudgetLUT.cxx
+/// \brief Implementation of a lookup table of the material budget in cylindrical voxels
+
+#include "DetectorsBase/MatBudgetLUT.h"
+#include <FairLogger.h>
+#include <cstring>
+#include <fstream>
+
+using namespace o2::base;
+
+//_______________________________________________________________________
+MatBudgetLUT::MatBudgetLUT(int nR, int nPhi, int nZ, float rMin, float rMax, float zMax)
+{
+  // c-tor of the owning table
+  if (nR < 1 || nPhi < 1 || nZ < 1 || rMin < 0.f || rMax <= rMin || zMax <= 0.f) {
+    LOG(FATAL) << "Invalid material LUT grid " << nR << ':' << nPhi << ':' << nZ << " in R = [" << rMin << ':' << rMax
+               << "], |Z| < " << zMax << FairLogger::endl;
+  }
+  Header header;
+  header.nR = nR;
+  header.nPhi = nPhi;
+  header.nZ = nZ;
+  header.rMin = rMin;
+  header.rMax = rMax;
+  header.zMax = zMax;
+  allocate(header);
+}
+
+//_______________________________________________________________________
+MatBudgetLUT::MatBudgetLUT(gsl::span<const char> buffer, bool copy)
+{
+  // c-tor from the flat buffer
+  Header header;
+  if (buffer.size() < sizeof(Header)) {
+    LOG(FATAL) << "Material LUT buffer of " << buffer.size() << " bytes is too small for the header" << FairLogger::endl;
+  }
+  std::memcpy(&header, buffer.data(), sizeof(Header));
+  if (header.magic != Magic || header.version != 1 || header.sizeofHeader != sizeof(Header)) {
+    LOG(FATAL) << "Unknown material LUT buffer format" << FairLogger::endl;
+  }
+  const size_t nVoxels = size_t(header.nR) * header.nPhi * header.nZ;
+  if (!nVoxels || buffer.size() != sizeof(Header) + NComponents * nVoxels * sizeof(float)) {
+    LOG(FATAL) << "Material LUT buffer size " << buffer.size() << " does not match the grid definition"
+               << FairLogger::endl;
+  }
+  if (copy) {
+    allocate(header);
+    std::memcpy(mOwnedBuffer.data(), buffer.data(), buffer.size());
+    return;
+  }
+  if (reinterpret_cast<uintptr_t>(buffer.data()) % alignof(float) != 0) {
+    LOG(FATAL) << "Material LUT buffer is not aligned" << FairLogger::endl;
+  }
+  mHeader = reinterpret_cast<const Header*>(buffer.data());
+  setupPointers();
+}
+
+//_______________________________________________________________________
+void MatBudgetLUT::allocate(const Header& header)
+{
+  // allocate the owned buffer and write the header
+  const size_t nVoxels = size_t(header.nR) * header.nPhi * header.nZ;
+  mOwnedBuffer.assign(sizeof(Header) + NComponents * nVoxels * sizeof(float), 0);
+  std::memcpy(mOwnedBuffer.data(), &header, sizeof(Header));
+  mHeader = reinterpret_cast<const Header*>(mOwnedBuffer.data());
+  setupPointers();
+}
+
+//_______________________________________________________________________
+void MatBudgetLUT::setupPointers()
+{
+  // set the data pointers and the derived grid parameters
+  mNVoxels = size_t(mHeader->nR) * mHeader->nPhi * mHeader->nZ;
+  mRho = reinterpret_cast<const float*>(reinterpret_cast<const char*>(mHeader) + sizeof(Header));
+  mInvX0 = mRho + mNVoxels;
+  mInvDeltaR = mHeader->nR / (mHeader->rMax - mHeader->rMin);
+  mInvDeltaPhi = mHeader->nPhi / 6.28318530717958647692f;
+  mInvDeltaZ = mHeader->nZ / (2.f * mHeader->zMax);
+  mMaxStep = 0.5f / std::max(mInvDeltaR, mInvDeltaZ);
+}
+
+//_______________________________________________________________________
+void MatBudgetLUT::setVoxel(int ir, int iphi, int iz, float rho, float invX0)
+{
+  // set the material of a voxel
+  if (mOwnedBuffer.empty()) {
+    LOG(FATAL) << "Cannot modify a material LUT which does not own its buffer" << FairLogger::endl;
+  }
+  const size_t i = index(ir, iphi, iz);
+  const_cast<float*>(mRho)[i] = rho;
+  const_cast<float*>(mInvX0)[i] = invX0;
+}
+
+//_______________________________________________________________________
+void MatBudgetLUT::fillFromGeometry(int nSamples)
+{
+  // average the material of each voxel over radial segments crossing it
+  if (!gGeoManager) {
+    LOG(FATAL) << "No active geometry!" << FairLogger::endl;
+  }
+  nSamples = std::max(nSamples, 1);
+  const float deltaR = 1.f / mInvDeltaR, deltaPhi = 1.f / mInvDeltaPhi, deltaZ = 1.f / mInvDeltaZ;
+  for (int iz = 0; iz < int(mHeader->nZ); iz++) {
+    for (int iphi = 0; iphi < int(mHeader->nPhi); iphi++) {
+      for (int ir = 0; ir < int(mHeader->nR); ir++) {
+        const float r0 = mHeader->rMin + ir * deltaR, r1 = r0 + deltaR;
+        double sumLength = 0., sumRhoL = 0., sumX2X0 = 0.;
+        for (int isp = 0; isp < nSamples; isp++) {
+          const float phi = (iphi + (isp + 0.5f) / nSamples) * deltaPhi;
+          const float cs = std::cos(phi), sn = std::sin(phi);
+          for (int isz = 0; isz < nSamples; isz++) {
+            const float z = -mHeader->zMax + (iz + (isz + 0.5f) / nSamples) * deltaZ;
+            auto mb = GeometryManager::MeanMaterialBudget(r0 * cs, r0 * sn, z, r1 * cs, r1 * sn, z);
+            if (mb.length <= 0.) {
+              continue; // out of geometry
+            }
+            sumLength += mb.length;
+            sumRhoL += mb.meanRho * mb.length;
+            sumX2X0 += mb.meanX2X0;
+          }
+        }
+        if (sumLength > 0.) {
+          setVoxel(ir, iphi, iz, sumRhoL / sumLength, sumX2X0 / sumLength);
+        }
+      }
+    }
+  }
+  LOG(INFO) << "Filled material LUT of " << mHeader->nR << " x " << mHeader->nPhi << " x " << mHeader->nZ
+            << " voxels in R = [" << mHeader->rMin << ':' << mHeader->rMax << "], |Z| < " << mHeader->zMax
+            << FairLogger::endl;
+}
+
+//_______________________________________________________________________
+void MatBudgetLUT::writeToFile(const std::string& fileName) const
+{
+  // write the flat buffer to a binary file
+  std::ofstream file(fileName, std::ios::binary);
+  const auto buffer = getBuffer();
+  if (!file.write(buffer.data(), buffer.size())) {
+    LOG(FATAL) << "Failed to write material LUT to " << fileName << FairLogger::endl;
+  }
+}
+
+//_______________________________________________________________________
+MatBudgetLUT MatBudgetLUT::readFromFile(const std::string& fileName)
+{
+  // read a table from a binary file
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if (!file) {
+    LOG(FATAL) << "Failed to open material LUT file " << fileName << FairLogger::endl;
+  }
+  std::vector<char> buffer(file.tellg());
+  file.seekg(0);
+  if (!file.read(buffer.data(), buffer.size())) {
+    LOG(FATAL) << "Failed to read material LUT from " << fileName << FairLogger::endl;
+  }
+  LOG(INFO) << "Loaded material LUT from " << fileName << FairLogger::endl;
+  return MatBudgetLUT(gsl::span<const char>(buffer.data(), buffer.size()), true);
+}
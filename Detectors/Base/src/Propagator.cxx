@@ -11,12 +11,15 @@
 #include "DetectorsBase/Propagator.h"
 #include <FairLogger.h>
 #include <FairRunAna.h> // eventually will get rid of it
+#include <TGeoManager.h>
 #include <TGeoGlobalMagField.h>
 #include "DataFormatsParameters/GRPObject.h"
 #include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/MatBudgetLUT.h"
 #include "Field/MagFieldFast.h"
 #include "Field/MagneticField.h"
 #include "MathUtils/Utils.h"
+#include <algorithm>
 
 using namespace o2::base;
 
@@ -80,25 +83,9 @@ bool Propagator::PropagateToXBxByBz(o2::track::TrackParCov& track, float xToGo,
     if (!track.propagateTo(x, b)) {
       return false;
     }
-    if (maxSnp > 0 && std::abs(track.getSnp()) >= maxSnp) {
+    if (!finalizeStep(track, xyz0, mass, maxSnp, matCorr, tofInfo, signCorr)) {
       return false;
     }
-    if (matCorr) {
-      auto xyz1 = track.getXYZGlo();
-      auto mb = GeometryManager::MeanMaterialBudget(xyz0, xyz1);
-      if (!track.correctForMaterial(mb.meanX2X0, ((signCorr < 0) ? -mb.length : mb.length) * mb.meanRho, mass)) {
-        return false;
-      }
-
-      if (tofInfo) {
-        tofInfo->addStep(mb.length, track); // fill L,ToF info using already calculated step length
-        tofInfo->addX2X0(mb.meanX2X0);
-      }
-    } else if (tofInfo) { // if tofInfo filling was requested w/o material correction, we need to calculate the step lenght
-      auto xyz1 = track.getXYZGlo();
-      Vector3D<float> stepV(xyz1.X() - xyz0.X(), xyz1.Y() - xyz0.Y(), xyz1.Z() - xyz0.Z());
-      tofInfo->addStep(stepV.R(), track);
-    }
     dx = xToGo - track.getX();
   }
   return true;
@@ -136,27 +123,136 @@ bool Propagator::propagateToX(o2::track::TrackParCov& track, float xToGo, float
     if (!track.propagateTo(x, bZ)) {
       return false;
     }
-    if (maxSnp > 0 && std::abs(track.getSnp()) >= maxSnp) {
+    if (!finalizeStep(track, xyz0, mass, maxSnp, matCorr, tofInfo, signCorr)) {
       return false;
     }
-    if (matCorr) {
-      auto xyz1 = track.getXYZGlo();
-      auto mb = GeometryManager::MeanMaterialBudget(xyz0, xyz1);
-      //
-      if (!track.correctForMaterial(mb.meanX2X0, ((signCorr < 0) ? -mb.length : mb.length) * mb.meanRho, mass)) {
-        return false;
-      }
+    dx = xToGo - track.getX();
+  }
+  return true;
+}
 
-      if (tofInfo) {
-        tofInfo->addStep(mb.length, track); // fill L,ToF info using already calculated step length
-        tofInfo->addX2X0(mb.meanX2X0);
+//_______________________________________________________________________
+int Propagator::PropagateToXBxByBz(gsl::span<o2::track::TrackParCov> tracks, float xToGo, std::vector<char>& status,
+                                   float mass, float maxSnp, float maxStep, int matCorr,
+                                   gsl::span<o2::track::TrackLTIntegral> tofInfo, int signCorr)
+{
+  //----------------------------------------------------------------
+  //
+  // Propagates the tracks to the plane X=xk (cm) as the single track version,
+  // but making the steps of all tracks together: the start points of the
+  // step of all tracks still propagating are collected in separate coordinate
+  // arrays and the field is evaluated in one call for all of them.
+  // The steps of each track are identical to those of the single track version.
+  //----------------------------------------------------------------
+  const float Epsilon = 0.00001;
+  const int nTracks = tracks.size();
+  if (!tofInfo.empty() && int(tofInfo.size()) != nTracks) {
+    LOG(FATAL) << "Number of LT integrals " << tofInfo.size() << " differs from number of tracks " << nTracks
+               << FairLogger::endl;
+  }
+  status.assign(nTracks, 1);
+  auto& context = getThreadContext();
+  auto& active = context.active;
+  auto& dirs = context.dirs;
+  auto& signCorrs = context.signCorrs;
+  active.resize(nTracks);
+  dirs.resize(nTracks);
+  signCorrs.resize(nTracks);
+  context.buffer.resize(6 * nTracks);
+  float *xg = context.buffer.data(), *yg = xg + nTracks, *zg = yg + nTracks;
+  float *bx = zg + nTracks, *by = bx + nTracks, *bz = by + nTracks;
+
+  int nActive = 0;
+  for (int it = 0; it < nTracks; it++) {
+    auto dx = xToGo - tracks[it].getX();
+    dirs[it] = dx > 0.f ? 1 : -1;
+    signCorrs[it] = signCorr ? signCorr : -dirs[it]; // sign of eloss correction is not imposed
+    if (std::abs(dx) > Epsilon) {
+      active[nActive++] = it;
+    }
+  }
+
+  while (nActive) {
+    for (int ia = 0; ia < nActive; ia++) {
+      auto xyz0 = tracks[active[ia]].getXYZGlo();
+      xg[ia] = xyz0.X();
+      yg[ia] = xyz0.Y();
+      zg[ia] = xyz0.Z();
+      bx[ia] = by[ia] = bz[ia] = 0.f; // no field outside of the parametrization
+    }
+    mField->Field(nActive, xg, yg, zg, bx, by, bz);
+    int nLeft = 0;
+    for (int ia = 0; ia < nActive; ia++) {
+      int it = active[ia];
+      auto& track = tracks[it];
+      auto step = std::min(std::abs(xToGo - track.getX()), maxStep);
+      if (dirs[it] < 0) {
+        step = -step;
+      }
+      const std::array<float, 3> b = { bx[ia], by[ia], bz[ia] };
+      if (!track.propagateTo(track.getX() + step, b) ||
+          !finalizeStep(track, Point3D<float>(xg[ia], yg[ia], zg[ia]), mass, maxSnp, matCorr,
+                        tofInfo.empty() ? nullptr : &tofInfo[it], signCorrs[it])) {
+        status[it] = 0;
+        continue;
+      }
+      if (std::abs(xToGo - track.getX()) > Epsilon) {
+        active[nLeft++] = it;
       }
-    } else if (tofInfo) { // if tofInfo filling was requested w/o material correction, we need to calculate the step lenght
-      auto xyz1 = track.getXYZGlo();
-      Vector3D<float> stepV(xyz1.X() - xyz0.X(), xyz1.Y() - xyz0.Y(), xyz1.Z() - xyz0.Z());
-      tofInfo->addStep(stepV.R(), track);
     }
-    dx = xToGo - track.getX();
+    nActive = nLeft;
+  }
+  return std::count(status.begin(), status.end(), 1);
+}
+
+//_______________________________________________________________________
+int Propagator::propagateToX(gsl::span<o2::track::TrackParCov> tracks, float xToGo, float bZ, std::vector<char>& status,
+                             float mass, float maxSnp, float maxStep, int matCorr,
+                             gsl::span<o2::track::TrackLTIntegral> tofInfo, int signCorr)
+{
+  // propagate tracks to the plane X=xk (cm) in constant Bz, nothing to share between the tracks
+  const int nTracks = tracks.size();
+  if (!tofInfo.empty() && int(tofInfo.size()) != nTracks) {
+    LOG(FATAL) << "Number of LT integrals " << tofInfo.size() << " differs from number of tracks " << nTracks
+               << FairLogger::endl;
+  }
+  status.resize(nTracks);
+  int nOK = 0;
+  for (int it = 0; it < nTracks; it++) {
+    status[it] = propagateToX(tracks[it], xToGo, bZ, mass, maxSnp, maxStep, matCorr,
+                              tofInfo.empty() ? nullptr : &tofInfo[it], signCorr);
+    nOK += status[it];
+  }
+  return nOK;
+}
+
+//_______________________________________________________________________
+bool Propagator::finalizeStep(o2::track::TrackParCov& track, const Point3D<float>& xyz0, float mass, float maxSnp,
+                              int matCorr, o2::track::TrackLTIntegral* tofInfo, int signCorr) const
+{
+  // check the track after the step from xyz0, correct for the crossed material and fill the LT integral
+  if (maxSnp > 0 && std::abs(track.getSnp()) >= maxSnp) {
+    return false;
+  }
+  if (matCorr) {
+    if (!mMatLUT) {
+      getThreadContext(); // make sure the thread has its own navigator
+    }
+    auto xyz1 = track.getXYZGlo();
+    auto mb = mMatLUT ? mMatLUT->getMatBudget(xyz0, xyz1) : GeometryManager::MeanMaterialBudget(xyz0, xyz1);
+    float xrho = ((signCorr < 0) ? -mb.length : mb.length) * mb.meanRho;
+    if (!track.correctForMaterial<o2::track::BetheBlochTabulated>(mb.meanX2X0, xrho, mass)) {
+      return false;
+    }
+
+    if (tofInfo) {
+      tofInfo->addStep(mb.length, track); // fill L,ToF info using already calculated step length
+      tofInfo->addX2X0(mb.meanX2X0);
+    }
+  } else if (tofInfo) { // if tofInfo filling was requested w/o material correction, we need to calculate the step lenght
+    auto xyz1 = track.getXYZGlo();
+    Vector3D<float> stepV(xyz1.X() - xyz0.X(), xyz1.Y() - xyz0.Y(), xyz1.Z() - xyz0.Z());
+    tofInfo->addStep(stepV.R(), track);
   }
   return true;
 }
@@ -200,6 +296,38 @@ bool Propagator::propagateToDCA(const Point3D<float>& vtx, o2::track::TrackParCo
   return true;
 }
 
+//____________________________________________________________
+void Propagator::setMaxThreads(int nThreads)
+{
+  /// enable the multi-threaded navigation of the geometry
+  if (nThreads > 1 && gGeoManager && gGeoManager->GetMaxThreads() < nThreads) {
+    gGeoManager->SetMaxThreads(nThreads); // keeps the navigator of the calling thread
+  }
+}
+
+//____________________________________________________________
+Propagator::ThreadContext& Propagator::getThreadContext()
+{
+  /// get the context of the calling thread, adding a navigator for threads which do not have one yet
+  thread_local ThreadContext context;
+  if (!context.navigator && gGeoManager) {
+    context.navigator = gGeoManager->GetCurrentNavigator();
+    if (!context.navigator && gGeoManager->IsMultiThread()) {
+      context.navigator = gGeoManager->AddNavigator();
+      context.ownNavigator = true;
+    }
+  }
+  return context;
+}
+
+//____________________________________________________________
+Propagator::ThreadContext::~ThreadContext()
+{
+  if (ownNavigator && gGeoManager) {
+    gGeoManager->RemoveNavigator(navigator);
+  }
+}
+
 //____________________________________________________________
 int Propagator::initFieldFromGRP(const std::string grpFileName, std::string grpName)
 {
@@ -0,0 +1,147 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ShowerLibrary.cxx
+/// \brief Library of frozen showers for the fast simulation of the calorimeters
+
+#include "DetectorsBase/ShowerLibrary.h"
+#include <FairLogger.h>
+#include <TFile.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+using namespace o2::base;
+
+ClassImp(o2::base::ShowerLibrary);
+
+namespace
+{
+// two unit vectors orthogonal to the unit direction dir and to each other
+void getTransverse(const double dir[3], double e1[3], double e2[3])
+{
+  // cross product with the axis least aligned with the direction
+  const double ax = std::abs(dir[0]), ay = std::abs(dir[1]), az = std::abs(dir[2]);
+  double a[3] = { 0., 0., 0. };
+  a[ax <= ay && ax <= az ? 0 : (ay <= az ? 1 : 2)] = 1.;
+  e1[0] = dir[1] * a[2] - dir[2] * a[1];
+  e1[1] = dir[2] * a[0] - dir[0] * a[2];
+  e1[2] = dir[0] * a[1] - dir[1] * a[0];
+  const double norm = std::sqrt(e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2]);
+  for (int i = 0; i < 3; i++) {
+    e1[i] /= norm;
+  }
+  e2[0] = dir[1] * e1[2] - dir[2] * e1[1];
+  e2[1] = dir[2] * e1[0] - dir[0] * e1[2];
+  e2[2] = dir[0] * e1[1] - dir[1] * e1[0];
+}
+} // namespace
+
+ShowerLibrary::ShowerLibrary(std::vector<float> energyEdges, std::vector<float> angleEdges, std::vector<float> positionEdges)
+  : mEnergyEdges(std::move(energyEdges)), mAngleEdges(std::move(angleEdges)), mPositionEdges(std::move(positionEdges))
+{
+  mShowers.resize(getNBins(mEnergyEdges) * getNBins(mAngleEdges) * getNBins(mPositionEdges));
+}
+
+int ShowerLibrary::findBin(std::vector<float> const& edges, float value)
+{
+  if (edges.empty()) {
+    return 0;
+  }
+  if (!(value >= edges.front() && value < edges.back())) {
+    return -1;
+  }
+  return std::upper_bound(edges.begin(), edges.end(), value) - edges.begin() - 1;
+}
+
+int ShowerLibrary::getBin(float energy, float angle, float position) const
+{
+  const int ie = findBin(mEnergyEdges, energy), ia = findBin(mAngleEdges, angle), ip = findBin(mPositionEdges, position);
+  if (ie < 0 || ia < 0 || ip < 0 || mShowers.empty()) {
+    return -1;
+  }
+  return (ie * getNBins(mAngleEdges) + ia) * getNBins(mPositionEdges) + ip;
+}
+
+void ShowerLibrary::addShower(float energy, float angle, float position, Shower shower)
+{
+  const int bin = getBin(energy, angle, position);
+  if (bin >= 0) {
+    mShowers[bin].emplace_back(std::move(shower));
+  }
+}
+
+ShowerLibrary::Shower const* ShowerLibrary::getShower(float energy, float angle, float position, float random) const
+{
+  const int bin = getBin(energy, angle, position);
+  if (bin < 0 || mShowers[bin].empty()) {
+    return nullptr;
+  }
+  auto& showers = mShowers[bin];
+  return &showers[std::min(size_t(random * showers.size()), showers.size() - 1)];
+}
+
+size_t ShowerLibrary::getNShowers() const
+{
+  size_t n = 0;
+  for (auto& showers : mShowers) {
+    n += showers.size();
+  }
+  return n;
+}
+
+void ShowerLibrary::toGlobal(Spot const& spot, const double entry[3], const double dir[3], double global[3])
+{
+  double e1[3], e2[3];
+  getTransverse(dir, e1, e2);
+  for (int i = 0; i < 3; i++) {
+    global[i] = entry[i] + spot.along * dir[i] + spot.u * e1[i] + spot.v * e2[i];
+  }
+}
+
+ShowerLibrary::Spot ShowerLibrary::toSpot(const double global[3], const double entry[3], const double dir[3])
+{
+  double e1[3], e2[3];
+  getTransverse(dir, e1, e2);
+  Spot spot;
+  for (int i = 0; i < 3; i++) {
+    const double d = global[i] - entry[i];
+    spot.along += d * dir[i];
+    spot.u += d * e1[i];
+    spot.v += d * e2[i];
+  }
+  return spot;
+}
+
+ShowerLibrary* ShowerLibrary::loadFromFile(std::string const& filename)
+{
+  std::unique_ptr<TFile> file(TFile::Open(filename.c_str()));
+  if (!file || file->IsZombie()) {
+    LOG(ERROR) << "Cannot open shower library file " << filename;
+    return nullptr;
+  }
+  ShowerLibrary* library = nullptr;
+  file->GetObject("ShowerLibrary", library);
+  if (!library) {
+    LOG(ERROR) << "No ShowerLibrary in " << filename;
+  }
+  return library;
+}
+
+void ShowerLibrary::writeToFile(std::string const& filename) const
+{
+  std::unique_ptr<TFile> file(TFile::Open(filename.c_str(), "RECREATE"));
+  if (!file || file->IsZombie()) {
+    LOG(ERROR) << "Cannot create shower library file " << filename;
+    return;
+  }
+  file->WriteObjectAny(this, "o2::base::ShowerLibrary", "ShowerLibrary");
+  file->Close();
+}
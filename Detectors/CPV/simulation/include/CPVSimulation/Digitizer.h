@@ -14,6 +14,7 @@
 #include "CPVBase/Digit.h"
 #include "CPVBase/Geometry.h"
 #include "CPVBase/Hit.h"
+#include "DetectorsBase/CellAccumulator.h"
 
 namespace o2
 {
@@ -66,6 +67,8 @@ class Digitizer : public TObject
   double mNoise = 0.005;               ///< Electronics (and APD) noise (in GeV)
   double mCoeffToNanoSecond = 1.e+9;   ///< Conversion for time units
 
+  o2::base::CellAccumulator<Digit> mDigits; //! digits of each pad
+
   ClassDefOverride(Digitizer, 1);
 };
 } // namespace cpv
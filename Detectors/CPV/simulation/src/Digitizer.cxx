@@ -22,7 +22,11 @@ using o2::cpv::Hit;
 using namespace o2::cpv;
 
 //_______________________________________________________________________
-void Digitizer::init() { mGeometry = Geometry::GetInstance(); }
+void Digitizer::init()
+{
+  mGeometry = Geometry::GetInstance();
+  mDigits.setNCells(mGeometry->GetTotalNPads() + 1); // absId starts at 1
+}
 
 //_______________________________________________________________________
 void Digitizer::finish() {}
@@ -38,51 +42,33 @@ void Digitizer::process(const std::vector<Hit>& hits, std::vector<Digit>& digits
   // Sort Hits: moved to Detector::FinishEvent
   // Add duplicates if any and remove them
 
-  Int_t hitIndex = 0;
-  Int_t hitAbsId = 0;
-  Int_t nHits = hits.size();
-  Hit hit;
-  if (hitIndex < nHits) {
-    hit = hits.at(hitIndex);
-    hitAbsId = hit.GetDetectorID();
+  // The hits are accumulated per pad and time window, they do not need to be sorted
+  mDigits.clear();
+  for (const auto& hit : hits) {
+    if (!mGeometry->IsPadExists(hit.GetDetectorID())) {
+      LOG(WARNING) << "pad index out of range: " << hit.GetDetectorID() << FairLogger::endl;
+      continue;
+    }
+    mDigits.add(hit.GetDetectorID(), Digit(hit));
   }
 
   Int_t nTotPads = mGeometry->GetTotalNPads();
-  for (Int_t absId = 1; absId < nTotPads; absId++) {
+  for (Int_t absId = 1; absId <= nTotPads; absId++) {
 
     // If signal exist in this pad, add noise to it, otherwise just create noise digit
-    if (absId == hitAbsId) {
-      Digit digit(hit);
-      hitIndex++;
-      if (hitIndex < nHits) {
-        Digit digitNext(hits.at(hitIndex));
-        while ((hitIndex < nHits) && digit.canAdd(digitNext)) {
-          digit += digitNext;
-          hitIndex++;
-          if (hitIndex < nHits) {
-            digitNext.FillFromHit(hits.at(hitIndex));
-          }
-        }
-        if (hitIndex < nHits) {
-          hitAbsId = digitNext.getAbsId();
-        } else {
-          hitAbsId = 0;
-        }
-        hit = hits.at(hitIndex);
-      } else {
-        hitAbsId = 99999; // out of CPV
-      }
-
-      // Add Electroinc noise, apply non-linearity, digitize, de-calibrate, time resolution
-      Double_t ampl = digit.getAmplitude();
-      // Simulate electronic noise
-      ampl += SimulateNoise();
+    if (mDigits.isTouched(absId)) {
+      for (auto& digit : mDigits.getDigits(absId)) {
+        // Add Electroinc noise, apply non-linearity, digitize, de-calibrate, time resolution
+        Double_t ampl = digit.getAmplitude();
+        // Simulate electronic noise
+        ampl += SimulateNoise();
 
-      if (mApplyDigitization) {
-        ampl = DigitizeAmpl(ampl);
+        if (mApplyDigitization) {
+          ampl = DigitizeAmpl(ampl);
+        }
+        digit.setAmplitude(ampl);
+        digits.push_back(digit);
       }
-      digit.setAmplitude(ampl);
-      digits.push_back(digit);
     } else { // No signal in this pad,
       if (!mGeometry->IsPadExists(absId)) {
         continue;
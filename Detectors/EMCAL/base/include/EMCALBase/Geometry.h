@@ -25,6 +25,7 @@
 #include "EMCALBase/Constants.h"
 #include "EMCALBase/GeometryBase.h"
 #include "MathUtils/Cartesian3D.h"
+#include "MathUtils/NearestCenterLookup.h"
 
 namespace o2
 {
@@ -644,6 +645,13 @@ class Geometry
 
   Float_t mSteelFrontThick; ///< Thickness of the front stell face of the support box - 9-sep-04; obsolete?
 
+  // Lookup tables, filled by CreateListOfTrd1Modules
+  std::vector<Point3D<double>> mCellPositionsInSModule; ///< Position of the cells in their SM, by absolute ID number
+  std::vector<o2::math_utils::NearestCenterLookup<Double_t>>
+    mPhiCentersLookup; ///< Nearest of mPhiCentersOfCells in full, 1/2 and 1/3 SMs
+  std::vector<o2::math_utils::NearestCenterLookup<Double_t>>
+    mEtaCentersLookup; ///< Nearest of mEtaCentersOfCells for each phi index, from the first cell and beyond the DCAL gap
+
   mutable const TGeoHMatrix* SMODULEMATRIX[EMCAL_MODULES]; ///< Orientations of EMCAL super modules
 
  private:
@@ -83,7 +83,10 @@ Geometry::Geometry(const Geometry& geo)
     mTrd1BondPaperThick(geo.mTrd1BondPaperThick),
     mILOSS(geo.mILOSS),
     mIHADR(geo.mIHADR),
-    mSteelFrontThick(geo.mSteelFrontThick) // obsolete data member?
+    mSteelFrontThick(geo.mSteelFrontThick), // obsolete data member?
+    mCellPositionsInSModule(geo.mCellPositionsInSModule),
+    mPhiCentersLookup(geo.mPhiCentersLookup),
+    mEtaCentersLookup(geo.mEtaCentersLookup)
 {
   memcpy(mEnvelop, geo.mEnvelop, sizeof(Float_t) * 3);
   memcpy(mParSM, geo.mParSM, sizeof(Float_t) * 3);
@@ -792,52 +795,29 @@ Int_t Geometry::GetAbsCellIdFromEtaPhi(Double_t eta, Double_t phi) const
 {
   Int_t nSupMod = SuperModuleNumberFromEtaPhi(eta, phi);
 
-  // phi index first
+  // phi index first, the nearest cell center among the cells of the SM
   phi = TVector2::Phi_0_2pi(phi);
   Double_t phiLoc = phi - mPhiCentersOfSMSec[nSupMod / 2];
-  Int_t nphi = mPhiCentersOfCells.size();
+  Int_t phiLookup = 0;
   if (GetSMType(nSupMod) == EMCAL_HALF)
-    nphi /= 2;
-  else if (GetSMType(nSupMod) == EMCAL_THIRD)
-    nphi /= 3;
-  else if (GetSMType(nSupMod) == DCAL_EXT)
-    nphi /= 3;
-
-  Double_t dmin = TMath::Abs(mPhiCentersOfCells[0] - phiLoc),
-           d = 0.;
-  Int_t iphi = 0;
-  for (Int_t i = 1; i < nphi; i++) {
-    d = TMath::Abs(mPhiCentersOfCells[i] - phiLoc);
-    if (d < dmin) {
-      dmin = d;
-      iphi = i;
-    }
-    // printf(" i %i : d %f : dmin %f : fPhiCentersOfCells[i] %f \n", i, d, dmin, fPhiCentersOfCells[i]);
-  }
+    phiLookup = 1;
+  else if (GetSMType(nSupMod) == EMCAL_THIRD || GetSMType(nSupMod) == DCAL_EXT)
+    phiLookup = 2;
+  Int_t iphi = mPhiCentersLookup[phiLookup].find(phiLoc);
   // odd SM are turned with respect of even SM - reverse indexes
-  LOG(DEBUG2) << " iphi " << iphi << " : dmin " << dmin << " (phi " << phi << ", phiLoc " << phiLoc << ")\n";
+  LOG(DEBUG2) << " iphi " << iphi << " : dmin " << TMath::Abs(mPhiCentersOfCells[iphi] - phiLoc) << " (phi " << phi
+              << ", phiLoc " << phiLoc << ")\n";
 
   // eta index
   Double_t absEta = TMath::Abs(eta);
-  Int_t neta = mCentersOfCellsEtaDir.size(),
-        etaShift = iphi * neta,
-        ieta = 0;
-  if (GetSMType(nSupMod) == DCAL_STANDARD)
-    ieta += 16; // jump 16 cells for DCSM
-  dmin = TMath::Abs(mEtaCentersOfCells[etaShift + ieta] - absEta);
-  for (Int_t i = ieta + 1; i < neta; i++) {
-    d = TMath::Abs(mEtaCentersOfCells[i + etaShift] - absEta);
-    if (d < dmin) {
-      dmin = d;
-      ieta = i;
-    }
-  }
-
+  Int_t neta = mCentersOfCellsEtaDir.size();
+  Int_t ieta = 0;
   if (GetSMType(nSupMod) == DCAL_STANDARD)
-    ieta -= 16; // jump 16 cells for DCSM
+    ieta = mEtaCentersLookup[2 * iphi + 1].find(absEta); // cells after the 16 first for DCSM
+  else
+    ieta = mEtaCentersLookup[2 * iphi].find(absEta);
 
-  LOG(DEBUG2) << " ieta " << ieta << " : dmin " << dmin << " (eta=" << eta << ") : nSupMod " << nSupMod
-              << FairLogger::endl;
+  LOG(DEBUG2) << " ieta " << ieta << " (eta=" << eta << ") : nSupMod " << nSupMod << FairLogger::endl;
 
   // patch for mapping following alice convention
   if (nSupMod % 2 ==
@@ -927,6 +907,8 @@ Point3D<double> Geometry::RelPosCellInSModule(Int_t absId) const
 
   if (!CheckAbsCellId(absId))
     throw InvalidCellIDException(absId);
+  if (mCellPositionsInSModule.size())
+    return mCellPositionsInSModule[absId];
 
   auto cellindex = GetCellIndex(absId);
   Int_t nSupMod = std::get<0>(cellindex), nModule = std::get<1>(cellindex), nIphi = std::get<2>(cellindex),
@@ -1152,6 +1134,26 @@ void Geometry::CreateListOfTrd1Modules()
                 << std::setprecision(3) << mCentersOfCellsEtaDir[i] << " : x " << std::setw(8)
                 << std::setprecision(3) << mCentersOfCellsXDir[i] << FairLogger::endl;
   }
+
+  // Lookups of the nearest cell center in phi, for full, 1/2 and 1/3 SMs, and in eta for each phi index,
+  // for all the cells and for the ones beyond the 16 first as in DCAL SMs
+  gsl::span<const Double_t> phiCenters(mPhiCentersOfCells);
+  mPhiCentersLookup.clear();
+  for (Int_t div = 1; div <= 3; div++)
+    mPhiCentersLookup.emplace_back(phiCenters.subspan(0, phiCenters.size() / div));
+  mEtaCentersLookup.clear();
+  for (Int_t iphi = 0; iphi < mCentersOfCellsPhiDir.size(); iphi++) {
+    auto etaCenters = gsl::span<const Double_t>(mEtaCentersOfCells).subspan(iphi * mCentersOfCellsEtaDir.size(), mCentersOfCellsEtaDir.size());
+    mEtaCentersLookup.emplace_back(etaCenters);
+    mEtaCentersLookup.emplace_back(etaCenters.subspan(16));
+  }
+
+  // Positions of all the cells in their SM
+  mCellPositionsInSModule.clear();
+  std::vector<Point3D<double>> positions(mNCells);
+  for (Int_t absId = 0; absId < mNCells; absId++)
+    positions[absId] = RelPosCellInSModule(absId);
+  mCellPositionsInSModule.swap(positions);
 }
 
 const ShishKebabTrd1Module& Geometry::GetShishKebabModule(Int_t neta) const
@@ -85,6 +85,18 @@ class Detector : public o2::base::DetImpl<Detector>
   Hit* AddHit(Int_t trackID, Int_t parentID, Int_t primary, Double_t initialEnergy, Int_t detID,
               const Point3D<float>& pos, const Vector3D<float>& mom, Double_t time, Double_t energyloss);
 
+  ///
+  /// Shower library fast simulation: the showers start at the entrance of a module (2x2 towers)
+  ///
+  std::vector<std::string> getShowerLibraryVolumes() const override { return {"EMOD"}; }
+
+  ///
+  /// Create the hits of a library shower, one hit per cell of the shower spots
+  /// The spot energies are the energy deposits in the scintillator, the Birks saturation is not applied
+  ///
+  void depositLibraryShower(o2::base::ShowerLibrary::Shower const& shower, const double entry[3], const double dir[3],
+                            double energy, double time) override;
+
   ///
   /// Register TClonesArray with hits
   ///
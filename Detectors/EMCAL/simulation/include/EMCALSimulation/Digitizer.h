@@ -12,9 +12,7 @@
 #define ALICEO2_EMCAL_DIGITIZER_H
 
 #include <memory>
-#include <unordered_map>
 #include <vector>
-#include <deque>
 
 #include "Rtypes.h"  // for Digitizer::Class, Double_t, ClassDef, etc
 #include "TObject.h" // for TObject
@@ -25,6 +23,7 @@
 #include "EMCALBase/GeometryBase.h"
 #include "EMCALBase/Hit.h"
 #include "EMCALSimulation/SimParam.h"
+#include "DetectorsBase/CellAccumulator.h"
 
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
@@ -88,7 +87,7 @@ class Digitizer : public TObject
   bool mRemoveDigitsBelowThreshold = true; // remove digits below threshold
   const SimParam* mSimParam = nullptr;     ///< SimParam object
 
-  std::unordered_map<Int_t, std::deque<Digit>> mDigits; ///< used to sort digits by tower
+  o2::base::CellAccumulator<Digit> mDigits;                             //! digits of each tower
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> mMCTruthContainer; ///< contains MC truth information
 
   TRandom3* mRandomGenerator = nullptr; // random number generator
@@ -10,9 +10,11 @@
 
 #include <algorithm>
 #include <iomanip>
+#include <map>
 
 #include "TGeoManager.h"
 #include "TGeoVolume.h"
+#include "TVector3.h"
 #include "TVirtualMC.h"
 
 #include "FairGeoNode.h"
@@ -200,6 +202,45 @@ Bool_t Detector::ProcessHits(FairVolume* v)
   return true;
 }
 
+void Detector::depositLibraryShower(o2::base::ShowerLibrary::Shower const& shower, const double entry[3],
+                                    const double dir[3], double energy, double time)
+{
+  Geometry* geom = GetGeometry();
+  auto o2stack = static_cast<o2::data::Stack*>(fMC->GetStack());
+  Int_t partID = o2stack->GetCurrentTrackNumber(), parent = o2stack->GetCurrentTrack()->GetMother(0);
+  Double_t estart = fMC->Etot();
+  Vector3D<float> mom(energy * dir[0], energy * dir[1], energy * dir[2]);
+
+  // one hit per cell, at the position and time of its first spot
+  std::map<Int_t, size_t> cellHits;
+  for (auto& spot : shower) {
+    double pos[3];
+    o2::base::ShowerLibrary::toGlobal(spot, entry, dir, pos);
+    TVector3 global(pos[0], pos[1], pos[2]);
+    Int_t detID;
+    try {
+      detID = geom->GetAbsCellIdFromEtaPhi(global.Eta(), global.Phi());
+    } catch (InvalidPositionException& e) {
+      continue; // spot outside of the acceptance
+    }
+    Double_t eloss = spot.energy * energy / geom->GetSampling();
+    auto cell = cellHits.find(detID);
+    if (cell == cellHits.end()) {
+      AddHit(partID, parent, 0, estart, detID, Point3D<float>(pos[0], pos[1], pos[2]), mom, time + spot.time, eloss);
+      cellHits.emplace(detID, mHits->size() - 1);
+    } else {
+      auto& hit = (*mHits)[cell->second];
+      hit.SetEnergyLoss(hit.GetEnergyLoss() + eloss);
+    }
+  }
+  if (!cellHits.empty()) {
+    o2stack->addHit(GetDetId());
+  }
+  // the following steps do not continue the library hits
+  mCurrentHit = nullptr;
+  mCurrentCellID = -1;
+}
+
 Hit* Detector::AddHit(Int_t trackID, Int_t parentID, Int_t primary, Double_t initialEnergy, Int_t detID,
                       const Point3D<float>& pos, const Vector3D<float>& mom, Double_t time, Double_t eLoss)
 {
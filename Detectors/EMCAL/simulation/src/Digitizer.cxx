@@ -17,8 +17,8 @@
 #include "MathUtils/Cartesian3D.h"
 #include "SimulationDataFormat/MCCompLabel.h"
 
+#include <algorithm>
 #include <climits>
-#include <forward_list>
 #include <chrono>
 #include <TRandom.h>
 #include "FairLogger.h" // for LOG
@@ -34,6 +34,7 @@ using namespace o2::emcal;
 void Digitizer::init()
 {
   mSimParam = SimParam::GetInstance();
+  mDigits.setNCells(mGeometry->GetNCells());
   mRandomGenerator = new TRandom3(std::chrono::high_resolution_clock::now().time_since_epoch().count());
 }
 
@@ -53,24 +54,13 @@ void Digitizer::process(const std::vector<Hit>& hits, std::vector<Digit>& digits
       Digit digit = hitToDigit(hit, LabelIndex);
       Int_t id = digit.GetTower();
 
-      if (id < 0 || id > mGeometry->GetNCells()) {
+      if (!mDigits.isValid(id)) {
         LOG(WARNING) << "tower index out of range: " << id << FairLogger::endl;
         continue;
       }
 
-      Bool_t flag = false;
-      for (auto& digit0 : mDigits[id]) {
-        if (digit0.canAdd(digit)) {
-          digit0 += digit;
-          LabelIndex = digit0.GetLabel();
-          flag = true;
-          break;
-        }
-      }
-
-      if (!flag) {
-        mDigits[id].push_front(digit);
-      }
+      // merged with the digit of the tower in the same time sample, if any
+      LabelIndex = mDigits.add(id, digit).GetLabel();
 
       o2::MCCompLabel label(hit.GetTrackID(), mCurrEvID, mCurrSrcID);
       mMCTruthContainer.addElementRandomAccess(LabelIndex, label);
@@ -107,27 +97,22 @@ void Digitizer::setEventTime(double t)
 //_______________________________________________________________________
 void Digitizer::fillOutputContainer(std::vector<Digit>& digits)
 {
-  std::forward_list<Digit> l;
-
-  for (auto tower : mDigits) {
-    for (auto& digit : tower.second) {
-      if (mRemoveDigitsBelowThreshold && (digit.GetAmplitude() < mSimParam->GetDigitThreshold() * (constants::EMCAL_ADCENERGY))) {
-        continue;
-      }
-
-      if (mSmearTimeEnergy) {
-        smearTimeEnergy(digit);
-      }
-
-      l.push_front(digit);
+  // towers in increasing order, such that the output does not depend on the order of the hits
+  mDigits.sortTouchedCells();
+  auto first = digits.size();
+  mDigits.forEachDigit([this, &digits](Digit& digit) {
+    if (mRemoveDigitsBelowThreshold && (digit.GetAmplitude() < mSimParam->GetDigitThreshold() * (constants::EMCAL_ADCENERGY))) {
+      return;
     }
-  }
 
-  l.sort();
+    if (mSmearTimeEnergy) {
+      smearTimeEnergy(digit);
+    }
 
-  for (auto digit : l) {
     digits.push_back(digit);
-  }
+  });
+
+  std::stable_sort(digits.begin() + first, digits.end());
 }
 
 //_______________________________________________________________________
@@ -26,6 +26,10 @@ class CollisionTimeRecoTask
   CollisionTimeRecoTask() = default;
   ~CollisionTimeRecoTask() = default;
   void Process(const o2::fit::Digit& digits, RecPoints& recPoints) const;
+  /// all the bunch crossings of a timeframe at once, to flat arrays: one BCRecPoint per digit
+  /// and the channels of all of them (the previous content of the outputs is replaced)
+  void Process(const std::vector<o2::fit::Digit>& digits, std::vector<BCRecPoint>& recPoints,
+               std::vector<o2::fit::ChannelData>& channels) const;
   void FinishTask();
 
  private:
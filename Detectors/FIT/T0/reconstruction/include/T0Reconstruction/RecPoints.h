@@ -28,6 +28,20 @@ struct Channel {
   Float_t time, amp;
   ClassDefNV(Channel, 1);
 };
+
+/// Collision times of one bunch crossing, in the flat output of the batch reconstruction:
+/// its channels are the nChannels entries from firstChannel of the channel array
+struct BCRecPoint {
+  std::array<Float_t, 3> collisionTime; // mean, A side, C side
+  Float_t vertex;
+  Double_t eventTime;
+  Int_t bc;
+  Int_t orbit;
+  Int_t firstChannel;
+  Int_t nChannels;
+  ClassDefNV(BCRecPoint, 1);
+};
+
 class RecPoints
 {
  public:
@@ -43,6 +57,11 @@ class RecPoints
   ~RecPoints() = default;
 
   void FillFromDigits(const o2::fit::Digit& digit);
+
+  /// collision times and vertex from the channels (CFD times relative to the event time),
+  /// the vertex and mean time are 0 unless both sides fired
+  static void computeCollisionTime(const o2::fit::ChannelData* channels, int nChannels,
+                                   std::array<Float_t, 3>& collisionTime, Float_t& vertex);
   Float_t GetCollisionTime(int side) const { return mCollisionTime[side]; }
   void setCollisionTime(Float_t time, int side) { mCollisionTime[side] = time; }
 
@@ -12,6 +12,7 @@
 /// \brief Implementation of the FIT reconstruction task
 
 #include "T0Reconstruction/CollisionTimeRecoTask.h"
+#include <CommonDataFormat/InteractionRecord.h>
 #include "FairLogger.h" // for LOG
 
 using namespace o2::t0;
@@ -32,6 +33,36 @@ void CollisionTimeRecoTask::Process(const Digit& digits,
   //  LOG(INFO) << "Running reconstruction on new event" << FairLogger::endl;
   recPoints.FillFromDigits(digits);
 }
+//_____________________________________________________________________
+void CollisionTimeRecoTask::Process(const std::vector<Digit>& digits, std::vector<BCRecPoint>& recPoints,
+                                    std::vector<ChannelData>& channels) const
+{
+  size_t nChannels = 0;
+  for (const auto& digit : digits) {
+    nChannels += digit.getChDgData().size();
+  }
+  recPoints.resize(digits.size());
+  channels.resize(nChannels);
+
+  int first = 0;
+  for (size_t i = 0; i < digits.size(); ++i) {
+    const auto& digit = digits[i];
+    const auto& data = digit.getChDgData();
+    auto& rec = recPoints[i];
+    rec.bc = digit.getBC();
+    rec.orbit = digit.getOrbit();
+    rec.eventTime = o2::InteractionRecord::bc2ns(rec.bc, rec.orbit);
+    rec.firstChannel = first;
+    rec.nChannels = data.size();
+    auto* out = channels.data() + first;
+    for (size_t ich = 0; ich < data.size(); ++ich) {
+      out[ich] = data[ich];
+      out[ich].CFDTime -= rec.eventTime;
+    }
+    RecPoints::computeCollisionTime(out, rec.nChannels, rec.collisionTime, rec.vertex);
+    first += rec.nChannels;
+  }
+}
 //________________________________________________________
 void CollisionTimeRecoTask::FinishTask()
 {
@@ -11,6 +11,7 @@
 #include "T0Reconstruction/RecPoints.h"
 #include "T0Base/Geometry.h"
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <CommonDataFormat/InteractionRecord.h>
 
@@ -21,42 +22,46 @@ ClassImp(o2::t0::RecPoints);
 
 void RecPoints::FillFromDigits(const o2::fit::Digit& digit)
 {
-  mCollisionTime = {};
-
-  Int_t ndigitsC = 0, ndigitsA = 0;
-  constexpr Int_t nMCPsA = 4 * o2::t0::Geometry::NCellsA;
-  constexpr Int_t nMCPsC = 4 * o2::t0::Geometry::NCellsC;
-  constexpr Int_t nMCPs = nMCPsA + nMCPsC;
-  Float_t sideAtime = 0, sideCtime = 0;
-
   mBC = digit.getBC();
   mOrbit = digit.getOrbit();
   mEventTime = o2::InteractionRecord::bc2ns(mBC, mOrbit);
 
-  Float_t BCEventTime = 12.5;
-
   mTimeAmp = digit.getChDgData();
   for (auto& d : mTimeAmp) {
     d.CFDTime -= mEventTime /*- BCEventTime*/;
-    if (abs(d.CFDTime - BCEventTime) < 2) {
-      if (d.ChId < nMCPsA) {
-        sideAtime += d.CFDTime;
-        ndigitsA++;
-      } else {
-        sideCtime += d.CFDTime;
-        ndigitsC++;
-      }
-    }
+  }
+  computeCollisionTime(mTimeAmp.data(), mTimeAmp.size(), mCollisionTime, mVertex);
+}
+
+void RecPoints::computeCollisionTime(const ChannelData* channels, int nChannels,
+                                     std::array<Float_t, 3>& collisionTime, Float_t& vertex)
+{
+  constexpr Int_t nMCPsA = 4 * o2::t0::Geometry::NCellsA;
+  constexpr Double_t BCEventTime = 12.5;
+
+  // without branches in the loop, such that it is vectorized
+  Int_t ndigitsC = 0, ndigitsA = 0;
+  Float_t sideAtime = 0, sideCtime = 0;
+  for (int i = 0; i < nChannels; ++i) {
+    const Double_t time = channels[i].CFDTime;
+    const bool inGate = std::abs(time - BCEventTime) < 2;
+    const bool isA = channels[i].ChId < nMCPsA;
+    ndigitsA += inGate && isA;
+    ndigitsC += inGate && !isA;
+    sideAtime += (inGate && isA) ? time : 0.;
+    sideCtime += (inGate && !isA) ? time : 0.;
   }
 
+  collisionTime = {};
+  vertex = 0;
   if (ndigitsA > 0)
-    mCollisionTime[1] = sideAtime / Float_t(ndigitsA);
+    collisionTime[1] = sideAtime / Float_t(ndigitsA);
 
   if (ndigitsC > 0)
-    mCollisionTime[2] = sideCtime / Float_t(ndigitsC);
+    collisionTime[2] = sideCtime / Float_t(ndigitsC);
 
   if (ndigitsA > 0 && ndigitsC > 0) {
-    mVertex = (mCollisionTime[1] - mCollisionTime[2]) / 2.;
-    mCollisionTime[0] = (mCollisionTime[1] + mCollisionTime[2]) / 2.;
+    vertex = (collisionTime[1] - collisionTime[2]) / 2.;
+    collisionTime[0] = (collisionTime[1] + collisionTime[2]) / 2.;
   }
 }
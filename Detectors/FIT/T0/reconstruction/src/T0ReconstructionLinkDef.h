@@ -19,5 +19,7 @@
 #pragma link C++ class std::vector < o2::t0::RecPoints > +;
 
 #pragma link C++ class o2::t0::Channel + ;
+#pragma link C++ class o2::t0::BCRecPoint + ;
+#pragma link C++ class std::vector < o2::t0::BCRecPoint > +;
 
 #endif
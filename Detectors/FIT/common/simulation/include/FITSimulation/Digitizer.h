@@ -17,6 +17,8 @@
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "FITBase/MCLabel.h"
 #include "FITSimulation/DigitizationParameters.h"
+#include <utility>
+#include <vector>
 
 namespace o2
 {
@@ -61,6 +63,7 @@ class Digitizer
   DigitizationParameters parameters;
 
   o2::dataformats::MCTruthContainer<o2::fit::MCLabel>* mMCLabels = nullptr;
+  std::vector<std::pair<Int_t, Int_t>> mTrackChannels; //! track id and channel of the hits, for the labels
 
   ClassDefNV(Digitizer, 1);
 };
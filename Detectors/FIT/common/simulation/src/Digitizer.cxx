@@ -33,10 +33,6 @@ void Digitizer::process(const std::vector<o2::fit::HitType>* hits, Digit* digit)
   constexpr Float_t A_side_cable_cmps = 11.08; //ns
   constexpr Float_t signal_width = 5.;         // time gate for signal, ns
 
-  auto sorted_hits{ *hits };
-  std::sort(sorted_hits.begin(), sorted_hits.end(), [](o2::fit::HitType const& a, o2::fit::HitType const& b) {
-    return a.GetTrackID() < b.GetTrackID();
-  });
   digit->setTime(mEventTime);
   digit->setBC(mBC);
   digit->setOrbit(mOrbit);
@@ -48,9 +44,8 @@ void Digitizer::process(const std::vector<o2::fit::HitType>* hits, Digit* digit)
     for (int i = 0; i < parameters.mMCPs; ++i)
       channel_data.emplace_back(ChannelData{ i, 0, 0, 0 });
   }
-  Int_t parent = -10;
   assert(digit->getChDgData().size() == parameters.mMCPs);
-  for (auto& hit : sorted_hits) {
+  for (auto& hit : *hits) {
     Int_t hit_ch = hit.GetDetectorID();
     Double_t hit_time = hit.GetTime();
     Bool_t is_A_side = (hit_ch <= 4 * parameters.NCellsA);
@@ -66,17 +61,27 @@ void Digitizer::process(const std::vector<o2::fit::HitType>* hits, Digit* digit)
       channel_data[hit_ch].QTCAmpl += hit.GetEnergyLoss();
       channel_data[hit_ch].CFDTime += hit_time_corr;
     }
+  }
 
-    //charge particles in MCLabel
-    Int_t parentID = hit.GetTrackID();
-    if (parentID != parent) {
-      o2::fit::MCLabel label(hit.GetTrackID(), mEventID, mSrcID, hit_ch);
-      int lblCurrent;
-      if (mMCLabels) {
-        lblCurrent = mMCLabels->getIndexedSize(); // this is the size of mHeaderArray;
-        mMCLabels->addElement(lblCurrent, label);
-      }
-      parent = parentID;
+  //charge particles in MCLabel: one label per track, in the order of the track ids, with
+  //the channel of its first hit. Only the track ids and channels are sorted, not the hits
+  if (!mMCLabels) {
+    return;
+  }
+  mTrackChannels.clear();
+  mTrackChannels.reserve(hits->size());
+  for (auto& hit : *hits) {
+    mTrackChannels.emplace_back(hit.GetTrackID(), hit.GetDetectorID());
+  }
+  std::stable_sort(mTrackChannels.begin(), mTrackChannels.end(),
+                   [](std::pair<Int_t, Int_t> const& a, std::pair<Int_t, Int_t> const& b) { return a.first < b.first; });
+  Int_t parent = -10;
+  for (auto& trackChannel : mTrackChannels) {
+    if (trackChannel.first != parent) {
+      o2::fit::MCLabel label(trackChannel.first, mEventID, mSrcID, trackChannel.second);
+      int lblCurrent = mMCLabels->getIndexedSize(); // this is the size of mHeaderArray;
+      mMCLabels->addElement(lblCurrent, label);
+      parent = trackChannel.first;
     }
   }
 }
@@ -173,12 +178,12 @@ void Digitizer::setTriggers(Digit* digit)
   // Debug output -------------------------------------------------------------
   LOG(DEBUG) << "\n\nTest digizing data ===================" << FairLogger::endl;
 
-  LOG(INFO) << "Event ID: " << mEventID << " Event Time " << mEventTime << FairLogger::endl;
-  LOG(INFO) << "N hit A: " << n_hit_A << " N hit C: " << n_hit_C << " summ ampl A: " << summ_ampl_A
+  LOG(DEBUG) << "Event ID: " << mEventID << " Event Time " << mEventTime << FairLogger::endl;
+  LOG(DEBUG) << "N hit A: " << n_hit_A << " N hit C: " << n_hit_C << " summ ampl A: " << summ_ampl_A
             << " summ ampl C: " << summ_ampl_C << " mean time A: " << mean_time_A
             << " mean time C: " << mean_time_C << FairLogger::endl;
 
-  LOG(INFO) << "IS A " << is_A << " IS C " << is_C << " is Central " << is_Central
+  LOG(DEBUG) << "IS A " << is_A << " IS C " << is_C << " is Central " << is_Central
             << " is SemiCentral " << is_SemiCentral << " is Vertex " << is_Vertex << FairLogger::endl;
 
   LOG(DEBUG) << "======================================\n\n"
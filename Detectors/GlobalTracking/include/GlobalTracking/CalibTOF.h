@@ -17,9 +17,13 @@
 
 #include <Rtypes.h>
 #include <array>
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include <string>
+#include <gsl/span>
 #include <TStopwatch.h>
+#include "ReconstructionDataFormats/CalibInfoTOF.h"
 #include "ReconstructionDataFormats/CalibInfoTOFshort.h"
 #include "ReconstructionDataFormats/CalibLHCphaseTOF.h"
 #include "ReconstructionDataFormats/CalibTimeSlewingParamTOF.h"
@@ -50,6 +54,9 @@ class CalibTOF
   enum { kLHCphase = 1,
          kChannelOffset = 2,
          kChannelTimeSlewing = 4 }; // enum to define which calibration we will do
+  static constexpr int NBINSCHOFFSET = 1000;    // binning of the channel offset histograms
+  static constexpr float MINCHOFFSET = -24400.; // lower edge of the channel offset histograms (ps)
+  static constexpr float MAXCHOFFSET = 24400.;  // upper edge of the channel offset histograms (ps)
 
   ///< constructor
   CalibTOF();
@@ -89,6 +96,20 @@ class CalibTOF
   TGraphErrors* processSlewing(TH2F* histo, Bool_t forceZero, TF1* fitFunc);
   Int_t FitPeak(TF1* fitFunc, TH1* h, Float_t startSigma, Float_t nSigmaMin, Float_t nSigmaMax, const char* debuginfo = "", TH2* hdbg = nullptr);
 
+  ///< online mode: the calib infos are passed in chunks (e.g. received via DPL) instead of being read from the tree
+  ///< set which calibrations are done by runOnline, to be set before the first input
+  void setOnlineFlag(int flag) { mOnlineFlag = flag; }
+  int getOnlineFlag() const { return mOnlineFlag; }
+
+  ///< accumulate the calib infos of a single channel
+  void addChannelCalibInfo(int channel, gsl::span<const o2::dataformats::CalibInfoTOFshort> calibinfotof);
+
+  ///< accumulate calib infos of any channels
+  void addCalibInfo(gsl::span<const o2::dataformats::CalibInfoTOF> calibinfotof);
+
+  ///< calibrate using the accumulated calib infos, the channels are fitted in parallel on nThreads threads
+  void runOnline(int nThreads = 1);
+
   void setDebugMode(Int_t flag = kTRUE) { mDebugMode = flag; }
   Int_t getDebugMode() const { return mDebugMode; }
 
@@ -97,7 +118,7 @@ class CalibTOF
  private:
   Int_t mDebugMode = 0; // >0= time slewing extra plot, >1= problematic fits stored
 
-  void fillLHCphaseCalibInput(std::vector<o2::dataformats::CalibInfoTOFshort>* calibinfotof);                                                                                                    // we will fill the input for the LHC phase calibration
+  void fillLHCphaseCalibInput(gsl::span<const o2::dataformats::CalibInfoTOFshort> calibinfotof);                                                                                               // we will fill the input for the LHC phase calibration
   void doLHCPhaseCalib();                                                                                                                                                                        // calibrate with respect LHC phase
   void fillChannelCalibInput(std::vector<o2::dataformats::CalibInfoTOFshort>* calibinfotof, float offset, int ipad, TH1F* histo, std::vector<o2::dataformats::CalibInfoTOFshort>* calibTimePad); // we will fill the input for the channel-level calibration
   void fillChannelTimeSlewingCalib(float offset, int ipad, TH2F* histo, std::vector<o2::dataformats::CalibInfoTOFshort>* calibTimePad);                                                          // we will fill the input for the channel-time-slewing calibration
@@ -110,6 +131,19 @@ class CalibTOF
 
   TH1D* mProjTimeSlewingTemp; // temporary histo for time slewing
 
+  ///< compact input of the channel level calibrations in online mode, no ROOT histogram per channel
+  struct OnlineChannelInput {
+    int entries = 0;                                       ///< number of entries
+    std::vector<uint16_t> offsetHisto;                     ///< channel offset histogram (saturating), booked at the first entry
+    std::vector<std::pair<float, float>> timeSlewingInput; ///< (tot, t - t_exp) pairs for the time slewing
+  };
+  std::vector<OnlineChannelInput> mOnlineChannelInput;                ///< per channel input, booked at the first online input
+  int mOnlineFlag = kLHCphase | kChannelOffset | kChannelTimeSlewing; ///< calibrations done in online mode
+
+  void fillOnlineCalibInput(int channel, int timestamp, float deltaTimePi, float tot); // accumulate one calib info in online mode
+  void doOnlineChannelCalibration(int ich, TH1F* histoOffset, TF1* func, TH2F* histoTimeSlewing, TH2F* histoTimeSlewingAll,
+                                  std::vector<std::pair<float, float>>& timeSlewingPoints); // calibrate one channel in online mode
+
   void attachInputTrees();
   bool loadTOFCollectedCalibInfo(TTree* localTree, int& currententry, int increment = 1);
 
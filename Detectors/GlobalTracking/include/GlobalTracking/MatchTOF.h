@@ -19,6 +19,7 @@
 #include <array>
 #include <vector>
 #include <string>
+#include <gsl/span>
 #include <TStopwatch.h>
 #include "ReconstructionDataFormats/Track.h"
 #include "ReconstructionDataFormats/TrackTPCITS.h"
@@ -86,6 +87,33 @@ class MatchTOF
   ///< set output tree to write calibration infos
   void setOutputTreeCalib(TTree* tr) { mOutputTreeCalib = tr; }
 
+  ///< set input tracks of the timeframe, alternative to the input tree. The data must stay valid during run()
+  void setTracksInp(const gsl::span<const o2::dataformats::TrackTPCITS> inp) { mTracksArray = inp; }
+
+  ///< set TOF clusters of the timeframe, alternative to the input tree. The data must stay valid during run()
+  void setTOFClustersInp(const gsl::span<const Cluster> inp) { mTOFClustersArray = inp; }
+
+  ///< set TPC and ITS MC labels of the input tracks of the timeframe, alternative to the input tree
+  void setTracksMCLabelsInp(const gsl::span<const o2::MCCompLabel> lblTPC, const gsl::span<const o2::MCCompLabel> lblITS)
+  {
+    mTPCLabels = lblTPC;
+    mITSLabels = lblITS;
+  }
+
+  ///< set TOF clusters MC labels of the timeframe, alternative to the input tree
+  void setTOFClustersMCLabelsInp(const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* lbl) { mTOFClusLabels = lbl; }
+
+  ///< get matched tracks of the last processed tracks entry
+  const std::vector<std::pair<int, o2::dataformats::MatchInfoTOF>>& getMatchedTracks() const { return mMatchedTracks; }
+
+  ///< get TOF, TPC and ITS MC labels of the matched tracks of the last processed tracks entry
+  const std::vector<o2::MCCompLabel>& getMatchedTOFLabels() const { return mOutTOFLabels; }
+  const std::vector<o2::MCCompLabel>& getMatchedTPCLabels() const { return mOutTPCLabels; }
+  const std::vector<o2::MCCompLabel>& getMatchedITSLabels() const { return mOutITSLabels; }
+
+  ///< get calibration infos of the last processed tracks entry
+  const std::vector<o2::dataformats::CalibInfoTOF>& getCalibInfoTOF() const { return mCalibInfoTOF; }
+
   ///< set input branch names for the input from the tree
   void setTrackBranchName(const std::string& nm) { mTracksBranchName = nm; }
   void setTPCTrackBranchName(const std::string& nm) { mTPCTracksBranchName = nm; }
@@ -129,6 +157,11 @@ class MatchTOF
   ///< get number of sigma used to do the matching
   float getSigmaTimeCut() const { return mSigmaTimeCut; }
 
+  ///< get number of tracks crossing a TOF strip for which the clusters were searched in the last run
+  int getNTracksTested() const { return mNTracksTested; }
+  ///< get number of track-cluster candidates tested in the last run
+  int getNCandidatesTested() const { return mNCandidatesTested; }
+
 #ifdef _ALLOW_DEBUG_TREES_
   enum DebugFlagTypes : UInt_t {
     MatchTreeAll = 0x1 << 1, ///< produce matching candidates tree for all candidates
@@ -202,18 +235,25 @@ class MatchTOF
 
   ///>>>------ these are input arrays which should not be modified by the matching code
   //           since this info is provided by external device
-  std::vector<o2::dataformats::TrackTPCITS>* mTracksArrayInp = nullptr; ///< input tracks
-  std::vector<o2::TPC::TrackTPC>* mTPCTracksArrayInp = nullptr;         ///< input TPC tracks
-  std::vector<Cluster>* mTOFClustersArrayInp = nullptr;                 ///< input TOF clusters
+  gsl::span<const o2::dataformats::TrackTPCITS> mTracksArray; ///< input tracks
+  gsl::span<const Cluster> mTOFClustersArray;                 ///< input TOF clusters
 
-  o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mTOFClusLabels = nullptr; ///< input TOF clusters MC labels
-  std::vector<o2::MCCompLabel> mTracksLblWork;                                  ///<TPCITS track labels
+  const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mTOFClusLabels = nullptr; ///< input TOF clusters MC labels
+  std::vector<o2::MCCompLabel> mTracksLblWork;                                        ///<TPCITS track labels
 
-  std::vector<o2::MCCompLabel>* mTPCLabels = nullptr; ///< TPC label of input tracks
-  std::vector<o2::MCCompLabel>* mITSLabels = nullptr; ///< ITS label of input tracks
+  gsl::span<const o2::MCCompLabel> mTPCLabels; ///< TPC label of input tracks
+  gsl::span<const o2::MCCompLabel> mITSLabels; ///< ITS label of input tracks
 
   /// <<<-----
 
+  ///< buffers of the input trees, the input arrays refer to them when the trees are used
+  std::vector<o2::dataformats::TrackTPCITS>* mTracksArrayInp = nullptr;
+  std::vector<o2::TPC::TrackTPC>* mTPCTracksArrayInp = nullptr;
+  std::vector<Cluster>* mTOFClustersArrayInp = nullptr;
+  o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mTOFClusLabelsInp = nullptr;
+  std::vector<o2::MCCompLabel>* mTPCLabelsInp = nullptr;
+  std::vector<o2::MCCompLabel>* mITSLabelsInp = nullptr;
+
   ///<working copy of the input tracks
   std::vector<o2::dataformats::TrackTPCITS> mTracksWork; ///<track params prepared for matching
   std::vector<Cluster> mTOFClusWork;                     ///<track params prepared for matching
@@ -223,6 +263,16 @@ class MatchTOF
   ///< per sector indices of TOF cluster entry in mTOFClusWork
   std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusSectIndexCache;
 
+  ///< per sector (strip, time) index of the TOF clusters: the positions in mTOFClusSectIndexCache of the clusters
+  ///< of strip i (numbered in the TOF sector) are stored in time order from entry mTOFClusStripStart[i]
+  std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusStripStart;
+  std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusStripIndex;
+  std::array<std::vector<float>, o2::constants::math::NSectors> mTOFClusStripTime; ///< time of the indexed clusters
+
+  std::vector<std::pair<int, int>> mCandidates; ///< position in sector cache and crossed strip of candidate clusters
+  int mNTracksTested = 0;                       ///< number of tracks for which the clusters were searched
+  int mNCandidatesTested = 0;                   ///< number of track-cluster candidates tested
+
   ///<array of track-TOFCluster pairs from the matching
   std::vector<std::pair<int, o2::dataformats::MatchInfoTOF>> mMatchedTracksPairs;
 
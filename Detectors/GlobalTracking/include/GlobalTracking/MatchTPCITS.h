@@ -21,6 +21,7 @@
 #include <array>
 #include <vector>
 #include <string>
+#include <gsl/span>
 #include <TStopwatch.h>
 #include "DataFormatsTPC/TrackTPC.h"
 #include "ReconstructionDataFormats/Track.h"
@@ -161,6 +162,11 @@ class MatchTPCITS
   ///< set max number of output matched tracks to store per tree entry
   void setMaxOutputTracksPerEntry(int n) { mMaxOutputTracksPerEntry = n > 1 ? n : 1; }
 
+  ///< set number of threads used for the refit of the winner matches
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  ///< get number of threads used for the refit of the winner matches
+  int getNThreads() const { return mNThreads; }
+
   ///< set ITS ROFrame duration in microseconds
   void setITSROFrameLengthMUS(float fums) { mITSROFrameLengthMUS = fums; }
 
@@ -182,6 +188,33 @@ class MatchTPCITS
   ///< set output tree to write matched tracks
   void setOutputTree(TTree* tr) { mOutputTree = tr; }
 
+  ///< set ITS tracks of the timeframe, alternative to the input tree. The data must stay valid during run()
+  void setITSTracksInp(const gsl::span<const o2::ITS::TrackITS> inp) { mITSTracksArray = inp; }
+
+  ///< set TPC tracks of the timeframe, alternative to the input tree. The data must stay valid during run()
+  void setTPCTracksInp(const gsl::span<const o2::TPC::TrackTPC> inp) { mTPCTracksArray = inp; }
+
+  ///< set ITS clusters of the timeframe, alternative to the input tree. The data must stay valid during run()
+  void setITSClustersInp(const gsl::span<const o2::itsmft::Cluster> inp) { mITSClustersArray = inp; }
+
+  ///< set TPC clusters index of the timeframe, alternative to the clusters reader
+  void setTPCClustersInp(const o2::TPC::ClusterNativeAccessFullTPC* inp) { mTPCClusterIdxStruct = inp; }
+
+  ///< set ITS tracks MC labels of the timeframe, alternative to the input tree
+  void setITSTrackMCLabelsInp(const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* lbl) { mITSTrkLabels = lbl; }
+
+  ///< set TPC tracks MC labels of the timeframe, alternative to the input tree
+  void setTPCTrackMCLabelsInp(const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* lbl) { mTPCTrkLabels = lbl; }
+
+  ///< get matched tracks of the last run, filled when no output tree is set
+  const std::vector<o2::dataformats::TrackTPCITS>& getMatchedTracks() const { return mMatchedTracks; }
+
+  ///< get ITS MC labels of the matched tracks of the last run, filled when no output tree is set
+  const std::vector<o2::MCCompLabel>& getMatchedITSLabels() const { return mOutITSLabels; }
+
+  ///< get TPC MC labels of the matched tracks of the last run, filled when no output tree is set
+  const std::vector<o2::MCCompLabel>& getMatchedTPCLabels() const { return mOutTPCLabels; }
+
   ///< set input branch names for the input from the tree
   void setITSTrackBranchName(const std::string& nm) { mITSTrackBranchName = nm; }
   void setTPCTrackBranchName(const std::string& nm) { mTPCTrackBranchName = nm; }
@@ -282,11 +315,13 @@ class MatchTPCITS
   void loadITSTracksChunk(int chunk);
   void loadTPCClustersChunk(int chunk);
   void loadTPCTracksChunk(int chunk);
+  void setITSTracksFromTree();
+  void setTPCTracksFromTree();
 
   void doMatching(int sec);
 
   void refitWinners();
-  bool refitTrackITSTPC(int iITS);
+  bool refitTrackITSTPC(int iITS, int iTPC, o2::dataformats::TrackTPCITS& trfit) const;
   void selectBestMatches();
   void buildMatch2TrackTables();
   bool validateTPCMatch(int mtID);
@@ -406,7 +441,7 @@ class MatchTPCITS
   TTree* mTreeTPCTracks = nullptr;   ///< input tree for TPC tracks
   TTree* mTreeITSClusters = nullptr; ///< input tree for ITS clusters
   o2::TPC::ClusterNativeHelper::Reader* mTPCClusterReader = nullptr; ///< TPC cluster reader
-  o2::TPC::ClusterNativeAccessFullTPC mTPCClusterIdxStruct;          ///< struct holding the TPC cluster indices
+  o2::TPC::ClusterNativeAccessFullTPC mTPCClusterIdxStructOwn;       ///< struct holding the TPC cluster indices from the reader
   std::unique_ptr<TPCTransform> mTPCTransform;                       ///< TPC cluster transformation
   std::unique_ptr<AliGPUCAParam> mTPCClusterParam;                   ///< TPC clusters error param
 
@@ -414,15 +449,22 @@ class MatchTPCITS
 
   ///>>>------ these are input arrays which should not be modified by the matching code
   //           since this info is provided by external device
-  std::vector<o2::ITS::TrackITS>* mITSTracksArrayInp = nullptr; ///< input ITS tracks
-  std::vector<o2::TPC::TrackTPC>* mTPCTracksArrayInp = nullptr; ///< input TPC tracks
-
-  std::vector<o2::itsmft::Cluster>* mITSClustersArrayInp = nullptr; ///< input ITS clusters
+  gsl::span<const o2::ITS::TrackITS> mITSTracksArray;                     ///< input ITS tracks
+  gsl::span<const o2::TPC::TrackTPC> mTPCTracksArray;                     ///< input TPC tracks
+  gsl::span<const o2::itsmft::Cluster> mITSClustersArray;                 ///< input ITS clusters
+  const o2::TPC::ClusterNativeAccessFullTPC* mTPCClusterIdxStruct = nullptr; ///< input TPC cluster indices
 
-  o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mITSTrkLabels = nullptr; ///< input ITS Track MC labels
-  o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mTPCTrkLabels = nullptr; ///< input TPC Track MC labels
+  const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mITSTrkLabels = nullptr; ///< input ITS Track MC labels
+  const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mTPCTrkLabels = nullptr; ///< input TPC Track MC labels
   /// <<<-----
 
+  ///< buffers of the input trees, the input arrays refer to them when the trees are used
+  std::vector<o2::ITS::TrackITS>* mITSTracksArrayInp = nullptr;
+  std::vector<o2::TPC::TrackTPC>* mTPCTracksArrayInp = nullptr;
+  std::vector<o2::itsmft::Cluster>* mITSClustersArrayInp = nullptr;
+  o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mITSTrkLabelsInp = nullptr;
+  o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mTPCTrkLabelsInp = nullptr;
+
   ///< container for matchCand structures of TPC tracks (1 per TPCtrack with some matches to ITS)
   std::vector<matchCand> mMatchesTPC;
   ///< container for matchCand structures of ITS tracks(1 per ITStrack with some matches to TPC)
@@ -454,8 +496,10 @@ class MatchTPCITS
 
   ///<indices of 1st entries with time-bin above the value
   std::array<std::vector<int>, o2::constants::math::NSectors> mTPCTimeBinStart;
-  ///<indices of 1st entries of ITS tracks with givem ROframe
+  ///<indices of 1st entries of ITS tracks with ROframe >= given one
   std::array<std::vector<int>, o2::constants::math::NSectors> mITSTimeBinStart;
+  ///<per sector tgl of ITS tracks in the order of mITSSectIndexCache, bisected in the matching
+  std::array<std::vector<float>, o2::constants::math::NSectors> mITSSectTgl;
 
   ///<outputs tracks container
   std::vector<o2::dataformats::TrackTPCITS> mMatchedTracks;
@@ -463,6 +507,7 @@ class MatchTPCITS
   std::vector<o2::MCCompLabel> mOutTPCLabels; ///< TPC label of matched track
 
   int mMaxOutputTracksPerEntry = 500; ///< max number of output tracks to store per entry
+  int mNThreads = 1;                  ///< number of threads used for the refit
 
   std::string mITSTrackBranchName = "ITSTrack";          ///< name of branch containing input ITS tracks
   std::string mTPCTrackBranchName = "Tracks";            ///< name of branch containing input TPC tracks
@@ -0,0 +1,168 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PrimaryVertexer.h
+/// \brief Primary vertex finder for the global TPC-ITS tracks of a time frame, using their time
+
+#ifndef ALICEO2_GLOBTRACKING_PRIMARYVERTEXER_
+#define ALICEO2_GLOBTRACKING_PRIMARYVERTEXER_
+
+#include <vector>
+#include <gsl/span>
+#include "Rtypes.h"
+#include "ReconstructionDataFormats/TrackTPCITS.h"
+#include "ReconstructionDataFormats/Vertex.h"
+#include "CommonDataFormat/RangeReference.h"
+#include "CommonDataFormat/TimeStamp.h"
+
+namespace o2
+{
+namespace globaltracking
+{
+
+using PVertex = o2::dataformats::Vertex<o2::dataformats::TimeStampWithError<float, float>>;
+using VertexTrackRef = o2::dataformats::RangeReference<int, int>;
+
+/// Finds the primary vertices of the continuous readout from the TPC-ITS tracks of a time frame,
+/// separating the pileup collisions by their z and by the time estimates of the tracks:
+///  - the tracks are propagated to their closest approach to the beam line and sorted in time,
+///  - a sweep over the sorted times splits them in independent time clusters at the gaps larger than
+///    the time cluster gap,
+///  - in each time cluster the vertices are seeded at the maxima of a histogram of the track z, each seed
+///    is fitted adaptively in (z, t), with Tukey weights of the (z, t) chi2 of the tracks, and the tracks
+///    compatible with the fitted vertex are removed from the histogram before the next seed.
+/// The time clusters are processed in parallel and merged in time order, so that the result does not
+/// depend on the number of threads. Apart from the sorting, the cost is linear in the number of tracks.
+class PrimaryVertexer
+{
+ public:
+  PrimaryVertexer() = default;
+  ~PrimaryVertexer() = default;
+
+  ///< find the vertices of the tracks, return their number
+  int process(const gsl::span<const o2::dataformats::TrackTPCITS> tracks);
+
+  ///< vertices found by the last process, in time order
+  const std::vector<PVertex>& getVertices() const { return mVertices; }
+
+  ///< for each vertex, the range of its contributors in getVertexTrackIDs
+  const std::vector<VertexTrackRef>& getVertexTrackRefs() const { return mVertexTrackRefs; }
+
+  ///< indices of the tracks contributing to the vertices
+  const std::vector<int>& getVertexTrackIDs() const { return mVertexTrackIDs; }
+
+  ///< for each input track, the vertex it contributes to, -1 if none
+  const std::vector<int>& getTrackVertex() const { return mTrackVertex; }
+
+  ///< set the magnetic field in kG
+  void setBz(float bz) { mBz = bz; }
+  float getBz() const { return mBz; }
+
+  ///< set the mean beam position in the transverse plane, in cm
+  void setBeamPosition(float x, float y)
+  {
+    mBeamX = x;
+    mBeamY = y;
+  }
+
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  ///< set the minimal number of contributors of a vertex
+  void setMinTracks(int n) { mMinTracks = n > 1 ? n : 2; }
+  int getMinTracks() const { return mMinTracks; }
+
+  ///< set the maximal distance in the transverse plane of the tracks to the beam line, in cm
+  void setMaxDCAXY(float v) { mMaxDCAXY = v; }
+  float getMaxDCAXY() const { return mMaxDCAXY; }
+
+  ///< set the maximal |z| of the vertices, in cm
+  void setMaxZ(float v) { mMaxZ = v; }
+  float getMaxZ() const { return mMaxZ; }
+
+  ///< set the bin size of the z histogram of the seeding, in cm
+  void setZBin(float v) { mZBin = v; }
+  float getZBin() const { return mZBin; }
+
+  ///< set the gap in the sorted track times separating the time clusters, in the units of the track time
+  void setTimeClusterGap(float v) { mTimeClusterGap = v; }
+  float getTimeClusterGap() const { return mTimeClusterGap; }
+
+  ///< set the minimal time error assumed for the tracks, in the units of the track time
+  void setMinTimeError(float v) { mMinTimeError = v; }
+  float getMinTimeError() const { return mMinTimeError; }
+
+  ///< set the maximal (z, t) chi2 of a contributor to its vertex, also the scale of the Tukey weights
+  void setMaxChi2(float v) { mMaxChi2 = v; }
+  float getMaxChi2() const { return mMaxChi2; }
+
+  void setMaxIterations(int n) { mMaxIterations = n > 0 ? n : 1; }
+  int getMaxIterations() const { return mMaxIterations; }
+
+  ///< track prepared for the vertex finding, at its closest approach to the beam line
+  struct TrackVF {
+    float x = 0.f;      ///< global x
+    float y = 0.f;      ///< global y
+    float z = 0.f;      ///< global z
+    float sig2XYI = 0.f; ///< inverse error^2 in the transverse plane
+    float sig2ZI = 0.f; ///< inverse error^2 in z
+    float t = 0.f;      ///< time
+    float sig2TI = 0.f; ///< inverse error^2 of the time
+    int index = -1;     ///< index of the input track
+  };
+
+  ///< find the vertices of the prepared tracks, to be sorted in time
+  int processPrepared(const std::vector<TrackVF>& tracks, int nInputTracks);
+
+ private:
+  ///< a vertex found in a time cluster, with the (local) indices of its contributors
+  struct VertexCandidate {
+    PVertex vertex;
+    std::vector<int> tracks;
+  };
+
+  ///< propagate the track to the beam line, return false if it is not usable
+  bool prepareTrack(const o2::dataformats::TrackTPCITS& track, int index, TrackVF& trackVF) const;
+
+  ///< find the vertices among the time sorted tracks [first, last)
+  void processTimeCluster(const std::vector<TrackVF>& tracks, int first, int last,
+                          std::vector<VertexCandidate>& vertices) const;
+
+  ///< fit adaptively a vertex from the seed (z, t), the tracks with a null flag being free
+  bool fitVertex(const std::vector<TrackVF>& tracks, int first, int last, const std::vector<char>& used,
+                 float zSeed, float tSeed, VertexCandidate& candidate) const;
+
+  template <typename F>
+  void processInThreads(int n, F&& work) const;
+
+  std::vector<PVertex> mVertices;
+  std::vector<VertexTrackRef> mVertexTrackRefs;
+  std::vector<int> mVertexTrackIDs;
+  std::vector<int> mTrackVertex;
+
+  float mBz = 5.f;
+  float mBeamX = 0.f;
+  float mBeamY = 0.f;
+  int mNThreads = 1;
+  int mMinTracks = 3;
+  float mMaxDCAXY = 2.f;
+  float mMaxZ = 20.f;
+  float mZBin = 0.1f;
+  float mTimeClusterGap = 0.5f;
+  float mMinTimeError = 0.01f;
+  float mMaxChi2 = 16.f;
+  int mMaxIterations = 10;
+
+  ClassDefNV(PrimaryVertexer, 1);
+};
+} // namespace globaltracking
+} // namespace o2
+
+#endif
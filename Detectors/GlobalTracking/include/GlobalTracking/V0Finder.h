@@ -0,0 +1,228 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file V0Finder.h
+/// \brief V0 and cascade finder for the global TPC-ITS tracks of a time frame
+
+#ifndef ALICEO2_GLOBTRACKING_V0FINDER_
+#define ALICEO2_GLOBTRACKING_V0FINDER_
+
+#include <array>
+#include <vector>
+#include <gsl/span>
+#include "Rtypes.h"
+#include "ReconstructionDataFormats/TrackTPCITS.h"
+#include "ReconstructionDataFormats/V0.h"
+#include "ReconstructionDataFormats/Cascade.h"
+
+namespace o2
+{
+namespace globaltracking
+{
+
+/// Finds the V0s, pairs of a positive and a negative track from a secondary vertex, and the cascades,
+/// V0s combined with a bachelor track, among the TPC-ITS tracks of a time frame.
+/// Instead of testing all the pairs, the tracks displaced from the beam line are hashed by their sign in
+/// cells of the azimuthal angle and of the tgLambda of their direction, sorted in time inside each cell.
+/// A positive track is only paired with the negative tracks of its own and of the neighbouring cells which
+/// are compatible in time, and similarly a V0 with the bachelors along its direction.
+/// The vertex of a pair is found from the crossing of the helices (of the helix and of the V0 line) in the
+/// transverse plane, then the tracks are propagated there and the candidate is selected by the distance
+/// between the prongs and by its pointing to the beam line in the transverse plane.
+/// The positive tracks and the V0s are processed in blocks on several threads, the candidates are merged in
+/// block order, so that the result does not depend on the number of threads.
+class V0Finder
+{
+  using V0 = o2::dataformats::V0;
+  using Cascade = o2::dataformats::Cascade;
+
+ public:
+  V0Finder() = default;
+  ~V0Finder() = default;
+
+  ///< find the V0s and cascades of the tracks, return the number of V0s
+  int process(const gsl::span<const o2::dataformats::TrackTPCITS> tracks);
+
+  ///< V0 candidates found by the last process
+  const std::vector<V0>& getV0s() const { return mV0s; }
+
+  ///< cascade candidates found by the last process
+  const std::vector<Cascade>& getCascades() const { return mCascades; }
+
+  ///< number of the track pairs (V0 and bachelor pairs) which passed the hashing, for the last process
+  long getNPairsTested() const { return mNPairsTested; }
+  long getNCascadePairsTested() const { return mNCascadePairsTested; }
+
+  ///< set the magnetic field in kG
+  void setBz(float bz) { mBz = bz; }
+  float getBz() const { return mBz; }
+
+  ///< set the mean beam position in the transverse plane, in cm
+  void setBeamPosition(float x, float y)
+  {
+    mBeamX = x;
+    mBeamY = y;
+  }
+
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  ///< set the material correction type of the Propagator for the propagation to the vertex, 0 for none
+  void setMatCorr(int v) { mMatCorr = v; }
+  int getMatCorr() const { return mMatCorr; }
+
+  ///< set the minimal distance of the prongs and bachelors to the beam line in the transverse plane, in cm
+  void setMinDCAXYToBeam(float v) { mMinDCAXYToBeam = v; }
+  float getMinDCAXYToBeam() const { return mMinDCAXYToBeam; }
+
+  ///< set the maximal difference of the azimuthal angles of the tracks paired, in rad
+  void setMaxDPhi(float v) { mMaxDPhi = v; }
+  float getMaxDPhi() const { return mMaxDPhi; }
+
+  ///< set the maximal difference of the tgLambda of the tracks paired
+  void setMaxDTgl(float v) { mMaxDTgl = v; }
+  float getMaxDTgl() const { return mMaxDTgl; }
+
+  ///< set the maximal chi2 of the time difference of the tracks paired
+  void setMaxTimeChi2(float v) { mMaxTimeChi2 = v; }
+  float getMaxTimeChi2() const { return mMaxTimeChi2; }
+
+  ///< set the range of the radius of the vertices, in cm
+  void setRRange(float rmin, float rmax)
+  {
+    mMinR = rmin;
+    mMaxR = rmax;
+  }
+  float getMinR() const { return mMinR; }
+  float getMaxR() const { return mMaxR; }
+
+  ///< set the maximal distance between the prongs at the V0 vertex, in cm
+  void setMaxDCAProngs(float v) { mMaxDCAProngs = v; }
+  float getMaxDCAProngs() const { return mMaxDCAProngs; }
+
+  ///< set the minimal cosine of the transverse pointing angle of the V0s
+  void setMinCosPA(float v) { mMinCosPA = v; }
+  float getMinCosPA() const { return mMinCosPA; }
+
+  ///< enable the search for cascades
+  void setFindCascades(bool v) { mFindCascades = v; }
+  bool getFindCascades() const { return mFindCascades; }
+
+  ///< set the minimal cosine of the transverse pointing angle of the V0s of the cascades
+  void setMinCosPACascadeV0(float v) { mMinCosPACascadeV0 = v; }
+  float getMinCosPACascadeV0() const { return mMinCosPACascadeV0; }
+
+  ///< set the window of the (anti)Lambda mass of the V0s of the cascades, in GeV
+  void setLambdaMassWindow(float v) { mLambdaMassWindow = v; }
+  float getLambdaMassWindow() const { return mLambdaMassWindow; }
+
+  ///< set the maximal distance between the V0 and the bachelor at the cascade vertex, in cm
+  void setMaxDCACascade(float v) { mMaxDCACascade = v; }
+  float getMaxDCACascade() const { return mMaxDCACascade; }
+
+  ///< set the minimal cosine of the transverse pointing angle of the cascades
+  void setMinCosPACascade(float v) { mMinCosPACascade = v; }
+  float getMinCosPACascade() const { return mMinCosPACascade; }
+
+ private:
+  ///< track selected as prong or bachelor, with its helix in the transverse plane
+  struct TrackV0 {
+    int index = -1;   ///< index of the input track
+    float phi = 0.f;  ///< azimuthal angle of the direction
+    float tgl = 0.f;  ///< tgLambda
+    float t = 0.f;    ///< time
+    float sigT = 0.f; ///< time error
+    float xC = 0.f;   ///< helix center x
+    float yC = 0.f;   ///< helix center y
+    float rC = 0.f;   ///< helix radius
+  };
+
+  ///< tracks of one sign in cells of phi and tgLambda, sorted in time inside each cell
+  struct TrackHash {
+    int nPhi = 1;
+    int nTgl = 1;
+    float tglMin = 0.f;
+    float phiBinI = 0.f;
+    float tglBinI = 0.f;
+    float maxSigT = 0.f;
+    std::vector<int> offsets; ///< start of each cell in entries, nPhi * nTgl + 1
+    std::vector<int> entries; ///< indices in mTracksV0
+
+    void build(const std::vector<TrackV0>& tracks, const std::vector<int>& selected, float maxDPhi, float maxDTgl);
+    int getPhiBin(float phi) const;
+    int getTglBin(float tgl) const;
+  };
+
+  ///< a V0 candidate with the V0 cuts flag, the cascades using also the V0s failing them
+  struct V0Candidate {
+    V0 v0;
+    bool accepted = false;
+  };
+
+  ///< select the track as a prong or a bachelor, return false if it is not usable
+  bool prepareTrack(const o2::dataformats::TrackTPCITS& track, int index, TrackV0& trackV0) const;
+
+  ///< call f(indexInTracksV0) for the tracks of the hash compatible with the direction and time
+  template <typename F>
+  void loopCompatible(const TrackHash& hash, float phi, float tgl, float t, float sigT, F&& f) const;
+
+  ///< fit the V0 of a pair of tracks, return false if it does not pass the selection
+  bool fitV0(const o2::dataformats::TrackTPCITS& trPos, const TrackV0& pos, const o2::dataformats::TrackTPCITS& trNeg,
+             const TrackV0& neg, V0Candidate& candidate) const;
+
+  ///< fit the cascade of a V0 and a bachelor, return false if it does not pass the selection
+  bool fitCascade(const V0& v0, int v0ID, const o2::dataformats::TrackTPCITS& trBach, const TrackV0& bach,
+                  Cascade& cascade) const;
+
+  ///< rotate the track to the frame alpha and propagate it to x in this frame
+  bool propagateToPoint(o2::track::TrackParCov& track, float alpha, float x) const;
+
+  ///< cosine of the angle between the momentum and the vertex position w.r.t. the beam in the transverse plane
+  float getCosPAXY(const std::array<float, 3>& xyz, const std::array<float, 3>& pxyz) const;
+
+  void findCascades(const gsl::span<const o2::dataformats::TrackTPCITS> tracks,
+                    const std::vector<V0Candidate>& candidates, const std::vector<int>& v0IDs);
+
+  template <typename F>
+  void processInThreads(int n, F&& work) const;
+
+  std::vector<V0> mV0s;
+  std::vector<Cascade> mCascades;
+  std::vector<TrackV0> mTracksV0;
+  TrackHash mHashPos;
+  TrackHash mHashNeg;
+  long mNPairsTested = 0;
+  long mNCascadePairsTested = 0;
+
+  float mBz = 5.f;
+  float mBeamX = 0.f;
+  float mBeamY = 0.f;
+  int mNThreads = 1;
+  int mMatCorr = 0;
+  float mMinDCAXYToBeam = 0.05f;
+  float mMaxDPhi = 1.5f;
+  float mMaxDTgl = 1.5f;
+  float mMaxTimeChi2 = 16.f;
+  float mMinR = 0.2f;
+  float mMaxR = 40.f;
+  float mMaxDCAProngs = 0.5f;
+  float mMinCosPA = 0.99f;
+  bool mFindCascades = true;
+  float mMinCosPACascadeV0 = 0.9f;
+  float mLambdaMassWindow = 0.01f;
+  float mMaxDCACascade = 0.5f;
+  float mMinCosPACascade = 0.99f;
+
+  ClassDefNV(V0Finder, 1);
+};
+} // namespace globaltracking
+} // namespace o2
+
+#endif
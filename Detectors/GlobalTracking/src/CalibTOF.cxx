@@ -22,6 +22,13 @@
 #include "CommonConstants/LHCConstants.h"
 
 #include "TMath.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
 
 using namespace o2::globaltracking;
 
@@ -78,7 +85,9 @@ void CalibTOF::init()
   TH1::AddDirectory(0); // needed because we have the LHCPhase created here, while in the macro we might have the output file open
                         // (we don't want to bind the histogram to the file, or teh destructor will complain)
 
-  attachInputTrees();
+  if (mTreeCollectedCalibInfoTOF) {
+    attachInputTrees(); // not needed in online mode
+  }
 
   std::fill_n(mCalibChannelOffset, o2::tof::Geo::NCHANNELS, 0);
   std::fill_n(mCalibChannelOffsetErr, o2::tof::Geo::NCHANNELS, -1);
@@ -117,6 +126,10 @@ void CalibTOF::run(int flag, int sector)
 
   Int_t currTOFInfoTreeEntry = -1;
 
+  if (!mTreeCollectedCalibInfoTOF) {
+    LOG(FATAL) << "Input tree with collected TOF calib infos is not set";
+  }
+
   std::vector<o2::dataformats::CalibInfoTOFshort>* localCalibInfoTOF = nullptr;
   TFile fOpenLocally(mTreeCollectedCalibInfoTOF->GetCurrentFile()->GetName());
   TTree* localTree = (TTree*)fOpenLocally.Get(mTreeCollectedCalibInfoTOF->GetName());
@@ -136,7 +149,7 @@ void CalibTOF::run(int flag, int sector)
 
   if (flag & kLHCphase) {                                                // LHC phase --> we will use all the entries in the tree
     while (loadTOFCollectedCalibInfo(localTree, currTOFInfoTreeEntry)) { // fill here all histos you need
-      fillLHCphaseCalibInput(localCalibInfoTOF);                         // we will fill the input for the LHC phase calibration
+      fillLHCphaseCalibInput(*localCalibInfoTOF);                        // we will fill the input for the LHC phase calibration
     }
     doLHCPhaseCalib();
   }
@@ -145,7 +158,7 @@ void CalibTOF::run(int flag, int sector)
     TH1F* histoChOffsetTemp[NPADSPERSTEP];
     std::vector<o2::dataformats::CalibInfoTOFshort>* calibTimePad[NPADSPERSTEP];
     for (int ipad = 0; ipad < NPADSPERSTEP; ipad++) {
-      histoChOffsetTemp[ipad] = new TH1F(Form("OffsetTemp_Sec%02d_Pad%04d", sector, ipad), Form("Sector %02d (pad = %04d);channel offset (ps)", sector, ipad), 1000, -24400, 24400);
+      histoChOffsetTemp[ipad] = new TH1F(Form("OffsetTemp_Sec%02d_Pad%04d", sector, ipad), Form("Sector %02d (pad = %04d);channel offset (ps)", sector, ipad), NBINSCHOFFSET, MINCHOFFSET, MAXCHOFFSET);
       if (flag & kChannelTimeSlewing)
         calibTimePad[ipad] = new std::vector<o2::dataformats::CalibInfoTOFshort>; // temporary array containing [time, tot] for every pad that we process; this will be the input for the 2D histo for timeSlewing calibration (to be filled after we get the channel offset)
       else
@@ -293,7 +306,7 @@ bool CalibTOF::loadTOFCollectedCalibInfo(TTree* localTree, int& currententry, in
 
 //______________________________________________
 
-void CalibTOF::fillLHCphaseCalibInput(std::vector<o2::dataformats::CalibInfoTOFshort>* calibinfotof)
+void CalibTOF::fillLHCphaseCalibInput(gsl::span<const o2::dataformats::CalibInfoTOFshort> calibinfotof)
 {
 
   // we will fill the input for the LHC phase calibration
@@ -301,7 +314,7 @@ void CalibTOF::fillLHCphaseCalibInput(std::vector<o2::dataformats::CalibInfoTOFs
   static double bc = 1.e13 / o2::constants::lhc::LHCRFFreq; // bunch crossing period (ps)
   static double bc_inv = 1. / bc;
 
-  for (auto infotof = calibinfotof->begin(); infotof != calibinfotof->end(); infotof++) {
+  for (auto infotof = calibinfotof.begin(); infotof != calibinfotof.end(); infotof++) {
     double dtime = infotof->getDeltaTimePi();
     dtime -= int(dtime * bc_inv + 0.5) * bc;
 
@@ -544,6 +557,208 @@ Int_t CalibTOF::FitPeak(TF1* fitFunc, TH1* h, Float_t startSigma, Float_t nSigma
 }
 //______________________________________________
 
+void CalibTOF::addChannelCalibInfo(int channel, gsl::span<const o2::dataformats::CalibInfoTOFshort> calibinfotof)
+{
+  // accumulate the calib infos of one channel (online mode)
+
+  if (!mInitDone) {
+    LOG(FATAL) << "init() was not done yet";
+  }
+  for (const auto& infotof : calibinfotof) {
+    fillOnlineCalibInput(channel, infotof.getTimestamp(), infotof.getDeltaTimePi(), infotof.getTot());
+  }
+}
+//______________________________________________
+
+void CalibTOF::addCalibInfo(gsl::span<const o2::dataformats::CalibInfoTOF> calibinfotof)
+{
+  // accumulate calib infos of any channel (online mode)
+
+  if (!mInitDone) {
+    LOG(FATAL) << "init() was not done yet";
+  }
+  for (const auto& infotof : calibinfotof) {
+    fillOnlineCalibInput(infotof.getTOFChIndex(), infotof.getTimestamp(), infotof.getDeltaTimePi(), infotof.getTot());
+  }
+}
+//______________________________________________
+
+void CalibTOF::fillOnlineCalibInput(int channel, int timestamp, float deltaTimePi, float tot)
+{
+  // the same input as fillLHCphaseCalibInput and fillChannelCalibInput, in compact per channel arrays
+
+  static double bc = 1.e13 / o2::constants::lhc::LHCRFFreq; // bunch crossing period (ps)
+  static double bc_inv = 1. / bc;
+  static double binWidth_inv = NBINSCHOFFSET / (MAXCHOFFSET - MINCHOFFSET);
+
+  if (channel < 0 || channel >= o2::tof::Geo::NCHANNELS) {
+    LOG(ERROR) << "Invalid TOF channel " << channel << " in calib info (skipped)";
+    return;
+  }
+
+  if (mOnlineFlag & kLHCphase) {
+    double dtime = deltaTimePi;
+    dtime -= int(dtime * bc_inv + 0.5) * bc;
+    mHistoLHCphase->Fill(dtime, timestamp);
+  }
+
+  if (!(mOnlineFlag & kChannelOffset) && !(mOnlineFlag & kChannelTimeSlewing)) {
+    return;
+  }
+  if (mOnlineChannelInput.empty()) {
+    mOnlineChannelInput.resize(o2::tof::Geo::NCHANNELS);
+  }
+  auto& input = mOnlineChannelInput[channel];
+  if (input.offsetHisto.empty()) {
+    input.offsetHisto.resize(NBINSCHOFFSET);
+  }
+
+  double dtime = deltaTimePi - mInitialCalibChannelOffset[channel]; // removing existing offset
+  dtime -= int(dtime * bc_inv + 0.5) * bc;
+  int bin = int((dtime - MINCHOFFSET) * binWidth_inv);
+  if (bin >= 0 && bin < NBINSCHOFFSET && input.offsetHisto[bin] < std::numeric_limits<uint16_t>::max()) {
+    input.offsetHisto[bin]++;
+  }
+  input.entries++;
+  if (mOnlineFlag & kChannelTimeSlewing) {
+    input.timeSlewingInput.emplace_back(tot, deltaTimePi);
+  }
+}
+//______________________________________________
+
+void CalibTOF::runOnline(int nThreads)
+{
+  ///< calibrate with the input accumulated in online mode
+
+  if (!mInitDone) {
+    LOG(FATAL) << "init() was not done yet";
+  }
+
+  TStopwatch timerTot;
+  timerTot.Start();
+
+  if (mOnlineFlag & kLHCphase) {
+    doLHCPhaseCalib();
+  }
+
+  if (((mOnlineFlag & kChannelOffset) || (mOnlineFlag & kChannelTimeSlewing)) && !mOnlineChannelInput.empty()) {
+    // the channels are independent of each other, each worker takes the next chunk of unprocessed channels
+    // with its own histograms and fit function; the time slewing points are added to the output in channel order
+    // afterwards since the output object requires them in increasing order
+    nThreads = std::max(nThreads, 1);
+    if (nThreads > 1) {
+      ROOT::EnableThreadSafety();
+    }
+    std::vector<std::unique_ptr<TH1F>> histoOffset;
+    std::vector<std::unique_ptr<TF1>> funcOffset;
+    std::vector<std::unique_ptr<TH2F>> histoTimeSlewing;
+    std::vector<std::unique_ptr<TH2F>> histoTimeSlewingAll;
+    for (int ithread = 0; ithread < nThreads; ithread++) {
+      histoOffset.emplace_back(new TH1F(Form("OffsetOnline_%02d", ithread), ";channel offset (ps)", NBINSCHOFFSET, MINCHOFFSET, MAXCHOFFSET));
+      funcOffset.emplace_back(new TF1(Form("fTOFchOffsetOnline_%02d", ithread), "gaus"));
+      if (mOnlineFlag & kChannelTimeSlewing) {
+        histoTimeSlewing.emplace_back(new TH2F(Form("hTOFchTimeSlewingOnline_%02d", ithread), ";tot (ns);t - t_{exp} - t_{offset} (ps)", 5000, 0., 250., 1000, -24400., 24400.));
+        histoTimeSlewingAll.emplace_back(static_cast<TH2F*>(mHistoChTimeSlewingAll->Clone(Form("hTOFchTimeSlewingAllOnline_%02d", ithread))));
+        histoTimeSlewingAll.back()->Reset();
+      } else {
+        histoTimeSlewing.emplace_back(nullptr);
+        histoTimeSlewingAll.emplace_back(nullptr);
+      }
+    }
+
+    std::vector<std::vector<std::pair<float, float>>> timeSlewingPoints(o2::tof::Geo::NCHANNELS);
+    std::atomic<int> nextChannel{ 0 };
+    auto worker = [&](int ithread) {
+      for (int ich = nextChannel.fetch_add(NPADSPERSTEP); ich < o2::tof::Geo::NCHANNELS; ich = nextChannel.fetch_add(NPADSPERSTEP)) {
+        for (int ipad = ich; ipad < std::min(ich + NPADSPERSTEP, int(o2::tof::Geo::NCHANNELS)); ipad++) {
+          doOnlineChannelCalibration(ipad, histoOffset[ithread].get(), funcOffset[ithread].get(), histoTimeSlewing[ithread].get(),
+                                     histoTimeSlewingAll[ithread].get(), timeSlewingPoints[ipad]);
+        }
+      }
+    };
+    std::vector<std::thread> threads;
+    for (int ithread = 1; ithread < nThreads; ithread++) {
+      threads.emplace_back(worker, ithread);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (int ich = 0; ich < o2::tof::Geo::NCHANNELS; ich++) {
+      for (const auto& point : timeSlewingPoints[ich]) {
+        mTimeSlewingObj->addTimeSlewingInfo(ich, point.first, point.second);
+      }
+    }
+    for (auto& histo : histoTimeSlewingAll) {
+      if (histo) {
+        mHistoChTimeSlewingAll->Add(histo.get());
+      }
+    }
+  }
+
+  timerTot.Stop();
+  printf("Timing online calibration (%i threads):\n", nThreads);
+  printf("Total:        ");
+  timerTot.Print();
+}
+//______________________________________________
+
+void CalibTOF::doOnlineChannelCalibration(int ich, TH1F* histoOffset, TF1* func, TH2F* histoTimeSlewing, TH2F* histoTimeSlewingAll,
+                                          std::vector<std::pair<float, float>>& timeSlewingPoints)
+{
+  // calibrate a single channel from the online input, as done in run() for the input from the tree
+
+  static double bc = 1.e13 / o2::constants::lhc::LHCRFFreq; // bunch crossing period (ps)
+  static double bc_inv = 1. / bc;
+
+  auto& input = mOnlineChannelInput[ich];
+  if (input.entries <= 30) {
+    return;
+  }
+
+  int sector = ich / o2::tof::Geo::NPADSXSECTOR;
+  int channelInSector = ich % o2::tof::Geo::NPADSXSECTOR;
+
+  histoOffset->Reset();
+  histoOffset->SetName(Form("OffsetOnline_Sec%02d_Pad%04d", sector, channelInSector));
+  for (int ibin = 0; ibin < NBINSCHOFFSET; ibin++) {
+    histoOffset->SetBinContent(ibin + 1, input.offsetHisto[ibin]);
+  }
+  histoOffset->SetEntries(input.entries);
+
+  float fractionUnderPeak = doChannelCalibration(ich, histoOffset, func);
+  mCalibChannelOffset[ich] = func->GetParameter(1) + mInitialCalibChannelOffset[ich];
+
+  mTimeSlewingObj->setFractionUnderPeak(sector, channelInSector, fractionUnderPeak);
+  mTimeSlewingObj->setSigmaPeak(sector, channelInSector, func->GetParameter(2));
+  mTimeSlewingObj->setSigmaErrPeak(sector, channelInSector, func->GetParError(2));
+
+  if (mOnlineFlag & kChannelTimeSlewing) {
+    histoTimeSlewing->Reset();
+    histoTimeSlewing->SetName(Form("TimeSlewing_Sec%02d_Pad%04d", sector, channelInSector));
+    for (const auto& totTime : input.timeSlewingInput) {
+      double dtime = totTime.second - mCalibChannelOffset[ich]; // removing the already calculated offset
+      dtime -= int(dtime * bc_inv + 0.5) * bc;
+      histoTimeSlewing->Fill(TMath::Min(double(totTime.first), 249.9), dtime);
+      histoTimeSlewingAll->Fill(totTime.first, dtime);
+    }
+
+    TGraphErrors* gTimeVsTot = processSlewing(histoTimeSlewing, 1, func);
+    if (gTimeVsTot && gTimeVsTot->GetN()) {
+      for (int itot = 0; itot < gTimeVsTot->GetN(); itot++) {
+        timeSlewingPoints.emplace_back(gTimeVsTot->GetX()[itot], gTimeVsTot->GetY()[itot] + mCalibChannelOffset[ich]);
+      }
+    } else { // just add the channel offset
+      timeSlewingPoints.emplace_back(0, mCalibChannelOffset[ich]);
+    }
+    delete gTimeVsTot;
+  } else if (mOnlineFlag & kChannelOffset) {
+    timeSlewingPoints.emplace_back(0, mCalibChannelOffset[ich]);
+  }
+}
+//______________________________________________
+
 void CalibTOF::merge(const char* name)
 {
   TFile* f = TFile::Open(name);
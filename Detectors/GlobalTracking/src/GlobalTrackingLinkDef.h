@@ -18,6 +18,8 @@
 #pragma link C++ class o2::globaltracking::MatchTOF + ;
 #pragma link C++ class o2::globaltracking::CalibTOF + ;
 #pragma link C++ class o2::globaltracking::CollectCalibInfoTOF + ;
+#pragma link C++ class o2::globaltracking::PrimaryVertexer + ;
+#pragma link C++ class o2::globaltracking::V0Finder + ;
 #pragma link C++ class o2::globaltracking::timeBracket + ;
 #pragma link C++ class o2::globaltracking::TrackLocTPC + ;
 #pragma link C++ class o2::globaltracking::TrackLocITS + ;
@@ -8,7 +8,9 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include <TTree.h>
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 
 #include "FairLogger.h"
 #include "Field/MagneticField.h"
@@ -53,16 +55,23 @@ void MatchTOF::run()
 
   mTimerTot.Start();
 
+  if (!mInputTreeTracks) { // inputs of a single timeframe are provided directly
+    mCurrTracksTreeEntry = mCurrTOFClustersTreeEntry = -1;
+    mMCTruthON = (mTOFClusLabels && mTPCLabels.size() && mITSLabels.size());
+  }
+
   // we load all TOF clusters (to be checked if we need to split per time frame)
   prepareTOFClusters();
 
   // we do the matching per entry of the TPCITS matched tracks tree
-  while (mCurrTracksTreeEntry + 1 < mInputTreeTracks->GetEntries()) { // we add "+1" because mCurrTracksTreeEntry starts from -1, and it is incremented in loadTracksNextChunk which is called by prepareTracks
+  int nTracksEntries = mInputTreeTracks ? mInputTreeTracks->GetEntries() : 1;
+  while (mCurrTracksTreeEntry + 1 < nTracksEntries) { // we add "+1" because mCurrTracksTreeEntry starts from -1, and it is incremented in loadTracksNextChunk which is called by prepareTracks
     LOG(DEBUG) << "Number of entries in track tree = " << mCurrTracksTreeEntry;
     mMatchedTracks.clear();
     mOutTOFLabels.clear();
     mOutTPCLabels.clear();
     mOutITSLabels.clear();
+    mCalibInfoTOF.clear();
     prepareTracks();
 
     /* Uncomment for local debug 
@@ -96,7 +105,8 @@ void MatchTOF::run()
       printCandidatesTOF();
       mTimerTot.Start(false);
     }
-    mOutputTree->Fill();
+    if (mOutputTree)
+      mOutputTree->Fill();
     if (mOutputTreeCalib)
       mOutputTreeCalib->Fill();
   }
@@ -107,6 +117,7 @@ void MatchTOF::run()
 #endif
 
   mTimerTot.Stop();
+  LOG(INFO) << "Tested " << mNCandidatesTested << " TOF cluster candidates for " << mNTracksTested << " tracks";
   printf("Timing:\n");
   printf("Total:        ");
   mTimerTot.Print();
@@ -122,7 +133,11 @@ void MatchTOF::init()
     return;
   }
 
-  attachInputTrees();
+  if (mInputTreeTracks || mTreeTPCTracks || mTreeTOFClusters) {
+    attachInputTrees();
+  } else {
+    LOG(INFO) << "Input trees are not attached, the inputs must be provided for every timeframe";
+  }
 
   // create output branch with track-tof matching
   if (mOutputTree) {
@@ -139,7 +154,7 @@ void MatchTOF::init()
     }
 
   } else {
-    LOG(ERROR) << "Output tree is not attached, matched tracks will not be stored";
+    LOG(INFO) << "Output tree is not attached, matched tracks of the last tracks entry are kept in memory";
   }
 
   // create output branch for calibration info
@@ -230,19 +245,20 @@ void MatchTOF::attachInputTrees()
 
   // is there MC info available ?
   if (mTreeTOFClusters->GetBranch(mTOFMCTruthBranchName.data())) {
-    mTreeTOFClusters->SetBranchAddress(mTOFMCTruthBranchName.data(), &mTOFClusLabels);
+    mTreeTOFClusters->SetBranchAddress(mTOFMCTruthBranchName.data(), &mTOFClusLabelsInp);
+    mTOFClusLabels = mTOFClusLabelsInp;
     LOG(INFO) << "Found TOF Clusters MCLabels branch " << mTOFMCTruthBranchName;
   }
   if (mInputTreeTracks->GetBranch(mTPCMCTruthBranchName.data())) {
-    mInputTreeTracks->SetBranchAddress(mTPCMCTruthBranchName.data(), &mTPCLabels);
+    mInputTreeTracks->SetBranchAddress(mTPCMCTruthBranchName.data(), &mTPCLabelsInp);
     LOG(INFO) << "Found TPC tracks MCLabels branch " << mTPCMCTruthBranchName.data();
   }
   if (mInputTreeTracks->GetBranch(mITSMCTruthBranchName.data())) {
-    mInputTreeTracks->SetBranchAddress(mITSMCTruthBranchName.data(), &mITSLabels);
+    mInputTreeTracks->SetBranchAddress(mITSMCTruthBranchName.data(), &mITSLabelsInp);
     LOG(INFO) << "Found ITS tracks MCLabels branch " << mITSMCTruthBranchName.data();
   }
 
-  mMCTruthON = (mTOFClusLabels && mTPCLabels && mITSLabels);
+  mMCTruthON = (mTOFClusLabelsInp && mTPCLabelsInp && mITSLabelsInp);
   mCurrTracksTreeEntry = -1;
   mCurrTOFClustersTreeEntry = -1;
 }
@@ -256,7 +272,7 @@ bool MatchTOF::prepareTracks()
     return false;
   }
 
-  mNumOfTracks = mTracksArrayInp->size();
+  mNumOfTracks = mTracksArray.size();
   if (mNumOfTracks == 0)
     return false; // no tracks to be matched
   mMatchedTracksIndex.resize(mNumOfTracks);
@@ -281,7 +297,7 @@ bool MatchTOF::prepareTracks()
   Printf("\n\nWe have %d tracks to try to match to TOF", mNumOfTracks);
   int nNotPropagatedToTOF = 0;
   for (int it = 0; it < mNumOfTracks; it++) {
-    o2::dataformats::TrackTPCITS& trcOrig = (*mTracksArrayInp)[it]; // TODO: check if we cannot directly use the o2::track::TrackParCov class instead of o2::dataformats::TrackTPCITS, and then avoid the casting below; this is the track at the vertex
+    const auto& trcOrig = mTracksArray[it]; // TODO: check if we cannot directly use the o2::track::TrackParCov class instead of o2::dataformats::TrackTPCITS, and then avoid the casting below; this is the track at the vertex
     std::array<float, 3> globalPos;
 
     // create working copy of track param
@@ -380,11 +396,11 @@ bool MatchTOF::prepareTOFClusters()
 
   mNumOfClusters = 0;
   while (loadTOFClustersNextChunk()) {
-    int nClusterInCurrentChunk = mTOFClustersArrayInp->size();
+    int nClusterInCurrentChunk = mTOFClustersArray.size();
     LOG(DEBUG) << "nClusterInCurrentChunk = " << nClusterInCurrentChunk;
     mNumOfClusters += nClusterInCurrentChunk;
     for (int it = 0; it < nClusterInCurrentChunk; it++) {
-      Cluster& clOrig = (*mTOFClustersArrayInp)[it];
+      const Cluster& clOrig = mTOFClustersArray[it];
 
       // create working copy of track param
       mTOFClusWork.emplace_back(clOrig);
@@ -407,6 +423,34 @@ bool MatchTOF::prepareTOFClusters()
     });
   } // loop over TOF clusters of single sector
 
+  // build the (strip, time) index of the clusters of each sector, the time order is kept within each strip
+  for (int sec = o2::constants::math::NSectors; sec--;) {
+    const auto& indexCache = mTOFClusSectIndexCache[sec];
+    auto& stripStart = mTOFClusStripStart[sec];
+    auto& stripIndex = mTOFClusStripIndex[sec];
+    auto& stripTime = mTOFClusStripTime[sec];
+    int nClusters = indexCache.size();
+    std::vector<int> clusterStrip(nClusters);
+    stripStart.assign(Geo::NSTRIPXSECTOR + 1, 0);
+    int indices[5];
+    for (int i = 0; i < nClusters; i++) {
+      Geo::getVolumeIndices(mTOFClusWork[indexCache[i]].getMainContributingChannel(), indices);
+      clusterStrip[i] = Geo::getStripNumberPerSM(indices[1], indices[2]);
+      stripStart[clusterStrip[i] + 1]++;
+    }
+    std::partial_sum(stripStart.begin(), stripStart.end(), stripStart.begin());
+    stripIndex.resize(nClusters);
+    stripTime.resize(nClusters);
+    std::vector<int> stripFill(stripStart.begin(), stripStart.end() - 1);
+    for (int i = 0; i < nClusters; i++) {
+      int pos = stripFill[clusterStrip[i]]++;
+      stripIndex[pos] = i;
+      stripTime[pos] = mTOFClusWork[indexCache[i]].getTime();
+    }
+  }
+  mNTracksTested = 0;
+  mNCandidatesTested = 0;
+
   if (mMatchedClustersIndex)
     delete[] mMatchedClustersIndex;
   mMatchedClustersIndex = new int[mNumOfClusters];
@@ -419,8 +463,16 @@ bool MatchTOF::prepareTOFClusters()
 bool MatchTOF::loadTracksNextChunk()
 {
   ///< load next chunk of tracks to be matched to TOF
+  if (!mInputTreeTracks) { // single chunk provided directly
+    return ++mCurrTracksTreeEntry == 0 && mTracksArray.size();
+  }
   while (++mCurrTracksTreeEntry < mInputTreeTracks->GetEntries()) {
     mInputTreeTracks->GetEntry(mCurrTracksTreeEntry);
+    mTracksArray = gsl::span<const o2::dataformats::TrackTPCITS>(mTracksArrayInp->data(), mTracksArrayInp->size());
+    if (mMCTruthON) {
+      mTPCLabels = gsl::span<const o2::MCCompLabel>(mTPCLabelsInp->data(), mTPCLabelsInp->size());
+      mITSLabels = gsl::span<const o2::MCCompLabel>(mITSLabelsInp->data(), mITSLabelsInp->size());
+    }
     LOG(INFO) << "Loading tracks entry " << mCurrTracksTreeEntry << " -> " << mTracksArrayInp->size()
               << " tracks";
     if (!mTracksArrayInp->size()) {
@@ -435,9 +487,13 @@ bool MatchTOF::loadTracksNextChunk()
 bool MatchTOF::loadTOFClustersNextChunk()
 {
   ///< load next chunk of clusters to be matched to TOF
+  if (!mTreeTOFClusters) { // single chunk provided directly
+    return ++mCurrTOFClustersTreeEntry == 0 && mTOFClustersArray.size();
+  }
   printf("Loading TOF clusters: number of entries in tree = %lld\n", mTreeTOFClusters->GetEntries());
   while (++mCurrTOFClustersTreeEntry < mTreeTOFClusters->GetEntries()) {
     mTreeTOFClusters->GetEntry(mCurrTOFClustersTreeEntry);
+    mTOFClustersArray = gsl::span<const Cluster>(mTOFClustersArrayInp->data(), mTOFClustersArrayInp->size());
     LOG(DEBUG) << "Loading TOF clusters entry " << mCurrTOFClustersTreeEntry << " -> " << mTOFClustersArrayInp->size()
                << " clusters";
     LOG(INFO) << "Loading TOF clusters entry " << mCurrTOFClustersTreeEntry << " -> " << mTOFClustersArrayInp->size()
@@ -476,7 +532,9 @@ void MatchTOF::doMatching(int sec)
   if (!nTracks || !nTOFCls) {
     return;
   }
-  int itof0 = 0;                           // starting index in TOF clusters for matching of the track
+  const auto& stripStart = mTOFClusStripStart[sec];
+  const auto& stripIndex = mTOFClusStripIndex[sec];
+  const auto& stripTime = mTOFClusStripTime[sec];
   int detId[2][5];                         // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the TOF det index
   float deltaPos[2][3];                    // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the residuals
   o2::track::TrackLTIntegral trkLTInt[2];  // Here we store the integrated track length and time for the (max 2) matched strips
@@ -596,7 +654,7 @@ void MatchTOF::doMatching(int sec)
     // uncomment for debug purposes, to check tracks that did not cross any strip
     /*
     if (nStripsCrossedInPropagation == 0) {
-      auto labelTPCNoStripsCrossed = mTPCLabels->at(mTracksSectIndexCache[sec][itrk]);    
+      auto labelTPCNoStripsCrossed = mTPCLabels[mTracksSectIndexCache[sec][itrk]];    
       Printf("The current track (index = %d) never crossed a strip", cacheTrk[itrk]);
       Printf("TrackID = %d, EventID = %d, SourceID = %d", labelTPCNoStripsCrossed.getTrackID(), labelTPCNoStripsCrossed.getEventID(), labelTPCNoStripsCrossed.getSourceID());
       printf("Global coordinates: pos[0] = %f, pos[1] = %f, pos[2] = %f\n", pos[0], pos[1], pos[2]);
@@ -617,21 +675,25 @@ void MatchTOF::doMatching(int sec)
       continue; // the track never hit a TOF strip during the propagation
     }
     bool foundCluster = false;
-    auto labelTPC = (*mTPCLabels)[mTracksSectIndexCache[sec][itrk]];
-    for (auto itof = itof0; itof < nTOFCls; itof++) {
-      //      printf("itof = %d\n", itof);
-      auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
-      // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
-      //Printf("trefTOF.getTime() = %f, maxTrkTime = %f, minTrkTime = %f", trefTOF.getTime(), maxTrkTime, minTrkTime);
-
-      if (trefTOF.getTime() < minTrkTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-        //Printf("In trefTOF.getTime() < minTrkTime");
-        itof0 = itof + 1; // but for the next track that we will check, we will ignore this cluster (the time is anyway too small)
-        continue;
-      }
-      if (trefTOF.getTime() > maxTrkTime) { // no more TOF clusters can be matched to this track
-        break;
+    auto labelTPC = mTPCLabels[mTracksSectIndexCache[sec][itrk]];
+    // the candidates are the clusters in the crossed strips within the time window of the track,
+    // tested in the time order of the sector cache
+    mCandidates.clear();
+    for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation; iPropagation++) {
+      int strip = Geo::getStripNumberPerSM(detId[iPropagation][1], detId[iPropagation][2]);
+      auto timeEnd = stripTime.begin() + stripStart[strip + 1];
+      auto time = std::lower_bound(stripTime.begin() + stripStart[strip], timeEnd, minTrkTime);
+      for (; time != timeEnd && *time <= maxTrkTime; ++time) {
+        mCandidates.emplace_back(stripIndex[time - stripTime.begin()], iPropagation);
       }
+    }
+    std::sort(mCandidates.begin(), mCandidates.end());
+    mNTracksTested++;
+    mNCandidatesTested += mCandidates.size();
+    for (const auto& candidate : mCandidates) {
+      const int itof = candidate.first;
+      const int iPropagation = candidate.second;
+      auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
 
       int mainChannel = trefTOF.getMainContributingChannel();
       int indices[5];
@@ -640,49 +702,47 @@ void MatchTOF::doMatching(int sec)
       int trackIdTOF;
       int eventIdTOF;
       int sourceIdTOF;
-      for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation; iPropagation++) {
-        LOG(DEBUG) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
-        LOG(DEBUG) << "Propagated Track [" << itrk << ", " << cacheTrk[itrk] << "]: detId[" << iPropagation << "]  = " << detId[iPropagation][0] << ", " << detId[iPropagation][1] << ", " << detId[iPropagation][2] << ", " << detId[iPropagation][3] << ", " << detId[iPropagation][4];
-        float resX = deltaPos[iPropagation][0] - (indices[4] - detId[iPropagation][4]) * Geo::XPAD; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-        float resZ = deltaPos[iPropagation][2] - (indices[3] - detId[iPropagation][3]) * Geo::ZPAD; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-        float res = TMath::Sqrt(resX * resX + resZ * resZ);
-        LOG(DEBUG) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
+      LOG(DEBUG) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
+      LOG(DEBUG) << "Propagated Track [" << itrk << ", " << cacheTrk[itrk] << "]: detId[" << iPropagation << "]  = " << detId[iPropagation][0] << ", " << detId[iPropagation][1] << ", " << detId[iPropagation][2] << ", " << detId[iPropagation][3] << ", " << detId[iPropagation][4];
+      float resX = deltaPos[iPropagation][0] - (indices[4] - detId[iPropagation][4]) * Geo::XPAD; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+      float resZ = deltaPos[iPropagation][2] - (indices[3] - detId[iPropagation][3]) * Geo::ZPAD; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+      float res = TMath::Sqrt(resX * resX + resZ * resZ);
+      LOG(DEBUG) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
 #ifdef _ALLOW_DEBUG_TREES_
-        fillTOFmatchTree("match0", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
+      fillTOFmatchTree("match0", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
 #endif
-        int tofLabelTrackID[3] = { -1, -1, -1 };
-        int tofLabelEventID[3] = { -1, -1, -1 };
-        int tofLabelSourceID[3] = { -1, -1, -1 };
+      int tofLabelTrackID[3] = { -1, -1, -1 };
+      int tofLabelEventID[3] = { -1, -1, -1 };
+      int tofLabelSourceID[3] = { -1, -1, -1 };
+      for (int ilabel = 0; ilabel < labelsTOF.size(); ilabel++) {
+        tofLabelTrackID[ilabel] = labelsTOF[ilabel].getTrackID();
+        tofLabelEventID[ilabel] = labelsTOF[ilabel].getEventID();
+        tofLabelSourceID[ilabel] = labelsTOF[ilabel].getSourceID();
+      }
+      //auto labelTPC = mTPCLabels->at(mTracksSectIndexCache[indices[0]][itrk]);
+      auto labelITS = mITSLabels[mTracksSectIndexCache[indices[0]][itrk]];
+      fillTOFmatchTreeWithLabels("matchPossibleWithLabels", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, labelTPC.getTrackID(), labelTPC.getEventID(), labelTPC.getSourceID(), labelITS.getTrackID(), labelITS.getEventID(), labelITS.getSourceID(), tofLabelTrackID[0], tofLabelEventID[0], tofLabelSourceID[0], tofLabelTrackID[1], tofLabelEventID[1], tofLabelSourceID[1], tofLabelTrackID[2], tofLabelEventID[2], tofLabelSourceID[2], trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
+      if (indices[0] != detId[iPropagation][0])
+        continue;
+      if (indices[1] != detId[iPropagation][1])
+        continue;
+      if (indices[2] != detId[iPropagation][2])
+        continue;
+      float chi2 = res; // TODO: take into account also the time!
+      fillTOFmatchTree("match1", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
+
+      fillTOFmatchTreeWithLabels("matchOkWithLabels", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, labelTPC.getTrackID(), labelTPC.getEventID(), labelTPC.getSourceID(), labelITS.getTrackID(), labelITS.getEventID(), labelITS.getSourceID(), tofLabelTrackID[0], tofLabelEventID[0], tofLabelSourceID[0], tofLabelTrackID[1], tofLabelEventID[1], tofLabelSourceID[1], tofLabelTrackID[2], tofLabelEventID[2], tofLabelSourceID[2], trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
+
+      if (res < mSpaceTolerance) { // matching ok!
+        LOG(DEBUG) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[indices[0]][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
+        foundCluster = true;
+        mMatchedTracksPairs.emplace_back(std::make_pair(mTracksSectIndexCache[indices[0]][itrk], o2::dataformats::MatchInfoTOF(mTOFClusSectIndexCache[indices[0]][itof], chi2, trkLTInt[iPropagation]))); // TODO: check if this is correct!
         for (int ilabel = 0; ilabel < labelsTOF.size(); ilabel++) {
-          tofLabelTrackID[ilabel] = labelsTOF[ilabel].getTrackID();
-          tofLabelEventID[ilabel] = labelsTOF[ilabel].getEventID();
-          tofLabelSourceID[ilabel] = labelsTOF[ilabel].getSourceID();
-        }
-        //auto labelTPC = mTPCLabels->at(mTracksSectIndexCache[indices[0]][itrk]);
-        auto labelITS = (*mITSLabels)[mTracksSectIndexCache[indices[0]][itrk]];
-        fillTOFmatchTreeWithLabels("matchPossibleWithLabels", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, labelTPC.getTrackID(), labelTPC.getEventID(), labelTPC.getSourceID(), labelITS.getTrackID(), labelITS.getEventID(), labelITS.getSourceID(), tofLabelTrackID[0], tofLabelEventID[0], tofLabelSourceID[0], tofLabelTrackID[1], tofLabelEventID[1], tofLabelSourceID[1], tofLabelTrackID[2], tofLabelEventID[2], tofLabelSourceID[2], trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
-        if (indices[0] != detId[iPropagation][0])
-          continue;
-        if (indices[1] != detId[iPropagation][1])
-          continue;
-        if (indices[2] != detId[iPropagation][2])
-          continue;
-        float chi2 = res; // TODO: take into account also the time!
-        fillTOFmatchTree("match1", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
-
-        fillTOFmatchTreeWithLabels("matchOkWithLabels", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, labelTPC.getTrackID(), labelTPC.getEventID(), labelTPC.getSourceID(), labelITS.getTrackID(), labelITS.getEventID(), labelITS.getSourceID(), tofLabelTrackID[0], tofLabelEventID[0], tofLabelSourceID[0], tofLabelTrackID[1], tofLabelEventID[1], tofLabelSourceID[1], tofLabelTrackID[2], tofLabelEventID[2], tofLabelSourceID[2], trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
-
-        if (res < mSpaceTolerance) { // matching ok!
-          LOG(DEBUG) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[indices[0]][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
-          foundCluster = true;
-          mMatchedTracksPairs.emplace_back(std::make_pair(mTracksSectIndexCache[indices[0]][itrk], o2::dataformats::MatchInfoTOF(mTOFClusSectIndexCache[indices[0]][itof], chi2, trkLTInt[iPropagation]))); // TODO: check if this is correct!
-          for (int ilabel = 0; ilabel < labelsTOF.size(); ilabel++) {
-            LOG(DEBUG) << "TOF label " << ilabel << ": trackID = " << labelsTOF[ilabel].getTrackID() << ", eventID = " << labelsTOF[ilabel].getEventID() << ", sourceID = " << labelsTOF[ilabel].getSourceID();
-          }
-          LOG(DEBUG) << "TPC label of the track: trackID = " << labelTPC.getTrackID() << ", eventID = " << labelTPC.getEventID() << ", sourceID = " << labelTPC.getSourceID();
-          LOG(DEBUG) << "ITS label of the track: trackID = " << labelITS.getTrackID() << ", eventID = " << labelITS.getEventID() << ", sourceID = " << labelITS.getSourceID();
-          fillTOFmatchTreeWithLabels("matchOkWithLabelsInSpaceTolerance", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, labelTPC.getTrackID(), labelTPC.getEventID(), labelTPC.getSourceID(), labelITS.getTrackID(), labelITS.getEventID(), labelITS.getSourceID(), tofLabelTrackID[0], tofLabelEventID[0], tofLabelSourceID[0], tofLabelTrackID[1], tofLabelEventID[1], tofLabelSourceID[1], tofLabelTrackID[2], tofLabelEventID[2], tofLabelSourceID[2], trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
+          LOG(DEBUG) << "TOF label " << ilabel << ": trackID = " << labelsTOF[ilabel].getTrackID() << ", eventID = " << labelsTOF[ilabel].getEventID() << ", sourceID = " << labelsTOF[ilabel].getSourceID();
         }
+        LOG(DEBUG) << "TPC label of the track: trackID = " << labelTPC.getTrackID() << ", eventID = " << labelTPC.getEventID() << ", sourceID = " << labelTPC.getSourceID();
+        LOG(DEBUG) << "ITS label of the track: trackID = " << labelITS.getTrackID() << ", eventID = " << labelITS.getEventID() << ", sourceID = " << labelITS.getSourceID();
+        fillTOFmatchTreeWithLabels("matchOkWithLabelsInSpaceTolerance", cacheTOF[itof], indices[0], indices[1], indices[2], indices[3], indices[4], cacheTrk[itrk], iPropagation, detId[iPropagation][0], detId[iPropagation][1], detId[iPropagation][2], detId[iPropagation][3], detId[iPropagation][4], resX, resZ, res, trackWork, labelTPC.getTrackID(), labelTPC.getEventID(), labelTPC.getSourceID(), labelITS.getTrackID(), labelITS.getEventID(), labelITS.getSourceID(), tofLabelTrackID[0], tofLabelEventID[0], tofLabelSourceID[0], tofLabelTrackID[1], tofLabelEventID[1], tofLabelSourceID[1], tofLabelTrackID[2], tofLabelEventID[2], tofLabelSourceID[2], trkLTInt[iPropagation].getL(), trkLTInt[iPropagation].getTOF(o2::track::PID::Pion), trefTOF.getTime());
       }
     }
     if (!foundCluster)
@@ -717,9 +777,9 @@ void MatchTOF::selectBestMatches()
                                mTOFClusWork[matchingPair.second.getTOFClIndex()].getTimeRaw() - matchingPair.second.getLTIntegralOut().getTOF(o2::track::PID::Pion),
                                mTOFClusWork[matchingPair.second.getTOFClIndex()].getTot());
 
-    const auto& labelTPC = (*mTPCLabels)[matchingPair.first];
+    const auto& labelTPC = mTPCLabels[matchingPair.first];
     LOG(DEBUG) << "labelTPC: trackID = " << labelTPC.getTrackID() << ", eventID = " << labelTPC.getEventID() << ", sourceID = " << labelTPC.getSourceID();
-    const auto& labelITS = (*mITSLabels)[matchingPair.first];
+    const auto& labelITS = mITSLabels[matchingPair.first];
     LOG(DEBUG) << "labelITS: trackID = " << labelITS.getTrackID() << ", eventID = " << labelITS.getEventID() << ", sourceID = " << labelITS.getSourceID();
     const auto& labelsTOF = mTOFClusLabels->getLabels(matchingPair.second.getTOFClIndex());
     bool labelOk = false; // whether we have found or not the same TPC label of the track among the labels of the TOF cluster
@@ -8,7 +8,10 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include <TTree.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <thread>
 
 #include "FairLogger.h"
 #include "Field/MagneticField.h"
@@ -57,6 +60,14 @@ void MatchTPCITS::run()
 
   mTimerTot.Start();
 
+  if (!mTreeITSTracks) { // inputs of a single timeframe are provided directly
+    mCurrITSTracksTreeEntry = mCurrTPCTracksTreeEntry = -1;
+    mMCTruthON = (mITSTrkLabels && mTPCTrkLabels);
+  }
+  mMatchedTracks.clear();
+  mOutITSLabels.clear();
+  mOutTPCLabels.clear();
+
   prepareTPCTracks();
   prepareITSTracks();
   for (int sec = o2::constants::math::NSectors; sec--;) {
@@ -135,7 +146,11 @@ void MatchTPCITS::init()
   mTPCClusterParam = std::make_unique<AliGPUCAParam>();
   mTPCClusterParam->SetDefaults(o2::base::Propagator::Instance()->getNominalBz()); // TODO this may change
 
-  attachInputTrees();
+  if (mTreeITSTracks || mTreeTPCTracks || mTreeITSClusters || mTPCClusterReader) {
+    attachInputTrees();
+  } else {
+    LOG(INFO) << "Input trees are not attached, the inputs must be provided for every timeframe";
+  }
 
   // create output branch
   if (mOutputTree) {
@@ -149,7 +164,7 @@ void MatchTPCITS::init()
       LOG(INFO) << "TPC Tracks Labels branch: " << mOutTPCMCTruthBranchName;
     }
   } else {
-    LOG(ERROR) << "Output tree is not attached, matched tracks will not be stored";
+    LOG(INFO) << "Output tree is not attached, matched tracks of every run are kept in memory";
   }
 
 #ifdef _ALLOW_DEBUG_TREES_
@@ -313,12 +328,14 @@ void MatchTPCITS::attachInputTrees()
 
   // is there MC info available ?
   if (mTreeITSTracks->GetBranch(mITSMCTruthBranchName.data())) {
-    mTreeITSTracks->SetBranchAddress(mITSMCTruthBranchName.data(), &mITSTrkLabels);
+    mTreeITSTracks->SetBranchAddress(mITSMCTruthBranchName.data(), &mITSTrkLabelsInp);
+    mITSTrkLabels = mITSTrkLabelsInp;
     LOG(INFO) << "Found ITS Track MCLabels branch " << mITSMCTruthBranchName;
   }
   // is there MC info available ?
   if (mTreeTPCTracks->GetBranch(mTPCMCTruthBranchName.data())) {
-    mTreeTPCTracks->SetBranchAddress(mTPCMCTruthBranchName.data(), &mTPCTrkLabels);
+    mTreeTPCTracks->SetBranchAddress(mTPCMCTruthBranchName.data(), &mTPCTrkLabelsInp);
+    mTPCTrkLabels = mTPCTrkLabelsInp;
     LOG(INFO) << "Found TPC Track MCLabels branch " << mTPCMCTruthBranchName;
   }
 
@@ -331,13 +348,14 @@ void MatchTPCITS::attachInputTrees()
 bool MatchTPCITS::prepareTPCTracks()
 {
   ///< load next chunk of TPC data and prepare for matching
+  mMatchesTPC.clear();
   mMatchRecordsTPC.clear();
 
   if (!loadTPCTracksNextChunk()) {
     return false;
   }
 
-  int ntr = mTPCTracksArrayInp->size();
+  int ntr = mTPCTracksArray.size();
 
   mMatchesTPC.reserve(mMatchesTPC.size() + ntr);
   // number of records might be actually more than N tracks!
@@ -358,7 +376,7 @@ bool MatchTPCITS::prepareTPCTracks()
 
   for (int it = 0; it < ntr; it++) {
 
-    o2::TPC::TrackTPC& trcOrig = (*mTPCTracksArrayInp)[it];
+    const auto& trcOrig = mTPCTracksArray[it];
 
     // make sure the track was propagated to inner TPC radius at the ref. radius
     if (trcOrig.getX() > XTPCInnerRef + 0.1)
@@ -444,12 +462,14 @@ bool MatchTPCITS::prepareITSTracks()
   }
   for (int sec = o2::constants::math::NSectors; sec--;) {
     mITSSectIndexCache[sec].clear();
+    mITSTimeBinStart[sec].clear();
+    mITSSectTgl[sec].clear();
   }
 
   while (loadITSTracksNextChunk()) {
-    int ntr = mITSTracksArrayInp->size();
+    int ntr = mITSTracksArray.size();
     for (int it = 0; it < ntr; it++) {
-      auto& trcOrig = (*mITSTracksArrayInp)[it];
+      const auto& trcOrig = mITSTracksArray[it];
 
       if (trcOrig.getParamOut().getX() < 1.) {
         continue; // backward refit failed
@@ -519,20 +539,23 @@ bool MatchTPCITS::prepareITSTracks()
       return trackA.getTgl() < trackB.getTgl();
     });
 
-    // build array of 1st entries with of each ITS RO cycle
+    // build array of 1st entries with of each ITS RO cycle and the contiguous array of tgl
     int nbins = 1 + mITSWork[indexCache.back()].roFrame;
     auto& tbinStart = mITSTimeBinStart[sec];
-    tbinStart.resize(nbins > 1 ? nbins : 1, -1);
-    tbinStart[0] = 0;
+    auto& tglCache = mITSSectTgl[sec];
+    tbinStart.resize(nbins, -1);
+    tglCache.reserve(indexCache.size());
     for (int itr = 0; itr < (int)indexCache.size(); itr++) {
       auto& trc = mITSWork[indexCache[itr]];
       if (tbinStart[trc.roFrame] == -1) {
         tbinStart[trc.roFrame] = itr;
       }
+      tglCache.push_back(trc.getTgl());
     }
-    for (int i = 1; i < nbins; i++) {
-      if (tbinStart[i] == -1) { // fill gaps with preceding indices
-        tbinStart[i] = tbinStart[i - 1];
+    // fill gaps with following indices, so that the tracks of ROFrame i are in [tbinStart[i], tbinStart[i+1])
+    for (int i = nbins - 1; i--;) {
+      if (tbinStart[i] == -1) {
+        tbinStart[i] = tbinStart[i + 1];
       }
     }
   } // loop over tracks of single sector
@@ -546,10 +569,14 @@ bool MatchTPCITS::prepareITSTracks()
 bool MatchTPCITS::loadITSTracksNextChunk()
 {
   ///< load next chunk of ITS data
+  if (!mTreeITSTracks) { // single chunk provided directly
+    return ++mCurrITSTracksTreeEntry == 0 && mITSTracksArray.size();
+  }
   mTimerIO.Start(false);
 
   while (++mCurrITSTracksTreeEntry < mTreeITSTracks->GetEntries()) {
     mTreeITSTracks->GetEntry(mCurrITSTracksTreeEntry);
+    setITSTracksFromTree();
     LOG(DEBUG) << "Loading ITS tracks entry " << mCurrITSTracksTreeEntry << " -> " << mITSTracksArrayInp->size()
                << " tracks";
     if (!mITSTracksArrayInp->size()) {
@@ -567,10 +594,14 @@ bool MatchTPCITS::loadITSTracksNextChunk()
 bool MatchTPCITS::loadTPCTracksNextChunk()
 {
   ///< load next chunk of TPC data
+  if (!mTreeTPCTracks) { // single chunk provided directly
+    return ++mCurrTPCTracksTreeEntry == 0 && mTPCTracksArray.size();
+  }
   mTimerIO.Start(false);
 
   while (++mCurrTPCTracksTreeEntry < mTreeTPCTracks->GetEntries()) {
     mTreeTPCTracks->GetEntry(mCurrTPCTracksTreeEntry);
+    setTPCTracksFromTree();
     LOG(DEBUG) << "Loading TPC tracks entry " << mCurrTPCTracksTreeEntry << " -> " << mTPCTracksArrayInp->size()
                << " tracks";
     if (mTPCTracksArrayInp->size() < 1) {
@@ -593,6 +624,7 @@ void MatchTPCITS::doMatching(int sec)
   auto& cacheTPC = mTPCSectIndexCache[sec];   // array of cached ITS track indices for this sector
   auto& tbinStartTPC = mTPCTimeBinStart[sec]; // array of 1st TPC track with timeMax in ITS ROFrame
   auto& tbinStartITS = mITSTimeBinStart[sec];
+  auto& tglITS = mITSSectTgl[sec];            // tgl of cached ITS tracks, in the order of cacheITS
   int nTracksTPC = cacheTPC.size(), nTracksITS = cacheITS.size();
   if (!nTracksTPC || !nTracksITS) {
     LOG(INFO) << "Matchng sector " << sec << " : N tracks TPC:" << nTracksTPC << " ITS:" << nTracksITS << " in sector "
@@ -623,54 +655,57 @@ void MatchTPCITS::doMatching(int sec)
     if (itsROBin >= int(tbinStartITS.size())) { // time of TPC track exceeds the max time of ITS in the cache
       break;
     }
-    int iits0 = tbinStartITS[itsROBin];
     nCheckTPCControl++;
-    for (auto iits = iits0; iits < nTracksITS; iits++) {
-      auto& trefITS = mITSWork[cacheITS[iits]];
-      // compare if the ITS and TPC tracks may overlap in time
-      if (trefTPC.timeBins.tmax < trefITS.timeBins.tmin) {
+    const float tglTPC = trefTPC.getTgl();
+    const float tglCut = mCrudeAbsDiffCut[o2::track::kTgl];
+    // loop over ITS ROFrames compatible in time and bisect the tracks of each ROFrame in tgl, so that
+    // only the ITS tracks passing the crude tgl cut are compared
+    for (int rof = itsROBin; rof < int(tbinStartITS.size()); rof++) {
+      int iitsMin = tbinStartITS[rof];
+      int iitsMax = rof + 1 < int(tbinStartITS.size()) ? tbinStartITS[rof + 1] : nTracksITS;
+      if (iitsMin == iitsMax) {
+        continue; // empty ROFrame
+      }
+      // all ITS tracks of the ROFrame have the same time bracket
+      const auto& tbITS = mITSWork[cacheITS[iitsMin]].timeBins;
+      if (trefTPC.timeBins.tmax < tbITS.tmin) {
         // since TPC tracks are sorted in timeMax and ITS tracks are sorted in timeMin
         // all following ITS tracks also will not match
         break;
       }
-      if (trefTPC.timeBins.tmin > trefITS.timeBins.tmax) { // its bracket is fully before TPC bracket
+      if (trefTPC.timeBins.tmin > tbITS.tmax) { // its bracket is fully before TPC bracket
         continue;
       }
-      nCheckITSControl++;
-      float chi2 = -1;
-      int rejFlag = compareITSTPCTracks(trefITS, trefTPC, chi2);
+      // 1st ITS track of the ROFrame not rejected with tgl_its < tgl_tpc - tolerance
+      auto tglBeg = tglITS.begin();
+      int iits0 = std::partition_point(tglBeg + iitsMin, tglBeg + iitsMax,
+                                       [tglTPC, tglCut](float tgl) { return tgl - tglTPC < -tglCut; }) -
+                  tglBeg;
+      for (int iits = iits0; iits < iitsMax; iits++) {
+        auto& trefITS = mITSWork[cacheITS[iits]];
+        nCheckITSControl++;
+        float chi2 = -1;
+        int rejFlag = compareITSTPCTracks(trefITS, trefTPC, chi2);
 
 #ifdef _ALLOW_DEBUG_TREES_
-      if (mDBGOut && ((rejFlag == Accept && isDebugFlag(MatchTreeAccOnly)) || isDebugFlag(MatchTreeAll))) {
-        fillITSTPCmatchTree(cacheITS[iits], cacheTPC[itpc], rejFlag, chi2);
-      }
+        if (mDBGOut && ((rejFlag == Accept && isDebugFlag(MatchTreeAccOnly)) || isDebugFlag(MatchTreeAll))) {
+          fillITSTPCmatchTree(cacheITS[iits], cacheTPC[itpc], rejFlag, chi2);
+        }
 #endif
 
-      if (rejFlag == RejectOnTgl) {
-        // ITS tracks in each ROFrame are ordered in Tgl, hence if this check failed on Tgl check
-        // (i.e. tgl_its>tgl_tpc+tolerance), tnem all other ITS tracks in this ROFrame will also have tgl too large.
-        // Jump on the 1st ITS track of the next ROFrame
-        int rof = trefITS.roFrame;
-        bool stop = false;
-        do {
-          if (++rof >= int(tbinStartITS.size())) {
-            stop = true;
-            break; // no more ITS ROFrames in cache
-          }
-          iits = tbinStartITS[rof] - 1;                  // next track to be checked -1
-        } while (iits <= tbinStartITS[trefITS.roFrame]); // skip empty bins
-        if (stop) {
+        if (rejFlag == RejectOnTgl) {
+          // ITS tracks in each ROFrame are ordered in Tgl, hence if this check failed on Tgl check
+          // (i.e. tgl_its>tgl_tpc+tolerance), then all other ITS tracks in this ROFrame will also have tgl too large.
           break;
         }
-        continue;
-      }
-      if (rejFlag != Accept) {
-        continue;
+        if (rejFlag != Accept) {
+          continue;
+        }
+        mTimerReg.Start(false);
+        registerMatchRecordTPC(trefITS, trefTPC, chi2); // register matching candidate
+        mTimerReg.Stop();
+        nMatchesControl++;
       }
-      mTimerReg.Start(false);
-      registerMatchRecordTPC(trefITS, trefTPC, chi2); // register matching candidate
-      mTimerReg.Stop();
-      nMatchesControl++;
     }
   }
 
@@ -1084,33 +1119,87 @@ void MatchTPCITS::refitWinners()
   mTimerRefit.Start(false);
 
   LOG(INFO) << "Refitting winner matches";
+  mWinnerChi2Refit.clear();
   mWinnerChi2Refit.resize(mITSWork.size(), -1.f);
   mCurrITSTracksTreeEntry = -1;
   mCurrITSClustersTreeEntry = -1;
-  for (int iITS = 0; iITS < mITSWork.size(); iITS++) {
-    if (!refitTrackITSTPC(iITS)) {
-      continue;
+
+  // collect the winner pairs of ITS and TPC work tracks, in the order of ITS work tracks
+  std::vector<std::pair<int, int>> winners;
+  for (int iITS = 0; iITS < int(mITSWork.size()); iITS++) {
+    const auto& tITS = mITSWork[iITS];
+    if (tITS.matchID < 0 || isDisabledITS(mMatchesITS[tITS.matchID])) {
+      continue; // no match
+    }
+    const auto& itsMatchRec = mMatchRecordsITS[mMatchesITS[tITS.matchID].first];
+    winners.emplace_back(iITS, mTPCMatch2Track[itsMatchRec.matchID]);
+  }
+
+  std::vector<o2::dataformats::TrackTPCITS> refitted;
+  std::vector<char> refitOK;
+  int nWinners = winners.size();
+  for (int first = 0, last = 0; first < nWinners; first = last) {
+    // consecutive winners using the same input chunks are refitted in parallel
+    int evITS = mITSWork[winners[first].first].source.getEvent();
+    int evTPC = mTPCWork[winners[first].second].source.getEvent();
+    while (++last < nWinners && mITSWork[winners[last].first].source.getEvent() == evITS &&
+           mTPCWork[winners[last].second].source.getEvent() == evTPC) {
+    }
+    loadITSClustersChunk(evITS);
+    loadITSTracksChunk(evITS);
+    loadTPCTracksChunk(evTPC);
+    loadTPCClustersChunk(evTPC);
+
+    int nBlock = last - first;
+    refitted.resize(nBlock);
+    refitOK.assign(nBlock, 0);
+    std::atomic<int> nextWinner{ 0 };
+    auto worker = [this, first, nBlock, &winners, &refitted, &refitOK, &nextWinner]() {
+      for (int i = nextWinner++; i < nBlock; i = nextWinner++) {
+        refitOK[i] = refitTrackITSTPC(winners[first + i].first, winners[first + i].second, refitted[i]);
+      }
+    };
+    std::vector<std::thread> threads;
+    const int nThreads = std::min(mNThreads, nBlock);
+    o2::base::Propagator::setMaxThreads(nThreads); // the propagator gives each thread its own navigator
+    for (int ith = 1; ith < nThreads; ith++) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
     }
-    mWinnerChi2Refit[iITS] = mMatchedTracks.back().getChi2Refit();
-    if (mMatchedTracks.size() == mMaxOutputTracksPerEntry) {
-      if (mOutputTree) {
+
+    // store the refitted tracks in the order of the winners
+    for (int i = 0; i < nBlock; i++) {
+      if (!refitOK[i]) {
+        continue;
+      }
+      int iITS = winners[first + i].first, iTPC = winners[first + i].second;
+      mMatchedTracks.push_back(refitted[i]);
+      mWinnerChi2Refit[iITS] = refitted[i].getChi2Refit();
+      if (mMCTruthON) { // store MC info
+        mOutITSLabels.emplace_back(mITSLblWork[iITS]);
+        mOutTPCLabels.emplace_back(mTPCLblWork[iTPC]);
+      }
+      if (mOutputTree && mMatchedTracks.size() == mMaxOutputTracksPerEntry) {
         mTimerRefit.Stop();
         mOutputTree->Fill();
         mTimerRefit.Start(false);
-      }
-      mMatchedTracks.clear();
-      if (mMCTruthON) {
-        mOutITSLabels.clear();
-        mOutTPCLabels.clear();
+        mMatchedTracks.clear();
+        if (mMCTruthON) {
+          mOutITSLabels.clear();
+          mOutTPCLabels.clear();
+        }
       }
     }
   }
-  // flush last tracks
-  if (mMatchedTracks.size() && mOutputTree) {
-    mOutputTree->Fill();
-  }
-  mMatchedTracks.clear();
-  if (mMCTruthON) {
+  // flush last tracks, without output tree they are kept until the next run
+  if (mOutputTree) {
+    if (mMatchedTracks.size()) {
+      mOutputTree->Fill();
+    }
+    mMatchedTracks.clear();
     mOutITSLabels.clear();
     mOutTPCLabels.clear();
   }
@@ -1118,31 +1207,21 @@ void MatchTPCITS::refitWinners()
 }
 
 //______________________________________________
-bool MatchTPCITS::refitTrackITSTPC(int iITS)
+bool MatchTPCITS::refitTrackITSTPC(int iITS, int iTPC, o2::dataformats::TrackTPCITS& trfit) const
 {
-  ///< refit in inward direction the pair of TPC and ITS tracks
+  ///< refit in inward direction the pair of TPC and ITS tracks, the chunks of both must be loaded.
+  ///< Can be called concurrently, the result is stored in trfit only
 
   const float maxStep = 2.f; // max propagation step (TODO: tune)
   const int matCorr = 1;     // material correction method
 
   const auto& tITS = mITSWork[iITS];
-  if (tITS.matchID < 0 || isDisabledITS(mMatchesITS[tITS.matchID])) {
-    return false; // no match
-  }
-  const auto& itsMatch = mMatchesITS[tITS.matchID];
-  const auto& itsMatchRec = mMatchRecordsITS[itsMatch.first];
-  int iTPC = mTPCMatch2Track[itsMatchRec.matchID];
+  const auto& itsMatchRec = mMatchRecordsITS[mMatchesITS[tITS.matchID].first];
   const auto& tTPC = mTPCWork[iTPC];
 
-  loadITSClustersChunk(tITS.source.getEvent());
-  loadITSTracksChunk(tITS.source.getEvent());
-  loadTPCTracksChunk(tTPC.source.getEvent());
-  loadTPCClustersChunk(tTPC.source.getEvent());
+  const auto& itsTrOrig = mITSTracksArray[tITS.source.getIndex()]; // currently we store clusterIDs in the track
 
-  auto itsTrOrig = (*mITSTracksArrayInp)[tITS.source.getIndex()]; // currently we store clusterIDs in the track
-
-  mMatchedTracks.emplace_back(tTPC, tITS); // create a copy of TPC track at xRef
-  auto& trfit = mMatchedTracks.back();
+  trfit = o2::dataformats::TrackTPCITS(tTPC, tITS); // create a copy of TPC track at xRef
   // in continuos mode the Z of TPC track is meaningless, unless it is CE crossing
   // track (currently absent, TODO)
   if (!mCompareTracksDZ) {
@@ -1157,7 +1236,7 @@ bool MatchTPCITS::refitTrackITSTPC(int iITS)
   auto geom = o2::ITS::GeometryTGeo::Instance();
   auto propagator = o2::base::Propagator::Instance();
   for (int icl = 0; icl < ncl; icl++) {
-    const auto& clus = (*mITSClustersArrayInp)[itsTrOrig.getClusterIndex(icl)];
+    const auto& clus = mITSClustersArray[itsTrOrig.getClusterIndex(icl)];
     float alpha = geom->getSensorRefAlpha(clus.getSensorID()), x = clus.getX();
     if (!trfit.rotate(alpha) ||
         // note: here we also calculate the L,T integral (in the inward direction, but this is irrelevant)
@@ -1180,7 +1259,6 @@ bool MatchTPCITS::refitTrackITSTPC(int iITS)
     tITS.print();
     printf("tpc was:  ");
     tTPC.print();
-    mMatchedTracks.pop_back(); // destroy failed track
     return false;
   }
 
@@ -1192,7 +1270,7 @@ bool MatchTPCITS::refitTrackITSTPC(int iITS)
   }
 
   /// precise time estimate
-  auto tpcTrOrig = (*mTPCTracksArrayInp)[tTPC.source.getIndex()];
+  const auto& tpcTrOrig = mTPCTracksArray[tTPC.source.getIndex()];
   float timeTB = tpcTrOrig.getTime0() - mNTPCBinsFullDrift;
   if (tpcTrOrig.hasASideClustersOnly()) {
     timeTB += deltaT;
@@ -1216,7 +1294,7 @@ bool MatchTPCITS::refitTrackITSTPC(int iITS)
     std::array<float, 3> clsCov = {};
     float clsX;
 
-    const auto& cl = tpcTrOrig.getCluster(icl, mTPCClusterIdxStruct, sector, row);
+    const auto& cl = tpcTrOrig.getCluster(icl, *mTPCClusterIdxStruct, sector, row);
     mTPCTransform->Transform(sector, row, cl.getPad(), cl.getTime() - timeTB, clsX, clsYZ[0], clsYZ[1]);
     // rotate to 1 cluster's sector
     if (!tracOut.rotate(o2::utils::Sector2Angle(sector % 18))) {
@@ -1242,7 +1320,7 @@ bool MatchTPCITS::refitTrackITSTPC(int iITS)
     prevsector = sector;
 
     for (; icl--;) {
-      const auto& cl = tpcTrOrig.getCluster(icl, mTPCClusterIdxStruct, sector, row);
+      const auto& cl = tpcTrOrig.getCluster(icl, *mTPCClusterIdxStruct, sector, row);
       if (row <= prevrow) {
         LOG(WARNING) << "New row/sect " << int(row) << '/' << int(sector) << " is <= the previous " << int(prevrow)
                      << '/' << int(prevsector) << " TrackID: " << tTPC.source.getIndex() << " Pt:" << tracOut.getPt();
@@ -1287,11 +1365,6 @@ bool MatchTPCITS::refitTrackITSTPC(int iITS)
   trfit.setRefTPC(tTPC.source);
   trfit.setRefITS(tITS.source);
 
-  if (mMCTruthON) { // store MC info
-    mOutITSLabels.emplace_back(mITSLblWork[iITS]);
-    mOutTPCLabels.emplace_back(mTPCLblWork[iTPC]);
-  }
-
   //  trfit.print(); // DBG
 
   return true;
@@ -1301,9 +1374,10 @@ bool MatchTPCITS::refitTrackITSTPC(int iITS)
 void MatchTPCITS::loadITSClustersChunk(int chunk)
 {
   // load single entry from ITS clusters tree
-  if (mCurrITSClustersTreeEntry != chunk) {
+  if (mTreeITSClusters && mCurrITSClustersTreeEntry != chunk) {
     mTimerIO.Start(false);
     mTreeITSClusters->GetEntry(mCurrITSClustersTreeEntry = chunk);
+    mITSClustersArray = gsl::span<const o2::itsmft::Cluster>(mITSClustersArrayInp->data(), mITSClustersArrayInp->size());
     mTimerIO.Stop();
   }
 }
@@ -1311,11 +1385,12 @@ void MatchTPCITS::loadITSClustersChunk(int chunk)
 //________________________________________________________
 void MatchTPCITS::loadTPCClustersChunk(int chunk)
 {
-  // load single entry from ITS clusters tree
-  if (mCurrTPCClustersTreeEntry != chunk) {
+  // load single entry from TPC clusters tree
+  if (mTPCClusterReader && mCurrTPCClustersTreeEntry != chunk) {
     mTimerIO.Start(false);
     mTPCClusterReader->read(mCurrTPCClustersTreeEntry = chunk);
-    mTPCClusterReader->fillIndex(mTPCClusterIdxStruct);
+    mTPCClusterReader->fillIndex(mTPCClusterIdxStructOwn);
+    mTPCClusterIdxStruct = &mTPCClusterIdxStructOwn;
     mTimerIO.Stop();
   }
 }
@@ -1324,9 +1399,10 @@ void MatchTPCITS::loadTPCClustersChunk(int chunk)
 void MatchTPCITS::loadITSTracksChunk(int chunk)
 {
   // load single entry from ITS tracks tree
-  if (mCurrITSTracksTreeEntry != chunk) {
+  if (mTreeITSTracks && mCurrITSTracksTreeEntry != chunk) {
     mTimerIO.Start(false);
     mTreeITSTracks->GetEntry(mCurrITSTracksTreeEntry = chunk);
+    setITSTracksFromTree();
     mTimerIO.Stop();
   }
 }
@@ -1335,13 +1411,30 @@ void MatchTPCITS::loadITSTracksChunk(int chunk)
 void MatchTPCITS::loadTPCTracksChunk(int chunk)
 {
   // load single entry from TPC tracks tree
-  if (mCurrTPCTracksTreeEntry != chunk) {
+  if (mTreeTPCTracks && mCurrTPCTracksTreeEntry != chunk) {
     mTimerIO.Start(false);
-    mTreeITSTracks->GetEntry(mCurrTPCTracksTreeEntry = chunk);
+    mTreeTPCTracks->GetEntry(mCurrTPCTracksTreeEntry = chunk);
+    setTPCTracksFromTree();
     mTimerIO.Stop();
   }
 }
 
+//________________________________________________________
+void MatchTPCITS::setITSTracksFromTree()
+{
+  // refer the ITS tracks input to the content of the tree buffers
+  mITSTracksArray = gsl::span<const o2::ITS::TrackITS>(mITSTracksArrayInp->data(), mITSTracksArrayInp->size());
+  mITSTrkLabels = mITSTrkLabelsInp;
+}
+
+//________________________________________________________
+void MatchTPCITS::setTPCTracksFromTree()
+{
+  // refer the TPC tracks input to the content of the tree buffers
+  mTPCTracksArray = gsl::span<const o2::TPC::TrackTPC>(mTPCTracksArrayInp->data(), mTPCTracksArrayInp->size());
+  mTPCTrkLabels = mTPCTrkLabelsInp;
+}
+
 #ifdef _ALLOW_DEBUG_TREES_
 //______________________________________________
 void MatchTPCITS::setDebugFlag(UInt_t flag, bool on)
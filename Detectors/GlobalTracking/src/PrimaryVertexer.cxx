@@ -0,0 +1,252 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PrimaryVertexer.cxx
+/// \brief Primary vertex finder for the global TPC-ITS tracks of a time frame, using their time
+
+#include "GlobalTracking/PrimaryVertexer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+using namespace o2::globaltracking;
+
+//______________________________________________
+template <typename F>
+void PrimaryVertexer::processInThreads(int n, F&& work) const
+{
+  std::atomic<int> next{ 0 };
+  auto worker = [n, &next, &work]() {
+    for (int i = next++; i < n; i = next++) {
+      work(i);
+    }
+  };
+  std::vector<std::thread> threads;
+  const int nThreads = std::min(mNThreads, n);
+  for (int ith = 1; ith < nThreads; ith++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+//______________________________________________
+int PrimaryVertexer::process(const gsl::span<const o2::dataformats::TrackTPCITS> tracks)
+{
+  const int nTracks = tracks.size();
+  std::vector<TrackVF> prepared(nTracks);
+  std::vector<char> accepted(nTracks, 0);
+  // propagation to the beam line, in blocks of tracks
+  constexpr int BlockSize = 256;
+  processInThreads((nTracks + BlockSize - 1) / BlockSize, [&](int block) {
+    for (int i = block * BlockSize, last = std::min(nTracks, i + BlockSize); i < last; i++) {
+      accepted[i] = prepareTrack(tracks[i], i, prepared[i]);
+    }
+  });
+  int nAccepted = 0;
+  for (int i = 0; i < nTracks; i++) {
+    if (accepted[i]) {
+      prepared[nAccepted++] = prepared[i];
+    }
+  }
+  prepared.resize(nAccepted);
+  std::sort(prepared.begin(), prepared.end(), [](const TrackVF& a, const TrackVF& b) { return a.t < b.t; });
+  return processPrepared(prepared, nTracks);
+}
+
+//______________________________________________
+int PrimaryVertexer::processPrepared(const std::vector<TrackVF>& tracks, int nInputTracks)
+{
+  mVertices.clear();
+  mVertexTrackRefs.clear();
+  mVertexTrackIDs.clear();
+  mTrackVertex.assign(nInputTracks, -1);
+
+  // sweep over the time sorted tracks: a gap larger than mTimeClusterGap separates independent clusters
+  std::vector<std::pair<int, int>> clusters;
+  const int nTracks = tracks.size();
+  for (int first = 0, last = 0; first < nTracks; first = last) {
+    while (++last < nTracks && tracks[last].t - tracks[last - 1].t < mTimeClusterGap) {
+    }
+    if (last - first >= mMinTracks) {
+      clusters.emplace_back(first, last);
+    }
+  }
+
+  std::vector<std::vector<VertexCandidate>> found(clusters.size());
+  processInThreads(clusters.size(), [&](int i) { processTimeCluster(tracks, clusters[i].first, clusters[i].second, found[i]); });
+
+  // store in time order
+  for (auto& candidates : found) {
+    std::sort(candidates.begin(), candidates.end(), [](const VertexCandidate& a, const VertexCandidate& b) {
+      return a.vertex.getTimeStamp().getTimeStamp() < b.vertex.getTimeStamp().getTimeStamp();
+    });
+    for (auto& candidate : candidates) {
+      const int vtxID = mVertices.size();
+      mVertices.push_back(candidate.vertex);
+      mVertexTrackRefs.emplace_back(mVertexTrackIDs.size(), candidate.tracks.size());
+      for (auto it : candidate.tracks) {
+        mVertexTrackIDs.push_back(tracks[it].index);
+        mTrackVertex[tracks[it].index] = vtxID;
+      }
+    }
+  }
+  return mVertices.size();
+}
+
+//______________________________________________
+bool PrimaryVertexer::prepareTrack(const o2::dataformats::TrackTPCITS& track, int index, TrackVF& trackVF) const
+{
+  // closest approach to the beam line, approximated by the beam position along the track frame X axis
+  o2::track::TrackParCov trc(track);
+  const float cs = std::cos(trc.getAlpha()), sn = std::sin(trc.getAlpha());
+  const float xBeam = mBeamX * cs + mBeamY * sn, yBeam = -mBeamX * sn + mBeamY * cs;
+  if (!trc.propagateTo(xBeam, mBz)) {
+    return false;
+  }
+  if (std::abs(trc.getY() - yBeam) > mMaxDCAXY || std::abs(trc.getZ()) > mMaxZ) {
+    return false;
+  }
+  if (trc.getSigmaY2() <= 0.f || trc.getSigmaZ2() <= 0.f) {
+    return false;
+  }
+  std::array<float, 3> xyz;
+  trc.getXYZGlo(xyz);
+  const float te = std::max(track.getTimeMUS().getTimeStampError(), mMinTimeError);
+  trackVF.x = xyz[0];
+  trackVF.y = xyz[1];
+  trackVF.z = xyz[2];
+  trackVF.sig2XYI = 1.f / trc.getSigmaY2();
+  trackVF.sig2ZI = 1.f / trc.getSigmaZ2();
+  trackVF.t = track.getTimeMUS().getTimeStamp();
+  trackVF.sig2TI = 1.f / (te * te);
+  trackVF.index = index;
+  return true;
+}
+
+//______________________________________________
+void PrimaryVertexer::processTimeCluster(const std::vector<TrackVF>& tracks, int first, int last,
+                                         std::vector<VertexCandidate>& vertices) const
+{
+  const int nBins = std::max(1, int(std::ceil(2.f * mMaxZ / mZBin)));
+  std::vector<int> histo(nBins, 0);
+  auto bin = [this, nBins](float z) { return std::min(nBins - 1, std::max(0, int((z + mMaxZ) / mZBin))); };
+  for (int i = first; i < last; i++) {
+    histo[bin(tracks[i].z)]++;
+  }
+  std::vector<char> used(last - first, 0);
+
+  while (true) {
+    // seed at the most populated bin, with its neighbours
+    int maxBin = std::max_element(histo.begin(), histo.end()) - histo.begin();
+    if (histo[maxBin] == 0) {
+      break;
+    }
+    int nSeed = 0;
+    float zSeed = 0.f, tSeed = 0.f;
+    for (int i = first; i < last; i++) {
+      if (!used[i - first] && std::abs(bin(tracks[i].z) - maxBin) <= 1) {
+        zSeed += tracks[i].z;
+        tSeed += tracks[i].t;
+        nSeed++;
+      }
+    }
+    if (nSeed < mMinTracks) {
+      break;
+    }
+    zSeed /= nSeed;
+    tSeed /= nSeed;
+
+    VertexCandidate candidate;
+    if (fitVertex(tracks, first, last, used, zSeed, tSeed, candidate)) {
+      for (auto it : candidate.tracks) {
+        used[it - first] = 1;
+        histo[bin(tracks[it].z)]--;
+      }
+      vertices.push_back(std::move(candidate));
+    } else {
+      histo[maxBin] = 0; // not a vertex, its tracks can still be attached to another seed
+    }
+  }
+}
+
+//______________________________________________
+bool PrimaryVertexer::fitVertex(const std::vector<TrackVF>& tracks, int first, int last, const std::vector<char>& used,
+                                float zSeed, float tSeed, VertexCandidate& candidate) const
+{
+  float zv = zSeed, tv = tSeed;
+  // the time error is not known for the seed, start from a loose one to let the tracks in
+  const float scale2 = 4.f;
+  for (int iter = 0; iter < mMaxIterations; iter++) {
+    double swz = 0., swzz = 0., swt = 0., swtt = 0.;
+    const float cut2 = iter ? mMaxChi2 : mMaxChi2 * scale2;
+    for (int i = first; i < last; i++) {
+      if (used[i - first]) {
+        continue;
+      }
+      const auto& trc = tracks[i];
+      const float dz = trc.z - zv, dt = trc.t - tv;
+      const float chi2 = dz * dz * trc.sig2ZI + dt * dt * trc.sig2TI;
+      if (chi2 >= cut2) {
+        continue;
+      }
+      const float w = (1.f - chi2 / cut2) * (1.f - chi2 / cut2); // Tukey biweight
+      swz += w * trc.sig2ZI;
+      swzz += w * trc.sig2ZI * trc.z;
+      swt += w * trc.sig2TI;
+      swtt += w * trc.sig2TI * trc.t;
+    }
+    if (swz <= 0.) {
+      return false;
+    }
+    const float zNew = swzz / swz, tNew = swtt / swt;
+    const bool converged = std::abs(zNew - zv) < 1e-4f && std::abs(tNew - tv) * std::sqrt(swt) < 1e-3f;
+    zv = zNew;
+    tv = tNew;
+    if (converged) {
+      break;
+    }
+  }
+
+  // contributors and final parameters
+  double sw = 0., swx = 0., swy = 0., swz = 0., swt = 0., chi2 = 0.;
+  for (int i = first; i < last; i++) {
+    if (used[i - first]) {
+      continue;
+    }
+    const auto& trc = tracks[i];
+    const float dz = trc.z - zv, dt = trc.t - tv;
+    const float chi2t = dz * dz * trc.sig2ZI + dt * dt * trc.sig2TI;
+    if (chi2t >= mMaxChi2) {
+      continue;
+    }
+    candidate.tracks.push_back(i);
+    sw += trc.sig2XYI;
+    swx += trc.sig2XYI * trc.x;
+    swy += trc.sig2XYI * trc.y;
+    swz += trc.sig2ZI;
+    swt += trc.sig2TI;
+    chi2 += chi2t;
+  }
+  if (int(candidate.tracks.size()) < mMinTracks) {
+    candidate.tracks.clear();
+    return false;
+  }
+  auto& vtx = candidate.vertex;
+  vtx.setXYZ(swx / sw, swy / sw, zv);
+  vtx.setCov(1. / sw, 0.f, 1. / sw, 0.f, 0.f, 1. / swz);
+  vtx.setNContributors(std::min<size_t>(candidate.tracks.size(), 0xffff));
+  vtx.setChi2(chi2);
+  vtx.setTimeStamp({ tv, float(1. / std::sqrt(swt)) });
+  return true;
+}
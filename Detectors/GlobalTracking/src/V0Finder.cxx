@@ -0,0 +1,502 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file V0Finder.cxx
+/// \brief V0 and cascade finder for the global TPC-ITS tracks of a time frame
+
+#include "GlobalTracking/V0Finder.h"
+#include "DetectorsBase/Propagator.h"
+#include "CommonConstants/MathConstants.h"
+#include "CommonConstants/PhysicsConstants.h"
+#include "MathUtils/Utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+using namespace o2::globaltracking;
+
+namespace
+{
+using Point2D = std::array<float, 2>;
+
+constexpr float MinTimeError = 1e-3f; ///< minimal time error assumed for the tracks, in \mus
+
+///< crossing points of two circles in the transverse plane, or the point between them if they do not cross
+int crossCircles(float x1, float y1, float r1, float x2, float y2, float r2, std::array<Point2D, 2>& points)
+{
+  const float dx = x2 - x1, dy = y2 - y1, d = std::sqrt(dx * dx + dy * dy);
+  if (d < 1e-6f) {
+    return 0; // concentric
+  }
+  const float ux = dx / d, uy = dy / d;
+  if (d > r1 + r2) { // apart: middle of the gap
+    const float s = r1 + 0.5f * (d - r1 - r2);
+    points[0] = { x1 + ux * s, y1 + uy * s };
+    return 1;
+  }
+  if (d < std::abs(r1 - r2)) { // one inside the other: middle of the gap on the far side
+    const float s = 0.5f * (r1 + r2 + d);
+    points[0] = r1 > r2 ? Point2D{ x1 + ux * s, y1 + uy * s } : Point2D{ x2 - ux * s, y2 - uy * s };
+    return 1;
+  }
+  const float a = (d * d + r1 * r1 - r2 * r2) / (2.f * d), h = std::sqrt(std::max(0.f, r1 * r1 - a * a));
+  points[0] = { x1 + ux * a - uy * h, y1 + uy * a + ux * h };
+  points[1] = { x1 + ux * a + uy * h, y1 + uy * a - ux * h };
+  return 2;
+}
+
+///< crossing points of the line (x0, y0) + s (ux, uy), with unit direction, and of a circle, or the point between them
+int crossLineCircle(float x0, float y0, float ux, float uy, float xc, float yc, float rc, std::array<Point2D, 2>& points)
+{
+  const float cx = xc - x0, cy = yc - y0;
+  const float s0 = cx * ux + cy * uy, h = cx * uy - cy * ux; // projection of the center and signed distance to it
+  if (std::abs(h) <= rc) {
+    const float ds = std::sqrt(rc * rc - h * h);
+    points[0] = { x0 + ux * (s0 - ds), y0 + uy * (s0 - ds) };
+    points[1] = { x0 + ux * (s0 + ds), y0 + uy * (s0 + ds) };
+    return 2;
+  }
+  // middle of the closest line point and of the circle point facing it
+  const float xl = x0 + ux * s0, yl = y0 + uy * s0, dl = std::abs(h), f = rc / dl;
+  points[0] = { 0.5f * (xl + xc + (xl - xc) * f), 0.5f * (yl + yc + (yl - yc) * f) };
+  return 1;
+}
+
+///< azimuthal angle of the bisector of the directions phi1 and phi2
+float bisector(float phi1, float phi2) { return std::atan2(std::sin(phi1) + std::sin(phi2), std::cos(phi1) + std::cos(phi2)); }
+
+float deltaPhi(float phi1, float phi2)
+{
+  float dphi = std::abs(phi1 - phi2);
+  return dphi > o2::constants::math::PI ? o2::constants::math::TwoPI - dphi : dphi;
+}
+} // namespace
+
+//______________________________________________
+template <typename F>
+void V0Finder::processInThreads(int n, F&& work) const
+{
+  std::atomic<int> next{ 0 };
+  auto worker = [n, &next, &work]() {
+    for (int i = next++; i < n; i = next++) {
+      work(i);
+    }
+  };
+  std::vector<std::thread> threads;
+  const int nThreads = std::min(mNThreads, n);
+  o2::base::Propagator::setMaxThreads(nThreads); // the propagator gives each thread its own navigator
+  for (int ith = 1; ith < nThreads; ith++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+//______________________________________________
+void V0Finder::TrackHash::build(const std::vector<TrackV0>& tracks, const std::vector<int>& selected, float maxDPhi,
+                                float maxDTgl)
+{
+  // the cells are not smaller than the maximal differences, such that the compatible tracks are in the neighbours
+  nPhi = std::max(1, int(o2::constants::math::TwoPI / maxDPhi));
+  phiBinI = nPhi / o2::constants::math::TwoPI;
+  float tglMax = 0.f;
+  tglMin = 0.f;
+  maxSigT = 0.f;
+  for (auto i : selected) {
+    tglMin = std::min(tglMin, tracks[i].tgl);
+    tglMax = std::max(tglMax, tracks[i].tgl);
+    maxSigT = std::max(maxSigT, tracks[i].sigT);
+  }
+  nTgl = int((tglMax - tglMin) / maxDTgl) + 1;
+  tglBinI = 1.f / maxDTgl;
+
+  const int nCells = nPhi * nTgl;
+  offsets.assign(nCells + 1, 0);
+  std::vector<int> cells(selected.size());
+  for (size_t i = 0; i < selected.size(); i++) {
+    const auto& trc = tracks[selected[i]];
+    cells[i] = getPhiBin(trc.phi) * nTgl + getTglBin(trc.tgl);
+    offsets[cells[i] + 1]++;
+  }
+  for (int c = 0; c < nCells; c++) {
+    offsets[c + 1] += offsets[c];
+  }
+  entries.resize(selected.size());
+  std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < selected.size(); i++) {
+    entries[fill[cells[i]]++] = selected[i];
+  }
+  for (int c = 0; c < nCells; c++) {
+    std::sort(entries.begin() + offsets[c], entries.begin() + offsets[c + 1],
+              [&tracks](int a, int b) { return tracks[a].t < tracks[b].t; });
+  }
+}
+
+//______________________________________________
+int V0Finder::TrackHash::getPhiBin(float phi) const
+{
+  o2::utils::BringTo02Pi(phi);
+  return std::min(nPhi - 1, int(phi * phiBinI));
+}
+
+//______________________________________________
+int V0Finder::TrackHash::getTglBin(float tgl) const
+{
+  return std::min(nTgl - 1, std::max(0, int((tgl - tglMin) * tglBinI)));
+}
+
+//______________________________________________
+template <typename F>
+void V0Finder::loopCompatible(const TrackHash& hash, float phi, float tgl, float t, float sigT, F&& f) const
+{
+  if (hash.entries.empty()) {
+    return;
+  }
+  const float dtMax = std::sqrt(mMaxTimeChi2) * (sigT + hash.maxSigT);
+  const int phiBin = hash.getPhiBin(phi), tglBin = hash.getTglBin(tgl);
+  const int nPhiScan = std::min(hash.nPhi, 3);
+  for (int ip = 0; ip < nPhiScan; ip++) {
+    const int phiCell = (phiBin - 1 + ip + hash.nPhi) % hash.nPhi;
+    for (int it = std::max(0, tglBin - 1); it <= std::min(hash.nTgl - 1, tglBin + 1); it++) {
+      const int cell = phiCell * hash.nTgl + it;
+      auto last = hash.entries.begin() + hash.offsets[cell + 1];
+      auto entry = std::lower_bound(hash.entries.begin() + hash.offsets[cell], last, t - dtMax,
+                                    [this](int i, float tmin) { return mTracksV0[i].t < tmin; });
+      for (; entry != last && mTracksV0[*entry].t <= t + dtMax; ++entry) {
+        const auto& trc = mTracksV0[*entry];
+        // the exact cuts, such that the result does not depend on the cells
+        const float dt = trc.t - t;
+        if (dt * dt > mMaxTimeChi2 * (sigT * sigT + trc.sigT * trc.sigT) || std::abs(trc.tgl - tgl) > mMaxDTgl ||
+            deltaPhi(trc.phi, phi) > mMaxDPhi) {
+          continue;
+        }
+        f(*entry);
+      }
+    }
+  }
+}
+
+//______________________________________________
+int V0Finder::process(const gsl::span<const o2::dataformats::TrackTPCITS> tracks)
+{
+  mV0s.clear();
+  mCascades.clear();
+  mTracksV0.clear();
+  mNPairsTested = 0;
+  mNCascadePairsTested = 0;
+
+  // selection of the tracks displaced from the beam line, in blocks of tracks
+  const int nTracks = tracks.size();
+  std::vector<TrackV0> prepared(nTracks);
+  std::vector<char> selected(nTracks, 0);
+  constexpr int PrepareBlockSize = 256;
+  processInThreads((nTracks + PrepareBlockSize - 1) / PrepareBlockSize, [&](int block) {
+    for (int i = block * PrepareBlockSize, last = std::min(nTracks, i + PrepareBlockSize); i < last; i++) {
+      selected[i] = prepareTrack(tracks[i], i, prepared[i]);
+    }
+  });
+  std::vector<int> posIDs, negIDs;
+  for (int i = 0; i < nTracks; i++) {
+    if (selected[i]) {
+      (tracks[i].getSign() > 0 ? posIDs : negIDs).push_back(mTracksV0.size());
+      mTracksV0.push_back(prepared[i]);
+    }
+  }
+  mHashPos.build(mTracksV0, posIDs, mMaxDPhi, mMaxDTgl);
+  mHashNeg.build(mTracksV0, negIDs, mMaxDPhi, mMaxDTgl);
+
+  // V0s, in blocks of positive tracks
+  constexpr int BlockSize = 64;
+  const int nBlocks = (posIDs.size() + BlockSize - 1) / BlockSize;
+  std::vector<std::vector<V0Candidate>> found(nBlocks);
+  std::vector<long> nTested(nBlocks, 0);
+  processInThreads(nBlocks, [&](int block) {
+    for (int ip = block * BlockSize, last = std::min<int>(posIDs.size(), ip + BlockSize); ip < last; ip++) {
+      const auto& pos = mTracksV0[posIDs[ip]];
+      loopCompatible(mHashNeg, pos.phi, pos.tgl, pos.t, pos.sigT, [&](int in) {
+        const auto& neg = mTracksV0[in];
+        nTested[block]++;
+        V0Candidate candidate;
+        if (fitV0(tracks[pos.index], pos, tracks[neg.index], neg, candidate)) {
+          found[block].push_back(candidate);
+        }
+      });
+    }
+  });
+
+  std::vector<V0Candidate> candidates;
+  std::vector<int> v0IDs;
+  for (int block = 0; block < nBlocks; block++) {
+    mNPairsTested += nTested[block];
+    for (const auto& candidate : found[block]) {
+      v0IDs.push_back(candidate.accepted ? int(mV0s.size()) : -1);
+      if (candidate.accepted) {
+        mV0s.push_back(candidate.v0);
+      }
+      candidates.push_back(candidate);
+    }
+  }
+
+  if (mFindCascades) {
+    findCascades(tracks, candidates, v0IDs);
+  }
+  return mV0s.size();
+}
+
+//______________________________________________
+void V0Finder::findCascades(const gsl::span<const o2::dataformats::TrackTPCITS> tracks,
+                            const std::vector<V0Candidate>& candidates, const std::vector<int>& v0IDs)
+{
+  using namespace o2::constants::physics;
+  // (anti)Lambda candidates, with the sign of their bachelor
+  std::vector<std::pair<int, int>> lambdas;
+  for (size_t i = 0; i < candidates.size(); i++) {
+    const auto& v0 = candidates[i].v0;
+    if (v0.getCosPA() < mMinCosPACascadeV0) {
+      continue;
+    }
+    if (std::abs(std::sqrt(std::max(0.f, v0.calcMass2(MassProton, MassPionCharged))) - MassLambda) < mLambdaMassWindow) {
+      lambdas.emplace_back(i, -1);
+    }
+    if (std::abs(std::sqrt(std::max(0.f, v0.calcMass2(MassPionCharged, MassProton))) - MassLambda) < mLambdaMassWindow) {
+      lambdas.emplace_back(i, 1);
+    }
+  }
+
+  constexpr int BlockSize = 16;
+  const int nBlocks = (lambdas.size() + BlockSize - 1) / BlockSize;
+  std::vector<std::vector<Cascade>> found(nBlocks);
+  std::vector<long> nTested(nBlocks, 0);
+  processInThreads(nBlocks, [&](int block) {
+    for (int il = block * BlockSize, last = std::min<int>(lambdas.size(), il + BlockSize); il < last; il++) {
+      const int iv = lambdas[il].first;
+      const auto& v0 = candidates[iv].v0;
+      std::array<float, 3> pxyz;
+      v0.getPxPyPz(pxyz);
+      const float pt = std::sqrt(pxyz[0] * pxyz[0] + pxyz[1] * pxyz[1]);
+      const auto& t = v0.getTimeMUS();
+      loopCompatible(lambdas[il].second > 0 ? mHashPos : mHashNeg, std::atan2(pxyz[1], pxyz[0]), pxyz[2] / pt,
+                     t.getTimeStamp(), t.getTimeStampError(), [&](int ib) {
+                       const auto& bach = mTracksV0[ib];
+                       if (bach.index == v0.getProngID(V0::kPositive) || bach.index == v0.getProngID(V0::kNegative)) {
+                         return;
+                       }
+                       nTested[block]++;
+                       Cascade cascade;
+                       if (fitCascade(v0, v0IDs[iv], tracks[bach.index], bach, cascade)) {
+                         found[block].push_back(cascade);
+                       }
+                     });
+    }
+  });
+  for (int block = 0; block < nBlocks; block++) {
+    mNCascadePairsTested += nTested[block];
+    mCascades.insert(mCascades.end(), found[block].begin(), found[block].end());
+  }
+}
+
+//______________________________________________
+bool V0Finder::prepareTrack(const o2::dataformats::TrackTPCITS& track, int index, TrackV0& trackV0) const
+{
+  const float crv = track.getCurvature(mBz), sn = track.getSnp();
+  if (std::abs(crv) < o2::constants::math::Almost0 || std::abs(sn) > o2::constants::math::Almost1) {
+    return false;
+  }
+  // helix center: the radius is signed by the curvature
+  const float r = 1.f / crv, cs = std::sqrt((1.f - sn) * (1.f + sn));
+  std::array<float, 3> center = { track.getX() - sn * r, track.getY() + cs * r, 0.f };
+  o2::utils::RotateZ(center, track.getAlpha());
+  trackV0.xC = center[0];
+  trackV0.yC = center[1];
+  trackV0.rC = std::abs(r);
+  const float dxB = trackV0.xC - mBeamX, dyB = trackV0.yC - mBeamY;
+  if (std::abs(std::sqrt(dxB * dxB + dyB * dyB) - trackV0.rC) < mMinDCAXYToBeam) {
+    return false; // primary track
+  }
+  trackV0.index = index;
+  trackV0.phi = track.getPhi();
+  trackV0.tgl = track.getTgl();
+  trackV0.t = track.getTimeMUS().getTimeStamp();
+  trackV0.sigT = std::max(track.getTimeMUS().getTimeStampError(), MinTimeError);
+  return true;
+}
+
+//______________________________________________
+bool V0Finder::fitV0(const o2::dataformats::TrackTPCITS& trPos, const TrackV0& pos,
+                     const o2::dataformats::TrackTPCITS& trNeg, const TrackV0& neg, V0Candidate& candidate) const
+{
+  // choose among the crossing points of the helices the one where the tracks are closest in z
+  std::array<Point2D, 2> points;
+  const int nPoints = crossCircles(pos.xC, pos.yC, pos.rC, neg.xC, neg.yC, neg.rC, points);
+  int best = -1;
+  float bestD2 = 0.f;
+  for (int ip = 0; ip < nPoints; ip++) {
+    const float x = points[ip][0], y = points[ip][1], r2 = x * x + y * y;
+    if (r2 < mMinR * mMinR || r2 > mMaxR * mMaxR) {
+      continue;
+    }
+    float yPos, zPos, yNeg, zNeg;
+    float csPos, snPos, csNeg, snNeg;
+    o2::utils::sincosf(trPos.getAlpha(), snPos, csPos);
+    o2::utils::sincosf(trNeg.getAlpha(), snNeg, csNeg);
+    const float xPos = x * csPos + y * snPos, xNeg = x * csNeg + y * snNeg;
+    if (!trPos.getYZAt(xPos, mBz, yPos, zPos) || !trNeg.getYZAt(xNeg, mBz, yNeg, zNeg)) {
+      continue;
+    }
+    // distance of the track positions at the local X of the point
+    const float dx = (xPos * csPos - yPos * snPos) - (xNeg * csNeg - yNeg * snNeg);
+    const float dy = (xPos * snPos + yPos * csPos) - (xNeg * snNeg + yNeg * csNeg);
+    const float d2 = dx * dx + dy * dy + (zPos - zNeg) * (zPos - zNeg);
+    if (best < 0 || d2 < bestD2) {
+      best = ip;
+      bestD2 = d2;
+    }
+  }
+  if (best < 0 || bestD2 > 4.f * mMaxDCAProngs * mMaxDCAProngs) {
+    return false;
+  }
+
+  // propagate both prongs to the point in the frame of the V0 direction, where both have small snp
+  const float alpha = bisector(pos.phi, neg.phi);
+  float cs, sn;
+  o2::utils::sincosf(alpha, sn, cs);
+  const float xV = points[best][0] * cs + points[best][1] * sn;
+  o2::track::TrackParCov prPos(trPos), prNeg(trNeg);
+  if (!propagateToPoint(prPos, alpha, xV) || !propagateToPoint(prNeg, alpha, xV)) {
+    return false;
+  }
+  const float dy = prPos.getY() - prNeg.getY(), dz = prPos.getZ() - prNeg.getZ();
+  const float dca = std::sqrt(dy * dy + dz * dz);
+  if (dca > mMaxDCAProngs) {
+    return false;
+  }
+  const float wyPos = 1.f / prPos.getSigmaY2(), wyNeg = 1.f / prNeg.getSigmaY2();
+  const float wzPos = 1.f / prPos.getSigmaZ2(), wzNeg = 1.f / prNeg.getSigmaZ2();
+  std::array<float, 3> xyz = { xV, (prPos.getY() * wyPos + prNeg.getY() * wyNeg) / (wyPos + wyNeg),
+                               (prPos.getZ() * wzPos + prNeg.getZ() * wzNeg) / (wzPos + wzNeg) };
+  o2::utils::RotateZ(xyz, alpha);
+  const float r2 = xyz[0] * xyz[0] + xyz[1] * xyz[1];
+  if (r2 < mMinR * mMinR || r2 > mMaxR * mMaxR) {
+    return false;
+  }
+
+  std::array<float, 3> pPos, pNeg;
+  prPos.getPxPyPzGlo(pPos);
+  prNeg.getPxPyPzGlo(pNeg);
+  const float cosPA = getCosPAXY(xyz, { pPos[0] + pNeg[0], pPos[1] + pNeg[1], pPos[2] + pNeg[2] });
+  candidate.accepted = cosPA >= mMinCosPA;
+  if (!candidate.accepted && !(mFindCascades && cosPA >= mMinCosPACascadeV0)) {
+    return false;
+  }
+  const float wtPos = 1.f / (pos.sigT * pos.sigT), wtNeg = 1.f / (neg.sigT * neg.sigT);
+  const o2::dataformats::TimeStampWithError<float, float> t((pos.t * wtPos + neg.t * wtNeg) / (wtPos + wtNeg),
+                                                           1.f / std::sqrt(wtPos + wtNeg));
+  candidate.v0 = V0(xyz, prPos, prNeg, pos.index, neg.index, dca, cosPA, t);
+  return true;
+}
+
+//______________________________________________
+bool V0Finder::fitCascade(const V0& v0, int v0ID, const o2::dataformats::TrackTPCITS& trBach, const TrackV0& bach,
+                          Cascade& cascade) const
+{
+  std::array<float, 3> pV0;
+  v0.getPxPyPz(pV0);
+  const float ptV0 = std::sqrt(pV0[0] * pV0[0] + pV0[1] * pV0[1]);
+  const float ux = pV0[0] / ptV0, uy = pV0[1] / ptV0, tglV0 = pV0[2] / ptV0;
+
+  // choose among the crossing points of the V0 line and of the bachelor helix, upstream of the V0 vertex,
+  // the one where they are closest in z
+  std::array<Point2D, 2> points;
+  const int nPoints = crossLineCircle(v0.getX(), v0.getY(), ux, uy, bach.xC, bach.yC, bach.rC, points);
+  float cs, sn;
+  o2::utils::sincosf(trBach.getAlpha(), sn, cs);
+  int best = -1;
+  float bestD2 = 0.f;
+  for (int ip = 0; ip < nPoints; ip++) {
+    const float x = points[ip][0], y = points[ip][1], r2 = x * x + y * y;
+    const float s = (x - v0.getX()) * ux + (y - v0.getY()) * uy;
+    if (s > mMaxDCACascade || r2 < mMinR * mMinR || r2 > mMaxR * mMaxR) {
+      continue;
+    }
+    float yB, zB;
+    const float xB = x * cs + y * sn;
+    if (!trBach.getYZAt(xB, mBz, yB, zB)) {
+      continue;
+    }
+    const float dx = (xB * cs - yB * sn) - x, dy = (xB * sn + yB * cs) - y, dz = zB - (v0.getZ() + s * tglV0);
+    const float d2 = dx * dx + dy * dy + dz * dz;
+    if (best < 0 || d2 < bestD2) {
+      best = ip;
+      bestD2 = d2;
+    }
+  }
+  if (best < 0 || bestD2 > 4.f * mMaxDCACascade * mMaxDCACascade) {
+    return false;
+  }
+
+  // propagate the bachelor to the point in the frame of the cascade direction, and take its distance to the V0 line
+  const float alpha = bisector(std::atan2(uy, ux), bach.phi);
+  o2::utils::sincosf(alpha, sn, cs);
+  o2::track::TrackParCov bachelor(trBach);
+  if (!propagateToPoint(bachelor, alpha, points[best][0] * cs + points[best][1] * sn)) {
+    return false;
+  }
+  std::array<float, 3> xyzB;
+  bachelor.getXYZGlo(xyzB);
+  const float pV0Norm = std::sqrt(ptV0 * ptV0 + pV0[2] * pV0[2]);
+  const std::array<float, 3> w = { xyzB[0] - v0.getX(), xyzB[1] - v0.getY(), xyzB[2] - v0.getZ() };
+  const float s = (w[0] * pV0[0] + w[1] * pV0[1] + w[2] * pV0[2]) / pV0Norm;
+  std::array<float, 3> xyz;
+  float dca2 = 0.f;
+  for (int i = 0; i < 3; i++) {
+    const float lineToBach = w[i] - s * pV0[i] / pV0Norm; // from the closest point of the V0 line to the bachelor
+    dca2 += lineToBach * lineToBach;
+    xyz[i] = xyzB[i] - 0.5f * lineToBach;
+  }
+  if (dca2 > mMaxDCACascade * mMaxDCACascade) {
+    return false;
+  }
+  const float r2 = xyz[0] * xyz[0] + xyz[1] * xyz[1];
+  if (r2 < mMinR * mMinR || r2 > mMaxR * mMaxR) {
+    return false;
+  }
+
+  std::array<float, 3> pBach;
+  bachelor.getPxPyPzGlo(pBach);
+  const float cosPA = getCosPAXY(xyz, { pV0[0] + pBach[0], pV0[1] + pBach[1], pV0[2] + pBach[2] });
+  if (cosPA < mMinCosPACascade) {
+    return false;
+  }
+  const auto& tV0 = v0.getTimeMUS();
+  const float wtV0 = 1.f / (tV0.getTimeStampError() * tV0.getTimeStampError()), wtB = 1.f / (bach.sigT * bach.sigT);
+  const o2::dataformats::TimeStampWithError<float, float> t((tV0.getTimeStamp() * wtV0 + bach.t * wtB) / (wtV0 + wtB),
+                                                           1.f / std::sqrt(wtV0 + wtB));
+  cascade = Cascade(xyz, v0, v0ID, bachelor, bach.index, std::sqrt(dca2), cosPA, t);
+  return true;
+}
+
+//______________________________________________
+bool V0Finder::propagateToPoint(o2::track::TrackParCov& track, float alpha, float x) const
+{
+  return track.rotate(alpha) &&
+         o2::base::Propagator::Instance()->propagateToX(track, x, mBz, o2::constants::physics::MassPionCharged, 0.85f, 2.f,
+                                                        mMatCorr);
+}
+
+//______________________________________________
+float V0Finder::getCosPAXY(const std::array<float, 3>& xyz, const std::array<float, 3>& pxyz) const
+{
+  const float dx = xyz[0] - mBeamX, dy = xyz[1] - mBeamY;
+  const float norm2 = (dx * dx + dy * dy) * (pxyz[0] * pxyz[0] + pxyz[1] * pxyz[1]);
+  return norm2 > 0.f ? (dx * pxyz[0] + dy * pxyz[1]) / std::sqrt(norm2) : -1.f;
+}
@@ -0,0 +1,168 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "CommonConstants/PhysicsConstants.h"
+#include "GlobalTracking/V0Finder.h"
+
+using namespace o2::globaltracking;
+using namespace o2::constants::physics;
+
+namespace
+{
+using P4 = std::array<float, 4>; // px, py, pz, mass
+constexpr float Bz = 5.f;
+constexpr float MassXi = 1.32171f;
+
+/// Time frame of a toy MC: collisions every 20 \mus with primary pions, K0s, Lambdas and Xis decaying
+/// at a few cm, the tracks being smeared at their production point
+class ToyTimeFrame
+{
+ public:
+  ToyTimeFrame(int nCollisions, int nPrimaries)
+  {
+    for (int ic = 0; ic < nCollisions; ic++) {
+      const float t = ic * 20.f + 5.f * mUniform(mGen);
+      const std::array<float, 3> vertex = { 0.f, 0.f, 5.f * mGaus(mGen) };
+      for (int i = 0; i < nPrimaries; i++) {
+        addTrack(vertex, generate(MassPionCharged, 0.5f), mUniform(mGen) > 0.5f ? 1 : -1, t);
+      }
+      for (int i = 0; i < 3; i++) {
+        addV0(vertex, generate(MassKaonNeutral, 1.f), 1.f + 15.f * mUniform(mGen), MassPionCharged, MassPionCharged, t);
+      }
+      for (int i = 0; i < 2; i++) {
+        addV0(vertex, generate(MassLambda, 1.5f), 1.f + 15.f * mUniform(mGen), MassProton, MassPionCharged, t);
+      }
+      auto xi = generate(MassXi, 2.f);
+      auto cascade = decayPoint(vertex, xi, 1.f + 5.f * mUniform(mGen));
+      P4 lambda, pion;
+      decay(xi, MassLambda, MassPionCharged, lambda, pion);
+      addTrack(cascade, pion, -1, t);
+      addV0(cascade, lambda, 2.f + 8.f * mUniform(mGen), MassProton, MassPionCharged, t);
+    }
+  }
+
+  const std::vector<o2::dataformats::TrackTPCITS>& getTracks() const { return mTracks; }
+
+  long getNPairs() const { return mNPositive * long(mTracks.size() - mNPositive); }
+
+ private:
+  P4 generate(float mass, float ptSlope)
+  {
+    const float pt = 0.2f - ptSlope * std::log(mUniform(mGen) + 1e-6f), phi = 2.f * M_PI * mUniform(mGen);
+    const float eta = 1.6f * mUniform(mGen) - 0.8f;
+    return { pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta), mass };
+  }
+
+  std::array<float, 3> decayPoint(const std::array<float, 3>& origin, const P4& mother, float length)
+  {
+    const float p = std::sqrt(mother[0] * mother[0] + mother[1] * mother[1] + mother[2] * mother[2]);
+    return { origin[0] + length * mother[0] / p, origin[1] + length * mother[1] / p, origin[2] + length * mother[2] / p };
+  }
+
+  // isotropic 2 body decay in the rest frame of the mother
+  void decay(const P4& mother, float m1, float m2, P4& d1, P4& d2)
+  {
+    const float m = mother[3];
+    const float p = std::sqrt((m * m - (m1 + m2) * (m1 + m2)) * (m * m - (m1 - m2) * (m1 - m2))) / (2.f * m);
+    const float cosTheta = 2.f * mUniform(mGen) - 1.f, sinTheta = std::sqrt(1.f - cosTheta * cosTheta);
+    const float phi = 2.f * M_PI * mUniform(mGen);
+    const std::array<float, 3> q = { p * sinTheta * std::cos(phi), p * sinTheta * std::sin(phi), p * cosTheta };
+    const float e = std::sqrt(mother[0] * mother[0] + mother[1] * mother[1] + mother[2] * mother[2] + m * m);
+    const std::array<float, 3> beta = { mother[0] / e, mother[1] / e, mother[2] / e };
+    const float beta2 = beta[0] * beta[0] + beta[1] * beta[1] + beta[2] * beta[2], gamma = e / m;
+    for (int id = 0; id < 2; id++) {
+      auto& d = id ? d2 : d1;
+      const float sign = id ? -1.f : 1.f, md = id ? m2 : m1;
+      const float betaQ = sign * (beta[0] * q[0] + beta[1] * q[1] + beta[2] * q[2]);
+      const float f = (gamma - 1.f) * betaQ / beta2 + gamma * std::sqrt(p * p + md * md);
+      for (int i = 0; i < 3; i++) {
+        d[i] = sign * q[i] + f * beta[i];
+      }
+      d[3] = md;
+    }
+  }
+
+  void addV0(const std::array<float, 3>& origin, const P4& mother, float length, float mPos, float mNeg, float t)
+  {
+    auto vertex = decayPoint(origin, mother, length);
+    P4 pos, neg;
+    decay(mother, mPos, mNeg, pos, neg);
+    addTrack(vertex, pos, 1, t);
+    addTrack(vertex, neg, -1, t);
+  }
+
+  void addTrack(const std::array<float, 3>& xyz, const P4& p, int charge, float t)
+  {
+    // in the frame of the transverse momentum, moved 0.5 cm away from the production point
+    const float pt = std::sqrt(p[0] * p[0] + p[1] * p[1]), alpha = std::atan2(p[1], p[0]);
+    const float cs = std::cos(alpha), sn = std::sin(alpha);
+    const std::array<float, 5> par = { -xyz[0] * sn + xyz[1] * cs + 0.01f * mGaus(mGen), xyz[2] + 0.01f * mGaus(mGen),
+                                       0.f, p[2] / pt, charge / pt };
+    const std::array<float, 15> cov = { 1e-4f, 0.f, 1e-4f, 0.f, 0.f, 1e-6f, 0.f, 0.f, 0.f, 1e-6f,
+                                        0.f, 0.f, 0.f, 0.f, 1e-4f };
+    o2::track::TrackParCov trc(xyz[0] * cs + xyz[1] * sn, alpha, par, cov);
+    trc.propagateTo(trc.getX() + 0.5f, Bz);
+    mTracks.emplace_back(trc);
+    mTracks.back().setTimeMUS(t + 0.1f * mGaus(mGen), 0.1f);
+    mNPositive += charge > 0;
+  }
+
+  std::mt19937 mGen{ 1 };
+  std::uniform_real_distribution<float> mUniform{ 0.f, 1.f };
+  std::normal_distribution<float> mGaus{ 0.f, 1.f };
+  std::vector<o2::dataformats::TrackTPCITS> mTracks;
+  long mNPositive = 0;
+};
+
+void runFinder(benchmark::State& state, V0Finder& finder, const ToyTimeFrame& tf)
+{
+  const auto& tracks = tf.getTracks();
+  for (auto _ : state) {
+    finder.process(gsl::span<const o2::dataformats::TrackTPCITS>(tracks.data(), tracks.size()));
+    benchmark::DoNotOptimize(finder.getV0s().data());
+  }
+  state.SetItemsProcessed(state.iterations() * tracks.size());
+  state.counters["V0s"] = finder.getV0s().size();
+  state.counters["cascades"] = finder.getCascades().size();
+  state.counters["pairsTested/allPairs"] = double(finder.getNPairsTested()) / tf.getNPairs();
+}
+} // namespace
+
+// V0 and cascade finding in time frames of an increasing number of collisions, on 1 and 4 threads
+static void BM_V0Finder(benchmark::State& state)
+{
+  ToyTimeFrame tf(state.range(0), 500);
+  V0Finder finder;
+  finder.setBz(Bz);
+  finder.setNThreads(state.range(1));
+  runFinder(state, finder, tf);
+}
+
+// V0 finding with the windows on the phi (mrad) and tgLambda (1e-3) differences of the prongs tightened
+static void BM_V0FinderWindows(benchmark::State& state)
+{
+  ToyTimeFrame tf(100, 500);
+  V0Finder finder;
+  finder.setBz(Bz);
+  finder.setFindCascades(false);
+  finder.setMaxDPhi(state.range(0) * 1e-3f);
+  finder.setMaxDTgl(state.range(0) * 1e-3f);
+  runFinder(state, finder, tf);
+}
+
+BENCHMARK(BM_V0Finder)->Args({ 20, 1 })->Args({ 100, 1 })->Args({ 500, 1 })->Args({ 500, 4 })->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_V0FinderWindows)->Arg(3142)->Arg(1500)->Arg(800)->Arg(400)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,32 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CalibTOFSpec.h
+/// @brief  Processor spec for the online TOF calibration
+
+#ifndef O2_GLOBALTRACKING_CALIBTOFSPEC
+#define O2_GLOBALTRACKING_CALIBTOFSPEC
+
+#include "Framework/DataProcessorSpec.h"
+
+namespace o2
+{
+namespace globaltracking
+{
+
+/// create a processor spec
+/// accumulate the TOF calib infos received as TOF/CALIBINFOS messages with CalibTOF in online
+/// mode, the calibration is done and written to file when the device is stopped
+framework::DataProcessorSpec getCalibTOFSpec();
+
+} // namespace globaltracking
+} // namespace o2
+
+#endif
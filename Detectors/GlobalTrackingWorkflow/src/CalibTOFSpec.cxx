@@ -0,0 +1,87 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CalibTOFSpec.cxx
+/// @brief  Processor spec for the online TOF calibration
+
+#include "GlobalTrackingWorkflow/CalibTOFSpec.h"
+#include "Framework/CallbackService.h"
+#include "GlobalTracking/CalibTOF.h"
+#include "ReconstructionDataFormats/CalibInfoTOF.h"
+#include "FairLogger.h"
+#include "TFile.h"
+#include "TTree.h"
+#include <memory> // for make_shared
+#include <string>
+
+using namespace o2::framework;
+
+namespace o2
+{
+namespace globaltracking
+{
+
+DataProcessorSpec getCalibTOFSpec()
+{
+  auto initFunction = [](InitContext& ic) {
+    auto filename = ic.options().get<std::string>("tof-calib-outfile");
+    auto nThreads = ic.options().get<int>("calib-threads");
+
+    auto outputfile = std::make_shared<TFile>(filename.c_str(), "RECREATE");
+    auto outputtree = std::make_shared<TTree>("calibrationTOF", "Calibration TOF params");
+
+    auto calib = std::make_shared<CalibTOF>();
+    calib->setOnlineFlag(ic.options().get<int>("calib-flag"));
+    calib->setMinTimestamp(ic.options().get<int>("min-timestamp"));
+    calib->setMaxTimestamp(ic.options().get<int>("max-timestamp"));
+    calib->setOutputTree(outputtree.get());
+    calib->init();
+
+    // the calibration is done at the end of the run, i.e. when the device is stopped
+    auto finishCalibration = [calib, outputfile, outputtree, nThreads]() {
+      static bool finished = false;
+      if (finished) {
+        return;
+      }
+      calib->runOnline(nThreads);
+      calib->fillOutput();
+      outputfile->cd();
+      outputtree->Write();
+      outputfile->Close();
+      finished = true;
+    };
+    ic.services().get<CallbackService>().set(CallbackService::Id::Stop, finishCalibration);
+
+    auto processingFct = [calib](ProcessingContext& pc) {
+      auto calibinfos = pc.inputs().get<gsl::span<o2::dataformats::CalibInfoTOF>>("calibinfo");
+      LOG(DEBUG) << "received " << calibinfos.size() << " TOF calib infos";
+      calib->addCalibInfo(calibinfos);
+    };
+
+    return processingFct;
+  };
+
+  return DataProcessorSpec{
+    "tof-calib",
+    Inputs{ InputSpec{ "calibinfo", "TOF", "CALIBINFOS", 0, Lifetime::Timeframe } },
+    {}, // no output, the calibration is written to file
+    AlgorithmSpec(initFunction),
+    Options{
+      { "tof-calib-outfile", VariantType::String, "o2calparams_tof.root", { "Name of the output file" } },
+      { "calib-flag", VariantType::Int, CalibTOF::kLHCphase | CalibTOF::kChannelOffset | CalibTOF::kChannelTimeSlewing, { "calibrations to do: 1 LHC phase, 2 channel offset, 4 time slewing" } },
+      { "calib-threads", VariantType::Int, 1, { "number of threads for the channel level fits" } },
+      { "min-timestamp", VariantType::Int, 0, { "minimum timestamp (s) of the calib infos, for the LHC phase binning" } },
+      { "max-timestamp", VariantType::Int, 1, { "maximum timestamp (s) of the calib infos, for the LHC phase binning" } },
+    }
+  };
+}
+
+} // namespace globaltracking
+} // namespace o2
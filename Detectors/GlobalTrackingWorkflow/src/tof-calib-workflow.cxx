@@ -0,0 +1,25 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   tof-calib-workflow.cxx
+/// @brief  DPL workflow for the online TOF calibration
+
+#include "Framework/WorkflowSpec.h"
+#include "GlobalTrackingWorkflow/CalibTOFSpec.h"
+
+#include "Framework/runDataProcessing.h" // the main driver
+
+using namespace o2::framework;
+
+/// The calibration device consumes the TOF/CALIBINFOS messages of an upstream workflow
+WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
+{
+  return WorkflowSpec{ o2::globaltracking::getCalibTOFSpec() };
+}
@@ -15,6 +15,7 @@
 #include "HMPIDBase/Hit.h"   // for hit
 #include "HMPIDBase/Param.h" // for param
 #include "TMath.h"
+#include <array>
 
 namespace o2
 {
@@ -62,6 +63,30 @@ class Digit : public DigitBase
     return Digit::InMathieson(localX, localY, somepad);
   }
 
+  // fractional contributions of the hit to the 3x3 pads centred on the pad (px, py) of the given pc, in the
+  // order (px - 1, py - 1), (px - 1, py), (px - 1, py + 1), (px, py - 1), ...: the same as the ones of
+  // getFractionalContributionForPad with one transformation of the hit and 3 + 3 Mathieson integrals
+  // the fractions of the pads outside of the pc are meaningless
+  static void getFractionalContributionsForPads(HitType const& hit, int pc, int px, int py, std::array<float, 9>& fractions)
+  {
+    float localX;
+    float localY;
+    const auto chamber = hit.GetDetectorID();
+    double tmp[3] = { hit.GetX(), hit.GetY(), hit.GetZ() };
+    Param::Instance()->Mars2Lors(chamber, tmp, localX, localY);
+    float fx[3];
+    Double_t fy[3];
+    for (int i = 0; i < 3; ++i) {
+      fx[i] = Digit::IntPartMathiX(localX, Param::Abs(chamber, pc, px + i - 1, py));
+      fy[i] = Digit::IntPartMathiY(localY, Param::Abs(chamber, pc, px, py + i - 1));
+    }
+    for (int nx = 0; nx < 3; ++nx) {
+      for (int ny = 0; ny < 3; ++ny) {
+        fractions[3 * nx + ny] = 4. * fx[nx] * fy[ny];
+      }
+    }
+  }
+
   // add charge to existing digit
   void addCharge(float q) { mQ += q; }
 
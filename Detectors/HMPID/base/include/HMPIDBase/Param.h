@@ -206,6 +206,13 @@ class Param
     x = l[0] + mX;
     y = l[1] + mY;
   } //MRS->LRS
+  void Mars2Lors(Int_t c, double* m, double* l) const
+  {
+    mM[c]->MasterToLocal(m, l);
+    l[0] += mX;
+    l[1] += mY;
+  } //MRS->LRS, z along the normal from the window-gap surface
+  void Mars2LorsVec(Int_t c, double* m, double* l) const { mM[c]->MasterToLocalVect(m, l); } //MRS->LRS
   void Mars2LorsVec(Int_t c, double* m, float& th, float& ph) const
   {
     double l[3];
@@ -11,6 +11,7 @@
 #ifndef ALICEO2_HMPID_DETECTOR_H_
 #define ALICEO2_HMPID_DETECTOR_H_
 
+#include <array>
 #include <vector>
 #include "DetectorsBase/Detector.h"
 #include "HMPIDBase/Hit.h"
@@ -50,6 +51,10 @@ class Detector : public o2::base::DetImpl<Detector>
   void createMaterials();
   void ConstructGeometry() override;
   void defineOpticalProperties();
+  // tables of the analytical Cherenkov photons (HMPIDSimParam::fastCherenkov)
+  void initFastCherenkov();
+  // analytical Cherenkov photons of the current charged step in the radiator, true if some made hits
+  bool fastCherenkovPhotons();
   void EndOfEvent() override { Reset(); }
 
   // for the geometry sub-parts
@@ -78,6 +83,22 @@ class Detector : public o2::base::DetImpl<Detector>
 
   std::vector<TGeoVolume*> mSensitiveVolumes; //!
 
+  // optical properties of one photon energy bin for the fast Cherenkov photons
+  struct CkovBin {
+    float eV;     // photon energy, [eV]
+    float nRad;   // refractive index of C6F14
+    float nWin;   // refractive index of SiO2
+    float nGap;   // refractive index of CH4
+    float absRad; // absorption length in C6F14, [cm]
+    float absWin; // absorption length in SiO2, [cm]
+    float absGap; // absorption length in CH4, [cm]
+    float qe;     // CsI quantum efficiency
+  };
+  static constexpr int NCkovBins = 30;
+  bool mFastCherenkov = false;              //! Cherenkov photons of the radiator made by fastCherenkovPhotons
+  std::array<CkovBin, NCkovBins> mCkovBins; //!
+  float mCkovMaxNRad = 0.;                  //! max C6F14 refractive index, for the threshold
+
   template <typename Det>
   friend class o2::base::DetImpl;
   ClassDefOverride(Detector, 1);
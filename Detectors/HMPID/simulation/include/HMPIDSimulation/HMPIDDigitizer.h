@@ -91,9 +91,16 @@ class HMPIDDigitizer
   constexpr static double TRACKHOLDTIME = 1200; // defines the window for pile-up after a trigger received in nanoseconds
   constexpr static double BUSYTIME = 22000;     // the time for which no new trigger can be received in nanoseconds
 
-  std::map<int, short> mIndexForPad; //! logarithmic mapping of pad to digit index
+  // flat index of a pad over all chambers and pcs
+  static constexpr int NPADS = (Param::kMaxCh + 1) * (Param::kMaxPc + 1) * Param::kPadPcX * Param::kPadPcY;
+  static int flatPadIndex(int chamber, int pc, int px, int py)
+  {
+    return ((chamber * (Param::kMaxPc + 1) + pc) * Param::kPadPcX + px) * Param::kPadPcY + py;
+  }
+
+  std::vector<int> mIndexForPad; //! digit index of each pad (by flat pad index), -1 if none
 
-  std::vector<int> mInvolvedPads; //! list of pads where digits created
+  std::vector<int> mInvolvedPads; //! list of (flat indices of the) pads where digits created
 
   int mReadoutCounter = -1;
 
@@ -0,0 +1,34 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef DETECTORS_HMPID_SIMULATION_INCLUDE_HMPIDSIMULATION_HMPIDSIMPARAM_H_
+#define DETECTORS_HMPID_SIMULATION_INCLUDE_HMPIDSIMULATION_HMPIDSIMPARAM_H_
+
+#include "SimConfig/ConfigurableParam.h"
+#include "SimConfig/ConfigurableParamHelper.h"
+
+namespace o2
+{
+namespace hmpid
+{
+
+// parameters of the HMPID transport
+struct HMPIDSimParam : public o2::conf::ConfigurableParamHelper<HMPIDSimParam> {
+  bool fastCherenkov = false; // no Cherenkov photons transported in the C6F14, their hits on the CsI are computed from the charged steps
+  float radTemperature = 20.; // C6F14 temperature [C] for the refractive index of the fast Cherenkov photons
+
+  // boilerplate stuff + make principal key "HMPSim"
+  O2ParamDef(HMPIDSimParam, "HMPSim");
+};
+
+} // namespace hmpid
+} // namespace o2
+
+#endif /* DETECTORS_HMPID_SIMULATION_INCLUDE_HMPIDSIMULATION_HMPIDSIMPARAM_H_ */
@@ -9,6 +9,7 @@
 // or submit itself to any jurisdiction.
 
 #include "HMPIDSimulation/Detector.h"
+#include "HMPIDSimulation/HMPIDSimParam.h"
 #include "HMPIDBase/Param.h"
 #include "TGeoManager.h"
 #include "TGeoShapeAssembly.h"
@@ -32,6 +33,9 @@
 
 #include "DetectorsBase/MaterialManager.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace o2
 {
 namespace hmpid
@@ -40,7 +44,10 @@ namespace hmpid
 Detector::Detector(Bool_t active) : o2::base::DetImpl<Detector>("HMP", active), mHits(new std::vector<HitType>) {}
 
 Detector::Detector(const Detector& other) : mSensitiveVolumes(other.mSensitiveVolumes),
-                                            mHits(new std::vector<HitType>) {}
+                                            mHits(new std::vector<HitType>),
+                                            mFastCherenkov(other.mFastCherenkov),
+                                            mCkovBins(other.mCkovBins),
+                                            mCkovMaxNRad(other.mCkovMaxNRad) {}
 
 void Detector::InitializeO2Detector()
 {
@@ -48,6 +55,9 @@ void Detector::InitializeO2Detector()
     LOG(DEBUG) << "HMPID: registering sensitive " << sensitiveHpad->GetName();
     AddSensitiveVolume(sensitiveHpad);
   }
+  if (mFastCherenkov) {
+    initFastCherenkov();
+  }
 }
 //*********************************************************************************************************
 bool Detector::ProcessHits(FairVolume* v)
@@ -55,6 +65,11 @@ bool Detector::ProcessHits(FairVolume* v)
   TString volname = fMC->CurrentVolName();
   auto stack = (o2::data::Stack*)fMC->GetStack();
 
+  //Cherenkov photons of charged particles in the radiator, without their transport
+  if (mFastCherenkov && fMC->TrackCharge() && volname == "Hrad") {
+    return fastCherenkovPhotons();
+  }
+
   //Treat photons
   //photon (Ckov or feedback) hits on module PC (Hpad)
   if ((fMC->TrackPid() == 50000050 || fMC->TrackPid() == 50000051) && volname.Contains("Hpad")) {
@@ -265,7 +280,7 @@ Float_t Detector::Fresnel(Float_t ene, Float_t pdoti, Bool_t pola)
                        0.69, 0.612, 0.649, 0.824, 1.347, 1.571, 1.678, 1.763, 1.857, 1.824, 1.824,
                        1.714, 1.498 };
   Float_t xe = ene;
-  Int_t j = Int_t(xe * 10) - 49;
+  Int_t j = std::min(std::max(Int_t(xe * 10) - 49, 0), 34); // interpolation within the table
   Float_t cn = csin[j] + ((csin[j + 1] - csin[j]) / 0.1) * (xe - en[j]);
   Float_t ck = csik[j] + ((csik[j + 1] - csik[j]) / 0.1) * (xe - en[j]);
 
@@ -446,6 +461,9 @@ void Detector::createMaterials()
 
   Mixture(++matId, "C6F14", aC6F14, zC6F14, dC6F14, nC6F14, wC6F14);
   Medium(kC6F14, "C6F14", matId, unsens, itgfld, maxfld, tmaxfd, stemax, deemax, epsil, stmin);
+  if (mFastCherenkov) {
+    SpecialProcess(kC6F14, o2::base::EProc::kCKOV, 0); // the radiator photons are made by fastCherenkovPhotons()
+  }
 
   Mixture(++matId, "SiO2", aSiO2, zSiO2, dSiO2, nSiO2, wSiO2);
   Medium(kSiO2, "SiO2", matId, unsens, itgfld, maxfld, tmaxfd, stemax, deemax, epsil, stmin);
@@ -504,6 +522,9 @@ TGeoVolume* Detector::createChamber(int number)
   TGeoVolume* cov = gGeoManager->MakeBox("Hcov", al, 1419 * mm / 2, 1378.00 * mm / 2, 0.5 * mm / 2);
   TGeoVolume* hon = gGeoManager->MakeBox("Hhon", roha, 1359 * mm / 2, 1318.00 * mm / 2, 49.5 * mm / 2);
   TGeoVolume* rad = gGeoManager->MakeBox("Hrad", c6f14, 1330 * mm / 2, 413.00 * mm / 2, 24.0 * mm / 2); // 2011P1
+  if (mFastCherenkov) {
+    mSensitiveVolumes.emplace_back(rad); // charged steps in the C6F14 for the fast Cherenkov photons
+  }
   TGeoVolume* neo = gGeoManager->MakeBox("Hneo", neoc, 1330 * mm / 2, 413.00 * mm / 2, 4.0 * mm / 2);
   TGeoVolume* win = gGeoManager->MakeBox("Hwin", sio2, 1330 * mm / 2, 413.00 * mm / 2, 5.0 * mm / 2);
   TGeoVolume* si1 = gGeoManager->MakeBox("Hsi1", sio2, 1330 * mm / 2, 5.00 * mm / 2, 15.0 * mm / 2);
@@ -1212,6 +1233,7 @@ void Detector::ConstructGeometry()
   // Creates detailed geometry simulation (currently GEANT volumes tree)
   // includind the HMPID cradle
 
+  mFastCherenkov = HMPIDSimParam::Instance().fastCherenkov;
   createMaterials();
 
   TGeoVolume* hmpcradle = CreateCradle();
@@ -1304,6 +1326,162 @@ void Detector::defineOpticalProperties()
   }
 }
 
+//*****************************************************************************************************************
+void Detector::initFastCherenkov()
+{
+  // Optical properties of the photon energy bins for the fast Cherenkov photons, the parametrisations are the ones
+  // of defineOpticalProperties() taken at the centres of the bins
+  const float temp = HMPIDSimParam::Instance().radTemperature;
+  const Bool_t isFlatIdx = TString(GetTitle()).Contains("FlatIdx");
+  const double deltaE = (Param::EPhotMax() - Param::EPhotMin()) / NCkovBins;
+  mCkovMaxNRad = 0;
+  for (int i = 0; i < NCkovBins; i++) {
+    auto& bin = mCkovBins[i];
+    double eV = Param::EPhotMin() + deltaE * (i + 0.5);
+    bin.eV = eV;
+    bin.nRad = isFlatIdx ? 1.292 : Param::NIdxRad(eV, temp);
+    bin.nWin = Param::NIdxWin(eV);
+    bin.nGap = Param::NIdxGap(eV);
+    bin.absRad = Param::LAbsRad(eV);
+    bin.absWin = Param::LAbsWin(eV);
+    bin.absGap = Param::LAbsGap(eV);
+    bin.qe = Param::QEffCSI(eV);
+    mCkovMaxNRad = std::max(mCkovMaxNRad, bin.nRad);
+  }
+  LOG(INFO) << "HMPID: Cherenkov photons of the C6F14 computed analytically, no optical photon transport";
+}
+//*****************************************************************************************************************
+bool Detector::fastCherenkovPhotons()
+{
+  // Cherenkov photons of the current step of a charged particle in the C6F14, made and propagated to the
+  // photocathode (PC) in one go instead of being transported by the MC:
+  // - the number of photons is drawn from the Frank-Tamm yield of the step, only for the photons which
+  //   would survive the CsI quantum efficiency, and their energy from the yield of each energy bin;
+  // - each photon is emitted at a random point of the step on the Cherenkov cone and followed along straight
+  //   lines in the chamber frame (z along the normal, from the radiator to the PC): C6F14 up to the window
+  //   (z=-0.5), SiO2 up to the window-gap surface (z=0), CH4 up to the PC (z=8), with the Snell refraction,
+  //   total reflection and Fresnel transmission at the two interfaces and the absorption in the three media;
+  // - a photon surviving these and the Fresnel reflection on the PC makes the same hit as a photon transported
+  //   by the MC, attributed to the charged particle.
+  // Arguments: none
+  //   Returns: true if some photons made hits
+  const double zRadMin = -2.0, zWin = -0.5, zGap = 0, zPc = 8.0; // radiator, window and gap limits, [cm]
+  const double cLight = 29.9792458;                               // [cm/ns]
+  const double kYield = 369.81;                                   // alpha/(hbar c), [eV^-1 cm^-1]
+
+  TLorentzVector p4;
+  fMC->TrackMomentum(p4);
+  const double step = fMC->TrackStep(), mom = p4.P();
+  if (step <= 0 || mom <= 0) {
+    return false;
+  }
+  const double beta = mom / p4.E();
+  if (beta * mCkovMaxNRad <= 1) {
+    return false; //below threshold at all energies
+  }
+
+  //cumulative yield of the detectable photons of the energy bins, per eV per cm
+  std::array<double, NCkovBins> cumYield;
+  double yield = 0;
+  for (int i = 0; i < NCkovBins; i++) {
+    const auto& bin = mCkovBins[i];
+    double sin2 = 1 - 1 / (beta * beta * bin.nRad * bin.nRad);
+    yield += (sin2 > 0) ? sin2 * bin.qe : 0;
+    cumYield[i] = yield;
+  }
+  const double charge = fMC->TrackCharge();
+  const double deltaE = (Param::EPhotMax() - Param::EPhotMin()) / NCkovBins;
+  auto rnd = fMC->GetRandom();
+  Int_t nPhotons = rnd->Poisson(kYield * charge * charge * step * deltaE * yield);
+  if (nPhotons == 0) {
+    return false;
+  }
+
+  //the step in the chamber frame, Hrad being placed in Hmp%i
+  TString chName = fMC->CurrentVolOffName(1);
+  chName.Remove(0, 3);
+  const Int_t idch = chName.Atoi();
+  auto param = Param::Instance();
+  double pos[3], dir[3] = { p4.Px() / mom, p4.Py() / mom, p4.Pz() / mom }, lpos[3], ldir[3];
+  fMC->TrackPosition(pos[0], pos[1], pos[2]);
+  param->Mars2Lors(idch, pos, lpos);
+  param->Mars2LorsVec(idch, dir, ldir);
+  const double trackTime = fMC->TrackTime(); //[s]
+
+  //two unit vectors normal to the track for the Cherenkov cone
+  double e1[3];
+  if (std::abs(ldir[0]) < 0.9) {
+    e1[0] = 0, e1[1] = ldir[2], e1[2] = -ldir[1];
+  } else {
+    e1[0] = -ldir[2], e1[1] = 0, e1[2] = ldir[0];
+  }
+  const double norm = 1 / std::sqrt(e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2]);
+  e1[0] *= norm, e1[1] *= norm, e1[2] *= norm;
+  const double e2[3] = { ldir[1] * e1[2] - ldir[2] * e1[1], ldir[2] * e1[0] - ldir[0] * e1[2], ldir[0] * e1[1] - ldir[1] * e1[0] };
+
+  //transmission through a dielectric interface, unpolarised light
+  auto transmission = [](double n1, double cos1, double n2, double cos2) {
+    double rs = (n1 * cos1 - n2 * cos2) / (n1 * cos1 + n2 * cos2);
+    double rp = (n2 * cos1 - n1 * cos2) / (n2 * cos1 + n1 * cos2);
+    return 1 - 0.5 * (rs * rs + rp * rp);
+  };
+
+  auto stack = (o2::data::Stack*)fMC->GetStack();
+  Int_t tid = stack->GetCurrentTrackNumber();
+  int nHits = 0;
+  for (Int_t iPhot = 0; iPhot < nPhotons; iPhot++) {
+    Double_t ranf[3];
+    rnd->RndmArray(3, ranf);
+    const auto& bin = mCkovBins[std::min(int(std::upper_bound(cumYield.begin(), cumYield.end(), ranf[0] * yield) - cumYield.begin()), NCkovBins - 1)];
+    const double back = ranf[1] * step; //emission point from the end of the step
+    const double z0 = std::min(std::max(lpos[2] - back * ldir[2], zRadMin), zWin);
+    const double cosTh = 1 / (beta * bin.nRad), sinTh = std::sqrt(std::max(0., 1 - cosTh * cosTh));
+    const double phi = ranf[2] * 2 * TMath::Pi(), cosPh = std::cos(phi), sinPh = std::sin(phi);
+    double d[3];
+    for (int k = 0; k < 3; k++) {
+      d[k] = cosTh * ldir[k] + sinTh * (cosPh * e1[k] + sinPh * e2[k]);
+    }
+    if (d[2] <= 0) {
+      continue; //towards the neoceram
+    }
+
+    //C6F14 -> SiO2 -> CH4: the tangential components of the direction scale with n1/n2
+    const double win[2] = { d[0] * bin.nRad / bin.nWin, d[1] * bin.nRad / bin.nWin };
+    const double gap[2] = { win[0] * bin.nWin / bin.nGap, win[1] * bin.nWin / bin.nGap };
+    const double sin2Win = win[0] * win[0] + win[1] * win[1], sin2Gap = gap[0] * gap[0] + gap[1] * gap[1];
+    if (sin2Win >= 1 || sin2Gap >= 1) {
+      continue; //total reflection
+    }
+    const double cosRad = d[2], cosWin = std::sqrt(1 - sin2Win), cosGap = std::sqrt(1 - sin2Gap);
+    const double sRad = (zWin - z0) / cosRad, sWin = (zGap - zWin) / cosWin, sGap = (zPc - zGap) / cosGap; //path lengths
+    double prob = transmission(bin.nRad, cosRad, bin.nWin, cosWin) * transmission(bin.nWin, cosWin, bin.nGap, cosGap);
+    prob *= std::exp(-sRad / bin.absRad - sWin / bin.absWin - sGap / bin.absGap);
+    prob *= 1 - Fresnel(bin.eV, cosGap, 1);
+    if (rnd->Rndm() >= prob) {
+      continue; //absorbed or reflected
+    }
+
+    //on the PC
+    const float xl = lpos[0] - back * ldir[0] + d[0] * sRad + win[0] * sWin + gap[0] * sGap;
+    const float yl = lpos[1] - back * ldir[1] + d[1] * sRad + win[1] * sWin + gap[1] * sGap;
+    Int_t pc, px, py;
+    Param::Lors2Pad(xl, yl, pc, px, py);
+    if (px < 0 || py < 0) {
+      continue; //between the PCs
+    }
+    double x[3];
+    param->Lors2Mars(idch, xl, yl, x);
+    const double path = bin.nRad * sRad + bin.nWin * sWin + bin.nGap * sGap;
+    Float_t hitTime = trackTime + (path - back / beta) / cLight * 1e-9; //emission time plus time of flight
+    AddHit(x[0], x[1], x[2], hitTime, bin.eV * 1e-9, tid, idch);     //HIT for photon, etot will be set to Q
+    nHits++;
+  }
+  if (nHits) {
+    stack->addHit(GetDetId());
+  }
+  return nHits > 0;
+}
+
 } // end namespace hmpid
 } // end namespace o2
 
@@ -49,7 +49,9 @@ void HMPIDDigitizer::flush(std::vector<o2::hmpid::Digit>& digits)
 
 void HMPIDDigitizer::reset()
 {
-  mIndexForPad.clear();
+  for (auto pad : mInvolvedPads) {
+    mIndexForPad[pad] = -1;
+  }
   mInvolvedPads.clear();
   mDigits.clear();
   mTmpLabelContainer.clear();
@@ -58,6 +60,10 @@ void HMPIDDigitizer::reset()
 // this will process hits and fill the digit vector with digits which are finalized
 void HMPIDDigitizer::process(std::vector<o2::hmpid::HitType> const& hits, std::vector<o2::hmpid::Digit>& digits)
 {
+  if (mIndexForPad.empty()) {
+    mIndexForPad.assign(NPADS, -1);
+  }
+  std::array<float, 9> fractions;
   for (auto& hit : hits) {
     int chamber, pc, px, py;
     float totalQ;
@@ -68,53 +74,48 @@ void HMPIDDigitizer::process(std::vector<o2::hmpid::HitType> const& hits, std::v
       continue;
     }
 
-    // determine which pads to loop over
-    std::array<int, 9> allpads;
+    // charge fractions of the 3x3 pads around the center pad
+    Digit::getFractionalContributionsForPads(hit, pc, px, py, fractions);
+    const o2::MCCompLabel newlabel(hit.GetTrackID(), mEventID, mSrcID);
+
     int counter = 0;
     for (int nx = -1; nx <= 1; ++nx) {
       for (int ny = -1; ny <= 1; ++ny) {
-        allpads[counter] = Param::Abs(chamber, pc, px + nx, py + ny);
-        counter++;
-      }
-    }
-
-    for (auto& pad : allpads) {
-      auto iter = mIndexForPad.find(pad);
-      int index = -1;
-      if (iter != mIndexForPad.end()) {
-        index = iter->second;
-      }
-      // auto index = mIndexForPad[pad];
-      float fraction = Digit::getFractionalContributionForPad(hit, pad);
-      // LOG(INFO) << "FRACTION ON PAD " << pad << " IS " << fraction;
-      if (index != -1) {
-        // digit exists ... reuse
-        auto& digit = mDigits[index];
-        digit.addCharge(totalQ * fraction);
+        const float fraction = fractions[counter++];
+        const int x = px + nx, y = py + ny;
+        if (x < 0 || x >= Param::kPadPcX || y < 0 || y >= Param::kPadPcY) {
+          continue; // no such pad in this pc
+        }
+        const int flatpad = flatPadIndex(chamber, pc, x, y);
+        const int index = mIndexForPad[flatpad];
+        if (index != -1) {
+          // digit exists ... reuse
+          auto& digit = mDigits[index];
+          digit.addCharge(totalQ * fraction);
 
-        if (mRegisteredLabelContainer) {
-          auto labels = mTmpLabelContainer.getLabels(index);
-          o2::MCCompLabel newlabel(hit.GetTrackID(), mEventID, mSrcID);
-          bool newlabelneeded = true;
-          for (auto& l : labels) {
-            if (l == newlabel) {
-              newlabelneeded = false;
-              break;
+          if (mRegisteredLabelContainer) {
+            auto labels = mTmpLabelContainer.getLabels(index);
+            bool newlabelneeded = true;
+            for (auto& l : labels) {
+              if (l == newlabel) {
+                newlabelneeded = false;
+                break;
+              }
+            }
+            if (newlabelneeded) {
+              mTmpLabelContainer.addElementRandomAccess(index, newlabel);
             }
           }
-          if (newlabelneeded) {
-            mTmpLabelContainer.addElementRandomAccess(index, newlabel);
-          }
-        }
-      } else {
-        // create digit ... and register
-        mDigits.emplace_back(mCurrentTriggerTime, pad, totalQ * fraction);
-        mIndexForPad[pad] = mDigits.size() - 1;
-        mInvolvedPads.emplace_back(pad);
+        } else {
+          // create digit ... and register
+          mDigits.emplace_back(mCurrentTriggerTime, Param::Abs(chamber, pc, x, y), totalQ * fraction);
+          mIndexForPad[flatpad] = mDigits.size() - 1;
+          mInvolvedPads.emplace_back(flatpad);
 
-        if (mRegisteredLabelContainer) {
-          // add label for this digit
-          mTmpLabelContainer.addElement(mDigits.size() - 1, o2::MCCompLabel(hit.GetTrackID(), mEventID, mSrcID));
+          if (mRegisteredLabelContainer) {
+            // add label for this digit
+            mTmpLabelContainer.addElement(mDigits.size() - 1, newlabel);
+          }
         }
       }
     }
@@ -20,15 +20,17 @@
 //    The pattern recongintion based on the "cooked covariance" approach
 //-------------------------------------------------------------------------
 
+#include <array>
+#include <atomic>
 #include <vector>
 #include "ITSBase/GeometryTGeo.h"
 #include "MathUtils/Cartesian3D.h"
 #include "DataFormatsITS/TrackITS.h"
 #include "DataFormatsITSMFT/ROFRecord.h"
+#include "SimulationDataFormat/MCCompLabel.h"
 
 namespace o2
 {
-class MCCompLabel;
 namespace dataformats
 {
 template <typename T>
@@ -97,9 +99,18 @@ class CookedTracker
   int loadClusters(const std::vector<Cluster>& clusters, const o2::itsmft::ROFRecord& rof);
   void unloadClusters();
 
-  std::vector<TrackITS> trackInThread(Int_t first, Int_t last);
-  void makeSeeds(std::vector<TrackITS>& seeds, Int_t first, Int_t last);
-  void trackSeeds(std::vector<TrackITS>& seeds);
+  /// Tracks and MC labels found from a group of clusters of the outermost seeding layer
+  struct SeedingUnit {
+    std::vector<Int_t> clusters;         ///< indices of the seeding clusters
+    std::vector<TrackITS> tracks;        ///< accepted tracks, ready to be stored
+    std::vector<o2::MCCompLabel> labels; ///< MC labels of the accepted tracks
+    Int_t nSeeds = 0;                    ///< number of seeds made from these clusters
+  };
+
+  void trackInThread(std::atomic<int>& nextUnit, std::vector<SeedingUnit>& units);
+  void trackUnit(SeedingUnit& unit) const;
+  void makeSeeds(std::vector<TrackITS>& seeds, const std::vector<Int_t>& clusters, const std::array<Double_t, 3>& vtx) const;
+  void trackSeeds(std::vector<TrackITS>& seeds) const;
 
   Bool_t attachCluster(Int_t& volID, Int_t nl, Int_t ci, TrackITS& t, const TrackITS& o) const;
 
@@ -146,13 +157,15 @@ class CookedTracker::Layer
   Bool_t insertCluster(const Cluster* c);
   void setR(Double_t r) { mR = r; }
   void unloadClusters();
-  void selectClusters(std::vector<Int_t>& s, Float_t phi, Float_t dy, Float_t z, Float_t dz);
+  void selectClusters(std::vector<Int_t>& s, Float_t phi, Float_t dy, Float_t z, Float_t dz) const;
   Int_t findClusterIndex(Float_t z) const;
   Float_t getR() const { return mR; }
   const Cluster* getCluster(Int_t i) const { return mClusters[i]; }
   Float_t getAlphaRef(Int_t i) const { return mAlphaRef[i]; }
   Float_t getClusterPhi(Int_t i) const { return mPhi[i]; }
   Int_t getNumberOfClusters() const { return mClusters.size(); }
+  void getSectorClusters(Int_t s, std::vector<Int_t>& clusters) const;
+  static constexpr Int_t getNumberOfSectors() { return kNSectors; }
   void setGeometry(o2::ITS::GeometryTGeo* geom) { mGeom = geom; }
 
  protected:
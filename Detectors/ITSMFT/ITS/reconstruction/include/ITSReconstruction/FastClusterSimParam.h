@@ -0,0 +1,38 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_ITS_FASTCLUSTERSIMPARAM_H_
+#define ALICEO2_ITS_FASTCLUSTERSIMPARAM_H_
+
+#include "SimConfig/ConfigurableParam.h"
+#include "SimConfig/ConfigurableParamHelper.h"
+
+namespace o2
+{
+namespace ITS
+{
+
+// parameters of the parametrized ITS clusters of FastClusterSimulation
+struct FastClusterSimParam : public o2::conf::ConfigurableParamHelper<FastClusterSimParam> {
+  float efficiency = 0.99; // probability of a track crossing the active matrix of a chip to make a cluster
+  float minPt = 0.02;      // GeV, slower tracks are not propagated
+  float maxSnp = 0.85;     // max sine of the track inclination in the frames of the chips
+  float maxStep = 2.;      // cm, max propagation step
+  int matCorr = 0;         // material correction of the propagation (energy loss only, 0: none)
+  unsigned int seed = 0;   // of the efficiency and topology sampling (0: default seed of the topology sampler)
+
+  // boilerplate stuff + make principal key "ITSFastSim"
+  O2ParamDef(FastClusterSimParam, "ITSFastSim");
+};
+
+} // namespace ITS
+} // namespace o2
+
+#endif /* ALICEO2_ITS_FASTCLUSTERSIMPARAM_H_ */
@@ -0,0 +1,106 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FastClusterSimulation.h
+/// \brief Parametrized ITS clusters of generated tracks
+///
+/// The charged tracks of the MC kinematics are propagated analytically (o2::base::Propagator, constant
+/// field and no multiple scattering) through the chips of the ITS layers. A chip crossed in its active
+/// matrix makes a cluster, with the layer efficiency FastClusterSimParam::efficiency, whose topology is
+/// drawn from the frequencies of the topology dictionary (itsmft::TopologyFastSimulation) and placed
+/// with its centre of gravity at the crossing point. The transport, digitization and clusterization
+/// are skipped: the outputs are the ones of the Clusterer, for the tracking performance studies.
+
+#ifndef ALICEO2_ITS_FASTCLUSTERSIMULATION_H
+#define ALICEO2_ITS_FASTCLUSTERSIMULATION_H
+
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "DataFormatsITSMFT/Cluster.h"
+#include "DataFormatsITSMFT/CompCluster.h"
+#include "DataFormatsITSMFT/ROFRecord.h"
+#include "ITSMFTReconstruction/TopologyFastSimulation.h"
+#include "ReconstructionDataFormats/Track.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTrack.h"
+
+namespace o2
+{
+namespace dataformats
+{
+template <typename T>
+class MCTruthContainer;
+}
+
+namespace ITS
+{
+class GeometryTGeo;
+
+class FastClusterSimulation
+{
+  using Cluster = o2::itsmft::Cluster;
+  using CompClusterExt = o2::itsmft::CompClusterExt;
+  using MCTruth = o2::dataformats::MCTruthContainer<o2::MCCompLabel>;
+
+ public:
+  FastClusterSimulation() = default;
+  FastClusterSimulation(const FastClusterSimulation&) = delete;
+  FastClusterSimulation& operator=(const FastClusterSimulation&) = delete;
+  ~FastClusterSimulation() = default;
+
+  /// \param geom ITS geometry, with the T2L matrices cached
+  /// \param dictionary binary file of the topology dictionary
+  /// \param bz field (kG) of the propagation
+  void init(const GeometryTGeo* geom, const std::string& dictionary, float bz);
+
+  /// clusters of the tracks of one MC event, appended to the outputs (any of them may be nullptr),
+  /// the event makes one readout frame
+  void processEvent(const std::vector<o2::MCTrack>& tracks, int eventID, int sourceID, std::vector<Cluster>* fullClus,
+                    std::vector<CompClusterExt>* compClus, MCTruth* labels, std::vector<o2::itsmft::ROFRecord>* rofs,
+                    std::vector<o2::itsmft::MC2ROFRecord>* mc2rofs);
+
+  int getNClusters() const { return mNClusters; }
+
+ private:
+  static constexpr int NLayers = 7;
+
+  /// chip in the tracking frame: frame and centre of the sensor
+  struct ChipFrame {
+    int id;
+    float alpha;
+    float x;
+    float y;
+    float z;
+  };
+
+  void processTrack(const o2::MCTrack& mc, const o2::MCCompLabel& label, unsigned int rof, std::vector<Cluster>* fullClus,
+                    std::vector<CompClusterExt>* compClus, MCTruth* labels);
+  /// cluster of the track crossing the chip at the local coordinates x, z, false if it does not make one
+  bool addCluster(const ChipFrame& chip, float xLoc, float zLoc, const o2::MCCompLabel& label, unsigned int rof,
+                  std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus, MCTruth* labels);
+
+  const GeometryTGeo* mGeom = nullptr;
+  std::unique_ptr<o2::itsmft::TopologyFastSimulation> mTopologies;
+  float mBz = 0.f;
+  std::array<float, NLayers> mLayerX;                             ///< mean X of the chips of the layer
+  std::array<std::vector<std::vector<ChipFrame>>, NLayers> mStaves; ///< chips of each stave of the layer
+  std::mt19937 mGenerator;
+  std::uniform_real_distribution<float> mUniform{ 0.f, 1.f };
+  unsigned int mROFrame = 0; ///< readout frame of the next event
+  int mNClusters = 0;        ///< clusters made so far
+};
+
+} // namespace ITS
+} // namespace o2
+
+#endif /* ALICEO2_ITS_FASTCLUSTERSIMULATION_H */
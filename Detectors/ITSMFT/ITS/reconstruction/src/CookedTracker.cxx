@@ -19,6 +19,7 @@
 #include <chrono>
 #include <future>
 #include <map>
+#include <numeric>
 
 #include <TGeoGlobalMagField.h>
 #include <TMath.h>
@@ -259,13 +260,15 @@ static TrackITS cookSeed(const Point3Df& r1, Point3Df& r2, const Point3Df& tr3,
   return TrackITS(x3, alpha, par, cov);
 }
 
-void CookedTracker::makeSeeds(std::vector<TrackITS>& seeds, Int_t first, Int_t last)
+void CookedTracker::makeSeeds(std::vector<TrackITS>& seeds, const std::vector<Int_t>& clusters,
+                              const std::array<Double_t, 3>& vtx) const
 {
   //--------------------------------------------------------------------
   // This is the main pattern recongition function.
   // Creates seeds out of two clusters and another point.
+  // The vertex is passed explicitly, since this is called from several threads.
   //--------------------------------------------------------------------
-  const float zv = getZ();
+  const float zv = vtx[2];
 
   Layer& layer1 = sLayers[kSeedingLayer1];
   Layer& layer2 = sLayers[kSeedingLayer2];
@@ -279,7 +282,7 @@ void CookedTracker::makeSeeds(std::vector<TrackITS>& seeds, Int_t first, Int_t l
   Int_t nClusters2 = layer2.getNumberOfClusters();
   Int_t nClusters3 = layer3.getNumberOfClusters();
 
-  for (Int_t n1 = first; n1 < last; n1++) {
+  for (auto n1 : clusters) {
     const Cluster* c1 = layer1.getCluster(n1);
     //
     //auto lab = (mClsLabels->getLabels(c1-mFirstCluster))[0];
@@ -307,7 +310,7 @@ void CookedTracker::makeSeeds(std::vector<TrackITS>& seeds, Int_t first, Int_t l
       auto z2 = xyz2.Z();
       auto r2 = xyz2.rho();
 
-      Float_t hcrv = 0.5 * f1(xyz1.X(), xyz1.Y(), xyz2.X(), xyz2.Y(), getX(), getY());
+      Float_t hcrv = 0.5 * f1(xyz1.X(), xyz1.Y(), xyz2.X(), xyz2.Y(), vtx[0], vtx[1]);
 
       auto zr3 = z1 + (layer3.getR() - r1) / (r2 - r1) * (z2 - z1);
       auto phir3 = phi1 + hcrv * (layer3.getR() - r1);
@@ -334,7 +337,7 @@ void CookedTracker::makeSeeds(std::vector<TrackITS>& seeds, Int_t first, Int_t l
         TrackITS seed = cookSeed(xyz1, xyz3, txyz2, layer2.getR(), layer3.getR(), layer2.getAlphaRef(n2), getBz());
 
         float ip[2];
-        seed.getImpactParams(getX(), getY(), getZ(), getBz(), ip);
+        seed.getImpactParams(vtx[0], vtx[1], vtx[2], getBz(), ip);
         if (TMath::Abs(ip[0]) > kmaxDCAxy)
           continue;
         if (TMath::Abs(ip[1]) > kmaxDCAz)
@@ -369,7 +372,7 @@ void CookedTracker::makeSeeds(std::vector<TrackITS>& seeds, Int_t first, Int_t l
   */
 }
 
-void CookedTracker::trackSeeds(std::vector<TrackITS>& seeds)
+void CookedTracker::trackSeeds(std::vector<TrackITS>& seeds) const
 {
   //--------------------------------------------------------------------
   // Loop over a subset of track seeds
@@ -454,19 +457,28 @@ void CookedTracker::trackSeeds(std::vector<TrackITS>& seeds)
   }
 }
 
-std::vector<TrackITS> CookedTracker::trackInThread(Int_t first, Int_t last)
+void CookedTracker::trackInThread(std::atomic<int>& nextUnit, std::vector<SeedingUnit>& units)
 {
   //--------------------------------------------------------------------
-  // This function is passed to a tracking thread
+  // This function is passed to a tracking thread.
+  // The seeding units are taken one by one until all of them are processed.
+  //--------------------------------------------------------------------
+  int n = units.size();
+  for (int u = nextUnit++; u < n; u = nextUnit++) {
+    trackUnit(units[u]);
+  }
+}
+
+void CookedTracker::trackUnit(SeedingUnit& unit) const
+{
+  //--------------------------------------------------------------------
+  // Make and follow the seeds of one seeding unit, keep the good tracks
   //--------------------------------------------------------------------
   std::vector<TrackITS> seeds;
-  seeds.reserve(last - first + 1);
+  seeds.reserve(unit.clusters.size() + 1);
 
   for (auto& vtx : mVertices) {
-    mX = vtx[0];
-    mY = vtx[1];
-    mZ = vtx[2];
-    makeSeeds(seeds, first, last);
+    makeSeeds(seeds, unit.clusters, vtx);
   }
 
   std::sort(seeds.begin(), seeds.end());
@@ -475,7 +487,16 @@ std::vector<TrackITS> CookedTracker::trackInThread(Int_t first, Int_t last)
 
   makeBackPropParam(seeds);
 
-  return seeds;
+  unit.nSeeds = seeds.size();
+  for (auto& track : seeds) {
+    if (track.getNumberOfClusters() < kminNumberOfClusters)
+      continue;
+    if (mTrkLabels) {
+      unit.labels.push_back(cookLabel(track, 0.)); // For comparison only
+    }
+    track.setROFrame(mROFrame);
+    unit.tracks.push_back(track);
+  }
 }
 
 void CookedTracker::process(const std::vector<Cluster>& clusters, std::vector<TrackITS>& tracks,
@@ -535,34 +556,72 @@ void CookedTracker::processFrame(std::vector<TrackITS>& tracks)
   }
   LOG(INFO) << "CookedTracker::process(), number of threads: " << mNumOfThreads << " for " << numOfClusters << " clusters";
 
-  std::vector<std::future<std::vector<TrackITS>>> futures(mNumOfThreads);
-  std::vector<std::vector<TrackITS>> seedArray(mNumOfThreads);
-
-  for (Int_t t = 0, first = 0; t < mNumOfThreads; t++) {
-    Int_t rem = t < (numOfClusters % mNumOfThreads) ? 1 : 0;
-    Int_t last = first + (numOfClusters / mNumOfThreads) + rem;
-    futures[t] = std::async(std::launch::async, &CookedTracker::trackInThread, this, first, last);
-    first = last;
-  }
-  Int_t nSeeds = 0, ngood = 0;
-  for (Int_t t = 0; t < mNumOfThreads; t++) {
-    seedArray[t] = futures[t].get();
-    nSeeds += seedArray[t].size();
-    for (auto& track : seedArray[t]) {
-      if (track.getNumberOfClusters() < kminNumberOfClusters)
+  // With several threads the clusters of the outermost seeding layer are grouped by phi sector.
+  // The sectors are distributed dynamically over the threads and merged in the sector order,
+  // so that the result does not depend on the number of threads or on their scheduling.
+  Layer& layer1 = sLayers[kSeedingLayer1];
+  std::vector<SeedingUnit> units(mNumOfThreads > 1 ? Layer::getNumberOfSectors() : 1);
+  if (units.size() > 1) {
+    for (Int_t s = 0; s < units.size(); s++) {
+      layer1.getSectorClusters(s, units[s].clusters);
+    }
+  } else {
+    units[0].clusters.resize(numOfClusters);
+    std::iota(units[0].clusters.begin(), units[0].clusters.end(), 0);
+  }
+
+  std::atomic<int> nextUnit{ 0 };
+  std::vector<std::future<void>> futures;
+  o2::base::Propagator::setMaxThreads(mNumOfThreads); // the back propagation needs a navigator per thread
+  for (Int_t t = 1; t < mNumOfThreads; t++) {
+    futures.push_back(std::async(std::launch::async, &CookedTracker::trackInThread, this, std::ref(nextUnit), std::ref(units)));
+  }
+  trackInThread(nextUnit, units);
+  for (auto& f : futures) {
+    f.wait();
+  }
+
+  // The clusters of the layers below the seeding ones are used only once within a unit.
+  // A track sharing them with a track of a preceding unit is a duplicate and is rejected.
+  // The cluster indices are internal ones until setExternalIndices is called.
+  std::vector<bool> used[kSeedingLayer2];
+  for (Int_t l = 0; l < kSeedingLayer2; l++) {
+    used[l].resize(sLayers[l].getNumberOfClusters(), false);
+  }
+
+  Int_t nSeeds = 0, ngood = 0, nshared = 0;
+  for (auto& unit : units) {
+    nSeeds += unit.nSeeds;
+    for (Int_t it = 0; it < unit.tracks.size(); it++) {
+      auto& track = unit.tracks[it];
+      Int_t noc = track.getNumberOfClusters();
+      bool shared = false;
+      for (Int_t ic = 3; ic < noc && !shared; ic++) {
+        Int_t index = track.getClusterIndex(ic);
+        shared = used[(index & 0xf0000000) >> 28][index & 0x0fffffff];
+      }
+      if (shared) {
+        nshared++;
         continue;
+      }
+      for (Int_t ic = 3; ic < noc; ic++) {
+        Int_t index = track.getClusterIndex(ic);
+        used[(index & 0xf0000000) >> 28][index & 0x0fffffff] = true;
+      }
       if (mTrkLabels) {
-        Label label = cookLabel(track, 0.); // For comparison only
+        const auto& label = unit.labels[it];
         if (label.getTrackID() >= 0)
           ngood++;
         Int_t idx = tracks.size();
         mTrkLabels->addElement(idx, label);
       }
       setExternalIndices(track);
-      track.setROFrame(mROFrame);
       tracks.push_back(track);
     }
   }
+  if (nshared) {
+    LOG(INFO) << "CookedTracker::process(), rejected " << nshared << " tracks sharing clusters with another sector";
+  }
 
   if (nSeeds) {
     LOG(INFO) << "CookedTracker::process(), good_tracks:/seeds: " << ngood << '/' << nSeeds << "-> "
@@ -729,7 +788,7 @@ Int_t CookedTracker::Layer::findClusterIndex(Float_t z) const
   return found - std::begin(mClusters);
 }
 
-void CookedTracker::Layer::selectClusters(std::vector<Int_t>& selec, Float_t phi, Float_t dy, Float_t z, Float_t dz)
+void CookedTracker::Layer::selectClusters(std::vector<Int_t>& selec, Float_t phi, Float_t dy, Float_t z, Float_t dz) const
 {
   //--------------------------------------------------------------------
   // This function selects clusters within the "road"
@@ -767,6 +826,17 @@ void CookedTracker::Layer::selectClusters(std::vector<Int_t>& selec, Float_t phi
   }
 }
 
+void CookedTracker::Layer::getSectorClusters(Int_t s, std::vector<Int_t>& clusters) const
+{
+  //--------------------------------------------------------------------
+  // This function returns the indices of the clusters in a phi sector
+  //--------------------------------------------------------------------
+  clusters.reserve(clusters.size() + mSectors[s].size());
+  for (auto[i, z] : mSectors[s]) {
+    clusters.push_back(i);
+  }
+}
+
 Bool_t CookedTracker::attachCluster(Int_t& volID, Int_t nl, Int_t ci, TrackITS& t, const TrackITS& o) const
 {
   //--------------------------------------------------------------------
@@ -0,0 +1,204 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FastClusterSimulation.cxx
+/// \brief Implementation of the parametrized ITS clusters of generated tracks
+
+#include <algorithm>
+#include <cmath>
+
+#include "TDatabasePDG.h"
+#include "TParticlePDG.h"
+
+#include "DetectorsBase/Propagator.h"
+#include "ITSBase/GeometryTGeo.h"
+#include "ITSMFTBase/SegmentationAlpide.h"
+#include "ITSReconstruction/FastClusterSimParam.h"
+#include "ITSReconstruction/FastClusterSimulation.h"
+#include "MathUtils/Utils.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+
+#include "FairLogger.h"
+
+using namespace o2::ITS;
+using Segmentation = o2::itsmft::SegmentationAlpide;
+
+//__________________________________________________
+void FastClusterSimulation::init(const GeometryTGeo* geom, const std::string& dictionary, float bz)
+{
+  const auto& param = FastClusterSimParam::Instance();
+  mGeom = geom;
+  mBz = bz;
+  mTopologies = param.seed ? std::make_unique<o2::itsmft::TopologyFastSimulation>(dictionary, param.seed)
+                           : std::make_unique<o2::itsmft::TopologyFastSimulation>(dictionary);
+  mGenerator.seed(param.seed ? param.seed : std::mt19937::default_seed);
+  if (mTopologies->getDictionary().GetSize() == 0) {
+    LOG(FATAL) << "ITS fast cluster simulation: no topologies in the dictionary " << dictionary;
+  }
+
+  // the chips of each stave in the tracking frame, where the tracks are propagated to them
+  for (int lay = 0; lay < NLayers; lay++) {
+    auto& staves = mStaves[lay];
+    staves.clear();
+    staves.resize(mGeom->getNumberOfStaves(lay));
+    double sumX = 0.;
+    for (int sta = 0; sta < (int)staves.size(); sta++) {
+      for (int det = 0; det < mGeom->getNumberOfChipsPerStave(lay); det++) {
+        const int id = mGeom->getChipIndex(lay, sta, det);
+        auto centre = mGeom->getMatrixT2L(id) ^ (Point3D<float>(0.f, 0.f, 0.f)); // local origin in the tracking frame
+        staves[sta].push_back({ id, mGeom->getSensorRefAlpha(id), centre.X(), centre.Y(), centre.Z() });
+        sumX += centre.X();
+      }
+    }
+    mLayerX[lay] = sumX / mGeom->getNumberOfChipsPerLayer(lay);
+  }
+  mROFrame = 0;
+  mNClusters = 0;
+  LOG(INFO) << "ITS fast cluster simulation with " << mTopologies->getDictionary().GetSize()
+            << " topologies, efficiency " << param.efficiency << ", Bz " << mBz << " kG";
+}
+
+//__________________________________________________
+void FastClusterSimulation::processEvent(const std::vector<o2::MCTrack>& tracks, int eventID, int sourceID,
+                                         std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                                         MCTruth* labels, std::vector<o2::itsmft::ROFRecord>* rofs,
+                                         std::vector<o2::itsmft::MC2ROFRecord>* mc2rofs)
+{
+  const int first = mNClusters;
+  for (int i = 0; i < (int)tracks.size(); i++) {
+    processTrack(tracks[i], o2::MCCompLabel(i, eventID, sourceID), mROFrame, fullClus, compClus, labels);
+  }
+  if (rofs) {
+    o2::itsmft::ROFRecord rof;
+    rof.setROFrame(mROFrame);
+    rof.getROFEntry().setIndex(first);
+    rof.setNROFEntries(mNClusters - first);
+    rofs->push_back(rof);
+  }
+  if (mc2rofs) {
+    mc2rofs->emplace_back(eventID, mROFrame, mROFrame, mROFrame);
+  }
+  mROFrame++;
+}
+
+//__________________________________________________
+void FastClusterSimulation::processTrack(const o2::MCTrack& mc, const o2::MCCompLabel& label, unsigned int rof,
+                                         std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                                         MCTruth* labels)
+{
+  constexpr float HalfRows = 0.5f * Segmentation::SensorSizeRows, HalfCols = 0.5f * Segmentation::SensorSizeCols;
+  const auto& param = FastClusterSimParam::Instance();
+  const auto pdg = TDatabasePDG::Instance()->GetParticle(mc.GetPdgCode());
+  if (!pdg || pdg->Charge() == 0. || mc.GetPt() < param.minPt) {
+    return;
+  }
+  const float mass = pdg->Mass();
+  const int charge = std::lround(pdg->Charge() / 3.);
+  std::array<float, 3> xyz{ float(mc.GetStartVertexCoordinatesX()), float(mc.GetStartVertexCoordinatesY()),
+                            float(mc.GetStartVertexCoordinatesZ()) };
+  std::array<float, 3> pxyz{ float(mc.GetStartVertexMomentumX()), float(mc.GetStartVertexMomentumY()),
+                             float(mc.GetStartVertexMomentumZ()) };
+  std::array<float, o2::track::kLabCovMatSize> cov{}; // the clusters are placed from the track parameters only
+  o2::track::TrackParCov track(xyz, pxyz, cov, charge ? charge : (pdg->Charge() > 0 ? 1 : -1), false);
+  const float r0 = std::sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1]);
+
+  auto propagator = o2::base::Propagator::Instance();
+  for (int lay = 0; lay < NLayers; lay++) {
+    if (mLayerX[lay] < r0) {
+      continue; // the track starts outside this layer
+    }
+    // to the mean radius of the layer, in the frame of the azimuth of the track
+    auto pos = track.getXYZGlo();
+    if (pos.Perp2() > 1.f && !track.rotate(std::atan2(pos.Y(), pos.X()))) {
+      return;
+    }
+    if (!propagator->propagateToX(track, mLayerX[lay], mBz, mass, param.maxSnp, param.maxStep, param.matCorr)) {
+      return;
+    }
+    pos = track.getXYZGlo();
+    const float phi = std::atan2(pos.Y(), pos.X());
+    const auto& staves = mStaves[lay];
+    const float maxDPhi = 2.f * M_PI / staves.size(); // the staves next to the closest one may overlap it
+
+    for (const auto& stave : staves) {
+      float dphi = std::abs(stave.front().alpha - phi);
+      if (std::min(dphi, float(2. * M_PI) - dphi) > maxDPhi) {
+        continue;
+      }
+      auto t = track;
+      for (const auto& chip : stave) {
+        if (std::abs(t.getZ() - chip.z) > HalfCols + 1.f) {
+          continue; // far from this chip, it is not worth the propagation
+        }
+        if (t.getAlpha() != chip.alpha && !t.rotate(chip.alpha)) {
+          break;
+        }
+        if (!propagator->propagateToX(t, chip.x, mBz, mass, param.maxSnp, param.maxStep, param.matCorr)) {
+          break;
+        }
+        if (std::abs(t.getY() - chip.y) > HalfRows || std::abs(t.getZ() - chip.z) > HalfCols) {
+          continue;
+        }
+        auto loc = mGeom->getMatrixT2L(chip.id)(Point3D<float>(t.getX(), t.getY(), t.getZ()));
+        addCluster(chip, loc.X(), loc.Z(), label, rof, fullClus, compClus, labels);
+      }
+    }
+  }
+}
+
+//__________________________________________________
+bool FastClusterSimulation::addCluster(const ChipFrame& chip, float xLoc, float zLoc, const o2::MCCompLabel& label,
+                                       unsigned int rof, std::vector<Cluster>* fullClus,
+                                       std::vector<CompClusterExt>* compClus, MCTruth* labels)
+{
+  constexpr Float_t SigmaX2 = Segmentation::PitchRow * Segmentation::PitchRow / 12.;
+  constexpr Float_t SigmaY2 = Segmentation::PitchCol * Segmentation::PitchCol / 12.;
+
+  // fractional row and column of the crossing, the pixel centres being at integer values
+  float x0, z0;
+  Segmentation::detectorToLocalUnchecked(0, 0, x0, z0);
+  const float row = (x0 - xLoc) / Segmentation::PitchRow, col = (zLoc - z0) / Segmentation::PitchCol;
+  if (row < -0.5f || row > Segmentation::NRows - 0.5f || col < -0.5f || col > Segmentation::NCols - 0.5f) {
+    return false; // outside of the active matrix
+  }
+  if (mUniform(mGenerator) > FastClusterSimParam::Instance().efficiency) {
+    return false;
+  }
+
+  // topology with its centre of gravity (in pixels from the corner of the bounding box) at the crossing
+  auto& dictionary = mTopologies->getDictionary();
+  const int pattID = std::min(mTopologies->getRandom(), dictionary.GetSize() - 1);
+  const auto pattern = dictionary.GetPattern(pattID);
+  const int rowSpan = std::max(pattern.getRowSpan(), 1), colSpan = std::max(pattern.getColumnSpan(), 1);
+  const float rowCOG = dictionary.GetXcog(pattID) - 0.5f, colCOG = dictionary.GetZcog(pattID) - 0.5f;
+  const int rowMin = std::min(std::max(int(std::lround(row - rowCOG)), 0), Segmentation::NRows - rowSpan);
+  const int colMin = std::min(std::max(int(std::lround(col - colCOG)), 0), Segmentation::NCols - colSpan);
+
+  if (fullClus) {
+    fullClus->emplace_back();
+    auto& c = fullClus->back();
+    c.setROFrame(rof);
+    c.setSensorID(chip.id);
+    c.setNxNzN(rowSpan, colSpan, dictionary.GetNpixels(pattID));
+    Point3D<float> xyzLoc;
+    Segmentation::detectorToLocalUnchecked(rowMin + rowCOG, colMin + colCOG, xyzLoc);
+    c.setPos(mGeom->getMatrixT2L(chip.id) ^ (xyzLoc)); // inverse transform from Local to Tracking frame
+    const float errX = dictionary.GetErrX(pattID), errZ = dictionary.GetErrZ(pattID);
+    c.setErrors(errX > 0.f ? errX * errX : SigmaX2, errZ > 0.f ? errZ * errZ : SigmaY2, 0.f);
+  }
+  if (compClus) {
+    compClus->emplace_back(rowMin, colMin, pattID, chip.id, rof);
+  }
+  if (labels) {
+    labels->addElement(mNClusters, label);
+  }
+  mNClusters++;
+  return true;
+}
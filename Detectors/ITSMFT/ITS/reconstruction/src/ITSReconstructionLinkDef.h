@@ -17,5 +17,7 @@
 //#pragma link C++ class o2::ITS::TrivialClustererTask+;
 #pragma link C++ class o2::ITS::ClustererTask+;
 #pragma link C++ class o2::ITS::CookedTracker + ;
+#pragma link C++ class o2::ITS::FastClusterSimParam + ;
+#pragma link C++ class o2::conf::ConfigurableParamHelper < o2::ITS::FastClusterSimParam> + ;
 
 #endif
@@ -37,11 +37,16 @@ class DeviceStoreNV final
  public:
   DeviceStoreNV();
 
-  UniquePointer<DeviceStoreNV> initialise(const float3&,
-                                          const std::array<std::vector<Cluster>, Constants::ITS::LayersNumber>&,
-                                          const std::array<std::vector<Tracklet>, Constants::ITS::TrackletsPerRoad>&,
-                                          const std::array<std::vector<Cell>, Constants::ITS::CellsPerRoad>&,
-                                          const std::array<std::vector<int>, Constants::ITS::CellsPerRoad - 1>&);
+  /// Fills the device structures for a new primary vertex context and copies the store to the device.
+  /// The device buffers are kept across the calls and only reallocated when they have to grow.
+  /// The index tables are taken from the host primary vertex context.
+  void initialise(UniquePointer<DeviceStoreNV>&, const float3&,
+                  const std::array<std::vector<Cluster>, Constants::ITS::LayersNumber>&,
+                  const std::array<std::array<int, Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins + 1>,
+                                   Constants::ITS::TrackletsPerRoad>&,
+                  const std::array<std::vector<Tracklet>, Constants::ITS::TrackletsPerRoad>&,
+                  const std::array<std::vector<Cell>, Constants::ITS::CellsPerRoad>&,
+                  const std::array<std::vector<int>, Constants::ITS::CellsPerRoad - 1>&);
   GPU_DEVICE const float3& getPrimaryVertex();
   GPU_HOST_DEVICE Array<Vector<Cluster>, Constants::ITS::LayersNumber>& getClusters();
   GPU_DEVICE Array<Array<int, Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins + 1>,
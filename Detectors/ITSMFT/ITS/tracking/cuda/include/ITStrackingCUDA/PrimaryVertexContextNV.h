@@ -121,14 +121,15 @@ inline std::array<GPU::Vector<Cell>, Constants::ITS::CellsPerRoad - 1>& PrimaryV
 
 inline void PrimaryVertexContextNV::updateDeviceContext()
 {
-  mGPUContextDevicePointer = GPU::UniquePointer<GPU::DeviceStoreNV>{ mGPUContext };
+  mGPUContextDevicePointer.reset(mGPUContext);
 }
 
 inline void PrimaryVertexContextNV::initialise(const MemoryParameters& memParam, const std::array<std::vector<Cluster>, Constants::ITS::LayersNumber>& cl,
                                                const std::array<float, 3>& pv, const int iteration)
 {
   this->PrimaryVertexContext::initialise(memParam, cl, pv, iteration);
-  mGPUContextDevicePointer = mGPUContext.initialise(mPrimaryVertex, mClusters, mTracklets, mCells, mCellsLookupTable);
+  mGPUContext.initialise(mGPUContextDevicePointer, mPrimaryVertex, mClusters, mIndexTables, mTracklets, mCells,
+                         mCellsLookupTable);
 }
 
 } // namespace ITS
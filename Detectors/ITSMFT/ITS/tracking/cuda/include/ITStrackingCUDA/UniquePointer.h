@@ -58,6 +58,9 @@ class UniquePointer final
   UniquePointer(UniquePointer&&);
   UniquePointer& operator=(UniquePointer&&);
 
+  /// copies the object to the device, the device memory is allocated only once and reused afterwards
+  void reset(const T&);
+
   GPU_HOST_DEVICE T* get() noexcept;
   GPU_HOST_DEVICE const T* get() const noexcept;
   GPU_HOST_DEVICE T& operator*() noexcept;
@@ -101,24 +104,41 @@ UniquePointer<T>::~UniquePointer()
 template <typename T>
 UniquePointer<T>::UniquePointer(UniquePointer<T>&& other) : mDevicePointer{ other.mDevicePointer }
 {
-  // Nothing to do
+  other.mDevicePointer = nullptr;
 }
 
 template <typename T>
 UniquePointer<T>& UniquePointer<T>::operator=(UniquePointer<T>&& other)
 {
-  mDevicePointer = other.mDevicePointer;
-  other.mDevicePointer = nullptr;
+  if (this != &other) {
+
+    destroy();
+
+    mDevicePointer = other.mDevicePointer;
+    other.mDevicePointer = nullptr;
+  }
 
   return *this;
 }
 
+template <typename T>
+void UniquePointer<T>::reset(const T& ref)
+{
+  if (mDevicePointer == nullptr) {
+
+    Utils::Host::gpuMalloc(reinterpret_cast<void**>(&mDevicePointer), sizeof(T));
+  }
+
+  Utils::Host::gpuMemcpyHostToDevice(mDevicePointer, &ref, sizeof(T));
+}
+
 template <typename T>
 void UniquePointer<T>::destroy()
 {
   if (mDevicePointer != nullptr) {
 
     Utils::Host::gpuFree(mDevicePointer);
+    mDevicePointer = nullptr;
   }
 }
 
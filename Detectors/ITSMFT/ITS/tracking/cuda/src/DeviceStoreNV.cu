@@ -14,6 +14,7 @@
 
 #include "ITStrackingCUDA/DeviceStoreNV.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "ITStrackingCUDA/Stream.h"
@@ -22,49 +23,6 @@ namespace {
 
 using namespace o2::ITS;
 
-__device__ void fillIndexTables(GPU::DeviceStoreNV &primaryVertexContext, const int layerIndex)
-{
-
-  const int currentClusterIndex { static_cast<int>(blockDim.x * blockIdx.x + threadIdx.x) };
-  const int nextLayerClustersNum { static_cast<int>(primaryVertexContext.getClusters()[layerIndex + 1].size()) };
-
-  if (currentClusterIndex < nextLayerClustersNum) {
-
-    const int currentBinIndex {
-        primaryVertexContext.getClusters()[layerIndex + 1][currentClusterIndex].indexTableBinIndex };
-    int previousBinIndex;
-
-    if (currentClusterIndex == 0) {
-
-      primaryVertexContext.getIndexTables()[layerIndex][0] = 0;
-      previousBinIndex = 0;
-
-    } else {
-
-      previousBinIndex = primaryVertexContext.getClusters()[layerIndex + 1][currentClusterIndex - 1].indexTableBinIndex;
-    }
-
-    if (currentBinIndex > previousBinIndex) {
-
-      for (int iBin { previousBinIndex + 1 }; iBin <= currentBinIndex; ++iBin) {
-
-        primaryVertexContext.getIndexTables()[layerIndex][iBin] = currentClusterIndex;
-      }
-
-      previousBinIndex = currentBinIndex;
-    }
-
-    if (currentClusterIndex == nextLayerClustersNum - 1) {
-
-      for (int iBin { currentBinIndex + 1 }; iBin <= Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins;
-          iBin++) {
-
-        primaryVertexContext.getIndexTables()[layerIndex][iBin] = nextLayerClustersNum;
-      }
-    }
-  }
-}
-
 __device__ void fillTrackletsPerClusterTables(GPU::DeviceStoreNV &primaryVertexContext, const int layerIndex)
 {
   const int currentClusterIndex { static_cast<int>(blockDim.x * blockIdx.x + threadIdx.x) };
@@ -79,7 +37,7 @@ __device__ void fillTrackletsPerClusterTables(GPU::DeviceStoreNV &primaryVertexC
 __device__ void fillCellsPerClusterTables(GPU::DeviceStoreNV &primaryVertexContext, const int layerIndex)
 {
   const int totalThreadNum { static_cast<int>(primaryVertexContext.getClusters()[layerIndex + 1].size()) };
-  const int trackletsSize { static_cast<int>(primaryVertexContext.getTracklets()[layerIndex + 1].capacity()) };
+  const int trackletsSize { static_cast<int>(primaryVertexContext.getCellsPerTrackletTable()[layerIndex].capacity()) };
   const int trackletsPerThread { 1 + (trackletsSize - 1) / totalThreadNum };
   const int firstTrackletIndex { static_cast<int>(blockDim.x * blockIdx.x + threadIdx.x) * trackletsPerThread };
 
@@ -93,8 +51,6 @@ __device__ void fillCellsPerClusterTables(GPU::DeviceStoreNV &primaryVertexConte
 
 __global__ void fillDeviceStructures(GPU::DeviceStoreNV &primaryVertexContext, const int layerIndex)
 {
-  fillIndexTables(primaryVertexContext, layerIndex);
-
   if (layerIndex < Constants::ITS::CellsPerRoad) {
 
     fillTrackletsPerClusterTables(primaryVertexContext, layerIndex);
@@ -119,20 +75,24 @@ DeviceStoreNV::DeviceStoreNV()
   // Nothing to do
 }
 
-UniquePointer<DeviceStoreNV> DeviceStoreNV::initialise(const float3 &primaryVertex,
+void DeviceStoreNV::initialise(UniquePointer<DeviceStoreNV> &deviceStore, const float3 &primaryVertex,
     const std::array<std::vector<Cluster>, Constants::ITS::LayersNumber> &clusters,
+    const std::array<std::array<int, Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins + 1>,
+        Constants::ITS::TrackletsPerRoad> &indexTables,
     const std::array<std::vector<Tracklet>, Constants::ITS::TrackletsPerRoad> &tracklets,
     const std::array<std::vector<Cell>, Constants::ITS::CellsPerRoad> &cells,
     const std::array<std::vector<int>, Constants::ITS::CellsPerRoad - 1> &cellsLookupTable)
 {
-  mPrimaryVertex = UniquePointer<float3>{ primaryVertex };
+  mPrimaryVertex.reset(primaryVertex);
 
   for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
 
-    this->mClusters[iLayer] =
-        Vector<Cluster> { &clusters[iLayer][0], static_cast<int>(clusters[iLayer].size()) };
+    this->mClusters[iLayer].reset(clusters[iLayer].data(), static_cast<int>(clusters[iLayer].size()));
 
     if (iLayer < Constants::ITS::TrackletsPerRoad) {
+
+      /// the index tables are part of the store and copied to the device with it
+      std::copy(indexTables[iLayer].begin(), indexTables[iLayer].end(), this->mIndexTables[iLayer].data());
       this->mTracklets[iLayer].reset(tracklets[iLayer].capacity());
     }
 
@@ -150,18 +110,22 @@ UniquePointer<DeviceStoreNV> DeviceStoreNV::initialise(const float3 &primaryVert
     }
   }
 
-  UniquePointer<DeviceStoreNV> gpuContextDevicePointer { *this };
+  deviceStore.reset(*this);
 
   std::array<Stream, Constants::ITS::LayersNumber> streamArray;
 
-  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
 
     const int nextLayerClustersNum = static_cast<int>(clusters[iLayer + 1].size());
 
+    if (nextLayerClustersNum == 0) {
+      continue;
+    }
+
     dim3 threadsPerBlock { Utils::Host::getBlockSize(nextLayerClustersNum) };
     dim3 blocksGrid { Utils::Host::getBlocksGrid(threadsPerBlock, nextLayerClustersNum) };
 
-    fillDeviceStructures<<< blocksGrid, threadsPerBlock, 0, streamArray[iLayer].get() >>>(*gpuContextDevicePointer, iLayer);
+    fillDeviceStructures<<< blocksGrid, threadsPerBlock, 0, streamArray[iLayer].get() >>>(*deviceStore, iLayer);
 
     cudaError_t error = cudaGetLastError();
 
@@ -174,8 +138,6 @@ UniquePointer<DeviceStoreNV> DeviceStoreNV::initialise(const float3 &primaryVert
       throw std::runtime_error { errorString.str() };
     }
   }
-
-  return gpuContextDevicePointer;
 }
 
 }
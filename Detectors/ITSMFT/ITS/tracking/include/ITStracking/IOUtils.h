@@ -20,6 +20,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include <gsl/span>
+
 #include "DataFormatsITSMFT/ROFRecord.h"
 #include "ITStracking/Configuration.h"
 #include "ITStracking/ROframe.h"
@@ -59,8 +61,19 @@ void loadConfigurations(const std::string&);
 std::vector<ROframe> loadEventData(const std::string&);
 void loadEventData(ROframe& events, const std::vector<itsmft::Cluster>* mClustersArray,
                    const dataformats::MCTruthContainer<MCCompLabel>* mClsLabels = nullptr);
+void loadEventData(ROframe& events, gsl::span<const itsmft::Cluster> clusters,
+                   const dataformats::MCTruthContainer<MCCompLabel>* mClsLabels = nullptr);
 int loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& events, const std::vector<itsmft::Cluster>* mClustersArray,
                     const dataformats::MCTruthContainer<MCCompLabel>* mClsLabels = nullptr);
+int loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& events, gsl::span<const itsmft::Cluster> clusters,
+                    const dataformats::MCTruthContainer<MCCompLabel>* mClsLabels = nullptr);
+
+/// Binary dump of RO frames, for the standalone tracking and its benchmarks: a header and, for each frame, fixed
+/// size records (primary vertices, then the clusters of each layer with their tracking frame info, label and external
+/// index) at 8 byte aligned offsets, in the byte order of the machine. The reader maps the file in memory and fills
+/// the frames from the records, without parsing. The write returns false (and the load an empty vector) on errors.
+bool writeROFramesBinary(const std::string& fileName, gsl::span<const ROframe> frames);
+std::vector<ROframe> loadROFramesBinary(const std::string& fileName);
 std::vector<std::unordered_map<int, Label>> loadLabels(const int, const std::string&);
 void writeRoadsReport(std::ofstream&, std::ofstream&, std::ofstream&, const std::vector<std::vector<Road>>&,
                       const std::unordered_map<int, Label>&);
@@ -52,6 +52,7 @@ class ROframe final
   const MCCompLabel& getClusterLabels(int layerId, const Cluster& cl) const;
   const MCCompLabel& getClusterLabels(int layerId, const int clId) const;
   int getClusterExternalIndex(int layerId, const int clId) const;
+  int getClusterExternalIndicesNum(int layerId) const;
 
   template <typename... T>
   void addClusterToLayer(int layer, T&&... args);
@@ -59,6 +60,7 @@ class ROframe final
   void addTrackingFrameInfoToLayer(int layer, T&&... args);
   void addClusterLabelToLayer(int layer, const MCCompLabel label);
   void addClusterExternalIndexToLayer(int layer, const int idx);
+  void reserveLayer(int layer, int clustersNum);
 
   void clear();
 
@@ -112,6 +114,11 @@ inline int ROframe::getClusterExternalIndex(int layerId, const int clId) const
   return mClusterExternalIndices[layerId][clId];
 }
 
+inline int ROframe::getClusterExternalIndicesNum(int layerId) const
+{
+  return mClusterExternalIndices[layerId].size();
+}
+
 template <typename... T>
 void ROframe::addClusterToLayer(int layer, T&&... values)
 {
@@ -131,6 +138,14 @@ inline void ROframe::addClusterExternalIndexToLayer(int layer, const int idx)
   mClusterExternalIndices[layer].push_back(idx);
 }
 
+inline void ROframe::reserveLayer(int layer, int clustersNum)
+{
+  mClusters[layer].reserve(clustersNum);
+  mTrackingFrameInfo[layer].reserve(clustersNum);
+  mClusterLabels[layer].reserve(clustersNum);
+  mClusterExternalIndices[layer].reserve(clustersNum);
+}
+
 inline void ROframe::clear()
 {
   for (int iL = 0; iL < Constants::ITS::LayersNumber; ++iL) {
@@ -23,6 +23,9 @@
 #include <iosfwd>
 #include <memory>
 #include <utility>
+#include <vector>
+
+#include <gsl/span>
 
 #include "ITStracking/Configuration.h"
 #include "ITStracking/Definitions.h"
@@ -42,6 +45,26 @@ namespace ITS
 class PrimaryVertexContext;
 class TrackerTraits;
 
+/// Stages of one tracking iteration, as monitored by the Tracker
+enum TrackerStage : int {
+  ContextInitialisation = 0,
+  TrackletFinding,
+  CellFinding,
+  NeighbourFinding,
+  RoadFinding,
+  TrackFinding,
+  TrackerStagesNumber
+};
+
+/// Wall time in ms and number of objects (clusters, tracklets, cells, cell neighbours, roads, tracks)
+/// of the tracking stages for one iteration on one primary vertex
+struct TrackerIterationInfo {
+  int vertex = 0;
+  int iteration = 0;
+  std::array<float, TrackerStagesNumber> time{};
+  std::array<int, TrackerStagesNumber> objects{};
+};
+
 class Tracker
 {
 
@@ -60,10 +83,32 @@ class Tracker
 
   void clustersToTracks(const ROframe&, std::ostream& = std::cout);
 
+  /// Tracks of the readout frames of a timeframe, one frame after the other, with the buffers of the tracker and of
+  /// its primary vertex context kept (cleared, not freed) from one frame to the next. The tracks of each frame are
+  /// appended to tracks and their labels to labels (if not nullptr), tracksPerFrame gets the number of tracks of each
+  /// frame. The ROframe id of a frame is the ROFrame of its tracks. The iteration infos are the ones of all the frames.
+  void clustersToTracks(gsl::span<const ROframe> frames, std::vector<TrackITS>& tracks,
+                        dataformats::MCTruthContainer<MCCompLabel>* labels, std::vector<int>& tracksPerFrame,
+                        std::ostream& = std::cout);
+
+  /// The same with the frames shared among several trackers, each with its own traits, run in one thread each: the
+  /// threads take chunks of consecutive frames, the outputs are the ones of one tracker over all the frames, in the
+  /// order of the frames. The iteration infos of all the frames are given to the first tracker.
+  static void clustersToTracks(const std::vector<Tracker*>& trackers, gsl::span<const ROframe> frames,
+                               std::vector<TrackITS>& tracks, dataformats::MCTruthContainer<MCCompLabel>* labels,
+                               std::vector<int>& tracksPerFrame);
+
   void setROFrame(std::uint32_t f) { mROFrame = f; }
   std::uint32_t getROFrame() const { return mROFrame; }
   void setParameters(const std::vector<MemoryParameters>&, const std::vector<TrackingParameters>&);
 
+  /// Enable the runtime recording of the per stage timing and object counts, independently
+  /// of Constants::DoTimeBenchmarks. The information is reset by each clustersToTracks call.
+  void setMonitoring(bool monitoring) { mMonitoring = monitoring; }
+  bool getMonitoring() const { return mMonitoring; }
+  const std::vector<TrackerIterationInfo>& getIterationInfos() const { return mIterationInfos; }
+  static const char* getStageName(int stage);
+
  private:
   track::TrackParCov buildTrackSeed(const Cluster& cluster1, const Cluster& cluster2, const Cluster& cluster3,
                                     const TrackingFrameInfo& tf3);
@@ -81,6 +126,7 @@ class Tracker
 
   template <typename... T>
   float evaluateTask(void (Tracker::*)(T...), const char*, std::ostream& ostream, T&&... args);
+  int countStageObjects(int stage) const;
 
   TrackerTraits* mTraits = nullptr;                      /// Observer pointer, not owned by this class
   PrimaryVertexContext* mPrimaryVertexContext = nullptr; /// Observer pointer, not owned by this class
@@ -93,6 +139,8 @@ class Tracker
   std::uint32_t mROFrame = 0;
   std::vector<TrackITS> mTracks;
   dataformats::MCTruthContainer<MCCompLabel> mTrackLabels;
+  bool mMonitoring = false;
+  std::vector<TrackerIterationInfo> mIterationInfos;
 };
 
 void Tracker::setParameters(const std::vector<MemoryParameters>& memPars, const std::vector<TrackingParameters>& trkPars)
@@ -133,7 +181,7 @@ float Tracker::evaluateTask(void (Tracker::*task)(T...), const char* taskName, s
 {
   float diff{ 0.f };
 
-  if (Constants::DoTimeBenchmarks) {
+  if (Constants::DoTimeBenchmarks || mMonitoring) {
     auto start = std::chrono::high_resolution_clock::now();
     (this->*task)(std::forward<T>(args)...);
     auto end = std::chrono::high_resolution_clock::now();
@@ -141,10 +189,12 @@ float Tracker::evaluateTask(void (Tracker::*task)(T...), const char* taskName, s
     std::chrono::duration<double, std::milli> diff_t{ end - start };
     diff = diff_t.count();
 
-    if (taskName == nullptr) {
-      ostream << diff << "\t";
-    } else {
-      ostream << std::setw(2) << " - " << taskName << " completed in: " << diff << " ms" << std::endl;
+    if (Constants::DoTimeBenchmarks) {
+      if (taskName == nullptr) {
+        ostream << diff << "\t";
+      } else {
+        ostream << std::setw(2) << " - " << taskName << " completed in: " << diff << " ms" << std::endl;
+      }
     }
   } else {
     (this->*task)(std::forward<T>(args)...);
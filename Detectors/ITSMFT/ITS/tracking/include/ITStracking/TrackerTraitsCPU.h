@@ -45,7 +45,31 @@ class TrackerTraitsCPU : public TrackerTraits
   void computeLayerTracklets() final;
   void computeLayerCells() final;
 
+  /// Number of threads used to find tracklets and cells, the work is shared among
+  /// the threads in chunks of clusters (tracklets) within and across the layers.
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  /// Evaluate the tracklet cuts on a structure of arrays copy of the cluster coordinates,
+  /// in batches of contiguous candidates. The selected tracklets are identical.
+  void setVectorisedTrackletSelection(bool v) { mVectorisedTrackletSelection = v; }
+  bool getVectorisedTrackletSelection() const { return mVectorisedTrackletSelection; }
+
  protected:
+  struct ClusterCoordinatesSoA {
+    std::vector<float> r;
+    std::vector<float> z;
+    std::vector<float> phi;
+  };
+
+  void computeTrackletsInRange(int iLayer, int first, int last, std::vector<Tracklet>& tracklets);
+  void computeCellsInRange(int iLayer, int first, int last, std::vector<Cell>& cells);
+  template <typename T, size_t N, typename SizeF, typename KernelF>
+  void processLayers(int layersNum, SizeF&& layerSize, std::array<std::vector<T>, N>& output, KernelF&& kernel);
+
+  int mNThreads = 1;
+  bool mVectorisedTrackletSelection = false;
+  std::array<ClusterCoordinatesSoA, Constants::ITS::LayersNumber> mClusterCoordinates;
   std::vector<std::vector<Tracklet>> mTracklets;
   std::vector<std::vector<Cell>> mCells;
 };
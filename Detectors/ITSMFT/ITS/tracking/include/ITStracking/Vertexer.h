@@ -21,6 +21,9 @@
 #include <iosfwd>
 #include <array>
 #include <iosfwd>
+#include <vector>
+
+#include <gsl/span>
 
 #include "ITStracking/ROframe.h"
 #include "ITStracking/Constants.h"
@@ -52,6 +55,11 @@ class Vertexer
   VertexerTraits* getTraits() const { return mTraits; };
 
   void clustersToVertices(ROframe&, std::ostream& = std::cout);
+  /// Vertices of the readout frames of a timeframe, one frame after the other with the buffers of the traits kept
+  /// from one frame to the next: appended to vertices, with their number for each frame in verticesPerFrame, and
+  /// added as the primary vertices of their frame for the tracking
+  void clustersToVertices(gsl::span<ROframe> frames, std::vector<Vertex>& vertices, std::vector<int>& verticesPerFrame,
+                          std::ostream& = std::cout);
   template <typename... T>
   void initialiseVertexer(T&&... args);
   void findTracklets(const bool useMCLabel = false);
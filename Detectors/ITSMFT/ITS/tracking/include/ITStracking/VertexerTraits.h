@@ -68,6 +68,15 @@ class VertexerTraits
   void dumpVertexerTraits();
 
  protected:
+  /// Tracklet finding for the layer 1 index table bins in [firstBin, lastBin), the used cluster flags of
+  /// the layers 0 and 2 are updated. If trackletClusters is given, the indices of the layer 0 and
+  /// layer 2 clusters of each tracklet are stored as well.
+  void computeTrackletsInBins(const int firstBin, const int lastBin, const bool useMCLabel,
+                              std::vector<bool>& usedCluster0Flags, std::vector<bool>& usedCluster2Flags,
+                              std::vector<Line>& tracklets, std::vector<std::array<int, 2>>* trackletClusters = nullptr) const;
+  /// Merges the clusters of tracklets close in z and stores the vertices of the accepted ones
+  void finaliseVertices();
+
   VertexingParameters mVrtParams;
   std::array<std::array<int, ZBins * PhiBins + 1>, LayersNumberVertexer> mIndexTables;
   std::vector<lightVertex> mVertices;
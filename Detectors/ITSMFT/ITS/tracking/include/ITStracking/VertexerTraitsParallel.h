@@ -0,0 +1,62 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file VertexerTraitsParallel.h
+/// \brief Multi-threaded vertexer traits: tracklets found per phi sector, lines clustered by density
+///
+
+#ifndef O2_ITS_TRACKING_VERTEXER_TRAITS_PARALLEL_H_
+#define O2_ITS_TRACKING_VERTEXER_TRAITS_PARALLEL_H_
+
+#include <array>
+#include <vector>
+
+#include "ITStracking/VertexerTraits.h"
+
+namespace o2
+{
+namespace ITS
+{
+
+/// The tracklets are found independently for each phi bin of the layer 1 index table, with
+/// per-sector used cluster flags. The sectors are merged in phi order, a tracklet sharing its
+/// layer 0 or layer 2 cluster with a tracklet of a preceding sector is discarded.
+///
+/// The lines are clustered DBSCAN-like in the z of their closest approach to the beam axis: a line
+/// with at least minNeighbours other lines within the pair cut in z is a core line, core lines
+/// closer than the pair cut form a cluster and the other lines are attached to the closest core line
+/// within the pair cut. The vertex of each cluster is refined once with the lines passing within the
+/// pair cut, and the clusters are merged and selected as in VertexerTraits.
+///
+/// Both steps are shared among the threads and the result does not depend on their number.
+class VertexerTraitsParallel : public VertexerTraits
+{
+ public:
+  VertexerTraitsParallel() = default;
+
+  void computeTracklets(const bool useMCLabel = false) final;
+  void computeVertices() final;
+
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+  void setMinNeighbours(int n) { mMinNeighbours = n > 0 ? n : 1; }
+  int getMinNeighbours() const { return mMinNeighbours; }
+
+ private:
+  template <typename KernelF>
+  void processChunks(int chunksNum, KernelF&& kernel) const;
+
+  int mNThreads = 1;      ///< number of threads
+  int mMinNeighbours = 1; ///< minimum number of lines within the pair cut in z for a core line
+};
+
+} // namespace ITS
+} // namespace o2
+#endif /* O2_ITS_TRACKING_VERTEXER_TRAITS_PARALLEL_H_ */
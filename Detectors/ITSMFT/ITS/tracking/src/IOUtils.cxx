@@ -15,13 +15,20 @@
 #include "ITStracking/IOUtils.h"
 
 #include <iostream>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "DataFormatsITSMFT/Cluster.h"
 #include "ITSBase/GeometryTGeo.h"
 #include "ITStracking/Constants.h"
@@ -33,6 +40,63 @@ namespace
 {
 constexpr int PrimaryVertexLayerId{ -1 };
 constexpr int EventLabelsSeparator{ -1 };
+
+/// records of the binary RO frame dump
+constexpr char BinaryMagic[8] = { 'O', '2', 'I', 'T', 'S', 'R', 'O', 'F' };
+constexpr std::uint32_t BinaryVersion{ 1 };
+
+struct BinaryHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t framesNum;
+};
+
+struct BinaryFrameHeader {
+  std::int32_t roFrameId;
+  std::uint32_t verticesNum;
+  std::uint32_t clustersNum[o2::ITS::Constants::ITS::LayersNumber];
+  std::uint32_t padding;
+};
+
+struct BinaryVertex {
+  float xyz[3];
+  float padding;
+};
+
+struct BinaryCluster {
+  float xyz[3];          ///< global position
+  float xTrackingFrame;
+  float alphaTrackingFrame;
+  float positionTrackingFrame[2];
+  float covarianceTrackingFrame[3];
+  std::int32_t externalIndex; ///< -1 if the frame has none
+  std::int32_t padding;
+  std::uint64_t label; ///< raw MCCompLabel
+};
+
+static_assert(sizeof(BinaryHeader) % 8 == 0 && sizeof(BinaryFrameHeader) % 8 == 0 && sizeof(BinaryVertex) % 8 == 0 &&
+                sizeof(BinaryCluster) % 8 == 0,
+              "the records of the binary dump keep the 8 byte alignment");
+static_assert(sizeof(o2::MCCompLabel) == sizeof(std::uint64_t), "the labels are stored as raw 64 bit values");
+
+/// records in place in the mapped file
+struct BinaryReader {
+  const char* data;
+  size_t size;
+  size_t offset = 0;
+
+  /// the next number records, nullptr if the file is too short
+  template <typename Record>
+  const Record* next(size_t number)
+  {
+    if (number * sizeof(Record) > size - offset) {
+      return nullptr;
+    }
+    const Record* records = reinterpret_cast<const Record*>(data + offset);
+    offset += number * sizeof(Record);
+    return records;
+  }
+};
 } // namespace
 
 namespace o2
@@ -109,12 +173,18 @@ void IOUtils::loadEventData(ROframe& event, const std::vector<itsmft::Cluster>*
     std::cerr << "Missing clusters." << std::endl;
     return;
   }
+  loadEventData(event, gsl::span<const itsmft::Cluster>(*clusters), mcLabels);
+}
+
+void IOUtils::loadEventData(ROframe& event, gsl::span<const itsmft::Cluster> clusters,
+                            const dataformats::MCTruthContainer<MCCompLabel>* mcLabels)
+{
   event.clear();
   GeometryTGeo* geom = GeometryTGeo::Instance();
   geom->fillMatrixCache(utils::bit2Mask(TransformType::T2GRot));
   int clusterId{ 0 };
 
-  for (auto& c : *clusters) {
+  for (auto& c : clusters) {
     int layer = geom->getLayer(c.getSensorID());
 
     /// Clusters are stored in the tracking frame
@@ -138,6 +208,12 @@ int IOUtils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& event, c
     std::cerr << "Missing clusters." << std::endl;
     return -1;
   }
+  return loadROFrameData(rof, event, gsl::span<const itsmft::Cluster>(*clusters), mcLabels);
+}
+
+int IOUtils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& event, gsl::span<const itsmft::Cluster> clusters,
+                             const dataformats::MCTruthContainer<MCCompLabel>* mcLabels)
+{
   event.clear();
   GeometryTGeo* geom = GeometryTGeo::Instance();
   geom->fillMatrixCache(utils::bit2Mask(TransformType::T2GRot));
@@ -145,7 +221,7 @@ int IOUtils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& event, c
 
   auto first = rof.getROFEntry().getIndex();
   auto number = rof.getNROFEntries();
-  auto clusters_in_frame = gsl::make_span(&(*clusters)[first], number);
+  auto clusters_in_frame = clusters.subspan(first, number);
   for (auto& c : clusters_in_frame) {
     int layer = geom->getLayer(c.getSensorID());
 
@@ -164,6 +240,137 @@ int IOUtils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& event, c
   return number;
 }
 
+bool IOUtils::writeROFramesBinary(const std::string& fileName, gsl::span<const ROframe> frames)
+{
+  std::ofstream outputStream{ fileName, std::ios::binary };
+  if (!outputStream) {
+    std::cerr << "Cannot open " << fileName << " for writing." << std::endl;
+    return false;
+  }
+  BinaryHeader header{};
+  std::memcpy(header.magic, BinaryMagic, sizeof(BinaryMagic));
+  header.version = BinaryVersion;
+  header.framesNum = frames.size();
+  outputStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::vector<BinaryVertex> vertices;
+  std::vector<BinaryCluster> clusters;
+  for (auto& frame : frames) {
+    BinaryFrameHeader frameHeader{};
+    frameHeader.roFrameId = frame.getROFrameId();
+    frameHeader.verticesNum = frame.getPrimaryVerticesNum();
+    for (int iLayer{ 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+      frameHeader.clustersNum[iLayer] = frame.getClustersOnLayer(iLayer).size();
+    }
+    outputStream.write(reinterpret_cast<const char*>(&frameHeader), sizeof(frameHeader));
+
+    vertices.resize(frameHeader.verticesNum);
+    for (int iVertex{ 0 }; iVertex < frame.getPrimaryVerticesNum(); ++iVertex) {
+      const float3& vertex = frame.getPrimaryVertex(iVertex);
+      vertices[iVertex] = BinaryVertex{ { vertex.x, vertex.y, vertex.z }, 0.f };
+    }
+    outputStream.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(BinaryVertex));
+
+    for (int iLayer{ 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+      const auto& layerClusters = frame.getClustersOnLayer(iLayer);
+      const auto& layerInfos = frame.getTrackingFrameInfoOnLayer(iLayer);
+      clusters.resize(layerClusters.size());
+      for (size_t iCluster{ 0 }; iCluster < layerClusters.size(); ++iCluster) {
+        const Cluster& cluster = layerClusters[iCluster];
+        const TrackingFrameInfo& info = layerInfos[cluster.clusterId];
+        auto& record = clusters[iCluster];
+        record = BinaryCluster{};
+        record.xyz[0] = cluster.xCoordinate;
+        record.xyz[1] = cluster.yCoordinate;
+        record.xyz[2] = cluster.zCoordinate;
+        record.xTrackingFrame = info.xTrackingFrame;
+        record.alphaTrackingFrame = info.alphaTrackingFrame;
+        std::copy(info.positionTrackingFrame.begin(), info.positionTrackingFrame.end(), record.positionTrackingFrame);
+        std::copy(info.covarianceTrackingFrame.begin(), info.covarianceTrackingFrame.end(),
+                  record.covarianceTrackingFrame);
+        std::memcpy(&record.label, &frame.getClusterLabels(iLayer, cluster), sizeof(record.label));
+        /// the text loader does not fill the external indices
+        record.externalIndex = cluster.clusterId < frame.getClusterExternalIndicesNum(iLayer)
+                                 ? frame.getClusterExternalIndex(iLayer, cluster.clusterId)
+                                 : -1;
+      }
+      outputStream.write(reinterpret_cast<const char*>(clusters.data()), clusters.size() * sizeof(BinaryCluster));
+    }
+  }
+  if (!outputStream) {
+    std::cerr << "Error writing " << fileName << "." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+std::vector<ROframe> IOUtils::loadROFramesBinary(const std::string& fileName)
+{
+  std::vector<ROframe> frames{};
+  const int fileDescriptor{ open(fileName.c_str(), O_RDONLY) };
+  if (fileDescriptor < 0) {
+    std::cerr << "Cannot open " << fileName << "." << std::endl;
+    return frames;
+  }
+  struct stat fileStatus;
+  const size_t size = fstat(fileDescriptor, &fileStatus) == 0 ? fileStatus.st_size : 0;
+  void* mapping = size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) : MAP_FAILED;
+  close(fileDescriptor);
+  if (mapping == MAP_FAILED) {
+    std::cerr << "Cannot map " << fileName << " in memory." << std::endl;
+    return frames;
+  }
+  BinaryReader reader{ static_cast<const char*>(mapping), size };
+
+  bool valid{ false };
+  const BinaryHeader* header = reader.next<BinaryHeader>(1);
+  if (header && !std::memcmp(header->magic, BinaryMagic, sizeof(BinaryMagic)) && header->version == BinaryVersion) {
+    valid = true;
+    frames.reserve(header->framesNum);
+    for (std::uint32_t iFrame{ 0 }; valid && iFrame < header->framesNum; ++iFrame) {
+      const BinaryFrameHeader* frameHeader = reader.next<BinaryFrameHeader>(1);
+      const BinaryVertex* vertices = frameHeader ? reader.next<BinaryVertex>(frameHeader->verticesNum) : nullptr;
+      if (!vertices) {
+        valid = false;
+        break;
+      }
+      frames.emplace_back(frameHeader->roFrameId);
+      ROframe& frame = frames.back();
+      for (std::uint32_t iVertex{ 0 }; iVertex < frameHeader->verticesNum; ++iVertex) {
+        frame.addPrimaryVertex(vertices[iVertex].xyz[0], vertices[iVertex].xyz[1], vertices[iVertex].xyz[2]);
+      }
+      for (int iLayer{ 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+        const int clustersNum = frameHeader->clustersNum[iLayer];
+        const BinaryCluster* clusters = reader.next<BinaryCluster>(clustersNum);
+        if (!clusters) {
+          valid = false;
+          break;
+        }
+        frame.reserveLayer(iLayer, clustersNum);
+        for (int iCluster{ 0 }; iCluster < clustersNum; ++iCluster) {
+          const BinaryCluster& record = clusters[iCluster];
+          frame.addClusterToLayer(iLayer, record.xyz[0], record.xyz[1], record.xyz[2], iCluster);
+          frame.addTrackingFrameInfoToLayer(
+            iLayer, record.xTrackingFrame, record.alphaTrackingFrame,
+            std::array<float, 2>{ record.positionTrackingFrame[0], record.positionTrackingFrame[1] },
+            std::array<float, 3>{ record.covarianceTrackingFrame[0], record.covarianceTrackingFrame[1],
+                                  record.covarianceTrackingFrame[2] });
+          MCCompLabel label;
+          std::memcpy(&label, &record.label, sizeof(label));
+          frame.addClusterLabelToLayer(iLayer, label);
+          frame.addClusterExternalIndexToLayer(iLayer, record.externalIndex);
+        }
+      }
+    }
+  }
+  munmap(mapping, size);
+  if (!valid) {
+    std::cerr << fileName << " is not a valid binary dump of RO frames." << std::endl;
+    frames.clear();
+  }
+  return frames;
+}
+
 std::vector<std::unordered_map<int, Label>> IOUtils::loadLabels(const int eventsNum, const std::string& fileName)
 {
   std::vector<std::unordered_map<int, Label>> labelsMap{};
@@ -72,7 +72,10 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const st
                     cl[iLayer + 2].size()),
         Constants::ITS::UnusedIndex);
 
-      mCellsNeighbours[iLayer].clear();
+      // the neighbour lists are cleared but kept with their capacity for the next frames
+      for (auto& neighbours : mCellsNeighbours[iLayer]) {
+        neighbours.clear();
+      }
     }
   }
 
@@ -23,11 +23,14 @@
 #include "ITStracking/TrackerTraitsCPU.h"
 
 #include "ReconstructionDataFormats/Track.h"
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <iostream>
 #include <dlfcn.h>
 #include <cstdlib>
 #include <string>
+#include <thread>
 
 namespace o2
 {
@@ -52,21 +55,41 @@ void Tracker::clustersToTracks(const ROframe& event, std::ostream& timeBenchmark
   mTracks.clear();
   mTrackLabels.clear();
 
+  mIterationInfos.clear();
+
   for (int iVertex = 0; iVertex < verticesNum; ++iVertex) {
 
     float total{ 0.f };
 
     for (int iteration = 0; iteration < mTrkParams.size(); ++iteration) {
+      TrackerIterationInfo info;
+      info.vertex = iVertex;
+      info.iteration = iteration;
+      auto record = [this, &info, &total](int stage, float time) {
+        total += time;
+        if (mMonitoring) {
+          info.time[stage] = time;
+          info.objects[stage] = countStageObjects(stage);
+        }
+      };
+      const int tracksNum = mTracks.size();
+
       mTraits->UpdateTrackingParameters(mTrkParams[iteration]);
       /// Ugly hack -> Unifiy float3 definition in CPU and CUDA/HIP code
       std::array<float, 3> pV = { event.getPrimaryVertex(iVertex).x, event.getPrimaryVertex(iVertex).y, event.getPrimaryVertex(iVertex).z };
-      total += evaluateTask(&Tracker::initialisePrimaryVertexContext, "Context initialisation",
-                            timeBenchmarkOutputStream, mMemParams[iteration], event.getClusters(), pV, iteration);
-      total += evaluateTask(&Tracker::computeTracklets, "Tracklet finding", timeBenchmarkOutputStream);
-      total += evaluateTask(&Tracker::computeCells, "Cell finding", timeBenchmarkOutputStream);
-      total += evaluateTask(&Tracker::findCellsNeighbours, "Neighbour finding", timeBenchmarkOutputStream, iteration);
-      total += evaluateTask(&Tracker::findRoads, "Road finding", timeBenchmarkOutputStream, iteration);
-      total += evaluateTask(&Tracker::findTracks, "Track finding", timeBenchmarkOutputStream, event);
+      record(ContextInitialisation, evaluateTask(&Tracker::initialisePrimaryVertexContext, getStageName(ContextInitialisation),
+                                                 timeBenchmarkOutputStream, mMemParams[iteration], event.getClusters(), pV, iteration));
+      record(TrackletFinding, evaluateTask(&Tracker::computeTracklets, getStageName(TrackletFinding), timeBenchmarkOutputStream));
+      record(CellFinding, evaluateTask(&Tracker::computeCells, getStageName(CellFinding), timeBenchmarkOutputStream));
+      record(NeighbourFinding, evaluateTask(&Tracker::findCellsNeighbours, getStageName(NeighbourFinding),
+                                            timeBenchmarkOutputStream, iteration));
+      record(RoadFinding, evaluateTask(&Tracker::findRoads, getStageName(RoadFinding), timeBenchmarkOutputStream, iteration));
+      record(TrackFinding, evaluateTask(&Tracker::findTracks, getStageName(TrackFinding), timeBenchmarkOutputStream, event));
+
+      if (mMonitoring) {
+        info.objects[TrackFinding] = mTracks.size() - tracksNum;
+        mIterationInfos.push_back(info);
+      }
     }
 
     if (Constants::DoTimeBenchmarks)
@@ -76,6 +99,139 @@ void Tracker::clustersToTracks(const ROframe& event, std::ostream& timeBenchmark
   computeTracksMClabels(event);
 }
 
+void Tracker::clustersToTracks(gsl::span<const ROframe> frames, std::vector<TrackITS>& tracks,
+                               dataformats::MCTruthContainer<MCCompLabel>* labels, std::vector<int>& tracksPerFrame,
+                               std::ostream& timeBenchmarkOutputStream)
+{
+  std::vector<TrackerIterationInfo> infos;
+  tracksPerFrame.reserve(tracksPerFrame.size() + frames.size());
+  for (const auto& frame : frames) {
+    if (frame.getTotalClusters() == 0 || frame.getPrimaryVerticesNum() == 0) {
+      tracksPerFrame.push_back(0);
+      continue;
+    }
+    mROFrame = frame.getROFrameId();
+    clustersToTracks(frame, timeBenchmarkOutputStream);
+    tracksPerFrame.push_back(mTracks.size());
+    tracks.insert(tracks.end(), mTracks.begin(), mTracks.end());
+    if (labels) {
+      labels->mergeAtBack(mTrackLabels);
+    }
+    infos.insert(infos.end(), mIterationInfos.begin(), mIterationInfos.end());
+  }
+  mIterationInfos.swap(infos);
+}
+
+void Tracker::clustersToTracks(const std::vector<Tracker*>& trackers, gsl::span<const ROframe> frames,
+                               std::vector<TrackITS>& tracks, dataformats::MCTruthContainer<MCCompLabel>* labels,
+                               std::vector<int>& tracksPerFrame)
+{
+  const int framesNum = frames.size();
+  const int workersNum = std::min(static_cast<int>(trackers.size()), framesNum);
+  if (workersNum <= 1) {
+    if (!trackers.empty()) {
+      trackers[0]->clustersToTracks(frames, tracks, labels, tracksPerFrame);
+    }
+    return;
+  }
+
+  /// Chunks of consecutive frames, a few per thread for the balance of the load
+  struct ChunkOutput {
+    std::vector<TrackITS> tracks;
+    dataformats::MCTruthContainer<MCCompLabel> labels;
+    std::vector<int> tracksPerFrame;
+    std::vector<TrackerIterationInfo> infos;
+  };
+  const int chunkSize = std::max(1, framesNum / (4 * workersNum));
+  const int chunksNum = (framesNum + chunkSize - 1) / chunkSize;
+  std::vector<ChunkOutput> outputs(chunksNum);
+  std::atomic<int> nextChunk{ 0 };
+  std::vector<std::exception_ptr> errors(workersNum);
+
+  auto work = [&](int iWorker) {
+    try {
+      Tracker* tracker = trackers[iWorker];
+      for (int iChunk = nextChunk++; iChunk < chunksNum; iChunk = nextChunk++) {
+        auto& output = outputs[iChunk];
+        const int first = iChunk * chunkSize;
+        tracker->clustersToTracks(frames.subspan(first, std::min(chunkSize, framesNum - first)), output.tracks,
+                                  labels ? &output.labels : nullptr, output.tracksPerFrame);
+        output.infos.swap(tracker->mIterationInfos);
+      }
+    } catch (...) {
+      errors[iWorker] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int iWorker = 1; iWorker < workersNum; ++iWorker) {
+    threads.emplace_back(work, iWorker);
+  }
+  work(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::vector<TrackerIterationInfo> infos;
+  tracksPerFrame.reserve(tracksPerFrame.size() + framesNum);
+  for (auto& output : outputs) {
+    tracks.insert(tracks.end(), output.tracks.begin(), output.tracks.end());
+    tracksPerFrame.insert(tracksPerFrame.end(), output.tracksPerFrame.begin(), output.tracksPerFrame.end());
+    if (labels) {
+      labels->mergeAtBack(output.labels);
+    }
+    infos.insert(infos.end(), output.infos.begin(), output.infos.end());
+  }
+  trackers[0]->mIterationInfos.swap(infos);
+}
+
+const char* Tracker::getStageName(int stage)
+{
+  static constexpr const char* names[TrackerStagesNumber] = { "Context initialisation", "Tracklet finding",
+                                                              "Cell finding", "Neighbour finding",
+                                                              "Road finding", "Track finding" };
+  return (stage >= 0 && stage < TrackerStagesNumber) ? names[stage] : "Unknown";
+}
+
+int Tracker::countStageObjects(int stage) const
+{
+  int count{ 0 };
+  switch (stage) {
+    case ContextInitialisation:
+      for (auto& clusters : mPrimaryVertexContext->getClusters()) {
+        count += clusters.size();
+      }
+      break;
+    case TrackletFinding:
+      for (auto& tracklets : mPrimaryVertexContext->getTracklets()) {
+        count += tracklets.size();
+      }
+      break;
+    case CellFinding:
+      for (auto& cells : mPrimaryVertexContext->getCells()) {
+        count += cells.size();
+      }
+      break;
+    case NeighbourFinding:
+      for (auto& layerNeighbours : mPrimaryVertexContext->getCellsNeighbours()) {
+        for (auto& neighbours : layerNeighbours) {
+          count += neighbours.size();
+        }
+      }
+      break;
+    case RoadFinding:
+      count = mPrimaryVertexContext->getRoads().size();
+      break;
+    default:
+      break;
+  }
+  return count;
+}
+
 void Tracker::computeTracklets()
 {
   mTraits->computeLayerTracklets();
@@ -107,7 +263,10 @@ void Tracker::findCellsNeighbours(int& iteration)
             nextLayerTrackletIndex) {
 
         const int nextLayerCellsNum{ static_cast<int>(mPrimaryVertexContext->getCells()[iLayer + 1].size()) };
-        mPrimaryVertexContext->getCellsNeighbours()[iLayer].resize(nextLayerCellsNum);
+        auto& layerNeighbours = mPrimaryVertexContext->getCellsNeighbours()[iLayer];
+        if (static_cast<int>(layerNeighbours.size()) < nextLayerCellsNum) {
+          layerNeighbours.resize(nextLayerCellsNum); // the lists of the previous frames are kept, cleared
+        }
 
         for (int iNextLayerCell{ nextLayerFirstCellIndex };
              iNextLayerCell < nextLayerCellsNum &&
@@ -396,7 +555,7 @@ bool Tracker::fitTrack(const ROframe& event, TrackITS& track, int start, int end
     const float xx0 = (iLayer > 2) ? 0.008f : 0.003f; // Rough layer thickness
     constexpr float radiationLength = 9.36f;          // Radiation length of Si [cm]
     constexpr float density = 2.33f;                  // Density of Si [g/cm^3]
-    if (!track.correctForMaterial(xx0, xx0 * radiationLength * density, true))
+    if (!track.correctForMaterial<o2::track::BetheBlochTabulated>(xx0, xx0 * radiationLength * density, true))
       return false;
   }
   return true;
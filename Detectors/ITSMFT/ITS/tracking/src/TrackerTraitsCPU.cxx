@@ -21,8 +21,10 @@
 #include "ITStracking/Tracklet.h"
 
 #include "ReconstructionDataFormats/Track.h"
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <thread>
 
 namespace o2
 {
@@ -32,15 +34,54 @@ namespace ITS
 void TrackerTraitsCPU::computeLayerTracklets()
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
-  for (int iLayer{ 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
-    if (primaryVertexContext->getClusters()[iLayer].empty() || primaryVertexContext->getClusters()[iLayer + 1].empty()) {
-      return;
+  int layersNum{ 0 };
+  while (layersNum < Constants::ITS::TrackletsPerRoad && !primaryVertexContext->getClusters()[layersNum].empty() &&
+         !primaryVertexContext->getClusters()[layersNum + 1].empty()) {
+    ++layersNum;
+  }
+
+  if (mVectorisedTrackletSelection) {
+    for (int iLayer{ 1 }; iLayer <= layersNum; ++iLayer) {
+      const auto& clusters = primaryVertexContext->getClusters()[iLayer];
+      auto& coordinates = mClusterCoordinates[iLayer];
+      coordinates.r.resize(clusters.size());
+      coordinates.z.resize(clusters.size());
+      coordinates.phi.resize(clusters.size());
+      for (size_t iCluster{ 0 }; iCluster < clusters.size(); ++iCluster) {
+        coordinates.r[iCluster] = clusters[iCluster].rCoordinate;
+        coordinates.z[iCluster] = clusters[iCluster].zCoordinate;
+        coordinates.phi[iCluster] = clusters[iCluster].phiCoordinate;
+      }
+    }
+  }
+
+  processLayers(layersNum, [primaryVertexContext](int iLayer) { return primaryVertexContext->getClusters()[iLayer].size(); },
+                primaryVertexContext->getTracklets(),
+                [this](int iLayer, int first, int last, std::vector<Tracklet>& tracklets) {
+                  computeTrackletsInRange(iLayer, first, last, tracklets);
+                });
+
+  /// the lookup tables point to the first tracklet starting from a given cluster, since the tracklets are
+  /// ordered by their first cluster they can be filled after the tracklet finding
+  for (int iLayer{ 1 }; iLayer < layersNum; ++iLayer) {
+    auto& lookupTable = primaryVertexContext->getTrackletsLookupTable()[iLayer - 1];
+    const auto& tracklets = primaryVertexContext->getTracklets()[iLayer];
+    for (int iTracklet{ 0 }; iTracklet < static_cast<int>(tracklets.size()); ++iTracklet) {
+      if (lookupTable[tracklets[iTracklet].firstClusterIndex] == Constants::ITS::UnusedIndex) {
+        lookupTable[tracklets[iTracklet].firstClusterIndex] = iTracklet;
+      }
     }
+  }
+}
 
+void TrackerTraitsCPU::computeTrackletsInRange(int iLayer, int first, int last, std::vector<Tracklet>& tracklets)
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  std::vector<unsigned char> selection;
+  {
     const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
-    const int currentLayerClustersNum{ static_cast<int>(primaryVertexContext->getClusters()[iLayer].size()) };
 
-    for (int iCluster{ 0 }; iCluster < currentLayerClustersNum; ++iCluster) {
+    for (int iCluster{ first }; iCluster < last; ++iCluster) {
       const Cluster& currentCluster{ primaryVertexContext->getClusters()[iLayer][iCluster] };
 
       const float tanLambda{ (currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate };
@@ -69,6 +110,37 @@ void TrackerTraitsCPU::computeLayerTracklets()
         const int firstRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][firstBinIndex];
         const int maxRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][maxBinIndex];
 
+        if (mVectorisedTrackletSelection) {
+          /// the candidates of one row are contiguous, the cuts are evaluated on the SoA copy of the
+          /// coordinates in a branch free loop which the compiler can vectorise
+          const int candidatesNum{ maxRowClusterIndex - firstRowClusterIndex };
+          if (candidatesNum <= 0) {
+            continue;
+          }
+          selection.resize(candidatesNum);
+          const ClusterCoordinatesSoA& nextLayer{ mClusterCoordinates[iLayer + 1] };
+          const float* rCoordinates{ nextLayer.r.data() + firstRowClusterIndex };
+          const float* zCoordinates{ nextLayer.z.data() + firstRowClusterIndex };
+          const float* phiCoordinates{ nextLayer.phi.data() + firstRowClusterIndex };
+          const float maxDeltaZ{ mTrkParams.TrackletMaxDeltaZ[iLayer] };
+          const float maxDeltaPhi{ mTrkParams.TrackletMaxDeltaPhi };
+          for (int iCandidate{ 0 }; iCandidate < candidatesNum; ++iCandidate) {
+            const float deltaZ{ MATH_ABS(tanLambda * (rCoordinates[iCandidate] - currentCluster.rCoordinate) +
+                                         currentCluster.zCoordinate - zCoordinates[iCandidate]) };
+            const float deltaPhi{ MATH_ABS(currentCluster.phiCoordinate - phiCoordinates[iCandidate]) };
+            selection[iCandidate] = (deltaZ < maxDeltaZ) &
+                                    ((deltaPhi < maxDeltaPhi) | (MATH_ABS(deltaPhi - Constants::Math::TwoPi) < maxDeltaPhi));
+          }
+          for (int iCandidate{ 0 }; iCandidate < candidatesNum; ++iCandidate) {
+            const int iNextLayerCluster{ firstRowClusterIndex + iCandidate };
+            const Cluster& nextCluster{ primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster] };
+            if (selection[iCandidate] && !primaryVertexContext->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
+              tracklets.emplace_back(iCluster, iNextLayerCluster, currentCluster, nextCluster);
+            }
+          }
+          continue;
+        }
+
         for (int iNextLayerCluster{ firstRowClusterIndex }; iNextLayerCluster < maxRowClusterIndex;
              ++iNextLayerCluster) {
 
@@ -85,15 +157,7 @@ void TrackerTraitsCPU::computeLayerTracklets()
               (deltaPhi < mTrkParams.TrackletMaxDeltaPhi ||
                MATH_ABS(deltaPhi - Constants::Math::TwoPi) < mTrkParams.TrackletMaxDeltaPhi)) {
 
-            if (iLayer > 0 &&
-                primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] == Constants::ITS::UnusedIndex) {
-
-              primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] =
-                primaryVertexContext->getTracklets()[iLayer].size();
-            }
-
-            primaryVertexContext->getTracklets()[iLayer].emplace_back(iCluster, iNextLayerCluster, currentCluster,
-                                                                      nextCluster);
+            tracklets.emplace_back(iCluster, iNextLayerCluster, currentCluster, nextCluster);
           }
         }
       }
@@ -104,18 +168,37 @@ void TrackerTraitsCPU::computeLayerTracklets()
 void TrackerTraitsCPU::computeLayerCells()
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
-  for (int iLayer{ 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
-
-    if (primaryVertexContext->getTracklets()[iLayer + 1].empty() ||
-        primaryVertexContext->getTracklets()[iLayer].empty()) {
+  int layersNum{ 0 };
+  while (layersNum < Constants::ITS::CellsPerRoad && !primaryVertexContext->getTracklets()[layersNum].empty() &&
+         !primaryVertexContext->getTracklets()[layersNum + 1].empty()) {
+    ++layersNum;
+  }
 
-      return;
+  processLayers(layersNum, [primaryVertexContext](int iLayer) { return primaryVertexContext->getTracklets()[iLayer].size(); },
+                primaryVertexContext->getCells(),
+                [this](int iLayer, int first, int last, std::vector<Cell>& cells) {
+                  computeCellsInRange(iLayer, first, last, cells);
+                });
+
+  /// the cells are ordered by their first tracklet, the lookup tables are filled after the cell finding
+  for (int iLayer{ 1 }; iLayer < layersNum; ++iLayer) {
+    auto& lookupTable = primaryVertexContext->getCellsLookupTable()[iLayer - 1];
+    const auto& cells = primaryVertexContext->getCells()[iLayer];
+    for (int iCell{ 0 }; iCell < static_cast<int>(cells.size()); ++iCell) {
+      if (lookupTable[cells[iCell].getFirstTrackletIndex()] == Constants::ITS::UnusedIndex) {
+        lookupTable[cells[iCell].getFirstTrackletIndex()] = iCell;
+      }
     }
+  }
+}
 
+void TrackerTraitsCPU::computeCellsInRange(int iLayer, int first, int last, std::vector<Cell>& cells)
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  {
     const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
-    const int currentLayerTrackletsNum{ static_cast<int>(primaryVertexContext->getTracklets()[iLayer].size()) };
 
-    for (int iTracklet{ 0 }; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+    for (int iTracklet{ first }; iTracklet < last; ++iTracklet) {
 
       const Tracklet& currentTracklet{ primaryVertexContext->getTracklets()[iLayer][iTracklet] };
       const int nextLayerClusterIndex{ currentTracklet.secondClusterIndex };
@@ -208,16 +291,10 @@ void TrackerTraitsCPU::computeLayerCells()
             }
 
             const float cellTrajectoryCurvature{ 1.0f / cellTrajectoryRadius };
-            if (iLayer > 0 &&
-                primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] == Constants::ITS::UnusedIndex) {
 
-              primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] =
-                primaryVertexContext->getCells()[iLayer].size();
-            }
-
-            primaryVertexContext->getCells()[iLayer].emplace_back(
-              currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
-              iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
+            cells.emplace_back(currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex,
+                               nextTracklet.secondClusterIndex, iTracklet, iNextLayerTracklet, normalizedPlaneVector,
+                               cellTrajectoryCurvature);
           }
         }
       }
@@ -225,5 +302,59 @@ void TrackerTraitsCPU::computeLayerCells()
   }
 }
 
+template <typename T, size_t N, typename SizeF, typename KernelF>
+void TrackerTraitsCPU::processLayers(int layersNum, SizeF&& layerSize, std::array<std::vector<T>, N>& output,
+                                     KernelF&& kernel)
+{
+  if (mNThreads <= 1) {
+    for (int iLayer{ 0 }; iLayer < layersNum; ++iLayer) {
+      kernel(iLayer, 0, static_cast<int>(layerSize(iLayer)), output[iLayer]);
+    }
+    return;
+  }
+
+  /// Each layer is split in chunks of consecutive input objects, the chunks are processed
+  /// concurrently into separate buffers and concatenated in order afterwards. The result
+  /// is therefore identical to the sequential processing.
+  struct Chunk {
+    int layer;
+    int first;
+    int last;
+    std::vector<T> result;
+  };
+  std::vector<Chunk> chunks;
+  for (int iLayer{ 0 }; iLayer < layersNum; ++iLayer) {
+    const int size{ static_cast<int>(layerSize(iLayer)) };
+    const int chunkSize{ std::max(1, (size + mNThreads - 1) / mNThreads) };
+    for (int first{ 0 }; first < size; first += chunkSize) {
+      chunks.push_back(Chunk{ iLayer, first, std::min(first + chunkSize, size), {} });
+    }
+  }
+
+  std::atomic<size_t> nextChunk{ 0 };
+  auto worker = [&chunks, &nextChunk, &kernel]() {
+    for (size_t iChunk = nextChunk++; iChunk < chunks.size(); iChunk = nextChunk++) {
+      auto& chunk = chunks[iChunk];
+      kernel(chunk.layer, chunk.first, chunk.last, chunk.result);
+    }
+  };
+  std::vector<std::thread> threads;
+  const int threadsNum{ std::min(mNThreads, static_cast<int>(chunks.size())) };
+  for (int iThread{ 1 }; iThread < threadsNum; ++iThread) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  /// the output objects are not assignable, they are appended one by one
+  for (auto& chunk : chunks) {
+    for (auto& object : chunk.result) {
+      output[chunk.layer].push_back(object);
+    }
+  }
+}
+
 } // namespace ITS
 } // namespace o2
@@ -37,6 +37,27 @@ void Vertexer::clustersToVertices(ROframe& event, std::ostream& timeBenchmarkOut
   total += evaluateTask(&Vertexer::findVertices, "Vertex finding", timeBenchmarkOutputStream);
 }
 
+void Vertexer::clustersToVertices(gsl::span<ROframe> frames, std::vector<Vertex>& vertices,
+                                  std::vector<int>& verticesPerFrame, std::ostream& timeBenchmarkOutputStream)
+{
+  verticesPerFrame.reserve(verticesPerFrame.size() + frames.size());
+  for (auto& frame : frames) {
+    if (frame.getTotalClusters() == 0) {
+      verticesPerFrame.push_back(0);
+      continue;
+    }
+    mROframe = frame.getROFrameId();
+    clustersToVertices(frame, timeBenchmarkOutputStream);
+    const auto& frameVertices = mTraits->getVertices();
+    for (auto& vertex : frameVertices) {
+      vertices.emplace_back(Point3D<float>(vertex.mX, vertex.mY, vertex.mZ), vertex.mRMS2, vertex.mContributors, vertex.mAvgDistance2);
+      vertices.back().setTimeStamp(vertex.mTimeStamp);
+      frame.addPrimaryVertex(vertex.mX, vertex.mY, vertex.mZ);
+    }
+    verticesPerFrame.push_back(frameVertices.size());
+  }
+}
+
 void Vertexer::findTracklets(const bool useMCLabels)
 {
   mTraits->computeTracklets(useMCLabels);
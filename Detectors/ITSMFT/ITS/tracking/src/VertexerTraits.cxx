@@ -113,12 +113,20 @@ const std::vector<std::pair<int, int>> VertexerTraits::selectClusters(const std:
 
 void VertexerTraits::computeTracklets(const bool useMCLabel)
 {
-  std::vector<std::pair<int, int>> clusters0, clusters2;
   std::vector<bool> usedCluster2Flags, usedCluster0Flags;
   usedCluster2Flags.resize(mClusters[2].size(), false);
   usedCluster0Flags.resize(mClusters[0].size(), false);
 
-  for (int iBin1{ 0 }; iBin1 < ZBins * PhiBins; ++iBin1) {
+  computeTrackletsInBins(0, ZBins * PhiBins, useMCLabel, usedCluster0Flags, usedCluster2Flags, mTracklets);
+}
+
+void VertexerTraits::computeTrackletsInBins(const int firstBin, const int lastBin, const bool useMCLabel,
+                                            std::vector<bool>& usedCluster0Flags, std::vector<bool>& usedCluster2Flags,
+                                            std::vector<Line>& tracklets, std::vector<std::array<int, 2>>* trackletClusters) const
+{
+  std::vector<std::pair<int, int>> clusters0, clusters2;
+
+  for (int iBin1{ firstBin }; iBin1 < lastBin; ++iBin1) {
 
     int ZBinLow0{ std::max(0, ZBins - static_cast<int>(std::ceil((ZBins - iBin1 % ZBins + 1) *
                                                                  (mDeltaRadii21 + mDeltaRadii10) / mDeltaRadii10))) };
@@ -189,18 +197,21 @@ void VertexerTraits::computeTracklets(const bool useMCLabel)
                                             mClusters[1][iCluster1].phiCoordinate) };
                 float absDeltaZ{ std::abs(mClusters[2][iCluster2].zCoordinate - ZProjectionRefined) };
                 if (absDeltaZ < mVrtParams.mZCut && ((absDeltaPhi < mVrtParams.mPhiCut || std::abs(absDeltaPhi - TwoPi) < mVrtParams.mPhiCut) && testMC)) {
-                  mTracklets.emplace_back(Line{
+                  tracklets.emplace_back(Line{
                     std::array<float, 3>{ mClusters[0][iCluster0].xCoordinate, mClusters[0][iCluster0].yCoordinate,
                                           mClusters[0][iCluster0].zCoordinate },
                     std::array<float, 3>{ mClusters[1][iCluster1].xCoordinate, mClusters[1][iCluster1].yCoordinate,
                                           mClusters[1][iCluster1].zCoordinate } });
-                  if (std::abs(mTracklets.back().cosinesDirector[2]) < mMaxDirectorCosine3) {
+                  if (std::abs(tracklets.back().cosinesDirector[2]) < mMaxDirectorCosine3) {
                     usedCluster0Flags[iCluster0] = true;
                     usedCluster2Flags[iCluster2] = true;
+                    if (trackletClusters) {
+                      trackletClusters->push_back(std::array<int, 2>{ iCluster0, iCluster2 });
+                    }
                     trackFound = true;
                     break;
                   } else {
-                    mTracklets.pop_back();
+                    tracklets.pop_back();
                   }
                 }
               }
@@ -251,6 +262,11 @@ void VertexerTraits::computeVertices()
       }
     }
   }
+  finaliseVertices();
+}
+
+void VertexerTraits::finaliseVertices()
+{
   std::sort(mTrackletClusters.begin(), mTrackletClusters.end(),
             [](ClusterLines& cluster1, ClusterLines& cluster2) { return cluster1.getSize() > cluster2.getSize(); });
   int noClusters{ static_cast<int>(mTrackletClusters.size()) };
@@ -0,0 +1,192 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file VertexerTraitsParallel.cxx
+/// \brief
+///
+
+#include "ITStracking/VertexerTraitsParallel.h"
+#include "ITStracking/ClusterLines.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+namespace o2
+{
+namespace ITS
+{
+
+using Constants::IndexTable::PhiBins;
+using Constants::IndexTable::ZBins;
+
+template <typename KernelF>
+void VertexerTraitsParallel::processChunks(int chunksNum, KernelF&& kernel) const
+{
+  std::atomic<int> nextChunk{ 0 };
+  auto worker = [chunksNum, &nextChunk, &kernel]() {
+    for (int iChunk = nextChunk++; iChunk < chunksNum; iChunk = nextChunk++) {
+      kernel(iChunk);
+    }
+  };
+  std::vector<std::thread> threads;
+  const int threadsNum{ std::min(mNThreads, chunksNum) };
+  for (int iThread{ 1 }; iThread < threadsNum; ++iThread) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void VertexerTraitsParallel::computeTracklets(const bool useMCLabel)
+{
+  /// the index table bins are phi-major, a sector is the range of z bins of one phi bin
+  struct Sector {
+    std::vector<Line> tracklets;
+    std::vector<std::array<int, 2>> clusters;
+  };
+  std::vector<Sector> sectors(PhiBins);
+  processChunks(PhiBins, [this, &sectors, useMCLabel](const int iSector) {
+    std::vector<bool> usedCluster0Flags(mClusters[0].size(), false);
+    std::vector<bool> usedCluster2Flags(mClusters[2].size(), false);
+    computeTrackletsInBins(iSector * ZBins, (iSector + 1) * ZBins, useMCLabel, usedCluster0Flags, usedCluster2Flags,
+                           sectors[iSector].tracklets, &sectors[iSector].clusters);
+  });
+
+  std::vector<bool> usedCluster0Flags(mClusters[0].size(), false);
+  std::vector<bool> usedCluster2Flags(mClusters[2].size(), false);
+  for (auto& sector : sectors) {
+    for (size_t iTracklet{ 0 }; iTracklet < sector.tracklets.size(); ++iTracklet) {
+      const auto& clusters = sector.clusters[iTracklet];
+      if (usedCluster0Flags[clusters[0]] || usedCluster2Flags[clusters[1]])
+        continue;
+      usedCluster0Flags[clusters[0]] = true;
+      usedCluster2Flags[clusters[1]] = true;
+      mTracklets.push_back(sector.tracklets[iTracklet]);
+    }
+  }
+}
+
+void VertexerTraitsParallel::computeVertices()
+{
+  const int numTracklets{ static_cast<int>(mTracklets.size()) };
+  const int chunkSize{ std::max(1, numTracklets / (4 * mNThreads)) };
+  const int chunksNum{ (numTracklets + chunkSize - 1) / chunkSize };
+  const float eps{ mVrtParams.mPairCut };
+
+  /// z of the point of closest approach of the tracklets to the beam axis, sorted
+  std::vector<std::pair<float, int>> beamZ(numTracklets);
+  processChunks(chunksNum, [this, &beamZ, chunkSize, numTracklets](const int iChunk) {
+    const int last{ std::min(numTracklets, (iChunk + 1) * chunkSize) };
+    for (int iTracklet{ iChunk * chunkSize }; iTracklet < last; ++iTracklet) {
+      const Line& line{ mTracklets[iTracklet] };
+      const float transverse{ line.cosinesDirector[0] * line.cosinesDirector[0] +
+                              line.cosinesDirector[1] * line.cosinesDirector[1] };
+      const float t{ -(line.originPoint[0] * line.cosinesDirector[0] + line.originPoint[1] * line.cosinesDirector[1]) /
+                     transverse };
+      beamZ[iTracklet] = std::make_pair(line.originPoint[2] + t * line.cosinesDirector[2], iTracklet);
+    }
+  });
+  std::sort(beamZ.begin(), beamZ.end());
+
+  /// DBSCAN in z: a tracklet is a core one if at least mMinNeighbours other tracklets are within eps
+  std::vector<unsigned char> isCore(numTracklets, 0);
+  processChunks(chunksNum, [&beamZ, &isCore, this, eps, chunkSize, numTracklets](const int iChunk) {
+    const int last{ std::min(numTracklets, (iChunk + 1) * chunkSize) };
+    auto low = beamZ.begin();
+    auto high = beamZ.begin();
+    for (int iSorted{ iChunk * chunkSize }; iSorted < last; ++iSorted) {
+      const float z{ beamZ[iSorted].first };
+      low = std::lower_bound(low, beamZ.end(), std::make_pair(z - eps, -1));
+      high = std::upper_bound(std::max(low, high), beamZ.end(), std::make_pair(z + eps, numTracklets));
+      isCore[iSorted] = (high - low - 1) >= mMinNeighbours;
+    }
+  });
+
+  /// consecutive core tracklets closer than eps form a cluster, the other tracklets are attached to the
+  /// closest core tracklet within eps
+  std::vector<int> clusterId(numTracklets, -1);
+  int clustersNum{ 0 };
+  int previousCore{ -1 };
+  for (int iSorted{ 0 }; iSorted < numTracklets; ++iSorted) {
+    if (!isCore[iSorted])
+      continue;
+    if (previousCore < 0 || beamZ[iSorted].first - beamZ[previousCore].first > eps)
+      ++clustersNum;
+    clusterId[iSorted] = clustersNum - 1;
+    previousCore = iSorted;
+  }
+  std::vector<std::vector<int>> clusterTracklets(clustersNum);
+  int nextCore{ -1 };
+  previousCore = -1;
+  for (int iSorted{ 0 }; iSorted < numTracklets; ++iSorted) {
+    if (isCore[iSorted]) {
+      previousCore = iSorted;
+    } else {
+      if (nextCore <= iSorted) {
+        for (nextCore = iSorted + 1; nextCore < numTracklets && !isCore[nextCore]; ++nextCore) {
+        }
+      }
+      const float z{ beamZ[iSorted].first };
+      const float dzPrevious{ previousCore < 0 ? eps + 1.f : z - beamZ[previousCore].first };
+      const float dzNext{ nextCore >= numTracklets ? eps + 1.f : beamZ[nextCore].first - z };
+      if (dzPrevious <= eps && dzPrevious <= dzNext) {
+        clusterId[iSorted] = clusterId[previousCore];
+      } else if (dzNext <= eps) {
+        clusterId[iSorted] = clusterId[nextCore];
+      } else {
+        continue;
+      }
+    }
+    clusterTracklets[clusterId[iSorted]].push_back(beamZ[iSorted].second);
+  }
+
+  /// the vertex of each cluster is refined once with the tracklets passing within the pair cut
+  std::vector<std::vector<ClusterLines>> clusterLines(clustersNum);
+  processChunks(clustersNum, [this, &clusterTracklets, &clusterLines](const int iCluster) {
+    auto& tracklets = clusterTracklets[iCluster];
+    if (tracklets.size() < 2)
+      return;
+    std::sort(tracklets.begin(), tracklets.end());
+    auto& lines = clusterLines[iCluster];
+    auto makeCluster = [this, &tracklets, &lines]() {
+      lines.clear();
+      lines.emplace_back(tracklets[0], mTracklets[tracklets[0]], tracklets[1], mTracklets[tracklets[1]]);
+      for (size_t iTracklet{ 2 }; iTracklet < tracklets.size(); ++iTracklet) {
+        lines.back().add(tracklets[iTracklet], mTracklets[tracklets[iTracklet]]);
+      }
+    };
+    makeCluster();
+    const std::array<float, 3> vertex{ lines.back().getVertex() };
+    const size_t size{ tracklets.size() };
+    tracklets.erase(std::remove_if(tracklets.begin(), tracklets.end(), [this, &vertex](const int tracklet) {
+                      return Line::getDistanceFromPoint(mTracklets[tracklet], vertex) >= mVrtParams.mPairCut;
+                    }),
+                    tracklets.end());
+    if (tracklets.size() < 2) {
+      lines.clear();
+    } else if (tracklets.size() < size) {
+      makeCluster();
+    }
+  });
+
+  for (auto& lines : clusterLines) {
+    for (auto& cluster : lines) {
+      mTrackletClusters.push_back(cluster);
+    }
+  }
+  finaliseVertices();
+}
+
+} // namespace ITS
+} // namespace o2
@@ -0,0 +1,134 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file its-tracking-benchmark.cxx
+/// \brief Standalone replay of the ITS tracking on dumped RO frames, with timing
+///
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DataFormatsITS/TrackITS.h"
+#include "ITStracking/IOUtils.h"
+#include "ITStracking/ROframe.h"
+#include "ITStracking/Tracker.h"
+#include "ITStracking/TrackerTraitsCPU.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+
+namespace bpo = boost::program_options;
+
+int main(int argc, char* argv[])
+{
+  bpo::options_description options("its-tracking-benchmark options");
+  options.add_options()
+    ("help,h", "print this help")
+    ("input,i", bpo::value<std::string>()->required(), "RO frames, binary dump of IOUtils::writeROFramesBinary")
+    ("text-input", bpo::bool_switch(), "the input is in the text format of IOUtils::loadEventData")
+    ("write-binary", bpo::value<std::string>()->default_value(""), "write the loaded frames as a binary dump to this file")
+    ("config", bpo::value<std::string>()->default_value(""), "JSON tracking configuration of IOUtils::loadConfigurations")
+    ("repeat", bpo::value<int>()->default_value(1), "number of replays of the frames")
+    ("nthreads", bpo::value<int>()->default_value(1), "threads of the tracker traits")
+    ("rof-threads", bpo::value<int>()->default_value(1), "threads sharing the frames, each with its own tracker")
+    ("vectorised-tracklet-selection", bpo::bool_switch(), "evaluate the tracklet cuts in vectorised batches")
+    ("bz", bpo::value<float>()->default_value(5.f), "magnetic field (kG)");
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::parse_command_line(argc, argv, options), vm);
+    if (vm.count("help")) {
+      std::cout << options << std::endl;
+      return 0;
+    }
+    bpo::notify(vm);
+  } catch (const bpo::error& e) {
+    std::cerr << e.what() << "\n\n"
+              << options << std::endl;
+    return 1;
+  }
+
+  using clock = std::chrono::steady_clock;
+  using milliseconds = std::chrono::duration<double, std::milli>;
+
+  const auto input = vm["input"].as<std::string>();
+  auto start = clock::now();
+  std::vector<o2::ITS::ROframe> frames = vm["text-input"].as<bool>() ? o2::ITS::IOUtils::loadEventData(input)
+                                                                      : o2::ITS::IOUtils::loadROFramesBinary(input);
+  const double loadTime = milliseconds(clock::now() - start).count();
+  if (frames.empty()) {
+    std::cerr << "No RO frames in " << input << std::endl;
+    return 1;
+  }
+  int clustersNum{ 0 };
+  for (auto& frame : frames) {
+    clustersNum += frame.getTotalClusters();
+  }
+  std::cout << "Loaded " << frames.size() << " RO frames, " << clustersNum << " clusters, in " << loadTime << " ms"
+            << std::endl;
+
+  const auto binaryOutput = vm["write-binary"].as<std::string>();
+  if (!binaryOutput.empty()) {
+    if (!o2::ITS::IOUtils::writeROFramesBinary(binaryOutput, frames)) {
+      return 1;
+    }
+    std::cout << "Wrote " << binaryOutput << std::endl;
+  }
+  o2::ITS::IOUtils::loadConfigurations(vm["config"].as<std::string>());
+
+  const int rofThreads = std::max(1, vm["rof-threads"].as<int>());
+  std::vector<std::unique_ptr<o2::ITS::TrackerTraitsCPU>> traits;
+  std::vector<std::unique_ptr<o2::ITS::Tracker>> trackers;
+  std::vector<o2::ITS::Tracker*> trackerPointers;
+  for (int i = 0; i < rofThreads; ++i) {
+    traits.emplace_back(std::make_unique<o2::ITS::TrackerTraitsCPU>());
+    traits.back()->setNThreads(vm["nthreads"].as<int>());
+    traits.back()->setVectorisedTrackletSelection(vm["vectorised-tracklet-selection"].as<bool>());
+    trackers.emplace_back(std::make_unique<o2::ITS::Tracker>(traits.back().get()));
+    trackers.back()->setBz(vm["bz"].as<float>());
+    trackers.back()->setMonitoring(true);
+    trackerPointers.push_back(trackers.back().get());
+  }
+
+  const int repeat = std::max(1, vm["repeat"].as<int>());
+  std::array<float, o2::ITS::TrackerStagesNumber> stageTimes{};
+  double trackingTime{ 0. };
+  size_t tracksNum{ 0 };
+  for (int iRepeat = 0; iRepeat < repeat; ++iRepeat) {
+    std::vector<o2::ITS::TrackITS> tracks;
+    o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+    std::vector<int> tracksPerFrame;
+    start = clock::now();
+    o2::ITS::Tracker::clustersToTracks(trackerPointers, frames, tracks, &labels, tracksPerFrame);
+    const double time = milliseconds(clock::now() - start).count();
+    trackingTime += time;
+    tracksNum = tracks.size();
+    for (auto& info : trackers.front()->getIterationInfos()) {
+      for (int stage = 0; stage < o2::ITS::TrackerStagesNumber; ++stage) {
+        stageTimes[stage] += info.time[stage];
+      }
+    }
+    std::cout << "Replay " << iRepeat << ": " << tracks.size() << " tracks in " << time << " ms" << std::endl;
+  }
+
+  std::cout << "Tracking: " << trackingTime / repeat << " ms per replay, " << trackingTime / (repeat * frames.size())
+            << " ms per RO frame, " << tracksNum << " tracks" << std::endl;
+  std::cout << "Stage times summed over the threads, per replay:" << std::endl;
+  for (int stage = 0; stage < o2::ITS::TrackerStagesNumber; ++stage) {
+    std::cout << "  " << o2::ITS::Tracker::getStageName(stage) << ": " << stageTimes[stage] / repeat << " ms" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,51 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   FastClusterSimSpec.h
+
+#ifndef O2_ITS_FASTCLUSTERSIMDPL
+#define O2_ITS_FASTCLUSTERSIMDPL
+
+#include "TFile.h"
+
+#include "Framework/DataProcessorSpec.h"
+#include "Framework/Task.h"
+
+#include "ITSReconstruction/FastClusterSimulation.h"
+
+using namespace o2::framework;
+
+namespace o2
+{
+namespace ITS
+{
+
+class FastClusterSimDPL : public Task
+{
+ public:
+  FastClusterSimDPL() = default;
+  ~FastClusterSimDPL() override = default;
+  void init(InitContext& ic) final;
+  void run(ProcessingContext& pc) final;
+
+ private:
+  int mState = 0;
+  std::unique_ptr<TFile> mFile = nullptr;
+  std::unique_ptr<FastClusterSimulation> mSimulation = nullptr;
+};
+
+/// create a processor spec
+/// make parametrized ITS clusters of the MC kinematics, in place of the digit reader and the clusterer
+framework::DataProcessorSpec getFastClusterSimSpec();
+
+} // namespace ITS
+} // namespace o2
+
+#endif /* O2_ITS_FASTCLUSTERSIMDPL */
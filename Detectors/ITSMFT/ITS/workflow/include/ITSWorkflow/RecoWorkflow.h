@@ -22,7 +22,8 @@ namespace ITS
 
 namespace RecoWorkflow
 {
-framework::WorkflowSpec getWorkflow();
+/// \param fastSim parametrized clusters of the MC kinematics instead of the digits and the clusterer
+framework::WorkflowSpec getWorkflow(bool fastSim = false);
 }
 
 } // namespace ITS
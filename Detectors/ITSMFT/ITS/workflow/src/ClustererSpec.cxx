@@ -44,6 +44,7 @@ void ClustererDPL::init(InitContext& ic)
   mClusterer = std::make_unique<o2::itsmft::Clusterer>();
   mClusterer->setGeometry(geom);
   mClusterer->setNChips(o2::itsmft::ChipMappingITS::getNChips());
+  mClusterer->setNThreads(ic.options().get<int>("nthreads"));
 
   auto filenameGRP = ic.options().get<std::string>("grp-file");
   const auto grp = o2::parameters::GRPObject::loadFrom(filenameGRP.c_str());
@@ -110,8 +111,13 @@ void ClustererDPL::run(ProcessingContext& pc)
             << clusterROframes.size() << " RO frames and "
             << clusterMC2ROframes.size() << " MC events";
 
-  pc.outputs().snapshot(Output{ "ITS", "COMPCLUSTERS", 0, Lifetime::Timeframe }, compClusters);
-  pc.outputs().snapshot(Output{ "ITS", "CLUSTERS", 0, Lifetime::Timeframe }, clusters);
+  // the cluster vectors are sent unserialized, by passing them as const references the
+  // snapshot of vectors of messageable types is picked instead of ROOT serialization,
+  // this allows the consumers to access the clusters directly in the message
+  const auto& compClustersRef = compClusters;
+  const auto& clustersRef = clusters;
+  pc.outputs().snapshot(Output{ "ITS", "COMPCLUSTERS", 0, Lifetime::Timeframe }, compClustersRef);
+  pc.outputs().snapshot(Output{ "ITS", "CLUSTERS", 0, Lifetime::Timeframe }, clustersRef);
   pc.outputs().snapshot(Output{ "ITS", "CLUSTERSMCTR", 0, Lifetime::Timeframe }, clusterLabels);
   pc.outputs().snapshot(Output{ "ITS", "ITSClusterROF", 0, Lifetime::Timeframe }, clusterROframes);
   pc.outputs().snapshot(Output{ "ITS", "ITSClusterMC2ROF", 0, Lifetime::Timeframe }, clusterMC2ROframes);
@@ -138,7 +144,8 @@ DataProcessorSpec getClustererSpec()
     AlgorithmSpec{ adaptFromTask<ClustererDPL>() },
     Options{
       { "its-dictionary-file", VariantType::String, "complete_dictionary.bin", { "Name of the cluster-topology dictionary file" } },
-      { "grp-file", VariantType::String, "o2sim_grp.root", { "Name of the grp file" } } }
+      { "grp-file", VariantType::String, "o2sim_grp.root", { "Name of the grp file" } },
+      { "nthreads", VariantType::Int, 1, { "Number of threads clusterizing the chips of a ROF" } } }
   };
 }
 
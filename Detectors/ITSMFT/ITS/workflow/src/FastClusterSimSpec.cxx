@@ -0,0 +1,132 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   FastClusterSimSpec.cxx
+
+#include <vector>
+
+#include "TGeoGlobalMagField.h"
+#include "TTree.h"
+
+#include "Framework/ControlService.h"
+#include "ITSWorkflow/FastClusterSimSpec.h"
+#include "DataFormatsITSMFT/CompCluster.h"
+#include "DataFormatsITSMFT/Cluster.h"
+#include "DataFormatsITSMFT/ROFRecord.h"
+#include "DataFormatsParameters/GRPObject.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTrack.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+#include "Field/MagneticField.h"
+#include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/Propagator.h"
+#include "ITSBase/GeometryTGeo.h"
+
+using namespace o2::framework;
+
+namespace o2
+{
+namespace ITS
+{
+
+void FastClusterSimDPL::init(InitContext& ic)
+{
+  auto filenameGRP = ic.options().get<std::string>("grp-file");
+  const auto grp = o2::parameters::GRPObject::loadFrom(filenameGRP.c_str());
+  if (!grp) {
+    LOG(ERROR) << "Cannot retrieve GRP from the " << filenameGRP.c_str() << " file !";
+    mState = 0;
+    return;
+  }
+  o2::base::Propagator::initFieldFromGRP(grp);
+  auto field = static_cast<o2::field::MagneticField*>(TGeoGlobalMagField::Instance()->GetField());
+  double origD[3] = { 0., 0., 0. };
+
+  o2::base::GeometryManager::loadGeometry();
+  o2::ITS::GeometryTGeo* geom = o2::ITS::GeometryTGeo::Instance();
+  geom->fillMatrixCache(o2::utils::bit2Mask(o2::TransformType::T2L));
+
+  auto filename = ic.options().get<std::string>("its-kine-infile");
+  mFile = std::make_unique<TFile>(filename.c_str(), "OLD");
+  if (!mFile->IsOpen()) {
+    LOG(ERROR) << "Cannot open the " << filename.c_str() << " file !";
+    mState = 0;
+    return;
+  }
+
+  mSimulation = std::make_unique<FastClusterSimulation>();
+  mSimulation->init(geom, ic.options().get<std::string>("its-dictionary-file"), field->getBz(origD));
+  mState = 1;
+}
+
+void FastClusterSimDPL::run(ProcessingContext& pc)
+{
+  if (mState != 1) {
+    return;
+  }
+
+  std::unique_ptr<TTree> treeKine((TTree*)mFile->Get("o2sim"));
+  if (!treeKine) {
+    LOG(ERROR) << "Cannot read the MC kinematics !";
+    return;
+  }
+  std::vector<o2::MCTrack> tracks, *ptracks = &tracks;
+  treeKine->SetBranchAddress("MCTrack", &ptracks);
+
+  std::vector<o2::itsmft::CompClusterExt> compClusters;
+  std::vector<o2::itsmft::Cluster> clusters;
+  o2::dataformats::MCTruthContainer<o2::MCCompLabel> clusterLabels;
+  std::vector<o2::itsmft::ROFRecord> clusterROframes;
+  std::vector<o2::itsmft::MC2ROFRecord> clusterMC2ROframes;
+
+  int ne = treeKine->GetEntries();
+  for (int e = 0; e < ne; e++) {
+    treeKine->GetEntry(e);
+    mSimulation->processEvent(tracks, e, 0, &clusters, &compClusters, &clusterLabels, &clusterROframes, &clusterMC2ROframes);
+  }
+
+  LOG(INFO) << "ITSFastClusterSim pushed " << clusters.size() << " clusters, in "
+            << clusterROframes.size() << " RO frames and "
+            << clusterMC2ROframes.size() << " MC events";
+
+  // same outputs as the clusterer, the cluster vectors are sent unserialized
+  const auto& compClustersRef = compClusters;
+  const auto& clustersRef = clusters;
+  pc.outputs().snapshot(Output{ "ITS", "COMPCLUSTERS", 0, Lifetime::Timeframe }, compClustersRef);
+  pc.outputs().snapshot(Output{ "ITS", "CLUSTERS", 0, Lifetime::Timeframe }, clustersRef);
+  pc.outputs().snapshot(Output{ "ITS", "CLUSTERSMCTR", 0, Lifetime::Timeframe }, clusterLabels);
+  pc.outputs().snapshot(Output{ "ITS", "ITSClusterROF", 0, Lifetime::Timeframe }, clusterROframes);
+  pc.outputs().snapshot(Output{ "ITS", "ITSClusterMC2ROF", 0, Lifetime::Timeframe }, clusterMC2ROframes);
+
+  mState = 2;
+  //pc.services().get<ControlService>().readyToQuit(true);
+}
+
+DataProcessorSpec getFastClusterSimSpec()
+{
+  return DataProcessorSpec{
+    "its-fast-cluster-sim",
+    Inputs{},
+    Outputs{
+      OutputSpec{ "ITS", "COMPCLUSTERS", 0, Lifetime::Timeframe },
+      OutputSpec{ "ITS", "CLUSTERS", 0, Lifetime::Timeframe },
+      OutputSpec{ "ITS", "CLUSTERSMCTR", 0, Lifetime::Timeframe },
+      OutputSpec{ "ITS", "ITSClusterROF", 0, Lifetime::Timeframe },
+      OutputSpec{ "ITS", "ITSClusterMC2ROF", 0, Lifetime::Timeframe } },
+    AlgorithmSpec{ adaptFromTask<FastClusterSimDPL>() },
+    Options{
+      { "its-kine-infile", VariantType::String, "o2sim.root", { "Name of the MC kinematics file" } },
+      { "its-dictionary-file", VariantType::String, "complete_dictionary.bin", { "Name of the cluster-topology dictionary file" } },
+      { "grp-file", VariantType::String, "o2sim_grp.root", { "Name of the grp file" } } }
+  };
+}
+
+} // namespace ITS
+} // namespace o2
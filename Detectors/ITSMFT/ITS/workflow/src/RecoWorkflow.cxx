@@ -14,6 +14,7 @@
 
 #include "ITSWorkflow/DigitReaderSpec.h"
 #include "ITSWorkflow/ClustererSpec.h"
+#include "ITSWorkflow/FastClusterSimSpec.h"
 #include "ITSWorkflow/ClusterWriterSpec.h"
 #include "ITSWorkflow/TrackerSpec.h"
 #include "ITSWorkflow/CookedTrackerSpec.h"
@@ -27,12 +28,16 @@ namespace ITS
 namespace RecoWorkflow
 {
 
-framework::WorkflowSpec getWorkflow()
+framework::WorkflowSpec getWorkflow(bool fastSim)
 {
   framework::WorkflowSpec specs;
 
-  specs.emplace_back(o2::ITS::getDigitReaderSpec());
-  specs.emplace_back(o2::ITS::getClustererSpec());
+  if (fastSim) {
+    specs.emplace_back(o2::ITS::getFastClusterSimSpec());
+  } else {
+    specs.emplace_back(o2::ITS::getDigitReaderSpec());
+    specs.emplace_back(o2::ITS::getClustererSpec());
+  }
   specs.emplace_back(o2::ITS::getClusterWriterSpec());
   //specs.emplace_back(o2::ITS::getTrackerSpec());
   specs.emplace_back(o2::ITS::getCookedTrackerSpec());
@@ -15,6 +15,7 @@
 #include "TGeoGlobalMagField.h"
 
 #include "Framework/ControlService.h"
+#include <Monitoring/Monitoring.h>
 #include "ITSWorkflow/TrackerSpec.h"
 #include "DataFormatsITSMFT/CompCluster.h"
 #include "DataFormatsITSMFT/Cluster.h"
@@ -51,14 +52,26 @@ class TrackerDPL : public Task
   void run(ProcessingContext& pc) final;
 
  private:
+  void accumulateIterationInfos();
+
   int mState = 0;
+  std::array<float, o2::ITS::TrackerStagesNumber> mStageTimes{};
+  std::array<int, o2::ITS::TrackerStagesNumber> mStageObjects{};
   o2::ITS::TrackerTraitsCPU mTraits;
   std::unique_ptr<o2::parameters::GRPObject> mGRP = nullptr;
   std::unique_ptr<o2::ITS::Tracker> mTracker = nullptr;
+  /// trackers of the other threads over the RO frames of a timeframe, each with its own traits
+  std::vector<std::unique_ptr<o2::ITS::TrackerTraitsCPU>> mWorkerTraits;
+  std::vector<std::unique_ptr<o2::ITS::Tracker>> mWorkerTrackers;
+  std::vector<o2::ITS::Tracker*> mTrackers;
+  std::vector<o2::ITS::ROframe> mFrames; ///< RO frames of the timeframe, kept with their capacity
 };
 
 void TrackerDPL::init(InitContext& ic)
 {
+  auto nthreads = ic.options().get<int>("nthreads");
+  mTraits.setNThreads(nthreads);
+  mTraits.setVectorisedTrackletSelection(ic.options().get<bool>("vectorised-tracklet-selection"));
   auto filename = ic.options().get<std::string>("grp-file");
   const auto grp = o2::parameters::GRPObject::loadFrom(filename.c_str());
   if (grp) {
@@ -72,8 +85,21 @@ void TrackerDPL::init(InitContext& ic)
                                               o2::TransformType::T2G));
 
     mTracker = std::make_unique<o2::ITS::Tracker>(&mTraits);
+    mTracker->setMonitoring(true);
     double origD[3] = { 0., 0., 0. };
     mTracker->setBz(field->getBz(origD));
+
+    mTrackers.assign(1, mTracker.get());
+    auto rofThreads = ic.options().get<int>("rof-threads");
+    for (int i = 1; i < rofThreads; ++i) {
+      mWorkerTraits.emplace_back(std::make_unique<o2::ITS::TrackerTraitsCPU>());
+      mWorkerTraits.back()->setNThreads(nthreads);
+      mWorkerTraits.back()->setVectorisedTrackletSelection(ic.options().get<bool>("vectorised-tracklet-selection"));
+      mWorkerTrackers.emplace_back(std::make_unique<o2::ITS::Tracker>(mWorkerTraits.back().get()));
+      mWorkerTrackers.back()->setMonitoring(true);
+      mWorkerTrackers.back()->setBz(field->getBz(origD));
+      mTrackers.push_back(mWorkerTrackers.back().get());
+    }
   } else {
     LOG(ERROR) << "Cannot retrieve GRP from the " << filename.c_str() << " file !";
     mState = 0;
@@ -81,13 +107,27 @@ void TrackerDPL::init(InitContext& ic)
   mState = 1;
 }
 
+void TrackerDPL::accumulateIterationInfos()
+{
+  for (auto& info : mTracker->getIterationInfos()) {
+    for (int stage = 0; stage < o2::ITS::TrackerStagesNumber; ++stage) {
+      mStageTimes[stage] += info.time[stage];
+      mStageObjects[stage] += info.objects[stage];
+    }
+  }
+}
+
 void TrackerDPL::run(ProcessingContext& pc)
 {
   if (mState != 1)
     return;
 
-  auto compClusters = pc.inputs().get<const std::vector<o2::itsmft::CompClusterExt>>("compClusters");
-  auto clusters = pc.inputs().get<const std::vector<o2::itsmft::Cluster>>("clusters");
+  mStageTimes.fill(0.f);
+  mStageObjects.fill(0);
+
+  // the clusters are used directly from the input messages, without copy
+  auto compClusters = pc.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("compClusters");
+  auto clusters = pc.inputs().get<gsl::span<o2::itsmft::Cluster>>("clusters");
   auto labels = pc.inputs().get<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>*>("labels");
   auto rofs = pc.inputs().get<const std::vector<o2::itsmft::ROFRecord>>("ROframes");
   auto mc2rofs = pc.inputs().get<const std::vector<o2::itsmft::MC2ROFRecord>>("MC2ROframes");
@@ -97,45 +137,56 @@ void TrackerDPL::run(ProcessingContext& pc)
             << rofs.size() << " RO frames and "
             << mc2rofs.size() << " MC events";
 
-  std::vector<o2::ITS::TrackITS> tracks;
-  o2::dataformats::MCTruthContainer<o2::MCCompLabel> trackLabels;
   std::vector<o2::ITS::TrackITS> allTracks;
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> allTrackLabels;
 
-  std::uint32_t roFrame = 0;
-  o2::ITS::ROframe event(0);
-
   bool continuous = mGRP->isDetContinuousReadOut("ITS");
   LOG(INFO) << "ITSTracker RO: continuous=" << continuous;
 
   if (continuous) {
-    for (const auto& rof : rofs) {
-      int nclUsed = o2::ITS::IOUtils::loadROFrameData(rof, event, &clusters, labels.get());
+    // all the RO frames of the timeframe are loaded first and then tracked in one call, which keeps the
+    // buffers of the trackers from one frame to the next and can share the frames among several trackers
+    while (mFrames.size() < rofs.size()) {
+      mFrames.emplace_back(mFrames.size());
+    }
+    for (std::uint32_t roFrame = 0; roFrame < rofs.size(); roFrame++) {
+      auto& frame = mFrames[roFrame];
+      int nclUsed = o2::ITS::IOUtils::loadROFrameData(rofs[roFrame], frame, clusters, labels.get());
       if (nclUsed) {
         LOG(INFO) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed;
-        event.addPrimaryVertex(0.f, 0.f, 0.f); //FIXME :  run an actual vertex finder !
-        mTracker->setROFrame(roFrame);
-        mTracker->clustersToTracks(event);
-        tracks.swap(mTracker->getTracks());
-        LOG(INFO) << "Found tracks: " << tracks.size();
-        trackLabels = mTracker->getTrackLabels(); /// FIXME: assignment ctor is not optimal.
-        int first = allTracks.size();
-        int number = tracks.size();
-        rofs[roFrame].getROFEntry().setIndex(first);
-        rofs[roFrame].setNROFEntries(number);
-        std::copy(tracks.begin(), tracks.end(), std::back_inserter(allTracks));
-        allTrackLabels.mergeAtBack(trackLabels);
+        frame.addPrimaryVertex(0.f, 0.f, 0.f); //FIXME :  run an actual vertex finder !
       }
-      roFrame++;
+    }
+    std::vector<int> tracksPerFrame;
+    gsl::span<const o2::ITS::ROframe> frames(mFrames.data(), rofs.size());
+    o2::ITS::Tracker::clustersToTracks(mTrackers, frames, allTracks, &allTrackLabels, tracksPerFrame);
+    accumulateIterationInfos();
+    int first = 0;
+    for (std::uint32_t roFrame = 0; roFrame < rofs.size(); roFrame++) {
+      rofs[roFrame].getROFEntry().setIndex(first);
+      rofs[roFrame].setNROFEntries(tracksPerFrame[roFrame]);
+      first += tracksPerFrame[roFrame];
     }
   } else {
-    o2::ITS::IOUtils::loadEventData(event, &clusters, labels.get());
+    o2::ITS::ROframe event(0);
+    o2::ITS::IOUtils::loadEventData(event, clusters, labels.get());
     event.addPrimaryVertex(0.f, 0.f, 0.f); //FIXME :  run an actual vertex finder !
     mTracker->clustersToTracks(event);
+    accumulateIterationInfos();
     allTracks.swap(mTracker->getTracks());
     allTrackLabels = mTracker->getTrackLabels(); /// FIXME: assignment ctor is not optimal.
   }
 
+  // per timeframe timing and object counts of the tracking stages
+  static const std::array<const char*, o2::ITS::TrackerStagesNumber> stageMetricNames = {
+    "context", "tracklets", "cells", "neighbours", "roads", "tracks"
+  };
+  auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+  for (int stage = 0; stage < o2::ITS::TrackerStagesNumber; ++stage) {
+    monitoring.send(o2::monitoring::Metric{ static_cast<double>(mStageTimes[stage]), std::string("its_tracker_time_") + stageMetricNames[stage] });
+    monitoring.send(o2::monitoring::Metric{ mStageObjects[stage], std::string("its_tracker_n_") + stageMetricNames[stage] });
+  }
+
   LOG(INFO) << "ITSTracker pushed " << allTracks.size() << " tracks";
   pc.outputs().snapshot(Output{ "ITS", "TRACKS", 0, Lifetime::Timeframe }, allTracks);
   pc.outputs().snapshot(Output{ "ITS", "TRACKSMCTR", 0, Lifetime::Timeframe }, allTrackLabels);
@@ -164,6 +215,9 @@ DataProcessorSpec getTrackerSpec()
     AlgorithmSpec{ adaptFromTask<TrackerDPL>() },
     Options{
       { "grp-file", VariantType::String, "o2sim_grp.root", { "Name of the output file" } },
+      { "nthreads", VariantType::Int, 1, { "Number of threads" } },
+      { "rof-threads", VariantType::Int, 1, { "Number of threads sharing the RO frames of a timeframe, each with its own tracker" } },
+      { "vectorised-tracklet-selection", VariantType::Bool, false, { "Evaluate the tracklet cuts in vectorised batches" } },
     }
   };
 }
@@ -21,6 +21,7 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   // option allowing to set parameters
   std::string keyvaluehelp("Semicolon separated key=value strings (e.g.: 'ITSDigitizerParam.roFrameLength=6000.;...')");
   workflowOptions.push_back(ConfigParamSpec{ "configKeyValues", VariantType::String, "", { keyvaluehelp } });
+  workflowOptions.push_back(ConfigParamSpec{ "fast-sim", VariantType::Bool, false, { "parametrized clusters of the MC kinematics instead of the digits (ITSFastSim.* parameters)" } });
 }
 
 // ------------------------------------------------------------------
@@ -34,5 +35,5 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   // write the configuration used for the digitizer workflow
   o2::conf::ConfigurableParam::writeINI("o2itsrecoflow_configuration.ini");
 
-  return std::move(o2::ITS::RecoWorkflow::getWorkflow());
+  return std::move(o2::ITS::RecoWorkflow::getWorkflow(configcontext.options().get<bool>("fast-sim")));
 }
@@ -16,11 +16,11 @@
 #ifndef ALICEO2_MFT_TRACKERTASK_H_
 #define ALICEO2_MFT_TRACKERTASK_H_
 
+#include <memory>
+
 #include "FairTask.h"
 
 #include "DataFormatsMFT/TrackMFT.h"
-#include "MFTBase/GeometryTGeo.h"
-#include "MFTReconstruction/Tracker.h"
 
 namespace o2
 {
@@ -34,6 +34,9 @@ class MCTruthContainer;
 
 namespace MFT
 {
+class Tracker;
+class TrackerTraitsCPU;
+
 class TrackerTask : public FairTask
 {
  public:
@@ -47,8 +50,9 @@ class TrackerTask : public FairTask
   bool getContinuousMode() { return mContinuousMode; }
 
  private:
-  bool mContinuousMode = true; ///< triggered or cont. mode
-  Tracker mTracker;            ///< Track finder
+  bool mContinuousMode = true;               ///< triggered or cont. mode
+  std::unique_ptr<TrackerTraitsCPU> mTraits; //! CA tracklet and cell finding
+  std::unique_ptr<Tracker> mTracker;         //! CA track finder
 
   const std::vector<o2::itsmft::Cluster>* mClustersArray = nullptr;               ///< Array of clusters
   const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mClsLabels = nullptr; ///< Cluster MC labels
@@ -56,7 +60,7 @@ class TrackerTask : public FairTask
   std::vector<TrackMFT>* mTracksArray = nullptr;                            ///< Array of tracks
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mTrkLabels = nullptr; ///< Track MC labels
 
-  ClassDefOverride(TrackerTask, 1)
+  ClassDefOverride(TrackerTask, 2)
 };
 }
 }
@@ -15,18 +15,28 @@
 
 #include "MFTReconstruction/TrackerTask.h"
 #include "DataFormatsITSMFT/Cluster.h"
+#include "MFTBase/GeometryTGeo.h"
+#include "MFTtracking/IOUtils.h"
+#include "MFTtracking/ROframe.h"
+#include "MFTtracking/Tracker.h"
+#include "MFTtracking/TrackerTraitsCPU.h"
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
 
+#include <algorithm>
+
 ClassImp(o2::MFT::TrackerTask);
 
 using namespace o2::MFT;
 using namespace o2::base;
 
 //_____________________________________________________________________________
-TrackerTask::TrackerTask(Int_t n, Bool_t useMCTruth) : FairTask("MFTTrackerTask"), mTracker(n)
+TrackerTask::TrackerTask(Int_t n, Bool_t useMCTruth)
+  : FairTask("MFTTrackerTask"), mTraits(std::make_unique<TrackerTraitsCPU>())
 {
-
+  mTraits->setNThreads(n);
+  mTracker = std::make_unique<Tracker>(mTraits.get());
+  mTracksArray = new std::vector<TrackMFT>;
   if (useMCTruth) {
     mTrkLabels = new o2::dataformats::MCTruthContainer<o2::MCCompLabel>;
   }
@@ -76,11 +86,7 @@ InitStatus TrackerTask::Init()
   }
 
   GeometryTGeo* geom = GeometryTGeo::Instance();
-  geom->fillMatrixCache(o2::utils::bit2Mask(o2::TransformType::L2G));
-  // geom->fillMatrixCache(o2::utils::bit2Mask(o2::TransformType::T2L, o2::TransformType::T2G, o2::TransformType::L2G));
-  mTracker.setGeometry(geom);
-  mTracker.setMCTruthContainers(mClsLabels, mTrkLabels);
-  mTracker.setContinuousMode(mContinuousMode);
+  geom->fillMatrixCache(o2::utils::bit2Mask(o2::TransformType::T2G));
 
   return kSUCCESS;
 }
@@ -95,7 +101,39 @@ void TrackerTask::Exec(Option_t* option)
   if (mTrkLabels) {
     mTrkLabels->clear();
   }
-  LOG(DEBUG) << "Running digitization on new event" << FairLogger::endl;
+  LOG(DEBUG) << "Running tracking on new event" << FairLogger::endl;
+
+  gsl::span<const o2::itsmft::Cluster> clusters(*mClustersArray);
+  const auto* labels = mTrkLabels ? mClsLabels : nullptr;
+  std::uint32_t maxROFrame{ 0 };
+  if (mContinuousMode) {
+    for (const auto& c : clusters) {
+      maxROFrame = std::max(maxROFrame, static_cast<std::uint32_t>(c.getROFrame()));
+    }
+  }
 
-  mTracker.process(*mClustersArray, *mTracksArray);
+  ROframe event(0);
+  for (std::uint32_t roFrame{ 0 }; !clusters.empty() && roFrame <= maxROFrame; ++roFrame) {
+    int nclUsed{ 0 };
+    if (mContinuousMode) {
+      nclUsed = IOUtils::loadROFrameData(roFrame, event, clusters, labels);
+    } else {
+      IOUtils::loadEventData(event, clusters, labels);
+      nclUsed = event.getTotalClusters();
+    }
+    if (nclUsed == 0) {
+      continue;
+    }
+    LOG(DEBUG) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed << FairLogger::endl;
+
+    event.addPrimaryVertex(0.f, 0.f, 0.f); // the nominal vertex, the MFT alone does not measure it
+    mTracker->setROFrame(roFrame);
+    mTracker->clustersToTracks(event);
+    auto& tracks = mTracker->getTracks();
+    if (mTrkLabels) {
+      mTrkLabels->mergeAtBack(mTracker->getTrackLabels());
+    }
+    mTracksArray->insert(mTracksArray->end(), tracks.begin(), tracks.end());
+  }
+  LOG(DEBUG) << "MFT tracks found: " << mTracksArray->size() << FairLogger::endl;
 }
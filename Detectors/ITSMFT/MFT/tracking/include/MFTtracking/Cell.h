@@ -0,0 +1,85 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Cell.h
+/// \brief Pair of compatible tracklets sharing a cluster, on three consecutive disks
+///
+
+#ifndef TRACKINGMFT_INCLUDE_CACELL_H_
+#define TRACKINGMFT_INCLUDE_CACELL_H_
+
+#include "ITStracking/Definitions.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+class Cell final
+{
+ public:
+  GPU_DEVICE Cell(const int, const int, const int, const int, const int, const float, const float);
+
+  int getFirstClusterIndex() const;
+  int getSecondClusterIndex() const;
+  int getThirdClusterIndex() const;
+  GPU_HOST_DEVICE int getFirstTrackletIndex() const;
+  int getSecondTrackletIndex() const;
+  int getLevel() const;
+  float getCurvature() const;
+  float getRZSlope() const;
+  void setLevel(const int level);
+
+ private:
+  const int mFirstClusterIndex;
+  const int mSecondClusterIndex;
+  const int mThirdClusterIndex;
+  const int mFirstTrackletIndex;
+  const int mSecondTrackletIndex;
+  const float mCurvature; ///< signed curvature of the circle through the clusters in the transverse plane
+  const float mRZSlope;   ///< mean dr/dz of the tracklets
+  int mLevel;
+};
+
+inline GPU_DEVICE Cell::Cell(const int firstClusterIndex, const int secondClusterIndex, const int thirdClusterIndex,
+                             const int firstTrackletIndex, const int secondTrackletIndex, const float curvature,
+                             const float rzSlope)
+  : mFirstClusterIndex{ firstClusterIndex },
+    mSecondClusterIndex{ secondClusterIndex },
+    mThirdClusterIndex{ thirdClusterIndex },
+    mFirstTrackletIndex(firstTrackletIndex),
+    mSecondTrackletIndex(secondTrackletIndex),
+    mCurvature{ curvature },
+    mRZSlope{ rzSlope },
+    mLevel{ 1 }
+{
+  // Nothing to do
+}
+
+inline int Cell::getFirstClusterIndex() const { return mFirstClusterIndex; }
+
+inline int Cell::getSecondClusterIndex() const { return mSecondClusterIndex; }
+
+inline int Cell::getThirdClusterIndex() const { return mThirdClusterIndex; }
+
+GPU_HOST_DEVICE inline int Cell::getFirstTrackletIndex() const { return mFirstTrackletIndex; }
+
+inline int Cell::getSecondTrackletIndex() const { return mSecondTrackletIndex; }
+
+inline int Cell::getLevel() const { return mLevel; }
+
+inline float Cell::getCurvature() const { return mCurvature; }
+
+inline float Cell::getRZSlope() const { return mRZSlope; }
+
+inline void Cell::setLevel(const int level) { mLevel = level; }
+} // namespace MFT
+} // namespace o2
+#endif /* TRACKINGMFT_INCLUDE_CACELL_H_ */
@@ -0,0 +1,41 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Cluster.h
+/// \brief Cluster of a disk, in global coordinates
+///
+
+#ifndef TRACKINGMFT_INCLUDE_CACLUSTER_H_
+#define TRACKINGMFT_INCLUDE_CACLUSTER_H_
+
+#include "ITStracking/Definitions.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+struct Cluster final {
+  Cluster(const float x, const float y, const float z, const int idx);
+  /// copy of the cluster with r and phi w.r.t. the primary vertex and the bin of the index table of the disk
+  Cluster(const int, const float3&, const Cluster&);
+
+  float xCoordinate;
+  float yCoordinate;
+  float zCoordinate;
+  float phiCoordinate;
+  float rCoordinate;
+  int clusterId;
+  int indexTableBinIndex;
+};
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_CACLUSTER_H_ */
@@ -0,0 +1,52 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Configuration.h
+/// \brief Cuts of an iteration of the MFT tracking
+///
+
+#ifndef TRACKINGMFT_INCLUDE_CONFIGURATION_H_
+#define TRACKINGMFT_INCLUDE_CONFIGURATION_H_
+
+#include "MFTtracking/Constants.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+struct TrackingParameters {
+  int CellMinimumLevel() const;
+
+  /// General parameters
+  int ClusterSharing = 0;
+  int MinTrackLength = 4; ///< in clusters, i.e. in disks
+  /// Trackleting cuts, the second cluster w.r.t. the straight line from the primary vertex through the first one
+  float TrackletMaxDeltaPhi = 0.05f;
+  float TrackletMaxDeltaR[Constants::MFT::TrackletsPerRoad] = { 0.1f, 0.1f, 0.3f, 0.1f };
+  /// Cell finding cuts, the DCA being the one of the line through the first and third clusters to the primary vertex
+  /// in the transverse plane
+  float CellMaxDeltaRZSlope = 0.01f;
+  float CellMaxDeltaPhi = 0.1f;
+  float CellMaxDCA[Constants::MFT::CellsPerRoad] = { 0.5f, 0.5f, 0.5f };
+  /// Neighbour finding cuts
+  float NeighbourMaxDeltaCurvature[Constants::MFT::CellsPerRoad - 1] = { 0.05f, 0.05f };
+  float NeighbourMaxDeltaRZSlope[Constants::MFT::CellsPerRoad - 1] = { 0.005f, 0.005f };
+};
+
+inline int TrackingParameters::CellMinimumLevel() const
+{
+  return MinTrackLength - Constants::MFT::ClustersPerCell + 1;
+}
+
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_CONFIGURATION_H_ */
@@ -0,0 +1,81 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Constants.h
+/// \brief Constants of the MFT cellular automaton tracking; distance unit is cm
+///
+
+#ifndef TRACKINGMFT_INCLUDE_CONSTANTS_H_
+#define TRACKINGMFT_INCLUDE_CONSTANTS_H_
+
+#include "ITStracking/Constants.h"
+#include "ITStracking/Definitions.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+namespace Constants
+{
+
+constexpr bool DoTimeBenchmarks = false;
+
+namespace Math = o2::ITS::Constants::Math;
+
+/// The tracking stations are the disks: the clusters of the two faces of a disk share the
+/// index table of the disk, a road has at most one cluster per disk
+namespace MFT
+{
+constexpr int DisksNumber{ 5 };
+constexpr int LayersNumber{ 2 * DisksNumber };
+constexpr int TrackletsPerRoad{ DisksNumber - 1 };
+constexpr int CellsPerRoad{ DisksNumber - 2 };
+constexpr int ClustersPerCell{ 3 };
+constexpr int UnusedIndex{ -1 };
+constexpr float Resolution{ 0.0005f };
+
+/// z of the middle of the sensors of the layers, as the LayerZPosition of MFTBase
+GPU_HOST_DEVICE constexpr GPUArray<float, LayersNumber> LayersZCoordinate()
+{
+  return GPUArray<float, LayersNumber>{ { -45.3f, -46.7f, -48.6f, -50.0f, -52.4f, -53.8f, -68.0f, -69.4f, -76.1f,
+                                          -77.5f } };
+}
+/// radial range of the index tables of the disks, the clusters outside fall in the first
+/// and last r bins
+GPU_HOST_DEVICE constexpr GPUArray<float, DisksNumber> DisksRMin()
+{
+  return GPUArray<float, DisksNumber>{ { 2.0f, 2.0f, 2.0f, 2.5f, 2.5f } };
+}
+GPU_HOST_DEVICE constexpr GPUArray<float, DisksNumber> DisksRMax()
+{
+  return GPUArray<float, DisksNumber>{ { 12.5f, 12.5f, 14.5f, 17.5f, 17.5f } };
+}
+} // namespace MFT
+
+namespace IndexTable
+{
+constexpr int RBins{ 30 };
+constexpr int PhiBins{ 64 };
+constexpr float InversePhiBinSize{ PhiBins / Math::TwoPi };
+GPU_HOST_DEVICE constexpr GPUArray<float, MFT::DisksNumber> InverseRBinSize()
+{
+  return GPUArray<float, MFT::DisksNumber>{ { RBins / (MFT::DisksRMax()[0] - MFT::DisksRMin()[0]),
+                                              RBins / (MFT::DisksRMax()[1] - MFT::DisksRMin()[1]),
+                                              RBins / (MFT::DisksRMax()[2] - MFT::DisksRMin()[2]),
+                                              RBins / (MFT::DisksRMax()[3] - MFT::DisksRMin()[3]),
+                                              RBins / (MFT::DisksRMax()[4] - MFT::DisksRMin()[4]) } };
+}
+} // namespace IndexTable
+} // namespace Constants
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_CONSTANTS_H_ */
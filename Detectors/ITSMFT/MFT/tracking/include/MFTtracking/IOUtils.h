@@ -0,0 +1,55 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file IOUtils.h
+/// \brief Filling of the MFT tracking frames from the clusters
+///
+
+#ifndef TRACKINGMFT_INCLUDE_IOUTILS_H_
+#define TRACKINGMFT_INCLUDE_IOUTILS_H_
+
+#include <cstdint>
+
+#include <gsl/span>
+
+#include "MFTtracking/ROframe.h"
+
+namespace o2
+{
+
+class MCCompLabel;
+
+namespace dataformats
+{
+template <typename T>
+class MCTruthContainer;
+}
+
+namespace itsmft
+{
+class Cluster;
+}
+
+namespace MFT
+{
+
+namespace IOUtils
+{
+/// All the clusters in one frame (triggered mode), in the global frame and on their disk
+void loadEventData(ROframe& event, gsl::span<const itsmft::Cluster> clusters,
+                   const dataformats::MCTruthContainer<MCCompLabel>* mcLabels = nullptr);
+/// The clusters of the read-out frame roFrame (continuous mode), returns their number
+int loadROFrameData(std::uint32_t roFrame, ROframe& event, gsl::span<const itsmft::Cluster> clusters,
+                    const dataformats::MCTruthContainer<MCCompLabel>* mcLabels = nullptr);
+} // namespace IOUtils
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_IOUTILS_H_ */
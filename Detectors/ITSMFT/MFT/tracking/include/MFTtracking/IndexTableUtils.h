@@ -0,0 +1,68 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file IndexTableUtils.h
+/// \brief Binning of the clusters of a disk in r and phi
+///
+
+#ifndef TRACKINGMFT_INCLUDE_INDEXTABLEUTILS_H_
+#define TRACKINGMFT_INCLUDE_INDEXTABLEUTILS_H_
+
+#include "MFTtracking/Constants.h"
+#include "ITStracking/Definitions.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+/// The bins of a disk are ordered by phi rows, the r bins of a row being contiguous
+namespace IndexTableUtils
+{
+GPU_HOST_DEVICE int getRBinIndex(const int, const float);
+GPU_HOST_DEVICE int getPhiBinIndex(const float);
+GPU_HOST_DEVICE int getBinIndex(const int, const int);
+GPU_HOST_DEVICE int countRowSelectedBins(
+  const GPUArray<int, Constants::IndexTable::RBins * Constants::IndexTable::PhiBins + 1>&, const int, const int,
+  const int);
+} // namespace IndexTableUtils
+
+GPU_HOST_DEVICE inline int IndexTableUtils::getRBinIndex(const int diskIndex, const float rCoordinate)
+{
+  const int rBin = (rCoordinate - Constants::MFT::DisksRMin()[diskIndex]) *
+                   Constants::IndexTable::InverseRBinSize()[diskIndex];
+  return MATH_MAX(0, MATH_MIN(Constants::IndexTable::RBins - 1, rBin));
+}
+
+GPU_HOST_DEVICE inline int IndexTableUtils::getPhiBinIndex(const float currentPhi)
+{
+  return MATH_MIN(static_cast<int>(currentPhi * Constants::IndexTable::InversePhiBinSize),
+                  Constants::IndexTable::PhiBins - 1);
+}
+
+GPU_HOST_DEVICE inline int IndexTableUtils::getBinIndex(const int rIndex, const int phiIndex)
+{
+  return MATH_MIN(phiIndex * Constants::IndexTable::RBins + rIndex,
+                  Constants::IndexTable::RBins * Constants::IndexTable::PhiBins);
+}
+
+GPU_HOST_DEVICE inline int IndexTableUtils::countRowSelectedBins(
+  const GPUArray<int, Constants::IndexTable::RBins * Constants::IndexTable::PhiBins + 1>& indexTable,
+  const int phiBinIndex, const int minRBinIndex, const int maxRBinIndex)
+{
+  const int firstBinIndex{ getBinIndex(minRBinIndex, phiBinIndex) };
+  const int maxBinIndex{ firstBinIndex + maxRBinIndex - minRBinIndex + 1 };
+
+  return indexTable[maxBinIndex] - indexTable[firstBinIndex];
+}
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_INDEXTABLEUTILS_H_ */
@@ -0,0 +1,125 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file PrimaryVertexContext.h
+/// \brief Clusters, index tables and CA objects of the tracking of one primary vertex
+///
+
+#ifndef TRACKINGMFT_INCLUDE_PRIMARYVERTEXCONTEXT_H_
+#define TRACKINGMFT_INCLUDE_PRIMARYVERTEXCONTEXT_H_
+
+#include <array>
+#include <vector>
+
+#include "ITStracking/Definitions.h"
+#include "MFTtracking/Cell.h"
+#include "MFTtracking/Cluster.h"
+#include "MFTtracking/Constants.h"
+#include "MFTtracking/Road.h"
+#include "MFTtracking/Tracklet.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+class PrimaryVertexContext
+{
+ public:
+  using IndexTable = std::array<int, Constants::IndexTable::RBins * Constants::IndexTable::PhiBins + 1>;
+
+  PrimaryVertexContext() = default;
+
+  virtual ~PrimaryVertexContext() = default;
+
+  PrimaryVertexContext(const PrimaryVertexContext&) = delete;
+  PrimaryVertexContext& operator=(const PrimaryVertexContext&) = delete;
+
+  /// The clusters are sorted and the index tables built at the first iteration, the following iterations only
+  /// reset the CA objects and keep the clusters used by the previous ones
+  virtual void initialise(const std::array<std::vector<Cluster>, Constants::MFT::DisksNumber>& cl,
+                          const std::array<float, 3>& pv, const int iteration);
+  const float3& getPrimaryVertex() const;
+  std::array<std::vector<Cluster>, Constants::MFT::DisksNumber>& getClusters();
+  std::array<std::vector<Cell>, Constants::MFT::CellsPerRoad>& getCells();
+  std::array<std::vector<int>, Constants::MFT::CellsPerRoad - 1>& getCellsLookupTable();
+  std::array<std::vector<std::vector<int>>, Constants::MFT::CellsPerRoad - 1>& getCellsNeighbours();
+  std::vector<Road>& getRoads();
+
+  bool isClusterUsed(int disk, int clusterId) const;
+  void markUsedCluster(int disk, int clusterId);
+
+  /// index tables of the disks 1 to DisksNumber - 1, where the tracklets end
+  std::array<IndexTable, Constants::MFT::TrackletsPerRoad>& getIndexTables();
+  std::array<std::vector<Tracklet>, Constants::MFT::TrackletsPerRoad>& getTracklets();
+  std::array<std::vector<int>, Constants::MFT::CellsPerRoad>& getTrackletsLookupTable();
+
+ protected:
+  float3 mPrimaryVertex;
+  std::array<std::vector<Cluster>, Constants::MFT::DisksNumber> mClusters;
+  std::array<std::vector<bool>, Constants::MFT::DisksNumber> mUsedClusters;
+  std::array<std::vector<Cell>, Constants::MFT::CellsPerRoad> mCells;
+  std::array<std::vector<int>, Constants::MFT::CellsPerRoad - 1> mCellsLookupTable;
+  std::array<std::vector<std::vector<int>>, Constants::MFT::CellsPerRoad - 1> mCellsNeighbours;
+  std::vector<Road> mRoads;
+
+  std::array<IndexTable, Constants::MFT::TrackletsPerRoad> mIndexTables;
+  std::array<std::vector<Tracklet>, Constants::MFT::TrackletsPerRoad> mTracklets;
+  std::array<std::vector<int>, Constants::MFT::CellsPerRoad> mTrackletsLookupTable;
+};
+
+inline const float3& PrimaryVertexContext::getPrimaryVertex() const { return mPrimaryVertex; }
+
+inline std::array<std::vector<Cluster>, Constants::MFT::DisksNumber>& PrimaryVertexContext::getClusters()
+{
+  return mClusters;
+}
+
+inline std::array<std::vector<Cell>, Constants::MFT::CellsPerRoad>& PrimaryVertexContext::getCells() { return mCells; }
+
+inline std::array<std::vector<int>, Constants::MFT::CellsPerRoad - 1>& PrimaryVertexContext::getCellsLookupTable()
+{
+  return mCellsLookupTable;
+}
+
+inline std::array<std::vector<std::vector<int>>, Constants::MFT::CellsPerRoad - 1>&
+  PrimaryVertexContext::getCellsNeighbours()
+{
+  return mCellsNeighbours;
+}
+
+inline std::vector<Road>& PrimaryVertexContext::getRoads() { return mRoads; }
+
+inline bool PrimaryVertexContext::isClusterUsed(int disk, int clusterId) const
+{
+  return mUsedClusters[disk][clusterId];
+}
+
+inline void PrimaryVertexContext::markUsedCluster(int disk, int clusterId) { mUsedClusters[disk][clusterId] = true; }
+
+inline std::array<PrimaryVertexContext::IndexTable, Constants::MFT::TrackletsPerRoad>&
+  PrimaryVertexContext::getIndexTables()
+{
+  return mIndexTables;
+}
+
+inline std::array<std::vector<Tracklet>, Constants::MFT::TrackletsPerRoad>& PrimaryVertexContext::getTracklets()
+{
+  return mTracklets;
+}
+
+inline std::array<std::vector<int>, Constants::MFT::CellsPerRoad>& PrimaryVertexContext::getTrackletsLookupTable()
+{
+  return mTrackletsLookupTable;
+}
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_PRIMARYVERTEXCONTEXT_H_ */
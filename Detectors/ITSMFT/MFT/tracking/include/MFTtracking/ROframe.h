@@ -0,0 +1,129 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file ROframe.h
+/// \brief Clusters of a readout frame, per disk, and primary vertices to track from
+///
+
+#ifndef TRACKINGMFT_INCLUDE_ROframe_H_
+#define TRACKINGMFT_INCLUDE_ROframe_H_
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "MFTtracking/Cluster.h"
+#include "MFTtracking/Constants.h"
+
+#include "SimulationDataFormat/MCCompLabel.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+class ROframe final
+{
+ public:
+  ROframe(int ROframeId);
+  int getROFrameId() const;
+  const float3& getPrimaryVertex(const int) const;
+  int getPrimaryVerticesNum() const;
+  void addPrimaryVertex(const float, const float, const float);
+  int getTotalClusters() const;
+  bool hasMCinformation() const;
+
+  const std::array<std::vector<Cluster>, Constants::MFT::DisksNumber>& getClusters() const;
+  const std::vector<Cluster>& getClustersOnDisk(int diskId) const;
+  const MCCompLabel& getClusterLabels(int diskId, const int clId) const;
+  int getClusterExternalIndex(int diskId, const int clId) const;
+
+  template <typename... T>
+  void addClusterToDisk(int disk, T&&... args);
+  void addClusterLabelToDisk(int disk, const MCCompLabel label);
+  void addClusterExternalIndexToDisk(int disk, const int idx);
+  void reserveDisk(int disk, int clustersNum);
+
+  void clear();
+
+ private:
+  const int mROframeId;
+  std::vector<float3> mPrimaryVertices;
+  std::array<std::vector<Cluster>, Constants::MFT::DisksNumber> mClusters;
+  std::array<std::vector<MCCompLabel>, Constants::MFT::DisksNumber> mClusterLabels;
+  std::array<std::vector<int>, Constants::MFT::DisksNumber> mClusterExternalIndices;
+};
+
+inline int ROframe::getROFrameId() const { return mROframeId; }
+
+inline const float3& ROframe::getPrimaryVertex(const int vertexIndex) const { return mPrimaryVertices[vertexIndex]; }
+
+inline int ROframe::getPrimaryVerticesNum() const { return mPrimaryVertices.size(); }
+
+inline bool ROframe::hasMCinformation() const
+{
+  for (int iD = 0; iD < Constants::MFT::DisksNumber; ++iD) {
+    if (!mClusterLabels[iD].empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline const std::array<std::vector<Cluster>, Constants::MFT::DisksNumber>& ROframe::getClusters() const
+{
+  return mClusters;
+}
+
+inline const std::vector<Cluster>& ROframe::getClustersOnDisk(int diskId) const { return mClusters[diskId]; }
+
+inline const MCCompLabel& ROframe::getClusterLabels(int diskId, const int clId) const
+{
+  return mClusterLabels[diskId][clId];
+}
+
+inline int ROframe::getClusterExternalIndex(int diskId, const int clId) const
+{
+  return mClusterExternalIndices[diskId][clId];
+}
+
+template <typename... T>
+void ROframe::addClusterToDisk(int disk, T&&... values)
+{
+  mClusters[disk].emplace_back(std::forward<T>(values)...);
+}
+
+inline void ROframe::addClusterLabelToDisk(int disk, const MCCompLabel label) { mClusterLabels[disk].emplace_back(label); }
+
+inline void ROframe::addClusterExternalIndexToDisk(int disk, const int idx)
+{
+  mClusterExternalIndices[disk].push_back(idx);
+}
+
+inline void ROframe::reserveDisk(int disk, int clustersNum)
+{
+  mClusters[disk].reserve(clustersNum);
+  mClusterLabels[disk].reserve(clustersNum);
+  mClusterExternalIndices[disk].reserve(clustersNum);
+}
+
+inline void ROframe::clear()
+{
+  for (int iD = 0; iD < Constants::MFT::DisksNumber; ++iD) {
+    mClusters[iD].clear();
+    mClusterLabels[iD].clear();
+    mClusterExternalIndices[iD].clear();
+  }
+  mPrimaryVertices.clear();
+}
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_ROframe_H_ */
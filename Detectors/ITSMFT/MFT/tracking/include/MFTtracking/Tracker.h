@@ -0,0 +1,157 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Tracker.h
+/// \brief Cellular automaton track finder of the MFT
+///
+
+#ifndef TRACKINGMFT_INCLUDE_TRACKER_H_
+#define TRACKINGMFT_INCLUDE_TRACKER_H_
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "MFTtracking/Configuration.h"
+#include "MFTtracking/Constants.h"
+#include "MFTtracking/PrimaryVertexContext.h"
+#include "MFTtracking/ROframe.h"
+
+#include "DataFormatsMFT/TrackMFT.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+class TrackerTraits;
+
+/// The CA of the ITS tracking on the planar disks of the MFT: the tracklets join clusters of consecutive disks
+/// compatible with a straight line from the primary vertex, found with the r/phi index tables of the disks, the
+/// cells join tracklets of the same direction, the neighbour cells of similar curvature build the roads.
+/// The tracklet and cell finding are done by the traits, which implement them for a given backend.
+/// The tracks are the roads with their parameters at the innermost cluster from the helix through the first,
+/// middle and last clusters, no Kalman fit is done yet.
+class Tracker
+{
+
+ public:
+  Tracker(TrackerTraits* traits);
+
+  Tracker(const Tracker&) = delete;
+  Tracker& operator=(const Tracker&) = delete;
+  ~Tracker() = default;
+
+  void setBz(float bz);
+  float getBz() const;
+
+  std::vector<TrackMFT>& getTracks();
+  dataformats::MCTruthContainer<MCCompLabel>& getTrackLabels();
+
+  /// Tracks of the frame for each of its primary vertices, the iterations of the parameters being run one after
+  /// the other on the clusters left by the previous ones
+  void clustersToTracks(const ROframe&, std::ostream& = std::cout);
+
+  void setROFrame(std::uint32_t f) { mROFrame = f; }
+  std::uint32_t getROFrame() const { return mROFrame; }
+  void setParameters(const std::vector<TrackingParameters>&);
+
+ private:
+  track::TrackParCov buildTrackSeed(const Cluster& cluster1, const Cluster& cluster2, const Cluster& cluster3);
+  template <typename... T>
+  void initialisePrimaryVertexContext(T&&... args);
+  void computeTracklets();
+  void computeCells();
+  void findCellsNeighbours(int& iteration);
+  void findRoads(int& iteration);
+  void findTracks(const ROframe& ev, int& iteration);
+  void traverseCellsTree(const int, const int);
+  void computeTracksMClabels(const ROframe&);
+
+  template <typename... T>
+  float evaluateTask(void (Tracker::*)(T...), const char*, std::ostream& ostream, T&&... args);
+
+  TrackerTraits* mTraits = nullptr;                      /// Observer pointer, not owned by this class
+  PrimaryVertexContext* mPrimaryVertexContext = nullptr; /// Observer pointer, not owned by this class
+
+  std::vector<TrackingParameters> mTrkParams;
+
+  float mBz = 5.f;
+  std::uint32_t mROFrame = 0;
+  std::vector<TrackMFT> mTracks;
+  dataformats::MCTruthContainer<MCCompLabel> mTrackLabels;
+};
+
+inline void Tracker::setParameters(const std::vector<TrackingParameters>& trkPars)
+{
+  mTrkParams = trkPars;
+}
+
+inline float Tracker::getBz() const
+{
+  return mBz;
+}
+
+inline void Tracker::setBz(float bz)
+{
+  mBz = bz;
+}
+
+template <typename... T>
+void Tracker::initialisePrimaryVertexContext(T&&... args)
+{
+  mPrimaryVertexContext->initialise(std::forward<T>(args)...);
+}
+
+inline std::vector<TrackMFT>& Tracker::getTracks()
+{
+  return mTracks;
+}
+
+inline dataformats::MCTruthContainer<MCCompLabel>& Tracker::getTrackLabels()
+{
+  return mTrackLabels;
+}
+
+template <typename... T>
+float Tracker::evaluateTask(void (Tracker::*task)(T...), const char* taskName, std::ostream& ostream,
+                            T&&... args)
+{
+  float diff{ 0.f };
+
+  if (Constants::DoTimeBenchmarks) {
+    auto start = std::chrono::high_resolution_clock::now();
+    (this->*task)(std::forward<T>(args)...);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration<double, std::milli> diff_t{ end - start };
+    diff = diff_t.count();
+
+    if (taskName == nullptr) {
+      ostream << diff << "\t";
+    } else {
+      ostream << std::setw(2) << " - " << taskName << " completed in: " << diff << " ms" << std::endl;
+    }
+  } else {
+    (this->*task)(std::forward<T>(args)...);
+  }
+
+  return diff;
+}
+
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_TRACKER_H_ */
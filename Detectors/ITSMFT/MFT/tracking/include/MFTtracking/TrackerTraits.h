@@ -0,0 +1,76 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file TrackerTraits.h
+/// \brief Interface of the tracklet and cell finding of the MFT tracking, implemented for each backend
+///
+
+#ifndef TRACKINGMFT_INCLUDE_TRACKERTRAITS_H_
+#define TRACKINGMFT_INCLUDE_TRACKERTRAITS_H_
+
+#include "ITStracking/Definitions.h"
+#include "ITStracking/MathUtils.h"
+#include "MFTtracking/Configuration.h"
+#include "MFTtracking/Constants.h"
+#include "MFTtracking/IndexTableUtils.h"
+#include "MFTtracking/PrimaryVertexContext.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+class TrackerTraits
+{
+ public:
+  virtual ~TrackerTraits() = default;
+
+  /// r and phi bins of the next disk around the projection of a cluster, the r window being the one of the
+  /// projections on the two faces of the disk
+  GPU_DEVICE static const int4 getBinsRect(const Cluster&, const int, const float, const float, float maxdeltar,
+                                           float maxdeltaphi);
+
+  virtual void computeLayerTracklets(){};
+  virtual void computeLayerCells(){};
+
+  void UpdateTrackingParameters(const TrackingParameters& trkPar);
+  PrimaryVertexContext* getPrimaryVertexContext() { return mPrimaryVertexContext; }
+
+ protected:
+  PrimaryVertexContext* mPrimaryVertexContext;
+  TrackingParameters mTrkParams;
+};
+
+inline void TrackerTraits::UpdateTrackingParameters(const TrackingParameters& trkPar)
+{
+  mTrkParams = trkPar;
+}
+
+inline GPU_DEVICE const int4 TrackerTraits::getBinsRect(const Cluster& currentCluster, const int diskIndex,
+                                                        const float directionRIntersectionMin,
+                                                        const float directionRIntersectionMax, float maxdeltar,
+                                                        float maxdeltaphi)
+{
+  const float rRangeMin = directionRIntersectionMin - 2 * maxdeltar;
+  const float phiRangeMin = currentCluster.phiCoordinate - maxdeltaphi;
+  const float rRangeMax = directionRIntersectionMax + 2 * maxdeltar;
+  const float phiRangeMax = currentCluster.phiCoordinate + maxdeltaphi;
+
+  /// the radii out of the range of the disk are in its first or last bins, the window is never empty
+
+  return int4{ IndexTableUtils::getRBinIndex(diskIndex + 1, rRangeMin),
+               IndexTableUtils::getPhiBinIndex(o2::ITS::MathUtils::getNormalizedPhiCoordinate(phiRangeMin)),
+               IndexTableUtils::getRBinIndex(diskIndex + 1, rRangeMax),
+               IndexTableUtils::getPhiBinIndex(o2::ITS::MathUtils::getNormalizedPhiCoordinate(phiRangeMax)) };
+}
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_TRACKERTRAITS_H_ */
@@ -0,0 +1,53 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file TrackerTraitsCPU.h
+/// \brief Tracklet and cell finding of the MFT tracking on the CPU
+///
+
+#ifndef TRACKINGMFT_INCLUDE_TRACKERTRAITSCPU_H_
+#define TRACKINGMFT_INCLUDE_TRACKERTRAITSCPU_H_
+
+#include <array>
+#include <vector>
+
+#include "MFTtracking/TrackerTraits.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+class TrackerTraitsCPU : public TrackerTraits
+{
+ public:
+  TrackerTraitsCPU() { mPrimaryVertexContext = new PrimaryVertexContext; }
+  ~TrackerTraitsCPU() override { delete mPrimaryVertexContext; }
+
+  void computeLayerTracklets() final;
+  void computeLayerCells() final;
+
+  /// Number of threads used to find tracklets and cells, the work is shared among
+  /// the threads in chunks of clusters (tracklets) within and across the disks.
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+ protected:
+  void computeTrackletsInRange(int iDisk, int first, int last, std::vector<Tracklet>& tracklets);
+  void computeCellsInRange(int iDisk, int first, int last, std::vector<Cell>& cells);
+  template <typename T, size_t N, typename SizeF, typename KernelF>
+  void processLayers(int layersNum, SizeF&& layerSize, std::array<std::vector<T>, N>& output, KernelF&& kernel);
+
+  int mNThreads = 1;
+};
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_TRACKERTRAITSCPU_H_ */
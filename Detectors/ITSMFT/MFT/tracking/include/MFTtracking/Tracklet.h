@@ -0,0 +1,55 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Tracklet.h
+/// \brief Pair of clusters on consecutive disks
+///
+
+#ifndef TRACKINGMFT_INCLUDE_TRACKLET_H_
+#define TRACKINGMFT_INCLUDE_TRACKLET_H_
+
+#include "MFTtracking/Cluster.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+struct Tracklet final {
+  Tracklet();
+  GPU_DEVICE Tracklet(const int, const int, const Cluster&, const Cluster&);
+
+  const int firstClusterIndex;
+  const int secondClusterIndex;
+  const float rzSlope;       ///< dr/dz, the disks being perpendicular to the beam
+  const float phiCoordinate; ///< azimuthal direction in the transverse plane
+};
+
+inline Tracklet::Tracklet() : firstClusterIndex{ 0 }, secondClusterIndex{ 0 }, rzSlope{ 0.0f }, phiCoordinate{ 0.0f }
+{
+  // Nothing to do
+}
+
+inline GPU_DEVICE Tracklet::Tracklet(const int firstClusterOrderingIndex, const int secondClusterOrderingIndex,
+                                     const Cluster& firstCluster, const Cluster& secondCluster)
+  : firstClusterIndex{ firstClusterOrderingIndex },
+    secondClusterIndex{ secondClusterOrderingIndex },
+    rzSlope{ (firstCluster.rCoordinate - secondCluster.rCoordinate) /
+             (firstCluster.zCoordinate - secondCluster.zCoordinate) },
+    phiCoordinate{ MATH_ATAN2(firstCluster.yCoordinate - secondCluster.yCoordinate,
+                              firstCluster.xCoordinate - secondCluster.xCoordinate) }
+{
+  // Nothing to do
+}
+
+} // namespace MFT
+} // namespace o2
+
+#endif /* TRACKINGMFT_INCLUDE_TRACKLET_H_ */
@@ -0,0 +1,55 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Cluster.cxx
+/// \brief
+///
+
+#include "MFTtracking/Cluster.h"
+
+#include "ITStracking/MathUtils.h"
+#include "MFTtracking/IndexTableUtils.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+using o2::ITS::MathUtils::calculatePhiCoordinate;
+using o2::ITS::MathUtils::calculateRCoordinate;
+using o2::ITS::MathUtils::getNormalizedPhiCoordinate;
+
+Cluster::Cluster(const float x, const float y, const float z, const int index)
+  : xCoordinate{ x },
+    yCoordinate{ y },
+    zCoordinate{ z },
+    phiCoordinate{ getNormalizedPhiCoordinate(calculatePhiCoordinate(x, y)) },
+    rCoordinate{ calculateRCoordinate(x, y) },
+    clusterId{ index },
+    indexTableBinIndex{ 0 }
+{
+  // Nothing to do
+}
+
+Cluster::Cluster(const int diskIndex, const float3& primaryVertex, const Cluster& other)
+  : xCoordinate{ other.xCoordinate },
+    yCoordinate{ other.yCoordinate },
+    zCoordinate{ other.zCoordinate },
+    phiCoordinate{ getNormalizedPhiCoordinate(
+      calculatePhiCoordinate(xCoordinate - primaryVertex.x, yCoordinate - primaryVertex.y)) },
+    rCoordinate{ calculateRCoordinate(xCoordinate - primaryVertex.x, yCoordinate - primaryVertex.y) },
+    clusterId{ other.clusterId },
+    indexTableBinIndex{ IndexTableUtils::getBinIndex(IndexTableUtils::getRBinIndex(diskIndex, rCoordinate),
+                                                     IndexTableUtils::getPhiBinIndex(phiCoordinate)) }
+{
+  // Nothing to do
+}
+} // namespace MFT
+} // namespace o2
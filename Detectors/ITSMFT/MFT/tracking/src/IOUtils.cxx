@@ -0,0 +1,77 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file IOUtils.cxx
+/// \brief
+///
+
+#include "MFTtracking/IOUtils.h"
+
+#include "DataFormatsITSMFT/Cluster.h"
+#include "MathUtils/Utils.h"
+#include "MFTBase/GeometryTGeo.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+namespace
+{
+void addCluster(ROframe& event, const GeometryTGeo& geom, const itsmft::Cluster& c, const int index,
+                const dataformats::MCTruthContainer<MCCompLabel>* mcLabels)
+{
+  const int disk = geom.getDisk(c.getSensorID());
+
+  /// Clusters are stored in the tracking frame, the tracking is done in the global one
+  auto xyz = c.getXYZGlo(geom);
+  event.addClusterToDisk(disk, xyz.x(), xyz.y(), xyz.z(), event.getClustersOnDisk(disk).size());
+  if (mcLabels) {
+    event.addClusterLabelToDisk(disk, *(mcLabels->getLabels(index).begin()));
+  }
+  event.addClusterExternalIndexToDisk(disk, index);
+}
+} // namespace
+
+void IOUtils::loadEventData(ROframe& event, gsl::span<const itsmft::Cluster> clusters,
+                            const dataformats::MCTruthContainer<MCCompLabel>* mcLabels)
+{
+  event.clear();
+  GeometryTGeo* geom = GeometryTGeo::Instance();
+  geom->fillMatrixCache(utils::bit2Mask(TransformType::T2G));
+
+  for (int iCluster{ 0 }; iCluster < static_cast<int>(clusters.size()); ++iCluster) {
+    addCluster(event, *geom, clusters[iCluster], iCluster, mcLabels);
+  }
+}
+
+int IOUtils::loadROFrameData(std::uint32_t roFrame, ROframe& event, gsl::span<const itsmft::Cluster> clusters,
+                             const dataformats::MCTruthContainer<MCCompLabel>* mcLabels)
+{
+  event.clear();
+  GeometryTGeo* geom = GeometryTGeo::Instance();
+  geom->fillMatrixCache(utils::bit2Mask(TransformType::T2G));
+  int clustersNum{ 0 };
+
+  for (int iCluster{ 0 }; iCluster < static_cast<int>(clusters.size()); ++iCluster) {
+    const auto& c = clusters[iCluster];
+    if (c.getROFrame() != roFrame) {
+      continue;
+    }
+    addCluster(event, *geom, c, iCluster, mcLabels);
+    ++clustersNum;
+  }
+  return clustersNum;
+}
+
+} // namespace MFT
+} // namespace o2
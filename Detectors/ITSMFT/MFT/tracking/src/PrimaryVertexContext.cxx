@@ -0,0 +1,88 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file PrimaryVertexContext.cxx
+/// \brief
+///
+
+#include "MFTtracking/PrimaryVertexContext.h"
+
+#include <algorithm>
+
+namespace o2
+{
+namespace MFT
+{
+
+void PrimaryVertexContext::initialise(const std::array<std::vector<Cluster>, Constants::MFT::DisksNumber>& cl,
+                                      const std::array<float, 3>& pVtx, const int iteration)
+{
+  mPrimaryVertex = { pVtx[0], pVtx[1], pVtx[2] };
+
+  for (int iDisk{ 0 }; iDisk < Constants::MFT::DisksNumber; ++iDisk) {
+
+    const auto& currentDisk{ cl[iDisk] };
+    const int clustersNum{ static_cast<int>(currentDisk.size()) };
+
+    if (iteration == 0) {
+      mClusters[iDisk].clear();
+      mClusters[iDisk].reserve(clustersNum);
+      mUsedClusters[iDisk].clear();
+      mUsedClusters[iDisk].resize(clustersNum, false);
+
+      for (int iCluster{ 0 }; iCluster < clustersNum; ++iCluster) {
+        mClusters[iDisk].emplace_back(iDisk, mPrimaryVertex, currentDisk[iCluster]);
+      }
+
+      std::sort(mClusters[iDisk].begin(), mClusters[iDisk].end(), [](const Cluster& cluster1, const Cluster& cluster2) {
+        return cluster1.indexTableBinIndex < cluster2.indexTableBinIndex ||
+               (cluster1.indexTableBinIndex == cluster2.indexTableBinIndex && cluster1.clusterId < cluster2.clusterId);
+      });
+
+      /// the index table of a disk points to the first cluster of each bin
+      if (iDisk > 0) {
+        auto& indexTable = mIndexTables[iDisk - 1];
+        indexTable.fill(0);
+        for (const auto& cluster : mClusters[iDisk]) {
+          ++indexTable[cluster.indexTableBinIndex + 1];
+        }
+        for (size_t iBin{ 1 }; iBin < indexTable.size(); ++iBin) {
+          indexTable[iBin] += indexTable[iBin - 1];
+        }
+      }
+    }
+
+    if (iDisk < Constants::MFT::TrackletsPerRoad) {
+      mTracklets[iDisk].clear();
+      mTracklets[iDisk].reserve(std::max(cl[iDisk].size(), cl[iDisk + 1].size()));
+    }
+
+    if (iDisk < Constants::MFT::CellsPerRoad) {
+      mTrackletsLookupTable[iDisk].clear();
+      mTrackletsLookupTable[iDisk].resize(cl[iDisk + 1].size(), Constants::MFT::UnusedIndex);
+      mCells[iDisk].clear();
+    }
+
+    if (iDisk < Constants::MFT::CellsPerRoad - 1) {
+      /// sized by the tracklets of the next disk in the cell finding
+      mCellsLookupTable[iDisk].clear();
+
+      // the neighbour lists are cleared but kept with their capacity for the next frames
+      for (auto& neighbours : mCellsNeighbours[iDisk]) {
+        neighbours.clear();
+      }
+    }
+  }
+
+  mRoads.clear();
+}
+
+} // namespace MFT
+} // namespace o2
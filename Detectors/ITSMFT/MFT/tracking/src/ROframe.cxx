@@ -0,0 +1,39 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file ROframe.cxx
+/// \brief
+///
+
+#include "MFTtracking/ROframe.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+ROframe::ROframe(const int ROframeId) : mROframeId{ ROframeId }
+{
+}
+
+void ROframe::addPrimaryVertex(const float xCoordinate, const float yCoordinate, const float zCoordinate)
+{
+  mPrimaryVertices.emplace_back(float3{ xCoordinate, yCoordinate, zCoordinate });
+}
+
+int ROframe::getTotalClusters() const
+{
+  size_t totalClusters{ 0 };
+  for (auto& clusters : mClusters)
+    totalClusters += clusters.size();
+  return int(totalClusters);
+}
+} // namespace MFT
+} // namespace o2
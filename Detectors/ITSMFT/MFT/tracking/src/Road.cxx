@@ -0,0 +1,42 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Road.cxx
+/// \brief
+///
+
+#include "MFTtracking/Road.h"
+
+namespace o2
+{
+namespace MFT
+{
+
+Road::Road() : mCellIds{}, mRoadSize{}, mLabel{ Constants::MFT::UnusedIndex }, mIsFakeRoad{} { resetRoad(); }
+
+Road::Road(int cellDisk, int cellId) : Road() { addCell(cellDisk, cellId); }
+
+void Road::resetRoad()
+{
+  mCellIds.fill(Constants::MFT::UnusedIndex);
+  mRoadSize = 0;
+}
+
+void Road::addCell(int cellDisk, int cellId)
+{
+  if (mCellIds[cellDisk] == Constants::MFT::UnusedIndex) {
+
+    ++mRoadSize;
+  }
+
+  mCellIds[cellDisk] = cellId;
+}
+} // namespace MFT
+} // namespace o2
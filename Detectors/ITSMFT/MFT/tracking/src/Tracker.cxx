@@ -0,0 +1,411 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Tracker.cxx
+/// \brief
+///
+
+#include "MFTtracking/Tracker.h"
+
+#include "CommonConstants/MathConstants.h"
+#include "ITStracking/MathUtils.h"
+#include "MFTtracking/Cell.h"
+#include "MFTtracking/Constants.h"
+#include "MFTtracking/TrackerTraits.h"
+#include "MFTtracking/Tracklet.h"
+
+#include "ReconstructionDataFormats/Track.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace o2
+{
+namespace MFT
+{
+
+using o2::ITS::MathUtils::computeCurvature;
+using o2::ITS::MathUtils::computeCurvatureCentreX;
+using o2::ITS::MathUtils::computeTanDipAngle;
+
+Tracker::Tracker(TrackerTraits* traits)
+{
+  /// Initialise standard configuration with 1 iteration
+  mTrkParams.resize(1);
+  assert(traits != nullptr);
+  mTraits = traits;
+  mPrimaryVertexContext = mTraits->getPrimaryVertexContext();
+}
+
+void Tracker::clustersToTracks(const ROframe& event, std::ostream& timeBenchmarkOutputStream)
+{
+  const int verticesNum = event.getPrimaryVerticesNum();
+  mTracks.clear();
+  mTrackLabels.clear();
+
+  for (int iVertex = 0; iVertex < verticesNum; ++iVertex) {
+
+    float total{ 0.f };
+
+    for (int iteration = 0; iteration < static_cast<int>(mTrkParams.size()); ++iteration) {
+      mTraits->UpdateTrackingParameters(mTrkParams[iteration]);
+      std::array<float, 3> pV = { event.getPrimaryVertex(iVertex).x, event.getPrimaryVertex(iVertex).y,
+                                  event.getPrimaryVertex(iVertex).z };
+      total += evaluateTask(&Tracker::initialisePrimaryVertexContext, "Context initialisation",
+                            timeBenchmarkOutputStream, event.getClusters(), pV, iteration);
+      total += evaluateTask(&Tracker::computeTracklets, "Tracklet finding", timeBenchmarkOutputStream);
+      total += evaluateTask(&Tracker::computeCells, "Cell finding", timeBenchmarkOutputStream);
+      total += evaluateTask(&Tracker::findCellsNeighbours, "Neighbour finding", timeBenchmarkOutputStream, iteration);
+      total += evaluateTask(&Tracker::findRoads, "Road finding", timeBenchmarkOutputStream, iteration);
+      total += evaluateTask(&Tracker::findTracks, "Track finding", timeBenchmarkOutputStream, event, iteration);
+    }
+
+    if (Constants::DoTimeBenchmarks)
+      timeBenchmarkOutputStream << std::setw(2) << " - "
+                                << "Vertex processing completed in: " << total << "ms" << std::endl;
+  }
+  computeTracksMClabels(event);
+}
+
+void Tracker::computeTracklets()
+{
+  mTraits->computeLayerTracklets();
+}
+
+void Tracker::computeCells()
+{
+  mTraits->computeLayerCells();
+}
+
+void Tracker::findCellsNeighbours(int& iteration)
+{
+  for (int iDisk{ 0 }; iDisk < Constants::MFT::CellsPerRoad - 1; ++iDisk) {
+
+    /// every cell of the next disk has its list, the roads look them up for all the cells
+    auto& diskNeighbours = mPrimaryVertexContext->getCellsNeighbours()[iDisk];
+    const int nextDiskCellsNum{ static_cast<int>(mPrimaryVertexContext->getCells()[iDisk + 1].size()) };
+    if (static_cast<int>(diskNeighbours.size()) < nextDiskCellsNum) {
+      diskNeighbours.resize(nextDiskCellsNum); // the lists of the previous frames are kept, cleared
+    }
+
+    if (mPrimaryVertexContext->getCells()[iDisk + 1].empty() ||
+        mPrimaryVertexContext->getCellsLookupTable()[iDisk].empty()) {
+      continue;
+    }
+
+    const int diskCellsNum{ static_cast<int>(mPrimaryVertexContext->getCells()[iDisk].size()) };
+
+    for (int iCell{ 0 }; iCell < diskCellsNum; ++iCell) {
+
+      const Cell& currentCell{ mPrimaryVertexContext->getCells()[iDisk][iCell] };
+      const int nextDiskTrackletIndex{ currentCell.getSecondTrackletIndex() };
+      const int nextDiskFirstCellIndex{ mPrimaryVertexContext->getCellsLookupTable()[iDisk][nextDiskTrackletIndex] };
+
+      if (nextDiskFirstCellIndex == Constants::MFT::UnusedIndex) {
+        continue;
+      }
+
+      for (int iNextDiskCell{ nextDiskFirstCellIndex };
+           iNextDiskCell < nextDiskCellsNum &&
+           mPrimaryVertexContext->getCells()[iDisk + 1][iNextDiskCell].getFirstTrackletIndex() ==
+             nextDiskTrackletIndex;
+           ++iNextDiskCell) {
+
+        Cell& nextCell{ mPrimaryVertexContext->getCells()[iDisk + 1][iNextDiskCell] };
+        const float deltaCurvature{ std::abs(currentCell.getCurvature() - nextCell.getCurvature()) };
+        const float deltaRZSlope{ std::abs(currentCell.getRZSlope() - nextCell.getRZSlope()) };
+
+        if (deltaCurvature < mTrkParams[iteration].NeighbourMaxDeltaCurvature[iDisk] &&
+            deltaRZSlope < mTrkParams[iteration].NeighbourMaxDeltaRZSlope[iDisk]) {
+
+          diskNeighbours[iNextDiskCell].push_back(iCell);
+
+          const int currentCellLevel{ currentCell.getLevel() };
+
+          if (currentCellLevel >= nextCell.getLevel()) {
+
+            nextCell.setLevel(currentCellLevel + 1);
+          }
+        }
+      }
+    }
+  }
+}
+
+void Tracker::findRoads(int& iteration)
+{
+  for (int iLevel{ Constants::MFT::CellsPerRoad }; iLevel >= mTrkParams[iteration].CellMinimumLevel(); --iLevel) {
+
+    const int minimumLevel{ iLevel - 1 };
+
+    for (int iDisk{ Constants::MFT::CellsPerRoad - 1 }; iDisk >= minimumLevel; --iDisk) {
+
+      const int levelCellsNum{ static_cast<int>(mPrimaryVertexContext->getCells()[iDisk].size()) };
+
+      for (int iCell{ 0 }; iCell < levelCellsNum; ++iCell) {
+
+        const Cell& currentCell{ mPrimaryVertexContext->getCells()[iDisk][iCell] };
+
+        if (currentCell.getLevel() != iLevel) {
+
+          continue;
+        }
+
+        mPrimaryVertexContext->getRoads().emplace_back(iDisk, iCell);
+
+        /// the cells of the first disk have no neighbours, they are the roads of a single cell
+        if (iDisk == 0) {
+          continue;
+        }
+
+        const int cellNeighboursNum{ static_cast<int>(
+          mPrimaryVertexContext->getCellsNeighbours()[iDisk - 1][iCell].size()) };
+        bool isFirstValidNeighbour = true;
+
+        for (int iNeighbourCell{ 0 }; iNeighbourCell < cellNeighboursNum; ++iNeighbourCell) {
+
+          const int neighbourCellId = mPrimaryVertexContext->getCellsNeighbours()[iDisk - 1][iCell][iNeighbourCell];
+          const Cell& neighbourCell = mPrimaryVertexContext->getCells()[iDisk - 1][neighbourCellId];
+
+          if (iLevel - 1 != neighbourCell.getLevel()) {
+            continue;
+          }
+
+          if (isFirstValidNeighbour) {
+
+            isFirstValidNeighbour = false;
+
+          } else {
+
+            mPrimaryVertexContext->getRoads().emplace_back(iDisk, iCell);
+          }
+
+          traverseCellsTree(neighbourCellId, iDisk - 1);
+        }
+      }
+    }
+  }
+}
+
+void Tracker::findTracks(const ROframe& event, int& iteration)
+{
+  std::vector<TrackMFT> tracks;
+  tracks.reserve(mPrimaryVertexContext->getRoads().size());
+
+  for (auto& road : mPrimaryVertexContext->getRoads()) {
+    std::array<int, Constants::MFT::DisksNumber> clusters;
+    clusters.fill(Constants::MFT::UnusedIndex);
+    int firstCellDisk{ Constants::MFT::UnusedIndex };
+    int lastCellDisk{ Constants::MFT::UnusedIndex };
+
+    for (int iCell{ 0 }; iCell < Constants::MFT::CellsPerRoad; ++iCell) {
+      const int cellIndex = road[iCell];
+      if (cellIndex == Constants::MFT::UnusedIndex) {
+        continue;
+      }
+      const Cell& cell{ mPrimaryVertexContext->getCells()[iCell][cellIndex] };
+      clusters[iCell] = cell.getFirstClusterIndex();
+      clusters[iCell + 1] = cell.getSecondClusterIndex();
+      clusters[iCell + 2] = cell.getThirdClusterIndex();
+      if (firstCellDisk == Constants::MFT::UnusedIndex) {
+        firstCellDisk = iCell;
+      }
+      lastCellDisk = iCell;
+    }
+
+    if (lastCellDisk == Constants::MFT::UnusedIndex) {
+      continue;
+    }
+
+    /// From primary vertex context index to event index (== the one used as input of the tracking code)
+    for (int iD{ 0 }; iD < Constants::MFT::DisksNumber; ++iD) {
+      if (clusters[iD] != Constants::MFT::UnusedIndex) {
+        clusters[iD] = mPrimaryVertexContext->getClusters()[iD][clusters[iD]].clusterId;
+      }
+    }
+
+    /// the disks of a road are consecutive: the seed goes through the outermost, a middle and the innermost cluster
+    const int firstDisk{ firstCellDisk };
+    const int lastDisk{ lastCellDisk + 2 };
+    const int middleDisk{ (firstDisk + lastDisk) / 2 };
+
+    const Cluster& cluster1 = event.getClustersOnDisk(lastDisk)[clusters[lastDisk]];
+    const Cluster& cluster2 = event.getClustersOnDisk(middleDisk)[clusters[middleDisk]];
+    const Cluster& cluster3 = event.getClustersOnDisk(firstDisk)[clusters[firstDisk]];
+
+    TrackMFT temporaryTrack{ buildTrackSeed(cluster1, cluster2, cluster3) };
+    for (int iD{ 0 }; iD < Constants::MFT::DisksNumber; ++iD) {
+      if (clusters[iD] != Constants::MFT::UnusedIndex) {
+        temporaryTrack.setExternalClusterIndex(iD, clusters[iD], true);
+      }
+    }
+    temporaryTrack.setROFrame(mROFrame);
+    tracks.emplace_back(std::move(temporaryTrack));
+  }
+
+  /// the longest candidates first, the order of the roads is kept among the ones of a given length
+  std::stable_sort(tracks.begin(), tracks.end(), [](const TrackMFT& track1, const TrackMFT& track2) {
+    return track1.getNumberOfClusters() > track2.getNumberOfClusters();
+  });
+
+  for (auto& track : tracks) {
+    int nShared{ 0 };
+    for (int iD{ 0 }; iD < Constants::MFT::DisksNumber; ++iD) {
+      const int index = track.getClusterIndex(iD);
+      if (index == Constants::MFT::UnusedIndex) {
+        continue;
+      }
+      nShared += static_cast<int>(mPrimaryVertexContext->isClusterUsed(iD, index));
+    }
+
+    if (nShared > mTrkParams[iteration].ClusterSharing) {
+      continue;
+    }
+
+    for (int iD{ 0 }; iD < Constants::MFT::DisksNumber; ++iD) {
+      const int index = track.getClusterIndex(iD);
+      if (index == Constants::MFT::UnusedIndex) {
+        continue;
+      }
+      mPrimaryVertexContext->markUsedCluster(iD, index);
+    }
+    mTracks.emplace_back(track);
+  }
+}
+
+void Tracker::traverseCellsTree(const int currentCellId, const int currentDiskId)
+{
+  const Cell& currentCell{ mPrimaryVertexContext->getCells()[currentDiskId][currentCellId] };
+  const int currentCellLevel = currentCell.getLevel();
+
+  mPrimaryVertexContext->getRoads().back().addCell(currentDiskId, currentCellId);
+
+  if (currentDiskId > 0) {
+
+    const int cellNeighboursNum{ static_cast<int>(
+      mPrimaryVertexContext->getCellsNeighbours()[currentDiskId - 1][currentCellId].size()) };
+    bool isFirstValidNeighbour = true;
+
+    for (int iNeighbourCell{ 0 }; iNeighbourCell < cellNeighboursNum; ++iNeighbourCell) {
+
+      const int neighbourCellId =
+        mPrimaryVertexContext->getCellsNeighbours()[currentDiskId - 1][currentCellId][iNeighbourCell];
+      const Cell& neighbourCell = mPrimaryVertexContext->getCells()[currentDiskId - 1][neighbourCellId];
+
+      if (currentCellLevel - 1 != neighbourCell.getLevel()) {
+        continue;
+      }
+
+      if (isFirstValidNeighbour) {
+        isFirstValidNeighbour = false;
+      } else {
+        mPrimaryVertexContext->getRoads().push_back(mPrimaryVertexContext->getRoads().back());
+      }
+
+      traverseCellsTree(neighbourCellId, currentDiskId - 1);
+    }
+  }
+}
+
+void Tracker::computeTracksMClabels(const ROframe& event)
+{
+  /// Moore's Voting Algorithm
+  const bool hasMCinformation{ event.hasMCinformation() };
+
+  for (TrackMFT& track : mTracks) {
+
+    MCCompLabel maxOccurrencesValue{ Constants::MFT::UnusedIndex, Constants::MFT::UnusedIndex,
+                                     Constants::MFT::UnusedIndex };
+    int count{ 0 };
+    bool isFakeTrack{ false };
+
+    for (int iCluster = 0; iCluster < TrackMFT::MaxClusters; ++iCluster) {
+      const int index = track.getClusterIndex(iCluster);
+      if (index == Constants::MFT::UnusedIndex) {
+        continue;
+      }
+
+      if (hasMCinformation) {
+        const MCCompLabel& currentLabel = event.getClusterLabels(iCluster, index);
+        if (currentLabel == maxOccurrencesValue) {
+          ++count;
+        } else {
+          if (count != 0) { // only in the first iteration count can be 0 at this point
+            isFakeTrack = true;
+            --count;
+          }
+          if (count == 0) {
+            maxOccurrencesValue = currentLabel;
+            count = 1;
+          }
+        }
+      }
+
+      track.setExternalClusterIndex(iCluster, event.getClusterExternalIndex(iCluster, index));
+    }
+
+    if (!hasMCinformation) {
+      continue;
+    }
+
+    if (isFakeTrack)
+      maxOccurrencesValue.set(-maxOccurrencesValue.getTrackID(), maxOccurrencesValue.getEventID(),
+                              maxOccurrencesValue.getSourceID());
+    mTrackLabels.addElement(mTrackLabels.getIndexedSize(), maxOccurrencesValue);
+  }
+}
+
+/// Clusters are given from outside inward (cluster1 is the outermost), in the global frame. The parameters are the
+/// ones at the innermost cluster, in the frame rotated along the direction of the track in the transverse plane
+track::TrackParCov Tracker::buildTrackSeed(const Cluster& cluster1, const Cluster& cluster2, const Cluster& cluster3)
+{
+  const float alpha = std::atan2(cluster1.yCoordinate - cluster3.yCoordinate,
+                                 cluster1.xCoordinate - cluster3.xCoordinate);
+  const float ca = std::cos(alpha), sa = std::sin(alpha);
+  const float x1 = cluster1.xCoordinate * ca + cluster1.yCoordinate * sa;
+  const float y1 = -cluster1.xCoordinate * sa + cluster1.yCoordinate * ca;
+  const float z1 = cluster1.zCoordinate;
+  const float x2 = cluster2.xCoordinate * ca + cluster2.yCoordinate * sa;
+  const float y2 = -cluster2.xCoordinate * sa + cluster2.yCoordinate * ca;
+  const float z2 = cluster2.zCoordinate;
+  const float x3 = cluster3.xCoordinate * ca + cluster3.yCoordinate * sa;
+  const float y3 = -cluster3.xCoordinate * sa + cluster3.yCoordinate * ca;
+  const float z3 = cluster3.zCoordinate;
+
+  /// three aligned clusters give no curvature, the track is then straight along the x axis of the frame
+  float crv = computeCurvature(x1, y1, x2, y2, x3, y3);
+  float snp = crv * (x3 - computeCurvatureCentreX(x1, y1, x2, y2, x3, y3));
+  if (!std::isfinite(crv) || !std::isfinite(snp)) {
+    crv = 0.f;
+    snp = 0.f;
+  }
+  const float tgl12 = computeTanDipAngle(x1, y1, x2, y2, z1, z2);
+  const float tgl23 = computeTanDipAngle(x2, y2, x3, y3, z2, z3);
+
+  const float fy = 1. / std::hypot(x1 - x3, y1 - y3);
+  const float& tz = fy;
+  float cy = (computeCurvature(x1, y1, x2, y2 + Constants::MFT::Resolution, x3, y3) - crv) /
+             (Constants::MFT::Resolution * getBz() * constants::math::B2C);
+  if (!std::isfinite(cy)) {
+    cy = 0.f;
+  }
+  constexpr float s2 = Constants::MFT::Resolution * Constants::MFT::Resolution;
+
+  return track::TrackParCov(x3, alpha,
+                            { y3, z3, snp, 0.5f * (tgl12 + tgl23),
+                              std::abs(getBz()) < constants::math::Almost0 ? constants::math::Almost0
+                                                                           : crv / (getBz() * constants::math::B2C) },
+                            { s2, 0.f, s2, s2 * fy, 0.f, s2 * fy * fy, 0.f, s2 * tz, 0.f, s2 * tz * tz, s2 * cy, 0.f,
+                              s2 * fy * cy, 0.f, s2 * cy * cy });
+}
+
+} // namespace MFT
+} // namespace o2
@@ -0,0 +1,270 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file TrackerTraitsCPU.cxx
+/// \brief
+///
+
+#include "MFTtracking/TrackerTraitsCPU.h"
+
+#include "ITStracking/MathUtils.h"
+#include "MFTtracking/Cell.h"
+#include "MFTtracking/Constants.h"
+#include "MFTtracking/IndexTableUtils.h"
+#include "MFTtracking/Tracklet.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace o2
+{
+namespace MFT
+{
+
+void TrackerTraitsCPU::computeLayerTracklets()
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  int disksNum{ 0 };
+  while (disksNum < Constants::MFT::TrackletsPerRoad && !primaryVertexContext->getClusters()[disksNum].empty() &&
+         !primaryVertexContext->getClusters()[disksNum + 1].empty()) {
+    ++disksNum;
+  }
+
+  processLayers(disksNum, [primaryVertexContext](int iDisk) { return primaryVertexContext->getClusters()[iDisk].size(); },
+                primaryVertexContext->getTracklets(),
+                [this](int iDisk, int first, int last, std::vector<Tracklet>& tracklets) {
+                  computeTrackletsInRange(iDisk, first, last, tracklets);
+                });
+
+  /// the lookup tables point to the first tracklet starting from a given cluster, since the tracklets are
+  /// ordered by their first cluster they can be filled after the tracklet finding
+  for (int iDisk{ 1 }; iDisk < disksNum; ++iDisk) {
+    auto& lookupTable = primaryVertexContext->getTrackletsLookupTable()[iDisk - 1];
+    const auto& tracklets = primaryVertexContext->getTracklets()[iDisk];
+    for (int iTracklet{ 0 }; iTracklet < static_cast<int>(tracklets.size()); ++iTracklet) {
+      if (lookupTable[tracklets[iTracklet].firstClusterIndex] == Constants::MFT::UnusedIndex) {
+        lookupTable[tracklets[iTracklet].firstClusterIndex] = iTracklet;
+      }
+    }
+  }
+}
+
+void TrackerTraitsCPU::computeTrackletsInRange(int iDisk, int first, int last, std::vector<Tracklet>& tracklets)
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
+  const auto& nextDiskClusters = primaryVertexContext->getClusters()[iDisk + 1];
+  const auto& nextIndexTable = primaryVertexContext->getIndexTables()[iDisk];
+  const float nextDiskZMin{ Constants::MFT::LayersZCoordinate()[2 * iDisk + 2] - primaryVertex.z };
+  const float nextDiskZMax{ Constants::MFT::LayersZCoordinate()[2 * iDisk + 3] - primaryVertex.z };
+  const float maxDeltaR{ mTrkParams.TrackletMaxDeltaR[iDisk] };
+  const float maxDeltaPhi{ mTrkParams.TrackletMaxDeltaPhi };
+
+  for (int iCluster{ first }; iCluster < last; ++iCluster) {
+    const Cluster& currentCluster{ primaryVertexContext->getClusters()[iDisk][iCluster] };
+
+    if (primaryVertexContext->isClusterUsed(iDisk, currentCluster.clusterId)) {
+      continue;
+    }
+
+    /// straight line from the primary vertex through the cluster: r scales with the distance in z to the vertex
+    const float rOverZ{ currentCluster.rCoordinate / (currentCluster.zCoordinate - primaryVertex.z) };
+    const float directionRIntersectionMin{ rOverZ * nextDiskZMin };
+    const float directionRIntersectionMax{ rOverZ * nextDiskZMax };
+
+    const int4 selectedBinsRect{ getBinsRect(currentCluster, iDisk, MATH_MIN(directionRIntersectionMin, directionRIntersectionMax),
+                                             MATH_MAX(directionRIntersectionMin, directionRIntersectionMax), maxDeltaR,
+                                             maxDeltaPhi) };
+
+    int phiBinsNum{ selectedBinsRect.w - selectedBinsRect.y + 1 };
+
+    if (phiBinsNum < 0) {
+      phiBinsNum += Constants::IndexTable::PhiBins;
+    }
+
+    for (int iPhiBin{ selectedBinsRect.y }, iPhiCount{ 0 }; iPhiCount < phiBinsNum;
+         iPhiBin = ++iPhiBin == Constants::IndexTable::PhiBins ? 0 : iPhiBin, iPhiCount++) {
+
+      /// the r bins of a phi row are contiguous in the index table
+      const int firstBinIndex{ IndexTableUtils::getBinIndex(selectedBinsRect.x, iPhiBin) };
+      const int maxBinIndex{ firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1 };
+      const int firstRowClusterIndex = nextIndexTable[firstBinIndex];
+      const int maxRowClusterIndex = nextIndexTable[maxBinIndex];
+
+      for (int iNextDiskCluster{ firstRowClusterIndex }; iNextDiskCluster < maxRowClusterIndex; ++iNextDiskCluster) {
+
+        const Cluster& nextCluster{ nextDiskClusters[iNextDiskCluster] };
+
+        if (primaryVertexContext->isClusterUsed(iDisk + 1, nextCluster.clusterId)) {
+          continue;
+        }
+
+        const float deltaR{ MATH_ABS(rOverZ * (nextCluster.zCoordinate - primaryVertex.z) - nextCluster.rCoordinate) };
+        const float deltaPhi{ MATH_ABS(currentCluster.phiCoordinate - nextCluster.phiCoordinate) };
+
+        if (deltaR < maxDeltaR &&
+            (deltaPhi < maxDeltaPhi || MATH_ABS(deltaPhi - Constants::Math::TwoPi) < maxDeltaPhi)) {
+
+          tracklets.emplace_back(iCluster, iNextDiskCluster, currentCluster, nextCluster);
+        }
+      }
+    }
+  }
+}
+
+void TrackerTraitsCPU::computeLayerCells()
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  int disksNum{ 0 };
+  while (disksNum < Constants::MFT::CellsPerRoad && !primaryVertexContext->getTracklets()[disksNum].empty() &&
+         !primaryVertexContext->getTracklets()[disksNum + 1].empty()) {
+    ++disksNum;
+  }
+
+  processLayers(disksNum, [primaryVertexContext](int iDisk) { return primaryVertexContext->getTracklets()[iDisk].size(); },
+                primaryVertexContext->getCells(),
+                [this](int iDisk, int first, int last, std::vector<Cell>& cells) {
+                  computeCellsInRange(iDisk, first, last, cells);
+                });
+
+  /// the cells are ordered by their first tracklet, the lookup tables are filled after the cell finding
+  for (int iDisk{ 1 }; iDisk < disksNum; ++iDisk) {
+    auto& lookupTable = primaryVertexContext->getCellsLookupTable()[iDisk - 1];
+    const auto& cells = primaryVertexContext->getCells()[iDisk];
+    lookupTable.assign(primaryVertexContext->getTracklets()[iDisk].size(), Constants::MFT::UnusedIndex);
+    for (int iCell{ 0 }; iCell < static_cast<int>(cells.size()); ++iCell) {
+      if (lookupTable[cells[iCell].getFirstTrackletIndex()] == Constants::MFT::UnusedIndex) {
+        lookupTable[cells[iCell].getFirstTrackletIndex()] = iCell;
+      }
+    }
+  }
+}
+
+void TrackerTraitsCPU::computeCellsInRange(int iDisk, int first, int last, std::vector<Cell>& cells)
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
+  const auto& tracklets = primaryVertexContext->getTracklets()[iDisk];
+  const auto& nextDiskTracklets = primaryVertexContext->getTracklets()[iDisk + 1];
+  const int nextDiskTrackletsNum{ static_cast<int>(nextDiskTracklets.size()) };
+
+  for (int iTracklet{ first }; iTracklet < last; ++iTracklet) {
+
+    const Tracklet& currentTracklet{ tracklets[iTracklet] };
+    const int nextDiskClusterIndex{ currentTracklet.secondClusterIndex };
+    const int nextDiskFirstTrackletIndex{ primaryVertexContext->getTrackletsLookupTable()[iDisk][nextDiskClusterIndex] };
+
+    if (nextDiskFirstTrackletIndex == Constants::MFT::UnusedIndex) {
+      continue;
+    }
+
+    const Cluster& firstCellCluster{ primaryVertexContext->getClusters()[iDisk][currentTracklet.firstClusterIndex] };
+    const Cluster& secondCellCluster{ primaryVertexContext->getClusters()[iDisk + 1][nextDiskClusterIndex] };
+
+    for (int iNextDiskTracklet{ nextDiskFirstTrackletIndex };
+         iNextDiskTracklet < nextDiskTrackletsNum &&
+         nextDiskTracklets[iNextDiskTracklet].firstClusterIndex == nextDiskClusterIndex;
+         ++iNextDiskTracklet) {
+
+      const Tracklet& nextTracklet{ nextDiskTracklets[iNextDiskTracklet] };
+      const float deltaRZSlope{ MATH_ABS(currentTracklet.rzSlope - nextTracklet.rzSlope) };
+      const float deltaPhi{ MATH_ABS(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate) };
+
+      if (deltaRZSlope > mTrkParams.CellMaxDeltaRZSlope ||
+          (deltaPhi > mTrkParams.CellMaxDeltaPhi &&
+           MATH_ABS(deltaPhi - Constants::Math::TwoPi) > mTrkParams.CellMaxDeltaPhi)) {
+        continue;
+      }
+
+      const Cluster& thirdCellCluster{ primaryVertexContext->getClusters()[iDisk + 2][nextTracklet.secondClusterIndex] };
+
+      /// distance to the primary vertex in the transverse plane of the line through the outer clusters
+      const float inverseDeltaZ{ 1.f / (thirdCellCluster.zCoordinate - firstCellCluster.zCoordinate) };
+      const float vertexDeltaZ{ primaryVertex.z - firstCellCluster.zCoordinate };
+      const float deltaX{ firstCellCluster.xCoordinate - primaryVertex.x +
+                          (thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate) * inverseDeltaZ * vertexDeltaZ };
+      const float deltaY{ firstCellCluster.yCoordinate - primaryVertex.y +
+                          (thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate) * inverseDeltaZ * vertexDeltaZ };
+
+      if (deltaX * deltaX + deltaY * deltaY > mTrkParams.CellMaxDCA[iDisk] * mTrkParams.CellMaxDCA[iDisk]) {
+        continue;
+      }
+
+      float curvature{ o2::ITS::MathUtils::computeCurvature(
+        thirdCellCluster.xCoordinate, thirdCellCluster.yCoordinate, secondCellCluster.xCoordinate,
+        secondCellCluster.yCoordinate, firstCellCluster.xCoordinate, firstCellCluster.yCoordinate) };
+      if (!std::isfinite(curvature)) {
+        curvature = 0.f;
+      }
+
+      cells.emplace_back(currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex,
+                         nextTracklet.secondClusterIndex, iTracklet, iNextDiskTracklet, curvature,
+                         0.5f * (currentTracklet.rzSlope + nextTracklet.rzSlope));
+    }
+  }
+}
+
+template <typename T, size_t N, typename SizeF, typename KernelF>
+void TrackerTraitsCPU::processLayers(int layersNum, SizeF&& layerSize, std::array<std::vector<T>, N>& output,
+                                     KernelF&& kernel)
+{
+  if (mNThreads <= 1) {
+    for (int iLayer{ 0 }; iLayer < layersNum; ++iLayer) {
+      kernel(iLayer, 0, static_cast<int>(layerSize(iLayer)), output[iLayer]);
+    }
+    return;
+  }
+
+  /// Each disk is split in chunks of consecutive input objects, the chunks are processed
+  /// concurrently into separate buffers and concatenated in order afterwards. The result
+  /// is therefore identical to the sequential processing.
+  struct Chunk {
+    int layer;
+    int first;
+    int last;
+    std::vector<T> result;
+  };
+  std::vector<Chunk> chunks;
+  for (int iLayer{ 0 }; iLayer < layersNum; ++iLayer) {
+    const int size{ static_cast<int>(layerSize(iLayer)) };
+    const int chunkSize{ std::max(1, (size + mNThreads - 1) / mNThreads) };
+    for (int first{ 0 }; first < size; first += chunkSize) {
+      chunks.push_back(Chunk{ iLayer, first, std::min(first + chunkSize, size), {} });
+    }
+  }
+
+  std::atomic<size_t> nextChunk{ 0 };
+  auto worker = [&chunks, &nextChunk, &kernel]() {
+    for (size_t iChunk = nextChunk++; iChunk < chunks.size(); iChunk = nextChunk++) {
+      auto& chunk = chunks[iChunk];
+      kernel(chunk.layer, chunk.first, chunk.last, chunk.result);
+    }
+  };
+  std::vector<std::thread> threads;
+  const int threadsNum{ std::min(mNThreads, static_cast<int>(chunks.size())) };
+  for (int iThread{ 1 }; iThread < threadsNum; ++iThread) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  /// the output objects are not assignable, they are appended one by one
+  for (auto& chunk : chunks) {
+    for (auto& object : chunk.result) {
+      output[chunk.layer].push_back(object);
+    }
+  }
+}
+
+} // namespace MFT
+} // namespace o2
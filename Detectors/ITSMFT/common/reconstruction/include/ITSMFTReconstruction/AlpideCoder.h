@@ -13,6 +13,7 @@
 
 #include <Rtypes.h>
 #include <cstdio>
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -97,6 +98,9 @@ class AlpideCoder
   static constexpr int Error = -1;     // flag for decoding error
   static constexpr int EOFFlag = -100; // flag for EOF in reading
 
+  ///< for every byte value, the Expect... flags of the records which may start with it
+  static const std::array<uint8_t, 256> RecordFlags;
+
   AlpideCoder() = default;
   ~AlpideCoder() = default;
   //
@@ -236,6 +240,130 @@ class AlpideCoder
     return chipData.getData().size();
   }
 
+  /// decode alpide data for the next non-empty chip from the contiguous buffer of the cable. Same as the generic
+  /// version, but the bytes are accessed directly, their possible meanings are classified at once with the RecordFlags
+  /// table and the bounds are checked only for multi-byte records
+  int decodeChip(ChipPixelData& chipData, PayLoadCont& buffer) const
+  {
+    const uint8_t* ptr = buffer.getPtr();
+    const uint8_t* const end = buffer.getEnd();
+    //
+    uint16_t region = 0;
+    //
+    int nRightCHits = 0;               // counter for the hits in the right column of the current double column
+    std::uint16_t rightColHits[NRows]; // buffer for the accumulation of hits in the right column
+    std::uint16_t colDPrev = 0xffff;   // previously processed double column (to dected change of the double column)
+
+    uint32_t expectInp = ExpectChipHeader | ExpectChipEmpty; // data must always start with chip header or chip empty flag
+
+    chipData.clear();
+    auto& pixels = chipData.getData();
+
+    while (ptr < end) {
+      const uint8_t dataC = *ptr++;
+      const uint32_t flags = RecordFlags[dataC] & expectInp; // expected records which may start with this byte
+      //
+      if (flags & ExpectChipEmpty) {
+        chipData.setChipID(dataC & MaskChipID); // here we set the chip ID within the module
+        if (ptr++ >= end) {                     // skip timestamp
+          buffer.setPtr(const_cast<uint8_t*>(end));
+          return unexpectedEOF("CHIP_EMPTY:Timestamp");
+        }
+        expectInp = ExpectChipHeader | ExpectChipEmpty;
+        continue;
+      }
+
+      if (flags & ExpectChipHeader) {
+        chipData.setChipID(dataC & MaskChipID); // here we set the chip ID within the module
+        if (ptr++ >= end) {                     // skip timestamp
+          buffer.setPtr(const_cast<uint8_t*>(end));
+          return unexpectedEOF("CHIP_HEADER");
+        }
+        expectInp = ExpectRegion; // now expect region info
+        continue;
+      }
+
+      if (flags & ExpectRegion) {
+        region = dataC & MaskRegion;
+        expectInp = ExpectData;
+        continue;
+      }
+
+      if (flags & ExpectChipTrailer) {
+        chipData.setROFlags(dataC & MaskROFlags);
+        // in case there are entries in the "right" columns buffer, add them to the container
+        if (nRightCHits) {
+          colDPrev++;
+          for (int ihr = 0; ihr < nRightCHits; ihr++) {
+            pixels.emplace_back(rightColHits[ihr], colDPrev);
+          }
+        }
+        break;
+      }
+
+      if (expectInp & ExpectData) {
+        if (!(flags & ExpectData)) {
+          LOG(ERROR) << "Expected DataShort or DataLong mask, got : " << int(dataC);
+          buffer.setPtr(const_cast<uint8_t*>(ptr));
+          return Error;
+        }
+        if (ptr >= end) {
+          buffer.setPtr(const_cast<uint8_t*>(end));
+          return unexpectedEOF("CHIPDATA");
+        }
+        const uint16_t dataS = (uint16_t(dataC) << 8) | *ptr++;
+        // we are decoding the pixel addres, if this is a DATALONG, we will fetch the mask later
+        const uint16_t dColID = (dataS & MaskEncoder) >> 10;
+        const uint16_t pixID = dataS & MaskPixID;
+        const uint16_t row = pixID >> 1;
+        const uint16_t colD = (region * NDColInReg + dColID) << 1; // abs id of left column in double column
+
+        // if we start new double column, transfer the hits accumulated in the right column buffer of prev. double column
+        if (colD != colDPrev) {
+          colDPrev++;
+          for (int ihr = 0; ihr < nRightCHits; ihr++) {
+            pixels.emplace_back(rightColHits[ihr], colDPrev);
+          }
+          colDPrev = colD;
+          nRightCHits = 0; // reset the buffer
+        }
+        // the hit is in the right column if the parities of the row and of the pixel ID differ
+        if ((row ^ pixID) & 0x1) {
+          rightColHits[nRightCHits++] = row;
+        } else {
+          pixels.emplace_back(row, colD);
+        }
+
+        if ((dataS & (~MaskDColID)) == DATALONG) { // multiple hits ?
+          if (ptr >= end) {
+            buffer.setPtr(const_cast<uint8_t*>(end));
+            return unexpectedEOF("CHIP_DATA_LONG:Pattern");
+          }
+          // loop over the set bits of the hit map only
+          for (uint32_t hitsPattern = *ptr++ & MaskHitMap; hitsPattern; hitsPattern &= hitsPattern - 1) {
+            const uint16_t addr = pixID + __builtin_ctz(hitsPattern) + 1, rowE = addr >> 1;
+            if ((rowE ^ addr) & 0x1) {
+              rightColHits[nRightCHits++] = rowE;
+            } else {
+              pixels.emplace_back(rowE, colD);
+            }
+          }
+        }
+        expectInp = ExpectChipTrailer | ExpectData | ExpectRegion;
+        continue; // end of DATA(SHORT or LONG) processing
+      }
+
+      if (!dataC) {
+        buffer.clear(); // 0 padding reached (end of the cable data), no point in continuing
+        return pixels.size();
+      }
+      buffer.setPtr(const_cast<uint8_t*>(ptr));
+      return unexpectedEOF("Unknown word"); // either error
+    }
+    buffer.setPtr(const_cast<uint8_t*>(ptr));
+    return pixels.size();
+  }
+
   /// check if the byte corresponds to chip_header or chip_empty flag
   bool isChipHeaderOrEmpty(uint8_t v) const
   {
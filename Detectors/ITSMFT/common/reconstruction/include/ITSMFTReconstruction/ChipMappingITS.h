@@ -19,6 +19,7 @@
 #include <cstdlib>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include "ITSMFTReconstruction/RUInfo.h"
 
 namespace o2
@@ -95,30 +96,15 @@ class ChipMappingITS
   void getChipInfoSW(int chipSW, ChipInfo& chInfo) const
   {
     chInfo.id = chipSW;
-    if (chipSW > NChipsSB[IB] + NChipsSB[MB] - 1) { // OB
-      chipSW -= NChipsSB[IB] + NChipsSB[MB];
-      chInfo.ruType = OB;
-      auto dvRU = std::div(chipSW, NChipsPerStaveSB[OB]);
-      chInfo.ru = NStavesSB[IB] + NStavesSB[MB] + dvRU.quot; // RU ID == stave ID
-      chInfo.chOnRU = getChipOnRUInfo(OB, dvRU.rem);
-    } else if (chipSW > NChipsSB[IB] - 1) { // MB
-      chipSW -= NChipsSB[IB];
-      chInfo.ruType = MB;
-      auto dvRU = std::div(chipSW, NChipsPerStaveSB[MB]);
-      chInfo.ru = NStavesSB[IB] + dvRU.quot; // RU ID == stave ID
-      chInfo.chOnRU = getChipOnRUInfo(MB, dvRU.rem);
-    } else { // IB
-      chInfo.ruType = IB;
-      auto dvRU = std::div(chipSW, NChipsPerStaveSB[IB]);
-      chInfo.ru = dvRU.quot; // RU ID == stave ID = module ID
-      chInfo.chOnRU = getChipOnRUInfo(IB, dvRU.rem);
-    }
+    chInfo.ru = mChipRUSW[chipSW]; // RU ID == stave ID
+    chInfo.ruType = mStavesInfo[chInfo.ru].ruType;
+    chInfo.chOnRU = &mChipsInfo[mChipInfoEntry[chipSW]];
   }
 
   ///< get chip global SW ID from chipID on module, cable SW ID and stave (RU) info
   uint16_t getGlobalChipID(uint16_t chOnModuleHW, int cableHW, const RUInfo& ruInfo) const
   {
-    return ruInfo.firstChipIDSW + mCableHWFirstChip[ruInfo.ruType][cableHW] + chipModuleIDHW2SW(ruInfo.ruType, chOnModuleHW);
+    return ruInfo.firstChipIDSW + mChipOnRUCableHW[(ruInfo.ruType * NCablesHWMax + (cableHW & (NCablesHWMax - 1))) * NChipsOnModuleHWMax + (chOnModuleHW & (NChipsOnModuleHWMax - 1))];
   }
 
   ///< get SW id of the RU from RU HW id
@@ -162,17 +148,7 @@ class ChipMappingITS
   int getNChipsOnRUType(int ruType) const { return NChipsPerStaveSB[ruType]; }
 
   ///< get RU type from the sequential ID of the RU
-  int getRUType(int ruID) const
-  {
-    ///< get the RU type corresponding to RU with secuential number ruID
-    if (ruID > NStavesSB[IB] + NStavesSB[MB] - 1) {
-      return OB;
-    }
-    if (ruID > NStavesSB[IB] - 1) {
-      return MB;
-    }
-    return IB;
-  }
+  int getRUType(int ruID) const { return mStavesInfo[ruID].ruType; }
 
   ///< convert HW id of chip in the module to SW ID (sequential ID on the module)
   int chipModuleIDHW2SW(int ruType, int hwIDinMod) const
@@ -187,16 +163,7 @@ class ChipMappingITS
   }
 
   ///< convert layer ID and RU sequential ID on Layer to absolute RU IDSW
-  int getRUIDSW(int lr, int ruOnLr) const
-  {
-    int sid = 0;
-    for (int i = 0; i < NLayers; i++) {
-      if (i >= lr)
-        break;
-      sid += NStavesOnLr[i];
-    }
-    return sid + ruOnLr;
-  }
+  int getRUIDSW(int lr, int ruOnLr) const { return FirstStaveOnLr[lr] + ruOnLr; }
 
  private:
   // sub-barrel types, their number, N layers, Max N GBT Links per RU
@@ -254,6 +221,9 @@ class ChipMappingITS
 
   static constexpr int NChips = NChipsSB[IB] + NChipsSB[MB] + NChipsSB[OB];
 
+  ///< bounds (powers of 2) of the HW cable ID and of the HW chip ID on the module, for the flat tables
+  static constexpr int NCablesHWMax = 32, NChipsOnModuleHWMax = 16;
+
   ///< mapping from SW chips ID within the module to HW ID
   /*
     SW/HW correspondence
@@ -277,7 +247,14 @@ class ChipMappingITS
   std::vector<uint8_t> mCableHW2SW[NSubB];       ///< table of cables HW to SW conversion for each RU type
   std::vector<uint8_t> mCableHWFirstChip[NSubB]; ///< 1st chip of module (relative to the 1st chip of the stave) served by each cable
 
-  ClassDefNV(ChipMappingITS, 1)
+  // flat tables to avoid the branching in the per chip accessors used by the raw data decoding
+  std::array<uint16_t, NChips> mChipRUSW;       ///< RU SW ID of each chip
+  std::array<uint16_t, NChips> mChipInfoEntry;  ///< entry of each chip in mChipsInfo
+  std::array<uint16_t, NSubB * NCablesHWMax * NChipsOnModuleHWMax> mChipOnRUCableHW; ///< chip SW ID within the RU for
+                                                                                      ///< each RU type, cable HW ID and
+                                                                                      ///< chip HW ID on the module
+
+  ClassDefNV(ChipMappingITS, 2)
 };
 }
 }
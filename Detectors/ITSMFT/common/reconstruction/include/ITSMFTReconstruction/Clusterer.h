@@ -15,6 +15,7 @@
 
 #define _PERFORM_TIMING_
 
+#include <memory>
 #include <utility>
 #include <vector>
 #include <cstring>
@@ -27,6 +28,7 @@
 #include "ITSMFTReconstruction/PixelData.h"
 #include "ITSMFTReconstruction/LookUp.h"
 #include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
 #include "CommonDataFormat/EvIndex.h"
 #include "CommonDataFormat/InteractionRecord.h"
 #include "CommonConstants/LHCConstants.h"
@@ -39,13 +41,6 @@
 
 namespace o2
 {
-class MCCompLabel;
-namespace dataformats
-{
-template <typename T>
-class MCTruthContainer;
-}
-
 namespace itsmft
 {
 class Clusterer
@@ -96,6 +91,14 @@ class Clusterer
 
   void setOutputTree(TTree* tr) { mClusTree = tr; }
 
+  ///< select the labeling of connected pixels on bit-packed columns instead of the pixel by pixel one
+  void setUseBitmaskLabeling(bool v) { mUseBitmaskLabeling = v; }
+  bool getUseBitmaskLabeling() const { return mUseBitmaskLabeling; }
+
+  ///< set the number of threads clusterizing the chips of a ROF in parallel
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
   void setNChips(int n)
   {
     mChips.resize(n);
@@ -109,65 +112,167 @@ class Clusterer
   }
 
  private:
-  void initChip(UInt_t first);
-
-  ///< add new precluster at given row of current column for the fired pixel with index ip in the ChipPixelData
-  void addNewPrecluster(UInt_t ip, UShort_t row)
+  ///< clusterization state of a single thread: scratch buffers for the chip being processed
+  ///< and the clusters produced by the thread in the multi-threaded mode
+  class ClustererThread
   {
-    mPreClusterHeads.push_back(mPixels.size());
-    // new head does not point yet (-1) on other pixels, store just the entry of the pixel in the ChipPixelData
-    mPixels.emplace_back(-1, ip);
-    int lastIndex = mPreClusterIndices.size();
-    mPreClusterIndices.push_back(lastIndex);
-    mCurr[row] = lastIndex; // store index of the new precluster in the current column buffer
-  }
+   public:
+    ClustererThread(const Clusterer* parent = nullptr);
+
+    ///< clusterize single chip, clustersCount is the index of the next cluster in the output containers
+    void processChip(ChipPixelData* chipData, std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                     const MCTruth* labelsDig, MCTruth* labelsClus, int& clustersCount);
+
+    ///< clear the clusters produced by this thread
+    void clearOutput()
+    {
+      mFullClusters.clear();
+      mCompClusters.clear();
+      mLabels.clear();
+      mNClusters = 0;
+    }
 
-  ///< add cluster at row (entry ip in the ChipPixeData) to the precluster with given index
-  void expandPreCluster(UInt_t ip, UShort_t row, int preClusIndex)
-  {
-    auto& firstIndex = mPreClusterHeads[mPreClusterIndices[preClusIndex]];
-    mPixels.emplace_back(firstIndex, ip);
-    firstIndex = mPixels.size() - 1;
-    mCurr[row] = preClusIndex;
-  }
+    std::vector<Cluster> mFullClusters;        ///< full clusters of the chips processed by this thread
+    std::vector<CompClusterExt> mCompClusters; ///< compact clusters of the chips processed by this thread
+    MCTruth mLabels;                           ///< labels of the clusters produced by this thread
+    int mNClusters = 0;                        ///< number of clusters produced by this thread
+
+   private:
+    void initChip(UInt_t first);
+
+    ///< add new precluster at given row of current column for the fired pixel with index ip in the ChipPixelData
+    void addNewPrecluster(UInt_t ip, UShort_t row)
+    {
+      mPreClusterHeads.push_back(mPixels.size());
+      // new head does not point yet (-1) on other pixels, store just the entry of the pixel in the ChipPixelData
+      mPixels.emplace_back(-1, ip);
+      int lastIndex = mPreClusterIndices.size();
+      mPreClusterIndices.push_back(lastIndex);
+      mCurr[row] = lastIndex; // store index of the new precluster in the current column buffer
+    }
 
-  ///< recalculate min max row and column of the cluster accounting for the position of pix
-  void adjustBoundingBox(const o2::itsmft::PixelData pix, UShort_t& rMin, UShort_t& rMax,
-                         UShort_t& cMin, UShort_t& cMax) const
-  {
-    if (pix.getRowDirect() < rMin) {
-      rMin = pix.getRowDirect();
+    ///< add cluster at row (entry ip in the ChipPixeData) to the precluster with given index
+    void expandPreCluster(UInt_t ip, UShort_t row, int preClusIndex)
+    {
+      auto& firstIndex = mPreClusterHeads[mPreClusterIndices[preClusIndex]];
+      mPixels.emplace_back(firstIndex, ip);
+      firstIndex = mPixels.size() - 1;
+      mCurr[row] = preClusIndex;
     }
-    if (pix.getRowDirect() > rMax) {
-      rMax = pix.getRowDirect();
+
+    ///< recalculate min max row and column of the cluster accounting for the position of pix
+    void adjustBoundingBox(const o2::itsmft::PixelData pix, UShort_t& rMin, UShort_t& rMax,
+                           UShort_t& cMin, UShort_t& cMax) const
+    {
+      if (pix.getRowDirect() < rMin) {
+        rMin = pix.getRowDirect();
+      }
+      if (pix.getRowDirect() > rMax) {
+        rMax = pix.getRowDirect();
+      }
+      if (pix.getCol() < cMin) {
+        cMin = pix.getCol();
+      }
+      if (pix.getCol() > cMax) {
+        cMax = pix.getCol();
+      }
     }
-    if (pix.getCol() < cMin) {
-      cMin = pix.getCol();
+
+    ///< swap current and previous column buffers
+    void swapColumnBuffers()
+    {
+      int* tmp = mCurr;
+      mCurr = mPrev;
+      mPrev = tmp;
     }
-    if (pix.getCol() > cMax) {
-      cMax = pix.getCol();
+
+    ///< reset column buffer, for the performance reasons we use memset
+    void resetColumn(int* buff)
+    {
+      std::memset(buff, -1, sizeof(int) * SegmentationAlpide::NRows);
+      //std::fill(buff, buff + SegmentationAlpide::NRows, -1);
     }
-  }
 
-  ///< swap current and previous column buffers
-  void swapColumnBuffers()
-  {
-    int* tmp = mCurr;
-    mCurr = mPrev;
-    mPrev = tmp;
-  }
+    void updateChip(UInt_t ip);
+    void finishChip(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                    const MCTruth* labelsDig, MCTruth* labelsClus, int& clustersCount);
+    void fetchMCLabels(int digID, const MCTruth* labelsDig, int& nfilled);
+    void storeCluster(int npix, UShort_t rowMin, UShort_t rowMax, UShort_t colMin, UShort_t colMax, int nlab,
+                      std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus, MCTruth* labelsClus,
+                      int& clustersCount);
+
+    ///< clusterize the chip by building the runs of fired rows of every column from its bit-packed pixels
+    ///< and by merging the runs touching in adjacent columns with a union-find
+    void processChipBitmask(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                            const MCTruth* labelsDig, MCTruth* labelsClus, int& clustersCount);
+
+    ///< append the runs of contiguous fired rows in mColumnBits to mRuns and reset mColumnBits
+    void extractRuns();
+
+    ///< find the root run of the cluster of the run i, with path halving
+    int findRoot(int i)
+    {
+      while (mRuns[i].parent != i) {
+        mRuns[i].parent = mRuns[mRuns[i].parent].parent;
+        i = mRuns[i].parent;
+      }
+      return i;
+    }
 
-  ///< reset column buffer, for the performance reasons we use memset
-  void resetColumn(int* buff)
-  {
-    std::memset(buff, -1, sizeof(int) * SegmentationAlpide::NRows);
-    //std::fill(buff, buff + SegmentationAlpide::NRows, -1);
-  }
+    ///< merge the clusters of runs i and j, the root is the run found first in the column-major order
+    void uniteRuns(int i, int j)
+    {
+      i = findRoot(i);
+      j = findRoot(j);
+      if (i < j) {
+        mRuns[j].parent = i;
+      } else {
+        mRuns[i].parent = j;
+      }
+    }
 
-  void updateChip(UInt_t ip);
-  void finishChip(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
-                  const MCTruth* labelsDig, MCTruth* labelsClus = nullptr);
-  void fetchMCLabels(int digID, const MCTruth* labelsDig, int& nfilled);
+    ///< run of contiguous fired rows in a column, node of the union-find forest of the runs
+    struct PixelRun {
+      UShort_t rowMin; ///< first row of the run
+      UShort_t rowMax; ///< last row of the run
+      int parent;      ///< parent run in the union-find forest
+    };
+    static constexpr int NColumnWords = SegmentationAlpide::NRows / 64;
+
+    const Clusterer* mParent = nullptr; ///< clusterer providing the geometry and the topology dictionary
+    ChipPixelData* mChipData = nullptr; ///< pointer on the chip data being processed
+
+    // buffers for entries in mPreClusterIndices in 2 columns, to avoid boundary checks, we reserve
+    // extra elements in the beginning and the end
+    int mColumn1[SegmentationAlpide::NRows + 2];
+    int mColumn2[SegmentationAlpide::NRows + 2];
+    int* mCurr; // pointer on the 1st row of currently processed mColumnsX
+    int* mPrev; // pointer on the 1st row of previously processed mColumnsX
+
+    // mPixels[].first is the index of the next pixel of the same precluster in the mPixels
+    // mPixels[].second is the index of the referred pixel in the ChipPixelData (element of mChips)
+    std::vector<std::pair<int, UInt_t>> mPixels;
+    std::vector<int> mPreClusterHeads; // index of precluster head in the mPixels
+    std::vector<int> mPreClusterIndices;
+    UShort_t mCol = 0xffff;    ///< Column being processed
+    bool mNoLeftColumn = true; ///< flag that there is no column on the left to check
+
+    std::array<Label, Cluster::maxLabels> mLabelsBuff;               ///< temporary buffer for building cluster labels
+    std::array<PixelData, Cluster::kMaxPatternBits * 2> mPixArrBuff; ///< temporary buffer for pattern calc.
+
+    // buffers of the bitmask labeling
+    std::array<uint64_t, NColumnWords> mColumnBits = {}; ///< fired unmasked rows of the current column
+    std::vector<PixelRun> mRuns;                         ///< runs of the chip in column-major order
+    std::vector<int> mPixelRun;                          ///< run of every pixel of the chip data, -1 for masked pixels
+    std::vector<int> mRunCluster;                        ///< cluster of every run
+    std::vector<int> mClusterPixelsEnd;                  ///< end of the pixels of every cluster in mClusterPixels
+    std::vector<UInt_t> mClusterPixels;                  ///< pixel entries in the chip data grouped by cluster
+  };
+
+  ///< clusterize the chips of the ROF collected in mChipsBatch with mNThreads threads and append the
+  ///< clusters to the output in the order of the chips
+  void processChipsBatch(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                         const MCTruth* labelsDig, MCTruth* labelsClus);
 
   ///< flush cluster data accumulated so far into the tree
   void flushClusters(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus, MCTruth* labels)
@@ -200,6 +305,9 @@ class Clusterer
   ///< mask continuosly fired pixels in frames separated by less than this amount of BCs (fired from hit in prev. ROF)
   int mMaxBCSeparationToMask = 6000. / o2::constants::lhc::LHCBunchSpacingNS + 10;
 
+  int mNThreads = 1;                ///< number of threads used to clusterize the chips of a ROF
+  bool mUseBitmaskLabeling = false; ///< use the labeling on bit-packed columns
+
   // aux data for clusterization
   ChipPixelData* mChipData = nullptr; //! pointer on the current single chip data provided by the reader
 
@@ -208,29 +316,17 @@ class Clusterer
   std::vector<ChipPixelData> mChips;    // currently processed chips data
   std::vector<ChipPixelData> mChipsOld; // previously processed chips data (for masking)
 
-  // buffers for entries in mPreClusterIndices in 2 columns, to avoid boundary checks, we reserve
-  // extra elements in the beginning and the end
-  int mColumn1[SegmentationAlpide::NRows + 2];
-  int mColumn2[SegmentationAlpide::NRows + 2];
-  int* mCurr; // pointer on the 1st row of currently processed mColumnsX
-  int* mPrev; // pointer on the 1st row of previously processed mColumnsX
-
   o2::itsmft::ROFRecord mROFRef; // ROF reference
 
-  // mPixels[].first is the index of the next pixel of the same precluster in the mPixels
-  // mPixels[].second is the index of the referred pixel in the ChipPixelData (element of mChips)
-  std::vector<std::pair<int, UInt_t>> mPixels;
-  std::vector<int> mPreClusterHeads; // index of precluster head in the mPixels
-  std::vector<int> mPreClusterIndices;
-  UShort_t mCol = 0xffff; ///< Column being processed
   int mClustersCount = 0; ///< number of clusters in the output container
 
-  bool mNoLeftColumn = true;                           ///< flag that there is no column on the left to check
   const o2::itsmft::GeometryTGeo* mGeometry = nullptr; //! ITS OR MFT upgrade geometry
 
   TTree* mClusTree = nullptr;                                      //! externally provided tree to write clusters output (if needed)
-  std::array<Label, Cluster::maxLabels> mLabelsBuff;               //! temporary buffer for building cluster labels
-  std::array<PixelData, Cluster::kMaxPatternBits * 2> mPixArrBuff; //! temporary buffer for pattern calc.
+
+  std::vector<std::unique_ptr<ClustererThread>> mThreads; //! clusterization states, the 1st one is used in the serial mode
+  std::vector<ChipPixelData> mChipsBatch;                 //! chips of the current ROF waiting for the multi-threaded clusterization
+  int mNChipsBatch = 0;                                   //! number of chips in mChipsBatch
 
   LookUp mPattIdConverter; //! Convert the cluster topology to the corresponding entry in the dictionary.
 
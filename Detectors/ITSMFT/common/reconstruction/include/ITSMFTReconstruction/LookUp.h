@@ -35,8 +35,8 @@ class LookUp
   LookUp();
   LookUp(std::string fileName);
   static int groupFinder(int nRow, int nCol);
-  int findGroupID(int nRow, int nCol, const unsigned char patt[Cluster::kMaxPatternBytes]);
-  int getTopologiesOverThreshold() { return mTopologiesOverThreshold; }
+  int findGroupID(int nRow, int nCol, const unsigned char patt[Cluster::kMaxPatternBytes]) const;
+  int getTopologiesOverThreshold() const { return mTopologiesOverThreshold; }
   void loadDictionary(std::string fileName);
 
  private:
@@ -36,6 +36,8 @@
 #include <string_view>
 #include <array>
 #include <bitset>
+#include <atomic>
+#include <thread>
 
 #define _RAW_READER_ERROR_CHECKS_
 
@@ -132,6 +134,7 @@ struct RawDecodingStat {
   uint64_t nBytesProcessed = 0; // total number of bytes (rdh->memorySize) processed
   uint64_t nNonEmptyChips = 0;  // number of non-empty chips found
   uint64_t nHitsDecoded = 0;    // number of hits found
+  double timeDecoding = 0.;     // real time in s spent in the decoding of the cached data
 
   RawDecodingStat() = default;
 
@@ -142,6 +145,7 @@ struct RawDecodingStat {
     nBytesProcessed = 0;
     nNonEmptyChips = 0;
     nHitsDecoded = 0;
+    timeDecoding = 0.;
   }
 
   void print() const
@@ -149,9 +153,19 @@ struct RawDecodingStat {
     printf("\nDecoding statistics\n");
     printf("%llu bytes for %llu RUs processed in %llu pages\n", (ULL)nBytesProcessed, (ULL)nRUsProcessed, (ULL)nPagesProcessed);
     printf("%llu hits found in %llu non-empty chips\n", (ULL)nHitsDecoded, (ULL)nNonEmptyChips);
+    if (timeDecoding > 0.) {
+      printf("decoding time %.3f s: %.2f MB/s, %.3e chips/s, %.3e hits/s\n", timeDecoding, getBytesPerSecond() / 1e6,
+             getChipsPerSecond(), nHitsDecoded / timeDecoding);
+    }
   }
 
-  ClassDefNV(RawDecodingStat, 1);
+  ///< decoding throughput in bytes per second
+  double getBytesPerSecond() const { return timeDecoding > 0. ? nBytesProcessed / timeDecoding : 0.; }
+
+  ///< decoding throughput in non-empty chips per second
+  double getChipsPerSecond() const { return timeDecoding > 0. ? nNonEmptyChips / timeDecoding : 0.; }
+
+  ClassDefNV(RawDecodingStat, 2);
 };
 
 // support for the GBT single link data
@@ -214,6 +228,7 @@ class RawPixelReader : public PixelReader
   RawPixelReader()
   {
     mRUEntry.fill(-1); // no known links in the beginning
+    mSWDecode.Reset();
   }
 
   ~RawPixelReader() override
@@ -247,20 +262,22 @@ class RawPixelReader : public PixelReader
   /// CRU pages are of max size of 8KB
   void imposeMaxPage(bool v) { mImposeMaxPage = v; }
 
+  /// set number of threads for the decoding of the RUs of the trigger. With more than 1 thread the
+  /// decoded chips of the trigger are provided in increasing chip ID order
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
   ///______________________________________________________________________
   ChipPixelData* getNextChipData(std::vector<ChipPixelData>& chipDataVec) override
   {
     // decode new RU if no cached non-empty chips
 
     if (mCurRUDecodeID >= 0) { // make sure current RU has fired chips to extract
-      for (; mCurRUDecodeID < mNRUs; mCurRUDecodeID++) {
-        auto& ru = mRUDecodeVec[mCurRUDecodeID];
-        if (ru.lastChipChecked < ru.nChipsFired) {
-          auto& chipData = ru.chipsData[ru.lastChipChecked++];
-          int id = chipData.getChipID();
-          chipDataVec[id].swap(chipData);
-          return &chipDataVec[id];
-        }
+      auto chipData = fetchDecodedChip();
+      if (chipData) {
+        int id = chipData->getChipID();
+        chipDataVec[id].swap(*chipData);
+        return &chipDataVec[id];
       }
       mCurRUDecodeID = 0; // no more decoded data if reached this place,
     }
@@ -282,6 +299,7 @@ class RawPixelReader : public PixelReader
   void clear()
   {
     mDecodingStat.clear();
+    mSWDecode.Reset();
     for (auto& rudec : mRUDecodeVec) {
       rudec.clear();
     }
@@ -680,31 +698,110 @@ class RawPixelReader : public PixelReader
     if (mMinTriggersCached < 1) {
       return 0;
     }
-    int nlinks = 0;
-    for (int ir = mNRUs; ir--;) {
-      auto& ruDecode = mRUDecodeVec[ir];
-      if (!nlinks) {                        // on 1st occasion extract trigger data
-        for (auto& link : ruDecode.links) { // loop over links to fill cable buffers
-          if (link && !link->data.isEmpty()) {
-            const auto rdh = reinterpret_cast<const o2::header::RAWDataHeader*>(link->data.getPtr());
-            mInteractionRecord.bc = rdh->triggerBC;
-            mInteractionRecord.orbit = rdh->triggerOrbit;
-            mTrigger = rdh->triggerType;
-            mInteractionRecordHB.bc = rdh->heartbeatBC;
-            mInteractionRecordHB.orbit = rdh->heartbeatOrbit;
-            break;
-          }
+    mSWDecode.Start(false);
+    bool triggerFound = false;
+    for (int ir = mNRUs; ir-- && !triggerFound;) { // extract trigger data from the 1st RU with data
+      for (auto& link : mRUDecodeVec[ir].links) {
+        if (link && !link->data.isEmpty()) {
+          const auto rdh = reinterpret_cast<const o2::header::RAWDataHeader*>(link->data.getPtr());
+          mInteractionRecord.bc = rdh->triggerBC;
+          mInteractionRecord.orbit = rdh->triggerOrbit;
+          mTrigger = rdh->triggerType;
+          mInteractionRecordHB.bc = rdh->heartbeatBC;
+          mInteractionRecordHB.orbit = rdh->heartbeatOrbit;
+          triggerFound = true;
+          break;
         }
       }
-
-      nlinks += decodeNextRUData(ruDecode);
-      mDecodingStat.nRUsProcessed++;
     }
+    int nlinks = 0;
+    mOrderedChips = mNThreads > 1 && mNRUs > 1;
+    if (mOrderedChips) {
+      nlinks = decodeRUsParallel();
+    } else {
+      for (int ir = mNRUs; ir--;) {
+        nlinks += decodeNextRUData(mRUDecodeVec[ir]);
+      }
+    }
+    for (int ir = 0; ir < mNRUs; ir++) {
+      const auto& ruDecode = mRUDecodeVec[ir];
+      mDecodingStat.nNonEmptyChips += ruDecode.nChipsFired;
+      for (int ic = 0; ic < ruDecode.nChipsFired; ic++) {
+        mDecodingStat.nHitsDecoded += ruDecode.chipsData[ic].getData().size();
+      }
+    }
+    mDecodingStat.nRUsProcessed += mNRUs;
     mCurRUDecodeID = 0;
     mMinTriggersCached--;
+    mSWDecode.Stop();
+    mDecodingStat.timeDecoding = mSWDecode.RealTime();
+    return nlinks;
+  }
+
+  //_____________________________________
+  int decodeRUsParallel()
+  {
+    // decode the current trigger of all RUs on mNThreads threads and order the decoded chips in chip ID,
+    // return N links decoded. The RUs are independent, their containers are filled by a single thread.
+    int nThreads = std::min(mNThreads, mNRUs);
+    std::atomic<int> nextRU{ 0 };
+    std::vector<int> nLinksThread(nThreads, 0);
+    auto worker = [this, &nextRU, &nLinksThread](int ith) {
+      int ir;
+      while ((ir = nextRU++) < mNRUs) {
+        nLinksThread[ith] += decodeNextRUData(mRUDecodeVec[ir]);
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (int ith = 1; ith < nThreads; ith++) {
+      threads.emplace_back(worker, ith);
+    }
+    worker(0); // the calling thread is used as well
+    for (auto& th : threads) {
+      th.join();
+    }
+    int nlinks = 0;
+    for (auto nl : nLinksThread) {
+      nlinks += nl;
+    }
+    // merge the chips of all RUs in increasing chip ID
+    mDecodedChips.clear();
+    for (int ir = 0; ir < mNRUs; ir++) {
+      const auto& ruDecode = mRUDecodeVec[ir];
+      for (int ic = 0; ic < ruDecode.nChipsFired; ic++) {
+        mDecodedChips.emplace_back(ruDecode.chipsData[ic].getChipID(), ir, ic);
+      }
+    }
+    std::sort(mDecodedChips.begin(), mDecodedChips.end(),
+              [](const DecodedChip& a, const DecodedChip& b) { return a.chipID < b.chipID; });
+    mNextDecodedChip = 0;
     return nlinks;
   }
 
+  //_____________________________________
+  ChipPixelData* fetchDecodedChip()
+  {
+    // get next decoded chip of the current trigger (w/o changing it), nullptr if all chips were provided
+    if (mOrderedChips) {
+      if (mNextDecodedChip < mDecodedChips.size()) {
+        const auto& chip = mDecodedChips[mNextDecodedChip++];
+        auto& ru = mRUDecodeVec[chip.ru];
+        mCurRUDecodeID = chip.ru;
+        ru.lastChipChecked++;
+        return &ru.chipsData[chip.chipInRU];
+      }
+      return nullptr;
+    }
+    for (; mCurRUDecodeID < mNRUs; mCurRUDecodeID++) {
+      auto& ru = mRUDecodeVec[mCurRUDecodeID];
+      if (ru.lastChipChecked < ru.nChipsFired) {
+        return &ru.chipsData[ru.lastChipChecked++];
+      }
+    }
+    return nullptr;
+  }
+
   //_____________________________________
   int decodeNextRUData(RUDecodeData& ruDecData)
   {
@@ -712,6 +809,7 @@ class RawPixelReader : public PixelReader
     int minTriggers = INT_MAX;
     int res = 0;
     ruDecData.clearTrigger();
+    ruDecData.nChipsFired = ruDecData.lastChipChecked = 0; // RUs w/o cables data have no fired chips
     bool aborted = false;
     for (auto& link : ruDecData.links) { // loop over links to fill cable buffers
       if (link && !link->data.isEmpty()) {
@@ -1232,8 +1330,6 @@ class RawPixelReader : public PixelReader
           chipData->setChipID(MAP.getGlobalChipID(chipData->getChipID(), decData.cableHWID[icab], *decData.ruInfo));
           chipData->setInteractionRecord(mInteractionRecord);
           chipData->setTrigger(mTrigger);
-          mDecodingStat.nNonEmptyChips++;
-          mDecodingStat.nHitsDecoded += chipData->getData().size();
           ntot += res;
           // fetch next free chip
           if (++decData.nChipsFired < MaxChipsPerRU) {
@@ -1253,12 +1349,10 @@ class RawPixelReader : public PixelReader
     /// read single chip data to the provided container
 
     if (mCurRUDecodeID >= 0) { // make sure current RU has fired chips to extract
-      for (; mCurRUDecodeID < mNRUs; mCurRUDecodeID++) {
-        auto& ru = mRUDecodeVec[mCurRUDecodeID];
-        if (ru.lastChipChecked < ru.nChipsFired) {
-          chipData.swap(ru.chipsData[ru.lastChipChecked++]);
-          return true;
-        }
+      auto decChipData = fetchDecodedChip();
+      if (decChipData) {
+        chipData.swap(*decChipData);
+        return true;
       }
       mCurRUDecodeID = 0; // no more decoded data if reached this place,
     }
@@ -1374,6 +1468,17 @@ class RawPixelReader : public PixelReader
   Mapping MAP;
   int mVerbose = 0;            //! verbosity level
   int mCurRUDecodeID = -1;     //! index of currently processed RUDecode container
+  int mNThreads = 1;           //! number of threads for the decoding of the RUs
+
+  struct DecodedChip {
+    uint16_t chipID = 0;   // global chip ID
+    uint16_t ru = 0;       // entry of the RU container
+    uint16_t chipInRU = 0; // entry of the chip in the RU container
+    DecodedChip(uint16_t id, uint16_t r, uint16_t c) : chipID(id), ru(r), chipInRU(c) {}
+  };
+  std::vector<DecodedChip> mDecodedChips; //! decoded chips of the trigger in chip ID order for the multi-threaded mode
+  size_t mNextDecodedChip = 0;            //! next entry of mDecodedChips to provide
+  bool mOrderedChips = false;             //! are the decoded chips provided from mDecodedChips
 
   PayLoadCont mRawBuffer; //! buffer for binary raw data file IO
 
@@ -1389,7 +1494,8 @@ class RawPixelReader : public PixelReader
   // statistics
   RawDecodingStat mDecodingStat;                                  //! global decoding statistics
 
-  TStopwatch mSWIO; //! timer for IO operations
+  TStopwatch mSWIO;     //! timer for IO operations
+  TStopwatch mSWDecode; //! timer for the decoding of the cached data
 
   static constexpr int RawBufferMargin = 5000000;                      // keep uploaded at least this amount
   static constexpr int RawBufferSize = 10000000 + 2 * RawBufferMargin; // size in MB
@@ -33,6 +33,8 @@ class TopologyFastSimulation
  public:
   TopologyFastSimulation(std::string fileName, unsigned seed = 0xdeadbeef);
   int getRandom();
+  /// dictionary the topologies are drawn from
+  TopologyDictionary& getDictionary() { return mDictionary; }
 
  private:
   TopologyDictionary mDictionary;
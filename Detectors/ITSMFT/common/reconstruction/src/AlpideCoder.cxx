@@ -18,6 +18,35 @@
 
 using namespace o2::itsmft;
 
+namespace
+{
+std::array<uint8_t, 256> makeRecordFlags()
+{
+  std::array<uint8_t, 256> flags{};
+  for (int v = 0; v < 256; v++) {
+    uint8_t vm = v & (~AlpideCoder::MaskChipID);
+    if (vm == AlpideCoder::CHIPEMPTY) {
+      flags[v] |= AlpideCoder::ExpectChipEmpty;
+    }
+    if (vm == AlpideCoder::CHIPHEADER) {
+      flags[v] |= AlpideCoder::ExpectChipHeader;
+    }
+    if ((v & AlpideCoder::REGION) == AlpideCoder::REGION) {
+      flags[v] |= AlpideCoder::ExpectRegion;
+    }
+    if (vm == AlpideCoder::CHIPTRAILER) {
+      flags[v] |= AlpideCoder::ExpectChipTrailer;
+    }
+    if (AlpideCoder::isData(uint8_t(v))) {
+      flags[v] |= AlpideCoder::ExpectData;
+    }
+  }
+  return flags;
+}
+} // namespace
+
+const std::array<uint8_t, 256> AlpideCoder::RecordFlags = makeRecordFlags();
+
 //_____________________________________
 void AlpideCoder::print() const
 {
@@ -12,6 +12,7 @@
 // \brief Autimatically generated ITS chip <-> module mapping
 
 #include "ITSMFTReconstruction/ChipMappingITS.h"
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <iomanip>
@@ -130,10 +131,32 @@ ChipMappingITS::ChipMappingITS()
       sInfo.ruType = RUTypeLr[ilr];
       sInfo.nCables = NCablesPerStaveSB[sInfo.ruType];
       sInfo.firstChipIDSW = chipCount;
+      for (int ich = 0; ich < NChipsPerStaveSB[sInfo.ruType]; ich++) {
+        mChipRUSW[chipCount + ich] = sInfo.idSW;
+        mChipInfoEntry[chipCount + ich] = mChipInfoEntrySB[sInfo.ruType] + ich;
+      }
       chipCount += NChipsPerStaveSB[sInfo.ruType];
     }
   }
   assert(ctrStv == getNRUs());
+  assert(chipCount == getNChips());
+
+  // chip ID within the RU from the cable HW ID and the chip HW ID on the module, 0xffff if not connected
+  mChipOnRUCableHW.fill(0xffff);
+  for (int bid = IB; bid <= OB; bid++) {
+    for (int cableHW = 0; cableHW < std::min(NCablesHWMax, int(mCableHWFirstChip[bid].size())); cableHW++) {
+      if (mCableHWFirstChip[bid][cableHW] == 0xff) {
+        continue;
+      }
+      for (int chipHW = 0; chipHW < NChipsOnModuleHWMax; chipHW++) {
+        if ((bid == IB && chipHW >= NChipsPerModuleSB[IB]) || (bid != IB && (chipHW > 14 || ChipOBModHW2SW[chipHW] == 0xff))) {
+          continue;
+        }
+        mChipOnRUCableHW[(bid * NCablesHWMax + cableHW) * NChipsOnModuleHWMax + chipHW] =
+          mCableHWFirstChip[bid][cableHW] + chipModuleIDHW2SW(bid, chipHW);
+      }
+    }
+  }
 }
 
 //______________________________________________
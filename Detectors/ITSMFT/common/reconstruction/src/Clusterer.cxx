@@ -11,6 +11,7 @@
 /// \file Clusterer.cxx
 /// \brief Implementation of the ITS cluster finder
 #include <algorithm>
+#include <thread>
 #include "FairLogger.h" // for LOG
 
 #include "ITSMFTBase/SegmentationAlpide.h"
@@ -21,10 +22,16 @@ using namespace o2::itsmft;
 using Segmentation = o2::itsmft::SegmentationAlpide;
 
 //__________________________________________________
-Clusterer::Clusterer() : mPattIdConverter(), mCurr(mColumn2 + 1), mPrev(mColumn1 + 1)
+Clusterer::ClustererThread::ClustererThread(const Clusterer* parent) : mParent(parent), mCurr(mColumn2 + 1), mPrev(mColumn1 + 1)
 {
   std::fill(std::begin(mColumn1), std::end(mColumn1), -1);
   std::fill(std::begin(mColumn2), std::end(mColumn2), -1);
+}
+
+//__________________________________________________
+Clusterer::Clusterer() : mPattIdConverter()
+{
+  mThreads.emplace_back(std::make_unique<ClustererThread>(this));
   mROFRef.clear();
 #ifdef _ClusterTopology_
   LOG(INFO) << "*********************************************************************" << FairLogger::endl;
@@ -52,11 +59,17 @@ void Clusterer::process(PixelReader& reader, std::vector<Cluster>* fullClus,
   auto& currROFIR = mROFRef.getBCData();
   auto& currROFEntry = mROFRef.getROFEntry();
 
+  const bool multiThreaded = mNThreads > 1;
+  mNChipsBatch = 0;
+
   while ((mChipData = reader.getNextChipData(mChips))) { // read next chip data to corresponding
     // vector in the mChips and return the pointer on it
 
     if (!(mChipData->getInteractionRecord() == currROFIR)) { // new ROF starts
 
+      if (multiThreaded) { // clusterize the chips of the finished ROF
+        processChipsBatch(fullClus, compClus, reader.getDigitsMCTruth(), labelsCl);
+      }
       mROFRef.setNROFEntries(mClustersCount - currROFEntry.getIndex()); // number of entries in this ROF
 
       if (!currROFIR.isDummy()) {
@@ -88,20 +101,21 @@ void Clusterer::process(PixelReader& reader, std::vector<Cluster>* fullClus,
         mChipData->maskFiredInSample(mChipsOld[chipID]);
       }
     }
-    auto validPixID = mChipData->getFirstUnmasked();
-    if (validPixID < mChipData->getData().size()) { // chip data may have all of its pixels masked!
-      initChip(validPixID++);
-      for (; validPixID < mChipData->getData().size(); validPixID++) {
-        if (!mChipData->getData()[validPixID].isMasked()) {
-          updateChip(validPixID);
-        }
+    if (multiThreaded) { // keep the chip until all chips of this ROF are read
+      if (mNChipsBatch == mChipsBatch.size()) {
+        mChipsBatch.emplace_back();
       }
-      finishChip(fullClus, compClus, reader.getDigitsMCTruth(), labelsCl);
+      mChipsBatch[mNChipsBatch++].swap(*mChipData);
+      continue;
     }
+    mThreads[0]->processChip(mChipData, fullClus, compClus, reader.getDigitsMCTruth(), labelsCl, mClustersCount);
     if (mMaxBCSeparationToMask > 0) { // current chip data will be used in the next ROF to mask overflow pixels
       mChipsOld[chipID].swap(*mChipData);
     }
   }
+  if (multiThreaded) { // clusterize the chips of the last ROF
+    processChipsBatch(fullClus, compClus, reader.getDigitsMCTruth(), labelsCl);
+  }
   mROFRef.setNROFEntries(mClustersCount - currROFEntry.getIndex()); // number of entries in this ROF
 
   // flush last ROF
@@ -122,7 +136,109 @@ void Clusterer::process(PixelReader& reader, std::vector<Cluster>* fullClus,
 }
 
 //__________________________________________________
-void Clusterer::initChip(UInt_t first)
+void Clusterer::processChipsBatch(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                                  const MCTruth* labelsDig, MCTruth* labelsClus)
+{
+  // clusterize the chips of the current ROF in parallel. Every thread processes a contiguous range of
+  // chips with its own scratch buffers and output containers, which are appended to the output in the
+  // order of the threads, so that the result is identical to the serial processing
+  constexpr size_t MinPixelsPerThread = 1000; // do not parallelize ROFs with few fired pixels
+  if (!mNChipsBatch) {
+    return;
+  }
+  size_t nPixels = 0;
+  for (int ic = 0; ic < mNChipsBatch; ic++) {
+    nPixels += mChipsBatch[ic].getData().size();
+  }
+  int nThreads = std::min<size_t>(std::min(mNThreads, mNChipsBatch), nPixels / MinPixelsPerThread);
+  if (nThreads < 1) {
+    nThreads = 1;
+  }
+  while (mThreads.size() < nThreads) {
+    mThreads.emplace_back(std::make_unique<ClustererThread>(this));
+  }
+
+  // split the chips in ranges with similar number of fired pixels
+  std::vector<int> firstChip(nThreads + 1, mNChipsBatch);
+  firstChip[0] = 0;
+  size_t nPixelsSeen = 0;
+  for (int ic = 0, it = 1; ic < mNChipsBatch && it < nThreads; ic++) {
+    nPixelsSeen += mChipsBatch[ic].getData().size();
+    if (nPixelsSeen * nThreads >= nPixels * it) {
+      firstChip[it++] = ic + 1;
+    }
+  }
+
+  auto processRange = [&](int it) {
+    auto& thread = *mThreads[it];
+    thread.clearOutput();
+    for (int ic = firstChip[it]; ic < firstChip[it + 1]; ic++) {
+      thread.processChip(&mChipsBatch[ic], fullClus ? &thread.mFullClusters : nullptr, compClus ? &thread.mCompClusters : nullptr,
+                         labelsDig, labelsClus ? &thread.mLabels : nullptr, thread.mNClusters);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (int it = 1; it < nThreads; it++) {
+    workers.emplace_back(processRange, it);
+  }
+  processRange(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (int it = 0; it < nThreads; it++) {
+    const auto& thread = *mThreads[it];
+    if (fullClus) { // Cluster is not assignable, cannot use vector::insert
+      fullClus->reserve(fullClus->size() + thread.mFullClusters.size());
+      for (const auto& clus : thread.mFullClusters) {
+        fullClus->push_back(clus);
+      }
+    }
+    if (compClus) {
+      compClus->insert(compClus->end(), thread.mCompClusters.begin(), thread.mCompClusters.end());
+    }
+    if (labelsClus) {
+      for (int icl = 0; icl < thread.mLabels.getIndexedSize(); icl++) {
+        for (const auto& lbl : thread.mLabels.getLabels(icl)) {
+          labelsClus->addElement(mClustersCount + icl, lbl);
+        }
+      }
+    }
+    mClustersCount += thread.mNClusters;
+  }
+
+  if (mMaxBCSeparationToMask > 0) { // chips data will be used in the next ROF to mask overflow pixels
+    for (int ic = 0; ic < mNChipsBatch; ic++) {
+      mChipsOld[mChipsBatch[ic].getChipID()].swap(mChipsBatch[ic]);
+    }
+  }
+  mNChipsBatch = 0;
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::processChip(ChipPixelData* chipData, std::vector<Cluster>* fullClus,
+                                             std::vector<CompClusterExt>* compClus, const MCTruth* labelsDig,
+                                             MCTruth* labelsClus, int& clustersCount)
+{
+  mChipData = chipData;
+  if (mParent->mUseBitmaskLabeling) {
+    processChipBitmask(fullClus, compClus, labelsDig, labelsClus, clustersCount);
+    return;
+  }
+  auto validPixID = mChipData->getFirstUnmasked();
+  if (validPixID < mChipData->getData().size()) { // chip data may have all of its pixels masked!
+    initChip(validPixID++);
+    for (; validPixID < mChipData->getData().size(); validPixID++) {
+      if (!mChipData->getData()[validPixID].isMasked()) {
+        updateChip(validPixID);
+      }
+    }
+    finishChip(fullClus, compClus, labelsDig, labelsClus, clustersCount);
+  }
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::initChip(UInt_t first)
 {
   // init chip with the 1st unmasked pixel (entry "from" in the mChipData)
   mPrev = mColumn1 + 1;
@@ -145,7 +261,7 @@ void Clusterer::initChip(UInt_t first)
 }
 
 //__________________________________________________
-void Clusterer::updateChip(UInt_t ip)
+void Clusterer::ClustererThread::updateChip(UInt_t ip)
 {
   const auto pix = mChipData->getData()[ip];
   UShort_t row = pix.getRowDirect(); // can use getRowDirect since the pixel is not masked
@@ -196,12 +312,9 @@ void Clusterer::updateChip(UInt_t ip)
 }
 
 //__________________________________________________
-void Clusterer::finishChip(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
-                           const MCTruth* labelsDig, MCTruth* labelsClus)
+void Clusterer::ClustererThread::finishChip(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                                            const MCTruth* labelsDig, MCTruth* labelsClus, int& clustersCount)
 {
-  constexpr Float_t SigmaX2 = Segmentation::PitchRow * Segmentation::PitchRow / 12.; // FIXME
-  constexpr Float_t SigmaY2 = Segmentation::PitchCol * Segmentation::PitchCol / 12.; // FIXME
-
   const auto& pixData = mChipData->getData();
 
   for (int i1 = 0; i1 < mPreClusterHeads.size(); ++i1) {
@@ -249,73 +362,225 @@ void Clusterer::finishChip(std::vector<Cluster>* fullClus, std::vector<CompClust
       }
       mPreClusterIndices[i2] = -1;
     }
-    UShort_t rowSpan = rowMax - rowMin + 1, colSpan = colMax - colMin + 1;
-    Cluster clus;
-    clus.setROFrame(mChipData->getROFrame());
-    clus.setSensorID(mChipData->getChipID());
-    clus.setNxNzN(rowSpan, colSpan, npix);
+    storeCluster(npix, rowMin, rowMax, colMin, colMax, nlab, fullClus, compClus, labelsClus, clustersCount);
+  }
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::storeCluster(int npix, UShort_t rowMin, UShort_t rowMax, UShort_t colMin, UShort_t colMax,
+                                              int nlab, std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                                              MCTruth* labelsClus, int& clustersCount)
+{
+  // store the cluster made of the npix pixels in mPixArrBuff with the nlab labels in mLabelsBuff
+  constexpr Float_t SigmaX2 = Segmentation::PitchRow * Segmentation::PitchRow / 12.; // FIXME
+  constexpr Float_t SigmaY2 = Segmentation::PitchCol * Segmentation::PitchCol / 12.; // FIXME
+
+  UShort_t rowSpan = rowMax - rowMin + 1, colSpan = colMax - colMin + 1;
+  Cluster clus;
+  clus.setROFrame(mChipData->getROFrame());
+  clus.setSensorID(mChipData->getChipID());
+  clus.setNxNzN(rowSpan, colSpan, npix);
 #ifdef _ClusterTopology_
-    UShort_t colSpanW = colSpan, rowSpanW = rowSpan;
-    if (colSpan * rowSpan > Cluster::kMaxPatternBits) { // need to store partial info
-      // will curtail largest dimension
-      if (colSpan > rowSpan) {
-        if ((colSpanW = Cluster::kMaxPatternBits / rowSpan) == 0) {
-          colSpanW = 1;
-          rowSpanW = Cluster::kMaxPatternBits;
-        }
-      } else {
-        if ((rowSpanW = Cluster::kMaxPatternBits / colSpan) == 0) {
-          rowSpanW = 1;
-          colSpanW = Cluster::kMaxPatternBits;
-        }
+  UShort_t colSpanW = colSpan, rowSpanW = rowSpan;
+  if (colSpan * rowSpan > Cluster::kMaxPatternBits) { // need to store partial info
+    // will curtail largest dimension
+    if (colSpan > rowSpan) {
+      if ((colSpanW = Cluster::kMaxPatternBits / rowSpan) == 0) {
+        colSpanW = 1;
+        rowSpanW = Cluster::kMaxPatternBits;
+      }
+    } else {
+      if ((rowSpanW = Cluster::kMaxPatternBits / colSpan) == 0) {
+        rowSpanW = 1;
+        colSpanW = Cluster::kMaxPatternBits;
+      }
+    }
+  }
+  clus.setPatternRowSpan(rowSpanW, rowSpanW < rowSpan);
+  clus.setPatternColSpan(colSpanW, colSpanW < colSpan);
+  clus.setPatternRowMin(rowMin);
+  clus.setPatternColMin(colMin);
+  for (int i = 0; i < npix; i++) {
+    const auto pix = mPixArrBuff[i];
+    unsigned short ir = pix.getRowDirect() - rowMin, ic = pix.getCol() - colMin;
+    if (ir < rowSpanW && ic < colSpanW) {
+      clus.setPixel(ir, ic);
+    }
+  }
+#endif            //_ClusterTopology_
+  if (fullClus) { // do we need conventional clusters with full topology and coordinates?
+    fullClus->push_back(clus);
+    Cluster& c = fullClus->back();
+    Float_t x = 0., z = 0.;
+    for (int i = npix; i--;) {
+      x += mPixArrBuff[i].getRowDirect();
+      z += mPixArrBuff[i].getCol();
+    }
+    Point3D<float> xyzLoc;
+    Segmentation::detectorToLocalUnchecked(x / npix, z / npix, xyzLoc);
+    auto xyzTra = mParent->mGeometry->getMatrixT2L(mChipData->getChipID()) ^ (xyzLoc); // inverse transform from Local to Tracking frame
+    c.setPos(xyzTra);
+    c.setErrors(SigmaX2, SigmaY2, 0.f);
+  }
+
+  if (compClus) { // store compact clusters
+    unsigned char patt[Cluster::kMaxPatternBytes];
+    clus.getPattern(&patt[0], Cluster::kMaxPatternBytes);
+    UShort_t pattID = mParent->mPattIdConverter.findGroupID(clus.getPatternRowSpan(), clus.getPatternColSpan(), patt);
+    compClus->emplace_back(rowMin, colMin, pattID, mChipData->getChipID(), mChipData->getROFrame());
+  }
+
+  if (labelsClus) { // MC labels were requested
+    for (int i = nlab; i--;) {
+      labelsClus->addElement(clustersCount, mLabelsBuff[i]);
+    }
+  }
+
+  clustersCount++;
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::processChipBitmask(std::vector<Cluster>* fullClus, std::vector<CompClusterExt>* compClus,
+                                                    const MCTruth* labelsDig, MCTruth* labelsClus, int& clustersCount)
+{
+  // Label the connected pixels column by column: the unmasked pixels of a column are packed into the
+  // NRows bits of mColumnBits, from which the runs of contiguous rows are extracted word by word. Runs of
+  // adjacent columns which touch (also diagonally) are merged with a union-find. The clusters are stored
+  // in the order of their first pixel, as in the pixel by pixel labeling.
+  const auto& pixData = mChipData->getData();
+  const UInt_t nPix = pixData.size();
+  UInt_t ip = mChipData->getFirstUnmasked();
+  if (ip >= nPix) { // chip data may have all of its pixels masked!
+    return;
+  }
+  mRuns.clear();
+  mPixelRun.assign(nPix, -1);
+
+  int prevFirst = 0, prevLast = 0; // runs of the previous column with fired pixels
+  int prevCol = -2;
+  while (ip < nPix) {
+    const UShort_t col = pixData[ip].getCol();
+    UInt_t colEnd = ip;
+    for (; colEnd < nPix && pixData[colEnd].getCol() == col; colEnd++) {
+      const auto pix = pixData[colEnd];
+      if (!pix.isMasked()) {
+        const auto row = pix.getRowDirect();
+        mColumnBits[row >> 6] |= 0x1UL << (row & 0x3f);
       }
     }
-    clus.setPatternRowSpan(rowSpanW, rowSpanW < rowSpan);
-    clus.setPatternColSpan(colSpanW, colSpanW < colSpan);
-    clus.setPatternRowMin(rowMin);
-    clus.setPatternColMin(colMin);
-    for (int i = 0; i < npix; i++) {
-      const auto pix = mPixArrBuff[i];
-      unsigned short ir = pix.getRowDirect() - rowMin, ic = pix.getCol() - colMin;
-      if (ir < rowSpanW && ic < colSpanW) {
-        clus.setPixel(ir, ic);
+    const int curFirst = mRuns.size();
+    extractRuns();
+    const int curLast = mRuns.size();
+    if (curFirst == curLast) { // all pixels of the column are masked
+      ip = colEnd;
+      continue;
+    }
+    // the pixels are sorted in row, so are the runs
+    for (int ir = curFirst; ip < colEnd; ip++) {
+      const auto pix = pixData[ip];
+      if (pix.isMasked()) {
+        continue;
+      }
+      while (mRuns[ir].rowMax < pix.getRowDirect()) {
+        ir++;
       }
+      mPixelRun[ip] = ir;
     }
-#endif              //_ClusterTopology_
-    if (fullClus) { // do we need conventional clusters with full topology and coordinates?
-      fullClus->push_back(clus);
-      Cluster& c = fullClus->back();
-      Float_t x = 0., z = 0.;
-      for (int i = npix; i--;) {
-        x += mPixArrBuff[i].getRowDirect();
-        z += mPixArrBuff[i].getCol();
+    if (col == prevCol + 1) { // merge with the runs of the previous column overlapping after extension by 1 row
+      int jp = prevFirst;
+      for (int jc = curFirst; jc < curLast; jc++) {
+        const auto& run = mRuns[jc];
+        while (jp < prevLast && mRuns[jp].rowMax + 1 < run.rowMin) {
+          jp++;
+        }
+        for (int k = jp; k < prevLast && mRuns[k].rowMin <= run.rowMax + 1; k++) {
+          uniteRuns(k, jc);
+        }
       }
-      Point3D<float> xyzLoc;
-      Segmentation::detectorToLocalUnchecked(x / npix, z / npix, xyzLoc);
-      auto xyzTra = mGeometry->getMatrixT2L(mChipData->getChipID()) ^ (xyzLoc); // inverse transform from Local to Tracking frame
-      c.setPos(xyzTra);
-      c.setErrors(SigmaX2, SigmaY2, 0.f);
     }
+    prevFirst = curFirst;
+    prevLast = curLast;
+    prevCol = col;
+  }
 
-    if (compClus) { // store compact clusters
-      unsigned char patt[Cluster::kMaxPatternBytes];
-      clus.getPattern(&patt[0], Cluster::kMaxPatternBytes);
-      UShort_t pattID = mPattIdConverter.findGroupID(clus.getPatternRowSpan(), clus.getPatternColSpan(), patt);
-      compClus->emplace_back(rowMin, colMin, pattID, mChipData->getChipID(), mChipData->getROFrame());
+  // number the clusters in the order of their root runs, which contain their first pixels
+  const int nRuns = mRuns.size();
+  mRunCluster.resize(nRuns);
+  int nClusters = 0;
+  for (int ir = 0; ir < nRuns; ir++) {
+    const int root = findRoot(ir);
+    mRunCluster[ir] = root == ir ? nClusters++ : mRunCluster[root];
+  }
+  // group the pixel entries by cluster
+  mClusterPixelsEnd.assign(nClusters + 1, 0);
+  for (UInt_t i = 0; i < nPix; i++) {
+    if (mPixelRun[i] >= 0) {
+      mClusterPixelsEnd[mRunCluster[mPixelRun[i]] + 1]++;
+    }
+  }
+  for (int ic = 0; ic < nClusters; ic++) {
+    mClusterPixelsEnd[ic + 1] += mClusterPixelsEnd[ic];
+  }
+  mClusterPixels.resize(mClusterPixelsEnd[nClusters]);
+  for (UInt_t i = 0; i < nPix; i++) {
+    if (mPixelRun[i] >= 0) {
+      mClusterPixels[mClusterPixelsEnd[mRunCluster[mPixelRun[i]]]++] = i;
     }
+  }
+  // mClusterPixelsEnd[ic] is now the end of the cluster ic
 
-    if (labelsClus) { // MC labels were requested
-      for (int i = nlab; i--;) {
-        labelsClus->addElement(mClustersCount, mLabelsBuff[i]);
+  for (int ic = 0, first = 0; ic < nClusters; first = mClusterPixelsEnd[ic++]) {
+    UShort_t rowMax = 0, rowMin = 65535;
+    UShort_t colMax = 0, colMin = 65535;
+    int nlab = 0, npix = 0;
+    for (int i = first; i < mClusterPixelsEnd[ic]; i++) {
+      if (npix == mPixArrBuff.size()) {
+        LOG(ERROR) << "Cluster size " << mClusterPixelsEnd[ic] - first << " exceeds the buffer size" << FairLogger::endl;
+        break;
+      }
+      const auto pix = pixData[mClusterPixels[i]];
+      mPixArrBuff[npix++] = pix; // needed for cluster topology
+      adjustBoundingBox(pix, rowMin, rowMax, colMin, colMax);
+      if (labelsClus) { // the MCtruth for this pixel is at mChipData->startID+mClusterPixels[i]
+        fetchMCLabels(mClusterPixels[i] + mChipData->getStartID(), labelsDig, nlab);
       }
     }
+    storeCluster(npix, rowMin, rowMax, colMin, colMax, nlab, fullClus, compClus, labelsClus, clustersCount);
+  }
+}
 
-    mClustersCount++;
+//__________________________________________________
+void Clusterer::ClustererThread::extractRuns()
+{
+  // a run starts at a fired bit whose lower neighbour is not fired and ends at a fired bit
+  // whose upper neighbour is not fired, the neighbours in the adjacent words are accounted for
+  int firstOpen = mRuns.size(); // first run waiting for its end
+  uint64_t carry = 0;           // highest bit of the previous word
+  for (int iw = 0; iw < NColumnWords; iw++) {
+    const uint64_t bits = mColumnBits[iw];
+    if (!bits) {
+      carry = 0;
+      continue;
+    }
+    const uint64_t nextLow = iw + 1 < NColumnWords ? mColumnBits[iw + 1] & 0x1UL : 0;
+    uint64_t starts = bits & ~((bits << 1) | carry);
+    uint64_t ends = bits & ~((bits >> 1) | (nextLow << 63));
+    const UShort_t offset = iw << 6;
+    for (; starts; starts &= starts - 1) {
+      const int run = mRuns.size();
+      const UShort_t row = offset + __builtin_ctzll(starts);
+      mRuns.push_back(PixelRun{ row, row, run });
+    }
+    for (; ends; ends &= ends - 1) {
+      mRuns[firstOpen++].rowMax = offset + __builtin_ctzll(ends);
+    }
+    carry = bits >> 63;
+    mColumnBits[iw] = 0;
   }
 }
 
 //__________________________________________________
-void Clusterer::fetchMCLabels(int digID, const MCTruth* labelsDig, int& nfilled)
+void Clusterer::ClustererThread::fetchMCLabels(int digID, const MCTruth* labelsDig, int& nfilled)
 {
   // transfer MC labels to cluster
   if (nfilled >= Cluster::maxLabels) {
@@ -353,4 +618,6 @@ void Clusterer::print() const
 {
   // print settings
   printf("Mask overflow pixels in strobes separated by < %d BCs\n", mMaxBCSeparationToMask);
+  printf("Clusterize chips of a ROF with %d thread(s)\n", mNThreads);
+  printf("Label connected pixels %s\n", mUseBitmaskLabeling ? "on bit-packed columns" : "pixel by pixel");
 }
@@ -54,8 +54,18 @@ int LookUp::groupFinder(int nRow, int nCol)
   }
 }
 
-int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[Cluster::kMaxPatternBytes])
+int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[Cluster::kMaxPatternBytes]) const
 {
+  // Topology with a small bounding box: direct look-up
+  if (nRow <= TopologyDictionary::MaxSmallPatternSpan && nCol <= TopologyDictionary::MaxSmallPatternSpan) {
+    int ID = mDictionary.GetSmallTopologyID(nRow, nCol, patt);
+    if (ID >= 0)
+      return ID;
+    else { // small rare topology (inside groups)
+      int index = groupFinder(nRow, nCol);
+      return (mTopologiesOverThreshold + index);
+    }
+  }
   int nBits = nRow * nCol;
   // Small topology
   if (nBits < 9) {
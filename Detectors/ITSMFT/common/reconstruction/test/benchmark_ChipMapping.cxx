@@ -0,0 +1,67 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+
+#include "ITSMFTReconstruction/ChipMappingITS.h"
+#include "ITSMFTReconstruction/ChipMappingMFT.h"
+
+using namespace o2::itsmft;
+
+// SW chip ID -> RU and chip on RU, as in the raw data encoding
+static void BM_ITSChipInfoSW(benchmark::State& state)
+{
+  ChipMappingITS mapping;
+  ChipInfo chInfo;
+  for (auto _ : state) {
+    for (int chip = 0; chip < mapping.getNChips(); chip++) {
+      mapping.getChipInfoSW(chip, chInfo);
+      benchmark::DoNotOptimize(chInfo.chOnRU);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mapping.getNChips());
+}
+
+// RU, cable and chip on module -> SW chip ID, as in the raw data decoding
+static void BM_ITSGlobalChipID(benchmark::State& state)
+{
+  ChipMappingITS mapping;
+  int nChips = 0;
+  for (auto _ : state) {
+    nChips = 0;
+    for (int ru = 0; ru < mapping.getNRUs(); ru++) {
+      const auto& ruInfo = *mapping.getRUInfoSW(ru);
+      for (int chip = 0; chip < mapping.getNChipsOnRUType(ruInfo.ruType); chip++) {
+        const auto chOnRU = mapping.getChipOnRUInfo(ruInfo.ruType, chip);
+        benchmark::DoNotOptimize(mapping.getGlobalChipID(chOnRU->chipOnModuleHW, chOnRU->cableHW, ruInfo));
+        nChips++;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nChips);
+}
+
+static void BM_MFTChipID2Module(benchmark::State& state)
+{
+  ChipMappingMFT mapping;
+  int chipInModule;
+  for (auto _ : state) {
+    for (int chip = 0; chip < mapping.getNChips(); chip++) {
+      benchmark::DoNotOptimize(mapping.chipID2Module(chip, chipInModule));
+      benchmark::DoNotOptimize(mapping.chip2Layer(chip));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mapping.getNChips());
+}
+
+BENCHMARK(BM_ITSChipInfoSW);
+BENCHMARK(BM_ITSGlobalChipID);
+BENCHMARK(BM_MFTChipID2Module);
+
+BENCHMARK_MAIN();
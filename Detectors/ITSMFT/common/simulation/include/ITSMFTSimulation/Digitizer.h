@@ -16,9 +16,11 @@
 #include <vector>
 #include <deque>
 #include <memory>
+#include <mutex>
 
 #include "Rtypes.h"  // for Digitizer::Class, Double_t, ClassDef, etc
 #include "TObject.h" // for TObject
+#include "TRandom3.h"
 
 #include "ITSMFTSimulation/ChipDigitsContainer.h"
 #include "ITSMFTSimulation/AlpideSimResponse.h"
@@ -87,9 +89,23 @@ class Digitizer : public TObject
     mEventROFrameMax = 0;
   }
 
+  /// set number of threads for the processing of the hits of single event, the chips are shared between the threads.
+  /// With more than 1 thread each thread uses its own random generator seeded from gRandom in every event
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
  private:
-  void processHit(const o2::itsmft::Hit& hit, UInt_t& maxFr, int evID, int srcID);
-  void registerDigits(ChipDigitsContainer& chip, UInt_t roFrame, float tInROF, int nROF,
+  /// state of the hits processing, owned by the processing thread
+  struct HitsContext {
+    TRandom* random = nullptr;           ///< generator for the collected charge fluctuations
+    UInt_t roFrameMax = 0;               ///< highest RO frame affected by the processed hits
+    UInt_t eventROFrameMin = 0xffffffff; ///< lowest RO frame with registered signal
+    UInt_t eventROFrameMax = 0;          ///< highest RO frame with registered signal
+  };
+
+  void processHit(const o2::itsmft::Hit& hit, HitsContext& ctx, int evID, int srcID);
+  void processHitsParallel(const std::vector<Hit>& hits, const std::vector<int>& hitIdx, int evID, int srcID);
+  void registerDigits(ChipDigitsContainer& chip, HitsContext& ctx, UInt_t roFrame, float tInROF, int nROF,
                       UShort_t row, UShort_t col, int nEle, o2::MCCompLabel& lbl);
 
   ExtraDig* getExtraDigBuffer(UInt_t roFrame)
@@ -105,6 +121,7 @@ class Digitizer : public TObject
   }
 
   static constexpr float sec2ns = 1e9;
+  static constexpr int MinHitsPerThread = 100; ///< don't split events with less hits per thread
 
   o2::itsmft::DigiParams mParams;  ///< digitization parameters
   double mEventTime = 0;           ///< global event time
@@ -123,11 +140,15 @@ class Digitizer : public TObject
   std::vector<o2::itsmft::ChipDigitsContainer> mChips; ///< Array of chips digits containers
   std::deque<std::unique_ptr<ExtraDig>> mExtraBuff;    ///< burrer (per roFrame) for extra digits
 
+  int mNThreads = 1;                                   //! number of threads for the hits processing
+  std::vector<std::unique_ptr<TRandom3>> mRandomGens;  //! random generators of the threads
+  std::mutex mExtraBuffMutex;                          //! lock for the extra digits buffers in the multi-threaded mode
+
   std::vector<o2::itsmft::Digit>* mDigits = nullptr;                       //! output digits
   std::vector<o2::itsmft::ROFRecord>* mROFRecords = nullptr;               //! output ROF records
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mMCLabels = nullptr; //! output labels
 
-  ClassDefOverride(Digitizer, 2);
+  ClassDefOverride(Digitizer, 3);
 };
 }
 }
@@ -19,6 +19,7 @@
 #include "TVector3.h"     // for TVector3
 #include <iosfwd>
 #include "CommonUtils/ShmAllocator.h"
+#include "CommonUtils/CompactHits.h"
 
 namespace o2 {
 namespace itsmft {
@@ -78,6 +79,13 @@ class Hit : public o2::BasicXYZEHit<Float_t,Float_t>
     UChar_t GetStatusEnd()   const  { return mTrackStatusEnd; }
     UChar_t GetStatusStart() const  { return mTrackStatusStart; }
 
+    // setters of the entrance values (the compact hit format)
+    void SetPosStart(Float_t x, Float_t y, Float_t z) { mPosStart.SetXYZ(x, y, z); }
+    void SetMomentum(Float_t px, Float_t py, Float_t pz) { mMomentum.SetXYZ(px, py, pz); }
+    void SetE(Float_t e) { mE = e; }
+    void SetStatusEnd(UChar_t status) { mTrackStatusEnd = status; }
+    void SetStatusStart(UChar_t status) { mTrackStatusStart = status; }
+
     Bool_t IsEntering()      const  { return mTrackStatusEnd & kTrackEntering; }
     Bool_t IsInside()        const  { return mTrackStatusEnd & kTrackInside; }
     Bool_t IsExiting()       const  { return mTrackStatusEnd & kTrackExiting; }
@@ -130,6 +138,78 @@ Hit::Hit(int trackID, unsigned short detID, const TVector3& startPos, const TVec
 }
 }
 
+namespace o2
+{
+namespace utils
+{
+/// compact format of the ITSMFT hits: the basic columns, the entrance position (fixed columns 4-6),
+/// momentum and energy (raw columns 1-4) and the status at entrance and exit (integer column 2)
+template <>
+struct CompactHitCodec<o2::itsmft::Hit> : BasicHitCodec<o2::itsmft::Hit> {
+  using Base = BasicHitCodec<o2::itsmft::Hit>;
+
+  template <typename Container>
+  static void split(Container const& hits, HitColumns& columns, CompactHitPrecision const& precision)
+  {
+    Base::split(hits, columns, precision);
+    const size_t n = hits.size();
+    columns.resize(NFixed + 3, NRaw + 4, NInt + 1);
+    for (size_t c = NFixed; c < NFixed + 3; c++) {
+      columns.fixed[c].precision = precision.position;
+      columns.fixed[c].values.resize(n);
+    }
+    for (size_t c = NRaw; c < NRaw + 4; c++) {
+      columns.raw[c].resize(n);
+    }
+    columns.ints[NInt].resize(n);
+    for (size_t i = 0; i < n; i++) {
+      auto& hit = hits[i];
+      columns.fixed[NFixed].values[i] = hit.GetStartX();
+      columns.fixed[NFixed + 1].values[i] = hit.GetStartY();
+      columns.fixed[NFixed + 2].values[i] = hit.GetStartZ();
+      columns.raw[NRaw][i] = HitColumns::toRaw(hit.GetPx());
+      columns.raw[NRaw + 1][i] = HitColumns::toRaw(hit.GetPy());
+      columns.raw[NRaw + 2][i] = HitColumns::toRaw(hit.GetPz());
+      columns.raw[NRaw + 3][i] = HitColumns::toRaw(hit.GetE());
+      columns.ints[NInt][i] = hit.GetStatusStart() | (hit.GetStatusEnd() << 8);
+    }
+  }
+
+  template <typename Container>
+  static bool merge(HitColumns const& columns, Container& hits)
+  {
+    if (!Base::merge(columns, hits)) {
+      return false;
+    }
+    const size_t n = hits.size();
+    for (size_t c = NFixed; c < NFixed + 3; c++) {
+      if (columns.fixed[c].values.size() != n) {
+        return false;
+      }
+    }
+    for (size_t c = NRaw; c < NRaw + 4; c++) {
+      if (columns.raw[c].size() != n) {
+        return false;
+      }
+    }
+    if (columns.ints[NInt].size() != n) {
+      return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+      auto& hit = hits[i];
+      hit.SetPosStart(columns.fixed[NFixed].values[i], columns.fixed[NFixed + 1].values[i], columns.fixed[NFixed + 2].values[i]);
+      hit.SetMomentum(HitColumns::fromRaw<Float_t>(columns.raw[NRaw][i]), HitColumns::fromRaw<Float_t>(columns.raw[NRaw + 1][i]),
+                      HitColumns::fromRaw<Float_t>(columns.raw[NRaw + 2][i]));
+      hit.SetE(HitColumns::fromRaw<Float_t>(columns.raw[NRaw + 3][i]));
+      hit.SetStatusStart(columns.ints[NInt][i] & 0xff);
+      hit.SetStatusEnd((columns.ints[NInt][i] >> 8) & 0xff);
+    }
+    return true;
+  }
+};
+} // namespace utils
+} // namespace o2
+
 #ifdef USESHM
 namespace std
 {
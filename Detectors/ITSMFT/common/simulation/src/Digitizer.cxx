@@ -21,6 +21,7 @@
 #include <climits>
 #include <vector>
 #include <numeric>
+#include <thread>
 #include "FairLogger.h" // for LOG
 
 using o2::itsmft::Hit;
@@ -70,8 +71,16 @@ void Digitizer::process(const std::vector<Hit>* hits, int evID, int srcID)
             [hits](auto lhs, auto rhs) {
               return (*hits)[lhs].GetDetectorID() < (*hits)[rhs].GetDetectorID();
             });
-  for (int i : hitIdx) {
-    processHit((*hits)[i], mROFrameMax, evID, srcID);
+  if (mNThreads > 1 && nHits >= 2 * MinHitsPerThread) {
+    processHitsParallel(*hits, hitIdx, evID, srcID);
+  } else {
+    HitsContext ctx{ gRandom, mROFrameMax, mEventROFrameMin, mEventROFrameMax };
+    for (int i : hitIdx) {
+      processHit((*hits)[i], ctx, evID, srcID);
+    }
+    mROFrameMax = ctx.roFrameMax;
+    mEventROFrameMin = ctx.eventROFrameMin;
+    mEventROFrameMax = ctx.eventROFrameMax;
   }
   // in the triggered mode store digits after every MC event
   // TODO: in the real triggered mode this will not be needed, this is actually for the
@@ -178,7 +187,52 @@ void Digitizer::fillOutputContainer(UInt_t frameLast)
 }
 
 //_______________________________________________________________________
-void Digitizer::processHit(const o2::itsmft::Hit& hit, UInt_t& maxFr, int evID, int srcID)
+void Digitizer::processHitsParallel(const std::vector<Hit>& hits, const std::vector<int>& hitIdx, int evID, int srcID)
+{
+  // process the hits sorted in chip ID on multiple threads, every chip being processed by single thread
+  int nHits = hitIdx.size();
+  int nThreads = std::min(mNThreads, nHits / MinHitsPerThread);
+  while (int(mRandomGens.size()) < nThreads) {
+    mRandomGens.emplace_back(std::make_unique<TRandom3>());
+  }
+  std::vector<HitsContext> contexts(nThreads);
+  std::vector<int> rangeStart(nThreads + 1, nHits);
+  rangeStart[0] = 0;
+  for (int ith = 0; ith < nThreads; ith++) {
+    if (ith) { // move the range boundary to the 1st hit of the next chip
+      int start = std::max(ith * nHits / nThreads, rangeStart[ith - 1]);
+      while (start > 0 && start < nHits && hits[hitIdx[start]].GetDetectorID() == hits[hitIdx[start - 1]].GetDetectorID()) {
+        start++;
+      }
+      rangeStart[ith] = start;
+    }
+    mRandomGens[ith]->SetSeed(1 + gRandom->Integer(0x7fffffff)); // seed 0 would be randomized by TRandom3
+    contexts[ith].random = mRandomGens[ith].get();
+    contexts[ith].roFrameMax = mROFrameMax;
+  }
+  auto worker = [this, &hits, &hitIdx, &rangeStart, &contexts, evID, srcID](int ith) {
+    for (int i = rangeStart[ith]; i < rangeStart[ith + 1]; i++) {
+      processHit(hits[hitIdx[i]], contexts[ith], evID, srcID);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads - 1);
+  for (int ith = 1; ith < nThreads; ith++) {
+    threads.emplace_back(worker, ith);
+  }
+  worker(0);
+  for (auto& th : threads) {
+    th.join();
+  }
+  for (const auto& ctx : contexts) {
+    mROFrameMax = std::max(mROFrameMax, ctx.roFrameMax);
+    mEventROFrameMin = std::min(mEventROFrameMin, ctx.eventROFrameMin);
+    mEventROFrameMax = std::max(mEventROFrameMax, ctx.eventROFrameMax);
+  }
+}
+
+//_______________________________________________________________________
+void Digitizer::processHit(const o2::itsmft::Hit& hit, HitsContext& ctx, int evID, int srcID)
 {
   // convert single hit to digits
 
@@ -194,8 +248,8 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, UInt_t& maxFr, int evID,
   // frame of the hit signal end: in the triggered mode we read just 1 frame
   UInt_t roFrameMax = mParams.isContinuous() ? UInt_t((hTime0 + tTot) * mParams.getROFrameLengthInv()) : roFrame;
   int nFrames = roFrameMax + 1 - roFrame;
-  if (roFrameMax > maxFr) {
-    maxFr = roFrameMax; // if signal extends beyond current maxFrame, increase the latter
+  if (roFrameMax > ctx.roFrameMax) {
+    ctx.roFrameMax = roFrameMax; // if signal extends beyond current maxFrame, increase the latter
   }
   // delay of the signal start wrt 1st ROF start
   float timeInROF = float(hTime0 - (roFrame * mParams.getROFrameLength()));
@@ -291,17 +345,14 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, UInt_t& maxFr, int evID,
       continue;
     }
 
-    for (int irow = AlpideRespSimMat::NPix; irow--;) {
-      int rowDest = row + irow - AlpideRespSimMat::NPix / 2 - rowS; // destination row in the respMatrix
-      if (rowDest < 0 || rowDest >= rowSpan) {
-        continue;
-      }
-      for (int icol = AlpideRespSimMat::NPix; icol--;) {
-        int colDest = col + icol - AlpideRespSimMat::NPix / 2 - colS; // destination column in the respMatrix
-        if (colDest < 0 || colDest >= colSpan) {
-          continue;
-        }
-        respMatrix[rowDest][colDest] += rspmat->getValue(irow, icol, flipRow, flipCol);
+    // restrict the response matrix cells to those falling into the respMatrix
+    int rowOffs = row - AlpideRespSimMat::NPix / 2 - rowS, colOffs = col - AlpideRespSimMat::NPix / 2 - colS;
+    int irowMin = std::max(0, -rowOffs), irowMax = std::min(int(AlpideRespSimMat::NPix), rowSpan - rowOffs);
+    int icolMin = std::max(0, -colOffs), icolMax = std::min(int(AlpideRespSimMat::NPix), colSpan - colOffs);
+    for (int irow = irowMin; irow < irowMax; irow++) {
+      float* respRow = respMatrix[irow + rowOffs]; // destination row in the respMatrix
+      for (int icol = icolMin; icol < icolMax; icol++) {
+        respRow[icol + colOffs] += rspmat->getValue(irow, icol, flipRow, flipCol);
       }
     }
   }
@@ -317,20 +368,20 @@ void Digitizer::processHit(const o2::itsmft::Hit& hit, UInt_t& maxFr, int evID,
       if (!nEleResp) {
         continue;
       }
-      int nEle = gRandom->Poisson(nElectrons * nEleResp); // total charge in given pixel
+      int nEle = ctx.random->Poisson(nElectrons * nEleResp); // total charge in given pixel
       // ignore charge which have no chance to fire the pixel
       if (nEle < mParams.getMinChargeToAccount()) {
         continue;
       }
       UShort_t colIS = icol + colS;
       //
-      registerDigits(chip, roFrame, timeInROF, nFrames, rowIS, colIS, nEle, lbl);
+      registerDigits(chip, ctx, roFrame, timeInROF, nFrames, rowIS, colIS, nEle, lbl);
     }
   }
 }
 
 //________________________________________________________________________________
-void Digitizer::registerDigits(ChipDigitsContainer& chip, UInt_t roFrame, float tInROF, int nROF,
+void Digitizer::registerDigits(ChipDigitsContainer& chip, HitsContext& ctx, UInt_t roFrame, float tInROF, int nROF,
                                UShort_t row, UShort_t col, int nEle, o2::MCCompLabel& lbl)
 {
   // Register digits for given pixel, accounting for the possible signal contribution to
@@ -347,10 +398,10 @@ void Digitizer::registerDigits(ChipDigitsContainer& chip, UInt_t roFrame, float
     if (nEleROF < mParams.getMinChargeToAccount()) {
       continue;
     }
-    if (roFr > mEventROFrameMax)
-      mEventROFrameMax = roFr;
-    if (roFr < mEventROFrameMin)
-      mEventROFrameMin = roFr;
+    if (roFr > ctx.eventROFrameMax)
+      ctx.eventROFrameMax = roFr;
+    if (roFr < ctx.eventROFrameMin)
+      ctx.eventROFrameMin = roFr;
     auto key = chip.getOrderingKey(roFr, row, col);
     PreDigit* pd = chip.findDigit(key);
     if (!pd) {
@@ -360,6 +411,11 @@ void Digitizer::registerDigits(ChipDigitsContainer& chip, UInt_t roFrame, float
       if (pd->labelRef.label == lbl) { // don't store the same label twice
         continue;
       }
+      // the extra digits buffers are shared by all chips
+      std::unique_lock<std::mutex> lock(mExtraBuffMutex, std::defer_lock);
+      if (mNThreads > 1) {
+        lock.lock();
+      }
       ExtraDig* extra = getExtraDigBuffer(roFr);
       int& nxt = pd->labelRef.next;
       bool skip = false;
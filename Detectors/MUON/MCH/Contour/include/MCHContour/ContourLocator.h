@@ -0,0 +1,150 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_MCH_CONTOUR_CONTOURLOCATOR_H
+#define O2_MCH_CONTOUR_CONTOURLOCATOR_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "Contour.h"
+#include "Polygon.h"
+#include "Vertex.h"
+
+namespace o2
+{
+namespace mch
+{
+namespace contour
+{
+
+/// A ContourLocator answers point-in-contour queries in logarithmic time.
+///
+/// The plane is cut into horizontal slabs at the ordinates of the vertices. Within
+/// one slab the (non horizontal) edges it crosses do not intersect each other, hence
+/// they are stored sorted by abscissa : a query is one binary search for the slab and
+/// one for the number of edges on the left of the point, whose parity tells whether
+/// the point is inside. The crossing abscissa is computed as in Polygon::contains,
+/// so that both give the same answer for a point on an edge as well.
+///
+/// The parity is that of the edges of all the polygons : a point within a polygon
+/// which is inside another one (a hole) is outside. For contours of disjoint polygons
+/// this is the same as Contour::contains.
+template <typename T>
+class ContourLocator
+{
+ public:
+  explicit ContourLocator(const Contour<T>& contour) : ContourLocator(contour.getPolygons()) {}
+
+  explicit ContourLocator(const Polygon<T>& polygon) : ContourLocator(std::vector<Polygon<T>>{ polygon }) {}
+
+  explicit ContourLocator(const std::vector<Polygon<T>>& polygons);
+
+  bool contains(T x, T y) const;
+
+  /// contains for each of the points (any container of Vertex<T>)
+  template <typename Points>
+  std::vector<bool> contains(const Points& points) const
+  {
+    std::vector<bool> inside;
+    inside.reserve(points.size());
+    for (const auto& p : points) {
+      inside.push_back(contains(p.x, p.y));
+    }
+    return inside;
+  }
+
+  int nofSlabs() const { return mSlabOffsets.empty() ? 0 : mSlabOffsets.size() - 1; }
+
+ private:
+  /// an edge from the vertex "to" back to the previous vertex "from" of its polygon
+  struct SlabEdge {
+    Vertex<T> to;
+    Vertex<T> from;
+    T xAt(T y) const { return to.x + (y - to.y) / (from.y - to.y) * (from.x - to.x); }
+  };
+
+  std::vector<T> mY;             // ordinates of the vertices, sorted and unique
+  std::vector<int> mSlabOffsets; // first edge of each slab (mY[i], mY[i+1]] (+ total)
+  std::vector<SlabEdge> mEdges;  // edges crossing each slab, sorted by abscissa
+};
+
+template <typename T>
+ContourLocator<T>::ContourLocator(const std::vector<Polygon<T>>& polygons)
+{
+  std::vector<SlabEdge> edges;
+  for (const auto& p : polygons) {
+    if (!p.isClosed()) {
+      throw std::invalid_argument("ContourLocator can only work with closed polygons");
+    }
+    for (auto i = 1; i < p.size(); ++i) {
+      mY.push_back(p[i].y);
+      if (p[i].y != p[i - 1].y) {
+        edges.push_back({ p[i], p[i - 1] });
+      }
+    }
+  }
+  std::sort(mY.begin(), mY.end());
+  mY.erase(std::unique(mY.begin(), mY.end()), mY.end());
+  if (mY.size() < 2) {
+    return;
+  }
+
+  // the slabs of each edge, first counted then filled
+  auto slabRange = [this](const SlabEdge& e, int& first, int& last) {
+    first = std::lower_bound(mY.begin(), mY.end(), std::min(e.to.y, e.from.y)) - mY.begin();
+    last = std::lower_bound(mY.begin(), mY.end(), std::max(e.to.y, e.from.y)) - mY.begin();
+  };
+  const int nofSlabs = mY.size() - 1;
+  mSlabOffsets.assign(nofSlabs + 1, 0);
+  int first, last;
+  for (const auto& e : edges) {
+    slabRange(e, first, last);
+    for (auto s = first; s < last; ++s) {
+      ++mSlabOffsets[s + 1];
+    }
+  }
+  for (auto s = 0; s < nofSlabs; ++s) {
+    mSlabOffsets[s + 1] += mSlabOffsets[s];
+  }
+  mEdges.resize(mSlabOffsets.back());
+  std::vector<int> next(mSlabOffsets.begin(), mSlabOffsets.end() - 1);
+  for (const auto& e : edges) {
+    slabRange(e, first, last);
+    for (auto s = first; s < last; ++s) {
+      mEdges[next[s]++] = e;
+    }
+  }
+  for (auto s = 0; s < nofSlabs; ++s) {
+    T ymid = (mY[s] + mY[s + 1]) / 2;
+    std::sort(mEdges.begin() + mSlabOffsets[s], mEdges.begin() + mSlabOffsets[s + 1],
+              [ymid](const SlabEdge& a, const SlabEdge& b) { return a.xAt(ymid) < b.xAt(ymid); });
+  }
+}
+
+template <typename T>
+bool ContourLocator<T>::contains(T x, T y) const
+{
+  // the slab (mY[s], mY[s+1]] of y, matching the edge selection of Polygon::contains
+  if (mSlabOffsets.empty() || !(y > mY.front() && y <= mY.back())) {
+    return false;
+  }
+  auto s = std::lower_bound(mY.begin(), mY.end(), y) - mY.begin() - 1;
+  auto first = mEdges.begin() + mSlabOffsets[s];
+  auto last = mEdges.begin() + mSlabOffsets[s + 1];
+  auto nofLeftEdges = std::partition_point(first, last, [x, y](const SlabEdge& e) { return e.xAt(y) < x; }) - first;
+  return nofLeftEdges % 2 == 1;
+}
+
+} // namespace contour
+} // namespace mch
+} // namespace o2
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MCHContour ContourLocator
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include "../include/MCHContour/ContourLocator.h"
+
+using namespace o2::mch::contour;
+
+struct CONTOURS {
+  Polygon<double> polygon{
+    { { -5.0, 10.0 }, { -5.0, -2.0 }, { 0.0, -2.0 }, { 0.0, -10.0 }, { 5.0, -10.0 }, { 5.0, 10.0 }, { -5.0, 10.0 } }
+  };
+  Contour<double> contour{ { { 0.1, 0.1 }, { 1.1, 0.1 }, { 1.1, 1.1 }, { 2.1, 1.1 }, { 2.1, 3.1 }, { 1.1, 3.1 }, { 1.1, 2.1 }, { 0.1, 2.1 }, { 0.1, 0.1 } },
+                           { { 3.0, 0.0 }, { 4.0, 0.0 }, { 4.0, 4.0 }, { 3.0, 4.0 }, { 3.0, 0.0 } },
+                           { { -2.0, 1.0 }, { -1.0, 0.5 }, { -0.5, 3.0 }, { -2.0, 1.0 } } };
+};
+
+BOOST_AUTO_TEST_SUITE(o2_mch_contour)
+
+BOOST_FIXTURE_TEST_SUITE(contourlocator, CONTOURS)
+
+BOOST_AUTO_TEST_CASE(ContainsIsTheSameAsForThePolygon)
+{
+  ContourLocator<double> locator(polygon);
+  BOOST_CHECK_EQUAL(locator.nofSlabs(), 2);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> coordinate(-12., 12.);
+  for (int i = 0; i < 10000; ++i) {
+    double x = coordinate(generator), y = coordinate(generator);
+    BOOST_CHECK_EQUAL(locator.contains(x, y), polygon.contains(x, y));
+  }
+  // on the edges and vertices
+  for (double x = -6; x <= 6; x += 0.5) {
+    for (double y = -11; y <= 11; y += 0.5) {
+      BOOST_CHECK_EQUAL(locator.contains(x, y), polygon.contains(x, y));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ContainsIsTheSameAsForTheContour)
+{
+  ContourLocator<double> locator(contour);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> coordinate(-3., 5.);
+  std::vector<Vertex<double>> points;
+  for (int i = 0; i < 10000; ++i) {
+    points.push_back({ coordinate(generator), coordinate(generator) });
+  }
+  auto inside = locator.contains(points);
+  BOOST_REQUIRE_EQUAL(inside.size(), points.size());
+  for (auto i = 0; i < points.size(); ++i) {
+    BOOST_CHECK_EQUAL(inside[i], contour.contains(points[i].x, points[i].y));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PointInAHoleIsOutside)
+{
+  ContourLocator<double> locator(std::vector<Polygon<double>>{
+    { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 }, { 0, 0 } }, { { 2, 2 }, { 2, 8 }, { 8, 8 }, { 8, 2 }, { 2, 2 } } });
+  BOOST_CHECK_EQUAL(locator.contains(1, 5), true);
+  BOOST_CHECK_EQUAL(locator.contains(5, 5), false);
+  BOOST_CHECK_EQUAL(locator.contains(9, 9), true);
+  BOOST_CHECK_EQUAL(locator.contains(11, 5), false);
+}
+
+BOOST_AUTO_TEST_CASE(ThrowIfPolygonIsNotClosed)
+{
+  Polygon<double> opened{ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+  BOOST_CHECK_THROW(ContourLocator<double>{ opened }, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
@@ -46,6 +46,13 @@ int mchCathodeSegmentationFindPadByPosition(MchCathodeSegmentationHandle segHand
   return segHandle->impl->findPadByPosition(x, y);
 }
 
+MCHMAPPINGIMPL3_EXPORT
+void mchCathodeSegmentationFindPadsByPositions(MchCathodeSegmentationHandle segHandle, int n, const double* x,
+                                               const double* y, int* catPadIndices)
+{
+  segHandle->impl->findPadsByPositions(n, x, y, catPadIndices);
+}
+
 MCHMAPPINGIMPL3_EXPORT
 int mchCathodeSegmentationFindPadByFEE(MchCathodeSegmentationHandle segHandle, int dualSampaId, int dualSampaChannel)
 {
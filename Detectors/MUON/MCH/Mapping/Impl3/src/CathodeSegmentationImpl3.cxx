@@ -18,8 +18,11 @@
 #include "PadSize.h"
 #include "MCHMappingInterface/CathodeSegmentation.h"
 #include "CathodeSegmentationCreator.h"
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
@@ -80,6 +83,79 @@ void CathodeSegmentation::fillRtree()
   }
 }
 
+void CathodeSegmentation::fillGrid()
+{
+  // rank of the pads within their pad group type, in the same order as the catPadIndexs in fillRtree
+  for (auto& pgt : mPadGroupTypes) {
+    std::vector<int> ranks(pgt.getNofPadsX() * pgt.getNofPadsY(), -1);
+    int rank{ 0 };
+    for (int ix = 0; ix < pgt.getNofPadsX(); ++ix) {
+      for (int iy = 0; iy < pgt.getNofPadsY(); ++iy) {
+        if (pgt.id(ix, iy) >= 0) {
+          ranks[pgt.fastIndex(ix, iy)] = rank++;
+        }
+      }
+    }
+    mPadGroupTypeFastIndex2PadRank.push_back(ranks);
+  }
+
+  if (mPadGroups.empty()) {
+    return;
+  }
+
+  // bounding boxes of the pad groups, enlarged by the tolerance of findPadByPosition
+  const double epsilon{ 1E-4 };
+  std::vector<std::array<double, 4>> boxes;
+  double xmin{ std::numeric_limits<double>::max() };
+  double ymin{ std::numeric_limits<double>::max() };
+  double xmax{ std::numeric_limits<double>::lowest() };
+  double ymax{ std::numeric_limits<double>::lowest() };
+  for (auto& pg : mPadGroups) {
+    auto& pgt = mPadGroupTypes[pg.mPadGroupTypeId];
+    boxes.push_back({ pg.mX - epsilon, pg.mY - epsilon,
+                      pg.mX + pgt.getNofPadsX() * mPadSizes[pg.mPadSizeId].first + epsilon,
+                      pg.mY + pgt.getNofPadsY() * mPadSizes[pg.mPadSizeId].second + epsilon });
+    xmin = std::min(xmin, boxes.back()[0]);
+    ymin = std::min(ymin, boxes.back()[1]);
+    xmax = std::max(xmax, boxes.back()[2]);
+    ymax = std::max(ymax, boxes.back()[3]);
+  }
+
+  // about 4 cells per pad group
+  double cellSize = std::sqrt((xmax - xmin) * (ymax - ymin) / (4. * mPadGroups.size()));
+  mGridXMin = xmin;
+  mGridYMin = ymin;
+  mGridNofCellsX = std::max(1, static_cast<int>(std::ceil((xmax - xmin) / cellSize)));
+  mGridNofCellsY = std::max(1, static_cast<int>(std::ceil((ymax - ymin) / cellSize)));
+  mGridInvCellSizeX = mGridNofCellsX / (xmax - xmin);
+  mGridInvCellSizeY = mGridNofCellsY / (ymax - ymin);
+
+  auto cellRange = [](double min, double max, double origin, double invCellSize, int nofCells, int& first, int& last) {
+    first = std::max(0, std::min(nofCells - 1, static_cast<int>(std::floor((min - origin) * invCellSize))));
+    last = std::max(0, std::min(nofCells - 1, static_cast<int>(std::floor((max - origin) * invCellSize))));
+  };
+
+  std::vector<std::vector<int>> cells(mGridNofCellsX * mGridNofCellsY);
+  for (auto padGroupIndex = 0; padGroupIndex < mPadGroups.size(); ++padGroupIndex) {
+    auto& box = boxes[padGroupIndex];
+    int ix1, ix2, iy1, iy2;
+    cellRange(box[0], box[2], mGridXMin, mGridInvCellSizeX, mGridNofCellsX, ix1, ix2);
+    cellRange(box[1], box[3], mGridYMin, mGridInvCellSizeY, mGridNofCellsY, iy1, iy2);
+    for (int iy = iy1; iy <= iy2; ++iy) {
+      for (int ix = ix1; ix <= ix2; ++ix) {
+        cells[ix + iy * mGridNofCellsX].push_back(padGroupIndex);
+      }
+    }
+  }
+
+  mGridCellOffsets.reserve(cells.size() + 1);
+  for (auto& cell : cells) {
+    mGridCellOffsets.push_back(mGridPadGroupIndices.size());
+    mGridPadGroupIndices.insert(mGridPadGroupIndices.end(), cell.begin(), cell.end());
+  }
+  mGridCellOffsets.push_back(mGridPadGroupIndices.size());
+}
+
 std::set<int> getUnique(const std::vector<PadGroup>& padGroups)
 {
   // extract from padGroup vector the unique integer values given by func
@@ -115,6 +191,7 @@ CathodeSegmentation::CathodeSegmentation(int segType, bool isBendingPlane, std::
     mPadGroupIndex2CatPadIndexIndex{}
 {
   fillRtree();
+  fillGrid();
 }
 
 std::vector<int> CathodeSegmentation::getCatPadIndexs(int dualSampaId) const
@@ -160,32 +237,68 @@ std::vector<int> CathodeSegmentation::getNeighbouringCatPadIndexs(int catPadInde
   return pads;
 }
 
-double CathodeSegmentation::squaredDistance(int catPadIndex, double x, double y) const
-{
-  double px = padPositionX(catPadIndex) - x;
-  double py = padPositionY(catPadIndex) - y;
-  return px * px + py * py;
-}
-
 int CathodeSegmentation::findPadByPosition(double x, double y) const
 {
+  // Select, among the pads intersecting the box of +/- epsilon around the position,
+  // the closest one. The candidates are taken from the pad groups registered in the
+  // grid cell of this position.
   const double epsilon{ 1E-4 };
-  auto pads = getCatPadIndexs(x - epsilon, y - epsilon, x + epsilon, y + epsilon);
+
+  double fx = (x - mGridXMin) * mGridInvCellSizeX;
+  double fy = (y - mGridYMin) * mGridInvCellSizeY;
+  if (!(fx >= 0. && fy >= 0. && fx < mGridNofCellsX && fy < mGridNofCellsY)) {
+    return InvalidCatPadIndex;
+  }
+  int cell = static_cast<int>(fx) + static_cast<int>(fy) * mGridNofCellsX;
 
   double dmin{ std::numeric_limits<double>::max() };
   int catPadIndex{ InvalidCatPadIndex };
 
-  for (auto i = 0; i < pads.size(); ++i) {
-    double d{ squaredDistance(pads[i], x, y) };
-    if (d < dmin) {
-      catPadIndex = pads[i];
-      dmin = d;
+  for (auto i = mGridCellOffsets[cell]; i < mGridCellOffsets[cell + 1]; ++i) {
+    auto padGroupIndex = mGridPadGroupIndices[i];
+    auto& pg = mPadGroups[padGroupIndex];
+    auto& pgt = mPadGroupTypes[pg.mPadGroupTypeId];
+    auto& ranks = mPadGroupTypeFastIndex2PadRank[pg.mPadGroupTypeId];
+    double dx{ mPadSizes[pg.mPadSizeId].first };
+    double dy{ mPadSizes[pg.mPadSizeId].second };
+    // candidate pads, one more on each side to be insensitive to the rounding of the division
+    int ix1 = std::max(0, static_cast<int>(std::floor((x - epsilon - pg.mX) / dx)) - 1);
+    int ix2 = std::min(pgt.getNofPadsX() - 1, static_cast<int>(std::floor((x + epsilon - pg.mX) / dx)) + 1);
+    int iy1 = std::max(0, static_cast<int>(std::floor((y - epsilon - pg.mY) / dy)) - 1);
+    int iy2 = std::min(pgt.getNofPadsY() - 1, static_cast<int>(std::floor((y + epsilon - pg.mY) / dy)) + 1);
+    for (int ix = ix1; ix <= ix2; ++ix) {
+      if (ix * dx + pg.mX > x + epsilon || (ix + 1) * dx + pg.mX < x - epsilon) {
+        continue;
+      }
+      for (int iy = iy1; iy <= iy2; ++iy) {
+        if (iy * dy + pg.mY > y + epsilon || (iy + 1) * dy + pg.mY < y - epsilon) {
+          continue;
+        }
+        int rank = ranks[pgt.fastIndex(ix, iy)];
+        if (rank < 0) {
+          continue;
+        }
+        double px = pg.mX + (ix + 0.5) * dx - x;
+        double py = pg.mY + (iy + 0.5) * dy - y;
+        double d = px * px + py * py;
+        if (d < dmin) {
+          catPadIndex = mPadGroupIndex2CatPadIndexIndex[padGroupIndex] + rank;
+          dmin = d;
+        }
+      }
     }
   }
 
   return catPadIndex;
 }
 
+void CathodeSegmentation::findPadsByPositions(int n, const double* x, const double* y, int* catPadIndices) const
+{
+  for (auto i = 0; i < n; ++i) {
+    catPadIndices[i] = findPadByPosition(x[i], y[i]);
+  }
+}
+
 const PadGroup& CathodeSegmentation::padGroup(int catPadIndex) const { return gsl::at(mPadGroups, mCatPadIndex2PadGroupIndex[catPadIndex]); }
 
 const PadGroupType& CathodeSegmentation::padGroupType(int catPadIndex) const
@@ -55,6 +55,10 @@ class CathodeSegmentation
 
   int findPadByPosition(double x, double y) const;
 
+  /// Find the pads at the n positions (x[i],y[i]) and store their catPadIndex,
+  /// or InvalidCatPadIndex if there is no pad at this position, in catPadIndices[i].
+  void findPadsByPositions(int n, const double* x, const double* y, int* catPadIndices) const;
+
   int findPadByFEE(int dualSampaId, int dualSampaChannel) const;
 
   bool hasPadByPosition(double x, double y) const { return findPadByPosition(x, y) != InvalidCatPadIndex; }
@@ -83,14 +87,14 @@ class CathodeSegmentation
 
   void fillRtree();
 
+  void fillGrid();
+
   std::ostream& showPad(std::ostream& out, int index) const;
 
   const PadGroup& padGroup(int catPadIndex) const;
 
   const PadGroupType& padGroupType(int catPadIndex) const;
 
-  double squaredDistance(int catPadIndex, double x, double y) const;
-
  private:
   int mSegType;
   bool mIsBendingPlane;
@@ -102,6 +106,17 @@ class CathodeSegmentation
   std::vector<int> mCatPadIndex2PadGroupIndex;
   std::vector<int> mCatPadIndex2PadGroupTypeFastIndex;
   std::vector<int> mPadGroupIndex2CatPadIndexIndex;
+  std::vector<std::vector<int>> mPadGroupTypeFastIndex2PadRank; // rank of each pad in its pad group type (-1 if no pad)
+
+  // uniform grid over the pad groups used to find pads by position
+  double mGridXMin{ 0. };
+  double mGridYMin{ 0. };
+  double mGridInvCellSizeX{ 0. };
+  double mGridInvCellSizeY{ 0. };
+  int mGridNofCellsX{ 0 };
+  int mGridNofCellsY{ 0 };
+  std::vector<int> mGridCellOffsets;     // first entry of each cell in mGridPadGroupIndices (+ total)
+  std::vector<int> mGridPadGroupIndices; // indices of the pad groups overlapping each cell
 };
 
 CathodeSegmentation* createCathodeSegmentation(int detElemId, bool isBendingPlane);
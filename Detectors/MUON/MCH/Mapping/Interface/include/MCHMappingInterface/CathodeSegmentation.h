@@ -22,6 +22,7 @@
 #include <iostream>
 #include <vector>
 #include <boost/format.hpp>
+#include <gsl/span>
 
 namespace o2
 {
@@ -143,6 +144,17 @@ class CathodeSegmentation
   /** Find the pad at position (x,y) (in cm). */
   int findPadByPosition(double x, double y) const { return mchCathodeSegmentationFindPadByPosition(mImpl, x, y); }
 
+  /** Find the pads at positions (x[i],y[i]) (in cm).
+   * catPadIndices[i] is filled with the catPadIndex found at position i (possibly invalid).
+   * All the spans must have the same size. */
+  void findPadsByPositions(gsl::span<const double> x, gsl::span<const double> y, gsl::span<int> catPadIndices) const
+  {
+    if (x.size() != y.size() || x.size() != catPadIndices.size()) {
+      throw std::invalid_argument("x, y and catPadIndices must have the same size");
+    }
+    mchCathodeSegmentationFindPadsByPositions(mImpl, x.size(), x.data(), y.data(), catPadIndices.data());
+  }
+
   /** Find the pad connected to the given channel of the given dual sampa. */
   int findPadByFEE(int dualSampaId, int dualSampaChannel) const
   {
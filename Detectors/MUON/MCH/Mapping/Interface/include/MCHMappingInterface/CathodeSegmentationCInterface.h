@@ -76,6 +76,11 @@ int mchCathodeSegmentationIsPadValid(MchCathodeSegmentationHandle segHandle, int
 /// Find the pad at position (x,y) (in cm).
 int mchCathodeSegmentationFindPadByPosition(MchCathodeSegmentationHandle segHandle, double x, double y);
 
+/// Find the pads at the n positions (x[i],y[i]) (in cm).
+/// catPadIndices[i] is set to the catPadIndex of the pad at position i or to an invalid one.
+void mchCathodeSegmentationFindPadsByPositions(MchCathodeSegmentationHandle segHandle, int n, const double* x,
+                                               const double* y, int* catPadIndices);
+
 /// Find the pad connected to the given channel of the given dual sampa.
 int mchCathodeSegmentationFindPadByFEE(MchCathodeSegmentationHandle segHandle, int dualSampaId, int dualSampaChannel);
 ///@}
@@ -0,0 +1,222 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/** @file SegmentationCache.h
+ * Flat tables of the pad information of one detection element.
+ */
+
+#ifndef O2_MCH_MAPPING_SEGMENTATIONCACHE_H
+#define O2_MCH_MAPPING_SEGMENTATIONCACHE_H
+
+#include "MCHMappingInterface/Segmentation.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace mch
+{
+namespace mapping
+{
+
+/// @brief A SegmentationCache holds the pad information of a Segmentation in flat arrays.
+///
+/// The tables are filled once at construction, going through the (C interface
+/// of the) segmentation, and can then be queried in constant time without any callback.
+/// This is meant for the reconstruction code which uses the same pads over and over.
+///
+/// The pad references are the dePadIndex of the Segmentation the cache has been built from :
+/// contiguous, from 0 to nofPads()-1, bending pads first.
+///
+/// The pad positions and sizes are stored as one array per quantity (x, y, dx, dy)
+/// and can be accessed as such, e.g. to process many pads at once.
+/// The neighbours of all the pads are stored in one array, the ones of a given pad being
+/// contiguous, and so are the pads of each dual sampa.
+class SegmentationCache
+{
+ public:
+  /// Build the cache of a segmentation
+  explicit SegmentationCache(const Segmentation& seg);
+
+  /// Build the cache of a detection element. This ctor throws if detElemId is invalid
+  explicit SegmentationCache(int detElemId) : SegmentationCache(Segmentation{ detElemId }) {}
+
+  /** @name Some general characteristics of this segmentation. */
+  ///@{
+  int detElemId() const { return mDetElemId; }
+  int nofPads() const { return mPadPositionX.size(); }
+  int nofDualSampas() const { return mDualSampaIds.size(); }
+  /// \param dualSampaIndex must be in the range 0..nofDualSampas()-1
+  /// \return the DualSampa chip id for a given index
+  int dualSampaId(int dualSampaIndex) const { return mDualSampaIds[dualSampaIndex]; }
+  ///@}
+
+  /// @name Pad information retrieval.
+  /// Given a _valid_ dePadIndex those methods return information
+  /// (position, size, fee) about that pad.
+  /// @{
+  bool isValid(int dePadIndex) const { return dePadIndex >= 0 && dePadIndex < nofPads(); }
+  bool isBendingPad(int dePadIndex) const { return dePadIndex < mPadIndexOffset; }
+  double padPositionX(int dePadIndex) const { return mPadPositionX[dePadIndex]; }
+  double padPositionY(int dePadIndex) const { return mPadPositionY[dePadIndex]; }
+  double padSizeX(int dePadIndex) const { return mPadSizeX[dePadIndex]; }
+  double padSizeY(int dePadIndex) const { return mPadSizeY[dePadIndex]; }
+  int padDualSampaId(int dePadIndex) const { return mDualSampaIds[mPadDualSampaIndex[dePadIndex]]; }
+  int padDualSampaChannel(int dePadIndex) const { return mPadDualSampaChannel[dePadIndex]; }
+  /// @}
+
+  /// @name Access to the full tables, indexed by dePadIndex.
+  /// @{
+  const std::vector<double>& padPositionsX() const { return mPadPositionX; }
+  const std::vector<double>& padPositionsY() const { return mPadPositionY; }
+  const std::vector<double>& padSizesX() const { return mPadSizeX; }
+  const std::vector<double>& padSizesY() const { return mPadSizeY; }
+  /// @}
+
+  /** Find the pad connected to the given channel of the given dual sampa.
+   * Returns -1 if there is no such pad. */
+  int findPadByFEE(int dualSampaId, int dualSampaChannel) const
+  {
+    if (dualSampaChannel < 0 || dualSampaChannel > 63) {
+      throw std::out_of_range("dualSampaChannel should be between 0 and 63");
+    }
+    int dualSampaIndex = findDualSampaIndex(dualSampaId);
+    return (dualSampaIndex < 0) ? -1 : mFEE2Pad[dualSampaIndex * 64 + dualSampaChannel];
+  }
+
+  /** @name Neighbours and ForEach methods.
+   * Those methods let you execute a function on each of the pads belonging to
+   * some group, with the same semantic as the ones of Segmentation.
+   */
+  ///@{
+  int nofNeighbours(int dePadIndex) const
+  {
+    return mNeighbourOffsets[dePadIndex + 1] - mNeighbourOffsets[dePadIndex];
+  }
+  /// \param iNeighbour must be in the range 0..nofNeighbours(dePadIndex)-1
+  int neighbour(int dePadIndex, int iNeighbour) const
+  {
+    return mNeighbours[mNeighbourOffsets[dePadIndex] + iNeighbour];
+  }
+
+  template <typename CALLABLE>
+  void forEachNeighbouringPad(int dePadIndex, CALLABLE&& func) const
+  {
+    for (auto i = mNeighbourOffsets[dePadIndex]; i < mNeighbourOffsets[dePadIndex + 1]; ++i) {
+      func(mNeighbours[i]);
+    }
+  }
+
+  template <typename CALLABLE>
+  void forEachPadInDualSampa(int dualSampaId, CALLABLE&& func) const
+  {
+    int dualSampaIndex = findDualSampaIndex(dualSampaId);
+    if (dualSampaIndex < 0) {
+      return;
+    }
+    for (auto i = mDualSampaPadOffsets[dualSampaIndex]; i < mDualSampaPadOffsets[dualSampaIndex + 1]; ++i) {
+      func(mDualSampaPads[i]);
+    }
+  }
+
+  template <typename CALLABLE>
+  void forEachPad(CALLABLE&& func) const
+  {
+    for (auto i = 0; i < nofPads(); ++i) {
+      func(i);
+    }
+  }
+  ///@}
+
+ private:
+  int findDualSampaIndex(int dualSampaId) const
+  {
+    if (dualSampaId < 0 || dualSampaId >= static_cast<int>(mDualSampaIndices.size())) {
+      return -1;
+    }
+    return mDualSampaIndices[dualSampaId];
+  }
+
+  int mDetElemId;
+  int mPadIndexOffset;
+  std::vector<double> mPadPositionX;
+  std::vector<double> mPadPositionY;
+  std::vector<double> mPadSizeX;
+  std::vector<double> mPadSizeY;
+  std::vector<uint16_t> mPadDualSampaIndex;  // index of the dual sampa of each pad
+  std::vector<uint8_t> mPadDualSampaChannel; // channel of each pad
+  std::vector<int> mNeighbourOffsets;        // position of the first neighbour of each pad (+ total)
+  std::vector<int> mNeighbours;              // neighbours of all the pads
+  std::vector<int> mDualSampaIds;            // dual sampa ids, bending first
+  std::vector<int> mDualSampaIndices;        // dual sampa index from id, -1 if not in this DE
+  std::vector<int> mDualSampaPadOffsets;     // position of the first pad of each dual sampa (+ total)
+  std::vector<int> mDualSampaPads;           // pads of all the dual sampas
+  std::vector<int> mFEE2Pad;                 // pad from dual sampa index * 64 + channel, -1 if none
+};
+
+inline SegmentationCache::SegmentationCache(const Segmentation& seg)
+  : mDetElemId{ seg.detElemId() }, mPadIndexOffset{ seg.bending().nofPads() }
+{
+  int nofPads = seg.nofPads();
+  mPadPositionX.reserve(nofPads);
+  mPadPositionY.reserve(nofPads);
+  mPadSizeX.reserve(nofPads);
+  mPadSizeY.reserve(nofPads);
+  mPadDualSampaIndex.assign(nofPads, 0);
+  mPadDualSampaChannel.reserve(nofPads);
+  mNeighbourOffsets.reserve(nofPads + 1);
+  mNeighbours.reserve(nofPads * 8);
+
+  seg.forEachPad([this, &seg](int dePadIndex) {
+    mPadPositionX.push_back(seg.padPositionX(dePadIndex));
+    mPadPositionY.push_back(seg.padPositionY(dePadIndex));
+    mPadSizeX.push_back(seg.padSizeX(dePadIndex));
+    mPadSizeY.push_back(seg.padSizeY(dePadIndex));
+    mPadDualSampaChannel.push_back(seg.padDualSampaChannel(dePadIndex));
+    mNeighbourOffsets.push_back(mNeighbours.size());
+    seg.forEachNeighbouringPad(dePadIndex, [this](int neighbour) { mNeighbours.push_back(neighbour); });
+  });
+  mNeighbourOffsets.push_back(mNeighbours.size());
+
+  // dual sampas of both cathodes, and the pads of each of them
+  mDualSampaPadOffsets.reserve(seg.nofDualSampas() + 1);
+  mDualSampaPads.reserve(nofPads);
+  for (const auto* catSeg : { &seg.bending(), &seg.nonBending() }) {
+    int offset = catSeg->isBendingPlane() ? 0 : mPadIndexOffset;
+    for (auto i = 0; i < catSeg->nofDualSampas(); ++i) {
+      int dualSampaIndex = mDualSampaIds.size();
+      int dualSampaId = catSeg->dualSampaId(i);
+      mDualSampaIds.push_back(dualSampaId);
+      if (dualSampaId >= static_cast<int>(mDualSampaIndices.size())) {
+        mDualSampaIndices.resize(dualSampaId + 1, -1);
+      }
+      mDualSampaIndices[dualSampaId] = dualSampaIndex;
+      mDualSampaPadOffsets.push_back(mDualSampaPads.size());
+      catSeg->forEachPadInDualSampa(dualSampaId, [this, offset, dualSampaIndex](int catPadIndex) {
+        mDualSampaPads.push_back(catPadIndex + offset);
+        mPadDualSampaIndex[catPadIndex + offset] = dualSampaIndex;
+      });
+    }
+  }
+  mDualSampaPadOffsets.push_back(mDualSampaPads.size());
+
+  mFEE2Pad.assign(mDualSampaIds.size() * 64, -1);
+  for (auto dePadIndex = 0; dePadIndex < nofPads; ++dePadIndex) {
+    mFEE2Pad[mPadDualSampaIndex[dePadIndex] * 64 + mPadDualSampaChannel[dePadIndex]] = dePadIndex;
+  }
+}
+
+} // namespace mapping
+} // namespace mch
+} // namespace o2
+
+#endif
@@ -318,6 +318,32 @@ BOOST_AUTO_TEST_CASE(CheckPositionOfOnePadInDE100Bending)
   BOOST_CHECK_EQUAL(seg.findPadByFEE(76, 9), seg.findPadByPosition(1.575, 18.69));
 }
 
+BOOST_AUTO_TEST_CASE(FindPadsByPositionsMatchesFindPadByPosition)
+{
+  std::vector<double> x, y;
+  seg.forEachPad([&](int catPadIndex) {
+    double px = seg.padPositionX(catPadIndex);
+    double py = seg.padPositionY(catPadIndex);
+    x.push_back(px);
+    y.push_back(py);
+    // a point in the pad, close to its corner
+    x.push_back(px + 0.49 * seg.padSizeX(catPadIndex));
+    y.push_back(py - 0.49 * seg.padSizeY(catPadIndex));
+  });
+  x.push_back(1000.);
+  y.push_back(1000.);
+  std::vector<int> catPadIndices(x.size());
+  seg.findPadsByPositions(x, y, catPadIndices);
+  int nofErrors{ 0 };
+  for (auto i = 0; i < x.size() - 1; ++i) {
+    nofErrors += (catPadIndices[i] != i / 2);
+    nofErrors += (catPadIndices[i] != seg.findPadByPosition(x[i], y[i]));
+  }
+  BOOST_CHECK_EQUAL(nofErrors, 0);
+  BOOST_CHECK_EQUAL(seg.isValid(catPadIndices.back()), false);
+  BOOST_CHECK_THROW(seg.findPadsByPositions(x, y, gsl::span<int>(catPadIndices.data(), 2)), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(CheckCopy)
 {
   CathodeSegmentation copy{ seg };
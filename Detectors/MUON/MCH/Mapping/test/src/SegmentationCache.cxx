@@ -0,0 +1,81 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "MCHMappingInterface/Segmentation.h"
+#include "MCHMappingInterface/SegmentationCache.h"
+#include <vector>
+
+using namespace o2::mch::mapping;
+
+BOOST_AUTO_TEST_SUITE(o2_mch_mapping)
+BOOST_AUTO_TEST_SUITE(segmentation_cache)
+
+BOOST_AUTO_TEST_CASE(CacheMustMatchSegmentation)
+{
+  forOneDetectionElementOfEachSegmentationType([](int detElemId) {
+    Segmentation seg{ detElemId };
+    SegmentationCache cache{ seg };
+    BOOST_REQUIRE_EQUAL(cache.detElemId(), detElemId);
+    BOOST_REQUIRE_EQUAL(cache.nofPads(), seg.nofPads());
+    BOOST_REQUIRE_EQUAL(cache.nofDualSampas(), seg.nofDualSampas());
+    int nofErrors{ 0 };
+    seg.forEachPad([&](int dePadIndex) {
+      nofErrors += (cache.isBendingPad(dePadIndex) != seg.isBendingPad(dePadIndex));
+      nofErrors += (cache.padPositionX(dePadIndex) != seg.padPositionX(dePadIndex));
+      nofErrors += (cache.padPositionY(dePadIndex) != seg.padPositionY(dePadIndex));
+      nofErrors += (cache.padSizeX(dePadIndex) != seg.padSizeX(dePadIndex));
+      nofErrors += (cache.padSizeY(dePadIndex) != seg.padSizeY(dePadIndex));
+      int dualSampaId = seg.padDualSampaId(dePadIndex);
+      int dualSampaChannel = seg.padDualSampaChannel(dePadIndex);
+      nofErrors += (cache.padDualSampaId(dePadIndex) != dualSampaId);
+      nofErrors += (cache.padDualSampaChannel(dePadIndex) != dualSampaChannel);
+      int dePadIndexFromFEE = seg.findPadByFEE(dualSampaId, dualSampaChannel);
+      nofErrors += (cache.findPadByFEE(dualSampaId, dualSampaChannel) != dePadIndexFromFEE);
+      std::vector<int> expected, neighbours;
+      seg.forEachNeighbouringPad(dePadIndex, [&expected](int i) { expected.push_back(i); });
+      cache.forEachNeighbouringPad(dePadIndex, [&neighbours](int i) { neighbours.push_back(i); });
+      nofErrors += (neighbours != expected);
+      nofErrors += (cache.nofNeighbours(dePadIndex) != static_cast<int>(expected.size()));
+    });
+    BOOST_CHECK_EQUAL(nofErrors, 0);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(CacheMustGroupPadsByDualSampa)
+{
+  forOneDetectionElementOfEachSegmentationType([](int detElemId) {
+    SegmentationCache cache{ detElemId };
+    int nofPads{ 0 };
+    int nofErrors{ 0 };
+    for (auto i = 0; i < cache.nofDualSampas(); ++i) {
+      int dualSampaId = cache.dualSampaId(i);
+      cache.forEachPadInDualSampa(dualSampaId, [&](int dePadIndex) {
+        nofErrors += (cache.padDualSampaId(dePadIndex) != dualSampaId);
+        ++nofPads;
+      });
+    }
+    BOOST_CHECK_EQUAL(nofErrors, 0);
+    BOOST_CHECK_EQUAL(nofPads, cache.nofPads());
+  });
+}
+
+BOOST_AUTO_TEST_CASE(CacheFindPadByFEEReturnsMinusOneIfNoPad)
+{
+  SegmentationCache cache{ 100 };
+  BOOST_CHECK_EQUAL(cache.findPadByFEE(214, 14), -1);
+  BOOST_CHECK_THROW(cache.findPadByFEE(102, 64), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
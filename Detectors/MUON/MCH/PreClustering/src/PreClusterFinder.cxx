@@ -12,7 +12,9 @@
 
 #include <chrono>
 #include <memory>
+#include <atomic>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <fairmq/Tools.h>
@@ -40,6 +42,7 @@ void PreClusterFinder::init(std::string& fileName)
     for (int iPlane = 0; iPlane < 2; ++iPlane) {
       mPreClusters[iDE][iPlane].reserve(100);
     }
+    mDEs[iDE].padStack.reserve(100);
   }
 }
 
@@ -137,54 +140,72 @@ void PreClusterFinder::loadDigits(const DigitStruct* digits, uint32_t nDigits)
 int PreClusterFinder::run()
 {
   /// preclusterize each cathod separately then merge them
-  preClusterizeRecursive();
-  return mergePreClusters();
+  /// the DEs are independent and distributed over the threads, the calling thread being one of them
+
+  std::atomic<int> nextDE(0);
+  std::atomic<int> nPreClusters(0);
+
+  auto worker = [this, &nextDE, &nPreClusters]() {
+    int n(0);
+    for (int iDE = nextDE++; iDE < SNDEs; iDE = nextDE++) {
+      preClusterize(iDE);
+      n += mergePreClusters(iDE);
+    }
+    nPreClusters += n;
+  };
+
+  std::vector<std::thread> threads{};
+  for (int iThread = 1; iThread < mNThreads; ++iThread) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return nPreClusters;
 }
 
 //_________________________________________________________________________________________________
-void PreClusterFinder::preClusterizeRecursive()
+void PreClusterFinder::preClusterize(int iDE)
 {
-  /// preclusterize both planes of every DE using recursive algorithm
+  /// preclusterize both planes of the DE "iDE"
 
   PreCluster* cluster(nullptr);
   uint16_t iPad(0);
 
-  // loop over DEs
-  for (int iDE = 0; iDE < SNDEs; ++iDE) {
+  DetectionElement& de(mDEs[iDE]);
 
-    DetectionElement& de(mDEs[iDE]);
+  // loop over planes
+  for (int iPlane = 0; iPlane < 2; ++iPlane) {
 
-    // loop over planes
-    for (int iPlane = 0; iPlane < 2; ++iPlane) {
+    // loop over fired pads
+    for (int iFiredPad = 0; iFiredPad < de.nFiredPads[iPlane]; ++iFiredPad) {
 
-      // loop over fired pads
-      for (int iFiredPad = 0; iFiredPad < de.nFiredPads[iPlane]; ++iFiredPad) {
-
-        iPad = de.firedPads[iPlane][iFiredPad];
-
-        if (de.mapping->pads[iPad].useMe) {
-
-          // create the precluster if needed
-          if (mNPreClusters[iDE][iPlane] >= mPreClusters[iDE][iPlane].size()) {
-            mPreClusters[iDE][iPlane].push_back(std::make_unique<PreCluster>());
-          }
-
-          // get the precluster
-          cluster = mPreClusters[iDE][iPlane][mNPreClusters[iDE][iPlane]].get();
-          ++mNPreClusters[iDE][iPlane];
+      iPad = de.firedPads[iPlane][iFiredPad];
 
-          // reset its content
-          cluster->area[0][0] = 1.e6;
-          cluster->area[0][1] = -1.e6;
-          cluster->area[1][0] = 1.e6;
-          cluster->area[1][1] = -1.e6;
-          cluster->useMe = true;
-          cluster->storeMe = false;
+      if (de.mapping->pads[iPad].useMe) {
 
-          // add the pad and its fired neighbours recusively
-          cluster->firstPad = de.nOrderedPads[0];
-          addPad(de, iPad, *cluster);
+        // create the precluster if needed
+        if (mNPreClusters[iDE][iPlane] >= mPreClusters[iDE][iPlane].size()) {
+          mPreClusters[iDE][iPlane].emplace_back();
         }
+
+        // get the precluster
+        cluster = &mPreClusters[iDE][iPlane][mNPreClusters[iDE][iPlane]];
+        ++mNPreClusters[iDE][iPlane];
+
+        // reset its content
+        cluster->area[0][0] = 1.e6;
+        cluster->area[0][1] = -1.e6;
+        cluster->area[1][0] = 1.e6;
+        cluster->area[1][1] = -1.e6;
+        cluster->useMe = true;
+        cluster->storeMe = false;
+
+        // add the pad and its fired neighbours
+        cluster->firstPad = de.nOrderedPads[0];
+        addPad(de, iPad, *cluster);
       }
     }
   }
@@ -193,98 +214,108 @@ void PreClusterFinder::preClusterizeRecursive()
 //_________________________________________________________________________________________________
 void PreClusterFinder::addPad(DetectionElement& de, uint16_t iPad, PreCluster& cluster)
 {
-  /// add the given MpPad and its fired neighbours (recursive method)
+  /// add the given MpPad and its fired neighbours
+  /// the pads are visited depth first with an explicit stack, in the same order as a recursive method
 
   Mapping::MpPad* pads(de.mapping->pads.get());
 
-  // add the given pad
-  Mapping::MpPad& pad(pads[iPad]);
-  if (de.nOrderedPads[0] < de.orderedPads[0].size()) {
-    de.orderedPads[0][de.nOrderedPads[0]] = iPad;
-  } else {
-    de.orderedPads[0].push_back(iPad);
-  }
-  cluster.lastPad = de.nOrderedPads[0];
-  ++de.nOrderedPads[0];
-  if (pad.area[0][0] < cluster.area[0][0])
-    cluster.area[0][0] = pad.area[0][0];
-  if (pad.area[0][1] > cluster.area[0][1])
-    cluster.area[0][1] = pad.area[0][1];
-  if (pad.area[1][0] < cluster.area[1][0])
-    cluster.area[1][0] = pad.area[1][0];
-  if (pad.area[1][1] > cluster.area[1][1])
-    cluster.area[1][1] = pad.area[1][1];
-
-  pad.useMe = false;
-
-  // loop over its neighbours
-  for (int iNeighbour = 0; iNeighbour < pad.nNeighbours; ++iNeighbour) {
-
-    if (pads[pad.neighbours[iNeighbour]].useMe) {
-
-      // add the pad to the precluster
-      addPad(de, pad.neighbours[iNeighbour], cluster);
+  de.padStack.clear();
+  de.padStack.push_back({ iPad, 0 });
+
+  while (!de.padStack.empty()) {
+
+    PadVisit& visit(de.padStack.back());
+    Mapping::MpPad& pad(pads[visit.iPad]);
+
+    if (visit.iNeighbour == 0 && pad.useMe) {
+
+      // add the pad when visited for the first time
+      if (de.nOrderedPads[0] < de.orderedPads[0].size()) {
+        de.orderedPads[0][de.nOrderedPads[0]] = visit.iPad;
+      } else {
+        de.orderedPads[0].push_back(visit.iPad);
+      }
+      cluster.lastPad = de.nOrderedPads[0];
+      ++de.nOrderedPads[0];
+      if (pad.area[0][0] < cluster.area[0][0])
+        cluster.area[0][0] = pad.area[0][0];
+      if (pad.area[0][1] > cluster.area[0][1])
+        cluster.area[0][1] = pad.area[0][1];
+      if (pad.area[1][0] < cluster.area[1][0])
+        cluster.area[1][0] = pad.area[1][0];
+      if (pad.area[1][1] > cluster.area[1][1])
+        cluster.area[1][1] = pad.area[1][1];
+
+      pad.useMe = false;
+    }
+
+    // move to its next fired neighbour, if any
+    while (visit.iNeighbour < pad.nNeighbours && !pads[pad.neighbours[visit.iNeighbour]].useMe) {
+      ++visit.iNeighbour;
+    }
+
+    if (visit.iNeighbour < pad.nNeighbours) {
+      uint16_t iNeighbourPad = pad.neighbours[visit.iNeighbour++];
+      de.padStack.push_back({ iNeighbourPad, 0 }); // invalidates visit
+    } else {
+      de.padStack.pop_back();
     }
   }
 }
 
 //_________________________________________________________________________________________________
-int PreClusterFinder::mergePreClusters()
+int PreClusterFinder::mergePreClusters(int iDE)
 {
-  /// merge overlapping preclusters on every DE
-  /// return the total number of preclusters after merging
+  /// merge overlapping preclusters on the DE "iDE"
+  /// return the number of preclusters after merging
 
   PreCluster* cluster(nullptr);
   int nPreClusters(0);
 
-  // loop over DEs
-  for (int iDE = 0; iDE < SNDEs; ++iDE) {
-
-    DetectionElement& de(mDEs[iDE]);
-
-    // loop over preclusters of one plane
-    for (int iCluster = 0; iCluster < mNPreClusters[iDE][0]; ++iCluster) {
+  DetectionElement& de(mDEs[iDE]);
 
-      if (!mPreClusters[iDE][0][iCluster]->useMe) {
-        continue;
-      }
+  // loop over preclusters of one plane
+  for (int iCluster = 0; iCluster < mNPreClusters[iDE][0]; ++iCluster) {
 
-      cluster = mPreClusters[iDE][0][iCluster].get();
-      cluster->useMe = false;
+    if (!mPreClusters[iDE][0][iCluster].useMe) {
+      continue;
+    }
 
-      // look for overlapping preclusters in the other plane
-      PreCluster* mergedCluster(nullptr);
-      mergePreClusters(*cluster, mPreClusters[iDE], mNPreClusters[iDE], de, 1, mergedCluster);
+    cluster = &mPreClusters[iDE][0][iCluster];
+    cluster->useMe = false;
 
-      // add the current one
-      if (!mergedCluster) {
-        mergedCluster = usePreClusters(cluster, de);
-      } else {
-        mergePreClusters(*mergedCluster, *cluster, de);
-      }
+    // look for overlapping preclusters in the other plane
+    PreCluster* mergedCluster(nullptr);
+    mergePreClusters(*cluster, mPreClusters[iDE], mNPreClusters[iDE], de, 1, mergedCluster);
 
-      ++nPreClusters;
+    // add the current one
+    if (!mergedCluster) {
+      mergedCluster = usePreClusters(cluster, de);
+    } else {
+      mergePreClusters(*mergedCluster, *cluster, de);
     }
 
-    // loop over preclusters of the other plane
-    for (int iCluster = 0; iCluster < mNPreClusters[iDE][1]; ++iCluster) {
-
-      if (!mPreClusters[iDE][1][iCluster]->useMe) {
-        continue;
-      }
+    ++nPreClusters;
+  }
 
-      // all remaining preclusters have to be stored
-      usePreClusters(mPreClusters[iDE][1][iCluster].get(), de);
+  // loop over preclusters of the other plane
+  for (int iCluster = 0; iCluster < mNPreClusters[iDE][1]; ++iCluster) {
 
-      ++nPreClusters;
+    if (!mPreClusters[iDE][1][iCluster].useMe) {
+      continue;
     }
+
+    // all remaining preclusters have to be stored
+    usePreClusters(&mPreClusters[iDE][1][iCluster], de);
+
+    ++nPreClusters;
   }
 
   return nPreClusters;
 }
 
 //_________________________________________________________________________________________________
-void PreClusterFinder::mergePreClusters(PreCluster& cluster, std::vector<std::unique_ptr<PreCluster>> preClusters[2],
+void PreClusterFinder::mergePreClusters(PreCluster& cluster, std::vector<PreCluster> preClusters[2],
                                         int nPreClusters[2], DetectionElement& de, int iPlane,
                                         PreCluster*& mergedCluster)
 {
@@ -298,11 +329,11 @@ void PreClusterFinder::mergePreClusters(PreCluster& cluster, std::vector<std::un
   // loop over preclusters in the given plane
   for (int iCluster = 0; iCluster < nPreClusters[iPlane]; ++iCluster) {
 
-    if (!preClusters[iPlane][iCluster]->useMe) {
+    if (!preClusters[iPlane][iCluster].useMe) {
       continue;
     }
 
-    cluster2 = preClusters[iPlane][iCluster].get();
+    cluster2 = &preClusters[iPlane][iCluster];
     if (Mapping::areOverlapping(cluster.area, cluster2->area, overlapPrecision) &&
         areOverlapping(cluster, *cluster2, de, overlapPrecision)) {
 
@@ -53,6 +53,9 @@ class PreClusterFinder
 
   void loadDigits(const DigitStruct* digits, uint32_t nDigits);
 
+  /// set the number of threads used to process the DEs in parallel
+  void setNThreads(int nThreads) { mNThreads = (nThreads > 0) ? nThreads : 1; }
+
   int run();
 
   int getNDEWithPreClusters(int& nUsedDigits);
@@ -66,6 +69,11 @@ class PreClusterFinder
   int getDEId(int iDE);
 
  private:
+  struct PadVisit {
+    uint16_t iPad;      // index of the pad
+    uint8_t iNeighbour; // index of the next neighbour to visit
+  };
+
   struct DetectionElement {
     std::unique_ptr<Mapping::MpDE> mapping; // mapping of this DE including the list of pads
     std::vector<const DigitStruct*> digits; // list of pointers to digits (not owner)
@@ -73,6 +81,7 @@ class PreClusterFinder
     std::vector<uint16_t> firedPads[2];     // indices of fired pads on each plane
     uint16_t nOrderedPads[2];               // current number of fired pads in the following arrays
     std::vector<uint16_t> orderedPads[2];   // indices of fired pads ordered after preclustering and merging
+    std::vector<PadVisit> padStack;         // pads being visited during the preclustering
   };
 
   /// Return detection element ID part of the unique ID
@@ -81,11 +90,11 @@ class PreClusterFinder
   /// Return the cathode part of the unique ID
   int cathode(uint32_t uid) { return (uid & 0x40000000) >> 30; }
 
-  void preClusterizeRecursive();
+  void preClusterize(int iDE);
   void addPad(DetectionElement& de, uint16_t iPad, PreCluster& cluster);
 
-  int mergePreClusters();
-  void mergePreClusters(PreCluster& cluster, std::vector<std::unique_ptr<PreCluster>> preClusters[2],
+  int mergePreClusters(int iDE);
+  void mergePreClusters(PreCluster& cluster, std::vector<PreCluster> preClusters[2],
                         int nPreClusters[2], DetectionElement& de, int iPlane, PreCluster*& mergedCluster);
   PreCluster* usePreClusters(PreCluster* cluster, DetectionElement& de);
   void mergePreClusters(PreCluster& cluster1, PreCluster& cluster2, DetectionElement& de);
@@ -99,8 +108,10 @@ class PreClusterFinder
   DetectionElement mDEs[SNDEs]{};            ///< internal mapping
   std::unordered_map<int, int> mDEIndices{}; ///< maps DE indices from DE IDs
 
-  int mNPreClusters[SNDEs][2]{}; ///< number of preclusters in each cathods of each DE
-  std::vector<std::unique_ptr<PreCluster>> mPreClusters[SNDEs][2]{}; ///< preclusters in each cathods of each DE
+  int mNPreClusters[SNDEs][2]{};                   ///< number of preclusters in each cathods of each DE
+  std::vector<PreCluster> mPreClusters[SNDEs][2]{}; ///< preclusters in each cathods of each DE (reused)
+
+  int mNThreads = 1; ///< number of threads used to process the DEs
 };
 
 //_________________________________________________________________________________________________
@@ -146,7 +157,7 @@ inline const PreClusterFinder::PreCluster* PreClusterFinder::getPreCluster(int i
   /// return the preclusters "iCluster" in plane "iPlane" of DE "iDE"
   assert(iDE >= 0 && iDE < SNDEs && iPlane >= 0 && iPlane < 2 && iCluster >= 0 &&
          iCluster < mNPreClusters[iDE][iPlane]);
-  return mPreClusters[iDE][iPlane][iCluster].get();
+  return &mPreClusters[iDE][iPlane][iCluster];
 }
 
 //_________________________________________________________________________________________________
@@ -56,6 +56,7 @@ class PreClusterFinderTask
     } catch (exception const& e) {
       throw;
     }
+    mPreClusterFinder.setNThreads(ic.options().get<int>("nThreads"));
 
     auto stop = [this]() {
       /// Clear the preclusterizer
@@ -226,7 +227,8 @@ o2::framework::DataProcessorSpec getPreClusterFinderSpec()
     Outputs{ OutputSpec{ "MCH", "PRECLUSTERS", 0, Lifetime::Timeframe } },
     AlgorithmSpec{ adaptFromTask<PreClusterFinderTask>() },
     Options{ { "binmapfile", VariantType::String, "", { "binary mapping file name" } },
-             { "print", VariantType::Bool, false, { "print preclusters" } } }
+             { "print", VariantType::Bool, false, { "print preclusters" } },
+             { "nThreads", VariantType::Int, 1, { "number of threads used to process the detection elements" } } }
   };
 }
 
@@ -16,13 +16,18 @@
 #ifndef O2_MCH_SIMULATION_MCHDIGITIZER_H_
 #define O2_MCH_SIMULATION_MCHDIGITIZER_H_
 
+#include "MCHMappingInterface/SegmentationCache.h"
 #include "MCHSimulation/Digit.h"
 #include "MCHSimulation/Detector.h"
 #include "MCHSimulation/Hit.h"
+#include "MathUtils/Cartesian3D.h"
 
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
 
+#include <memory>
+#include <vector>
+
 namespace o2
 {
 namespace mch
@@ -54,7 +59,26 @@ class Digitizer
   void setEventID(int v);
   int getEventID() const { return mEventID; }
 
+  // The detection elements are digitized in parallel with more than one thread
+  void setNThreads(int nThreads) { mNThreads = nThreads > 0 ? nThreads : 1; }
+  int getNThreads() const { return mNThreads; }
+
  private:
+  // Hit in the frame of its detection element, with the charges drawn for it
+  struct LocalHit {
+    int hit;          // index in the hit vector
+    float x;          // anode wire position
+    float y;          // position along the wire
+    float chargeBend; // charge on the bending cathode
+    float chargeNon;  // charge on the non-bending cathode
+  };
+
+  // Digits of one detection element, with the hit of each of them
+  struct DEDigits {
+    std::vector<Digit> digits;
+    std::vector<int> hits;
+  };
+
   double mEventTime;
   int mReadoutWindowCurrent{ 0 };
   int mEventID = 0;
@@ -72,7 +96,18 @@ class Digitizer
   //MCLabel container (output)
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> mMCTruthOutputContainer;
 
-  int processHit(const Hit& hit, int detID, double event_time);
+  int mNThreads = 1; // Number of threads digitizing the detection elements
+
+  std::vector<LocalHit> mLocalHits;  // hits grouped by detection element
+  std::vector<int> mDEHitOffsets;    // first local hit of each detection element (+ total)
+  std::vector<DEDigits> mDEDigits;   // per detection element, reused for every event
+  // the transformation and pad table of each detection element, made when first needed
+  std::vector<std::unique_ptr<o2::Transform3D>> mTransformations;
+  std::vector<std::unique_ptr<o2::mch::mapping::SegmentationCache>> mPadCaches;
+
+  void convertHits(const std::vector<Hit>& hits);
+  void processDE(int deIndex);
+  int processHit(const LocalHit& hit, int deIndex, DEDigits& output);
 };
 
 } // namespace mch
@@ -11,6 +11,8 @@
 #ifndef O2_MCH_SIMULATION_RESPONSE_H_
 #define O2_MCH_SIMULATION_RESPONSE_H_
 
+#include <vector>
+
 #include "MCHSimulation/Digit.h"
 #include "MCHSimulation/Detector.h"
 #include "MCHSimulation/Hit.h"
@@ -35,9 +37,12 @@ class Response
   float getChargeSat() { return mChargeSat; };
   float getChargeThreshold() { return mChargeThreshold; };
   float etocharge(float edepos);
-  double chargePadfraction(float xmin, float xmax, float ymin, float ymax);
-  double chargefrac1d(float min, float max, double k2, double sqrtk3, double k4);
-  double response(float charge);
+  /// charge fraction on the pad from the tabulated Mathieson integrals
+  double chargePadfraction(float xmin, float xmax, float ymin, float ymax) const;
+  /// same, from the analytic Mathieson integrals
+  double chargePadfractionExact(float xmin, float xmax, float ymin, float ymax) const;
+  double chargefrac1d(float min, float max, double k2, double sqrtk3, double k4) const;
+  double response(float charge) const;
   float getAnod(float x);
   float chargeCorr();
 
@@ -74,6 +79,15 @@ class Response
 
   //anode-cathode Pitch in 1/cm
   float mInversePitch = 0.0;
+
+  // Mathieson integral from 0 to u (in units of the pitch), tabulated for u in [0, sIntegralMax],
+  // it is odd and constant beyond to better than 1e-8
+  static constexpr int sNIntegralBins = 2000;
+  static constexpr double sIntegralMax = 10.;
+  std::vector<double> mIntegralX;
+  std::vector<double> mIntegralY;
+  void tabulateIntegral(std::vector<double>& table, double k2, double sqrtk3, double k4);
+  double integral(const std::vector<double>& table, float u) const;
 };
 } // namespace mch
 } // namespace o2
@@ -18,7 +18,11 @@
 #include "TProfile2D.h"
 #include "TRandom.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
+#include <map>
+#include <thread>
 #include <fairlogger/Logger.h>
 
 using namespace o2::mch;
@@ -42,6 +46,9 @@ int deId2deIndex(int detElemId)
   return m[detElemId];
 }
 
+// distance up to which the pads are neighbours in the mapping
+constexpr double sNeighbourDistance = 0.1; // cm
+
 std::vector<o2::mch::mapping::Segmentation> createSegmentations()
 {
   std::vector<o2::mch::mapping::Segmentation> segs;
@@ -51,10 +58,10 @@ std::vector<o2::mch::mapping::Segmentation> createSegmentations()
   return segs;
 }
 
-const o2::mch::mapping::Segmentation& segmentation(int detElemId)
+const o2::mch::mapping::Segmentation& segmentationByIndex(int deIndex)
 {
   static auto segs = createSegmentations();
-  return segs[deId2deIndex(detElemId)];
+  return segs[deIndex];
 }
 
 bool isStation1(int detID)
@@ -83,53 +90,133 @@ void Digitizer::process(const std::vector<Hit> hits, std::vector<Digit>& digits)
   mDigits.clear();
   mTrackLabels.clear();
 
-  //array of MCH hits for a given simulated event
-  for (auto& hit : hits) {
-    //index for this hit
-    int detID = hit.GetDetectorID();
-    int ndigits = processHit(hit, detID, mEventTime);
-    //TODO need one label per Digit
-    // can use nDigit output of processHit
-    MCCompLabel label(hit.GetTrackID(), mEventID, mSrcID);
-    for (int i = 0; i < ndigits; ++i) {
-      int digitIndex = mDigits.size() - ndigits + i;
-      mTrackLabels.addElementRandomAccess(digitIndex, label);
-    } //loop over digits to generate MCdigits
-  }   //loop over hits
+  // The charges are drawn and the hits transformed to the local frames here, in the
+  // order of the hits, such that the detection elements are then independent
+  convertHits(hits);
+
+  std::vector<int> deIndices;
+  for (int deIndex = 0; deIndex < mNdE; ++deIndex) {
+    if (mDEHitOffsets[deIndex + 1] > mDEHitOffsets[deIndex]) {
+      deIndices.push_back(deIndex);
+    }
+  }
+
+  const int nThreads = std::max(1, std::min<int>(mNThreads, deIndices.size()));
+  std::atomic<int> nextDE(0);
+  std::vector<std::exception_ptr> exceptions(nThreads);
+  auto processDEs = [&](int thread) {
+    try {
+      for (int i = nextDE++; i < int(deIndices.size()); i = nextDE++) {
+        processDE(deIndices[i]);
+      }
+    } catch (...) {
+      exceptions[thread] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int thread = 1; thread < nThreads; ++thread) {
+    threads.emplace_back(processDEs, thread);
+  }
+  processDEs(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  // the digits in the order of the detection elements, one label per digit
+  for (auto deIndex : deIndices) {
+    auto& output = mDEDigits[deIndex];
+    for (size_t i = 0; i < output.digits.size(); ++i) {
+      const auto& hit = hits[output.hits[i]];
+      mTrackLabels.addElementRandomAccess(mDigits.size(), MCCompLabel(hit.GetTrackID(), mEventID, mSrcID));
+      mDigits.push_back(output.digits[i]);
+    }
+  }
 
   fillOutputContainer(digits);
 }
+
 //______________________________________________________________________
-int Digitizer::processHit(const Hit& hit, int detID, double event_time)
+void Digitizer::convertHits(const std::vector<Hit>& hits)
 {
-  Point3D<float> pos(hit.GetX(), hit.GetY(), hit.GetZ());
+  mTransformations.resize(mNdE);
+  mPadCaches.resize(mNdE);
+  mDEDigits.resize(mNdE);
+
+  // group the hits by detection element, keeping their order
+  std::vector<int> deIndices(hits.size());
+  mDEHitOffsets.assign(mNdE + 1, 0);
+  for (size_t i = 0; i < hits.size(); ++i) {
+    deIndices[i] = deId2deIndex(hits[i].GetDetectorID());
+    ++mDEHitOffsets[deIndices[i] + 1];
+  }
+  for (int deIndex = 0; deIndex < mNdE; ++deIndex) {
+    mDEHitOffsets[deIndex + 1] += mDEHitOffsets[deIndex];
+  }
+  std::vector<int> next(mDEHitOffsets.begin(), mDEHitOffsets.end() - 1);
+
+  mLocalHits.resize(hits.size());
+  for (size_t i = 0; i < hits.size(); ++i) {
+    const auto& hit = hits[i];
+    int detID = hit.GetDetectorID();
+    int deIndex = deIndices[i];
+    Response& resp = response(isStation1(detID));
 
-  Response& resp = response(isStation1(detID));
+    //convert energy to charge
+    auto charge = resp.etocharge(hit.GetEnergyLoss());
 
-  //convert energy to charge
-  auto charge = resp.etocharge(hit.GetEnergyLoss());
-  auto time = hit.GetTime(); //to be used for pile-up
+    //transformation from global to local
+    auto& t = mTransformations[deIndex];
+    if (!t) {
+      t = std::make_unique<o2::Transform3D>(o2::mch::getTransformation(detID, *gGeoManager));
+    }
+    Point3D<float> pos(hit.GetX(), hit.GetY(), hit.GetZ());
+    Point3D<float> lpos;
+    t->MasterToLocal(pos, lpos);
 
-  //transformation from global to local
-  auto t = o2::mch::getTransformation(detID, *gGeoManager);
-  Point3D<float> lpos;
-  t.MasterToLocal(pos, lpos);
+    auto fracplane = resp.chargeCorr();
+    auto& local = mLocalHits[next[deIndex]++];
+    local.hit = i;
+    local.x = resp.getAnod(lpos.X());
+    local.y = lpos.Y();
+    local.chargeBend = fracplane * charge;
+    local.chargeNon = charge / fracplane;
+  }
+}
 
-  auto anodpos = resp.getAnod(lpos.X());
-  auto fracplane = resp.chargeCorr();
-  auto chargebend = fracplane * charge;
-  auto chargenon = charge / fracplane;
+//______________________________________________________________________
+void Digitizer::processDE(int deIndex)
+{
+  auto& output = mDEDigits[deIndex];
+  output.digits.clear();
+  output.hits.clear();
+  for (int i = mDEHitOffsets[deIndex]; i < mDEHitOffsets[deIndex + 1]; ++i) {
+    processHit(mLocalHits[i], deIndex, output);
+  }
+}
 
-  //borders of charge gen.
-  auto xMin = anodpos - resp.getQspreadX() * 0.5;
-  auto xMax = anodpos + resp.getQspreadX() * 0.5;
-  auto yMin = lpos.Y() - resp.getQspreadY() * 0.5;
-  auto yMax = lpos.Y() + resp.getQspreadY() * 0.5;
+//______________________________________________________________________
+int Digitizer::processHit(const LocalHit& hit, int deIndex, DEDigits& output)
+{
+  auto& seg = segmentationByIndex(deIndex);
+  auto& pads = mPadCaches[deIndex];
+  if (!pads) {
+    pads = std::make_unique<o2::mch::mapping::SegmentationCache>(seg);
+  }
+  Response& resp = response(isStation1(seg.detElemId()));
 
-  //get segmentation for detector element
-  auto& seg = segmentation(detID);
-  auto localX = anodpos;
-  auto localY = lpos.Y();
+  auto localX = hit.x;
+  auto localY = hit.y;
+
+  //borders of charge gen.
+  auto xMin = localX - resp.getQspreadX() * 0.5;
+  auto xMax = localX + resp.getQspreadX() * 0.5;
+  auto yMin = localY - resp.getQspreadY() * 0.5;
+  auto yMax = localY + resp.getQspreadY() * 0.5;
 
   //get area for signal induction from segmentation
   //single pad as check
@@ -143,23 +230,48 @@ int Digitizer::processHit(const Hit& hit, int detID, double event_time)
     return 0;
   }
 
-  seg.forEachPadInArea(xMin, yMin, xMax, yMax, [&resp, &digits = this->mDigits, chargebend, chargenon, localX, localY, &seg, &ndigits ](int padid) {
-    auto dx = seg.padSizeX(padid) * 0.5;
-    auto dy = seg.padSizeY(padid) * 0.5;
-    auto xmin = (localX - seg.padPositionX(padid)) - dx;
+  auto addDigit = [&](int padid) {
+    auto dx = pads->padSizeX(padid) * 0.5;
+    auto dy = pads->padSizeY(padid) * 0.5;
+    auto xmin = (localX - pads->padPositionX(padid)) - dx;
     auto xmax = xmin + dx;
-    auto ymin = (localY - seg.padPositionY(padid)) - dy;
+    auto ymin = (localY - pads->padPositionY(padid)) - dy;
     auto ymax = ymin + dy;
     auto q = resp.chargePadfraction(xmin, xmax, ymin, ymax);
-    if (seg.isBendingPad(padid)) {
-      q *= chargebend;
+    if (pads->isBendingPad(padid)) {
+      q *= hit.chargeBend;
     } else {
-      q *= chargenon;
+      q *= hit.chargeNon;
     }
     auto signal = resp.response(q);
-    digits.emplace_back(padid, signal);
+    output.digits.emplace_back(padid, signal);
+    output.hits.push_back(hit.hit);
     ++ndigits;
-  });
+  };
+
+  // The charge spreads over less than the neighbourhood distance of the pads (1 mm) around the
+  // pads at the hit position: the pads of the area are these pads and their neighbours
+  if (resp.getQspreadX() * 0.5 >= sNeighbourDistance || resp.getQspreadY() * 0.5 >= sNeighbourDistance) {
+    seg.forEachPadInArea(xMin, yMin, xMax, yMax, addDigit);
+    return ndigits;
+  }
+  auto inArea = [&](int padid) {
+    auto dx = pads->padSizeX(padid) * 0.5;
+    auto dy = pads->padSizeY(padid) * 0.5;
+    auto x = pads->padPositionX(padid);
+    auto y = pads->padPositionY(padid);
+    return x - dx <= xMax && x + dx >= xMin && y - dy <= yMax && y + dy >= yMin;
+  };
+  for (int padid : { padidbendcent, padidnoncent }) {
+    if (inArea(padid)) {
+      addDigit(padid);
+    }
+    pads->forEachNeighbouringPad(padid, [&](int neighbour) {
+      if (inArea(neighbour)) {
+        addDigit(neighbour);
+      }
+    });
+  }
   return ndigits;
 }
 
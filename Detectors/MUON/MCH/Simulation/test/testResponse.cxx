@@ -0,0 +1,38 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "MCHSimulation/Response.h"
+#include <random>
+
+using namespace o2::mch;
+
+BOOST_AUTO_TEST_SUITE(o2_mch_simulation)
+
+BOOST_AUTO_TEST_CASE(TabulatedMathiesonIntegralsMatchTheAnalyticOnes)
+{
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<float> position(-3., 3.);
+  for (auto station : { Station::Type1, Station::Type2345 }) {
+    Response resp(station);
+    BOOST_CHECK_CLOSE(resp.chargePadfraction(-50., 50., -50., 50.), 1., 1e-4);
+    for (int i = 0; i < 10000; ++i) {
+      float x1 = position(generator), x2 = position(generator), y1 = position(generator), y2 = position(generator);
+      BOOST_CHECK_SMALL(resp.chargePadfraction(std::min(x1, x2), std::max(x1, x2), std::min(y1, y2), std::max(y1, y2)) -
+                          resp.chargePadfractionExact(std::min(x1, x2), std::max(x1, x2), std::min(y1, y2), std::max(y1, y2)),
+                        5e-6);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,8 @@
 
 #include <FairMQLogger.h>
 
+#include "Field/MagneticField.h"
+#include "Field/MagFieldFast.h"
 #include "TrackParam.h"
 
 namespace o2
@@ -30,6 +32,8 @@ namespace mch
 
 double TrackExtrap::sSimpleBValue = 0.;
 bool TrackExtrap::sFieldON = false;
+bool TrackExtrap::sUseFastField = false;
+const o2::field::MagFieldFast* TrackExtrap::sFastField = nullptr;
 
 //__________________________________________________________________________
 void TrackExtrap::setField()
@@ -42,6 +46,28 @@ void TrackExtrap::setField()
   sSimpleBValue = b[0];
   sFieldON = (TMath::Abs(sSimpleBValue) > 1.e-10) ? true : false;
   LOG(INFO) << "Track extrapolation with magnetic field " << (sFieldON ? "ON" : "OFF");
+
+  /// Prepare the tabulated field if requested
+  sFastField = nullptr;
+  if (sUseFastField) {
+    auto field = dynamic_cast<o2::field::MagneticField*>(TGeoGlobalMagField::Instance()->GetField());
+    if (field) {
+      field->AllowFastField(true, true);
+      sFastField = field->getFastField();
+      LOG(INFO) << "Track extrapolation with tabulated magnetic field";
+    } else {
+      LOG(WARNING) << "Tabulated magnetic field requires o2::field::MagneticField, using the global field";
+    }
+  }
+}
+
+//__________________________________________________________________________
+inline void TrackExtrap::getField(const double* xyz, double* b)
+{
+  /// Get the field from the tabulated map if used and covering this point, from the global field otherwise
+  if (!sFastField || !sFastField->Field(xyz, b)) {
+    TGeoGlobalMagField::Instance()->Field(xyz, b);
+  }
 }
 
 //__________________________________________________________________________
@@ -525,7 +551,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
       h = rest;
     }
     // cmodif: call gufld(vout,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(vout, f);
+    getField(vout, f);
 
     // *
     // *             start of integration
@@ -573,7 +599,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
+    getField(xyzt, f);
 
     at = a + secxs[0];
     bt = b + secys[0];
@@ -612,7 +638,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
+    getField(xyzt, f);
 
     z = z + (c + (seczs[0] + seczs[1] + seczs[2]) * kthird) * h;
     y = y + (b + (secys[0] + secys[1] + secys[2]) * kthird) * h;
@@ -18,6 +18,10 @@
 
 namespace o2
 {
+namespace field
+{
+class MagFieldFast;
+}
 namespace mch
 {
 
@@ -38,6 +42,12 @@ class TrackExtrap
 
   static void setField();
 
+  /// Switch to the tabulated field of o2::field::MagFieldFast in the dipole region instead of the
+  /// global field map for the Runge-Kutta steps. To be called before setField.
+  static void useFastField(bool use) { sUseFastField = use; }
+  /// Return true if the tabulated field is used
+  static bool isFastFieldUsed() { return sFastField != nullptr; }
+
   /// Return true if the field is switched ON
   static bool isFieldON() { return sFieldON; }
 
@@ -60,6 +70,8 @@ class TrackExtrap
   static bool extrapToZRungekutta(TrackParam* trackParam, double Z);
   static bool extrapOneStepRungekutta(double charge, double step, const double* vect, double* vout);
 
+  static void getField(const double* xyz, double* b);
+
   static constexpr double SSimpleBPosition = -0.5 * (994.05 + 986.6); ///< Position of the dipole
   static constexpr double SSimpleBLength = 0.5 * (502.1 + 309.4);     ///< Length of the dipole
   static constexpr int SMaxStepNumber = 5000;                         ///< Maximum number of steps for track extrapolation
@@ -68,8 +80,10 @@ class TrackExtrap
   /// Needed to get some "reasonable" corrections for MCS and E loss even if B = 0
   static constexpr double SMostProbBendingMomentum = 2.;
 
-  static double sSimpleBValue; ///< Magnetic field value at the centre
-  static bool sFieldON;        ///< true if the field is switched ON
+  static double sSimpleBValue;                      ///< Magnetic field value at the centre
+  static bool sFieldON;                             ///< true if the field is switched ON
+  static bool sUseFastField;                        ///< true if the tabulated field is requested
+  static const o2::field::MagFieldFast* sFastField; ///< tabulated field, if used
 };
 
 } // namespace mch
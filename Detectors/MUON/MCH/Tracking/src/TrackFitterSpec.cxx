@@ -15,8 +15,13 @@
 
 #include "TrackFitterSpec.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
 #include <stdexcept>
-#include <list>
+#include <thread>
+#include <vector>
 
 #include "Framework/ControlService.h"
 #include "Framework/DataProcessorSpec.h"
@@ -30,6 +35,7 @@
 #include "Cluster.h"
 #include "Track.h"
 #include "TrackFitter.h"
+#include "TrackExtrap.h"
 
 namespace o2
 {
@@ -49,8 +55,10 @@ class TrackFitterTask
     LOG(INFO) << "initializing track fitter";
     auto l3Current = ic.options().get<float>("l3Current");
     auto dipoleCurrent = ic.options().get<float>("dipoleCurrent");
+    TrackExtrap::useFastField(ic.options().get<bool>("fastField"));
     mTrackFitter.initField(l3Current, dipoleCurrent);
     mTrackFitter.smoothTracks(true);
+    mNThreads = std::max(1, ic.options().get<int>("nThreads"));
   }
 
   //_________________________________________________________________________________________________
@@ -85,30 +93,44 @@ class TrackFitterTask
     bufferPtrOut += SSizeOfInt;
     sizeLeft -= SSizeOfInt;
 
-    std::list<Cluster> clusters{};
+    // locate the tracks, the refitted tracks are written at the same place in the output message
+    mTrackOffsets.clear();
+    const char* bufferStart = bufferPtr;
     for (int iTrack = 0; iTrack < nTracks; ++iTrack) {
+      mTrackOffsets.push_back(bufferPtr - bufferStart);
+      skipTrack(bufferPtr, sizeLeft);
+    }
 
-      // get the input track
-      Track track{};
-      try {
-        readTrack(bufferPtr, sizeLeft, track, clusters);
-      } catch (exception const& e) {
-        throw;
-      }
+    if (sizeLeft != 0) {
+      throw length_error("incorrect payload");
+    }
 
-      // refit the track
+    // refit the tracks, the calling thread being one of the workers
+    std::atomic<int> nextTrack{ 0 };
+    std::vector<std::exception_ptr> errors(mNThreads);
+    auto worker = [&](int iThread) {
+      std::deque<Cluster> clusters{};
       try {
-        mTrackFitter.fit(track);
-      } catch (exception const& e) {
-        throw runtime_error(std::string("Track fit failed: ") + e.what());
+        for (int iTrack = nextTrack++; iTrack < nTracks; iTrack = nextTrack++) {
+          fitTrack(bufferStart + mTrackOffsets[iTrack], bufferPtrOut + mTrackOffsets[iTrack], clusters);
+        }
+      } catch (...) {
+        errors[iThread] = std::current_exception();
+        nextTrack = nTracks; // stop the other workers
       }
-
-      // write the refitted track to the ouput message
-      writeTrack(track, bufferPtrOut);
+    };
+    std::vector<std::thread> threads{};
+    for (int iThread = 1; iThread < std::min(mNThreads, nTracks); ++iThread) {
+      threads.emplace_back(worker, iThread);
     }
-
-    if (sizeLeft != 0) {
-      throw length_error("incorrect payload");
+    worker(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
     }
   }
 
@@ -141,7 +163,51 @@ class TrackFitterTask
   }
 
   //_________________________________________________________________________________________________
-  void readTrack(const char*& bufferPtr, int& sizeLeft, Track& track, std::list<Cluster>& clusters) const
+  void skipTrack(const char*& bufferPtr, int& sizeLeft) const
+  {
+    /// check the track informations in the buffer without reading them
+    /// move the buffer ptr and decrease the size left
+    /// throw an exception in case of error
+
+    if (sizeLeft < SSizeOfTrackParamStruct + SSizeOfInt) {
+      throw out_of_range("missing track parameters or number of clusters");
+    }
+    const int& nClusters = *reinterpret_cast<const int*>(bufferPtr + SSizeOfTrackParamStruct);
+    if (nClusters > 20) {
+      throw length_error("too many (>20) clusters attached to the track");
+    }
+    const int trackSize = SSizeOfTrackParamStruct + SSizeOfInt + nClusters * SSizeOfClusterStruct;
+    if (sizeLeft < trackSize) {
+      throw out_of_range("missing cluster");
+    }
+    bufferPtr += trackSize;
+    sizeLeft -= trackSize;
+  }
+
+  //_________________________________________________________________________________________________
+  void fitTrack(const char* bufferPtr, char* bufferPtrOut, std::deque<Cluster>& clusters)
+  {
+    /// read the track at this position of the input buffer, already checked with skipTrack,
+    /// refit it and write it at this position of the output message
+    /// the cluster container is reused from one track to the next
+
+    Track track{};
+    clusters.clear();
+    int sizeLeft = SSizeOfTrackParamStruct + SSizeOfInt;
+    sizeLeft += *reinterpret_cast<const int*>(bufferPtr + SSizeOfTrackParamStruct) * SSizeOfClusterStruct;
+    readTrack(bufferPtr, sizeLeft, track, clusters);
+
+    try {
+      mTrackFitter.fit(track);
+    } catch (exception const& e) {
+      throw runtime_error(std::string("Track fit failed: ") + e.what());
+    }
+
+    writeTrack(track, bufferPtrOut);
+  }
+
+  //_________________________________________________________________________________________________
+  void readTrack(const char*& bufferPtr, int& sizeLeft, Track& track, std::deque<Cluster>& clusters) const
   {
     /// read the track informations from the buffer
     /// move the buffer ptr and decrease the size left
@@ -207,7 +273,9 @@ class TrackFitterTask
   static constexpr int SSizeOfTrackParamStruct = sizeof(TrackParamStruct);
   static constexpr int SSizeOfClusterStruct = sizeof(ClusterStruct);
 
-  TrackFitter mTrackFitter{}; ///< track fitter
+  TrackFitter mTrackFitter{};       ///< track fitter, stateless during the fit
+  int mNThreads = 1;                ///< number of threads used to refit the tracks
+  std::vector<int> mTrackOffsets{}; ///< position of each track in the input and output buffers
 };
 
 //_________________________________________________________________________________________________
@@ -219,7 +287,9 @@ o2::framework::DataProcessorSpec getTrackFitterSpec()
     Outputs{ OutputSpec{ "MCH", "REFITTRACKS", 0, Lifetime::Timeframe } },
     AlgorithmSpec{ adaptFromTask<TrackFitterTask>() },
     Options{ { "l3Current", VariantType::Float, -30000.0f, { "L3 current" } },
-             { "dipoleCurrent", VariantType::Float, -6000.0f, { "Dipole current" } } }
+             { "dipoleCurrent", VariantType::Float, -6000.0f, { "Dipole current" } },
+             { "fastField", VariantType::Bool, false, { "Use the tabulated field in the dipole region" } },
+             { "nThreads", VariantType::Int, 1, { "Number of threads used to refit the tracks" } } }
   };
 }
 
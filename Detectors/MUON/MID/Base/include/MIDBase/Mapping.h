@@ -76,6 +76,15 @@ class Mapping
   };
 
   void init();
+  void buildStripAreas();
+  MpArea computeStripArea(int strip, int cathode, int line, int column, int deId, bool warn) const;
+  /// Index of the bending plane strip in the table of areas
+  inline int getAreaIndexBP(int strip, int line, int column, int deId) const
+  {
+    return ((deId * sNColumns + column) * sNLines + line) * sNStrips + strip;
+  }
+  /// Index of the non-bending plane strip in the table of areas
+  inline int getAreaIndexNBP(int strip, int column, int deId) const { return (deId * sNColumns + column) * sNStrips + strip; }
   void setupSegmentation(int rpcType, int column, int nStripsNBP, int stripPitchNBP, int nBoardsBP, int firstBoardId,
                          bool isBelowBeamPipe = false);
   void setupSegmentationLastColumn(int rpcType, int boardId);
@@ -101,6 +110,13 @@ class Mapping
 
   std::array<MpDE, 9> mDetectionElements;      ///< Array of detection element
   std::array<MpBoardIndex, 118> mBoardIndexes; ///< Array of board indexes
+
+  static constexpr int sNDEAreas = 36; ///< Detection elements with distinct areas (one side)
+  static constexpr int sNColumns = 7;  ///< Columns per detection element
+  static constexpr int sNLines = 4;    ///< Lines per column
+  static constexpr int sNStrips = 16;  ///< Strips per local board
+  std::vector<MpArea> mStripAreasBP;   ///< Areas of the bending plane strips per (deId, column, line, strip)
+  std::vector<MpArea> mStripAreasNBP;  ///< Areas of the non-bending plane strips per (deId, column, strip)
 };
 } // namespace mid
 } // namespace o2
@@ -43,6 +43,27 @@ void Mapping::init()
   buildDETypeMedium(6, { { 12, 34, 56, 72, 88, 104, 115 } }, false);
   buildDETypeMedium(7, { { 14, 36, 58, 74, 90, 106, 116 } }, true);
   buildDETypeLarge(8, { { 16, 38, 60, 76, 92, 108, 117 } });
+
+  buildStripAreas();
+}
+
+//______________________________________________________________________________
+void Mapping::buildStripAreas()
+{
+  /// Fills the tables of the strip areas
+  /// The areas only depend on the RPC type and chamber, i.e. on deId % 36
+  mStripAreasBP.resize(sNDEAreas * sNColumns * sNLines * sNStrips);
+  mStripAreasNBP.resize(sNDEAreas * sNColumns * sNStrips);
+  for (int deId = 0; deId < sNDEAreas; ++deId) {
+    for (int column = 0; column < sNColumns; ++column) {
+      for (int strip = 0; strip < sNStrips; ++strip) {
+        for (int line = 0; line < sNLines; ++line) {
+          mStripAreasBP[getAreaIndexBP(strip, line, column, deId)] = computeStripArea(strip, 0, line, column, deId, false);
+        }
+        mStripAreasNBP[getAreaIndexNBP(strip, column, deId)] = computeStripArea(strip, 1, 0, column, deId, false);
+      }
+    }
+  }
 }
 
 //______________________________________________________________________________
@@ -491,6 +512,22 @@ MpArea Mapping::stripByLocation(int strip, int cathode, int line, int column, in
   /// @param column The column id in the detection element
   /// @param deId The detection element ID
   /// @param warn Set to false to avoid printing an error message in case the strip is not found (default: true)
+  assert(strip < 16);
+  assert(column < 7);
+  if (cathode == 0) {
+    if (line >= 0 && line < sNLines) {
+      return mStripAreasBP[getAreaIndexBP(strip, line, column, deId % sNDEAreas)];
+    }
+  } else if (strip < mDetectionElements[getRPCType(deId)].columns[column].nStripsNBP) {
+    return mStripAreasNBP[getAreaIndexNBP(strip, column, deId % sNDEAreas)];
+  }
+  return computeStripArea(strip, cathode, line, column, deId, warn);
+}
+
+//______________________________________________________________________________
+MpArea Mapping::computeStripArea(int strip, int cathode, int line, int column, int deId, bool warn) const
+{
+  /// Computes the strip area from the column segmentation
   int deType = getRPCType(deId);
   int chamber = Constants::getChamber(deId);
   assert(strip < 16);
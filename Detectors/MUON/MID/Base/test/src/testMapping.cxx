@@ -170,5 +170,29 @@ BOOST_DATA_TEST_CASE_F(MyFixture, MID_Mapping_NeighboursNBP, boost::unit_test::d
   }       // loop on column
 }
 
+BOOST_DATA_TEST_CASE_F(MyFixture, MID_Mapping_StripAreas, boost::unit_test::data::xrange(72))
+{
+  // The centre of the tabulated strip area must be found in the same strip
+  int deId = sample;
+  for (int icolumn = mapping.getFirstColumn(deId); icolumn < 7; ++icolumn) {
+    int firstLine = mapping.getFirstBoardBP(icolumn, deId);
+    int lastLine = mapping.getLastBoardBP(icolumn, deId);
+    for (int icathode = 0; icathode < 2; ++icathode) {
+      int nStrips = (icathode == 0) ? 16 : mapping.getNStripsNBP(icolumn, deId);
+      for (int iline = firstLine; iline <= lastLine; ++iline) {
+        for (int istrip = 0; istrip < nStrips; ++istrip) {
+          MpArea area = mapping.stripByLocation(istrip, icathode, iline, icolumn, deId, false);
+          Mapping::MpStripIndex stripIndex = mapping.stripByPosition(area.getCenterX(), area.getCenterY(), icathode, deId, false);
+          BOOST_TEST(stripIndex.column == icolumn);
+          BOOST_TEST(stripIndex.strip == istrip);
+          if (icathode == 0) {
+            BOOST_TEST(stripIndex.line == iline);
+          }
+        } // loop on strips
+      }   // loop on lines
+    }     // loop on cathode
+  }       // loop on column
+}
+
 } // namespace mid
 } // namespace o2
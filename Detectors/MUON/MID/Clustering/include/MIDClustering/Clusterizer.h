@@ -18,9 +18,11 @@
 
 #include <unordered_map>
 #include <vector>
+#include <gsl/span>
 #include "MIDBase/Mapping.h"
 #include "DataFormatsMID/Cluster2D.h"
 #include "DataFormatsMID/ColumnData.h"
+#include "DataFormatsMID/ROFRecord.h"
 #include "MIDClustering/PreClusters.h"
 
 namespace o2
@@ -41,13 +43,20 @@ class Clusterizer
 
   bool init();
   bool process(std::vector<PreClusters>& preClusters);
+  bool process(gsl::span<PreClusters> preClusters, gsl::span<const ROFRecord> rofRecords);
 
   /// Gets the array of reconstructes clusters
   const std::vector<Cluster2D>& getClusters() { return mClusters; }
 
+  /// Gets the reconstructed clusters of the last call to process
+  gsl::span<const Cluster2D> getClustersSpan() const { return gsl::span<const Cluster2D>(mClusters.data(), mNClusters); }
+
   /// Gets the number of reconstructed clusters
   unsigned long int getNClusters() { return mNClusters; }
 
+  /// Gets the readout frame records of the clusters of the last call to process
+  const std::vector<ROFRecord>& getROFRecords() const { return mROFRecords; }
+
  private:
   void reset();
 
@@ -60,8 +69,10 @@ class Clusterizer
   void makeCluster(PreClusters::PreClusterBP& clBend, const int& deIndex);
   void makeCluster(PreClusters::PreClusterBP& clBend, PreClusters::PreClusterBP& clBendNeigh, PreClusters::PreClusterNBP& clNonBend, const int& deIndex);
 
-  std::vector<Cluster2D> mClusters; ///< list of clusters
-  unsigned long int mNClusters = 0; ///< Number of clusters
+  std::vector<Cluster2D> mClusters;   ///< list of clusters
+  unsigned long int mNClusters = 0;   ///< Number of clusters
+  std::vector<ROFRecord> mROFRecords; ///< Readout frame records of the clusters
+  std::vector<int> mNeighbours;       ///< Scratch list of neighbour pre-clusters
 };
 } // namespace mid
 } // namespace o2
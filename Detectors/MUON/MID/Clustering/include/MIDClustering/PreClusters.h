@@ -70,7 +70,7 @@ class PreClusters
   /// Gets the detection element ID
   int getDEId() const { return mDEId; }
 
-  std::vector<int> getNeighbours(int icolumn, int idx);
+  void getNeighbours(int icolumn, int idx, std::vector<int>& neighbours) const;
 
   PreClusterNBP* nextPreClusterNBP();
   PreClusterBP* nextPreClusterBP(int icolumn);
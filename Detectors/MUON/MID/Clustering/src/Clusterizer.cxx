@@ -13,6 +13,7 @@
 /// \author Diego Stocco <Diego.Stocco at cern.ch>
 /// \date   24 October 2016
 #include "MIDClustering/Clusterizer.h"
+#include <array>
 #include <cassert>
 
 #include <fairlogger/Logger.h>
@@ -34,10 +35,27 @@ bool Clusterizer::process(std::vector<PreClusters>& preClusters)
 {
   /// Main function: runs on the preclusters and builds the clusters
   /// @param preClusters Vector of PreClusters objects
+  ROFRecord rof(0, preClusters.size());
+  return process(gsl::span<PreClusters>(preClusters), gsl::span<const ROFRecord>(&rof, 1));
+}
+
+//______________________________________________________________________________
+bool Clusterizer::process(gsl::span<PreClusters> preClusters, gsl::span<const ROFRecord> rofRecords)
+{
+  /// Runs on the preclusters of all the readout frames of a timeframe and builds the clusters.
+  /// The clusters of all the readout frames are stored one after the other,
+  /// with one output readout frame record for each input one.
+  /// The storage is kept from one call to the next to avoid reallocations.
+  /// @param preClusters PreClusters objects of the timeframe
+  /// @param rofRecords Readout frame records pointing to preClusters
   // Reset cluster information
   reset();
-  for (auto& pcs : preClusters) {
-    makeClusters(pcs);
+  for (auto& rof : rofRecords) {
+    unsigned long int firstCluster = mNClusters;
+    for (auto& pcs : preClusters.subspan(rof.firstEntry, rof.nEntries)) {
+      makeClusters(pcs);
+    }
+    mROFRecords.emplace_back(firstCluster, mNClusters - firstCluster);
   }
   return true;
 }
@@ -83,15 +101,15 @@ bool Clusterizer::makeClusters(PreClusters& pcs)
         for (int ib = 0; ib < pcs.getNPreClustersBP(icolumn); ++ib) {
           PreClusters::PreClusterBP& pcB = pcs.getPreClusterBP(icolumn, ib);
           // This function checks for the neighbours only on icolumn+1
-          std::vector<int> neighbours = pcs.getNeighbours(icolumn, ib);
+          pcs.getNeighbours(icolumn, ib, mNeighbours);
           // It can happen that the NBP spans two columns...but there are fired strips only on
           // one column of the BP. In this case we only consider the column with a hit in the BP.
           // Of course, we need to check that the current pre-cluster was not already paired
           // with the pre-cluster in the previous column.
-          if (neighbours.empty() && pcB.paired != pairId) {
+          if (mNeighbours.empty() && pcB.paired != pairId) {
             makeCluster(pcB, pcNB, deIndex);
           } else {
-            for (auto& jb : neighbours) {
+            for (auto& jb : mNeighbours) {
               PreClusters::PreClusterBP& pcBneigh = pcs.getPreClusterBP(icolumn + 1, jb);
               makeCluster(pcB, pcBneigh, pcNB, deIndex);
               // Here we set the paired flag to a custom ID of the pre-cluster in the NBP
@@ -130,6 +148,8 @@ bool Clusterizer::init()
 
   // prepare storage of clusters and PreClusters
   mClusters.reserve(100);
+  mROFRecords.reserve(100);
+  mNeighbours.reserve(20);
 
   return true;
 }
@@ -201,7 +221,7 @@ void Clusterizer::makeCluster(PreClusters::PreClusterBP& clBend, PreClusters::Pr
   double delta[2];
   double sumArea = 0.;
 
-  std::vector<PreClusters::PreClusterBP*> pcBlist = { &clBend, &clBendNeigh };
+  std::array<PreClusters::PreClusterBP*, 2> pcBlist = { &clBend, &clBendNeigh };
 
   for (auto* pcBP : pcBlist) {
     int icolumn = pcBP->column;
@@ -293,6 +313,7 @@ void Clusterizer::reset()
 {
   /// Resets the clusters
   mNClusters = 0;
+  mROFRecords.clear();
 }
 } // namespace mid
 } // namespace o2
@@ -60,16 +60,17 @@ PreClusters::PreClusterBP* PreClusters::nextPreClusterBP(int icolumn)
 }
 
 //______________________________________________________________________________
-std::vector<int> PreClusters::getNeighbours(int icolumn, int idx)
+void PreClusters::getNeighbours(int icolumn, int idx, std::vector<int>& neighbours) const
 {
   /// Gets the neighbour pre-cluster in the BP i the next column
-  std::vector<int> neighbours;
+  /// @param neighbours Filled with the indexes of the neighbours (cleared first)
+  neighbours.clear();
   if (icolumn == 6) {
-    return neighbours;
+    return;
   }
-  PreClusterBP& pcB = mPreClustersBP[icolumn][idx];
+  const PreClusterBP& pcB = mPreClustersBP[icolumn][idx];
   for (int ib = 0; ib < mNPreClustersBP[icolumn + 1]; ++ib) {
-    PreClusterBP& neigh = mPreClustersBP[icolumn + 1][idx];
+    const PreClusterBP& neigh = mPreClustersBP[icolumn + 1][idx];
     if (neigh.area.getYmin() > pcB.area.getYmax()) {
       continue;
     }
@@ -78,7 +79,6 @@ std::vector<int> PreClusters::getNeighbours(int icolumn, int idx)
     }
     neighbours.push_back(ib);
   }
-  return neighbours;
 }
 
 //______________________________________________________________________________
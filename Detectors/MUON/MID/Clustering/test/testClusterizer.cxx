@@ -134,7 +134,7 @@ std::vector<Cluster2D> getClusters(int event)
   return clusters;
 }
 
-bool areClustersEqual(Cluster2D& cl1, Cluster2D& cl2)
+bool areClustersEqual(const Cluster2D& cl1, const Cluster2D& cl2)
 {
   int nBad = 0;
   float precision = 1.e-3;
@@ -196,6 +196,39 @@ BOOST_DATA_TEST_CASE_F(MyFixture, MID_Clustering_Fixed, boost::unit_test::data::
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(MID_Clustering_Timeframe, MyFixture)
+{
+  // Process all the fixed samples at once, one readout frame each
+  std::vector<PreClusters> tfPreClusters;
+  std::vector<ROFRecord> rofRecords;
+  for (int sample = 0; sample < 3; ++sample) {
+    preClusterizer.process(getColumnsFixed(sample));
+    rofRecords.emplace_back(tfPreClusters.size(), preClusterizer.getNPreClusters());
+    for (unsigned long ipc = 0; ipc < preClusterizer.getNPreClusters(); ++ipc) {
+      tfPreClusters.push_back(preClusterizer.getPreClusters()[ipc]);
+    }
+  }
+  // The input is processed twice to check that the clusters do not accumulate
+  for (int iloop = 0; iloop < 2; ++iloop) {
+    auto preClusters = tfPreClusters;
+    clusterizer.process(gsl::span<PreClusters>(preClusters), gsl::span<const ROFRecord>(rofRecords));
+    BOOST_TEST(clusterizer.getROFRecords().size() == rofRecords.size());
+    auto recoClusters = clusterizer.getClustersSpan();
+    unsigned long nClusters = 0;
+    for (int sample = 0; sample < 3; ++sample) {
+      std::vector<Cluster2D> clusters = getClusters(sample);
+      const ROFRecord& rof = clusterizer.getROFRecords()[sample];
+      BOOST_TEST(rof.firstEntry == nClusters);
+      BOOST_TEST(rof.nEntries == clusters.size());
+      for (unsigned long icl = 0; icl < clusters.size() && icl < rof.nEntries; ++icl) {
+        BOOST_TEST(areClustersEqual(clusters[icl], recoClusters[rof.firstEntry + icl]));
+      }
+      nClusters += rof.nEntries;
+    }
+    BOOST_TEST(recoClusters.size() == nClusters);
+  }
+}
+
 bool isWithinUncertainties(float xPos, float yPos, Cluster2D& cl)
 {
   std::string str[2] = { "x", "y" };
@@ -15,6 +15,9 @@
 #ifndef O2_MID_DIGITSMERGER_H
 #define O2_MID_DIGITSMERGER_H
 
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include "DataFormatsMID/ColumnData.h"
@@ -30,8 +33,19 @@ class DigitsMerger
  public:
   void process(const std::vector<ColumnDataMC>& inDigitStore, const o2::dataformats::MCTruthContainer<MCLabel>& inMCContainer, std::vector<ColumnData>& outDigitStore, o2::dataformats::MCTruthContainer<MCLabel>& outMCContainer, int timestampdiff = 0);
 
+  /// Merges the digits of several stores at once, e.g. the events of a timeframe, whose timestamps are in the same time base
+  void process(const std::vector<const std::vector<ColumnDataMC>*>& inDigitStores, const std::vector<const o2::dataformats::MCTruthContainer<MCLabel>*>& inMCContainers, std::vector<ColumnData>& outDigitStore, o2::dataformats::MCTruthContainer<MCLabel>& outMCContainer, int timestampdiff = 0);
+
  private:
-  std::vector<std::pair<ColumnDataMC, std::vector<size_t>>> mDigitsLabels; //! Temporary digits store
+  size_t merge(const ColumnDataMC& digit, int timestampdiff);
+
+  std::vector<ColumnDataMC> mDigits;                              //! Merged digits
+  std::vector<std::pair<size_t, size_t>> mInputs;                 //! Store and index of the input digits
+  std::vector<size_t> mMergedIndex;                               //! Merged digit of each input digit
+  std::vector<size_t> mFirstInput;                                //! First entry in mOrderedInputs of each merged digit
+  std::vector<size_t> mOrderedInputs;                             //! Input digits, grouped by merged digit
+  std::unordered_map<uint64_t, size_t> mDigitIndex;               //! Merged digit of each (deId, columnId, timestamp)
+  std::unordered_map<uint32_t, std::vector<size_t>> mColumnDigits; //! Merged digits of each (deId, columnId)
 };
 
 } // namespace mid
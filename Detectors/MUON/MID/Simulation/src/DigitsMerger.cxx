@@ -14,6 +14,8 @@
 /// \date   05 March 2018
 #include "MIDSimulation/DigitsMerger.h"
 
+#include <cstdlib>
+
 namespace o2
 {
 namespace mid
@@ -26,34 +28,86 @@ void DigitsMerger::process(const std::vector<ColumnDataMC>& inDigitStore, const
   /// \param outDigitStore Vector with merged digits
   /// \param outMCContainer Container with MC labels for merged digits
   /// \param timestampdiff Maximum timestamp difference between digits to be merged
+  process(std::vector<const std::vector<ColumnDataMC>*>{ &inDigitStore }, std::vector<const o2::dataformats::MCTruthContainer<MCLabel>*>{ &inMCContainer }, outDigitStore, outMCContainer, timestampdiff);
+}
+
+void DigitsMerger::process(const std::vector<const std::vector<ColumnDataMC>*>& inDigitStores, const std::vector<const o2::dataformats::MCTruthContainer<MCLabel>*>& inMCContainers, std::vector<ColumnData>& outDigitStore, o2::dataformats::MCTruthContainer<MCLabel>& outMCContainer, int timestampdiff)
+{
+  /// Merges the digits of all the input stores which have a timestamp difference smaller than timestamp diff
+  /// \param inDigitStores Input MC digits
+  /// \param inMCContainers Containers with MC labels for the input MC digits, one per store
+  /// \param outDigitStore Vector with merged digits
+  /// \param outMCContainer Container with MC labels for merged digits
+  /// \param timestampdiff Maximum timestamp difference between digits to be merged
   outDigitStore.clear();
   outMCContainer.clear();
-  mDigitsLabels.clear();
-
-  for (auto inIt = inDigitStore.begin(); inIt != inDigitStore.end(); ++inIt) {
-    bool isNew = true;
-    size_t idx = inIt - inDigitStore.begin();
-    for (auto& pair : mDigitsLabels) {
-      auto& outCol = pair.first;
-      if (outCol.deId == inIt->deId && outCol.columnId == inIt->columnId && std::abs(inIt->getTimeStamp() - outCol.getTimeStamp()) <= timestampdiff) {
-        outCol |= (*inIt);
-        pair.second.emplace_back(idx);
-        isNew = false;
-        break;
-      }
+  mDigits.clear();
+  mInputs.clear();
+  mMergedIndex.clear();
+  mDigitIndex.clear();
+  for (auto& column : mColumnDigits) {
+    column.second.clear();
+  }
+
+  for (size_t istore = 0; istore < inDigitStores.size(); ++istore) {
+    auto& store = *inDigitStores[istore];
+    for (size_t idx = 0; idx < store.size(); ++idx) {
+      mInputs.emplace_back(istore, idx);
+      mMergedIndex.emplace_back(merge(store[idx], timestampdiff));
     }
-    if (isNew) {
-      std::vector<size_t> vec = { idx };
-      mDigitsLabels.emplace_back(std::make_pair(*inIt, vec));
+  }
+
+  // Input digits of each merged digit, in input order
+  mFirstInput.assign(mDigits.size() + 1, 0);
+  for (auto imerged : mMergedIndex) {
+    ++mFirstInput[imerged + 1];
+  }
+  for (size_t imerged = 0; imerged < mDigits.size(); ++imerged) {
+    mFirstInput[imerged + 1] += mFirstInput[imerged];
+  }
+  mOrderedInputs.resize(mInputs.size());
+  for (size_t iinput = 0; iinput < mInputs.size(); ++iinput) {
+    mOrderedInputs[mFirstInput[mMergedIndex[iinput]]++] = iinput;
+  }
+
+  outDigitStore.reserve(mDigits.size());
+  size_t iordered = 0;
+  for (size_t imerged = 0; imerged < mDigits.size(); ++imerged) {
+    outDigitStore.emplace_back(mDigits[imerged]);
+    // mFirstInput[imerged] now is the end of the inputs of this digit
+    for (; iordered < mFirstInput[imerged]; ++iordered) {
+      auto& input = mInputs[mOrderedInputs[iordered]];
+      outMCContainer.addElements(imerged, inMCContainers[input.first]->getLabels(input.second));
     }
   }
+}
 
-  for (auto pair : mDigitsLabels) {
-    outDigitStore.emplace_back(pair.first);
-    for (auto labelIdx : pair.second) {
-      outMCContainer.addElements(outDigitStore.size() - 1, inMCContainer.getLabels(labelIdx));
+size_t DigitsMerger::merge(const ColumnDataMC& digit, int timestampdiff)
+{
+  /// Merges the digit with the first merged digit of the same column within timestampdiff, or adds it
+  /// \return Index of the merged digit
+  uint32_t columnKey = (static_cast<uint32_t>(digit.deId) << 8) | digit.columnId;
+  if (timestampdiff == 0) {
+    uint64_t key = (static_cast<uint64_t>(columnKey) << 32) | static_cast<uint32_t>(digit.getTimeStamp());
+    auto inserted = mDigitIndex.emplace(key, mDigits.size());
+    if (inserted.second) {
+      mDigits.emplace_back(digit);
+    } else {
+      mDigits[inserted.first->second] |= digit;
+    }
+    return inserted.first->second;
+  }
+  auto& candidates = mColumnDigits[columnKey];
+  for (auto imerged : candidates) {
+    auto& outCol = mDigits[imerged];
+    if (std::abs(digit.getTimeStamp() - outCol.getTimeStamp()) <= timestampdiff) {
+      outCol |= digit;
+      return imerged;
     }
   }
+  candidates.emplace_back(mDigits.size());
+  mDigits.emplace_back(digit);
+  return mDigits.size() - 1;
 }
 } // namespace mid
 } // namespace o2
@@ -215,6 +215,57 @@ BOOST_DATA_TEST_CASE(MID_Digitizer, boost::unit_test::data::make(getDEList()), d
   }
 }
 
+BOOST_AUTO_TEST_CASE(MID_DigitsMergerBatch)
+{
+  // In this test we merge the digits of two events, in the same and in other columns and timestamps
+  // We check that the merging of both stores at once gives the one of the concatenated stores
+  auto addDigit = [](std::vector<ColumnDataMC>& store, o2::dataformats::MCTruthContainer<MCLabel>& labels, int deId, int columnId, int strip, int timestamp, int trackID) {
+    ColumnDataMC digit;
+    digit.deId = deId;
+    digit.columnId = columnId;
+    digit.patterns.fill(0);
+    digit.setNonBendPattern(1 << strip);
+    digit.setTimeStamp(timestamp);
+    labels.addElement(store.size(), MCLabel(trackID, 0, 0, deId, columnId, 1, strip, strip));
+    store.emplace_back(digit);
+  };
+  std::vector<ColumnDataMC> event1, event2, allEvents;
+  o2::dataformats::MCTruthContainer<MCLabel> labels1, labels2, allLabels;
+  addDigit(event1, labels1, 3, 1, 2, 0, 0);
+  addDigit(event1, labels1, 3, 2, 2, 0, 1);
+  addDigit(event1, labels1, 3, 1, 5, 0, 2);
+  addDigit(event2, labels2, 3, 1, 7, 0, 3);
+  addDigit(event2, labels2, 3, 1, 8, 2, 4);
+  addDigit(event2, labels2, 10, 1, 8, 2, 5);
+  allEvents = event1;
+  allEvents.insert(allEvents.end(), event2.begin(), event2.end());
+  allLabels.mergeAtBack(labels1);
+  allLabels.mergeAtBack(labels2);
+
+  for (int timestampdiff : { 0, 2 }) {
+    std::vector<ColumnData> digitStore, batchDigitStore;
+    o2::dataformats::MCTruthContainer<MCLabel> digitLabels, batchDigitLabels;
+    SIMUL::digitsMerger.process(allEvents, allLabels, digitStore, digitLabels, timestampdiff);
+    SIMUL::digitsMerger.process({ &event1, &event2 }, { &labels1, &labels2 }, batchDigitStore, batchDigitLabels, timestampdiff);
+    // (3,1) at timestamp 0 and 2 are separate digits unless the timestamp difference allows the merging
+    BOOST_TEST(digitStore.size() == (timestampdiff == 0 ? 4 : 3));
+    BOOST_TEST(digitStore.front().getNonBendPattern() == (timestampdiff == 0 ? 0xA4 : 0x1A4));
+    BOOST_TEST(digitLabels.getLabels(0).size() == (timestampdiff == 0 ? 3 : 4));
+    BOOST_REQUIRE(batchDigitStore.size() == digitStore.size());
+    BOOST_REQUIRE(batchDigitLabels.getIndexedSize() == digitLabels.getIndexedSize());
+    for (size_t idig = 0; idig < digitStore.size(); ++idig) {
+      BOOST_TEST(batchDigitStore[idig].deId == digitStore[idig].deId);
+      BOOST_TEST(batchDigitStore[idig].columnId == digitStore[idig].columnId);
+      BOOST_TEST(batchDigitStore[idig].patterns == digitStore[idig].patterns);
+      auto labels = digitLabels.getLabels(idig), batchLabels = batchDigitLabels.getLabels(idig);
+      BOOST_REQUIRE(batchLabels.size() == labels.size());
+      for (size_t ilabel = 0; ilabel < labels.size(); ++ilabel) {
+        BOOST_TEST(batchLabels[ilabel] == labels[ilabel]);
+      }
+    }
+  }
+}
+
 // BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
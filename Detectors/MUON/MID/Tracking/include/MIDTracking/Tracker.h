@@ -16,6 +16,7 @@
 #ifndef O2_MID_TRACKER_H
 #define O2_MID_TRACKER_H
 
+#include <utility>
 #include <vector>
 #include "DataFormatsMID/Cluster2D.h"
 #include "DataFormatsMID/Cluster3D.h"
@@ -41,9 +42,18 @@ class Tracker
   /// Gets number of sigmas for cuts
   inline float getSigmaCut() const { return mSigmaCut; }
 
+  /// Sets the number of threads used to process the four passes
+  /// (right/left side, inward/outward) of each event. The reconstructed tracks do not depend on it
+  void setNThreads(int nThreads) { mNThreads = (nThreads < 1) ? 1 : nThreads; }
+  /// Gets the number of threads
+  inline int getNThreads() const { return mNThreads; }
+
   bool process(const std::vector<Cluster2D>& clusters);
   bool init();
 
+  /// Gets the time spent in the last call to process, in microseconds
+  double getProcessingTime() const { return mProcessingTime; }
+
   /// Gets the array of reconstructes tracks
   const std::vector<Track>& getTracks() { return mTracks; }
 
@@ -51,12 +61,29 @@ class Tracker
   unsigned long int getNTracks() { return mNTracks; }
 
  private:
-  bool processSide(bool isRight, bool isInward);
+  /// Extent of the clusters of one RPC, sorted in y if they are many,
+  /// to restrict the search to the clusters close to the track
+  struct ClusterBucket {
+    std::vector<std::pair<float, int>> sortedY; ///< y position and index in mClusters, in increasing y
+    float yMin = 0.;                            ///< minimum y of the clusters
+    float yMax = 0.;                            ///< maximum y of the clusters
+    float zMin = 0.;                            ///< minimum z of the clusters
+    float zMax = 0.;                            ///< maximum z of the clusters
+    float maxSigmaY2 = 0.;                      ///< maximum y variance of the clusters
+  };
+
+  /// Minimum number of clusters in an RPC to sort them in y
+  static constexpr unsigned long int sMinClustersToSort = 8;
+
+  void processPasses(int nThreads);
+  void processSide(bool isRight, bool isInward, std::vector<Track>& candidates) const;
   bool addTrack(const Track& track);
-  bool followTrack(const Track& track, bool isRight, bool isInward);
+  bool followTrack(const Track& track, bool isRight, bool isInward, std::vector<Track>& candidates) const;
   bool findNextCluster(const Track& track, bool isRight, bool isInward, int chamber, int firstRPC, int lastRPC,
                        int& nFiredChambers, double& bestChi2, Track& bestTrack, double chi2 = 0., int depth = 1) const;
+  void fillBucket(int deId);
   int getClusterId(int id, int deId) const;
+  void getSearchWindow(const Track& track, int deId, float& yMin, float& yMax) const;
   int getFirstNeighbourRPC(int rpc) const;
   int getLastNeighbourRPC(int rpc) const;
   bool loadClusters(const std::vector<Cluster2D>& clusters);
@@ -64,7 +91,7 @@ class Tracker
   void reset();
   double runKalmanFilter(Track& track, const Cluster3D& cluster) const;
   double tryOneCluster(const Track& track, const Cluster3D& cluster, Track& newTrack) const;
-  void finalizeTrack(Track& track);
+  void finalizeTrack(Track& track) const;
 
   float mImpactParamCut = 210.; ///< Cut on impact parameter
   float mSigmaCut = 5.;         ///< Number of sigmas cut
@@ -72,10 +99,16 @@ class Tracker
 
   std::vector<Cluster3D> mClusters[72]; ///< Ordered arrays of clusters
   unsigned long int mNClusters[72];     ///< Number of clusters per RPC
+  ClusterBucket mBuckets[72];           ///< Clusters per RPC sorted in y
+
+  std::vector<Track> mCandidates[4]; ///< Candidate tracks of each pass, in the order they are found
 
   std::vector<Track> mTracks;     ///< Array of tracks
   unsigned long int mNTracks = 0; ///< Number of tracks
 
+  int mNThreads = 1;           ///< Number of threads
+  double mProcessingTime = 0.; ///< Time spent in the last call to process (us)
+
   GeometryTransformer mTransformer; ///< Geometry transformer
 };
 } // namespace mid
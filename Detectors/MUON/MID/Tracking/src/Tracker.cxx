@@ -14,7 +14,12 @@
 /// \date   09 May 2017
 #include "MIDTracking/Tracker.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <exception>
+#include <thread>
 #include "FairLogger.h"
 #include "MIDBase/Constants.h"
 
@@ -101,36 +106,142 @@ bool Tracker::loadClusters(const std::vector<Cluster2D>& clusters)
                << "," << cl.position.z() << ")";
   }
 
+  for (int deId = 0; deId < 72; ++deId) {
+    fillBucket(deId);
+  }
+
   return (clusters.size() > 0);
 }
 
+//______________________________________________________________________________
+void Tracker::fillBucket(int deId)
+{
+  /// Computes the extent of the clusters of the RPC
+  /// and sorts them in y if there are many of them
+  ClusterBucket& bucket(mBuckets[deId]);
+  bucket.sortedY.clear();
+  if (mNClusters[deId] == 0) {
+    return;
+  }
+  auto& firstCl = mClusters[deId][0];
+  bucket.yMin = bucket.yMax = firstCl.position.y();
+  bucket.zMin = bucket.zMax = firstCl.position.z();
+  bucket.maxSigmaY2 = firstCl.sigmaY2;
+  for (int icl = 1; icl < mNClusters[deId]; ++icl) {
+    auto& cl = mClusters[deId][icl];
+    bucket.yMin = std::min(bucket.yMin, cl.position.y());
+    bucket.yMax = std::max(bucket.yMax, cl.position.y());
+    bucket.zMin = std::min(bucket.zMin, cl.position.z());
+    bucket.zMax = std::max(bucket.zMax, cl.position.z());
+    bucket.maxSigmaY2 = std::max(bucket.maxSigmaY2, cl.sigmaY2);
+  }
+  if (mNClusters[deId] >= sMinClustersToSort) {
+    for (int icl = 0; icl < mNClusters[deId]; ++icl) {
+      bucket.sortedY.emplace_back(mClusters[deId][icl].position.y(), icl);
+    }
+    std::sort(bucket.sortedY.begin(), bucket.sortedY.end());
+  }
+}
+
+//______________________________________________________________________________
+void Tracker::getSearchWindow(const Track& track, int deId, float& yMin, float& yMax) const
+{
+  /// Gets the y range of the RPC where the clusters can pass the distance cut of tryOneCluster.
+  /// The cut is evaluated at the lowest and highest z of the clusters of the RPC
+  /// with their largest uncertainty: since the track position is linear in z
+  /// and the distance cut is convex, this range contains all the compatible clusters
+  const ClusterBucket& bucket(mBuckets[deId]);
+  const std::array<float, 6> covParams = track.getCovarianceParameters();
+  double zs[2] = { bucket.zMin, bucket.zMax };
+  for (int iz = 0; iz < 2; ++iz) {
+    double dZ = zs[iz] - track.getPosition().z();
+    double newPos = track.getPosition().y() + track.getDirection().y() * dZ;
+    double err2 = covParams[1] + dZ * dZ * covParams[3] + 2. * dZ * covParams[5] + bucket.maxSigmaY2;
+    // Add a small margin to be safe against rounding
+    double distMax = mSigmaCut * std::sqrt(2. * std::max(err2, 0.)) + 4. + 0.1;
+    float low = newPos - distMax;
+    float high = newPos + distMax;
+    yMin = (iz == 0) ? low : std::min(yMin, low);
+    yMax = (iz == 0) ? high : std::max(yMax, high);
+  }
+}
+
 //______________________________________________________________________________
 bool Tracker::process(const std::vector<Cluster2D>& clusters)
 {
   /// Main function: runs on a data containing the clusters
   /// and builds the tracks
 
+  auto tStart = std::chrono::high_resolution_clock::now();
+
   // Reset cluster and tracks information
   reset();
 
   // Load the digits to get the fired pads
   if (loadClusters(clusters)) {
-    // Right and left side can be processed in parallel
-    // Right inward
-    processSide(true, true);
-    // Right outward
-    processSide(true, false);
-    // Left inward
-    processSide(false, true);
-    // left outward
-    processSide(false, false);
+    // Search the candidate tracks of the four passes, possibly in parallel
+    processPasses(mNThreads);
+
+    // Then add them to the list in the order of the passes:
+    // right inward, right outward, left inward, left outward.
+    // This keeps the result independent of the number of threads
+    for (int ipass = 0; ipass < 4; ++ipass) {
+      for (auto& track : mCandidates[ipass]) {
+        addTrack(track);
+      }
+    }
   }
 
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::high_resolution_clock::now() - tStart;
+  mProcessingTime = elapsed.count();
+
   return true;
 }
 
 //______________________________________________________________________________
-bool Tracker::processSide(bool isRight, bool isInward)
+void Tracker::processPasses(int nThreads)
+{
+  /// Runs the four passes on the loaded clusters. The passes only read the clusters
+  /// and each one fills its own list of candidates, so that they can run in parallel
+  for (int ipass = 0; ipass < 4; ++ipass) {
+    mCandidates[ipass].clear();
+  }
+  nThreads = std::min(nThreads, 4);
+  if (nThreads <= 1) {
+    for (int ipass = 0; ipass < 4; ++ipass) {
+      processSide(ipass < 2, ipass % 2 == 0, mCandidates[ipass]);
+    }
+    return;
+  }
+
+  std::atomic<int> nextPass(0);
+  std::exception_ptr exceptions[4];
+  auto worker = [this, &nextPass, &exceptions](int iThread) {
+    try {
+      for (int ipass = nextPass++; ipass < 4; ipass = nextPass++) {
+        processSide(ipass < 2, ipass % 2 == 0, mCandidates[ipass]);
+      }
+    } catch (...) {
+      exceptions[iThread] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int iThread = 1; iThread < nThreads; ++iThread) {
+    threads.emplace_back(worker, iThread);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+//______________________________________________________________________________
+void Tracker::processSide(bool isRight, bool isInward, std::vector<Track>& candidates) const
 {
   /// Make tracks on one side of the detector
   int firstCh = (isInward) ? 3 : 0;
@@ -165,12 +276,11 @@ bool Tracker::processSide(bool isRight, bool isInward)
           LOG(DEBUG) << deId1 << " - " << deId2;
           LOG(DEBUG) << "Position: " << track.getPosition();
           // LOG(DEBUG) << "Covariance: " << track.getCovarianceParameters();
-          followTrack(track, isRight, isInward);
+          followTrack(track, isRight, isInward, candidates);
         } // loop on clusters in second plane
       }   // loop on RPCs in second plane
     }     // loop on clusters in first plane
   }       // loop on RPCs in first plane
-  return true;
 }
 
 //______________________________________________________________________________
@@ -205,7 +315,7 @@ bool Tracker::makeTrackSeed(Track& track, const Cluster3D& cl1, const Cluster3D&
 }
 
 //______________________________________________________________________________
-bool Tracker::followTrack(const Track& track, bool isRight, bool isInward)
+bool Tracker::followTrack(const Track& track, bool isRight, bool isInward, std::vector<Track>& candidates) const
 {
   /// Follows the track segment in the other station
   double bestChi2 = 2. * mSigmaCut * mSigmaCut;
@@ -214,11 +324,9 @@ bool Tracker::followTrack(const Track& track, bool isRight, bool isInward)
   chamberOrder[0] = isInward ? 1 : 2;
   chamberOrder[1] = isInward ? 0 : 3;
 
-  // Add the track to the list
-  if (mNTracks >= static_cast<unsigned long int>(mTracks.size())) {
-    mTracks.emplace_back(Track());
-  }
-  Track& bestTrack(mTracks[mNTracks]);
+  // Look for the best track directly in the list of candidates
+  candidates.emplace_back();
+  Track& bestTrack(candidates.back());
 
   // loop on next two chambers
   for (int ich = 0; ich < 2; ++ich) {
@@ -232,14 +340,16 @@ bool Tracker::followTrack(const Track& track, bool isRight, bool isInward)
 
   if (nFiredChambers == 0) {
     // No track found
+    candidates.pop_back();
     return false;
   }
 
   // Extrapolate to first cluster in MT11 and compute the chi2
   finalizeTrack(bestTrack);
 
-  // Add the track if it is not compatible or better than the ones we already have
-  return addTrack(bestTrack);
+  // The track is added to the list at the end of the pass,
+  // if it is not compatible or better than the ones we already have
+  return true;
 }
 
 //______________________________________________________________________________
@@ -250,10 +360,37 @@ bool Tracker::findNextCluster(const Track& track, bool isRight, bool isInward, i
   int nextChamber = (isInward) ? chamber - 1 : chamber + 1;
   int rpcOffset = Constants::getDEId(isRight, chamber, 0);
   Track newTrack;
+  std::vector<int> candidateClusters;
+  float yMin = 0., yMax = 0.;
   for (int irpc = firstRPC; irpc <= lastRPC; ++irpc) {
     int deId = rpcOffset + irpc;
-    for (int icl = 0; icl < mNClusters[deId]; ++icl) {
+    if (mNClusters[deId] == 0) {
+      continue;
+    }
+    // Only test the clusters in the y range compatible with the track
+    const ClusterBucket& bucket(mBuckets[deId]);
+    getSearchWindow(track, deId, yMin, yMax);
+    if (yMax < bucket.yMin || yMin > bucket.yMax) {
+      continue;
+    }
+    int nCandidates = mNClusters[deId];
+    bool isSorted = !bucket.sortedY.empty();
+    if (isSorted) {
+      // Select the clusters in the window, keeping the order in which they were loaded
+      auto first = std::lower_bound(bucket.sortedY.begin(), bucket.sortedY.end(), std::make_pair(yMin, -1));
+      candidateClusters.clear();
+      for (auto it = first; it != bucket.sortedY.end() && it->first <= yMax; ++it) {
+        candidateClusters.push_back(it->second);
+      }
+      std::sort(candidateClusters.begin(), candidateClusters.end());
+      nCandidates = candidateClusters.size();
+    }
+    for (int icand = 0; icand < nCandidates; ++icand) {
+      int icl = isSorted ? candidateClusters[icand] : icand;
       auto& cl = mClusters[deId][icl];
+      if (cl.position.y() < yMin || cl.position.y() > yMax) {
+        continue;
+      }
       double addChi2AtCluster = tryOneCluster(track, cl, newTrack);
       double sumChi2 = chi2 + addChi2AtCluster;
       if (sumChi2 > bestChi2) {
@@ -368,7 +505,7 @@ double Tracker::runKalmanFilter(Track& track, const Cluster3D& cluster) const
 }
 
 //______________________________________________________________________________
-void Tracker::finalizeTrack(Track& track)
+void Tracker::finalizeTrack(Track& track) const
 {
   /// Computes the chi2 of the track
   /// and extrapolate it to the first cluster
@@ -382,7 +519,7 @@ void Tracker::finalizeTrack(Track& track)
     ++ndf;
     int deId = matchedClusterIdx / 1000;
     int icl = matchedClusterIdx % 1000 - 1;
-    Cluster3D& cl(mClusters[deId][icl]);
+    const Cluster3D& cl(mClusters[deId][icl]);
     track.propagateToZ(cl.position.z());
     double clPos[2] = { cl.position.x(), cl.position.y() };
     double clErr2[2] = { cl.sigmaX2, cl.sigmaY2 };
@@ -440,6 +577,11 @@ bool Tracker::addTrack(const Track& track)
   }
 
   // The new track is not compatible with the previous ones: add the track to the list
+  if (mNTracks >= static_cast<unsigned long int>(mTracks.size())) {
+    mTracks.emplace_back(track);
+  } else {
+    mTracks[mNTracks] = track;
+  }
   ++mNTracks;
   return true;
 }
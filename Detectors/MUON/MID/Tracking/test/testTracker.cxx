@@ -177,5 +177,31 @@ BOOST_DATA_TEST_CASE_F(MyFixture, TestMultipleTracks, boost::unit_test::data::xr
   BOOST_TEST_MESSAGE("Fraction of fake tracks: " << (double)nTotFakes / (double)nTotReconstructible);
 }
 
+BOOST_DATA_TEST_CASE_F(MyFixture, TestParallelPasses, boost::unit_test::data::xrange(1, 9), nTracksPerEvent)
+{
+  Tracker parallelTracker(geoTrans);
+  parallelTracker.setNThreads(4);
+  for (int ievt = 0; ievt < 100; ++ievt) {
+    std::vector<Cluster2D> clusters;
+    for (auto& trCl : getTrackClusters(nTracksPerEvent)) {
+      clusters.insert(clusters.end(), trCl.clusters.begin(), trCl.clusters.end());
+    }
+    tracker.process(clusters);
+    parallelTracker.process(clusters);
+    BOOST_TEST(parallelTracker.getProcessingTime() >= 0.);
+
+    // The tracks do not depend on the number of threads
+    BOOST_REQUIRE(parallelTracker.getNTracks() == tracker.getNTracks());
+    for (int itr = 0; itr < tracker.getNTracks(); ++itr) {
+      const Track& track = tracker.getTracks()[itr];
+      const Track& parallelTrack = parallelTracker.getTracks()[itr];
+      for (int ich = 0; ich < 4; ++ich) {
+        BOOST_TEST(parallelTrack.getClusterMatched(ich) == track.getClusterMatched(ich));
+      }
+      BOOST_TEST(parallelTrack.getChi2() == track.getChi2());
+    }
+  }
+}
+
 } // namespace mid
 } // namespace o2
@@ -13,6 +13,7 @@
 #ifndef ALICEO2_PHOS_CLUSTERER_H
 #define ALICEO2_PHOS_CLUSTERER_H
 
+#include <vector>
 #include "Rtypes.h" // for Clusterer::Class, Double_t, ClassDef, etc
 
 namespace o2
@@ -23,20 +24,76 @@ class Digit;
 class Cluster;
 class Geometry;
 
+/// \struct ClusterProperties
+/// \brief Properties of the clusters of an event, one entry of each vector per cluster
+/// The digits of the cluster i are digitIndices[firstDigit[i]] to digitIndices[firstDigit[i] + multiplicity[i] - 1],
+/// as indices in the input digits, the first one being the seed.
+struct ClusterProperties {
+  std::vector<int> module;        ///< PHOS module, from 1
+  std::vector<int> firstDigit;    ///< first digit of the cluster in digitIndices
+  std::vector<int> multiplicity;  ///< number of digits
+  std::vector<float> energy;      ///< full energy
+  std::vector<float> coreEnergy;  ///< energy within the core radius from the centre of gravity
+  std::vector<float> localPosX;   ///< centre of gravity in the module (phi direction)
+  std::vector<float> localPosZ;   ///< centre of gravity in the module (z direction)
+  std::vector<float> dispersion;  ///< shower dispersion
+  std::vector<float> lambdaLong;  ///< shower ellipse axes
+  std::vector<float> lambdaShort; ///< shower ellipse axes
+  std::vector<float> time;        ///< time of the digit with maximal energy deposition
+  std::vector<int> digitIndices;  ///< digits of all the clusters
+
+  int size() const { return multiplicity.size(); }
+  void clear();
+};
+
+/// \class Clusterer
+/// \brief Cluster finder on a dense grid of the cells of the PHOS modules
+/// The digits are put in the grid of the cells (64 x 56 per module), a cluster grows from a seed over the cells
+/// with a common vertex (breadth first, the queue being on the stack since a cluster is at most a module).
+/// The properties of the clusters are evaluated at once in the ClusterProperties, all the buffers are kept
+/// from one event to the next.
 class Clusterer
 {
  public:
+  static constexpr int kNRows = 64;                    ///< cells along phi in a module
+  static constexpr int kNCols = 56;                    ///< cells along z in a module
+  static constexpr int kNCellsInModule = kNRows * kNCols;
+  static constexpr float kLogWeight = 4.5;             ///< weight used in position and disp. calculations
+
   Clusterer() = default;
   ~Clusterer() = default;
 
+  /// Clusters of the digits, kept as Cluster objects with their list of digits
   void process(const std::vector<Digit>* digits, std::vector<Cluster>* clusters);
-  void MakeClusters(const std::vector<Digit>* digits, std::vector<Cluster>* clusters);
-  void EvalCluProperties(const std::vector<Digit>* digits, std::vector<Cluster>* clusters);
+  /// Clusters of the digits, in the properties of the clusterer, valid until the next call
+  const ClusterProperties& process(const std::vector<Digit>& digits);
+
+  void MakeClusters(const std::vector<Digit>& digits);
+  void EvalCluProperties(const std::vector<Digit>& digits);
+
+  const ClusterProperties& getClusterProperties() const { return mClusters; }
 
  protected:
+  void init();
+  void fillGrid(const std::vector<Digit>& digits);
+  void clearGrid(const std::vector<Digit>& digits);
+  /// adds to the cluster the digits of the cell above the purification threshold, returns false if there are none
+  bool takeCell(int cell, const std::vector<Digit>& digits);
+
   Geometry* mPHOSGeom = nullptr; ///< PHOS geometry
+
+  double mClusteringThreshold = 0.050; ///< minimal energy of a seed, TODO: To be read from RecoParam
+  double mPurifyThreshold = 0.020;     ///< minimal energy of a digit in a cluster, TODO: Should be in RecoParams
+  double mCoreRadius = 3.5;            ///< radius of the core energy, TODO: should be stored in recoParams
+
+  std::vector<int> mCellFirstDigit; //! first digit of each cell (absId - 1), -1 if none
+  std::vector<int> mNextDigit;      //! next digit in the same cell, -1 if none
+  std::vector<char> mDigitUsed;     //! digits already in a cluster
+  std::vector<float> mCellX;        //! position of each cell in its module (phi direction)
+  std::vector<float> mCellZ;        //! position of each cell in its module (z direction)
+  ClusterProperties mClusters;      //! clusters of the last event
 };
-}
-}
+} // namespace phos
+} // namespace o2
 
-#endif /* ALICEO2_ITS_TRIVIALCLUSTERER_H */
+#endif /* ALICEO2_PHOS_CLUSTERER_H */
@@ -11,6 +11,9 @@
 /// \file Clusterer.cxx
 /// \brief Implementation of the PHOS cluster finder
 
+#include <algorithm>
+#include <cmath>
+
 #include "PHOSReconstruction/Clusterer.h" // for LOG
 #include "PHOSReconstruction/Cluster.h"
 #include "PHOSBase/Geometry.h"
@@ -23,114 +26,258 @@ using namespace o2::phos;
 ClassImp(Clusterer);
 
 //____________________________________________________________________________
-void Clusterer::process(const std::vector<Digit>* digits, std::vector<Cluster>* clusters)
+void ClusterProperties::clear()
 {
+  module.clear();
+  firstDigit.clear();
+  multiplicity.clear();
+  energy.clear();
+  coreEnergy.clear();
+  localPosX.clear();
+  localPosZ.clear();
+  dispersion.clear();
+  lambdaLong.clear();
+  lambdaShort.clear();
+  time.clear();
+  digitIndices.clear();
+}
 
+//____________________________________________________________________________
+void Clusterer::init()
+{
   if (!mPHOSGeom) {
     mPHOSGeom = Geometry::GetInstance();
   }
+  if (!mCellFirstDigit.empty()) {
+    return;
+  }
+  mCellFirstDigit.assign(mPHOSGeom->GetTotalNCells(), -1);
+
+  // the positions in the module are the same for all the modules
+  mCellX.resize(kNCellsInModule);
+  mCellZ.resize(kNCellsInModule);
+  for (int cell = 0; cell < kNCellsInModule; cell++) {
+    double x = 0., z = 0.;
+    mPHOSGeom->AbsIdToRelPosInModule(cell + 1, x, z);
+    mCellX[cell] = x;
+    mCellZ[cell] = z;
+  }
+}
+
+//____________________________________________________________________________
+void Clusterer::process(const std::vector<Digit>* digits, std::vector<Cluster>* clusters)
+{
+  init();
 
   // Collect digits to clusters
-  MakeClusters(digits, clusters);
+  MakeClusters(*digits);
 
+  // Unfolding and evaluation of the properties are left to the Cluster objects
+  for (int i = 0; i < mClusters.size(); i++) {
+    const int* indices = &mClusters.digitIndices[mClusters.firstDigit[i]];
+    const Digit& seed = (*digits)[indices[0]];
+    Cluster clu(seed.getAbsId(), seed.getAmplitude(), seed.getTime());
+    for (int j = 1; j < mClusters.multiplicity[i]; j++) {
+      const Digit& digit = (*digits)[indices[j]];
+      clu.AddDigit(digit.getAbsId(), digit.getAmplitude(), digit.getTime());
+    }
+    clu.Purify(mPurifyThreshold);
+    clu.EvalAll(digits);
+    clusters->push_back(clu);
+  }
   LOG(DEBUG) << "Number of PHOS clusters" << clusters->size() << FairLogger::endl;
+}
+
+//____________________________________________________________________________
+const ClusterProperties& Clusterer::process(const std::vector<Digit>& digits)
+{
+  init();
+
+  // Collect digits to clusters
+  MakeClusters(digits);
+
+  LOG(DEBUG) << "Number of PHOS clusters" << mClusters.size() << FairLogger::endl;
 
   // Unfold overlapped clusters
   // TODO:
   // MakeUnfolding();
 
   // Calculate properties of collected clusters (Local position, energy, disp etc.)
-  EvalCluProperties(digits, clusters);
+  EvalCluProperties(digits);
   LOG(DEBUG) << "PHOS clustrization done" << FairLogger::endl;
+  return mClusters;
 }
+
 //____________________________________________________________________________
-void Clusterer::MakeClusters(const std::vector<Digit>* digits, std::vector<Cluster>* clusters)
+void Clusterer::fillGrid(const std::vector<Digit>& digits)
 {
-  // A cluster is defined as a list of neighbour digits
-  const double kClusteringThreshold = 0.050; // TODO: To be read from RecoParam
-  const double kDigitMinEnergy = 0.010;      // TODO: to be implemented as a digit energy cut
-
-  // Mark all digits as unused yet
-  const int maxNDigits = 3584; // There is no clusters larger than PHOS module ;)
-  int nDigits = digits->size();
-  bool digitsUsed[maxNDigits];
-
+  int nDigits = digits.size();
+  mNextDigit.resize(nDigits);
+  mDigitUsed.assign(nDigits, 0);
   for (int i = 0; i < nDigits; i++) {
-    digitsUsed[i] = false;
+    int absId = digits[i].getAbsId();
+    if (!mPHOSGeom->IsCellExists(absId)) {
+      LOG(WARNING) << "PHOS digit with wrong absId " << absId << FairLogger::endl;
+      mNextDigit[i] = -1;
+      mDigitUsed[i] = 1;
+      continue;
+    }
+    mNextDigit[i] = mCellFirstDigit[absId - 1];
+    mCellFirstDigit[absId - 1] = i;
   }
-  int iFirst = 0; // first index of digit which potentially can be a part of cluster
-                  // e.g. first digit in this module, first CPV digit etc.
+}
 
-  for (int i = 0; i < nDigits; i++) {
-    if (digitsUsed[i])
+//____________________________________________________________________________
+void Clusterer::clearGrid(const std::vector<Digit>& digits)
+{
+  // only the cells with digits were touched
+  for (const auto& digit : digits) {
+    int absId = digit.getAbsId();
+    if (mPHOSGeom->IsCellExists(absId)) {
+      mCellFirstDigit[absId - 1] = -1;
+    }
+  }
+}
+
+//____________________________________________________________________________
+bool Clusterer::takeCell(int cell, const std::vector<Digit>& digits)
+{
+  bool taken = false;
+  for (int i = mCellFirstDigit[cell]; i >= 0; i = mNextDigit[i]) {
+    if (mDigitUsed[i] || digits[i].getAmplitude() < mPurifyThreshold) {
       continue;
+    }
+    mDigitUsed[i] = 1;
+    mClusters.digitIndices.push_back(i);
+    taken = true;
+  }
+  return taken;
+}
 
-    const Digit* digitSeed = &(digits->at(i));
+//____________________________________________________________________________
+void Clusterer::MakeClusters(const std::vector<Digit>& digits)
+{
+  // A cluster is defined as a list of neighbour digits, i.e. having at least a common vertex.
+  // The digits below the purification threshold are not added, so that the clusters do not need
+  // to be purified afterwards.
+  mClusters.clear();
+  fillGrid(digits);
 
-    // is this digit so energetic that start cluster?
-    Cluster* clu = nullptr;
-    int iDigitInCluster = 0;
-    if (digitSeed->getAmplitude() > kClusteringThreshold) {
-      // start a new EMC RecPoint
-      Cluster cluTmp(digitSeed->getAbsId(), digitSeed->getAmplitude(), digitSeed->getTime());
-      clusters->push_back(cluTmp);
-      clu = &(clusters->back());
+  int queue[kNCellsInModule]; // There is no clusters larger than PHOS module ;)
 
-      digitsUsed[i] = true;
-      iDigitInCluster = 1;
-    } else {
+  int nDigits = digits.size();
+  for (int i = 0; i < nDigits; i++) {
+    if (mDigitUsed[i] || digits[i].getAmplitude() <= mClusteringThreshold) {
       continue;
     }
 
-    // Now scan remaining digits in list to find neigbours of our seed
-    int index = 0;
-    while (index < iDigitInCluster) { // scan over digits already in cluster
-      int digitSeedAbsId = clu->GetDigitAbsId(index);
-      index++;
-      for (Int_t j = iFirst; j < nDigits; j++) {
-        if (digitsUsed[j])
-          continue; // look through remaining digits
-        const Digit* digitN = &(digits->at(j));
-        ;
-        // call (digit,digitN) in THAT oder !!!!!
-        Int_t ineb = mPHOSGeom->AreNeighbours(digitSeedAbsId, digitN->getAbsId());
-        switch (ineb) {
-          case -1: // too early (e.g. previous module), do not look before j at subsequent passes
-            iFirst = j;
-            break;
-          case 0: // not a neighbour
-            break;
-          case 1: // are neighbours
-            clu->AddDigit(digitN->getAbsId(), digitN->getAmplitude(), digitN->getTime());
-            iDigitInCluster++;
-            digitsUsed[j] = true;
-            break;
-          case 2: // too far from each other
-          default:
-            break;
-        } // switch
+    // start a new cluster from the seed, then the other digits of the same cell
+    int cell = digits[i].getAbsId() - 1;
+    int moduleOffset = cell - cell % kNCellsInModule;
+    mClusters.module.push_back(1 + cell / kNCellsInModule);
+    mClusters.firstDigit.push_back(mClusters.digitIndices.size());
+    mDigitUsed[i] = 1;
+    mClusters.digitIndices.push_back(i);
+    takeCell(cell, digits);
+
+    // each cell enters the queue at most once, when its digits are taken
+    int nQueued = 0;
+    queue[nQueued++] = cell - moduleOffset;
+    for (int index = 0; index < nQueued; index++) {
+      int row = queue[index] / kNCols;
+      int col = queue[index] % kNCols;
+      for (int iRow = std::max(row - 1, 0); iRow <= std::min(row + 1, kNRows - 1); iRow++) {
+        for (int iCol = std::max(col - 1, 0); iCol <= std::min(col + 1, kNCols - 1); iCol++) {
+          int neighbour = iRow * kNCols + iCol;
+          if (mCellFirstDigit[moduleOffset + neighbour] >= 0 && takeCell(moduleOffset + neighbour, digits)) {
+            queue[nQueued++] = neighbour;
+          }
+        }
       }
-    } // loop over cluster
-  }   // energy theshold
+    }
+    mClusters.multiplicity.push_back(mClusters.digitIndices.size() - mClusters.firstDigit.back());
+  }
+
+  clearGrid(digits);
 }
+
 //____________________________________________________________________________
-void Clusterer::EvalCluProperties(const std::vector<Digit>* digits, std::vector<Cluster>* clusters)
+void Clusterer::EvalCluProperties(const std::vector<Digit>& digits)
 {
-  const double kThreshold = 0.020; // TODO: Should be in RecoParams
-  LOG(DEBUG) << "EvalCluProperties: nclu=" << clusters->size() << FairLogger::endl;
-
-  for (int i = 0; i < clusters->size(); i++) {
-    LOG(DEBUG) << "   i=" << i << FairLogger::endl;
-
-    Cluster* clu = &(clusters->at(i));
-    LOG(DEBUG) << " clu=" << clu << FairLogger::endl;
-
-    clu->Purify(kThreshold);
-    //  LOG(DEBUG) << "Purify done" << FairLogger::endl;
-    clu->EvalAll(digits);
-    double PosX, PosZ;
-    clu->GetLocalPosition(PosX, PosZ);
-    LOG(DEBUG) << "EvalALl done: clu E=" << clu->GetEnergy() << " pos = (" << PosX << "," << PosZ << ")"
-               << FairLogger::endl;
+  LOG(DEBUG) << "EvalCluProperties: nclu=" << mClusters.size() << FairLogger::endl;
+
+  int nClusters = mClusters.size();
+  mClusters.energy.resize(nClusters);
+  mClusters.coreEnergy.resize(nClusters);
+  mClusters.localPosX.resize(nClusters);
+  mClusters.localPosZ.resize(nClusters);
+  mClusters.dispersion.resize(nClusters);
+  mClusters.lambdaLong.resize(nClusters);
+  mClusters.lambdaShort.resize(nClusters);
+  mClusters.time.resize(nClusters);
+
+  for (int i = 0; i < nClusters; i++) {
+    const int* indices = &mClusters.digitIndices[mClusters.firstDigit[i]];
+    int multiplicity = mClusters.multiplicity[i];
+
+    // Full energy and time of the digit with maximal energy deposition
+    double fullEnergy = 0., eMax = 0.;
+    float time = 0.;
+    for (int j = 0; j < multiplicity; j++) {
+      const Digit& digit = digits[indices[j]];
+      fullEnergy += digit.getAmplitude();
+      if (digit.getAmplitude() > eMax) {
+        eMax = digit.getAmplitude();
+        time = digit.getTime();
+      }
+    }
+
+    // Centre of gravity and second moments with the logarithmic weights
+    double wtot = 0., x = 0., z = 0., dxx = 0., dxz = 0., dzz = 0.;
+    for (int j = 0; j < multiplicity; j++) {
+      const Digit& digit = digits[indices[j]];
+      int cell = (digit.getAbsId() - 1) % kNCellsInModule;
+      double w = std::max(0., kLogWeight + std::log(digit.getAmplitude() / fullEnergy));
+      double xi = mCellX[cell], zi = mCellZ[cell];
+      x += w * xi;
+      z += w * zi;
+      dxx += w * xi * xi;
+      dzz += w * zi * zi;
+      dxz += w * xi * zi;
+      wtot += w;
+    }
+    double lambdaLong = 0., lambdaShort = 0., dispersion = 0.;
+    if (wtot > 0) {
+      x /= wtot;
+      z /= wtot;
+      dxx = dxx / wtot - x * x;
+      dzz = dzz / wtot - z * z;
+      dxz = dxz / wtot - x * z;
+      double root = std::sqrt(0.25 * (dxx - dzz) * (dxx - dzz) + dxz * dxz);
+      lambdaLong = std::sqrt(std::max(0., 0.5 * (dxx + dzz) + root));
+      lambdaShort = std::sqrt(std::max(0., 0.5 * (dxx + dzz) - root));
+      dispersion = std::sqrt(std::max(0., dxx + dzz));
+    }
+
+    // Energy in the core around the centre of gravity
+    double coreEnergy = 0.;
+    for (int j = 0; j < multiplicity; j++) {
+      const Digit& digit = digits[indices[j]];
+      int cell = (digit.getAbsId() - 1) % kNCellsInModule;
+      double dx = mCellX[cell] - x, dz = mCellZ[cell] - z;
+      if (dx * dx + dz * dz < mCoreRadius * mCoreRadius) {
+        coreEnergy += digit.getAmplitude();
+      }
+    }
+
+    mClusters.energy[i] = fullEnergy;
+    mClusters.coreEnergy[i] = coreEnergy;
+    mClusters.localPosX[i] = x;
+    mClusters.localPosZ[i] = z;
+    mClusters.dispersion[i] = dispersion;
+    mClusters.lambdaLong[i] = lambdaLong;
+    mClusters.lambdaShort[i] = lambdaShort;
+    mClusters.time[i] = time;
+    LOG(DEBUG) << "   clu E=" << fullEnergy << " pos = (" << x << "," << z << ")" << FairLogger::endl;
   }
 }
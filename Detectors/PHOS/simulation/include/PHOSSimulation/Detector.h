@@ -21,6 +21,7 @@
 #include <vector>
 
 class FairVolume;
+class TGeoNavigator;
 
 namespace o2
 {
@@ -98,6 +99,17 @@ class Detector : public o2::base::DetImpl<Detector>
   Hit* AddHit(Int_t trackID, Int_t detID, const Point3D<float>& pos, const Vector3D<float>& mom, Double_t totE,
               Double_t time, Double_t eLoss);
 
+  ///
+  /// Shower library fast simulation: the showers start at the entrance of a module
+  ///
+  std::vector<std::string> getShowerLibraryVolumes() const override;
+
+  ///
+  /// Create the hits of a library shower, for the crystals the shower spots are in
+  ///
+  void depositLibraryShower(o2::base::ShowerLibrary::Shower const& shower, const double entry[3], const double dir[3],
+                            double energy, double time) override;
+
   ///
   /// Register vector with hits
   ///
@@ -188,6 +200,7 @@ class Detector : public o2::base::DetImpl<Detector>
   Int_t mCurrentCellID;             //! current cell Id
   Int_t mCurentSuperParent;         //! current SuperParent ID: particle entered PHOS
   Hit* mCurrentHit;                 //! current Hit
+  TGeoNavigator* mLibraryNavigator; //! navigator locating the library shower spots, apart from the one of the transport
 
   template <typename Det>
   friend class o2::base::DetImpl;
@@ -14,6 +14,7 @@
 #include "PHOSBase/Digit.h"
 #include "PHOSBase/Geometry.h"
 #include "PHOSBase/Hit.h"
+#include "DetectorsBase/CellAccumulator.h"
 
 namespace o2
 {
@@ -83,7 +84,7 @@ class Digitizer : public TObject
   double mMinNoiseTime = -200.;        ///< minimum time in noise channels (in ns)
   double mMaxNoiseTime = 2000.;        ///< minimum time in noise channels (in ns)
 
-  //  std::unordered_map<Int_t, std::deque<Digit>> mDigits; ///< used to sort digits by tower
+  o2::base::CellAccumulator<Digit> mDigits; //! digits of each cell
 
   ClassDefOverride(Digitizer, 1);
 };
@@ -9,12 +9,16 @@
 // or submit itself to any jurisdiction.
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <map>
 
 #include "TGeoManager.h"
+#include "TGeoNavigator.h"
+#include "TGeoNode.h"
 #include "TGeoVolume.h"
 #include "TVirtualMC.h"
+#include "TVirtualMCStack.h"
 
 #include "FairGeoNode.h"
 #include "FairRootManager.h"
@@ -40,7 +44,8 @@ Detector::Detector(Bool_t active)
     mCurrentTrackID(-1),
     mCurrentCellID(-1),
     mCurentSuperParent(-1),
-    mCurrentHit(nullptr)
+    mCurrentHit(nullptr),
+    mLibraryNavigator(nullptr)
 {
 }
 
@@ -50,13 +55,15 @@ Detector::Detector(const Detector& rhs)
     mCurrentTrackID(-1),
     mCurrentCellID(-1),
     mCurentSuperParent(-1),
-    mCurrentHit(nullptr)
+    mCurrentHit(nullptr),
+    mLibraryNavigator(nullptr)
 {
 }
 
 Detector::~Detector()
 {
   o2::utils::freeSimVector(mHits);
+  delete mLibraryNavigator;
 }
 
 void Detector::InitializeO2Detector()
@@ -225,6 +232,63 @@ Hit* Detector::AddHit(Int_t trackID, Int_t detID, const Point3D<float>& pos, con
   return &(mHits->back());
 }
 
+std::vector<std::string> Detector::getShowerLibraryVolumes() const
+{
+  std::vector<std::string> volumes{"PHOS"};
+  if (gGeoManager->GetVolume("PHOH")) { // half module, if it is created
+    volumes.emplace_back("PHOH");
+  }
+  return volumes;
+}
+
+void Detector::depositLibraryShower(o2::base::ShowerLibrary::Shower const& shower, const double entry[3],
+                                    const double dir[3], double energy, double time)
+{
+  if (!mGeom) {
+    mGeom = Geometry::GetInstance();
+  }
+  if (!mLibraryNavigator) {
+    mLibraryNavigator = new TGeoNavigator(gGeoManager);
+  }
+
+  // the track entering the module is a SuperParent, unless its parent is one already
+  TVirtualMCStack* stack = fMC->GetStack();
+  const Int_t partID = stack->GetCurrentTrackNumber();
+  auto itTr = mSuperParents.find(stack->GetCurrentTrack()->GetMother(0));
+  Int_t superParent = itTr == mSuperParents.end() ? partID : itTr->second;
+  mSuperParents[partID] = superParent;
+
+  Point3D<float> pos(entry[0], entry[1], entry[2]);
+  Vector3D<float> mom(energy * dir[0], energy * dir[1], energy * dir[2]);
+  Double_t estart = fMC->Etot();
+
+  // one hit per crystal, the hits of the same SuperParent and cell are summed in FinishEvent
+  std::map<Int_t, size_t> cellHits;
+  for (auto& spot : shower) {
+    double global[3];
+    o2::base::ShowerLibrary::toGlobal(spot, entry, dir, global);
+    TGeoNode* node = mLibraryNavigator->FindNode(global[0], global[1], global[2]);
+    if (!node || strcmp(node->GetVolume()->GetName(), "PXTL") != 0) {
+      continue; // spot outside of the crystals
+    }
+    // same levels as in ProcessHits
+    Int_t detID = mGeom->RelToAbsId(mLibraryNavigator->GetMother(11)->GetNumber(),
+                                    mLibraryNavigator->GetMother(3)->GetNumber(),
+                                    mLibraryNavigator->GetMother(2)->GetNumber());
+    Double_t eloss = spot.energy * energy;
+    auto cell = cellHits.find(detID);
+    if (cell == cellHits.end()) {
+      AddHit(superParent, detID, pos, mom, estart, time + spot.time, eloss);
+      cellHits.emplace(detID, mHits->size() - 1);
+    } else {
+      (*mHits)[cell->second].AddEnergyLoss(eloss);
+    }
+  }
+  mCurrentHit = nullptr;
+  mCurrentTrackID = -1;
+  mCurrentCellID = -1;
+}
+
 void Detector::ConstructGeometry()
 {
   // Create geometry description of PHOS depector for Geant simulations.
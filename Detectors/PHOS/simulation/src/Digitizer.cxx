@@ -22,7 +22,11 @@ using o2::phos::Hit;
 using namespace o2::phos;
 
 //_______________________________________________________________________
-void Digitizer::init() { mGeometry = Geometry::GetInstance(); }
+void Digitizer::init()
+{
+  mGeometry = Geometry::GetInstance();
+  mDigits.setNCells(mGeometry->GetTotalNCells() + 1); // absId starts at 1
+}
 
 //_______________________________________________________________________
 void Digitizer::finish() {}
@@ -63,68 +67,50 @@ void Digitizer::process(const std::vector<Hit>& hits, std::vector<Digit>& digits
   // hits.erase(itr, hits.end());
   // // TODO==========End of hit sorting, to be moved to Detector=============
 
-  Int_t hitIndex = 0;
-  Int_t hitAbsId = 0;
-  Int_t nHits = hits.size();
-  Hit hit;
-  if (hitIndex < nHits) {
-    hit = hits.at(hitIndex);
-    hitAbsId = hit.GetDetectorID();
+  // The hits are accumulated per cell and time window, they do not need to be sorted
+  mDigits.clear();
+  for (const auto& hit : hits) {
+    if (!mGeometry->IsCellExists(hit.GetDetectorID())) {
+      LOG(WARNING) << "cell index out of range: " << hit.GetDetectorID() << FairLogger::endl;
+      continue;
+    }
+    mDigits.add(hit.GetDetectorID(), Digit(hit));
   }
 
   Int_t nTotCells = mGeometry->GetTotalNCells();
-  for (Int_t absId = 1; absId < nTotCells; absId++) {
+  for (Int_t absId = 1; absId <= nTotCells; absId++) {
 
     // If signal exist in this cell, add noise to it, otherwise just create noise digit
-    if (absId == hitAbsId) {
-      Digit digit(hit);
-      hitIndex++;
-      if (hitIndex < nHits) {
-        Digit digitNext(hits.at(hitIndex));
-        while ((hitIndex < nHits) && digit.canAdd(digitNext)) {
-          digit += digitNext;
-          hitIndex++;
-          if (hitIndex < nHits) {
-            digitNext.FillFromHit(hits.at(hitIndex));
-          }
+    if (mDigits.isTouched(absId)) {
+      for (auto& digit : mDigits.getDigits(absId)) {
+        // Add Electroinc noise, apply non-linearity, digitize, de-calibrate, time resolution
+        Double_t energy = digit.getAmplitude();
+        // // Simulate electronic noise
+        // energy += SimulateNoiseEnergy();
+
+        // if (mApplyNonLinearity) {
+        //   energy = NonLinearity(energy);
+        // }
+        // if (mApplyDigitization) {
+        //   energy = DigitizeEnergy(energy);
+        // }
+        // if (mApplyDecalibration) {
+        //   energy = Decalibrate(energy);
+        // }
+        // digit.setAmplitude(energy);
+        if (mApplyTimeResolution) {
+          digit.setTimeStamp(TimeResolution(digit.getTimeStamp(), energy));
         }
-        if (hitIndex < nHits) {
-          hitAbsId = digitNext.getAbsId();
-        } else {
-          hitAbsId = 0;
-        }
-        hit = hits.at(hitIndex);
-      } else {
-        hitAbsId = 99999; // out of PHOS
-      }
-
-      // Add Electroinc noise, apply non-linearity, digitize, de-calibrate, time resolution
-      Double_t energy = digit.getAmplitude();
-      // // Simulate electronic noise
-      // energy += SimulateNoiseEnergy();
-
-      // if (mApplyNonLinearity) {
-      //   energy = NonLinearity(energy);
-      // }
-      // if (mApplyDigitization) {
-      //   energy = DigitizeEnergy(energy);
-      // }
-      // if (mApplyDecalibration) {
-      //   energy = Decalibrate(energy);
-      // }
-      // digit.setAmplitude(energy);
-      if (mApplyTimeResolution) {
-        digit.setTimeStamp(TimeResolution(digit.getTimeStamp(), energy));
+        digits.push_back(digit);
       }
-      digits.push_back(digit);
     } else { // No signal in this cell,
       if (!mGeometry->IsCellExists(absId)) {
         continue;
       }
-      // Simulate noise
+      // Simulate noise, the time only for the noise above the zero suppression
       Double_t energy = SimulateNoiseEnergy();
-      Double_t time = SimulateNoiseTime();
       if (energy > mZSthreshold) {
+        Double_t time = SimulateNoiseTime();
         Digit noiseDigit(absId, energy, time, -1); // current AbsId, energy, random time, no primary
         digits.push_back(noiseDigit);
       }
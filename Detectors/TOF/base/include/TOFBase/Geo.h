@@ -42,6 +42,11 @@ class Geo
   static Float_t getHeights(Int_t iplate, Int_t istrip) { return HEIGHTS[iplate][istrip]; }
   static Float_t getDistances(Int_t iplate, Int_t istrip) { return DISTANCES[iplate][istrip]; }
   static void getPadDxDyDz(const Float_t* pos, Int_t* det, Float_t* DeltaPos);
+
+  // Lookups on the channel geometry table, built at the first call from the same transformations as getDetID
+  static void getChannelPos(Int_t channel, Float_t* pos); // pad centre (cm) of a channel in the global frame
+  static Int_t getStripCandidates(const Float_t* pos, Float_t tolerance, Int_t* strips, Int_t maxStrips); // strips (channel / NPADS) within tolerance (cm) of pos, returns their number
+  static Bool_t getPadDxDyDzInStrip(const Float_t* pos, Int_t strip, Int_t* det, Float_t* DeltaPos); // as getPadDxDyDz, for a given strip; false if pos is not in it
   enum {
     // DAQ characteristics
     // cfr. TOF-TDR pag. 105 for Glossary
@@ -266,6 +271,14 @@ class Geo
   static Float_t mRotationMatrixSector[NSECTORS + 1][3][3]; // rotation matrixes
   static Float_t mRotationMatrixPlateStrip[NPLATES][NMAXNSTRIP][3][3];
 
+  static void InitChannels();
+  static Float_t mChannelX[NCHANNELS]; // pad centres in the global frame
+  static Float_t mChannelY[NCHANNELS];
+  static Float_t mChannelZ[NCHANNELS];
+  static Float_t mStripRotation[NSTRIPS][3][3]; // global frame -> pad frame of the strip: M * pos - T
+  static Float_t mStripTranslation[NSTRIPS][3];
+  static Float_t mStripZRange[NSTRIPXSECTOR][2]; // z extent of the strips in the sector frame, the same for all the sectors
+
   // cable length map
   static constexpr Float_t CABLEPROPAGATIONDELAY = 0.0513; // Propagation delay [ns/cm]
   static Float_t CABLELENGTH[kNCrate][10][kNChain][kNTdc / 3];
@@ -13,6 +13,7 @@
 #include "TMath.h"
 #include "FairLogger.h"
 #include "DetectorsBase/GeometryManager.h"
+#include <mutex>
 
 ClassImp(o2::tof::Geo);
 
@@ -27,6 +28,40 @@ constexpr Float_t Geo::ROOF2PARAMETERS[3];
 Bool_t Geo::mToBeIntit = kTRUE;
 Float_t Geo::mRotationMatrixSector[NSECTORS + 1][3][3];
 Float_t Geo::mRotationMatrixPlateStrip[NPLATES][NMAXNSTRIP][3][3];
+Float_t Geo::mChannelX[NCHANNELS];
+Float_t Geo::mChannelY[NCHANNELS];
+Float_t Geo::mChannelZ[NCHANNELS];
+Float_t Geo::mStripRotation[NSTRIPS][3][3];
+Float_t Geo::mStripTranslation[NSTRIPS][3];
+Float_t Geo::mStripZRange[NSTRIPXSECTOR][2];
+
+namespace
+{
+std::once_flag gChannelsInit;
+
+// plate and strip in the plate of the strips of a sector, by their number in the sector
+struct SectorStrips {
+  Int_t plate[Geo::NSTRIPXSECTOR];
+  Int_t strip[Geo::NSTRIPXSECTOR];
+};
+
+const SectorStrips& getSectorStrips()
+{
+  static const SectorStrips table = [] {
+    SectorStrips result;
+    const Int_t nstrips[Geo::NPLATES] = { Geo::NSTRIPC, Geo::NSTRIPB, Geo::NSTRIPA, Geo::NSTRIPB, Geo::NSTRIPC };
+    Int_t index = 0;
+    for (Int_t iplate = 0; iplate < Geo::NPLATES; iplate++) {
+      for (Int_t istrip = 0; istrip < nstrips[iplate]; istrip++, index++) {
+        result.plate[index] = iplate;
+        result.strip[index] = istrip;
+      }
+    }
+    return result;
+  }();
+  return table;
+}
+} // namespace
 
 void Geo::Init()
 {
@@ -161,9 +196,6 @@ void Geo::getPos(Int_t* det, Float_t* pos)
     LOG(WARNING) << " no TGeo! Loading it";
     o2::base::GeometryManager::loadGeometry();
   }
-  FILE* fOutTXT = fopen("TOF_geo.txt", "w");
-  fprintf(fOutTXT, "path = %s, gGeoManager = %p", path, gGeoManager);
-  fclose(fOutTXT);
   gGeoManager->cd(path);
   TGeoHMatrix global;
   global = *gGeoManager->GetCurrentMatrix();
@@ -204,38 +236,18 @@ void Geo::getVolumeIndices(Int_t index, Int_t *detId)
   //
   // Retrieve volume indices from the calibration channel index 
   //
-  Int_t npadxstrip = NPADX*NPADZ;
+  const auto& sectorStrips = getSectorStrips();
 
-  detId[0] = index/npadxstrip/NSTRIPXSECTOR;
+  detId[0] = index / NPADSXSECTOR;
 
-  Int_t dummyStripPerModule = 
-    ( index - ( NSTRIPXSECTOR*npadxstrip*detId[0]) ) / npadxstrip;
-  if (dummyStripPerModule<NSTRIPC) {
-    detId[1] = 0;
-    detId[2] = dummyStripPerModule;
-  }
-  else if (dummyStripPerModule>=NSTRIPC && dummyStripPerModule<NSTRIPC+NSTRIPB) {
-    detId[1] = 1;
-    detId[2] = dummyStripPerModule-NSTRIPC;
-  }
-  else if (dummyStripPerModule>=NSTRIPC+NSTRIPB && dummyStripPerModule<NSTRIPC+NSTRIPB+NSTRIPA) {
-    detId[1] = 2;
-    detId[2] = dummyStripPerModule-NSTRIPC-NSTRIPB;
-  }
-  else if (dummyStripPerModule>=NSTRIPC+NSTRIPB+NSTRIPA && dummyStripPerModule<NSTRIPC+NSTRIPB+NSTRIPA+NSTRIPB) {
-    detId[1] = 3;
-    detId[2] = dummyStripPerModule-NSTRIPC-NSTRIPB-NSTRIPA;
-  }
-  else if (dummyStripPerModule>=NSTRIPC+NSTRIPB+NSTRIPA+NSTRIPB && dummyStripPerModule<NSTRIPXSECTOR) {
-    detId[1] = 4;
-    detId[2] = dummyStripPerModule-NSTRIPC-NSTRIPB-NSTRIPA-NSTRIPB;
-  }
+  Int_t stripPerModule = (index / NPADS) % NSTRIPXSECTOR;
+  detId[1] = sectorStrips.plate[stripPerModule];
+  detId[2] = sectorStrips.strip[stripPerModule];
 
-  Int_t padPerStrip = ( index - ( NSTRIPXSECTOR*npadxstrip*detId[0]) ) - dummyStripPerModule*npadxstrip;
+  Int_t padPerStrip = index % NPADS;
 
   detId[3] = padPerStrip / NPADX; // padZ
-  detId[4] = padPerStrip - detId[3]*NPADX; // padX
-
+  detId[4] = padPerStrip % NPADX; // padX
 }
 
 Int_t Geo::getIndex(const Int_t * detId)
@@ -446,6 +458,149 @@ void Geo::getPadDxDyDz(const Float_t * pos,Int_t * det, Float_t * DeltaPos)
   translate(DeltaPos,step); 
 } 
 
+void Geo::InitChannels()
+{
+  //
+  // Fill the channel geometry table: for every strip the transformation from the global frame to its pad frame,
+  // composed from the ones applied step by step by getDetID, and the pad centres of its channels
+  //
+  if (mToBeIntit)
+    Init();
+
+  LOG(INFO) << "tof::Geo: Initialization of the TOF channel geometry table";
+
+  constexpr Float_t HGLFY = HFILIY + 2 * HGLASSY;
+  constexpr Float_t HSTRIPY = 2. * HHONY + 2. * HPCBY + 4. * HRGLY + 2. * HGLFY + HCPCBY;
+  const Float_t halfSize[3] = { static_cast<Float_t>(STRIPLENGTH * 0.5), static_cast<Float_t>(HSTRIPY * 0.5), static_cast<Float_t>(WCPCBZ * 0.5) };
+  const Float_t padOrigin[3] = { static_cast<Float_t>(-0.5 * NPADX * XPAD), 0., static_cast<Float_t>(-0.5 * NPADZ * ZPAD) };
+  const Float_t sectorCentre[3] = { 0., 0., static_cast<Float_t>((RMAX + RMIN) * 0.5) };
+  const auto& sectorStrips = getSectorStrips();
+
+  for (Int_t istrip = 0; istrip < NSTRIPXSECTOR; istrip++) {
+    Int_t iplate = sectorStrips.plate[istrip];
+    Int_t istripInPlate = sectorStrips.strip[istrip];
+    const auto& rotStrip = mRotationMatrixPlateStrip[iplate][istripInPlate];
+    const Float_t stripCentre[3] = { 0., getHeights(iplate, istripInPlate), -getDistances(iplate, istripInPlate) };
+
+    // strip frame = rotStrip * (sector frame - stripCentre), hence the z extent of the strip box in the sector frame
+    Float_t dz = 0.;
+    for (Int_t ii = 0; ii < 3; ii++)
+      dz += TMath::Abs(rotStrip[ii][2]) * halfSize[ii];
+    mStripZRange[istrip][0] = stripCentre[2] - dz;
+    mStripZRange[istrip][1] = stripCentre[2] + dz;
+
+    for (Int_t isector = 0; isector < NSECTORS; isector++) {
+      const auto& rotSector = mRotationMatrixSector[isector];
+      const auto& rotFrame = mRotationMatrixSector[NSECTORS];
+      Int_t index = isector * NSTRIPXSECTOR + istrip;
+      auto& rot = mStripRotation[index];
+      auto& tr = mStripTranslation[index];
+
+      // pad frame = rotStrip * (rotFrame * (rotSector * pos - sectorCentre) - stripCentre) - padOrigin
+      Float_t rotStripFrame[3][3];
+      for (Int_t ii = 0; ii < 3; ii++) {
+        for (Int_t jj = 0; jj < 3; jj++) {
+          rotStripFrame[ii][jj] = 0.;
+          for (Int_t kk = 0; kk < 3; kk++)
+            rotStripFrame[ii][jj] += rotStrip[ii][kk] * rotFrame[kk][jj];
+        }
+      }
+      for (Int_t ii = 0; ii < 3; ii++) {
+        tr[ii] = padOrigin[ii];
+        for (Int_t jj = 0; jj < 3; jj++) {
+          rot[ii][jj] = 0.;
+          for (Int_t kk = 0; kk < 3; kk++)
+            rot[ii][jj] += rotStripFrame[ii][kk] * rotSector[kk][jj];
+          tr[ii] += rotStripFrame[ii][jj] * sectorCentre[jj] + rotStrip[ii][jj] * stripCentre[jj];
+        }
+      }
+
+      // the transformation is a rotation, the pad centres follow from its transpose
+      for (Int_t ipadz = 0; ipadz < NPADZ; ipadz++) {
+        for (Int_t ipadx = 0; ipadx < NPADX; ipadx++) {
+          const Float_t padCentre[3] = { static_cast<Float_t>((ipadx + 0.5) * XPAD + tr[0]), tr[1], static_cast<Float_t>((ipadz + 0.5) * ZPAD + tr[2]) };
+          Int_t channel = index * NPADS + ipadz * NPADX + ipadx;
+          mChannelX[channel] = rot[0][0] * padCentre[0] + rot[1][0] * padCentre[1] + rot[2][0] * padCentre[2];
+          mChannelY[channel] = rot[0][1] * padCentre[0] + rot[1][1] * padCentre[1] + rot[2][1] * padCentre[2];
+          mChannelZ[channel] = rot[0][2] * padCentre[0] + rot[1][2] * padCentre[1] + rot[2][2] * padCentre[2];
+        }
+      }
+    }
+  }
+}
+
+void Geo::getChannelPos(Int_t channel, Float_t* pos)
+{
+  //
+  // Returns the pad centre (x,y,z) (cm) of a channel
+  //
+  std::call_once(gChannelsInit, InitChannels);
+
+  pos[0] = mChannelX[channel];
+  pos[1] = mChannelY[channel];
+  pos[2] = mChannelZ[channel];
+}
+
+Int_t Geo::getStripCandidates(const Float_t* pos, Float_t tolerance, Int_t* strips, Int_t maxStrips)
+{
+  //
+  // Returns the number of strips whose volume is closer to the space point than tolerance (cm) along the strip and
+  // along z, they are filled in strips, up to maxStrips
+  //
+  std::call_once(gChannelsInit, InitChannels);
+
+  Int_t isector = getSector(pos);
+  if (isector == -1)
+    return 0;
+
+  Int_t nstrips = 0;
+  for (Int_t ii = -1; ii <= 1; ii++) {
+    Int_t jsector = (isector + ii + NSECTORS) % NSECTORS;
+    Float_t posLocal[3] = { pos[0], pos[1], pos[2] };
+    fromGlobalToSector(posLocal, jsector);
+    if (TMath::Abs(posLocal[0]) > STRIPLENGTH * 0.5 + tolerance)
+      continue;
+    for (Int_t istrip = 0; istrip < NSTRIPXSECTOR && nstrips < maxStrips; istrip++) {
+      if (posLocal[2] >= mStripZRange[istrip][0] - tolerance && posLocal[2] <= mStripZRange[istrip][1] + tolerance)
+        strips[nstrips++] = jsector * NSTRIPXSECTOR + istrip;
+    }
+  }
+  return nstrips;
+}
+
+Bool_t Geo::getPadDxDyDzInStrip(const Float_t* pos, Int_t strip, Int_t* det, Float_t* DeltaPos)
+{
+  //
+  // Returns the Detector Indices and the residuals wrt the pad centre, as getPadDxDyDz, if the space point is in the
+  // strip (channel / NPADS)
+  //
+  std::call_once(gChannelsInit, InitChannels);
+
+  constexpr Float_t HGLFY = HFILIY + 2 * HGLASSY;
+  constexpr Float_t HSTRIPY = 2. * HHONY + 2. * HPCBY + 4. * HRGLY + 2. * HGLFY + HCPCBY;
+
+  const auto& rot = mStripRotation[strip];
+  const auto& tr = mStripTranslation[strip];
+  for (Int_t ii = 0; ii < 3; ii++)
+    DeltaPos[ii] = rot[ii][0] * pos[0] + rot[ii][1] * pos[1] + rot[ii][2] * pos[2] - tr[ii];
+
+  if ((TMath::Abs(DeltaPos[0] - 0.5 * NPADX * XPAD) > STRIPLENGTH * 0.5) || (TMath::Abs(DeltaPos[1]) > HSTRIPY * 0.5) ||
+      (TMath::Abs(DeltaPos[2] - 0.5 * NPADZ * ZPAD) > WCPCBZ * 0.5))
+    return kFALSE;
+
+  const auto& sectorStrips = getSectorStrips();
+  Int_t istrip = strip % NSTRIPXSECTOR;
+  det[0] = strip / NSTRIPXSECTOR;
+  det[1] = sectorStrips.plate[istrip];
+  det[2] = sectorStrips.strip[istrip];
+  det[3] = getPadZ(DeltaPos);
+  det[4] = getPadX(DeltaPos);
+
+  DeltaPos[0] -= (det[4] + 0.5) * XPAD;
+  DeltaPos[2] -= (det[3] + 0.5) * ZPAD;
+  return kTRUE;
+}
+
 Int_t Geo::getPlate(const Float_t* pos)
 {
   //
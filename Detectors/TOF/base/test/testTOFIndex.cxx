@@ -13,6 +13,7 @@
 #define BOOST_TEST_DYN_LINK
 #include "FairLogger.h" // for FairLogger
 #include "TOFBase/Geo.h"
+#include <TMath.h>
 #include <TRandom.h>
 #include <TStopwatch.h>
 #include <boost/test/unit_test.hpp>
@@ -90,3 +91,36 @@ BOOST_AUTO_TEST_CASE(testTOFIndex) {
   }
   BOOST_TEST_CHECKPOINT("Ending");
 }
+
+BOOST_AUTO_TEST_CASE(testTOFChannelTable)
+{
+  Int_t nWrongIndex = 0;
+  Int_t nWrongCandidates = 0;
+  Int_t nWrongStrip = 0;
+  for (Int_t chan = 0; chan < Geo::NCHANNELS; chan++) {
+    Float_t pos[3];
+    Geo::getChannelPos(chan, pos);
+
+    // the pad centre is found back by the full chain of transformations
+    Int_t det[5];
+    Geo::getDetID(pos, det);
+    if (Geo::getIndex(det) != chan)
+      nWrongIndex++;
+
+    Int_t strips[8];
+    Int_t nStrips = Geo::getStripCandidates(pos, 0., strips, 8);
+    Bool_t found = kFALSE;
+    for (Int_t i = 0; i < nStrips; i++)
+      found |= strips[i] == chan / Geo::NPADS;
+    if (!found)
+      nWrongCandidates++;
+
+    Float_t delta[3];
+    if (!Geo::getPadDxDyDzInStrip(pos, chan / Geo::NPADS, det, delta) || Geo::getIndex(det) != chan ||
+        TMath::Abs(delta[0]) > 1e-3 || TMath::Abs(delta[2]) > 1e-3)
+      nWrongStrip++;
+  }
+  BOOST_CHECK_EQUAL(nWrongIndex, 0);
+  BOOST_CHECK_EQUAL(nWrongCandidates, 0);
+  BOOST_CHECK_EQUAL(nWrongStrip, 0);
+}
@@ -13,8 +13,10 @@
 #ifndef ALICEO2_TOF_CLUSTERER_H
 #define ALICEO2_TOF_CLUSTERER_H
 
+#include <array>
 #include <utility>
 #include <vector>
+#include <gsl/span>
 #include "DataFormatsTOF/Cluster.h"
 #include "TOFBase/Geo.h"
 #include "TOFReconstruction/DataReader.h"
@@ -42,20 +44,49 @@ class Clusterer
 
   void process(DataReader& r, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
 
+  /// Clusterizes digits grouped by strip (consecutive digits with the same strip belong to the same strip
+  /// data, as with the DigitDataReader) and sorted in TDC within each strip.
+  /// With more than one thread the strips are clusterized in parallel into separate outputs,
+  /// which are then appended to clusters (and to the MC labels) in the order of the input.
+  void process(gsl::span<const Digit> digits, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
+
   void setMCTruthContainer(o2::dataformats::MCTruthContainer<o2::MCCompLabel>* truth) { mClsLabels = truth; }
 
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
  private:
-  void processStrip(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
-  //void fetchMCLabels(const Digit* dig, std::array<Label, Cluster::maxLabels>& labels, int& nfilled) const;
+  /// temporary data to build the clusters, one per thread
+  struct ClusterBuilder {
+    StripData stripData;                ///< data of the strip being clusterized
+    Digit* contributingDigit[6];        ///< array of digits contributing to the cluster
+    int numberOfContributingDigits = 0; ///< number of digits contributing to the cluster
+  };
 
-  StripData mStripData; ///< single strip data provided by the reader
+  /// output of a range of strips, filled by one thread
+  struct StripRangeOutput {
+    size_t firstDigit = 0;         ///< first digit of the range
+    size_t lastDigit = 0;          ///< digit after the last one of the range
+    std::vector<Cluster> clusters; ///< clusters of the range
+    MCLabelContainer labels;       ///< MC labels of the clusters of the range
+  };
+
+  void processStrip(ClusterBuilder& builder, std::vector<Cluster>& clusters, MCLabelContainer* clsLabels, MCLabelContainer const* digitMCTruth) const;
+  void processStrips(ClusterBuilder& builder, gsl::span<const Digit> digits, std::vector<Cluster>& clusters, MCLabelContainer* clsLabels, MCLabelContainer const* digitMCTruth) const;
+  //void fetchMCLabels(const Digit* dig, std::array<Label, Cluster::maxLabels>& labels, int& nfilled) const;
 
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mClsLabels = nullptr; // Cluster MC labels
 
-  Digit* mContributingDigit[6];    //! array of digits contributing to the cluster; this will not be stored, it is temporary to build the final cluster
-  int mNumberOfContributingDigits; //! number of digits contributing to the cluster; this will not be stored, it is temporary to build the final cluster
-  void addContributingDigit(Digit* dig);
-  void buildCluster(Cluster& c, MCLabelContainer const* digitMCTruth);
+  ClusterBuilder mBuilder;                             //! temporary data of the serial clusterization
+  std::vector<ClusterBuilder> mThreadBuilders;         //! temporary data of the parallel clusterization
+  std::vector<StripRangeOutput> mRangeOutputs;         //! outputs of the parallel clusterization
+  std::vector<std::array<float, 3>> mChannelPositions; //! cache of the channel positions, filled when needed
+  std::vector<bool> mIsChannelPositionSet;             //! flag of the cached channel positions
+  int mNThreads = 1;                                   ///< number of threads for the clusterization of the digit spans
+
+  void addContributingDigit(ClusterBuilder& builder, Digit* dig) const;
+  void buildCluster(ClusterBuilder& builder, Cluster& c, MCLabelContainer* clsLabels, MCLabelContainer const* digitMCTruth) const;
+  void setClusterPosition(Cluster& c);
 };
 
 } // namespace tof
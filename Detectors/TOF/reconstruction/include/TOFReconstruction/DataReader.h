@@ -14,7 +14,10 @@
 #ifndef ALICEO2_TOF_DATAREADER_H
 #define ALICEO2_TOF_DATAREADER_H
 
+#include <cstdint>
+#include <gsl/span>
 #include "TOFBase/Digit.h"
+#include "TOFReconstruction/Decoder.h"
 
 namespace o2
 {
@@ -84,10 +87,30 @@ class DigitDataReader : public DataReader
 /// \class RawDataReader
 /// \brief RawDataReader class for TOF. Feeds raw data to the Cluster Finder
 ///
+/// The raw data of the readout window are decoded at once by init(), the crates in parallel, into
+/// digits grouped by strip which can also be clusterized directly with getDigits()
 class RawDataReader : public DataReader
 {
  public:
+  RawDataReader() = default;
+  void setRawData(gsl::span<const uint32_t> buffer) { mBuffer = buffer; }
+  void setNThreads(int n) { mDecoder.setNThreads(n); }
+
+  void init() override;
+
   Bool_t getNextStripData(StripData& stripData) override;
+
+  /// digits of the decoded window
+  const std::vector<Digit>& getDigits() const { return mDigits; }
+
+  /// number of corrupted crates in the decoded window
+  int getNErrors() const { return mDecoder.getNErrors(); }
+
+ private:
+  gsl::span<const uint32_t> mBuffer; //! raw data of the readout window
+  Decoder mDecoder;                  //! raw data decoder
+  std::vector<Digit> mDigits;        //! digits of the readout window
+  size_t mIdx = 0;                   //! next digit to be sent to the Cluster Finder
 };
 
 } // namespace tof
@@ -0,0 +1,71 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file Decoder.h
+/// \brief Definition of the TOF raw data decoder
+
+#ifndef ALICEO2_TOF_DECODER_H
+#define ALICEO2_TOF_DECODER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <gsl/span>
+#include "TOFBase/Digit.h"
+#include "TOFBase/Geo.h"
+
+namespace o2
+{
+namespace tof
+{
+/// \class Decoder
+/// \brief Decodes the raw data of RawFormat.h into digits
+///
+/// The DRM blocks are located first, then the crates are decoded in parallel. Since each crate
+/// serves whole strips, the digits are produced in the layout consumed by the Clusterer:
+/// grouped by strip, in increasing strip order, and sorted in TDC within each strip.
+class Decoder
+{
+ public:
+  Decoder() = default;
+  ~Decoder() = default;
+
+  Decoder(const Decoder&) = delete;
+  Decoder& operator=(const Decoder&) = delete;
+
+  /// Decodes the DRM blocks of a readout window and appends the digits
+  /// \return false if the data are corrupted; the digits of the broken crates are dropped
+  bool decode(gsl::span<const uint32_t> buffer, std::vector<Digit>& digits);
+
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  /// number of corrupted crates in the last decoded buffer
+  int getNErrors() const { return mNErrors; }
+
+ private:
+  /// location of the DRM block of a crate in the buffer
+  struct CrateBlock {
+    size_t first = 0;  ///< first word of the block
+    size_t nWords = 0; ///< number of words of the block, 0 if no block was found
+  };
+
+  bool decodeCrate(gsl::span<const uint32_t> block, int crate, std::vector<Digit>& digits) const;
+
+  std::array<CrateBlock, Geo::kNCrate> mBlocks;               //! DRM blocks of the crates
+  std::array<std::vector<Digit>, Geo::kNCrate> mCrateDigits; //! digits of each crate
+  int mNThreads = 1;                                          ///< number of threads for the decoding of the crates
+  int mNErrors = 0;                                           ///< corrupted crates in the last buffer
+};
+
+} // namespace tof
+} // namespace o2
+
+#endif /* ALICEO2_TOF_DECODER_H */
@@ -0,0 +1,54 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file Encoder.h
+/// \brief Definition of the TOF raw data encoder
+
+#ifndef ALICEO2_TOF_ENCODER_H
+#define ALICEO2_TOF_ENCODER_H
+
+#include <cstdint>
+#include <vector>
+#include <gsl/span>
+#include "TOFBase/Digit.h"
+
+namespace o2
+{
+namespace tof
+{
+/// \class Encoder
+/// \brief Writes the digits of a readout window in the raw format of RawFormat.h
+///
+class Encoder
+{
+ public:
+  Encoder() = default;
+  ~Encoder() = default;
+
+  /// Appends one DRM block per crate to buffer, in the order of the crates
+  /// \param digits digits of the window, in any order
+  /// \param windowBC BC of the start of the readout window, to which the BC of the digits are relative
+  /// \return false if some digits could not be encoded (out of the window or out of range), they are skipped
+  bool encode(gsl::span<const Digit> digits, int windowBC, std::vector<uint32_t>& buffer);
+
+ private:
+  struct Hit {
+    uint32_t key;    ///< crate, slot, chain, TDC and TDC channel, for the sorting
+    uint32_t hit;    ///< hit word
+    uint32_t hitTOT; ///< hit TOT word
+    bool operator<(const Hit& other) const { return key < other.key; }
+  };
+  std::vector<Hit> mHits; //! hits sorted in the order of the electronics
+};
+
+} // namespace tof
+} // namespace o2
+
+#endif /* ALICEO2_TOF_ENCODER_H */
@@ -0,0 +1,136 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file RawFormat.h
+/// \brief Definition of the TOF raw data words and of the electronic index
+
+#ifndef ALICEO2_TOF_RAWFORMAT_H
+#define ALICEO2_TOF_RAWFORMAT_H
+
+#include <algorithm>
+#include <cstdint>
+#include "TOFBase/Geo.h"
+
+namespace o2
+{
+namespace tof
+{
+namespace raw
+{
+/// The data of a readout window are made of one block of 32 bit words per crate, each
+/// following the DRM/TRM/chain structure of the electronics:
+///
+///   DRM global header   | 0x4 | crate [26:20] | words in the block [19:4] | slot 1 [3:0] |
+///   DRM window BC       | BC of the readout window, 32 bits                                |
+///     TRM global header | 0x4 | words in the TRM block [19:4]            | slot 3-12 [3:0] |
+///       chain header    | 0x0 (chain A) or 0x2 (chain B)                  | slot [3:0]      |
+///         hit           | 0xA | TDC [27:24] | channel [23:21] | TDC bins [20:0]             |
+///         hit TOT       | 0xB | BC since the window BC [27:16] | TOT bins [15:0]            |
+///       chain trailer   | 0x1 (chain A) or 0x3 (chain B) | number of hits [19:4] | slot [3:0] |
+///     TRM global trailer| 0x5                                             | slot [3:0]      |
+///   DRM global trailer  | 0x5                                             | slot 1 [3:0]    |
+///
+/// Only the TRMs with hits are written. The electronic index is sequential: each crate serves
+/// a quarter of a sector, i.e. up to 23 consecutive strips, whose channels are read in order
+/// by the TRMs, chains, TDCs and TDC channels.
+
+enum WordType : uint32_t {
+  ChainAHeader = 0x0,
+  ChainATrailer = 0x1,
+  ChainBHeader = 0x2,
+  ChainBTrailer = 0x3,
+  GlobalHeader = 0x4,
+  GlobalTrailer = 0x5,
+  Hit = 0xA,
+  HitTOT = 0xB
+};
+
+constexpr int NCRATESPERSECTOR = Geo::kNCrate / Geo::NSECTORS;
+constexpr int NSTRIPSPERCRATE = (Geo::NSTRIPXSECTOR + NCRATESPERSECTOR - 1) / NCRATESPERSECTOR;
+constexpr int DRMSLOT = 1;
+constexpr int FIRSTTRMSLOT = 3;
+constexpr int NTRMS = 10;
+constexpr int NCHANNELSPERCHAIN = Geo::kNTdc * Geo::kNCh;
+constexpr int NCHANNELSPERTRM = Geo::kNChain * NCHANNELSPERCHAIN;
+static_assert(NSTRIPSPERCRATE * Geo::NPADS <= NTRMS * NCHANNELSPERTRM, "the strips of a crate exceed its TRMs");
+
+constexpr int MAXWORDSINBLOCK = 0xffff;
+constexpr int MAXTDCBINS = 0x1fffff;
+constexpr int MAXBCOFFSET = 0xfff;
+constexpr int MAXTOTBINS = 0xffff;
+
+inline uint32_t getWordType(uint32_t word) { return word >> 28; }
+inline int getSlot(uint32_t word) { return word & 0xf; }
+inline int getBlockWords(uint32_t header) { return (header >> 4) & 0xffff; }
+inline int getCrate(uint32_t drmHeader) { return (drmHeader >> 20) & 0x7f; }
+inline int getHitTDC(uint32_t hit) { return (hit >> 24) & 0xf; }
+inline int getHitChannel(uint32_t hit) { return (hit >> 21) & 0x7; }
+inline int getHitTDCBins(uint32_t hit) { return hit & MAXTDCBINS; }
+inline int getHitBCOffset(uint32_t tot) { return (tot >> 16) & MAXBCOFFSET; }
+inline int getHitTOTBins(uint32_t tot) { return tot & MAXTOTBINS; }
+
+inline uint32_t makeGlobalHeader(int slot, int nwords, int crate = 0)
+{
+  return (GlobalHeader << 28) | (crate << 20) | (nwords << 4) | slot;
+}
+inline uint32_t makeGlobalTrailer(int slot) { return (GlobalTrailer << 28) | slot; }
+inline uint32_t makeChainHeader(int slot, int chain) { return ((chain ? ChainBHeader : ChainAHeader) << 28) | slot; }
+inline uint32_t makeChainTrailer(int slot, int chain, int nhits)
+{
+  return ((chain ? ChainBTrailer : ChainATrailer) << 28) | (nhits << 4) | slot;
+}
+inline uint32_t makeHit(int tdc, int channel, int tdcBins)
+{
+  return (uint32_t(Hit) << 28) | (tdc << 24) | (channel << 21) | tdcBins;
+}
+inline uint32_t makeHitTOT(int bcOffset, int totBins) { return (uint32_t(HitTOT) << 28) | (bcOffset << 16) | totBins; }
+
+/// Location of a channel in the electronics
+struct ElectronicIndex {
+  int crate = 0;
+  int slot = 0;
+  int chain = 0;
+  int tdc = 0;
+  int channel = 0;
+};
+
+/// \return the electronic index of a TOF channel
+inline ElectronicIndex getElectronicIndex(int channel)
+{
+  ElectronicIndex index;
+  const int strip = channel / Geo::NPADS;
+  const int sector = strip / Geo::NSTRIPXSECTOR;
+  const int quarter = (strip % Geo::NSTRIPXSECTOR) / NSTRIPSPERCRATE;
+  const int local = channel - (sector * Geo::NSTRIPXSECTOR + quarter * NSTRIPSPERCRATE) * Geo::NPADS;
+  index.crate = sector * NCRATESPERSECTOR + quarter;
+  index.slot = FIRSTTRMSLOT + local / NCHANNELSPERTRM;
+  index.chain = (local % NCHANNELSPERTRM) / NCHANNELSPERCHAIN;
+  index.tdc = (local % NCHANNELSPERCHAIN) / Geo::kNCh;
+  index.channel = local % Geo::kNCh;
+  return index;
+}
+
+/// \return the TOF channel read by a TDC channel, -1 if it is not connected
+inline int getChannel(int crate, int slot, int chain, int tdc, int tdcChannel)
+{
+  const int sector = crate / NCRATESPERSECTOR;
+  const int firstStrip = (crate % NCRATESPERSECTOR) * NSTRIPSPERCRATE;
+  const int nStrips = std::min(NSTRIPSPERCRATE, Geo::NSTRIPXSECTOR - firstStrip);
+  const int local = (slot - FIRSTTRMSLOT) * NCHANNELSPERTRM + chain * NCHANNELSPERCHAIN + tdc * Geo::kNCh + tdcChannel;
+  if (sector >= Geo::NSECTORS || slot < FIRSTTRMSLOT || tdc >= Geo::kNTdc || local >= nStrips * Geo::NPADS) {
+    return -1;
+  }
+  return (sector * Geo::NSTRIPXSECTOR + firstStrip) * Geo::NPADS + local;
+}
+} // namespace raw
+} // namespace tof
+} // namespace o2
+
+#endif /* ALICEO2_TOF_RAWFORMAT_H */
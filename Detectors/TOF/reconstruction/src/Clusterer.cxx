@@ -11,6 +11,9 @@
 /// \file Clusterer.cxx
 /// \brief Implementation of the TOF cluster finder
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 #include "FairLogger.h" // for LOG
 #include "DataFormatsTOF/Cluster.h"
 #include "TOFReconstruction/Clusterer.h"
@@ -25,19 +28,123 @@ void Clusterer::process(DataReader& reader, std::vector<Cluster>& clusters, MCLa
   reader.init();
   int totNumDigits = 0;
 
-  while (reader.getNextStripData(mStripData)) {
-    LOG(DEBUG) << "TOFClusterer got Strip " << mStripData.stripID << " with Ndigits "
-               << mStripData.digits.size();
-    totNumDigits += mStripData.digits.size();
+  while (reader.getNextStripData(mBuilder.stripData)) {
+    LOG(DEBUG) << "TOFClusterer got Strip " << mBuilder.stripData.stripID << " with Ndigits "
+               << mBuilder.stripData.digits.size();
+    totNumDigits += mBuilder.stripData.digits.size();
 
-    processStrip(clusters, digitMCTruth);
+    int firstCluster = clusters.size();
+    processStrip(mBuilder, clusters, mClsLabels, digitMCTruth);
+    for (int icl = firstCluster; icl < clusters.size(); icl++) {
+      setClusterPosition(clusters[icl]);
+    }
   }
 
   LOG(DEBUG) << "We had " << totNumDigits << " digits in this event";
 }
 
 //__________________________________________________
-void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
+void Clusterer::process(gsl::span<const Digit> digits, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
+{
+  // clusterize the strips of a span of digits, in parallel if more than one thread is requested
+  size_t firstCluster = clusters.size();
+  if (mNThreads <= 1 || digits.size() < 2) {
+    processStrips(mBuilder, digits, clusters, mClsLabels, digitMCTruth);
+    for (size_t icl = firstCluster; icl < clusters.size(); icl++) {
+      setClusterPosition(clusters[icl]);
+    }
+    return;
+  }
+
+  // split the digits in ranges of whole strips, several per thread to balance the load
+  const size_t nDigits = digits.size();
+  const int nRanges = std::min<size_t>(4 * mNThreads, nDigits);
+  mRangeOutputs.resize(nRanges);
+  size_t first = 0;
+  for (int irange = 0; irange < nRanges; irange++) {
+    size_t last = (irange == nRanges - 1) ? nDigits : std::max(first, (irange + 1) * nDigits / nRanges);
+    while (last > 0 && last < nDigits && digits[last].getChannel() / Geo::NPADS == digits[last - 1].getChannel() / Geo::NPADS) {
+      last++;
+    }
+    mRangeOutputs[irange].firstDigit = first;
+    mRangeOutputs[irange].lastDigit = last;
+    first = last;
+  }
+
+  const int nThreads = std::min(mNThreads, nRanges);
+  mThreadBuilders.resize(nThreads);
+  std::atomic<int> nextRange(0);
+  std::vector<std::exception_ptr> exceptions(nThreads);
+  bool withLabels = (digitMCTruth != nullptr && mClsLabels != nullptr);
+  auto worker = [this, digits, digitMCTruth, withLabels, nRanges, &nextRange, &exceptions](int ithread) {
+    try {
+      for (int irange = nextRange++; irange < nRanges; irange = nextRange++) {
+        auto& output = mRangeOutputs[irange];
+        output.clusters.clear();
+        output.labels.clear();
+        processStrips(mThreadBuilders[ithread], digits.subspan(output.firstDigit, output.lastDigit - output.firstDigit),
+                      output.clusters, withLabels ? &output.labels : nullptr, digitMCTruth);
+      }
+    } catch (...) {
+      exceptions[ithread] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int ithread = 1; ithread < nThreads; ithread++) {
+    threads.emplace_back(worker, ithread);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  // merge the outputs in the order of the strips; the positions are set here
+  // since the geometry cannot be accessed from several threads
+  size_t nClusters = firstCluster;
+  for (auto& output : mRangeOutputs) {
+    nClusters += output.clusters.size();
+  }
+  clusters.reserve(nClusters);
+  std::vector<MCLabelContainer const*> labels;
+  for (auto& output : mRangeOutputs) {
+    clusters.insert(clusters.end(), output.clusters.begin(), output.clusters.end());
+    labels.push_back(&output.labels);
+  }
+  for (size_t icl = firstCluster; icl < clusters.size(); icl++) {
+    setClusterPosition(clusters[icl]);
+  }
+  if (withLabels) {
+    mClsLabels->mergeAll(gsl::span<MCLabelContainer const* const>(labels.data(), labels.size()), nThreads);
+  }
+}
+
+//__________________________________________________
+void Clusterer::processStrips(ClusterBuilder& builder, gsl::span<const Digit> digits, std::vector<Cluster>& clusters, MCLabelContainer* clsLabels, MCLabelContainer const* digitMCTruth) const
+{
+  // clusterize the strips of a span of digits, the strip data are built as in the DigitDataReader
+  auto& stripData = builder.stripData;
+  size_t idig = 0;
+  while (idig < digits.size()) {
+    stripData.clear();
+    stripData.stripID = digits[idig].getChannel() / Geo::NPADS;
+    for (; idig < digits.size() && digits[idig].getChannel() / Geo::NPADS == stripData.stripID; idig++) {
+      stripData.digits.emplace_back(digits[idig]);
+    }
+    auto byTDC = [](const Digit& a, const Digit& b) { return a.getTDC() < b.getTDC(); };
+    if (!std::is_sorted(stripData.digits.begin(), stripData.digits.end(), byTDC)) {
+      std::sort(stripData.digits.begin(), stripData.digits.end(), byTDC);
+    }
+    processStrip(builder, clusters, clsLabels, digitMCTruth);
+  }
+}
+
+//__________________________________________________
+void Clusterer::processStrip(ClusterBuilder& builder, std::vector<Cluster>& clusters, MCLabelContainer* clsLabels, MCLabelContainer const* digitMCTruth) const
 {
   // method to clusterize the current strip
 
@@ -47,15 +154,16 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
   Int_t iphi, iphi2, iphi3;
   Int_t ieta, ieta2, ieta3; // it is the number of padz-row increasing along the various strips
 
-  for (int idig = 0; idig < mStripData.digits.size(); idig++) {
+  auto& stripData = builder.stripData;
+  for (int idig = 0; idig < stripData.digits.size(); idig++) {
     //    LOG(DEBUG) << "Checking digit " << idig;
-    Digit* dig = &mStripData.digits[idig];
+    Digit* dig = &stripData.digits[idig];
     if (dig->isUsedInCluster())
       continue; // the digit was already used to build a cluster
 
-    mNumberOfContributingDigits = 0;
+    builder.numberOfContributingDigits = 0;
     dig->getPhiAndEtaIndex(iphi, ieta);
-    if (mStripData.digits.size() > 1)
+    if (stripData.digits.size() > 1)
       LOG(DEBUG) << "idig = " << idig;
 
     // first we make a cluster out of the digit
@@ -63,11 +171,11 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
     //    LOG(DEBUG) << "noc = " << noc << "\n";
     clusters.emplace_back();
     Cluster& c = clusters[noc];
-    addContributingDigit(dig);
+    addContributingDigit(builder, dig);
     float timeDig = dig->getTDC() * Geo::TDCBIN;
 
-    for (int idigNext = idig + 1; idigNext < mStripData.digits.size(); idigNext++) {
-      Digit* digNext = &mStripData.digits[idigNext];
+    for (int idigNext = idig + 1; idigNext < stripData.digits.size(); idigNext++) {
+      Digit* digNext = &stripData.digits[idigNext];
       if (digNext->isUsedInCluster())
         continue; // the digit was already used to build a cluster
       // check if the TOF time are close enough to be merged; if not, it means that nothing else will contribute to the cluster (since digits are ordered in time)
@@ -84,51 +192,57 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
         continue;
 
       // if we are here, the digit contributes to the cluster
-      addContributingDigit(digNext);
+      addContributingDigit(builder, digNext);
 
     } // loop on the second digit
 
-    buildCluster(c, digitMCTruth);
+    buildCluster(builder, c, clsLabels, digitMCTruth);
 
   } // loop on the first digit
 }
 //______________________________________________________________________
-void Clusterer::addContributingDigit(Digit* dig)
+void Clusterer::addContributingDigit(ClusterBuilder& builder, Digit* dig) const
 {
 
   // adding a digit to the array that stores the contributing ones
 
-  if (mNumberOfContributingDigits == 6) {
+  if (builder.numberOfContributingDigits == 6) {
     LOG(ERROR) << "The cluster has already 6 digits associated to it, we cannot add more; returning without doing anything";
+    return;
   }
-  mContributingDigit[mNumberOfContributingDigits] = dig;
-  mNumberOfContributingDigits++;
+  builder.contributingDigit[builder.numberOfContributingDigits] = dig;
+  builder.numberOfContributingDigits++;
   dig->setIsUsedInCluster();
 
   return;
 }
 
 //_____________________________________________________________________
-void Clusterer::buildCluster(Cluster& c, MCLabelContainer const* digitMCTruth)
+void Clusterer::buildCluster(ClusterBuilder& builder, Cluster& c, MCLabelContainer* clsLabels, MCLabelContainer const* digitMCTruth) const
 {
 
   // here we finally build the cluster from all the digits contributing to it
+  // (the position is set later by setClusterPosition)
+
+  auto& contributingDigit = builder.contributingDigit;
+  const int nContributingDigits = builder.numberOfContributingDigits;
 
   Digit* temp;
-  for (int idig = 1; idig < mNumberOfContributingDigits; idig++) {
+  for (int idig = 1; idig < nContributingDigits; idig++) {
     // the digit[0] will be the main one
-    if (mContributingDigit[idig]->getTOT() > mContributingDigit[0]->getTOT()) {
-      temp = mContributingDigit[0];
-      mContributingDigit[0] = mContributingDigit[idig];
-      mContributingDigit[idig] = temp;
+    if (contributingDigit[idig]->getTOT() > contributingDigit[0]->getTOT()) {
+      temp = contributingDigit[0];
+      contributingDigit[0] = contributingDigit[idig];
+      contributingDigit[idig] = temp;
     }
   }
 
-  c.setMainContributingChannel(mContributingDigit[0]->getChannel());
-  c.setTime(mContributingDigit[0]->getTDC() * Geo::TDCBIN + double(mContributingDigit[0]->getBC() * 25000.)); // time in ps (for now we assume it calibrated)
-  c.setTimeRaw(mContributingDigit[0]->getTDC() * Geo::TDCBIN + double(mContributingDigit[0]->getBC() * 25000.)); // time in ps (for now we assume it calibrated)
+  c.setContributingChannels(0);
+  c.setMainContributingChannel(contributingDigit[0]->getChannel());
+  c.setTime(contributingDigit[0]->getTDC() * Geo::TDCBIN + double(contributingDigit[0]->getBC() * 25000.)); // time in ps (for now we assume it calibrated)
+  c.setTimeRaw(contributingDigit[0]->getTDC() * Geo::TDCBIN + double(contributingDigit[0]->getBC() * 25000.)); // time in ps (for now we assume it calibrated)
 
-  c.setTot(mContributingDigit[0]->getTOT() * Geo::TOTBIN * 1E-3); // TOT in ns (for now we assume it calibrated)
+  c.setTot(contributingDigit[0]->getTOT() * Geo::TOTBIN * 1E-3); // TOT in ns (for now we assume it calibrated)
   //setL0L1Latency(); // to be filled (maybe)
   //setDeltaBC(); // to be filled (maybe)
 
@@ -138,10 +252,11 @@ void Clusterer::buildCluster(Cluster& c, MCLabelContainer const* digitMCTruth)
   int deltaPhi, deltaEta;
   int mask;
 
-  mContributingDigit[0]->getPhiAndEtaIndex(phi1, eta1);
+  contributingDigit[0]->getPhiAndEtaIndex(phi1, eta1);
   // now set the mask with the secondary digits
-  for (int idig = 1; idig < mNumberOfContributingDigits; idig++) {
-    mContributingDigit[idig]->getPhiAndEtaIndex(phi2, eta2);
+  for (int idig = 1; idig < nContributingDigits; idig++) {
+    contributingDigit[idig]->getPhiAndEtaIndex(phi2, eta2);
+    mask = 0;
     deltaPhi = phi1 - phi2;
     deltaEta = eta1 - eta2;
     if (deltaPhi == 1) {   // the digit is to the LEFT of the cluster; let's check about UP/DOWN/Same Line
@@ -175,29 +290,35 @@ void Clusterer::buildCluster(Cluster& c, MCLabelContainer const* digitMCTruth)
   }
 
   // filling the MC labels of this cluster; the first will be those of the main digit; then the others
-  if (digitMCTruth != nullptr) {
-    int lbl = mClsLabels->getIndexedSize(); // this should correspond to the number of digits also;
-    printf("lbl = %d\n", lbl);
-    for (int i = 0; i < mNumberOfContributingDigits; i++) {
-      printf("contributing digit = %d\n", i);
-      int digitLabel = mContributingDigit[i]->getLabel();
-      printf("digitLabel = %d\n", digitLabel);
+  if (digitMCTruth != nullptr && clsLabels != nullptr) {
+    int lbl = clsLabels->getIndexedSize(); // this should correspond to the number of digits also;
+    for (int i = 0; i < nContributingDigits; i++) {
+      int digitLabel = contributingDigit[i]->getLabel();
       gsl::span<const o2::MCCompLabel> mcArray = digitMCTruth->getLabels(digitLabel);
       for (int j = 0; j < static_cast<int>(mcArray.size()); j++) {
-        printf("checking element %d in the array of labels\n", j);
-        auto label = digitMCTruth->getElement(digitMCTruth->getMCTruthHeader(digitLabel).index + j);
-        printf("EventID = %d\n", label.getEventID());
-        mClsLabels->addElement(lbl, label);
+        clsLabels->addElement(lbl, mcArray[j]);
       }
     }
   }
 
-  // set geometrical variables
-  int det[5];
-  Geo::getVolumeIndices(c.getMainContributingChannel(), det);
-  float pos[3];
-  Geo::getPos(det, pos);
-  c.setBaseData(c.getMainContributingChannel(), pos[0], pos[1], pos[2], 0, 0, 0); // error on position set to zero
-
   return;
 }
+
+//_____________________________________________________________________
+void Clusterer::setClusterPosition(Cluster& c)
+{
+  // set geometrical variables; the position of each channel is taken once from the geometry and cached
+  int chan = c.getMainContributingChannel();
+  if (mChannelPositions.empty()) {
+    mChannelPositions.resize(Geo::NCHANNELS);
+    mIsChannelPositionSet.resize(Geo::NCHANNELS, false);
+  }
+  auto& pos = mChannelPositions[chan];
+  if (!mIsChannelPositionSet[chan]) {
+    int det[5];
+    Geo::getVolumeIndices(chan, det);
+    Geo::getPos(det, pos.data());
+    mIsChannelPositionSet[chan] = true;
+  }
+  c.setBaseData(chan, pos[0], pos[1], pos[2], 0, 0, 0); // error on position set to zero
+}
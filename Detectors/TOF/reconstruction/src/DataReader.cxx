@@ -55,4 +55,26 @@ Bool_t DigitDataReader::getNextStripData(StripData& stripData)
 }
 
 //______________________________________________________________________________
-Bool_t RawDataReader::getNextStripData(DataReader::StripData& stripData) { return kTRUE; }
+void RawDataReader::init()
+{
+  mDigits.clear();
+  mIdx = 0;
+  if (!mDecoder.decode(mBuffer, mDigits)) {
+    LOG(ERROR) << "TOF raw data of " << mDecoder.getNErrors() << " crates could not be decoded";
+  }
+}
+
+//______________________________________________________________________________
+Bool_t RawDataReader::getNextStripData(DataReader::StripData& stripData)
+{
+  // the decoded digits are already grouped by strip and sorted according to the TDC
+  stripData.clear();
+  if (mIdx >= mDigits.size()) {
+    return kFALSE;
+  }
+  stripData.stripID = mDigits[mIdx].getChannel() / Geo::NPADS;
+  for (; mIdx < mDigits.size() && mDigits[mIdx].getChannel() / Geo::NPADS == stripData.stripID; mIdx++) {
+    stripData.digits.emplace_back(mDigits[mIdx]);
+  }
+  return kTRUE;
+}
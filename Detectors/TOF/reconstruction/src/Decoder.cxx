@@ -0,0 +1,154 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file Decoder.cxx
+/// \brief Implementation of the TOF raw data decoder
+
+#include "TOFReconstruction/Decoder.h"
+#include "TOFReconstruction/RawFormat.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "FairLogger.h" // for LOG
+
+using namespace o2::tof;
+using namespace o2::tof::raw;
+
+//______________________________________________________________________________
+bool Decoder::decode(gsl::span<const uint32_t> buffer, std::vector<Digit>& digits)
+{
+  mNErrors = 0;
+  mBlocks.fill(CrateBlock());
+
+  // locate the DRM blocks, which can come in any order
+  size_t iword = 0;
+  while (iword < buffer.size()) {
+    const uint32_t header = buffer[iword];
+    const size_t nWords = getBlockWords(header);
+    const int crate = getCrate(header);
+    if (getWordType(header) != GlobalHeader || getSlot(header) != DRMSLOT || nWords < 3 ||
+        iword + nWords > buffer.size() || crate >= Geo::kNCrate) {
+      LOG(ERROR) << "TOF raw data: corrupted DRM header 0x" << std::hex << header << std::dec << " at word " << iword;
+      mNErrors++;
+      break;
+    }
+    if (mBlocks[crate].nWords) {
+      LOG(ERROR) << "TOF raw data: crate " << crate << " is present twice";
+      mNErrors++;
+    } else {
+      mBlocks[crate] = { iword, nWords };
+    }
+    iword += nWords;
+  }
+
+  // decode the crates in parallel
+  const int nThreads = std::min(mNThreads, int(Geo::kNCrate));
+  std::atomic<int> nextCrate(0);
+  std::atomic<int> nErrors(0);
+  auto worker = [this, buffer, &nextCrate, &nErrors]() {
+    for (int crate = nextCrate++; crate < Geo::kNCrate; crate = nextCrate++) {
+      auto& crateDigits = mCrateDigits[crate];
+      crateDigits.clear();
+      const auto& block = mBlocks[crate];
+      if (block.nWords && !decodeCrate(buffer.subspan(block.first, block.nWords), crate, crateDigits)) {
+        crateDigits.clear();
+        nErrors++;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int ithread = 1; ithread < nThreads; ithread++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  mNErrors += nErrors;
+
+  // the crates serve consecutive strips
+  size_t nDigits = digits.size();
+  for (const auto& crateDigits : mCrateDigits) {
+    nDigits += crateDigits.size();
+  }
+  digits.reserve(nDigits);
+  for (const auto& crateDigits : mCrateDigits) {
+    digits.insert(digits.end(), crateDigits.begin(), crateDigits.end());
+  }
+  return mNErrors == 0;
+}
+
+//______________________________________________________________________________
+bool Decoder::decodeCrate(gsl::span<const uint32_t> block, int crate, std::vector<Digit>& digits) const
+{
+  // decode the DRM block of a crate, see RawFormat.h
+  const int windowBC = block[1];
+  if (getWordType(block[block.size() - 1]) != GlobalTrailer || getSlot(block[block.size() - 1]) != DRMSLOT) {
+    LOG(ERROR) << "TOF raw data: missing DRM trailer in crate " << crate;
+    return false;
+  }
+  size_t iword = 2;
+  const size_t trmEnd = block.size() - 1;
+  while (iword < trmEnd) {
+    const uint32_t trmHeader = block[iword];
+    const int slot = getSlot(trmHeader);
+    const size_t nWords = getBlockWords(trmHeader);
+    if (getWordType(trmHeader) != GlobalHeader || slot < FIRSTTRMSLOT || slot >= FIRSTTRMSLOT + NTRMS ||
+        nWords < 2 || iword + nWords > trmEnd || block[iword + nWords - 1] != makeGlobalTrailer(slot)) {
+      LOG(ERROR) << "TOF raw data: corrupted TRM block in crate " << crate << " at word " << iword;
+      return false;
+    }
+    const size_t chainEnd = iword + nWords - 1;
+    int chain = -1;
+    int tdc = 0, tdcChannel = 0, tdcBins = 0;
+    bool expectTOT = false;
+    for (iword++; iword < chainEnd; iword++) {
+      const uint32_t word = block[iword];
+      switch (getWordType(word)) {
+        case ChainAHeader:
+        case ChainBHeader:
+          chain = getWordType(word) == ChainBHeader ? 1 : 0;
+          break;
+        case ChainATrailer:
+        case ChainBTrailer:
+          chain = -1;
+          break;
+        case Hit:
+          tdc = getHitTDC(word);
+          tdcChannel = getHitChannel(word);
+          tdcBins = getHitTDCBins(word);
+          expectTOT = true;
+          break;
+        case HitTOT: {
+          const int channel = chain < 0 || !expectTOT ? -1 : getChannel(crate, slot, chain, tdc, tdcChannel);
+          if (channel < 0) {
+            LOG(ERROR) << "TOF raw data: unexpected hit in crate " << crate << " slot " << slot;
+            return false;
+          }
+          digits.emplace_back(channel, tdcBins, getHitTOTBins(word), windowBC + getHitBCOffset(word));
+          expectTOT = false;
+          break;
+        }
+        default:
+          LOG(ERROR) << "TOF raw data: unknown word 0x" << std::hex << word << std::dec << " in crate " << crate;
+          return false;
+      }
+    }
+    iword++; // TRM trailer
+  }
+
+  // the hits come in channel order within a TDC, but the TDCs of a strip are read out by different chains:
+  // group the digits by strip and sort them in TDC, as expected by the Clusterer
+  std::sort(digits.begin(), digits.end(), [](const Digit& a, const Digit& b) {
+    const int stripA = a.getChannel() / Geo::NPADS, stripB = b.getChannel() / Geo::NPADS;
+    return stripA < stripB || (stripA == stripB && (a.getTDC() < b.getTDC() || (a.getTDC() == b.getTDC() && a.getChannel() < b.getChannel())));
+  });
+  return true;
+}
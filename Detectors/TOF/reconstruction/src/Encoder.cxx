@@ -0,0 +1,93 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file Encoder.cxx
+/// \brief Implementation of the TOF raw data encoder
+
+#include "TOFReconstruction/Encoder.h"
+#include "TOFReconstruction/RawFormat.h"
+#include <algorithm>
+#include "FairLogger.h" // for LOG
+
+using namespace o2::tof;
+using namespace o2::tof::raw;
+
+namespace
+{
+// hits are sorted by crate, slot (16 values), chain, TDC and TDC channel
+constexpr uint32_t KEYSPERCHAIN = Geo::kNTdc * Geo::kNCh;
+constexpr uint32_t KEYSPERSLOT = Geo::kNChain * KEYSPERCHAIN;
+constexpr uint32_t KEYSPERCRATE = 16 * KEYSPERSLOT;
+} // namespace
+
+//______________________________________________________________________________
+bool Encoder::encode(gsl::span<const Digit> digits, int windowBC, std::vector<uint32_t>& buffer)
+{
+  int nSkipped = 0;
+  mHits.clear();
+  mHits.reserve(digits.size());
+  for (const auto& digit : digits) {
+    const int bcOffset = digit.getBC() - windowBC;
+    if (digit.getChannel() < 0 || digit.getChannel() >= Geo::NCHANNELS || bcOffset < 0 || bcOffset > MAXBCOFFSET ||
+        digit.getTDC() < 0 || digit.getTDC() > MAXTDCBINS || digit.getTOT() < 0 || digit.getTOT() > MAXTOTBINS) {
+      nSkipped++;
+      continue;
+    }
+    const auto index = getElectronicIndex(digit.getChannel());
+    const uint32_t key = index.crate * KEYSPERCRATE + index.slot * KEYSPERSLOT + index.chain * KEYSPERCHAIN +
+                         index.tdc * Geo::kNCh + index.channel;
+    mHits.push_back({ key, makeHit(index.tdc, index.channel, digit.getTDC()), makeHitTOT(bcOffset, digit.getTOT()) });
+  }
+  // the hits of a TDC channel keep their order
+  std::stable_sort(mHits.begin(), mHits.end());
+
+  auto hit = mHits.begin();
+  for (int crate = 0; crate < Geo::kNCrate; crate++) {
+    const size_t drmHeader = buffer.size();
+    buffer.push_back(0);
+    buffer.push_back(windowBC);
+    const uint32_t crateEnd = (crate + 1) * KEYSPERCRATE;
+    while (hit != mHits.end() && hit->key < crateEnd) {
+      const int slot = (hit->key % KEYSPERCRATE) / KEYSPERSLOT;
+      const uint32_t slotStart = hit->key - hit->key % KEYSPERSLOT;
+      const size_t trmHeader = buffer.size();
+      buffer.push_back(0);
+      for (int chain = 0; chain < Geo::kNChain; chain++) {
+        const uint32_t chainEnd = slotStart + (chain + 1) * KEYSPERCHAIN;
+        buffer.push_back(makeChainHeader(slot, chain));
+        int nHits = 0;
+        for (; hit != mHits.end() && hit->key < chainEnd; ++hit, ++nHits) {
+          buffer.push_back(hit->hit);
+          buffer.push_back(hit->hitTOT);
+        }
+        buffer.push_back(makeChainTrailer(slot, chain, nHits));
+      }
+      buffer.push_back(makeGlobalTrailer(slot));
+      buffer[trmHeader] = makeGlobalHeader(slot, buffer.size() - trmHeader);
+    }
+    buffer.push_back(makeGlobalTrailer(DRMSLOT));
+    const size_t nWords = buffer.size() - drmHeader;
+    if (nWords > MAXWORDSINBLOCK) {
+      LOG(ERROR) << "TOF crate " << crate << " has " << nWords << " words, more than the DRM block can hold";
+      buffer.resize(drmHeader);
+      buffer.push_back(makeGlobalHeader(DRMSLOT, 3, crate));
+      buffer.push_back(windowBC);
+      buffer.push_back(makeGlobalTrailer(DRMSLOT));
+      nSkipped++;
+      continue;
+    }
+    buffer[drmHeader] = makeGlobalHeader(DRMSLOT, nWords, crate);
+  }
+
+  if (nSkipped) {
+    LOG(WARNING) << "TOF encoder skipped " << nSkipped << " digits or crates out of range";
+  }
+  return nSkipped == 0;
+}
@@ -0,0 +1,121 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TOFRawData
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include "TOFReconstruction/DataReader.h"
+#include "TOFReconstruction/Decoder.h"
+#include "TOFReconstruction/Encoder.h"
+#include "TOFReconstruction/RawFormat.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace o2::tof;
+
+namespace
+{
+// digits sorted by channel, as produced by the digitizer, with distinct TDC in each strip
+std::vector<Digit> makeDigits(int nDigits, int windowBC)
+{
+  std::mt19937 generator(1234);
+  std::uniform_int_distribution<int> channel(0, Geo::NCHANNELS - 1), tot(0, 2000), bc(0, 1100);
+  std::vector<Digit> digits;
+  for (int i = 0; i < nDigits; i++) {
+    digits.emplace_back(channel(generator), (i * 7919) % 100000, tot(generator), windowBC + bc(generator));
+  }
+  std::sort(digits.begin(), digits.end(), [](const Digit& a, const Digit& b) { return a.getChannel() < b.getChannel(); });
+  return digits;
+}
+
+bool isSame(const Digit& a, const Digit& b)
+{
+  return a.getChannel() == b.getChannel() && a.getTDC() == b.getTDC() && a.getTOT() == b.getTOT() && a.getBC() == b.getBC();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(testTOFElectronicIndex)
+{
+  for (int channel = 0; channel < Geo::NCHANNELS; channel++) {
+    auto index = raw::getElectronicIndex(channel);
+    BOOST_REQUIRE(index.crate < Geo::kNCrate);
+    BOOST_REQUIRE(index.slot >= raw::FIRSTTRMSLOT && index.slot < raw::FIRSTTRMSLOT + raw::NTRMS);
+    BOOST_REQUIRE_EQUAL(raw::getChannel(index.crate, index.slot, index.chain, index.tdc, index.channel), channel);
+  }
+  // the last TDCs of the crates with 22 strips are not connected
+  BOOST_CHECK_EQUAL(raw::getChannel(3, 12, 1, 14, 7), -1);
+}
+
+BOOST_AUTO_TEST_CASE(testTOFRawDataRoundTrip)
+{
+  const int windowBC = 3564 * 5;
+  auto digits = makeDigits(20000, windowBC);
+  std::vector<uint32_t> buffer;
+  Encoder encoder;
+  BOOST_CHECK(encoder.encode(digits, windowBC, buffer));
+
+  // the decoded digits are those of the DigitDataReader, strip by strip, whatever the number of threads
+  DigitDataReader digitReader;
+  RawDataReader rawReader;
+  for (int nThreads : { 1, 4 }) {
+    digitReader.setDigitArray(&digits);
+    digitReader.init();
+    rawReader.setRawData(buffer);
+    rawReader.setNThreads(nThreads);
+    rawReader.init();
+    BOOST_CHECK_EQUAL(rawReader.getNErrors(), 0);
+    BOOST_CHECK_EQUAL(rawReader.getDigits().size(), digits.size());
+
+    DataReader::StripData digitStrip, rawStrip;
+    int nStrips = 0;
+    while (digitReader.getNextStripData(digitStrip)) {
+      BOOST_REQUIRE(rawReader.getNextStripData(rawStrip));
+      BOOST_REQUIRE_EQUAL(rawStrip.stripID, digitStrip.stripID);
+      BOOST_REQUIRE_EQUAL(rawStrip.digits.size(), digitStrip.digits.size());
+      for (size_t i = 0; i < digitStrip.digits.size(); i++) {
+        BOOST_REQUIRE(isSame(rawStrip.digits[i], digitStrip.digits[i]));
+      }
+      nStrips++;
+    }
+    BOOST_CHECK(!rawReader.getNextStripData(rawStrip));
+    BOOST_CHECK(nStrips > 0);
+  }
+
+  // digits out of the window are skipped
+  std::vector<Digit> late = { Digit(10, 0, 0, windowBC - 1), Digit(11, 0, 0, windowBC) };
+  buffer.clear();
+  BOOST_CHECK(!encoder.encode(late, windowBC, buffer));
+  std::vector<Digit> decoded;
+  Decoder decoder;
+  BOOST_CHECK(decoder.decode(buffer, decoded));
+  BOOST_REQUIRE_EQUAL(decoded.size(), 1);
+  BOOST_CHECK(isSame(decoded[0], late[1]));
+}
+
+BOOST_AUTO_TEST_CASE(testTOFRawDataCorrupted)
+{
+  const int windowBC = 0;
+  std::vector<Digit> digits = { Digit(0, 5, 6, 1), Digit(100000, 7, 8, 2) };
+  std::vector<uint32_t> buffer;
+  Encoder encoder;
+  BOOST_CHECK(encoder.encode(digits, windowBC, buffer));
+
+  // the DRM trailer of the first crate is broken: its digits are dropped, the other crates are decoded
+  const int nWordsFirst = raw::getBlockWords(buffer[0]);
+  buffer[nWordsFirst - 1] = raw::makeGlobalTrailer(2);
+  std::vector<Digit> decoded;
+  Decoder decoder;
+  decoder.setNThreads(2);
+  BOOST_CHECK(!decoder.decode(buffer, decoded));
+  BOOST_CHECK_EQUAL(decoder.getNErrors(), 1);
+  BOOST_REQUIRE_EQUAL(decoded.size(), 1);
+  BOOST_CHECK(isSame(decoded[0], digits[1]));
+}
@@ -16,6 +16,7 @@
 
 #include "SimulationDataFormat/BaseHits.h"
 #include "CommonUtils/ShmAllocator.h"
+#include "CommonUtils/CompactHits.h"
 
 class FairVolume;
 
@@ -31,6 +32,17 @@ class HitType : public o2::BasicXYZEHit<float>
 } // namespace tof
 } // namespace o2
 
+namespace o2
+{
+namespace utils
+{
+// the TOF hits have the basic fields only
+template <>
+struct CompactHitCodec<o2::tof::HitType> : BasicHitCodec<o2::tof::HitType> {
+};
+} // namespace utils
+} // namespace o2
+
 #ifdef USESHM
 namespace std
 {
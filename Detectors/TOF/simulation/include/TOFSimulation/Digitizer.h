@@ -17,6 +17,7 @@
 #include "TOFSimulation/Strip.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include "TOFSimulation/MCLabel.h"
+#include "MathUtils/RandomStream.h"
 
 namespace o2
 {
@@ -41,6 +42,11 @@ class Digitizer
   Float_t getEffZ(Float_t z);
   Float_t getFractionOfCharge(Float_t x, Float_t z);
 
+  /// seed of the generator used for the random numbers of process (by default taken from gRandom)
+  void setRandomSeed(ULong64_t seed) { mRandomStream.seed(seed); }
+  /// random stream of the numbers of process, e.g. one of o2::utils::RngHelper::getStream per event
+  void setRandomStream(const o2::math_utils::RandomStream& stream) { mRandomStream = stream; }
+
   Int_t getCurrentReadoutWindow() const { return mReadoutWindowCurrent; }
   void setCurrentReadoutWindow(Double_t value) { mReadoutWindowCurrent = value; }
   Float_t getTimeLastHit(Int_t idigit) const { return 0; }
@@ -124,11 +130,54 @@ class Digitizer
 
   o2::dataformats::MCTruthContainer<o2::tof::MCLabel> mFutureMCTruthContainer;
 
+  // batched digitization of the hits in process: the candidate pads of NHITSBATCH hits are evaluated at once
+  static constexpr int NHITSBATCH = 16; // hits digitized at once
+  static constexpr int NPADSHIT = 6;    // candidate pads of a hit: the one hit and its neighbours
+
+  struct HitBatch {
+    Float_t time[NHITSBATCH];                 // hit time with the shower smearing (ps)
+    Float_t charge[NHITSBATCH];               // collected charge
+    Int_t trackID[NHITSBATCH];                // track of the hit
+    UInt_t istrip[NHITSBATCH];                // strip of the hit
+    Int_t padZfired[NHITSBATCH];              // pad row of the hit pad
+    Int_t iZshift[NHITSBATCH];                // direction of the other pad row
+    Int_t channel[NPADSHIT][NHITSBATCH];      // channel of the candidate pads (-1 if outside of the strip)
+    Float_t x[NPADSHIT][NHITSBATCH];          // local x of the hit in the candidate pads
+    Float_t z[NPADSHIT][NHITSBATCH];          // local z of the hit in the candidate pads
+    Float_t rndm[NPADSHIT][NHITSBATCH];       // uniform random numbers for the efficiency
+    bool fired[NPADSHIT][NHITSBATCH];         // candidate pads which are fired
+    Float_t noise[2 * NPADSHIT * NHITSBATCH]; // normal random numbers for the digit time smearing
+    Float_t hitRndm[2 * NHITSBATCH];          // random numbers for the charge and the shower time smearing
+  };
+
+  HitBatch mHitBatch;                         //! buffers of the hit batch being digitized
+  o2::math_utils::RandomStream mRandomStream; //! the random numbers drawn in bulk in process
+
+  void processHitBatch(const HitType* hits, Int_t nhits, Double_t event_time);
+
+  /// efficiency as a function of the distance from the pad border (negative outside of the pad),
+  /// written without branches such that it can be evaluated for many pads at once
+  Float_t getEffFromBorder(Float_t border) const
+  {
+    Float_t effIn = mEffBoundary2 + (mEffBoundary1 - mEffBoundary2) * border / mBound2;
+    effIn = border > mBound2 ? mEffBoundary1 + (mEffCenter - mEffBoundary1) * (border - mBound2) / (mBound1 - mBound2) : effIn;
+    effIn = border > mBound1 ? mEffCenter : effIn;
+    Float_t effOut = mEffBoundary2 + (mEffBoundary3 - mEffBoundary2) * -border / mBound3;
+    effOut = -border > mBound3 ? mEffBoundary3 - mEffBoundary3 * (-border - mBound3) / (mBound4 - mBound3) : effOut;
+    effOut = -border > mBound4 ? 0.f : effOut;
+    return border > 0 ? effIn : effOut;
+  }
+
+  Float_t getChargeFromRndm(Float_t rndm) const;
+
   void fillDigitsInStrip(std::vector<Strip>* strips, o2::dataformats::MCTruthContainer<o2::tof::MCLabel>* mcTruthContainer, int channel, int tdc, int tot, int nbc, UInt_t istrip, Int_t trackID, Int_t eventID, Int_t sourceID);
 
   Int_t processHit(const HitType& hit, Double_t event_time);
   void addDigit(Int_t channel, UInt_t istrip, Float_t time, Float_t x, Float_t z, Float_t charge, Int_t iX, Int_t iZ, Int_t padZfired,
                 Int_t trackID);
+  // add a digit whose time already contains the digit smearing, borderNoise is a normal random number
+  void addSmearedDigit(Int_t channel, UInt_t istrip, Float_t time, Float_t x, Float_t z, Float_t charge, Int_t iX, Int_t iZ, Int_t padZfired,
+                       Int_t trackID, Float_t borderNoise);
 
   void checkIfReuseFutureDigits();
 
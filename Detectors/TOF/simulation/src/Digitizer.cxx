@@ -18,8 +18,10 @@
 #include "TMath.h"
 #include "TProfile2D.h"
 #include "TRandom.h"
+#include "Math/QuantFuncMathCore.h"
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 using namespace o2::tof;
 
@@ -33,6 +35,9 @@ void Digitizer::init()
 
   initParameters();
 
+  // the bulk random numbers follow the seed of gRandom
+  setRandomSeed(gRandom->Integer(kMaxUInt));
+
   for (Int_t i = 0; i < Geo::NSTRIPS; i++) {
     for (Int_t j = 0; j < MAXWINDOWS; j++) {
       mStrips[j].emplace_back(i);
@@ -64,10 +69,9 @@ void Digitizer::process(const std::vector<HitType>* hits, std::vector<Digit>* di
     } // close loop readout window
   }   // close if continuous
 
-  for (auto& hit : *hits) {
-    //TODO: put readout window counting/selection
-
-    processHit(hit, mEventTime);
+  //TODO: put readout window counting/selection
+  for (size_t ihit = 0; ihit < hits->size(); ihit += NHITSBATCH) {
+    processHitBatch(hits->data() + ihit, std::min<size_t>(NHITSBATCH, hits->size() - ihit), mEventTime);
   } // end loop over hits
 
   if (!mContinuous) { // fill output container per event
@@ -198,14 +202,93 @@ Int_t Digitizer::processHit(const HitType &hit,Double_t event_time)
 
 }
 
+//______________________________________________________________________
+void Digitizer::processHitBatch(const HitType* hits, Int_t nhits, Double_t event_time)
+{
+  // digitize nhits <= NHITSBATCH hits as processHit does: the geometry is resolved for each hit, then the
+  // efficiency of the candidate pads is evaluated for all the hits together, with the random numbers
+  // drawn in bulk from mRandomStream
+
+  // candidate pads in the order of processHit (A, 2, 3, 5, 4, 6): shift in x and if in the other pad row
+  constexpr Int_t padShiftX[NPADSHIT] = { 0, 0, -1, 1, -1, 1 };
+  constexpr Int_t padOtherRow[NPADSHIT] = { 0, 1, 0, 0, 1, 1 };
+
+  auto& batch = mHitBatch;
+  mRandomStream.fillUniform(batch.hitRndm, nhits);
+  mRandomStream.fillGaus(batch.hitRndm + NHITSBATCH, nhits);
+
+  Float_t deltapos[3];
+  Int_t detInd[5];
+  Int_t detIndOtherPad[5];
+  for (Int_t ihit = 0; ihit < nhits; ihit++) {
+    const auto& hit = hits[ihit];
+    Float_t pos[3] = { hit.GetX(), hit.GetY(), hit.GetZ() };
+    Geo::getPadDxDyDz(pos, detInd, deltapos); // Get DetId and residuals
+
+    Int_t otherraw = detInd[3] == 0 ? 1 : 0;
+    batch.iZshift[ihit] = otherraw ? 1 : -1;
+    batch.padZfired[ihit] = detInd[3];
+    batch.istrip[ihit] = Geo::getIndex(detInd) / Geo::NPADS;
+    batch.trackID[ihit] = hit.GetTrackID();
+    batch.charge[ihit] = getChargeFromRndm(batch.hitRndm[ihit]);
+    // NOTE: FROM NOW ON THE TIME IS IN PS ... AND NOT IN NS
+    batch.time[ihit] = (event_time + hit.GetTime()) * 1E3 + mShowerResolution * batch.hitRndm[NHITSBATCH + ihit];
+
+    detIndOtherPad[0] = detInd[0], detIndOtherPad[1] = detInd[1], detIndOtherPad[2] = detInd[2]; // same sector, plate, strip
+    for (Int_t ipad = 0; ipad < NPADSHIT; ipad++) {
+      detIndOtherPad[3] = padOtherRow[ipad] ? otherraw : detInd[3];
+      detIndOtherPad[4] = detInd[4] + padShiftX[ipad];
+      bool inStrip = detIndOtherPad[4] >= 0 && detIndOtherPad[4] < Geo::NPADX;
+      batch.channel[ipad][ihit] = inStrip ? Geo::getIndex(detIndOtherPad) : -1;
+      batch.x[ipad][ihit] = deltapos[0] - padShiftX[ipad] * Geo::XPAD; // recompute local coordinates
+      batch.z[ipad][ihit] = deltapos[2] - padOtherRow[ipad] * batch.iZshift[ihit] * Geo::ZPAD;
+    }
+  }
+
+  // efficiency of all the candidate pads, as in isFired
+  Int_t nfired = 0;
+  for (Int_t ipad = 0; ipad < NPADSHIT; ipad++) {
+    mRandomStream.fillUniform(batch.rndm[ipad], nhits);
+    for (Int_t ihit = 0; ihit < nhits; ihit++) {
+      Float_t x = batch.x[ipad][ihit], z = batch.z[ipad][ihit];
+      Float_t efficiency = std::min(getEffFromBorder(Geo::XPAD * 0.5f - std::abs(x)), getEffFromBorder(Geo::ZPAD * 0.5f - std::abs(z)));
+      batch.fired[ipad][ihit] = batch.channel[ipad][ihit] >= 0 && std::abs(x) <= Geo::XPAD * 0.5f + 0.3f && std::abs(z) <= Geo::ZPAD * 0.5f + 0.3f &&
+                                batch.rndm[ipad][ihit] <= efficiency;
+      nfired += batch.fired[ipad][ihit];
+    }
+  }
+
+  // add the digits of the fired pads, in the order of the hits
+  mRandomStream.fillGaus(batch.noise, 2 * nfired);
+  const Float_t* noise = batch.noise;
+  for (Int_t ihit = 0; ihit < nhits; ihit++) {
+    for (Int_t ipad = 0; ipad < NPADSHIT; ipad++) {
+      if (!batch.fired[ipad][ihit]) {
+        continue;
+      }
+      Float_t time = batch.time[ihit] + mDigitResolution * noise[0]; // add time smearing
+      addSmearedDigit(batch.channel[ipad][ihit], batch.istrip[ihit], time, batch.x[ipad][ihit], batch.z[ipad][ihit], batch.charge[ihit],
+                      padShiftX[ipad], padOtherRow[ipad] * batch.iZshift[ihit], batch.padZfired[ihit], batch.trackID[ihit], noise[1]);
+      noise += 2;
+    }
+  }
+}
+
 //______________________________________________________________________
 void Digitizer::addDigit(Int_t channel, UInt_t istrip, Float_t time, Float_t x, Float_t z, Float_t charge, Int_t iX, Int_t iZ,
                          Int_t padZfired, Int_t trackID)
 {
-  // TOF digit requires: channel, time and time-over-threshold
-
   time = getDigitTimeSmeared(time, x, z, charge); // add time smearing
 
+  addSmearedDigit(channel, istrip, time, x, z, charge, iX, iZ, padZfired, trackID, gRandom->Gaus(0, 1));
+}
+
+//______________________________________________________________________
+void Digitizer::addSmearedDigit(Int_t channel, UInt_t istrip, Float_t time, Float_t x, Float_t z, Float_t charge, Int_t iX, Int_t iZ,
+                                Int_t padZfired, Int_t trackID, Float_t borderNoise)
+{
+  // TOF digit requires: channel, time and time-over-threshold
+
   charge *= getFractionOfCharge(x, z);
   Float_t tot = 12; // time-over-threshold
 
@@ -219,7 +302,7 @@ void Digitizer::addDigit(Int_t channel, UInt_t istrip, Float_t time, Float_t x,
   if (border < 0) { // keep the effect onlu if hit out of pad
     border *= -1;
     Float_t extraTimeSmear = border * mTimeSlope;
-    time += gRandom->Gaus(mTimeDelay, extraTimeSmear);
+    time += mTimeDelay + extraTimeSmear * borderNoise;
   } else {
     border = 1 - border;
     // if(border > 0)  printf("deltat =%f\n",mTimeDelay*border*border*border);
@@ -319,10 +402,17 @@ Float_t Digitizer::getDigitTimeSmeared(Float_t time, Float_t x, Float_t z, Float
 Float_t Digitizer::getCharge(Float_t eDep)
 {
   // transform deposited energy in collected charge
+  return getChargeFromRndm(gRandom->Rndm());
+}
+
+//______________________________________________________________________
+Float_t Digitizer::getChargeFromRndm(Float_t rndm) const
+{
+  // collected charge from a uniform random number, as TRandom::Landau
   Float_t adcMean = 50;
   Float_t adcRms = 25;
 
-  return gRandom->Landau(adcMean, adcRms);
+  return adcMean + ROOT::Math::landau_quantile(rndm, adcRms);
 }
 
 //______________________________________________________________________
@@ -345,54 +435,10 @@ Bool_t Digitizer::isFired(Float_t x, Float_t z, Float_t charge)
 }
 
 //______________________________________________________________________
-Float_t Digitizer::getEffX(Float_t x)
-{
-  Float_t xborder = Geo::XPAD * 0.5 - TMath::Abs(x);
-
-  if (xborder > 0) {
-    if (xborder > mBound1)
-      return mEffCenter;
-    else if (xborder > mBound2)
-      return mEffBoundary1 + (mEffCenter - mEffBoundary1) * (xborder - mBound2) / (mBound1 - mBound2);
-    else
-      return mEffBoundary2 + (mEffBoundary1 - mEffBoundary2) * xborder / mBound2;
-  } else {
-    xborder *= -1;
-    if (xborder > mBound4)
-      return 0;
-    else if (xborder > mBound3)
-      return mEffBoundary3 - mEffBoundary3 * (xborder - mBound3) / (mBound4 - mBound3);
-    else
-      return mEffBoundary2 + (mEffBoundary3 - mEffBoundary2) * xborder / mBound3;
-  }
-
-  return 0;
-}
+Float_t Digitizer::getEffX(Float_t x) { return getEffFromBorder(Geo::XPAD * 0.5 - TMath::Abs(x)); }
 
 //______________________________________________________________________
-Float_t Digitizer::getEffZ(Float_t z)
-{
-  Float_t zborder = Geo::ZPAD * 0.5 - TMath::Abs(z);
-
-  if (zborder > 0) {
-    if (zborder > mBound1)
-      return mEffCenter;
-    else if (zborder > mBound2)
-      return mEffBoundary1 + (mEffCenter - mEffBoundary1) * (zborder - mBound2) / (mBound1 - mBound2);
-    else
-      return mEffBoundary2 + (mEffBoundary1 - mEffBoundary2) * zborder / mBound2;
-  } else {
-    zborder *= -1;
-    if (zborder > mBound4)
-      return 0;
-    else if (zborder > mBound3)
-      return mEffBoundary3 - mEffBoundary3 * (zborder - mBound3) / (mBound4 - mBound3);
-    else
-      return mEffBoundary2 + (mEffBoundary3 - mEffBoundary2) * zborder / mBound3;
-  }
-
-  return 0;
-}
+Float_t Digitizer::getEffZ(Float_t z) { return getEffFromBorder(Geo::ZPAD * 0.5 - TMath::Abs(z)); }
 
 //______________________________________________________________________
 Float_t Digitizer::getFractionOfCharge(Float_t x, Float_t z) { return 1; }
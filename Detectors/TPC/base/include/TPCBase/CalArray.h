@@ -12,6 +12,8 @@
 #define ALICEO2_TPC_CALARRAY_H_
 
 #include <Vc/Vc>
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <string>
@@ -133,6 +135,24 @@ class CalArray
   /// Divide value on all channels
   const CalArray& operator/=(const T& val);
 
+  /// Apply op(this, other) channel by channel
+  ///
+  /// The channels are processed in one pass over the contiguous data, which can be
+  /// vectorized by the compiler for plain arithmetic operations
+  /// \param other object with the same pad subset
+  /// \param op binary operation, e.g. std::plus<T>()
+  template <class BinaryOp>
+  const CalArray& transform(const CalArray& other, BinaryOp op);
+
+  /// Apply op(this, other) channel by channel, only where mask is not zero
+  ///
+  /// The unmasked channels are kept, the selection is branch free
+  /// \param other object with the same pad subset
+  /// \param mask object with the same pad subset, e.g. CalArray<int> of dead channels
+  /// \param op binary operation, e.g. std::plus<T>()
+  template <class M, class BinaryOp>
+  const CalArray& transform(const CalArray& other, const CalArray<M>& mask, BinaryOp op);
+
  private:
   std::string mName;
   // better to use std::array?
@@ -200,60 +220,28 @@ inline const T CalArray<T>::getValue(const size_t row, const size_t pad) const
 template <class T>
 inline const CalArray<T>& CalArray<T>::operator+=(const CalArray<T>& other)
 {
-  if (!((mPadSubset == other.mPadSubset) && (mPadSubsetNumber == other.mPadSubsetNumber))) {
-    LOG(ERROR) << "You are trying to operate on incompatible objects: Pad subset type and number must be the same on both objects"
-               << FairLogger::endl;
-    return *this;
-  }
-  for (size_t i = 0; i < mData.size(); ++i) {
-    mData[i] += other.getValue(i);
-  }
-  return *this;
+  return transform(other, std::plus<T>());
 }
 
 //______________________________________________________________________________
 template <class T>
 inline const CalArray<T>& CalArray<T>::operator-=(const CalArray<T>& other)
 {
-  if (!((mPadSubset == other.mPadSubset) && (mPadSubsetNumber == other.mPadSubsetNumber))) {
-    LOG(ERROR) << "You are trying to operate on incompatible objects: Pad subset type and number must be the same on both objects"
-               << FairLogger::endl;
-    return *this;
-  }
-  for (size_t i = 0; i < mData.size(); ++i) {
-    mData[i] -= other.getValue(i);
-  }
-  return *this;
+  return transform(other, std::minus<T>());
 }
 
 //______________________________________________________________________________
 template <class T>
 inline const CalArray<T>& CalArray<T>::operator*=(const CalArray<T>& other)
 {
-  if (!((mPadSubset == other.mPadSubset) && (mPadSubsetNumber == other.mPadSubsetNumber))) {
-    LOG(ERROR) << "pad subste type of the objects it not compatible"
-               << FairLogger::endl;
-    return *this;
-  }
-  for (size_t i = 0; i < mData.size(); ++i) {
-    mData[i] *= other.getValue(i);
-  }
-  return *this;
+  return transform(other, std::multiplies<T>());
 }
 
 //______________________________________________________________________________
 template <class T>
 inline const CalArray<T>& CalArray<T>::operator/=(const CalArray<T>& other)
 {
-  if (!((mPadSubset == other.mPadSubset) && (mPadSubsetNumber == other.mPadSubsetNumber))) {
-    LOG(ERROR) << "pad subste type of the objects it not compatible"
-               << FairLogger::endl;
-    return *this;
-  }
-  for (size_t i = 0; i < mData.size(); ++i) {
-    mData[i] /= other.getValue(i);
-  }
-  return *this;
+  return transform(other, std::divides<T>());
 }
 
 //______________________________________________________________________________
@@ -296,6 +284,39 @@ inline const CalArray<T>& CalArray<T>::operator/=(const T& val)
   return *this;
 }
 
+//______________________________________________________________________________
+template <class T>
+template <class BinaryOp>
+inline const CalArray<T>& CalArray<T>::transform(const CalArray<T>& other, BinaryOp op)
+{
+  if (!((mPadSubset == other.mPadSubset) && (mPadSubsetNumber == other.mPadSubsetNumber))) {
+    LOG(ERROR) << "You are trying to operate on incompatible objects: Pad subset type and number must be the same on both objects"
+               << FairLogger::endl;
+    return *this;
+  }
+  std::transform(mData.begin(), mData.end(), other.mData.begin(), mData.begin(), op);
+  return *this;
+}
+
+//______________________________________________________________________________
+template <class T>
+template <class M, class BinaryOp>
+inline const CalArray<T>& CalArray<T>::transform(const CalArray<T>& other, const CalArray<M>& mask, BinaryOp op)
+{
+  if (!((mPadSubset == other.mPadSubset) && (mPadSubsetNumber == other.mPadSubsetNumber)) ||
+      !((mPadSubset == mask.getPadSubset()) && (mPadSubsetNumber == mask.getPadSubsetNumber()))) {
+    LOG(ERROR) << "You are trying to operate on incompatible objects: Pad subset type and number must be the same on all objects"
+               << FairLogger::endl;
+    return *this;
+  }
+  const auto& maskData = mask.getData();
+  for (size_t i = 0; i < mData.size(); ++i) {
+    const T value = mData[i];
+    mData[i] = maskData[i] ? op(value, other.mData[i]) : value;
+  }
+  return *this;
+}
+
 using CalROC = CalArray<float>;
 } // namespace TPC
 } // namespace o2
@@ -11,7 +11,10 @@
 #ifndef ALICEO2_TPC_CALDET_H_
 #define ALICEO2_TPC_CALDET_H_
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <vector>
 #include <string>
 #include <boost/format.hpp>
@@ -82,6 +85,29 @@ class CalDet
   const CalDet& operator*=(const T& val);
   const CalDet& operator/=(const T& val);
 
+  /// Apply op(this, other) channel by channel, see CalArray::transform
+  template <class BinaryOp>
+  const CalDet& transform(const CalDet& other, BinaryOp op);
+
+  /// Apply op(this, other) channel by channel where mask is not zero, see CalArray::transform
+  template <class M, class BinaryOp>
+  const CalDet& transform(const CalDet& other, const CalDet<M>& mask, BinaryOp op);
+
+  /// total number of channels in all CalArrays
+  size_t getNumberOfChannels() const;
+
+  /// Copy all channels, CalArray after CalArray, to the contiguous range starting at out
+  ///
+  /// e.g. to ship the whole object as one flat buffer instead of ROOT streaming it
+  /// \return end of the written range
+  template <class OutputIt>
+  OutputIt copyTo(OutputIt out) const;
+
+  /// Set all channels from a contiguous range as written by copyTo
+  /// \return end of the read range
+  template <class InputIt>
+  InputIt copyFrom(InputIt in);
+
  private:
   std::string mName;          ///< name of the object
   std::vector<CalType> mData; ///< internal CalArrays
@@ -178,56 +204,74 @@ inline const T CalDet<T>::getValue(const CRU cru, const size_t row, const size_t
 template <class T>
 inline const CalDet<T>& CalDet<T>::operator+=(const CalDet& other)
 {
-  // make sure the calibration objects have the same substructure
-  // TODO: perhaps make it independed of this
-  if (mPadSubset != other.mPadSubset) {
-    LOG(ERROR) << "Pad subste type of the objects it not compatible" << FairLogger::endl;
-    return *this;
-  }
-
-  for (size_t i = 0; i < mData.size(); ++i) {
-    mData[i] += other.mData[i];
-  }
-  return *this;
+  return transform(other, std::plus<T>());
 }
 
 //______________________________________________________________________________
 template <class T>
 inline const CalDet<T>& CalDet<T>::operator-=(const CalDet& other)
 {
-  // make sure the calibration objects have the same substructure
-  // TODO: perhaps make it independed of this
-  if (mPadSubset != other.mPadSubset) {
-    LOG(ERROR) << "Pad subste type of the objects it not compatible" << FairLogger::endl;
-    return *this;
+  return transform(other, std::minus<T>());
+}
+
+//______________________________________________________________________________
+template <class T>
+inline const CalDet<T>& CalDet<T>::operator*=(const CalDet& other)
+{
+  return transform(other, std::multiplies<T>());
+}
+
+//______________________________________________________________________________
+template <class T>
+inline const CalDet<T>& CalDet<T>::operator/=(const CalDet& other)
+{
+  return transform(other, std::divides<T>());
+}
+
+//______________________________________________________________________________
+template <class T>
+inline const CalDet<T>& CalDet<T>::operator+=(const T& val)
+{
+  for (auto& cal : mData) {
+    cal += val;
   }
+  return *this;
+}
 
-  for (size_t i = 0; i < mData.size(); ++i) {
-    mData[i] -= other.mData[i];
+//______________________________________________________________________________
+template <class T>
+inline const CalDet<T>& CalDet<T>::operator-=(const T& val)
+{
+  for (auto& cal : mData) {
+    cal -= val;
   }
   return *this;
 }
 
 //______________________________________________________________________________
 template <class T>
-inline const CalDet<T>& CalDet<T>::operator*=(const CalDet& other)
+inline const CalDet<T>& CalDet<T>::operator*=(const T& val)
 {
-  // make sure the calibration objects have the same substructure
-  // TODO: perhaps make it independed of this
-  if (mPadSubset != other.mPadSubset) {
-    LOG(ERROR) << "Pad subste type of the objects it not compatible" << FairLogger::endl;
-    return *this;
+  for (auto& cal : mData) {
+    cal *= val;
   }
+  return *this;
+}
 
-  for (size_t i = 0; i < mData.size(); ++i) {
-    mData[i] *= other.mData[i];
+//______________________________________________________________________________
+template <class T>
+inline const CalDet<T>& CalDet<T>::operator/=(const T& val)
+{
+  for (auto& cal : mData) {
+    cal /= val;
   }
   return *this;
 }
 
 //______________________________________________________________________________
 template <class T>
-inline const CalDet<T>& CalDet<T>::operator/=(const CalDet& other)
+template <class BinaryOp>
+inline const CalDet<T>& CalDet<T>::transform(const CalDet& other, BinaryOp op)
 {
   // make sure the calibration objects have the same substructure
   // TODO: perhaps make it independed of this
@@ -237,49 +281,58 @@ inline const CalDet<T>& CalDet<T>::operator/=(const CalDet& other)
   }
 
   for (size_t i = 0; i < mData.size(); ++i) {
-    mData[i] /= other.mData[i];
+    mData[i].transform(other.mData[i], op);
   }
   return *this;
 }
 
 //______________________________________________________________________________
 template <class T>
-inline const CalDet<T>& CalDet<T>::operator+=(const T& val)
+template <class M, class BinaryOp>
+inline const CalDet<T>& CalDet<T>::transform(const CalDet& other, const CalDet<M>& mask, BinaryOp op)
 {
-  for (auto& cal : mData) {
-    cal += val;
+  if (mPadSubset != other.mPadSubset || mPadSubset != mask.getPadSubset()) {
+    LOG(ERROR) << "Pad subste type of the objects it not compatible" << FairLogger::endl;
+    return *this;
+  }
+
+  for (size_t i = 0; i < mData.size(); ++i) {
+    mData[i].transform(other.mData[i], mask.getCalArray(i), op);
   }
   return *this;
 }
 
 //______________________________________________________________________________
 template <class T>
-inline const CalDet<T>& CalDet<T>::operator-=(const T& val)
+inline size_t CalDet<T>::getNumberOfChannels() const
 {
-  for (auto& cal : mData) {
-    cal -= val;
-  }
-  return *this;
+  return std::accumulate(mData.begin(), mData.end(), size_t(0),
+                         [](size_t sum, const CalType& cal) { return sum + cal.getData().size(); });
 }
 
 //______________________________________________________________________________
 template <class T>
-inline const CalDet<T>& CalDet<T>::operator*=(const T& val)
+template <class OutputIt>
+inline OutputIt CalDet<T>::copyTo(OutputIt out) const
 {
-  for (auto& cal : mData) {
-    cal *= val;
+  for (const auto& cal : mData) {
+    out = std::copy(cal.getData().begin(), cal.getData().end(), out);
   }
-  return *this;
+  return out;
 }
 
 //______________________________________________________________________________
 template <class T>
-inline const CalDet<T>& CalDet<T>::operator/=(const T& val)
+template <class InputIt>
+inline InputIt CalDet<T>::copyFrom(InputIt in)
 {
   for (auto& cal : mData) {
-    cal /= val;
+    auto& data = cal.getData();
+    for (auto it = data.begin(); it != data.end(); ++it, ++in) {
+      *it = *in;
+    }
   }
-  return *this;
+  return in;
 }
 
 // ===| Full detector initialisation |==========================================
@@ -38,6 +38,21 @@ namespace TPC
 class Mapper
 {
  public:
+  static constexpr unsigned short NPadsInSector{ 14560 }; ///< number of pads in one sector
+  static constexpr unsigned short NRegions{ 10 };         ///< number of pad regions (CRUs) in one sector
+
+  /// Per pad information of one sector in a structure of arrays, indexed by the global pad number in the sector.
+  /// The table is filled once when the mapping is loaded and is meant for lookups in per digit loops,
+  /// where it replaces the modulo arithmetic and the search over the pad regions.
+  struct PadInfoTable {
+    std::array<unsigned char, NPadsInSector> region; ///< pad region, the CRU is sector * NRegions + region
+    std::array<unsigned char, NPadsInSector> row;    ///< global pad row in sector
+    std::array<unsigned char, NPadsInSector> pad;    ///< pad number in the row
+    std::array<unsigned char, NPadsInSector> fec;    ///< FEC number in sector
+    std::array<float, NPadsInSector> localX;         ///< local x of the pad centre
+    std::array<float, NPadsInSector> localY;         ///< local y of the pad centre
+  };
+
   static Mapper& instance(const std::string mappingDir = "")
   {
     static Mapper mapper(mappingDir);
@@ -59,21 +74,23 @@ class Mapper
   /// \param sec sector
   /// \param globalPad global pad number in sector
   /// \return global cru number
-  int getCRU(const Sector& sec, GlobalPadNumber globalPad)
+  int getCRU(const Sector& sec, GlobalPadNumber globalPad) const
   {
-    const auto row = mMapGlobalPadToPadPos[globalPad].getRow();
-    const auto nCRUPerSector = mMapPadRegionInfo.size();
-    int region = 0;
-    for (size_t i = 1; i < nCRUPerSector; ++i) {
-      if (row < mMapPadRegionInfo[i].getGlobalRowOffset()) {
-        break;
-      }
-      ++region;
-    }
-
-    return int(sec * nCRUPerSector + region);
+    return int(sec * NRegions + mMapGlobalPadInfo.region[globalPad]);
   }
 
+  // ===| unchecked per pad lookups, globalPad must be smaller than getPadsInSector() |===
+  const PadInfoTable& getPadInfoTable() const { return mMapGlobalPadInfo; }
+  int getRegion(GlobalPadNumber globalPad) const { return mMapGlobalPadInfo.region[globalPad]; }
+  int getPadRow(GlobalPadNumber globalPad) const { return mMapGlobalPadInfo.row[globalPad]; }
+  int getPadInRow(GlobalPadNumber globalPad) const { return mMapGlobalPadInfo.pad[globalPad]; }
+  int getFECInSector(GlobalPadNumber globalPad) const { return mMapGlobalPadInfo.fec[globalPad]; }
+  float getPadCentreX(GlobalPadNumber globalPad) const { return mMapGlobalPadInfo.localX[globalPad]; }
+  float getPadCentreY(GlobalPadNumber globalPad) const { return mMapGlobalPadInfo.localY[globalPad]; }
+
+  /// \return pad region of a global pad row in the sector
+  int getRegionOfRow(int row) const { return mMapRegionPerRow[row]; }
+
   /// return the global pad number in ROC for PadROCPos (ROC, row, pad)
   /// \return global pad number of PadROCPos (ROC, row, pad)
   /// \todo add check for row and pad limits
@@ -449,6 +466,7 @@ class Mapper
 
   void load(const std::string& mappingDir);
   void initPadRegionsAndPartitions();
+  void initPadInfoTable();
   bool readMappingFile(std::string file);
 
   static constexpr unsigned short mPadsInIROC{ 5280 };        ///< number of pads in IROC
@@ -456,7 +474,7 @@ class Mapper
   static constexpr unsigned short mPadsInOROC2{ 3200 };       ///< number of pads in OROC2
   static constexpr unsigned short mPadsInOROC3{ 3200 };       ///< number of pads in OROC3
   static constexpr unsigned short mPadsInOROC{ 9280 };        ///< number of pads in OROC
-  static constexpr unsigned short mPadsInSector{ 14560 };     ///< number of pads in one sector
+  static constexpr unsigned short mPadsInSector{ NPadsInSector }; ///< number of pads in one sector
   static constexpr unsigned short mNumberOfPadRowsIROC{ 63 }; ///< number of pad rows in IROC
   static constexpr unsigned short mNumberOfPadRowsOROC{ 89 }; ///< number of pad rows in IROC
 
@@ -520,6 +538,7 @@ class Mapper
     mMapPadPosGlobalPad;                     ///< mapping pad position to global pad number, most probably needs to be changed to speed up
   std::vector<int> mMapFECIDGlobalPad;       ///< mapping sector global FEC id to global pad number
   std::vector<FECInfo> mMapGlobalPadFECInfo; ///< map global pad number to FEC info
+  PadInfoTable mMapGlobalPadInfo;            ///< per pad information in structure of arrays
 
   // ===| Pad region and partition mappings |===================================
   std::array<PadRegionInfo, 10> mMapPadRegionInfo; ///< pad region information
@@ -530,6 +549,8 @@ class Mapper
     mMapNumberOfPadsPerRow; ///< number of pads per global pad row in sector
   std::array<int, mNumberOfPadRowsIROC + mNumberOfPadRowsOROC>
     mMapPadOffsetPerRow; ///< global pad number offset in a row
+  std::array<unsigned char, mNumberOfPadRowsIROC + mNumberOfPadRowsOROC>
+    mMapRegionPerRow; ///< pad region of a global pad row in sector
 };
 
 // ===| inline functions |======================================================
@@ -30,11 +30,14 @@
 #include <boost/format.hpp>
 
 #include "Vc/Vc"
+#include <algorithm>
 #include <array>
 
 #include "TF1.h"
 #include "TRandom.h"
 
+#include "MathUtils/RandomStream.h"
+
 using float_v = Vc::float_v;
 
 namespace o2
@@ -103,6 +106,25 @@ class RandomRing
     return value;
   }
 
+  /// fill an array with the next random values
+  /// This function copies the next n values from the ring buffer
+  /// in contiguous chunks and increases the buffer position by n
+  /// @param [out] values array to be filled, must hold at least n values
+  /// @param [in] n number of random values
+  void getNextValues(float* values, size_t n)
+  {
+    while (n > 0) {
+      const size_t chunk = std::min(n, mRandomNumbers.size() - mRingPosition);
+      std::copy_n(&mRandomNumbers[mRingPosition], chunk, values);
+      values += chunk;
+      n -= chunk;
+      mRingPosition += chunk;
+      if (mRingPosition >= mRandomNumbers.size()) {
+        mRingPosition = 0;
+      }
+    }
+  }
+
   /// position in the ring buffer
   /// @return position in the ring buffer
   unsigned int getRingPosition() const { return mRingPosition; }
@@ -141,22 +163,21 @@ inline RandomRing<N>::RandomRing(TF1& function)
 template <size_t N>
 inline void RandomRing<N>::initialize(const RandomType randomType)
 {
-
-  for (auto& v : mRandomNumbers) {
-    // TODO: configurable mean and sigma
-    switch (randomType) {
-      case RandomType::Gaus: {
-        v = gRandom->Gaus(0, 1);
-        break;
-      }
-      case RandomType::Flat: {
-        v = gRandom->Rndm();
-        break;
-      }
-      default: {
-        v = 0;
-        break;
-      }
+  // the numbers are drawn in bulk from a stream following the seed of gRandom
+  o2::math_utils::RandomStream stream(gRandom->Integer(0xffffffff));
+  // TODO: configurable mean and sigma
+  switch (randomType) {
+    case RandomType::Gaus: {
+      stream.fillGaus(mRandomNumbers.data(), N);
+      break;
+    }
+    case RandomType::Flat: {
+      stream.fillUniform(mRandomNumbers.data(), N);
+      break;
+    }
+    default: {
+      mRandomNumbers.fill(0);
+      break;
     }
   }
 }
@@ -165,9 +186,11 @@ inline void RandomRing<N>::initialize(const RandomType randomType)
 template <size_t N>
 inline void RandomRing<N>::initialize(TF1& function)
 {
-  for (auto& v : mRandomNumbers) {
-    v = function.GetRandom();
-  }
+  // inverse cumulative distribution of the function instead of N calls of TF1::GetRandom
+  o2::math_utils::InverseCDFTable table([&function](double x) { return function.Eval(x); }, function.GetXmin(),
+                                        function.GetXmax());
+  o2::math_utils::RandomStream stream(gRandom->Integer(0xffffffff));
+  stream.fill(table, mRandomNumbers.data(), N);
 }
 
 } // namespace TPC
@@ -203,6 +203,7 @@ void Mapper::load(const std::string& mappingDir)
   readMappingFile(inputDir+"/TABLE-OROC3.txt");
 
   initPadRegionsAndPartitions();
+  initPadInfoTable();
 }
 
 void Mapper::initPadRegionsAndPartitions()
@@ -232,6 +233,7 @@ void Mapper::initPadRegionsAndPartitions()
   for (const auto& reg : mMapPadRegionInfo) {
     for (int row=0; row<reg.getNumberOfPadRows(); ++row) {
       mMapPadOffsetPerRow[globalRow] = padOffset;
+      mMapRegionPerRow[globalRow] = reg.getRegion();
       padsInRow = reg.getPadsInRowRegion(row);
       mMapNumberOfPadsPerRow[globalRow] = padsInRow;
       ++globalRow;
@@ -240,5 +242,19 @@ void Mapper::initPadRegionsAndPartitions()
   }
 }
 
+void Mapper::initPadInfoTable()
+{
+  for (GlobalPadNumber globalPad = 0; globalPad < mPadsInSector; ++globalPad) {
+    const PadPos& pos = mMapGlobalPadToPadPos[globalPad];
+    const PadCentre& centre = mMapGlobalPadCentre[globalPad];
+    mMapGlobalPadInfo.region[globalPad] = mMapRegionPerRow[pos.getRow()];
+    mMapGlobalPadInfo.row[globalPad]    = pos.getRow();
+    mMapGlobalPadInfo.pad[globalPad]    = pos.getPad();
+    mMapGlobalPadInfo.fec[globalPad]    = mMapGlobalPadFECInfo[globalPad].getIndex();
+    mMapGlobalPadInfo.localX[globalPad] = centre.X();
+    mMapGlobalPadInfo.localY[globalPad] = centre.Y();
+  }
+}
+
 }
 }
@@ -307,5 +307,72 @@ BOOST_AUTO_TEST_CASE(CalDet_Arithmetics)
   BOOST_CHECK_EQUAL(isEqual, true);
 }
 
+BOOST_AUTO_TEST_CASE(CalDet_MaskedTransform)
+{
+  CalPad pad(PadSubset::ROC);
+  CalPad pad2(PadSubset::ROC);
+  CalDet<int> mask(PadSubset::ROC);
+
+  int iter = 0;
+  for (auto& calArray : pad.getData()) {
+    for (auto& value : calArray.getData()) {
+      value = iter++;
+    }
+  }
+  pad2 += 2.f;
+
+  // mask every second channel
+  iter = 0;
+  for (auto& calArray : mask.getData()) {
+    for (auto& value : calArray.getData()) {
+      value = iter++ % 2;
+    }
+  }
+
+  CalPad padCmp = pad;
+  padCmp.transform(pad2, mask, std::multiplies<float>());
+
+  bool isEqual = true;
+  for (size_t iarray = 0; iarray < pad.getData().size(); ++iarray) {
+    const auto& values = pad.getCalArray(iarray).getData();
+    const auto& valuesCmp = padCmp.getCalArray(iarray).getData();
+    const auto& valuesMask = mask.getCalArray(iarray).getData();
+    for (size_t i = 0; i < values.size(); ++i) {
+      isEqual &= isEqualAbs(valuesCmp[i], valuesMask[i] ? values[i] * 2.f : values[i]);
+    }
+  }
+  BOOST_CHECK_EQUAL(isEqual, true);
+}
+
+BOOST_AUTO_TEST_CASE(CalDet_FlatCopy)
+{
+  auto& mapper = Mapper::instance();
+  const auto numberOfPads = mapper.getPadsInSector() * 36;
+
+  CalPad pad(PadSubset::Region);
+  int iter = 0;
+  for (auto& calArray : pad.getData()) {
+    for (auto& value : calArray.getData()) {
+      value = iter++;
+    }
+  }
+  BOOST_CHECK_EQUAL(pad.getNumberOfChannels(), numberOfPads);
+
+  // copy to one flat buffer and back
+  std::vector<float> buffer(pad.getNumberOfChannels());
+  BOOST_CHECK(pad.copyTo(buffer.begin()) == buffer.end());
+
+  CalPad padRead(PadSubset::Region);
+  BOOST_CHECK(padRead.copyFrom(buffer.cbegin()) == buffer.cend());
+
+  float sum = 0.f;
+  for (auto const& arrays : boost::combine(pad.getData(), padRead.getData())) {
+    for (auto const& val : boost::combine(arrays.get<0>().getData(), arrays.get<1>().getData())) {
+      sum += (val.get<0>() - val.get<1>());
+    }
+  }
+  BOOST_CHECK_CLOSE(sum, 0.f, 1.E-12);
+}
+
 } // TPC
 } // AliceO2
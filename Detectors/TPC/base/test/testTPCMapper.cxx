@@ -129,5 +129,34 @@ namespace TPC {
       }
     }
   }
+
+  /// \brief Test the per pad lookup table
+  /// The structure of arrays must agree with the pad position, pad centre and FEC mappings
+  /// and the CRU lookup with the search over the pad regions
+  BOOST_AUTO_TEST_CASE(Mapper_padInfo_test)
+  {
+    const Mapper& mapper = Mapper::instance();
+    const auto& regions = mapper.getMapPadRegionInfo();
+    for (GlobalPadNumber globalPad = 0; globalPad < mapper.getPadsInSector(); ++globalPad) {
+      const PadPos& pos = mapper.padPos(globalPad);
+      const PadCentre& centre = mapper.padCentre(globalPad);
+      BOOST_CHECK_EQUAL(mapper.getPadRow(globalPad), int(pos.getRow()));
+      BOOST_CHECK_EQUAL(mapper.getPadInRow(globalPad), int(pos.getPad()));
+      BOOST_CHECK_EQUAL(mapper.getFECInSector(globalPad), int(mapper.fecInfo(globalPad).getIndex()));
+      BOOST_CHECK_EQUAL(mapper.getPadCentreX(globalPad), centre.X());
+      BOOST_CHECK_EQUAL(mapper.getPadCentreY(globalPad), centre.Y());
+
+      int region = 0;
+      for (size_t i = 1; i < regions.size(); ++i) {
+        if (pos.getRow() < regions[i].getGlobalRowOffset()) {
+          break;
+        }
+        ++region;
+      }
+      BOOST_CHECK_EQUAL(mapper.getRegion(globalPad), region);
+      BOOST_CHECK_EQUAL(mapper.getRegionOfRow(pos.getRow()), region);
+      BOOST_CHECK_EQUAL(mapper.getCRU(Sector(5), globalPad), 5 * Mapper::NRegions + region);
+    }
+  }
 }
 }
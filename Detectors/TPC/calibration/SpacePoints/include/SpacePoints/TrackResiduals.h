@@ -101,6 +101,11 @@ class TrackResiduals
   // -------------------------------------- settings --------------------------------------------------
   /// Sets a flag to print the memory usage at certain points in the program for performance studies.
   void setPrintMemoryUsage() { mPrintMem = true; }
+  /// Sets the number of threads used to process the sectors in parallel.
+  /// \param nThreads Number of worker threads, with 1 the sectors are processed sequentially
+  void setNThreads(int nThreads) { mNThreads = nThreads > 1 ? nThreads : 1; }
+  /// \return Number of threads used to process the sectors
+  int getNThreads() const { return mNThreads; }
   /// Sets the kernel type used for smoothing.
   /// \param type Kernel type (Epanechnikov / Gaussian)
   /// \param bwX Bin width in X
@@ -114,6 +119,8 @@ class TrackResiduals
   // -------------------------------------- steering functions --------------------------------------------------
 
   /// Steers the processing of the residuals for all sectors.
+  /// With more than one thread configured the sectors are distributed over the worker threads,
+  /// the debug output is written afterwards in increasing sector order.
   void processResiduals();
 
   /// Processes residuals for given sector.
@@ -156,10 +163,16 @@ class TrackResiduals
   float fitPoly1Robust(std::vector<float>& x, std::vector<float>& y, std::array<float, 2>& res, std::array<float, 3>& err, float cutLTM) const;
 
   /// Calculates the median of the absolute deviations to the median of the data.
-  /// The input vector is copied such that the original vector is not modified.
-  /// \param data Input data vector
+  /// The input data is copied into a per-thread buffer such that the original data is not modified.
+  /// \param data Pointer to the first input value
+  /// \param nPoints Number of input values
   /// \return Median of absolute deviations to the median
-  float getMAD2Sigma(std::vector<float> data) const;
+  float getMAD2Sigma(const float* data, int nPoints) const;
+
+  /// Calculates the median of the absolute deviations to the median of the data.
+  /// \param data Input data vector, which is not modified
+  /// \return Median of absolute deviations to the median
+  float getMAD2Sigma(const std::vector<float>& data) const { return getMAD2Sigma(data.data(), data.size()); }
 
   /// Fits a straight line to given x and y minimizing the absolute deviations y(x|a, b) = a + b * x.
   /// Not all data points need to be considered, but only a fraction of the input is used to perform the fit.
@@ -352,6 +365,11 @@ class TrackResiduals
   void closeOutputFile();
 
  private:
+  /// Processes the residuals for the given sector without writing the debug output.
+  /// \param iSec Sector to process
+  /// \return True if the results of the sector should be dumped
+  bool fillSectorResiduals(int iSec);
+
   // some constants
   static constexpr float sFloatEps{ 1.e-7f }; ///< float epsilon for robust linear fitting
   static constexpr float sDeadZone{ 1.5f };   ///< dead zone for TPC in between sectors
@@ -366,6 +384,7 @@ class TrackResiduals
   // status flags
   bool mIsInitialized{}; ///< initialize only once
   bool mPrintMem{};      ///< turn on to print memory usage at certain points
+  int mNThreads{ 1 };    ///< number of threads for the processing of the sectors
   // binning
   int mNXBins{};                           ///< number of bins in radial direction
   int mNY2XBins{ 15 };                     ///< number of y/x bins per sector
@@ -404,7 +423,6 @@ class TrackResiduals
   std::array<int, VoxDim> mStepKern{};                             ///< N bins to consider with given kernel settings
   std::array<float, VoxDim> mKernelScaleEdge{};                    ///< optional scaling factors for kernel width on the edge
   std::array<float, VoxDim> mKernelWInv{};                         ///< inverse kernel width in bins
-  std::array<double, ResDim * sMaxSmtDim> mLastSmoothingRes{};     ///< results of last smoothing operation
   // (intermediate) results
   std::array<std::bitset<param::NPadRows>, SECTORSPERSIDE * SIDES> mXBinsIgnore{};          ///< flags which X bins to ignore
   std::array<std::array<float, param::NPadRows>, SECTORSPERSIDE * SIDES> mValidFracXBins{}; ///< for each sector for each X-bin the fraction of validated voxels
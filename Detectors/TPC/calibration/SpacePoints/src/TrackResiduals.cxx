@@ -19,14 +19,19 @@
 #include "SpacePoints/TrackResiduals.h"
 #include "CommonConstants/MathConstants.h"
 #include "MathUtils/MathBase.h"
+#include "MathUtils/RobustStatistics.h"
 
 #include "TMatrixDSym.h"
 #include "TDecompChol.h"
 #include "TVectorD.h"
+#include "TROOT.h"
 
 #include <cmath>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 // for debugging
 #include "TStopwatch.h"
@@ -222,80 +227,126 @@ void TrackResiduals::processResiduals()
   if (!mIsInitialized) {
     init();
   }
-  for (int iSec = 0; iSec < SECTORSPERSIDE * SIDES; ++iSec) {
-    processSectorResiduals(iSec);
+  const int nSectors = SECTORSPERSIDE * SIDES;
+  if (mNThreads <= 1) {
+    for (int iSec = 0; iSec < nSectors; ++iSec) {
+      processSectorResiduals(iSec);
+    }
+    return;
+  }
+  // the sectors are independent of each other, each worker takes the next unprocessed sector
+  ROOT::EnableThreadSafety();
+  std::array<bool, SECTORSPERSIDE * SIDES> doDump{};
+  std::atomic<int> nextSector{ 0 };
+  auto worker = [this, &doDump, &nextSector, nSectors]() {
+    for (int iSec = nextSector++; iSec < nSectors; iSec = nextSector++) {
+      doDump[iSec] = fillSectorResiduals(iSec);
+    }
+  };
+  std::vector<std::thread> threads;
+  const int nThreads = std::min(mNThreads, nSectors);
+  for (int i = 0; i < nThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // the debug tree is shared, fill it sequentially in the same order as without threads
+  for (int iSec = 0; iSec < nSectors; ++iSec) {
+    if (doDump[iSec]) {
+      dumpResults(iSec);
+    }
   }
 }
 
 //______________________________________________________________________________
 void TrackResiduals::processSectorResiduals(int iSec)
+{
+  if (fillSectorResiduals(iSec)) {
+    dumpResults(iSec);
+  }
+}
+
+//______________________________________________________________________________
+bool TrackResiduals::fillSectorResiduals(int iSec)
 {
   if (iSec < 0 || iSec > 35) {
     LOG(error) << "wrong sector: " << iSec;
-    return;
+    return false;
   }
   LOG(info) << "processing sector residuals for sector " << iSec;
   if (!mIsInitialized) {
     init();
   }
-  // open file and retrieve data tree (only local files are supported at the moment)
-  std::string filename = mLocalResFileName + std::to_string(iSec) + ".root";
-  std::unique_ptr<TFile> flin = std::make_unique<TFile>(filename.c_str());
-  if (!flin || flin->IsZombie()) {
-    LOG(error) << "failed to open " << filename.c_str();
-    return;
-  }
-  std::string treename = "ts" + std::to_string(iSec);
-  std::unique_ptr<TTree> tree((TTree*)flin->Get(treename.c_str()));
-  if (!tree) {
-    LOG(error) << "did not find the data tree " << treename.c_str();
-    return;
-  }
-  AliTPCDcalibRes::dts_t trkRes;
-  auto* pTrkRes = &trkRes;
-  tree->SetBranchAddress("dts", &pTrkRes);
-  auto nPoints = tree->GetEntries();
-  if (!nPoints) {
-    LOG(warning) << "no entries found for sector " << iSec;
-    flin->Close();
-    return;
-  }
-  if (nPoints > mMaxPointsPerSector) {
-    nPoints = mMaxPointsPerSector;
-  }
-  // initialize container holding results
-  initResultsContainer(iSec);
-
-  LOG(info) << "extracted " << nPoints << " of unbinned data";
-
-  std::vector<bres_t>& secData = mVoxelResults[iSec];
 
   unsigned int nAccepted = 0;
+  std::vector<float> dyData;
+  std::vector<float> dzData;
+  std::vector<float> tgSlpData;
+  std::vector<unsigned short> binData;
+
+  {
+    // reading of the input is serialized, the processing below runs concurrently for different sectors
+    static std::mutex inputMutex;
+    std::lock_guard<std::mutex> lock(inputMutex);
+
+    // open file and retrieve data tree (only local files are supported at the moment)
+    std::string filename = mLocalResFileName + std::to_string(iSec) + ".root";
+    std::unique_ptr<TFile> flin = std::make_unique<TFile>(filename.c_str());
+    if (!flin || flin->IsZombie()) {
+      LOG(error) << "failed to open " << filename.c_str();
+      return false;
+    }
+    std::string treename = "ts" + std::to_string(iSec);
+    std::unique_ptr<TTree> tree((TTree*)flin->Get(treename.c_str()));
+    if (!tree) {
+      LOG(error) << "did not find the data tree " << treename.c_str();
+      return false;
+    }
+    AliTPCDcalibRes::dts_t trkRes;
+    auto* pTrkRes = &trkRes;
+    tree->SetBranchAddress("dts", &pTrkRes);
+    auto nPoints = tree->GetEntries();
+    if (!nPoints) {
+      LOG(warning) << "no entries found for sector " << iSec;
+      flin->Close();
+      return false;
+    }
+    if (nPoints > mMaxPointsPerSector) {
+      nPoints = mMaxPointsPerSector;
+    }
+    // initialize container holding results
+    initResultsContainer(iSec);
 
-  std::vector<float> dyData(nPoints);
-  std::vector<float> dzData(nPoints);
-  std::vector<float> tgSlpData(nPoints);
-  std::vector<unsigned short> binData(nPoints);
+    LOG(info) << "extracted " << nPoints << " of unbinned data";
 
-  if (mPrintMem) {
-    printMem();
-  }
+    dyData.resize(nPoints);
+    dzData.resize(nPoints);
+    tgSlpData.resize(nPoints);
+    binData.resize(nPoints);
 
-  // read input data into internal vectors
-  for (int i = 0; i < nPoints; ++i) {
-    tree->GetEntry(i);
-    if (fabs(trkRes.tgSlp) >= mMaxTgSlp) {
-      continue;
+    if (mPrintMem) {
+      printMem();
+    }
+
+    // read input data into internal vectors
+    for (int i = 0; i < nPoints; ++i) {
+      tree->GetEntry(i);
+      if (fabs(trkRes.tgSlp) >= mMaxTgSlp) {
+        continue;
+      }
+      dyData[nAccepted] = trkRes.dy;
+      dzData[nAccepted] = trkRes.dz;
+      tgSlpData[nAccepted] = trkRes.tgSlp;
+      binData[nAccepted] = getGlbVoxBin(trkRes.bvox[VoxX], trkRes.bvox[VoxF], trkRes.bvox[VoxZ]);
+      nAccepted++;
     }
-    dyData[nAccepted] = trkRes.dy;
-    dzData[nAccepted] = trkRes.dz;
-    tgSlpData[nAccepted] = trkRes.tgSlp;
-    binData[nAccepted] = getGlbVoxBin(trkRes.bvox[VoxX], trkRes.bvox[VoxF], trkRes.bvox[VoxZ]);
-    nAccepted++;
+
+    tree.release();
+    flin->Close();
   }
 
-  tree.release();
-  flin->Close();
+  std::vector<bres_t>& secData = mVoxelResults[iSec];
 
   if (mPrintMem) {
     printMem();
@@ -372,7 +423,7 @@ void TrackResiduals::processSectorResiduals(int iSec)
   LOG(info) << "number of validated X rows: " << nRowsOK;
   if (!nRowsOK) {
     LOG(warning) << "sector " << iSec << ": all X-bins disabled, abandon smoothing";
-    return;
+    return false;
   } else {
     smooth(iSec);
   }
@@ -422,7 +473,7 @@ void TrackResiduals::processSectorResiduals(int iSec)
       }
     }
   }
-  dumpResults(iSec);
+  return true;
 }
 
 //______________________________________________________________________________
@@ -436,8 +487,8 @@ void TrackResiduals::processVoxelResiduals(std::vector<float>& dy, std::vector<f
   }
   std::array<float, 7> zResults;
   resVox.flags = 0;
-  std::vector<size_t> indices(dz.size());
-  if (!o2::math_utils::math_base::LTMUnbinned(dz, indices, zResults, mLTMCut)) {
+  // dz is not needed afterwards and can be sorted in place
+  if (!o2::math_utils::robust_stats::ltm(gsl::span<float>(dz), zResults, mLTMCut)) {
     LOG(debug) << "failed trimming input array for voxel " << getGlbVoxBin(resVox.bvox);
     return;
   }
@@ -479,7 +530,8 @@ void TrackResiduals::processVoxelDispersions(std::vector<float>& tg, std::vector
   for (size_t i = nPoints; i--;) {
     dy[i] -= resVox.DS[ResY] - resVox.DS[ResX] * tg[i];
   }
-  resVox.D[ResD] = getMAD2Sigma(dy);
+  // dy is not needed afterwards and can be rearranged
+  resVox.D[ResD] = o2::math_utils::robust_stats::MADToSigma * o2::math_utils::robust_stats::mad(gsl::span<float>(dy));
   resVox.E[ResD] = resVox.D[ResD] / sqrt(2.f * nPoints); // a la gaussioan RMS error (very crude)
   resVox.flags |= DispDone;
 }
@@ -685,6 +737,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
   // cache
   // \todo maybe a 1-D cache would be more efficient?
   std::array<std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>, ResDim> cmat;
+  std::array<double, ResDim * sMaxSmtDim> smoothingRes; // local such that sectors can be smoothed concurrently
   int maxNeighb = 10 * 10 * 10;
   std::vector<bres_t*> currVox;
   currVox.reserve(maxNeighb);
@@ -699,7 +752,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
   std::array<int, VoxDim> trial{ 0 };
 
   while (true) {
-    std::fill(mLastSmoothingRes.begin(), mLastSmoothingRes.end(), 0);
+    std::fill(smoothingRes.begin(), smoothingRes.end(), 0);
     memset(&cmat[0][0], 0, sizeof(cmat));
 
     int nbOK = 0; // accounted neighbours
@@ -885,7 +938,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
           wi /= (voxNb->E[iDim] * voxNb->E[iDim]);
         }
         std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-        double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+        double* rhsD = &smoothingRes[iDim * sMaxSmtDim];
         unsigned short iMat = 0;
         unsigned short iRhs = 0;
         // linear part
@@ -951,7 +1004,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
       }
       matrix.Zero(); // reset matrix
       std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-      double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+      double* rhsD = &smoothingRes[iDim * sMaxSmtDim];
       short iMat = -1;
       short iRhs = -1;
       short row = -1;
@@ -1053,13 +1106,17 @@ float TrackResiduals::fitPoly1Robust(std::vector<float>& x, std::vector<float>&
     return -1;
   }
   std::array<float, 7> yResults;
-  std::vector<size_t> indY(nPoints);
-  if (!o2::math_utils::math_base::LTMUnbinned(y, indY, yResults, cutLTM)) {
+  // scratch buffers are kept per thread to avoid allocations for every voxel
+  static thread_local std::vector<float> ycm;
+  static thread_local std::vector<size_t> indices;
+  indices.resize(nPoints);
+  // rearrange used events in increasing order
+  o2::math_utils::math_base::SortData(y, indices);
+  o2::math_utils::math_base::Reorder(y, indices);
+  o2::math_utils::math_base::Reorder(x, indices);
+  if (!o2::math_utils::robust_stats::ltmSorted(gsl::span<const float>(y), yResults, cutLTM)) {
     return -1;
   }
-  // rearrange used events in increasing order
-  o2::math_utils::math_base::Reorder(y, indY);
-  o2::math_utils::math_base::Reorder(x, indY);
   //
   // 1st fit to get crude slope
   int nPointsUsed = std::lrint(yResults[0]);
@@ -1068,20 +1125,20 @@ float TrackResiduals::fitPoly1Robust(std::vector<float>& x, std::vector<float>&
   float a, b;
   medFit(nPointsUsed, vecOffset, x, y, a, b, err);
   //
-  std::vector<float> ycm(nPoints);
+  ycm.resize(nPoints);
   for (size_t i = nPoints; i-- > 0;) {
     ycm[i] = y[i] - (a + b * x[i]);
   }
-  std::vector<size_t> indices(nPoints);
   o2::math_utils::math_base::SortData(ycm, indices);
   o2::math_utils::math_base::Reorder(ycm, indices);
   o2::math_utils::math_base::Reorder(y, indices);
   o2::math_utils::math_base::Reorder(x, indices);
   //
   // robust estimate of sigma after crude slope correction
-  float sigMAD = getMAD2Sigma({ ycm.begin() + vecOffset, ycm.begin() + vecOffset + nPointsUsed });
+  // ycm is sorted, such that the MAD of the selected range is found without copy
+  float sigMAD = nPointsUsed < 2 ? 0.f : o2::math_utils::robust_stats::MADToSigma * o2::math_utils::robust_stats::madSorted(gsl::span<const float>(&ycm[vecOffset], nPointsUsed));
   // find LTM estimate matching to sigMAD, keaping at least given fraction
-  if (!o2::math_utils::math_base::LTMUnbinnedSig(ycm, indY, yResults, mMinFracLTM, sigMAD, true)) {
+  if (!o2::math_utils::robust_stats::ltmSigSorted(gsl::span<const float>(ycm), yResults, mMinFracLTM, sigMAD)) {
     return -1;
   }
   // final fit
@@ -1166,7 +1223,8 @@ float TrackResiduals::roFunc(int nPoints, int offset, const std::vector<float>&
 {
   // calculate sum(x_i * sgn(y_i - a - b * x_i)) for given b
   // see numberical recipies paragraph 15.7.3
-  std::vector<float> vecTmp(nPoints);
+  static thread_local std::vector<float> vecTmp;
+  vecTmp.resize(nPoints);
   float sum = 0.f;
   for (int j = nPoints; j-- > 0;) {
     vecTmp[j] = y[j + offset] - b * x[j + offset];
@@ -1187,15 +1245,7 @@ float TrackResiduals::roFunc(int nPoints, int offset, const std::vector<float>&
     }
     aa = (nPoints & 0x1) ? vecTmp[nPointsHalf] : .5f * (vecTmp[nPointsHalf - 1] + vecTmp[nPointsHalf]);
   } else {
-    std::vector<float>::iterator nth = vecTmp.begin() + vecTmp.size() / 2;
-    if (nPoints & 0x1) {
-      std::nth_element(vecTmp.begin(), nth, vecTmp.end());
-      aa = *nth;
-    } else {
-      std::nth_element(vecTmp.begin(), nth - 1, vecTmp.end());
-      std::nth_element(nth, nth, vecTmp.end());
-      aa = 0.5 * (*(nth - 1) + *(nth));
-    }
+    aa = o2::math_utils::robust_stats::median(gsl::span<float>(vecTmp));
     /*
     aa = (nPoints & 0x1) ? selectKthMin(nPointsHalf, vecTmp) : .5f * (selectKthMin(nPointsHalf - 1, vecTmp) + selectKthMin(nPointsHalf, vecTmp));
     */
@@ -1274,48 +1324,19 @@ float TrackResiduals::selectKthMin(const int k, std::vector<float>& data)
 }
 
 //___________________________________________________________________
-float TrackResiduals::getMAD2Sigma(std::vector<float> data) const
+float TrackResiduals::getMAD2Sigma(const float* input, int nPoints) const
 {
   // Sigma calculated from median absolute deviations
   // see: https://en.wikipedia.org/wiki/Median_absolute_deviation
-  // the data is passed by value (copied!), such that the original vector
-  // is not rearranged
+  // the data is copied into a per-thread buffer, such that the original
+  // data is not rearranged
 
-  int nPoints = data.size();
   if (nPoints < 2) {
     return 0;
   }
-
-  // calculate median of the input data
-  float medianOfData;
-  std::vector<float>::iterator nth = data.begin() + data.size() / 2;
-  if (nPoints & 0x1) {
-    std::nth_element(data.begin(), nth, data.end());
-    medianOfData = *nth;
-  } else {
-    std::nth_element(data.begin(), nth - 1, data.end());
-    std::nth_element(nth, nth, data.end());
-    medianOfData = .5f * (*(nth - 1) + (*nth));
-  }
-
-  // fill vector with absolute deviations to median
-  for (auto& entry : data) {
-    entry = fabs(entry - medianOfData);
-  }
-
-  // calculate median of abs deviations
-  float medianOfAbsDeviations;
-  if (nPoints & 0x1) {
-    std::nth_element(data.begin(), nth, data.end());
-    medianOfAbsDeviations = *nth;
-  } else {
-    std::nth_element(data.begin(), nth - 1, data.end());
-    std::nth_element(nth, nth, data.end());
-    medianOfAbsDeviations = .5f * (*(nth - 1) + (*nth));
-  }
-
-  float k = 1.4826f; // scale factor for normally distributed data
-  return k * medianOfAbsDeviations;
+  static thread_local std::vector<float> data;
+  data.assign(input, input + nPoints);
+  return o2::math_utils::robust_stats::MADToSigma * o2::math_utils::robust_stats::mad(gsl::span<float>(data));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 #include "Rtypes.h"
 
@@ -86,6 +87,15 @@ class CalibPedestal : public CalibRawBase
     mFirstTimeBin = first;
     mLastTimeBin = last;
   }
+  /// Process one event decoding the CRU raw readers on nThreads threads
+  ///
+  /// The ADC values are accumulated per thread in compact histograms without calling
+  /// updateROC. They are merged into the pedestal data before they could overflow and in
+  /// analyse(). Only PadSubset::ROC is supported.
+  ///
+  /// \param nThreads number of decoding threads
+  ProcessStatus processEventParallel(size_t nThreads);
+
   /// Analyse the buffered adc values and calculate noise and pedestal
   void analyse();
 
@@ -118,7 +128,14 @@ class CalibPedestal : public CalibRawBase
   CalPad mPedestal;               ///< CalDet object with pedestal information
   CalPad mNoise;                  ///< CalDet object with noise
 
+  /// ADC data of one thread of the parallel processing
+  struct ADCAccumulator {
+    std::vector<std::vector<uint16_t>> histograms; ///< per ROC, with the same binning as mADCdata
+    size_t entries = 0;                            ///< upper limit of the entries in a single bin
+  };
+
   std::vector<std::unique_ptr<vectorType>> mADCdata; //!< ADC data to calculate noise and pedestal
+  std::vector<ADCAccumulator> mAccumulators;         //!< per thread ADC data of the parallel processing
 
   /// return the value vector for a readout chamber
   ///
@@ -126,6 +143,12 @@ class CalibPedestal : public CalibRawBase
   /// \param create if to create the vector if it does not exist
   vectorType* getVector(ROC roc, bool create = kFALSE);
 
+  /// fill the ADC values of one CRU raw reader into an accumulator
+  void fillAccumulator(ADCAccumulator& accumulator, const RawReaderCRU& reader) const;
+
+  /// add the accumulated ADC values to mADCdata and reset the accumulator
+  void mergeAccumulator(ADCAccumulator& accumulator);
+
   /// dummy reset
   void resetEvent() final {}
 };
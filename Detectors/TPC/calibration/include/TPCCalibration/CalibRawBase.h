@@ -17,6 +17,9 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 
 #include "TString.h"
 #include "Rtypes.h"
@@ -125,10 +128,22 @@ class CalibRawBase
   /// Debug level
   int getDebugLevel() const { return mDebugLevel; }
 
+  /// number of CRU type raw readers
+  size_t getNumberOfRawReadersCRU() const { return mRawReadersCRU.size(); }
+
  protected:
   const Mapper& mMapper; //!< TPC mapper
   int mDebugLevel;       //!< debug level
 
+  /// Process one event using RawReaderCRU, decoding the readers on up to nThreads threads
+  ///
+  /// The update functions are not called. Instead, once its links are processed, every
+  /// reader is passed to process(thread, reader), where thread is the index of the
+  /// thread in [0, nThreads). process must only modify state private to that thread.
+  /// endReader() is not called.
+  template <typename Processor>
+  ProcessStatus processEventRawReaderCRUParallel(size_t nThreads, Processor&& process);
+
  private:
   size_t mNevents;            //!< number of processed events
   int mTimeBinsPerCall;       //!< number of time bins to process in processEvent
@@ -454,6 +469,67 @@ inline CalibRawBase::ProcessStatus CalibRawBase::processEventRawReaderCRU(int st
   return status;
 }
 
+//______________________________________________________________________________
+template <typename Processor>
+inline CalibRawBase::ProcessStatus CalibRawBase::processEventRawReaderCRUParallel(size_t nThreads, Processor&& process)
+{
+  if (!mRawReadersCRU.size())
+    return ProcessStatus::NoReaders;
+  resetEvent();
+
+  nThreads = std::max(size_t(1), std::min(nThreads, mRawReadersCRU.size()));
+
+  // the readers are handed out one by one, so that a slow reader does not hold back the others
+  std::atomic<size_t> nextReader{ 0 };
+  std::vector<size_t> processedTimeBins(nThreads, 0);
+  std::vector<std::exception_ptr> errors(nThreads);
+
+  auto worker = [this, &nextReader, &processedTimeBins, &errors, &process](size_t thread) {
+    try {
+      for (size_t ireader = nextReader++; ireader < mRawReadersCRU.size(); ireader = nextReader++) {
+        auto reader = mRawReadersCRU[ireader].get();
+        reader->processLinks();
+        for (const auto& pair : reader->getADCMap()) {
+          processedTimeBins[thread] = std::max(processedTimeBins[thread], pair.second.size());
+        }
+        process(thread, *reader);
+        reader->clearMap();
+      }
+    } catch (...) {
+      errors[thread] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t thread = 1; thread < nThreads; ++thread) {
+    threads.emplace_back(worker, thread);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  mProcessedTimeBins = *std::max_element(processedTimeBins.begin(), processedTimeBins.end());
+  LOG(INFO) << "Processed " << mRawReadersCRU.size() << " RawReaders on " << nThreads << " threads, found time bins: " << mProcessedTimeBins;
+
+  // set status, as in processEventRawReaderCRU the CRU readers do not advance the event number
+  ProcessStatus status = ProcessStatus::Ok;
+  if (mProcessedTimeBins == 0) {
+    return ProcessStatus::NoMoreData;
+  } else if (mPresentEventNumber == 0) {
+    status = ProcessStatus::LastEvent;
+  }
+
+  endEvent();
+  ++mNevents;
+  return status;
+}
+
 } // namespace TPC
 
 } // namespace o2
@@ -11,6 +11,9 @@
 /// \file   CalibPedestal.cxx
 /// \author Jens Wiechula, Jens.Wiechula@ikf.uni-frankfurt.de
 
+#include <limits>
+#include <mutex>
+
 #include "TFile.h"
 #include "TPCBase/ROC.h"
 #include "MathUtils/MathBase.h"
@@ -31,7 +34,8 @@ CalibPedestal::CalibPedestal(PadSubset padSubset)
     mStatisticsType(StatisticsType::GausFit),
     mPedestal("Pedestals", padSubset),
     mNoise("Noise", padSubset),
-    mADCdata()
+    mADCdata(),
+    mAccumulators()
 
 {
   mADCdata.resize(ROC::MaxROC);
@@ -74,9 +78,98 @@ CalibPedestal::vectorType* CalibPedestal::getVector(ROC roc, bool create /*=kFAL
   return vec;
 }
 
+//______________________________________________________________________________
+CalibRawBase::ProcessStatus CalibPedestal::processEventParallel(size_t nThreads)
+{
+  nThreads = std::max(nThreads, size_t(1));
+  if (mAccumulators.size() < nThreads) {
+    mAccumulators.resize(nThreads);
+  }
+
+  // the merging only happens when an accumulator is about to overflow
+  std::mutex mergeMutex;
+  auto process = [this, &mergeMutex](size_t thread, const RawReaderCRU& reader) {
+    auto& accumulator = mAccumulators[thread];
+    size_t timeBins = 0;
+    for (const auto& pair : reader.getADCMap()) {
+      timeBins = std::max(timeBins, pair.second.size());
+    }
+    if (accumulator.entries + timeBins > std::numeric_limits<uint16_t>::max()) {
+      std::lock_guard<std::mutex> lock(mergeMutex);
+      mergeAccumulator(accumulator);
+    }
+    accumulator.entries += timeBins;
+    fillAccumulator(accumulator, reader);
+  };
+
+  return processEventRawReaderCRUParallel(nThreads, process);
+}
+
+//______________________________________________________________________________
+void CalibPedestal::fillAccumulator(ADCAccumulator& accumulator, const RawReaderCRU& reader) const
+{
+  const CRU& cru = reader.getCRU();
+  const ROC roc = cru.roc();
+  const int rowOffset = mMapper.getPadRegionInfo(cru.region()).getGlobalRowOffset() -
+                        (cru.rocType() == RocType::OROC) * mMapper.getNumberOfRowsROC(0);
+
+  auto& histograms = accumulator.histograms;
+  if (histograms.empty()) {
+    histograms.resize(ROC::MaxROC);
+  }
+  auto& histogram = histograms[roc];
+  if (histogram.empty()) {
+    const size_t numberOfPads = (roc.rocType() == RocType::IROC) ? mMapper.getPadsInIROC() : mMapper.getPadsInOROC();
+    histogram.resize(numberOfPads * mNumberOfADCs);
+  }
+
+  for (const auto& pair : reader.getADCMap()) {
+    const auto& padPos = pair.first;
+    const auto& dataVector = pair.second;
+
+    // row is local in region (CRU)
+    const int row = padPos.getRow();
+    const int pad = padPos.getPad();
+    if (row == 255 || pad == 255)
+      continue;
+
+    const GlobalPadNumber padInROC = mMapper.getPadNumberInROC(PadROCPos(roc, row + rowOffset, pad));
+    uint16_t* padHistogram = histogram.data() + padInROC * mNumberOfADCs;
+
+    const int lastTimeBin = std::min(int(dataVector.size()) - 1, mLastTimeBin);
+    for (int timeBin = mFirstTimeBin; timeBin <= lastTimeBin; ++timeBin) {
+      const int bin = int(dataVector[timeBin]) - mADCMin;
+      if (bin >= 0 && bin < mNumberOfADCs) {
+        ++padHistogram[bin];
+      }
+    }
+  }
+}
+
+//______________________________________________________________________________
+void CalibPedestal::mergeAccumulator(ADCAccumulator& accumulator)
+{
+  ROC roc;
+  for (auto& histogram : accumulator.histograms) {
+    if (!histogram.empty()) {
+      vectorType& adcVec = *getVector(roc, kTRUE);
+      for (size_t bin = 0; bin < histogram.size(); ++bin) {
+        adcVec[bin] += histogram[bin];
+      }
+      std::fill(histogram.begin(), histogram.end(), 0);
+    }
+    ++roc;
+  }
+  accumulator.entries = 0;
+}
+
 //______________________________________________________________________________
 void CalibPedestal::analyse()
 {
+  for (auto& accumulator : mAccumulators) {
+    mergeAccumulator(accumulator);
+  }
+
   ROC roc;
 
   std::vector<float> fitValues;
@@ -130,6 +223,7 @@ void CalibPedestal::resetData()
     }
     vec->clear();
   }
+  mAccumulators.clear();
 }
 
 //______________________________________________________________________________
@@ -0,0 +1,158 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterNativeCTF.h
+/// \brief Compressed time frame (CTF) format and coder of the TPC native clusters
+#ifndef ALICEO2_TPC_CLUSTERNATIVECTF_H_
+#define ALICEO2_TPC_CLUSTERNATIVECTF_H_
+
+#include "DataFormatsTPC/Constants.h"
+#include <gsl/gsl>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2
+{
+namespace TPC
+{
+
+/// \struct CTFHeader
+/// Header of a compressed time frame of TPC native clusters.
+///
+/// A CTF consists of the header, the directory of the sectors (CTFSectorEntry) and the sector
+/// blocks. Every sector block starts with a CTFSectorHeader, followed by two streams per attribute,
+/// each made of a CTFStreamHeader, the frequency table of the rANS model, the rANS stream and the
+/// escaped values. All the parts start at 8 byte boundaries, the values are little endian, such
+/// that a CTF file can be memory mapped and the sectors decoded in place and independently.
+/// CTFs are stored one after the other in a file.
+struct CTFHeader {
+  static constexpr uint32_t sMagic = 0x46544354; // "TCTF"
+  static constexpr uint16_t sVersion = 1;
+
+  uint32_t magic = sMagic;
+  uint16_t version = sVersion;
+  uint16_t nSectors = 0; ///< number of entries of the sector directory
+  uint64_t size = 0;     ///< size of the CTF including this header
+  uint64_t nClusters = 0;
+};
+
+/// \struct CTFSectorEntry
+/// Entry of the sector directory of a CTF
+struct CTFSectorEntry {
+  uint16_t sector = 0;
+  uint16_t reserved = 0;
+  uint32_t nClusters = 0;
+  uint64_t offset = 0; ///< offset of the sector block from the start of the CTF
+  uint64_t size = 0;   ///< size of the sector block
+};
+
+/// \struct CTFSectorHeader
+/// Header of the block of a sector
+struct CTFSectorHeader {
+  static constexpr int sMaxAttributes = 8;
+
+  uint16_t sector = 0;
+  uint16_t nAttributes = 0;
+  uint32_t nClusters = 0;
+  uint8_t truncatedBits[sMaxAttributes] = { 0 }; ///< number of LSBs dropped for each attribute
+};
+
+/// \struct CTFStreamHeader
+/// Header of a stream of symbols. The values of an attribute are coded in two streams, the low
+/// byte and the remaining high bits, such that the frequency tables stay small.
+struct CTFStreamHeader {
+  enum TableFormat : uint8_t {
+    SparseTable, ///< pairs of uint16 symbol and frequency - 1
+    DenseTable   ///< uint16 frequencies of the symbols starting at firstSymbol, 0 for unused symbols
+  };
+
+  uint8_t scaleBits = 0;       ///< precision of the frequencies of the rANS model
+  uint8_t tableFormat = SparseTable;
+  uint16_t firstSymbol = 0;    ///< first symbol of a dense table
+  uint32_t nTableEntries = 0;  ///< number of uint16 pairs or values of the frequency table
+  uint32_t streamSize = 0;     ///< size of the rANS stream in bytes
+  uint32_t nEscapes = 0;       ///< number of uint32 values which do not fit the alphabet
+};
+
+static_assert(sizeof(CTFHeader) == 24, "inconsistent padding detected");
+static_assert(sizeof(CTFSectorEntry) == 24, "inconsistent padding detected");
+static_assert(sizeof(CTFSectorHeader) == 16, "inconsistent padding detected");
+static_assert(sizeof(CTFStreamHeader) == 16, "inconsistent padding detected");
+
+/// \class ClusterNativeCTFCoder
+/// \brief Coder of the TPC native clusters into compressed time frames
+///
+/// The input and output of the coder are the flat buffers of ClusterNativeBuffer blocks of the
+/// CLUSTERNATIVE messages, one buffer per sector. For every sector, each attribute of the clusters
+/// is coded in its own stream with an rANS model generated from the attribute values of the sector:
+/// the number of clusters of each pad row, the time difference to the previous cluster of the row,
+/// pad, sigmas, charges and flags. The clusters of a pad row are sorted by time and pad for coding,
+/// the order of the clusters within a pad row is not kept. The precision of the attributes can be
+/// truncated with a TruncatedPrecisionConverter, the coding is lossless otherwise. The sectors are
+/// coded and decoded in parallel.
+///
+/// Errors of the CTF format are reported with std::runtime_error exceptions.
+class ClusterNativeCTFCoder
+{
+ public:
+  constexpr static size_t NSectors = o2::TPC::Constants::MAXSECTOR;
+  enum Attribute : int {
+    NClusters, ///< number of clusters of the pad rows
+    TimeDelta, ///< packed time, difference to the previous cluster in the pad row
+    Pad,
+    SigmaTime,
+    SigmaPad,
+    QMax,
+    QTot,
+    Flags,
+    NAttributes
+  };
+  static_assert(NAttributes <= CTFSectorHeader::sMaxAttributes, "too many attributes for the CTF sector header");
+
+  ClusterNativeCTFCoder() = default;
+  ~ClusterNativeCTFCoder() = default;
+
+  /// Set the number of LSBs of an attribute dropped by the coding, the coding is lossy if not 0.
+  /// Only the time, pad, sigmas and charges can be truncated.
+  void setTruncatedBits(int attribute, uint8_t nBits);
+  uint8_t getTruncatedBits(int attribute) const { return mTruncatedBits[attribute]; }
+
+  /// Encode the clusters of one sector, given by a flat buffer of ClusterNativeBuffer blocks
+  /// \return number of encoded clusters, the sector block is appended to output
+  size_t encodeSector(int sector, gsl::span<const char> input, std::vector<char>& output) const;
+
+  /// Decode a sector block to a flat buffer of ClusterNativeBuffer blocks, one block for every pad row
+  /// with clusters, by increasing pad row
+  /// \return number of decoded clusters
+  size_t decodeSector(gsl::span<const char> block, std::vector<char>& output) const;
+
+  /// Encode the sectors of a time frame into one CTF, which is appended to ctf.
+  /// Sectors with an empty input are not part of the CTF.
+  /// \return number of encoded clusters
+  size_t encode(std::array<gsl::span<const char>, NSectors> const& inputs, std::vector<char>& ctf) const;
+
+  /// Decode all sectors of a CTF, the outputs of the sectors which are not part of the CTF are cleared
+  /// \return number of decoded clusters
+  size_t decode(gsl::span<const char> ctf, std::array<std::vector<char>, NSectors>& outputs) const;
+
+  /// Check the header and the sector directory of the CTF at the beginning of data
+  /// \return the size of the CTF, data can contain more than one CTF
+  static size_t checkCTF(gsl::span<const char> data);
+
+ private:
+  std::array<uint8_t, NAttributes> mTruncatedBits = { 0 };
+};
+
+} // namespace TPC
+} // namespace o2
+
+#endif // ALICEO2_TPC_CLUSTERNATIVECTF_H_
@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <memory>
+#include <cstring>
 
 #include "DataFormatsTPC/ClusterNative.h"
 #include "DataFormatsTPC/Constants.h"
@@ -38,12 +39,17 @@ public:
     }
   }
   void integrateCluster(int sector, int row, float pad, unsigned int charge) {
-    int ipad = ipad + 0.5;
+    int ipad = pad + 0.5;
     if (ipad < 0) ipad = 0;
     int maxPad = o2::TPC::Mapper::instance().getNumberOfPadsInRowSector(row);
     if (ipad >= maxPad) ipad = maxPad - 1;
     mIntegratedCurrents[sector][row][ipad] += charge;
   }
+  //Integrate the charges of all clusters of the index, the sectors are processed in parallel by nThreads threads.
+  //Every sector is integrated by one thread only, such that the threads never add to the same pads and no atomics are needed.
+  void integrateClusters(const ClusterNativeAccessFullTPC& clusters, int nThreads = 1);
+  //Currents of the pads of a row, nullptr if the row was not initialized
+  const unsigned long long int* getCurrents(int sector, int row) const { return mIntegratedCurrents[sector][row].get(); }
   void clear(); //Clear all currents to 0
   void reset(); //Free all allocated current buffers
 
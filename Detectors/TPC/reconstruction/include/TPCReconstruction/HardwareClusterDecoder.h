@@ -54,6 +54,10 @@ class MCTruthContainer;
 ///     }
 ///     decoder( {pointer, n}, outputAllocator, &mcIn, &mcOut);
 ///
+/// The output size is counted before the clusters are decoded into the allocated buffer, the sectors
+/// are decoded on setNThreads() threads. The clusters of each row are sorted in time with a radix sort,
+/// which moves the MC labels along.
+///
 /// FIXME: The class should be in principle stateless, but right now it has an instance of the
 /// integrator for the digittal currents.
 class HardwareClusterDecoder
@@ -81,12 +85,24 @@ public:
 
   /// @brief Sort clusters and MC labels in place
   /// ClusterNative defines the smaller-than relation used in the sorting, with time being the more significant
-  /// condition in the comparison.
+  /// condition in the comparison. Clusters with the same time and pad keep their order.
   static void sortClustersAndMC(ClusterNative* clusters, size_t nClusters,
-                                o2::dataformats::MCTruthContainer<o2::MCCompLabel> mcTruth);
+                                o2::dataformats::MCTruthContainer<o2::MCCompLabel>& mcTruth);
+
+  /// @brief Set the number of threads decoding the sectors
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
 
  private:
+  /// a page of the input, with the index of its input buffer
+  struct InputPage {
+    const ClusterHardwareContainer* container;
+    int input;
+  };
+
   std::unique_ptr<DigitalCurrentClusterIntegrator> mIntegrator;
+  std::vector<InputPage> mPages; ///< input pages grouped by sector, reused over the calls
+  int mNThreads = 1;             ///< number of threads decoding the sectors
 };
 
 } // namespace TPC
@@ -23,6 +23,8 @@
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include "SimulationDataFormat/MCCompLabel.h"
 
+#include <gsl/span>
+
 #include <vector>
 #include <utility>
 #include <memory>
@@ -80,6 +82,22 @@ class HwClusterer : public Clusterer
   void process(std::vector<o2::TPC::Digit> const& digits, MCLabelContainer const* mcDigitTruth) override;
   void process(std::vector<o2::TPC::Digit> const& digits, MCLabelContainer const* mcDigitTruth, bool clearContainerFirst);
 
+  /// Signal of one pad in one time bin, as decoded from the raw data
+  struct Signal {
+    unsigned short row; ///< global row number in the sector
+    unsigned short pad; ///< pad number in the row
+    int time;           ///< time bin
+    float charge;       ///< ADC value
+  };
+
+  /// Process signals directly from the raw data decoding, without creating digits
+  /// The signals have to be time ordered, they can be pushed in chunks of any size
+  /// (e.g. time bin by time bin), the clusters are written to the output as the
+  /// time bins roll over in the internal buffer. No MC labels are produced.
+  /// \param signals Time ordered signals
+  /// \param clearContainerFirst Clears the output container for clusters first, before processing
+  void processSignals(gsl::span<const Signal> signals, bool clearContainerFirst = false);
+
   /// Finish processing digits
   /// \param digits Container with TPC digits
   /// \param mcDigitTruth MC Digit Truth container
@@ -152,6 +170,23 @@ class HwClusterer : public Clusterer
   /// \param mcLabel        Vector with MClabel-counter-pairs
   void updateCluster(const Vc::uint_m selectionMask, int row, short centerPad, int centerTime, short dp, short dt, Vc::uint_v& qTot, Vc::int_v& pad, Vc::int_v& time, Vc::int_v& sigmaPad2, Vc::int_v& sigmaTime2, std::vector<std::unique_ptr<std::vector<std::pair<MCCompLabel, unsigned>>>>& mcLabels, Vc::uint_m splitMask = Vc::Mask<uint>(false));
 
+  /// Prepares the buffer for time bins until the given one and looks for clusters in the
+  /// time bins which are complete
+  /// \param timebin  New time bin
+  void advanceToTimebin(int timebin);
+
+  /// Adds a signal to the data buffer
+  /// \param row          Global row number
+  /// \param pad          Pad number
+  /// \param timebin      Time bin
+  /// \param cru          CRU of the pad, used for the pedestal subtraction
+  /// \param charge       ADC value
+  /// \param digitIndex   Index of the signal for the MC label lookup
+  void addToBuffer(unsigned short row, unsigned short pad, int timebin, int cru, float charge, int digitIndex);
+
+  /// Clears the output containers and the cluster counter
+  void clearOutputContainers();
+
   /// Writes clusters from temporary storage to cluster output
   /// \param timeOffset   Time offset of cluster container
   void writeOutputWithTimeOffset(int timeOffset);
@@ -0,0 +1,102 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HwClustererDriver.h
+/// \brief Driver running the TPC HW cluster finding of several sectors in parallel
+
+#ifndef ALICEO2_TPC_HWClustererDriver_H_
+#define ALICEO2_TPC_HWClustererDriver_H_
+
+#include "TPCReconstruction/HwClusterer.h"
+#include "TPCBase/Sector.h"
+#include "DataFormatsTPC/Helpers.h"
+
+#include "SimulationDataFormat/MCTruthContainer.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace o2
+{
+namespace TPC
+{
+
+class Digit;
+
+/// \class HwClustererDriver
+/// \brief Owns one HwClusterer per sector and runs the sectors on a pool of threads
+///
+/// Each sector has its own clusterer with its own cluster and MC label output
+/// containers, the sectors do not share any state and are processed without
+/// any locking.
+class HwClustererDriver
+{
+ public:
+  using MCLabelContainer = o2::dataformats::MCTruthContainer<o2::MCCompLabel>;
+  static constexpr int NSectors = Sector::MAXSECTOR;
+
+  /// Input of one sector
+  struct SectorInput {
+    int sector = -1;                                     ///< sector number
+    std::vector<o2::TPC::Digit> const* digits = nullptr; ///< digits of the sector
+    MCLabelContainer const* labels = nullptr;            ///< MC labels of the digits, optional
+  };
+
+  /// Constructor
+  /// \param nThreads   number of threads used for processing
+  /// \param useMC      fill the MC label output containers
+  HwClustererDriver(int nThreads = 1, bool useMC = false);
+
+  /// Destructor
+  ~HwClustererDriver() = default;
+
+  /// Process the digits of a list of sectors, each sector can appear only once.
+  /// The output containers of the processed sectors are cleared first.
+  /// \param inputs   inputs of the sectors
+  void process(std::vector<SectorInput> const& inputs);
+
+  /// Set a function for configuring the clusterers when they are created
+  /// \param configurator   function invoked with the newly created clusterer
+  void setConfigurator(std::function<void(HwClusterer&)> configurator) { mConfigurator = configurator; }
+
+  /// Set number of threads
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  /// Output clusters of a sector
+  std::vector<ClusterHardwareContainer8kb> const& getClusters(int sector) const { return mSectors[sector].clusters; }
+
+  /// Output MC labels of a sector
+  MCLabelContainer const& getLabels(int sector) const { return mSectors[sector].labels; }
+
+ private:
+  /// Shared-nothing state of one sector
+  struct SectorState {
+    std::unique_ptr<HwClusterer> clusterer;
+    std::vector<ClusterHardwareContainer8kb> clusters;
+    MCLabelContainer labels;
+  };
+
+  /// Get the clusterer of a sector, create it if it does not exist
+  HwClusterer& getClusterer(int sector);
+
+  int mNThreads = 1;
+  bool mUseMC = false;
+  std::function<void(HwClusterer&)> mConfigurator;
+  std::array<SectorState, NSectors> mSectors;
+};
+
+} // namespace TPC
+} // namespace o2
+
+#endif
@@ -25,6 +25,9 @@
 #include <array>
 #include <bitset>
 #include <cmath>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 #include "TPCBase/CRU.h"
 #include "Headers/RAWDataHeader.h"
@@ -286,8 +289,24 @@ class RawReaderCRU
     void updateSyncCheck(bool verbose = false);
 
     /// extract the 4 5b halfwords for the 5 data streams from one GBT frame
+    ///
+    /// The bits of one stream are interleaved over a contiguous 20 bit window of the
+    /// frame, halfword j occupying every 4th bit starting at offset 3-j. The window is
+    /// fetched with one 64 bit load and the halfwords are compressed out of it, using
+    /// the BMI2 pext instruction if available.
     void getFrameHalfWords();
 
+    /// bit-by-bit extraction of the halfwords, kept as reference for getFrameHalfWords
+    void getFrameHalfWordsReference();
+
+    /// set the raw frame data
+    void setData(const std::array<uint32_t, 4>& data) { mData = data; }
+
+    /// return a halfword of the current frame
+    /// \param stream data stream (0-4)
+    /// \param halfWord halfword in the stream (0-3)
+    uint32_t getFrameHalfWord(int stream, int halfWord) const { return mFrameHalfWords[stream][halfWord]; }
+
     /// store the half words of the current frame in the previous frame data structure. Both
     /// frame information is needed to reconstruct the ADC stream since it can spread across
     /// 2 frames, depending on the position of the SYNC pattern.
@@ -483,6 +502,26 @@ inline void RawReaderCRU::GBTFrame::updateSyncCheck(bool verbose)
 
 /// extract the 4 5b halfwords for the 5 data streams from one GBT frame
 inline void RawReaderCRU::GBTFrame::getFrameHalfWords()
+{
+  // first bit of the 20 bit window of each stream
+  constexpr uint32_t WindowStart[5] = { 0, 20, 44, 64, 88 };
+  for (int i = 0; i < 5; i++) {
+    const uint32_t word = WindowStart[i] / 32;
+    const uint64_t data = (uint64_t(mData[word + 1]) << 32) | mData[word];
+    const uint32_t window = uint32_t(data >> (WindowStart[i] % 32)) & 0xFFFFF;
+    for (int j = 0; j < 4; j++) {
+      const uint32_t x = window >> (3 - j);
+#if defined(__BMI2__)
+      mFrameHalfWords[i][j] = _pext_u32(x, 0x11111);
+#else
+      mFrameHalfWords[i][j] = (x & 0x1) | ((x >> 3) & 0x2) | ((x >> 6) & 0x4) | ((x >> 9) & 0x8) | ((x >> 12) & 0x10);
+#endif
+    }
+  }
+}
+
+/// bit-by-bit extraction of the halfwords, kept as reference for getFrameHalfWords
+inline void RawReaderCRU::GBTFrame::getFrameHalfWordsReference()
 {
   uint32_t P[5][4] = { { 19, 18, 17, 16 }, { 39, 38, 37, 36 }, { 63, 62, 61, 60 }, { 83, 82, 81, 80 }, { 107, 106, 105, 104 } };
   uint32_t res = 0;
@@ -13,7 +13,9 @@
 /// \author David Rohr
 #ifndef ALICEO2_TPC_TPCCATRACKING_H_
 #define ALICEO2_TPC_TPCCATRACKING_H_
+#include <future>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "DataFormatsTPC/Cluster.h"
 #include "DataFormatsTPC/ClusterNative.h"
@@ -45,6 +47,11 @@ public:
   int runTracking(const o2::TPC::ClusterNativeAccessFullTPC& clusters, std::vector<TrackTPC>* outputTracks,
                   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* outputTracksMCTruth = nullptr);
 
+  //Same as runTracking, but the tracking is executed in a separate thread and the call returns immediately. The cluster buffers and the output containers must stay valid until the returned future is ready.
+  //Tracking calls are serialized, such that the caller can prepare the input of the next time frame while the current one is processed.
+  std::future<int> runTrackingAsync(const o2::TPC::ClusterNativeAccessFullTPC& clusters, std::vector<TrackTPC>* outputTracks,
+                                    o2::dataformats::MCTruthContainer<o2::MCCompLabel>* outputTracksMCTruth = nullptr);
+
   float getPseudoVDrift();                                            //Return artificial VDrift used to convert time to Z
   float getTFReferenceLength() {return sContinuousTFReferenceLength;} //Return reference time frame length used to obtain Z from T in continuous data
   int getNTracksASide() {return mNTracksASide;}
@@ -58,6 +65,7 @@ public:
   static constexpr float sContinuousTFReferenceLength = 0.023 * 5e6;
   static constexpr float sTrackMCMaxFake = 0.1;
   int mNTracksASide = 0;
+  std::mutex mTrackingMutex; //Serializes the calls to the CA library, which is not reentrant
 };
 
 }
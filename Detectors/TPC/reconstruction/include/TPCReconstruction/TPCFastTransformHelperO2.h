@@ -16,12 +16,18 @@
 ///
 ///  std::unique_ptr<TPCFastTransform> fastTransform = TPCFastTransformHelperO2::instance()->create( 0 );
 ///
+/// or, with the flat buffer of the transformation shared by all processes of a node:
+///
+///  std::unique_ptr<TPCFastTransform> fastTransform = TPCFastTransformHelperO2::instance()->createShared( 0, "/tpc-fast-transform" );
+///
 
 #ifndef ALICEO2_TPC_TPCFASTTRANSFORMHELPERO2_H_
 #define ALICEO2_TPC_TPCFASTTRANSFORMHELPERO2_H_
 
 #include "TPCFastTransform.h"
 #include "Rtypes.h"
+#include <gsl/span>
+#include <string>
 
 namespace o2
 {
@@ -58,6 +64,20 @@ class TPCFastTransformHelperO2
   /// Updates the transformation with the new time stamp
   int updateCalibration(TPCFastTransform& transform, Long_t TimeStamp);
 
+  /// creates TPCFastTransform object with its flat buffer in the named shared memory segment, or
+  /// attaches to the segment if another process of the node has created it; the returned object is
+  /// local to the process, the buffer it points to is shared and must not be modified (no updateCalibration)
+  /// Falls back to a local transformation if the segment can not be used.
+  std::unique_ptr<TPCFastTransform> createShared(Long_t TimeStamp, const std::string& name);
+
+  /// removes the named shared memory segment, the processes attached to it keep their mapping
+  static void removeShared(const std::string& name);
+
+  /// transforms a batch of clusters of one row of a sector from pad, time to x, y, z
+  /// \return number of clusters for which the transformation failed
+  static int transform(const TPCFastTransform& transform, int sector, int row, gsl::span<const float> pad, gsl::span<const float> time,
+                       gsl::span<float> x, gsl::span<float> y, gsl::span<float> z);
+
   /// _______________  Utilities   ________________________
 
   void testGeometry(const TPCFastTransform& fastTransform) const;
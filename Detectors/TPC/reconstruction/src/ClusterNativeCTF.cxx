@@ -0,0 +1,466 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterNativeCTF.cxx
+/// \brief Compressed time frame (CTF) format and coder of the TPC native clusters
+
+#include "TPCReconstruction/ClusterNativeCTF.h"
+#include "DataFormatsTPC/ClusterNative.h"
+#include "DataFormatsTPC/ClusterGroupAttribute.h"
+#include "DataCompression/dc_primitives.h"
+#include "DataCompression/RANSCodec.h"
+#include "DataCompression/TruncatedPrecisionConverter.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <string>
+
+using namespace o2::TPC;
+using namespace o2::data_compression;
+
+namespace
+{
+constexpr size_t NPadRows = o2::TPC::Constants::MAXGLOBALPADROW;
+
+// all streams are coded with the same 16 bit alphabet, the last symbol escapes the high bits
+// which do not fit, they are stored in full
+using Alphabet = ContiguousAlphabet<uint16_t, 0, 0xffff>;
+using Model = RANSModel<ProbabilityModel<Alphabet, uint32_t>>;
+constexpr uint32_t EscapeSymbol = 0xffff;
+
+/// parameter model of the TruncatedPrecisionConverter dropping a number of LSBs
+class TruncatedAttributeModel
+{
+ public:
+  static const int sBitlength = 32;
+  using converted_type = uint32_t;
+
+  void setTruncatedBits(uint8_t nBits) { mTruncatedBits = nBits; }
+
+  template <typename T>
+  int convert(T value, converted_type& content, uint8_t& bitlength) const
+  {
+    content = uint32_t(value) >> mTruncatedBits;
+    bitlength = sBitlength - mTruncatedBits;
+    return 0;
+  }
+
+  void reset() {}
+
+ private:
+  uint8_t mTruncatedBits = 0;
+};
+
+/// back to the original precision, the value is set to the middle of the truncated interval
+uint32_t restorePrecision(uint32_t value, uint8_t nBits)
+{
+  return nBits == 0 ? value : (value << nBits) | (uint32_t(1) << (nBits - 1));
+}
+
+size_t alignedSize(size_t size) { return (size + 7) & ~size_t(7); }
+
+void append(std::vector<char>& output, const void* data, size_t size)
+{
+  auto position = output.size();
+  output.resize(position + alignedSize(size), 0);
+  if (size > 0) {
+    std::memcpy(output.data() + position, data, size);
+  }
+}
+
+template <typename T>
+T readStruct(gsl::span<const char> data, size_t& position)
+{
+  if (position + sizeof(T) > size_t(data.size())) {
+    throw std::runtime_error("TPC CTF block truncated");
+  }
+  T value;
+  std::memcpy(&value, data.data() + position, sizeof(T));
+  position += alignedSize(sizeof(T));
+  return value;
+}
+
+const char* getData(gsl::span<const char> data, size_t& position, size_t size)
+{
+  if (position + size > size_t(data.size())) {
+    throw std::runtime_error("TPC CTF block truncated");
+  }
+  const char* ptr = data.data() + position;
+  position += alignedSize(size);
+  return ptr;
+}
+
+/// entropy code a sequence of symbols into a stream appended to output, the frequency table is
+/// stored dense or sparse, whichever is smaller
+void encodeSymbols(std::vector<uint16_t> const& symbols, std::vector<uint32_t> const& escapes, std::vector<char>& output)
+{
+  std::vector<uint32_t> counts(EscapeSymbol + 1, 0);
+  for (auto symbol : symbols) {
+    counts[symbol]++;
+  }
+
+  CTFStreamHeader header;
+  std::vector<uint16_t> table;
+  std::vector<uint8_t> stream;
+  Model model;
+  for (uint32_t symbol = 0; symbol <= EscapeSymbol; symbol++) {
+    if (counts[symbol] > 0) {
+      model.addWeight(symbol, counts[symbol]);
+    }
+  }
+  if (model.GenerateTables()) {
+    auto frequencies = model.getFrequencyTable();
+    const uint32_t first = frequencies.front().first;
+    const uint32_t range = frequencies.back().first - first + 1;
+    header.scaleBits = model.getScaleBits();
+    if (range < 2 * frequencies.size() && header.scaleBits < 16) {
+      // all frequencies are below 2^16 as the precision is below 16 bits
+      header.tableFormat = CTFStreamHeader::DenseTable;
+      header.firstSymbol = first;
+      table.resize(range, 0);
+      for (auto const& entry : frequencies) {
+        table[entry.first - first] = entry.second;
+      }
+    } else {
+      for (auto const& entry : frequencies) {
+        table.push_back(entry.first);
+        table.push_back(entry.second - 1);
+      }
+    }
+    model.EncodeStream(symbols.begin(), symbols.end(), stream);
+  }
+  header.nTableEntries = header.tableFormat == CTFStreamHeader::DenseTable ? table.size() : table.size() / 2;
+  header.streamSize = stream.size();
+  header.nEscapes = escapes.size();
+  append(output, &header, sizeof(header));
+  append(output, table.data(), table.size() * sizeof(uint16_t));
+  append(output, stream.data(), stream.size());
+  append(output, escapes.data(), escapes.size() * sizeof(uint32_t));
+}
+
+/// decode a stream of symbols at position of the sector block
+std::vector<uint16_t> decodeSymbols(gsl::span<const char> block, size_t& position, std::vector<uint32_t>& escapes)
+{
+  auto header = readStruct<CTFStreamHeader>(block, position);
+  const bool dense = header.tableFormat == CTFStreamHeader::DenseTable;
+  if (header.tableFormat > CTFStreamHeader::DenseTable ||
+      (dense && header.firstSymbol + header.nTableEntries > EscapeSymbol + 1)) {
+    throw std::runtime_error("invalid frequency table in TPC CTF stream");
+  }
+  const size_t tableSize = header.nTableEntries * (dense ? 1 : 2) * sizeof(uint16_t);
+  const char* tableData = getData(block, position, tableSize);
+  const char* stream = getData(block, position, header.streamSize);
+  const char* escapeData = getData(block, position, header.nEscapes * sizeof(uint32_t));
+  escapes.resize(header.nEscapes);
+  if (header.nEscapes > 0) {
+    std::memcpy(escapes.data(), escapeData, header.nEscapes * sizeof(uint32_t));
+  }
+  std::vector<uint16_t> symbols;
+  if (header.nTableEntries == 0) {
+    return symbols;
+  }
+
+  std::vector<uint16_t> entries(tableSize / sizeof(uint16_t));
+  std::memcpy(entries.data(), tableData, tableSize);
+  std::vector<std::pair<uint16_t, uint32_t>> table;
+  if (dense) {
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (entries[i] > 0) {
+        table.emplace_back(header.firstSymbol + i, entries[i]);
+      }
+    }
+  } else {
+    for (size_t i = 0; i < entries.size(); i += 2) {
+      table.emplace_back(entries[i], uint32_t(entries[i + 1]) + 1);
+    }
+  }
+  Model model;
+  if (!model.setFrequencyTable(table, header.scaleBits)) {
+    throw std::runtime_error("invalid frequency table in TPC CTF stream");
+  }
+  uint32_t nSymbols = 0;
+  if (header.streamSize < sizeof(nSymbols)) {
+    throw std::runtime_error("TPC CTF stream truncated");
+  }
+  std::memcpy(&nSymbols, stream, sizeof(nSymbols));
+  symbols.resize(nSymbols);
+  model.DecodeStream(reinterpret_cast<const uint8_t*>(stream), size_t(header.streamSize) * 8, symbols.begin());
+  return symbols;
+}
+
+/// entropy code the values of one attribute, the low bytes and the high bits go to separate streams
+void encodeAttribute(std::vector<uint32_t> const& values, std::vector<char>& output)
+{
+  std::vector<uint16_t> low(values.size());
+  std::vector<uint16_t> high(values.size());
+  std::vector<uint32_t> escapes;
+  for (size_t i = 0; i < values.size(); i++) {
+    low[i] = values[i] & 0xff;
+    const uint32_t highBits = values[i] >> 8;
+    if (highBits >= EscapeSymbol) {
+      high[i] = EscapeSymbol;
+      escapes.push_back(highBits);
+    } else {
+      high[i] = highBits;
+    }
+  }
+  encodeSymbols(low, {}, output);
+  encodeSymbols(high, escapes, output);
+}
+
+/// decode the values of one attribute at position of the sector block
+std::vector<uint32_t> decodeAttribute(gsl::span<const char> block, size_t& position)
+{
+  std::vector<uint32_t> escapes;
+  auto low = decodeSymbols(block, position, escapes);
+  auto high = decodeSymbols(block, position, escapes);
+  if (low.size() != high.size()) {
+    throw std::runtime_error("inconsistent streams of attribute in TPC CTF sector block");
+  }
+  std::vector<uint32_t> values(low.size());
+  size_t escape = 0;
+  for (size_t i = 0; i < values.size(); i++) {
+    uint32_t highBits = high[i];
+    if (highBits == EscapeSymbol) {
+      if (escape >= escapes.size()) {
+        throw std::runtime_error("inconsistent number of escaped values in TPC CTF stream");
+      }
+      highBits = escapes[escape++];
+    }
+    values[i] = (highBits << 8) | low[i];
+  }
+  return values;
+}
+} // namespace
+
+void ClusterNativeCTFCoder::setTruncatedBits(int attribute, uint8_t nBits)
+{
+  if (attribute < TimeDelta || attribute > QTot) {
+    throw std::invalid_argument("precision of attribute " + std::to_string(attribute) + " can not be truncated");
+  }
+  if (nBits >= 16) {
+    throw std::invalid_argument("can not truncate " + std::to_string(nBits) + " bits");
+  }
+  mTruncatedBits[attribute] = nBits;
+}
+
+size_t ClusterNativeCTFCoder::encodeSector(int sector, gsl::span<const char> input, std::vector<char>& output) const
+{
+  // the clusters of the sector by pad row, from the sequence of ClusterNativeBuffer blocks
+  std::vector<std::vector<ClusterNative>> rows(NPadRows);
+  size_t position = 0;
+  while (position < size_t(input.size())) {
+    if (position + sizeof(ClusterGroupHeader) > size_t(input.size())) {
+      throw std::runtime_error("invalid TPC native cluster buffer of sector " + std::to_string(sector));
+    }
+    const auto& groupHeader = *reinterpret_cast<const ClusterGroupHeader*>(input.data() + position);
+    const size_t nClusters = groupHeader.nClusters;
+    position += sizeof(ClusterGroupHeader);
+    if (position + nClusters * sizeof(ClusterNative) > size_t(input.size()) || groupHeader.globalPadRow >= NPadRows) {
+      throw std::runtime_error("invalid TPC native cluster buffer of sector " + std::to_string(sector));
+    }
+    auto& row = rows[groupHeader.globalPadRow];
+    const auto first = row.size();
+    row.resize(first + nClusters);
+    std::memcpy(row.data() + first, input.data() + position, nClusters * sizeof(ClusterNative));
+    position += nClusters * sizeof(ClusterNative);
+  }
+
+  std::array<TruncatedPrecisionConverter<TruncatedAttributeModel>, NAttributes> converters;
+  for (int attribute = 0; attribute < NAttributes; attribute++) {
+    converters[attribute].getModel().setTruncatedBits(mTruncatedBits[attribute]);
+  }
+  std::array<std::vector<uint32_t>, NAttributes> values;
+  auto add = [&converters, &values](int attribute, uint32_t value) {
+    converters[attribute].write(value, [&values, attribute](uint32_t content, uint8_t) {
+      values[attribute].push_back(content);
+      return 0;
+    });
+  };
+
+  size_t nClusters = 0;
+  for (auto& row : rows) {
+    if (row.size() > 0xffff) {
+      throw std::runtime_error("too many clusters in pad row of sector " + std::to_string(sector));
+    }
+    std::sort(row.begin(), row.end());
+    values[NClusters].push_back(row.size());
+    nClusters += row.size();
+    uint32_t lastTime = 0;
+    for (auto const& cluster : row) {
+      // the truncation is applied before the difference, the rounding errors do not add up
+      uint32_t time = cluster.getTimePacked() >> mTruncatedBits[TimeDelta];
+      values[TimeDelta].push_back(time - lastTime);
+      lastTime = time;
+      add(Pad, cluster.padPacked);
+      add(SigmaTime, cluster.sigmaTimePacked);
+      add(SigmaPad, cluster.sigmaPadPacked);
+      add(QMax, cluster.qMax);
+      add(QTot, cluster.qTot);
+      add(Flags, cluster.getFlags());
+    }
+  }
+
+  CTFSectorHeader header;
+  header.sector = sector;
+  header.nAttributes = NAttributes;
+  header.nClusters = nClusters;
+  std::copy(mTruncatedBits.begin(), mTruncatedBits.end(), header.truncatedBits);
+  append(output, &header, sizeof(header));
+  for (auto const& attributeValues : values) {
+    encodeAttribute(attributeValues, output);
+  }
+  return nClusters;
+}
+
+size_t ClusterNativeCTFCoder::decodeSector(gsl::span<const char> block, std::vector<char>& output) const
+{
+  size_t position = 0;
+  auto header = readStruct<CTFSectorHeader>(block, position);
+  if (header.nAttributes != NAttributes) {
+    throw std::runtime_error("unsupported number of attributes in TPC CTF sector block: " + std::to_string(header.nAttributes));
+  }
+  std::array<std::vector<uint32_t>, NAttributes> values;
+  for (auto& attributeValues : values) {
+    attributeValues = decodeAttribute(block, position);
+  }
+  if (values[NClusters].size() != NPadRows) {
+    throw std::runtime_error("inconsistent number of pad rows in TPC CTF sector block");
+  }
+  for (int attribute = TimeDelta; attribute < NAttributes; attribute++) {
+    if (values[attribute].size() != header.nClusters) {
+      throw std::runtime_error("inconsistent number of clusters in TPC CTF sector block");
+    }
+  }
+
+  const auto& bits = header.truncatedBits;
+  output.clear();
+  size_t cluster = 0;
+  for (size_t padRow = 0; padRow < NPadRows; padRow++) {
+    const uint16_t nClusters = values[NClusters][padRow];
+    if (nClusters == 0) {
+      continue;
+    }
+    if (cluster + nClusters > header.nClusters) {
+      throw std::runtime_error("inconsistent number of clusters in TPC CTF sector block");
+    }
+    ClusterGroupHeader groupHeader{ ClusterGroupAttribute{ uint8_t(header.sector), uint8_t(padRow) }, nClusters };
+    auto groupPosition = output.size();
+    output.resize(groupPosition + sizeof(groupHeader) + nClusters * sizeof(ClusterNative));
+    std::memcpy(output.data() + groupPosition, &groupHeader, sizeof(groupHeader));
+    auto clusters = reinterpret_cast<ClusterNative*>(output.data() + groupPosition + sizeof(groupHeader));
+    uint32_t time = 0;
+    for (uint16_t i = 0; i < nClusters; i++, cluster++) {
+      time += values[TimeDelta][cluster];
+      ClusterNative c;
+      c.setTimePackedFlags(restorePrecision(time, bits[TimeDelta]), values[Flags][cluster]);
+      c.padPacked = restorePrecision(values[Pad][cluster], bits[Pad]);
+      c.sigmaTimePacked = restorePrecision(values[SigmaTime][cluster], bits[SigmaTime]);
+      c.sigmaPadPacked = restorePrecision(values[SigmaPad][cluster], bits[SigmaPad]);
+      c.qMax = restorePrecision(values[QMax][cluster], bits[QMax]);
+      c.qTot = restorePrecision(values[QTot][cluster], bits[QTot]);
+      std::memcpy(clusters + i, &c, sizeof(c));
+    }
+  }
+  return cluster;
+}
+
+size_t ClusterNativeCTFCoder::encode(std::array<gsl::span<const char>, NSectors> const& inputs, std::vector<char>& ctf) const
+{
+  std::array<std::vector<char>, NSectors> blocks;
+  std::array<std::future<size_t>, NSectors> results;
+  for (size_t sector = 0; sector < NSectors; sector++) {
+    if (inputs[sector].size() > 0) {
+      results[sector] = std::async(std::launch::async, [this, sector, &inputs, &blocks]() {
+        return encodeSector(sector, inputs[sector], blocks[sector]);
+      });
+    }
+  }
+
+  CTFHeader header;
+  std::vector<CTFSectorEntry> directory;
+  for (size_t sector = 0; sector < NSectors; sector++) {
+    if (!results[sector].valid()) {
+      continue;
+    }
+    CTFSectorEntry entry;
+    entry.sector = sector;
+    entry.nClusters = results[sector].get();
+    directory.push_back(entry);
+    header.nClusters += entry.nClusters;
+  }
+  header.nSectors = directory.size();
+  uint64_t offset = alignedSize(sizeof(header)) + alignedSize(directory.size() * sizeof(CTFSectorEntry));
+  for (auto& entry : directory) {
+    entry.offset = offset;
+    entry.size = blocks[entry.sector].size();
+    offset += entry.size;
+  }
+  header.size = offset;
+
+  ctf.reserve(ctf.size() + header.size);
+  append(ctf, &header, sizeof(header));
+  append(ctf, directory.data(), directory.size() * sizeof(CTFSectorEntry));
+  for (auto const& entry : directory) {
+    ctf.insert(ctf.end(), blocks[entry.sector].begin(), blocks[entry.sector].end());
+  }
+  return header.nClusters;
+}
+
+size_t ClusterNativeCTFCoder::checkCTF(gsl::span<const char> data)
+{
+  size_t position = 0;
+  auto header = readStruct<CTFHeader>(data, position);
+  if (header.magic != CTFHeader::sMagic) {
+    throw std::runtime_error("not a TPC CTF");
+  }
+  if (header.version != CTFHeader::sVersion) {
+    throw std::runtime_error("unsupported TPC CTF version " + std::to_string(header.version));
+  }
+  if (header.size > size_t(data.size())) {
+    throw std::runtime_error("TPC CTF truncated");
+  }
+  std::bitset<NSectors> sectors;
+  for (uint16_t i = 0; i < header.nSectors; i++) {
+    CTFSectorEntry entry;
+    std::memcpy(&entry, getData(data, position, sizeof(entry)), sizeof(entry));
+    if (entry.sector >= NSectors || sectors.test(entry.sector) || entry.offset + entry.size > header.size) {
+      throw std::runtime_error("invalid sector directory of TPC CTF");
+    }
+    sectors.set(entry.sector);
+  }
+  return header.size;
+}
+
+size_t ClusterNativeCTFCoder::decode(gsl::span<const char> ctf, std::array<std::vector<char>, NSectors>& outputs) const
+{
+  checkCTF(ctf);
+  CTFHeader header;
+  std::memcpy(&header, ctf.data(), sizeof(header));
+  std::vector<CTFSectorEntry> directory(header.nSectors);
+  std::memcpy(directory.data(), ctf.data() + alignedSize(sizeof(header)), directory.size() * sizeof(CTFSectorEntry));
+
+  for (auto& output : outputs) {
+    output.clear();
+  }
+  std::vector<std::future<size_t>> results;
+  for (auto const& entry : directory) {
+    results.emplace_back(std::async(std::launch::async, [this, entry, ctf, &outputs]() {
+      return decodeSector(ctf.subspan(entry.offset, entry.size), outputs[entry.sector]);
+    }));
+  }
+  size_t nClusters = 0;
+  for (auto& result : results) {
+    nClusters += result.get();
+  }
+  return nClusters;
+}
@@ -12,9 +12,43 @@
 /// \author David Rohr
 
 #include "TPCReconstruction/DigitalCurrentClusterIntegrator.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 using namespace o2::TPC;
 
+void DigitalCurrentClusterIntegrator::integrateClusters(const ClusterNativeAccessFullTPC& clusters, int nThreads)
+{
+  //The row buffers are allocated before the threads are started, the threads then only write to the pads of their sectors
+  for (int i = 0;i < Constants::MAXSECTOR;i++)
+  {
+    for (int j = 0;j < Constants::MAXGLOBALPADROW;j++)
+    {
+      if (clusters.nClusters[i][j]) initRow(i, j);
+    }
+  }
+  std::atomic<int> nextSector{ 0 };
+  auto worker = [this, &clusters, &nextSector]() {
+    for (int i = nextSector++;i < Constants::MAXSECTOR;i = nextSector++)
+    {
+      for (int j = 0;j < Constants::MAXGLOBALPADROW;j++)
+      {
+        for (unsigned int k = 0;k < clusters.nClusters[i][j];k++)
+        {
+          const ClusterNative& cl = clusters.clusters[i][j][k];
+          integrateCluster(i, j, cl.getPad(), cl.qTot);
+        }
+      }
+    }
+  };
+  nThreads = std::max(1, std::min(nThreads, int(Constants::MAXSECTOR)));
+  std::vector<std::thread> threads;
+  for (int i = 1;i < nThreads;i++) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+}
+
 void DigitalCurrentClusterIntegrator::clear()
 {
   for (int i = 0;i < Constants::MAXSECTOR;i++)
@@ -18,8 +18,11 @@
 #include "DataFormatsTPC/Constants.h"
 #include "TPCBase/Mapper.h"
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <thread>
 #include <vector>
-#include <numeric> // std::iota
 #include "FairLogger.h"
 
 #include "SimulationDataFormat/MCTruthContainer.h"
@@ -32,6 +35,109 @@ using namespace o2::TPC;
 using namespace o2;
 using namespace o2::dataformats;
 
+namespace
+{
+// scratch space of the sorting, reused over the rows sorted by one thread
+struct SortBuffers {
+  std::vector<uint64_t> keys;
+  std::vector<uint64_t> tmpKeys;
+  std::vector<ClusterNative> tmpClusters;
+};
+
+// Sorts the clusters of a row by time and pad, in the order of ClusterNative::operator<, and moves their
+// MC labels along. The sort key, time (24 bits) and pad (16 bits) in the upper 40 bits and the position
+// of the cluster in the lower 24 bits, is radix sorted on the bytes of time and pad, skipping the bytes
+// which are the same for all clusters; short rows are sorted by comparison of the keys. The clusters and
+// labels are then gathered from the sorted positions once, and not at all if they are already sorted.
+void sortRow(ClusterNative* clusters, size_t nClusters, MCLabelContainer* mcTruth, SortBuffers& buffers)
+{
+  constexpr size_t MinRadixSort = 64;
+  constexpr int NKeyBytes = 5;
+  constexpr int PositionBits = 24;
+  if (nClusters < 2) {
+    return;
+  }
+  assert(nClusters <= (1 << PositionBits));
+  auto& keys = buffers.keys;
+  keys.resize(nClusters);
+  for (size_t i = 0; i < nClusters; i++) {
+    keys[i] = (uint64_t(clusters[i].getTimePacked()) << (PositionBits + 16)) | (uint64_t(clusters[i].padPacked) << PositionBits) | i;
+  }
+  if (nClusters < MinRadixSort) {
+    std::sort(keys.begin(), keys.end());
+  } else {
+    uint32_t counts[NKeyBytes][256] = { { 0 } };
+    for (auto key : keys) {
+      for (int b = 0; b < NKeyBytes; b++) {
+        counts[b][(key >> (PositionBits + 8 * b)) & 0xFF]++;
+      }
+    }
+    auto& tmpKeys = buffers.tmpKeys;
+    tmpKeys.resize(nClusters);
+    for (int b = 0; b < NKeyBytes; b++) {
+      const int shift = PositionBits + 8 * b;
+      if (counts[b][(keys[0] >> shift) & 0xFF] == nClusters) {
+        continue; // same byte for all clusters
+      }
+      uint32_t offsets[256];
+      uint32_t offset = 0;
+      for (int d = 0; d < 256; d++) {
+        offsets[d] = offset;
+        offset += counts[b][d];
+      }
+      for (auto key : keys) {
+        tmpKeys[offsets[(key >> shift) & 0xFF]++] = key;
+      }
+      keys.swap(tmpKeys);
+    }
+  }
+
+  constexpr uint64_t positionMask = (1 << PositionBits) - 1;
+  size_t first = 0;
+  while (first < nClusters && (keys[first] & positionMask) == first) {
+    first++;
+  }
+  if (first == nClusters) {
+    return; // already sorted
+  }
+  auto& tmpClusters = buffers.tmpClusters;
+  tmpClusters.assign(clusters, clusters + nClusters);
+  for (size_t i = first; i < nClusters; i++) {
+    clusters[i] = tmpClusters[keys[i] & positionMask];
+  }
+  if (mcTruth) {
+    MCLabelContainer sorted;
+    for (size_t i = 0; i < nClusters; i++) {
+      for (auto const& label : mcTruth->getLabels(keys[i] & positionMask)) {
+        sorted.addElement(i, label);
+      }
+    }
+    *mcTruth = std::move(sorted);
+  }
+}
+
+// runs process(sector) for all sectors, on nThreads threads taking the sectors from a common counter
+template <typename F>
+void forEachSector(int nThreads, F&& process)
+{
+  nThreads = std::max(1, std::min(nThreads, int(Constants::MAXSECTOR)));
+  std::atomic<int> nextSector{ 0 };
+  auto worker = [&nextSector, &process]() {
+    for (int sector = nextSector++; sector < Constants::MAXSECTOR; sector = nextSector++) {
+      process(sector);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 1; i < nThreads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+} // namespace
+
 int HardwareClusterDecoder::decodeClusters(std::vector<std::pair<const ClusterHardwareContainer*, std::size_t>>& inputClusters,
                                            HardwareClusterDecoder::OutputAllocator outputAllocator,
                                            const std::vector<o2::dataformats::MCTruthContainer<o2::MCCompLabel>>* inMCLabels,
@@ -39,14 +145,17 @@ int HardwareClusterDecoder::decodeClusters(std::vector<std::pair<const ClusterHa
 {
   if (mIntegrator == nullptr) mIntegrator.reset(new DigitalCurrentClusterIntegrator);
   if (!inMCLabels) outMCLabels = nullptr;
-  std::vector<ClusterNativeBuffer*> outputBufferMap;
-  int nRowClusters[Constants::MAXSECTOR][Constants::MAXGLOBALPADROW] = {0};
-  int containerRowCluster[Constants::MAXSECTOR][Constants::MAXGLOBALPADROW] =  {0};
   Mapper& mapper = Mapper::instance();
-  int numberOfOutputContainers = 0;
+
+  //Group the pages by sector, keeping their input order inside a sector
+  int nSectorPages[Constants::MAXSECTOR + 1] = {0};
   for (int loop = 0;loop < 2;loop++)
   {
-    int nTotalClusters = 0;
+    if (loop == 1)
+    {
+      for (int i = 0;i < Constants::MAXSECTOR;i++) nSectorPages[i + 1] += nSectorPages[i];
+      mPages.resize(nSectorPages[Constants::MAXSECTOR]);
+    }
     for (int i = 0;i < inputClusters.size();i++)
     {
       if (outMCLabels && inputClusters[i].second > 1)
@@ -58,109 +167,113 @@ int HardwareClusterDecoder::decodeClusters(std::vector<std::pair<const ClusterHa
       {
         const char* tmpPtr = reinterpret_cast<const char*> (inputClusters[i].first);
         tmpPtr += j * 8192; //TODO: FIXME: Compute correct offset based on the size of the actual packet in the RDH
-        const ClusterHardwareContainer& cont = *(reinterpret_cast<const ClusterHardwareContainer*> (tmpPtr));
-        const CRU cru(cont.CRU);
-        const Sector sector = cru.sector();
-        const PadRegionInfo& region = mapper.getPadRegionInfo(cru.region());
-        const int rowOffset = region.getGlobalRowOffset();
-
-        for (int k = 0;k < cont.numberOfClusters;k++)
-        {
-          const int padRowGlobal = rowOffset + cont.clusters[k].getRow();
-          int& nCls = nRowClusters[sector][padRowGlobal];
-          if (loop == 1)
-          {
-            //Fill cluster in the respective output buffer
-            const ClusterHardware& cIn = cont.clusters[k];
-            ClusterNative& cOut = outputBufferMap[containerRowCluster[sector][padRowGlobal]]->clusters[nCls];
-            float pad = cIn.getPad();
-            cOut.setPad(pad);
-            cOut.setTimeFlags(cIn.getTimeLocal() + cont.timeBinOffset, cIn.getFlags());
-            cOut.setSigmaPad(std::sqrt(cIn.getSigmaPad2()));
-            cOut.setSigmaTime(std::sqrt(cIn.getSigmaTime2()));
-            cOut.qMax = cIn.getQMax();
-            cOut.qTot = cIn.getQTot();
-            mIntegrator->integrateCluster(sector, padRowGlobal, pad, cIn.getQTot());
-            if (outMCLabels)
-            {
-              auto& mcOut = (*outMCLabels)[containerRowCluster[sector][padRowGlobal]];
-              for (const auto& element : (*inMCLabels)[i].getLabels(k)) {
-                mcOut.addElement(nCls, element);
-              }
-            }
-          }
-          else
-          {
-            //Count how many output buffers we need (and how large they are below)
-            if (nCls == 0) numberOfOutputContainers++;
-          }
-          nCls++;
-          nTotalClusters++;
-        }
+        const ClusterHardwareContainer* cont = reinterpret_cast<const ClusterHardwareContainer*> (tmpPtr);
+        const int sector = CRU(cont->CRU).sector();
+        if (loop == 0) nSectorPages[sector + 1]++;
+        else mPages[nSectorPages[sector]++] = {cont, i};
       }
     }
-    if (loop == 1)
+  }
+  //nSectorPages[sector] now points to the end of the pages of the sector
+  auto sectorPages = [this, &nSectorPages](int sector) {
+    return std::make_pair(mPages.data() + (sector ? nSectorPages[sector - 1] : 0), mPages.data() + nSectorPages[sector]);
+  };
+
+  //Count the clusters per row, in parallel over the sectors
+  int nRowClusters[Constants::MAXSECTOR][Constants::MAXGLOBALPADROW] = {0};
+  forEachSector(mNThreads, [&](int sector) {
+    auto pages = sectorPages(sector);
+    for (auto page = pages.first;page != pages.second;page++)
     {
-      //We are done with filling the buffers, sort all output buffers
-      for (int i = 0; i < outputBufferMap.size(); i++) {
-        if (outMCLabels) {
-          sortClustersAndMC(outputBufferMap[i]->clusters, outputBufferMap[i]->nClusters, (*outMCLabels)[i]);
-        } else {
-          auto* cl = outputBufferMap[i]->clusters;
-          std::sort(cl, cl + outputBufferMap[i]->nClusters);
-        }
-      }
+      const ClusterHardwareContainer& cont = *page->container;
+      const int rowOffset = mapper.getPadRegionInfo(CRU(cont.CRU).region()).getGlobalRowOffset();
+      for (int k = 0;k < cont.numberOfClusters;k++) nRowClusters[sector][rowOffset + cont.clusters[k].getRow()]++;
+    }
+  });
+
+  //Now we know the size of all output buffers, allocate them
+  ClusterNativeBuffer* outputBufferMap[Constants::MAXSECTOR][Constants::MAXGLOBALPADROW] = {{nullptr}};
+  int containerRowCluster[Constants::MAXSECTOR][Constants::MAXGLOBALPADROW] = {0};
+  int numberOfOutputContainers = 0;
+  size_t nTotalClusters = 0;
+  for (int i = 0;i < Constants::MAXSECTOR;i++)
+  {
+    for (int j = 0;j < Constants::MAXGLOBALPADROW;j++)
+    {
+      if (nRowClusters[i][j] == 0) continue;
+      numberOfOutputContainers++;
+      nTotalClusters += nRowClusters[i][j];
+    }
+  }
+  if (outMCLabels) outMCLabels->resize(numberOfOutputContainers);
+  size_t rawOutputBufferSize = numberOfOutputContainers * sizeof(ClusterNativeBuffer) + nTotalClusters * sizeof(ClusterNative);
+  char* rawOutputBuffer = outputAllocator(rawOutputBufferSize);
+  char* rawOutputBufferIterator = rawOutputBuffer;
+  numberOfOutputContainers = 0;
+  for (int i = 0;i < Constants::MAXSECTOR;i++)
+  {
+    for (int j = 0;j < Constants::MAXGLOBALPADROW;j++)
+    {
+      if (nRowClusters[i][j] == 0) continue;
+      outputBufferMap[i][j] = reinterpret_cast<ClusterNativeBuffer*>(rawOutputBufferIterator);
+      ClusterNativeBuffer& container = *outputBufferMap[i][j];
+      container.sector = i;
+      container.globalPadRow = j;
+      container.nClusters = nRowClusters[i][j];
+      containerRowCluster[i][j] = numberOfOutputContainers++;
+      rawOutputBufferIterator += container.getFlatSize();
+      mIntegrator->initRow(i, j);
     }
-    else
+  }
+  assert(rawOutputBufferIterator == rawOutputBuffer + rawOutputBufferSize);
+  memset(nRowClusters, 0, sizeof(nRowClusters));
+
+  //Fill the clusters in the respective output buffers and sort them, in parallel over the sectors:
+  //a sector only writes to its own rows, MC label containers and integrator rows
+  forEachSector(mNThreads, [&](int sector) {
+    auto pages = sectorPages(sector);
+    for (auto page = pages.first;page != pages.second;page++)
     {
-      //Now we know the size of all output buffers, allocate them
-      if (outMCLabels) outMCLabels->resize(numberOfOutputContainers);
-      size_t rawOutputBufferSize = numberOfOutputContainers * sizeof(ClusterNativeBuffer) + nTotalClusters * sizeof(ClusterNative);
-      char* rawOutputBuffer = outputAllocator(rawOutputBufferSize);
-      char* rawOutputBufferIterator = rawOutputBuffer;
-      numberOfOutputContainers = 0;
-      for (int i = 0;i < Constants::MAXSECTOR;i++)
+      const ClusterHardwareContainer& cont = *page->container;
+      const int rowOffset = mapper.getPadRegionInfo(CRU(cont.CRU).region()).getGlobalRowOffset();
+      for (int k = 0;k < cont.numberOfClusters;k++)
       {
-        for (int j = 0;j < Constants::MAXGLOBALPADROW;j++)
+        const ClusterHardware& cIn = cont.clusters[k];
+        const int padRowGlobal = rowOffset + cIn.getRow();
+        int& nCls = nRowClusters[sector][padRowGlobal];
+        ClusterNative& cOut = outputBufferMap[sector][padRowGlobal]->clusters[nCls];
+        float pad = cIn.getPad();
+        cOut.setPad(pad);
+        cOut.setTimeFlags(cIn.getTimeLocal() + cont.timeBinOffset, cIn.getFlags());
+        cOut.setSigmaPad(std::sqrt(cIn.getSigmaPad2()));
+        cOut.setSigmaTime(std::sqrt(cIn.getSigmaTime2()));
+        cOut.qMax = cIn.getQMax();
+        cOut.qTot = cIn.getQTot();
+        mIntegrator->integrateCluster(sector, padRowGlobal, pad, cIn.getQTot());
+        if (outMCLabels)
         {
-          if (nRowClusters[i][j] == 0) continue;
-          outputBufferMap.push_back(reinterpret_cast<ClusterNativeBuffer*>(rawOutputBufferIterator));
-          ClusterNativeBuffer& container = *outputBufferMap.back();
-          container.sector = i;
-          container.globalPadRow = j;
-          container.nClusters = nRowClusters[i][j];
-          containerRowCluster[i][j] = numberOfOutputContainers++;
-          rawOutputBufferIterator += container.getFlatSize();
-          mIntegrator->initRow(i, j);
+          auto& mcOut = (*outMCLabels)[containerRowCluster[sector][padRowGlobal]];
+          for (const auto& element : (*inMCLabels)[page->input].getLabels(k)) {
+            mcOut.addElement(nCls, element);
+          }
         }
+        nCls++;
       }
-      assert(rawOutputBufferIterator == rawOutputBuffer + rawOutputBufferSize);
-      memset(nRowClusters, 0, sizeof(nRowClusters));
     }
-  }
+    SortBuffers buffers;
+    for (int j = 0;j < Constants::MAXGLOBALPADROW;j++)
+    {
+      if (nRowClusters[sector][j] == 0) continue;
+      sortRow(outputBufferMap[sector][j]->clusters, nRowClusters[sector][j],
+              outMCLabels ? &(*outMCLabels)[containerRowCluster[sector][j]] : nullptr, buffers);
+    }
+  });
   return(0);
 }
 
 void HardwareClusterDecoder::sortClustersAndMC(ClusterNative* clusters, size_t nClusters,
-                                               o2::dataformats::MCTruthContainer<o2::MCCompLabel> mcTruth)
+                                               o2::dataformats::MCTruthContainer<o2::MCCompLabel>& mcTruth)
 {
-  std::vector<unsigned int> indizes(nClusters);
-  std::iota(indizes.begin(), indizes.end(), 0);
-  std::sort(indizes.begin(), indizes.end(), [&clusters](const auto a, const auto b) {
-    return clusters[a] < clusters[b];
-  });
-  std::vector<unsigned int> actual = indizes;
-  MCLabelContainer tmpMC = std::move(mcTruth);
-  assert(mcTruth.getIndexedSize() == 0);
-  for (int i = 0; i < nClusters; i++) {
-    ClusterNative backup = clusters[i];
-    clusters[i] = clusters[actual[indizes[i]]];
-    clusters[actual[indizes[i]]] = backup;
-    auto tmp = actual[i];
-    actual[i] = actual[indizes[i]];
-    actual[indizes[i]] = tmp;
-    for (auto const& label : tmpMC.getLabels(indizes[i])) {
-      mcTruth.addElement(i, label);
-    }
-  }
+  SortBuffers buffers;
+  sortRow(clusters, nClusters, &mcTruth, buffers);
 }
@@ -132,19 +132,10 @@ HwClusterer::HwClusterer(
 void HwClusterer::process(std::vector<o2::TPC::Digit> const& digits, MCLabelContainer const* mcDigitTruth, bool clearContainerFirst)
 {
   if (clearContainerFirst) {
-    if (mClusterArray)
-      mClusterArray->clear();
-    if (mPlainClusterArray)
-      mPlainClusterArray->clear();
-
-    if (mClusterMcLabelArray)
-      mClusterMcLabelArray->clear();
-    mClusterCounter = 0;
+    clearOutputContainers();
   }
 
   int digitIndex = 0;
-  int index;
-  unsigned HB;
   mCurrentMcContainerInBuffer = 0;
 
   /*
@@ -165,57 +156,7 @@ void HwClusterer::process(std::vector<o2::TPC::Digit> const& digits, MCLabelCont
      */
 
     if (digit.getTimeStamp() != mLastTimebin) {
-      /*
-       * If the timebin changes, it could change by more then just 1 (not every
-       * timebin has digits). Since the tmp storage covers mTimebinsInBuffer,
-       * at most mTimebinsInBuffer new timebins need to be prepared and checked
-       * for clusters.
-       */
-      for (int i = mLastTimebin; (i < digit.getTimeStamp()) && (i - mLastTimebin < mTimebinsInBuffer); ++i) {
-
-        /*
-         * If the HB of the cluster which will be found in a few lines, NOT the
-         * current timebin is a new one, we have to fill the output container
-         * with the so far found clusters. Because cluster center and timebin
-         * have an offset of two with respect to each other (see next comment),
-         * the HB is calculated with (i-2). By the way, it is not possible, that
-         * a cluster is found with a negative HB, because at least 2 timebins
-         * have to be filled to be able to find a cluster.
-         */
-        HB = i < 3 ? 0 : (i - 3) / 447; // integer division on purpose
-        if (HB != mLastHB) {
-          writeOutputWithTimeOffset(mLastHB * 447);
-        }
-
-        /*
-         * For each row(set), we first compute all the pad relations for the
-         * latest timebin (i), afterwards the clusters for timebin i-2 are
-         * collected and computed. We need the -2 because a cluster spreads
-         * over 5 timbins, and the relations are always computed with respect
-         * to the older timebin. Also a (i-1) and (i-2) would be possible, but
-         * doens't matter.
-         *
-         * If mTimebinsInBuffer would be 5 and i 5 is the new digit timebin (4
-         * would be mLastTimebin), then 0 is the oldest one timebin and will to
-         * be replaced by the new arriving one. The cluster which could be
-         * found, would then range from timebin 0 to 4 and has its center at
-         * timebin 2. Threrefore we are looking in (i - 2) for clusters and
-         * clearing (i - 4), or (i + 1) afterwards.
-         *       ---------
-         * -> 0 |
-         *    1 |
-         *    2 | XXXXXX
-         *    3 |
-         *    4 |
-         *       ---------
-         */
-        findPeaksForTime(i);
-        computeClusterForTime(i - 3);
-
-        clearBuffer(i + 1);
-
-        mLastHB = HB;
-      }
+      advanceToTimebin(digit.getTimeStamp());
 
       // we have to copy the MC truth container because we need the information
       // maybe only in the next events (we store permanently 5 timebins), where
@@ -233,29 +174,7 @@ void HwClusterer::process(std::vector<o2::TPC::Digit> const& digits, MCLabelCont
     /*
      * add current digit to storage
      */
-    index = mapTimeInRange(digit.getTimeStamp()) * mPadsPerRowSet[mGlobalRowToRowSet[digit.getRow()]] + (digit.getPad() + 2);
-    // offset of digit pad because of 2 empty pads on both sides
-
-    // TODO: fill noise here as well if necessary
-    if (mPedestalObject) {
-      /*
-       * If a pedestal object was registered, check if charge of pad is greater
-       * than pedestal value. If so, assign difference of charge and pedestal
-       * to buffer, if not, set buffer to 0.
-       */
-      if (digit.getChargeFloat() < mPedestalObject->getValue(CRU(digit.getCRU()), digit.getRow(), digit.getPad())) {
-        mDataBuffer[mGlobalRowToRowSet[digit.getRow()]][index][mGlobalRowToVcIndex[digit.getRow()]] = 0;
-      } else {
-        mDataBuffer[mGlobalRowToRowSet[digit.getRow()]][index][mGlobalRowToVcIndex[digit.getRow()]] = static_cast<unsigned>(
-          (digit.getChargeFloat() - mPedestalObject->getValue(CRU(digit.getCRU()), digit.getRow(), digit.getPad())) * (1 << 4));
-      }
-    } else {
-      mDataBuffer[mGlobalRowToRowSet[digit.getRow()]][index][mGlobalRowToVcIndex[digit.getRow()]] = static_cast<unsigned>(digit.getChargeFloat() * (1 << 4));
-    }
-    if (mDataBuffer[mGlobalRowToRowSet[digit.getRow()]][index][mGlobalRowToVcIndex[digit.getRow()]] > 0x3FFF)
-      mDataBuffer[mGlobalRowToRowSet[digit.getRow()]][index][mGlobalRowToVcIndex[digit.getRow()]] = 0x3FFF; // set only 14 LSBs
-
-    mIndexBuffer[mGlobalRowToRowSet[digit.getRow()]][index][mGlobalRowToVcIndex[digit.getRow()]] = digitIndex++;
+    addToBuffer(digit.getRow(), digit.getPad(), digit.getTimeStamp(), digit.getCRU(), digit.getChargeFloat(), digitIndex++);
 
     mLastTimebin = digit.getTimeStamp();
   }
@@ -267,6 +186,128 @@ void HwClusterer::process(std::vector<o2::TPC::Digit> const& digits, MCLabelCont
     LOG(DEBUG) << "Event ranged from time bin " << digits.front().getTimeStamp() << " to " << digits.back().getTimeStamp() << "." << FairLogger::endl;
 }
 
+//______________________________________________________________________________
+void HwClusterer::processSignals(gsl::span<const Signal> signals, bool clearContainerFirst)
+{
+  if (clearContainerFirst) {
+    clearOutputContainers();
+  }
+
+  // no MC information is available for raw data, the buffers of the MC truth
+  // information are cleared as the time bins roll over
+  mCurrentMcContainerInBuffer = 0;
+
+  int signalIndex = 0;
+  for (const auto& signal : signals) {
+    if (signal.time != mLastTimebin) {
+      advanceToTimebin(signal.time);
+    }
+    const int cru = CRU(Sector(mClusterSector), mGlobalRowToRegion[signal.row]);
+    addToBuffer(signal.row, signal.pad, signal.time, cru, signal.charge, signalIndex++);
+    mLastTimebin = signal.time;
+  }
+
+  if (!mIsContinuousReadout)
+    finishFrame(true);
+}
+
+//______________________________________________________________________________
+void HwClusterer::clearOutputContainers()
+{
+  if (mClusterArray)
+    mClusterArray->clear();
+  if (mPlainClusterArray)
+    mPlainClusterArray->clear();
+
+  if (mClusterMcLabelArray)
+    mClusterMcLabelArray->clear();
+  mClusterCounter = 0;
+}
+
+//______________________________________________________________________________
+void HwClusterer::advanceToTimebin(int timebin)
+{
+  /*
+   * If the timebin changes, it could change by more then just 1 (not every
+   * timebin has digits). Since the tmp storage covers mTimebinsInBuffer,
+   * at most mTimebinsInBuffer new timebins need to be prepared and checked
+   * for clusters.
+   */
+  for (int i = mLastTimebin; (i < timebin) && (i - mLastTimebin < mTimebinsInBuffer); ++i) {
+
+    /*
+     * If the HB of the cluster which will be found in a few lines, NOT the
+     * current timebin is a new one, we have to fill the output container
+     * with the so far found clusters. Because cluster center and timebin
+     * have an offset of two with respect to each other (see next comment),
+     * the HB is calculated with (i-2). By the way, it is not possible, that
+     * a cluster is found with a negative HB, because at least 2 timebins
+     * have to be filled to be able to find a cluster.
+     */
+    unsigned HB = i < 3 ? 0 : (i - 3) / 447; // integer division on purpose
+    if (HB != mLastHB) {
+      writeOutputWithTimeOffset(mLastHB * 447);
+    }
+
+    /*
+     * For each row(set), we first compute all the pad relations for the
+     * latest timebin (i), afterwards the clusters for timebin i-2 are
+     * collected and computed. We need the -2 because a cluster spreads
+     * over 5 timbins, and the relations are always computed with respect
+     * to the older timebin. Also a (i-1) and (i-2) would be possible, but
+     * doens't matter.
+     *
+     * If mTimebinsInBuffer would be 5 and i 5 is the new digit timebin (4
+     * would be mLastTimebin), then 0 is the oldest one timebin and will to
+     * be replaced by the new arriving one. The cluster which could be
+     * found, would then range from timebin 0 to 4 and has its center at
+     * timebin 2. Threrefore we are looking in (i - 2) for clusters and
+     * clearing (i - 4), or (i + 1) afterwards.
+     *       ---------
+     * -> 0 |
+     *    1 |
+     *    2 | XXXXXX
+     *    3 |
+     *    4 |
+     *       ---------
+     */
+    findPeaksForTime(i);
+    computeClusterForTime(i - 3);
+
+    clearBuffer(i + 1);
+
+    mLastHB = HB;
+  }
+}
+
+//______________________________________________________________________________
+void HwClusterer::addToBuffer(unsigned short row, unsigned short pad, int timebin, int cru, float charge, int digitIndex)
+{
+  int index = mapTimeInRange(timebin) * mPadsPerRowSet[mGlobalRowToRowSet[row]] + (pad + 2);
+  // offset of digit pad because of 2 empty pads on both sides
+
+  // TODO: fill noise here as well if necessary
+  if (mPedestalObject) {
+    /*
+     * If a pedestal object was registered, check if charge of pad is greater
+     * than pedestal value. If so, assign difference of charge and pedestal
+     * to buffer, if not, set buffer to 0.
+     */
+    if (charge < mPedestalObject->getValue(CRU(cru), row, pad)) {
+      mDataBuffer[mGlobalRowToRowSet[row]][index][mGlobalRowToVcIndex[row]] = 0;
+    } else {
+      mDataBuffer[mGlobalRowToRowSet[row]][index][mGlobalRowToVcIndex[row]] = static_cast<unsigned>(
+        (charge - mPedestalObject->getValue(CRU(cru), row, pad)) * (1 << 4));
+    }
+  } else {
+    mDataBuffer[mGlobalRowToRowSet[row]][index][mGlobalRowToVcIndex[row]] = static_cast<unsigned>(charge * (1 << 4));
+  }
+  if (mDataBuffer[mGlobalRowToRowSet[row]][index][mGlobalRowToVcIndex[row]] > 0x3FFF)
+    mDataBuffer[mGlobalRowToRowSet[row]][index][mGlobalRowToVcIndex[row]] = 0x3FFF; // set only 14 LSBs
+
+  mIndexBuffer[mGlobalRowToRowSet[row]][index][mGlobalRowToVcIndex[row]] = digitIndex;
+}
+
 //______________________________________________________________________________
 void HwClusterer::finishProcess(std::vector<o2::TPC::Digit> const& digits, MCLabelContainer const* mcDigitTruth, bool clearContainerFirst)
 {
@@ -0,0 +1,112 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HwClustererDriver.cxx
+/// \brief Driver running the TPC HW cluster finding of several sectors in parallel
+
+#include "TPCReconstruction/HwClustererDriver.h"
+#include "TPCBase/Digit.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace o2::TPC;
+
+//______________________________________________________________________________
+HwClustererDriver::HwClustererDriver(int nThreads, bool useMC)
+  : mNThreads(nThreads > 0 ? nThreads : 1),
+    mUseMC(useMC),
+    mConfigurator(),
+    mSectors()
+{
+}
+
+//______________________________________________________________________________
+HwClusterer& HwClustererDriver::getClusterer(int sector)
+{
+  auto& state = mSectors[sector];
+  if (!state.clusterer) {
+    state.clusterer = std::make_unique<HwClusterer>(&state.clusters, sector, mUseMC ? &state.labels : nullptr);
+    if (mConfigurator) {
+      mConfigurator(*state.clusterer);
+    }
+  }
+  return *state.clusterer;
+}
+
+//______________________________________________________________________________
+void HwClustererDriver::process(std::vector<SectorInput> const& inputs)
+{
+  std::array<bool, NSectors> scheduled{};
+  for (auto const& input : inputs) {
+    if (input.sector < 0 || input.sector >= NSectors || input.digits == nullptr) {
+      throw std::runtime_error("HwClustererDriver: invalid input for sector " + std::to_string(input.sector));
+    }
+    if (scheduled[input.sector]) {
+      throw std::runtime_error("HwClustererDriver: sector " + std::to_string(input.sector) + " scheduled twice");
+    }
+    scheduled[input.sector] = true;
+    // the clusterers are created here and not in the worker threads, the creation
+    // accesses the mapper and configuration
+    getClusterer(input.sector);
+  }
+
+  auto processSector = [this](SectorInput const& input) {
+    auto& clusterer = *mSectors[input.sector].clusterer;
+    // clear the output containers and the cluster counter first, keep the clusters
+    // in finishProcess as they have not been stored in the meantime
+    clusterer.process(*input.digits, mUseMC ? input.labels : nullptr, true);
+    const std::vector<o2::TPC::Digit> emptyDigits;
+    clusterer.finishProcess(emptyDigits, nullptr, false);
+  };
+
+  const int threadsNum = std::min<int>(mNThreads, inputs.size());
+  if (threadsNum <= 1) {
+    for (auto const& input : inputs) {
+      processSector(input);
+    }
+    return;
+  }
+
+  // the first error stops the scheduling of further sectors and is rethrown
+  // after all threads have finished
+  std::atomic<size_t> nextInput{ 0 };
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto worker = [&inputs, &nextInput, &processSector, &error, &errorMutex]() {
+    for (size_t i = nextInput++; i < inputs.size(); i = nextInput++) {
+      try {
+        processSector(inputs[i]);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        nextInput = inputs.size();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 1; i < threadsNum; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
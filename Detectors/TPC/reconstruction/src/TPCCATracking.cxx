@@ -70,6 +70,7 @@ void TPCCATracking::deinitialize()
 int TPCCATracking::runTracking(const ClusterNativeAccessFullTPC& clusters, std::vector<TrackTPC>* outputTracks,
                                MCLabelContainer* outputTracksMCTruth)
 {
+  std::lock_guard<std::mutex> lock(mTrackingMutex);
   const static ParameterDetector& detParam = ParameterDetector::defaultInstance();
   const static ParameterGas& gasParam = ParameterGas::defaultInstance();
   const static ParameterElectronics& elParam = ParameterElectronics::defaultInstance();
@@ -194,7 +195,14 @@ int TPCCATracking::runTracking(const ClusterNativeAccessFullTPC& clusters, std::
                                   cl.getPad(), cl.getSigmaPad(), cl.getTime(), cl.getSigmaTime()));
         oTrack.setClusterReference(j, sector, globalRow, clusterId);
         if (outputTracksMCTruth) {
-          for (const auto& element : clusters.clustersMCTruth[sector][globalRow]->getLabels(clusterId)) {
+          // the labels are either in a container per row or in a flat view per sector
+          gsl::span<const MCCompLabel> clusterLabels;
+          if (clusters.clustersMCTruthView[sector]) {
+            clusterLabels = clusters.clustersMCTruthView[sector]->getLabels(clusters.clusterOffset[sector][globalRow] + clusterId);
+          } else {
+            clusterLabels = clusters.clustersMCTruth[sector][globalRow]->getLabels(clusterId);
+          }
+          for (const auto& element : clusterLabels) {
             bool found = false;
             for (int l = 0; l < labels.size(); l++) {
               if (labels[l].first == element) {
@@ -232,6 +240,14 @@ int TPCCATracking::runTracking(const ClusterNativeAccessFullTPC& clusters, std::
   return (retVal);
 }
 
+std::future<int> TPCCATracking::runTrackingAsync(const ClusterNativeAccessFullTPC& clusters, std::vector<TrackTPC>* outputTracks,
+                                                 MCLabelContainer* outputTracksMCTruth)
+{
+  return std::async(std::launch::async, [this, &clusters, outputTracks, outputTracksMCTruth]() {
+    return runTracking(clusters, outputTracks, outputTracksMCTruth);
+  });
+}
+
 float TPCCATracking::getPseudoVDrift()
 {
   const static ParameterGas& gasParam = ParameterGas::defaultInstance();
@@ -24,6 +24,16 @@
 #include "Riostream.h"
 #include "FairLogger.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace ali_tpc_common::tpc_fast_transformation;
 
 namespace o2
@@ -166,6 +176,113 @@ std::unique_ptr<TPCFastTransform> TPCFastTransformHelperO2::create(Long_t TimeSt
   return std::move(fastTransformPtr);
 }
 
+namespace
+{
+// layout of the shared memory segment of createShared: this header, the image of the
+// TPCFastTransform object of the creator, and the flat buffer
+struct SharedTransformHeader {
+  static constexpr uint64_t MAGIC = 0x5450434654726631; // "TPCFTrf1"
+  std::atomic<uint64_t> magic;                          // set once the segment is complete
+  uint64_t objectSize;
+  uint64_t bufferOffset;
+  uint64_t bufferSize;
+};
+constexpr size_t alignBuffer(size_t size) { return (size + 63) & ~size_t(63); }
+
+// a process local object for the image of the transformation in the segment: the object is copied, as
+// for the transfer to a GPU, and its pointers are relocated to the shared flat buffer of this process
+std::unique_ptr<TPCFastTransform> attachTransform(char* segment)
+{
+  auto header = reinterpret_cast<SharedTransformHeader*>(segment);
+  std::unique_ptr<TPCFastTransform> fastTransform(new TPCFastTransform);
+  std::memcpy((void*)fastTransform.get(), segment + sizeof(SharedTransformHeader), sizeof(TPCFastTransform));
+  fastTransform->setActualBufferAddress(segment + header->bufferOffset);
+  return fastTransform;
+}
+} // namespace
+
+std::unique_ptr<TPCFastTransform> TPCFastTransformHelperO2::createShared(Long_t TimeStamp, const std::string& name)
+{
+  /// creates or attaches to the shared TPCFastTransform object
+
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd >= 0) {
+    // this process creates the segment
+    auto fastTransform = create(TimeStamp);
+    const size_t bufferOffset = alignBuffer(sizeof(SharedTransformHeader) + sizeof(TPCFastTransform));
+    const size_t size = bufferOffset + fastTransform->getFlatBufferSize();
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, size) == 0) {
+      memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED) {
+      LOG(ERROR) << "can not set up the shared memory segment " << name << " of the TPC transformation, using a local one";
+      shm_unlink(name.c_str());
+      return fastTransform;
+    }
+    auto segment = reinterpret_cast<char*>(memory);
+    auto header = new (segment) SharedTransformHeader;
+    header->magic.store(0);
+    header->objectSize = sizeof(TPCFastTransform);
+    header->bufferOffset = bufferOffset;
+    header->bufferSize = fastTransform->getFlatBufferSize();
+    std::memcpy(segment + sizeof(SharedTransformHeader), (const void*)fastTransform.get(), sizeof(TPCFastTransform));
+    std::memcpy(segment + bufferOffset, fastTransform->getFlatBufferPtr(), header->bufferSize);
+    header->magic.store(SharedTransformHeader::MAGIC, std::memory_order_release);
+    // the mapping stays for the lifetime of the process
+    return attachTransform(segment);
+  }
+
+  // another process creates the segment, wait until it is complete
+  fd = shm_open(name.c_str(), O_RDWR, 0);
+  void* memory = MAP_FAILED;
+  size_t size = 0;
+  if (fd >= 0) {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    struct stat st;
+    while (fstat(fd, &st) == 0 && st.st_size < (off_t)sizeof(SharedTransformHeader) && std::chrono::steady_clock::now() < timeout) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(SharedTransformHeader)) {
+      size = st.st_size;
+      memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory != MAP_FAILED) {
+      auto header = reinterpret_cast<SharedTransformHeader*>(memory);
+      while (header->magic.load(std::memory_order_acquire) != SharedTransformHeader::MAGIC && std::chrono::steady_clock::now() < timeout) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      if (header->magic.load(std::memory_order_acquire) == SharedTransformHeader::MAGIC && header->objectSize == sizeof(TPCFastTransform) &&
+          header->bufferOffset + header->bufferSize <= size) {
+        return attachTransform(reinterpret_cast<char*>(memory));
+      }
+      munmap(memory, size);
+    }
+  }
+  LOG(ERROR) << "can not attach to the shared memory segment " << name << " of the TPC transformation, using a local one";
+  return create(TimeStamp);
+}
+
+void TPCFastTransformHelperO2::removeShared(const std::string& name)
+{
+  shm_unlink(name.c_str());
+}
+
+int TPCFastTransformHelperO2::transform(const TPCFastTransform& transform, int sector, int row, gsl::span<const float> pad, gsl::span<const float> time,
+                                        gsl::span<float> x, gsl::span<float> y, gsl::span<float> z)
+{
+  /// transforms the clusters of a row
+
+  const size_t n = std::min({ pad.size(), time.size(), x.size(), y.size(), z.size() });
+  int nFailed = 0;
+  for (size_t i = 0; i < n; i++) {
+    nFailed += transform.Transform(sector, row, pad[i], time[i], x[i], y[i], z[i]) != 0;
+  }
+  return nFailed;
+}
+
 int TPCFastTransformHelperO2::updateCalibration(ali_tpc_common::tpc_fast_transformation::TPCFastTransform& fastTransform, Long_t TimeStamp)
 {
   // Update the calibration with the new time stamp
@@ -0,0 +1,60 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_GBTFrameDecoding.cxx
+/// \brief  Benchmark of the GBT frame halfword extraction of the RawReaderCRU
+
+#include "benchmark/benchmark.h"
+#include <array>
+#include <random>
+#include <vector>
+#include "TPCReconstruction/RawReaderCRU.h"
+
+using GBTFrame = o2::TPC::RawReaderCRU::GBTFrame;
+
+std::vector<GBTFrame> generateFrames(size_t nFrames)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint32_t> dist;
+  std::vector<GBTFrame> frames(nFrames);
+  for (auto& frame : frames) {
+    frame.setData({ dist(gen), dist(gen), dist(gen), dist(gen) });
+  }
+  return frames;
+}
+
+static void BM_GBTFrameHalfWords(benchmark::State& state)
+{
+  auto frames = generateFrames(state.range(0));
+  for (auto _ : state) {
+    for (auto& frame : frames) {
+      frame.getFrameHalfWords();
+      benchmark::DoNotOptimize(frame);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * frames.size());
+}
+
+static void BM_GBTFrameHalfWordsReference(benchmark::State& state)
+{
+  auto frames = generateFrames(state.range(0));
+  for (auto _ : state) {
+    for (auto& frame : frames) {
+      frame.getFrameHalfWordsReference();
+      benchmark::DoNotOptimize(frame);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * frames.size());
+}
+
+BENCHMARK(BM_GBTFrameHalfWords)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_GBTFrameHalfWordsReference)->Arg(1 << 10)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
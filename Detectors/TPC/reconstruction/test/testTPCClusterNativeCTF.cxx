@@ -0,0 +1,127 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCClusterNativeCTF.cxx
+/// \brief This task tests the compressed time frame coder of the TPC native clusters
+
+#define BOOST_TEST_MODULE Test TPC ClusterNativeCTF
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCReconstruction/ClusterNativeCTF.h"
+#include "DataFormatsTPC/ClusterNative.h"
+#include "DataFormatsTPC/ClusterGroupAttribute.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace o2
+{
+namespace TPC
+{
+
+// flat buffer of ClusterNativeBuffer blocks of one sector, with sorted clusters
+std::vector<char> createSectorBuffer(int sector, std::mt19937& generator)
+{
+  std::vector<char> buffer;
+  std::exponential_distribution<float> charge(0.02);
+  std::normal_distribution<float> sigma(1.5, 0.3);
+  std::uniform_real_distribution<float> time(0., 100000.);
+  std::uniform_real_distribution<float> pad(0., 140.);
+  for (int padRow = 0; padRow < Constants::MAXGLOBALPADROW; padRow += 3) {
+    std::vector<ClusterNative> clusters(50 + padRow);
+    for (auto& cluster : clusters) {
+      cluster.setTimeFlags(time(generator), padRow % 4);
+      cluster.setPad(pad(generator));
+      cluster.setSigmaTime(sigma(generator));
+      cluster.setSigmaPad(sigma(generator));
+      cluster.qTot = 10 + charge(generator);
+      cluster.qMax = std::min<int>(cluster.qTot, 5 + charge(generator) / 4);
+    }
+    std::sort(clusters.begin(), clusters.end());
+    ClusterGroupHeader header{ ClusterGroupAttribute{ uint8_t(sector), uint8_t(padRow) }, uint16_t(clusters.size()) };
+    auto position = buffer.size();
+    buffer.resize(position + sizeof(header) + clusters.size() * sizeof(ClusterNative));
+    std::memcpy(buffer.data() + position, &header, sizeof(header));
+    std::memcpy(buffer.data() + position + sizeof(header), clusters.data(), clusters.size() * sizeof(ClusterNative));
+  }
+  return buffer;
+}
+
+BOOST_AUTO_TEST_CASE(ClusterNativeCTF_lossless)
+{
+  std::mt19937 generator(1);
+  ClusterNativeCTFCoder coder;
+  std::array<std::vector<char>, ClusterNativeCTFCoder::NSectors> buffers;
+  std::array<gsl::span<const char>, ClusterNativeCTFCoder::NSectors> inputs;
+  size_t inputSize = 0;
+  for (int sector : { 0, 5, 17, 35 }) {
+    buffers[sector] = createSectorBuffer(sector, generator);
+    inputs[sector] = gsl::span<const char>(buffers[sector].data(), buffers[sector].size());
+    inputSize += buffers[sector].size();
+  }
+
+  // two CTFs in one buffer, as in a file
+  std::vector<char> ctf;
+  auto nClusters = coder.encode(inputs, ctf);
+  auto ctfSize = ctf.size();
+  BOOST_CHECK(nClusters > 0);
+  std::cout << "CTF: " << ctfSize << " bytes for " << inputSize << " bytes of clusters" << std::endl;
+  BOOST_CHECK(ctfSize < inputSize);
+  BOOST_CHECK_EQUAL(coder.encode(inputs, ctf), nClusters);
+  BOOST_CHECK_EQUAL(ClusterNativeCTFCoder::checkCTF(gsl::span<const char>(ctf.data(), ctf.size())), ctfSize);
+
+  std::array<std::vector<char>, ClusterNativeCTFCoder::NSectors> outputs;
+  BOOST_CHECK_EQUAL(coder.decode(gsl::span<const char>(ctf.data() + ctfSize, ctf.size() - ctfSize), outputs), nClusters);
+  for (size_t sector = 0; sector < ClusterNativeCTFCoder::NSectors; sector++) {
+    BOOST_CHECK(outputs[sector] == buffers[sector]);
+  }
+
+  ctf.resize(ctfSize - 8);
+  BOOST_CHECK_THROW(coder.decode(gsl::span<const char>(ctf.data(), ctf.size()), outputs), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(ClusterNativeCTF_truncated)
+{
+  std::mt19937 generator(2);
+  auto buffer = createSectorBuffer(3, generator);
+  ClusterNativeCTFCoder coder;
+  coder.setTruncatedBits(ClusterNativeCTFCoder::Pad, 2);
+  coder.setTruncatedBits(ClusterNativeCTFCoder::QTot, 1);
+  BOOST_CHECK_THROW(coder.setTruncatedBits(ClusterNativeCTFCoder::Flags, 1), std::invalid_argument);
+
+  std::vector<char> block;
+  auto nClusters = coder.encodeSector(3, gsl::span<const char>(buffer.data(), buffer.size()), block);
+  std::vector<char> output;
+  BOOST_CHECK_EQUAL(coder.decodeSector(gsl::span<const char>(block.data(), block.size()), output), nClusters);
+  BOOST_REQUIRE_EQUAL(output.size(), buffer.size());
+
+  // the clusters stay in place, the truncated attributes are within the precision
+  size_t position = 0;
+  while (position < buffer.size()) {
+    const auto& header = *reinterpret_cast<const ClusterGroupHeader*>(buffer.data() + position);
+    position += sizeof(ClusterGroupHeader);
+    for (int i = 0; i < header.nClusters; i++, position += sizeof(ClusterNative)) {
+      const auto& original = *reinterpret_cast<const ClusterNative*>(buffer.data() + position);
+      const auto& decoded = *reinterpret_cast<const ClusterNative*>(output.data() + position);
+      BOOST_CHECK_EQUAL(decoded.getTimePacked(), original.getTimePacked());
+      BOOST_CHECK_EQUAL(decoded.getFlags(), original.getFlags());
+      BOOST_CHECK(std::abs(int(decoded.padPacked) - int(original.padPacked)) <= 2);
+      BOOST_CHECK(std::abs(int(decoded.qTot) - int(original.qTot)) <= 1);
+      BOOST_CHECK_EQUAL(decoded.qMax, original.qMax);
+    }
+  }
+}
+
+} // namespace TPC
+} // namespace o2
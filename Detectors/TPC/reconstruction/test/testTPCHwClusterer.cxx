@@ -20,6 +20,7 @@
 #include "TPCBase/Digit.h"
 #include "TPCBase/Mapper.h"
 #include "TPCReconstruction/HwClusterer.h"
+#include "TPCReconstruction/HwClustererDriver.h"
 
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include "SimulationDataFormat/MCCompLabel.h"
@@ -999,5 +1000,112 @@ BOOST_AUTO_TEST_CASE(HwClusterer_test6)
   std::cout << "##" << std::endl
             << std::endl;
 }
+
+/// @brief Test 7 parallel processing of several sectors
+BOOST_AUTO_TEST_CASE(HwClusterer_test7)
+{
+  std::cout << "##" << std::endl;
+  std::cout << "## Starting test 7, parallel processing of sectors." << std::endl;
+  using MCLabelContainer = o2::dataformats::MCTruthContainer<o2::MCCompLabel>;
+
+  HwClustererDriver driver(4, true);
+  driver.setConfigurator([](HwClusterer& clusterer) { clusterer.setContinuousReadout(false); });
+
+  // same digits as in test 1, in the first region of each sector
+  const int nSectors = 12;
+  std::vector<std::vector<Digit>> digits(nSectors);
+  std::vector<MCLabelContainer> labels(nSectors);
+  std::vector<HwClustererDriver::SectorInput> inputs;
+  for (int sector = 0; sector < nSectors; ++sector) {
+    digits[sector].emplace_back(sector * 10, 123, 13, 4, 2);
+    digits[sector].emplace_back(sector * 10, 12, 13, 5, 2);
+    digits[sector].emplace_back(sector * 10, 321, 7, 10, 10);
+    labels[sector].addElement(0, 1);
+    labels[sector].addElement(1, 2);
+    labels[sector].addElement(2, 3);
+    inputs.push_back({ sector, &digits[sector], &labels[sector] });
+  }
+
+  // process twice to check that the outputs are cleared
+  for (int iteration = 0; iteration < 2; ++iteration) {
+    driver.process(inputs);
+    for (int sector = 0; sector < nSectors; ++sector) {
+      auto const& clusterArray = driver.getClusters(sector);
+      auto const& labelArray = driver.getLabels(sector);
+      BOOST_REQUIRE_EQUAL(clusterArray.size(), 1);
+      BOOST_CHECK_EQUAL(clusterArray[0].getContainer()->CRU, sector * 10);
+      BOOST_CHECK_EQUAL(clusterArray[0].getContainer()->numberOfClusters, 2);
+      BOOST_CHECK_EQUAL(clusterArray[0].getContainer()->clusters[0].getQMax(), 123);
+      BOOST_CHECK_EQUAL(clusterArray[0].getContainer()->clusters[1].getQMax(), 321);
+      BOOST_CHECK_EQUAL(labelArray.getIndexedSize(), 2);
+      BOOST_CHECK_EQUAL(labelArray.getLabels(0).size(), 2);
+      BOOST_CHECK_EQUAL(labelArray.getLabels(1)[0].getTrackID(), 3);
+    }
+  }
+
+  // a sector can only be scheduled once
+  inputs.push_back(inputs.front());
+  BOOST_CHECK_THROW(driver.process(inputs), std::runtime_error);
+
+  std::cout << "## Test 7 done." << std::endl;
+  std::cout << "##" << std::endl
+            << std::endl;
+}
+
+/// @brief Test 8 streaming signals without digits
+BOOST_AUTO_TEST_CASE(HwClusterer_test8)
+{
+  std::cout << "##" << std::endl;
+  std::cout << "## Starting test 8, processing of signals." << std::endl;
+  auto clusterArrayDigits = std::make_unique<std::vector<ClusterHardwareContainer8kb>>();
+  auto clusterArraySignals = std::make_unique<std::vector<ClusterHardwareContainer8kb>>();
+
+  HwClusterer clustererDigits(clusterArrayDigits.get(), 0);
+  HwClusterer clustererSignals(clusterArraySignals.get(), 0);
+
+  // the same input as digits and as signals, the signals are pushed
+  // time bin by time bin
+  std::vector<Digit> digits;
+  std::vector<HwClusterer::Signal> signals;
+  for (int time = 0; time < 20; time += 5) {
+    digits.emplace_back(0, 123, 13, 4, time);
+    digits.emplace_back(0, 12, 13, 5, time);
+    digits.emplace_back(0, 321, 7, 10, time + 1);
+    signals.push_back({ 13, 4, time, 123 });
+    signals.push_back({ 13, 5, time, 12 });
+    signals.push_back({ 7, 10, time + 1, 321 });
+  }
+
+  clustererDigits.process(digits, nullptr);
+  clustererDigits.finishProcess(std::vector<Digit>(), nullptr, false);
+
+  size_t first = 0;
+  for (size_t i = 1; i <= signals.size(); ++i) {
+    if (i == signals.size() || signals[i].time != signals[first].time) {
+      clustererSignals.processSignals(gsl::span<const HwClusterer::Signal>(&signals[first], i - first), first == 0);
+      first = i;
+    }
+  }
+  clustererSignals.finishProcess(std::vector<Digit>(), nullptr, false);
+
+  BOOST_REQUIRE_EQUAL(clusterArrayDigits->size(), clusterArraySignals->size());
+  for (size_t c = 0; c < clusterArrayDigits->size(); ++c) {
+    auto const* contDigits = clusterArrayDigits->at(c).getContainer();
+    auto const* contSignals = clusterArraySignals->at(c).getContainer();
+    BOOST_CHECK_EQUAL(contSignals->CRU, contDigits->CRU);
+    BOOST_REQUIRE_EQUAL(contSignals->numberOfClusters, contDigits->numberOfClusters);
+    for (int cl = 0; cl < contDigits->numberOfClusters; ++cl) {
+      BOOST_CHECK_EQUAL(contSignals->clusters[cl].getRow(), contDigits->clusters[cl].getRow());
+      BOOST_CHECK_EQUAL(contSignals->clusters[cl].getQMax(), contDigits->clusters[cl].getQMax());
+      BOOST_CHECK_EQUAL(contSignals->clusters[cl].getQTot(), contDigits->clusters[cl].getQTot());
+      BOOST_CHECK_EQUAL(contSignals->clusters[cl].getTimeLocal(), contDigits->clusters[cl].getTimeLocal());
+    }
+  }
+  BOOST_CHECK(clusterArraySignals->size() > 0);
+
+  std::cout << "## Test 8 done." << std::endl;
+  std::cout << "##" << std::endl
+            << std::endl;
+}
 }
 }
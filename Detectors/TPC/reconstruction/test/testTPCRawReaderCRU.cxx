@@ -0,0 +1,69 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCRawReaderCRU.cxx
+/// \brief This task tests the GBT frame decoding of the RawReaderCRU
+
+#define BOOST_TEST_MODULE Test TPC RawReaderCRU
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCReconstruction/RawReaderCRU.h"
+
+#include <array>
+#include <random>
+
+namespace o2
+{
+namespace TPC
+{
+
+using GBTFrame = RawReaderCRU::GBTFrame;
+
+/// @brief Test 1 compare the halfword extraction with the bit-by-bit reference
+BOOST_AUTO_TEST_CASE(RawReaderCRU_GBTFrame_test1)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint32_t> dist;
+
+  GBTFrame frame;
+  GBTFrame reference;
+  for (int iFrame = 0; iFrame < 1000; ++iFrame) {
+    const std::array<uint32_t, 4> data{ dist(gen), dist(gen), dist(gen), dist(gen) };
+    frame.setData(data);
+    reference.setData(data);
+    frame.getFrameHalfWords();
+    reference.getFrameHalfWordsReference();
+    for (int s = 0; s < 5; ++s) {
+      for (int h = 0; h < 4; ++h) {
+        BOOST_CHECK_EQUAL(frame.getFrameHalfWord(s, h), reference.getFrameHalfWord(s, h));
+      }
+    }
+  }
+}
+
+/// @brief Test 2 single bits end up in the expected halfword
+BOOST_AUTO_TEST_CASE(RawReaderCRU_GBTFrame_test2)
+{
+  GBTFrame frame;
+  // bit 19 is the MSB of halfword 0 of stream 0, bit 107 the MSB of halfword 0 of stream 4
+  frame.setData({ 1u << 19, 0, 0, 1u << 11 });
+  frame.getFrameHalfWords();
+  BOOST_CHECK_EQUAL(frame.getFrameHalfWord(0, 0), 0x10);
+  BOOST_CHECK_EQUAL(frame.getFrameHalfWord(4, 0), 0x10);
+  for (int s = 1; s < 4; ++s) {
+    for (int h = 0; h < 4; ++h) {
+      BOOST_CHECK_EQUAL(frame.getFrameHalfWord(s, h), 0);
+    }
+  }
+}
+
+} // namespace TPC
+} // namespace o2
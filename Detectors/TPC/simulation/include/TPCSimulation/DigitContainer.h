@@ -16,6 +16,8 @@
 #define ALICEO2_TPC_DigitContainer_H_
 
 #include <deque>
+#include <memory>
+#include <vector>
 #include "TPCBase/CRU.h"
 #include "DataFormatsTPC/Defs.h"
 #include "TPCSimulation/DigitTime.h"
@@ -36,6 +38,9 @@ class DigitMCMetaData;
 /// sorted into after amplification
 /// The structure assures proper sorting of the Digits when later on written out for further processing.
 /// This class holds the CRU containers.
+/// The time bins are kept in a ring of pooled DigitTime objects: flushed time bins are reset and returned to a pool
+/// from which new time bins are served, such that in continuous readout no per-time-bin allocations are needed once
+/// the pool has grown to the size required by the drift time.
 
 class DigitContainer
 {
@@ -79,13 +84,23 @@ class DigitContainer
   TimeBin mEffectiveTimeBin = 0;          ///< Effective time bin of that digit
   TimeBin mTmaxTriggered = 0;             ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
   TimeBin mOffset = 600;                  ///< Size of the container for one event
-  std::deque<DigitTime> mTimeBins{ 600 }; ///< Time bin Container for the ADC value
+  std::deque<std::unique_ptr<DigitTime>> mTimeBins;     ///< Time bin Container for the ADC value
+  std::vector<std::unique_ptr<DigitTime>> mTimeBinPool; ///< Flushed time bins available for reuse
+
+  /// Get a reset time bin, either from the pool or newly allocated
+  std::unique_ptr<DigitTime> acquireTimeBin();
+
+  /// Reset a flushed time bin and return it to the pool
+  void releaseTimeBin(std::unique_ptr<DigitTime> time);
 };
 
 inline DigitContainer::DigitContainer()
 {
   const static ParameterDetector& detParam = ParameterDetector::defaultInstance();
   mTmaxTriggered = detParam.getMaxTimeBinTriggered();
+  for (TimeBin i = 0; i < mOffset; ++i) {
+    mTimeBins.emplace_back(std::make_unique<DigitTime>());
+  }
 }
 
 inline void DigitContainer::reset()
@@ -93,22 +108,38 @@ inline void DigitContainer::reset()
   mFirstTimeBin = 0;
   mEffectiveTimeBin = 0;
   for (auto& time : mTimeBins) {
-    time.reset();
+    time->reset();
   }
 }
 
 inline void DigitContainer::reserve(TimeBin eventTimeBin)
 {
-  if (mTimeBins.size() < mOffset + eventTimeBin - mFirstTimeBin) {
-    mTimeBins.resize(mOffset + eventTimeBin - mFirstTimeBin);
+  while (mTimeBins.size() < mOffset + eventTimeBin - mFirstTimeBin) {
+    mTimeBins.emplace_back(acquireTimeBin());
+  }
+}
+
+inline std::unique_ptr<DigitTime> DigitContainer::acquireTimeBin()
+{
+  if (mTimeBinPool.empty()) {
+    return std::make_unique<DigitTime>();
   }
+  auto time = std::move(mTimeBinPool.back());
+  mTimeBinPool.pop_back();
+  return time;
+}
+
+inline void DigitContainer::releaseTimeBin(std::unique_ptr<DigitTime> time)
+{
+  time->reset();
+  mTimeBinPool.emplace_back(std::move(time));
 }
 
 inline void DigitContainer::addDigit(const MCCompLabel& label, const CRU& cru, TimeBin timeBin, GlobalPadNumber globalPad,
                                      float signal)
 {
   mEffectiveTimeBin = timeBin - mFirstTimeBin;
-  mTimeBins[mEffectiveTimeBin].addDigit(label, cru, globalPad, signal);
+  mTimeBins[mEffectiveTimeBin]->addDigit(label, cru, globalPad, signal);
 }
 
 } // namespace TPC
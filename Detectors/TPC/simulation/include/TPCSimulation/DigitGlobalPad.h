@@ -82,6 +82,17 @@ class DigitGlobalPad
                            o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labelContainer,
                            float commonMode = 0.f);
 
+  /// Write out the digit and its MC labels, once the signal processing is done
+  /// \param output Output container
+  /// \param mcTruth MC Truth container
+  /// \param cru CRU ID
+  /// \param timeBin Time bin
+  /// \param globalPad Global pad ID
+  /// \param ADC ADC value after application of noise, pedestal and saturation
+  void writeDigit(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth,
+                  const CRU& cru, TimeBin timeBin, GlobalPadNumber globalPad,
+                  o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labelContainer, float ADC);
+
  private:
   /// Compare two MC labels regarding trackID, eventID and sourceID
   /// \param label1 MC label 1
@@ -117,6 +128,7 @@ inline void DigitGlobalPad::addDigit(const MCCompLabel& label, float signal,
 inline void DigitGlobalPad::reset()
 {
   mChargePad = 0;
+  mID = -1;
 }
 
 inline bool DigitGlobalPad::compareMClabels(const MCCompLabel& label1, const MCCompLabel& label2) const
@@ -135,10 +147,7 @@ inline void DigitGlobalPad::fillOutputContainer(std::vector<Digit>& output,
                                                 o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels,
                                                 float commonMode)
 {
-  const static Mapper& mapper = Mapper::instance();
   static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
-  const PadPos pad = mapper.padPos(globalPad);
-  static std::vector<std::pair<MCCompLabel, int>> labelCollector; // static workspace container for sorting
 
   /// The charge accumulated on that pad is converted into ADC counts, saturation of the SAMPA is applied and a Digit
   /// is created in written out
@@ -147,6 +156,16 @@ inline void DigitGlobalPad::fillOutputContainer(std::vector<Digit>& output,
 
   float noise, pedestal;
   const float mADC = sampaProcessing.makeSignal<MODE>(totalADC, cru.sector(), globalPad, pedestal, noise);
+  writeDigit(output, mcTruth, cru, timeBin, globalPad, labels, mADC);
+}
+
+inline void DigitGlobalPad::writeDigit(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth,
+                                       const CRU& cru, TimeBin timeBin, GlobalPadNumber globalPad,
+                                       o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels,
+                                       float mADC)
+{
+  const static Mapper& mapper = Mapper::instance();
+  static std::vector<std::pair<MCCompLabel, int>> labelCollector; // static workspace container for sorting
 
   /// only write out the data if there is actually charge on that pad
   if (mADC > 0 && mChargePad > 0) {
@@ -154,7 +173,7 @@ inline void DigitGlobalPad::fillOutputContainer(std::vector<Digit>& output,
 
     /// Write out the Digit
     const auto digiPos = output.size();
-    output.emplace_back(cru, mADC, pad.getRow(), pad.getPad(), timeBin); /// create Digit and append to container
+    output.emplace_back(cru, mADC, mapper.getPadRow(globalPad), mapper.getPadInRow(globalPad), timeBin); /// create Digit and append to container
 
     labelCollector.clear();
     for (auto& mcLabel : labelview) {
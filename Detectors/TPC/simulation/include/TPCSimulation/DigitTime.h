@@ -19,6 +19,9 @@
 #include "TPCSimulation/DigitGlobalPad.h"
 #include "SimulationDataFormat/LabelContainer.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace o2
 {
 namespace TPC
@@ -43,6 +46,8 @@ class DigitTime
   ~DigitTime() = default;
 
   /// Resets the container
+  /// Only the pads which received a signal are touched, such that the container can be cheaply reused for another
+  /// time bin
   void reset();
 
   /// Get common mode for a given GEM stack
@@ -74,13 +79,14 @@ class DigitTime
   int mDigitCounter = 0;                                             ///< counts the number of digits in this timebin
 
   o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false> mLabels;
-  // std::deque<int> mOccupiedPads; // iterable container of occupied pads
+  std::vector<GlobalPadNumber> mOccupiedPads;                        ///< pads which received a signal in this time bin
 };
 
 inline DigitTime::DigitTime() : mCommonMode(), mGlobalPads()
 {
   mCommonMode.fill(0);
   mLabels.reserve(Mapper::getPadsInSector() / 3);
+  mOccupiedPads.reserve(Mapper::getPadsInSector() / 3);
 }
 
 inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal)
@@ -89,7 +95,7 @@ inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, Global
   if (paddigit.getID() == -1) {
     // this means we have a new digit
     paddigit.setID(mDigitCounter++);
-    // could also register this pad in a vector of digits
+    mOccupiedPads.emplace_back(globalPad);
   }
   paddigit.addDigit(label, signal, mLabels);
   mCommonMode[cru.gemStack()] += signal;
@@ -97,9 +103,12 @@ inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, Global
 
 inline void DigitTime::reset()
 {
-  for (auto& pad : mGlobalPads) {
-    pad.reset();
+  for (const auto globalPad : mOccupiedPads) {
+    mGlobalPads[globalPad].reset();
   }
+  mOccupiedPads.clear();
+  mLabels.clear();
+  mDigitCounter = 0;
   mCommonMode.fill(0);
 }
 
@@ -118,13 +127,33 @@ inline void DigitTime::fillOutputContainer(std::vector<Digit>& output, dataforma
                                            float commonMode)
 {
   static Mapper& mapper = Mapper::instance();
-  GlobalPadNumber globalPad = 0;
-  for (auto& pad : mGlobalPads) {
+  static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
+  static std::vector<GlobalPadNumber> pads; // static workspace containers for the batched signal processing
+  static std::vector<CRU> crus;
+  static std::vector<float> signals;
+
+  /// only the occupied pads are visited, sorted to write out the digits ordered in the global pad number,
+  /// i.e. row by row
+  std::sort(mOccupiedPads.begin(), mOccupiedPads.end());
+  pads.clear();
+  crus.clear();
+  signals.clear();
+  for (const auto globalPad : mOccupiedPads) {
+    const auto& pad = mGlobalPads[globalPad];
     if (pad.getChargePad() > 0.) {
-      const int cru = mapper.getCRU(sector, globalPad);
-      pad.fillOutputContainer<MODE>(output, mcTruth, cru, timeBin, globalPad, mLabels, getCommonMode(cru));
+      const CRU cru = mapper.getCRU(sector, globalPad);
+      pads.emplace_back(globalPad);
+      crus.emplace_back(cru);
+      /// common mode is subtracted here in order to properly apply noise, pedestals and saturation of the SAMPA
+      signals.emplace_back(pad.getChargePad() - getCommonMode(cru));
     }
-    ++globalPad;
+  }
+
+  /// noise, pedestal and saturation are applied to all pads at once
+  sampaProcessing.makeSignal<MODE>(signals.data(), sector, pads.data(), pads.size());
+
+  for (size_t i = 0; i < pads.size(); ++i) {
+    mGlobalPads[pads[i]].writeDigit(output, mcTruth, crus[i], timeBin, pads[i], mLabels, signals[i]);
   }
 }
 } // namespace TPC
@@ -110,7 +110,42 @@ class Digitizer
   /// \param nRBins number of grid points in r, must be (2**N)+1
   void enableSCDistortions(SpaceCharge::SCDistortionType distortionType, TH3* hisInitialSCDensity, int nZSlices, int nPhiBins, int nRBins);
 
+  /// Enable the use of constant space-charge distortions from a precomputed lookup table
+  /// \param table distortion lookup table, e.g. read with DistortionLookupTable::readFromFile
+  void setSCDistortionLookupTable(DistortionLookupTable&& table);
+
+  /// Switch for the batched electron transport
+  /// In the batched mode the electrons of each hit are drifted and amplified together, drawing the random numbers in
+  /// bulk and computing the transport in SIMD registers, before the signals are added to the DigitContainer
+  /// \param useBatched - true for batched transport, false for the electron-by-electron transport
+  void setUseBatchedTransport(bool useBatched) { mUseBatchedTransport = useBatched; }
+
+  /// Option to retrieve whether the batched electron transport is used
+  bool isUseBatchedTransport() const { return mUseBatchedTransport; }
+
  private:
+  /// Transport, amplification and signal formation of all electrons of a hit in batches
+  /// \param posEle Start position of the electrons
+  /// \param nElectrons Number of primary electrons of the hit
+  /// \param hitTime Time of the hit in us
+  /// \param label MC label of the hit
+  void processElectronsBatched(const GlobalPosition3D& posEle, const int nElectrons, const float hitTime,
+                               const MCCompLabel& label);
+
+  /// Find the pad an electron arrives at, rejecting electrons outside the active volume or the current sector
+  /// \param posEleDiff Position of the electron after the drift
+  /// \param digiPadPos DigitPos of the electron
+  /// \return true if the electron arrives on a valid pad of the current sector
+  bool findDigitPos(const GlobalPosition3D& posEleDiff, DigitPos& digiPadPos) const;
+
+  /// Shape the signal of an amplified electron and add it to the DigitContainer
+  /// \param label MC label of the electron
+  /// \param digiPadPos DigitPos of the electron
+  /// \param absoluteTime Arrival time of the electron in us
+  /// \param nElectronsGEM Number of electrons after amplification
+  void addElectronSignal(const MCCompLabel& label, const DigitPos& digiPadPos, const float absoluteTime,
+                         const int nElectronsGEM);
+
   DigitContainer mDigitContainer;                   ///< Container for the Digits
   std::unique_ptr<SpaceCharge> mSpaceChargeHandler; ///< Handler of space-charge distortions
   Sector mSector = -1;                              ///< ID of the currently processed sector
@@ -118,6 +153,7 @@ class Digitizer
   // FIXME: whats the reason for hving this static?
   static bool mIsContinuous;                        ///< Switch for continuous readout
   bool mUseSCDistortions = false;                   ///< Flag to switch on the use of space-charge distortions
+  bool mUseBatchedTransport = false;                ///< Flag to switch on the batched electron transport
 
   ClassDefNV(Digitizer, 1);
 };
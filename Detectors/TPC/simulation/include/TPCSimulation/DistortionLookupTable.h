@@ -0,0 +1,214 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DistortionLookupTable.h
+/// \brief Definition of a compact lookup table for space-charge distortions with trilinear interpolation
+
+#ifndef ALICEO2_TPC_DISTORTIONLOOKUPTABLE_H
+#define ALICEO2_TPC_DISTORTIONLOOKUPTABLE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <gsl/span>
+
+namespace o2
+{
+namespace TPC
+{
+
+/// \class DistortionLookupTable
+/// Lookup table of the electron distortions (dx, dy, dz) on a regular cylindrical grid in (z, phi, r) for both TPC
+/// sides. The table is stored as one flat, position independent buffer: a small header followed by one float array
+/// per distortion component (structure of arrays). The buffer can be written to a file or a CCDB blob and used again
+/// without any copy, e.g. from a memory-mapped file, via the constructor taking a buffer.
+///
+/// The distortions are evaluated by trilinear interpolation between the 8 grid points surrounding the position.
+/// Positions outside the grid are clamped to the closest grid boundary, phi is periodic. The interpolation does
+/// not branch on the position, such that the batched version can be vectorised.
+class DistortionLookupTable
+{
+ public:
+  /// header of the flat buffer
+  struct Header {
+    uint32_t magic = Magic;                 ///< identifier of the format
+    uint16_t version = 1;                   ///< version of the format
+    uint16_t sizeofHeader = sizeof(Header); ///< size of the header in bytes
+    uint32_t nZ = 0;                        ///< number of grid points in z
+    uint32_t nPhi = 0;                      ///< number of grid points in phi
+    uint32_t nR = 0;                        ///< number of grid points in r
+    float rMin = 0.f;                       ///< radius of the first grid point (cm)
+    float rMax = 0.f;                       ///< radius of the last grid point (cm)
+    float zMax = 0.f;                       ///< |z| of the last grid point (cm), the first one is at z = 0
+  };
+
+  static constexpr uint32_t Magic = 0x54444353; ///< 'SCDT'
+  static constexpr int NSides = 2;              ///< A side (z >= 0) and C side (z < 0)
+  static constexpr int NComponents = 3;         ///< dx, dy and dz
+
+  /// Default constructor, creates an empty table
+  DistortionLookupTable() = default;
+
+  /// Constructor of an owning table with all distortions set to zero
+  /// \param nZ number of grid points in z, at least 2
+  /// \param nPhi number of grid points in phi, covering [0, 2pi)
+  /// \param nR number of grid points in r, at least 2
+  /// \param rMin radius of the first grid point (cm)
+  /// \param rMax radius of the last grid point (cm)
+  /// \param zMax |z| of the last grid point (cm)
+  DistortionLookupTable(int nZ, int nPhi, int nR, float rMin, float rMax, float zMax);
+
+  /// Constructor of a table from a flat buffer as returned by getBuffer
+  /// \param buffer flat buffer, the data is copied if copy is true, otherwise the buffer must outlive the table
+  /// \param copy copy the buffer into the table
+  DistortionLookupTable(gsl::span<const char> buffer, bool copy = false);
+
+  DistortionLookupTable(const DistortionLookupTable&) = delete;
+  DistortionLookupTable& operator=(const DistortionLookupTable&) = delete;
+  DistortionLookupTable(DistortionLookupTable&&) = default;
+  DistortionLookupTable& operator=(DistortionLookupTable&&) = default;
+
+  /// \return true if the table contains a grid
+  bool isValid() const { return mHeader != nullptr; }
+
+  /// \return header of the table
+  const Header& getHeader() const { return *mHeader; }
+
+  /// \return flat buffer of the table
+  gsl::span<const char> getBuffer() const { return gsl::span<const char>(reinterpret_cast<const char*>(mHeader), getBufferSize()); }
+
+  /// \return size of the flat buffer in bytes
+  size_t getBufferSize() const { return mHeader ? sizeof(Header) + NComponents * mComponentSize * sizeof(float) : 0; }
+
+  /// Set the distortion of a grid point, only possible for owning tables
+  /// \param side TPC side (0 = A, 1 = C)
+  /// \param iz z index
+  /// \param iphi phi index
+  /// \param ir r index
+  /// \param dx distortion in x
+  /// \param dy distortion in y
+  /// \param dz distortion in z
+  void setDistortion(int side, int iz, int iphi, int ir, float dx, float dy, float dz);
+
+  /// \return global coordinates of a grid point
+  /// \param side TPC side (0 = A, 1 = C)
+  /// \param iz z index
+  /// \param iphi phi index
+  /// \param ir r index
+  /// \param x x coordinate of the grid point
+  /// \param y y coordinate of the grid point
+  /// \param z z coordinate of the grid point
+  void getGridPoint(int side, int iz, int iphi, int ir, float& x, float& y, float& z) const;
+
+  /// Interpolate the distortion at a global position
+  /// \param x global position (x, y, z)
+  /// \param dx distortion (dx, dy, dz)
+  void getDistortion(const float x[3], float dx[3]) const;
+
+  /// Interpolate the distortions of a batch of global positions
+  /// \param n number of positions
+  /// \param x x coordinates
+  /// \param y y coordinates
+  /// \param z z coordinates
+  /// \param dx output distortions in x
+  /// \param dy output distortions in y
+  /// \param dz output distortions in z
+  void getDistortions(size_t n, const float* x, const float* y, const float* z, float* dx, float* dy, float* dz) const;
+
+  /// Write the flat buffer to a binary file
+  /// \param fileName name of the output file
+  void writeToFile(const std::string& fileName) const;
+
+  /// Read a table from a binary file written with writeToFile
+  /// \param fileName name of the input file
+  /// \return owning table
+  static DistortionLookupTable readFromFile(const std::string& fileName);
+
+ private:
+  std::vector<char> mOwnedBuffer;        ///< storage of owning tables
+  const Header* mHeader = nullptr;       ///< header of the flat buffer
+  const float* mData[NComponents] = {};  ///< start of the arrays of the distortion components
+  size_t mComponentSize = 0;             ///< number of values per component
+  float mInvDeltaR = 0.f;                ///< inverse of the r grid spacing
+  float mInvDeltaPhi = 0.f;              ///< inverse of the phi grid spacing
+  float mInvDeltaZ = 0.f;                ///< inverse of the z grid spacing
+
+  /// allocate the owned buffer and write the header
+  void allocate(const Header& header);
+
+  /// set the data pointers for the buffer starting at mHeader
+  void setupPointers();
+
+  /// linear index of a grid point
+  size_t index(int side, int iz, int iphi, int ir) const
+  {
+    return ((static_cast<size_t>(side) * mHeader->nZ + iz) * mHeader->nPhi + iphi) * mHeader->nR + ir;
+  }
+};
+
+inline void DistortionLookupTable::getDistortion(const float x[3], float dx[3]) const
+{
+  constexpr float TwoPI = 6.28318530717958647692f;
+  const int nZ = mHeader->nZ;
+  const int nPhi = mHeader->nPhi;
+  const int nR = mHeader->nR;
+
+  /// fractional grid coordinates, the side is selected arithmetically
+  const int side = x[2] < 0.f;
+  const float r = std::sqrt(x[0] * x[0] + x[1] * x[1]);
+  float phi = std::atan2(x[1], x[0]);
+  phi += (phi < 0.f) * TwoPI;
+  const float fr = std::min(std::max((r - mHeader->rMin) * mInvDeltaR, 0.f), nR - 1.001f);
+  const float fz = std::min(std::abs(x[2]) * mInvDeltaZ, nZ - 1.001f);
+  const float fphi = std::min(phi * mInvDeltaPhi, nPhi - 0.001f);
+
+  const int ir = static_cast<int>(fr);
+  const int iz = static_cast<int>(fz);
+  const int iphi0 = static_cast<int>(fphi);
+  const int iphi1 = iphi0 + 1 - nPhi * (iphi0 + 1 == nPhi);
+  const float wr = fr - ir;
+  const float wz = fz - iz;
+  const float wphi = fphi - iphi0;
+
+  const size_t i00 = index(side, iz, iphi0, ir);
+  const size_t i01 = index(side, iz, iphi1, ir);
+  const size_t i10 = index(side, iz + 1, iphi0, ir);
+  const size_t i11 = index(side, iz + 1, iphi1, ir);
+
+  for (int c = 0; c < NComponents; ++c) {
+    const float* d = mData[c];
+    const float v00 = d[i00] + wr * (d[i00 + 1] - d[i00]);
+    const float v01 = d[i01] + wr * (d[i01 + 1] - d[i01]);
+    const float v10 = d[i10] + wr * (d[i10 + 1] - d[i10]);
+    const float v11 = d[i11] + wr * (d[i11 + 1] - d[i11]);
+    const float v0 = v00 + wphi * (v01 - v00);
+    const float v1 = v10 + wphi * (v11 - v10);
+    dx[c] = v0 + wz * (v1 - v0);
+  }
+}
+
+inline void DistortionLookupTable::getDistortions(size_t n, const float* x, const float* y, const float* z, float* dx, float* dy, float* dz) const
+{
+  for (size_t i = 0; i < n; ++i) {
+    const float pos[3] = { x[i], y[i], z[i] };
+    float dist[3];
+    getDistortion(pos, dist);
+    dx[i] = dist[0];
+    dy[i] = dist[1];
+    dz[i] = dist[2];
+  }
+}
+
+} // namespace TPC
+} // namespace o2
+
+#endif // ALICEO2_TPC_DISTORTIONLOOKUPTABLE_H
@@ -21,6 +21,8 @@
 #include "TPCBase/Mapper.h"
 #include "TPCBase/RandomRing.h"
 
+#include <vector>
+
 namespace o2
 {
 namespace TPC
@@ -34,6 +36,27 @@ namespace TPC
 class ElectronTransport
 {
  public:
+  /// \struct ElectronBatch
+  /// Structure of arrays holding the position and drift time of a batch of electrons after the transport
+  /// The arrays are padded to a multiple of the SIMD width, only the first size electrons are valid
+  struct ElectronBatch {
+    std::vector<float> x;         ///< x position after the drift
+    std::vector<float> y;         ///< y position after the drift
+    std::vector<float> z;         ///< z position after the drift
+    std::vector<float> driftTime; ///< drift time taking into account diffusion in z direction
+    std::vector<float> random;    ///< flat random values used for the attachment
+    size_t size = 0;              ///< number of valid electrons
+
+    void resize(size_t n)
+    {
+      x.resize(n);
+      y.resize(n);
+      z.resize(n);
+      driftTime.resize(n);
+      random.resize(n);
+    }
+  };
+
   static ElectronTransport& instance()
   {
     static ElectronTransport electronTransport;
@@ -52,6 +75,14 @@ class ElectronTransport
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion
   GlobalPosition3D getElectronDrift(GlobalPosition3D posEle, float& driftTime);
 
+  /// Drift of a batch of electrons starting from the same position, taking into account diffusion and attachment
+  /// The random numbers are drawn in bulk and the transport is computed in SIMD registers. The electrons lost by
+  /// attachment are removed from the batch
+  /// \param posEle GlobalPosition3D with start position of the electrons
+  /// \param nElectrons Number of electrons to be drifted
+  /// \param batch ElectronBatch filled with the electrons surviving the drift
+  void getElectronDriftBatch(const GlobalPosition3D& posEle, int nElectrons, ElectronBatch& batch);
+
   /// Drift of electrons in electric field taking into account diffusion with 3 sigma of the width
   /// \param posEle GlobalPosition3D with start position of the electrons
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion with
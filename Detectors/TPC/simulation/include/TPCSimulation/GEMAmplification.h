@@ -22,6 +22,8 @@
 #include "TPCBase/PadPos.h"
 #include "TPCBase/CalDet.h"
 
+#include <vector>
+
 namespace o2
 {
 namespace TPC
@@ -58,6 +60,19 @@ class GEMAmplification
   /// \return Number of electrons after amplification in an  effective single-stage amplification
   int getEffectiveStackAmplification(int nElectrons = 1);
 
+  /// Compute the effective stack amplification for a batch of single electrons
+  /// The random numbers are drawn in bulk and the amplification is computed in SIMD registers
+  /// \param nElectrons Number of electrons arriving at the first amplification stage (GEM1)
+  /// \param amplification Number of electrons after amplification for each of the incoming electrons, padded to a
+  /// multiple of the SIMD width
+  void getEffectiveStackAmplificationBatch(size_t nElectrons, std::vector<float>& amplification);
+
+  /// Local variation of the electron amplification
+  /// \param cru CRU where the electron arrives
+  /// \param pos PadPos where the electron arrives
+  /// \return Relative gain on the pad
+  float getLocalGain(const CRU& cru, const PadPos& pos) const { return mGainMap->getValue(cru, pos.getRow(), pos.getPad()); }
+
   /// Compute the number of electrons after amplification in a full stack of four GEM foils
   /// taking into account local variations of the electron amplification
   /// \param nElectrons Number of electrons arriving at the first amplification stage (GEM1)
@@ -100,6 +115,8 @@ class GEMAmplification
   std::array<RandomRing<>, 4> mGain;
   /// Container with random Polya distributions for the full stack amplification
   RandomRing<> mGainFullStack;
+  /// Scratch buffer for the flat random values of the batched amplification
+  std::vector<float> mRandomFlatBatch;
 
   const ParameterGEM* mGEMParam; ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterGas* mGasParam; ///< Caching of the parameter class to avoid multiple CDB calls
@@ -16,6 +16,7 @@
 #include "SimulationDataFormat/BaseHits.h"
 #include <vector>
 #include <CommonUtils/ShmAllocator.h>
+#include <CommonUtils/CompactHits.h>
 
 namespace o2 {
 namespace TPC {
@@ -213,6 +214,92 @@ Point::Point(float x, float y, float z, float time, float nElectrons, float trac
 {}
 
 } // namespace TPC
+
+namespace utils
+{
+/// compact format of the TPC hit groups: the track id and number of elemental hits of the groups
+/// (integer columns 0-1), the x, y, z and time (fixed columns 0-3) and the energy loss (raw column 0) of
+/// the elemental hits of all the groups
+template <>
+struct CompactHitCodec<o2::TPC::HitGroup> {
+  static constexpr bool available = true;
+
+  template <typename Container>
+  static void split(Container const& groups, HitColumns& columns, CompactHitPrecision const& precision)
+  {
+    size_t nHits = 0;
+    for (auto& group : groups) {
+      nHits += group.getSize();
+    }
+    columns.resize(4, 1, 2);
+    for (size_t c = 0; c < 3; c++) {
+      columns.fixed[c].precision = precision.position;
+      columns.fixed[c].values.reserve(nHits);
+    }
+    columns.fixed[3].precision = precision.time;
+    columns.fixed[3].values.reserve(nHits);
+    columns.raw[0].reserve(nHits);
+    for (auto& group : groups) {
+      columns.ints[0].push_back(group.GetTrackID());
+      columns.ints[1].push_back(group.getSize());
+      for (size_t i = 0; i < group.getSize(); i++) {
+        const auto hit = group.getHit(i);
+        columns.fixed[0].values.push_back(hit.GetX());
+        columns.fixed[1].values.push_back(hit.GetY());
+        columns.fixed[2].values.push_back(hit.GetZ());
+        columns.fixed[3].values.push_back(hit.GetTime());
+        columns.raw[0].push_back(HitColumns::toRaw(hit.GetEnergyLoss()));
+      }
+    }
+  }
+
+  template <typename Container>
+  static bool merge(HitColumns const& columns, Container& groups)
+  {
+    const size_t nGroups = columns.ints[0].size(), nHits = columns.raw[0].size();
+    if (columns.ints[1].size() != nGroups) {
+      return false;
+    }
+    size_t sum = 0;
+    for (auto size : columns.ints[1]) {
+      if (size < 0) {
+        return false;
+      }
+      sum += size;
+    }
+    if (sum != nHits) {
+      return false;
+    }
+    for (auto& column : columns.fixed) {
+      if (column.values.size() != nHits) {
+        return false;
+      }
+    }
+    groups.clear();
+    groups.reserve(nGroups);
+    size_t pos = 0;
+    for (size_t g = 0; g < nGroups; g++) {
+      groups.emplace_back(columns.ints[0][g]);
+      auto& group = groups.back();
+      const size_t end = pos + columns.ints[1][g];
+      for (; pos < end; pos++) {
+        const float e = HitColumns::fromRaw<float>(columns.raw[0][pos]);
+#ifdef HIT_AOS
+        group.mHits.emplace_back(columns.fixed[0].values[pos], columns.fixed[1].values[pos], columns.fixed[2].values[pos],
+                                 columns.fixed[3].values[pos], e);
+#else
+        group.mHitsXVctr.push_back(columns.fixed[0].values[pos]);
+        group.mHitsYVctr.push_back(columns.fixed[1].values[pos]);
+        group.mHitsZVctr.push_back(columns.fixed[2].values[pos]);
+        group.mHitsTVctr.push_back(columns.fixed[3].values[pos]);
+        group.mHitsEVctr.push_back(e);
+#endif
+      }
+    }
+    return true;
+  }
+};
+} // namespace utils
 } // namespace o2
 
 #ifdef USESHM
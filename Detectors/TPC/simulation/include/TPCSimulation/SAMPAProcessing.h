@@ -16,6 +16,7 @@
 #define ALICEO2_TPC_SAMPAProcessing_H_
 
 #include <Vc/Vc>
+#include <vector>
 
 #include "TPCBase/PadPos.h"
 #include "TPCBase/CalDet.h"
@@ -69,6 +70,17 @@ class SAMPAProcessing
   template <DigitzationMode MODE>
   float makeSignal(float ADCcounts, const int sector, const int globalPadInSector, float& pedestal, float& noise);
 
+  /// Make the full signal including noise and pedestals from the OCDB for a batch of pads of one sector (vectorized)
+  /// The pedestal and noise values of the pads are gathered first, such that the signal is then processed as a stream
+  /// The random numbers for the noise are drawn in the same order as for consecutive calls of the scalar version
+  /// \param ADCcounts ADC values of the signal (common mode already subtracted), replaced by the ADC values after
+  ///                  application of noise, pedestal and saturation
+  /// \param sector Sector number
+  /// \param globalPadInSector global pad numbers in the sector
+  /// \param nPads Number of pads in the batch
+  template <DigitzationMode MODE>
+  void makeSignal(float* ADCcounts, const int sector, const GlobalPadNumber* globalPadInSector, size_t nPads);
+
   /// A delta signal is shaped by the FECs and thus spread over several time bins
   /// This function returns an array with the signal spread into the following time bins
   /// \param ADCsignal Signal of the incoming charge
@@ -131,6 +143,8 @@ class SAMPAProcessing
   const CalPad* mNoiseMap;               ///< Caching of the parameter class to avoid multiple CDB calls
   const CalPad* mPedestalMap;            ///< Caching of the parameter class to avoid multiple CDB calls
   RandomRing<> mRandomNoiseRing;         ///< Ring with random number for noise
+  std::vector<float> mPedestalBuffer;    ///< Pedestals gathered for the batched signal processing
+  std::vector<float> mNoiseBuffer;       ///< Noise gathered for the batched signal processing
 };
 
 template <typename T>
@@ -176,6 +190,64 @@ inline float SAMPAProcessing::makeSignal(float ADCcounts, const int sector, cons
   return signal;
 }
 
+template <DigitzationMode MODE>
+inline void SAMPAProcessing::makeSignal(float* ADCcounts, const int sector, const GlobalPadNumber* globalPadInSector,
+                                        size_t nPads)
+{
+  if (MODE == DigitzationMode::PropagateADC) {
+    // the random numbers are consumed anyway, as in the scalar version
+    mNoiseBuffer.resize(nPads);
+    mRandomNoiseRing.getNextValues(mNoiseBuffer.data(), nPads);
+    return;
+  }
+
+  /// gather the calibration values of the pads, padded to full vectors
+  const size_t nVectors = (nPads + Vc::float_v::Size - 1) / Vc::float_v::Size;
+  const size_t nPadded = nVectors * Vc::float_v::Size;
+  mPedestalBuffer.resize(nPadded);
+  mNoiseBuffer.resize(nPadded);
+  mRandomNoiseRing.getNextValues(mNoiseBuffer.data(), nPads);
+  for (size_t i = 0; i < nPads; ++i) {
+    mPedestalBuffer[i] = getPedestal(sector, globalPadInSector[i]);
+    mNoiseBuffer[i] *= mNoiseMap->getValue(sector, globalPadInSector[i]);
+  }
+
+  const Vc::float_v saturation(mEleParam->getADCSaturation() - 1);
+  const size_t nFull = nPads / Vc::float_v::Size;
+  auto process = [&](Vc::float_v signal, size_t i) {
+    const Vc::float_v pedestal(&mPedestalBuffer[i], Vc::Unaligned);
+    signal += Vc::float_v(&mNoiseBuffer[i], Vc::Unaligned);
+    signal += pedestal;
+    switch (MODE) {
+      case DigitzationMode::FullMode: {
+        return Vc::min(signal, saturation);
+      }
+      case DigitzationMode::SubtractPedestal: {
+        return Vc::min(signal, saturation) - pedestal;
+      }
+      default: {
+        return signal;
+      }
+    }
+  };
+  for (size_t v = 0; v < nFull; ++v) {
+    const size_t i = v * Vc::float_v::Size;
+    process(Vc::float_v(ADCcounts + i, Vc::Unaligned), i).store(ADCcounts + i, Vc::Unaligned);
+  }
+  /// the remaining pads go through a padded vector
+  if (nFull * Vc::float_v::Size < nPads) {
+    const size_t i = nFull * Vc::float_v::Size;
+    Vc::float_v signal(Vc::Zero);
+    for (size_t j = 0; i + j < nPads; ++j) {
+      signal[j] = ADCcounts[i + j];
+    }
+    const Vc::float_v result = process(signal, i);
+    for (size_t j = 0; i + j < nPads; ++j) {
+      ADCcounts[i + j] = result[j];
+    }
+  }
+}
+
 inline float SAMPAProcessing::getADCSaturation(const float signal) const
 {
   const float adcSaturation = mEleParam->getADCSaturation();
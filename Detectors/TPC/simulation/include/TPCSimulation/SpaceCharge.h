@@ -37,6 +37,7 @@
 
 #include "AliTPCSpaceCharge3DCalc.h"
 #include "DataFormatsTPC/Defs.h"
+#include "TPCSimulation/DistortionLookupTable.h"
 
 class TH3;
 class TMatrixDfwd;
@@ -112,9 +113,20 @@ class SpaceCharge
   /// \param point 3D coordinates of the electron
   void correctElectron(GlobalPosition3D& point);
   /// Distort electron position using distortion lookup tables
+  /// If enabled, the compact DistortionLookupTable with trilinear interpolation is used
   /// \param point 3D coordinates of the electron
   void distortElectron(GlobalPosition3D& point);
 
+  /// Use a precomputed distortion lookup table, e.g. read from file
+  /// The distortions are then constant and no lookup tables are calculated
+  /// \param table distortion lookup table
+  void setDistortionLookupTable(DistortionLookupTable&& table);
+  /// Get the compact distortion lookup table, filled after the calculation of the lookup tables
+  const DistortionLookupTable& getDistortionLookupTable() const { return mDistortionTable; }
+  /// Switch between the compact distortion lookup table and the interpolation of the AliTPCSpaceCharge3DCalc tables
+  /// \param useTable true to use the compact lookup table
+  void setUseDistortionLookupTable(bool useTable) { mUseDistortionTable = useTable; }
+
   /// Set the space-charge distortions model
   /// \param distortionType distortion type (constant or realistic)
   void setSCDistortionType(SCDistortionType distortionType) { mSCDistortionType = distortionType; }
@@ -127,6 +139,9 @@ class SpaceCharge
   /// \return space-charge density (C/m^3)
   float ions2Charge(int nIons);
 
+  /// Fill the compact distortion lookup table from the AliTPCSpaceCharge3DCalc tables
+  void fillDistortionLookupTable();
+
   static constexpr float DvDEoverv0 = 0.0025; //! v'(E) / v0 = K / (K*E0) for ions, used in dz calculation
   static const float sEzField;                //! nominal drift field
 
@@ -158,6 +173,10 @@ class SpaceCharge
   bool mInitLookUpTables;             ///< Flag to indicate if lookup tables have been calculated
   float mTimeInit;                    ///< time of last update of lookup tables
   SCDistortionType mSCDistortionType; ///< Type of space-charge distortions
+  bool mUseDistortionTable;           ///< Flag for the use of the compact distortion lookup table
+  bool mExternalDistortionTable;      ///< Flag to indicate that the distortion lookup table was provided externally
+
+  DistortionLookupTable mDistortionTable; //! compact distortion lookup table with trilinear interpolation
 
   AliTPCSpaceCharge3DCalc mLookUpTableCalculator; ///< object to calculate and store correction and distortion lookup tables
 
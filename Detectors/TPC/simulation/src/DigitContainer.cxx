@@ -39,19 +39,19 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
 
       switch (digitizationMode) {
         case DigitzationMode::FullMode: {
-          time.fillOutputContainer<DigitzationMode::FullMode>(output, mcTruth, sector, timeBin);
+          time->fillOutputContainer<DigitzationMode::FullMode>(output, mcTruth, sector, timeBin);
           break;
         }
         case DigitzationMode::SubtractPedestal: {
-          time.fillOutputContainer<DigitzationMode::SubtractPedestal>(output, mcTruth, sector, timeBin);
+          time->fillOutputContainer<DigitzationMode::SubtractPedestal>(output, mcTruth, sector, timeBin);
           break;
         }
         case DigitzationMode::NoSaturation: {
-          time.fillOutputContainer<DigitzationMode::NoSaturation>(output, mcTruth, sector, timeBin);
+          time->fillOutputContainer<DigitzationMode::NoSaturation>(output, mcTruth, sector, timeBin);
           break;
         }
         case DigitzationMode::PropagateADC: {
-          time.fillOutputContainer<DigitzationMode::PropagateADC>(output, mcTruth, sector, timeBin);
+          time->fillOutputContainer<DigitzationMode::PropagateADC>(output, mcTruth, sector, timeBin);
           break;
         }
       }
@@ -63,6 +63,7 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
   if (nProcessedTimeBins > 0) {
     mFirstTimeBin += nProcessedTimeBins;
     while (nProcessedTimeBins--) {
+      releaseTimeBin(std::move(mTimeBins.front()));
       mTimeBins.pop_front();
     }
   }
@@ -46,9 +46,6 @@ void Digitizer::init()
 void Digitizer::process(const std::vector<o2::TPC::HitGroup>& hits,
                         const int eventID, const int sourceID)
 {
-  const static Mapper& mapper = Mapper::instance();
-  const static ParameterDetector& detParam = ParameterDetector::defaultInstance();
-  const static ParameterElectronics& eleParam = ParameterElectronics::defaultInstance();
   const static ParameterGEM& gemParam = ParameterGEM::defaultInstance();
 
   static GEMAmplification& gemAmplification = GEMAmplification::instance();
@@ -58,16 +55,14 @@ void Digitizer::process(const std::vector<o2::TPC::HitGroup>& hits,
   static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
   sampaProcessing.updateParameters();
 
-  const int nShapedPoints = eleParam.getNShapedPoints();
   const auto amplificationMode = gemParam.getAmplificationMode();
-  static std::vector<float> signalArray;
-  signalArray.resize(nShapedPoints);
 
   /// Reserve space in the digit container for the current event
   mDigitContainer.reserve(sampaProcessing.getTimeBinFromTime(mEventTime));
 
   for (auto& hitGroup : hits) {
     const int MCTrackID = hitGroup.GetTrackID();
+    const MCCompLabel label(MCTrackID, eventID, sourceID);
     for (size_t hitindex = 0; hitindex < hitGroup.getSize(); ++hitindex) {
       const auto& eh = hitGroup.getHit(hitindex);
 
@@ -91,6 +86,11 @@ void Digitizer::process(const std::vector<o2::TPC::HitGroup>& hits,
 
       /// TODO: add primary ions to space-charge density
 
+      if (mUseBatchedTransport) {
+        processElectronsBatched(posEle, nPrimaryElectrons, hitTime, label);
+        continue;
+      }
+
       /// Loop over electrons
       for (int iEle = 0; iEle < nPrimaryElectrons; ++iEle) {
 
@@ -103,24 +103,9 @@ void Digitizer::process(const std::vector<o2::TPC::HitGroup>& hits,
           continue;
         }
 
-        /// Remove electrons that end up outside the active volume
-        if (std::abs(posEleDiff.Z()) > detParam.getTPClength()) {
-          continue;
-        }
-
-        /// When the electron is not in the sector we're processing, abandon
-        if (mapper.isOutOfSector(posEleDiff, mSector)) {
-          continue;
-        }
-
         /// Compute digit position and check for validity
-        const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(posEleDiff, mSector);
-        if (!digiPadPos.isValid()) {
-          continue;
-        }
-
-        /// Remove digits the end up outside the currently produced sector
-        if (digiPadPos.getCRU().sector() != mSector) {
+        DigitPos digiPadPos;
+        if (!findDigitPos(posEleDiff, digiPadPos)) {
           continue;
         }
 
@@ -130,15 +115,7 @@ void Digitizer::process(const std::vector<o2::TPC::HitGroup>& hits,
           continue;
         }
 
-        const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
-        const float ADCsignal = sampaProcessing.getADCvalue(static_cast<float>(nElectronsGEM));
-        const MCCompLabel label(MCTrackID, eventID, sourceID);
-        sampaProcessing.getShapedSignal(ADCsignal, absoluteTime, signalArray);
-        for (float i = 0; i < nShapedPoints; ++i) {
-          const float time = absoluteTime + i * eleParam.getZBinWidth();
-          mDigitContainer.addDigit(label, digiPadPos.getCRU(), sampaProcessing.getTimeBinFromTime(time), globalPad,
-                                   signalArray[i]);
-        }
+        addElectronSignal(label, digiPadPos, absoluteTime, nElectronsGEM);
         /// TODO: add ion backflow to space-charge density
       }
       /// end of loop over electrons
@@ -146,6 +123,99 @@ void Digitizer::process(const std::vector<o2::TPC::HitGroup>& hits,
   }
 }
 
+void Digitizer::processElectronsBatched(const GlobalPosition3D& posEle, const int nElectrons, const float hitTime,
+                                        const MCCompLabel& label)
+{
+  const static ParameterGEM& gemParam = ParameterGEM::defaultInstance();
+  static GEMAmplification& gemAmplification = GEMAmplification::instance();
+  static ElectronTransport& electronTransport = ElectronTransport::instance();
+
+  static ElectronTransport::ElectronBatch electrons;
+  static std::vector<DigitPos> digitPositions;
+  static std::vector<float> arrivalTimes;
+  static std::vector<float> amplification;
+
+  /// Drift, diffusion and attachment of all electrons of the hit at once
+  electronTransport.getElectronDriftBatch(posEle, nElectrons, electrons);
+
+  /// Select the electrons arriving on a valid pad of the current sector
+  digitPositions.clear();
+  arrivalTimes.clear();
+  for (size_t iEle = 0; iEle < electrons.size; ++iEle) {
+    DigitPos digiPadPos;
+    if (!findDigitPos(GlobalPosition3D(electrons.x[iEle], electrons.y[iEle], electrons.z[iEle]), digiPadPos)) {
+      continue;
+    }
+    digitPositions.emplace_back(digiPadPos);
+    arrivalTimes.emplace_back(electrons.driftTime[iEle] + mEventTime + hitTime); /// in us
+  }
+
+  /// Electron amplification, the effective mode draws the gain of all electrons in bulk
+  const auto amplificationMode = gemParam.getAmplificationMode();
+  const bool isEffectiveMode = (amplificationMode == AmplificationMode::EffectiveMode);
+  if (isEffectiveMode) {
+    gemAmplification.getEffectiveStackAmplificationBatch(digitPositions.size(), amplification);
+  }
+
+  for (size_t iEle = 0; iEle < digitPositions.size(); ++iEle) {
+    const DigitPos& digiPadPos = digitPositions[iEle];
+    const int nElectronsGEM = isEffectiveMode
+                                ? static_cast<int>(static_cast<float>(static_cast<int>(amplification[iEle])) *
+                                                   gemAmplification.getLocalGain(digiPadPos.getCRU(), digiPadPos.getPadPos()))
+                                : gemAmplification.getStackAmplification(digiPadPos.getCRU(), digiPadPos.getPadPos(), amplificationMode);
+    if (nElectronsGEM == 0) {
+      continue;
+    }
+    addElectronSignal(label, digiPadPos, arrivalTimes[iEle], nElectronsGEM);
+  }
+}
+
+bool Digitizer::findDigitPos(const GlobalPosition3D& posEleDiff, DigitPos& digiPadPos) const
+{
+  const static Mapper& mapper = Mapper::instance();
+  const static ParameterDetector& detParam = ParameterDetector::defaultInstance();
+
+  /// Remove electrons that end up outside the active volume
+  if (std::abs(posEleDiff.Z()) > detParam.getTPClength()) {
+    return false;
+  }
+
+  /// When the electron is not in the sector we're processing, abandon
+  if (mapper.isOutOfSector(posEleDiff, mSector)) {
+    return false;
+  }
+
+  /// Compute digit position and check for validity
+  digiPadPos = mapper.findDigitPosFromGlobalPosition(posEleDiff, mSector);
+  if (!digiPadPos.isValid()) {
+    return false;
+  }
+
+  /// Remove digits the end up outside the currently produced sector
+  return digiPadPos.getCRU().sector() == mSector;
+}
+
+void Digitizer::addElectronSignal(const MCCompLabel& label, const DigitPos& digiPadPos, const float absoluteTime,
+                                  const int nElectronsGEM)
+{
+  const static Mapper& mapper = Mapper::instance();
+  const static ParameterElectronics& eleParam = ParameterElectronics::defaultInstance();
+  static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
+
+  const int nShapedPoints = eleParam.getNShapedPoints();
+  static std::vector<float> signalArray;
+  signalArray.resize(nShapedPoints);
+
+  const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
+  const float ADCsignal = sampaProcessing.getADCvalue(static_cast<float>(nElectronsGEM));
+  sampaProcessing.getShapedSignal(ADCsignal, absoluteTime, signalArray);
+  for (float i = 0; i < nShapedPoints; ++i) {
+    const float time = absoluteTime + i * eleParam.getZBinWidth();
+    mDigitContainer.addDigit(label, digiPadPos.getCRU(), sampaProcessing.getTimeBinFromTime(time), globalPad,
+                             signalArray[i]);
+  }
+}
+
 void Digitizer::flush(std::vector<o2::TPC::Digit>& digits,
                       o2::dataformats::MCTruthContainer<o2::MCCompLabel>& labels, bool finalFlush)
 {
@@ -164,3 +234,13 @@ void Digitizer::enableSCDistortions(SpaceCharge::SCDistortionType distortionType
     mSpaceChargeHandler->setInitialSpaceChargeDensity(hisInitialSCDensity);
   }
 }
+
+void Digitizer::setSCDistortionLookupTable(DistortionLookupTable&& table)
+{
+  mUseSCDistortions = true;
+  if (!mSpaceChargeHandler) {
+    const auto& header = table.getHeader();
+    mSpaceChargeHandler = std::make_unique<SpaceCharge>(header.nZ, header.nPhi, header.nR);
+  }
+  mSpaceChargeHandler->setDistortionLookupTable(std::move(table));
+}
@@ -0,0 +1,128 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DistortionLookupTable.cxx
+/// \brief Implementation of a compact lookup table for space-charge distortions with trilinear interpolation
+
+#include "TPCSimulation/DistortionLookupTable.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace o2::TPC;
+
+DistortionLookupTable::DistortionLookupTable(int nZ, int nPhi, int nR, float rMin, float rMax, float zMax)
+{
+  if (nZ < 2 || nPhi < 1 || nR < 2 || rMax <= rMin || zMax <= 0.f) {
+    throw std::runtime_error("DistortionLookupTable: invalid grid definition");
+  }
+  Header header;
+  header.nZ = nZ;
+  header.nPhi = nPhi;
+  header.nR = nR;
+  header.rMin = rMin;
+  header.rMax = rMax;
+  header.zMax = zMax;
+  allocate(header);
+}
+
+DistortionLookupTable::DistortionLookupTable(gsl::span<const char> buffer, bool copy)
+{
+  Header header;
+  if (buffer.size() < sizeof(Header)) {
+    throw std::runtime_error("DistortionLookupTable: buffer too small for header");
+  }
+  std::memcpy(&header, buffer.data(), sizeof(Header));
+  if (header.magic != Magic || header.version != 1 || header.sizeofHeader != sizeof(Header)) {
+    throw std::runtime_error("DistortionLookupTable: unknown buffer format");
+  }
+  if (header.nZ < 2 || header.nPhi < 1 || header.nR < 2) {
+    throw std::runtime_error("DistortionLookupTable: invalid grid definition");
+  }
+  const size_t componentSize = size_t(NSides) * header.nZ * header.nPhi * header.nR;
+  if (buffer.size() != sizeof(Header) + NComponents * componentSize * sizeof(float)) {
+    throw std::runtime_error("DistortionLookupTable: buffer size does not match the grid definition");
+  }
+  if (copy) {
+    allocate(header);
+    std::memcpy(mOwnedBuffer.data(), buffer.data(), buffer.size());
+    return;
+  }
+  if (reinterpret_cast<uintptr_t>(buffer.data()) % alignof(float) != 0) {
+    throw std::runtime_error("DistortionLookupTable: buffer not aligned");
+  }
+  mHeader = reinterpret_cast<const Header*>(buffer.data());
+  setupPointers();
+}
+
+void DistortionLookupTable::allocate(const Header& header)
+{
+  const size_t componentSize = size_t(NSides) * header.nZ * header.nPhi * header.nR;
+  mOwnedBuffer.assign(sizeof(Header) + NComponents * componentSize * sizeof(float), 0);
+  std::memcpy(mOwnedBuffer.data(), &header, sizeof(Header));
+  mHeader = reinterpret_cast<const Header*>(mOwnedBuffer.data());
+  setupPointers();
+}
+
+void DistortionLookupTable::setupPointers()
+{
+  mComponentSize = size_t(NSides) * mHeader->nZ * mHeader->nPhi * mHeader->nR;
+  const float* data = reinterpret_cast<const float*>(reinterpret_cast<const char*>(mHeader) + sizeof(Header));
+  for (int c = 0; c < NComponents; ++c) {
+    mData[c] = data + c * mComponentSize;
+  }
+  mInvDeltaR = (mHeader->nR - 1) / (mHeader->rMax - mHeader->rMin);
+  mInvDeltaPhi = mHeader->nPhi / 6.28318530717958647692f;
+  mInvDeltaZ = (mHeader->nZ - 1) / mHeader->zMax;
+}
+
+void DistortionLookupTable::setDistortion(int side, int iz, int iphi, int ir, float dx, float dy, float dz)
+{
+  if (mOwnedBuffer.empty()) {
+    throw std::runtime_error("DistortionLookupTable: cannot modify a table which does not own its buffer");
+  }
+  const size_t i = index(side, iz, iphi, ir);
+  const_cast<float*>(mData[0])[i] = dx;
+  const_cast<float*>(mData[1])[i] = dy;
+  const_cast<float*>(mData[2])[i] = dz;
+}
+
+void DistortionLookupTable::getGridPoint(int side, int iz, int iphi, int ir, float& x, float& y, float& z) const
+{
+  const float r = mHeader->rMin + ir / mInvDeltaR;
+  const float phi = iphi / mInvDeltaPhi;
+  x = r * std::cos(phi);
+  y = r * std::sin(phi);
+  z = (side == 0 ? 1.f : -1.f) * iz / mInvDeltaZ;
+}
+
+void DistortionLookupTable::writeToFile(const std::string& fileName) const
+{
+  std::ofstream file(fileName, std::ios::binary);
+  const auto buffer = getBuffer();
+  if (!file.write(buffer.data(), buffer.size())) {
+    throw std::runtime_error("DistortionLookupTable: failed to write " + fileName);
+  }
+}
+
+DistortionLookupTable DistortionLookupTable::readFromFile(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if (!file) {
+    throw std::runtime_error("DistortionLookupTable: failed to open " + fileName);
+  }
+  std::vector<char> buffer(file.tellg());
+  file.seekg(0);
+  if (!file.read(buffer.data(), buffer.size())) {
+    throw std::runtime_error("DistortionLookupTable: failed to read " + fileName);
+  }
+  return DistortionLookupTable(gsl::span<const char>(buffer.data(), buffer.size()), true);
+}
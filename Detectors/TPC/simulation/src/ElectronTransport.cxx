@@ -65,6 +65,63 @@ GlobalPosition3D ElectronTransport::getElectronDrift(GlobalPosition3D posEle, fl
   return posEleDiffusion;
 }
 
+void ElectronTransport::getElectronDriftBatch(const GlobalPosition3D& posEle, int nElectrons, ElectronBatch& batch)
+{
+  /// All electrons of the batch start at the same position, so the width of the diffusion is the same for all of them
+  float driftl = mDetParam->getTPClength() - std::abs(posEle.Z());
+  if (driftl < 0.01) {
+    driftl = 0.01;
+  }
+  driftl = std::sqrt(driftl);
+  const float sigT = driftl * mGasParam->getDiffT();
+  const float sigL = driftl * mGasParam->getDiffL();
+
+  const size_t nPadded = ((nElectrons + float_v::size() - 1) / float_v::size()) * float_v::size();
+  batch.resize(nPadded);
+  mRandomGaus.getNextValues(batch.x.data(), nPadded);
+  mRandomGaus.getNextValues(batch.y.data(), nPadded);
+  mRandomGaus.getNextValues(batch.z.data(), nPadded);
+  mRandomFlat.getNextValues(batch.random.data(), nPadded);
+
+  const float tpcLength = mDetParam->getTPClength();
+  const float vDrift = mGasParam->getVdrift();
+  const float posX = posEle.X();
+  const float posY = posEle.Y();
+  const float posZ = posEle.Z();
+  for (size_t i = 0; i < nPadded; i += float_v::size()) {
+    const float_v x = float_v(&batch.x[i], Vc::Unaligned) * sigT + posX;
+    const float_v y = float_v(&batch.y[i], Vc::Unaligned) * sigT + posY;
+    float_v z = float_v(&batch.z[i], Vc::Unaligned) * sigL + posZ;
+
+    /// A sign change in the z position is an elongation of the drift time, see getElectronDrift
+    const Vc::float_m signChange = (z * posZ) < 0.f;
+    float_v absZ = Vc::abs(z);
+    absZ(signChange) = -absZ;
+    z(signChange) = posZ;
+    const float_v driftTime = (tpcLength - absZ) / vDrift;
+
+    x.store(&batch.x[i], Vc::Unaligned);
+    y.store(&batch.y[i], Vc::Unaligned);
+    z.store(&batch.z[i], Vc::Unaligned);
+    driftTime.store(&batch.driftTime[i], Vc::Unaligned);
+  }
+
+  /// Attachment, compacting the surviving electrons to the front of the arrays
+  const float attachment = mGasParam->getAttachmentCoefficient() * mGasParam->getOxygenContent();
+  size_t nSurviving = 0;
+  for (int i = 0; i < nElectrons; ++i) {
+    if (batch.random[i] < attachment * batch.driftTime[i]) {
+      continue;
+    }
+    batch.x[nSurviving] = batch.x[i];
+    batch.y[nSurviving] = batch.y[i];
+    batch.z[nSurviving] = batch.z[i];
+    batch.driftTime[nSurviving] = batch.driftTime[i];
+    ++nSurviving;
+  }
+  batch.size = nSurviving;
+}
+
 bool ElectronTransport::isCompletelyOutOfSectorCoarseElectronDrift(GlobalPosition3D posEle, const Sector& sector) const
 {
   /// For drift lengths shorter than 1 mm, the drift length is set to that value
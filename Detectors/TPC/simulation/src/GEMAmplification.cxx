@@ -140,6 +140,23 @@ int GEMAmplification::getEffectiveStackAmplification(int nElectrons)
   return nElectronsGEM;
 }
 
+void GEMAmplification::getEffectiveStackAmplificationBatch(size_t nElectrons, std::vector<float>& amplification)
+{
+  /// Same as getEffectiveStackAmplification for each of the electrons individually
+  const size_t nPadded = ((nElectrons + float_v::size() - 1) / float_v::size()) * float_v::size();
+  amplification.resize(nPadded);
+  mRandomFlatBatch.resize(nPadded);
+  mRandomFlat.getNextValues(mRandomFlatBatch.data(), nPadded);
+  mGainFullStack.getNextValues(amplification.data(), nPadded);
+
+  const float efficiency = mGEMParam->getEfficiencyStack();
+  for (size_t i = 0; i < nPadded; i += float_v::size()) {
+    float_v gain(&amplification[i], Vc::Unaligned);
+    gain(float_v(&mRandomFlatBatch[i], Vc::Unaligned) < efficiency) = 0.f;
+    gain.store(&amplification[i], Vc::Unaligned);
+  }
+}
+
 int GEMAmplification::getSingleGEMAmplification(int nElectrons, int GEM)
 {
   /// The effective gain of the GEM foil is given by three components
@@ -47,6 +47,8 @@ SpaceCharge::SpaceCharge()
     mInitLookUpTables(false),
     mTimeInit(-1),
     mSCDistortionType(SpaceCharge::SCDistortionType::SCDistortionsRealistic),
+    mUseDistortionTable(true),
+    mExternalDistortionTable(false),
     mLookUpTableCalculator(Constants::MAXGLOBALPADROW, MaxZSlices, MaxPhiBins, 2, 3, 0),
     mSpaceChargeDensityA(MaxZSlices),
     mSpaceChargeDensityC(MaxZSlices)
@@ -70,6 +72,8 @@ SpaceCharge::SpaceCharge(int nZSlices, int nPhiBins, int nRBins)
     mInitLookUpTables(false),
     mTimeInit(-1),
     mSCDistortionType(SpaceCharge::SCDistortionType::SCDistortionsRealistic),
+    mUseDistortionTable(true),
+    mExternalDistortionTable(false),
     mLookUpTableCalculator(nRBins, nZSlices, nPhiBins, 2, 3, 0),
     mSpaceChargeDensityA(nZSlices),
     mSpaceChargeDensityC(nZSlices)
@@ -93,6 +97,8 @@ SpaceCharge::SpaceCharge(int nZSlices, int nPhiBins, int nRBins, int interpolati
     mInitLookUpTables(false),
     mTimeInit(-1),
     mSCDistortionType(SpaceCharge::SCDistortionType::SCDistortionsRealistic),
+    mUseDistortionTable(true),
+    mExternalDistortionTable(false),
     mLookUpTableCalculator(nRBins, nZSlices, nPhiBins, interpolationOrder, 3, 0),
     mSpaceChargeDensityA(nZSlices),
     mSpaceChargeDensityC(nZSlices)
@@ -145,7 +151,7 @@ void SpaceCharge::init()
   /// TODO use this parameterization or fixed value(s) from Magboltz calculations?
   float omegaTau = -10. * bzField * vDrift / TMath::Abs(sEzField);
   setOmegaTauT1T2(omegaTau, t1, t2);
-  if (mUseInitialSCDensity) {
+  if (mUseInitialSCDensity && !mExternalDistortionTable) {
     calculateLookupTables();
   }
 }
@@ -197,11 +203,50 @@ void SpaceCharge::calculateLookupTables()
     /// TODO: Propagate current SC density along E field by one time bin for next update
   }
 
+  fillDistortionLookupTable();
+  mInitLookUpTables = true;
+}
+
+void SpaceCharge::fillDistortionLookupTable()
+{
+  mDistortionTable = DistortionLookupTable(mNZSlices, mNPhiBins, mNRBins, RadiusInner, RadiusOuter, DriftLength);
+  for (int iside = 0; iside < DistortionLookupTable::NSides; ++iside) {
+    for (int iz = 0; iz < mNZSlices; ++iz) {
+      for (int iphi = 0; iphi < mNPhiBins; ++iphi) {
+        for (int ir = 0; ir < mNRBins; ++ir) {
+          float x[3] = { 0.f, 0.f, 0.f };
+          float dx[3] = { 0.f, 0.f, 0.f };
+          mDistortionTable.getGridPoint(iside, iz, iphi, ir, x[0], x[1], x[2]);
+          float phi = TMath::ATan2(x[1], x[0]);
+          if (phi < 0) {
+            phi += TMath::TwoPi();
+          }
+          int roc = phi / TMath::Pi() * 9;
+          if (iside == 1) {
+            roc += 18;
+          }
+          mLookUpTableCalculator.GetDistortion(x, roc, dx);
+          mDistortionTable.setDistortion(iside, iz, iphi, ir, dx[0], dx[1], dx[2]);
+        }
+      }
+    }
+  }
+}
+
+void SpaceCharge::setDistortionLookupTable(DistortionLookupTable&& table)
+{
+  mDistortionTable = std::move(table);
+  mSCDistortionType = SCDistortionType::SCDistortionsConstant;
+  mUseDistortionTable = true;
+  mExternalDistortionTable = true;
   mInitLookUpTables = true;
 }
 
 void SpaceCharge::updateLookupTables(float eventTime)
 {
+  if (mExternalDistortionTable) {
+    return; // precomputed distortions are constant
+  }
   if (mTimeInit < 0.) {
     mTimeInit = eventTime; // set the time of first initialization
   }
@@ -318,6 +363,11 @@ void SpaceCharge::distortElectron(GlobalPosition3D& point)
   }
   const float x[3] = { point.X(), point.Y(), point.Z() };
   float dx[3] = { 0.f, 0.f, 0.f };
+  if (mUseDistortionTable && mDistortionTable.isValid()) {
+    mDistortionTable.getDistortion(x, dx);
+    point = GlobalPosition3D(x[0] + dx[0], x[1] + dx[1], x[2] + dx[2]);
+    return;
+  }
   float phi = TMath::ATan2(x[1], x[0]);
   if (phi < 0) {
     phi += TMath::TwoPi();
@@ -153,5 +153,40 @@ BOOST_AUTO_TEST_CASE(DigitContainer_test2)
     ++digits;
   }
 }
+
+/// \brief Test of the DigitContainer
+/// In continuous readout the flushed time bins are reused for later time bins. We fill the same voxel in two
+/// consecutive flush cycles and check that no charge or MC label of the first cycle leaks into the second one
+BOOST_AUTO_TEST_CASE(DigitContainer_test3)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  const Mapper& mapper = Mapper::instance();
+  DigitContainer digitContainer;
+  digitContainer.reset();
+
+  const CRU cru(0);
+  const GlobalPadNumber globalPad = mapper.globalPadNumber(DigitPos(cru, PadPos(5, 10)).getGlobalPadPos());
+
+  std::vector<Digit> digits;
+  dataformats::MCTruthContainer<MCCompLabel> mcTruth;
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    const TimeBin startTime = cycle * 1000;
+    digitContainer.setStartTime(startTime);
+    digitContainer.reserve(startTime);
+    digitContainer.addDigit(MCCompLabel(cycle, cycle, 0), cru, startTime + 10, globalPad, 100.f);
+
+    digits.clear();
+    mcTruth.clear();
+    digitContainer.fillOutputContainer(digits, mcTruth, 0, startTime + 600, true, false);
+
+    BOOST_CHECK_EQUAL(digits.size(), 1);
+    BOOST_CHECK_EQUAL(digits[0].getTimeStamp(), startTime + 10);
+    const auto labels = mcTruth.getLabels(0);
+    BOOST_CHECK_EQUAL(labels.size(), 1);
+    BOOST_CHECK_EQUAL(labels[0].getTrackID(), cycle);
+    BOOST_CHECK_EQUAL(labels[0].getEventID(), cycle);
+  }
+}
 }
 }
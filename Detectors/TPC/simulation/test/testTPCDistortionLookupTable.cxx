@@ -0,0 +1,135 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCDistortionLookupTable.cxx
+/// \brief This task tests the DistortionLookupTable of the TPC space-charge distortions
+
+#define BOOST_TEST_MODULE Test TPC DistortionLookupTable
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCSimulation/DistortionLookupTable.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+
+namespace o2
+{
+namespace TPC
+{
+
+/// distortions which are bilinear in r and z and do not depend on phi, reproduced exactly by the interpolation
+void expectedDistortion(int side, float r, float z, float d[3])
+{
+  d[0] = 0.01f * r + 0.002f * z;
+  d[1] = -0.5f + 0.0001f * r * std::abs(z);
+  d[2] = side == 1 ? 0.3f : -0.3f;
+}
+
+DistortionLookupTable createTable()
+{
+  DistortionLookupTable table(17, 36, 33, 85.f, 245.f, 250.f);
+  for (int side = 0; side < DistortionLookupTable::NSides; ++side) {
+    for (int iz = 0; iz < 17; ++iz) {
+      for (int iphi = 0; iphi < 36; ++iphi) {
+        for (int ir = 0; ir < 33; ++ir) {
+          float x, y, z, d[3];
+          table.getGridPoint(side, iz, iphi, ir, x, y, z);
+          expectedDistortion(side, std::sqrt(x * x + y * y), z, d);
+          table.setDistortion(side, iz, iphi, ir, d[0], d[1], d[2]);
+        }
+      }
+    }
+  }
+  return table;
+}
+
+void checkTable(const DistortionLookupTable& table)
+{
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> distR(86.f, 244.f);
+  std::uniform_real_distribution<float> distPhi(-3.14f, 3.14f);
+  std::uniform_real_distribution<float> distZ(-249.f, 249.f);
+  for (int i = 0; i < 1000; ++i) {
+    const float r = distR(gen);
+    const float phi = distPhi(gen);
+    const float x[3] = { r * std::cos(phi), r * std::sin(phi), distZ(gen) };
+    float dx[3], expected[3];
+    table.getDistortion(x, dx);
+    expectedDistortion(x[2] < 0.f, r, x[2], expected);
+    for (int c = 0; c < 3; ++c) {
+      BOOST_CHECK_SMALL(dx[c] - expected[c], 1e-3f);
+    }
+  }
+}
+
+/// \brief Test of the trilinear interpolation
+BOOST_AUTO_TEST_CASE(DistortionLookupTable_test1)
+{
+  const auto table = createTable();
+  BOOST_CHECK(table.isValid());
+  checkTable(table);
+
+  // the batched interpolation gives the same result as the single one
+  const float x[2] = { 100.f, -50.f };
+  const float y[2] = { 20.f, -150.f };
+  const float z[2] = { 10.f, -200.f };
+  float dx[2], dy[2], dz[2];
+  table.getDistortions(2, x, y, z, dx, dy, dz);
+  for (int i = 0; i < 2; ++i) {
+    const float pos[3] = { x[i], y[i], z[i] };
+    float d[3];
+    table.getDistortion(pos, d);
+    BOOST_CHECK_EQUAL(d[0], dx[i]);
+    BOOST_CHECK_EQUAL(d[1], dy[i]);
+    BOOST_CHECK_EQUAL(d[2], dz[i]);
+  }
+
+  // positions outside of the grid are clamped to the boundary
+  const float outside[3] = { 300.f, 0.f, 10.f };
+  const float boundary[3] = { 245.f, 0.f, 10.f };
+  float dOutside[3], dBoundary[3];
+  table.getDistortion(outside, dOutside);
+  table.getDistortion(boundary, dBoundary);
+  for (int c = 0; c < 3; ++c) {
+    BOOST_CHECK_SMALL(dOutside[c] - dBoundary[c], 1e-3f);
+  }
+}
+
+/// \brief Test of the flat buffer and the file I/O
+BOOST_AUTO_TEST_CASE(DistortionLookupTable_test2)
+{
+  const auto table = createTable();
+
+  // view on the buffer without copy
+  const DistortionLookupTable view(table.getBuffer());
+  BOOST_CHECK_EQUAL(view.getHeader().nZ, 17);
+  BOOST_CHECK_EQUAL(view.getHeader().nPhi, 36);
+  BOOST_CHECK_EQUAL(view.getHeader().nR, 33);
+  checkTable(view);
+
+  const std::string fileName = "testTPCDistortionLookupTable.bin";
+  table.writeToFile(fileName);
+  const auto fromFile = DistortionLookupTable::readFromFile(fileName);
+  std::remove(fileName.c_str());
+  BOOST_CHECK_EQUAL(fromFile.getBufferSize(), table.getBufferSize());
+  checkTable(fromFile);
+
+  // corrupted buffers are rejected
+  std::vector<char> buffer(table.getBuffer().begin(), table.getBuffer().end());
+  BOOST_CHECK_THROW(DistortionLookupTable(gsl::span<const char>(buffer.data(), buffer.size() - 4), true), std::runtime_error);
+  buffer[0] = 0;
+  BOOST_CHECK_THROW(DistortionLookupTable(gsl::span<const char>(buffer.data(), buffer.size()), true), std::runtime_error);
+}
+
+} // namespace TPC
+} // namespace o2
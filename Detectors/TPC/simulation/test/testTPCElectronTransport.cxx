@@ -124,6 +124,58 @@ BOOST_AUTO_TEST_CASE(ElectronDiffusion_test2)
   BOOST_CHECK_CLOSE(gausZ.GetParameter(2), gasParam.getDiffL(), 0.5);
 }
 
+/// \brief Test 3 of the getElectronDriftBatch function
+/// Same as test 1 for the batched transport, where all electrons
+/// of a batch start from the same position
+///
+/// Precision: 0.5 %.
+BOOST_AUTO_TEST_CASE(ElectronDiffusion_test3)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  const static ParameterGas& gasParam = ParameterGas::defaultInstance();
+  const static ParameterDetector& detParam = ParameterDetector::defaultInstance();
+  const GlobalPosition3D posEle(10.f, 10.f, 10.f);
+  TH1D hTestDiffX("hTestDiffX", "", 500, posEle.X() - 10., posEle.X() + 10.);
+  TH1D hTestDiffY("hTestDiffY", "", 500, posEle.Y() - 10., posEle.Y() + 10.);
+  TH1D hTestDiffZ("hTestDiffZ", "", 500, posEle.Z() - 10., posEle.Z() + 10.);
+
+  TF1 gausX("gausX", "gaus");
+  TF1 gausY("gausY", "gaus");
+  TF1 gausZ("gausZ", "gaus");
+
+  static ElectronTransport& electronTransport = ElectronTransport::instance();
+  ElectronTransport::ElectronBatch batch;
+
+  for (int i = 0; i < 5000; ++i) {
+    electronTransport.getElectronDriftBatch(posEle, 101, batch);
+    BOOST_CHECK(batch.size <= 101);
+    for (size_t iEle = 0; iEle < batch.size; ++iEle) {
+      hTestDiffX.Fill(batch.x[iEle]);
+      hTestDiffY.Fill(batch.y[iEle]);
+      hTestDiffZ.Fill(batch.z[iEle]);
+      BOOST_CHECK_CLOSE(batch.driftTime[iEle], electronTransport.getDriftTime(batch.z[iEle]), 1e-3);
+    }
+  }
+
+  hTestDiffX.Fit("gausX", "Q0");
+  hTestDiffY.Fit("gausY", "Q0");
+  hTestDiffZ.Fit("gausZ", "Q0");
+
+  // check whether the mean of the gaussian fit matches the starting point
+  BOOST_CHECK_CLOSE(gausX.GetParameter(1), posEle.X(), 0.5);
+  BOOST_CHECK_CLOSE(gausY.GetParameter(1), posEle.Y(), 0.5);
+  BOOST_CHECK_CLOSE(gausZ.GetParameter(1), posEle.Z(), 0.5);
+
+  // check whether the width of the distribution matches the expected one
+  const float sigT = std::sqrt(detParam.getTPClength() - posEle.Z()) * gasParam.getDiffT();
+  const float sigL = std::sqrt(detParam.getTPClength() - posEle.Z()) * gasParam.getDiffL();
+
+  BOOST_CHECK_CLOSE(gausX.GetParameter(2), sigT, 0.5);
+  BOOST_CHECK_CLOSE(gausY.GetParameter(2), sigT, 0.5);
+  BOOST_CHECK_CLOSE(gausZ.GetParameter(2), sigL, 0.5);
+}
+
 /// \brief Test of the isElectronAttachment function
 /// We let the electrons drift for 100 us and compare the fraction
 /// of lost electrons to the expected value
@@ -60,6 +60,35 @@ BOOST_AUTO_TEST_CASE(SAMPA_saturation_test)
   }
 }
 
+/// \brief Test of the batched signal processing
+/// the noise is random, but does not matter once the signal is saturated; the number of pads is not a multiple of
+/// the vector size to test the remainder
+BOOST_AUTO_TEST_CASE(SAMPA_makeSignal_batch_test)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  const ParameterElectronics& eleParam = cdb.getParameterElectronics();
+  SAMPAProcessing& sampa = SAMPAProcessing::instance();
+
+  const size_t nPads = 4 * Vc::float_v::Size + 3;
+  std::vector<GlobalPadNumber> pads(nPads);
+  std::vector<float> signals(nPads);
+  for (size_t i = 0; i < nPads; ++i) {
+    pads[i] = 10 * i;
+    signals[i] = 1.e5f + i;
+  }
+
+  sampa.makeSignal<DigitzationMode::PropagateADC>(signals.data(), 0, pads.data(), nPads);
+  for (size_t i = 0; i < nPads; ++i) {
+    BOOST_CHECK(signals[i] == 1.e5f + i);
+  }
+
+  sampa.makeSignal<DigitzationMode::FullMode>(signals.data(), 0, pads.data(), nPads);
+  for (size_t i = 0; i < nPads; ++i) {
+    BOOST_CHECK(signals[i] == eleParam.getADCSaturation() - 1);
+  }
+}
+
 /// \brief Test of the Gamma4 function
 BOOST_AUTO_TEST_CASE(SAMPA_Gamma4_test)
 {
@@ -32,11 +32,14 @@ enum struct InputType { Digitizer, // directly read digits from channel {TPC:DIG
                         Digits,    // read digits from file
                         Raw,       // read hardware clusters in raw page format from file
                         Clusters,  // read native clusters from file
+                        CTF,       // read native clusters from compressed time frame file
 };
 enum struct OutputType { Digits,
                          Raw,
                          Clusters,
                          Tracks,
+                         CTF,
+                         Currents,
 };
 
 /// create the workflow for TPC reconstruction
@@ -30,6 +30,7 @@
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "Algorithm/Parser.h"
 #include <FairMQLogger.h>
+#include <future>
 #include <memory> // for make_shared
 #include <vector>
 #include <iomanip>
@@ -49,27 +50,47 @@ DataProcessorSpec getCATrackerSpec(bool processMC, std::vector<int> const& input
 {
   constexpr static size_t NSectors = o2::TPC::Sector::MAXSECTOR;
   using ClusterGroupParser = o2::algorithm::ForwardParser<o2::TPC::ClusterGroupHeader>;
+  // in asynchronous mode the tracking of one time frame runs while the input of the next one
+  // is prepared, every slot owns a copy of the input data because the DPL messages are only
+  // valid during the processing call
+  struct TrackingSlot {
+    std::array<std::vector<char>, NSectors> inputs;
+    std::array<std::vector<MCLabelContainer>, NSectors> mcInputs;
+    std::array<std::vector<char>, NSectors> mcFlatInputs;
+    std::array<MCLabelContainerView, NSectors> mcViews;
+    ClusterNativeAccessFullTPC clusterIndex;
+    std::vector<TrackTPC> tracks;
+    MCLabelContainer tracksMCTruth;
+    std::future<int> result;
+  };
   struct ProcessAttributes {
     // the input comes in individual calls and we need to buffer until
     // data set is complete, have to think about a DPL feature to take
     // ownership of an input
     std::array<std::vector<char>, NSectors> bufferedInputs;
     std::array<std::vector<MCLabelContainer>, NSectors> mcInputs;
+    std::array<std::vector<char>, NSectors> bufferedMcInputs;
     std::bitset<NSectors> validInputs = 0;
     std::bitset<NSectors> validMcInputs = 0;
+    std::bitset<NSectors> flatMcInputs = 0; // sectors with the MC labels in one flat container
     std::unique_ptr<ClusterGroupParser> parser;
     std::unique_ptr<o2::TPC::TPCCATracking> tracker;
     int verbosity = 1;
     std::vector<int> inputIds;
     bool readyToQuit = false;
+    bool asyncMode = false;
+    std::array<TrackingSlot, 2> slots;
+    int nextSlot = 0;
   };
 
   auto initFunction = [processMC, inputIds](InitContext& ic) {
     auto options = ic.options().get<std::string>("tracker-options");
+    auto asyncMode = ic.options().get<bool>("tracker-async");
 
     auto processAttributes = std::make_shared<ProcessAttributes>();
     {
       processAttributes->inputIds = inputIds;
+      processAttributes->asyncMode = asyncMode;
       auto& parser = processAttributes->parser;
       auto& tracker = processAttributes->tracker;
       parser = std::make_unique<ClusterGroupParser>();
@@ -90,9 +111,34 @@ DataProcessorSpec getCATrackerSpec(bool processMC, std::vector<int> const& input
       uint64_t activeSectors = 0;
       auto& verbosity = processAttributes->verbosity;
 
+      auto publishTracks = [&pc, processMC](int retVal, std::vector<TrackTPC>& tracks, MCLabelContainer& tracksMCTruth) {
+        if (retVal != 0) {
+          // FIXME: error policy
+          LOG(ERROR) << "tracker returned error code " << retVal;
+        }
+        LOG(INFO) << "found " << tracks.size() << " track(s)";
+        pc.outputs().snapshot(OutputRef{ "output" }, tracks);
+        if (processMC) {
+          LOG(INFO) << "sending " << tracksMCTruth.getIndexedSize() << " track label(s)";
+          pc.outputs().snapshot(OutputRef{ "mclblout" }, tracksMCTruth);
+        }
+      };
+      // completion of the asynchronous tracking, the result is published in the current time slice
+      auto completePendingTracking = [processAttributes, &publishTracks]() {
+        auto& slot = processAttributes->slots[processAttributes->nextSlot ^ 0x1];
+        if (!slot.result.valid()) {
+          return;
+        }
+        publishTracks(slot.result.get(), slot.tracks, slot.tracksMCTruth);
+        slot.tracks.clear();
+        slot.tracksMCTruth.clear();
+      };
+
       // FIXME cleanup almost duplicated code
       auto& validMcInputs = processAttributes->validMcInputs;
       auto& mcInputs = processAttributes->mcInputs;
+      auto& flatMcInputs = processAttributes->flatMcInputs;
+      std::map<int, DataRef> mcdatarefs;
       if (processMC) {
         // we can later extend this to multiple inputs
         for (auto const& inputId : processAttributes->inputIds) {
@@ -114,7 +160,14 @@ DataProcessorSpec getCATrackerSpec(bool processMC, std::vector<int> const& input
             // multiple buffers need to be handled
             throw std::runtime_error("can only have one data set per sector");
           }
-          mcInputs[sector] = std::move(pc.inputs().get<std::vector<MCLabelContainer>>(inputLabel.c_str()));
+          auto const* dataHeader = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+          if (dataHeader->payloadSerializationMethod == o2::header::gSerializationMethodNone) {
+            // the labels of the sector in one flat container, indexed in place like the clusters
+            mcdatarefs[sector] = ref;
+            flatMcInputs.set(sector);
+          } else {
+            mcInputs[sector] = std::move(pc.inputs().get<std::vector<MCLabelContainer>>(inputLabel.c_str()));
+          }
           validMcInputs.set(sector);
           activeSectors |= sectorHeader->activeSectors;
           if (verbosity > 1) {
@@ -166,6 +219,8 @@ DataProcessorSpec getCATrackerSpec(bool processMC, std::vector<int> const& input
       }
 
       if (operation == -1) {
+        // the last time frame of the asynchronous mode is still in flight
+        completePendingTracking();
         // EOD is transmitted in the sectorHeader with sector number equal to -1
         o2::TPC::TPCSectorHeader sh{ -1 };
         sh.activeSectors = activeSectors;
@@ -199,12 +254,32 @@ DataProcessorSpec getCATrackerSpec(bool processMC, std::vector<int> const& input
           std::copy(ref.payload, ref.payload + payploadSize, bufferedInputs[sector].begin());
           printInputLog(ref, "buffering", sector);
         }
+        for (auto const& refentry : mcdatarefs) {
+          auto& ref = refentry.second;
+          processAttributes->bufferedMcInputs[refentry.first].assign(ref.payload, ref.payload + DataRefUtils::getPayloadSize(ref));
+        }
 
         // not needed to send something, DPL will simply drop this timeslice, whenever the
         // data for all sectors is available, the output is sent in that time slice
         return;
       }
       assert(processMC == false || validMcInputs == validInputs);
+      if (flatMcInputs.any() && flatMcInputs != validMcInputs) {
+        throw std::runtime_error("can not mix flat and serialized MC labels");
+      }
+      // the flat MC labels, received in this call or buffered
+      std::array<gsl::span<const char>, NSectors> mcFlatInputs;
+      for (size_t sector = 0; sector < NSectors; ++sector) {
+        if (!flatMcInputs.test(sector)) {
+          continue;
+        }
+        auto mcref = mcdatarefs.find(sector);
+        if (mcref != mcdatarefs.end()) {
+          mcFlatInputs[sector] = gsl::span(mcref->second.payload, DataRefUtils::getPayloadSize(mcref->second));
+        } else {
+          mcFlatInputs[sector] = gsl::span<const char>(processAttributes->bufferedMcInputs[sector].data(), processAttributes->bufferedMcInputs[sector].size());
+        }
+      }
       std::array<gsl::span<const char>, NSectors> inputs;
       auto inputStatus = validInputs;
       for (auto const& refentry : datarefs) {
@@ -261,27 +336,58 @@ DataProcessorSpec getCATrackerSpec(bool processMC, std::vector<int> const& input
         }
         LOG(INFO) << "running tracking for sector(s) " << bitInfo;
       }
-      ClusterNativeAccessFullTPC clusterIndex;
-      memset(&clusterIndex, 0, sizeof(clusterIndex));
-      ClusterNativeHelper::Reader::fillIndex(clusterIndex, inputs, mcInputs, [&validInputs](auto& index) { return validInputs.test(index); });
+      if (processAttributes->asyncMode) {
+        // prepare the input of this time frame in the free slot while the previous one is tracked,
+        // then publish the previous result and start the tracking of this time frame
+        auto& slot = processAttributes->slots[processAttributes->nextSlot];
+        std::array<gsl::span<const char>, NSectors> slotInputs;
+        for (size_t sector = 0; sector < NSectors; ++sector) {
+          if (!validInputs.test(sector)) {
+            continue;
+          }
+          slot.inputs[sector].assign(inputs[sector].begin(), inputs[sector].end());
+          slotInputs[sector] = gsl::span<const char>(slot.inputs[sector].data(), slot.inputs[sector].size());
+          if (flatMcInputs.test(sector)) {
+            slot.mcFlatInputs[sector].assign(mcFlatInputs[sector].begin(), mcFlatInputs[sector].end());
+            slot.mcViews[sector] = MCLabelContainerView(gsl::span<const char>(slot.mcFlatInputs[sector].data(), slot.mcFlatInputs[sector].size()));
+          } else if (processMC) {
+            slot.mcInputs[sector] = std::move(mcInputs[sector]);
+          }
+        }
+        if (flatMcInputs.any()) {
+          ClusterNativeHelper::Reader::fillIndex(slot.clusterIndex, slotInputs, slot.mcViews, [&validInputs](auto& index) { return validInputs.test(index); });
+        } else {
+          ClusterNativeHelper::Reader::fillIndex(slot.clusterIndex, slotInputs, slot.mcInputs, [&validInputs](auto& index) { return validInputs.test(index); });
+        }
+        completePendingTracking();
+        slot.result = tracker->runTrackingAsync(slot.clusterIndex, &slot.tracks, (processMC ? &slot.tracksMCTruth : nullptr));
+        processAttributes->nextSlot ^= 0x1;
+      } else {
+        ClusterNativeAccessFullTPC clusterIndex;
+        memset(&clusterIndex, 0, sizeof(clusterIndex));
+        std::array<MCLabelContainerView, NSectors> mcViews;
+        if (flatMcInputs.any()) {
+          // clusters and MC labels are both indexed in place in the input messages
+          for (size_t sector = 0; sector < NSectors; ++sector) {
+            if (flatMcInputs.test(sector)) {
+              mcViews[sector] = MCLabelContainerView(mcFlatInputs[sector]);
+            }
+          }
+          ClusterNativeHelper::Reader::fillIndex(clusterIndex, inputs, mcViews, [&validInputs](auto& index) { return validInputs.test(index); });
+        } else {
+          ClusterNativeHelper::Reader::fillIndex(clusterIndex, inputs, mcInputs, [&validInputs](auto& index) { return validInputs.test(index); });
+        }
 
-      std::vector<TrackTPC> tracks;
-      MCLabelContainer tracksMCTruth;
-      int retVal = tracker->runTracking(clusterIndex, &tracks, (processMC ? &tracksMCTruth : nullptr));
-      if (retVal != 0) {
-        // FIXME: error policy
-        LOG(ERROR) << "tracker returned error code " << retVal;
-      }
-      LOG(INFO) << "found " << tracks.size() << " track(s)";
-      pc.outputs().snapshot(OutputRef{ "output" }, tracks);
-      if (processMC) {
-        LOG(INFO) << "sending " << tracksMCTruth.getIndexedSize() << " track label(s)";
-        pc.outputs().snapshot(OutputRef{ "mclblout" }, tracksMCTruth);
+        std::vector<TrackTPC> tracks;
+        MCLabelContainer tracksMCTruth;
+        int retVal = tracker->runTracking(clusterIndex, &tracks, (processMC ? &tracksMCTruth : nullptr));
+        publishTracks(retVal, tracks, tracksMCTruth);
       }
 
       validInputs.reset();
       if (processMC) {
         validMcInputs.reset();
+        flatMcInputs.reset();
         for (auto& mcInput : mcInputs) {
           mcInput.clear();
         }
@@ -328,6 +434,7 @@ DataProcessorSpec getCATrackerSpec(bool processMC, std::vector<int> const& input
                             AlgorithmSpec(initFunction),
                             Options{
                               { "tracker-options", VariantType::String, "", { "Option string passed to tracker" } },
+                              { "tracker-async", VariantType::Bool, false, { "Track a time frame while the next one is prepared, the tracks are published one time frame later" } },
                             } };
 }
 
@@ -0,0 +1,197 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFReaderSpec.cxx
+/// @brief  Processor spec for reading TPC native clusters from a compressed time frame file
+
+#include "CTFReaderSpec.h"
+#include "Headers/DataHeader.h"
+#include "Framework/ControlService.h"
+#include "DataFormatsTPC/TPCSectorHeader.h"
+#include "TPCReconstruction/ClusterNativeCTF.h"
+#include "TPCBase/Sector.h"
+#include <FairMQLogger.h>
+#include <array>
+#include <cstring>
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#include <memory>     // for make_shared
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+using namespace o2::header;
+
+namespace o2
+{
+namespace TPC
+{
+
+DataProcessorSpec getCTFReaderSpec(std::vector<int> const& tpcSectors, std::vector<int> const& outputIds)
+{
+  if (tpcSectors.size() == 0 || outputIds.size() == 0) {
+    throw std::invalid_argument("need TPC sector and output id configuration");
+  }
+  constexpr static size_t NSectors = o2::TPC::Sector::MAXSECTOR;
+  // the file is memory mapped, the CTFs are decoded in place one after the other
+  struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+    ~MappedFile()
+    {
+      if (data != nullptr) {
+        munmap(const_cast<char*>(data), size);
+      }
+    }
+  };
+  struct ProcessAttributes {
+    MappedFile file;
+    size_t position = 0;
+    ClusterNativeCTFCoder coder;
+    std::array<std::vector<char>, NSectors> sectorData;
+    uint64_t configuredSectors = 0;
+    uint64_t activeSectors = 0;
+    std::vector<int> pendingSectors;
+    std::vector<int> outputIds;
+    size_t nCTFs = 0;
+    bool terminateOnEod = false;
+    bool finished = false;
+  };
+
+  auto initFunction = [tpcSectors, outputIds](InitContext& ic) {
+    auto filename = ic.options().get<std::string>("ctf-file");
+
+    auto processAttributes = std::make_shared<ProcessAttributes>();
+    {
+      processAttributes->terminateOnEod = ic.options().get<bool>("terminate-on-eod");
+      processAttributes->outputIds = outputIds;
+      for (auto const& s : tpcSectors) {
+        if (s >= NSectors) {
+          std::string message = std::string("invalid sector range specified, allowed 0-") + std::to_string(NSectors - 1);
+          LOG(ERROR) << message;
+          throw std::invalid_argument(message);
+        }
+        processAttributes->configuredSectors |= (uint64_t)0x1 << s;
+      }
+
+      int fd = open(filename.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw std::runtime_error("can not open CTF file " + filename);
+      }
+      struct stat st;
+      if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("can not stat CTF file " + filename);
+      }
+      auto& file = processAttributes->file;
+      if (st.st_size > 0) {
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+          close(fd);
+          throw std::runtime_error("can not map CTF file " + filename);
+        }
+        madvise(data, st.st_size, MADV_SEQUENTIAL);
+        file.data = reinterpret_cast<const char*>(data);
+        file.size = st.st_size;
+      }
+      close(fd);
+    }
+
+    // decode the next CTF, the sectors which are not configured are skipped
+    auto readCTF = [processAttributes]() {
+      auto& file = processAttributes->file;
+      auto& position = processAttributes->position;
+      if (position >= file.size) {
+        return false;
+      }
+      gsl::span<const char> data(file.data + position, file.size - position);
+      auto ctfSize = ClusterNativeCTFCoder::checkCTF(data);
+      auto& sectorData = processAttributes->sectorData;
+      auto nClusters = processAttributes->coder.decode(data.subspan(0, ctfSize), sectorData);
+      position += ctfSize;
+      processAttributes->nCTFs++;
+
+      auto& pendingSectors = processAttributes->pendingSectors;
+      auto& activeSectors = processAttributes->activeSectors;
+      pendingSectors.clear();
+      activeSectors = 0;
+      for (size_t sector = 0; sector < NSectors; ++sector) {
+        if (sectorData[sector].size() > 0 && (processAttributes->configuredSectors & ((uint64_t)0x1 << sector))) {
+          pendingSectors.push_back(sector);
+          activeSectors |= (uint64_t)0x1 << sector;
+        }
+      }
+      LOG(INFO) << "read CTF " << processAttributes->nCTFs << " with " << nClusters << " cluster(s), "
+                << pendingSectors.size() << " selected sector(s)";
+      return true;
+    };
+
+    // one sector per lane is published in every call, a CTF without selected sectors is
+    // published as noop
+    auto processingFct = [processAttributes, readCTF](ProcessingContext& pc) {
+      if (processAttributes->finished) {
+        return;
+      }
+      auto& pendingSectors = processAttributes->pendingSectors;
+      int operation = -2;
+      if (pendingSectors.empty() && !readCTF()) {
+        operation = -1;
+      }
+      auto pendingSector = pendingSectors.begin();
+      for (size_t lane = 0; lane < processAttributes->outputIds.size(); ++lane) {
+        o2::header::DataHeader::SubSpecificationType subSpec = processAttributes->outputIds[lane];
+        if (pendingSector == pendingSectors.end()) {
+          // FIXME define and use flags in the TPCSectorHeader, for now using the same schema as
+          // in the PublisherSpec, -1 -> end of data, -2 noop
+          o2::TPC::TPCSectorHeader header{ operation };
+          pc.outputs().snapshot(OutputRef{ "output", subSpec, { header } }, subSpec);
+          continue;
+        }
+        auto sector = *pendingSector++;
+        o2::TPC::TPCSectorHeader header{ sector };
+        header.activeSectors = processAttributes->activeSectors;
+        auto& data = processAttributes->sectorData[sector];
+        auto& chunk = pc.outputs().newChunk(OutputRef{ "output", subSpec, { header } }, data.size());
+        std::memcpy(chunk.data(), data.data(), data.size());
+      }
+      pendingSectors.erase(pendingSectors.begin(), pendingSector);
+
+      if ((processAttributes->finished = (operation == -1)) && processAttributes->terminateOnEod) {
+        pc.services().get<ControlService>().readyToQuit(false);
+      }
+    };
+
+    return processingFct;
+  };
+
+  auto createOutputSpecs = [outputIds]() {
+    std::vector<OutputSpec> outputSpecs;
+    for (auto const& outputId : outputIds) {
+      o2::header::DataHeader::SubSpecificationType subSpec = outputId;
+      outputSpecs.emplace_back(OutputSpec{ { "output" }, gDataOriginTPC, "CLUSTERNATIVE", subSpec, Lifetime::Timeframe });
+    }
+    return std::move(outputSpecs);
+  };
+
+  return DataProcessorSpec{ "tpc-ctf-reader",
+                            Inputs{}, // no inputs
+                            { createOutputSpecs() },
+                            AlgorithmSpec(initFunction),
+                            Options{
+                              { "ctf-file", VariantType::String, "tpc-clusters.ctf", { "Name of the CTF input file" } },
+                              { "terminate-on-eod", VariantType::Bool, true, { "terminate on end-of-data" } },
+                            } };
+}
+
+} // namespace TPC
+} // namespace o2
@@ -0,0 +1,28 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFReaderSpec.h
+/// @brief  Processor spec for reading TPC native clusters from a compressed time frame file
+
+#include "Framework/DataProcessorSpec.h"
+#include <vector>
+
+namespace o2
+{
+namespace TPC
+{
+
+/// create a processor spec
+/// read the compressed time frames (CTF) from a binary file and publish the decoded native
+/// clusters of the selected sectors, one CTF after the other
+framework::DataProcessorSpec getCTFReaderSpec(std::vector<int> const& tpcSectors, std::vector<int> const& outputIds);
+
+} // end namespace TPC
+} // end namespace o2
@@ -0,0 +1,182 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFWriterSpec.cxx
+/// @brief  Processor spec for writing TPC native clusters to a compressed time frame file
+
+#include "CTFWriterSpec.h"
+#include "Headers/DataHeader.h"
+#include "Framework/WorkflowSpec.h" // o2::framework::mergeInputs
+#include "Framework/DataRefUtils.h"
+#include "Framework/DataSpecUtils.h"
+#include "Framework/ControlService.h"
+#include "DataFormatsTPC/TPCSectorHeader.h"
+#include "TPCReconstruction/ClusterNativeCTF.h"
+#include "TPCBase/Sector.h"
+#include <FairMQLogger.h>
+#include <array>
+#include <bitset>
+#include <fstream>
+#include <memory> // for make_shared
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+using namespace o2::header;
+
+namespace o2
+{
+namespace TPC
+{
+
+DataProcessorSpec getCTFWriterSpec(std::vector<int> const& inputIds)
+{
+  constexpr static size_t NSectors = o2::TPC::Sector::MAXSECTOR;
+  struct ProcessAttributes {
+    // the sectors of a time frame can come in individual calls, the input is buffered until
+    // the data set is complete
+    std::array<std::vector<char>, NSectors> bufferedInputs;
+    std::bitset<NSectors> validInputs = 0;
+    std::vector<int> inputIds;
+    ClusterNativeCTFCoder coder;
+    std::vector<char> ctf;
+    std::ofstream file;
+    size_t nCTFs = 0;
+    size_t nBytes = 0;
+    bool readyToQuit = false;
+  };
+
+  auto initFunction = [inputIds](InitContext& ic) {
+    auto filename = ic.options().get<std::string>("ctf-file");
+
+    auto processAttributes = std::make_shared<ProcessAttributes>();
+    {
+      processAttributes->inputIds = inputIds;
+      auto& coder = processAttributes->coder;
+      coder.setTruncatedBits(ClusterNativeCTFCoder::TimeDelta, ic.options().get<int>("ctf-truncate-time"));
+      coder.setTruncatedBits(ClusterNativeCTFCoder::Pad, ic.options().get<int>("ctf-truncate-pad"));
+      auto sigmaBits = ic.options().get<int>("ctf-truncate-sigma");
+      coder.setTruncatedBits(ClusterNativeCTFCoder::SigmaTime, sigmaBits);
+      coder.setTruncatedBits(ClusterNativeCTFCoder::SigmaPad, sigmaBits);
+      auto chargeBits = ic.options().get<int>("ctf-truncate-charge");
+      coder.setTruncatedBits(ClusterNativeCTFCoder::QMax, chargeBits);
+      coder.setTruncatedBits(ClusterNativeCTFCoder::QTot, chargeBits);
+      processAttributes->file.open(filename, std::ios::binary | std::ios::trunc);
+      if (!processAttributes->file.good()) {
+        throw std::runtime_error("can not open CTF file " + filename);
+      }
+    }
+
+    auto processingFct = [processAttributes](ProcessingContext& pc) {
+      if (processAttributes->readyToQuit) {
+        return;
+      }
+      uint64_t activeSectors = 0;
+      int operation = 0;
+      auto& validInputs = processAttributes->validInputs;
+      std::array<DataRef, NSectors> datarefs;
+      std::bitset<NSectors> receivedInputs;
+      for (auto const& inputId : processAttributes->inputIds) {
+        std::string inputLabel = "input" + std::to_string(inputId);
+        auto ref = pc.inputs().get(inputLabel);
+        auto const* sectorHeader = DataRefUtils::getHeader<o2::TPC::TPCSectorHeader*>(ref);
+        if (sectorHeader == nullptr) {
+          LOG(ERROR) << "sector header missing on header stack";
+          return;
+        }
+        const int& sector = sectorHeader->sector;
+        // the operation is either eod (-1) or noop (-2), see PublisherSpec.cxx
+        if (sector < 0) {
+          if (operation == 0) {
+            operation = sector;
+          }
+          continue;
+        }
+        if (validInputs.test(sector)) {
+          throw std::runtime_error("can only have one data set per sector");
+        }
+        activeSectors |= sectorHeader->activeSectors;
+        validInputs.set(sector);
+        receivedInputs.set(sector);
+        datarefs[sector] = ref;
+      }
+
+      auto& bufferedInputs = processAttributes->bufferedInputs;
+      if (operation == -1) {
+        if (validInputs.any()) {
+          LOG(ERROR) << "dropping incomplete time frame with " << validInputs.count() << " sector(s) at end of data";
+        }
+        processAttributes->file.close();
+        LOG(INFO) << "wrote " << processAttributes->nCTFs << " CTF(s), " << processAttributes->nBytes << " byte(s)";
+        pc.services().get<ControlService>().readyToQuit(false);
+        processAttributes->readyToQuit = true;
+        return;
+      }
+      if (activeSectors == 0 || (activeSectors & validInputs.to_ulong()) != activeSectors) {
+        // not all sectors available, buffer the inputs until the data set is complete
+        for (size_t sector = 0; sector < NSectors; ++sector) {
+          if (receivedInputs.test(sector)) {
+            auto& ref = datarefs[sector];
+            bufferedInputs[sector].assign(ref.payload, ref.payload + DataRefUtils::getPayloadSize(ref));
+          }
+        }
+        return;
+      }
+
+      std::array<gsl::span<const char>, NSectors> inputs;
+      for (size_t sector = 0; sector < NSectors; ++sector) {
+        if (receivedInputs.test(sector)) {
+          inputs[sector] = gsl::span<const char>(datarefs[sector].payload, DataRefUtils::getPayloadSize(datarefs[sector]));
+        } else if (validInputs.test(sector)) {
+          inputs[sector] = gsl::span<const char>(bufferedInputs[sector].data(), bufferedInputs[sector].size());
+        }
+      }
+      auto& ctf = processAttributes->ctf;
+      ctf.clear();
+      auto nClusters = processAttributes->coder.encode(inputs, ctf);
+      processAttributes->file.write(ctf.data(), ctf.size());
+      if (!processAttributes->file.good()) {
+        throw std::runtime_error("failed to write CTF file");
+      }
+      processAttributes->nCTFs++;
+      processAttributes->nBytes += ctf.size();
+      LOG(INFO) << "wrote CTF with " << nClusters << " cluster(s) of " << validInputs.count() << " sector(s), "
+                << ctf.size() << " byte(s)";
+      validInputs.reset();
+    };
+
+    return processingFct;
+  };
+
+  auto createInputSpecs = [inputIds]() {
+    Inputs inputs = { InputSpec{ "input", gDataOriginTPC, "CLUSTERNATIVE", 0, Lifetime::Timeframe } };
+    return std::move(mergeInputs(inputs, inputIds.size(),
+                                 [inputIds](InputSpec& input, size_t index) {
+                                   input.binding += std::to_string(inputIds[index]);
+                                   DataSpecUtils::updateMatchingSubspec(input, inputIds[index]);
+                                 }));
+  };
+
+  return DataProcessorSpec{ "tpc-ctf-writer", // process id
+                            { createInputSpecs() },
+                            {}, // no outputs
+                            AlgorithmSpec(initFunction),
+                            Options{
+                              { "ctf-file", VariantType::String, "tpc-clusters.ctf", { "Name of the CTF output file" } },
+                              { "ctf-truncate-time", VariantType::Int, 0, { "number of LSBs of the packed time dropped in the CTF" } },
+                              { "ctf-truncate-pad", VariantType::Int, 0, { "number of LSBs of the packed pad dropped in the CTF" } },
+                              { "ctf-truncate-sigma", VariantType::Int, 0, { "number of LSBs of the packed sigmas dropped in the CTF" } },
+                              { "ctf-truncate-charge", VariantType::Int, 0, { "number of LSBs of the charges dropped in the CTF" } },
+                            } };
+}
+
+} // namespace TPC
+} // namespace o2
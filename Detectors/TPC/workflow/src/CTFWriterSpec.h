@@ -0,0 +1,28 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFWriterSpec.h
+/// @brief  Processor spec for writing TPC native clusters to a compressed time frame file
+
+#include "Framework/DataProcessorSpec.h"
+#include <vector>
+
+namespace o2
+{
+namespace TPC
+{
+
+/// create a processor spec
+/// encode the native clusters of all sectors of a time frame to one compressed time frame (CTF),
+/// the CTFs are appended to a binary file
+framework::DataProcessorSpec getCTFWriterSpec(std::vector<int> const& inputIds);
+
+} // end namespace TPC
+} // end namespace o2
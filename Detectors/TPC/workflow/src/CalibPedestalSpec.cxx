@@ -0,0 +1,103 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CalibPedestalSpec.cxx
+/// @brief  Processor spec for the TPC pedestal and noise calibration from raw CRU data
+
+#include "CalibPedestalSpec.h"
+#include "Framework/ControlService.h"
+#include "TPCCalibration/CalibPedestal.h"
+#include <FairMQLogger.h>
+#include <memory> // for make_shared
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace o2::framework;
+
+namespace o2
+{
+namespace TPC
+{
+
+DataProcessorSpec getCalibPedestalSpec()
+{
+  struct ProcessAttributes {
+    CalibPedestal calibPedestal;
+    size_t nThreads = 1;
+    int maxEvents = -1;
+    std::string outputFile;
+    bool finished = false;
+  };
+
+  auto initFunction = [](InitContext& ic) {
+    auto processAttributes = std::make_shared<ProcessAttributes>();
+    {
+      auto& calibPedestal = processAttributes->calibPedestal;
+      calibPedestal.setADCRange(ic.options().get<int>("adc-min"), ic.options().get<int>("adc-max"));
+      calibPedestal.setTimeBinRange(ic.options().get<int>("first-timebin"), ic.options().get<int>("last-timebin"));
+      calibPedestal.setStatisticsType(ic.options().get<int>("statistics-type") == 0 ? CalibPedestal::StatisticsType::GausFit
+                                                                                   : CalibPedestal::StatisticsType::MeanStdDev);
+      calibPedestal.setupContainers(ic.options().get<std::string>("input-spec").c_str());
+      if (calibPedestal.getNumberOfRawReadersCRU() == 0) {
+        throw std::runtime_error("no CRU raw data found for input-spec " + ic.options().get<std::string>("input-spec"));
+      }
+
+      auto nThreads = ic.options().get<int>("decoder-threads");
+      processAttributes->nThreads = nThreads > 0 ? nThreads : std::max(std::thread::hardware_concurrency(), 1u);
+      processAttributes->maxEvents = ic.options().get<int>("max-events");
+      processAttributes->outputFile = ic.options().get<std::string>("output-file");
+      LOG(INFO) << "decoding " << calibPedestal.getNumberOfRawReadersCRU() << " CRU raw reader(s) on "
+                << processAttributes->nThreads << " thread(s)";
+    }
+
+    // one event is processed per call, the calibration is finalized after the last one
+    auto processingFct = [processAttributes](ProcessingContext& pc) {
+      if (processAttributes->finished) {
+        return;
+      }
+      auto& calibPedestal = processAttributes->calibPedestal;
+      auto status = calibPedestal.processEventParallel(processAttributes->nThreads);
+      auto nEvents = calibPedestal.getNumberOfProcessedEvents();
+      LOG(INFO) << "processed event " << nEvents << " with status " << int(status);
+      if (status == CalibRawBase::ProcessStatus::Ok &&
+          (processAttributes->maxEvents < 0 || nEvents < size_t(processAttributes->maxEvents))) {
+        return;
+      }
+
+      calibPedestal.analyse();
+      calibPedestal.dumpToFile(processAttributes->outputFile);
+      LOG(INFO) << "pedestal and noise of " << nEvents << " event(s) written to " << processAttributes->outputFile;
+      processAttributes->finished = true;
+      pc.services().get<ControlService>().readyToQuit(true);
+    };
+
+    return processingFct;
+  };
+
+  return DataProcessorSpec{ "tpc-calib-pedestal",
+                            Inputs{},  // no inputs
+                            Outputs{}, // the calibration is written to file
+                            AlgorithmSpec(initFunction),
+                            Options{
+                              { "input-spec", VariantType::String, "", { "CRU raw data files, e.g. 'cru*.raw:1000' for 1000 time bins" } },
+                              { "output-file", VariantType::String, "Pedestals.root", { "name of the output file" } },
+                              { "decoder-threads", VariantType::Int, 0, { "number of decoding threads, 0 for the number of cores" } },
+                              { "max-events", VariantType::Int, -1, { "maximum number of events to process, -1 for all" } },
+                              { "adc-min", VariantType::Int, 0, { "minimum ADC value" } },
+                              { "adc-max", VariantType::Int, 120, { "maximum ADC value" } },
+                              { "first-timebin", VariantType::Int, 0, { "first time bin used in the analysis" } },
+                              { "last-timebin", VariantType::Int, 500, { "last time bin used in the analysis" } },
+                              { "statistics-type", VariantType::Int, 0, { "0: Gaus fit, 1: mean and standard deviation" } },
+                            } };
+}
+
+} // namespace TPC
+} // namespace o2
@@ -0,0 +1,28 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CalibPedestalSpec.h
+/// @brief  Processor spec for the TPC pedestal and noise calibration from raw CRU data
+
+#include "Framework/DataProcessorSpec.h"
+
+namespace o2
+{
+namespace TPC
+{
+
+/// create a processor spec
+/// decode the CRU raw data files given by the option 'input-spec' on several threads and
+/// accumulate the ADC values per pad, pedestal and noise are calculated and written to file
+/// at the end of the run
+framework::DataProcessorSpec getCalibPedestalSpec();
+
+} // end namespace TPC
+} // end namespace o2
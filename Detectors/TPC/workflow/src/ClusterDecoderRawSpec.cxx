@@ -56,8 +56,10 @@ DataProcessorSpec getClusterDecoderRawSpec(bool sendMC)
     // there is nothing to init at the moment
     auto verbosity = 0;
     auto decoder = std::make_shared<HardwareClusterDecoder>();
+    decoder->setNThreads(ic.options().get<int>("nthreads"));
+    auto flatMCLabels = ic.options().get<bool>("flat-mc-labels");
 
-    auto processSectorFunction = [verbosity, decoder](ProcessingContext& pc, std::string inputKey, std::string labelKey) -> bool {
+    auto processSectorFunction = [verbosity, decoder, flatMCLabels](ProcessingContext& pc, std::string inputKey, std::string labelKey) -> bool {
       // this will return a span of TPC clusters
       const auto& ref = pc.inputs().get(inputKey.c_str());
       auto size = o2::framework::DataRefUtils::getPayloadSize(ref);
@@ -146,8 +148,10 @@ DataProcessorSpec getClusterDecoderRawSpec(bool sendMC)
       // output of the decoder is sorted in (sector,globalPadRow) coordinates, individual
       // containers are created for clusters and MC labels per (sector,globalPadRow) address
       char* outputBuffer = nullptr;
-      auto outputAllocator = [&pc, &fanSpec, &outputBuffer, &rawHeaderStack](size_t size) -> char* {
+      size_t outputSize = 0;
+      auto outputAllocator = [&pc, &fanSpec, &outputBuffer, &outputSize, &rawHeaderStack](size_t size) -> char* {
         outputBuffer = pc.outputs().newChunk(Output{ gDataOriginTPC, DataDescription("CLUSTERNATIVE"), fanSpec, Lifetime::Timeframe, std::move(rawHeaderStack) }, size).data();
+        outputSize = size;
         return outputBuffer;
       };
       std::vector<MCLabelContainer> mcoutList;
@@ -166,8 +170,15 @@ DataProcessorSpec getClusterDecoderRawSpec(bool sendMC)
                     << std::accumulate(mcoutList.begin(), mcoutList.end(), size_t(0), [](size_t l, auto const& r) { return l + r.getIndexedSize(); })
                     << " label object(s)" << std::endl;
         }
-        // serialize the complete list of MC label containers
-        pc.outputs().snapshot(Output{ gDataOriginTPC, DataDescription("CLNATIVEMCLBL"), fanSpec, Lifetime::Timeframe, std::move(mcHeaderStack) }, mcoutList);
+        if (flatMCLabels) {
+          // one container for the sector in the flat layout, the tracker indexes it in place
+          std::vector<char> flatLabels;
+          ClusterNativeHelper::mergeSectorMCLabels(outputBuffer, outputSize, mcoutList).flatten_to(flatLabels);
+          pc.outputs().snapshot(Output{ gDataOriginTPC, DataDescription("CLNATIVEMCLBL"), fanSpec, Lifetime::Timeframe, std::move(mcHeaderStack) }, flatLabels);
+        } else {
+          // serialize the complete list of MC label containers
+          pc.outputs().snapshot(Output{ gDataOriginTPC, DataDescription("CLNATIVEMCLBL"), fanSpec, Lifetime::Timeframe, std::move(mcHeaderStack) }, mcoutList);
+        }
       }
       return false;
     };
@@ -241,7 +252,11 @@ DataProcessorSpec getClusterDecoderRawSpec(bool sendMC)
   return DataProcessorSpec{ processorName,
                             { createInputSpecs(sendMC) },
                             { createOutputSpecs(sendMC) },
-                            AlgorithmSpec(initFunction) };
+                            AlgorithmSpec(initFunction),
+                            Options{
+                              { "nthreads", VariantType::Int, 1, { "Number of threads decoding the sectors" } },
+                              { "flat-mc-labels", VariantType::Bool, false, { "Send the MC labels of a sector in one flat container, indexed in place by the tracker" } },
+                            } };
 }
 
 } // namespace TPC
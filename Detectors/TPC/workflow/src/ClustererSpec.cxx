@@ -17,7 +17,7 @@
 #include "Framework/ControlService.h"
 #include "Headers/DataHeader.h"
 #include "TPCBase/Digit.h"
-#include "TPCReconstruction/HwClusterer.h"
+#include "TPCReconstruction/HwClustererDriver.h"
 #include "TPCBase/Sector.h"
 #include "DataFormatsTPC/TPCSectorHeader.h"
 #include "DataFormatsTPC/Cluster.h"
@@ -45,26 +45,30 @@ DataProcessorSpec getClustererSpec(bool sendMC, bool haveDigTriggers)
 {
   std::string processorName = "tpc-clusterer";
 
-  constexpr static size_t NSectors = o2::TPC::Sector::MAXSECTOR;
   struct ProcessAttributes {
-    std::vector<o2::TPC::ClusterHardwareContainer8kb> clusterArray;
-    MCLabelContainer mctruthArray;
-    std::array<std::shared_ptr<o2::TPC::HwClusterer>, NSectors> clusterers;
+    std::unique_ptr<o2::TPC::HwClustererDriver> driver;
     int verbosity = 1;
     bool finished = false;
   };
 
-  auto initFunction = [](InitContext& ic) {
-    // FIXME: the clusterer needs to be initialized with the sector number, so we need one
-    // per sector. Taking a closer look to the HwClusterer, the sector number is only used
-    // for calculating the CRU id. This could be achieved by passing the current sector as
-    // parameter to the clusterer processing function.
+  auto initFunction = [sendMC](InitContext& ic) {
+    // the driver owns one clusterer per sector, the sectors received in one invocation
+    // are processed in parallel by the configured number of threads
     auto processAttributes = std::make_shared<ProcessAttributes>();
+    processAttributes->driver = std::make_unique<o2::TPC::HwClustererDriver>(ic.options().get<int>("nthreads"), sendMC);
+
+    /// the input data of one sector, kept until the outputs have been created
+    struct SectorInput {
+      o2::TPC::TPCSectorHeader sectorHeader{ -1 };
+      o2::header::DataHeader::SubSpecificationType fanSpec = 0;
+      bool sendLabels = false;
+      std::vector<o2::TPC::Digit> digits;
+      std::unique_ptr<const MCLabelContainer> labels;
+    };
 
-    auto processSectorFunction = [processAttributes](ProcessingContext& pc, std::string inputKey, std::string labelKey) -> bool {
-      auto& clusterArray = processAttributes->clusterArray;
-      auto& mctruthArray = processAttributes->mctruthArray;
-      auto& clusterers = processAttributes->clusterers;
+    // returns true if the input was an end-of-data control message, the sector
+    // data is added to the list of inputs to be processed otherwise
+    auto readSectorFunction = [processAttributes](ProcessingContext& pc, std::string inputKey, std::string labelKey, std::vector<SectorInput>& sectorInputs) -> bool {
       auto& verbosity = processAttributes->verbosity;
       auto dataref = pc.inputs().get(inputKey);
       auto const* sectorHeader = DataRefUtils::getHeader<o2::TPC::TPCSectorHeader*>(dataref);
@@ -86,53 +90,26 @@ DataProcessorSpec getClustererSpec(bool sendMC, bool haveDigTriggers)
         }
         return (sectorHeader->sector == -1);
       }
-      std::unique_ptr<const MCLabelContainer> inMCLabels;
+      sectorInputs.emplace_back();
+      auto& input = sectorInputs.back();
+      input.sectorHeader = *sectorHeader;
+      input.fanSpec = fanSpec;
+      input.sendLabels = !labelKey.empty();
       if (!labelKey.empty()) {
-        inMCLabels = std::move(pc.inputs().get<const MCLabelContainer*>(labelKey.c_str()));
-      }
-      auto inDigits = pc.inputs().get<const std::vector<o2::TPC::Digit>>(inputKey.c_str());
-      if (verbosity > 0 && inMCLabels) {
-        LOG(INFO) << "received " << inDigits.size() << " digits, "
-                  << inMCLabels->getIndexedSize() << " MC label objects";
+        input.labels = std::move(pc.inputs().get<const MCLabelContainer*>(labelKey.c_str()));
       }
-      if (!clusterers[sector]) {
-        // create the clusterer for this sector, take the same target arrays for all clusterers
-        // as they are not invoked in parallel
-        // the cost of creating the clusterer should be small so we do it in the processing
-        clusterers[sector] = std::make_shared<o2::TPC::HwClusterer>(&clusterArray, sector, &mctruthArray);
-      }
-      auto& clusterer = clusterers[sector];
-
-      if (verbosity > 0) {
-        LOG(INFO) << "processing " << inDigits.size() << " digit object(s) of sector " << sectorHeader->sector;
+      input.digits = pc.inputs().get<const std::vector<o2::TPC::Digit>>(inputKey.c_str());
+      if (verbosity > 0 && input.labels) {
+        LOG(INFO) << "received " << input.digits.size() << " digits, "
+                  << input.labels->getIndexedSize() << " MC label objects";
       }
-      // process the digits and MC labels, the bool parameter controls whether to clear all
-      // internal data or not. Have to clear it inside the process method as not only the containers
-      // are cleared but also the cluster counter. Clearing the containers externally leaves the
-      // cluster counter unchanged and leads to an inconsistency between cluster container and
-      // MC label container (the latter just grows with every call).
-      clusterer->process(inDigits, inMCLabels.get(), true /* clear output containers and cluster counter */);
-      const std::vector<o2::TPC::Digit> emptyDigits;
-      clusterer->finishProcess(emptyDigits, nullptr, false); // keep here the false, otherwise the clusters are lost of they are not stored in the meantime
       if (verbosity > 0) {
-        LOG(INFO) << "clusterer produced "
-                  << std::accumulate(clusterArray.begin(), clusterArray.end(), size_t(0), [](size_t l, auto const& r) { return l + r.getContainer()->numberOfClusters; })
-                  << " cluster(s)";
-        if (!labelKey.empty()) {
-          LOG(INFO) << "clusterer produced " << mctruthArray.getIndexedSize() << " MC label object(s)";
-        }
-      }
-      // FIXME: that should be a case for pmr, want to send the content of the vector as a binary
-      // block by using move semantics
-      auto outputPages = pc.outputs().make<ClusterHardwareContainer8kb>(Output{ gDataOriginTPC, "CLUSTERHW", fanSpec, Lifetime::Timeframe, { *sectorHeader } }, clusterArray.size());
-      std::copy(clusterArray.begin(), clusterArray.end(), outputPages.begin());
-      if (!labelKey.empty()) {
-        pc.outputs().snapshot(Output{ gDataOriginTPC, "CLUSTERHWMCLBL", fanSpec, Lifetime::Timeframe, { *sectorHeader } }, mctruthArray);
+        LOG(INFO) << "processing " << input.digits.size() << " digit object(s) of sector " << sectorHeader->sector;
       }
       return false;
     };
 
-    auto processingFct = [processAttributes, processSectorFunction](ProcessingContext& pc) {
+    auto processingFct = [processAttributes, readSectorFunction](ProcessingContext& pc) {
       if (processAttributes->finished) {
         return;
       }
@@ -152,11 +129,40 @@ DataProcessorSpec getClustererSpec(bool sendMC, bool haveDigTriggers)
         }
       }
       bool finished = true;
+      std::vector<SectorInput> sectorInputs;
       for (auto const& input : inputs) {
-        if (!processSectorFunction(pc, input.second.inputKey, input.second.labelKey)) {
+        if (!readSectorFunction(pc, input.second.inputKey, input.second.labelKey, sectorInputs)) {
           finished = false;
         }
       }
+
+      auto& driver = *processAttributes->driver;
+      std::vector<o2::TPC::HwClustererDriver::SectorInput> driverInputs;
+      for (auto const& input : sectorInputs) {
+        driverInputs.push_back({ input.sectorHeader.sector, &input.digits, input.labels.get() });
+      }
+      driver.process(driverInputs);
+
+      for (auto const& input : sectorInputs) {
+        auto const& clusterArray = driver.getClusters(input.sectorHeader.sector);
+        auto const& mctruthArray = driver.getLabels(input.sectorHeader.sector);
+        if (processAttributes->verbosity > 0) {
+          LOG(INFO) << "clusterer produced "
+                    << std::accumulate(clusterArray.begin(), clusterArray.end(), size_t(0), [](size_t l, auto const& r) { return l + r.getContainer()->numberOfClusters; })
+                    << " cluster(s) in sector " << input.sectorHeader.sector;
+          if (input.sendLabels) {
+            LOG(INFO) << "clusterer produced " << mctruthArray.getIndexedSize() << " MC label object(s)";
+          }
+        }
+        // FIXME: that should be a case for pmr, want to send the content of the vector as a binary
+        // block by using move semantics
+        auto outputPages = pc.outputs().make<ClusterHardwareContainer8kb>(Output{ gDataOriginTPC, "CLUSTERHW", input.fanSpec, Lifetime::Timeframe, { input.sectorHeader } }, clusterArray.size());
+        std::copy(clusterArray.begin(), clusterArray.end(), outputPages.begin());
+        if (input.sendLabels) {
+          pc.outputs().snapshot(Output{ gDataOriginTPC, "CLUSTERHWMCLBL", input.fanSpec, Lifetime::Timeframe, { input.sectorHeader } }, mctruthArray);
+        }
+      }
+
       if (finished) {
         // got EOD on all inputs
         processAttributes->finished = true;
@@ -199,7 +205,10 @@ DataProcessorSpec getClustererSpec(bool sendMC, bool haveDigTriggers)
   return DataProcessorSpec{ processorName,
                             { createInputSpecs(sendMC, haveDigTriggers) },
                             { createOutputSpecs(sendMC) },
-                            AlgorithmSpec(initFunction) };
+                            AlgorithmSpec(initFunction),
+                            Options{
+                              { "nthreads", VariantType::Int, 1, { "Number of threads processing the sectors" } },
+                            } };
 }
 
 } // namespace TPC
@@ -0,0 +1,186 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   DigitalCurrentSpec.cxx
+/// @since  2018-10-15
+/// @brief  Processor spec for the integration of the digital currents of TPC native clusters
+
+#include "DigitalCurrentSpec.h"
+#include "Headers/DataHeader.h"
+#include "Framework/WorkflowSpec.h" // o2::framework::mergeInputs
+#include "Framework/DataRefUtils.h"
+#include "Framework/DataSpecUtils.h"
+#include "Framework/ControlService.h"
+#include "DataFormatsTPC/TPCSectorHeader.h"
+#include "DataFormatsTPC/ClusterNative.h"
+#include "DataFormatsTPC/ClusterNativeHelper.h"
+#include "TPCReconstruction/DigitalCurrentClusterIntegrator.h"
+#include "TPCBase/Mapper.h"
+#include "TPCBase/Sector.h"
+#include <FairMQLogger.h>
+#include <bitset>
+#include <memory> // for make_shared
+#include <vector>
+#include <stdexcept>
+
+using namespace o2::framework;
+using namespace o2::header;
+
+namespace o2
+{
+namespace TPC
+{
+
+/// Input: native clusters of the sectors, the inputs of the lanes are merged
+/// Output: the integrated charges of all pads, sector by sector and row by row in one flat vector,
+/// published once per time interval of a configurable number of time frames
+///
+/// A time frame is complete once the clusters of all its active sectors have been integrated,
+/// the sectors of one processing call are integrated in parallel.
+DataProcessorSpec getDigitalCurrentSpec(std::vector<int> const& inputIds)
+{
+  constexpr static size_t NSectors = o2::TPC::Sector::MAXSECTOR;
+  using MCLabelContainer = o2::dataformats::MCTruthContainer<o2::MCCompLabel>;
+
+  struct ProcessAttributes {
+    DigitalCurrentClusterIntegrator integrator;
+    std::unique_ptr<ClusterNativeAccessFullTPC> clusterIndex;
+    std::vector<int> inputIds;
+    std::bitset<NSectors> integratedSectors = 0; // sectors of the current time frame
+    uint64_t activeSectors = 0;
+    int nThreads = 1;
+    int interval = 1;
+    int nTimeFrames = 0; // complete time frames in the current interval
+    bool readyToQuit = false;
+  };
+
+  auto initFunction = [inputIds](InitContext& ic) {
+    auto processAttributes = std::make_shared<ProcessAttributes>();
+    processAttributes->inputIds = inputIds;
+    processAttributes->clusterIndex = std::make_unique<ClusterNativeAccessFullTPC>();
+    processAttributes->nThreads = ic.options().get<int>("nthreads");
+    processAttributes->interval = ic.options().get<int>("interval");
+    if (processAttributes->interval < 1) {
+      throw std::invalid_argument("the integration interval must be at least one time frame");
+    }
+
+    // all pads of all sectors, in the order of the global pad rows
+    auto publishCurrents = [processAttributes](ProcessingContext& pc) {
+      auto& integrator = processAttributes->integrator;
+      const Mapper& mapper = Mapper::instance();
+      std::vector<unsigned long long int> currents;
+      currents.reserve(NSectors * mapper.getPadsInSector());
+      for (size_t sector = 0; sector < NSectors; sector++) {
+        for (int row = 0; row < mapper.getNumberOfRows(); row++) {
+          int nPads = mapper.getNumberOfPadsInRowSector(row);
+          auto const* rowCurrents = integrator.getCurrents(sector, row);
+          if (rowCurrents) {
+            currents.insert(currents.end(), rowCurrents, rowCurrents + nPads);
+          } else {
+            currents.insert(currents.end(), nPads, 0);
+          }
+        }
+      }
+      o2::TPC::TPCSectorHeader sh{ 0 };
+      sh.activeSectors = processAttributes->activeSectors;
+      pc.outputs().snapshot(OutputRef{ "output", 0, { sh } }, currents);
+      integrator.clear();
+      processAttributes->nTimeFrames = 0;
+    };
+
+    auto processingFct = [processAttributes, publishCurrents](ProcessingContext& pc) {
+      if (processAttributes->readyToQuit) {
+        return;
+      }
+      std::array<gsl::span<const char>, NSectors> inputs;
+      std::array<std::vector<MCLabelContainer>, NSectors> mcInputs; // no labels needed
+      std::bitset<NSectors> validInputs = 0;
+      int operation = 0;
+      for (auto const& inputId : processAttributes->inputIds) {
+        std::string inputLabel = "input" + std::to_string(inputId);
+        auto ref = pc.inputs().get(inputLabel);
+        auto const* sectorHeader = DataRefUtils::getHeader<o2::TPC::TPCSectorHeader*>(ref);
+        if (sectorHeader == nullptr) {
+          LOG(ERROR) << "sector header missing on header stack";
+          return;
+        }
+        const int& sector = sectorHeader->sector;
+        if (sector < 0) {
+          if (operation < 0 && operation != sector) {
+            LOG(ERROR) << "inconsistent lane operation, got " << sector << ", expecting " << operation;
+          } else if (operation == 0) {
+            operation = sector;
+          }
+          continue;
+        }
+        if (validInputs.test(sector)) {
+          throw std::runtime_error("can only have one data set per sector");
+        }
+        validInputs.set(sector);
+        processAttributes->activeSectors |= sectorHeader->activeSectors;
+        inputs[sector] = gsl::span<const char>(ref.payload, DataRefUtils::getPayloadSize(ref));
+      }
+
+      if (operation == -1) {
+        // the currents of an incomplete interval are published before the end-of-data
+        if (processAttributes->nTimeFrames > 0 || processAttributes->integratedSectors.any()) {
+          publishCurrents(pc);
+        }
+        o2::TPC::TPCSectorHeader sh{ -1 };
+        sh.activeSectors = processAttributes->activeSectors;
+        pc.outputs().snapshot(OutputRef{ "output", 0, { sh } }, -1);
+        pc.services().get<ControlService>().readyToQuit(false);
+        processAttributes->readyToQuit = true;
+        return;
+      }
+      if (validInputs.none()) {
+        return;
+      }
+
+      auto& clusterIndex = *processAttributes->clusterIndex;
+      ClusterNativeHelper::Reader::fillIndex(clusterIndex, inputs, mcInputs, [&validInputs](auto& index) { return validInputs.test(index); });
+      processAttributes->integrator.integrateClusters(clusterIndex, processAttributes->nThreads);
+
+      auto& integratedSectors = processAttributes->integratedSectors;
+      integratedSectors |= validInputs;
+      auto activeSectors = processAttributes->activeSectors;
+      if (activeSectors == 0 || (activeSectors & integratedSectors.to_ulong()) != activeSectors) {
+        return;
+      }
+      integratedSectors.reset();
+      if (++processAttributes->nTimeFrames == processAttributes->interval) {
+        publishCurrents(pc);
+      }
+    };
+
+    return processingFct;
+  };
+
+  auto createInputSpecs = [inputIds]() {
+    Inputs inputs = { InputSpec{ "input", gDataOriginTPC, "CLUSTERNATIVE", 0, Lifetime::Timeframe } };
+    return std::move(mergeInputs(inputs, inputIds.size(),
+                                 [inputIds](InputSpec& input, size_t index) {
+                                   input.binding += std::to_string(inputIds[index]);
+                                   DataSpecUtils::updateMatchingSubspec(input, inputIds[index]);
+                                 }));
+  };
+
+  return DataProcessorSpec{ "tpc-digital-current",
+                            { createInputSpecs() },
+                            { OutputSpec{ { "output" }, gDataOriginTPC, "DIGITALCURRENTS", 0, Lifetime::Timeframe } },
+                            AlgorithmSpec(initFunction),
+                            Options{
+                              { "nthreads", VariantType::Int, 1, { "Number of threads integrating the sectors" } },
+                              { "interval", VariantType::Int, 1, { "Number of time frames integrated into one publication of the currents" } },
+                            } };
+}
+
+} // namespace TPC
+} // namespace o2
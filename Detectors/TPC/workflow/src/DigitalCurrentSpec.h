@@ -0,0 +1,27 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   DigitalCurrentSpec.h
+/// @since  2018-10-15
+/// @brief  Processor spec for the integration of the digital currents of TPC native clusters
+
+#include "Framework/DataProcessorSpec.h"
+
+namespace o2
+{
+namespace TPC
+{
+
+/// create a processor spec
+/// integrate the charges of the native clusters per pad and publish the currents per time interval
+framework::DataProcessorSpec getDigitalCurrentSpec(std::vector<int> const& inputIds);
+
+} // end namespace TPC
+} // end namespace o2
@@ -24,6 +24,7 @@
 #include <vector>
 #include <utility>   // std::move
 #include <stdexcept> //std::invalid_argument
+#include <algorithm> // std::max
 
 using namespace o2::framework;
 using namespace o2::header;
@@ -60,6 +61,8 @@ DataProcessorSpec getPublisherSpec(PublisherConf const& config, bool propagateMC
     auto mcbrName = ic.options().get<std::string>(config.mcbranch.option.c_str());
     auto nofEvents = ic.options().get<int>("nevents");
     auto publishingMode = nofEvents == -1 ? RootTreeReader::PublishingMode::Single : RootTreeReader::PublishingMode::Loop;
+    auto cacheSize = RootTreeReader::CacheSize{ ic.options().get<int>("tree-cache-size") * 1024ll * 1024ll };
+    auto readAhead = RootTreeReader::ReadAhead{ static_cast<size_t>(std::max(ic.options().get<int>("read-ahead"), 0)) };
 
     auto processAttributes = std::make_shared<ProcessAttributes>();
     {
@@ -102,6 +105,8 @@ DataProcessorSpec getPublisherSpec(PublisherConf const& config, bool propagateMC
                                                              filename.c_str(), // input file name
                                                              nofEvents,        // number of entries to publish
                                                              publishingMode,
+                                                             cacheSize,
+                                                             readAhead,
                                                              Output{ dto.origin, dto.description, subSpec, persistency },
                                                              clusterbranchname.c_str(), // name of cluster branch
                                                              Output{ mco.origin, mco.description, subSpec, persistency },
@@ -112,6 +117,8 @@ DataProcessorSpec getPublisherSpec(PublisherConf const& config, bool propagateMC
                                                              filename.c_str(), // input file name
                                                              nofEvents,        // number of entries to publish
                                                              publishingMode,
+                                                             cacheSize,
+                                                             readAhead,
                                                              Output{ dto.origin, dto.description, subSpec, persistency },
                                                              clusterbranchname.c_str() // name of cluster branch
                                                              );
@@ -221,6 +228,8 @@ DataProcessorSpec getPublisherSpec(PublisherConf const& config, bool propagateMC
                               { mcb.option.c_str(), VariantType::String, mcb.defval.c_str(), { mcb.help.c_str() } },
                               { "nevents", VariantType::Int, -1, { "number of events to run" } },
                               { "terminate-on-eod", VariantType::Bool, true, { "terminate on end-of-data" } },
+                              { "tree-cache-size", VariantType::Int, 0, { "size of the TTreeCache in MB, 0 to disable" } },
+                              { "read-ahead", VariantType::Int, 0, { "number of entries to read ahead on a background thread" } },
                             } };
 }
 } // end namespace TPC
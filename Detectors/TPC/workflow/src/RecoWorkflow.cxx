@@ -21,6 +21,9 @@
 #include "ClustererSpec.h"
 #include "ClusterDecoderRawSpec.h"
 #include "CATrackerSpec.h"
+#include "CTFWriterSpec.h"
+#include "CTFReaderSpec.h"
+#include "DigitalCurrentSpec.h"
 #include "Algorithm/RangeTokenizer.h"
 #include "TPCBase/Digit.h"
 #include "DataFormatsTPC/Constants.h"
@@ -57,6 +60,7 @@ const std::unordered_map<std::string, InputType> InputMap{
   { "digits", InputType::Digits },
   { "raw", InputType::Raw },
   { "clusters", InputType::Clusters },
+  { "ctf", InputType::CTF },
 };
 
 const std::unordered_map<std::string, OutputType> OutputMap{
@@ -64,6 +68,8 @@ const std::unordered_map<std::string, OutputType> OutputMap{
   { "raw", OutputType::Raw },
   { "clusters", OutputType::Clusters },
   { "tracks", OutputType::Tracks },
+  { "ctf", OutputType::CTF },
+  { "currents", OutputType::Currents },
 };
 
 framework::WorkflowSpec getWorkflow(std::vector<int> const& tpcSectors, std::vector<int> const& laneConfiguration,
@@ -92,6 +98,12 @@ framework::WorkflowSpec getWorkflow(std::vector<int> const& tpcSectors, std::vec
   if (inputType == InputType::Clusters && (isEnabled(OutputType::Digits) || isEnabled(OutputType::Raw))) {
     throw std::invalid_argument("input/output type mismatch, can not produce 'digits', nor 'raw' from 'clusters'");
   }
+  if (inputType == InputType::CTF && (isEnabled(OutputType::Digits) || isEnabled(OutputType::Raw))) {
+    throw std::invalid_argument("input/output type mismatch, can not produce 'digits', nor 'raw' from 'ctf'");
+  }
+  if (inputType == InputType::CTF && propagateMC) {
+    throw std::invalid_argument("MC labels are not stored in the CTF, MC propagation needs to be disabled for input type 'ctf'");
+  }
 
   WorkflowSpec specs;
 
@@ -131,17 +143,23 @@ framework::WorkflowSpec getWorkflow(std::vector<int> const& tpcSectors, std::vec
                                                    laneConfiguration,
                                                  },
                                                  propagateMC));
+  } else if (inputType == InputType::CTF) {
+    specs.emplace_back(o2::TPC::getCTFReaderSpec(tpcSectors, laneConfiguration));
   }
 
   // output matrix
   bool runTracker = isEnabled(OutputType::Tracks);
-  bool runDecoder = runTracker || isEnabled(OutputType::Clusters);
+  bool runCTFWriter = isEnabled(OutputType::CTF);
+  bool runIntegrator = isEnabled(OutputType::Currents);
+  bool runDecoder = runTracker || runCTFWriter || runIntegrator || isEnabled(OutputType::Clusters);
   bool runClusterer = runDecoder || isEnabled(OutputType::Raw);
 
   // input matrix
   runClusterer &= inputType == InputType::Digitizer || inputType == InputType::Digits;
   runDecoder &= runClusterer || inputType == InputType::Raw;
-  runTracker &= runDecoder || inputType == InputType::Clusters;
+  runTracker &= runDecoder || inputType == InputType::Clusters || inputType == InputType::CTF;
+  runCTFWriter &= runDecoder || inputType == InputType::Clusters || inputType == InputType::CTF;
+  runIntegrator &= runDecoder || inputType == InputType::Clusters || inputType == InputType::CTF;
 
   WorkflowSpec parallelProcessors;
   //////////////////////////////////////////////////////////////////////////////////////////////
@@ -318,6 +336,15 @@ framework::WorkflowSpec getWorkflow(std::vector<int> const& tpcSectors, std::vec
                                                                         "mcbranch" }));
   }
 
+  //////////////////////////////////////////////////////////////////////////////////////////////
+  //
+  // a writer process for compressed time frames of TPC native clusters
+  //
+  // selected by output type 'ctf'
+  if (runCTFWriter) {
+    specs.emplace_back(o2::TPC::getCTFWriterSpec(laneConfiguration));
+  }
+
   //////////////////////////////////////////////////////////////////////////////////////////////
   //
   // tracker process
@@ -327,6 +354,15 @@ framework::WorkflowSpec getWorkflow(std::vector<int> const& tpcSectors, std::vec
     specs.emplace_back(o2::TPC::getCATrackerSpec(propagateMC, laneConfiguration));
   }
 
+  //////////////////////////////////////////////////////////////////////////////////////////////
+  //
+  // integration of the digital currents
+  //
+  // selected by output type 'currents'
+  if (runIntegrator) {
+    specs.emplace_back(o2::TPC::getDigitalCurrentSpec(laneConfiguration));
+  }
+
   //////////////////////////////////////////////////////////////////////////////////////////////
   //
   // a writer process for tracks
@@ -0,0 +1,27 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   tpc-calib-pedestal.cxx
+/// @brief  DPL workflow for the TPC pedestal and noise calibration from raw CRU data
+
+#include "Framework/WorkflowSpec.h"
+#include "CalibPedestalSpec.h"
+
+#include "Framework/runDataProcessing.h" // the main driver
+
+using namespace o2::framework;
+
+/// The workflow executable for the TPC pedestal calibration, the CRU raw data files are
+/// decoded in parallel within one device, see the options of the tpc-calib-pedestal
+/// processor for the configuration
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{ o2::TPC::getCalibPedestalSpec() };
+}
@@ -0,0 +1,103 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_TRDSPARSEARRAY_H
+#define O2_TRDSPARSEARRAY_H
+
+#include <vector>
+
+namespace o2
+{
+namespace trd
+{
+
+// Sparse container of the time series of the pads of one chamber, the sparse
+// counterpart of TRDArraySignal and TRDArrayADC for the low TRD occupancy.
+// Only the pads with data own a block of ntime values. The blocks are contiguous
+// in one buffer which keeps its memory when the array is reset or allocated for
+// the next chamber, such that a long lived array does not allocate any more.
+template <typename T>
+class TRDSparseArray
+{
+ public:
+  TRDSparseArray() = default;
+
+  // Sets the dimensions of the chamber, without any pad with data
+  void allocate(int nrow, int ncol, int ntime)
+  {
+    reset();
+    mNrow = nrow;
+    mNcol = ncol;
+    mNtime = ntime;
+    mPadIndex.resize(nrow * ncol, -1); // all the entries are -1 after the reset
+  }
+
+  // Removes the pads with data, only the entries of these pads are touched
+  void reset()
+  {
+    for (int pad : mPads) {
+      mPadIndex[pad] = -1;
+    }
+    mPads.clear();
+    mData.clear();
+  }
+
+  int getNrow() const { return mNrow; }
+  int getNcol() const { return mNcol; }
+  int getNtime() const { return mNtime; }
+  bool hasData() const { return !mPads.empty(); }
+
+  // The time series of the pad, nullptr if the pad has no data
+  const T* getPad(int row, int col) const
+  {
+    const int index = mPadIndex[row * mNcol + col];
+    return index < 0 ? nullptr : &mData[index * mNtime];
+  }
+
+  // The time series of the pad, created with zeros if the pad has no data.
+  // The pointer is invalidated by the creation of the next pad.
+  T* getOrCreatePad(int row, int col)
+  {
+    const int pad = row * mNcol + col;
+    if (mPadIndex[pad] < 0) {
+      mPadIndex[pad] = mPads.size();
+      mPads.push_back(pad);
+      mData.resize(mData.size() + mNtime, T(0));
+    }
+    return &mData[mPadIndex[pad] * mNtime];
+  }
+
+  T getData(int row, int col, int time) const
+  {
+    const T* data = getPad(row, col);
+    return data ? data[time] : T(0);
+  }
+  void addData(int row, int col, int time, T value) { getOrCreatePad(row, col)[time] += value; }
+
+  // Loop over the pads with data, in the order of their creation
+  int getNpads() const { return mPads.size(); }
+  int getPadRow(int i) const { return mPads[i] / mNcol; }
+  int getPadCol(int i) const { return mPads[i] % mNcol; }
+  const T* getPadData(int i) const { return &mData[i * mNtime]; }
+  T* getPadData(int i) { return &mData[i * mNtime]; }
+
+ private:
+  int mNrow{ 0 };             // Number of rows of the chamber
+  int mNcol{ 0 };             // Number of columns of the chamber
+  int mNtime{ 0 };            // Number of time bins
+  std::vector<int> mPadIndex; // Position of each pad (row * ncol + col) in mPads, -1 if no data
+  std::vector<int> mPads;     // The pads with data
+  std::vector<T> mData;       // The time series of the pads with data, in the order of mPads
+};
+
+} // namespace trd
+} // namespace o2
+
+#endif
@@ -12,7 +12,13 @@
 #define ALICEO2_TRD_DIGITIZER_H_
 
 #include "TRDBase/Digit.h"
+#include "TRDBase/TRDCommonParam.h"
+#include "TRDBase/TRDGeometryFlat.h"
+#include "TRDBase/TRDSparseArray.h"
 #include "TRDSimulation/Detector.h"
+#include <TRandom3.h>
+#include <array>
+#include <memory>
 
 namespace o2
 {
@@ -30,25 +36,51 @@ class Digitizer
   void setEventTime(double timeNS) { mTime = timeNS; }
   void setEventID(int entryID) { mEventID = entryID; }
   void setSrcID(int sourceID) { mSrcID = sourceID; }
+  // The detectors are digitized in parallel with more than one thread
+  void setNThreads(int nThreads) { mNThreads = nThreads > 0 ? nThreads : 1; }
+  int getNThreads() const { return mNThreads; }
 
  private:
   TRDGeometry* mGeom = nullptr;
+  std::unique_ptr<TRDGeometryFlat> mGeomFlat; // Pad planes and chambers used in the digitization hot path
 
   double mTime = 0.;
   int mEventID = 0;
   int mSrcID = 0;
 
-  bool mSDigits; // true: convert signals to summable digits, false by default
+  bool mSDigits;     // true: convert signals to summable digits, false by default
+  int mNThreads = 1; // Number of threads digitizing the detectors
 
-  std::vector<o2::trd::HitType> mHitContainer; // The container of hits in a given detector
+  // Data used to digitize one detector, one set per thread and reused for all the detectors
+  struct DetectorContext {
+    std::vector<o2::trd::HitType> hitContainer;           // The container of hits in a given detector
+    std::vector<std::array<double, 3>> hitLocalPositions; // The local positions of these hits
+    TRDSparseArray<float> signals;                        // The signals of the pads of the detector with a signal
+    TRDSparseArray<short> adcs;                           // The zero-suppressed ADC values of the detector
+    std::vector<short> padADCs;                           // The ADC values of one pad before the zero suppression
+    std::vector<double> electronRndm;                     // The random numbers of the electrons of a hit
+    TRandom3 random;                                      // The random generator, seeded for each detector
+  };
+  std::vector<std::unique_ptr<DetectorContext>> mContexts;
 
-  bool getHitContainer(const int, const std::vector<o2::trd::HitType>&, std::vector<o2::trd::HitType>&); // True if there are hits in the detector
+  std::vector<int> mHitIndices;                           // Indices of the hits sorted by detector
+  std::array<int, kNdet + 1> mDetectorHitOffsets;         // First entry of each detector in mHitIndices
+  std::vector<std::array<double, 3>> mLocalPositions;     // Local positions of all the hits
+  std::vector<std::array<double, 12>> mChamberTransforms; // Global to local transformation of each detector
+  std::vector<char> mHasChamberTransform;                 // Detectors with a transformation taken from TGeo
+  std::vector<char> mIsDigitized;                         // Detectors with processed hits
+
+  void initGeometry();
+  bool navigateToChamber(const int, const double*, std::array<double, 12>&); // True if the transformation holds for the whole detector
+  void sortHitsByDetector(const std::vector<o2::trd::HitType>&);
+  void computeLocalPositions(const std::vector<o2::trd::HitType>&);
+  bool getHitContainer(const int, const std::vector<o2::trd::HitType>&, DetectorContext&); // True if there are hits in the detector
   // Digitization chaing methods
-  bool convertHits(const int, const std::vector<o2::trd::HitType>&, int&); // True if hit-to-signal conversion is successful
-  bool convertSignalsToDigits(const int, int&);                            // True if signal-to-digit conversion is successful
-  bool convertSignalsToSDigits(const int, int&);                           // True if singal-to-sdigit conversion is successful
-  bool convertSignalsToADC(const int, int&);                               // True if signal-to-ADC conversion is successful
-  bool diffusion(float, double, double, double&, double&, double&);        // True if diffusion is applied successfully
+  bool convertHits(const int, DetectorContext&, int&);                    // True if hit-to-signal conversion is successful
+  bool convertSignalsToDigits(const int, DetectorContext&);               // True if signal-to-digit conversion is successful
+  bool convertSignalsToSDigits(const int, DetectorContext&);              // True if singal-to-sdigit conversion is successful
+  bool convertSignalsToADC(const int, DetectorContext&);                  // True if signal-to-ADC conversion is successful
+  bool diffusionSigmas(float, double, double, double&, double&, double&); // True if the diffusion widths are available
 };
 } // namespace trd
 } // namespace o2
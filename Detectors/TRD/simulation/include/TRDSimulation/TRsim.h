@@ -22,8 +22,8 @@
 #define ALICEO2_TRD_TRSIM_H_
 
 #include <TMath.h>
-
-class TH1D;
+#include <array>
+#include <vector>
 
 namespace o2
 {
@@ -37,6 +37,7 @@ class TRsim
   void init();
   int createPhotons(int pdg, float p, std::vector<float>& ePhoton);
   int calculatePhotons(float p, float mass, std::vector<float>& ePhoton);
+  double computeSpectrum(double gamma, int foils, double* spectrum) const;
   double getSigma(double energykeV);
   double interpolate(double energyMeV, double* en, const double* const mu, int n);
   int locate(double* xv, int n, double xval, int& kl, double& dx);
@@ -63,11 +64,13 @@ class TRsim
   {
     mFoilZ = z;
     mFoilOmega = getOmega(mFoilDens, mFoilZ, mFoilA);
+    resetTables();
   };
   void setFoilA(float a)
   {
     mFoilA = a;
     mFoilOmega = getOmega(mFoilDens, mFoilZ, mFoilA);
+    resetTables();
   };
   void setGapDens(float d)
   {
@@ -79,11 +82,13 @@ class TRsim
   {
     mGapZ = z;
     mGapOmega = getOmega(mGapDens, mGapZ, mGapA);
+    resetTables();
   };
   void setGapA(float a)
   {
     mGapA = a;
     mGapOmega = getOmega(mGapDens, mGapZ, mGapA);
+    resetTables();
   };
   void setTemp(float t)
   {
@@ -109,7 +114,6 @@ class TRsim
   double getFoilgetOmega() const { return mFoilOmega; };
   double getGapgetOmega() const { return mGapOmega; };
   float getTemp() const { return mTemp / 273.16; };
-  TH1D* getSpectrum() const { return mSpectrum; };
 
  protected:
   static constexpr int mNFoilsDim = 7;      // Dimension of the NFoils array
@@ -132,7 +136,22 @@ class TRsim
   float mSpLower;                           // Lower border of the TR spectrum
   float mSpUpper;                           // Upper border of the TR spectrum
   std::array<double, mSpNBins> mSigma;      // [mSpNBins] Array of sigma values
-  TH1D* mSpectrum = nullptr;                // TR photon energy spectrum
+
+  // Tables of the TR spectrum per number of foils and gamma node, the gamma
+  // nodes being equidistant in log10(gamma) from gamma = 1 to gamma = 10^6
+  static constexpr int mNGammaNodes = 601;      // Number of gamma nodes of the TR tables
+  static constexpr double mGammaLogStep = 0.01; // Step of the gamma nodes in log10(gamma)
+  struct SpectrumTable {
+    bool filled = false;                 // The table has been computed
+    double nTr = 0;                      // Mean number of TR photons
+    std::array<float, mSpNBins + 1> cdf; // Cumulative distribution of the TR photon energy
+  };
+  std::vector<SpectrumTable> mTables; //! [mNFoilsDim * mNGammaNodes] Tables, computed on demand
+
+  void resetTables();
+  int selectNFoilsIndex(float p) const;
+  const SpectrumTable& getTable(int foilsIndex, int gammaNode);
+  double sampleEnergy(const SpectrumTable& table) const;
 };
 } // namespace trd
 } // namespace o2
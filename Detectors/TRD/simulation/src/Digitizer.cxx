@@ -9,7 +9,15 @@
 // or submit itself to any jurisdiction.
 
 #include <TGeoManager.h>
+#include <TGeoMatrix.h>
+#include <TGeoVolume.h>
 #include <TRandom.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <thread>
 
 #include "TRDSimulation/Digitizer.h"
 #include "TRDBase/TRDGeometry.h"
@@ -20,6 +28,14 @@
 
 using namespace o2::trd;
 
+namespace
+{
+// FIX ME: Default drift velocity until the calibration objects are implemented, see convertHits
+constexpr float kCalVdriftDetValue = 1.48; // cm/microsecond
+// FIX ME: Zero suppression threshold in ADC counts above the baseline, until the FEE configuration is implemented
+constexpr int kADCZeroSuppressionThreshold = 3;
+} // namespace
+
 Digitizer::Digitizer()
 {
   // Check if you need more initialization
@@ -46,62 +62,229 @@ void Digitizer::process(std::vector<HitType> const& hits, std::vector<Digit>& di
   int totalNumberOfProcessedHits = 0;
   LOG(INFO) << "Start of processing " << hits.size() << " hits";
 
-  for (int det = 0; det < kNdet; ++det) {
-    // Loop over all TRD detectors
+  if (!mGeomFlat) {
+    initGeometry();
+  }
 
+  // The hits are grouped by detector in one pass, and the local coordinates are computed
+  // here for all of them, such that the detectors are then independent
+  sortHitsByDetector(hits);
+  computeLocalPositions(hits);
+
+  // Create the parameter singletons and sample the drift time map before digitizing
+  TRDSimParam* simParam = TRDSimParam::Instance();
+  TRDCommonParam* commonParam = TRDCommonParam::Instance();
+  if (simParam && commonParam && simParam->TimeStructOn()) {
+    commonParam->TimeStruct(kCalVdriftDetValue, 0., 0.);
+  }
+
+  // The detectors with hits, each of them digitized with its own random sequence
+  std::vector<int> detectors;
+  for (int det = 0; det < kNdet; ++det) {
     // Jump to the next detector if the detector is
     // switched off, not installed, etc
     /*
     if (calibration->IsChamberNoData(det)) {
       continue;
     }
-    if (!mGeo->ChamberInGeometry(det)) {
-      continue
-    }
     */
-
-    mHitContainer.clear();
-    // Skip detectors without hits
-    if (!getHitContainer(det, hits, mHitContainer)) {
-      // move to next det if no hits are found for this det
+    if (!mGeomFlat->chamberInGeometry(det)) {
       continue;
     }
-    totalNumberOfProcessedHits += mHitContainer.size();
-    int signals = 0; // dummy variable for now
-    if (!convertHits(det, mHitContainer, signals)) {
-      LOG(INFO) << "TRD converstion of hits failed for detector " << det;
-      signals = 0; //
+    // Skip detectors without hits
+    if (mDetectorHitOffsets[det + 1] > mDetectorHitOffsets[det]) {
+      detectors.push_back(det);
     }
+  }
+  const UInt_t seed = gRandom->Integer(kMaxUInt);
+  mIsDigitized.assign(kNdet, false);
 
-    digits.emplace_back();
-  } // end of loop over detectors
+  const int nThreads = std::max(1, std::min<int>(mNThreads, detectors.size()));
+  while (int(mContexts.size()) < nThreads) {
+    mContexts.emplace_back(std::make_unique<DetectorContext>());
+  }
+  std::atomic<int> nextDetector(0);
+  std::atomic<int> nProcessedHits(0);
+  std::vector<std::exception_ptr> exceptions(nThreads);
+  auto processDetectors = [&](int thread) {
+    try {
+      auto& context = *mContexts[thread];
+      for (int idet = nextDetector++; idet < int(detectors.size()); idet = nextDetector++) {
+        const int det = detectors[idet];
+        getHitContainer(det, hits, context);
+        context.random.SetSeed(ULong_t(seed) * kNdet + det + 1);
+        nProcessedHits += context.hitContainer.size();
+        int signals = 0; // dummy variable for now
+        if (!convertHits(det, context, signals)) {
+          LOG(INFO) << "TRD converstion of hits failed for detector " << det;
+          signals = 0; //
+        }
+        mIsDigitized[det] = true;
+      }
+    } catch (...) {
+      exceptions[thread] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int thread = 1; thread < nThreads; ++thread) {
+    threads.emplace_back(processDetectors, thread);
+  }
+  processDetectors(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+  totalNumberOfProcessedHits = nProcessedHits;
+
+  // The digits in the order of the detectors
+  for (int det = 0; det < kNdet; ++det) {
+    if (mIsDigitized[det]) {
+      digits.emplace_back();
+    }
+  }
   LOG(INFO) << "End of processing " << totalNumberOfProcessedHits << " hits";
 }
 
-bool Digitizer::getHitContainer(const int det, const std::vector<HitType>& hits, std::vector<HitType>& hitContainer)
+void Digitizer::initGeometry()
 {
   //
-  // Fills the hit vector for hits in detector number det
-  // Returns false if there are no hits in the dectector
+  // Builds the pad planes and the chamber matrices from the loaded geometry, and keeps them
+  // in the flat geometry, which is read concurrently by the threads digitizing the detectors
+  //
+  if (!gGeoManager) {
+    LOG(FATAL) << "Geometry is not loaded";
+  }
+  mGeom->createPadPlaneArray();
+  mGeom->createClusterMatrixArray();
+  mGeomFlat = std::make_unique<TRDGeometryFlat>(*mGeom);
+  mChamberTransforms.resize(kNdet);
+  mHasChamberTransform.assign(kNdet, false);
+}
+
+void Digitizer::sortHitsByDetector(const std::vector<HitType>& hits)
+{
   //
+  // Fills mHitIndices with the indices of the hits grouped by detector,
+  // the hits of detector det being between mDetectorHitOffsets[det] and mDetectorHitOffsets[det + 1]
+  //
+  mDetectorHitOffsets.fill(0);
   for (const auto& hit : hits) {
-    if (hit.GetDetectorID() == det) {
-      hitContainer.push_back(hit);
+    const int det = hit.GetDetectorID();
+    if (det >= 0 && det < kNdet) {
+      ++mDetectorHitOffsets[det + 1];
+    }
+  }
+  for (int det = 0; det < kNdet; ++det) {
+    mDetectorHitOffsets[det + 1] += mDetectorHitOffsets[det];
+  }
+  mHitIndices.resize(mDetectorHitOffsets[kNdet]);
+  std::array<int, kNdet> next;
+  std::copy(mDetectorHitOffsets.begin(), mDetectorHitOffsets.begin() + kNdet, next.begin());
+  for (int ihit = 0; ihit < int(hits.size()); ++ihit) {
+    const int det = hits[ihit].GetDetectorID();
+    if (det >= 0 && det < kNdet) {
+      mHitIndices[next[det]++] = ihit;
     }
   }
-  if (hitContainer.size() == 0) {
+}
+
+bool Digitizer::navigateToChamber(const int det, const double* pos, std::array<double, 12>& transform)
+{
+  //
+  // Fills the transformation from the global coordinates to the local coordinates of computeLocalPositions
+  // with the TGeo volume at pos. Returns true if the volume is the drift or amplification region of the
+  // detector, such that the transformation is valid for all its hits
+  //
+  const float kAmWidth = TRDGeometry::amThick(); // Width of the amplification region
+  const float kDrWidth = TRDGeometry::drThick(); // Width of the drift retion
+
+  gGeoManager->SetCurrentPoint(pos);
+  gGeoManager->FindNode();
+  const TGeoHMatrix* matrix = gGeoManager->GetCurrentMatrix();
+  const double* rot = matrix->GetRotationMatrix();
+  const double* tra = matrix->GetTranslation();
+  // local = rot^T * (global - tra)
+  for (int i = 0; i < 3; ++i) {
+    transform[9 + i] = 0;
+    for (int j = 0; j < 3; ++j) {
+      transform[3 * i + j] = rot[3 * j + i];
+      transform[9 + i] -= rot[3 * j + i] * tra[j];
+    }
+  }
+
+  // The drift (UJ) and amplification (UK) volumes of the chamber, numbered by the det-sec
+  const char* name = gGeoManager->GetCurrentVolume()->GetName();
+  const bool inAmplification = name[0] == 'U' && name[1] == 'K';
+  const bool inDrift = name[0] == 'U' && name[1] == 'J';
+  if (inDrift) {
+    transform[11] -= kDrWidth / 2 + kAmWidth / 2;
+  }
+  return (inAmplification || inDrift) && std::strlen(name) == 4 && std::atoi(name + 2) == TRDGeometry::getDetectorSec(det);
+}
+
+void Digitizer::computeLocalPositions(const std::vector<HitType>& hits)
+{
+  //
+  // Computes the position of the hits in the local coordinate system of the amplification or drift volume,
+  // with respect to the wire plane
+  // loc [0] -  col direction in amplification or drift volume
+  // loc [1] -  row direction in amplification or drift volume
+  // loc [2] -  time direction in amplification or drift volume
+  //
+  // The TGeo navigation is done for the first hit of each detector only, the transformation
+  // of its volume being then applied to all the hits of the detector
+  //
+  double pos[3];
+  mLocalPositions.resize(mHitIndices.size());
+  for (int det = 0; det < kNdet; ++det) {
+    auto& transform = mChamberTransforms[det];
+    for (int i = mDetectorHitOffsets[det]; i < mDetectorHitOffsets[det + 1]; ++i) {
+      const auto& hit = hits[mHitIndices[i]];
+      auto& loc = mLocalPositions[i];
+      pos[0] = hit.GetX();
+      pos[1] = hit.GetY();
+      pos[2] = hit.GetZ();
+      if (!mHasChamberTransform[det]) {
+        mHasChamberTransform[det] = navigateToChamber(det, pos, transform);
+      }
+      // Go to the local coordinate system
+      for (int k = 0; k < 3; ++k) {
+        loc[k] = transform[3 * k] * pos[0] + transform[3 * k + 1] * pos[1] + transform[3 * k + 2] * pos[2] + transform[9 + k];
+      }
+    }
+  }
+}
+
+bool Digitizer::getHitContainer(const int det, const std::vector<HitType>& hits, DetectorContext& context)
+{
+  //
+  // Fills the hit vector for hits in detector number det, with their local positions
+  // Returns false if there are no hits in the dectector
+  //
+  context.hitContainer.clear();
+  context.hitLocalPositions.clear();
+  for (int i = mDetectorHitOffsets[det]; i < mDetectorHitOffsets[det + 1]; ++i) {
+    context.hitContainer.push_back(hits[mHitIndices[i]]);
+    context.hitLocalPositions.push_back(mLocalPositions[i]);
+  }
+  if (context.hitContainer.size() == 0) {
     return false;
   }
   return true;
 }
 
-bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int& arraySignal)
+bool Digitizer::convertHits(const int det, DetectorContext& context, int& arraySignal)
 {
   //
   // Convert the detector-wise sorted hits to detector signals
   //
 
-  LOG(INFO) << "Start converting " << hits.size() << " hits for detector " << det;
+  const auto& hits = context.hitContainer;
+  LOG(DEBUG) << "Start converting " << hits.size() << " hits for detector " << det;
 
   // Number of track dictionary arrays
   // const int kNdict     = AliTRDdigitsManager::kNDict;
@@ -133,8 +316,6 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
 
   int timeBinTRFend = 0;
 
-  double pos[3];
-  double loc[3];
   double padSignal[kNpad];
   double signalOld[kNpad];
 
@@ -149,7 +330,7 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
   // Defaults values  from OCDB (AliRoot DrawTrending macro - Thanks to Y. Pachmayer)
   // For 5 TeV pp - 27 runs from LHC15n
   //
-  float calVdriftDetValue = 1.48; // cm/microsecond         // calVdriftDet->GetValue(det); PLEASE FIX ME when CCDB is ready
+  float calVdriftDetValue = kCalVdriftDetValue; // cm/microsecond         // calVdriftDet->GetValue(det); PLEASE FIX ME when CCDB is ready
   float calT0DetValue = -1.38;    // microseconds           // calT0Det->GetValue(det);     PLEASE FIX ME when CCDB is ready
   double calExBDetValue = 0.16;   // T * V/cm (check units) // calExBDet->GetValue(det);    PLEASE FIX ME when CCDB is ready
 
@@ -164,15 +345,16 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
   const float samplingRate = commonParam->GetSamplingFrequency();
   const float elAttachProp = simParam->GetElAttachProp() / 100;
 
-  const TRDPadPlane* padPlane = mGeom->getPadPlane(det);
-  const int layer = mGeom->getLayer(det);
+  const TRDPadPlane* padPlane = mGeomFlat->getPadPlane(det);
+  const int layer = mGeomFlat->getLayer(det);
   const float rowEndROC = padPlane->getRowEndROC();
   const float row0 = padPlane->getRow0ROC();
   const int nRowMax = padPlane->getNrows();
   const int nColMax = padPlane->getNcols();
 
-  // Allocate space for signals
-  // arraySignal->Allocate(nRowMax,nColMax,nTimeTotal);
+  // The sparse signal array of the context is reused for all the detectors,
+  // only the pads which receive a signal take memory
+  context.signals.allocate(nRowMax, nColMax, nTimeTotal);
 
   // Create a new array for the dictionary
   // for (int dict = 0; dict < kNdict; dict++) {
@@ -181,25 +363,13 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
   // }
 
   // Loop over hits
-  for (const auto& hit : hits) {
-    pos[0] = hit.GetX();
-    pos[1] = hit.GetY();
-    pos[2] = hit.GetZ();
-    gGeoManager->SetCurrentPoint(pos);
-    gGeoManager->FindNode();
-    // Go to the local coordinate system
-    // loc [0] -  col direction in amplification or drift volume
-    // loc [1] -  row direction in amplification or drift volume
-    // loc [2] -  time direction in amplification or drift volume
-    gGeoManager->MasterToLocal(pos, loc);
+  for (size_t ihit = 0; ihit < hits.size(); ++ihit) {
+    const auto& hit = hits[ihit];
+    // The local coordinates with respect to the wire plane, see computeLocalPositions
+    const auto& loc = context.hitLocalPositions[ihit];
 
     const int qTotal = hit.GetCharge();
 
-    const int inDrift = std::strstr(gGeoManager->GetPath(), "/UK") ? 0 : 1;
-    if (inDrift) {
-      loc[2] = loc[2] - kDrWidth / 2 - kAmWidth / 2;
-    }
-
     const double driftLength = -1 * loc[2]; // The drift length in cm without diffusion
 
     // Patch to take care of TR photons that are absorbed
@@ -235,8 +405,28 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
     }
     double driftVelocity = calVdriftDetValue; // * calVdriftROC->GetValue(colE, rowE); PLEASE FIX ME when CCDB is ready
 
-    // Loop over all created electrons
+    // The diffusion widths are the same for all the electrons of the hit
+    double sigmaRow = 0, sigmaCol = 0, sigmaTime = 0;
+    if (simParam->DiffusionOn()) {
+      if (!diffusionSigmas(driftVelocity, absDriftLength, calExBDetValue, sigmaRow, sigmaCol, sigmaTime)) {
+        continue;
+      }
+    }
+
+    // Draw the random numbers of all the electrons at once: first the electron attachment
+    // and the gas gain (uniform), then the diffusion in row, col and time (normal)
     const int nElectrons = abs(qTotal);
+    auto& rndm = context.electronRndm;
+    rndm.resize(5 * nElectrons);
+    context.random.RndmArray(2 * nElectrons, rndm.data());
+    const double* gaus = rndm.data() + 2 * nElectrons;
+    if (simParam->DiffusionOn()) {
+      for (int i = 2 * nElectrons; i < 5 * nElectrons; ++i) {
+        rndm[i] = context.random.Gaus(0., 1.);
+      }
+    }
+
+    // Loop over all created electrons
     for (int el = 0; el < nElectrons; ++el) {
       /* 
       Now the real local coordinate system of the ROC
@@ -255,16 +445,16 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
 
       // Electron attachment
       if (simParam->ElAttachOn()) {
-        if (gRandom->Rndm() < absDriftLength * elAttachProp) {
+        if (rndm[2 * el] < absDriftLength * elAttachProp) {
           continue;
         }
       }
 
       // Apply diffusion smearing
       if (simParam->DiffusionOn()) {
-        if (!diffusion(driftVelocity, absDriftLength, calExBDetValue, locR, locC, locT)) {
-          continue;
-        }
+        locR += sigmaRow * gaus[3 * el];
+        locC += sigmaCol * gaus[3 * el + 1];
+        locT += sigmaTime * gaus[3 * el + 2];
       }
 
       // Apply E x B effects
@@ -274,7 +464,7 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
 
       // The electron position after diffusion and ExB in pad coordinates.
       rowE = padPlane->getPadRowNumberROC(locR);
-      if (rowE) {
+      if (rowE < 0) {
         continue;
       }
       rowOffset = padPlane->getPadRowOffsetROC(rowE, locR);
@@ -309,11 +499,8 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
         driftTime = abs(locT) / driftVelocity + hit.GetTime();
       }
 
-      // Apply the gas gain including fluctuations
-      double ggRndm = 0.0;
-      do {
-        ggRndm = gRandom->Rndm();
-      } while (ggRndm <= 0);
+      // Apply the gas gain including fluctuations (the random number is never 0)
+      double ggRndm = rndm[2 * el + 1];
       double signal = -(simParam->GetGasGain()) * TMath::Log(ggRndm);
 
       // Apply the pad response
@@ -370,8 +557,12 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
           if (colPos >= nColMax) {
             break;
           }
-          // Add the signals
-          // signalOld[iPad] = arraySignal->GetData(rowE, colPos, iTimeBin); ******* TO BE ADDED LATER REQUIRES ARRAYSIGNALS
+          // Add the signals, the pads without contribution are not created
+          if (padSignal[iPad] == 0) {
+            continue;
+          }
+          float* padSignals = context.signals.getOrCreatePad(rowE, colPos);
+          signalOld[iPad] = padSignals[iTimeBin];
           if (colPos != colE) {
             // Cross talk added to non-central pads
             signalOld[iPad] += padSignal[iPad] * (timeResponse + crossTalk);
@@ -379,10 +570,7 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
             // Without cross talk at central pad
             signalOld[iPad] += padSignal[iPad] * timeResponse;
           }
-
-          // ******* TO BE ADDED LATER REQUIRES ARRAYSIGNALS
-          // arraySignal->SetData(rowE, colPos, iTimeBin, signalOld[iPad]); ******* TO BE ADDED LATER REQUIRES ARRAYSIGNALS
-          // ******* TO BE ADDED LATER REQUIRES ARRAYSIGNALS
+          padSignals[iTimeBin] = signalOld[iPad];
 
           // Store the track index in the dictionary
           // Note: We store index+1 in order to allow the array to be compressed
@@ -408,7 +596,7 @@ bool Digitizer::convertHits(const int det, const std::vector<HitType>& hits, int
   return true;
 }
 
-bool Digitizer::convertSignalsToDigits(const int det, int& arraySignal)
+bool Digitizer::convertSignalsToDigits(const int det, DetectorContext& context)
 {
   //
   // Converstion of signals to digits
@@ -417,12 +605,12 @@ bool Digitizer::convertSignalsToDigits(const int det, int& arraySignal)
   LOG(INFO) << "Start converting signals for detector " << det;
   if (mSDigits) {
     // Convert the signal array to s-digits
-    if (!convertSignalsToSDigits(det, arraySignal)) {
+    if (!convertSignalsToSDigits(det, context)) {
       return false;
     }
   } else {
     // Convert the signal array to digits
-    if (!convertSignalsToADC(det, arraySignal)) {
+    if (!convertSignalsToADC(det, context)) {
       return false;
     }
     // Run digital processing for digits
@@ -433,7 +621,7 @@ bool Digitizer::convertSignalsToDigits(const int det, int& arraySignal)
   return true;
 }
 
-bool Digitizer::convertSignalsToSDigits(const int det, int& arraySignal)
+bool Digitizer::convertSignalsToSDigits(const int det, DetectorContext& context)
 {
   //
   // Convert signals to S-digits
@@ -442,7 +630,7 @@ bool Digitizer::convertSignalsToSDigits(const int det, int& arraySignal)
   return true;
 }
 
-bool Digitizer::convertSignalsToADC(const int det, int& signals)
+bool Digitizer::convertSignalsToADC(const int det, DetectorContext& context)
 {
   //
   // Converts the sampled electron signals to ADC values for a given chamber
@@ -476,114 +664,93 @@ bool Digitizer::convertSignalsToADC(const int det, int& signals)
   // The electronics baseline in electrons
   double baselineEl = baseline / convert;
 
-  int row = 0;
-  int col = 0;
-  int time = 0;
-
-  int nRowMax = mGeom->getPadPlane(det)->getNrows();
-  int nColMax = mGeom->getPadPlane(det)->getNcols();
-  int nTimeTotal = 100; // fDigitsManager->GetDigitsParam()->GetNTimeBins(det);
-  // if (fSDigitsManager->GetDigitsParam()->GetNTimeBins(det)) {
-  //   nTimeTotal = fSDigitsManager->GetDigitsParam()->GetNTimeBins(det);
-  // } else {
-  //   LOG(FATAL) << "Could not get number of time bins";
-  //   return false;
-  // }
+  const auto& signals = context.signals;
+  auto& adcs = context.adcs;
+  int nRowMax = mGeomFlat->getPadPlane(det)->getNrows();
+  int nColMax = mGeomFlat->getPadPlane(det)->getNcols();
+  int nTimeTotal = signals.getNtime(); // fDigitsManager->GetDigitsParam()->GetNTimeBins(det);
 
   // The gain factor calibration objects
   // const AliTRDCalDet* calGainFactorDet = calibration->GetGainFactorDet();
   // AliTRDCalROC* calGainFactorROC = 0x0;
   float calGainFactorDetValue = 0.0;
 
-  // AliTRDarrayADC* digits = 0x0;
-  int digits = 0;
-
-  if (!signals) {
-    LOG(FATAL) << "Signals array for detector " << det << " does not exis";
-    return false;
-  }
-  // if (signals->HasData()) {
-  //   // Expand the container if neccessary
-  //   signals->Expand();
-  // } else {
-  //   // Create missing containers
-  //   signals->Allocate(nRowMax, nColMax, nTimeTotal);
-  // }
-
-  // Get the container for the digits of this detector
-  // if (fDigitsManager->HasSDigits()) {
-  //   AliError("Digits manager has s-digits");
-  //   return false;
-  // }
-
-  // digits = (AliTRDarrayADC*)fDigitsManager->GetDigits(det);
-  // // Allocate memory space for the digits buffer
-  // if (!digits->HasData()) {
-  //   digits->Allocate(nRowMax, nColMax, nTimeTotal);
-  // }
-
   // Get the calibration objects
   // calGainFactorROC = calibration->GetGainFactorROC(det);
   // calGainFactorDetValue = calGainFactorDet->GetValue(det);
 
-  // Create the digits for this chamber
-  for (row = 0; row < nRowMax; row++) {
-    for (col = 0; col < nColMax; col++) {
-
-      // halfchamber masking
-      int iMcm = (int)(col / 18);               // current group of 18 col pads
-      int halfchamberside = (iMcm > 3 ? 1 : 0); // 0=Aside, 1=Bside
-      // Halfchambers that are switched off, masked by calibration
-      // if (calibration->IsHalfChamberNoData(det, halfchamberside))
-      //   continue;
-
-      // Check whether pad is masked
-      // Bridged pads are not considered yet!!!
-      // if (calibration->IsPadMasked(det, col, row) ||
-      //     calibration->IsPadNotConnected(det, col, row)) {
-      //   continue;
-      // }
-
-      // The gain factors
-      float padgain = calGainFactorDetValue; // * calGainFactorROC->GetValue(col, row);
-      if (padgain <= 0) {
-        const auto msg = Form("Not a valid gain %f, %d %d %d", padgain, det, col, row);
-        LOG(FATAL) << msg;
+  // The sparse ADC array of the context is reused for all the detectors
+  adcs.allocate(nRowMax, nColMax, nTimeTotal);
+  auto& padADCs = context.padADCs;
+  padADCs.resize(nTimeTotal);
+  const int adcThreshold = simParam->GetADCbaseline() + kADCZeroSuppressionThreshold;
+
+  // Create the digits for the pads with a signal. The other pads would only have
+  // noise, which is removed by the zero suppression
+  for (int ipad = 0; ipad < signals.getNpads(); ipad++) {
+    const int row = signals.getPadRow(ipad);
+    const int col = signals.getPadCol(ipad);
+
+    // halfchamber masking
+    int iMcm = (int)(col / 18);               // current group of 18 col pads
+    int halfchamberside = (iMcm > 3 ? 1 : 0); // 0=Aside, 1=Bside
+    // Halfchambers that are switched off, masked by calibration
+    // if (calibration->IsHalfChamberNoData(det, halfchamberside))
+    //   continue;
+
+    // Check whether pad is masked
+    // Bridged pads are not considered yet!!!
+    // if (calibration->IsPadMasked(det, col, row) ||
+    //     calibration->IsPadNotConnected(det, col, row)) {
+    //   continue;
+    // }
+
+    // The gain factors
+    float padgain = calGainFactorDetValue; // * calGainFactorROC->GetValue(col, row);
+    if (padgain <= 0) {
+      const auto msg = Form("Not a valid gain %f, %d %d %d", padgain, det, col, row);
+      LOG(FATAL) << msg;
+    }
+
+    const float* padSignals = signals.getPadData(ipad);
+    bool aboveThreshold = false;
+    for (int time = 0; time < nTimeTotal; time++) {
+      // Get the signal amplitude
+      float signalAmp = padSignals[time];
+      // Pad and time coupling
+      signalAmp *= coupling;
+      // Gain factors
+      signalAmp *= padgain;
+      // Add the noise, starting from minus ADC baseline in electrons
+      signalAmp = TMath::Max(context.random.Gaus(signalAmp, simParam->GetNoise()), -baselineEl);
+      // Convert to mV
+      signalAmp *= convert;
+      // Add ADC baseline in mV
+      signalAmp += baseline;
+      // Convert to ADC counts. Set the overflow-bit fADCoutRange if the
+      // signal is larger than fADCinRange
+      short adc = 0;
+      if (signalAmp >= simParam->GetADCinRange()) {
+        adc = ((short)simParam->GetADCoutRange());
+      } else {
+        adc = TMath::Nint(signalAmp * adcConvert);
       }
+      padADCs[time] = adc;
+      aboveThreshold |= adc > adcThreshold;
+    } // for: time
 
-      for (time = 0; time < nTimeTotal; time++) {
-        // Get the signal amplitude
-        float signalAmp = 99; //signals->GetData(row, col, time);
-        // Pad and time coupling
-        signalAmp *= coupling;
-        // Gain factors
-        signalAmp *= padgain;
-        // Add the noise, starting from minus ADC baseline in electrons
-        signalAmp = TMath::Max((double)gRandom->Gaus(signalAmp, simParam->GetNoise()), -baselineEl);
-        // Convert to mV
-        signalAmp *= convert;
-        // Add ADC baseline in mV
-        signalAmp += baseline;
-        // Convert to ADC counts. Set the overflow-bit fADCoutRange if the
-        // signal is larger than fADCinRange
-        short adc = 0;
-        if (signalAmp >= simParam->GetADCinRange()) {
-          adc = ((short)simParam->GetADCoutRange());
-        } else {
-          adc = TMath::Nint(signalAmp * adcConvert);
-        }
-        // Saving all digits
-        // digits->SetData(row, col, time, adc);
-      } // for: time
-    }   // for: col
-  }     // for: row
+    // Zero suppression on the fly, only the pads above the threshold are stored
+    if (aboveThreshold) {
+      std::copy(padADCs.begin(), padADCs.end(), adcs.getOrCreatePad(row, col));
+    }
+  } // for: pads
   return true;
 }
 
-bool Digitizer::diffusion(float vdrift, double absdriftlength, double exbvalue, double& lRow, double& lCol, double& lTime)
+bool Digitizer::diffusionSigmas(float vdrift, double absdriftlength, double exbvalue, double& sigmaRow, double& sigmaCol, double& sigmaTime)
 {
   //
-  // Applies the diffusion smearing to the position of a single electron.
+  // Computes the widths of the diffusion smearing of the electron positions.
   // Depends on absolute drift length.
   //
   float diffL = 0.0;
@@ -592,13 +759,13 @@ bool Digitizer::diffusion(float vdrift, double absdriftlength, double exbvalue,
     float driftSqrt = TMath::Sqrt(absdriftlength);
     float sigmaT = driftSqrt * diffT;
     float sigmaL = driftSqrt * diffL;
-    lRow = gRandom->Gaus(lRow, sigmaT);
+    sigmaRow = sigmaT;
     if (TRDCommonParam::Instance()->ExBOn()) {
-      lCol = gRandom->Gaus(lCol, sigmaT * 1.0 / (1.0 + exbvalue * exbvalue));
-      lTime = gRandom->Gaus(lTime, sigmaL * 1.0 / (1.0 + exbvalue * exbvalue));
+      sigmaCol = sigmaT * 1.0 / (1.0 + exbvalue * exbvalue);
+      sigmaTime = sigmaL * 1.0 / (1.0 + exbvalue * exbvalue);
     } else {
-      lCol = gRandom->Gaus(lCol, sigmaT);
-      lTime = gRandom->Gaus(lTime, sigmaL);
+      sigmaCol = sigmaT;
+      sigmaTime = sigmaL;
     }
     return true;
   } else {
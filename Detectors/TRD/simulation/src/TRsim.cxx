@@ -39,7 +39,6 @@
 //                                                                        //
 ////////////////////////////////////////////////////////////////////////////
 
-#include <TH1.h>
 #include <TRandom.h>
 #include <TMath.h>
 #include <TVirtualMC.h>
@@ -49,6 +48,9 @@
 
 #include "FairModule.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace o2::trd;
 
 //_____________________________________________________________________________
@@ -107,13 +109,7 @@ void TRsim::init()
   mSpLower = 1.0 - 0.5 * mSpBinWidth;
   mSpUpper = mSpLower + mSpRange;
 
-  if (mSpectrum) {
-    delete mSpectrum;
-  }
-  mSpectrum = new TH1D("TRspectrum", "TR spectrum", mSpNBins, mSpLower, mSpUpper);
-  mSpectrum->SetDirectory(nullptr);
-
-  // Set the sigma values
+  // Set the sigma values, the TR tables are computed when needed
   setSigma();
 }
 
@@ -162,6 +158,8 @@ int TRsim::calculatePhotons(float p, float mass, std::vector<float>& ePhoton)
   // Produces TR photons using a parametric model for regular radiator. Photons
   // with energy larger than 15 keV are included in the MC stack and tracked by VMC
   // machinary.
+  // The TR spectrum is taken from tables in log10(gamma), computed once per gamma node
+  // and number of foils, and linearly interpolated between the two nodes around gamma.
   //
   // Input parameters:
   // p    - parent momentum (GeV/c)
@@ -171,15 +169,83 @@ int TRsim::calculatePhotons(float p, float mass, std::vector<float>& ePhoton)
   // ePhoton - energy container of this photons in keV.
   //
 
-  const double kAlpha = 0.0072973;
-  const int kSumMax = 30;
-  double tau = mGapThick / mFoilThick;
   // Calculate gamma
   double gamma = TMath::Sqrt(p * p + mass * mass) / mass;
   // Select the number of foils corresponding to momentum
-  int foils = selectNFoils(p);
+  int foilsIndex = selectNFoilsIndex(p);
+
+  // The TR spectra at the gamma nodes around gamma (saturated above the last node)
+  double node = std::min(std::max(std::log10(gamma) / mGammaLogStep, 0.0), mNGammaNodes - 1.0);
+  int lowNode = std::min(static_cast<int>(node), mNGammaNodes - 2);
+  double fraction = node - lowNode;
+  const SpectrumTable& lowTable = getTable(foilsIndex, lowNode);
+  const SpectrumTable& upTable = getTable(foilsIndex, lowNode + 1);
+
+  // <nTR>
+  double nTrLow = (1.0 - fraction) * lowTable.nTr;
+  float nTr = nTrLow + fraction * upTable.nTr;
+  // Number of TR photons from Poisson distribution with mean <nTr>
+  int nPhCand = gRandom->Poisson(nTr);
+  if (nPhCand == 0) {
+    return 1;
+  }
+
+  // Link the MC stack and get info about parent electron
+  TVirtualMCStack* stack = TVirtualMC::GetMC()->GetStack();
+  int track = stack->GetCurrentTrackNumber();
+  double px, py, pz, ptot;
+  TVirtualMC::GetMC()->TrackMomentum(px, py, pz, ptot);
+  ptot = TMath::Sqrt(px * px + py * py + pz * pz);
+  px /= ptot;
+  py /= ptot;
+  pz /= ptot;
+  // Current position of electron
+  double x, y, z;
+  TVirtualMC::GetMC()->TrackPosition(x, y, z);
+  double t = TVirtualMC::GetMC()->TrackTime();
+  for (int iPhoton = 0; iPhoton < nPhCand; ++iPhoton) {
+    // Energy of the TR photon, from the spectrum of one of the nodes chosen in
+    // proportion of its contribution to the interpolated spectrum
+    double e = sampleEnergy((gRandom->Rndm() * nTr < nTrLow) ? lowTable : upTable);
+    // Put TR photon on particle stack
+    if (e > 15) {
+      e *= 1e-6; // Convert it to GeV
+      int phtrack;
+      stack->PushTrack(1,                // Must be 1
+                       track,            // Identifier of the parent track, -1 for a primary
+                       22,               // Particle code.
+                       px * e,           // 4 momentum (The photon is generated on the same
+                       py * e,           // direction as the parent. For irregular radiator one
+                       pz * e,           // can calculate also the angle but this is a second
+                       e,                // order effect)
+                       x, y, z, t,       // 4 vertex
+                       0.0, 0.0, 0.0,    // Polarisation
+                       kPFeedBackPhoton, // Production mechanism (there is no TR in G3 so one has to make some convention)
+                       phtrack,          // On output the number of the track stored
+                       1.0,
+                       1);
+    }
+    // Custom treatment of TR photons
+    else {
+      ePhoton.push_back(e);
+    }
+  }
+  return 1;
+}
+
+//_____________________________________________________________________________
+double TRsim::computeSpectrum(double gamma, int foils, double* spectrum) const
+{
+  //
+  // Computes the TR spectrum dN / domega in the <mSpNBins> bins of the TR photon energy
+  // for a particle with a given <gamma> crossing <foils> foils.
+  // Returns the mean number of TR photons <nTR>.
+  //
+
+  const double kAlpha = 0.0072973;
+  const int kSumMax = 30;
+  double tau = mGapThick / mFoilThick;
 
-  // The TR spectrum
   double csi1;
   double csi2;
   double rho1;
@@ -192,13 +258,13 @@ int TRsim::calculatePhotons(float p, float mass, std::vector<float>& ePhoton)
   double energyeV;
   double energykeV;
 
-  mSpectrum->Reset();
-  for (int iBin = 1; iBin <= mSpNBins; iBin++) {
+  double nTr = 0.0;
+  for (int iBin = 0; iBin < mSpNBins; iBin++) {
 
-    energykeV = mSpectrum->GetBinCenter(iBin);
+    energykeV = mSpLower + (iBin + 0.5) * mSpBinWidth;
     energyeV = energykeV * 1.0e3;
 
-    sigma = getSigma(energykeV);
+    sigma = mSigma[iBin];
 
     csi1 = mFoilOmega / energyeV;
     csi2 = mGapOmega / energyeV;
@@ -221,53 +287,62 @@ int TRsim::calculatePhotons(float p, float mass, std::vector<float>& ePhoton)
     nEqu = (1.0 - TMath::Exp(-foils * sigma)) / (1.0 - TMath::Exp(-sigma));
 
     // dN / domega
-    mSpectrum->SetBinContent(iBin, 4.0 * kAlpha * nEqu * sum / (energykeV * (1.0 + tau)));
+    spectrum[iBin] = 4.0 * kAlpha * nEqu * sum / (energykeV * (1.0 + tau));
+    nTr += spectrum[iBin];
   }
 
   // <nTR> (binsize corr.)
-  float nTr = mSpBinWidth * mSpectrum->Integral();
-  // Number of TR photons from Poisson distribution with mean <nTr>
-  int nPhCand = gRandom->Poisson(nTr);
+  return mSpBinWidth * nTr;
+}
 
-  // Link the MC stack and get info about parent electron
-  TVirtualMCStack* stack = TVirtualMC::GetMC()->GetStack();
-  int track = stack->GetCurrentTrackNumber();
-  double px, py, pz, ptot;
-  TVirtualMC::GetMC()->TrackMomentum(px, py, pz, ptot);
-  ptot = TMath::Sqrt(px * px + py * py + pz * pz);
-  px /= ptot;
-  py /= ptot;
-  pz /= ptot;
-  // Current position of electron
-  double x, y, z;
-  TVirtualMC::GetMC()->TrackPosition(x, y, z);
-  double t = TVirtualMC::GetMC()->TrackTime();
-  for (int iPhoton = 0; iPhoton < nPhCand; ++iPhoton) {
-    double e = mSpectrum->GetRandom(); // Energy of the TR photon
-    // Put TR photon on particle stack
-    if (e > 15) {
-      e *= 1e-6; // Convert it to GeV
-      int phtrack;
-      stack->PushTrack(1,                // Must be 1
-                       track,            // Identifier of the parent track, -1 for a primary
-                       22,               // Particle code.
-                       px * e,           // 4 momentum (The photon is generated on the same
-                       py * e,           // direction as the parent. For irregular radiator one
-                       pz * e,           // can calculate also the angle but this is a second
-                       e,                // order effect)
-                       x, y, z, t,       // 4 vertex
-                       0.0, 0.0, 0.0,    // Polarisation
-                       kPFeedBackPhoton, // Production mechanism (there is no TR in G3 so one has to make some convention)
-                       phtrack,          // On output the number of the track stored
-                       1.0,
-                       1);
-    }
-    // Custom treatment of TR photons
-    else {
-      ePhoton.push_back(e);
+//_____________________________________________________________________________
+const TRsim::SpectrumTable& TRsim::getTable(int foilsIndex, int gammaNode)
+{
+  //
+  // Returns the TR table of a number of foils and a gamma node, computed at the first call
+  //
+
+  SpectrumTable& table = mTables[foilsIndex * mNGammaNodes + gammaNode];
+  if (!table.filled) {
+    std::array<double, mSpNBins> spectrum;
+    table.nTr = computeSpectrum(std::pow(10.0, gammaNode * mGammaLogStep), mNFoils[foilsIndex], spectrum.data());
+    double sum = 0.0;
+    table.cdf[0] = 0.0;
+    for (int iBin = 0; iBin < mSpNBins; iBin++) {
+      sum += spectrum[iBin];
+      table.cdf[iBin + 1] = (table.nTr > 0.0) ? sum * mSpBinWidth / table.nTr : 0.0;
     }
+    table.filled = true;
   }
-  return 1;
+  return table;
+}
+
+//_____________________________________________________________________________
+double TRsim::sampleEnergy(const SpectrumTable& table) const
+{
+  //
+  // Samples the energy (keV) of a TR photon by inversion of the cumulative distribution
+  // of a TR table, uniformly within the selected bin as TH1::GetRandom
+  //
+
+  double r = gRandom->Rndm();
+  int iBin = std::upper_bound(table.cdf.begin() + 1, table.cdf.end() - 1, r) - table.cdf.begin() - 1;
+  double binContent = table.cdf[iBin + 1] - table.cdf[iBin];
+  double e = mSpLower + iBin * mSpBinWidth;
+  if (binContent > 0.0) {
+    e += mSpBinWidth * (r - table.cdf[iBin]) / binContent;
+  }
+  return e;
+}
+
+//_____________________________________________________________________________
+void TRsim::resetTables()
+{
+  //
+  // Invalidates the TR tables after a change of the radiator parameters
+  //
+
+  mTables.assign(mNFoilsDim * mNGammaNodes, SpectrumTable());
 }
 
 //_____________________________________________________________________________
@@ -281,6 +356,7 @@ void TRsim::setSigma()
     double energykeV = iBin * mSpBinWidth + 1.0;
     mSigma[iBin] = getSigma(energykeV);
   }
+  resetTables();
 }
 
 //_____________________________________________________________________________
@@ -686,14 +762,21 @@ int TRsim::selectNFoils(float p) const
   // Selects the number of foils corresponding to the momentum
   //
 
-  int foils = mNFoils[mNFoilsDim - 1];
+  return mNFoils[selectNFoilsIndex(p)];
+}
+
+//_____________________________________________________________________________
+int TRsim::selectNFoilsIndex(float p) const
+{
+  //
+  // Selects the index in mNFoils corresponding to the momentum
+  //
 
   for (int iFoil = 0; iFoil < mNFoilsDim; iFoil++) {
     if (p < mNFoilsUp[iFoil]) {
-      foils = mNFoils[iFoil];
-      break;
+      return iFoil;
     }
   }
 
-  return foils;
+  return mNFoilsDim - 1;
 }
@@ -89,8 +89,25 @@ class Detector : public o2::base::DetImpl<Detector>
   // Define sensitive volumes
   void defineSensitiveVolumes();
 
+  // kind of the sensitive volumes, cached per volume id to avoid the name comparisons at each step
+  enum VolumeKind : char {
+    kUnknownVolume = 0,
+    kZNVolume,
+    kZPVolume,
+    kZEMVolume,
+    kOtherVolume
+  };
+  VolumeKind getVolumeKind(int volumeID);
+
   // Methods to calculate the light outpu
-  void calculateTableIndexes(int& ibeta, int& iangle, int& iradius);
+  // the indexes of the light tables for the step, false if the step produces no light
+  bool calculateTableIndexes(const Float_t* x, const Float_t* p, Float_t energy, int& ibeta, int& iangle, int& iradius);
+  // angle bin of the light tables for the cosine of the angle to the fibre axis, 99 beyond the tables
+  static int getAngleBin(double cosAngle);
+  // group the mean light of the steps in a fibre (ZDCSimParam::groupFibreSteps)
+  void addFibreLight(bool inFibre, int mediumID, float light);
+  // photoelectrons of the grouped steps, added to the current hit
+  void flushFibreLight();
 
   Int_t mZDCdetectorID; //detector in ZDC
   Int_t mZDCsectorID;   //tower in ZDC
@@ -106,6 +123,10 @@ class Detector : public o2::base::DetImpl<Detector>
   Float_t mTotLightPMQ;
   Int_t mMediumPMCid;
   Int_t mMediumPMQid;
+  Bool_t mGroupFibreSteps = false; //! draw the photoelectrons once per fibre traversal
+  Float_t mPendingLightPMC = 0.;   //! mean light of the grouped steps
+  Float_t mPendingLightPMQ = 0.;   //!
+  std::vector<char> mVolumeKinds;  //! VolumeKind per sensitive volume id
   o2::zdc::Hit* mCurrentHit;
   //
   /// Container for hit data
@@ -119,6 +140,7 @@ class Detector : public o2::base::DetImpl<Detector>
   static constexpr int ZNRADIUSBINS = 18;
   static constexpr int ZPRADIUSBINS = 28;
   static constexpr int ANGLEBINS = 90;
+  static constexpr int NANGLEEDGES = 56; // angle bins of 2 degrees used, up to 110 degrees
 
   float mLightTableZN[4][ZNRADIUSBINS][ANGLEBINS] = { 1. }; //!
   float mLightTableZP[4][ZPRADIUSBINS][ANGLEBINS] = { 1. }; //!
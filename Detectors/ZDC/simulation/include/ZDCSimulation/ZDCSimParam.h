@@ -0,0 +1,34 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef DETECTORS_ZDC_SIMULATION_INCLUDE_ZDCSIMULATION_ZDCSIMPARAM_H_
+#define DETECTORS_ZDC_SIMULATION_INCLUDE_ZDCSIMULATION_ZDCSIMPARAM_H_
+
+#include "SimConfig/ConfigurableParam.h"
+#include "SimConfig/ConfigurableParamHelper.h"
+
+namespace o2
+{
+namespace zdc
+{
+
+// parameters of the light production in the ZDC quartz fibres
+struct ZDCSimParam : public o2::conf::ConfigurableParamHelper<ZDCSimParam> {
+  bool groupFibreSteps = false; // sum the mean light of the steps of a track in a fibre, draw the photoelectrons once
+  float maxStepFibre = -1.;     // max step in the fibre media [cm] (<= 0: the one of the other ZDC media)
+
+  // boilerplate stuff + make principal key "ZDCSim"
+  O2ParamDef(ZDCSimParam, "ZDCSim");
+};
+
+} // namespace zdc
+} // namespace o2
+
+#endif /* DETECTORS_ZDC_SIMULATION_INCLUDE_ZDCSIMULATION_ZDCSIMPARAM_H_ */
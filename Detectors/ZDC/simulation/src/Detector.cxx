@@ -16,6 +16,7 @@
 #include "SimulationDataFormat/Stack.h"
 #include "ZDCSimulation/Detector.h"
 #include "ZDCSimulation/Hit.h"
+#include "ZDCSimulation/ZDCSimParam.h"
 
 #include "TMath.h"
 #include "TGeoManager.h"        // for TGeoManager, gGeoManager
@@ -26,8 +27,12 @@
 #include "TVirtualMC.h"         // for gMC, TVirtualMC
 #include "TString.h"            // for TString, operator+
 #include <TRandom.h>
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 #include <fstream>
+#include <functional>
 
 using namespace o2::zdc;
 
@@ -96,6 +101,7 @@ void Detector::InitializeO2Detector()
 {
   // Define the list of sensitive volumes
   defineSensitiveVolumes();
+  mGroupFibreSteps = ZDCSimParam::Instance().groupFibreSteps;
 
   std::string inputDir;
   const char* aliceO2env = std::getenv("O2_ROOT");
@@ -176,14 +182,15 @@ void Detector::defineSensitiveVolumes()
 Bool_t Detector::ProcessHits(FairVolume* v)
 {
   // Method called from MC stepping for the sensitive volumes
-  TString volname = fMC->CurrentVolName();
   Float_t x[3] = { 0., 0., 0. }, xDet[3] = { 0., 0., 0. }, p[3] = { 0., 0., 0. }, energy = 0.;
   fMC->TrackPosition(x[0], x[1], x[2]);
   fMC->TrackMomentum(p[0], p[1], p[2], energy);
 
   // determine detector and tower
+  int sensID = v->getMCid();
+  const auto volumeKind = getVolumeKind(sensID);
   Int_t cZDCdetID[2];
-  if (volname.Contains("ZN")) {
+  if (volumeKind == kZNVolume) {
     if (x[2] > 0)
       cZDCdetID[0] = 1; //ZNA (NB -> DIFFERENT FROM AliRoot!!!)
     else if (x[2] < 0)
@@ -217,7 +224,7 @@ Bool_t Detector::ProcessHits(FairVolume* v)
           cZDCdetID[1] = 4;
       }
     }
-  } else if (volname.Contains("ZP")) {
+  } else if (volumeKind == kZPVolume) {
     if (x[2] > 0)
       cZDCdetID[0] = 2; //ZPA (NB -> DIFFERENT FROM AliRoot!!!)
     else if (x[2] < 0)
@@ -244,7 +251,7 @@ Bool_t Detector::ProcessHits(FairVolume* v)
         }
       }
     }
-  } else if (volname.Contains("ZEM")) {
+  } else if (volumeKind == kZEMVolume) {
     cZDCdetID[0] = 3;
     for (int i = 0; i < 3; i++)
       xDet[i] = x[i] - Geometry::ZEMPOSITION[i];
@@ -271,32 +278,31 @@ Bool_t Detector::ProcessHits(FairVolume* v)
   Float_t eDep = fMC->Edep();
 
   //Track entering the fibres
-  int sensID = v->getMCid();
   int pdgCode = fMC->TrackPid();
   float lightoutput = 0.;
   auto currentMediumid = fMC->CurrentMedium();
-  int ibeta = 99, iangle = 99, iradius = 99, nphe = 0;
-  if ((currentMediumid == mMediumPMCid) || (currentMediumid == mMediumPMQid)) {
-    calculateTableIndexes(ibeta, iangle, iradius);
-    if (ibeta != 99 && iangle != 99 && iangle != 99) {
-      int charge = 0;
-      if (pdgCode < 10000)
-        charge = fMC->TrackCharge();
-      else
-        charge = TMath::Abs(pdgCode / 10000 - 100000);
+  const bool inFibre = (currentMediumid == mMediumPMCid) || (currentMediumid == mMediumPMQid);
+  int nphe = 0;
+  if (inFibre) {
+    int charge = 0;
+    if (pdgCode < 10000)
+      charge = fMC->TrackCharge();
+    else
+      charge = TMath::Abs(pdgCode / 10000 - 100000);
+    // only charged particles produce Cherenkov light, the neutral shower particles need no table lookup
+    int ibeta = 99, iangle = 99, iradius = 99;
+    if (charge != 0 && calculateTableIndexes(x, p, energy, ibeta, iangle, iradius)) {
       //look into the light tables
       if (mZDCdetectorID == 1 || mZDCdetectorID == 4) {
-        if (iradius > Geometry::ZNFIBREDIAMETER)
-          iradius = Geometry::ZNFIBREDIAMETER;
-        lightoutput = charge * charge * mLightTableZN[ibeta][iangle][iradius];
+        lightoutput = charge * charge * mLightTableZN[ibeta][std::min(iradius, ZNRADIUSBINS - 1)][iangle];
       } else {
-        if (iradius > Geometry::ZPFIBREDIAMETER)
-          iradius = Geometry::ZPFIBREDIAMETER;
-        lightoutput = charge * charge * mLightTableZP[ibeta][iangle][iradius];
+        lightoutput = charge * charge * mLightTableZP[ibeta][std::min(iradius, ZPRADIUSBINS - 1)][iangle];
       }
-      if (lightoutput > 0)
-        nphe = gRandom->Poisson(lightoutput);
     }
+    // with grouped steps the mean light is summed until the track leaves the fibre and the number of
+    // photoelectrons drawn once (the sum of Poisson numbers being a Poisson number of the summed mean)
+    if (!mGroupFibreSteps && lightoutput > 0)
+      nphe = gRandom->Poisson(lightoutput);
   }
 
   // A new hit is created for a new track NOT daughter of a seen particle (shower product)
@@ -304,6 +310,8 @@ Bool_t Detector::ProcessHits(FairVolume* v)
   // OR if it is a new hit
   // TODO: needs check
   if ((fMC->IsTrackEntering() && (!isDaughterOfSeenTrack) && (!kIsTrackInsideSameSector)) || (!mCurrentHit)) {
+    // the light of the steps grouped so far belongs to the previous hit
+    flushFibreLight();
 
     mTrackTOF = 1.e09 * fMC->TrackTime(); //TOF in ns
     mPcMother = stack->GetCurrentTrack()->GetMother(0);
@@ -329,6 +337,7 @@ Bool_t Detector::ProcessHits(FairVolume* v)
       mXImpact[i] = xDet[i];
     mPrimaryEnergy = energy;
 
+    addFibreLight(inFibre, currentMediumid, lightoutput);
     return true;
 
   } else {
@@ -343,11 +352,68 @@ Bool_t Detector::ProcessHits(FairVolume* v)
     mCurrentHit->SetEnergyLoss(mTotDepEnergy);
     mCurrentHit->setPMCLightYield(mTotLightPMC);
     mCurrentHit->setPMQLightYield(mTotLightPMQ);
+    addFibreLight(inFibre, currentMediumid, lightoutput);
     return true;
   }
   return false;
 }
 
+//_____________________________________________________________________________
+Detector::VolumeKind Detector::getVolumeKind(int volumeID)
+{
+  // the kind of the sensitive volumes, from their name at the first step in them
+  if (volumeID >= int(mVolumeKinds.size())) {
+    mVolumeKinds.resize(volumeID + 1, kUnknownVolume);
+  }
+  auto& kind = mVolumeKinds[volumeID];
+  if (kind == kUnknownVolume) {
+    TString volname = fMC->CurrentVolName();
+    if (volname.Contains("ZN")) {
+      kind = kZNVolume;
+    } else if (volname.Contains("ZP")) {
+      kind = kZPVolume;
+    } else if (volname.Contains("ZEM")) {
+      kind = kZEMVolume;
+    } else {
+      kind = kOtherVolume;
+    }
+  }
+  return VolumeKind(kind);
+}
+
+//_____________________________________________________________________________
+void Detector::addFibreLight(bool inFibre, int mediumID, float light)
+{
+  if (!mGroupFibreSteps || !inFibre) {
+    return;
+  }
+  if (mediumID == mMediumPMCid) {
+    mPendingLightPMC += light;
+  } else {
+    mPendingLightPMQ += light;
+  }
+  if (fMC->IsTrackExiting() || fMC->IsTrackStop() || fMC->IsTrackDisappeared()) {
+    flushFibreLight();
+  }
+}
+
+//_____________________________________________________________________________
+void Detector::flushFibreLight()
+{
+  if (mCurrentHit) {
+    if (mPendingLightPMC > 0) {
+      mTotLightPMC += gRandom->Poisson(mPendingLightPMC);
+      mCurrentHit->setPMCLightYield(mTotLightPMC);
+    }
+    if (mPendingLightPMQ > 0) {
+      mTotLightPMQ += gRandom->Poisson(mPendingLightPMQ);
+      mCurrentHit->setPMQLightYield(mTotLightPMQ);
+    }
+  }
+  mPendingLightPMC = 0.;
+  mPendingLightPMQ = 0.;
+}
+
 //_____________________________________________________________________________
 o2::zdc::Hit* Detector::addHit(Int_t trackID, Int_t parentID, Int_t sFlag, Float_t primaryEnergy, Int_t detID,
                                Int_t secID, Vector3D<float> pos, Vector3D<float> mom, Float_t tof, Float_t* xImpact, Double_t energyloss, Int_t nphePMC, Int_t nphePMQ)
@@ -467,8 +533,10 @@ void Detector::createMaterials()
   // ******** MEDIUM DEFINITION ********
   Medium(kWalloy, "Walloy$", 0, sensMed, inofld, nofieldm, tmaxnofd, stemax, deemax, epsil, stmin);
   Medium(kCuZn, "CuZn$", 1, sensMed, inofld, nofieldm, tmaxnofd, stemax, deemax, epsil, stmin);
-  Medium(kSiO2pmc, "quartzPMC$", 2, sensMed, inofld, nofieldm, tmaxnofd, stemax, deemax, epsil, stmin);
-  Medium(kSiO2pmq, "quartzPMQ$", 2, sensMed, inofld, nofieldm, tmaxnofd, stemax, deemax, epsil, stmin);
+  // the step in the fibres can be longer, the light yield is tabulated per step
+  const Float_t stemaxFibre = ZDCSimParam::Instance().maxStepFibre > 0 ? ZDCSimParam::Instance().maxStepFibre : stemax;
+  Medium(kSiO2pmc, "quartzPMC$", 2, sensMed, inofld, nofieldm, tmaxnofd, stemaxFibre, deemax, epsil, stmin);
+  Medium(kSiO2pmq, "quartzPMQ$", 2, sensMed, inofld, nofieldm, tmaxnofd, stemaxFibre, deemax, epsil, stmin);
   Medium(kPb, "Lead$", 3, sensMed, inofld, nofieldm, tmaxnofd, stemax, deemax, epsil, stmin);
   Medium(kCu, "Copper$", 4, notactiveMed, inofld, nofieldm, tmaxnofd, stemax, deemax, epsil, stmin);
   Medium(kFe, "Iron$", 5, notactiveMed, inofld, nofieldm, tmaxnofd, stemax, deemax, epsil, stmin);
@@ -2152,40 +2220,35 @@ void Detector::createDetectors()
 }
 
 //_____________________________________________________________________________
-void Detector::calculateTableIndexes(int& ibeta, int& iangle, int& iradius)
+bool Detector::calculateTableIndexes(const Float_t* xstep, const Float_t* pstep, Float_t energy, int& ibeta, int& iangle, int& iradius)
 {
-  double x[3] = { 0., 0., 0. }, xDet[3] = { 0., 0., 0. }, p[3] = { 0., 0., 0. }, energy = 0.;
-  fMC->TrackPosition(x[0], x[1], x[2]);
-  fMC->TrackMomentum(p[0], p[1], p[2], energy);
-
-  //particle velocity
-  float ptot = TMath::Sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+  //particle velocity, below the Cherenkov threshold of the tables there is no light
+  float ptot = TMath::Sqrt(pstep[0] * pstep[0] + pstep[1] * pstep[1] + pstep[2] * pstep[2]);
   float beta = 0.;
   if (energy > 0.)
     beta = ptot / energy;
-  if (beta >= 0.67) {
-    if (beta <= 0.75)
-      ibeta = 0;
-    else if (beta > 0.75 && beta <= 0.85)
-      ibeta = 1;
-    else if (beta > 0.85 && beta <= 0.95)
-      ibeta = 2;
-    else if (beta > 0.95)
-      ibeta = 3;
-  } else
-    beta = 99;
-  //track angle wrt fibre axis (||LHC axis)
+  if (beta < 0.67) {
+    ibeta = 99;
+    return false;
+  }
+  if (beta <= 0.75)
+    ibeta = 0;
+  else if (beta <= 0.85)
+    ibeta = 1;
+  else if (beta <= 0.95)
+    ibeta = 2;
+  else
+    ibeta = 3;
+  //track angle wrt fibre axis (||LHC axis), from the cosines of the bin edges
+  double x[3] = { xstep[0], xstep[1], xstep[2] }, xDet[3] = { 0., 0., 0. };
   double umom[3] = { 0., 0., 0. }, udet[3] = { 0., 0., 0. };
-  umom[0] = p[0] / ptot;
-  umom[1] = p[1] / ptot;
-  umom[2] = p[2] / ptot;
+  umom[0] = pstep[0] / ptot;
+  umom[1] = pstep[1] / ptot;
+  umom[2] = pstep[2] / ptot;
   fMC->Gmtod(umom, udet, 2);
-  double angleRad = TMath::ACos(udet[2]);
-  double angleDeg = angleRad * kRaddeg;
-  if (angleDeg < 110.)
-    iangle = int(0.5 + angleDeg / 2.);
-  else
-    iangle = 99;
+  iangle = getAngleBin(udet[2]);
+  if (iangle == 99)
+    return false;
   //radius from fibre axis
   fMC->Gmtod(x, xDet, 1);
   float radius = 0.;
@@ -2195,6 +2258,24 @@ void Detector::calculateTableIndexes(int& ibeta, int& iangle, int& iradius)
   } else
     radius = TMath::Abs(udet[0]);
   iradius = int(radius * 1000. + 1.);
+  return true;
+}
+
+//_____________________________________________________________________________
+int Detector::getAngleBin(double cosAngle)
+{
+  // bins of 2 degrees centred on multiples of 2 degrees up to 110 degrees (99 beyond): bin k for
+  // angles in [2k - 1, 2k + 1) degrees, i.e. for cosines in (cos(2k + 1), cos(2k - 1)]
+  static const auto edges = []() {
+    std::array<double, NANGLEEDGES> cosEdges;
+    for (int k = 0; k < NANGLEEDGES; k++) {
+      cosEdges[k] = std::cos(std::min(2. * k + 1., 110.) / kRaddeg); // decreasing
+    }
+    return cosEdges;
+  }();
+  // number of edges above the cosine = number of edges of smaller angle
+  int bin = std::upper_bound(edges.begin(), edges.end(), cosAngle, std::greater<double>()) - edges.begin();
+  return bin < NANGLEEDGES ? bin : 99;
 }
 
 //_____________________________________________________________________________
@@ -2219,4 +2300,7 @@ void Detector::Register()
 void Detector::Reset()
 {
   mHits->clear();
+  mCurrentHit = nullptr;
+  mPendingLightPMC = 0.;
+  mPendingLightPMQ = 0.;
 }
@@ -17,5 +17,7 @@
 #pragma link C++ class o2::zdc::Hit+;
 #pragma link C++ class o2::zdc::Detector+;
 #pragma link C++ class o2::base::DetImpl<o2::zdc::Detector>+;
+#pragma link C++ class o2::zdc::ZDCSimParam+;
+#pragma link C++ class o2::conf::ConfigurableParamHelper<o2::zdc::ZDCSimParam>+;
 
 #endif
@@ -16,11 +16,16 @@
 #define ALICE_O2_EVENTVISUALISATION_BASE_EVENTMANAGER_H
 
 #include "CCDB/Manager.h"
+#include "EventVisualisationDataConverter/MinimalisticEvent.h"
 
 #include <TEveElement.h>
 #include <TEveEventManager.h>
 #include <TQObject.h>
 
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
 #include <string>
 
 namespace o2  {
@@ -32,6 +37,12 @@ namespace EventVisualisation {
 /// (Raw data, hits, digits, clusters, ESDs, AODs...). It is a role of detector-specific data macros to
 /// interpret data from different formats as visualisation objects (points, lines...) and register them
 /// for drawing in the MultiView.
+///
+/// Events are loaded as MinimalisticEvents by an event loader. The current event and its neighbours
+/// are kept in a cache: after each navigation the next and the previous events are loaded in background
+/// threads, so that moving by one event only waits for the (main thread) construction of the
+/// visualisation objects. Those are built for at most getMaxTracksDrawn() tracks per event, the ones
+/// of highest pT (MinimalisticEvent::selectTracks), to keep the display interactive for Pb-Pb events.
 
 class EventManager : public TEveEventManager, public TQObject
 {
@@ -45,6 +56,27 @@ class EventManager : public TEveEventManager, public TQObject
     /// Returns an instance of EventManager
     static EventManager& getInstance();
 
+    /// Loads the event of given number, nullptr if there is no such event.
+    /// It is called from the background threads, so it must be thread-safe.
+    using EventLoader = std::function<std::unique_ptr<MinimalisticEvent>(int)>;
+    using EventPtr = std::shared_ptr<MinimalisticEvent>;
+
+    /// Sets the source of the events and clears the cache
+    void setEventLoader(EventLoader loader);
+    /// Makes the event of given number current, from the cache if it was already prefetched,
+    /// and starts the prefetch of its neighbours. Returns nullptr if there is no such event.
+    EventPtr gotoEvent(int eventNumber);
+    /// Makes the next event current
+    inline EventPtr nextEvent(){return gotoEvent(mCurrentEventNumber+1);}
+    /// Makes the previous event current
+    inline EventPtr previousEvent(){return gotoEvent(mCurrentEventNumber-1);}
+    /// Number of the current event
+    inline int getCurrentEventNumber() const {return mCurrentEventNumber;}
+
+    /// Level of detail: maximal number of tracks drawn per event, all of them if <= 0
+    inline void setMaxTracksDrawn(int maxTracks){mMaxTracksDrawn = maxTracks;}
+    inline int getMaxTracksDrawn() const {return mMaxTracksDrawn;}
+
     /// Setter of the current data source
     inline void setDataSourceType(EDataSource source){mCurrentDataSourceType = source;}
     /// Sets the CDB path in CCDB Manager
@@ -55,6 +87,13 @@ class EventManager : public TEveEventManager, public TQObject
 
    private:
     EDataSource mCurrentDataSourceType; ///< enum type of the current data source
+    EventLoader mEventLoader;           ///< source of the events
+    std::map<int, std::shared_future<EventPtr>> mEvents; ///< current event and its (prefetched) neighbours
+    int mCurrentEventNumber;            ///< number of the current event
+    int mMaxTracksDrawn;                ///< maximal number of tracks drawn per event
+
+    /// Starts the background loading of the event of given number, unless already cached
+    void prefetchEvent(int eventNumber);
 
     /// Default constructor
     EventManager();
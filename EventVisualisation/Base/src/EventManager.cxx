@@ -39,11 +39,54 @@ EventManager& EventManager::getInstance()
 }
 
 EventManager::EventManager() : TEveEventManager("Event",""),
-mCurrentDataSourceType(SourceOffline)
+mCurrentDataSourceType(SourceOffline),
+mCurrentEventNumber(-1),
+mMaxTracksDrawn(0)
 {
 }
 
 EventManager::~EventManager() = default;
 
+void EventManager::setEventLoader(EventLoader loader)
+{
+  mEvents.clear(); // waits for the pending loads of the previous source
+  mEventLoader = std::move(loader);
+  mCurrentEventNumber = -1;
+}
+
+EventManager::EventPtr EventManager::gotoEvent(int eventNumber)
+{
+  if(!mEventLoader || eventNumber<0){
+    return nullptr;
+  }
+  prefetchEvent(eventNumber);
+  EventPtr event = mEvents[eventNumber].get();
+  if(!event){
+    return nullptr; // stay on the current event
+  }
+  mCurrentEventNumber = eventNumber;
+  
+  // keep only the neighbours, the ones further away are not likely to be needed soon
+  for(auto it=mEvents.begin();it!=mEvents.end();){
+    if(abs(it->first-eventNumber)>1) it = mEvents.erase(it);
+    else ++it;
+  }
+  prefetchEvent(eventNumber+1);
+  if(eventNumber>0) prefetchEvent(eventNumber-1);
+  
+  return event;
+}
+
+void EventManager::prefetchEvent(int eventNumber)
+{
+  if(mEvents.count(eventNumber)){
+    return;
+  }
+  EventLoader loader = mEventLoader;
+  mEvents[eventNumber] = async(launch::async,[loader,eventNumber]() -> EventPtr {
+    return loader(eventNumber);
+  }).share();
+}
+
 }
 }
@@ -19,6 +19,8 @@
 
 #include "EventVisualisationDataConverter/MinimalisticTrack.h"
 
+#include <random>
+#include <string>
 #include <vector>
 #include <ctime>
 
@@ -42,11 +44,21 @@ class MinimalisticEvent
     void addTrack(const MinimalisticTrack& track){ mTracks.push_back(track); }
     // Generates random tracks
     void fillWithRandomTracks();
+    // Generates random tracks with the given generator (safe to use in a loading thread)
+    void fillWithRandomTracks(std::mt19937& generator);
   
     // Multiplicity getter
     inline int GetMultiplicity(){return mMultiplicity;}
+    // Event number getter
+    inline int getEventNumber() const {return mEventNumber;}
+    // Number of stored tracks
+    inline int getNumberOfTracks() const {return mTracks.size();}
     // Returns track with index i
     MinimalisticTrack* getTrack(int i);
+  
+    // Level of detail: indices (in increasing order) of the at most maxTracks tracks
+    // of highest pT, all the tracks if maxTracks <= 0
+    std::vector<int> selectTracks(int maxTracks) const;
 private:
     int mEventNumber;                       /// event number in file
     int mRunNumber;                         /// run number
@@ -57,7 +69,7 @@ private:
     std::vector<MinimalisticTrack> mTracks; /// an array of minimalistic tracks
 };
 
-#endif
-
 }
 }
+
+#endif
@@ -20,6 +20,7 @@
 #include "ConversionConstants.h"
 
 #include <iosfwd>
+#include <random>
 #include <string>
 #include <vector>
 #include <cmath>
@@ -76,9 +77,13 @@ class MinimalisticTrack
     int     getCharge(){return mCharge;}
     // PID (particle identification code) getter
     int     getPID(){return mPID;}
+    // Transverse momentum getter
+    double  getPt() const {return std::hypot(mMomentum[0],mMomentum[1]);}
   
     // Generates random track
     void fillWithRandomData();
+    // Generates random track with the given generator (unlike rand(), safe to use in a loading thread)
+    void fillWithRandomData(std::mt19937& generator);
   
 private:
     // Set coordinates of the beginning of the track
@@ -111,7 +116,7 @@ private:
     std::vector<double> mPolyZ;
 };
 
-#endif
-
 }
 }
+
+#endif
@@ -16,6 +16,9 @@
 
 #include "EventVisualisationDataConverter/MinimalisticEvent.h"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace std;
 
 namespace o2  {
@@ -47,11 +50,36 @@ void MinimalisticEvent::fillWithRandomTracks()
     mTracks.push_back(track);
   }
 }
+
+void MinimalisticEvent::fillWithRandomTracks(std::mt19937& generator)
+{
+  mTracks.reserve(mTracks.size()+mMultiplicity);
+  for(int i=0;i<mMultiplicity;i++){
+    MinimalisticTrack track = MinimalisticTrack();
+    track.fillWithRandomData(generator);
+    mTracks.push_back(track);
+  }
+}
  
 MinimalisticTrack* MinimalisticEvent::getTrack(int i)
 {
   return &mTracks[i];
 }
+
+vector<int> MinimalisticEvent::selectTracks(int maxTracks) const
+{
+  vector<int> selected(mTracks.size());
+  iota(selected.begin(),selected.end(),0);
+  if(maxTracks<=0 || maxTracks>=(int)selected.size()){
+    return selected;
+  }
+  // partial selection only: the order of the kept tracks is not needed, only which ones
+  nth_element(selected.begin(),selected.begin()+maxTracks,selected.end(),
+              [this](int a,int b){return mTracks[a].getPt()>mTracks[b].getPt();});
+  selected.resize(maxTracks);
+  sort(selected.begin(),selected.end());
+  return selected;
+}
   
 }
 }
@@ -119,6 +119,26 @@ void MinimalisticTrack::fillWithRandomData()
   int PID[10] = {-2212, -321, -211, -13, -11, 11, 13 , 211, 321, 2212 };
   mPID = PID[(int)(rand()%10)];
 }
+
+void MinimalisticTrack::fillWithRandomData(std::mt19937& generator)
+{
+  uniform_real_distribution<double> uniform(0.,1.);
+  mCharge = (uniform(generator)>0.5) ? 1 : -1;
+  
+  mStartCoordinates[0] = 0.0;
+  mStartCoordinates[1] = 0.0;
+  mStartCoordinates[2] = 0.0;
+  
+  mMomentum[0] = 2*uniform(generator)-1;
+  mMomentum[1] = 2*uniform(generator)-1;
+  mMomentum[2] = 2*uniform(generator)-1;
+  
+  mMass = 1000*uniform(generator) + 0.5;
+  mEnergy = mMass + 1000*uniform(generator);
+  
+  int PID[10] = {-2212, -321, -211, -13, -11, 11, 13 , 211, 321, 2212 };
+  mPID = PID[uniform_int_distribution<int>(0,9)(generator)];
+}
     
 }
 }
@@ -18,6 +18,9 @@
 #include "EventVisualisationBase/DataInterpreter.h"
 #include "EventVisualisationBase/EventManager.h"
 #include "EventVisualisationBase/VisualisationConstants.h"
+#include "EventVisualisationDataConverter/MinimalisticEvent.h"
+
+#include <memory>
 
 namespace o2  {
 namespace EventVisualisation {
@@ -38,6 +41,13 @@ public:
   
   // Returns a list of random tracks colored by PID
   TEveElement* interpretDataForType(EDataType type) final;
+  // Returns a list of the tracks of the event colored by PID, at most maxTracks
+  // of them (the ones of highest pT), all of them if maxTracks <= 0
+  TEveElement* interpretEvent(MinimalisticEvent& event, int maxTracks);
+  
+  // Random event, the same for the same event number. Thread-safe, it can be
+  // used as the event loader of the EventManager.
+  static std::unique_ptr<MinimalisticEvent> generateRandomEvent(int eventNumber);
 };
   
 }
@@ -24,6 +24,7 @@
 #include <TGListTree.h>
 
 #include <iostream>
+#include <random>
 
 using namespace std;
 
@@ -37,8 +38,25 @@ DataInterpreterRND::~DataInterpreterRND() = default;
 TEveElement* DataInterpreterRND::interpretDataForType(EDataType type)
 {
   int multiplicity = 500*((double)rand()/RAND_MAX)+100;
-  MinimalisticEvent *minEvent = new MinimalisticEvent(15,123456,7000,multiplicity,"p-p",12736563);
-  minEvent->fillWithRandomTracks();
+  MinimalisticEvent minEvent(15,123456,7000,multiplicity,"p-p",12736563);
+  minEvent.fillWithRandomTracks();
+  
+  return interpretEvent(minEvent, EventManager::getInstance().getMaxTracksDrawn());
+}
+
+unique_ptr<MinimalisticEvent> DataInterpreterRND::generateRandomEvent(int eventNumber)
+{
+  mt19937 generator(eventNumber);
+  int multiplicity = uniform_int_distribution<int>(100,600)(generator);
+  auto minEvent = make_unique<MinimalisticEvent>(eventNumber,123456,7000,multiplicity,"p-p",12736563);
+  minEvent->fillWithRandomTracks(generator);
+  return minEvent;
+}
+
+TEveElement* DataInterpreterRND::interpretEvent(MinimalisticEvent& event, int maxTracks)
+{
+  MinimalisticEvent *minEvent = &event;
+  const vector<int> selectedTracks = minEvent->selectTracks(maxTracks);
   
   TEnv settings;
   ConfigurationManager::getInstance().getConfig(settings);
@@ -54,7 +72,7 @@ TEveElement* DataInterpreterRND::interpretDataForType(EDataType type)
   colors[4] = settings.GetValue("tracks.byType.proton",797);
   
   TEveElementList *container = new TEveElementList("Random tracks by PID");
-  container->SetTitle(Form("Multiplicity = %d", minEvent->GetMultiplicity()));
+  container->SetTitle(Form("Multiplicity = %d, drawn = %d", minEvent->GetMultiplicity(), (int)selectedTracks.size()));
   gEve->AddElement(container);
   
   TEveTrackList *trackList[nParticleTypes];
@@ -87,7 +105,7 @@ TEveElement* DataInterpreterRND::interpretDataForType(EDataType type)
     container->AddElement(trackList[i]);
   }
   
-  for (int iTrack=0; iTrack<minEvent->GetMultiplicity();iTrack++){
+  for (int iTrack : selectedTracks){
     MinimalisticTrack *minTrack = minEvent->getTrack(iTrack);
     
     int listNumber = PIDtoListNumber[minTrack->getPID()];
@@ -84,6 +84,13 @@ class MultiView
     void destroyAllEvents();
   
     void drawRandomEvent();
+    /// Draws the event of given number of the EventManager, replacing the current one
+    /// \return false if there is no such event
+    bool drawEvent(int eventNumber);
+    /// Draws the next event of the EventManager
+    bool drawNextEvent();
+    /// Draws the previous event of the EventManager
+    bool drawPreviousEvent();
   private:
     /// Default constructor
     MultiView();
@@ -20,6 +20,7 @@
 #include "EventVisualisationBase/GeometryManager.h"
 #include "EventVisualisationView/MultiView.h"
 #include "EventVisualisationBase/VisualisationConstants.h"
+#include "EventVisualisationDetectors/DataInterpreterRND.h"
 
 #include <TGTab.h>
 #include <TEnv.h>
@@ -44,11 +45,13 @@ Initializer::Initializer(EventManager::EDataSource defaultDataSource)
   
   const bool fullscreen      = settings.GetValue("fullscreen.mode",false);       // hide left and bottom tabs
   const string ocdbStorage   = settings.GetValue("OCDB.default.path","local://$ALICE_ROOT/OCDB");// default path to OCDB
+  const int maxTracksDrawn   = settings.GetValue("tracks.maxDrawn",0);           // level of detail, 0 to draw all tracks
   cout<<"Initializer -- OCDB path:"<<ocdbStorage<<endl;
   
   auto &eventManager = EventManager::getInstance();
   eventManager.setDataSourceType(defaultDataSource);
   eventManager.setCdbPath(ocdbStorage);
+  eventManager.setMaxTracksDrawn(maxTracksDrawn);
   
 //  gEve->AddEvent(eventManager);
   
@@ -73,9 +76,10 @@ Initializer::Initializer(EventManager::EDataSource defaultDataSource)
   setupCamera();
   
   // Temporary:
-  // For the time being we draw single random event on startup.
-  // Later this will be triggered by button, and finally moved to configuration.
-  MultiView::getInstance()->drawRandomEvent();
+  // For the time being the events are random ones, the first is drawn on startup.
+  // Later the loader will depend on the data source.
+  eventManager.setEventLoader(&DataInterpreterRND::generateRandomEvent);
+  MultiView::getInstance()->drawEvent(0);
 }
 
 Initializer::~Initializer() = default;
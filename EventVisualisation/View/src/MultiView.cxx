@@ -202,10 +202,33 @@ void MultiView::destroyAllEvents()
   
 void MultiView::drawRandomEvent()
 {
-  DataInterpreterRND *dataInterpreterRND = new DataInterpreterRND();
-  TEveElement *dataRND = dataInterpreterRND->interpretDataForType(NoData);
+  DataInterpreterRND dataInterpreterRND;
+  TEveElement *dataRND = dataInterpreterRND.interpretDataForType(NoData);
   registerEvent(dataRND);
 }
+
+bool MultiView::drawEvent(int eventNumber)
+{
+  auto &eventManager = EventManager::getInstance();
+  auto event = eventManager.gotoEvent(eventNumber); // the neighbours are then loaded in the background
+  if(!event){
+    return false;
+  }
+  destroyAllEvents();
+  DataInterpreterRND dataInterpreterRND;
+  registerEvent(dataInterpreterRND.interpretEvent(*event, eventManager.getMaxTracksDrawn()));
+  return true;
+}
+
+bool MultiView::drawNextEvent()
+{
+  return drawEvent(EventManager::getInstance().getCurrentEventNumber()+1);
+}
+
+bool MultiView::drawPreviousEvent()
+{
+  return drawEvent(EventManager::getInstance().getCurrentEventNumber()-1);
+}
   
 }
 }
@@ -13,6 +13,9 @@
 
 #include "Framework/AlgorithmSpec.h"
 
+#include <string>
+#include <vector>
+
 namespace o2
 {
 namespace framework
@@ -21,8 +24,17 @@ namespace readers
 {
 
 struct AODReaderHelpers {
+  /// Reads the AOD tables from the ROOT files given by the aod-file option.
+  /// If the option ends with ".arrow", the AOD converted by convertToArrow is
+  /// memory mapped instead and its record batches are published unchanged.
   static AlgorithmSpec rootFileReaderCallback();
   static AlgorithmSpec run2ESDConverterCallback();
+
+  /// Converts the AOD tables of @a inputFiles to Arrow IPC files in the
+  /// directory @a outputPath, one file per table named after its description.
+  /// Each input file becomes one record batch of each table, i.e. one
+  /// invocation of the reader.
+  static void convertToArrow(std::vector<std::string> const& inputFiles, std::string const& outputPath);
 };
 
 } // namespace readers
@@ -12,7 +12,10 @@
 
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/InputSpec.h"
+#include "Framework/OutputSpec.h"
+#include "Framework/WorkflowSpec.h"
 
+#include <string>
 #include <vector>
 
 namespace o2
@@ -31,6 +34,18 @@ struct CommonDataProcessors {
   /// @return a dummy DataProcessorSpec which requires all the passed @a InputSpec
   /// and simply discards them.
   static DataProcessorSpec getDummySink(std::vector<InputSpec> const& danglingInputs);
+  /// @return a DataProcessorSpec which dumps to a TimesliceRecord all the parts
+  /// of the first timeslices matching @a inputs. Subscribing it to the inputs of
+  /// a device records what is needed to replay that device alone.
+  static DataProcessorSpec getTimesliceRecorder(std::vector<InputSpec> const& inputs);
+  /// @return a source which sends again, in a loop, the timeslices of a
+  /// TimesliceRecord on @a outputs, reporting how long each loop took.
+  static DataProcessorSpec getTimesliceReplayer(std::vector<OutputSpec> const& outputs);
+  /// @return a workflow where @a device processes alone the timeslices
+  /// recorded in @a filename for it, e.g. to profile it. The recorded parts
+  /// matching its Timeframe inputs are replayed, the other inputs are provided
+  /// as usual.
+  static WorkflowSpec getReplayWorkflow(DataProcessorSpec const& device, std::string const& filename);
 };
 
 } // namespace framework
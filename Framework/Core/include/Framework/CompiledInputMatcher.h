@@ -0,0 +1,101 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef o2_framework_CompiledInputMatcher_H_INCLUDED
+#define o2_framework_CompiledInputMatcher_H_INCLUDED
+
+#include "Framework/DataDescriptorMatcher.h"
+#include "Framework/InputSpec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace framework
+{
+
+/// The inputs of a device compiled ahead of time, to find which input an
+/// incoming message belongs to.
+///
+/// The inputs given by a ConcreteDataMatcher only bind the start time of
+/// the message to the first variable of the context. They are put in a hash
+/// table on (origin, description, subspecification), so that the lookup of
+/// the header is done only once per message, whatever the number of inputs
+/// and of contexts which are tried. Only the inputs given by a generic
+/// DataDescriptorMatcher are still evaluated as a tree, for every context.
+///
+/// The result is the same as evaluating the matchers of the inputs in
+/// order: the first input which matches is returned.
+class CompiledInputMatcher
+{
+ public:
+  static constexpr int INVALID_INPUT = -1;
+
+  /// The part of the match which does not depend on the context
+  struct Lookup {
+    /// The first concrete input matching the DataHeader, INVALID_INPUT if none
+    int concreteInput = INVALID_INPUT;
+    uint64_t startTime = 0;
+  };
+
+  CompiledInputMatcher(std::vector<InputSpec> const& specs);
+
+  /// Look up the header stack @a data in the table of the concrete inputs
+  Lookup lookup(char const* data) const;
+
+  /// Match the header stack @a data against the inputs, given the @a lookup
+  /// done once for the message. Like for a DataDescriptorMatcher, the variables
+  /// are committed to the @a context on success and discarded otherwise.
+  /// @return the index of the first matching input or INVALID_INPUT
+  int match(Lookup const& lookup, char const* data, data_matcher::VariableContext& context) const;
+
+  int match(char const* data, data_matcher::VariableContext& context) const
+  {
+    return match(lookup(data), data, context);
+  }
+
+  /// @return true if all the inputs are looked up in the table
+  bool isFullyCompiled() const { return mGenericMatchers.empty(); }
+
+ private:
+  struct Key {
+    uint64_t origin;
+    uint64_t subSpec;
+    uint64_t description[2];
+
+    bool operator==(Key const& other) const
+    {
+      return origin == other.origin && subSpec == other.subSpec &&
+             description[0] == other.description[0] && description[1] == other.description[1];
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(Key const& key) const
+    {
+      uint64_t h = (key.origin << 32 ^ key.subSpec) * 0x9E3779B97F4A7C15ULL;
+      h ^= key.description[0] + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+      h ^= key.description[1] + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+
+  std::unordered_map<Key, int, KeyHash> mConcreteInputs;
+  /// The inputs which need the full matcher, by increasing input index
+  std::vector<std::pair<int, data_matcher::DataDescriptorMatcher>> mGenericMatchers;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // o2_framework_CompiledInputMatcher_H_INCLUDED
@@ -51,6 +51,12 @@ struct CompletionPolicy {
 
   using Matcher = std::function<bool(DeviceSpec const& device)>;
   using Callback = std::function<CompletionOp(gsl::span<PartRef const> const &)>;
+  /// Callback which only gets to know how many of the @a total inputs of a
+  /// record are @a present. The DataRelayer keeps those counts up to date
+  /// incrementally, so policies which can be expressed this way do not
+  /// require the whole partial record to be scanned every time a new part
+  /// arrives.
+  using CountCallback = std::function<CompletionOp(size_t present, size_t total)>;
 
   /// Name of the policy itself.
   std::string name;
@@ -59,6 +65,9 @@ struct CompletionPolicy {
   Matcher matcher;
   /// Actual policy which decides what to do with a partial InputRecord.
   Callback callback;
+  /// Optional, cheaper, version of @a callback. When set, it is used in
+  /// place of @a callback. It must give the same result.
+  CountCallback countCallback = nullptr;
 
   /// Helper to create the default configuration.
   static std::vector<CompletionPolicy> createDefaultPolicies();
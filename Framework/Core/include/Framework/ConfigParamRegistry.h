@@ -16,18 +16,43 @@
 #include <memory>
 #include <string>
 #include <cassert>
+#include <utility>
 
 namespace o2
 {
 namespace framework
 {
 
+/// A typed option, looked up once by ConfigParamRegistry::handle and then
+/// read without any lookup. The options of a device do not change once it is
+/// configured, so the value is simply the one found at the time of the lookup.
+template <typename T>
+class ConfigParamHandle
+{
+ public:
+  explicit ConfigParamHandle(T value)
+    : mValue{ std::move(value) }
+  {
+  }
+
+  T const& get() const { return mValue; }
+  T const& operator*() const { return mValue; }
+  T const* operator->() const { return &mValue; }
+
+ private:
+  T mValue;
+};
+
 /// This provides unified access to the parameters specified in the workflow
 /// specification.
 /// The ParamRetriever is a concrete implementation of the registry which
 /// will actually get the options. For example it could get them from the
 /// FairMQ ProgOptions plugin or (to run "device-less", e.g. in batch simulation
 /// jobs).
+/// The lookups by name go through the retriever every time, so the options
+/// read in the processing callback should be resolved once in the init
+/// callback with handle<T>(key). The lookups done while the registry is
+/// marked as processing are counted, so that a device can report them.
 /// FIXME: Param is a bad name as FairRoot uses it for conditions data.
 ///        Use options? YES! OptionsRegistry...
 class ConfigParamRegistry
@@ -41,6 +66,9 @@ class ConfigParamRegistry
   T get(const char* key) const
   {
     assert(mRetriever);
+    if (mProcessing) {
+      mProcessingLookups++;
+    }
     try {
       if constexpr (std::is_same_v<T, int>) {
         return mRetriever->getInt(key);
@@ -67,8 +95,25 @@ class ConfigParamRegistry
     }
   }
 
+  /// The option @a key, looked up once, as a handle which can be
+  /// read at every timeslice at no cost.
+  template <typename T>
+  ConfigParamHandle<T> handle(const char* key) const
+  {
+    return ConfigParamHandle<T>{ get<T>(key) };
+  }
+
+  /// Mark the time spent in the processing callbacks, where the lookups by
+  /// name are counted.
+  void setProcessing(bool processing) { mProcessing = processing; }
+
+  /// The lookups by name done while processing
+  size_t processingLookups() const { return mProcessingLookups; }
+
  private:
   std::unique_ptr<ParamRetriever> mRetriever;
+  bool mProcessing = false;
+  mutable size_t mProcessingLookups = 0;
 };
 
 } // namespace framework
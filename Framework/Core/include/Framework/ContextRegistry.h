@@ -11,14 +11,14 @@
 #ifndef FRAMEWORK_CONTEXTREGISTRY_H
 #define FRAMEWORK_CONTEXTREGISTRY_H
 
+#include "Framework/TypeIndex.h"
+
 #include <typeinfo>
-#include <typeindex>
 #include <type_traits>
 #include <string>
 #include <stdexcept>
 #include <vector>
 #include <utility>
-#include <array>
 
 namespace o2
 {
@@ -30,6 +30,8 @@ namespace framework
 /// Decouples getting the various contextes from the actual type
 /// of context, so that the DataAllocator does not need to know
 /// about the various serialization methods.
+/// The instances are stored by the TypeIndex of their type, so that a lookup
+/// is a direct array access.
 ///
 class ContextRegistry
 {
@@ -45,11 +47,9 @@ class ContextRegistry
   template <typename T>
   T* get() const
   {
-    void* instance = nullptr;
-    for (size_t i = 0; i < mRegistryCount; ++i) {
-      if (mRegistryKey[i] == typeid(T*).hash_code()) {
-        return reinterpret_cast<T*>(mRegistryValue[i]);
-      }
+    auto index = TypeIndex::get<T>();
+    if (index < mRegistry.size() && mRegistry[index] != nullptr) {
+      return reinterpret_cast<T*>(mRegistry[index]);
     }
     throw std::out_of_range(std::string("Unsupported backend, no registered context '") + typeid(T).name() + "'");
   }
@@ -65,25 +65,19 @@ class ContextRegistry
   void set(T* instance)
   {
     static_assert(std::is_void<T>::value == false, "can not register a void object");
-    size_t i = 0;
-    for (i = 0; i < mRegistryCount; ++i) {
-      if (typeid(T*).hash_code() == mRegistryKey[i]) {
-        return;
-      }
+    auto index = TypeIndex::get<T>();
+    if (mRegistry.size() <= index) {
+      mRegistry.resize(index + 1, nullptr);
     }
-    if (i == MAX_REGISTRY_SIZE) {
-      throw std::runtime_error("Too many entries in ContextRegistry");
+    // The first instance registered for a type is kept
+    if (mRegistry[index] == nullptr) {
+      mRegistry[index] = instance;
     }
-    mRegistryCount = i + 1;
-    mRegistryKey[i] = typeid(T*).hash_code();
-    mRegistryValue[i] = instance;
   }
 
  private:
-  static constexpr size_t MAX_REGISTRY_SIZE = 8;
-  size_t mRegistryCount = 0;
-  std::array<size_t, MAX_REGISTRY_SIZE> mRegistryKey;
-  std::array<void*, MAX_REGISTRY_SIZE> mRegistryValue;
+  /// The instances, by TypeIndex of their type
+  std::vector<void*> mRegistry;
 };
 
 } // namespace framework
@@ -17,6 +17,7 @@
 #include "Framework/ArrowContext.h"
 #include "Framework/RawBufferContext.h"
 #include "CommonUtils/BoostSerializer.h"
+#include "CommonUtils/FlatSerializer.h"
 #include "Framework/Output.h"
 #include "Framework/OutputRef.h"
 #include "Framework/OutputRoute.h"
@@ -34,6 +35,7 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <string>
 #include <utility>
 #include <type_traits>
@@ -84,6 +86,10 @@ class DataAllocator
 
   void adoptChunk(const Output&, char*, size_t, fairmq_free_fn*, void*);
 
+  /// Send a FairMQ message as the payload of an output, e.g. a reference to the
+  /// message of an input, keeping the serialization method of its content.
+  void adoptMessage(const Output&, FairMQMessagePtr&&, o2::header::SerializationMethod);
+
   // In case no extra argument is provided and the passed type is trivially
   // copyable and non polymorphic, the most likely wanted behavior is to create
   // a message with that type, and so we do.
@@ -167,9 +173,38 @@ class DataAllocator
     return make_boost<WT>(std::move(specs));
   }
 
+  /// Helper to create a container of structs with flatFields, which will be owned by the framework
+  /// and flat serialized directly in the message when the processing finishes.
+  template <typename T, typename WT = typename T::wrapped_type>
+  typename std::enable_if<is_specialization<T, FlatSerialized>::value == true, WT&>::type
+    make(const Output& spec)
+  {
+    auto buff = new WT{};
+    adopt_flat(spec, buff);
+    return *buff;
+  }
+
+  /// Helper to create a std::vector of messageable elements with polymorphic
+  /// allocator (i.e. o2::vector<T>), whose buffer is allocated directly in the
+  /// memory of the message for the output channel. The vector can be grown
+  /// as needed, the resulting buffer is sent without a copy once the
+  /// processing callback completes.
+  template <typename T>
+  typename std::enable_if<is_pmr_vector<T>::value == true && is_messageable<typename T::value_type>::value == true, T&>::type
+    make(const Output& spec)
+  {
+    std::string channel = matchDataHeader(spec, mTimingInfo->timeslice);
+    auto context = mContextRegistry->get<MessageContext>();
+
+    // the correct payload size is set when the message is finalized
+    FairMQMessagePtr headerMessage = headerMessageFromOutput(spec, channel, o2::header::gSerializationMethodNone, 0);
+    return context->add<MessageContext::VectorObject<typename T::value_type>>(std::move(headerMessage), channel, 0, 0).get();
+  }
+
   template <typename T>
   typename std::enable_if<is_specialization<T, BoostSerialized>::value == false   //
                             && is_messageable<T>::value == false                  //
+                            && is_pmr_vector<T>::value == false                   //
                             && framework::is_boost_serializable<T>::value == true //
                             && std::is_base_of<std::string, T>::value == false,
                           T&>::type
@@ -192,9 +227,11 @@ class DataAllocator
   template <typename T>
   typename std::enable_if<
     is_specialization<T, BoostSerialized>::value == false     //
+      && is_specialization<T, FlatSerialized>::value == false //
       && std::is_base_of<TObject, T>::value == false          //
       && std::is_base_of<TableBuilder, T>::value == false     //
       && is_messageable<T>::value == false                    //
+      && is_pmr_vector<T>::value == false                     //
       && std::is_same<std::string, T>::value == false         //
       && framework::is_boost_serializable<T>::value == false, //
     T&>::type
@@ -206,7 +243,8 @@ class DataAllocator
                   "\n - arrays of those"
                   "\n - TObject with additional constructor arguments"
                   "\n - Classes and structs with boost serialization support"
-                  "\n - std containers of those");
+                  "\n - std containers of those"
+                  "\n - o2::vector of trivially copyable, non-polymorphic structures");
   }
 
   /// catching unsupported type for case of span of objects
@@ -297,6 +335,33 @@ class DataAllocator
     mContextRegistry->get<RawBufferContext>()->addRawBuffer(std::move(header), std::move(payload), std::move(channel), std::move(lambdaSerialize), std::move(lambdaDestructor));
   }
 
+  /// Adopt a container of structs with flatFields in the framework, it is flat serialized
+  /// directly in the message and sent to the consumers of @a spec once done.
+  template <typename T>
+  void adopt_flat(const Output& spec, T* ptr)
+  {
+    using type = T;
+
+    char* payload = reinterpret_cast<char*>(ptr);
+    std::string channel = matchDataHeader(spec, mTimingInfo->timeslice);
+    // the correct payload size is set later when sending the
+    // RawBufferContext, see DataProcessor::doSend
+    auto header = headerMessageFromOutput(spec, channel, o2::header::gSerializationMethodFlat, 0);
+
+    auto lambdaSerialize = [voidPtr = payload](FairMQMessage& message) {
+      auto const& data = *reinterpret_cast<type*>(voidPtr);
+      message.Rebuild(o2::utils::FlatSerializedSize(data));
+      o2::utils::FlatSerialize(data, reinterpret_cast<char*>(message.GetData()), message.GetSize());
+    };
+
+    auto lambdaDestructor = [voidPtr = payload]() {
+      auto tmpPtr = reinterpret_cast<type*>(voidPtr);
+      delete tmpPtr;
+    };
+
+    mContextRegistry->get<RawBufferContext>()->addRawBuffer(std::move(header), std::move(payload), std::move(channel), std::move(lambdaSerialize), std::move(lambdaDestructor));
+  }
+
   /// Serialize a snapshot of an object with root dictionary when called,
   /// will then be sent once the computation ends.
   /// Framework does not take ownership of the @a object. Changes to @a object
@@ -310,9 +375,9 @@ class DataAllocator
     snapshot(const Output& spec, T& object)
   {
     auto proxy = mContextRegistry->get<RootObjectContext>()->proxy();
-    FairMQMessagePtr payloadMessage(proxy.createMessage());
     auto* cl = TClass::GetClass(typeid(T));
-    TMessageSerializer().Serialize(*payloadMessage, &object, cl);
+    auto payloadMessage = TMessageSerializer::SerializeToMessage([&proxy](size_t size) { return proxy.createMessage(size); },
+                                                                 &object, cl);
 
     addPartToContext(std::move(payloadMessage), spec, o2::header::gSerializationMethodROOT);
   }
@@ -335,7 +400,6 @@ class DataAllocator
                   "class hint must be of type TClass or const char");
 
     auto proxy = mContextRegistry->get<RootObjectContext>()->proxy();
-    FairMQMessagePtr payloadMessage(proxy.createMessage());
     const TClass* cl = nullptr;
     if (wrapper.getHint() == nullptr) {
       // get TClass info by wrapped type
@@ -356,10 +420,27 @@ class DataAllocator
       }
       throw std::runtime_error(msg);
     }
-    TMessageSerializer().Serialize(*payloadMessage, &wrapper(), cl);
+    auto payloadMessage = TMessageSerializer::SerializeToMessage([&proxy](size_t size) { return proxy.createMessage(size); },
+                                                                 &wrapper(), cl);
     addPartToContext(std::move(payloadMessage), spec, o2::header::gSerializationMethodROOT);
   }
 
+  /// Flat serialize a snapshot of a container of structs with flatFields, wrapped
+  /// into type FlatSerialized, when called, will then be sent once the computation
+  /// ends. The size is known beforehand, the columns are written directly in the
+  /// message. Framework does not take ownership of the container.
+  template <typename W>
+  typename std::enable_if<is_specialization<W, FlatSerialized>::value == true, void>::type
+    snapshot(const Output& spec, W wrapper)
+  {
+    auto proxy = mContextRegistry->get<MessageContext>()->proxy();
+    auto size = o2::utils::FlatSerializedSize(wrapper());
+    FairMQMessagePtr payloadMessage(proxy.createMessage(size));
+    o2::utils::FlatSerialize(wrapper(), reinterpret_cast<char*>(payloadMessage->GetData()), size);
+
+    addPartToContext(std::move(payloadMessage), spec, o2::header::gSerializationMethodFlat);
+  }
+
   /// Serialize a snapshot of a trivially copyable, non-polymorphic @a object,
   /// referred to be 'messageable, will then be sent once the computation ends.
   /// Framework does not take ownership of @param object. Changes to @param object
@@ -427,6 +508,7 @@ class DataAllocator
   template <typename T>
   typename std::enable_if<has_root_dictionary<T>::value == false &&                //
                           is_specialization<T, ROOTSerialized>::value == false &&  //
+                          is_specialization<T, FlatSerialized>::value == false &&  //
                           is_messageable<T>::value == false &&                     //
                           std::is_pointer<T>::value == false &&                    //
                           is_specialization<T, std::vector>::value == false>::type //
@@ -501,9 +583,38 @@ class DataAllocator
   }
 
  private:
+  /// The serialized DataHeader and DataProcessingHeader of an output, the template is created
+  /// on the first message of the output and only the payload size, the serialization method
+  /// and the timing are patched for every message. The output routes matching the output and
+  /// the transports of their channels are cached along.
+  struct HeaderTemplate {
+    std::vector<char> buffer;
+    std::vector<size_t> routes;                      // indices of the matching output routes
+    std::vector<FairMQTransportFactory*> transports; // transport of each route, set on first use
+  };
+  struct HeaderTemplateKey {
+    DataOrigin origin;
+    DataDescription description;
+    SubSpecificationType subSpec;
+    bool operator==(HeaderTemplateKey const& other) const
+    {
+      return origin == other.origin && description == other.description && subSpec == other.subSpec;
+    }
+  };
+  struct HeaderTemplateKeyHash {
+    size_t operator()(HeaderTemplateKey const& key) const
+    {
+      return std::hash<uint64_t>{}(key.description.itg[0] ^ (key.description.itg[1] * 31) ^
+                                   ((uint64_t(key.origin.itg[0]) << 32 | key.subSpec) * 0x9E3779B97F4A7C15ull));
+    }
+  };
+
   AllowedOutputRoutes mAllowedOutputRoutes;
   TimingInfo* mTimingInfo;
   ContextRegistry* mContextRegistry;
+  std::unordered_map<HeaderTemplateKey, HeaderTemplate, HeaderTemplateKeyHash> mHeaderTemplates;
+
+  HeaderTemplate& getHeaderTemplate(const Output& spec);
 
   std::string matchDataHeader(const Output& spec, size_t timeframeId);
   FairMQMessagePtr headerMessageFromOutput(Output const& spec,                                  //
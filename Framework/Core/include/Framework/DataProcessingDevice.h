@@ -25,19 +25,43 @@
 #include "Framework/RawBufferContext.h"
 #include "Framework/ServiceRegistry.h"
 #include "Framework/InputRoute.h"
+#include "Framework/MemoryAccounting.h"
+#include "Framework/MetricHandles.h"
 #include "Framework/ForwardRoute.h"
 #include "Framework/TimingInfo.h"
+#include "Framework/TimesliceTrace.h"
+#include "Framework/TimesliceCredits.h"
 
 #include <fairmq/FairMQDevice.h>
 #include <fairmq/FairMQParts.h>
+#include <fairmq/FairMQPoller.h>
 
 #include <memory>
+#include <vector>
 
 namespace o2
 {
 namespace framework
 {
 
+/// All the state which is needed to run the processing callback for a given
+/// timeslice and to hold its outputs until they can be sent. The device keeps
+/// one of these for each of the timeslices it processes concurrently.
+struct DataProcessingSlotState {
+  DataProcessingSlotState(FairMQDevice* device, std::vector<OutputRoute> const& outputs);
+
+  TimingInfo timingInfo;
+  MessageContext fairMQContext;
+  RootObjectContext rootContext;
+  StringContext stringContext;
+  ArrowContext dataFrameContext;
+  RawBufferContext rawBufferContext;
+  ContextRegistry contextRegistry;
+  DataAllocator allocator;
+  /// The inputs of the timeslice being processed.
+  std::vector<std::unique_ptr<FairMQMessage>> inputs;
+};
+
 class DataProcessingDevice : public FairMQDevice
 {
  public:
@@ -71,6 +95,8 @@ class DataProcessingDevice : public FairMQDevice
   DataAllocator mAllocator;
   DataRelayer mRelayer;
   std::vector<ExpirationHandler> mExpirationHandlers;
+  /// Per timeslice state used when processing timeslices concurrently.
+  std::vector<std::unique_ptr<DataProcessingSlotState>> mSlotStates;
 
   int mErrorCount;
   int mProcessingCount;
@@ -78,6 +104,16 @@ class DataProcessingDevice : public FairMQDevice
   uint64_t mLastMetricFlushedTimestamp = 0;  /// The timestamp of the last time we actually flushed metrics
   uint64_t mBeginIterationTimestamp = 0; /// The timestamp of when the current ConditionalRun was started
   DataProcessingStats mStats;            /// Stats about the actual data processing.
+  MetricHandles mSlowMetrics;            /// The relayer and processing stats, registered in Init
+  MetricHandles mRelayerStateMetrics;    /// The state of each input of each slot, for the GUI
+  TimesliceTracer mTracer;               /// Trace points of the timeslices, enabled by --timeslice-tracing
+  MemoryAccounting* mMemoryAccounting = nullptr; /// The accounting service, if enabled by --memory-accounting
+  bool mEventDriven = false;             /// Block on the inputs rather than polling them, enabled by --event-driven
+  int mPollTimeout = 0;                  /// How long (ms) to block when no input arrives, given by the timers
+  FairMQPollerPtr mInputPoller;          /// Poller on all the input channels, in the event driven mode
+  std::unique_ptr<TimesliceCredits> mCredits;      /// The credits of the workflow, enabled by --flow-control
+  size_t mCreditsIndex = 0;                        /// The entry of this device in mCredits
+  TimesliceCredits::ConsumerGroups mCreditConsumers; /// The consumers a source is throttled against
 };
 
 } // namespace framework
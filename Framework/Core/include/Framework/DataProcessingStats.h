@@ -32,6 +32,10 @@ struct DataProcessingStats {
   int lastTotalProcessedSize;
   InputLatency lastLatency;
   std::vector<int> relayerState;
+  // The flow control state of a source, see TimesliceCredits
+  int freeTimeslices = 0;
+  int inFlightTimeslices = 0;
+  int throttledIterations = 0;
 };
 
 } // namespace framework
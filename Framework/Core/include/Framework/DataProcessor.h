@@ -10,7 +10,11 @@
 #ifndef FRAMEWORK_DATAPROCESSOR_H
 #define FRAMEWORK_DATAPROCESSOR_H
 
+#include <functional>
+#include <string>
+
 class FairMQDevice;
+class FairMQParts;
 
 namespace o2
 {
@@ -26,8 +30,17 @@ class RawBufferContext;
 /// Helper class to send messages from a contex at the end
 /// of a computation.
 struct DataProcessor {
+  /// Invoked on every header-payload pair before it is sent on channel
+  using PartsTransform = std::function<void(FairMQParts&, std::string const& channel)>;
+
   static void doSend(FairMQDevice&, RootObjectContext&);
   static void doSend(FairMQDevice&, MessageContext&);
+  /// Send the messages of the context, if @a aggregate is true all the
+  /// header-payload pairs for the same channel go in one multipart message,
+  /// keeping the order in which they were created.
+  static void doSend(FairMQDevice&, MessageContext&, bool aggregate);
+  /// Like the above, applying @a transform to the messages first, unless empty
+  static void doSend(FairMQDevice&, MessageContext&, bool aggregate, PartsTransform const& transform);
   static void doSend(FairMQDevice&, StringContext&);
   static void doSend(FairMQDevice&, ArrowContext&);
   static void doSend(FairMQDevice&, RawBufferContext&);
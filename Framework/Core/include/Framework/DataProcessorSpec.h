@@ -64,6 +64,17 @@ struct DataProcessorSpec {
   /// put, but this is actually to be handled in the actual DeviceSpec.
   size_t inputTimeSliceId = 0;
   size_t maxInputTimeslices = 1;
+  /// How many timeslices can be processed at the same time by the same
+  /// device. Setting this to a value larger than 1 requires the processing
+  /// callback (and any state it captures) to be reentrant. Outputs are
+  /// still sent in timeslice order.
+  size_t maxProcessingThreads = 1;
+  /// Send all the outputs of a computation which go to the same channel
+  /// as one multipart message, rather than one message per output. This
+  /// reduces the per-message transport overhead for DataProcessors which
+  /// create many small outputs. The receiving device splits the multipart
+  /// message into its header-payload pairs, no data is copied.
+  bool aggregateOutputs = false;
 };
 
 } // namespace framework
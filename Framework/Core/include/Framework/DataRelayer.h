@@ -11,13 +11,17 @@
 #define FRAMEWORK_DATARELAYER_H
 
 #include "Framework/InputRoute.h"
+#include "Framework/CompiledInputMatcher.h"
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/ForwardRoute.h"
 #include "Framework/CompletionPolicy.h"
+#include "Framework/MetricHandles.h"
 #include "Framework/PartRef.h"
+#include "Framework/TimerWheel.h"
 #include "Framework/TimesliceIndex.h"
 
 #include <cstddef>
+#include <mutex>
 #include <vector>
 
 class FairMQMessage;
@@ -37,6 +41,8 @@ struct DataRelayerStats {
   uint64_t droppedComputations = 0;     /// How many computations have been dropped because one of the inputs was late
   uint64_t droppedIncomingMessages = 0; /// How many messages have been dropped (not relayed) because they were late
   uint64_t relayedMessages = 0;         /// How many messages have been successfully relayed
+  uint64_t expirationsChecked = 0;      /// How many times a dangling checker was evaluated
+  uint64_t expirationsFired = 0;        /// How many inputs were created by their expiration handler
 };
 
 class DataRelayer {
@@ -60,12 +66,17 @@ public:
   /// This invokes the appropriate `InputRoute::danglingChecker` on every
   /// entry in the cache and if it returns true, it creates a new
   /// cache entry by invoking the associated `InputRoute::expirationHandler`.
+  /// The checkers are only invoked when their ExpirationHandler::Schedule
+  /// allows them to expire something, the periodic ones are kept in a
+  /// timer wheel.
   void processDanglingInputs(std::vector<ExpirationHandler> const&,
                              ServiceRegistry& context);
 
   /// This is used to ask for relaying a given (header,payload) pair.
   /// Notice that we expect that the header is an O2 Header Stack
   /// with a DataProcessingHeader inside so that we can assess time.
+  /// It is safe to invoke this concurrently from multiple channel
+  /// polling threads.
   RelayChoice relay(std::unique_ptr<FairMQMessage> &&header,
                     std::unique_ptr<FairMQMessage> &&payload);
 
@@ -85,6 +96,11 @@ public:
   /// Returns how many timeslices we can handle in parallel
   size_t getParallelTimeslices() const;
 
+  /// @return how many inputs are currently filled for the given @a slot.
+  /// This is kept up to date incrementally, so it does not require a scan
+  /// of the cache.
+  size_t getFilledInputs(TimesliceSlot slot) const;
+
   /// Tune the maximum number of in flight timeslices this can handle.
   void setPipelineLength(size_t s);
 
@@ -112,11 +128,21 @@ public:
   std::vector<bool> mForwardingMask;
   CompletionPolicy mCompletionPolicy;
   std::vector<size_t> mDistinctRoutesIndex;
-  std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  CompiledInputMatcher mInputMatcher;
+  /// The deadlines of the periodic expirations, by distinct route
+  TimerWheel mExpirationWheel;
+  /// The distinct routes whose periodic expiration is due
+  std::vector<bool> mDueRoutes;
   std::vector<data_matcher::VariableContext> mVariableContextes;
-  std::vector<int> mCachedStateMetrics;
+  /// The state of each entry of the cache, as the "data_relayer/<entry>" metrics
+  MetricHandles mStateMetrics;
+  /// How many inputs are filled for each of the slots in the cache.
+  std::vector<size_t> mFilledInputs;
+
+  /// Guards the cache, the index and the statistics, so that relay() can
+  /// be invoked from multiple threads at the same time.
+  mutable std::mutex mMutex;
 
-  static std::vector<std::string> sMetricsNames;
   static std::vector<std::string> sVariablesMetricsNames;
   static std::vector<std::string> sQueriesMetricsNames;
 
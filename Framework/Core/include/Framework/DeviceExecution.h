@@ -10,6 +10,8 @@
 #ifndef FRAMEWORK_DEVICEEXECUTION_H
 #define FRAMEWORK_DEVICEEXECUTION_H
 
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace o2
@@ -21,7 +23,16 @@ namespace framework
 /// information which  can change between  one execution  of a Device  and the
 /// other, e.g. its pid or the arguments it is started with.
 struct DeviceExecution {
+  /// Environment variable with the steady clock time, in ns, at which the
+  /// driver spawned the device, to measure the startup time of the device.
+  static constexpr const char* SPAWN_TIME_ENV = "DPL_SPAWN_TIME";
+
+
   std::vector<char *> args;
+  /// The cores the device is pinned to, empty if it is not pinned
+  std::vector<int> cpuAffinity;
+  /// Additional environment variables of the device
+  std::vector<std::pair<std::string, std::string>> environment;
 };
 
 } // namespace framework
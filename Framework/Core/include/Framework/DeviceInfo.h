@@ -15,6 +15,7 @@
 #include "Framework/Variant.h"
 
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 // For pid_t
@@ -26,6 +27,8 @@ namespace o2
 namespace framework
 {
 
+class DeviceMetricsChannel;
+
 struct DeviceInfo {
   /// The pid of the device associated to this device
   pid_t pid;
@@ -54,6 +57,9 @@ struct DeviceInfo {
   Metric2DViewIndex variablesViewIndex;
   /// Index for the queries of each input route.
   Metric2DViewIndex queriesViewIndex;
+  /// The binary channel for the metrics of the device, if any. The metrics
+  /// printed on stdout are still parsed.
+  std::shared_ptr<DeviceMetricsChannel> metricsChannel;
 };
 
 } // namespace framework
@@ -0,0 +1,106 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef FRAMEWORK_DEVICEMETRICSCHANNEL_H
+#define FRAMEWORK_DEVICEMETRICSCHANNEL_H
+
+#include "Framework/DeviceMetricsInfo.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace o2
+{
+namespace framework
+{
+
+/// A binary channel for the metrics of a device to the driver, to be used
+/// instead of the "[METRIC] ..." lines on the device stdout.
+///
+/// The channel is a single producer, single consumer ring buffer of
+/// variable size records in a POSIX shared memory segment, which the
+/// driver creates before spawning the device. The device pushes the
+/// metrics, the driver polls them and gets them as ParsedMetricMatch, so
+/// that they can be stored with DeviceMetricsHelper::processMetric without
+/// any text parsing. The metric names are sent only once, the following
+/// records refer to them by index. When the ring is full, metrics are
+/// dropped rather than blocking the device.
+class DeviceMetricsChannel
+{
+ public:
+  static constexpr size_t DEFAULT_SIZE = 1 << 20;
+  /// Environment variable the driver uses to pass the name of the segment to the device
+  static constexpr const char* ENV_NAME = "DPL_METRICS_CHANNEL";
+
+  /// Create the channel as a new shared memory segment @a name of @a size
+  /// bytes, which is removed again when the channel is destroyed.
+  /// @return nullptr if the segment can not be created
+  static std::unique_ptr<DeviceMetricsChannel> create(std::string const& name, size_t size = DEFAULT_SIZE);
+  /// Attach to the shared memory segment @a name created by the driver
+  /// @return nullptr if there is no such segment
+  static std::unique_ptr<DeviceMetricsChannel> attach(std::string const& name);
+
+  ~DeviceMetricsChannel();
+  DeviceMetricsChannel(DeviceMetricsChannel const&) = delete;
+  DeviceMetricsChannel& operator=(DeviceMetricsChannel const&) = delete;
+
+  /// Producer side, @a timestamp is in milliseconds like for the text metrics
+  /// @return false if the metric was dropped because the ring is full
+  bool push(std::string_view name, int value, size_t timestamp);
+  bool push(std::string_view name, float value, size_t timestamp);
+  bool push(std::string_view name, std::string_view value, size_t timestamp);
+
+  /// Consumer side, invoke @a callback for every metric pushed since the last
+  /// call. The ParsedMetricMatch is only valid within the callback.
+  /// @return the number of metrics
+  size_t poll(std::function<void(ParsedMetricMatch&)> const& callback);
+
+  /// Number of metrics dropped by the producer so far
+  size_t dropped() const;
+
+  std::string const& name() const { return mName; }
+
+ private:
+  struct Control;
+  struct RecordHeader;
+
+  DeviceMetricsChannel(std::string const& name, void* memory, size_t mappedSize, bool owner);
+  /// Reserve a record of @a payloadSize bytes, nullptr if there is no space
+  RecordHeader* reserve(size_t payloadSize);
+  /// Make the last reserved record visible to the consumer
+  void commit(RecordHeader* record);
+  /// Get the index of @a name, sending it first if it is new, -1 if full
+  int labelIndex(std::string_view name);
+  bool pushValue(std::string_view name, MetricType type, void const* value, size_t valueSize, size_t timestamp);
+
+  std::string mName;
+  void* mMemory;
+  size_t mMappedSize;
+  bool mOwner;
+  Control* mControl;
+  char* mData;
+  size_t mSize;
+  /// position of the end of the record being written by the producer
+  uint64_t mReservedHead = 0;
+  /// labels known to the producer
+  std::unordered_map<std::string, int> mLabelIndices;
+  /// labels received by the consumer
+  std::vector<std::string> mLabels;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // FRAMEWORK_DEVICEMETRICSCHANNEL_H
@@ -65,15 +65,56 @@ struct ParsedMetricMatch {
   char const* endStringValue;
 };
 
+/// Summary of the values of a numeric metric received in a fixed
+/// interval of time, starting at @a timestamp.
+struct MetricBucket {
+  size_t timestamp;
+  float min;
+  float max;
+  float sum;
+  size_t count;
+
+  float avg() const { return count ? sum / count : 0.f; }
+};
+
+/// Ring buffer of the last buckets of a metric at a given time resolution.
+/// Like the raw histories, it is only grown when buckets are added.
+struct MetricAggregate {
+  std::vector<MetricBucket> buckets;
+  size_t pos = 0; // Position of the next bucket in the circular buffer
+};
+
+/// A point of a metric history, as extracted for the GUI. For raw
+/// values min, max and avg are the same.
+struct MetricPoint {
+  size_t timestamp;
+  float min;
+  float max;
+  float avg;
+};
+
 /// This struct hold information about device metrics when running
 /// in standalone mode
 struct DeviceMetricsInfo {
-  // We keep the size of each metric to 4096 bytes. No need for more
-  // for the debug GUI
-  std::vector<std::array<int, 1024>> intMetrics;
-  std::vector<std::array<StringMetric, 32>> stringMetrics; // We do not keep so many strings as metrics as history is less relevant.
-  std::vector<std::array<float, 1024>> floatMetrics;
-  std::vector<std::array<size_t, 1024>> timestamps;
+  /// Maximum number of raw values kept for each numeric metric. No need
+  /// for more for the debug GUI.
+  static constexpr size_t MAX_HISTORY_SIZE = 1024;
+  /// We do not keep so many strings as metrics as history is less relevant.
+  static constexpr size_t MAX_STRING_HISTORY_SIZE = 32;
+  /// Time resolutions (in ms) of the aggregated histories, finest first.
+  static constexpr std::array<size_t, 2> AGGREGATE_PERIODS = { 1000, 10000 };
+  /// Maximum number of buckets kept for each resolution, i.e. the last 6
+  /// minutes at 1s and the last hour at 10s.
+  static constexpr size_t MAX_AGGREGATE_SIZE = 360;
+
+  // The raw histories grow up to their maximum size as values arrive, so that
+  // metrics which are rarely updated do not get a full buffer.
+  std::vector<std::vector<int>> intMetrics;
+  std::vector<std::vector<StringMetric>> stringMetrics;
+  std::vector<std::vector<float>> floatMetrics;
+  std::vector<std::vector<size_t>> timestamps;
+  // One aggregate per resolution for each metric, empty for string metrics.
+  std::vector<std::array<MetricAggregate, AGGREGATE_PERIODS.size()>> aggregates;
   std::vector<float> max;
   std::vector<float> min;
   std::vector<size_t> minDomain;
@@ -100,6 +141,16 @@ struct DeviceMetricsHelper {
                             NewMetricCallback newMetricCallback = nullptr);
   static size_t metricIdxByName(const std::string& name,
                                 const DeviceMetricsInfo& info);
+
+  /// Extracts the history of the numeric metric @a metricIndex between
+  /// @a begin and @a end into @a points, oldest first. The finest resolution
+  /// which still covers @a begin is used and consecutive points are merged,
+  /// so that at most @a maxPoints are returned whatever the length of the run.
+  ///
+  /// @return the number of points extracted
+  static size_t extractHistory(DeviceMetricsInfo const& info, size_t metricIndex,
+                               size_t begin, size_t end, size_t maxPoints,
+                               std::vector<MetricPoint>& points);
 };
 
 } // namespace framework
@@ -49,6 +49,10 @@ struct DeviceSpec {
   size_t rank; // Id of a parallel processing I am part of
   size_t nSlots; // Total number of parallel units I am part of
   size_t inputTimesliceId;
+  /// How many timeslices can be processed at the same time.
+  size_t maxProcessingThreads = 1;
+  /// Whether outputs to the same channel are sent as one multipart message.
+  bool aggregateOutputs = false;
   /// The completion policy to use for this device.
   CompletionPolicy completionPolicy;
 };
@@ -19,6 +19,13 @@
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/DataSamplingPolicy.h"
 #include "Framework/Task.h"
+#include "Framework/DataProcessingHeader.h"
+
+#include <fairmq/FairMQMessage.h>
+#include <boost/lockfree/queue.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 namespace o2
 {
@@ -30,7 +37,8 @@ class Dispatcher : public Task
  public:
   /// \brief Constructor
   Dispatcher(const std::string name, const std::string reconfigurationSource);
-  /// \brief Destructor
+  Dispatcher(Dispatcher&&) = default;
+  /// \brief Destructor, stops the sampling threads
   ~Dispatcher() override;
 
   /// \brief Dispatcher init callback
@@ -46,8 +54,31 @@ class Dispatcher : public Task
   Outputs getOutputSpecs();
 
  private:
-  void send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const;
-  void sendFairMQ(FairMQDevice* device, const DataRef& inputData, const std::string& fairMQChannel) const;
+  /// \brief Data matched by a policy with a FairMQ channel, waiting for the decision of the sampling thread.
+  struct Sample {
+    header::DataHeader dataHeader;
+    DataProcessingHeader processingHeader;
+    FairMQMessagePtr payload;
+  };
+  /// \brief Thread deciding and sending the samples of a policy with a FairMQ channel, out of the processing path.
+  struct SamplingThread {
+    explicit SamplingThread(std::shared_ptr<DataSamplingPolicy> p) : policy(std::move(p)) {}
+    std::shared_ptr<DataSamplingPolicy> policy;
+    boost::lockfree::queue<Sample*> queue{ SamplingQueueCapacity };
+    std::atomic<bool> stop{ false };
+    std::atomic<size_t> dropped{ 0 };
+    std::thread thread;
+  };
+  // samples waiting in the queue of a sampling thread, the new ones are dropped beyond
+  static constexpr size_t SamplingQueueCapacity = 1024;
+
+  void send(DataAllocator& dataAllocator, const DataRef& inputData, FairMQMessagePtr&& payload, const Output& output) const;
+  void sendFairMQ(FairMQDevice* device, const header::DataHeader& dh, const DataProcessingHeader& dph,
+                  FairMQMessagePtr&& payload, const std::string& fairMQChannel) const;
+  /// \brief Returns a reference to the payload message if available, a copy of the payload otherwise.
+  FairMQMessagePtr referencePayload(FairMQDevice* device, FairMQMessage* message, const DataRef& inputData) const;
+  void runSamplingThread(FairMQDevice* device, SamplingThread& samplingThread) const;
+  void stopSamplingThreads();
 
   std::string mName;
   std::string mReconfigurationSource;
@@ -55,6 +86,8 @@ class Dispatcher : public Task
   Outputs outputs;
   // policies should be shared between all pipeline threads
   std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+  // sampling threads of the policies with a FairMQ channel, null for the other ones
+  std::vector<std::unique_ptr<SamplingThread>> mSamplingThreads;
 };
 
 } // namespace framework
@@ -12,6 +12,7 @@
 #define FRAMEWORK_EXPIRATIONHANDLER_H
 
 #include "Framework/Lifetime.h"
+#include <chrono>
 #include <cstdint>
 #include <functional>
 
@@ -29,10 +30,20 @@ struct ExpirationHandler {
   using Checker = std::function<bool(uint64_t timestamp)>;
   using Handler = std::function<void(ServiceRegistry&, PartRef& expiredInput, uint64_t timestamp)>;
 
+  /// When the checker needs to be evaluated, so that the DataRelayer can
+  /// skip it when it cannot expire anything.
+  enum struct Schedule {
+    Always,  /// at every iteration
+    Never,   /// never, i.e. the checker is LifetimeHelpers::expireNever()
+    Periodic /// once the period elapsed since it last expired something
+  };
+
   Lifetime lifetime;
   Creator creator;
   Checker checker;
   Handler handler;
+  Schedule schedule = Schedule::Always;
+  std::chrono::microseconds period{ 0 };
 };
 
 } // namespace framework
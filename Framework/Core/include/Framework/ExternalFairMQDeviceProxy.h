@@ -23,6 +23,10 @@ namespace framework
 {
   void broadcastMessage(FairMQDevice &device, o2::header::Stack &&headerStack, FairMQMessagePtr &&payloadMessage, int index);
 
+  /// As broadcastMessage, but the header stack is made a message once and both messages
+  /// are shared by all the output channels (reference counted), the payload is never copied.
+  void broadcastSharedMessage(FairMQDevice& device, o2::header::Stack&& headerStack, FairMQMessagePtr&& payloadMessage, int index);
+
   using InjectorFunction = std::function<void(FairMQDevice &device, FairMQParts& inputs, int index)>;
 
   /// Helper function which takes a set of inputs coming from a device,
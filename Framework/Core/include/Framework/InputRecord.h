@@ -17,7 +17,9 @@
 #include "Framework/InputSpan.h"
 #include "Framework/TableConsumer.h"
 
+#include "Framework/SerializationMethods.h"
 #include "CommonUtils/BoostSerializer.h"
+#include "CommonUtils/FlatSerializer.h"
 
 #include <gsl/gsl>
 
@@ -38,6 +40,7 @@ namespace framework
 {
 
 struct InputSpec;
+class MemoryAccounting;
 
 /// @class InputRecord
 /// @brief The input API of the Data Processing Layer
@@ -135,6 +138,9 @@ class InputRecord
       base::operator()(ptr);
     }
 
+    /// @return false if the underlying resource is not deleted by this deleter
+    constexpr bool isOwning() const { return mProperty != OwnershipProperty::NotOwning; }
+
    private:
     OwnershipProperty mProperty = OwnershipProperty::Unknown;
   };
@@ -142,6 +148,24 @@ class InputRecord
   int getPos(const char *name) const;
   int getPos(const std::string &name) const;
 
+  /// Account the ROOT objects deserialized from the inputs to @a accounting,
+  /// by their serialized size. The device releases them once the processing
+  /// callback returned.
+  void setMemoryAccounting(MemoryAccounting* accounting) { mAccounting = accounting; }
+  /// @return the bytes accounted as MemorySource::Deserialized so far
+  size_t getDeserializedBytes() const { return mDeserializedBytes; }
+
+  /// Get the message holding the payload of the input at position @a pos, e.g.
+  /// to send a reference to it without copying the payload.
+  /// @return nullptr if the input is not valid or its message is not available
+  FairMQMessage* getPayloadMessageByPos(int pos) const
+  {
+    if (pos * 2 + 1 >= mSpan.size() || pos < 0) {
+      return nullptr;
+    }
+    return mSpan.getMessage(pos * 2 + 1);
+  }
+
   DataRef getByPos(int pos) const {
     if (pos * 2 + 1 > mSpan.size() || pos < 0) {
       throw std::runtime_error("Unknown message requested at position " + std::to_string(pos));
@@ -215,8 +239,12 @@ class InputRecord
   }
 
   /// substitution for span of messageable objects
-  /// Note: there is no check for serialization type for the moment, which means that the method
-  /// can be used to get the raw buffer by simply querying gsl::span<unsigned char>.
+  /// The span is a view directly on the payload of the incoming message, no copy
+  /// or deserialization is involved. It is therefore valid only as long as the
+  /// InputRecord, i.e. for the processing of the current timeslice.
+  /// Spans of single byte types can be used to get the raw buffer regardless of
+  /// the serialization method, for all other types the payload is required to be
+  /// unserialized.
   /// FIXME: there will be std::span in C++20
   template <typename T>
   typename std::enable_if<std::is_same<T, gsl::span<typename T::value_type>>::value == true,
@@ -226,7 +254,10 @@ class InputRecord
     auto&& ref = get<DataRef>(binding);
     auto header = header::get<const header::DataHeader*>(ref.header);
     assert(header);
-    using ValueT = typename T::value_type;
+    using ValueT = typename std::remove_const<typename T::value_type>::type;
+    if (sizeof(ValueT) > 1 && header->payloadSerializationMethod != o2::header::gSerializationMethodNone) {
+      throw std::runtime_error("Can not create a view on serialized content at " + std::string(binding));
+    }
     if (header->payloadSize % sizeof(ValueT)) {
       throw std::runtime_error("Inconsistent type and payload size at " + std::string(binding) +
                                ": type size " + std::to_string(sizeof(ValueT)) +
@@ -296,6 +327,25 @@ class InputRecord
     return std::move(desData);
   }
 
+  /// substitution for flat serialized containers
+  /// The returned FlatView reads the columns directly in the payload of the incoming
+  /// message, no copy or deserialization is involved. It is therefore valid only as
+  /// long as the InputRecord, i.e. for the processing of the current timeslice.
+  /// @return o2::utils::FlatView of the value type of the wrapped container
+  template <typename T, typename VT = typename T::view_type>
+  typename std::enable_if<is_specialization<T, FlatSerialized>::value == true, VT>::type
+    get(char const* binding) const
+  {
+    auto&& ref = get<DataRef>(binding);
+    auto header = header::get<const header::DataHeader*>(ref.header);
+    assert(header);
+    if (header->payloadSerializationMethod != o2::header::gSerializationMethodFlat) {
+      throw std::runtime_error("Can not create a flat view on content of serialization method " +
+                               header->payloadSerializationMethod.as<std::string>() + " at " + std::string(binding));
+    }
+    return VT(ref.payload, header->payloadSize);
+  }
+
   template <typename T>
   T get_boost(char const* binding) const
   {
@@ -365,6 +415,7 @@ class InputRecord
   {
     using T = typename std::remove_pointer<PtrT>::type;
     auto ref = this->get(binding);
+    accountDeserialized(ref);
     return std::move(DataRefUtils::as<T>(ref));
   }
 
@@ -372,6 +423,9 @@ class InputRecord
   /// Notice that this will return a copy of the actual contents of the buffer, because
   /// the buffer is actually serialised. The extracted container is swaped to local,
   /// container, C++11 and beyond will implicitly apply return value optimization.
+  /// Containers of messageable objects can also be extracted from unserialized
+  /// payload, the content is copied in this case. Use get<gsl::span<T>> to avoid
+  /// the copy.
   /// @return std container object
   template <class T>
   typename std::enable_if<is_container<T>::value == true &&          //
@@ -381,9 +435,18 @@ class InputRecord
     get(char const* binding) const
   {
     using NonConstT = typename std::remove_const<T>::type;
+    using ValueT = typename NonConstT::value_type;
     auto ref = this->get(binding);
+    if constexpr (is_messageable<ValueT>::value == true) {
+      auto header = o2::header::get<const o2::header::DataHeader*>(ref.header);
+      if (header->payloadSerializationMethod == o2::header::gSerializationMethodNone) {
+        auto data = get<gsl::span<ValueT>>(binding);
+        return NonConstT(data.begin(), data.end());
+      }
+    }
     // we expect the unique_ptr to hold an object, exception should have been thrown
     // otherwise
+    accountDeserialized(ref);
     auto object = DataRefUtils::as<NonConstT>(ref);
     // need to swap the content of the deserialized container to a local variable to force return
     // value optimization
@@ -418,6 +481,7 @@ class InputRecord
       // explicitely specify serialization method to ROOT-serialized because type T
       // is messageable and a different method would be deduced in DataRefUtils
       // return type with owning Deleter instance, forwarding to default_deleter
+      accountDeserialized(ref);
       std::unique_ptr<T const, Deleter<T const>> result(DataRefUtils::as<ROOTSerialized<T>>(ref).release());
       return std::move(result);
     } else {
@@ -436,6 +500,7 @@ class InputRecord
                               && std::is_same<T, DataRef>::value == false             //
                               && std::is_same<T, std::string>::value == false         //
                               && has_root_dictionary<T>::value == false               //
+                              && is_specialization<T, FlatSerialized>::value == false //
                               && framework::is_boost_serializable<T>::value == false, //
                             std::unique_ptr<T const, Deleter<T const>>>::type
     get(char const* binding) const
@@ -452,6 +517,7 @@ class InputRecord
       // explicitely specify serialization method to ROOT-serialized because type T
       // is messageable and a different method would be deduced in DataRefUtils
       // return type with owning Deleter instance, forwarding to default_deleter
+      accountDeserialized(ref);
       std::unique_ptr<T const, Deleter<T const>> result(DataRefUtils::as<ROOTSerialized<T>>(ref).release());
       return std::move(result);
     } else {
@@ -543,8 +609,12 @@ class InputRecord
   }
 
 private:
+  void accountDeserialized(DataRef const& ref) const;
+
   std::vector<InputRoute> const &mInputsSchema;
   InputSpan mSpan;
+  MemoryAccounting* mAccounting = nullptr;
+  mutable size_t mDeserializedBytes = 0;
 };
 
 } // namespace framework
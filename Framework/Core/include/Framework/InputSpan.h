@@ -10,6 +10,10 @@
 #ifndef FRAMEWORK_INPUTSPAN_H
 #define FRAMEWORK_INPUTSPAN_H
 
+#include <functional>
+
+class FairMQMessage;
+
 namespace o2
 {
 namespace framework
@@ -32,12 +36,27 @@ class InputSpan
   {
   }
 
+  /// @a messageGetter is the mapping between an element of the span and the
+  /// message holding its buffer, such that it can be forwarded without copy.
+  InputSpan(std::function<const char*(size_t)> getter, std::function<FairMQMessage*(size_t)> messageGetter, size_t size)
+    : mGetter{ getter },
+      mMessageGetter{ messageGetter },
+      mSize{ size }
+  {
+  }
+
   /// @a i-th element of the InputSpan
   char const* get(size_t i) const
   {
     return mGetter(i);
   }
 
+  /// Message of the @a i-th element of the InputSpan, nullptr if not available
+  FairMQMessage* getMessage(size_t i) const
+  {
+    return mMessageGetter ? mMessageGetter(i) : nullptr;
+  }
+
   /// Number of elements in the InputSpan
   size_t size() const
   {
@@ -46,6 +65,7 @@ class InputSpan
 
  private:
   std::function<char const*(size_t)> mGetter;
+  std::function<FairMQMessage*(size_t)> mMessageGetter;
   size_t mSize;
 };
 
@@ -54,11 +54,14 @@ struct LifetimeHelpers {
 
   /// Build a fetcher for an object from CCDB when the record is expired.
   /// @a prefix is the lookup prefix in CCDB.
-  /// FIXME: actually implement the fetching
+  /// The objects are kept in memory for their validity interval. If @a cacheDir
+  /// is not empty, they are also stored there and looked up there before
+  /// accessing CCDB, such that the devices of a node retrieve each object once.
   /// FIXME: provide a way to customize the namespace from the ProcessingContext
   static ExpirationHandler::Handler fetchFromCCDBCache(ConcreteDataMatcher const& matcher,
                                                        std::string const& prefix,
-                                                       std::string const& sourceChannel);
+                                                       std::string const& sourceChannel,
+                                                       std::string const& cacheDir = "");
 
   /// Create an entry in the registry for histograms on the first
   /// FIXME: actually implement this
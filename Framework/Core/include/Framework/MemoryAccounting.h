@@ -0,0 +1,107 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef o2_framework_MemoryAccounting_H_INCLUDED
+#define o2_framework_MemoryAccounting_H_INCLUDED
+
+#include <boost/container/pmr/memory_resource.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace o2
+{
+namespace monitoring
+{
+class Monitoring;
+}
+
+namespace framework
+{
+
+/// What the memory accounted by the MemoryAccounting service is used for
+enum struct MemorySource : int {
+  Outputs,      ///< messages created with the DataAllocator, until they are sent
+  Inputs,       ///< messages of the InputRecord being processed
+  Deserialized, ///< ROOT objects deserialized from the inputs, by their serialized size
+  User,         ///< allocations of the user via MemoryAccounting::resource()
+  Count
+};
+
+/// Service keeping track of the live and peak bytes of a device, per
+/// MemorySource. The framework accounts the inputs and outputs of each
+/// timeslice, the user code can allocate its own buffers from resource(),
+/// e.g. with o2::pmr::vector, to have them accounted as well. All the methods
+/// are thread safe.
+///
+/// With --memory-accounting 1 the device reports after every timeslice the
+/// live bytes and the peak bytes since the previous report, so that the peaks
+/// are the ones of the timeslice.
+class MemoryAccounting
+{
+ public:
+  MemoryAccounting();
+  MemoryAccounting(MemoryAccounting const&) = delete;
+  MemoryAccounting& operator=(MemoryAccounting const&) = delete;
+
+  void allocated(MemorySource source, size_t bytes);
+  void released(MemorySource source, size_t bytes);
+
+  int64_t live(MemorySource source) const { return mLive[index(source)].load(std::memory_order_relaxed); }
+  int64_t peak(MemorySource source) const { return mPeak[index(source)].load(std::memory_order_relaxed); }
+  /// the live bytes of all the sources
+  int64_t live() const { return mLive[index(MemorySource::Count)].load(std::memory_order_relaxed); }
+  /// the peak of the live bytes of all the sources, not the sum of the peaks
+  int64_t peak() const { return mPeak[index(MemorySource::Count)].load(std::memory_order_relaxed); }
+
+  /// Restart the peaks from the live bytes
+  void resetPeaks();
+
+  /// The resource to allocate from for the memory to be accounted as
+  /// MemorySource::User, it forwards to new and delete
+  boost::container::pmr::memory_resource* resource() { return &mResource; }
+
+  /// Send memory/<source>/live_bytes and memory/<source>/peak_bytes for all
+  /// the sources and memory/total/..., then reset the peaks
+  void report(o2::monitoring::Monitoring& monitoring);
+
+  static char const* name(MemorySource source);
+
+ private:
+  /// Accounts what it forwards to its upstream resource
+  class AccountingResource : public boost::container::pmr::memory_resource
+  {
+   public:
+    AccountingResource(MemoryAccounting& accounting);
+
+   protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+   private:
+    MemoryAccounting& mAccounting;
+    boost::container::pmr::memory_resource* mUpstream;
+  };
+
+  static constexpr size_t index(MemorySource source) { return static_cast<size_t>(source); }
+  void add(size_t which, int64_t bytes);
+
+  /// per source and, at MemorySource::Count, the total
+  std::array<std::atomic<int64_t>, static_cast<size_t>(MemorySource::Count) + 1> mLive;
+  std::array<std::atomic<int64_t>, static_cast<size_t>(MemorySource::Count) + 1> mPeak;
+  AccountingResource mResource;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // o2_framework_MemoryAccounting_H_INCLUDED
@@ -0,0 +1,64 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef FRAMEWORK_METRICHANDLES_H
+#define FRAMEWORK_METRICHANDLES_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace monitoring
+{
+class Monitoring;
+}
+namespace framework
+{
+
+/// Integer metrics of a device whose names and tags are registered once,
+/// when the device is set up, rather than built every time they are sent.
+/// An update is a plain store into a preallocated array, flush() then sends
+/// them all at once, e.g. at the reporting interval of the device.
+class MetricHandles
+{
+ public:
+  using Handle = size_t;
+
+  /// Register the metric @a name. With @a dplSubsystem the metric is sent
+  /// with the DPL subsystem tag.
+  /// @return the handle of the metric, handles are consecutive from 0
+  Handle add(std::string name, bool dplSubsystem = false);
+  /// Register the @a n metrics "<prefix>0" ... "<prefix><n-1>"
+  /// @return the handle of the first one
+  Handle addRange(std::string const& prefix, size_t n, bool dplSubsystem = false);
+
+  void set(Handle handle, int value) { mValues[handle] = value; }
+  int get(Handle handle) const { return mValues[handle]; }
+  size_t size() const { return mValues.size(); }
+
+  /// Send the metrics to @a monitoring. With @a onlyChanged, only the ones
+  /// whose value changed since they were last sent (or which were never
+  /// sent) are.
+  /// @return the number of metrics sent
+  size_t flush(monitoring::Monitoring& monitoring, bool onlyChanged = false);
+
+ private:
+  std::vector<std::string> mNames;
+  std::vector<bool> mDplSubsystem;
+  std::vector<int> mValues;
+  std::vector<int> mSentValues;
+  std::vector<bool> mSent;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // FRAMEWORK_METRICHANDLES_H
@@ -25,19 +25,22 @@ namespace RDF
 
 /// This is the baseclass which actually implements how two tables should be
 /// combined together, via the GetAssociatedEntries() method. The BuildIndex()
-/// method is a convenience method which gets invoked only once per
-/// Initialise() and that can be used to precompute the index itself, if the
+/// method is a convenience method which gets invoked only once, on the first
+/// Initialise(), and that can be used to precompute the index itself, if the
 /// mapping combinedEntry -> (leftEntry, rightEntry) cannot be computed on
-/// the fly quickly.
+/// the fly quickly. Once built, the index is only read, concurrently by all
+/// the slots of the RCombinedDS, so GetAssociatedEntries() must not modify it.
 class RCombinedDSIndex
 {
  public:
   virtual ~RCombinedDSIndex() = default;
-  /// This is invoked on every Inititialise of the RCombinedDS to
+  /// This is invoked on the first Inititialise of the RCombinedDS to
   /// allow constructing the index associated to it.
   /// \param[in]left is the dataframe constructed on top of the left input.
   /// \param[in]right is the dataframe constructed on top of the right input.
-  /// \result the vector with the ranges of the combined dataset.
+  /// \result the vector with the ranges of the combined dataset. They have
+  ///         to cover all the entries, but do not need to be balanced, the
+  ///         RCombinedDS splits them among its slots.
   virtual std::vector<std::pair<ULong64_t, ULong64_t>> BuildIndex(std::unique_ptr<RDataFrame>& left,
                                                                   std::unique_ptr<RDataFrame>& right) = 0;
   /// This is invoked on every GetEntry() of the RCombinedDS and
@@ -48,6 +51,41 @@ class RCombinedDSIndex
   virtual std::pair<ULong64_t, ULong64_t> GetAssociatedEntries(ULong64_t entry) = 0;
 };
 
+enum struct BlockCombinationRule {
+  Full,
+  Upper,
+  StrictlyUpper,
+  Diagonal,
+  Anti
+};
+
+struct RCombinedDSIndexHelpers {
+  static char const* combinationRuleAsString(BlockCombinationRule ruleType);
+  /// Merge the contiguous @a ranges, dropping the empty ones, and split them
+  /// again in ranges of equal size, @a rangesPerSlot for each of the
+  /// @a nSlots slots, so that all the slots get some work also when the
+  /// index has a few large blocks or many small ones.
+  static std::vector<std::pair<ULong64_t, ULong64_t>> splitRanges(std::vector<std::pair<ULong64_t, ULong64_t>> ranges,
+                                                                  unsigned int nSlots,
+                                                                  unsigned int rangesPerSlot = 4);
+
+  /// The values of @a column of @a df, in the order of its entries also
+  /// when the event loop runs multithreaded, where Take alone returns them
+  /// in the order they were processed by the slots.
+  template <typename T>
+  static std::vector<T> takeInEntryOrder(RDataFrame& df, std::string const& column)
+  {
+    // both booked before running, so that they are filled by the same event loop
+    auto values = df.Take<T>(column);
+    auto entries = df.Take<ULong64_t>("rdfentry_");
+    std::vector<T> result(entries->size());
+    for (size_t i = 0; i < entries->size(); ++i) {
+      result[(*entries)[i]] = (*values)[i];
+    }
+    return result;
+  }
+};
+
 /// An index which allows doing a inner join on the row number for two tables,
 /// i.e.  putting the rows of one next to the rows of other.
 class RCombinedDSFriendIndex : public RCombinedDSIndex
@@ -101,21 +139,9 @@ class RCombinedDSColumnJoinIndex : public RCombinedDSIndex
     BuildIndex(std::unique_ptr<RDataFrame>& left,
                std::unique_ptr<RDataFrame>& right) final
   {
+    fAssociations = RCombinedDSIndexHelpers::takeInEntryOrder<INDEX_TYPE>(*right, fIndexColumnName);
     std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
-    auto nEntries = *right->Count();
-    fAssociations.reserve(nEntries);
-    // Fill the index with the associations
-    auto filler = [& assoc = fAssociations](INDEX_TYPE ri) { assoc.push_back(ri); };
-    right->Foreach(filler, std::vector<std::string>{ fIndexColumnName });
-
-    // Create the ranges by processing 64 entries per range
-    auto deltaRange = 64;
-    ranges.reserve(nEntries / deltaRange + 1);
-    ULong64_t i = 0;
-    while (deltaRange * (i + 1) < nEntries) {
-      ranges.emplace_back(std::pair<ULong64_t, ULong64_t>(deltaRange * i, deltaRange * (i + 1)));
-    }
-    ranges.emplace_back(std::pair<ULong64_t, ULong64_t>(deltaRange * i, nEntries)); // Last entry
+    ranges.emplace_back(0, fAssociations.size());
     return ranges;
   }
 
@@ -124,18 +150,6 @@ class RCombinedDSColumnJoinIndex : public RCombinedDSIndex
   std::vector<INDEX_TYPE> fAssociations;
 };
 
-enum struct BlockCombinationRule {
-  Full,
-  Upper,
-  StrictlyUpper,
-  Diagonal,
-  Anti
-};
-
-struct RCombinedDSIndexHelpers {
-  static char const* combinationRuleAsString(BlockCombinationRule ruleType);
-};
-
 /// An index which allows doing a cross join of all entries belonging to the
 /// same category, where the category is defined by a two given columns.
 ///
@@ -275,7 +289,7 @@ class RCombinedDSBlockJoinIndex : public RCombinedDSIndex
                                  std::vector<Association>& pairs,
                                  std::string const& column)
   {
-    categories = *df->template Take<INDEX_TYPE>(column);
+    categories = RCombinedDSIndexHelpers::takeInEntryOrder<INDEX_TYPE>(*df, column);
     pairs.reserve(categories.size());
     // Fill the pairs according tho the actual category
     for (size_t i = 0; i < categories.size(); ++i) {
@@ -296,6 +310,9 @@ class RCombinedDSBlockJoinIndex : public RCombinedDSIndex
 /// the provided RCombinedDSIndex implementation.
 /// By default it simply pairs same position rows of two tables with the same
 /// length.
+/// With ROOT implicit multithreading the entries of the combined index are
+/// split in ranges which are processed in parallel, one slot per thread, each
+/// slot forwarding to the same slot of the two RDataSources.
 class RCombinedDS final : public ROOT::RDF::RDataSource
 {
  private:
@@ -312,6 +329,10 @@ class RCombinedDS final : public ROOT::RDF::RDataSource
   size_t fNSlots = 0U;
   std::vector<std::string> fColumnNames;
   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+  /// The ranges of the index, split for the slots, kept for the following
+  /// event loops
+  std::vector<std::pair<ULong64_t, ULong64_t>> fIndexRanges;
+  bool fIndexBuilt = false;
   std::unique_ptr<RCombinedDSIndex> fIndex;
 
  protected:
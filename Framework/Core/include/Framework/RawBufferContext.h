@@ -51,6 +51,8 @@ class RawBufferContext
     std::string channel;
     std::function<std::ostringstream()> serializeMsg;
     std::function<void()> destroyPayload;
+    /// alternative to serializeMsg, serializes directly in the payload message
+    std::function<void(FairMQMessage&)> serializeToMsg;
   };
 
   using Messages = std::vector<MessageRef>;
@@ -64,6 +66,15 @@ class RawBufferContext
     mMessages.push_back(std::move(MessageRef{ std::move(header), std::move(payload), std::move(channel), std::move(serialize), std::move(destructor) }));
   }
 
+  void addRawBuffer(std::unique_ptr<FairMQMessage> header,
+                    char* payload,
+                    std::string channel,
+                    std::function<void(FairMQMessage&)> serialize,
+                    std::function<void()> destructor)
+  {
+    mMessages.push_back(MessageRef{ std::move(header), payload, std::move(channel), {}, std::move(destructor), std::move(serialize) });
+  }
+
   Messages::iterator begin()
   {
     return mMessages.begin();
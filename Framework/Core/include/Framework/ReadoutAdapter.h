@@ -24,6 +24,14 @@ namespace framework
 /// is an enumeration of the pages received.
 InjectorFunction readoutAdapter(OutputSpec const& spec);
 
+/// Adapter for the superpages of readout, for the ingestion on the FLPs: every
+/// part is a superpage which is forwarded untouched, the DPL header (DataHeader
+/// and DataProcessingHeader) is attached as a separate small message and both
+/// are shared by the consumers without copy. The consumers split the superpage
+/// into heartbeat frames in place, e.g. on get<gsl::span<char>>() with
+/// o2::algorithm::scanHeartbeatFrames of Algorithm/RawPageScanner.h.
+InjectorFunction readoutSuperpageAdapter(OutputSpec const& spec);
+
 } // namespace framework
 } // namespace o2
 
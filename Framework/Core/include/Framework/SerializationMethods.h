@@ -15,6 +15,7 @@
 
 #include "Framework/TypeTraits.h"
 #include "CommonUtils/BoostSerializer.h"
+#include "CommonUtils/FlatSerializer.h"
 
 namespace o2
 {
@@ -99,6 +100,39 @@ class BoostSerialized
  private:
   wrapped_type& mRef;
 };
+
+/// @class FlatSerialized
+/// Enforce the flat serialization of CommonUtils/FlatSerializer.h for a container
+/// of structs listing their fields with a static flatFields
+///
+/// Usage: (with 'output' being the DataAllocator of the ProcessingContext)
+///   std::vector<SomeType> objects;
+///   output.snapshot(Output{}, FlatSerialized<decltype(objects)>(objects));
+///     - or -
+///   auto& objects = output.make<FlatSerialized<std::vector<SomeType>>>(Output{});
+///
+/// At the receiver side the content is exposed in place as o2::utils::FlatView:
+///   auto view = inputs.get<FlatSerialized<std::vector<SomeType>>>("binding");
+template <typename T>
+class FlatSerialized
+{
+ public:
+  using non_messageable = o2::framework::MarkAsNonMessageable;
+  using wrapped_type = T;
+  using view_type = o2::utils::FlatView<typename T::value_type>;
+
+  static_assert(o2::utils::is_flat_serializable<typename T::value_type>::value == true,
+                "wrapped type is no container of a type with flatFields");
+
+  FlatSerialized() = delete;
+  FlatSerialized(wrapped_type& ref) : mRef(ref) {}
+
+  T& operator()() { return mRef; }
+  T const& operator()() const { return mRef; }
+
+ private:
+  wrapped_type& mRef;
+};
 } // namespace framework
 } // namespace o2
 #endif // FRAMEWORK_SERIALIZATIONMETHODS_H
@@ -10,12 +10,14 @@
 #ifndef FRAMEWORK_SERVICEREGISTRY_H
 #define FRAMEWORK_SERVICEREGISTRY_H
 
+#include "Framework/TypeIndex.h"
+
 #include <exception>
-#include <functional>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
-#include <unordered_map>
+#include <vector>
 
 namespace o2
 {
@@ -23,7 +25,8 @@ namespace framework
 {
 
 /// Service registry to hold generic, singleton like, interfaces and retrieve
-/// them by type.
+/// them by type. The services are stored by the TypeIndex of their interface,
+/// so that a lookup is a direct array access.
 class ServiceRegistry
 {
 public:
@@ -41,7 +44,7 @@ public:
     // advance
     static_assert(std::is_base_of<I, C>::value == true,
                   "Registered service is not derived from declared interface");
-    mServices[typeid(I)] = reinterpret_cast<ServicePtr>(service);
+    store(mServices, TypeIndex::get<I>(), static_cast<I*>(service));
   }
 
   template <class I, class C>
@@ -52,7 +55,7 @@ public:
     // advance
     static_assert(std::is_base_of<I, C>::value == true,
                   "Registered service is not derived from declared interface");
-    mConstServices[typeid(I)] = reinterpret_cast<ConstServicePtr>(service);
+    store(mConstServices, TypeIndex::get<std::remove_const_t<I>>(), static_cast<I const*>(service));
   }
 
   /// Get a service for the given interface T. The returned reference exposed to
@@ -61,13 +64,13 @@ public:
   template <typename T>
   std::enable_if_t<std::is_const_v<T> == false, T&> get() const
   {
-    auto service = mServices.find(typeid(T));
-    if (service == mServices.end()) {
+    auto index = TypeIndex::get<T>();
+    if (index >= mServices.size() || mServices[index] == nullptr) {
       throw std::runtime_error(std::string("Unable to find service of kind ") +
                                typeid(T).name() +
                                " did you register one?");
     }
-    return *reinterpret_cast<T*>(service->second);
+    return *reinterpret_cast<T*>(mServices[index]);
   }
   /// Get a service for the given interface T. The returned reference exposed to
   /// the user is actually of the last concrete type C registered, however this
@@ -75,32 +78,30 @@ public:
   template <typename T>
   std::enable_if_t<std::is_const_v<T>, T&> get() const
   {
-    auto service = mConstServices.find(typeid(T));
-    if (service == mConstServices.end()) {
+    auto index = TypeIndex::get<std::remove_const_t<T>>();
+    if (index >= mConstServices.size() || mConstServices[index] == nullptr) {
       throw std::runtime_error(std::string("Unable to find service of kind ") + typeid(T).name() + ". Is it non-const?");
     }
-    return *reinterpret_cast<T const*>(service->second);
+    return *reinterpret_cast<T const*>(mConstServices[index]);
   }
 
  private:
-  using TypeInfoRef = std::reference_wrapper<const std::type_info>;
   using ServicePtr = void *;
   using ConstServicePtr = void const*;
-  struct Hasher {
-      std::size_t operator()(TypeInfoRef code) const
-      {
-          return code.get().hash_code();
-      }
-  };
-  struct EqualTo {
-      bool operator()(TypeInfoRef lhs, TypeInfoRef rhs) const
-      {
-          return lhs.get() == rhs.get();
-      }
-  };
-  std::unordered_map<TypeInfoRef, ServicePtr, Hasher, EqualTo> mServices;
+
+  template <typename P>
+  static void store(std::vector<P>& services, size_t index, typename std::vector<P>::value_type service)
+  {
+    if (services.size() <= index) {
+      services.resize(index + 1, nullptr);
+    }
+    services[index] = service;
+  }
+
+  /// The services, by TypeIndex of their interface
+  std::vector<ServicePtr> mServices;
   // Services which we want to expose as read only
-  std::unordered_map<TypeInfoRef, ConstServicePtr, Hasher, EqualTo> mConstServices;
+  std::vector<ConstServicePtr> mConstServices;
 };
 
 } // namespace framework
@@ -18,6 +18,7 @@
 #include <TStreamerInfo.h>
 #include <gsl/gsl_util>
 #include <gsl/span>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <MemoryResources/MemoryResources.h>
@@ -48,6 +49,8 @@ struct TMessageSerializer {
   using StreamerList = std::vector<TVirtualStreamerInfo*>;
   using CompressionLevel = int;
   enum class CacheStreamers { yes, no };
+  /// Creates a message of the transport with the given size
+  using MessageCreator = std::function<std::unique_ptr<FairMQMessage>(size_t)>;
 
   static void Serialize(FairMQMessage& msg, const TObject* input,
                         CacheStreamers streamers = CacheStreamers::no,
@@ -58,6 +61,15 @@ struct TMessageSerializer {
                         CacheStreamers streamers = CacheStreamers::no,        //
                         CompressionLevel compressionLevel = -1);
 
+  /// Serialize @a input of class @a cl directly into the buffer of a message
+  /// made by @a creator, rather than into a TMessage buffer which is then
+  /// handed over to the transport. The message is created with the size of
+  /// the last object of the same class serialized by this thread, and it is
+  /// only replaced by a larger one, like FairMQResizableBuffer does, if the
+  /// object does not fit.
+  template <typename T>
+  static std::unique_ptr<FairMQMessage> SerializeToMessage(MessageCreator const& creator, const T* input, const TClass* cl);
+
   template <typename T = TObject>
   static void Deserialize(const FairMQMessage& msg, std::unique_ptr<T>& output);
 
@@ -90,6 +102,8 @@ struct TMessageSerializer {
   static void updateStreamers(const TObject* object);
 
  private:
+  static std::unique_ptr<FairMQMessage> serializeToMessage(MessageCreator const& creator, const void* input, const TClass* cl);
+
   // update the cache of streamer infos for serialized classes
   static void updateStreamers(const FairTMessage& message, StreamerList& streamers);
 
@@ -197,6 +211,13 @@ inline void TMessageSerializer::Serialize(FairMQMessage& msg, const T* input,
   tm.release();
 }
 
+template <typename T>
+inline std::unique_ptr<FairMQMessage> TMessageSerializer::SerializeToMessage(MessageCreator const& creator,
+                                                                             const T* input, const TClass* cl)
+{
+  return serializeToMessage(creator, static_cast<const void*>(input), cl);
+}
+
 template <typename T>
 inline void TMessageSerializer::Deserialize(const FairMQMessage& msg, std::unique_ptr<T>& output)
 {
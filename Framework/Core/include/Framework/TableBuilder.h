@@ -16,6 +16,8 @@
 #include <arrow/table.h>
 #include <arrow/builder.h>
 
+#include <gsl/span>
+
 #include <functional>
 #include <vector>
 #include <string>
@@ -219,6 +221,21 @@ struct TableBuilderHelpers {
   {
     return (std::get<Is>(builders)->Reserve(s).ok() && ...);
   }
+
+  /// @return the common size of all the columns
+  template <typename... SIZES>
+  static size_t commonLength(size_t first, SIZES... sizes)
+  {
+    if (((sizes != first) || ...)) {
+      throw std::runtime_error("Mismatching length of the columns");
+    }
+    return first;
+  }
+
+  /// Wraps @a length values of @a valueSize bytes at @a data in an array of
+  /// @a type without copying them. The buffer keeps @a owner alive.
+  static std::shared_ptr<arrow::Array> adoptArray(std::shared_ptr<arrow::DataType> type, void const* data,
+                                                  size_t length, size_t valueSize, std::shared_ptr<void> owner);
 };
 
 /// Helper class which creates a lambda suitable for building
@@ -233,7 +250,7 @@ class TableBuilder
     if (nColumns != columnNames.size()) {
       throw std::runtime_error("Mismatching number of column types and names");
     }
-    if (mBuilders != nullptr) {
+    if (mBuilders != nullptr || mFinalizer) {
       throw std::runtime_error("TableBuilder::persist can only be invoked once per instance");
     }
   }
@@ -328,6 +345,43 @@ class TableBuilder
     };
   }
 
+  /// Fills the table column-wise from contiguous arrays of equal length, the
+  /// values of each column are appended in one go.
+  /// Usage: builder.bulkFill<float, int>({ "x", "n" }, xs, ns);
+  template <typename... ARGS>
+  void bulkFill(std::vector<std::string> const& columnNames, gsl::span<ARGS const>... columns)
+  {
+    using BuildersTuple = typename std::tuple<std::unique_ptr<typename BuilderTraits<ARGS>::BuilderType>...>;
+    constexpr int nColumns = sizeof...(ARGS);
+    validate<ARGS...>(columnNames);
+    auto nRows = TableBuilderHelpers::commonLength(columns.size()...);
+    mArrays.resize(nColumns);
+    makeBuilders<ARGS...>(columnNames, nRows);
+    makeFinalizer<ARGS...>();
+    auto status = TableBuilderHelpers::bulkAppend(*(BuildersTuple*)mBuilders, nRows, std::index_sequence_for<ARGS...>{},
+                                                  std::make_tuple(columns.data()...));
+    if (status == false) {
+      throw std::runtime_error("Unable to append");
+    }
+  }
+
+  /// Creates the columns of the table from existing contiguous arrays of equal
+  /// length, without copying them. The arrays must stay valid as long as the
+  /// table is in use, @a owner, e.g. the message holding the arrays, is kept
+  /// alive by the table for this. Only fixed width numeric columns can be
+  /// adopted, as booleans are bit packed in arrow.
+  template <typename... ARGS>
+  void adoptColumns(std::vector<std::string> const& columnNames, std::shared_ptr<void> owner, gsl::span<ARGS const>... columns)
+  {
+    static_assert(((std::is_arithmetic<ARGS>::value && std::is_same<ARGS, bool>::value == false) && ...),
+                  "only fixed width numeric columns can be adopted");
+    validate<ARGS...>(columnNames);
+    auto nRows = TableBuilderHelpers::commonLength(columns.size()...);
+    mSchema = std::make_shared<arrow::Schema>(TableBuilderHelpers::makeFields<ARGS...>(columnNames));
+    mArrays = { TableBuilderHelpers::adoptArray(BuilderMaker<ARGS>::make_datatype(), columns.data(), nRows, sizeof(ARGS), owner)... };
+    mFinalizer = []() {};
+  }
+
   /// Actually creates the arrow::Table from the builders
   std::shared_ptr<arrow::Table> finalize();
 
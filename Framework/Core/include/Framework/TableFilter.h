@@ -0,0 +1,243 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef o2_framework_TableFilter_H_DEFINED
+#define o2_framework_TableFilter_H_DEFINED
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace arrow
+{
+class Array;
+class RecordBatch;
+class Table;
+} // namespace arrow
+
+namespace o2
+{
+namespace analysis
+{
+
+/// The indices of the rows of a table or record batch which pass a Filter,
+/// in increasing order
+using SelectionVector = std::vector<int64_t>;
+
+enum struct CompareOp : int {
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+  Equal,
+  NotEqual
+};
+
+/// A selection on the numeric columns of a table, built from column()
+/// comparisons combined with &&, || and !, e.g.
+///
+///   auto filter = column("pt") > 0.5f && column("eta") > -0.9f && column("eta") < 0.9f;
+///   auto selected = filter.select(*table);
+///
+/// The comparisons are evaluated on whole arrays, one column at a time, into
+/// byte masks which are then combined, so that the loops vectorize. Rows for
+/// which a column is null are not selected. A default constructed Filter
+/// selects all the rows.
+class Filter
+{
+ public:
+  struct Node;
+
+  Filter() = default;
+  explicit Filter(std::shared_ptr<Node const> node) : mNode{ std::move(node) } {}
+
+  /// @return the rows of @a batch which pass the filter. Throws
+  /// std::runtime_error if a column is missing or is not numeric.
+  SelectionVector select(arrow::RecordBatch const& batch) const;
+  /// @return the rows of @a table which pass the filter
+  SelectionVector select(arrow::Table const& table) const;
+  /// Set @a mask to 1 for the rows of @a batch which pass the filter, 0 otherwise
+  void mask(arrow::RecordBatch const& batch, std::vector<uint8_t>& mask) const;
+
+  bool empty() const { return mNode == nullptr; }
+  std::shared_ptr<Node const> const& node() const { return mNode; }
+
+ private:
+  std::shared_ptr<Node const> mNode;
+};
+
+/// A column of the table, to be compared with a value
+struct ColumnRef {
+  std::string name;
+};
+
+inline ColumnRef column(std::string name) { return ColumnRef{ std::move(name) }; }
+
+Filter compare(ColumnRef const& column, CompareOp op, double value);
+Filter operator&&(Filter const& lhs, Filter const& rhs);
+Filter operator||(Filter const& lhs, Filter const& rhs);
+Filter operator!(Filter const& filter);
+
+inline Filter operator<(ColumnRef const& c, double v) { return compare(c, CompareOp::Less, v); }
+inline Filter operator<=(ColumnRef const& c, double v) { return compare(c, CompareOp::LessEqual, v); }
+inline Filter operator>(ColumnRef const& c, double v) { return compare(c, CompareOp::Greater, v); }
+inline Filter operator>=(ColumnRef const& c, double v) { return compare(c, CompareOp::GreaterEqual, v); }
+inline Filter operator==(ColumnRef const& c, double v) { return compare(c, CompareOp::Equal, v); }
+inline Filter operator!=(ColumnRef const& c, double v) { return compare(c, CompareOp::NotEqual, v); }
+
+/// @return the record batches of @a table, zero copy, with at most
+/// @a chunkSize rows each if it is not 0, otherwise following its chunks
+std::vector<std::shared_ptr<arrow::RecordBatch>> getRecordBatches(std::shared_ptr<arrow::Table> const& table, int64_t chunkSize = 0);
+
+/// Process the record batches of @a table on @a nThreads threads. Each
+/// thread gets its own state from @a init, e.g. its own histograms, and
+/// calls @a process on it for each of the batches it picks up with the rows
+/// of the batch which pass @a filter. The states are then merged with
+/// @a merge, which has to add its second argument to its first one, in the
+/// order of the threads, and the merged state is returned, e.g.
+///
+///   auto histos = processInParallel(table, 4,
+///     []() { return std::make_unique<TH1F>("pt", "pt", 100, 0, 10); },
+///     [](auto& h, arrow::RecordBatch const& batch, SelectionVector const& rows) { ... },
+///     [](auto& h, auto& other) { h->Add(other.get()); },
+///     column("pt") > 0.5f);
+///
+/// ROOT histograms must not be attached to a directory to be filled from
+/// several threads, i.e. TH1::AddDirectory(false) must have been called.
+template <typename INIT, typename PROCESS, typename MERGE>
+auto processInParallel(std::shared_ptr<arrow::Table> const& table,
+                       size_t nThreads,
+                       INIT init,
+                       PROCESS process,
+                       MERGE merge,
+                       Filter const& filter = Filter{},
+                       int64_t chunkSize = 0) -> decltype(init())
+{
+  using STATE = decltype(init());
+  auto batches = getRecordBatches(table, chunkSize);
+  nThreads = std::max<size_t>(1, std::min(nThreads, batches.size()));
+  std::vector<STATE> states;
+  states.reserve(nThreads);
+  for (size_t ti = 0; ti < nThreads; ++ti) {
+    states.emplace_back(init());
+  }
+
+  std::atomic<size_t> next{ 0 };
+  std::vector<std::exception_ptr> errors(nThreads);
+  auto worker = [&](size_t ti) {
+    try {
+      for (size_t bi = next++; bi < batches.size(); bi = next++) {
+        process(states[ti], *batches[bi], filter.select(*batches[bi]));
+      }
+    } catch (...) {
+      errors[ti] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t ti = 1; ti < nThreads; ++ti) {
+    threads.emplace_back(worker, ti);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  for (size_t ti = 1; ti < nThreads; ++ti) {
+    merge(states[0], states[ti]);
+  }
+  return std::move(states[0]);
+}
+
+namespace filter_kernels
+{
+/// mask[i] = values[i] OP value for the @a n values, comparing in the type
+/// of the column for floating point columns, in double otherwise
+template <typename T, typename V>
+void compare(T const* values, int64_t n, CompareOp op, V value, uint8_t* mask)
+{
+  switch (op) {
+    case CompareOp::Less:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] = static_cast<V>(values[i]) < value;
+      }
+      break;
+    case CompareOp::LessEqual:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] = static_cast<V>(values[i]) <= value;
+      }
+      break;
+    case CompareOp::Greater:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] = static_cast<V>(values[i]) > value;
+      }
+      break;
+    case CompareOp::GreaterEqual:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] = static_cast<V>(values[i]) >= value;
+      }
+      break;
+    case CompareOp::Equal:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] = static_cast<V>(values[i]) == value;
+      }
+      break;
+    case CompareOp::NotEqual:
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] = static_cast<V>(values[i]) != value;
+      }
+      break;
+  }
+}
+
+/// Clear the entries of @a mask whose bit, starting at @a offset, is not set
+/// in the validity @a bitmap
+inline void applyValidity(uint8_t const* bitmap, int64_t offset, int64_t n, uint8_t* mask)
+{
+  for (int64_t i = 0; i < n; ++i) {
+    auto bit = offset + i;
+    mask[i] &= (bitmap[bit >> 3] >> (bit & 7)) & 1;
+  }
+}
+
+/// @return the indices of the non zero entries of @a mask
+inline SelectionVector toSelection(uint8_t const* mask, int64_t n)
+{
+  SelectionVector selection;
+  int64_t count = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    count += mask[i];
+  }
+  // one spare entry, so that the index can always be written and is kept
+  // only if selected, without branches
+  selection.resize(count + 1);
+  int64_t* out = selection.data();
+  for (int64_t i = 0; i < n; ++i) {
+    *out = i;
+    out += mask[i] != 0;
+  }
+  selection.resize(count);
+  return selection;
+}
+} // namespace filter_kernels
+
+} // namespace analysis
+} // namespace o2
+
+#endif // o2_framework_TableFilter_H_DEFINED
@@ -0,0 +1,142 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef FRAMEWORK_TIMERWHEEL_H
+#define FRAMEWORK_TIMERWHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2
+{
+namespace framework
+{
+
+/// A hierarchical timer wheel, to find the entries whose deadline is due
+/// without looking at all of them.
+///
+/// Time is counted in ticks of configurable length. The wheel has Levels
+/// levels of Slots buckets, the buckets of level l spanning Slots^l ticks.
+/// An entry is put in the level whose span covers its distance to the
+/// current tick. Expiring entries are taken from the buckets of level 0 as
+/// the time advances. Whenever the level 0 wraps, a bucket of level 1 is
+/// redistributed to the lower levels, and so on. Scheduling is O(1), and
+/// advancing is O(elapsed ticks + due entries). Deadlines beyond the span
+/// of the wheel are kept in its last bucket until they get closer.
+///
+/// Deadlines are rounded up to the tick: an entry never fires before its
+/// deadline, but up to one tick after it.
+class TimerWheel
+{
+ public:
+  static constexpr int Levels = 4;
+  static constexpr int SlotsBits = 6;
+  static constexpr uint64_t Slots = 1 << SlotsBits;
+
+  /// @a tick is the length of a tick and @a start the current time, in
+  /// whatever units the deadlines are given.
+  TimerWheel(uint64_t tick, uint64_t start) : mTick{ tick }, mCurrent{ start / tick } {}
+
+  /// Schedule @a id to fire at @a deadline. The same id can be scheduled
+  /// more than once.
+  void schedule(size_t id, uint64_t deadline)
+  {
+    insert({ (deadline + mTick - 1) / mTick, id });
+    ++mSize;
+  }
+
+  /// Advance the time to @a now, invoking @a onExpired(id) for every entry
+  /// which is due, in the order of their deadlines (to the tick). The
+  /// entries scheduled by onExpired fire at the next tick at the earliest.
+  template <typename F>
+  void advance(uint64_t now, F&& onExpired)
+  {
+    auto target = now / mTick;
+    mAdvancing = true;
+    while (mCurrent <= target) {
+      if (mSize == 0) {
+        mCurrent = target + 1;
+        break;
+      }
+      cascade();
+      auto& bucket = mBuckets[0][mCurrent & (Slots - 1)];
+      if (bucket.empty() == false) {
+        std::vector<Entry> due;
+        due.swap(bucket);
+        mSize -= due.size();
+        for (auto& entry : due) {
+          onExpired(entry.id);
+        }
+        // The bucket is reused, unless it was filled again by onExpired
+        if (bucket.empty()) {
+          due.clear();
+          bucket.swap(due);
+        }
+      }
+      ++mCurrent;
+    }
+    mAdvancing = false;
+  }
+
+  /// Number of scheduled entries
+  size_t size() const { return mSize; }
+
+ private:
+  struct Entry {
+    uint64_t ticks; // deadline, in ticks
+    size_t id;
+  };
+
+  void insert(Entry entry)
+  {
+    // Anything overdue fires at the current tick, or at the next one if the
+    // current one is being processed.
+    auto earliest = mCurrent + (mAdvancing ? 1 : 0);
+    auto ticks = entry.ticks > earliest ? entry.ticks : earliest;
+    auto delta = ticks - mCurrent;
+    for (int level = 0; level < Levels; ++level) {
+      if (delta < (Slots << (SlotsBits * level))) {
+        mBuckets[level][(ticks >> (SlotsBits * level)) & (Slots - 1)].push_back(entry);
+        return;
+      }
+    }
+    // Beyond the span of the wheel: the farthest bucket, whence it is
+    // redistributed when the top level wraps around to it.
+    auto top = Levels - 1;
+    mBuckets[top][((mCurrent >> (SlotsBits * top)) - 1) & (Slots - 1)].push_back(entry);
+  }
+
+  /// Redistribute the buckets of the upper levels reached at the current tick
+  void cascade()
+  {
+    for (int level = 1; level < Levels; ++level) {
+      if ((mCurrent & ((uint64_t(1) << (SlotsBits * level)) - 1)) != 0) {
+        return;
+      }
+      std::vector<Entry> entries;
+      entries.swap(mBuckets[level][(mCurrent >> (SlotsBits * level)) & (Slots - 1)]);
+      for (auto& entry : entries) {
+        insert(entry);
+      }
+    }
+  }
+
+  uint64_t mTick;
+  uint64_t mCurrent; // the current time, in ticks
+  size_t mSize = 0;
+  bool mAdvancing = false;
+  std::array<std::array<std::vector<Entry>, Slots>, Levels> mBuckets;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // FRAMEWORK_TIMERWHEEL_H
@@ -0,0 +1,113 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef FRAMEWORK_TIMESLICECREDITS_H
+#define FRAMEWORK_TIMESLICECREDITS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace framework
+{
+
+struct DeviceSpec;
+
+/// Credit based flow control between the sources of a workflow and their
+/// consumers, enabled with --flow-control.
+///
+/// The driver creates a POSIX shared memory segment with one entry per
+/// device. Every device advertises in its entry how many timeslices it can
+/// hold at the same time (DataRelayer::getParallelTimeslices) and counts the
+/// timeslices it has processed. A source, i.e. a device without input
+/// channels, compares the timeslices it has sent with the ones processed by
+/// its consumers: the difference is in flight, and the source only creates
+/// a new timeslice while the consumers have free slots for it.
+///
+/// The consumers of a source are grouped by data processor, so that the
+/// time pipelined instances of a consumer share the timeslices of the
+/// source: the processed timeslices and the windows of a group are summed.
+/// A consumer which does not process all the timeslices of its source (e.g.
+/// because of a sampling condition) would hold the source forever, which is
+/// why the flow control is not enabled by default.
+class TimesliceCredits
+{
+ public:
+  /// Environment variables the driver uses to pass the segment, the index of
+  /// the device in it and, for a source, its consumers
+  static constexpr const char* ENV_NAME = "DPL_TIMESLICE_CREDITS";
+  static constexpr const char* ENV_INDEX = "DPL_TIMESLICE_CREDITS_INDEX";
+  static constexpr const char* ENV_CONSUMERS = "DPL_TIMESLICE_CREDITS_CONSUMERS";
+
+  /// The indices of the consumers of a source, one group per data processor
+  using ConsumerGroups = std::vector<std::vector<size_t>>;
+
+  /// What a source can send: the timeslices its most loaded group of
+  /// consumers has free and has in flight
+  struct Credit {
+    int64_t free;
+    int64_t inFlight;
+  };
+
+  /// Create the segment @a name for @a devices devices, which is removed
+  /// again when the credits are destroyed.
+  /// @return nullptr if the segment can not be created
+  static std::unique_ptr<TimesliceCredits> create(std::string const& name, size_t devices);
+  /// Attach to the segment @a name created by the driver
+  /// @return nullptr if there is no such segment
+  static std::unique_ptr<TimesliceCredits> attach(std::string const& name);
+
+  ~TimesliceCredits();
+  TimesliceCredits(TimesliceCredits const&) = delete;
+  TimesliceCredits& operator=(TimesliceCredits const&) = delete;
+
+  size_t size() const { return mDevices; }
+  std::string const& name() const { return mName; }
+
+  /// The device @a index can hold @a window timeslices at the same time
+  void advertise(size_t index, size_t window);
+  /// The device @a index has processed one more timeslice
+  void processed(size_t index);
+  /// The timeslices processed so far by the device @a index
+  size_t getProcessed(size_t index) const;
+
+  /// The credit of a source which has sent @a sent timeslices to @a groups.
+  /// Groups which did not advertise a window yet are not considered, the
+  /// credit is unlimited if there are none.
+  Credit credit(ConsumerGroups const& groups, size_t sent) const;
+
+  /// The consumers of each of @a devices, empty for the ones which have
+  /// input channels
+  static std::vector<ConsumerGroups> computeConsumers(std::vector<DeviceSpec> const& devices);
+  /// The ConsumerGroups as passed in ENV_CONSUMERS, e.g. "1,2;4"
+  static std::string encodeConsumers(ConsumerGroups const& groups);
+  static ConsumerGroups decodeConsumers(std::string const& encoded);
+
+ private:
+  struct Control;
+  struct Entry;
+
+  TimesliceCredits(std::string const& name, void* memory, size_t mappedSize, bool owner);
+
+  std::string mName;
+  void* mMemory;
+  size_t mMappedSize;
+  bool mOwner;
+  size_t mDevices;
+  Entry* mEntries;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // FRAMEWORK_TIMESLICECREDITS_H
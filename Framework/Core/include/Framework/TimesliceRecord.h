@@ -0,0 +1,73 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef o2_framework_TimesliceRecord_H_INCLUDED
+#define o2_framework_TimesliceRecord_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace framework
+{
+
+/// One input of a recorded timeslice: the whole header stack, starting with
+/// the DataHeader, and the payload
+struct RecordedPart {
+  std::vector<char> header;
+  std::vector<char> payload;
+};
+
+using RecordedTimeslice = std::vector<RecordedPart>;
+
+/// Binary file with the inputs of a device, timeslice by timeslice, which is
+/// written by the timeslice recorder and read back by the replayer. The file
+/// starts with the magic and the version, then for each timeslice the number
+/// of parts, and for each part the sizes of its header stack and payload
+/// followed by their content. Sizes are in the byte order of the host.
+struct TimesliceRecord {
+  static constexpr const char* MAGIC = "O2DPLREC";
+  static constexpr uint32_t VERSION = 1;
+
+  /// @return all the timeslices in @a filename, throws std::runtime_error if
+  /// the file can not be read or is not a valid record. Without @a payloads
+  /// only the headers are read, e.g. to find out what has been recorded.
+  static std::vector<RecordedTimeslice> read(std::string const& filename, bool payloads = true);
+};
+
+/// Appends the timeslices to a record file
+class TimesliceRecordWriter
+{
+ public:
+  /// Create @a filename, throws std::runtime_error if it can not be opened
+  explicit TimesliceRecordWriter(std::string const& filename);
+
+  /// Start a timeslice which has @a nParts parts, to be added with addPart
+  void beginTimeslice(uint32_t nParts);
+  /// Add a part to the current timeslice, @a header being the whole stack
+  void addPart(char const* header, size_t headerSize, char const* payload, size_t payloadSize);
+
+  /// @return the number of timeslices written so far
+  size_t timeslices() const { return mTimeslices; }
+
+ private:
+  std::ofstream mFile;
+  size_t mTimeslices = 0;
+  uint32_t mMissingParts = 0;
+  std::string mFilename;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // o2_framework_TimesliceRecord_H_INCLUDED
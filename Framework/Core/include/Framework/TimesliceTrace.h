@@ -0,0 +1,137 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef o2_framework_TimesliceTrace_H_INCLUDED
+#define o2_framework_TimesliceTrace_H_INCLUDED
+
+#include "Headers/DataHeader.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace o2
+{
+namespace framework
+{
+
+/// Header added to the header stack of the outputs of a device when the
+/// timeslice tracing is enabled, so that the next device can tell how long
+/// a message took to reach it and how long ago its timeslice entered the
+/// traced part of the topology. Times are in ns of the steady clock, which is
+/// shared by all the devices of a host.
+struct TimesliceTraceHeader : public header::BaseHeader {
+  constexpr static const o2::header::HeaderType sHeaderType = "DPLTrace";
+  static const uint32_t sVersion = 1;
+
+  /// when the message was sent by the upstream device
+  uint64_t sendTime;
+  /// when the timeslice was sent by the first traced device
+  uint64_t originTime;
+
+  TimesliceTraceHeader(uint64_t send = 0, uint64_t origin = 0)
+    : BaseHeader(sizeof(TimesliceTraceHeader), sHeaderType, header::gSerializationMethodNone, sVersion),
+      sendTime(send),
+      originTime(origin)
+  {
+  }
+};
+
+/// The points of the life of a timeslice within a device
+enum struct TracePoint : int {
+  RelayArrival,   ///< the last input of the timeslice was relayed
+  ReadyToProcess, ///< the relayer reported the timeslice as ready
+  CallbackStart,  ///< the processing callback was invoked
+  CallbackEnd,    ///< the processing callback returned
+  Send,           ///< the outputs were sent
+  Count
+};
+
+/// The trace of a timeslice within a device
+struct TimesliceTrace {
+  /// times of the trace points, 0 if not reached
+  std::array<uint64_t, static_cast<int>(TracePoint::Count)> points = {};
+  /// when the first input of the timeslice was relayed
+  uint64_t firstArrival = 0;
+  /// the latest send time of the traced inputs, 0 if none was traced
+  uint64_t upstreamSend = 0;
+  /// the earliest origin time of the traced inputs, 0 if none was traced
+  uint64_t originTime = 0;
+
+  uint64_t at(TracePoint point) const { return points[static_cast<int>(point)]; }
+};
+
+/// Where a device spent the time of a timeslice, in ns
+struct TimesliceBreakdown {
+  /// from the upstream send to the last input relay, -1 if untraced upstream
+  int64_t transfer = -1;
+  /// from the first to the last input relay
+  int64_t inputWait = 0;
+  /// from the last input relay to the relayer reporting it as ready
+  int64_t queue = 0;
+  /// from ready to the start of the callback, fetching the inputs
+  int64_t dispatch = 0;
+  /// the processing callback
+  int64_t compute = 0;
+  /// from the end of the callback until all the outputs are sent
+  int64_t send = 0;
+  /// from the origin of the timeslice to the send, the latency accumulated
+  /// along the critical path up to this device
+  int64_t sinceOrigin = -1;
+
+  static TimesliceBreakdown fromTrace(TimesliceTrace const& trace);
+};
+
+/// Records the trace points of the timeslices being processed by a device.
+/// At most maxOpenTraces timeslices are tracked, the oldest ones are dropped,
+/// so that the timeslices which are never processed do not accumulate.
+class TimesliceTracer
+{
+ public:
+  TimesliceTracer(size_t maxOpenTraces = 1024) : mMaxOpenTraces{ maxOpenTraces } {}
+
+  static uint64_t now();
+
+  bool isEnabled() const { return mEnabled; }
+  void setEnabled(bool enabled) { mEnabled = enabled; }
+
+  /// Record that an input of @a timeslice was relayed. @a upstream is the
+  /// trace header of the input, if any.
+  void relayed(size_t timeslice, TimesliceTraceHeader const* upstream, uint64_t time = now());
+  /// Record reaching @a point for @a timeslice at @a time
+  void mark(size_t timeslice, TracePoint point, uint64_t time = now());
+  /// @return the trace of @a timeslice, nullptr if it is not tracked
+  TimesliceTrace const* get(size_t timeslice) const;
+  /// The header to add to the outputs of @a timeslice sent at @a time. The
+  /// origin is passed on from the inputs, or starts at this device.
+  TimesliceTraceHeader outputHeader(size_t timeslice, uint64_t time) const;
+  /// Stop tracking @a timeslice, @return its trace
+  TimesliceTrace finish(size_t timeslice);
+
+  size_t openTraces() const { return mTraces.size(); }
+
+  /// Copy the header stack @a stack of @a size bytes to @a out, appending
+  /// @a trace at its end. @a out must have space for
+  /// size + sizeof(TimesliceTraceHeader) bytes.
+  /// @return the size of the new stack
+  static size_t appendHeader(char const* stack, size_t size, char* out, TimesliceTraceHeader const& trace);
+
+ private:
+  TimesliceTrace& trace(size_t timeslice);
+
+  bool mEnabled = false;
+  size_t mMaxOpenTraces;
+  std::map<size_t, TimesliceTrace> mTraces;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // o2_framework_TimesliceTrace_H_INCLUDED
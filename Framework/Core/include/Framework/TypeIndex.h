@@ -0,0 +1,43 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef FRAMEWORK_TYPEINDEX_H
+#define FRAMEWORK_TYPEINDEX_H
+
+#include <cstddef>
+
+namespace o2
+{
+namespace framework
+{
+
+/// Dense indices of the types used as keys by the ServiceRegistry and the
+/// ContextRegistry, so that they look up their entries by indexing an array
+/// rather than by hashing or comparing typeid's.
+///
+/// The index of a type is assigned the first time it is asked for, from a
+/// counter shared by all the types. The counter lives in libFramework, and
+/// the per type static is merged by the dynamic linker like any other
+/// template static, so the index is the same in all the libraries.
+struct TypeIndex {
+  template <typename T>
+  static size_t get()
+  {
+    static const size_t index = next();
+    return index;
+  }
+
+ private:
+  static size_t next();
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // FRAMEWORK_TYPEINDEX_H
@@ -16,6 +16,7 @@
 
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
 #include <gsl/gsl>
 
 namespace o2
@@ -34,6 +35,20 @@ template <template <typename...> class Ref, typename... Args>
 struct is_specialization<Ref<Args...>, Ref> : std::true_type {
 };
 
+/// Helper trait to determine if a given type T is a std::vector using a
+/// polymorphic allocator, i.e. whose buffer can be allocated directly in
+/// the memory of a message, like o2::vector<T>.
+template <typename T, typename _ = void>
+struct is_pmr_vector : std::false_type {
+};
+
+template <typename T>
+struct is_pmr_vector<T, std::enable_if_t<is_specialization<T, std::vector>::value &&
+                                         std::is_same<typename T::allocator_type,
+                                                      boost::container::pmr::polymorphic_allocator<typename T::value_type>>::value>>
+  : std::true_type {
+};
+
 // helper struct to mark a type as non-messageable by defining a type alias
 // with name 'non-messageable'
 struct MarkAsNonMessageable {
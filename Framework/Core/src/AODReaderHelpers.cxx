@@ -20,9 +20,18 @@
 
 #include <arrow/ipc/reader.h>
 #include <arrow/ipc/writer.h>
+#include <arrow/io/file.h>
 #include <arrow/io/interfaces.h>
+#include <arrow/record_batch.h>
 #include <arrow/table.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <sys/stat.h>
+
 namespace o2::framework::readers
 {
 namespace
@@ -78,6 +87,196 @@ class FileStream : public arrow::io::InputStream
   int64_t mPos = 0;
 };
 
+/// The AOD tables known to the readers
+std::vector<header::DataDescription> const& knownAODTables()
+{
+  static std::vector<header::DataDescription> tables{
+    header::DataDescription{ "TRACKPAR" },
+    header::DataDescription{ "TRACKPARCOV" },
+    header::DataDescription{ "TRACKEXTRA" },
+    header::DataDescription{ "CALO" },
+    header::DataDescription{ "MUON" },
+    header::DataDescription{ "VZERO" },
+    header::DataDescription{ "DZEROFLAGGED" },
+  };
+  return tables;
+}
+
+/// Provides the builder to fill a table with, nullptr if the table is not wanted
+using BuilderProvider = std::function<TableBuilder*(header::DataDescription const&)>;
+
+/// Convert the AOD tables of @a infile into the builders provided by @a builderFor
+void convertRootTables(TFile* infile, BuilderProvider const& builderFor)
+{
+  /// FIXME: Substitute here the actual data you want to convert for the AODReader
+  if (auto* trackParBuilder = builderFor(header::DataDescription{ "TRACKPAR" })) {
+    std::unique_ptr<TTreeReader> reader = std::make_unique<TTreeReader>("O2tracks", infile);
+    TTreeReaderValue<int> c0(*reader, "fID4Tracks");
+    TTreeReaderValue<float> c1(*reader, "fX");
+    TTreeReaderValue<float> c2(*reader, "fAlpha");
+    TTreeReaderValue<float> c3(*reader, "fY");
+    TTreeReaderValue<float> c4(*reader, "fZ");
+    TTreeReaderValue<float> c5(*reader, "fSnp");
+    TTreeReaderValue<float> c6(*reader, "fTgl");
+    TTreeReaderValue<float> c7(*reader, "fSigned1Pt");
+    RootTableBuilderHelpers::convertTTree(*trackParBuilder, *reader,
+                                          c0, c1, c2, c3, c4, c5, c6, c7);
+  }
+
+  if (auto* trackParCovBuilder = builderFor(header::DataDescription{ "TRACKPARCOV" })) {
+    std::unique_ptr<TTreeReader> covReader = std::make_unique<TTreeReader>("O2tracks", infile);
+    TTreeReaderValue<float> c0(*covReader, "fCYY");
+    TTreeReaderValue<float> c1(*covReader, "fCZY");
+    TTreeReaderValue<float> c2(*covReader, "fCZZ");
+    TTreeReaderValue<float> c3(*covReader, "fCSnpY");
+    TTreeReaderValue<float> c4(*covReader, "fCSnpZ");
+    TTreeReaderValue<float> c5(*covReader, "fCSnpSnp");
+    TTreeReaderValue<float> c6(*covReader, "fCTglSnp");
+    TTreeReaderValue<float> c7(*covReader, "fCTglTgl");
+    TTreeReaderValue<float> c8(*covReader, "fC1PtY");
+    TTreeReaderValue<float> c9(*covReader, "fC1PtZ");
+    TTreeReaderValue<float> c10(*covReader, "fC1PtSnp");
+    TTreeReaderValue<float> c11(*covReader, "fC1PtTgl");
+    TTreeReaderValue<float> c12(*covReader, "fC1Pt21Pt2");
+    RootTableBuilderHelpers::convertTTree(*trackParCovBuilder, *covReader,
+                                          c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, c11, c12);
+  }
+
+  if (auto* extraBuilder = builderFor(header::DataDescription{ "TRACKEXTRA" })) {
+    std::unique_ptr<TTreeReader> extraReader = std::make_unique<TTreeReader>("O2tracks", infile);
+    TTreeReaderValue<float> c0(*extraReader, "fTPCinnerP");
+    TTreeReaderValue<uint64_t> c1(*extraReader, "fFlags");
+    TTreeReaderValue<unsigned char> c2(*extraReader, "fITSClusterMap");
+    TTreeReaderValue<unsigned short> c3(*extraReader, "fTPCncls");
+    TTreeReaderValue<unsigned char> c4(*extraReader, "fTRDntracklets");
+    TTreeReaderValue<float> c5(*extraReader, "fITSchi2Ncl");
+    TTreeReaderValue<float> c6(*extraReader, "fTPCchi2Ncl");
+    TTreeReaderValue<float> c7(*extraReader, "fTRDchi2");
+    TTreeReaderValue<float> c8(*extraReader, "fTOFchi2");
+    TTreeReaderValue<float> c9(*extraReader, "fTPCsignal");
+    TTreeReaderValue<float> c10(*extraReader, "fTRDsignal");
+    TTreeReaderValue<float> c11(*extraReader, "fTOFsignal");
+    TTreeReaderValue<float> c12(*extraReader, "fLength");
+    RootTableBuilderHelpers::convertTTree(*extraBuilder, *extraReader,
+                                          c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, c11);
+  }
+
+  if (auto* extraBuilder = builderFor(header::DataDescription{ "CALO" })) {
+    std::unique_ptr<TTreeReader> extraReader = std::make_unique<TTreeReader>("O2calo", infile);
+    TTreeReaderValue<int> c0(*extraReader, "fID4Calo");
+    TTreeReaderValue<short> c1(*extraReader, "fCellNumber");
+    TTreeReaderValue<float> c2(*extraReader, "fAmplitude");
+    TTreeReaderValue<float> c3(*extraReader, "fTime");
+    TTreeReaderValue<int8_t> c4(*extraReader, "fType");
+    RootTableBuilderHelpers::convertTTree(*extraBuilder, *extraReader,
+                                          c0, c1, c2, c3, c4);
+  }
+
+  if (auto* muBuilder = builderFor(header::DataDescription{ "MUON" })) {
+    std::unique_ptr<TTreeReader> muReader = std::make_unique<TTreeReader>("O2mu", infile);
+    TTreeReaderValue<int> c0(*muReader, "fID4mu");
+    TTreeReaderValue<float> c1(*muReader, "fInverseBendingMomentum");
+    TTreeReaderValue<float> c2(*muReader, "fThetaX");
+    TTreeReaderValue<float> c3(*muReader, "fThetaY");
+    TTreeReaderValue<float> c4(*muReader, "fZmu");
+    TTreeReaderValue<float> c5(*muReader, "fBendingCoor");
+    TTreeReaderValue<float> c6(*muReader, "fNonBendingCoor");
+    TTreeReaderArray<float> c7(*muReader, "fCovariances");
+    TTreeReaderValue<float> c8(*muReader, "fChi2");
+    TTreeReaderValue<float> c9(*muReader, "fChi2MatchTrigger");
+    TTreeReaderValue<int> c10(*muReader, "fID4vz");
+    RootTableBuilderHelpers::convertTTree(*muBuilder, *muReader,
+                                          c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10);
+  }
+
+  if (auto* vzBuilder = builderFor(header::DataDescription{ "VZERO" })) {
+    std::unique_ptr<TTreeReader> vzReader = std::make_unique<TTreeReader>("O2vz", infile);
+    TTreeReaderArray<float> c0(*vzReader, "fAdcVZ"); // FIXME: we do not support arrays for now
+    TTreeReaderArray<float> c1(*vzReader, "fTimeVZ");
+    TTreeReaderArray<float> c2(*vzReader, "fWidthVZ");
+    RootTableBuilderHelpers::convertTTree(*vzBuilder, *vzReader,
+                                          c0, c1, c2);
+  }
+
+  // Candidates as described by Gianmichele example
+  if (auto* dzBuilder = builderFor(header::DataDescription{ "DZEROFLAGGED" })) {
+    std::unique_ptr<TTreeReader> dzReader = std::make_unique<TTreeReader>("fTreeDzeroFlagged", infile);
+
+    TTreeReaderValue<float> c0(*dzReader, "d_len_ML");
+    TTreeReaderValue<int> c1(*dzReader, "cand_type_ML");
+    TTreeReaderValue<float> c2(*dzReader, "cos_p_ML");
+    TTreeReaderValue<float> c3(*dzReader, "cos_p_xy_ML");
+    TTreeReaderValue<float> c4(*dzReader, "d_len_xy_ML");
+    TTreeReaderValue<float> c5(*dzReader, "eta_prong0_ML");
+    TTreeReaderValue<float> c6(*dzReader, "eta_prong1_ML");
+    TTreeReaderValue<float> c7(*dzReader, "imp_par_prong0_ML");
+    TTreeReaderValue<float> c8(*dzReader, "imp_par_prong1_ML");
+    TTreeReaderValue<float> c9(*dzReader, "imp_par_xy_ML");
+    TTreeReaderValue<float> c10(*dzReader, "inv_mass_ML");
+    TTreeReaderValue<float> c11(*dzReader, "max_norm_d0d0exp_ML");
+    TTreeReaderValue<float> c12(*dzReader, "norm_dl_xy_ML");
+    TTreeReaderValue<float> c13(*dzReader, "pt_cand_ML");
+    TTreeReaderValue<float> c14(*dzReader, "pt_prong0_ML");
+    TTreeReaderValue<float> c15(*dzReader, "pt_prong1_ML");
+    TTreeReaderValue<float> c16(*dzReader, "y_cand_ML");
+    TTreeReaderValue<float> c17(*dzReader, "phi_cand_ML");
+    TTreeReaderValue<float> c18(*dzReader, "eta_cand_ML");
+    TTreeReaderValue<int> c19(*dzReader, "cand_evtID_ML");
+    TTreeReaderValue<int> c20(*dzReader, "cand_fileID_ML");
+
+    RootTableBuilderHelpers::convertTTree(*dzBuilder, *dzReader,
+                                          c0, c1, c2, c3, c4, c5, c6, c7,
+                                          c8, c9, c10, c11, c12, c13, c14,
+                                          c15, c16, c17, c18, c19, c20);
+  }
+}
+
+/// Publish the tables of an AOD converted by AODReaderHelpers::convertToArrow.
+/// The files are memory mapped and every invocation publishes the next record
+/// batch of each of the requested tables, so the data is only copied into the
+/// messages.
+AlgorithmSpec::ProcessCallback arrowFileReader(std::string const& path, std::vector<header::DataDescription> const& tables)
+{
+  using BatchReader = std::shared_ptr<arrow::ipc::RecordBatchFileReader>;
+  std::vector<std::pair<header::DataDescription, BatchReader>> readers;
+  for (auto& table : tables) {
+    auto filename = path + "/" + table.as<std::string>() + ".arrow";
+    std::shared_ptr<arrow::io::MemoryMappedFile> file;
+    BatchReader reader;
+    if (arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ, &file).ok() == false ||
+        arrow::ipc::RecordBatchFileReader::Open(file, &reader).ok() == false) {
+      throw std::runtime_error("Unable to open converted AOD table: " + filename);
+    }
+    readers.emplace_back(table, reader);
+  }
+
+  auto counter = std::make_shared<int>(0);
+  return adaptStateless([readers, counter](DataAllocator& outputs, ControlService& control) {
+    bool published = false;
+    for (auto& [description, reader] : readers) {
+      if (*counter >= reader->num_record_batches()) {
+        continue;
+      }
+      std::shared_ptr<arrow::RecordBatch> batch;
+      if (reader->ReadRecordBatch(*counter, &batch).ok() == false) {
+        throw std::runtime_error(std::string("Error while reading record batch of ") + description.as<std::string>());
+      }
+      auto writer = outputs.make<arrow::ipc::RecordBatchWriter>(Output{ "AOD", description }, batch->schema());
+      if (writer->WriteRecordBatch(*batch).ok() == false) {
+        throw std::runtime_error("Error while writing record");
+      }
+      published = true;
+    }
+    if (published == false) {
+      LOG(info) << "All input batches processed";
+      control.readyToQuit(false);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+      return;
+    }
+    *counter += 1;
+  });
+}
+
 } // anonymous namespace
 
 AlgorithmSpec AODReaderHelpers::run2ESDConverterCallback()
@@ -224,6 +423,27 @@ AlgorithmSpec AODReaderHelpers::rootFileReaderCallback()
     std::vector<std::string> filenames;
     auto filename = options.get<std::string>("aod-file");
 
+    std::vector<header::DataDescription> requested;
+    // FIXME: bruteforce but effective.
+    for (auto& route : spec.outputs) {
+      if (route.matcher.origin != header::DataOrigin{ "AOD" }) {
+        continue;
+      }
+      auto description = route.matcher.description;
+      auto& known = knownAODTables();
+      if (std::find(known.begin(), known.end(), description) == known.end()) {
+        throw std::runtime_error(std::string("Unknown AOD type: ") + route.matcher.description.str);
+      }
+      requested.push_back(description);
+    }
+
+    // An AOD converted to Arrow is read as it is
+    std::string arrowSuffix = ".arrow";
+    if (filename.size() > arrowSuffix.size() &&
+        filename.compare(filename.size() - arrowSuffix.size(), arrowSuffix.size(), arrowSuffix) == 0) {
+      return arrowFileReader(filename, requested);
+    }
+
     // If option starts with a @, we consider the file as text which contains a list of
     // files.
     if (filename.size() && filename[0] == '@') {
@@ -240,47 +460,8 @@ AlgorithmSpec AODReaderHelpers::rootFileReaderCallback()
       filenames.push_back(filename);
     }
 
-    bool readTracks = false;
-    bool readTracksCov = false;
-    bool readTracksExtra = false;
-    bool readCalo = false;
-    bool readMuon = false;
-    bool readDZeroFlagged = false;
-    bool readVZ = false;
-
-    // FIXME: bruteforce but effective.
-    for (auto& route : spec.outputs) {
-      if (route.matcher.origin != header::DataOrigin{ "AOD" }) {
-        continue;
-      }
-      auto description = route.matcher.description;
-      if (description == header::DataDescription{ "TRACKPAR" }) {
-        readTracks = true;
-      } else if (description == header::DataDescription{ "TRACKPARCOV" }) {
-        readTracksCov = true;
-      } else if (description == header::DataDescription{ "TRACKEXTRA" }) {
-        readTracksExtra = true;
-      } else if (description == header::DataDescription{ "CALO" }) {
-        readCalo = true;
-      } else if (description == header::DataDescription{ "MUON" }) {
-        readMuon = true;
-      } else if (description == header::DataDescription{ "DZEROFLAGGED" }) {
-        readDZeroFlagged = true;
-      } else if (description == header::DataDescription{ "VZERO" }) {
-        readVZ = true;
-      } else {
-        throw std::runtime_error(std::string("Unknown AOD type: ") + route.matcher.description.str);
-      }
-    }
-
     auto counter = std::make_shared<int>(0);
-    return adaptStateless([readTracks,
-                           readTracksCov,
-                           readTracksExtra,
-                           readCalo,
-                           readMuon,
-                           readDZeroFlagged,
-                           readVZ,
+    return adaptStateless([requested,
                            counter,
                            filenames](DataAllocator& outputs, ControlService& control) {
       if (*counter >= filenames.size()) {
@@ -297,138 +478,69 @@ AlgorithmSpec AODReaderHelpers::rootFileReaderCallback()
         return;
       }
 
-      /// FIXME: Substitute here the actual data you want to convert for the AODReader
-      if (readTracks) {
-        std::unique_ptr<TTreeReader> reader = std::make_unique<TTreeReader>("O2tracks", infile.get());
-        auto& trackParBuilder = outputs.make<TableBuilder>(Output{ "AOD", "TRACKPAR" });
-        TTreeReaderValue<int> c0(*reader, "fID4Tracks");
-        TTreeReaderValue<float> c1(*reader, "fX");
-        TTreeReaderValue<float> c2(*reader, "fAlpha");
-        TTreeReaderValue<float> c3(*reader, "fY");
-        TTreeReaderValue<float> c4(*reader, "fZ");
-        TTreeReaderValue<float> c5(*reader, "fSnp");
-        TTreeReaderValue<float> c6(*reader, "fTgl");
-        TTreeReaderValue<float> c7(*reader, "fSigned1Pt");
-        RootTableBuilderHelpers::convertTTree(trackParBuilder, *reader,
-                                              c0, c1, c2, c3, c4, c5, c6, c7);
-      }
+      convertRootTables(infile.get(), [&requested, &outputs](header::DataDescription const& description) -> TableBuilder* {
+        if (std::find(requested.begin(), requested.end(), description) == requested.end()) {
+          return nullptr;
+        }
+        return &outputs.make<TableBuilder>(Output{ "AOD", description });
+      });
+    });
+  }) };
 
-      if (readTracksCov) {
-        std::unique_ptr<TTreeReader> covReader = std::make_unique<TTreeReader>("O2tracks", infile.get());
-        TTreeReaderValue<float> c0(*covReader, "fCYY");
-        TTreeReaderValue<float> c1(*covReader, "fCZY");
-        TTreeReaderValue<float> c2(*covReader, "fCZZ");
-        TTreeReaderValue<float> c3(*covReader, "fCSnpY");
-        TTreeReaderValue<float> c4(*covReader, "fCSnpZ");
-        TTreeReaderValue<float> c5(*covReader, "fCSnpSnp");
-        TTreeReaderValue<float> c6(*covReader, "fCTglSnp");
-        TTreeReaderValue<float> c7(*covReader, "fCTglTgl");
-        TTreeReaderValue<float> c8(*covReader, "fC1PtY");
-        TTreeReaderValue<float> c9(*covReader, "fC1PtZ");
-        TTreeReaderValue<float> c10(*covReader, "fC1PtSnp");
-        TTreeReaderValue<float> c11(*covReader, "fC1PtTgl");
-        TTreeReaderValue<float> c12(*covReader, "fC1Pt21Pt2");
-        auto& trackParCovBuilder = outputs.make<TableBuilder>(Output{ "AOD", "TRACKPARCOV" });
-        RootTableBuilderHelpers::convertTTree(trackParCovBuilder, *covReader,
-                                              c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, c11, c12);
-      }
+  return callback;
+}
 
-      if (readTracksExtra) {
-        std::unique_ptr<TTreeReader> extraReader = std::make_unique<TTreeReader>("O2tracks", infile.get());
-        TTreeReaderValue<float> c0(*extraReader, "fTPCinnerP");
-        TTreeReaderValue<uint64_t> c1(*extraReader, "fFlags");
-        TTreeReaderValue<unsigned char> c2(*extraReader, "fITSClusterMap");
-        TTreeReaderValue<unsigned short> c3(*extraReader, "fTPCncls");
-        TTreeReaderValue<unsigned char> c4(*extraReader, "fTRDntracklets");
-        TTreeReaderValue<float> c5(*extraReader, "fITSchi2Ncl");
-        TTreeReaderValue<float> c6(*extraReader, "fTPCchi2Ncl");
-        TTreeReaderValue<float> c7(*extraReader, "fTRDchi2");
-        TTreeReaderValue<float> c8(*extraReader, "fTOFchi2");
-        TTreeReaderValue<float> c9(*extraReader, "fTPCsignal");
-        TTreeReaderValue<float> c10(*extraReader, "fTRDsignal");
-        TTreeReaderValue<float> c11(*extraReader, "fTOFsignal");
-        TTreeReaderValue<float> c12(*extraReader, "fLength");
-        auto& extraBuilder = outputs.make<TableBuilder>(Output{ "AOD", "TRACKEXTRA" });
-        RootTableBuilderHelpers::convertTTree(extraBuilder, *extraReader,
-                                              c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, c11);
-      }
+void AODReaderHelpers::convertToArrow(std::vector<std::string> const& inputFiles, std::string const& outputPath)
+{
+  if (mkdir(outputPath.c_str(), 0755) != 0 && errno != EEXIST) {
+    throw std::runtime_error("Unable to create " + outputPath + ": " + strerror(errno));
+  }
 
-      if (readCalo) {
-        std::unique_ptr<TTreeReader> extraReader = std::make_unique<TTreeReader>("O2calo", infile.get());
-        TTreeReaderValue<int> c0(*extraReader, "fID4Calo");
-        TTreeReaderValue<short> c1(*extraReader, "fCellNumber");
-        TTreeReaderValue<float> c2(*extraReader, "fAmplitude");
-        TTreeReaderValue<float> c3(*extraReader, "fTime");
-        TTreeReaderValue<int8_t> c4(*extraReader, "fType");
-        auto& extraBuilder = outputs.make<TableBuilder>(Output{ "AOD", "CALO" });
-        RootTableBuilderHelpers::convertTTree(extraBuilder, *extraReader,
-                                              c0, c1, c2, c3, c4);
-      }
+  struct TableFile {
+    std::shared_ptr<arrow::io::FileOutputStream> sink;
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  };
+  std::map<std::string, TableFile> files;
+  for (auto& inputFile : inputFiles) {
+    auto infile = std::make_unique<TFile>(inputFile.c_str());
+    if (infile->IsOpen() == false) {
+      throw std::runtime_error("File not found: " + inputFile);
+    }
+    std::map<std::string, std::unique_ptr<TableBuilder>> builders;
+    convertRootTables(infile.get(), [&builders](header::DataDescription const& description) {
+      auto& builder = builders[description.as<std::string>()];
+      builder = std::make_unique<TableBuilder>();
+      return builder.get();
+    });
 
-      if (readMuon) {
-        std::unique_ptr<TTreeReader> muReader = std::make_unique<TTreeReader>("O2mu", infile.get());
-        TTreeReaderValue<int> c0(*muReader, "fID4mu");
-        TTreeReaderValue<float> c1(*muReader, "fInverseBendingMomentum");
-        TTreeReaderValue<float> c2(*muReader, "fThetaX");
-        TTreeReaderValue<float> c3(*muReader, "fThetaY");
-        TTreeReaderValue<float> c4(*muReader, "fZmu");
-        TTreeReaderValue<float> c5(*muReader, "fBendingCoor");
-        TTreeReaderValue<float> c6(*muReader, "fNonBendingCoor");
-        TTreeReaderArray<float> c7(*muReader, "fCovariances");
-        TTreeReaderValue<float> c8(*muReader, "fChi2");
-        TTreeReaderValue<float> c9(*muReader, "fChi2MatchTrigger");
-        TTreeReaderValue<int> c10(*muReader, "fID4vz");
-        auto& muBuilder = outputs.make<TableBuilder>(Output{ "AOD", "MUON" });
-        RootTableBuilderHelpers::convertTTree(muBuilder, *muReader,
-                                              c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10);
+    // Every input file becomes one record batch of each table
+    for (auto& [name, builder] : builders) {
+      auto table = builder->finalize();
+      std::vector<std::shared_ptr<arrow::Array>> columns;
+      for (int ci = 0; ci < table->num_columns(); ++ci) {
+        columns.push_back(table->column(ci)->data()->chunk(0));
       }
-
-      if (readVZ) {
-        std::unique_ptr<TTreeReader> vzReader = std::make_unique<TTreeReader>("O2vz", infile.get());
-        TTreeReaderArray<float> c0(*vzReader, "fAdcVZ"); // FIXME: we do not support arrays for now
-        TTreeReaderArray<float> c1(*vzReader, "fTimeVZ");
-        TTreeReaderArray<float> c2(*vzReader, "fWidthVZ");
-        auto& vzBuilder = outputs.make<TableBuilder>(Output{ "AOD", "VZERO" });
-        RootTableBuilderHelpers::convertTTree(vzBuilder, *vzReader,
-                                              c0, c1, c2);
+      auto batch = arrow::RecordBatch::Make(table->schema(), table->num_rows(), columns);
+
+      auto& file = files[name];
+      if (file.writer == nullptr) {
+        auto filename = outputPath + "/" + name + ".arrow";
+        if (arrow::io::FileOutputStream::Open(filename, &file.sink).ok() == false ||
+            arrow::ipc::RecordBatchFileWriter::Open(file.sink.get(), batch->schema(), &file.writer).ok() == false) {
+          throw std::runtime_error("Unable to create " + filename);
+        }
       }
-
-      // Candidates as described by Gianmichele example
-      if (readDZeroFlagged) {
-        std::unique_ptr<TTreeReader> dzReader = std::make_unique<TTreeReader>("fTreeDzeroFlagged", infile.get());
-
-        TTreeReaderValue<float> c0(*dzReader, "d_len_ML");
-        TTreeReaderValue<int> c1(*dzReader, "cand_type_ML");
-        TTreeReaderValue<float> c2(*dzReader, "cos_p_ML");
-        TTreeReaderValue<float> c3(*dzReader, "cos_p_xy_ML");
-        TTreeReaderValue<float> c4(*dzReader, "d_len_xy_ML");
-        TTreeReaderValue<float> c5(*dzReader, "eta_prong0_ML");
-        TTreeReaderValue<float> c6(*dzReader, "eta_prong1_ML");
-        TTreeReaderValue<float> c7(*dzReader, "imp_par_prong0_ML");
-        TTreeReaderValue<float> c8(*dzReader, "imp_par_prong1_ML");
-        TTreeReaderValue<float> c9(*dzReader, "imp_par_xy_ML");
-        TTreeReaderValue<float> c10(*dzReader, "inv_mass_ML");
-        TTreeReaderValue<float> c11(*dzReader, "max_norm_d0d0exp_ML");
-        TTreeReaderValue<float> c12(*dzReader, "norm_dl_xy_ML");
-        TTreeReaderValue<float> c13(*dzReader, "pt_cand_ML");
-        TTreeReaderValue<float> c14(*dzReader, "pt_prong0_ML");
-        TTreeReaderValue<float> c15(*dzReader, "pt_prong1_ML");
-        TTreeReaderValue<float> c16(*dzReader, "y_cand_ML");
-        TTreeReaderValue<float> c17(*dzReader, "phi_cand_ML");
-        TTreeReaderValue<float> c18(*dzReader, "eta_cand_ML");
-        TTreeReaderValue<int> c19(*dzReader, "cand_evtID_ML");
-        TTreeReaderValue<int> c20(*dzReader, "cand_fileID_ML");
-
-        auto& dzBuilder = outputs.make<TableBuilder>(Output{ "AOD", "DZEROFLAGGED" });
-        RootTableBuilderHelpers::convertTTree(dzBuilder, *dzReader,
-                                              c0, c1, c2, c3, c4, c5, c6, c7,
-                                              c8, c9, c10, c11, c12, c13, c14,
-                                              c15, c16, c17, c18, c19, c20);
+      if (file.writer->WriteRecordBatch(*batch).ok() == false) {
+        throw std::runtime_error("Error while writing table " + name + " of " + inputFile);
       }
-    });
-  }) };
-
-  return callback;
+    }
+    LOG(INFO) << "Converted " << inputFile;
+  }
+  for (auto& [name, file] : files) {
+    if (file.writer->Close().ok() == false || file.sink->Close().ok() == false) {
+      throw std::runtime_error("Error while closing table " + name);
+    }
+  }
 }
 
 } // namespace o2::framework::readers
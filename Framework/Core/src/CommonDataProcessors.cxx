@@ -10,6 +10,7 @@
 #include "Framework/CommonDataProcessors.h"
 
 #include "Framework/AlgorithmSpec.h"
+#include "Framework/ControlService.h"
 #include "Framework/DataProcessingHeader.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/DataDescriptorMatcher.h"
@@ -19,16 +20,30 @@
 #include "Framework/InitContext.h"
 #include "Framework/InputSpec.h"
 #include "Framework/OutputSpec.h"
+#include "Framework/RawDeviceService.h"
+#include "Framework/TimesliceRecord.h"
 #include "Framework/Variant.h"
+#include "Headers/DataHeader.h"
 
+#include <Monitoring/Monitoring.h>
+#include <FairMQDevice.h>
+
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <thread>
 
 using namespace o2::framework::data_matcher;
+using Monitoring = o2::monitoring::Monitoring;
+using Metric = o2::monitoring::Metric;
+using Key = o2::monitoring::tags::Key;
+using Value = o2::monitoring::tags::Value;
 
 namespace o2
 {
@@ -121,5 +136,161 @@ DataProcessorSpec CommonDataProcessors::getDummySink(std::vector<InputSpec> cons
   };
 }
 
+namespace
+{
+/// the size of the header stack starting at @a header
+size_t headerStackSize(char const* header)
+{
+  size_t size = 0;
+  for (auto current = header::BaseHeader::get(reinterpret_cast<o2::byte const*>(header)); current; current = current->next()) {
+    size += current->size();
+  }
+  return size;
+}
+} // namespace
+
+DataProcessorSpec CommonDataProcessors::getTimesliceRecorder(std::vector<InputSpec> const& inputs)
+{
+  auto recorderFunction = [](InitContext& ic) -> std::function<void(ProcessingContext&)> {
+    auto filename = ic.options().get<std::string>("record-file");
+    size_t maxTimeslices = std::max(ic.options().get<int>("record-timeslices"), 0);
+    auto writer = std::make_shared<TimesliceRecordWriter>(filename);
+
+    return [writer, filename, maxTimeslices](ProcessingContext& pc) {
+      if (maxTimeslices > 0 && writer->timeslices() >= maxTimeslices) {
+        return;
+      }
+      std::vector<DataRef> parts;
+      for (auto const& entry : pc.inputs()) {
+        if (entry.header != nullptr) {
+          parts.push_back(entry);
+        }
+      }
+      writer->beginTimeslice(parts.size());
+      for (auto const& part : parts) {
+        writer->addPart(part.header, headerStackSize(part.header), part.payload, DataRefUtils::getPayloadSize(part));
+      }
+      if (writer->timeslices() == maxTimeslices) {
+        LOG(INFO) << "recorded " << maxTimeslices << " timeslices to " << filename;
+      }
+    };
+  };
+
+  return DataProcessorSpec{
+    "dpl-timeslice-recorder",
+    inputs,
+    Outputs{},
+    AlgorithmSpec(recorderFunction),
+    { { "record-file", VariantType::String, "dpl-record.bin", { "Name of the timeslice record" } },
+      { "record-timeslices", VariantType::Int, 10, { "Number of timeslices to record, 0 for all of them" } } }
+  };
+}
+
+DataProcessorSpec CommonDataProcessors::getTimesliceReplayer(std::vector<OutputSpec> const& outputs)
+{
+  struct ReplayState {
+    size_t next = 0;
+    int loop = 0;
+    std::chrono::steady_clock::time_point loopStart;
+    std::vector<double> loopTimes;
+  };
+
+  auto replayerFunction = [](InitContext& ic) -> std::function<void(ProcessingContext&)> {
+    auto filename = ic.options().get<std::string>("replay-file");
+    auto loops = ic.options().get<int>("replay-loops");
+    auto timeslices = std::make_shared<std::vector<RecordedTimeslice>>(TimesliceRecord::read(filename));
+    if (timeslices->empty()) {
+      throw std::runtime_error("no timeslice to replay in " + filename);
+    }
+    LOG(INFO) << "replaying " << timeslices->size() << " timeslices of " << filename;
+
+    return [timeslices, loops, state = std::make_shared<ReplayState>()](ProcessingContext& pc) {
+      if (loops > 0 && state->loop >= loops) {
+        // waiting for the device to process the last timeslices
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return;
+      }
+      if (state->next == 0) {
+        state->loopStart = std::chrono::steady_clock::now();
+      }
+      auto device = pc.services().get<RawDeviceService>().device();
+      for (auto const& part : (*timeslices)[state->next]) {
+        auto dh = header::get<header::DataHeader*>(part.header.data());
+        if (dh == nullptr) {
+          continue;
+        }
+        FairMQMessagePtr payload(device->NewMessage(part.payload.size()));
+        std::memcpy(payload->GetData(), part.payload.data(), part.payload.size());
+        pc.outputs().adoptMessage(Output{ dh->dataOrigin, dh->dataDescription, dh->subSpecification },
+                                  std::move(payload), dh->payloadSerializationMethod);
+      }
+      if (++state->next < timeslices->size()) {
+        return;
+      }
+
+      // The sending is asynchronous, so this is the time the device needs for
+      // a loop only once the queues are full, i.e. after the first loops or
+      // with the flow control of the sources.
+      std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - state->loopStart;
+      state->loopTimes.push_back(elapsed.count());
+      LOG(INFO) << "replay loop " << state->loop << ": " << elapsed.count() << " ms, "
+                << timeslices->size() * 1000. / elapsed.count() << " timeslices/s";
+      pc.services().get<Monitoring>().send(Metric{ elapsed.count(), "replay_loop_time_ms" }.addTag(Key::Subsystem, Value::DPL));
+      state->next = 0;
+      state->loop++;
+      if (loops > 0 && state->loop == loops) {
+        auto const& times = state->loopTimes;
+        auto mean = std::accumulate(times.begin(), times.end(), 0.) / times.size();
+        LOG(INFO) << "replayed " << loops << " loops of " << timeslices->size() << " timeslices, loop time min "
+                  << *std::min_element(times.begin(), times.end()) << " ms, mean " << mean << " ms, max "
+                  << *std::max_element(times.begin(), times.end()) << " ms";
+        pc.services().get<ControlService>().readyToQuit(true);
+      }
+    };
+  };
+
+  return DataProcessorSpec{
+    "dpl-timeslice-replayer",
+    Inputs{},
+    outputs,
+    AlgorithmSpec(replayerFunction),
+    { { "replay-file", VariantType::String, "dpl-record.bin", { "Name of the timeslice record" } },
+      { "replay-loops", VariantType::Int, 10, { "Number of loops over the recorded timeslices, 0 to loop forever" } } }
+  };
+}
+
+WorkflowSpec CommonDataProcessors::getReplayWorkflow(DataProcessorSpec const& device, std::string const& filename)
+{
+  // The outputs are the recorded parts which are Timeframe inputs of the device
+  std::vector<OutputSpec> outputs;
+  for (auto const& timeslice : TimesliceRecord::read(filename, false)) {
+    for (auto const& part : timeslice) {
+      auto dh = header::get<header::DataHeader*>(part.header.data());
+      if (dh == nullptr) {
+        continue;
+      }
+      OutputSpec output{ dh->dataOrigin, dh->dataDescription, dh->subSpecification };
+      auto isInput = [&output](InputSpec const& input) {
+        return input.lifetime == Lifetime::Timeframe && DataSpecUtils::match(input, output);
+      };
+      if (std::find(outputs.begin(), outputs.end(), output) == outputs.end() &&
+          std::any_of(device.inputs.begin(), device.inputs.end(), isInput)) {
+        outputs.push_back(output);
+      }
+    }
+  }
+  if (outputs.empty()) {
+    throw std::runtime_error("no input of " + device.name + " in " + filename);
+  }
+
+  auto replayer = getTimesliceReplayer(outputs);
+  for (auto& option : replayer.options) {
+    if (option.name == "replay-file") {
+      option.defaultValue = Variant{ filename.c_str() };
+    }
+  }
+  return WorkflowSpec{ replayer, device };
+}
+
 } // namespace framework
 } // namespace o2
@@ -0,0 +1,98 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/CompiledInputMatcher.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Headers/DataHeader.h"
+
+#include <stdexcept>
+
+namespace o2
+{
+namespace framework
+{
+
+using namespace data_matcher;
+
+CompiledInputMatcher::CompiledInputMatcher(std::vector<InputSpec> const& specs)
+{
+  for (size_t si = 0; si < specs.size(); ++si) {
+    auto& spec = specs[si];
+    if (auto concrete = std::get_if<ConcreteDataMatcher>(&spec.matcher)) {
+      Key key{ concrete->origin.itg[0], concrete->subSpec, { concrete->description.itg[0], concrete->description.itg[1] } };
+      // Only the first of the inputs with the same description can match
+      mConcreteInputs.emplace(key, si);
+    } else if (auto matcher = std::get_if<DataDescriptorMatcher>(&spec.matcher)) {
+      mGenericMatchers.emplace_back(si, *matcher);
+    } else {
+      throw std::runtime_error("Unsupported InputSpec type");
+    }
+  }
+}
+
+CompiledInputMatcher::Lookup CompiledInputMatcher::lookup(char const* data) const
+{
+  Lookup result;
+  if (mConcreteInputs.empty()) {
+    return result;
+  }
+  auto dh = o2::header::get<header::DataHeader*>(data);
+  if (dh == nullptr) {
+    throw std::runtime_error("Cannot find DataHeader");
+  }
+  Key key{ dh->dataOrigin.itg[0], dh->subSpecification, { dh->dataDescription.itg[0], dh->dataDescription.itg[1] } };
+  auto it = mConcreteInputs.find(key);
+  if (it == mConcreteInputs.end()) {
+    return result;
+  }
+  auto dph = o2::header::get<DataProcessingHeader*>(data);
+  if (dph == nullptr) {
+    throw std::runtime_error("Cannot find DataProcessingHeader");
+  }
+  result.concreteInput = it->second;
+  result.startTime = dph->startTime;
+  return result;
+}
+
+int CompiledInputMatcher::match(Lookup const& lookup, char const* data, VariableContext& context) const
+{
+  auto generic = mGenericMatchers.begin();
+  auto matchGeneric = [&generic, end = mGenericMatchers.end(), data, &context](int last) -> int {
+    for (; generic != end && (last == INVALID_INPUT || generic->first < last); ++generic) {
+      if (generic->second.match(data, context)) {
+        context.commit();
+        return generic->first;
+      }
+      context.discard();
+    }
+    return INVALID_INPUT;
+  };
+
+  // The generic inputs before the concrete one have precedence
+  auto input = matchGeneric(lookup.concreteInput);
+  if (input != INVALID_INPUT || lookup.concreteInput == INVALID_INPUT) {
+    return input;
+  }
+  // A concrete input binds the start time to the first variable, like
+  // StartTimeValueMatcher{ ContextRef{ 0 } }
+  if (auto value = std::get_if<uint64_t>(&context.get(0))) {
+    if (*value == lookup.startTime) {
+      return lookup.concreteInput;
+    }
+    // the inputs with the same description can not match either, only the
+    // generic ones following it
+    return matchGeneric(INVALID_INPUT);
+  }
+  context.put({ 0, lookup.startTime });
+  context.commit();
+  return lookup.concreteInput;
+}
+
+} // namespace framework
+} // namespace o2
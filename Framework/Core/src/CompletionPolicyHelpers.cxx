@@ -31,18 +31,21 @@ CompletionPolicy CompletionPolicyHelpers::defineByName(std::string const&name, C
   auto callback = [op](gsl::span<PartRef const> const &inputs) -> CompletionPolicy::CompletionOp {
     return op;
   };
+  auto countCallback = [op](size_t, size_t) -> CompletionPolicy::CompletionOp {
+    return op;
+  };
   switch (op) {
     case CompletionPolicy::CompletionOp::Consume:
-      return CompletionPolicy{"always-consume", matcher, callback };
+      return CompletionPolicy{"always-consume", matcher, callback, countCallback };
       break;
     case CompletionPolicy::CompletionOp::Process:
-      return CompletionPolicy{"always-process", matcher, callback };
+      return CompletionPolicy{"always-process", matcher, callback, countCallback };
       break;
     case CompletionPolicy::CompletionOp::Wait:
-      return CompletionPolicy{"always-wait", matcher, callback };
+      return CompletionPolicy{"always-wait", matcher, callback, countCallback };
       break;
     case CompletionPolicy::CompletionOp::Discard:
-      return CompletionPolicy{"always-discard", matcher, callback };
+      return CompletionPolicy{"always-discard", matcher, callback, countCallback };
       break;
   }
   O2_BUILTIN_UNREACHABLE();
@@ -58,7 +61,10 @@ CompletionPolicy CompletionPolicyHelpers::consumeWhenAll() {
     }
     return CompletionPolicy::CompletionOp::Consume;
   };
-  return CompletionPolicy{"consume-all", matcher, callback };
+  auto countCallback = [](size_t present, size_t total) -> CompletionPolicy::CompletionOp {
+    return present == total ? CompletionPolicy::CompletionOp::Consume : CompletionPolicy::CompletionOp::Wait;
+  };
+  return CompletionPolicy{"consume-all", matcher, callback, countCallback };
 }
 
 CompletionPolicy CompletionPolicyHelpers::consumeWhenAny() {
@@ -71,7 +77,10 @@ CompletionPolicy CompletionPolicyHelpers::consumeWhenAny() {
     }
     return CompletionPolicy::CompletionOp::Wait;
   };
-  return CompletionPolicy{"consume-any", matcher, callback };
+  auto countCallback = [](size_t present, size_t) -> CompletionPolicy::CompletionOp {
+    return present != 0 ? CompletionPolicy::CompletionOp::Consume : CompletionPolicy::CompletionOp::Wait;
+  };
+  return CompletionPolicy{"consume-any", matcher, callback, countCallback };
 }
 
 CompletionPolicy CompletionPolicyHelpers::processWhenAny() {
@@ -90,7 +99,15 @@ CompletionPolicy CompletionPolicyHelpers::processWhenAny() {
     }
     return CompletionPolicy::CompletionOp::Process;
   };
-  return CompletionPolicy{"process-any", matcher, callback };
+  auto countCallback = [](size_t present, size_t total) -> CompletionPolicy::CompletionOp {
+    if (present == total) {
+      return CompletionPolicy::CompletionOp::Consume;
+    } else if (present == 0) {
+      return CompletionPolicy::CompletionOp::Wait;
+    }
+    return CompletionPolicy::CompletionOp::Process;
+  };
+  return CompletionPolicy{"process-any", matcher, callback, countCallback };
 }
 
 } // namespace framework
@@ -0,0 +1,255 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "CpuPlacement.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace o2
+{
+namespace framework
+{
+
+namespace
+{
+bool isAllowed(int core)
+{
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return true;
+  }
+  return core < CPU_SETSIZE && CPU_ISSET(core, &allowed);
+#else
+  return true;
+#endif
+}
+
+std::string readLine(std::string const& path)
+{
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line);
+  return line;
+}
+} // namespace
+
+std::vector<int> CpuTopology::parseCpuList(std::string const& list)
+{
+  std::vector<int> result;
+  std::istringstream in(list);
+  std::string range;
+  while (std::getline(in, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    auto dash = range.find('-');
+    try {
+      int first = std::stoi(range.substr(0, dash));
+      int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int core = first; core <= last; ++core) {
+        result.push_back(core);
+      }
+    } catch (std::logic_error const&) {
+      throw std::runtime_error("Invalid cpu list: " + list);
+    }
+  }
+  return result;
+}
+
+CpuTopology CpuTopology::uniform(size_t nCores, size_t nNodes)
+{
+  CpuTopology result;
+  nNodes = std::max(nNodes, (size_t)1);
+  size_t perNode = std::max((nCores + nNodes - 1) / nNodes, (size_t)1);
+  for (size_t ci = 0; ci < nCores; ++ci) {
+    result.cores.push_back(CpuCore{ static_cast<int>(ci), static_cast<int>(ci / perNode) });
+  }
+  return result;
+}
+
+CpuTopology CpuTopology::fromSysfs(std::string const& nodesPath)
+{
+  CpuTopology result;
+  auto online = readLine(nodesPath + "/online");
+  if (online.empty() == false) {
+    for (auto node : parseCpuList(online)) {
+      auto cpus = readLine(nodesPath + "/node" + std::to_string(node) + "/cpulist");
+      for (auto core : parseCpuList(cpus)) {
+        if (isAllowed(core)) {
+          result.cores.push_back(CpuCore{ core, node });
+        }
+      }
+    }
+  }
+  if (result.cores.empty()) {
+    for (auto& core : uniform(std::thread::hardware_concurrency()).cores) {
+      if (isAllowed(core.id)) {
+        result.cores.push_back(core);
+      }
+    }
+  }
+  return result;
+}
+
+size_t CpuTopology::numaNodes() const
+{
+  int maxNode = -1;
+  for (auto& core : cores) {
+    maxNode = std::max(maxNode, core.numaNode);
+  }
+  return maxNode + 1;
+}
+
+std::istream& operator>>(std::istream& in, enum CpuPlacementPolicy& policy)
+{
+  std::string token;
+  in >> token;
+  if (token == "none") {
+    policy = CpuPlacementPolicy::NONE;
+  } else if (token == "cores") {
+    policy = CpuPlacementPolicy::CORES;
+  } else if (token == "numa") {
+    policy = CpuPlacementPolicy::NUMA;
+  } else {
+    in.setstate(std::ios_base::failbit);
+  }
+  return in;
+}
+
+std::ostream& operator<<(std::ostream& out, const enum CpuPlacementPolicy& policy)
+{
+  if (policy == CpuPlacementPolicy::NONE) {
+    out << "none";
+  } else if (policy == CpuPlacementPolicy::CORES) {
+    out << "cores";
+  } else if (policy == CpuPlacementPolicy::NUMA) {
+    out << "numa";
+  } else {
+    out.setstate(std::ios_base::failbit);
+  }
+  return out;
+}
+
+std::vector<std::vector<int>> CpuPlacementHelpers::placeDevices(std::vector<DeviceSpec> const& devices,
+                                                                CpuTopology const& topology,
+                                                                CpuPlacementPolicy policy)
+{
+  std::vector<std::vector<int>> result(devices.size());
+  if (policy == CpuPlacementPolicy::NONE || topology.cores.empty()) {
+    return result;
+  }
+  if (policy == CpuPlacementPolicy::CORES) {
+    for (size_t di = 0; di < devices.size() && di < topology.cores.size(); ++di) {
+      result[di] = { topology.cores[di].id };
+    }
+    return result;
+  }
+
+  // The free cores of each node, in order
+  std::vector<std::vector<int>> freeCores(topology.numaNodes());
+  for (auto& core : topology.cores) {
+    freeCores[core.numaNode].push_back(core.id);
+  }
+  for (auto& cores : freeCores) {
+    std::reverse(cores.begin(), cores.end());
+  }
+  std::vector<std::vector<int>> nodeCores = freeCores;
+
+  // The channels are named after the devices they connect, so both ends
+  // have the same name.
+  std::map<std::string, int> channelNodes;
+  for (size_t di = 0; di < devices.size(); ++di) {
+    auto& device = devices[di];
+    std::vector<int> score(freeCores.size(), 0);
+    auto addScore = [&channelNodes, &score](std::string const& channel) {
+      auto it = channelNodes.find(channel);
+      if (it != channelNodes.end()) {
+        score[it->second]++;
+      }
+    };
+    for (auto& channel : device.inputChannels) {
+      addScore(channel.name);
+    }
+    for (auto& channel : device.outputChannels) {
+      addScore(channel.name);
+    }
+
+    // Prefer the nodes with free cores, then the most connected ones, then
+    // the emptiest ones.
+    int node = -1;
+    for (size_t ni = 0; ni < freeCores.size(); ++ni) {
+      if (nodeCores[ni].empty()) {
+        continue;
+      }
+      if (node == -1) {
+        node = ni;
+        continue;
+      }
+      auto key = [&freeCores, &score](size_t n) {
+        return std::make_tuple(freeCores[n].empty() == false, score[n], freeCores[n].size());
+      };
+      if (key(ni) > key(node)) {
+        node = ni;
+      }
+    }
+    if (node == -1) {
+      continue;
+    }
+    if (freeCores[node].empty() == false) {
+      result[di] = { freeCores[node].back() };
+      freeCores[node].pop_back();
+    } else {
+      result[di] = nodeCores[node];
+      std::sort(result[di].begin(), result[di].end());
+    }
+
+    for (auto& channel : device.inputChannels) {
+      channelNodes.emplace(channel.name, node);
+    }
+    for (auto& channel : device.outputChannels) {
+      channelNodes.emplace(channel.name, node);
+    }
+  }
+  return result;
+}
+
+bool CpuPlacementHelpers::pinCurrentProcess(std::vector<int> const& cores)
+{
+  if (cores.empty()) {
+    return true;
+  }
+#ifdef __linux__
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (auto core : cores) {
+    if (core >= 0 && core < CPU_SETSIZE) {
+      CPU_SET(core, &cpuset);
+    }
+  }
+  return sched_setaffinity(0, sizeof(cpuset), &cpuset) == 0;
+#else
+  return false;
+#endif
+}
+
+} // namespace framework
+} // namespace o2
@@ -0,0 +1,81 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef FRAMEWORK_CPUPLACEMENT_H
+#define FRAMEWORK_CPUPLACEMENT_H
+
+#include "Framework/DeviceSpec.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace framework
+{
+
+/// A core of the host and the NUMA node it belongs to
+struct CpuCore {
+  int id;
+  int numaNode;
+};
+
+/// The cores the driver can place its devices on
+struct CpuTopology {
+  std::vector<CpuCore> cores;
+
+  /// The cores of the NUMA nodes as found in @a nodesPath, restricted to the
+  /// ones the current process is allowed to run on. If there is no NUMA
+  /// information, all the cores are considered to be on node 0.
+  static CpuTopology fromSysfs(std::string const& nodesPath = "/sys/devices/system/node");
+  /// @a nCores cores on @a nNodes NUMA nodes of consecutive cores each
+  static CpuTopology uniform(size_t nCores, size_t nNodes = 1);
+  /// Parse a list like "0-3,8,10-11" as used by the kernel
+  static std::vector<int> parseCpuList(std::string const& list);
+
+  /// @return the number of NUMA nodes, i.e. the highest node id plus one
+  size_t numaNodes() const;
+};
+
+/// How the devices are pinned to the cores when the driver forks them
+enum struct CpuPlacementPolicy {
+  NONE,  ///< the devices are not pinned
+  CORES, ///< every device gets a core of its own, while there are free cores
+  NUMA   ///< like CORES, keeping the devices connected by a channel on the same NUMA node
+};
+
+std::istream& operator>>(std::istream& in, enum CpuPlacementPolicy& policy);
+std::ostream& operator<<(std::ostream& out, const enum CpuPlacementPolicy& policy);
+
+struct CpuPlacementHelpers {
+  /// The cores each of the @a devices should be pinned to, according to
+  /// @a policy. The devices are placed in order, so that the producers are
+  /// placed before their consumers. An empty set means not to pin the device.
+  ///
+  /// With the NUMA policy a device goes on the node with the most channels
+  /// to the devices already placed, if it has free cores left, else on the
+  /// node with the most free cores, so that time pipelined lanes are spread
+  /// over distinct cores and the shared memory traffic stays local. Once all
+  /// the cores are taken, the devices are pinned to all the cores of the node
+  /// of their neighbours.
+  static std::vector<std::vector<int>> placeDevices(std::vector<DeviceSpec> const& devices,
+                                                    CpuTopology const& topology,
+                                                    CpuPlacementPolicy policy);
+
+  /// Pin the calling process to @a cores, the affinity is inherited by the
+  /// processes it execs. Does nothing if @a cores is empty.
+  /// @return false if the affinity could not be set
+  static bool pinCurrentProcess(std::vector<int> const& cores);
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // FRAMEWORK_CPUPLACEMENT_H
@@ -25,6 +25,8 @@
 
 #include <TClonesArray.h>
 
+#include <cstring>
+
 
 namespace o2
 {
@@ -44,12 +46,37 @@ DataAllocator::DataAllocator(TimingInfo* timingInfo,
 {
 }
 
+DataAllocator::HeaderTemplate& DataAllocator::getHeaderTemplate(const Output& spec)
+{
+  HeaderTemplateKey key{ spec.origin, spec.description, spec.subSpec };
+  auto cached = mHeaderTemplates.find(key);
+  if (cached != mHeaderTemplates.end()) {
+    return cached->second;
+  }
+
+  HeaderTemplate headerTemplate;
+  for (size_t ri = 0; ri < mAllowedOutputRoutes.size(); ++ri) {
+    if (DataSpecUtils::match(mAllowedOutputRoutes[ri].matcher, spec.origin, spec.description, spec.subSpec)) {
+      headerTemplate.routes.push_back(ri);
+    }
+  }
+  headerTemplate.transports.resize(headerTemplate.routes.size(), nullptr);
+  DataHeader dh;
+  dh.dataOrigin = spec.origin;
+  dh.dataDescription = spec.description;
+  dh.subSpecification = spec.subSpec;
+  o2::header::Stack stack{ dh, DataProcessingHeader{ 0, 1 } };
+  auto data = reinterpret_cast<const char*>(stack.data());
+  headerTemplate.buffer.assign(data, data + stack.size());
+  return mHeaderTemplates.emplace(key, std::move(headerTemplate)).first->second;
+}
+
 std::string
 DataAllocator::matchDataHeader(const Output& spec, size_t timeslice) {
   // FIXME: we should take timeframeId into account as well.
-  for (auto &output : mAllowedOutputRoutes) {
-    if (DataSpecUtils::match(output.matcher, spec.origin, spec.description, spec.subSpec)
-        && ((timeslice % output.maxTimeslices) == output.timeslice)) {
+  for (auto ri : getHeaderTemplate(spec).routes) {
+    auto const& output = mAllowedOutputRoutes[ri];
+    if ((timeslice % output.maxTimeslices) == output.timeslice) {
       return output.channel;
     }
   }
@@ -90,23 +117,56 @@ void DataAllocator::adoptChunk(const Output& spec, char* buffer, size_t size, fa
   context->add<MessageContext::TrivialObject>(std::move(headerMessage), channel, 0, buffer, size, freefn, hint);
 }
 
+void DataAllocator::adoptMessage(const Output& spec, FairMQMessagePtr&& payload, o2::header::SerializationMethod method)
+{
+  addPartToContext(std::move(payload), spec, method);
+}
+
 FairMQMessagePtr DataAllocator::headerMessageFromOutput(Output const& spec,                     //
                                                         std::string const& channel,             //
                                                         o2::header::SerializationMethod method, //
                                                         size_t payloadSize)                     //
 {
-  DataHeader dh;
-  dh.dataOrigin = spec.origin;
-  dh.dataDescription = spec.description;
-  dh.subSpecification = spec.subSpec;
-  dh.payloadSize = payloadSize;
-  dh.payloadSerializationMethod = method;
-
-  DataProcessingHeader dph{mTimingInfo->timeslice, 1};
   auto context = mContextRegistry->get<MessageContext>();
+  if (spec.metaHeader.size() > 0) {
+    // the stack with additional headers is built for every message
+    DataHeader dh;
+    dh.dataOrigin = spec.origin;
+    dh.dataDescription = spec.description;
+    dh.subSpecification = spec.subSpec;
+    dh.payloadSize = payloadSize;
+    dh.payloadSerializationMethod = method;
+
+    DataProcessingHeader dph{ mTimingInfo->timeslice, 1 };
+    auto channelAlloc = o2::pmr::getTransportAllocator(context->proxy().getTransport(channel, 0));
+    return o2::pmr::getMessage(o2::header::Stack{ channelAlloc, dh, dph, spec.metaHeader });
+  }
+
+  auto& headerTemplate = getHeaderTemplate(spec);
+  FairMQTransportFactory* transport = nullptr;
+  for (size_t i = 0; i < headerTemplate.routes.size(); ++i) {
+    if (mAllowedOutputRoutes[headerTemplate.routes[i]].channel == channel) {
+      if (headerTemplate.transports[i] == nullptr) {
+        headerTemplate.transports[i] = context->proxy().getTransport(channel, 0);
+      }
+      transport = headerTemplate.transports[i];
+      break;
+    }
+  }
+  if (transport == nullptr) {
+    transport = context->proxy().getTransport(channel, 0);
+  }
 
-  auto channelAlloc = o2::pmr::getTransportAllocator(context->proxy().getTransport(channel, 0));
-  return o2::pmr::getMessage(o2::header::Stack{ channelAlloc, dh, dph, spec.metaHeader });
+  auto headerMessage = transport->CreateMessage(headerTemplate.buffer.size());
+  auto data = reinterpret_cast<char*>(headerMessage->GetData());
+  std::memcpy(data, headerTemplate.buffer.data(), headerTemplate.buffer.size());
+  auto dh = reinterpret_cast<DataHeader*>(data);
+  dh->payloadSize = payloadSize;
+  dh->payloadSerializationMethod = method;
+  auto dph = reinterpret_cast<DataProcessingHeader*>(data + sizeof(DataHeader));
+  dph->startTime = mTimingInfo->timeslice;
+  dph->creation = DataProcessingHeader::getCreationTime();
+  return headerMessage;
 }
 
 void DataAllocator::addPartToContext(FairMQMessagePtr&& payloadMessage, const Output& spec,
@@ -13,12 +13,15 @@
 #include "Framework/DataProcessingHeader.h"
 #include "Framework/DataProcessor.h"
 #include "Framework/DataSpecUtils.h"
+#include "Framework/DeviceExecution.h"
 #include "Framework/FairOptionsRetriever.h"
 #include "Framework/FairMQDeviceProxy.h"
 #include "Framework/CallbackService.h"
 #include "Framework/TMessageSerializer.h"
 #include "Framework/InputRecord.h"
+#include "Framework/MemoryAccounting.h"
 #include "Framework/Signpost.h"
+#include "Framework/TimesliceTrace.h"
 
 #include "ScopedExit.h"
 
@@ -29,6 +32,13 @@
 #include <TMessage.h>
 #include <TClonesArray.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <memory>
 
@@ -41,12 +51,97 @@ using DataHeader = o2::header::DataHeader;
 
 constexpr unsigned int MONITORING_QUEUE_SIZE = 100;
 constexpr unsigned int MIN_RATE_LOGGING = 60;
+// Upper bound (ms) of the blocking wait of the event driven mode, so that
+// state transitions requested to the device are still handled promptly.
+constexpr int MAX_POLL_TIMEOUT_MS = 100;
+/// How long a source which has no credit waits before checking it again
+constexpr std::chrono::microseconds THROTTLE_SLEEP{ 100 };
+
+namespace
+{
+/// Report where the device spent the time of a traced timeslice
+void reportTrace(Monitoring& monitoring, TimesliceTrace const& trace)
+{
+  auto breakdown = TimesliceBreakdown::fromTrace(trace);
+  auto send = [&monitoring](int64_t ns, char const* name) {
+    monitoring.send(Metric{ ns * 1e-3, name }.addTag(Key::Subsystem, Value::DPL));
+  };
+  if (breakdown.transfer >= 0) {
+    send(breakdown.transfer, "timeslice_trace/transfer_us");
+  }
+  send(breakdown.inputWait, "timeslice_trace/input_wait_us");
+  send(breakdown.queue, "timeslice_trace/queue_us");
+  send(breakdown.dispatch, "timeslice_trace/dispatch_us");
+  send(breakdown.compute, "timeslice_trace/compute_us");
+  send(breakdown.send, "timeslice_trace/send_us");
+  if (breakdown.sinceOrigin >= 0) {
+    send(breakdown.sinceOrigin, "timeslice_trace/since_origin_us");
+  }
+}
+
+/// The metrics sent by sendRelayerMetrics, in the order of their handles
+enum SlowMetric : size_t {
+  MalformedInputs,
+  DroppedComputations,
+  DroppedIncomingMessages,
+  RelayedMessages,
+  ExpirationsChecked,
+  ExpirationsFired,
+  PendingInputs,
+  IncompleteInputs,
+  TotalInputs,
+  ElapsedTime,
+  ProcessedInputSize,
+  ProcessingRate,
+  MinInputLatency,
+  MaxInputLatency,
+  InputRate,
+  ConfigLookupsInProcessing,
+  FreeTimeslices,
+  InFlightTimeslices,
+  ThrottledIterations,
+  SlowMetricsCount
+};
+
+constexpr char const* slowMetricsNames[SlowMetricsCount] = {
+  "malformed_inputs",
+  "dropped_computations",
+  "dropped_incoming_messages",
+  "relayed_messages",
+  "expirations_checked",
+  "expirations_fired",
+  "inputs/relayed/pending",
+  "inputs/relayed/incomplete",
+  "inputs/relayed/total",
+  "elapsed_time_ms",
+  "processed_input_size_byte",
+  "processing_rate_mb_s",
+  "min_input_latency_ms",
+  "max_input_latency_ms",
+  "input_rate_mb_s",
+  "config_lookups_in_processing",
+  "flow_control/free_timeslices",
+  "flow_control/in_flight_timeslices",
+  "flow_control/throttled_iterations"
+};
+} // namespace
 
 namespace o2
 {
 namespace framework
 {
 
+DataProcessingSlotState::DataProcessingSlotState(FairMQDevice* device, std::vector<OutputRoute> const& outputs)
+  : fairMQContext{ FairMQDeviceProxy{ device } },
+    rootContext{ FairMQDeviceProxy{ device } },
+    stringContext{ FairMQDeviceProxy{ device } },
+    dataFrameContext{ FairMQDeviceProxy{ device } },
+    rawBufferContext{ FairMQDeviceProxy{ device } },
+    contextRegistry{ &fairMQContext, &rootContext, &stringContext, &dataFrameContext, &rawBufferContext },
+    allocator{ &timingInfo, &contextRegistry, outputs }
+{
+}
+
 DataProcessingDevice::DataProcessingDevice(DeviceSpec const& spec, ServiceRegistry& registry)
   : mSpec{ spec },
     mInit{ spec.algorithm.onInit },
@@ -87,6 +182,10 @@ void DataProcessingDevice::Init() {
     }
   }
   auto optionsRetriever(std::make_unique<FairOptionsRetriever>(mSpec.options, GetConfig()));
+  mTracer.setEnabled(GetConfig()->Count("timeslice-tracing") && GetConfig()->GetValue<bool>("timeslice-tracing"));
+  if (GetConfig()->Count("memory-accounting") && GetConfig()->GetValue<bool>("memory-accounting")) {
+    mMemoryAccounting = &mServiceRegistry.get<MemoryAccounting>();
+  }
   mConfigRegistry = std::move(std::make_unique<ConfigParamRegistry>(std::move(optionsRetriever)));
 
   mExpirationHandlers.clear();
@@ -97,14 +196,64 @@ void DataProcessingDevice::Init() {
       route.danglingConfigurator(*mConfigRegistry),
       route.expirationConfigurator(*mConfigRegistry)
     };
+    // When the dangling checkers DeviceSpecHelpers uses for each lifetime
+    // can expire something: timeframes, QA and transient inputs never
+    // expire (expireNever), the timers do so at their period (expireTimed)
+    // and the rest at every iteration (expireAlways).
+    switch (route.matcher.lifetime) {
+      case Lifetime::Timeframe:
+      case Lifetime::QA:
+      case Lifetime::Transient:
+        handler.schedule = ExpirationHandler::Schedule::Never;
+        break;
+      case Lifetime::Timer:
+        handler.schedule = ExpirationHandler::Schedule::Periodic;
+        handler.period = std::chrono::microseconds(mConfigRegistry->get<int>((std::string{ "period-" } + route.matcher.binding).c_str()));
+        break;
+      default:
+        break;
+    }
     mExpirationHandlers.emplace_back(std::move(handler));
   }
 
+  // In the event driven mode the device sleeps until some input arrives. Of
+  // the inputs which are not created by data, the timers need to wake it up
+  // at their period, while enumerations are created as fast as they are
+  // consumed, hence they need the polling.
+  mEventDriven = GetConfig()->Count("event-driven") && GetConfig()->GetValue<bool>("event-driven");
+  mPollTimeout = MAX_POLL_TIMEOUT_MS;
+  for (auto& handler : mExpirationHandlers) {
+    if (handler.lifetime == Lifetime::Timer) {
+      mPollTimeout = std::min(mPollTimeout, int(handler.period.count() / 1000));
+    } else if (handler.lifetime == Lifetime::Enumeration) {
+      mPollTimeout = 0;
+    }
+  }
+
+  // With --flow-control the driver shares the credits of all the devices:
+  // each of them advertises how many timeslices it can hold, the sources
+  // also get the consumers they have to wait for.
+  auto creditsName = getenv(TimesliceCredits::ENV_NAME);
+  auto creditsIndex = getenv(TimesliceCredits::ENV_INDEX);
+  mCredits = creditsName && creditsIndex ? TimesliceCredits::attach(creditsName) : nullptr;
+  if (mCredits) {
+    mCreditsIndex = std::stoul(creditsIndex);
+    auto consumers = getenv(TimesliceCredits::ENV_CONSUMERS);
+    mCreditConsumers = TimesliceCredits::decodeConsumers(consumers ? consumers : "");
+    mCredits->advertise(mCreditsIndex, mRelayer.getParallelTimeslices());
+  }
+
   auto& monitoring = mServiceRegistry.get<Monitoring>();
   monitoring.enableBuffering(MONITORING_QUEUE_SIZE);
   static const std::string dataProcessorIdMetric = "dataprocessor_id";
   static const std::string dataProcessorIdValue = mSpec.name;
   monitoring.addGlobalTag("dataprocessor_id", dataProcessorIdValue);
+  // The names and tags of the periodic metrics are built only once, here.
+  mSlowMetrics = MetricHandles{};
+  for (auto name : slowMetricsNames) {
+    mSlowMetrics.add(name, true);
+  }
+  mRelayerStateMetrics = MetricHandles{};
 
   if (mInit) {
     InitContext initContext{*mConfigRegistry,mServiceRegistry};
@@ -112,9 +261,33 @@ void DataProcessingDevice::Init() {
   }
 }
 
-void DataProcessingDevice::PreRun() { mServiceRegistry.get<CallbackService>()(CallbackService::Id::Start); }
+void DataProcessingDevice::PreRun()
+{
+  // How long it took since the driver spawned this device
+  if (auto spawnTime = getenv(DeviceExecution::SPAWN_TIME_ENV)) {
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto startup = (now - std::stoll(spawnTime)) * 1e-6;
+    LOG(INFO) << "Device started " << startup << " ms after being spawned";
+    mServiceRegistry.get<Monitoring>().send(Metric{ startup, "startup_time_ms" }.addTag(Key::Subsystem, Value::DPL));
+  }
+  // The channels are only connected at this point, so this is where the
+  // poller can be created.
+  if (mEventDriven && mSpec.inputChannels.empty() == false) {
+    std::vector<std::string> channelNames;
+    for (auto& channel : mSpec.inputChannels) {
+      channelNames.push_back(channel.name);
+    }
+    mInputPoller = fChannels.at(channelNames[0]).at(0).Transport()->CreatePoller(fChannels, channelNames);
+    LOG(INFO) << "Event driven mode, waiting at most " << mPollTimeout << " ms for the inputs";
+  }
+  mServiceRegistry.get<CallbackService>()(CallbackService::Id::Start);
+}
 
-void DataProcessingDevice::PostRun() { mServiceRegistry.get<CallbackService>()(CallbackService::Id::Stop); }
+void DataProcessingDevice::PostRun()
+{
+  mInputPoller.reset();
+  mServiceRegistry.get<CallbackService>()(CallbackService::Id::Stop);
+}
 
 void DataProcessingDevice::Reset() { mServiceRegistry.get<CallbackService>()(CallbackService::Id::Reset); }
 
@@ -124,8 +297,10 @@ bool DataProcessingDevice::ConditionalRun()
 {
   /// This will send metrics for the relayer at regular intervals of
   /// 5 seconds, in order to avoid overloading the system.
-  auto sendRelayerMetrics = [relayerStats = mRelayer.getStats(),
+  auto sendRelayerMetrics = [&relayer = mRelayer,
                              &stats = mStats,
+                             &metrics = mSlowMetrics,
+                             &configRegistry = *mConfigRegistry,
                              &lastSent = mLastSlowMetricSentTimestamp,
                              &currentTime = mBeginIterationTimestamp,
                              &monitoring = mServiceRegistry.get<Monitoring>()]()
@@ -136,26 +311,28 @@ bool DataProcessingDevice::ConditionalRun()
 
     O2_SIGNPOST_START(MonitoringStatus::ID, MonitoringStatus::SEND, 0, 0, O2_SIGNPOST_BLUE);
 
-    monitoring.send(Metric{ (int)relayerStats.malformedInputs, "malformed_inputs" }.addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ (int)relayerStats.droppedComputations, "dropped_computations" }.addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ (int)relayerStats.droppedIncomingMessages, "dropped_incoming_messages" }.addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ (int)relayerStats.relayedMessages, "relayed_messages" }.addTag(Key::Subsystem, Value::DPL));
-
-    monitoring.send(Metric{ (int)stats.pendingInputs, "inputs/relayed/pending" }.addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ (int)stats.incomplete, "inputs/relayed/incomplete" }.addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ (int)stats.inputParts, "inputs/relayed/total" }.addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ stats.lastElapsedTimeMs, "elapsed_time_ms" }.addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ stats.lastTotalProcessedSize, "processed_input_size_byte" }
-                      .addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ (stats.lastTotalProcessedSize / (stats.lastElapsedTimeMs ? stats.lastElapsedTimeMs : 1) / 1000),
-                            "processing_rate_mb_s" }
-                      .addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ stats.lastLatency.minLatency, "min_input_latency_ms" }
-                      .addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ stats.lastLatency.maxLatency, "max_input_latency_ms" }
-                      .addTag(Key::Subsystem, Value::DPL));
-    monitoring.send(Metric{ (stats.lastTotalProcessedSize / (stats.lastLatency.maxLatency ? stats.lastLatency.maxLatency : 1) / 1000), "input_rate_mb_s" }
-                      .addTag(Key::Subsystem, Value::DPL));
+    auto& relayerStats = relayer.getStats();
+    metrics.set(MalformedInputs, (int)relayerStats.malformedInputs);
+    metrics.set(DroppedComputations, (int)relayerStats.droppedComputations);
+    metrics.set(DroppedIncomingMessages, (int)relayerStats.droppedIncomingMessages);
+    metrics.set(RelayedMessages, (int)relayerStats.relayedMessages);
+    metrics.set(ExpirationsChecked, (int)relayerStats.expirationsChecked);
+    metrics.set(ExpirationsFired, (int)relayerStats.expirationsFired);
+
+    metrics.set(PendingInputs, stats.pendingInputs);
+    metrics.set(IncompleteInputs, stats.incomplete);
+    metrics.set(TotalInputs, stats.inputParts);
+    metrics.set(ElapsedTime, stats.lastElapsedTimeMs);
+    metrics.set(ProcessedInputSize, stats.lastTotalProcessedSize);
+    metrics.set(ProcessingRate, stats.lastTotalProcessedSize / (stats.lastElapsedTimeMs ? stats.lastElapsedTimeMs : 1) / 1000);
+    metrics.set(MinInputLatency, stats.lastLatency.minLatency);
+    metrics.set(MaxInputLatency, stats.lastLatency.maxLatency);
+    metrics.set(InputRate, stats.lastTotalProcessedSize / (stats.lastLatency.maxLatency ? stats.lastLatency.maxLatency : 1) / 1000);
+    metrics.set(ConfigLookupsInProcessing, (int)configRegistry.processingLookups());
+    metrics.set(FreeTimeslices, stats.freeTimeslices);
+    metrics.set(InFlightTimeslices, stats.inFlightTimeslices);
+    metrics.set(ThrottledIterations, stats.throttledIterations);
+    metrics.flush(monitoring);
 
     lastSent = currentTime;
     O2_SIGNPOST_END(MonitoringStatus::ID, MonitoringStatus::SEND, 0, 0, O2_SIGNPOST_BLUE);
@@ -163,6 +340,7 @@ bool DataProcessingDevice::ConditionalRun()
 
   /// This will flush metrics only once every second.
   auto flushMetrics = [&stats = mStats,
+                       &stateMetrics = mRelayerStateMetrics,
                        &relayer = mRelayer,
                        &lastFlushed = mLastMetricFlushedTimestamp,
                        &currentTime = mBeginIterationTimestamp,
@@ -173,25 +351,37 @@ bool DataProcessingDevice::ConditionalRun()
     }
 
     O2_SIGNPOST_START(MonitoringStatus::ID, MonitoringStatus::FLUSH, 0, 0, O2_SIGNPOST_RED);
-    // Send all the relevant metrics for the relayer to update the GUI
-    // FIXME: do a delta with the previous version if too many metrics are still
-    // sent...
+    // Send all the relevant metrics for the relayer to update the GUI. The
+    // state of a slot input is registered the first time it is set. Only the
+    // states which changed since the previous flush are sent.
+    for (size_t si = stateMetrics.size(); si < stats.relayerState.size(); ++si) {
+      stateMetrics.add("data_relayer/" + std::to_string(si));
+    }
     for (size_t si = 0; si < stats.relayerState.size(); ++si) {
-      auto state = stats.relayerState[si];
-      monitoring.send({ state, "data_relayer/" + std::to_string(si) });
+      stateMetrics.set(si, stats.relayerState[si]);
     }
+    stateMetrics.flush(monitoring, true);
     relayer.sendContextState();
     monitoring.flushBuffer();
     lastFlushed = currentTime;
     O2_SIGNPOST_END(MonitoringStatus::ID, MonitoringStatus::FLUSH, 0, 0, O2_SIGNPOST_RED);
   };
 
+  // Block until any of the inputs has data or until the next timer is due,
+  // rather than cycling through the channels when there is nothing to do.
+  if (mInputPoller) {
+    mInputPoller->Poll(mPollTimeout);
+  }
+
   auto now = std::chrono::high_resolution_clock::now();
   mBeginIterationTimestamp = (uint64_t)std::chrono::duration<double, std::milli>(now.time_since_epoch()).count();
 
   mServiceRegistry.get<CallbackService>()(CallbackService::Id::ClockTick);
   bool active = false;
   for (auto& channel : mSpec.inputChannels) {
+    if (mInputPoller && mInputPoller->CheckInput(channel.name, 0) == false) {
+      continue;
+    }
     FairMQParts parts;
     auto result = this->Receive(parts, channel.name, 0, 0);
     if (result > 0) {
@@ -202,7 +392,21 @@ bool DataProcessingDevice::ConditionalRun()
   if (active == false) {
     mServiceRegistry.get<CallbackService>()(CallbackService::Id::Idle);
   }
-  mRelayer.processDanglingInputs(mExpirationHandlers, mServiceRegistry);
+  // A source only creates new timeslices while all its consumers have free
+  // slots for them, otherwise it waits for them to catch up.
+  bool throttled = false;
+  if (mCredits && mCreditConsumers.empty() == false) {
+    auto credit = mCredits->credit(mCreditConsumers, mCredits->getProcessed(mCreditsIndex));
+    mStats.freeTimeslices = (int)std::min<int64_t>(credit.free, std::numeric_limits<int>::max());
+    mStats.inFlightTimeslices = (int)credit.inFlight;
+    throttled = credit.free <= 0;
+  }
+  if (throttled) {
+    mStats.throttledIterations++;
+    std::this_thread::sleep_for(THROTTLE_SLEEP);
+  } else {
+    mRelayer.processDanglingInputs(mExpirationHandlers, mServiceRegistry);
+  }
   this->tryDispatchComputation();
 
   sendRelayerMetrics();
@@ -271,13 +475,23 @@ bool DataProcessingDevice::handleData(FairMQParts& parts)
     device.error(message);
   };
 
-  auto putIncomingMessageIntoCache = [&parts,&relayer,&reportError]() {
+  auto traceArrival = [&parts, &tracer = mTracer](size_t headerIndex) {
+    auto header = parts.At(headerIndex)->GetData();
+    auto dph = o2::header::get<DataProcessingHeader*>(header);
+    tracer.relayed(dph->startTime, o2::header::get<TimesliceTraceHeader*>(header));
+    O2_SIGNPOST(TimesliceTraceStatus::ID, TimesliceTraceStatus::RELAY_ARRIVAL, dph->startTime, 0, O2_SIGNPOST_BLUE);
+  };
+
+  auto putIncomingMessageIntoCache = [&parts, &relayer, &reportError, &traceArrival, tracing = mTracer.isEnabled()]() {
     // We relay execution to make sure we have a complete set of parts
     // available.
     for (size_t pi = 0; pi < (parts.Size()/2); ++pi) {
       auto headerIndex = 2*pi;
       auto payloadIndex = 2*pi+1;
       assert(payloadIndex < parts.Size());
+      if (tracing) {
+        traceArrival(headerIndex);
+      }
       auto relayed = relayer.relay(std::move(parts.At(headerIndex)),
                                    std::move(parts.At(payloadIndex)));
       if (relayed == DataRelayer::WillNotRelay) {
@@ -320,6 +534,7 @@ bool DataProcessingDevice::tryDispatchComputation()
   auto& forwards = mSpec.forwards;
   auto& inputsSchema = mSpec.inputs;
   auto& processingCount = mProcessingCount;
+  auto& configRegistry = *mConfigRegistry;
   auto& rdfContext = *mContextRegistry.get<ArrowContext>();
   auto& relayer = mRelayer;
   auto& rootContext = *mContextRegistry.get<RootObjectContext>();
@@ -330,6 +545,7 @@ bool DataProcessingDevice::tryDispatchComputation()
   auto& timingInfo = mTimingInfo;
   auto& timesliceIndex = mServiceRegistry.get<TimesliceIndex>();
   auto& rawContext = *mContextRegistry.get<RawBufferContext>();
+  auto& tracer = mTracer;
 
   // These duplicate references are created so that each function
   // does not need to know about the whole class state, but I can
@@ -354,6 +570,68 @@ bool DataProcessingDevice::tryDispatchComputation()
     return completed.empty() == false;
   };
 
+  // The time at which the timeslices are ready, the time at which the
+  // callback starts and ends and the time at which the outputs are sent.
+  auto traceReady = [&tracer, &completed, &timesliceIndex]() {
+    auto time = TimesliceTracer::now();
+    for (auto& action : completed) {
+      if (action.op == CompletionPolicy::CompletionOp::Wait) {
+        continue;
+      }
+      auto timeslice = timesliceIndex.getTimesliceForSlot(action.slot).value;
+      tracer.mark(timeslice, TracePoint::ReadyToProcess, time);
+      O2_SIGNPOST(TimesliceTraceStatus::ID, TimesliceTraceStatus::READY_TO_PROCESS, timeslice, 0, O2_SIGNPOST_BLUE);
+    }
+  };
+
+  auto traceCallback = [&tracer](size_t timeslice, TracePoint point, uint64_t time) {
+    if (tracer.isEnabled()) {
+      tracer.mark(timeslice, point, time);
+    }
+  };
+
+  // When tracing, the header stack of every output gets a
+  // TimesliceTraceHeader with the time it is sent.
+  auto traceOutputs = [&tracer, &device](size_t timeslice) -> DataProcessor::PartsTransform {
+    if (tracer.isEnabled() == false) {
+      return {};
+    }
+    return [&tracer, &device, timeslice](FairMQParts& parts, std::string const& channel) {
+      auto trace = tracer.outputHeader(timeslice, TimesliceTracer::now());
+      auto& header = parts.At(0);
+      FairMQMessagePtr traced = device.NewMessageFor(channel, 0, header->GetSize() + sizeof(TimesliceTraceHeader));
+      TimesliceTracer::appendHeader(static_cast<char const*>(header->GetData()), header->GetSize(),
+                                    static_cast<char*>(traced->GetData()), trace);
+      header = std::move(traced);
+    };
+  };
+
+  // With the memory accounting, the outputs of a timeslice are accounted as
+  // they are sent, and released once all of them are: they were all alive at
+  // the end of the callback.
+  auto sendTransform = [&traceOutputs, accounting = mMemoryAccounting](size_t timeslice, size_t& outputBytes) -> DataProcessor::PartsTransform {
+    auto trace = traceOutputs(timeslice);
+    if (accounting == nullptr) {
+      return trace;
+    }
+    return [trace, accounting, &outputBytes](FairMQParts& parts, std::string const& channel) {
+      accounting->allocated(MemorySource::Outputs, parts.At(1)->GetSize());
+      outputBytes += parts.At(1)->GetSize();
+      if (trace) {
+        trace(parts, channel);
+      }
+    };
+  };
+
+  auto traceSent = [&tracer, &monitoringService](size_t timeslice) {
+    if (tracer.isEnabled() == false) {
+      return;
+    }
+    tracer.mark(timeslice, TracePoint::Send);
+    O2_SIGNPOST(TimesliceTraceStatus::ID, TimesliceTraceStatus::SEND, timeslice, 0, O2_SIGNPOST_BLUE);
+    reportTrace(monitoringService, tracer.finish(timeslice));
+  };
+
   // We use this to get a list with the actual indexes in the cache which
   // indicate a complete set of inputs. Notice how I fill the completed
   // vector and return it, so that I can have a nice for loop iteration later
@@ -372,6 +650,7 @@ bool DataProcessingDevice::tryDispatchComputation()
     InputSpan span{ [&currentSetOfInputs](size_t i) -> char const* {
                      return currentSetOfInputs.at(i) ? static_cast<char const*>(currentSetOfInputs.at(i)->GetData()) : nullptr;
                    },
+                    [&currentSetOfInputs](size_t i) -> FairMQMessage* { return currentSetOfInputs.at(i).get(); },
                     currentSetOfInputs.size() };
     return InputRecord{ inputsSchema, std::move(span) };
   };
@@ -380,8 +659,17 @@ bool DataProcessingDevice::tryDispatchComputation()
   // why we do the stateful processing before the stateless one.
   // PROCESSING:{START,END} is done so that we can trigger on begin / end of processing
   // in the GUI.
-  auto dispatchProcessing = [&processingCount, &allocator, &statefulProcess, &statelessProcess, &monitoringService,
-                             &context, &rootContext, &stringContext, &rdfContext, &rawContext, &serviceRegistry, &device](TimesliceSlot slot, InputRecord& record) {
+  auto dispatchProcessing = [&processingCount, &allocator, &statefulProcess, &statelessProcess, &monitoringService, &configRegistry,
+                             &context, &rootContext, &stringContext, &rdfContext, &rawContext, &serviceRegistry, &device,
+                             &timingInfo, &traceCallback, &sendTransform, &traceSent,
+                             aggregate = mSpec.aggregateOutputs](TimesliceSlot slot, InputRecord& record, size_t& outputBytes) {
+    auto timeslice = timingInfo.timeslice;
+    traceCallback(timeslice, TracePoint::CallbackStart, TimesliceTracer::now());
+    O2_SIGNPOST_START(TimesliceTraceStatus::ID, timeslice, TimesliceTraceStatus::CALLBACK, 0, O2_SIGNPOST_GREEN);
+    // Options looked up by name at every timeslice should be resolved once
+    // via ConfigParamRegistry::handle in the init callback.
+    auto lookupsBefore = configRegistry.processingLookups();
+    configRegistry.setProcessing(true);
     if (statefulProcess) {
       ProcessingContext processContext{record, serviceRegistry, allocator};
       StateMonitoring<DataProcessingStatus>::moveTo(DataProcessingStatus::IN_DPL_USER_CALLBACK);
@@ -396,12 +684,20 @@ bool DataProcessingDevice::tryDispatchComputation()
       StateMonitoring<DataProcessingStatus>::moveTo(DataProcessingStatus::IN_DPL_OVERHEAD);
       processingCount++;
     }
+    configRegistry.setProcessing(false);
+    if (lookupsBefore == 0 && configRegistry.processingLookups() != 0) {
+      LOG(WARNING) << "Options are looked up by name in the processing callback, "
+                   << "use ConfigParamRegistry::handle in the init callback instead";
+    }
+    O2_SIGNPOST_END(TimesliceTraceStatus::ID, timeslice, TimesliceTraceStatus::CALLBACK, 0, O2_SIGNPOST_GREEN);
+    traceCallback(timeslice, TracePoint::CallbackEnd, TimesliceTracer::now());
 
-    DataProcessor::doSend(device, context);
+    DataProcessor::doSend(device, context, aggregate, sendTransform(timeslice, outputBytes));
     DataProcessor::doSend(device, rootContext);
     DataProcessor::doSend(device, stringContext);
     DataProcessor::doSend(device, rdfContext);
     DataProcessor::doSend(device, rawContext);
+    traceSent(timeslice);
   };
 
   // Error handling means printing the error and updating the metric
@@ -518,9 +814,167 @@ bool DataProcessingDevice::tryDispatchComputation()
     return totalInputSize;
   };
 
+  // The inputs of a timeslice, and the objects deserialized from them, are
+  // accounted from when they are taken from the relayer until the outputs
+  // are sent
+  auto accountInputs = [&calculateTotalInputRecordSize, accounting = mMemoryAccounting](InputRecord& record) -> size_t {
+    if (accounting == nullptr) {
+      return 0;
+    }
+    size_t inputBytes = calculateTotalInputRecordSize(record);
+    accounting->allocated(MemorySource::Inputs, inputBytes);
+    record.setMemoryAccounting(accounting);
+    return inputBytes;
+  };
+
+  auto releaseAccounted = [&monitoringService, accounting = mMemoryAccounting](InputRecord const& record, size_t inputBytes, size_t outputBytes) {
+    if (accounting == nullptr) {
+      return;
+    }
+    accounting->released(MemorySource::Outputs, outputBytes);
+    accounting->released(MemorySource::Deserialized, record.getDeserializedBytes());
+    accounting->released(MemorySource::Inputs, inputBytes);
+    accounting->report(monitoringService);
+  };
+
+  // When processing multiple timeslices concurrently, each action gets its
+  // own set of contextes and allocator. The inputs are fetched and the
+  // outputs sent on this thread, in timeslice order, while the processing
+  // callbacks are picked up by the first available worker thread.
+  auto dispatchParallel = [&device, &relayer, &timesliceIndex, &inputsSchema, &forwards, &forwardInputs,
+                           &currentSetOfInputs, &errorCallback, &monitoringService, &serviceRegistry,
+                           &statefulProcess, &statelessProcess, &processingCount, &slotStates = mSlotStates,
+                           &traceCallback, &sendTransform, &traceSent, &accountInputs, &releaseAccounted,
+                           &credits = mCredits, creditsIndex = mCreditsIndex,
+                           &spec = mSpec, &stats = mStats](std::vector<DataRelayer::RecordAction> actions) {
+    actions.erase(std::remove_if(actions.begin(), actions.end(),
+                                 [](DataRelayer::RecordAction const& action) { return action.op == CompletionPolicy::CompletionOp::Wait; }),
+                  actions.end());
+    std::sort(actions.begin(), actions.end(), [&timesliceIndex](DataRelayer::RecordAction const& a, DataRelayer::RecordAction const& b) {
+      return timesliceIndex.getTimesliceForSlot(a.slot).value < timesliceIndex.getTimesliceForSlot(b.slot).value;
+    });
+    while (slotStates.size() < actions.size()) {
+      slotStates.emplace_back(std::make_unique<DataProcessingSlotState>(&device, spec.outputs));
+    }
+
+    std::vector<InputRecord> records;
+    std::vector<size_t> inputBytes;
+    records.reserve(actions.size());
+    for (size_t ai = 0; ai < actions.size(); ++ai) {
+      auto& state = *slotStates[ai];
+      state.timingInfo.timeslice = timesliceIndex.getTimesliceForSlot(actions[ai].slot).value;
+      state.fairMQContext.clear();
+      state.rootContext.clear();
+      state.stringContext.clear();
+      state.dataFrameContext.clear();
+      state.rawBufferContext.clear();
+      state.inputs = relayer.getInputsForTimeslice(actions[ai].slot);
+      auto& inputs = state.inputs;
+      InputSpan span{ [&inputs](size_t i) -> char const* {
+                       return inputs.at(i) ? static_cast<char const*>(inputs.at(i)->GetData()) : nullptr;
+                     },
+                      [&inputs](size_t i) -> FairMQMessage* { return inputs.at(i).get(); },
+                      inputs.size() };
+      records.emplace_back(inputsSchema, std::move(span));
+      inputBytes.push_back(accountInputs(records.back()));
+    }
+
+    // Discarded records are only forwarded, if there is some place to
+    // forward them to, like in the serial case.
+    auto skipProcessing = [&forwards](DataRelayer::RecordAction const& action) {
+      return action.op == CompletionPolicy::CompletionOp::Discard && forwards.empty() == false;
+    };
+
+    std::atomic<size_t> nextAction{ 0 };
+    std::mutex errorMutex;
+    // The tracer is not thread safe, so the workers only take the times
+    std::vector<std::pair<uint64_t, uint64_t>> callbackTimes(actions.size(), { 0, 0 });
+    auto worker = [&]() {
+      for (size_t ai = nextAction++; ai < actions.size(); ai = nextAction++) {
+        if (skipProcessing(actions[ai])) {
+          continue;
+        }
+        auto& state = *slotStates[ai];
+        callbackTimes[ai].first = TimesliceTracer::now();
+        try {
+          if (statefulProcess) {
+            ProcessingContext processContext{ records[ai], serviceRegistry, state.allocator };
+            statefulProcess(processContext);
+          }
+          if (statelessProcess) {
+            ProcessingContext processContext{ records[ai], serviceRegistry, state.allocator };
+            statelessProcess(processContext);
+          }
+        } catch (std::exception& e) {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          LOG(ERROR) << "Exception caught: " << e.what() << std::endl;
+          if (errorCallback) {
+            monitoringService.send({ 1, "error" });
+            ErrorContext errorContext{ records[ai], serviceRegistry, e };
+            errorCallback(errorContext);
+          }
+        }
+        callbackTimes[ai].second = TimesliceTracer::now();
+      }
+    };
+
+    auto tStart = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    auto nThreads = std::min(spec.maxProcessingThreads, actions.size());
+    for (size_t ti = 1; ti < nThreads; ++ti) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    auto tEnd = std::chrono::high_resolution_clock::now();
+    stats.lastElapsedTimeMs = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+
+    for (size_t ai = 0; ai < actions.size(); ++ai) {
+      auto& state = *slotStates[ai];
+      auto& action = actions[ai];
+      size_t outputBytes = 0;
+      if (skipProcessing(action) == false) {
+        auto timeslice = state.timingInfo.timeslice;
+        traceCallback(timeslice, TracePoint::CallbackStart, callbackTimes[ai].first);
+        traceCallback(timeslice, TracePoint::CallbackEnd, callbackTimes[ai].second);
+        DataProcessor::doSend(device, state.fairMQContext, spec.aggregateOutputs, sendTransform(timeslice, outputBytes));
+        DataProcessor::doSend(device, state.rootContext);
+        DataProcessor::doSend(device, state.stringContext);
+        DataProcessor::doSend(device, state.dataFrameContext);
+        DataProcessor::doSend(device, state.rawBufferContext);
+        traceSent(timeslice);
+        processingCount += (statefulProcess ? 1 : 0) + (statelessProcess ? 1 : 0);
+      }
+      releaseAccounted(records[ai], inputBytes[ai], outputBytes);
+      if (forwards.empty() == false && (action.op == CompletionPolicy::CompletionOp::Consume || action.op == CompletionPolicy::CompletionOp::Discard)) {
+        currentSetOfInputs = std::move(state.inputs);
+        InputSpan span{ [&currentSetOfInputs](size_t i) -> char const* {
+                         return currentSetOfInputs.at(i) ? static_cast<char const*>(currentSetOfInputs.at(i)->GetData()) : nullptr;
+                       },
+                        currentSetOfInputs.size() };
+        InputRecord forwardedRecord{ inputsSchema, std::move(span) };
+        forwardInputs(action.slot, forwardedRecord);
+      }
+      state.inputs.clear();
+      if (credits) {
+        credits->processed(creditsIndex);
+      }
+    }
+  };
+
   if (canDispatchSomeComputation() == false) {
     return false;
   }
+  if (tracer.isEnabled()) {
+    traceReady();
+  }
+
+  if (mSpec.maxProcessingThreads > 1) {
+    dispatchParallel(getReadyActions());
+    return true;
+  }
 
   for (auto action: getReadyActions()) {
     if (action.op == CompletionPolicy::CompletionOp::Wait) {
@@ -529,6 +983,11 @@ bool DataProcessingDevice::tryDispatchComputation()
 
     prepareAllocatorForCurrentTimeSlice(TimesliceSlot{ action.slot });
     InputRecord record = fillInputs(action.slot);
+    // The slot of the timeslice is now free, one more credit for the
+    // sources feeding this device
+    if (mCredits) {
+      mCredits->processed(mCreditsIndex);
+    }
     if (action.op == CompletionPolicy::CompletionOp::Discard) {
       if (forwards.empty() == false) {
         forwardInputs(action.slot, record);
@@ -542,11 +1001,14 @@ bool DataProcessingDevice::tryDispatchComputation()
       mStats.relayerState.resize(std::max(cacheId + 1, mStats.relayerState.size()), 0);
       mStats.relayerState[cacheId] = state;
     }
+    size_t inputBytes = accountInputs(record);
+    size_t outputBytes = 0;
     try {
-      dispatchProcessing(action.slot, record);
+      dispatchProcessing(action.slot, record, outputBytes);
     } catch(std::exception &e) {
       errorHandling(e, record);
     }
+    releaseAccounted(record, inputBytes, outputBytes);
     for (size_t ai = 0; ai != record.size(); ai++) {
       auto cacheId = action.slot.index * record.size() + ai;
       auto state = record.isValid(ai) ? 3 : 0;
@@ -41,6 +41,16 @@ enum struct DriverStatus : uint32_t {
 
 };
 
+/// The trace points of the timeslices, when the tracing is enabled. The
+/// timeslice is the interval id of the callback.
+enum struct TimesliceTraceStatus : uint32_t {
+  ID = 3,
+  RELAY_ARRIVAL = 0,
+  READY_TO_PROCESS = 1,
+  CALLBACK = 2,
+  SEND = 3
+};
+
 } // namespace framework
 } // namespace o2
 
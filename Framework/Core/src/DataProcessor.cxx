@@ -21,7 +21,11 @@
 #include <fairmq/FairMQDevice.h>
 #include <arrow/io/memory.h>
 #include <arrow/ipc/writer.h>
+#include <algorithm>
 #include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace o2::framework;
 using DataHeader = o2::header::DataHeader;
@@ -42,6 +46,51 @@ void DataProcessor::doSend(FairMQDevice &device, MessageContext &context) {
   }
 }
 
+void DataProcessor::doSend(FairMQDevice& device, MessageContext& context, bool aggregate)
+{
+  doSend(device, context, aggregate, PartsTransform{});
+}
+
+void DataProcessor::doSend(FairMQDevice& device, MessageContext& context, bool aggregate, PartsTransform const& transform)
+{
+  if (aggregate == false && !transform) {
+    doSend(device, context);
+    return;
+  }
+  if (aggregate == false) {
+    for (auto& message : context) {
+      FairMQParts parts = std::move(message->finalize());
+      assert(message->empty());
+      assert(parts.Size() == 2);
+      transform(parts, message->channel());
+      device.Send(parts, message->channel(), 0);
+    }
+    return;
+  }
+  // One multipart message per channel, channels in order of first use.
+  // Only a handful of channels per device, a linear lookup is enough.
+  std::vector<std::pair<std::string, FairMQParts>> channelParts;
+  for (auto& message : context) {
+    FairMQParts parts = std::move(message->finalize());
+    assert(message->empty());
+    assert(parts.Size() == 2);
+    if (transform) {
+      transform(parts, message->channel());
+    }
+    auto it = std::find_if(channelParts.begin(), channelParts.end(),
+                           [&message](auto const& entry) { return entry.first == message->channel(); });
+    if (it == channelParts.end()) {
+      channelParts.emplace_back(message->channel(), FairMQParts{});
+      it = channelParts.end() - 1;
+    }
+    it->second.AddPart(std::move(parts.At(0)));
+    it->second.AddPart(std::move(parts.At(1)));
+  }
+  for (auto& entry : channelParts) {
+    device.Send(entry.second, entry.first, 0);
+  }
+}
+
 void DataProcessor::doSend(FairMQDevice &device, RootObjectContext &context) {
   for (auto &messageRef : context) {
     assert(messageRef.payload.get());
@@ -106,11 +155,17 @@ void DataProcessor::doSend(FairMQDevice& device, RawBufferContext& context)
   for (auto& messageRef : context) {
     FairMQParts parts;
     FairMQMessagePtr payload(device.NewMessage());
-    auto buffer = messageRef.serializeMsg().str();
-    // Rebuild the message using the serialized ostringstream as input. For now it involves a copy.
-    size_t size = buffer.length();
-    payload->Rebuild(size);
-    std::memcpy(payload->GetData(), buffer.c_str(), size);
+    size_t size = 0;
+    if (messageRef.serializeToMsg) {
+      messageRef.serializeToMsg(*payload);
+      size = payload->GetSize();
+    } else {
+      auto buffer = messageRef.serializeMsg().str();
+      // Rebuild the message using the serialized ostringstream as input. For now it involves a copy.
+      size = buffer.length();
+      payload->Rebuild(size);
+      std::memcpy(payload->GetData(), buffer.c_str(), size);
+    }
     const DataHeader* cdh = o2::header::get<DataHeader*>(messageRef.header->GetData());
     // sigh... See if we can avoid having it const by not
     // exposing it to the user in the first place.
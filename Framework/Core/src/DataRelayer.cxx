@@ -24,6 +24,8 @@
 
 #include <gsl/span>
 
+#include <chrono>
+
 using namespace o2::framework::data_matcher;
 using DataHeader = o2::header::DataHeader;
 using DataProcessingHeader = o2::framework::DataProcessingHeader;
@@ -47,44 +49,32 @@ std::vector<size_t> createDistinctRouteIndex(std::vector<InputRoute> const& rout
   return result;
 }
 
-DataDescriptorMatcher fromConcreteMatcher(ConcreteDataMatcher const& matcher)
-{
-  return DataDescriptorMatcher{
-    DataDescriptorMatcher::Op::And,
-    StartTimeValueMatcher{ ContextRef{ 0 } },
-    std::make_unique<DataDescriptorMatcher>(
-      DataDescriptorMatcher::Op::And,
-      OriginValueMatcher{ matcher.origin.str },
-      std::make_unique<DataDescriptorMatcher>(
-        DataDescriptorMatcher::Op::And,
-        DescriptionValueMatcher{ matcher.description.str },
-        std::make_unique<DataDescriptorMatcher>(
-          DataDescriptorMatcher::Op::Just,
-          SubSpecificationTypeValueMatcher{ matcher.subSpec })))
-  };
-}
-
-/// This converts from InputRoute to the associated DataDescriptorMatcher.
-std::vector<DataDescriptorMatcher> createInputMatchers(std::vector<InputRoute> const& routes)
+/// The matchers of the routes, compiled such that the inputs which do not
+/// bind any variable but the start time are looked up in a table.
+CompiledInputMatcher createInputMatcher(std::vector<InputRoute> const& routes)
 {
-  std::vector<DataDescriptorMatcher> result;
-
+  std::vector<InputSpec> specs;
   for (auto& route : routes) {
-    if (auto pval = std::get_if<ConcreteDataMatcher>(&route.matcher.matcher)) {
-      result.emplace_back(fromConcreteMatcher(*pval));
-    } else if (auto matcher = std::get_if<DataDescriptorMatcher>(&route.matcher.matcher)) {
-      result.push_back(*matcher);
-    } else {
-      throw std::runtime_error("Unsupported InputSpec type");
-    }
+    specs.push_back(route.matcher);
   }
-
-  return result;
+  return CompiledInputMatcher{ specs };
 }
 }
 
 constexpr int INVALID_INPUT = -1;
 
+// Resolution of the scheduling of the periodic expirations, in microseconds
+constexpr uint64_t EXPIRATION_TICK_US = 1000;
+
+namespace
+{
+uint64_t getCurrentTime()
+{
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+} // namespace
+
 // 16 is just some reasonable numer
 // The number should really be tuned at runtime for each processor.
 constexpr int DEFAULT_PIPELINE_LENGTH = 16;
@@ -101,12 +91,11 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     mMetrics{ metrics },
     mCompletionPolicy{ policy },
     mDistinctRoutesIndex{ createDistinctRouteIndex(inputRoutes) },
-    mInputMatchers{ createInputMatchers(inputRoutes) }
+    mInputMatcher{ createInputMatcher(inputRoutes) },
+    mExpirationWheel{ EXPIRATION_TICK_US, getCurrentTime() }
 {
   setPipelineLength(DEFAULT_PIPELINE_LENGTH);
-  for (size_t ci = 0; ci < mCache.size(); ci++) {
-    metrics.send({ 0, sMetricsNames[ci] });
-  }
+  mStateMetrics.flush(metrics);
   for (size_t ci = 0; ci < mVariableContextes.size() * 16; ci++) {
     metrics.send({ std::string("null"), sVariablesMetricsNames[ci] });
   }
@@ -115,20 +104,44 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
 void DataRelayer::processDanglingInputs(std::vector<ExpirationHandler> const& expirationHandlers,
                                         ServiceRegistry& services)
 {
+  std::lock_guard<std::mutex> lock(mMutex);
   // Create any slot for the time based fields
   for (size_t hi = 0; hi < expirationHandlers.size(); ++hi) {
     expirationHandlers[hi].creator(mTimesliceIndex);
   }
-  // Expire the records as needed.
-  for (size_t ti = 0; ti < mTimesliceIndex.size(); ++ti) {
-    TimesliceSlot slot{ ti };
-    if (mTimesliceIndex.isValid(slot) == false) {
-      continue;
-    }
-    assert(mDistinctRoutesIndex.empty() == false);
+  // The handlers are only known here: the periodic routes are put in the
+  // timer wheel on the first invocation.
+  auto now = getCurrentTime();
+  if (mDueRoutes.size() != mDistinctRoutesIndex.size()) {
+    mDueRoutes.assign(mDistinctRoutesIndex.size(), false);
     for (size_t ri = 0; ri < mDistinctRoutesIndex.size(); ++ri) {
-      auto& route = mInputRoutes[mDistinctRoutesIndex[ri]];
       auto& expirator = expirationHandlers[mDistinctRoutesIndex[ri]];
+      if (expirator.schedule == ExpirationHandler::Schedule::Periodic) {
+        mExpirationWheel.schedule(ri, now + expirator.period.count());
+      }
+    }
+  }
+  mExpirationWheel.advance(now, [&due = mDueRoutes](size_t ri) { due[ri] = true; });
+
+  // Expire the records as needed. Only the routes which can expire
+  // something now are checked, i.e. not the ones which never expire and
+  // the periodic ones only once their period elapsed.
+  assert(mDistinctRoutesIndex.empty() == false);
+  for (size_t ri = 0; ri < mDistinctRoutesIndex.size(); ++ri) {
+    auto& expirator = expirationHandlers[mDistinctRoutesIndex[ri]];
+    if (!expirator.checker || expirator.schedule == ExpirationHandler::Schedule::Never) {
+      continue;
+    }
+    bool periodic = expirator.schedule == ExpirationHandler::Schedule::Periodic;
+    if (periodic && mDueRoutes[ri] == false) {
+      continue;
+    }
+    bool expired = false;
+    for (size_t ti = 0; ti < mTimesliceIndex.size(); ++ti) {
+      TimesliceSlot slot{ ti };
+      if (mTimesliceIndex.isValid(slot) == false) {
+        continue;
+      }
       auto timestamp = mTimesliceIndex.getTimesliceForSlot(slot);
       auto& part = mCache[ti * mDistinctRoutesIndex.size() + ri];
       if (part.header != nullptr) {
@@ -137,9 +150,7 @@ void DataRelayer::processDanglingInputs(std::vector<ExpirationHandler> const& ex
       if (part.payload != nullptr) {
         continue;
       }
-      if (!expirator.checker) {
-        continue;
-      }
+      mStats.expirationsChecked++;
       if (expirator.checker(timestamp.value) == false) {
         continue;
       }
@@ -147,30 +158,19 @@ void DataRelayer::processDanglingInputs(std::vector<ExpirationHandler> const& ex
       assert(ti * mDistinctRoutesIndex.size() + ri < mCache.size());
       assert(expirator.handler);
       expirator.handler(services, part, timestamp.value);
+      mStats.expirationsFired++;
+      expired = true;
+      mFilledInputs[ti]++;
       mTimesliceIndex.markAsDirty(slot, true);
       assert(part.header != nullptr);
       assert(part.payload != nullptr);
     }
-  }
-}
-
-/// This does the mapping between a route and a InputSpec. The
-/// reason why these might diffent is that when you have timepipelining
-/// you have one route per timeslice, even if the type is the same.
-size_t matchToContext(void* data,
-                      std::vector<DataDescriptorMatcher> const& matchers,
-                      VariableContext& context)
-{
-  for (size_t ri = 0, re = matchers.size(); ri < re; ++ri) {
-    auto& matcher = matchers[ri];
-
-    if (matcher.match(reinterpret_cast<char const*>(data), context)) {
-      context.commit();
-      return ri;
+    // Next period, or retry at the next tick if nothing could be expired yet
+    if (periodic) {
+      mDueRoutes[ri] = false;
+      mExpirationWheel.schedule(ri, now + (expired ? expirator.period.count() : EXPIRATION_TICK_US));
     }
-    context.discard();
   }
-  return INVALID_INPUT;
 }
 
 /// Send the contents of a context as metrics, so that we can examine them in
@@ -196,9 +196,10 @@ DataRelayer::RelayChoice
 DataRelayer::relay(std::unique_ptr<FairMQMessage> &&header,
                    std::unique_ptr<FairMQMessage> &&payload) {
   // STATE HOLDING VARIABLES
-  // This is the class level state of the relaying. If we start supporting
-  // multithreading this will have to be made thread safe before we can invoke
-  // relay concurrently.
+  // This is the class level state of the relaying. Multiple channel
+  // polling threads can invoke relay concurrently, so we serialise the
+  // access to the cache and to the index.
+  std::lock_guard<std::mutex> lock(mMutex);
   auto const& inputRoutes = mInputRoutes;
   auto& index = mTimesliceIndex;
 
@@ -212,14 +213,19 @@ DataRelayer::relay(std::unique_ptr<FairMQMessage> &&header,
   // This returns the identifier for the given input. We use a separate
   // function because while it's trivial now, the actual matchmaking will
   // become more complicated when we will start supporting ranges.
-  auto getInputTimeslice = [& matchers = mInputMatchers,
-                            &header,
-                            &index ](VariableContext & context)
+  // The part of the matching which does not depend on the context is done
+  // only once, rather than for every slot.
+  auto const* headerData = reinterpret_cast<char const*>(header->GetData());
+  auto const lookup = mInputMatcher.lookup(headerData);
+  auto getInputTimeslice = [& matcher = mInputMatcher,
+                            &lookup,
+                            headerData ](VariableContext & context)
                              ->std::tuple<int, TimesliceId>
   {
-    /// FIXME: for the moment we only use the first context and reset
-    /// between one invokation and the other.
-    auto input = matchToContext(header->GetData(), matchers, context);
+    /// This does the mapping between a route and a InputSpec. The
+    /// reason why these might diffent is that when you have timepipelining
+    /// you have one route per timeslice, even if the type is the same.
+    auto input = matcher.match(lookup, headerData, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -244,7 +250,8 @@ DataRelayer::relay(std::unique_ptr<FairMQMessage> &&header,
   // simply store the payload in the cache and we mark relevant bit in the
   // hence the first if.
   auto pruneCache = [&cache,
-                     &cachedStateMetrics = mCachedStateMetrics,
+                     &stateMetrics = mStateMetrics,
+                     &filledInputs = mFilledInputs,
                      &numInputTypes,
                      &index,
                      &metrics](TimesliceSlot slot) {
@@ -257,8 +264,9 @@ DataRelayer::relay(std::unique_ptr<FairMQMessage> &&header,
     for (size_t ai = slot.index * numInputTypes, ae = ai + numInputTypes; ai != ae; ++ai) {
       cache[ai].header.reset(nullptr);
       cache[ai].payload.reset(nullptr);
-      cachedStateMetrics[ai] = 0;
+      stateMetrics.set(ai, 0);
     }
+    filledInputs[slot.index] = 0;
   };
 
   // We need to check if the slot for the current input is already taken for
@@ -272,14 +280,18 @@ DataRelayer::relay(std::unique_ptr<FairMQMessage> &&header,
 
   // Actually save the header / payload in the slot
   auto saveInSlot = [&header,
-                     &cachedStateMetrics = mCachedStateMetrics,
+                     &stateMetrics = mStateMetrics,
+                     &filledInputs = mFilledInputs,
                      &payload,
                      &cache,
                      &numInputTypes,
                      &metrics](TimesliceId timeslice, int input, TimesliceSlot slot) {
     auto cacheIdx = numInputTypes * slot.index + input;
     PartRef& currentPart = cache[cacheIdx];
-    cachedStateMetrics[cacheIdx] = 1;
+    stateMetrics.set(cacheIdx, 1);
+    if (currentPart.header == nullptr && currentPart.payload == nullptr) {
+      filledInputs[slot.index]++;
+    }
     PartRef ref{std::move(header), std::move(payload)};
     currentPart = std::move(ref);
     assert(header.get() == nullptr && payload.get() == nullptr);
@@ -398,6 +410,7 @@ DataRelayer::relay(std::unique_ptr<FairMQMessage> &&header,
 
 std::vector<DataRelayer::RecordAction>
 DataRelayer::getReadyToProcess() {
+  std::lock_guard<std::mutex> lock(mMutex);
   // THE STATE
   std::vector<RecordAction> completed;
   completed.reserve(16);
@@ -451,8 +464,13 @@ DataRelayer::getReadyToProcess() {
     if (mTimesliceIndex.isDirty(slot) == false) {
       continue;
     }
-    auto partial = getPartialRecord(li);
-    auto action = mCompletionPolicy.callback(partial);
+    CompletionPolicy::CompletionOp action;
+    if (mCompletionPolicy.countCallback) {
+      action = mCompletionPolicy.countCallback(mFilledInputs[li], numInputTypes);
+    } else {
+      auto partial = getPartialRecord(li);
+      action = mCompletionPolicy.callback(partial);
+    }
     switch (action) {
       case CompletionPolicy::CompletionOp::Consume:
       case CompletionPolicy::CompletionOp::Process:
@@ -472,6 +490,7 @@ DataRelayer::getReadyToProcess() {
 std::vector<std::unique_ptr<FairMQMessage>>
   DataRelayer::getInputsForTimeslice(TimesliceSlot slot)
 {
+  std::lock_guard<std::mutex> lock(mMutex);
   const auto numInputTypes = mDistinctRoutesIndex.size();
   // State of the computation
   std::vector<std::unique_ptr<FairMQMessage>> messages;
@@ -490,10 +509,10 @@ std::vector<std::unique_ptr<FairMQMessage>>
   // This means we can still handle old messages if there is still space in the
   // cache where to put them.
   auto moveHeaderPayloadToOutput = [&messages,
-                                    &cachedStateMetrics = mCachedStateMetrics,
+                                    &stateMetrics = mStateMetrics,
                                     &cache, &index, &numInputTypes, &metrics](TimesliceSlot s, size_t arg) {
     auto cacheId = s.index * numInputTypes + arg;
-    cachedStateMetrics[cacheId] = 2;
+    stateMetrics.set(cacheId, 2);
     messages.emplace_back(std::move(cache[cacheId].header));
     messages.emplace_back(std::move(cache[cacheId].payload));
     index.markAsInvalid(s);
@@ -517,6 +536,7 @@ std::vector<std::unique_ptr<FairMQMessage>>
     moveHeaderPayloadToOutput(slot, ai);
   }
   invalidateCacheFor(slot);
+  mFilledInputs[slot.index] = 0;
 
   return std::move(messages);
 }
@@ -526,6 +546,13 @@ DataRelayer::getParallelTimeslices() const {
   return mCache.size() / mDistinctRoutesIndex.size();
 }
 
+size_t DataRelayer::getFilledInputs(TimesliceSlot slot) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  assert(mFilledInputs.size() > slot.index);
+  return mFilledInputs[slot.index];
+}
+
 
 /// Tune the maximum number of in flight timeslices this can handle.
 /// Notice that in case we have time pipelining we need to count
@@ -533,17 +560,17 @@ DataRelayer::getParallelTimeslices() const {
 /// the time pipelining.
 void
 DataRelayer::setPipelineLength(size_t s) {
+  std::lock_guard<std::mutex> lock(mMutex);
   mTimesliceIndex.resize(s);
   mVariableContextes.resize(s);
   auto numInputTypes = mDistinctRoutesIndex.size();
   mCache.resize(numInputTypes * mTimesliceIndex.size());
+  mFilledInputs.resize(mTimesliceIndex.size(), 0);
   mMetrics.send({ (int)numInputTypes, "data_relayer/h" });
   mMetrics.send({ (int)mTimesliceIndex.size(), "data_relayer/w" });
-  sMetricsNames.resize(mCache.size());
-  mCachedStateMetrics.resize(mCache.size());
-  for (size_t i = 0; i < sMetricsNames.size(); ++i) {
-    sMetricsNames[i] = std::string("data_relayer/") + std::to_string(i);
-  }
+  // The handles of the state metrics are the indices in the cache
+  mStateMetrics = MetricHandles{};
+  mStateMetrics.addRange("data_relayer/", mCache.size());
   // There is maximum 16 variables available. We keep them row-wise so that
   // that we can take mod 16 of the index to understand which variable we
   // are talking about.
@@ -574,17 +601,16 @@ DataRelayerStats const& DataRelayer::getStats() const
 
 void DataRelayer::sendContextState()
 {
+  std::lock_guard<std::mutex> lock(mMutex);
   for (size_t ci = 0; ci < mTimesliceIndex.size(); ++ci) {
     auto slot = TimesliceSlot{ ci };
     sendVariableContextMetrics(mTimesliceIndex.getPublishedVariablesForSlot(slot), slot,
                                mMetrics, sVariablesMetricsNames);
   }
-  for (size_t si = 0; si < mCachedStateMetrics.size(); ++si) {
-    mMetrics.send({ mCachedStateMetrics[si], sMetricsNames[si] });
-  }
+  // Only the cache entries whose state changed since the last time
+  mStateMetrics.flush(mMetrics, true);
 }
 
-std::vector<std::string> DataRelayer::sMetricsNames;
 std::vector<std::string> DataRelayer::sVariablesMetricsNames;
 std::vector<std::string> DataRelayer::sQueriesMetricsNames;
 }
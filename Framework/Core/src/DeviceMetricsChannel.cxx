@@ -0,0 +1,281 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/DeviceMetricsChannel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2
+{
+namespace framework
+{
+
+/// The control block at the beginning of the shared memory segment. Head and
+/// tail are monotonic byte positions, the ring offset is position % size.
+/// They are on separate cache lines as they are written by different
+/// processes.
+struct DeviceMetricsChannel::Control {
+  static constexpr uint64_t MAGIC = 0x31534349525445ddULL;
+  uint64_t magic;
+  uint64_t size;
+  alignas(64) std::atomic<uint64_t> head; // written by the producer
+  alignas(64) std::atomic<uint64_t> tail; // written by the consumer
+  alignas(64) std::atomic<uint64_t> dropped;
+};
+
+/// Records are 8 byte aligned and never wrap, the end of the ring is
+/// skipped with a padding record if a record does not fit.
+struct DeviceMetricsChannel::RecordHeader {
+  enum Kind : uint8_t {
+    Padding = 0,
+    Label = 1, ///< the payload is the name of the metric with the given index
+    Metric = 2 ///< the payload is the value of the metric with the given index
+  };
+  uint32_t size; ///< size of the record including the header
+  uint8_t kind;
+  uint8_t type; ///< MetricType of a Metric record
+  uint16_t reserved;
+  int32_t index;
+  uint32_t payloadSize;
+  uint64_t timestamp;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the metrics channel needs address free atomics");
+
+namespace
+{
+constexpr size_t alignRecord(size_t size) { return (size + 7) & ~size_t(7); }
+} // namespace
+
+std::unique_ptr<DeviceMetricsChannel> DeviceMetricsChannel::create(std::string const& name, size_t size)
+{
+  size = alignRecord(std::max(size, sizeof(RecordHeader) * 16));
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return nullptr;
+  }
+  size_t mappedSize = sizeof(Control) + size;
+  if (ftruncate(fd, mappedSize) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  void* memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  auto control = new (memory) Control;
+  control->size = size;
+  control->head = 0;
+  control->tail = 0;
+  control->dropped = 0;
+  std::atomic_thread_fence(std::memory_order_release);
+  control->magic = Control::MAGIC;
+  return std::unique_ptr<DeviceMetricsChannel>(new DeviceMetricsChannel(name, memory, mappedSize, true));
+}
+
+std::unique_ptr<DeviceMetricsChannel> DeviceMetricsChannel::attach(std::string const& name)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Control)) {
+    close(fd);
+    return nullptr;
+  }
+  void* memory = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    return nullptr;
+  }
+  auto control = reinterpret_cast<Control*>(memory);
+  if (control->magic != Control::MAGIC || sizeof(Control) + control->size != (size_t)st.st_size) {
+    munmap(memory, st.st_size);
+    return nullptr;
+  }
+  return std::unique_ptr<DeviceMetricsChannel>(new DeviceMetricsChannel(name, memory, st.st_size, false));
+}
+
+DeviceMetricsChannel::DeviceMetricsChannel(std::string const& name, void* memory, size_t mappedSize, bool owner)
+  : mName{ name },
+    mMemory{ memory },
+    mMappedSize{ mappedSize },
+    mOwner{ owner },
+    mControl{ reinterpret_cast<Control*>(memory) },
+    mData{ reinterpret_cast<char*>(memory) + sizeof(Control) },
+    mSize{ reinterpret_cast<Control*>(memory)->size }
+{
+}
+
+DeviceMetricsChannel::~DeviceMetricsChannel()
+{
+  munmap(mMemory, mMappedSize);
+  if (mOwner) {
+    shm_unlink(mName.c_str());
+  }
+}
+
+DeviceMetricsChannel::RecordHeader* DeviceMetricsChannel::reserve(size_t payloadSize)
+{
+  size_t total = alignRecord(sizeof(RecordHeader) + payloadSize);
+  if (total > mSize / 2) {
+    return nullptr;
+  }
+  uint64_t head = mControl->head.load(std::memory_order_relaxed);
+  uint64_t tail = mControl->tail.load(std::memory_order_acquire);
+  size_t offset = head % mSize;
+  size_t contiguous = mSize - offset;
+  size_t needed = contiguous < total ? contiguous + total : total;
+  if (mSize - (head - tail) < needed) {
+    return nullptr;
+  }
+  if (contiguous < total) {
+    // skip the end of the ring, the consumer skips it implicitly if even
+    // the header does not fit
+    if (contiguous >= sizeof(RecordHeader)) {
+      auto padding = reinterpret_cast<RecordHeader*>(mData + offset);
+      padding->size = contiguous;
+      padding->kind = RecordHeader::Padding;
+    }
+    head += contiguous;
+    offset = 0;
+  }
+  auto record = reinterpret_cast<RecordHeader*>(mData + offset);
+  record->size = total;
+  record->payloadSize = payloadSize;
+  mReservedHead = head + total;
+  return record;
+}
+
+void DeviceMetricsChannel::commit(RecordHeader*)
+{
+  mControl->head.store(mReservedHead, std::memory_order_release);
+}
+
+int DeviceMetricsChannel::labelIndex(std::string_view name)
+{
+  name = name.substr(0, MetricLabelIndex::MAX_METRIC_LABEL_SIZE - 1);
+  std::string key{ name };
+  auto it = mLabelIndices.find(key);
+  if (it != mLabelIndices.end()) {
+    return it->second;
+  }
+  auto record = reserve(name.size());
+  if (record == nullptr) {
+    return -1;
+  }
+  int index = mLabelIndices.size();
+  record->kind = RecordHeader::Label;
+  record->index = index;
+  record->timestamp = 0;
+  memcpy(record + 1, name.data(), name.size());
+  commit(record);
+  mLabelIndices.emplace(std::move(key), index);
+  return index;
+}
+
+bool DeviceMetricsChannel::pushValue(std::string_view name, MetricType type, void const* value, size_t valueSize, size_t timestamp)
+{
+  int index = labelIndex(name);
+  auto record = index < 0 ? nullptr : reserve(valueSize);
+  if (record == nullptr) {
+    mControl->dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  record->kind = RecordHeader::Metric;
+  record->type = static_cast<uint8_t>(type);
+  record->index = index;
+  record->timestamp = timestamp;
+  memcpy(record + 1, value, valueSize);
+  commit(record);
+  return true;
+}
+
+bool DeviceMetricsChannel::push(std::string_view name, int value, size_t timestamp)
+{
+  return pushValue(name, MetricType::Int, &value, sizeof(value), timestamp);
+}
+
+bool DeviceMetricsChannel::push(std::string_view name, float value, size_t timestamp)
+{
+  return pushValue(name, MetricType::Float, &value, sizeof(value), timestamp);
+}
+
+bool DeviceMetricsChannel::push(std::string_view name, std::string_view value, size_t timestamp)
+{
+  value = value.substr(0, StringMetric::MAX_SIZE - 1);
+  return pushValue(name, MetricType::String, value.data(), value.size(), timestamp);
+}
+
+size_t DeviceMetricsChannel::poll(std::function<void(ParsedMetricMatch&)> const& callback)
+{
+  uint64_t tail = mControl->tail.load(std::memory_order_relaxed);
+  uint64_t head = mControl->head.load(std::memory_order_acquire);
+  size_t count = 0;
+  ParsedMetricMatch match;
+  while (tail < head) {
+    size_t offset = tail % mSize;
+    if (mSize - offset < sizeof(RecordHeader)) {
+      tail += mSize - offset;
+      continue;
+    }
+    auto record = reinterpret_cast<RecordHeader const*>(mData + offset);
+    auto payload = reinterpret_cast<char const*>(record + 1);
+    if (record->kind == RecordHeader::Label) {
+      if (mLabels.size() <= (size_t)record->index) {
+        mLabels.resize(record->index + 1);
+      }
+      mLabels[record->index].assign(payload, record->payloadSize);
+    } else if (record->kind == RecordHeader::Metric && (size_t)record->index < mLabels.size()) {
+      auto const& label = mLabels[record->index];
+      match.beginKey = label.data();
+      match.endKey = label.data() + label.size();
+      match.timestamp = record->timestamp;
+      match.type = static_cast<MetricType>(record->type);
+      switch (match.type) {
+        case MetricType::Int:
+          memcpy(&match.intValue, payload, sizeof(match.intValue));
+          break;
+        case MetricType::Float:
+          memcpy(&match.floatValue, payload, sizeof(match.floatValue));
+          break;
+        case MetricType::String:
+          match.beginStringValue = payload;
+          match.endStringValue = payload + record->payloadSize;
+          break;
+        default:
+          break;
+      }
+      callback(match);
+      ++count;
+    }
+    tail += record->size;
+  }
+  mControl->tail.store(tail, std::memory_order_release);
+  return count;
+}
+
+size_t DeviceMetricsChannel::dropped() const
+{
+  return mControl->dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace framework
+} // namespace o2
@@ -24,6 +24,46 @@ namespace o2
 namespace framework
 {
 
+namespace
+{
+// Stores @a value at @a pos of a ring buffer which is still growing when
+// @a pos is past its end.
+template <typename T>
+void storeInRing(std::vector<T>& ring, size_t pos, T const& value)
+{
+  if (pos == ring.size()) {
+    ring.push_back(value);
+  } else {
+    ring[pos] = value;
+  }
+}
+
+// Accounts @a value in the current bucket of each resolution, opening a new
+// bucket once its interval is over. Values arriving late are accounted in the
+// last bucket, rather than searching for the one they belong to.
+void aggregateValue(std::array<MetricAggregate, DeviceMetricsInfo::AGGREGATE_PERIODS.size()>& aggregates,
+                    size_t timestamp, float value)
+{
+  for (size_t li = 0; li < aggregates.size(); ++li) {
+    auto& aggregate = aggregates[li];
+    auto& buckets = aggregate.buckets;
+    size_t start = timestamp - timestamp % DeviceMetricsInfo::AGGREGATE_PERIODS[li];
+    if (buckets.empty() == false) {
+      auto& last = buckets[(aggregate.pos + buckets.size() - 1) % buckets.size()];
+      if (start <= last.timestamp) {
+        last.min = std::min(last.min, value);
+        last.max = std::max(last.max, value);
+        last.sum += value;
+        last.count++;
+        continue;
+      }
+    }
+    storeInRing(buckets, aggregate.pos, MetricBucket{ start, value, value, value, 1 });
+    aggregate.pos = (aggregate.pos + 1) % DeviceMetricsInfo::MAX_AGGREGATE_SIZE;
+  }
+}
+} // namespace
+
 // Parses a metric in the form
 //
 // [METRIC] <name>,<type> <value> <timestamp> [<tag>,<tag>]
@@ -150,21 +190,22 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
     switch (match.type) {
       case MetricType::Int:
         metricInfo.storeIdx = info.intMetrics.size();
-        info.intMetrics.emplace_back(std::array<int, 1024>{});
+        info.intMetrics.emplace_back();
         break;
       case MetricType::String:
         metricInfo.storeIdx = info.stringMetrics.size();
-        info.stringMetrics.emplace_back(std::array<StringMetric, 32>{});
+        info.stringMetrics.emplace_back();
         break;
       case MetricType::Float:
         metricInfo.storeIdx = info.floatMetrics.size();
-        info.floatMetrics.emplace_back(std::array<float, 1024>{});
+        info.floatMetrics.emplace_back();
         break;
       default:
         return false;
     };
-    // Add the timestamp buffer for it
-    info.timestamps.emplace_back(std::array<size_t, 1024>{});
+    // Add the timestamp buffer and the aggregates for it
+    info.timestamps.emplace_back();
+    info.aggregates.emplace_back();
     info.max.push_back(std::numeric_limits<float>::lowest());
     info.min.push_back(std::numeric_limits<float>::max());
     info.maxDomain.push_back(std::numeric_limits<size_t>::lowest());
@@ -201,30 +242,32 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
 
   switch(metricInfo.type) {
     case MetricType::Int: {
-      info.intMetrics[metricInfo.storeIdx][metricInfo.pos] = match.intValue;
+      storeInRing(info.intMetrics[metricInfo.storeIdx], metricInfo.pos, match.intValue);
       info.max[metricIndex] = std::max(info.max[metricIndex], (float)match.intValue);
       info.min[metricIndex] = std::min(info.min[metricIndex], (float)match.intValue);
+      aggregateValue(info.aggregates[metricIndex], match.timestamp, (float)match.intValue);
       // Save the timestamp for the current metric we do it here
       // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
+      storeInRing(info.timestamps[metricIndex], metricInfo.pos, match.timestamp);
       // Update the position where to write the next metric
-      metricInfo.pos = (metricInfo.pos + 1) % info.intMetrics[metricInfo.storeIdx].size();
+      metricInfo.pos = (metricInfo.pos + 1) % DeviceMetricsInfo::MAX_HISTORY_SIZE;
     } break;
     case MetricType::String: {
-      info.stringMetrics[metricInfo.storeIdx][metricInfo.pos] = stringValue;
+      storeInRing(info.stringMetrics[metricInfo.storeIdx], metricInfo.pos, stringValue);
       // Save the timestamp for the current metric we do it here
       // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      metricInfo.pos = (metricInfo.pos + 1) % info.stringMetrics[metricInfo.storeIdx].size();
+      storeInRing(info.timestamps[metricIndex], metricInfo.pos, match.timestamp);
+      metricInfo.pos = (metricInfo.pos + 1) % DeviceMetricsInfo::MAX_STRING_HISTORY_SIZE;
     } break;
     case MetricType::Float: {
-      info.floatMetrics[metricInfo.storeIdx][metricInfo.pos] = match.floatValue;
+      storeInRing(info.floatMetrics[metricInfo.storeIdx], metricInfo.pos, match.floatValue);
       info.max[metricIndex] = std::max(info.max[metricIndex], match.floatValue);
       info.min[metricIndex] = std::min(info.min[metricIndex], match.floatValue);
+      aggregateValue(info.aggregates[metricIndex], match.timestamp, match.floatValue);
       // Save the timestamp for the current metric we do it here
       // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      metricInfo.pos = (metricInfo.pos + 1) % info.floatMetrics[metricInfo.storeIdx].size();
+      storeInRing(info.timestamps[metricIndex], metricInfo.pos, match.timestamp);
+      metricInfo.pos = (metricInfo.pos + 1) % DeviceMetricsInfo::MAX_HISTORY_SIZE;
     } break;
     default:
       return false;
@@ -249,6 +292,92 @@ DeviceMetricsHelper::metricIdxByName(const std::string& name, const DeviceMetric
   return i;
 }
 
+size_t DeviceMetricsHelper::extractHistory(DeviceMetricsInfo const& info, size_t metricIndex,
+                                           size_t begin, size_t end, size_t maxPoints,
+                                           std::vector<MetricPoint>& points)
+{
+  points.clear();
+  if (metricIndex >= info.metrics.size() || maxPoints == 0) {
+    return 0;
+  }
+  auto& metric = info.metrics[metricIndex];
+  if (metric.type != MetricType::Int && metric.type != MetricType::Float) {
+    return 0;
+  }
+  auto& timestamps = info.timestamps[metricIndex];
+  auto& aggregates = info.aggregates[metricIndex];
+
+  // A history can be used if it goes back to the beginning of the range or
+  // if it never wrapped, i.e. nothing older was ever received. Otherwise we
+  // fall back to the coarsest one.
+  int level = aggregates.size() - 1;
+  if (timestamps.empty() == false && (timestamps[metric.pos % timestamps.size()] <= begin || timestamps.size() < DeviceMetricsInfo::MAX_HISTORY_SIZE)) {
+    level = -1;
+  } else {
+    for (size_t li = 0; li < aggregates.size(); ++li) {
+      auto& buckets = aggregates[li].buckets;
+      if (buckets.empty() == false && (buckets[aggregates[li].pos % buckets.size()].timestamp <= begin || buckets.size() < DeviceMetricsInfo::MAX_AGGREGATE_SIZE)) {
+        level = li;
+        break;
+      }
+    }
+  }
+
+  // Invokes @a fn for the entries of the chosen history in the range, oldest first.
+  auto visit = [&](auto fn) {
+    if (level == -1) {
+      size_t first = metric.pos % timestamps.size();
+      for (size_t i = 0; i < timestamps.size(); ++i) {
+        size_t pos = (first + i) % timestamps.size();
+        if (timestamps[pos] < begin || timestamps[pos] > end) {
+          continue;
+        }
+        float value = metric.type == MetricType::Int ? (float)info.intMetrics[metric.storeIdx][pos]
+                                                     : info.floatMetrics[metric.storeIdx][pos];
+        fn(MetricBucket{ timestamps[pos], value, value, value, 1 });
+      }
+      return;
+    }
+    auto& aggregate = aggregates[level];
+    auto period = DeviceMetricsInfo::AGGREGATE_PERIODS[level];
+    for (size_t i = 0; i < aggregate.buckets.size(); ++i) {
+      auto& bucket = aggregate.buckets[(aggregate.pos + i) % aggregate.buckets.size()];
+      if (bucket.timestamp + period <= begin || bucket.timestamp > end) {
+        continue;
+      }
+      fn(bucket);
+    }
+  };
+
+  // Merge consecutive entries, so that we stay within maxPoints.
+  size_t entries = 0;
+  visit([&entries](MetricBucket const&) { entries++; });
+  size_t merge = (entries + maxPoints - 1) / maxPoints;
+  MetricBucket current{};
+  size_t merged = 0;
+  auto flush = [&]() {
+    points.push_back(MetricPoint{ current.timestamp, current.min, current.max, current.avg() });
+    merged = 0;
+  };
+  visit([&](MetricBucket const& bucket) {
+    if (merged == 0) {
+      current = bucket;
+    } else {
+      current.min = std::min(current.min, bucket.min);
+      current.max = std::max(current.max, bucket.max);
+      current.sum += bucket.sum;
+      current.count += bucket.count;
+    }
+    if (++merged == merge) {
+      flush();
+    }
+  });
+  if (merged != 0) {
+    flush();
+  }
+  return points.size();
+}
+
 std::ostream& operator<<(std::ostream& oss, MetricType const& val)
 {
   switch (val) {
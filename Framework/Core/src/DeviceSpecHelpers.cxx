@@ -93,7 +93,8 @@ struct ExpirationHandlerHelpers {
     return [ s = spec, matcher = *m, sourceChannel ](ConfigParamRegistry const& options)
     {
       auto serverUrl = options.get<std::string>("condition-backend");
-      return LifetimeHelpers::fetchFromCCDBCache(matcher, serverUrl, sourceChannel);
+      auto cacheDir = options.get<std::string>("condition-cache-dir");
+      return LifetimeHelpers::fetchFromCCDBCache(matcher, serverUrl, sourceChannel, cacheDir);
     };
   }
 
@@ -230,6 +231,8 @@ void DeviceSpecHelpers::processOutEdgeActions(std::vector<DeviceSpec>& devices,
     device.options = processor.options;
     device.rank = processor.rank;
     device.nSlots = processor.nSlots;
+    device.maxProcessingThreads = processor.maxProcessingThreads;
+    device.aggregateOutputs = processor.aggregateOutputs;
     device.inputTimesliceId = edge.timeIndex;
     devices.push_back(device);
     return devices.size() - 1;
@@ -410,6 +413,8 @@ void DeviceSpecHelpers::processInEdgeActions(std::vector<DeviceSpec>& devices,
     device.options = processor.options;
     device.rank = processor.rank;
     device.nSlots = processor.nSlots;
+    device.maxProcessingThreads = processor.maxProcessingThreads;
+    device.aggregateOutputs = processor.aggregateOutputs;
     device.inputTimesliceId = edge.timeIndex;
     // FIXME: maybe I should use an std::map in the end
     //        but this is really not performance critical
@@ -784,9 +789,13 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("plugin-search-path,S", bpo::value<std::string>(), "FairMQ plugins search path")                           //
     ("control-port", bpo::value<std::string>(), "Utility port to be used by O2 Control")                        //
     ("rate", bpo::value<std::string>(), "rate for a data source device (Hz)")                                   //
+    ("transport", bpo::value<std::string>(), "FairMQ transport of the channels (zeromq, shmem)")                //
     ("monitoring-backend", bpo::value<std::string>(), "monitoring connection string")                           //
     ("infologger-mode", bpo::value<std::string>(), "INFOLOGGER_MODE override")                                  //
     ("infologger-severity", bpo::value<std::string>(), "minimun FairLogger severity which goes to info logger") //
+    ("timeslice-tracing", bpo::value<std::string>(), "report the trace points of every timeslice")              //
+    ("memory-accounting", bpo::value<std::string>(), "report the memory used by every timeslice")               //
+    ("event-driven", bpo::value<std::string>(), "block on the inputs until data arrives or a timer is due")     //
     ("child-driver", bpo::value<std::string>(), "external driver to start childs with (e.g. valgrind)");        //
 
   return forwardedDeviceOptions;
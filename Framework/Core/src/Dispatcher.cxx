@@ -24,6 +24,9 @@
 #include <fairmq/FairMQDevice.h>
 #include <fairmq/FairMQLogger.h>
 
+#include <chrono>
+#include <cstring>
+
 using namespace o2::configuration;
 
 namespace o2
@@ -36,7 +39,10 @@ Dispatcher::Dispatcher(std::string name, const std::string reconfigurationSource
 {
 }
 
-Dispatcher::~Dispatcher() = default;
+Dispatcher::~Dispatcher()
+{
+  stopSamplingThreads();
+}
 
 void Dispatcher::init(InitContext& ctx)
 {
@@ -44,35 +50,62 @@ void Dispatcher::init(InitContext& ctx)
 
   std::unique_ptr<ConfigurationInterface> cfg = ConfigurationFactory::getConfiguration(mReconfigurationSource);
   auto policiesTree = cfg->getRecursive("dataSamplingPolicies");
+  stopSamplingThreads();
   mPolicies.clear();
 
   for (auto&& policyConfig : policiesTree) {
     mPolicies.emplace_back(std::make_shared<DataSamplingPolicy>(policyConfig.second));
   }
+
+  // The policies sending to FairMQ channels are decided and sent by their own threads, so that
+  // the sampling does not hold the processing of the Dispatcher and thus its producers.
+  auto device = ctx.services().get<RawDeviceService>().device();
+  for (auto& policy : mPolicies) {
+    if (policy->getFairMQOutputChannel().empty()) {
+      mSamplingThreads.emplace_back(nullptr);
+      continue;
+    }
+    auto samplingThread = std::make_unique<SamplingThread>(policy);
+    samplingThread->thread = std::thread(&Dispatcher::runSamplingThread, this, device, std::ref(*samplingThread));
+    mSamplingThreads.push_back(std::move(samplingThread));
+  }
 }
 
 void Dispatcher::run(ProcessingContext& ctx)
 {
-  for (const auto& input : ctx.inputs()) {
+  auto& inputs = ctx.inputs();
+  auto device = ctx.services().get<RawDeviceService>().device();
+  for (size_t pos = 0; pos < inputs.size(); pos++) {
+    const auto input = inputs.getByPos(pos);
     if (input.header != nullptr && input.spec != nullptr) {
 
-      for (auto& policy : mPolicies) {
+      for (size_t i = 0; i < mPolicies.size(); i++) {
+        auto& policy = mPolicies[i];
         // todo: consider getting the outputSpec in match to improve performance
         // todo: consider matching (and deciding) in completion policy to save some time
-        if (policy->match(*input.spec) && policy->decide(input)) {
+        if (!policy->match(*input.spec)) {
+          continue;
+        }
 
-          if (!policy->getFairMQOutputChannel().empty()) {
-            sendFairMQ(ctx.services().get<RawDeviceService>().device(), input, policy->getFairMQOutputChannelName());
-          } else {
-            send(ctx.outputs(), input, policy->prepareOutput(*input.spec));
+        if (auto& samplingThread = mSamplingThreads[i]) {
+          const auto* dh = header::get<header::DataHeader*>(input.header);
+          const auto* dph = header::get<DataProcessingHeader*>(input.header);
+          assert(dh && dph);
+          auto sample = new Sample{ *dh, *dph, referencePayload(device, inputs.getPayloadMessageByPos(pos), input) };
+          if (!samplingThread->queue.bounded_push(sample)) {
+            // the sampling thread cannot keep up, the data is not sampled rather than delaying the processing
+            delete sample;
+            samplingThread->dropped++;
           }
+        } else if (policy->decide(input)) {
+          send(ctx.outputs(), input, referencePayload(device, inputs.getPayloadMessageByPos(pos), input), policy->prepareOutput(*input.spec));
         }
       }
     }
   }
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const
+void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, FairMQMessagePtr&& payload, const Output& output) const
 {
   //todo: support other serialization methods
   const auto* inputHeader = header::get<header::DataHeader*>(inputData.header);
@@ -80,39 +113,80 @@ void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, co
     LOG(WARNING) << "DataSampling::dispatcherCallback: input of origin'" << inputHeader->dataOrigin.str
                  << "', description '" << inputHeader->dataDescription.str
                  << "' has gSerializationMethodInvalid.";
-  } else if (inputHeader->payloadSerializationMethod == header::gSerializationMethodROOT) {
-    dataAllocator.adopt(output, DataRefUtils::as<TObject>(inputData).release());
-  } else { // POD
-    // todo: do it non-copy, when API is available
-    auto& outputMessage = dataAllocator.newChunk(output, inputHeader->payloadSize);
-    memcpy(outputMessage.data(), inputData.payload, inputHeader->payloadSize);
+  } else {
+    // the payload is sent as it is, ROOT objects are not deserialized and serialized again
+    dataAllocator.adoptMessage(output, std::move(payload), inputHeader->payloadSerializationMethod);
   }
 }
 
-// ideally this should be in a separate proxy device or use Lifetime::External
-void Dispatcher::sendFairMQ(FairMQDevice* device, const DataRef& inputData, const std::string& fairMQChannel) const
+FairMQMessagePtr Dispatcher::referencePayload(FairMQDevice* device, FairMQMessage* message, const DataRef& inputData) const
 {
   const auto* dh = header::get<header::DataHeader*>(inputData.header);
   assert(dh);
-  const auto* dph = header::get<DataProcessingHeader*>(inputData.header);
-  assert(dph);
+  if (message != nullptr) {
+    // refers to the same buffer (refcounted), no payload copy
+    FairMQMessagePtr reference(device->NewMessage());
+    reference->Copy(*message);
+    return reference;
+  }
+  FairMQMessagePtr payloadCopy(device->NewMessage(dh->payloadSize));
+  memcpy(payloadCopy->GetData(), inputData.payload, dh->payloadSize);
+  return payloadCopy;
+}
 
-  header::DataHeader dhout{ dh->dataDescription, dh->dataOrigin, dh->subSpecification, dh->payloadSize };
-  dhout.payloadSerializationMethod = dh->payloadSerializationMethod;
-  DataProcessingHeader dphout{ dph->startTime, dph->duration };
+void Dispatcher::runSamplingThread(FairMQDevice* device, SamplingThread& samplingThread) const
+{
+  const auto channel = samplingThread.policy->getFairMQOutputChannelName();
+  Sample* sample = nullptr;
+  while (!samplingThread.stop) {
+    if (!samplingThread.queue.pop(sample)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    std::unique_ptr<Sample> owned(sample);
+    o2::header::Stack headerStack{ owned->dataHeader, owned->processingHeader };
+    DataRef ref{ nullptr, reinterpret_cast<const char*>(headerStack.data()), static_cast<const char*>(owned->payload->GetData()) };
+    if (samplingThread.policy->decide(ref)) {
+      sendFairMQ(device, owned->dataHeader, owned->processingHeader, std::move(owned->payload), channel);
+    }
+  }
+}
+
+void Dispatcher::stopSamplingThreads()
+{
+  for (auto& samplingThread : mSamplingThreads) {
+    if (!samplingThread) {
+      continue;
+    }
+    samplingThread->stop = true;
+    samplingThread->thread.join();
+    Sample* sample = nullptr;
+    while (samplingThread->queue.pop(sample)) {
+      delete sample;
+    }
+    if (samplingThread->dropped) {
+      LOG(INFO) << "Policy " << samplingThread->policy->getName() << " dropped " << samplingThread->dropped
+                << " messages not sampled in time";
+    }
+  }
+  mSamplingThreads.clear();
+}
+
+// ideally this should be in a separate proxy device or use Lifetime::External
+void Dispatcher::sendFairMQ(FairMQDevice* device, const header::DataHeader& dh, const DataProcessingHeader& dph,
+                            FairMQMessagePtr&& payload, const std::string& fairMQChannel) const
+{
+  header::DataHeader dhout{ dh.dataDescription, dh.dataOrigin, dh.subSpecification, dh.payloadSize };
+  dhout.payloadSerializationMethod = dh.payloadSerializationMethod;
+  DataProcessingHeader dphout{ dph.startTime, dph.duration };
   o2::header::Stack headerStack{ dhout, dphout };
 
   auto channelAlloc = o2::pmr::getTransportAllocator(device->Transport());
   FairMQMessagePtr msgHeaderStack = o2::pmr::getMessage(std::move(headerStack), channelAlloc);
 
-  char* payloadCopy = new char[dh->payloadSize];
-  memcpy(payloadCopy, inputData.payload, dh->payloadSize);
-  auto cleanupFcn = [](void* data, void*) { delete[] reinterpret_cast<char*>(data); };
-  FairMQMessagePtr msgPayload(device->NewMessage(payloadCopy, dh->payloadSize, cleanupFcn, payloadCopy));
-
   FairMQParts message;
   message.AddPart(move(msgHeaderStack));
-  message.AddPart(move(msgPayload));
+  message.AddPart(move(payload));
 
   int64_t bytesSent = device->Send(message, fairMQChannel);
 }
@@ -14,6 +14,7 @@
 #include <chrono>
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <csignal>
@@ -21,6 +22,7 @@
 
 #include "Framework/ChannelConfigurationPolicy.h"
 #include "Framework/ConfigParamSpec.h"
+#include "CpuPlacement.h"
 
 namespace o2
 {
@@ -28,6 +30,7 @@ namespace framework
 {
 
 class ConfigContext;
+class TimesliceCredits;
 
 /// Possible states for the DPL Driver application
 ///
@@ -76,6 +79,11 @@ enum struct DriverState {
 /// reading from file).
 enum struct TerminationPolicy { QUIT, WAIT, RESTART };
 
+/// How the driver starts the devices. EXEC re-executes the workflow for every
+/// device, which then recomputes the whole topology. FORK reuses in the child
+/// the device specification already computed by the driver.
+enum struct SpawnPolicy { EXEC, FORK };
+
 /// Information about the driver process (i.e.  / the one which calculates the
 /// topology and actually spawns the devices )
 struct DriverInfo {
@@ -107,6 +115,14 @@ struct DriverInfo {
   bool batch;
   /// What we should do when the workflow is completed.
   enum TerminationPolicy terminationPolicy;
+  /// How the devices are pinned to the cores of the host
+  enum CpuPlacementPolicy cpuPlacement;
+  /// How the devices are started
+  enum SpawnPolicy spawnPolicy;
+  /// Whether the sources are throttled against their consumers
+  bool flowControl;
+  /// The credits of the devices, when flowControl is enabled
+  std::shared_ptr<TimesliceCredits> timesliceCredits;
   /// The offset at which the process was started.
   std::chrono::time_point<std::chrono::steady_clock> startTime;
   /// The optional timeout after which the driver will request
@@ -20,6 +20,8 @@
 #include <cstring>
 #include <cassert>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace o2
 {
@@ -62,6 +64,38 @@ void broadcastMessage(FairMQDevice &device, o2::header::Stack &&headerStack, Fai
   }
 }
 
+void broadcastSharedMessage(FairMQDevice& device, o2::header::Stack&& headerStack, FairMQMessagePtr&& payloadMessage, int index)
+{
+  std::vector<std::string const*> channels;
+  for (auto& channelInfo : device.fChannels) {
+    if (isBroadcastChannel(channelInfo.first)) {
+      channels.push_back(&channelInfo.first);
+    }
+  }
+  if (channels.empty()) {
+    return;
+  }
+  auto channelAlloc = o2::pmr::getTransportAllocator(device.fChannels.at(*channels.front()).at(index).Transport());
+  FairMQMessagePtr headerMessage = o2::pmr::getMessage(std::move(headerStack), channelAlloc);
+
+  for (size_t ci = 0; ci < channels.size(); ++ci) {
+    FairMQParts out;
+    if (ci + 1 == channels.size()) {
+      out.AddPart(std::move(headerMessage));
+      out.AddPart(std::move(payloadMessage));
+    } else {
+      // refers to the same buffers, no copy
+      FairMQMessagePtr header(device.NewMessageFor(*channels[ci], index));
+      header->Copy(*headerMessage);
+      FairMQMessagePtr payload(device.NewMessageFor(*channels[ci], index));
+      payload->Copy(*payloadMessage);
+      out.AddPart(std::move(header));
+      out.AddPart(std::move(payload));
+    }
+    device.Send(out, *channels[ci], index);
+  }
+}
+
 void broadcastDPLMessage(FairMQDevice& device, FairMQMessagePtr&& headerMessage, FairMQMessagePtr&& payloadMessage, int index)
 {
   for (auto& channelInfo : device.fChannels) {
@@ -63,20 +63,35 @@ struct HeatMapHelper {
       ImVec2(0., 0.) + winPos,
       ImVec2{ size.x - 1, size.y } + winPos,
       BORDER_COLOR);
+    // The adjacent slots of an input with the same state are drawn as one
+    // box, so that the cost follows the changes of state, not the slots.
     float padding = 1;
-    for (size_t ri = 0, re = getNumRecords(); ri < re; ri++) {
-      auto record = getRecord(ri);
-      ImVec2 xOffset{ (ri * boxSizeX) + padding, 0 };
-      ImVec2 xSize{ boxSizeX - 2 * padding, 0 };
-      auto boxSizeY = std::min(size.y / getNumItems(record), MAX_BOX_Y_SIZE);
-      for (size_t mi = 0, me = getNumItems(record); mi < me; mi++) {
-        ImVec2 yOffSet{ 0, (mi * boxSizeY) + padding };
-        ImVec2 ySize{ 0, boxSizeY - 2 * padding };
-
-        drawList->AddRectFilled(
-          xOffset + yOffSet + winPos,
-          xOffset + xSize + yOffSet + ySize + winPos,
-          getColor(getValue(getItem(record, mi))));
+    auto numItems = getNumItems(getRecord(0));
+    auto boxSizeY = std::min(size.y / numItems, MAX_BOX_Y_SIZE);
+    for (size_t mi = 0; mi < numItems; mi++) {
+      ImVec2 yOffSet{ 0, (mi * boxSizeY) + padding };
+      ImVec2 ySize{ 0, boxSizeY - 2 * padding };
+      size_t runBegin = 0;
+      ImU32 runColor = 0;
+      for (size_t ri = 0; ri <= records; ri++) {
+        ImU32 color = runColor;
+        if (ri < records) {
+          auto record = getRecord(ri);
+          color = getColor(getValue(getItem(record, mi)));
+          if (ri == 0) {
+            runColor = color;
+          }
+        }
+        if (ri == records || color != runColor) {
+          ImVec2 xOffset{ (runBegin * boxSizeX) + padding, 0 };
+          ImVec2 xSize{ (ri - runBegin) * boxSizeX - 2 * padding, 0 };
+          drawList->AddRectFilled(
+            xOffset + yOffSet + winPos,
+            xOffset + xSize + yOffSet + ySize + winPos,
+            runColor);
+          runBegin = ri;
+          runColor = color;
+        }
       }
     }
 
@@ -38,12 +38,7 @@ namespace gui
 {
 // Type erased information for the plotting
 struct MultiplotData {
-  int mod;
-  size_t first;
-  size_t size;
-  const void* Y;
-  const void* X;
-  MetricType type;
+  std::vector<MetricPoint> points;
 };
 
 } // namespace gui
@@ -152,14 +147,6 @@ void displayHistory(const DeviceInfo& info, DeviceControl& control)
   }
 }
 
-template <typename T>
-struct HistoData {
-  int mod;
-  size_t first;
-  size_t size;
-  const T* points;
-};
-
 enum struct MetricsDisplayStyle : int {
   Lines = 0,
   Histos = 1,
@@ -184,7 +171,6 @@ void displayDeviceMetrics(const char* label, ImVec2 canvasSize, std::string cons
   std::vector<const char*> deviceNames;
   std::vector<MultiplotData> userData;
   std::vector<ImColor> colors;
-  MetricType metricType;
   size_t metricSize = 0;
   assert(specs.size() == metricsInfos.size());
   float maxValue = std::numeric_limits<float>::lowest();
@@ -197,69 +183,40 @@ void displayDeviceMetrics(const char* label, ImVec2 canvasSize, std::string cons
     if (vi == metricsInfos[mi].metricLabelsIdx.size()) {
       continue;
     }
-    auto& metric = metricsInfos[mi].metrics[vi];
+    // Only the points in the range are extracted, at the resolution which
+    // fits in the requested number of bins.
+    MultiplotData data;
+    if (DeviceMetricsHelper::extractHistory(metricsInfos[mi], vi, rangeBegin, rangeEnd, bins, data.points) == 0) {
+      continue;
+    }
     deviceNames.push_back(specs[mi].name.c_str());
     colors.push_back(palette[mi % palette.size()]);
-    metricType = metric.type;
-    MultiplotData data;
-    data.mod = metricsInfos[mi].timestamps[vi].size();
-    data.first = metric.pos - data.mod;
-    data.X = metricsInfos[mi].timestamps[vi].data();
-    minValue = std::min(minValue, metricsInfos[mi].min[vi]);
-    maxValue = std::max(maxValue, metricsInfos[mi].max[vi]);
-    minDomain = std::min(minDomain, metricsInfos[mi].minDomain[vi]);
-    maxDomain = std::max(maxDomain, metricsInfos[mi].maxDomain[vi]);
-    switch (metric.type) {
-      case MetricType::Int: {
-        data.size = metricsInfos[mi].intMetrics[metric.storeIdx].size();
-        data.Y = metricsInfos[mi].intMetrics[metric.storeIdx].data();
-        data.type = MetricType::Int;
-        metricType = MetricType::Int;
-        metricSize = metricsInfos[mi].intMetrics[metric.storeIdx].size();
-      } break;
-      case MetricType::Float: {
-        data.size = metricsInfos[mi].floatMetrics[metric.storeIdx].size();
-        data.Y = metricsInfos[mi].floatMetrics[metric.storeIdx].data();
-        data.type = MetricType::Float;
-        metricType = MetricType::Float;
-        metricSize = metricsInfos[mi].floatMetrics[metric.storeIdx].size();
-      } break;
-      case MetricType::Unknown:
-      case MetricType::String: {
-        data.size = metricsInfos[mi].stringMetrics[metric.storeIdx].size();
-        data.Y = nullptr;
-        data.type = MetricType::String;
-        metricType = MetricType::String;
-        metricSize = metricsInfos[mi].stringMetrics[metric.storeIdx].size();
-      } break;
+    for (auto& point : data.points) {
+      minValue = std::min(minValue, point.min);
+      maxValue = std::max(maxValue, point.max);
     }
-    userData.emplace_back(data);
+    minDomain = std::min(minDomain, data.points.front().timestamp);
+    maxDomain = std::max(maxDomain, data.points.back().timestamp);
+    metricSize = std::max(metricSize, data.points.size());
+    userData.emplace_back(std::move(data));
   }
 
+  if (userData.empty()) {
+    return;
+  }
   maxDomain = std::max(minDomain + 1024, maxDomain);
 
   for (size_t ui = 0; ui < userData.size(); ++ui) {
     metricsToDisplay.push_back(&(userData[ui]));
   }
+  // Devices with less points than others repeat their last one.
   auto getterY = [](const void* hData, int idx) -> float {
-    auto histoData = reinterpret_cast<const MultiplotData*>(hData);
-    size_t pos = (histoData->first + static_cast<size_t>(idx)) % histoData->mod;
-    // size_t pos = (static_cast<size_t>(idx)) % histoData->mod;
-    assert(pos >= 0 && pos < 1024);
-    if (histoData->type == MetricType::Int) {
-      return static_cast<const int*>(histoData->Y)[pos];
-    } else if (histoData->type == MetricType::Float) {
-      return static_cast<const float*>(histoData->Y)[pos];
-    } else {
-      return 0;
-    }
+    auto& points = reinterpret_cast<const MultiplotData*>(hData)->points;
+    return points[std::min(static_cast<size_t>(idx), points.size() - 1)].avg;
   };
   auto getterX = [](const void* hData, int idx) -> size_t {
-    auto histoData = reinterpret_cast<const MultiplotData*>(hData);
-    size_t pos = (histoData->first + static_cast<size_t>(idx)) % histoData->mod;
-    //size_t pos = (static_cast<size_t>(idx)) % histoData->mod;
-    assert(pos >= 0 && pos < 1024);
-    return static_cast<const size_t*>(histoData->X)[pos];
+    auto& points = reinterpret_cast<const MultiplotData*>(hData)->points;
+    return points[std::min(static_cast<size_t>(idx), points.size() - 1)].timestamp;
   };
   switch (displayType) {
     case MetricsDisplayStyle::Histos:
@@ -322,14 +279,29 @@ void metricsTableRow(std::vector<ColumnInfo> columnInfos,
     }
     switch (info.type) {
       case MetricType::Int: {
+        if (row >= metricsInfo.intMetrics[info.index].size()) {
+          ImGui::TextUnformatted("-");
+          ImGui::NextColumn();
+          break;
+        }
         ImGui::Text("%i (%i)", metricsInfo.intMetrics[info.index][row], info.index);
         ImGui::NextColumn();
       } break;
       case MetricType::Float: {
+        if (row >= metricsInfo.floatMetrics[info.index].size()) {
+          ImGui::TextUnformatted("-");
+          ImGui::NextColumn();
+          break;
+        }
         ImGui::Text("%f (%i)", metricsInfo.floatMetrics[info.index][row], info.index);
         ImGui::NextColumn();
       } break;
       case MetricType::String: {
+        if (row >= metricsInfo.stringMetrics[info.index].size()) {
+          ImGui::TextUnformatted("-");
+          ImGui::NextColumn();
+          break;
+        }
         ImGui::Text("%s (%i)", metricsInfo.stringMetrics[info.index][row].data, info.index);
         ImGui::NextColumn();
       } break;
@@ -359,7 +331,15 @@ void historyBar(gui::WorkspaceGUIState& globalGUIState,
     return;
   }
 
-  auto currentMetricName = driverInfo.availableMetrics[globalGUIState.selectedMetric];
+  // The history of the rows out of the scrolling region is not extracted
+  ImVec2 plotSize(ImGui::CalcItemWidth(), ImGui::GetTextLineHeight() + ImGui::GetStyle().FramePadding.y * 2);
+  if (!ImGui::IsRectVisible(plotSize)) {
+    ImGui::Dummy(plotSize);
+    ImGui::NextColumn();
+    return;
+  }
+
+  auto& currentMetricName = driverInfo.availableMetrics[globalGUIState.selectedMetric];
 
   size_t i = DeviceMetricsHelper::metricIdxByName(currentMetricName, metricsInfo);
   // We did not find any plot, skipping this.
@@ -367,46 +347,16 @@ void historyBar(gui::WorkspaceGUIState& globalGUIState,
     ImGui::NextColumn();
     return;
   }
-  auto& metric = metricsInfo.metrics[i];
-
-  switch (metric.type) {
-    case MetricType::Int: {
-      HistoData<int> data;
-      data.mod = metricsInfo.timestamps[i].size();
-      data.first = metric.pos - data.mod;
-      data.size = metricsInfo.intMetrics[metric.storeIdx].size();
-      data.points = metricsInfo.intMetrics[metric.storeIdx].data();
-
-      auto getter = [](void* hData, int idx) -> float {
-        auto histoData = reinterpret_cast<HistoData<int>*>(hData);
-        size_t pos = (histoData->first + static_cast<size_t>(idx)) % histoData->mod;
-        assert(pos >= 0 && pos < 1024);
-        return histoData->points[pos];
-      };
-      ImGui::PlotLines(("##" + currentMetricName).c_str(), getter, &data, data.size);
-      ImGui::NextColumn();
-    } break;
-    case MetricType::Float: {
-      HistoData<float> data;
-      data.mod = metricsInfo.timestamps[i].size();
-      data.first = metric.pos - data.mod;
-      data.size = metricsInfo.floatMetrics[metric.storeIdx].size();
-      data.points = metricsInfo.floatMetrics[metric.storeIdx].data();
-
-      auto getter = [](void* hData, int idx) -> float {
-        auto histoData = reinterpret_cast<HistoData<float>*>(hData);
-        size_t pos = (histoData->first + static_cast<size_t>(idx)) % histoData->mod;
-        assert(pos >= 0 && pos < 1024);
-        return histoData->points[pos];
-      };
-      ImGui::PlotLines(("##" + currentMetricName).c_str(), getter, &data, data.size);
-      ImGui::NextColumn();
-    } break;
-    default:
-      ImGui::NextColumn();
-      return;
-      break;
+  std::vector<MetricPoint> points;
+  if (DeviceMetricsHelper::extractHistory(metricsInfo, i, rangeBegin, rangeEnd, 256, points) == 0) {
+    ImGui::NextColumn();
+    return;
   }
+  auto getter = [](void* hData, int idx) -> float {
+    return reinterpret_cast<std::vector<MetricPoint>*>(hData)->at(idx).avg;
+  };
+  ImGui::PlotLines(("##" + currentMetricName).c_str(), getter, &points, points.size());
+  ImGui::NextColumn();
 }
 
 /// Calculate where to find the coliumns for a give metric
@@ -481,7 +431,19 @@ void displayDeviceHistograms(gui::WorkspaceGUIState& state,
   static enum MetricsDisplayStyle currentStyle = MetricsDisplayStyle::Lines;
   ImGui::Combo("##Select style", reinterpret_cast<int*>(&currentStyle), plotStyles, IM_ARRAYSIZE(plotStyles));
 
-  // Calculate the full timestamp range for the selected metric
+  static char const* historyRanges[] = {
+    "recent",
+    "last minute",
+    "last 10 minutes",
+    "last hour"
+  };
+  static size_t const historyWindows[] = { 0, 60 * 1000, 600 * 1000, 3600 * 1000 };
+  ImGui::SameLine();
+  static int currentRange = 0;
+  ImGui::Combo("##Select range", &currentRange, historyRanges, IM_ARRAYSIZE(historyRanges));
+
+  // Calculate the timestamp range for the selected metric. The recent range
+  // is the one of the raw values, the other ones are served by the aggregates.
   size_t minTime = -1;
   size_t maxTime = 0;
   std::string currentMetricName;
@@ -494,21 +456,11 @@ void displayDeviceHistograms(gui::WorkspaceGUIState& state,
       }
       auto& metric = metricInfo.metrics[mi];
       auto& timestamps = metricInfo.timestamps[mi];
-
-      for (size_t ti = 0; ti != metricInfo.timestamps.size(); ++ti) {
-        size_t minRangePos = (metric.pos + ti) % metricInfo.timestamps.size();
-        size_t curMinTime = timestamps[minRangePos];
-        if (curMinTime == 0) {
-          continue;
-        }
-        minTime = minTime < curMinTime ? minTime : curMinTime;
-        if (minTime != 0 && minTime != -1) {
-          break;
-        }
-      }
-      size_t maxRangePos = (size_t)(metric.pos) - 1 % metricInfo.timestamps.size();
-      size_t curMaxTime = timestamps[maxRangePos];
-      maxTime = maxTime > curMaxTime ? maxTime : curMaxTime;
+      minTime = std::min(minTime, timestamps[metric.pos % timestamps.size()]);
+      maxTime = std::max(maxTime, metricInfo.maxDomain[mi]);
+    }
+    if (minTime != -1 && historyWindows[currentRange] != 0) {
+      minTime = maxTime > historyWindows[currentRange] ? maxTime - historyWindows[currentRange] : 0;
     }
   }
   if (minTime != -1) {
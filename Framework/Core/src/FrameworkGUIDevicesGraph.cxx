@@ -18,7 +18,10 @@
 #include "../src/WorkflowHelpers.h"
 #include "DebugGUI/imgui.h"
 #include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <map>
+#include <string>
 #include <vector>
 
 static inline ImVec2 operator+(const ImVec2& lhs, const ImVec2& rhs) { return ImVec2(lhs.x + rhs.x, lhs.y + rhs.y); }
@@ -104,16 +107,19 @@ struct Node {
   float Value;
   ImVec4 Color;
   int InputsCount, OutputsCount;
+  int GroupId; // the group of pipelined lanes, -1 for a single device
 
-  Node(int id, const char* name, float value, const ImVec4& color, int inputs_count, int outputs_count)
+  Node(int id, const char* name, float value, const ImVec4& color, int inputs_count, int outputs_count, int group_id = -1)
   {
     ID = id;
     strncpy(Name, name, 31);
     Name[31] = 0;
+    Size = ImVec2(166.f, 144.f); // Estimate until the node is displayed, used to cull it
     Value = value;
     Color = color;
     InputsCount = inputs_count;
     OutputsCount = outputs_count;
+    GroupId = group_id;
   }
 };
 
@@ -149,6 +155,183 @@ struct NodeLink {
   }
 };
 
+// Private helper struct for the lanes of a pipelined DataProcessor,
+// i.e. the devices named <name>_t<lane>
+struct LaneGroup {
+  std::string name;
+  std::vector<int> devices;
+  bool expanded;
+};
+
+// The graph as displayed. It is only recomputed when the topology changes
+// or when a group of lanes is collapsed or expanded, not at every frame.
+struct GraphLayout {
+  ImVector<Node> nodes;
+  ImVector<NodeLink> links;
+  ImVector<NodePos> positions;
+  std::vector<LaneGroup> groups;
+  std::vector<int> deviceGroup; // the group of each device
+  size_t specsCount = -1;       // the topology the layout was done for
+  bool dirty = true;
+};
+
+/// The name of the DataProcessor of a pipelined device, empty if the
+/// device is not a lane of a pipeline.
+std::string laneGroupName(std::string const& id)
+{
+  auto pos = id.rfind("_t");
+  if (pos == std::string::npos || pos + 2 == id.size()) {
+    return "";
+  }
+  for (size_t ci = pos + 2; ci < id.size(); ++ci) {
+    if (!isdigit(id[ci])) {
+      return "";
+    }
+  }
+  return id.substr(0, pos);
+}
+
+/// The device whose state is shown for a group: the first inactive lane,
+/// otherwise the one with the highest log level.
+int representativeLane(LaneGroup const& group, const std::vector<DeviceInfo>& infos)
+{
+  int result = group.devices.front();
+  for (auto di : group.devices) {
+    if (infos[di].active == false) {
+      return di;
+    }
+    if (infos[di].maxLogLevel > infos[result].maxLogLevel) {
+      result = di;
+    }
+  }
+  return result;
+}
+
+void groupLanes(GraphLayout& layout, const std::vector<DeviceSpec>& specs)
+{
+  std::map<std::string, int> groupsByName;
+  std::vector<LaneGroup> oldGroups;
+  oldGroups.swap(layout.groups);
+  layout.deviceGroup.assign(specs.size(), -1);
+  for (int si = 0; si < specs.size(); ++si) {
+    auto name = laneGroupName(specs[si].id);
+    if (name.empty()) {
+      continue;
+    }
+    auto group = groupsByName.find(name);
+    if (group == groupsByName.end()) {
+      group = groupsByName.insert(std::make_pair(name, layout.groups.size())).first;
+      layout.groups.push_back(LaneGroup{ name, {}, false });
+    }
+    layout.groups[group->second].devices.push_back(si);
+    layout.deviceGroup[si] = group->second;
+  }
+  // Keep the state of the groups which were already there
+  for (auto& oldGroup : oldGroups) {
+    auto group = groupsByName.find(oldGroup.name);
+    if (group != groupsByName.end()) {
+      layout.groups[group->second].expanded = oldGroup.expanded;
+    }
+  }
+}
+
+void prepareChannelView(GraphLayout& layout, const std::vector<DeviceSpec>& specs)
+{
+  auto& nodes = layout.nodes;
+  auto& links = layout.links;
+  auto& positions = layout.positions;
+  nodes.clear();
+  links.clear();
+  positions.clear();
+
+  // One node per device, but only one for all the lanes of a collapsed group
+  std::vector<int> deviceNode(specs.size(), -1);
+  for (int si = 0; si < specs.size(); ++si) {
+    auto gi = layout.deviceGroup[si];
+    if (gi != -1 && layout.groups[gi].devices.size() > 1 && layout.groups[gi].expanded == false) {
+      auto& group = layout.groups[gi];
+      if (group.devices.front() == si) {
+        nodes.push_back(Node(si, group.name.c_str(), 0.5f, ImColor(255, 100, 100), 0, 0, gi));
+      }
+      deviceNode[si] = nodes.Size - 1;
+      continue;
+    }
+    nodes.push_back(Node(si, specs[si].id.c_str(), 0.5f, ImColor(255, 100, 100), 0, 0));
+    deviceNode[si] = nodes.Size - 1;
+  }
+
+  struct LinkInfo {
+    int specId;
+    int outputId;
+  };
+  std::map<std::string, LinkInfo> linkToIndex;
+  for (int si = 0; si < specs.size(); ++si) {
+    int oi = 0;
+    for (auto&& output : specs[si].outputChannels) {
+      linkToIndex.insert(std::make_pair(output.name, LinkInfo{ si, oi }));
+      oi += 1;
+    }
+  }
+  // Do matching between inputs and outputs. The channels between the same
+  // nodes are shown only once, which matters for the collapsed groups.
+  std::map<std::pair<int, int>, int> nodeLinks;
+  for (int si = 0; si < specs.size(); ++si) {
+    auto& spec = specs[si];
+    for (auto& input : spec.inputChannels) {
+      auto const& outName = input.name;
+      auto const& out = linkToIndex.find(input.name);
+      if (out == linkToIndex.end()) {
+        LOG(ERROR) << "Could not find suitable node for " << outName;
+        continue;
+      }
+      auto producer = deviceNode[out->second.specId];
+      auto consumer = deviceNode[si];
+      if (producer == consumer || nodeLinks.count(std::make_pair(producer, consumer))) {
+        continue;
+      }
+      nodeLinks.insert(std::make_pair(std::make_pair(producer, consumer), links.Size));
+      links.push_back(NodeLink{ producer, nodes[producer].OutputsCount++, consumer, nodes[consumer].InputsCount++ });
+    }
+  }
+
+  // ImVector does boudary checks, so I bypass the case there is no
+  // edges.
+  std::vector<TopoIndexInfo> sortedNodes;
+  if (links.size()) {
+    sortedNodes = WorkflowHelpers::topologicalSort(nodes.Size, &(links[0].InputIdx), &(links[0].OutputIdx), sizeof(links[0]), links.size());
+  } else {
+    for (int ni = 0; ni < nodes.Size; ++ni) {
+      sortedNodes.push_back(TopoIndexInfo{ ni, 0 });
+    }
+  }
+  /// We resort them again, this time with the added layer information
+  std::sort(sortedNodes.begin(), sortedNodes.end());
+
+  std::vector<int> layerEntries(1024, 0);
+  std::vector<int> layerMax(1024, 0);
+  for (auto& node : sortedNodes) {
+    layerMax[node.layer < 1023 ? node.layer : 1023] += 1;
+  }
+
+  assert(nodes.Size == sortedNodes.size());
+  // Update positions
+  for (int ni = 0; ni < nodes.Size; ++ni) {
+    auto& node = sortedNodes[ni];
+    assert(node.index == ni);
+    auto layer = node.layer < 1023 ? node.layer : 1023;
+    int xpos = 40 + 240 * layer;
+    int ypos = 300 + (600 / (layerMax[layer] + 1)) * (layerEntries[layer] - layerMax[layer] / 2);
+    positions.push_back(NodePos{ ImVec2(xpos, ypos) });
+    layerEntries[layer] += 1;
+  }
+}
+
+/// Whether the rectangle intersects the visible part of the canvas
+bool isVisible(ImVec2 const& rectMin, ImVec2 const& rectMax, ImVec2 const& clipMin, ImVec2 const& clipMax)
+{
+  return rectMax.x >= clipMin.x && rectMin.x <= clipMax.x && rectMax.y >= clipMin.y && rectMin.y <= clipMax.y;
+}
+
 void showTopologyNodeGraph(WorkspaceGUIState& state,
                            const std::vector<DeviceInfo>& infos,
                            const std::vector<DeviceSpec>& specs,
@@ -164,80 +347,23 @@ void showTopologyNodeGraph(WorkspaceGUIState& state,
 
   ImGui::Begin("Physical topology view", nullptr, ImGuiWindowFlags_NoBringToFrontOnFocus | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize);
 
-  static ImVector<Node> nodes;
-  static ImVector<NodeLink> links;
-  static ImVector<NodePos> positions;
+  static GraphLayout layout;
+  auto& nodes = layout.nodes;
+  auto& links = layout.links;
+  auto& positions = layout.positions;
 
-  static bool inited = false;
   static ImVec2 scrolling = ImVec2(0.0f, 0.0f);
   static bool show_grid = true;
   static int node_selected = -1;
 
-  auto prepareChannelView = [&specs](ImVector<Node>& nodeList) {
-    struct LinkInfo {
-      int specId;
-      int outputId;
-    };
-    std::map<std::string, LinkInfo> linkToIndex;
-    for (int si = 0; si < specs.size(); ++si) {
-      int oi = 0;
-      for (auto&& output : specs[si].outputChannels) {
-        linkToIndex.insert(std::make_pair(output.name, LinkInfo{ si, oi }));
-        oi += 1;
-      }
-    }
-    // Do matching between inputs and outputs
-    for (int si = 0; si < specs.size(); ++si) {
-      auto& spec = specs[si];
-      nodeList.push_back(Node(si, spec.id.c_str(), 0.5f,
-                              ImColor(255, 100, 100),
-                              spec.inputChannels.size(),
-                              spec.outputChannels.size()));
-      int ii = 0;
-      for (auto& input : spec.inputChannels) {
-        auto const& outName = input.name;
-        auto const& out = linkToIndex.find(input.name);
-        if (out == linkToIndex.end()) {
-          LOG(ERROR) << "Could not find suitable node for " << outName;
-          continue;
-        }
-        links.push_back(NodeLink{ out->second.specId, out->second.outputId, si, ii });
-        ii += 1;
-      }
-    }
-
-    // ImVector does boudary checks, so I bypass the case there is no
-    // edges.
-    std::vector<TopoIndexInfo> sortedNodes = { { 0, 0 } };
-    if (links.size()) {
-      sortedNodes = WorkflowHelpers::topologicalSort(specs.size(), &(links[0].InputIdx), &(links[0].OutputIdx), sizeof(links[0]), links.size());
-    }
-    /// We resort them again, this time with the added layer information
-    std::sort(sortedNodes.begin(), sortedNodes.end());
-
-    std::vector<int> layerEntries(1024, 0);
-    std::vector<int> layerMax(1024, 0);
-    for (auto& node : sortedNodes) {
-      layerMax[node.layer < 1023 ? node.layer : 1023] += 1;
-    }
-
-    assert(specs.size() == sortedNodes.size());
-    // FIXME: display nodes using topological sort
-    // Update positions
-    for (int si = 0; si < specs.size(); ++si) {
-      auto& node = sortedNodes[si];
-      assert(node.index == si);
-      int xpos = 40 + 240 * node.layer;
-      int ypos = 300 + (600 / (layerMax[node.layer] + 1)) * (layerEntries[node.layer] - layerMax[node.layer] / 2);
-      positions.push_back(NodePos{ ImVec2(xpos, ypos) });
-      layerEntries[node.layer] += 1;
-    }
-
-  };
-
-  if (!inited) {
-    prepareChannelView(nodes);
-    inited = true;
+  if (layout.specsCount != specs.size()) {
+    groupLanes(layout, specs);
+    layout.specsCount = specs.size();
+    layout.dirty = true;
+  }
+  if (layout.dirty) {
+    prepareChannelView(layout, specs);
+    layout.dirty = false;
   }
 
   // Create our child canvas
@@ -279,20 +405,44 @@ void showTopologyNodeGraph(WorkspaceGUIState& state,
     ImGui::BeginChild("node_list", ImVec2(state.leftPaneSize, 0));
     ImGui::Text("Devices");
     ImGui::Separator();
-    for (int node_idx = 0; node_idx < nodes.Size; node_idx++) {
-      Node* node = &nodes[node_idx];
-      ImGui::PushID(node->ID);
-      if (ImGui::Selectable(node->Name, node->ID == node_selected)) {
+    auto deviceSelectable = [&](int di, const char* name) {
+      ImGui::PushID(di);
+      if (ImGui::Selectable(name, di == node_selected)) {
         if (ImGui::IsMouseDoubleClicked(0)) {
-          controls[node_selected].logVisible = true;
+          controls[di].logVisible = true;
         }
-        node_selected = node->ID;
+        node_selected = di;
       }
       if (ImGui::IsItemHovered()) {
-        node_hovered_in_list = node->ID;
+        node_hovered_in_list = di;
         open_context_menu |= ImGui::IsMouseClicked(1);
       }
       ImGui::PopID();
+    };
+    // The lanes of a pipeline are listed under their group, which
+    // is expanded in the graph when its tree node is open.
+    for (int di = 0; di < specs.size(); di++) {
+      auto gi = layout.deviceGroup[di];
+      if (gi == -1 || layout.groups[gi].devices.size() == 1) {
+        deviceSelectable(di, specs[di].id.c_str());
+        continue;
+      }
+      auto& group = layout.groups[gi];
+      if (group.devices.front() != di) {
+        continue;
+      }
+      ImGui::SetNextTreeNodeOpen(group.expanded);
+      bool expanded = ImGui::TreeNode(group.name.c_str(), "%s (%zu lanes)", group.name.c_str(), group.devices.size());
+      if (expanded != group.expanded) {
+        group.expanded = expanded;
+        layout.dirty = true;
+      }
+      if (expanded) {
+        for (auto lane : group.devices) {
+          deviceSelectable(lane, specs[lane].id.c_str());
+        }
+        ImGui::TreePop();
+      }
     }
     ImGui::EndChild();
     ImGui::SameLine();
@@ -319,9 +469,12 @@ void showTopologyNodeGraph(WorkspaceGUIState& state,
 
   ImVec2 offset = ImGui::GetCursorScreenPos() - scrolling;
   ImDrawList* draw_list = ImGui::GetWindowDrawList();
-  // Number of layers we need. 2 per node, plus 2 for
-  // the background stuff.
-  draw_list->ChannelsSplit((nodes.Size + 2) * 2);
+  // Only what intersects the canvas is displayed
+  ImVec2 clipMin = ImGui::GetWindowPos();
+  ImVec2 clipMax = clipMin + ImGui::GetWindowSize();
+  // Number of layers we need: 2 for the background stuff, 2 for
+  // all the nodes and 2 for the selected one, which goes to front.
+  draw_list->ChannelsSplit(6);
 
   // Display grid
   displayGrid(show_grid, offset, draw_list);
@@ -332,24 +485,31 @@ void showTopologyNodeGraph(WorkspaceGUIState& state,
     NodeLink* link = &links[link_idx];
     ImVec2 p1 = offset + NodePos::GetOutputSlotPos(nodes, positions, link->InputIdx, link->InputSlot);
     ImVec2 p2 = ImVec2(-3 * NODE_SLOT_RADIUS, 0) + offset + NodePos::GetInputSlotPos(nodes, positions, link->OutputIdx, link->OutputSlot);
+    if (!isVisible(ImVec2(std::min(p1.x, p2.x) - 50, std::min(p1.y, p2.y)), ImVec2(std::max(p1.x, p2.x) + 50, std::max(p1.y, p2.y)), clipMin, clipMax)) {
+      continue;
+    }
     draw_list->AddBezierCurve(p1, p1 + ImVec2(+50, 0), p2 + ImVec2(-50, 0), p2, ImColor(200, 200, 100), 3.0f);
   }
 
   // Display nodes
   for (int node_idx = 0; node_idx < nodes.Size; node_idx++) {
-    auto backgroundLayer = (node_idx + 1) * 2;
-    auto foregroundLayer = (node_idx + 1) * 2 + 1;
-    // Selected node goes to front
-    if (node_selected == node_idx) {
-      backgroundLayer = (nodes.Size + 1) * 2;
-      foregroundLayer = (nodes.Size + 1) * 2 + 1;
-    }
     Node* node = &nodes[node_idx];
     NodePos* pos = &positions[node_idx];
-    const DeviceInfo& info = infos[node_idx];
+    ImVec2 node_rect_min = offset + pos->pos;
+    if (!isVisible(node_rect_min, node_rect_min + node->Size, clipMin, clipMax)) {
+      continue;
+    }
+    auto backgroundLayer = 2;
+    auto foregroundLayer = 3;
+    // Selected node goes to front
+    if (node_selected == node->ID) {
+      backgroundLayer = 4;
+      foregroundLayer = 5;
+    }
+    auto group = node->GroupId == -1 ? nullptr : &layout.groups[node->GroupId];
+    const DeviceInfo& info = infos[group ? representativeLane(*group, infos) : node->ID];
 
     ImGui::PushID(node->ID);
-    ImVec2 node_rect_min = offset + pos->pos;
 
     // Display node contents first
     draw_list->ChannelsSetCurrent(foregroundLayer);
@@ -357,7 +517,11 @@ void showTopologyNodeGraph(WorkspaceGUIState& state,
     ImGui::SetCursorScreenPos(node_rect_min + NODE_WINDOW_PADDING);
     ImGui::BeginGroup(); // Lock horizontal position
     ImGui::Text("%s", node->Name);
-    gui::displayDataRelayer(metricsInfos[node->ID], infos[node->ID], ImVec2(140., 90.));
+    if (group) {
+      ImGui::Text("%zu lanes", group->devices.size());
+    } else {
+      gui::displayDataRelayer(metricsInfos[node->ID], infos[node->ID], ImVec2(140., 90.));
+    }
     ImGui::EndGroup();
 
     // Save the size of what we have emitted and whether any of the widgets are being used
@@ -384,8 +548,6 @@ void showTopologyNodeGraph(WorkspaceGUIState& state,
       node_selected = node->ID;
     if (node_moving_active && ImGui::IsMouseDragging(0))
       pos->pos = pos->pos + ImGui::GetIO().MouseDelta;
-    if (ImGui::IsWindowHovered() && !node_moving_active && ImGui::IsMouseDragging(0))
-      scrolling = scrolling - ImVec2(ImGui::GetIO().MouseDelta.x / 4.f, ImGui::GetIO().MouseDelta.y / 4.f);
 
     auto nodeBg = decideColorForNode(info);
 
@@ -415,6 +577,11 @@ void showTopologyNodeGraph(WorkspaceGUIState& state,
   }
   draw_list->ChannelsMerge();
 
+  // Dragging the background scrolls, once per frame whatever the number of nodes
+  if (ImGui::IsWindowHovered() && !ImGui::IsAnyItemActive() && ImGui::IsMouseDragging(0)) {
+    scrolling = scrolling - ImGui::GetIO().MouseDelta;
+  }
+
   // Open context menu
   if (!ImGui::IsAnyItemHovered() && ImGui::IsMouseHoveringWindow() && ImGui::IsMouseClicked(1)) {
     node_selected = node_hovered_in_list = node_hovered_in_scene = -1;
@@ -9,6 +9,7 @@
 // or submit itself to any jurisdiction.
 #include "Framework/InputRecord.h"
 #include "Framework/InputSpec.h"
+#include "Framework/MemoryAccounting.h"
 #include <fairmq/FairMQMessage.h>
 #include <cassert>
 
@@ -61,6 +62,16 @@ InputRecord::getPos(std::string const &binding) const {
   return -1;
 }
 
+void InputRecord::accountDeserialized(DataRef const& ref) const
+{
+  if (mAccounting == nullptr) {
+    return;
+  }
+  auto size = DataRefUtils::getPayloadSize(ref);
+  mAccounting->allocated(MemorySource::Deserialized, size);
+  mDeserializedBytes += size;
+}
+
 bool
 InputRecord::isValid(char const *s) {
   DataRef ref = get(s);
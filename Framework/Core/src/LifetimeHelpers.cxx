@@ -22,6 +22,17 @@
 
 #include <fairmq/FairMQDevice.h>
 
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <vector>
+
 using namespace o2::header;
 using namespace fair;
 
@@ -142,34 +153,115 @@ ExpirationHandler::Handler LifetimeHelpers::doNothing()
   return [](ServiceRegistry&, PartRef& ref, uint64_t) -> void { return; };
 }
 
-// We simply put everything in a stringstream and read it afterwards.
-size_t readToMessage(void* p, size_t size, size_t nmemb, void* userdata)
+namespace
 {
-  if (nmemb == 0) {
-    return 0;
+/// Payload of a condition object with its validity (in ms), as downloaded from CCDB
+struct CachedCondition {
+  uint64_t validFrom = 0;
+  uint64_t validUntil = 0;
+  std::vector<char> payload;
+
+  bool isValid(uint64_t timestamp) const { return validFrom <= timestamp && timestamp < validUntil; }
+};
+
+/// Condition objects retrieved by this process, shared by all the condition inputs of the device.
+/// The expiration handlers are invoked by the device thread only.
+std::map<std::string, std::vector<CachedCondition>>& conditionCache()
+{
+  static std::map<std::string, std::vector<CachedCondition>> cache;
+  return cache;
+}
+
+// We simply put everything in a buffer and read it afterwards.
+size_t readToBuffer(void* p, size_t size, size_t nmemb, void* userdata)
+{
+  auto buffer = static_cast<std::vector<char>*>(userdata);
+  buffer->insert(buffer->end(), static_cast<char*>(p), static_cast<char*>(p) + size * nmemb);
+  return size * nmemb;
+}
+
+// The validity of the object is given by the Valid-From and Valid-Until headers.
+size_t readValidity(char* buffer, size_t size, size_t nitems, void* userdata)
+{
+  auto condition = static_cast<CachedCondition*>(userdata);
+  std::string line(buffer, size * nitems);
+  auto colon = line.find(':');
+  if (colon != std::string::npos) {
+    std::string key = line.substr(0, colon);
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+    if (key == "valid-from") {
+      condition->validFrom = strtoull(line.c_str() + colon + 1, nullptr, 10);
+    } else if (key == "valid-until") {
+      condition->validUntil = strtoull(line.c_str() + colon + 1, nullptr, 10);
+    }
   }
-  if (size == 0) {
-    return 0;
+  return size * nitems;
+}
+
+/// Find an object valid at @a timestamp in the cache directory @a dir, whose files are
+/// named <validFrom>_<validUntil>.
+bool readCachedCondition(std::string const& dir, uint64_t timestamp, CachedCondition& condition)
+{
+  DIR* d = opendir(dir.c_str());
+  if (d == nullptr) {
+    return false;
   }
-  o2::vector<char>* buffer = (o2::vector<char>*)userdata;
-  size_t oldSize = buffer->size();
-  buffer->resize(oldSize + nmemb * size);
-  memcpy(buffer->data() + oldSize, userdata, nmemb * size);
-  return size * nmemb;
+  bool found = false;
+  while (auto entry = readdir(d)) {
+    unsigned long long validFrom, validUntil;
+    char extra;
+    if (sscanf(entry->d_name, "%llu_%llu%c", &validFrom, &validUntil, &extra) != 2 ||
+        validFrom > timestamp || timestamp >= validUntil) {
+      continue;
+    }
+    std::ifstream file(dir + "/" + entry->d_name, std::ios::binary | std::ios::ate);
+    if (!file) {
+      continue;
+    }
+    condition.validFrom = validFrom;
+    condition.validUntil = validUntil;
+    condition.payload.resize(file.tellg());
+    file.seekg(0);
+    if (file.read(condition.payload.data(), condition.payload.size())) {
+      found = true;
+      break;
+    }
+  }
+  closedir(d);
+  return found;
+}
+
+/// Store an object in the cache directory @a dir, such that the other devices of the node find it.
+void writeCachedCondition(std::string const& dir, CachedCondition const& condition)
+{
+  for (size_t pos = dir.find('/', 1); pos != std::string::npos; pos = dir.find('/', pos + 1)) {
+    mkdir(dir.substr(0, pos).c_str(), 0777);
+  }
+  mkdir(dir.c_str(), 0777);
+  auto name = dir + "/" + std::to_string(condition.validFrom) + "_" + std::to_string(condition.validUntil);
+  // written under a temporary name first, the other devices only see complete files
+  auto tmpName = name + ".tmp" + std::to_string(getpid());
+  std::ofstream file(tmpName, std::ios::binary);
+  if (!file.write(condition.payload.data(), condition.payload.size())) {
+    LOG(ERROR) << "fetchFromCCDBCache: Unable to write " << name;
+    return;
+  }
+  file.close();
+  rename(tmpName.c_str(), name.c_str());
 }
+} // namespace
 
 /// Fetch an object from CCDB if the record is expired. The actual
 /// name of the object is given by:
 ///
 /// "<namespace>/<InputRoute.origin>/<InputRoute.description>"
 ///
-/// FIXME: actually implement the fetching
-/// FIXME: for the moment we always go to CCDB every time we are expired.
-/// FIXME: this should really be done in the common fetcher.
+/// The objects are kept with their validity, CCDB is accessed again only
+/// once the validity of the inputs has ended.
 /// FIXME: provide a way to customize the namespace from the ProcessingContext
-ExpirationHandler::Handler LifetimeHelpers::fetchFromCCDBCache(ConcreteDataMatcher const& matcher, std::string const& prefix, std::string const& sourceChannel)
+ExpirationHandler::Handler LifetimeHelpers::fetchFromCCDBCache(ConcreteDataMatcher const& matcher, std::string const& prefix, std::string const& sourceChannel, std::string const& cacheDir)
 {
-  return [ matcher, sourceChannel, serverUrl = prefix ](ServiceRegistry & services, PartRef & ref, uint64_t timestamp)->void
+  return [ matcher, sourceChannel, serverUrl = prefix, cacheDir ](ServiceRegistry & services, PartRef & ref, uint64_t timestamp)->void
   {
     // We should invoke the handler only once.
     assert(!ref.header);
@@ -178,49 +270,63 @@ ExpirationHandler::Handler LifetimeHelpers::fetchFromCCDBCache(ConcreteDataMatch
     auto& rawDeviceService = services.get<RawDeviceService>();
     auto&& transport = rawDeviceService.device()->GetChannel(sourceChannel, 0).Transport();
     auto channelAlloc = o2::pmr::getTransportAllocator(transport);
-    o2::vector<char> payloadBuffer;
-    payloadBuffer.reserve(10000); // we begin with messages of 10KB
-    auto payload = o2::pmr::getMessage(std::forward<o2::vector<char>>(payloadBuffer), transport->GetMemoryResource());
-
-    CURL* curl = curl_easy_init();
-    if (curl == nullptr) {
-      throw std::runtime_error("fetchFromCCDBCache: Unable to initialise CURL");
-    }
-    CURLcode res;
-    auto path = std::string("/") + matcher.origin.as<std::string>() + "/" + matcher.description.as<std::string>() + "/" + std::to_string(timestamp / 1000);
-    auto url = serverUrl + path;
-    LOG(INFO) << "fetchFromCCDBCache: Fetching " << url;
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &payloadBuffer);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, readToMessage);
-
-    res = curl_easy_perform(curl);
-    if (res != CURLE_OK) {
-      throw std::runtime_error(std::string("fetchFromCCDBCache: Unable to fetch ") + url + " from CCDB");
-    }
-    long responseCode;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
 
-    if (responseCode != 200) {
-      throw std::runtime_error(std::string("fetchFromCCDBCache: HTTP error ") + std::to_string(responseCode) + " while fetching " + url + " from CCDB");
+    // The timestamp of the timeslice is in microseconds, the validity of the objects in milliseconds.
+    auto key = matcher.origin.as<std::string>() + "/" + matcher.description.as<std::string>();
+    auto& cached = conditionCache()[key];
+    auto condition = std::find_if(cached.begin(), cached.end(), [timestamp](CachedCondition const& c) { return c.isValid(timestamp / 1000); });
+    if (condition == cached.end()) {
+      CachedCondition fetched;
+      if (cacheDir.empty() || readCachedCondition(cacheDir + "/" + key, timestamp / 1000, fetched) == false) {
+        CURL* curl = curl_easy_init();
+        if (curl == nullptr) {
+          throw std::runtime_error("fetchFromCCDBCache: Unable to initialise CURL");
+        }
+        auto url = serverUrl + "/" + key + "/" + std::to_string(timestamp / 1000);
+        LOG(INFO) << "fetchFromCCDBCache: Fetching " << url;
+
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &fetched.payload);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, readToBuffer);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &fetched);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, readValidity);
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+
+        CURLcode res = curl_easy_perform(curl);
+        long responseCode = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+        curl_easy_cleanup(curl);
+        if (res != CURLE_OK) {
+          throw std::runtime_error(std::string("fetchFromCCDBCache: Unable to fetch ") + url + " from CCDB");
+        }
+        if (responseCode != 200) {
+          throw std::runtime_error(std::string("fetchFromCCDBCache: HTTP error ") + std::to_string(responseCode) + " while fetching " + url + " from CCDB");
+        }
+        if (fetched.isValid(timestamp / 1000) == false) {
+          // no usable validity, the object is fetched again for the next timeslice
+          fetched.validFrom = fetched.validUntil = 0;
+        } else if (cacheDir.empty() == false) {
+          writeCachedCondition(cacheDir + "/" + key, fetched);
+        }
+      }
+      cached.push_back(std::move(fetched));
+      condition = cached.end() - 1;
     }
 
-    curl_easy_cleanup(curl);
-
     DataHeader dh;
     dh.dataOrigin = matcher.origin;
     dh.dataDescription = matcher.description;
     dh.subSpecification = matcher.subSpec;
-    // FIXME: should use curl_off_t and CURLINFO_SIZE_DOWNLOAD_T, but
-    //        apparently not there on some platforms.
-    double dl;
-    res = curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD, &dl);
-    dh.payloadSize = payloadBuffer.size();
+    dh.payloadSize = condition->payload.size();
     dh.payloadSerializationMethod = gSerializationMethodNone;
 
     DataProcessingHeader dph{ timestamp, 1 };
     auto header = o2::pmr::getMessage(o2::header::Stack{ channelAlloc, dh, dph });
+    auto payload = transport->CreateMessage(condition->payload.size());
+    memcpy(payload->GetData(), condition->payload.data(), condition->payload.size());
+    if (condition->validUntil == 0) {
+      cached.erase(condition);
+    }
 
     ref.header = std::move(header);
     ref.payload = std::move(payload);
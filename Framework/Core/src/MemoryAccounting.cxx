@@ -0,0 +1,108 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/MemoryAccounting.h"
+
+#include <Monitoring/Monitoring.h>
+#include <boost/container/pmr/global_resource.hpp>
+
+#include <string>
+
+using Monitoring = o2::monitoring::Monitoring;
+using Metric = o2::monitoring::Metric;
+using Key = o2::monitoring::tags::Key;
+using Value = o2::monitoring::tags::Value;
+
+namespace o2
+{
+namespace framework
+{
+
+MemoryAccounting::MemoryAccounting() : mResource{ *this }
+{
+  for (size_t i = 0; i < mLive.size(); ++i) {
+    mLive[i] = 0;
+    mPeak[i] = 0;
+  }
+}
+
+void MemoryAccounting::add(size_t which, int64_t bytes)
+{
+  auto live = mLive[which].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  auto peak = mPeak[which].load(std::memory_order_relaxed);
+  while (live > peak && !mPeak[which].compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+void MemoryAccounting::allocated(MemorySource source, size_t bytes)
+{
+  add(index(source), bytes);
+  add(index(MemorySource::Count), bytes);
+}
+
+void MemoryAccounting::released(MemorySource source, size_t bytes)
+{
+  add(index(source), -static_cast<int64_t>(bytes));
+  add(index(MemorySource::Count), -static_cast<int64_t>(bytes));
+}
+
+void MemoryAccounting::resetPeaks()
+{
+  for (size_t i = 0; i < mLive.size(); ++i) {
+    mPeak[i].store(mLive[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+}
+
+char const* MemoryAccounting::name(MemorySource source)
+{
+  switch (source) {
+    case MemorySource::Outputs:
+      return "outputs";
+    case MemorySource::Inputs:
+      return "inputs";
+    case MemorySource::Deserialized:
+      return "deserialized";
+    case MemorySource::User:
+      return "user";
+    default:
+      return "total";
+  }
+}
+
+void MemoryAccounting::report(Monitoring& monitoring)
+{
+  for (size_t i = 0; i < mLive.size(); ++i) {
+    std::string prefix = std::string("memory/") + name(static_cast<MemorySource>(i));
+    monitoring.send(Metric{ static_cast<double>(mLive[i].load(std::memory_order_relaxed)), prefix + "/live_bytes" }.addTag(Key::Subsystem, Value::DPL));
+    monitoring.send(Metric{ static_cast<double>(mPeak[i].load(std::memory_order_relaxed)), prefix + "/peak_bytes" }.addTag(Key::Subsystem, Value::DPL));
+  }
+  resetPeaks();
+}
+
+MemoryAccounting::AccountingResource::AccountingResource(MemoryAccounting& accounting)
+  : mAccounting{ accounting },
+    mUpstream{ boost::container::pmr::new_delete_resource() }
+{
+}
+
+void* MemoryAccounting::AccountingResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+  auto p = mUpstream->allocate(bytes, alignment);
+  mAccounting.allocated(MemorySource::User, bytes);
+  return p;
+}
+
+void MemoryAccounting::AccountingResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+  mUpstream->deallocate(p, bytes, alignment);
+  mAccounting.released(MemorySource::User, bytes);
+}
+
+} // namespace framework
+} // namespace o2
@@ -0,0 +1,62 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/MetricHandles.h"
+
+#include <Monitoring/Monitoring.h>
+
+using Key = o2::monitoring::tags::Key;
+using Value = o2::monitoring::tags::Value;
+using Metric = o2::monitoring::Metric;
+
+namespace o2
+{
+namespace framework
+{
+
+MetricHandles::Handle MetricHandles::add(std::string name, bool dplSubsystem)
+{
+  mNames.emplace_back(std::move(name));
+  mDplSubsystem.push_back(dplSubsystem);
+  mValues.push_back(0);
+  mSentValues.push_back(0);
+  mSent.push_back(false);
+  return mValues.size() - 1;
+}
+
+MetricHandles::Handle MetricHandles::addRange(std::string const& prefix, size_t n, bool dplSubsystem)
+{
+  auto first = mValues.size();
+  for (size_t i = 0; i < n; ++i) {
+    add(prefix + std::to_string(i), dplSubsystem);
+  }
+  return first;
+}
+
+size_t MetricHandles::flush(monitoring::Monitoring& monitoring, bool onlyChanged)
+{
+  size_t sent = 0;
+  for (size_t hi = 0; hi < mValues.size(); ++hi) {
+    if (onlyChanged && mSent[hi] && mSentValues[hi] == mValues[hi]) {
+      continue;
+    }
+    Metric metric{ mValues[hi], mNames[hi] };
+    if (mDplSubsystem[hi]) {
+      metric.addTag(Key::Subsystem, Value::DPL);
+    }
+    monitoring.send(std::move(metric));
+    mSentValues[hi] = mValues[hi];
+    mSent[hi] = true;
+    ++sent;
+  }
+  return sent;
+}
+
+} // namespace framework
+} // namespace o2
@@ -0,0 +1,87 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef FRAMEWORK_METRICSCHANNELBACKEND_H
+#define FRAMEWORK_METRICSCHANNELBACKEND_H
+
+#include "Framework/DeviceMetricsChannel.h"
+
+#include <Monitoring/Backend.h>
+#include <Monitoring/Metric.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace o2
+{
+namespace framework
+{
+
+/// Monitoring backend which sends the metrics of a device to the driver via
+/// the DeviceMetricsChannel, rather than printing them on stdout. Integer
+/// values are sent as Int, double and uint64_t values as Float and strings
+/// as String, like the driver stores them. Tags are not forwarded, as the
+/// text metrics do not carry them either.
+class MetricsChannelBackend : public o2::monitoring::Backend
+{
+ public:
+  MetricsChannelBackend(std::unique_ptr<DeviceMetricsChannel> channel)
+    : mChannel{ std::move(channel) }
+  {
+  }
+
+  void send(o2::monitoring::Metric const& metric) override
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    push(metric);
+  }
+
+  void send(std::vector<o2::monitoring::Metric>&& metrics) override
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto const& metric : metrics) {
+      push(metric);
+    }
+  }
+
+  void sendMultiple(std::string, std::vector<o2::monitoring::Metric>&& metrics) override
+  {
+    send(std::move(metrics));
+  }
+
+  void addGlobalTag(std::string_view, std::string_view) override {}
+
+ private:
+  void push(o2::monitoring::Metric const& metric)
+  {
+    size_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(metric.getTimestamp().time_since_epoch()).count();
+    auto const& name = metric.getName();
+    auto const& value = metric.getValue();
+    if (auto v = std::get_if<int>(&value)) {
+      mChannel->push(name, *v, timestamp);
+    } else if (auto v = std::get_if<double>(&value)) {
+      mChannel->push(name, static_cast<float>(*v), timestamp);
+    } else if (auto v = std::get_if<uint64_t>(&value)) {
+      mChannel->push(name, static_cast<float>(*v), timestamp);
+    } else if (auto v = std::get_if<std::string>(&value)) {
+      mChannel->push(name, std::string_view(*v), timestamp);
+    }
+  }
+
+  std::unique_ptr<DeviceMetricsChannel> mChannel;
+  std::mutex mMutex;
+};
+
+} // namespace framework
+} // namespace o2
+
+#endif // FRAMEWORK_METRICSCHANNELBACKEND_H
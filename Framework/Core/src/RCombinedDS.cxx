@@ -72,6 +72,38 @@ char const* RCombinedDSIndexHelpers::combinationRuleAsString(BlockCombinationRul
   throw std::runtime_error("Unknown BlockCombinationRule");
 }
 
+std::vector<std::pair<ULong64_t, ULong64_t>>
+  RCombinedDSIndexHelpers::splitRanges(std::vector<std::pair<ULong64_t, ULong64_t>> ranges,
+                                       unsigned int nSlots,
+                                       unsigned int rangesPerSlot)
+{
+  std::sort(ranges.begin(), ranges.end());
+  std::vector<std::pair<ULong64_t, ULong64_t>> merged;
+  ULong64_t nEntries = 0;
+  for (auto& range : ranges) {
+    if (range.first >= range.second) {
+      continue;
+    }
+    nEntries += range.second - range.first;
+    if (!merged.empty() && merged.back().second == range.first) {
+      merged.back().second = range.second;
+    } else {
+      merged.push_back(range);
+    }
+  }
+  ULong64_t nRanges = std::max(1U, nSlots) * std::max(1U, rangesPerSlot);
+  ULong64_t rangeSize = std::max<ULong64_t>(1, (nEntries + nRanges - 1) / nRanges);
+
+  std::vector<std::pair<ULong64_t, ULong64_t>> result;
+  result.reserve(nRanges + merged.size());
+  for (auto& range : merged) {
+    for (auto begin = range.first; begin < range.second; begin += rangeSize) {
+      result.emplace_back(begin, std::min(begin + rangeSize, range.second));
+    }
+  }
+  return result;
+}
+
 std::vector<std::pair<ULong64_t, ULong64_t>>
   RCombinedDSCrossJoinIndex::BuildIndex(std::unique_ptr<RDataFrame>& left,
                                         std::unique_ptr<RDataFrame>& right)
@@ -96,15 +128,7 @@ std::vector<std::pair<ULong64_t, ULong64_t>>
     throw std::runtime_error("Union can be performed only with two datasources which have the same amount of entries");
   }
   std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
-  // FIXME: should we really use the min between two number of slots?
-  auto nSlots = std::min(left->GetLoopManager()->GetNSlots(), right->GetLoopManager()->GetNSlots());
-  assert(nSlots > 0);
-  auto deltaSize = rightCount / nSlots;
-  ULong64_t i = 0;
-  for (; i < (nSlots - 1); ++i) {
-    ranges.emplace_back(std::pair<ULong64_t, ULong64_t>(deltaSize * i, deltaSize * (i + 1)));
-  }
-  ranges.emplace_back(std::pair<ULong64_t, ULong64_t>(i * deltaSize, rightCount));
+  ranges.emplace_back(0, rightCount);
   return ranges;
 }
 
@@ -197,8 +221,9 @@ void RCombinedDS::InitSlot(unsigned int slot, ULong64_t entry)
 void RCombinedDS::SetNSlots(unsigned int nSlots)
 {
   assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
-  /// FIXME: For the moment we simply forward the nSlots, not sure this is the
-  ///        right thing to do.
+  fNSlots = nSlots;
+  /// The slots are forwarded one to one to the inputs, whose entries get
+  /// set concurrently for the different slots.
   fLeft->SetNSlots(nSlots);
   fRight->SetNSlots(nSlots);
 }
@@ -220,7 +245,13 @@ std::vector<void*> RCombinedDS::GetColumnReadersImpl(std::string_view colName, c
 
 void RCombinedDS::Initialise()
 {
-  fEntryRanges = fIndex->BuildIndex(fLeftDF, fRightDF);
+  // The index is built only once and then shared, read only, by all the
+  // slots and all the event loops.
+  if (fIndexBuilt == false) {
+    fIndexRanges = RCombinedDSIndexHelpers::splitRanges(fIndex->BuildIndex(fLeftDF, fRightDF), fNSlots);
+    fIndexBuilt = true;
+  }
+  fEntryRanges = fIndexRanges;
 
   fLeft->Initialise();
   fRight->Initialise();
@@ -42,5 +42,25 @@ InjectorFunction readoutAdapter(OutputSpec const& spec)
   };
 }
 
+InjectorFunction readoutSuperpageAdapter(OutputSpec const& spec)
+{
+  auto counter = std::make_shared<uint64_t>(0);
+
+  return [spec, counter](FairMQDevice& device, FairMQParts& parts, int index) {
+    for (size_t i = 0; i < parts.Size(); ++i) {
+      DataHeader dh;
+      dh.dataOrigin = spec.origin;
+      dh.dataDescription = spec.description;
+      dh.subSpecification = spec.subSpec;
+      dh.payloadSize = parts.At(i)->GetSize();
+      dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+
+      DataProcessingHeader dph{ *counter, 0 };
+      (*counter) += 1UL;
+      broadcastSharedMessage(device, o2::header::Stack{ dh, dph }, std::move(parts.At(i)), index);
+    }
+  };
+}
+
 } // namespace framework
 } // namespace o2
@@ -9,7 +9,10 @@
 // or submit itself to any jurisdiction.
 #include <Framework/TMessageSerializer.h>
 #include <algorithm>
+#include <cstring>
 #include <memory>
+#include <stdexcept>
+#include <unordered_map>
 
 using namespace o2::framework;
 
@@ -96,6 +99,65 @@ void TMessageSerializer::updateStreamers(const FairTMessage& message, StreamerLi
   }
 }
 
+namespace
+{
+/// The message the current thread is serializing into. ROOT grows its
+/// buffers with a plain function, so this is how reallocateMessage finds
+/// the creator and the message to replace.
+struct MessageOutput {
+  TMessageSerializer::MessageCreator const& creator;
+  std::unique_ptr<FairMQMessage> message;
+};
+thread_local MessageOutput* gMessageOutput = nullptr;
+
+/// The size of the last object of each class serialized by this thread
+thread_local std::unordered_map<const TClass*, size_t> gSizeHints;
+
+constexpr size_t DEFAULT_SIZE_HINT = 4096;
+/// The space TBuffer keeps at the end of its buffer (kExtraSpace in
+/// TBuffer.cxx), which is part of the message as well
+constexpr size_t BUFFER_EXTRA_SPACE = 8;
+
+/// ReAllocCharFun_t replacing the message with a larger one, which gets the
+/// @a copySize bytes written so far
+char* reallocateMessage(char* current, size_t newSize, size_t copySize)
+{
+  auto larger = gMessageOutput->creator(newSize);
+  if (current != nullptr && copySize > 0) {
+    std::memcpy(larger->GetData(), current, std::min(copySize, newSize));
+  }
+  gMessageOutput->message = std::move(larger);
+  return static_cast<char*>(gMessageOutput->message->GetData());
+}
+} // namespace
+
+std::unique_ptr<FairMQMessage> TMessageSerializer::serializeToMessage(MessageCreator const& creator,
+                                                                      const void* input, const TClass* cl)
+{
+  if (cl == nullptr) {
+    throw std::runtime_error("can not serialize an object without class info");
+  }
+  auto hint = gSizeHints.find(cl);
+  MessageOutput output{ creator, creator((hint != gSizeHints.end() ? hint->second : DEFAULT_SIZE_HINT) + BUFFER_EXTRA_SPACE) };
+  auto previous = gMessageOutput;
+  gMessageOutput = &output;
+
+  FairTMessage tm(kMESS_OBJECT);
+  tm.SetBuffer(output.message->GetData(), output.message->GetSize(), kFALSE, reallocateMessage);
+  // The buffer starts with the header written by the TMessage constructor:
+  // the space reserved for the length and the kind of message.
+  tm << UInt_t(0);
+  tm << UInt_t(kMESS_OBJECT);
+  tm.WriteObjectAny(input, cl);
+  size_t length = tm.Length();
+  tm.DetachBuffer();
+
+  gMessageOutput = previous;
+  gSizeHints[cl] = length;
+  output.message->SetUsedSize(length);
+  return std::move(output.message);
+}
+
 void TMessageSerializer::updateStreamers(const TObject* object)
 {
   FairTMessage msg(kMESS_OBJECT);
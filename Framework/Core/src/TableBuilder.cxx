@@ -14,6 +14,8 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
+#include <arrow/array.h>
+#include <arrow/buffer.h>
 #include <arrow/builder.h>
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
@@ -42,6 +44,19 @@ void ArrayFromVector(const std::vector<C_TYPE>& values, std::shared_ptr<arrow::A
   assert(status.ok());
 }
 
+/// A buffer on memory it does not own, which keeps the owner of the memory alive
+class AdoptedBuffer : public arrow::Buffer
+{
+ public:
+  AdoptedBuffer(uint8_t const* data, int64_t size, std::shared_ptr<void> owner)
+    : arrow::Buffer(data, size), mOwner{ std::move(owner) }
+  {
+  }
+
+ private:
+  std::shared_ptr<void> mOwner;
+};
+
 } // namespace
 
 namespace o2
@@ -49,6 +64,15 @@ namespace o2
 namespace framework
 {
 
+std::shared_ptr<arrow::Array> TableBuilderHelpers::adoptArray(std::shared_ptr<arrow::DataType> type, void const* data,
+                                                             size_t length, size_t valueSize, std::shared_ptr<void> owner)
+{
+  auto buffer = std::make_shared<AdoptedBuffer>(reinterpret_cast<uint8_t const*>(data), length * valueSize, std::move(owner));
+  // no validity bitmap, all the values are valid
+  auto arrayData = arrow::ArrayData::Make(type, length, { nullptr, buffer }, 0);
+  return arrow::MakeArray(arrayData);
+}
+
 std::shared_ptr<arrow::Table>
   TableBuilder::finalize()
 {
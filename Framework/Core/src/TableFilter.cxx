@@ -0,0 +1,241 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/TableFilter.h"
+
+#include <arrow/array.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <arrow/type.h>
+
+#include <stdexcept>
+
+namespace o2
+{
+namespace analysis
+{
+
+struct Filter::Node {
+  enum struct Kind : int {
+    Compare,
+    And,
+    Or,
+    Not
+  };
+  Kind kind;
+  std::string column;
+  CompareOp op = CompareOp::Equal;
+  double value = 0;
+  std::shared_ptr<Node const> lhs;
+  std::shared_ptr<Node const> rhs;
+};
+
+namespace
+{
+using Node = Filter::Node;
+
+template <typename ARRAY, typename V>
+void compareArray(arrow::Array const& array, CompareOp op, V value, uint8_t* mask)
+{
+  auto const& typed = static_cast<ARRAY const&>(array);
+  filter_kernels::compare(typed.raw_values(), typed.length(), op, value, mask);
+}
+
+void compareColumn(arrow::RecordBatch const& batch, Node const& node, uint8_t* mask)
+{
+  auto index = batch.schema()->GetFieldIndex(node.column);
+  if (index < 0) {
+    throw std::runtime_error("Filter: no column " + node.column);
+  }
+  auto const& array = *batch.column(index);
+  switch (array.type_id()) {
+    case arrow::Type::BOOL: {
+      auto const& typed = static_cast<arrow::BooleanArray const&>(array);
+      std::vector<uint8_t> values(typed.length());
+      for (int64_t i = 0; i < typed.length(); ++i) {
+        values[i] = typed.Value(i);
+      }
+      filter_kernels::compare(values.data(), typed.length(), node.op, node.value, mask);
+      break;
+    }
+    case arrow::Type::INT8:
+      compareArray<arrow::Int8Array>(array, node.op, node.value, mask);
+      break;
+    case arrow::Type::INT16:
+      compareArray<arrow::Int16Array>(array, node.op, node.value, mask);
+      break;
+    case arrow::Type::INT32:
+      compareArray<arrow::Int32Array>(array, node.op, node.value, mask);
+      break;
+    case arrow::Type::INT64:
+      compareArray<arrow::Int64Array>(array, node.op, node.value, mask);
+      break;
+    case arrow::Type::UINT8:
+      compareArray<arrow::UInt8Array>(array, node.op, node.value, mask);
+      break;
+    case arrow::Type::UINT16:
+      compareArray<arrow::UInt16Array>(array, node.op, node.value, mask);
+      break;
+    case arrow::Type::UINT32:
+      compareArray<arrow::UInt32Array>(array, node.op, node.value, mask);
+      break;
+    case arrow::Type::UINT64:
+      compareArray<arrow::UInt64Array>(array, node.op, node.value, mask);
+      break;
+    case arrow::Type::FLOAT:
+      // compared as float, so that pt > 0.5f means the same as in the user code
+      compareArray<arrow::FloatArray>(array, node.op, static_cast<float>(node.value), mask);
+      break;
+    case arrow::Type::DOUBLE:
+      compareArray<arrow::DoubleArray>(array, node.op, node.value, mask);
+      break;
+    default:
+      throw std::runtime_error("Filter: column " + node.column + " is not numeric");
+  }
+  if (array.null_count() > 0) {
+    filter_kernels::applyValidity(array.null_bitmap_data(), array.offset(), array.length(), mask);
+  }
+}
+
+void evaluate(arrow::RecordBatch const& batch, Node const& node, uint8_t* mask)
+{
+  auto n = batch.num_rows();
+  switch (node.kind) {
+    case Node::Kind::Compare:
+      compareColumn(batch, node, mask);
+      break;
+    case Node::Kind::And:
+    case Node::Kind::Or: {
+      evaluate(batch, *node.lhs, mask);
+      std::vector<uint8_t> other(n);
+      evaluate(batch, *node.rhs, other.data());
+      if (node.kind == Node::Kind::And) {
+        for (int64_t i = 0; i < n; ++i) {
+          mask[i] &= other[i];
+        }
+      } else {
+        for (int64_t i = 0; i < n; ++i) {
+          mask[i] |= other[i];
+        }
+      }
+      break;
+    }
+    case Node::Kind::Not:
+      evaluate(batch, *node.lhs, mask);
+      for (int64_t i = 0; i < n; ++i) {
+        mask[i] ^= 1;
+      }
+      break;
+  }
+}
+
+Filter combine(Node::Kind kind, Filter const& lhs, Filter const& rhs)
+{
+  // an empty filter selects everything
+  if (lhs.empty()) {
+    return kind == Node::Kind::And ? rhs : lhs;
+  }
+  if (rhs.empty()) {
+    return kind == Node::Kind::And ? lhs : rhs;
+  }
+  auto node = std::make_shared<Node>();
+  node->kind = kind;
+  node->lhs = lhs.node();
+  node->rhs = rhs.node();
+  return Filter{ node };
+}
+} // namespace
+
+Filter compare(ColumnRef const& column, CompareOp op, double value)
+{
+  auto node = std::make_shared<Node>();
+  node->kind = Node::Kind::Compare;
+  node->column = column.name;
+  node->op = op;
+  node->value = value;
+  return Filter{ node };
+}
+
+Filter operator&&(Filter const& lhs, Filter const& rhs)
+{
+  return combine(Node::Kind::And, lhs, rhs);
+}
+
+Filter operator||(Filter const& lhs, Filter const& rhs)
+{
+  return combine(Node::Kind::Or, lhs, rhs);
+}
+
+Filter operator!(Filter const& filter)
+{
+  if (filter.empty()) {
+    throw std::runtime_error("Filter: cannot negate an empty filter");
+  }
+  auto node = std::make_shared<Node>();
+  node->kind = Node::Kind::Not;
+  node->lhs = filter.node();
+  return Filter{ node };
+}
+
+void Filter::mask(arrow::RecordBatch const& batch, std::vector<uint8_t>& mask) const
+{
+  if (mNode == nullptr) {
+    mask.assign(batch.num_rows(), 1);
+    return;
+  }
+  mask.resize(batch.num_rows());
+  evaluate(batch, *mNode, mask.data());
+}
+
+SelectionVector Filter::select(arrow::RecordBatch const& batch) const
+{
+  std::vector<uint8_t> selected;
+  mask(batch, selected);
+  return filter_kernels::toSelection(selected.data(), selected.size());
+}
+
+SelectionVector Filter::select(arrow::Table const& table) const
+{
+  SelectionVector result;
+  result.reserve(table.num_rows());
+  arrow::TableBatchReader reader(table);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  int64_t offset = 0;
+  while (reader.ReadNext(&batch).ok() && batch != nullptr) {
+    for (auto row : select(*batch)) {
+      result.push_back(offset + row);
+    }
+    offset += batch->num_rows();
+  }
+  return result;
+}
+
+std::vector<std::shared_ptr<arrow::RecordBatch>> getRecordBatches(std::shared_ptr<arrow::Table> const& table, int64_t chunkSize)
+{
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  arrow::TableBatchReader reader(*table);
+  if (chunkSize > 0) {
+    reader.set_chunksize(chunkSize);
+  }
+  std::shared_ptr<arrow::RecordBatch> batch;
+  while (true) {
+    auto status = reader.ReadNext(&batch);
+    if (!status.ok()) {
+      throw std::runtime_error("Unable to read the record batches: " + status.ToString());
+    }
+    if (batch == nullptr) {
+      break;
+    }
+    batches.push_back(batch);
+  }
+  return batches;
+}
+
+} // namespace analysis
+} // namespace o2
@@ -0,0 +1,226 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/TimesliceCredits.h"
+#include "Framework/DeviceSpec.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <new>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2
+{
+namespace framework
+{
+
+struct TimesliceCredits::Control {
+  static constexpr uint64_t MAGIC = 0x5354494445524344ULL;
+  uint64_t magic;
+  uint64_t devices;
+};
+
+/// The entry of a device, on its own cache line as each of them is written
+/// by a different process
+struct alignas(64) TimesliceCredits::Entry {
+  std::atomic<uint64_t> window;
+  std::atomic<uint64_t> processed;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the timeslice credits need address free atomics");
+
+namespace
+{
+constexpr size_t entriesOffset() { return (sizeof(uint64_t) * 2 + 63) & ~size_t(63); }
+} // namespace
+
+std::unique_ptr<TimesliceCredits> TimesliceCredits::create(std::string const& name, size_t devices)
+{
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return nullptr;
+  }
+  size_t mappedSize = entriesOffset() + devices * sizeof(Entry);
+  if (ftruncate(fd, mappedSize) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  void* memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  auto control = new (memory) Control;
+  control->devices = devices;
+  auto entries = reinterpret_cast<Entry*>(reinterpret_cast<char*>(memory) + entriesOffset());
+  for (size_t i = 0; i < devices; ++i) {
+    auto entry = new (entries + i) Entry;
+    entry->window = 0;
+    entry->processed = 0;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  control->magic = Control::MAGIC;
+  return std::unique_ptr<TimesliceCredits>(new TimesliceCredits(name, memory, mappedSize, true));
+}
+
+std::unique_ptr<TimesliceCredits> TimesliceCredits::attach(std::string const& name)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)entriesOffset()) {
+    close(fd);
+    return nullptr;
+  }
+  void* memory = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    return nullptr;
+  }
+  auto control = reinterpret_cast<Control*>(memory);
+  if (control->magic != Control::MAGIC || entriesOffset() + control->devices * sizeof(Entry) != (size_t)st.st_size) {
+    munmap(memory, st.st_size);
+    return nullptr;
+  }
+  return std::unique_ptr<TimesliceCredits>(new TimesliceCredits(name, memory, st.st_size, false));
+}
+
+TimesliceCredits::TimesliceCredits(std::string const& name, void* memory, size_t mappedSize, bool owner)
+  : mName{ name },
+    mMemory{ memory },
+    mMappedSize{ mappedSize },
+    mOwner{ owner },
+    mDevices{ reinterpret_cast<Control*>(memory)->devices },
+    mEntries{ reinterpret_cast<Entry*>(reinterpret_cast<char*>(memory) + entriesOffset()) }
+{
+}
+
+TimesliceCredits::~TimesliceCredits()
+{
+  munmap(mMemory, mMappedSize);
+  if (mOwner) {
+    shm_unlink(mName.c_str());
+  }
+}
+
+void TimesliceCredits::advertise(size_t index, size_t window)
+{
+  if (index < mDevices) {
+    mEntries[index].window.store(window, std::memory_order_relaxed);
+  }
+}
+
+void TimesliceCredits::processed(size_t index)
+{
+  // Each entry has a single writer, no need for a read-modify-write
+  if (index < mDevices) {
+    auto& processed = mEntries[index].processed;
+    processed.store(processed.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+}
+
+size_t TimesliceCredits::getProcessed(size_t index) const
+{
+  return index < mDevices ? mEntries[index].processed.load(std::memory_order_acquire) : 0;
+}
+
+TimesliceCredits::Credit TimesliceCredits::credit(ConsumerGroups const& groups, size_t sent) const
+{
+  Credit result{ std::numeric_limits<int64_t>::max(), 0 };
+  for (auto& group : groups) {
+    int64_t window = 0;
+    int64_t processed = 0;
+    for (auto index : group) {
+      if (index >= mDevices) {
+        continue;
+      }
+      window += mEntries[index].window.load(std::memory_order_relaxed);
+      processed += mEntries[index].processed.load(std::memory_order_acquire);
+    }
+    if (window == 0) {
+      continue;
+    }
+    auto inFlight = std::max<int64_t>((int64_t)sent - processed, 0);
+    result.free = std::min(result.free, window - inFlight);
+    result.inFlight = std::max(result.inFlight, inFlight);
+  }
+  return result;
+}
+
+std::vector<TimesliceCredits::ConsumerGroups> TimesliceCredits::computeConsumers(std::vector<DeviceSpec> const& devices)
+{
+  std::vector<ConsumerGroups> result(devices.size());
+  for (size_t si = 0; si < devices.size(); ++si) {
+    auto& source = devices[si];
+    if (source.inputChannels.empty() == false) {
+      continue;
+    }
+    // The consumers are grouped by data processor, in order of appearance
+    std::map<std::string, size_t> groupByName;
+    for (size_t ci = 0; ci < devices.size(); ++ci) {
+      auto& consumer = devices[ci];
+      bool connected = false;
+      for (auto& output : source.outputChannels) {
+        for (auto& input : consumer.inputChannels) {
+          connected |= output.name == input.name;
+        }
+      }
+      if (connected == false) {
+        continue;
+      }
+      auto group = groupByName.emplace(consumer.name, result[si].size());
+      if (group.second) {
+        result[si].emplace_back();
+      }
+      result[si][group.first->second].push_back(ci);
+    }
+  }
+  return result;
+}
+
+std::string TimesliceCredits::encodeConsumers(ConsumerGroups const& groups)
+{
+  std::ostringstream encoded;
+  for (size_t gi = 0; gi < groups.size(); ++gi) {
+    encoded << (gi ? ";" : "");
+    for (size_t ci = 0; ci < groups[gi].size(); ++ci) {
+      encoded << (ci ? "," : "") << groups[gi][ci];
+    }
+  }
+  return encoded.str();
+}
+
+TimesliceCredits::ConsumerGroups TimesliceCredits::decodeConsumers(std::string const& encoded)
+{
+  ConsumerGroups groups;
+  std::istringstream groupStream(encoded);
+  std::string group;
+  while (std::getline(groupStream, group, ';')) {
+    std::istringstream indexStream(group);
+    std::string index;
+    groups.emplace_back();
+    while (std::getline(indexStream, index, ',')) {
+      groups.back().push_back(std::stoul(index));
+    }
+  }
+  return groups;
+}
+
+} // namespace framework
+} // namespace o2
@@ -0,0 +1,121 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/TimesliceRecord.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace o2
+{
+namespace framework
+{
+
+namespace
+{
+template <typename T>
+void readValue(std::ifstream& file, T& value, std::string const& filename)
+{
+  if (!file.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+    throw std::runtime_error("truncated timeslice record " + filename);
+  }
+}
+} // namespace
+
+std::vector<RecordedTimeslice> TimesliceRecord::read(std::string const& filename, bool payloads)
+{
+  std::ifstream file(filename.c_str(), std::ios_base::binary);
+  if (!file) {
+    throw std::runtime_error("unable to open timeslice record " + filename);
+  }
+  char magic[8];
+  uint32_t version = 0;
+  if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(magic)) != 0) {
+    throw std::runtime_error(filename + " is not a timeslice record");
+  }
+  readValue(file, version, filename);
+  if (version != VERSION) {
+    throw std::runtime_error("unsupported version " + std::to_string(version) + " of timeslice record " + filename);
+  }
+
+  std::vector<RecordedTimeslice> timeslices;
+  uint32_t nParts = 0;
+  while (file.read(reinterpret_cast<char*>(&nParts), sizeof(nParts))) {
+    RecordedTimeslice timeslice(nParts);
+    for (auto& part : timeslice) {
+      uint32_t headerSize = 0;
+      uint64_t payloadSize = 0;
+      readValue(file, headerSize, filename);
+      readValue(file, payloadSize, filename);
+      part.header.resize(headerSize);
+      if (!file.read(part.header.data(), headerSize)) {
+        throw std::runtime_error("truncated timeslice record " + filename);
+      }
+      if (payloads) {
+        part.payload.resize(payloadSize);
+        file.read(part.payload.data(), payloadSize);
+      } else {
+        file.seekg(payloadSize, std::ios_base::cur);
+      }
+      if (!file) {
+        throw std::runtime_error("truncated timeslice record " + filename);
+      }
+    }
+    timeslices.emplace_back(std::move(timeslice));
+  }
+  if (!file.eof() || file.gcount() != 0) {
+    throw std::runtime_error("truncated timeslice record " + filename);
+  }
+  return timeslices;
+}
+
+TimesliceRecordWriter::TimesliceRecordWriter(std::string const& filename)
+  : mFile{ filename.c_str(), std::ios_base::binary },
+    mFilename{ filename }
+{
+  if (!mFile) {
+    throw std::runtime_error("unable to create timeslice record " + filename);
+  }
+  mFile.write(TimesliceRecord::MAGIC, 8);
+  mFile.write(reinterpret_cast<char const*>(&TimesliceRecord::VERSION), sizeof(uint32_t));
+}
+
+void TimesliceRecordWriter::beginTimeslice(uint32_t nParts)
+{
+  if (mMissingParts != 0) {
+    throw std::runtime_error("timeslice record " + mFilename + ": previous timeslice is incomplete");
+  }
+  mFile.write(reinterpret_cast<char const*>(&nParts), sizeof(nParts));
+  mMissingParts = nParts;
+  mTimeslices++;
+}
+
+void TimesliceRecordWriter::addPart(char const* header, size_t headerSize, char const* payload, size_t payloadSize)
+{
+  if (mMissingParts == 0) {
+    throw std::runtime_error("timeslice record " + mFilename + ": part outside of a timeslice");
+  }
+  uint32_t size32 = headerSize;
+  uint64_t size64 = payloadSize;
+  mFile.write(reinterpret_cast<char const*>(&size32), sizeof(size32));
+  mFile.write(reinterpret_cast<char const*>(&size64), sizeof(size64));
+  mFile.write(header, headerSize);
+  mFile.write(payload, payloadSize);
+  if (mMissingParts == 1) {
+    // a complete timeslice is readable even if the device is killed
+    mFile.flush();
+  }
+  if (!mFile) {
+    throw std::runtime_error("unable to write timeslice record " + mFilename);
+  }
+  mMissingParts--;
+}
+
+} // namespace framework
+} // namespace o2
@@ -0,0 +1,125 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/TimesliceTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace o2
+{
+namespace framework
+{
+
+namespace
+{
+int64_t elapsed(uint64_t from, uint64_t to)
+{
+  return (from == 0 || to == 0) ? 0 : static_cast<int64_t>(to) - static_cast<int64_t>(from);
+}
+} // namespace
+
+TimesliceBreakdown TimesliceBreakdown::fromTrace(TimesliceTrace const& trace)
+{
+  TimesliceBreakdown result;
+  auto arrival = trace.at(TracePoint::RelayArrival);
+  if (trace.upstreamSend != 0 && arrival != 0) {
+    result.transfer = elapsed(trace.upstreamSend, arrival);
+  }
+  result.inputWait = elapsed(trace.firstArrival, arrival);
+  result.queue = elapsed(arrival, trace.at(TracePoint::ReadyToProcess));
+  result.dispatch = elapsed(trace.at(TracePoint::ReadyToProcess), trace.at(TracePoint::CallbackStart));
+  result.compute = elapsed(trace.at(TracePoint::CallbackStart), trace.at(TracePoint::CallbackEnd));
+  result.send = elapsed(trace.at(TracePoint::CallbackEnd), trace.at(TracePoint::Send));
+  if (trace.originTime != 0 && trace.at(TracePoint::Send) != 0) {
+    result.sinceOrigin = elapsed(trace.originTime, trace.at(TracePoint::Send));
+  }
+  return result;
+}
+
+uint64_t TimesliceTracer::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TimesliceTrace& TimesliceTracer::trace(size_t timeslice)
+{
+  auto it = mTraces.find(timeslice);
+  if (it != mTraces.end()) {
+    return it->second;
+  }
+  if (mTraces.size() >= mMaxOpenTraces) {
+    mTraces.erase(mTraces.begin());
+  }
+  return mTraces[timeslice];
+}
+
+void TimesliceTracer::relayed(size_t timeslice, TimesliceTraceHeader const* upstream, uint64_t time)
+{
+  auto& current = trace(timeslice);
+  if (current.firstArrival == 0) {
+    current.firstArrival = time;
+  }
+  current.points[static_cast<int>(TracePoint::RelayArrival)] = time;
+  if (upstream == nullptr) {
+    return;
+  }
+  current.upstreamSend = std::max(current.upstreamSend, upstream->sendTime);
+  if (upstream->originTime != 0) {
+    current.originTime = current.originTime == 0 ? upstream->originTime : std::min(current.originTime, upstream->originTime);
+  }
+}
+
+void TimesliceTracer::mark(size_t timeslice, TracePoint point, uint64_t time)
+{
+  trace(timeslice).points[static_cast<int>(point)] = time;
+}
+
+TimesliceTrace const* TimesliceTracer::get(size_t timeslice) const
+{
+  auto it = mTraces.find(timeslice);
+  return it == mTraces.end() ? nullptr : &it->second;
+}
+
+TimesliceTraceHeader TimesliceTracer::outputHeader(size_t timeslice, uint64_t time) const
+{
+  auto current = get(timeslice);
+  auto origin = (current && current->originTime != 0) ? current->originTime : time;
+  return TimesliceTraceHeader{ time, origin };
+}
+
+TimesliceTrace TimesliceTracer::finish(size_t timeslice)
+{
+  TimesliceTrace result;
+  auto it = mTraces.find(timeslice);
+  if (it != mTraces.end()) {
+    result = it->second;
+    mTraces.erase(it);
+  }
+  return result;
+}
+
+size_t TimesliceTracer::appendHeader(char const* stack, size_t size, char* out, TimesliceTraceHeader const& trace)
+{
+  std::memcpy(out, stack, size);
+  auto last = header::BaseHeader::get(reinterpret_cast<o2::byte*>(out));
+  while (last && last->flagsNextHeader) {
+    last = last->next();
+  }
+  if (last) {
+    last->flagsNextHeader = 1;
+  }
+  std::memcpy(out + size, &trace, sizeof(TimesliceTraceHeader));
+  reinterpret_cast<header::BaseHeader*>(out + size)->flagsNextHeader = 0;
+  return size + sizeof(TimesliceTraceHeader);
+}
+
+} // namespace framework
+} // namespace o2
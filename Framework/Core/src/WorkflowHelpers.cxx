@@ -165,7 +165,7 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow)
                  static_cast<DataAllocator::SubSpecificationType>(separateEnumerations++), Lifetime::Enumeration } },
     {},
     readers::AODReaderHelpers::rootFileReaderCallback(),
-    { ConfigParamSpec{ "aod-file", VariantType::String, "aod.root", { "Input AOD file" } },
+    { ConfigParamSpec{ "aod-file", VariantType::String, "aod.root", { "Input AOD file, or AOD converted to Arrow if ending with .arrow" } },
       ConfigParamSpec{ "start-value-enumeration", VariantType::Int, 0, { "initial value for the enumeration" } },
       ConfigParamSpec{ "end-value-enumeration", VariantType::Int, -1, { "final value for the enumeration" } },
       ConfigParamSpec{ "step-value-enumeration", VariantType::Int, 1, { "step between one value and the other" } } }
@@ -225,8 +225,9 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow)
         case Lifetime::Condition: {
           auto concrete = DataSpecUtils::asConcreteDataMatcher(input);
           if (hasConditionOption == false) {
-            processor.options.emplace_back(ConfigParamSpec{ "condition-backend", VariantType::String, "http://localhost:8080", { "Url for CCDB" } }),
-              hasConditionOption = true;
+            processor.options.emplace_back(ConfigParamSpec{ "condition-backend", VariantType::String, "http://localhost:8080", { "Url for CCDB" } });
+            processor.options.emplace_back(ConfigParamSpec{ "condition-cache-dir", VariantType::String, "", { "Directory where the conditions are shared by the devices of the node" } });
+            hasConditionOption = true;
           }
           requestedCCDBs.emplace_back(concrete);
         } break;
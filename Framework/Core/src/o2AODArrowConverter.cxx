@@ -0,0 +1,37 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// Converts ROOT AOD files to the Arrow IPC format, which the AOD reader
+/// memory maps when given as --aod-file <output>.arrow
+///
+/// Usage: o2AODArrowConverter <output>.arrow <input.root>...
+
+#include "Framework/AODReaderHelpers.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <output>.arrow <input.root>..." << std::endl;
+    return 1;
+  }
+  std::vector<std::string> inputFiles(argv + 2, argv + argc);
+  try {
+    o2::framework::readers::AODReaderHelpers::convertToArrow(inputFiles, argv[1]);
+  } catch (std::exception const& e) {
+    std::cerr << "Conversion failed: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -19,12 +19,15 @@
 #include "Framework/DeviceControl.h"
 #include "Framework/DeviceExecution.h"
 #include "Framework/DeviceInfo.h"
+#include "Framework/DeviceMetricsChannel.h"
+#include "Framework/TimesliceCredits.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/FrameworkGUIDebugger.h"
 #include "Framework/FreePortFinder.h"
 #include "Framework/LocalRootFileService.h"
 #include "Framework/LogParsingHelpers.h"
+#include "Framework/MemoryAccounting.h"
 #include "Framework/ParallelContext.h"
 #include "Framework/RawDeviceService.h"
 #include "Framework/SimpleRawDeviceService.h"
@@ -40,7 +43,9 @@
 #include "DriverControl.h"
 #include "DriverInfo.h"
 #include "GraphvizHelpers.h"
+#include "MetricsChannelBackend.h"
 #include "SimpleResourceManager.h"
+#include "CpuPlacement.h"
 
 #include <Monitoring/MonitoringFactory.h>
 #include <InfoLogger/InfoLogger.hxx>
@@ -64,6 +69,7 @@
 #include <map>
 #include <regex>
 #include <set>
+#include <sstream>
 #include <string>
 #include <type_traits>
 #include <chrono>
@@ -123,6 +129,30 @@ std::ostream& operator<<(std::ostream& out, const enum TerminationPolicy& policy
     out.setstate(std::ios_base::failbit);
   return out;
 }
+
+std::istream& operator>>(std::istream& in, enum SpawnPolicy& policy)
+{
+  std::string token;
+  in >> token;
+  if (token == "exec") {
+    policy = SpawnPolicy::EXEC;
+  } else if (token == "fork") {
+    policy = SpawnPolicy::FORK;
+  } else
+    in.setstate(std::ios_base::failbit);
+  return in;
+}
+
+std::ostream& operator<<(std::ostream& out, const enum SpawnPolicy& policy)
+{
+  if (policy == SpawnPolicy::EXEC) {
+    out << "exec";
+  } else if (policy == SpawnPolicy::FORK) {
+    out << "fork";
+  } else
+    out.setstate(std::ios_base::failbit);
+  return out;
+}
 } // namespace framework
 } // namespace o2
 
@@ -247,11 +277,15 @@ static void handle_sigint(int) { graceful_exit = true; }
 
 static void handle_sigchld(int) { sigchld_requested = true; }
 
+int doChild(int argc, char** argv, const o2::framework::DeviceSpec& spec);
 
 /// This will start a new device by forking and executing a
-/// new child
+/// new child. If @a reuseTopology is true, the child runs the device
+/// directly from the specification computed by the driver, without
+/// executing the workflow again.
 void spawnDevice(DeviceSpec const& spec, std::map<int, size_t>& socket2DeviceInfo, DeviceControl& control,
-                 DeviceExecution& execution, std::vector<DeviceInfo>& deviceInfos, int& maxFd, fd_set& childFdset)
+                 DeviceExecution& execution, std::vector<DeviceInfo>& deviceInfos, int& maxFd, fd_set& childFdset,
+                 bool reuseTopology)
 {
   int childstdout[2];
   int childstderr[2];
@@ -259,9 +293,18 @@ void spawnDevice(DeviceSpec const& spec, std::map<int, size_t>& socket2DeviceInf
   maxFd = createPipes(maxFd, childstdout);
   maxFd = createPipes(maxFd, childstderr);
 
+  // The metrics of the device are sent via shared memory, if possible, so
+  // that they do not need to be printed and parsed.
+  std::shared_ptr<DeviceMetricsChannel> metricsChannel =
+    DeviceMetricsChannel::create("/dpl-metrics-" + std::to_string(getpid()) + "-" + std::to_string(deviceInfos.size()));
+
   // If we have a framework id, it means we have already been respawned
   // and that we are in a child. If not, we need to fork and re-exec, adding
   // the framework-id as one of the options.
+  auto spawnTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  // Whatever is buffered would be printed again by the child
+  std::cout.flush();
+  fflush(stdout);
   pid_t id = 0;
   id = fork();
   // We are the child: prepare options and reexec.
@@ -282,6 +325,21 @@ void spawnDevice(DeviceSpec const& spec, std::map<int, size_t>& socket2DeviceInf
     close(STDERR_FILENO);
     dup2(childstdout[1], STDOUT_FILENO);
     dup2(childstderr[1], STDERR_FILENO);
+    if (metricsChannel) {
+      setenv(DeviceMetricsChannel::ENV_NAME, metricsChannel->name().c_str(), 1);
+    }
+    setenv(DeviceExecution::SPAWN_TIME_ENV, std::to_string(spawnTime).c_str(), 1);
+    for (auto& variable : execution.environment) {
+      setenv(variable.first.c_str(), variable.second.c_str(), 1);
+    }
+    // The affinity is inherited through the exec
+    CpuPlacementHelpers::pinCurrentProcess(execution.cpuAffinity);
+    if (reuseTopology) {
+      // The handlers are the ones of the driver
+      signal(SIGCHLD, SIG_DFL);
+      signal(SIGINT, SIG_DFL);
+      exit(doChild(static_cast<int>(execution.args.size()) - 1, execution.args.data(), spec));
+    }
     execvp(execution.args[0], execution.args.data());
   }
 
@@ -298,6 +356,13 @@ void spawnDevice(DeviceSpec const& spec, std::map<int, size_t>& socket2DeviceInf
   }
 
   std::cout << "Starting " << spec.id << " on pid " << id << "\n";
+  if (execution.cpuAffinity.empty() == false) {
+    std::ostringstream cores;
+    for (auto core : execution.cpuAffinity) {
+      cores << " " << core;
+    }
+    LOG(INFO) << "Device " << spec.id << " pinned to cores" << cores.str();
+  }
   DeviceInfo info;
   info.pid = id;
   info.active = true;
@@ -308,6 +373,7 @@ void spawnDevice(DeviceSpec const& spec, std::map<int, size_t>& socket2DeviceInf
   info.dataRelayerViewIndex = Metric2DViewIndex{ "data_relayer", 0, 0, {} };
   info.variablesViewIndex = Metric2DViewIndex{ "matcher_variables", 0, 0, {} };
   info.queriesViewIndex = Metric2DViewIndex{ "data_queries", 0, 0, {} };
+  info.metricsChannel = metricsChannel;
 
   socket2DeviceInfo.insert(std::make_pair(childstdout[0], deviceInfos.size()));
   socket2DeviceInfo.insert(std::make_pair(childstderr[0], deviceInfos.size()));
@@ -346,6 +412,32 @@ void processChildrenOutput(DriverInfo& driverInfo, DeviceInfos& infos, DeviceSpe
   timeout.tv_usec = 16666; // This should be enough to allow 60 HZ redrawing.
   memcpy(&fdset, &driverInfo.childFdset, sizeof(fd_set));
   int numFd = select(driverInfo.maxFd, &fdset, nullptr, nullptr, &timeout);
+
+  // The metrics received via shared memory do not wake up the select, so we
+  // get them on every iteration.
+  bool hasNewChannelMetric = false;
+  for (size_t di = 0, de = infos.size(); di < de; ++di) {
+    DeviceInfo& info = infos[di];
+    if (!info.metricsChannel) {
+      continue;
+    }
+    auto updateMetricsViews =
+      Metric2DViewIndex::getUpdater({ &info.dataRelayerViewIndex,
+                                      &info.variablesViewIndex,
+                                      &info.queriesViewIndex });
+    auto newMetricCallback = [&updateMetricsViews, &hasNewChannelMetric](std::string const& name, MetricInfo const& metric, int value, size_t metricIndex) {
+      updateMetricsViews(name, metric, value, metricIndex);
+      hasNewChannelMetric = true;
+    };
+    DeviceMetricsInfo& metrics = metricsInfos[di];
+    info.metricsChannel->poll([&metrics, &newMetricCallback](ParsedMetricMatch& metricMatch) {
+      DeviceMetricsHelper::processMetric(metricMatch, metrics, newMetricCallback);
+    });
+  }
+  if (hasNewChannelMetric) {
+    updateMetricsNames(driverInfo, metricsInfos);
+  }
+
   if (numFd == 0) {
     return;
   }
@@ -558,7 +650,10 @@ int doChild(int argc, char** argv, const o2::framework::DeviceSpec& spec)
       ConfigParamsHelper::populateBoostProgramOptions(optsDesc, spec.options, gHiddenDeviceOptions);
       optsDesc.add_options()("monitoring-backend", bpo::value<std::string>()->default_value("infologger://"), "monitoring backend info") //
         ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")       //
-        ("infologger-mode", bpo::value<std::string>()->default_value(""), "INFOLOGGER_MODE override");
+        ("infologger-mode", bpo::value<std::string>()->default_value(""), "INFOLOGGER_MODE override")                                   //
+        ("timeslice-tracing", bpo::value<bool>()->default_value(false), "report the trace points of every timeslice")                   //
+        ("memory-accounting", bpo::value<bool>()->default_value(false), "report the memory used by every timeslice")                    //
+        ("event-driven", bpo::value<bool>()->default_value(false), "block on the inputs until data arrives or a timer is due");
       r.fConfig.AddToCmdLineOptions(optsDesc, true);
     });
 
@@ -577,6 +672,7 @@ int doChild(int argc, char** argv, const o2::framework::DeviceSpec& spec)
     std::unique_ptr<InfoLogger> infoLoggerService;
     std::unique_ptr<InfoLoggerContext> infoLoggerContext;
     std::unique_ptr<TimesliceIndex> timesliceIndex;
+    std::unique_ptr<MemoryAccounting> memoryAccounting;
 
     auto afterConfigParsingCallback = [&localRootFileService,
                                        &textControlService,
@@ -588,13 +684,24 @@ int doChild(int argc, char** argv, const o2::framework::DeviceSpec& spec)
                                        &spec,
                                        &serviceRegistry,
                                        &infoLoggerContext,
-                                       &timesliceIndex](fair::mq::DeviceRunner& r) {
+                                       &timesliceIndex,
+                                       &memoryAccounting](fair::mq::DeviceRunner& r) {
       localRootFileService = std::make_unique<LocalRootFileService>();
       textControlService = std::make_unique<TextControlService>();
       parallelContext = std::make_unique<ParallelContext>(spec.rank, spec.nSlots);
       simpleRawDeviceService = std::make_unique<SimpleRawDeviceService>(nullptr);
       callbackService = std::make_unique<CallbackService>();
-      monitoringService = MonitoringFactory::Get(r.fConfig.GetStringValue("monitoring-backend"));
+      // With the default backend the metrics are printed for the driver.
+      // If the driver provided a binary channel, we use it instead.
+      auto monitoringBackend = r.fConfig.GetStringValue("monitoring-backend");
+      auto metricsChannelName = getenv(DeviceMetricsChannel::ENV_NAME);
+      auto metricsChannel = metricsChannelName && monitoringBackend == "infologger://" ? DeviceMetricsChannel::attach(metricsChannelName) : nullptr;
+      if (metricsChannel) {
+        monitoringService = MonitoringFactory::Get("no-op://");
+        monitoringService->addBackend(std::make_unique<MetricsChannelBackend>(std::move(metricsChannel)));
+      } else {
+        monitoringService = MonitoringFactory::Get(monitoringBackend);
+      }
       auto infoLoggerMode = r.fConfig.GetStringValue("infologger-mode");
       if (infoLoggerMode != "") {
         setenv("INFOLOGGER_MODE", r.fConfig.GetStringValue("infologger-mode").c_str(), 1);
@@ -607,6 +714,7 @@ int doChild(int argc, char** argv, const o2::framework::DeviceSpec& spec)
         fair::Logger::AddCustomSink("infologger", infoLoggerSeverity, createInfoLoggerSinkHelper(infoLoggerService, infoLoggerContext));
       }
       timesliceIndex = std::make_unique<TimesliceIndex>();
+      memoryAccounting = std::make_unique<MemoryAccounting>();
 
       serviceRegistry.registerService<Monitoring>(monitoringService.get());
       serviceRegistry.registerService<InfoLogger>(infoLoggerService.get());
@@ -616,6 +724,7 @@ int doChild(int argc, char** argv, const o2::framework::DeviceSpec& spec)
       serviceRegistry.registerService<RawDeviceService>(simpleRawDeviceService.get());
       serviceRegistry.registerService<CallbackService>(callbackService.get());
       serviceRegistry.registerService<TimesliceIndex>(timesliceIndex.get());
+      serviceRegistry.registerService<MemoryAccounting>(memoryAccounting.get());
       serviceRegistry.registerService<DeviceSpec>(&spec);
 
       // The decltype stuff is to be able to compile with both new and old
@@ -741,9 +850,14 @@ int runStateMachine(DataProcessorSpecs const& workflow, DriverControl& driverCon
         break;
       case DriverState::MATERIALISE_WORKFLOW:
         try {
+          auto materialiseStart = std::chrono::steady_clock::now();
           std::vector<ComputingResource> resources = resourceManager->getAvailableResources();
           DeviceSpecHelpers::dataProcessorSpecs2DeviceSpecs(workflow, driverInfo.channelPolicies, driverInfo.completionPolicies, deviceSpecs, resources);
           // This should expand nodes so that we can build a consistent DAG.
+          if (frameworkId.empty()) {
+            LOG(INFO) << "Topology of " << deviceSpecs.size() << " devices materialised in "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - materialiseStart).count() << " ms";
+          }
         } catch (std::runtime_error& e) {
           std::cerr << "Invalid workflow: " << e.what() << std::endl;
           return 1;
@@ -767,26 +881,62 @@ int runStateMachine(DataProcessorSpecs const& workflow, DriverControl& driverCon
           debugGUICallback = gui::getGUIDebugger(infos, deviceSpecs, metricsInfos, driverInfo, controls, driverControl);
         }
         break;
-      case DriverState::SCHEDULE:
+      case DriverState::SCHEDULE: {
         // FIXME: for the moment modifying the topology means we rebuild completely
         //        all the devices and we restart them. This is also what DDS does at
         //        a larger scale. In principle one could try to do a delta and only
         //        restart the data processors which need to be restarted.
         LOG(INFO) << "Redeployment of configuration asked.";
+        auto scheduleStart = std::chrono::steady_clock::now();
         controls.resize(deviceSpecs.size());
         deviceExecutions.resize(deviceSpecs.size());
 
         DeviceSpecHelpers::prepareArguments(driverInfo.argc, driverInfo.argv, driverControl.defaultQuiet,
                                             driverControl.defaultStopped, deviceSpecs,
                                             driverInfo.workflowOptions, deviceExecutions, controls);
+        if (driverInfo.cpuPlacement != CpuPlacementPolicy::NONE) {
+          auto affinities = CpuPlacementHelpers::placeDevices(deviceSpecs, CpuTopology::fromSysfs(), driverInfo.cpuPlacement);
+          for (size_t di = 0; di < deviceSpecs.size(); ++di) {
+            deviceExecutions[di].cpuAffinity = affinities[di];
+          }
+        }
+        // The segment is recreated, as the devices might be different
+        driverInfo.timesliceCredits.reset();
+        if (driverInfo.flowControl) {
+          driverInfo.timesliceCredits = TimesliceCredits::create("/dpl-credits-" + std::to_string(getpid()), deviceSpecs.size());
+          if (driverInfo.timesliceCredits == nullptr) {
+            LOG(ERROR) << "Unable to create the timeslice credits, the sources are not throttled";
+          }
+        }
+        auto consumers = driverInfo.timesliceCredits ? TimesliceCredits::computeConsumers(deviceSpecs)
+                                                     : std::vector<TimesliceCredits::ConsumerGroups>{};
         for (size_t di = 0; di < deviceSpecs.size(); ++di) {
+          auto& environment = deviceExecutions[di].environment;
+          environment.clear();
+          if (driverInfo.timesliceCredits) {
+            environment.emplace_back(TimesliceCredits::ENV_NAME, driverInfo.timesliceCredits->name());
+            environment.emplace_back(TimesliceCredits::ENV_INDEX, std::to_string(di));
+            environment.emplace_back(TimesliceCredits::ENV_CONSUMERS, TimesliceCredits::encodeConsumers(consumers[di]));
+          }
+        }
+        auto argumentsDone = std::chrono::steady_clock::now();
+        // Forking without exec is not possible with a GUI, nor when the
+        // devices run under a child driver, e.g. valgrind.
+        bool canReuseTopology = driverInfo.spawnPolicy == SpawnPolicy::FORK && window == nullptr;
+        for (size_t di = 0; di < deviceSpecs.size(); ++di) {
+          bool reuseTopology = canReuseTopology && strcmp(deviceExecutions[di].args[0], driverInfo.argv[0]) == 0;
           spawnDevice(deviceSpecs[di], driverInfo.socket2DeviceInfo, controls[di], deviceExecutions[di], infos,
-                      driverInfo.maxFd, driverInfo.childFdset);
+                      driverInfo.maxFd, driverInfo.childFdset, reuseTopology);
         }
         driverInfo.maxFd += 1;
         assert(infos.empty() == false);
-        LOG(INFO) << "Redeployment of configuration done.";
+        auto spawnDone = std::chrono::steady_clock::now();
+        LOG(INFO) << "Redeployment of configuration done: arguments prepared in "
+                  << std::chrono::duration<double, std::milli>(argumentsDone - scheduleStart).count() << " ms, "
+                  << deviceSpecs.size() << " devices spawned in "
+                  << std::chrono::duration<double, std::milli>(spawnDone - argumentsDone).count() << " ms";
         break;
+      }
       case DriverState::RUNNING:
         // Calculate what we should do next and eventually
         // show the GUI
@@ -982,6 +1132,12 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("port-range,pr", bpo::value<unsigned short>()->default_value(1000), "ports in range")                  //
     ("completion-policy,c", bpo::value<TerminationPolicy>(&policy)->default_value(TerminationPolicy::QUIT), //
      "what to do when processing is finished: quit, wait")                                                  //
+    ("cpu-placement", bpo::value<CpuPlacementPolicy>()->default_value(CpuPlacementPolicy::NONE),             //
+     "how to pin the devices to the cores: none, cores, numa")                                              //
+    ("spawn-policy", bpo::value<SpawnPolicy>()->default_value(SpawnPolicy::EXEC),                            //
+     "how to start the devices: exec, fork (reuse the topology of the driver, batch mode only)")            //
+    ("flow-control", bpo::value<bool>()->zero_tokens()->default_value(false),                                //
+     "throttle the sources against the free timeslices of their consumers")                                 //
     ("graphviz,g", bpo::value<bool>()->zero_tokens()->default_value(false), "produce graph output")         //
     ("timeout,t", bpo::value<double>()->default_value(0), "timeout after which to exit")                    //
     ("dds,D", bpo::value<bool>()->zero_tokens()->default_value(false), "create DDS configuration")          //
@@ -1067,6 +1223,9 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   driverInfo.argv = argv;
   driverInfo.batch = varmap["batch"].as<bool>();
   driverInfo.terminationPolicy = varmap["completion-policy"].as<TerminationPolicy>();
+  driverInfo.cpuPlacement = varmap["cpu-placement"].as<CpuPlacementPolicy>();
+  driverInfo.spawnPolicy = varmap["spawn-policy"].as<SpawnPolicy>();
+  driverInfo.flowControl = varmap["flow-control"].as<bool>();
   driverInfo.startTime = std::chrono::steady_clock::now();
   driverInfo.timeout = varmap["timeout"].as<double>();
   driverInfo.startPort = varmap["start-port"].as<unsigned short>();
@@ -10,6 +10,7 @@
 #include <benchmark/benchmark.h>
 
 #include "Framework/ContextRegistry.h"
+#include "Framework/ServiceRegistry.h"
 #include "Framework/ArrowContext.h"
 #include "Framework/StringContext.h"
 #include "Framework/RawBufferContext.h"
@@ -59,4 +60,34 @@ static void BM_ContextRegistryMultiGet(benchmark::State& state)
 
 BENCHMARK(BM_ContextRegistryMultiGet);
 
+struct ServiceA {
+  int value = 0;
+};
+struct ServiceB {
+  int value = 1;
+};
+struct ServiceC {
+  int value = 2;
+};
+
+// The lookup of a service done by the user code at every timeslice,
+// e.g. pc.services().get<ControlService>()
+static void BM_ServiceRegistryGet(benchmark::State& state)
+{
+  ServiceA a;
+  ServiceB b;
+  ServiceC c;
+  ServiceRegistry registry;
+  registry.registerService<ServiceA>(&a);
+  registry.registerService<ServiceB>(&b);
+  registry.registerService<ServiceC>(&c);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(registry.get<ServiceA>());
+    benchmark::DoNotOptimize(registry.get<ServiceC>());
+  }
+}
+
+BENCHMARK(BM_ServiceRegistryGet);
+
 BENCHMARK_MAIN()
@@ -9,9 +9,14 @@
 // or submit itself to any jurisdiction.
 #include <benchmark/benchmark.h>
 #include "Headers/DataHeader.h"
+#include "Headers/Stack.h"
+#include "Framework/CompiledInputMatcher.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/InputSpec.h"
 
 using namespace o2::header;
+using namespace o2::framework;
 using namespace o2::framework::data_matcher;
 
 static void BM_MatchedSingleQuery(benchmark::State& state)
@@ -184,4 +189,71 @@ static void BM_OneVariableMatchUnmatch(benchmark::State& state)
 // Register the function as a benchmark
 BENCHMARK(BM_OneVariableMatchUnmatch);
 
+// The inputs of a device as previously matched by the DataRelayer, one
+// tree per input evaluated in order. The message matches the last input.
+static void BM_TreeInputs(benchmark::State& state)
+{
+  std::vector<DataDescriptorMatcher> matchers;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    matchers.emplace_back(DataDescriptorMatcher{
+      DataDescriptorMatcher::Op::And,
+      StartTimeValueMatcher{ ContextRef{ 0 } },
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::And,
+        OriginValueMatcher{ "TPC" },
+        std::make_unique<DataDescriptorMatcher>(
+          DataDescriptorMatcher::Op::And,
+          DescriptionValueMatcher{ "CLUSTERS" },
+          std::make_unique<DataDescriptorMatcher>(
+            DataDescriptorMatcher::Op::Just,
+            SubSpecificationTypeValueMatcher{ (uint64_t)i }))) });
+  }
+
+  DataHeader dh;
+  dh.dataOrigin = "TPC";
+  dh.dataDescription = "CLUSTERS";
+  dh.subSpecification = state.range(0) - 1;
+  DataProcessingHeader dph{ 0, 1 };
+  Stack stack{ dh, dph };
+  auto data = reinterpret_cast<char const*>(stack.data());
+
+  VariableContext context;
+  for (auto _ : state) {
+    for (auto& matcher : matchers) {
+      if (matcher.match(data, context)) {
+        context.commit();
+        break;
+      }
+      context.discard();
+    }
+    context.reset();
+  }
+}
+BENCHMARK(BM_TreeInputs)->Arg(1)->Arg(8)->Arg(64);
+
+// The same inputs, compiled in a table
+static void BM_CompiledInputs(benchmark::State& state)
+{
+  std::vector<InputSpec> specs;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    specs.emplace_back(InputSpec{ "x", "TPC", "CLUSTERS", (DataHeader::SubSpecificationType)i });
+  }
+  CompiledInputMatcher matcher{ specs };
+
+  DataHeader dh;
+  dh.dataOrigin = "TPC";
+  dh.dataDescription = "CLUSTERS";
+  dh.subSpecification = state.range(0) - 1;
+  DataProcessingHeader dph{ 0, 1 };
+  Stack stack{ dh, dph };
+  auto data = reinterpret_cast<char const*>(stack.data());
+
+  VariableContext context;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matcher.match(data, context));
+    context.reset();
+  }
+}
+BENCHMARK(BM_CompiledInputs)->Arg(1)->Arg(8)->Arg(64);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+
+#include "CommonUtils/BoostSerializer.h"
+#include "CommonUtils/FlatSerializer.h"
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/string.hpp>
+#include <string>
+#include <vector>
+
+using namespace o2::utils;
+
+/// the struct of test_BoostSerializedProcessing, with both serializations
+struct Foo {
+  int fBar1;
+  double fBar2[2];
+  std::vector<float> fBar3;
+  std::string fBar4;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    ar& fBar1;
+    ar& fBar2;
+    ar& fBar3;
+    ar& fBar4;
+  }
+
+  template <typename Self>
+  static auto flatFields(Self& self)
+  {
+    return std::tie(self.fBar1, self.fBar2, self.fBar3, self.fBar4);
+  }
+};
+
+static std::vector<Foo> makeFoos(size_t n)
+{
+  std::vector<Foo> foos;
+  for (size_t i = 0; i < n; i++) {
+    float iFloat = (float)i;
+    foos.emplace_back(Foo{ (int)i, { 2. * iFloat, 2.1 * iFloat }, { iFloat * 3.f, iFloat * 3.1f, iFloat * 3.2f }, "This is Foo!" });
+  }
+  return foos;
+}
+
+static void BM_BoostSerialize(benchmark::State& state)
+{
+  auto foos = makeFoos(state.range(0));
+  for (auto _ : state) {
+    // the string copy is the one of DataProcessor::doSend
+    auto buffer = BoostSerialize(foos).str();
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FlatSerialize(benchmark::State& state)
+{
+  auto foos = makeFoos(state.range(0));
+  std::vector<char> buffer;
+  for (auto _ : state) {
+    // the message of the snapshot
+    buffer.resize(FlatSerializedSize(foos));
+    FlatSerialize(foos, buffer.data(), buffer.size());
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BoostDeserialize(benchmark::State& state)
+{
+  auto foos = makeFoos(state.range(0));
+  auto buffer = BoostSerialize(foos).str();
+  for (auto _ : state) {
+    // the string copy is the one of InputRecord::get
+    auto str = std::string(buffer.data(), buffer.size());
+    auto result = BoostDeserialize<std::vector<Foo>>(str);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FlatDeserialize(benchmark::State& state)
+{
+  auto foos = makeFoos(state.range(0));
+  auto buffer = FlatSerialize(foos);
+  for (auto _ : state) {
+    auto result = FlatDeserialize<Foo>(buffer.data(), buffer.size());
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FlatView(benchmark::State& state)
+{
+  auto foos = makeFoos(state.range(0));
+  auto buffer = FlatSerialize(foos);
+  for (auto _ : state) {
+    // read all the values in place
+    FlatView<Foo> view(buffer.data(), buffer.size());
+    auto bar1 = view.column<0>();
+    auto bar3 = view.column<2>();
+    double sum = 0;
+    for (size_t i = 0; i < view.size(); ++i) {
+      sum += bar1[i];
+      for (auto value : bar3[i]) {
+        sum += value;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_BoostSerialize)->Range(16, 1 << 16);
+BENCHMARK(BM_FlatSerialize)->Range(16, 1 << 16);
+BENCHMARK(BM_BoostDeserialize)->Range(16, 1 << 16);
+BENCHMARK(BM_FlatDeserialize)->Range(16, 1 << 16);
+BENCHMARK(BM_FlatView)->Range(16, 1 << 16);
+
+BENCHMARK_MAIN();
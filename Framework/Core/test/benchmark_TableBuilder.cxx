@@ -77,6 +77,37 @@ static void BM_TableBuilderScalarBulk(benchmark::State& state)
 
 BENCHMARK(BM_TableBuilderScalarBulk)->Range(256, 1 << 20);
 
+static void BM_TableBuilderBulkFill(benchmark::State& state)
+{
+  using namespace o2::framework;
+  std::vector<float> x(state.range(0), 0.);
+  std::vector<float> y(state.range(0), 0.);
+  std::vector<float> z(state.range(0), 0.);
+  for (auto _ : state) {
+    TableBuilder builder;
+    builder.bulkFill<float, float, float>({ "x", "y", "z" }, x, y, z);
+    auto table = builder.finalize();
+  }
+}
+
+BENCHMARK(BM_TableBuilderBulkFill)->Range(256, 1 << 20);
+
+static void BM_TableBuilderAdopt(benchmark::State& state)
+{
+  using namespace o2::framework;
+  auto x = std::make_shared<std::vector<float>>(state.range(0), 0.);
+  auto y = std::make_shared<std::vector<float>>(state.range(0), 0.);
+  auto z = std::make_shared<std::vector<float>>(state.range(0), 0.);
+  auto owner = std::make_shared<std::tuple<decltype(x), decltype(y), decltype(z)>>(x, y, z);
+  for (auto _ : state) {
+    TableBuilder builder;
+    builder.adoptColumns<float, float, float>({ "x", "y", "z" }, owner, *x, *y, *z);
+    auto table = builder.finalize();
+  }
+}
+
+BENCHMARK(BM_TableBuilderAdopt)->Range(256, 1 << 20);
+
 static void BM_TableBuilderSimple(benchmark::State& state)
 {
   using namespace o2::framework;
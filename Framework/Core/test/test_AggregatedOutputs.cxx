@@ -0,0 +1,85 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ConfigContext.h"
+#include "Framework/ControlService.h"
+#include "Framework/DataProcessorSpec.h"
+#include "Framework/DataRefUtils.h"
+#include "Framework/DataSpecUtils.h"
+#include "Framework/runDataProcessing.h"
+#include "FairMQLogger.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace o2::framework;
+
+constexpr size_t nParts = 16;
+
+// A producer creating many small outputs, which are sent as one multipart
+// message because of aggregateOutputs. The consumer checks that every
+// header-payload pair arrives as a separate input.
+WorkflowSpec defineDataProcessing(ConfigContext const&)
+{
+  DataProcessorSpec producer{
+    "producer",
+    Inputs{},
+    {},
+    AlgorithmSpec{
+      [](ProcessingContext& ctx) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        for (size_t i = 0; i < nParts; ++i) {
+          auto data = ctx.outputs().make<int>(Output{ "TST", "A", i }, i + 1);
+          for (auto& value : data) {
+            value = i;
+          }
+        }
+        ctx.services().get<ControlService>().readyToQuit(true);
+      } }
+  };
+  producer.aggregateOutputs = true;
+  for (size_t i = 0; i < nParts; ++i) {
+    producer.outputs.emplace_back(OutputSpec{ "TST", "A", i });
+  }
+
+  DataProcessorSpec consumer{
+    "consumer",
+    mergeInputs(InputSpec{ "x", "TST", "A", 0, Lifetime::Timeframe },
+                nParts,
+                [](InputSpec& input, size_t index) {
+                  DataSpecUtils::updateMatchingSubspec(input, index);
+                }),
+    {},
+    AlgorithmSpec{
+      [](ProcessingContext& ctx) {
+        size_t nInputs = 0;
+        for (auto const& ref : ctx.inputs()) {
+          auto const* header = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+          if (header == nullptr || header->payloadSize != (header->subSpecification + 1) * sizeof(int)) {
+            LOG(ERROR) << "Wrong input received";
+            continue;
+          }
+          auto const* data = reinterpret_cast<int const*>(ref.payload);
+          for (size_t i = 0; i < header->subSpecification + 1; ++i) {
+            if (data[i] != (int)header->subSpecification) {
+              LOG(ERROR) << "Wrong payload for subspec " << header->subSpecification;
+            }
+          }
+          ++nInputs;
+        }
+        if (nInputs != nParts) {
+          LOG(ERROR) << "Expected " << nParts << " inputs, got " << nInputs;
+        }
+        ctx.services().get<ControlService>().readyToQuit(true);
+      } }
+  };
+
+  return WorkflowSpec{ producer, consumer };
+}
@@ -0,0 +1,189 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework CompiledInputMatcher
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/CompiledInputMatcher.h"
+#include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/InputSpec.h"
+#include "Headers/Stack.h"
+
+#include <boost/test/unit_test.hpp>
+#include <variant>
+
+using namespace o2::framework;
+using namespace o2::header;
+using namespace o2::framework::data_matcher;
+
+namespace
+{
+Stack makeStack(char const* origin, char const* description, DataHeader::SubSpecificationType subSpec, uint64_t startTime)
+{
+  DataHeader dh;
+  dh.dataOrigin.runtimeInit(origin);
+  dh.dataDescription.runtimeInit(description);
+  dh.subSpecification = subSpec;
+  DataProcessingHeader dph{ startTime, 1 };
+  return Stack{ dh, dph };
+}
+
+char const* data(Stack const& stack)
+{
+  return reinterpret_cast<char const*>(stack.data());
+}
+
+bool sameValue(ContextElement::Value const& a, ContextElement::Value const& b)
+{
+  if (a.index() != b.index()) {
+    return false;
+  }
+  if (auto pval = std::get_if<uint64_t>(&a)) {
+    return *pval == std::get<uint64_t>(b);
+  }
+  if (auto pval = std::get_if<std::string>(&a)) {
+    return *pval == std::get<std::string>(b);
+  }
+  return true;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestConcreteInputs)
+{
+  std::vector<InputSpec> specs{
+    InputSpec{ "clusters", "TPC", "CLUSTERS", 0 },
+    InputSpec{ "clusters1", "TPC", "CLUSTERS", 1 },
+    InputSpec{ "tracks", "ITS", "TRACKS", 0 },
+    // same as the first one, can never be matched
+    InputSpec{ "again", "TPC", "CLUSTERS", 0 },
+  };
+  CompiledInputMatcher matcher{ specs };
+  BOOST_CHECK(matcher.isFullyCompiled());
+
+  VariableContext context;
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "CLUSTERS", 1, 5)), context), 1);
+  BOOST_CHECK_EQUAL(std::get<uint64_t>(context.get(0)), 5);
+  // the start time is bound now
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("ITS", "TRACKS", 0, 5)), context), 2);
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("ITS", "TRACKS", 0, 6)), context), CompiledInputMatcher::INVALID_INPUT);
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "CLUSTERS", 0, 5)), context), 0);
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "CLUSTERS", 2, 5)), context), CompiledInputMatcher::INVALID_INPUT);
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TRD", "CLUSTERS", 0, 5)), context), CompiledInputMatcher::INVALID_INPUT);
+  BOOST_CHECK_THROW(matcher.match(reinterpret_cast<char const*>(Stack{ DataProcessingHeader{ 0, 1 } }.data()), context), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(TestMixedInputs)
+{
+  // A generic input for any TPC data with a given subspecification,
+  // binding the description to a variable
+  DataDescriptorMatcher anyTPC{
+    DataDescriptorMatcher::Op::And,
+    StartTimeValueMatcher{ ContextRef{ 0 } },
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::And,
+      OriginValueMatcher{ "TPC" },
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::And,
+        DescriptionValueMatcher{ ContextRef{ 1 } },
+        std::make_unique<DataDescriptorMatcher>(
+          DataDescriptorMatcher::Op::Just,
+          SubSpecificationTypeValueMatcher{ 1 }))) };
+
+  std::vector<InputSpec> specs{
+    InputSpec{ "clusters", "TPC", "CLUSTERS", 0 },
+    InputSpec{ "anyTPC", std::move(anyTPC) },
+    InputSpec{ "clusters1", "TPC", "CLUSTERS", 1 },
+    InputSpec{ "tracks", "TPC", "TRACKS", 0 },
+  };
+  CompiledInputMatcher matcher{ specs };
+  BOOST_CHECK(matcher.isFullyCompiled() == false);
+
+  // The generic input comes before the concrete one for TPC/CLUSTERS/1
+  VariableContext context;
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "CLUSTERS", 1, 5)), context), 1);
+  BOOST_CHECK_EQUAL(std::get<std::string>(context.get(1)), "CLUSTERS");
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "CLUSTERS", 0, 5)), context), 0);
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "TRACKS", 0, 5)), context), 3);
+  // The description is bound, so only the concrete input can match
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "TRACKS", 1, 5)), context), CompiledInputMatcher::INVALID_INPUT);
+
+  // A different timeslice only matches a fresh context
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "TRACKS", 0, 6)), context), CompiledInputMatcher::INVALID_INPUT);
+  VariableContext other;
+  BOOST_CHECK_EQUAL(matcher.match(data(makeStack("TPC", "TRACKS", 1, 6)), other), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestSameResultAsTrees)
+{
+  // The compiled matcher must give the same result as matching the
+  // trees of the inputs one after the other, for every context state
+  DataDescriptorMatcher anyTracks{
+    DataDescriptorMatcher::Op::And,
+    StartTimeValueMatcher{ ContextRef{ 0 } },
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::And,
+      OriginValueMatcher{ ContextRef{ 1 } },
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::Just,
+        DescriptionValueMatcher{ "TRACKS" })) };
+  std::vector<InputSpec> specs{
+    InputSpec{ "a", "TPC", "TRACKS", 0 },
+    InputSpec{ "b", "ITS", "TRACKS", 0 },
+    InputSpec{ "c", std::move(anyTracks) },
+    InputSpec{ "d", "TRD", "TRACKS", 0 },
+  };
+  std::vector<DataDescriptorMatcher> trees;
+  for (auto& spec : specs) {
+    if (auto concrete = std::get_if<ConcreteDataMatcher>(&spec.matcher)) {
+      trees.emplace_back(DataDescriptorMatcher{
+        DataDescriptorMatcher::Op::And,
+        StartTimeValueMatcher{ ContextRef{ 0 } },
+        std::make_unique<DataDescriptorMatcher>(
+          DataDescriptorMatcher::Op::And,
+          OriginValueMatcher{ concrete->origin.str },
+          std::make_unique<DataDescriptorMatcher>(
+            DataDescriptorMatcher::Op::And,
+            DescriptionValueMatcher{ concrete->description.str },
+            std::make_unique<DataDescriptorMatcher>(
+              DataDescriptorMatcher::Op::Just,
+              SubSpecificationTypeValueMatcher{ concrete->subSpec }))) });
+    } else {
+      trees.push_back(std::get<DataDescriptorMatcher>(spec.matcher));
+    }
+  }
+  CompiledInputMatcher matcher{ specs };
+
+  std::vector<Stack> messages;
+  for (auto origin : { "TPC", "ITS", "TRD", "MFT" }) {
+    for (uint64_t startTime : { 1, 2 }) {
+      messages.emplace_back(makeStack(origin, "TRACKS", 0, startTime));
+    }
+  }
+  // Feed the messages in sequence to both, such that the contexts get bound
+  VariableContext compiledContext;
+  VariableContext treeContext;
+  for (auto& message : messages) {
+    int expected = CompiledInputMatcher::INVALID_INPUT;
+    for (size_t ti = 0; ti < trees.size(); ++ti) {
+      if (trees[ti].match(data(message), treeContext)) {
+        treeContext.commit();
+        expected = ti;
+        break;
+      }
+      treeContext.discard();
+    }
+    BOOST_CHECK_EQUAL(matcher.match(data(message), compiledContext), expected);
+    for (size_t vi = 0; vi < 2; ++vi) {
+      BOOST_CHECK(sameValue(compiledContext.get(vi), treeContext.get(vi)));
+    }
+  }
+}
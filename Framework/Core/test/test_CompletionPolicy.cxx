@@ -14,6 +14,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include "Framework/CompletionPolicy.h"
+#include "Framework/CompletionPolicyHelpers.h"
 
 using namespace o2::framework;
 
@@ -27,3 +28,28 @@ BOOST_AUTO_TEST_CASE(TestCompletionPolicy)
 
   BOOST_REQUIRE_EQUAL(oss.str(), "consumeprocesswaitdiscard");
 }
+
+BOOST_AUTO_TEST_CASE(TestCountCallbacks)
+{
+  using CompletionOp = CompletionPolicy::CompletionOp;
+  auto all = CompletionPolicyHelpers::consumeWhenAll();
+  BOOST_REQUIRE(all.countCallback);
+  BOOST_CHECK_EQUAL(all.countCallback(0, 3), CompletionOp::Wait);
+  BOOST_CHECK_EQUAL(all.countCallback(2, 3), CompletionOp::Wait);
+  BOOST_CHECK_EQUAL(all.countCallback(3, 3), CompletionOp::Consume);
+
+  auto any = CompletionPolicyHelpers::consumeWhenAny();
+  BOOST_REQUIRE(any.countCallback);
+  BOOST_CHECK_EQUAL(any.countCallback(0, 3), CompletionOp::Wait);
+  BOOST_CHECK_EQUAL(any.countCallback(1, 3), CompletionOp::Consume);
+
+  auto process = CompletionPolicyHelpers::processWhenAny();
+  BOOST_REQUIRE(process.countCallback);
+  BOOST_CHECK_EQUAL(process.countCallback(0, 3), CompletionOp::Wait);
+  BOOST_CHECK_EQUAL(process.countCallback(1, 3), CompletionOp::Process);
+  BOOST_CHECK_EQUAL(process.countCallback(3, 3), CompletionOp::Consume);
+
+  auto byName = CompletionPolicyHelpers::defineByName("foo", CompletionOp::Discard);
+  BOOST_REQUIRE(byName.countCallback);
+  BOOST_CHECK_EQUAL(byName.countCallback(1, 3), CompletionOp::Discard);
+}
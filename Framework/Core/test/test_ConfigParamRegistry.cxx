@@ -83,4 +83,21 @@ BOOST_AUTO_TEST_CASE(TestConfigParamRegistry)
   Foo obj = registry.get<Foo>("aNested");
   BOOST_CHECK_EQUAL(obj.x, 1);
   BOOST_CHECK_EQUAL(obj.y, 2.f);
+
+  // Handles are resolved once and then read without any lookup.
+  auto anInt = registry.handle<int>("anInt");
+  auto aString = registry.handle<std::string>("aString");
+  BOOST_CHECK_EQUAL(*anInt, 10);
+  BOOST_CHECK_EQUAL(aString.get(), "somethingelse");
+  BOOST_CHECK_EQUAL(aString->size(), 13);
+  BOOST_CHECK_THROW(registry.handle<int>("notAnOption"), std::invalid_argument);
+
+  // Only the lookups by name done while processing are counted.
+  BOOST_CHECK_EQUAL(registry.processingLookups(), 0);
+  registry.setProcessing(true);
+  BOOST_CHECK_EQUAL(*anInt, 10);
+  BOOST_CHECK_EQUAL(registry.get<int>("anInt"), 10);
+  registry.setProcessing(false);
+  BOOST_CHECK_EQUAL(registry.get<int>("anInt"), 10);
+  BOOST_CHECK_EQUAL(registry.processingLookups(), 1);
 }
@@ -0,0 +1,129 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework CpuPlacement
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "../src/CpuPlacement.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace o2::framework;
+
+namespace
+{
+/// A device with channels to the given devices
+DeviceSpec makeDevice(std::string const& id, std::vector<std::string> const& from, std::vector<std::string> const& to)
+{
+  DeviceSpec device;
+  device.id = id;
+  for (auto& producer : from) {
+    device.inputChannels.push_back(InputChannelSpec{ "from_" + producer + "_to_" + id, ChannelType::Pull, ChannelMethod::Connect, 0 });
+  }
+  for (auto& consumer : to) {
+    device.outputChannels.push_back(OutputChannelSpec{ "from_" + id + "_to_" + consumer, ChannelType::Push, ChannelMethod::Bind, 0, 1 });
+  }
+  return device;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestParseCpuList)
+{
+  BOOST_CHECK(CpuTopology::parseCpuList("") == std::vector<int>{});
+  BOOST_CHECK((CpuTopology::parseCpuList("0-3,8,10-11") == std::vector<int>{ 0, 1, 2, 3, 8, 10, 11 }));
+  BOOST_CHECK((CpuTopology::parseCpuList("5") == std::vector<int>{ 5 }));
+  BOOST_CHECK_THROW(CpuTopology::parseCpuList("a-b"), std::runtime_error);
+
+  auto topology = CpuTopology::uniform(8, 2);
+  BOOST_REQUIRE_EQUAL(topology.cores.size(), 8);
+  BOOST_CHECK_EQUAL(topology.numaNodes(), 2);
+  BOOST_CHECK_EQUAL(topology.cores[3].numaNode, 0);
+  BOOST_CHECK_EQUAL(topology.cores[4].numaNode, 1);
+  // whatever the host, there is at least one core to run on
+  BOOST_CHECK(CpuTopology::fromSysfs().cores.empty() == false);
+}
+
+BOOST_AUTO_TEST_CASE(TestPolicyStreaming)
+{
+  CpuPlacementPolicy policy;
+  std::istringstream in("numa");
+  in >> policy;
+  BOOST_CHECK(policy == CpuPlacementPolicy::NUMA);
+  std::ostringstream out;
+  out << CpuPlacementPolicy::CORES;
+  BOOST_CHECK_EQUAL(out.str(), "cores");
+  std::istringstream invalid("everywhere");
+  invalid >> policy;
+  BOOST_CHECK(invalid.fail());
+}
+
+BOOST_AUTO_TEST_CASE(TestCoresPolicy)
+{
+  std::vector<DeviceSpec> devices{
+    makeDevice("A", {}, { "B" }),
+    makeDevice("B", { "A" }, {}),
+    makeDevice("C", {}, {}),
+  };
+  auto topology = CpuTopology::uniform(2);
+  auto none = CpuPlacementHelpers::placeDevices(devices, topology, CpuPlacementPolicy::NONE);
+  BOOST_REQUIRE_EQUAL(none.size(), 3);
+  BOOST_CHECK(none[0].empty() && none[1].empty() && none[2].empty());
+
+  auto cores = CpuPlacementHelpers::placeDevices(devices, topology, CpuPlacementPolicy::CORES);
+  BOOST_CHECK((cores[0] == std::vector<int>{ 0 }));
+  BOOST_CHECK((cores[1] == std::vector<int>{ 1 }));
+  // no core left, not pinned
+  BOOST_CHECK(cores[2].empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestNumaPolicy)
+{
+  // Two independent chains of producer, processor and consumer
+  std::vector<DeviceSpec> devices{
+    makeDevice("A0", {}, { "B0" }),
+    makeDevice("A1", {}, { "B1" }),
+    makeDevice("B0", { "A0" }, { "C0" }),
+    makeDevice("B1", { "A1" }, { "C1" }),
+    makeDevice("C0", { "B0" }, {}),
+    makeDevice("C1", { "B1" }, {}),
+  };
+  auto topology = CpuTopology::uniform(8, 2);
+  auto placement = CpuPlacementHelpers::placeDevices(devices, topology, CpuPlacementPolicy::NUMA);
+  auto nodeOf = [&topology](std::vector<int> const& cores) {
+    BOOST_REQUIRE_EQUAL(cores.size(), 1);
+    return topology.cores[cores[0]].numaNode;
+  };
+  // every chain stays on one node, the chains are spread on the two nodes
+  BOOST_CHECK_EQUAL(nodeOf(placement[0]), nodeOf(placement[2]));
+  BOOST_CHECK_EQUAL(nodeOf(placement[2]), nodeOf(placement[4]));
+  BOOST_CHECK_EQUAL(nodeOf(placement[1]), nodeOf(placement[3]));
+  BOOST_CHECK_EQUAL(nodeOf(placement[3]), nodeOf(placement[5]));
+  BOOST_CHECK(nodeOf(placement[0]) != nodeOf(placement[1]));
+  // on distinct cores
+  std::vector<int> used;
+  for (auto& cores : placement) {
+    used.push_back(cores[0]);
+  }
+  std::sort(used.begin(), used.end());
+  BOOST_CHECK(std::adjacent_find(used.begin(), used.end()) == used.end());
+
+  // Once the cores are exhausted, the devices get the whole node of their
+  // neighbours
+  auto small = CpuPlacementHelpers::placeDevices(devices, CpuTopology::uniform(2, 2), CpuPlacementPolicy::NUMA);
+  BOOST_CHECK((small[0] == std::vector<int>{ 0 }));
+  BOOST_CHECK((small[1] == std::vector<int>{ 1 }));
+  BOOST_CHECK((small[2] == std::vector<int>{ 0 }));
+  BOOST_CHECK((small[3] == std::vector<int>{ 1 }));
+}
@@ -115,6 +115,11 @@ DataProcessorSpec getSourceSpec()
     auto& shrinkchunk = pc.outputs().newChunk(OutputRef{ "shrinkchunk", 0 }, 1000000);
     shrinkchunk.resize(sizeof(o2::test::TriviallyCopyable));
     memcpy(shrinkchunk.data(), &a, sizeof(o2::test::TriviallyCopyable));
+    // test the vector allocated in the message memory, growing it in place
+    auto& pmrvec = pc.outputs().make<o2::vector<o2::test::TriviallyCopyable>>(OutputRef{ "makepmrvector", 0 });
+    for (size_t i = 0; i < 100; ++i) {
+      pmrvec.emplace_back(a);
+    }
   };
 
   return DataProcessorSpec{ "source", // name of the processor
@@ -124,6 +129,7 @@ DataProcessorSpec getSourceSpec()
                               OutputSpec{ { "makespan" }, "TST", "MAKESPAN", 0, Lifetime::Timeframe },
                               OutputSpec{ { "growchunk" }, "TST", "GROWCHUNK", 0, Lifetime::Timeframe },
                               OutputSpec{ { "shrinkchunk" }, "TST", "SHRINKCHUNK", 0, Lifetime::Timeframe },
+                              OutputSpec{ { "makepmrvector" }, "TST", "MAKEPMRVECTOR", 0, Lifetime::Timeframe },
                               OutputSpec{ "TST", "ADOPTCHUNK", 0, Lifetime::Timeframe },
                               OutputSpec{ "TST", "MSGBLEROOTSRLZ", 0, Lifetime::Timeframe },
                               OutputSpec{ "TST", "ROOTNONTOBJECT", 0, Lifetime::Timeframe },
@@ -230,6 +236,13 @@ DataProcessorSpec getSinkSpec()
     auto object11 = pc.inputs().get<o2::test::TriviallyCopyable>("input11");
     ASSERT_ERROR(object11 == o2::test::TriviallyCopyable(42, 23, 0xdead));
 
+    LOG(INFO) << "extracting span of o2::test::TriviallyCopyable from input12";
+    auto objectspan12 = DataRefUtils::as<o2::test::TriviallyCopyable>(pc.inputs().get("input12"));
+    ASSERT_ERROR(objectspan12.size() == 100);
+    for (auto const& object12 : objectspan12) {
+      ASSERT_ERROR(object12 == o2::test::TriviallyCopyable(42, 23, 0xdead));
+    }
+
     pc.services().get<ControlService>().readyToQuit(true);
   };
 
@@ -244,7 +257,8 @@ DataProcessorSpec getSinkSpec()
                               InputSpec{ "input8", "TST", "MAKESPAN", 0, Lifetime::Timeframe },
                               InputSpec{ "input9", "TST", "ADOPTCHUNK", 0, Lifetime::Timeframe },
                               InputSpec{ "input10", "TST", "GROWCHUNK", 0, Lifetime::Timeframe },
-                              InputSpec{ "input11", "TST", "SHRINKCHUNK", 0, Lifetime::Timeframe } },
+                              InputSpec{ "input11", "TST", "SHRINKCHUNK", 0, Lifetime::Timeframe },
+                              InputSpec{ "input12", "TST", "MAKEPMRVECTOR", 0, Lifetime::Timeframe } },
                             Outputs{},
                             AlgorithmSpec(processingFct) };
 }
@@ -21,7 +21,9 @@
 #include "Framework/WorkflowSpec.h"
 #include <Monitoring/Monitoring.h>
 #include <fairmq/FairMQTransportFactory.h>
+#include <atomic>
 #include <cstring>
+#include <thread>
 
 using Monitoring = o2::monitoring::Monitoring;
 using namespace o2::framework;
@@ -380,3 +382,59 @@ BOOST_AUTO_TEST_CASE(TestPolicies) {
   BOOST_CHECK_EQUAL(ready3[0].slot.index, 1);
   BOOST_CHECK_EQUAL(ready3[0].op, CompletionPolicy::CompletionOp::Consume);
 }
+
+// This verifies that multiple threads can relay parts for the same timeslice
+// at the same time and that the completion bookkeeping stays consistent.
+BOOST_AUTO_TEST_CASE(TestConcurrentRelay)
+{
+  Monitoring metrics;
+  std::vector<o2::header::DataDescription> descriptions = { "CLUSTERS", "TRACKS", "DIGITS", "HITS" };
+
+  std::vector<InputRoute> inputs;
+  for (size_t i = 0; i < descriptions.size(); ++i) {
+    inputs.push_back(InputRoute{ InputSpec{ "input" + std::to_string(i), "TPC", descriptions[i] }, "Fake" + std::to_string(i), 0 });
+  }
+
+  std::vector<ForwardRoute> forwards;
+  TimesliceIndex index;
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  DataRelayer relayer(policy, inputs, forwards, metrics, index);
+  relayer.setPipelineLength(4);
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  auto createMessage = [&transport, &relayer](o2::header::DataDescription const& description, size_t time) {
+    DataHeader dh;
+    dh.dataDescription = description;
+    dh.dataOrigin = "TPC";
+    dh.subSpecification = 0;
+    DataProcessingHeader dph{ time, 1 };
+    Stack stack{ dh, dph };
+    FairMQMessagePtr header = transport->CreateMessage(stack.size());
+    FairMQMessagePtr payload = transport->CreateMessage(1000);
+    memcpy(header->GetData(), stack.data(), stack.size());
+    return relayer.relay(std::move(header), std::move(payload));
+  };
+
+  std::vector<std::thread> threads;
+  std::atomic<size_t> relayed{ 0 };
+  for (auto& description : descriptions) {
+    threads.emplace_back([&createMessage, &relayed, description]() {
+      if (createMessage(description, 0) == DataRelayer::WillRelay) {
+        relayed++;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(relayed.load(), descriptions.size());
+
+  auto ready = relayer.getReadyToProcess();
+  BOOST_REQUIRE_EQUAL(ready.size(), 1);
+  BOOST_CHECK_EQUAL(ready[0].op, CompletionPolicy::CompletionOp::Consume);
+  BOOST_CHECK_EQUAL(relayer.getFilledInputs(ready[0].slot), descriptions.size());
+  auto result = relayer.getInputsForTimeslice(ready[0].slot);
+  BOOST_REQUIRE_EQUAL(result.size(), 2 * descriptions.size());
+  BOOST_CHECK_EQUAL(relayer.getFilledInputs(ready[0].slot), 0);
+}
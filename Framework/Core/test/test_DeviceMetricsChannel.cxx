@@ -0,0 +1,128 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework DeviceMetricsChannel
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/DeviceMetricsChannel.h"
+#include "Framework/DeviceMetricsInfo.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace o2::framework;
+
+std::string channelName(char const* test)
+{
+  return std::string("/dpl-test-metrics-") + test + "-" + std::to_string(getpid());
+}
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsChannelRoundTrip)
+{
+  auto driver = DeviceMetricsChannel::create(channelName("roundtrip"), 4096);
+  BOOST_REQUIRE(driver != nullptr);
+  // the segment can not be created twice
+  BOOST_CHECK(DeviceMetricsChannel::create(channelName("roundtrip"), 4096) == nullptr);
+  auto device = DeviceMetricsChannel::attach(channelName("roundtrip"));
+  BOOST_REQUIRE(device != nullptr);
+
+  BOOST_CHECK(device->push("akey", 12, 1789372894));
+  BOOST_CHECK(device->push("bkey", 1.5f, 1789372895));
+  BOOST_CHECK(device->push("ckey", std::string_view("some string"), 1789372896));
+  BOOST_CHECK(device->push("akey", 13, 1789372897));
+
+  DeviceMetricsInfo info;
+  std::vector<std::string> keys;
+  auto count = driver->poll([&info, &keys](ParsedMetricMatch& match) {
+    keys.emplace_back(match.beginKey, match.endKey);
+    BOOST_CHECK(DeviceMetricsHelper::processMetric(match, info));
+  });
+  BOOST_CHECK_EQUAL(count, 4);
+  BOOST_REQUIRE_EQUAL(keys.size(), 4);
+  BOOST_CHECK_EQUAL(keys[0], "akey");
+  BOOST_CHECK_EQUAL(keys[2], "ckey");
+  BOOST_CHECK_EQUAL(keys[3], "akey");
+  BOOST_REQUIRE_EQUAL(info.metrics.size(), 3);
+  BOOST_CHECK_EQUAL(info.intMetrics[0][0], 12);
+  BOOST_CHECK_EQUAL(info.intMetrics[0][1], 13);
+  BOOST_CHECK_EQUAL(info.floatMetrics[0][0], 1.5f);
+  BOOST_CHECK_EQUAL(std::string(info.stringMetrics[0][0].data), "some string");
+  BOOST_CHECK_EQUAL(info.timestamps[0][1], 1789372897);
+  BOOST_CHECK_EQUAL(driver->poll([](ParsedMetricMatch&) {}), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsChannelWrapAndDrop)
+{
+  auto driver = DeviceMetricsChannel::create(channelName("wrap"), 1024);
+  BOOST_REQUIRE(driver != nullptr);
+  auto device = DeviceMetricsChannel::attach(channelName("wrap"));
+  BOOST_REQUIRE(device != nullptr);
+
+  // fill the ring until metrics are dropped, then drain it and continue,
+  // such that the records wrap at the end of the ring several times
+  int pushed = 0;
+  int received = 0;
+  int expected = 0;
+  bool ordered = true;
+  auto check = [&received, &expected, &ordered](ParsedMetricMatch& match) {
+    ordered = ordered && match.type == MetricType::Int && match.intValue == expected;
+    ++expected;
+    ++received;
+  };
+  for (int round = 0; round < 10; ++round) {
+    while (device->push("counter", pushed, pushed)) {
+      ++pushed;
+    }
+    driver->poll(check);
+  }
+  BOOST_CHECK(pushed > 100);
+  BOOST_CHECK_EQUAL(received, pushed);
+  BOOST_CHECK(ordered);
+  BOOST_CHECK_EQUAL(device->dropped(), 10);
+  BOOST_CHECK_EQUAL(driver->dropped(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsChannelProcesses)
+{
+  // the name depends on the pid, it must be taken before the fork
+  auto name = channelName("fork");
+  auto driver = DeviceMetricsChannel::create(name, 1 << 16);
+  BOOST_REQUIRE(driver != nullptr);
+  constexpr int nMetrics = 100000;
+  pid_t pid = fork();
+  if (pid == 0) {
+    auto device = DeviceMetricsChannel::attach(name);
+    if (device == nullptr) {
+      _exit(1);
+    }
+    for (int i = 0; i < nMetrics; ++i) {
+      while (device->push("counter", i, i) == false) {
+        usleep(10);
+      }
+    }
+    _exit(0);
+  }
+  int received = 0;
+  bool ordered = true;
+  auto check = [&received, &ordered](ParsedMetricMatch& match) {
+    ordered = ordered && match.intValue == received && match.timestamp == (size_t)received;
+    ++received;
+  };
+  int status = 0;
+  while (waitpid(pid, &status, WNOHANG) == 0) {
+    driver->poll(check);
+  }
+  driver->poll(check);
+  BOOST_CHECK_EQUAL(received, nMetrics);
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  BOOST_CHECK(ordered);
+}
@@ -50,7 +50,7 @@ BOOST_AUTO_TEST_CASE(TestDeviceMetricsInfo) {
 
   BOOST_CHECK_EQUAL(info.timestamps[0][0], 1789372894);
   BOOST_CHECK_EQUAL(info.intMetrics[0][0], 12);
-  BOOST_CHECK_EQUAL(info.intMetrics[0][1], 0);
+  BOOST_CHECK_EQUAL(info.intMetrics[0].size(), 1);
 
   // Parse a second metric with the same key
   metric = "[METRIC] bkey,0 13 1789372894 hostname=test.cern.ch";
@@ -63,7 +63,7 @@ BOOST_AUTO_TEST_CASE(TestDeviceMetricsInfo) {
   BOOST_CHECK_EQUAL(info.intMetrics.size(), 1);
   BOOST_CHECK_EQUAL(info.intMetrics[0][0], 12);
   BOOST_CHECK_EQUAL(info.intMetrics[0][1], 13);
-  BOOST_CHECK_EQUAL(info.intMetrics[0][2], 0);
+  BOOST_CHECK_EQUAL(info.intMetrics[0].size(), 2);
   BOOST_CHECK_EQUAL(info.metrics[0].pos, 2);
 
   // Parse a third metric with a different key
@@ -76,7 +76,7 @@ BOOST_AUTO_TEST_CASE(TestDeviceMetricsInfo) {
   BOOST_CHECK_EQUAL(info.intMetrics.size(), 2);
   BOOST_CHECK_EQUAL(info.intMetrics[0][0], 12);
   BOOST_CHECK_EQUAL(info.intMetrics[0][1], 13);
-  BOOST_CHECK_EQUAL(info.intMetrics[0][2], 0);
+  BOOST_CHECK_EQUAL(info.intMetrics[0].size(), 2);
   BOOST_CHECK_EQUAL(info.intMetrics[1][0], 14);
   BOOST_CHECK_EQUAL(info.metrics.size(), 2);
   BOOST_CHECK_EQUAL(info.metrics[1].type, MetricType::Int);
@@ -94,7 +94,7 @@ BOOST_AUTO_TEST_CASE(TestDeviceMetricsInfo) {
   BOOST_CHECK_EQUAL(info.floatMetrics.size(), 1);
   BOOST_CHECK_EQUAL(info.metrics.size(), 3);
   BOOST_CHECK_EQUAL(info.floatMetrics[0][0], 16.0);
-  BOOST_CHECK_EQUAL(info.floatMetrics[0][1], 0);
+  BOOST_CHECK_EQUAL(info.floatMetrics[0].size(), 1);
   BOOST_CHECK_EQUAL(info.metrics[2].type, MetricType::Float);
   BOOST_CHECK_EQUAL(info.metrics[2].storeIdx, 0);
   BOOST_CHECK_EQUAL(info.metrics[2].pos, 1);
@@ -111,7 +111,7 @@ BOOST_AUTO_TEST_CASE(TestDeviceMetricsInfo) {
   BOOST_CHECK_EQUAL(info.metrics.size(), 3);
   BOOST_CHECK_EQUAL(info.floatMetrics[0][0], 16.0);
   BOOST_CHECK_EQUAL(info.floatMetrics[0][1], 17.0);
-  BOOST_CHECK_EQUAL(info.floatMetrics[0][2], 0);
+  BOOST_CHECK_EQUAL(info.floatMetrics[0].size(), 2);
   BOOST_CHECK_EQUAL(info.metrics[2].type, MetricType::Float);
   BOOST_CHECK_EQUAL(info.metrics[2].storeIdx, 0);
   BOOST_CHECK_EQUAL(info.metrics[2].pos, 2);
@@ -128,3 +128,65 @@ BOOST_AUTO_TEST_CASE(TestDeviceMetricsInfo) {
   result = DeviceMetricsHelper::processMetric(match, info);
   BOOST_CHECK_EQUAL(result, true);
 }
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsHistory)
+{
+  using namespace o2::framework;
+  ParsedMetricMatch match;
+  DeviceMetricsInfo info;
+
+  // One value every 100ms for 20 minutes, going up and down between 0 and 99
+  size_t const start = 1789372890000;
+  size_t const n = 12000;
+  for (size_t i = 0; i < n; ++i) {
+    auto metric = "[METRIC] akey,0 " + std::to_string(i % 100) + " " + std::to_string(start + i * 100) + " hostname=test.cern.ch";
+    BOOST_REQUIRE(DeviceMetricsHelper::parseMetric(metric, match));
+    BOOST_REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+  }
+  // The histories are bounded
+  BOOST_CHECK_EQUAL(info.intMetrics[0].size(), DeviceMetricsInfo::MAX_HISTORY_SIZE);
+  BOOST_CHECK_EQUAL(info.timestamps[0].size(), DeviceMetricsInfo::MAX_HISTORY_SIZE);
+  BOOST_CHECK_EQUAL(info.aggregates[0][0].buckets.size(), DeviceMetricsInfo::MAX_AGGREGATE_SIZE);
+  BOOST_CHECK_EQUAL(info.aggregates[0][1].buckets.size(), n / 100);
+  BOOST_CHECK_EQUAL(info.metrics[0].pos, n % DeviceMetricsInfo::MAX_HISTORY_SIZE);
+  auto& last = info.aggregates[0][1].buckets.back();
+  BOOST_CHECK_EQUAL(last.timestamp, start + (n / 100 - 1) * 10000);
+  BOOST_CHECK_EQUAL(last.count, 100);
+  BOOST_CHECK_EQUAL(last.min, 0);
+  BOOST_CHECK_EQUAL(last.max, 99);
+  BOOST_CHECK_CLOSE(last.avg(), 49.5, 0.001);
+
+  // The last seconds come from the raw values
+  std::vector<MetricPoint> points;
+  size_t end = start + (n - 1) * 100;
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::extractHistory(info, 0, end - 999, end, 1024, points), 10);
+  BOOST_CHECK_EQUAL(points.front().timestamp, end - 900);
+  BOOST_CHECK_EQUAL(points.front().avg, 90);
+  BOOST_CHECK_EQUAL(points.back().avg, 99);
+
+  // The last minute is still in the raw values, merged to fit in the points
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::extractHistory(info, 0, end - 59999, end, 60, points), 60);
+  BOOST_CHECK_EQUAL(points.back().min, 90);
+  BOOST_CHECK_EQUAL(points.back().avg, 94.5);
+
+  // The last 5 minutes come from the 1s buckets
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::extractHistory(info, 0, end - 299900, end, 1024, points), 300);
+  BOOST_CHECK_EQUAL(points.back().min, 90);
+  BOOST_CHECK_EQUAL(points.back().max, 99);
+  BOOST_CHECK_EQUAL(points.back().avg, 94.5);
+
+  // The whole run comes from the 10s buckets, merged to fit in the points.
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::extractHistory(info, 0, start, end, 50, points), 40);
+  BOOST_CHECK_EQUAL(points.front().timestamp, start);
+  BOOST_CHECK_EQUAL(points.front().min, 0);
+  BOOST_CHECK_EQUAL(points.front().max, 99);
+  BOOST_CHECK_CLOSE(points.front().avg, 49.5, 0.001);
+
+  // String metrics have no numeric history
+  auto metric = std::string("[METRIC] bkey,1 some_string 1789372895000 hostname=test.cern.ch");
+  BOOST_REQUIRE(DeviceMetricsHelper::parseMetric(metric, match));
+  BOOST_REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+  BOOST_CHECK_EQUAL(info.aggregates[1][0].buckets.size(), 0);
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::extractHistory(info, 1, 0, -1, 1024, points), 0);
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::extractHistory(info, 7, 0, -1, 1024, points), 0);
+}
@@ -0,0 +1,94 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/DataRefUtils.h"
+#include "Framework/AlgorithmSpec.h"
+#include "Framework/ServiceRegistry.h"
+#include "Framework/runDataProcessing.h"
+#include <Monitoring/Monitoring.h>
+#include "Framework/ControlService.h"
+#include "FairMQLogger.h"
+#include "Framework/SerializationMethods.h"
+
+using namespace o2::framework;
+
+/// Dummy struct with flat fields to perform some tests, same content
+/// as the one of test_BoostSerializedProcessing
+struct Foo {
+  int fBar1;
+  double fBar2[2];
+  std::vector<float> fBar3;
+  std::string fBar4;
+
+  template <typename Self>
+  static auto flatFields(Self& self)
+  {
+    return std::tie(self.fBar1, self.fBar2, self.fBar3, self.fBar4);
+  }
+};
+
+Foo makeFoo(size_t i)
+{
+  float iFloat = (float)i;
+  return Foo{ (int)i, { 2. * iFloat, 2.1 * iFloat }, { iFloat * 3.f, iFloat * 3.1f, iFloat * 3.2f }, "This is Foo!" };
+}
+
+WorkflowSpec defineDataProcessing(ConfigContext const&)
+{
+  return WorkflowSpec{
+    //
+    DataProcessorSpec{
+      "flat_serialized_producer", //
+      Inputs{},                   //
+      {
+        OutputSpec{ { "make" }, "TES", "FLAT" },     //
+        OutputSpec{ { "snapshot" }, "TES", "FLAT2" }, //
+      },
+      AlgorithmSpec{ [](ProcessingContext& ctx) {
+        auto& out1 = ctx.outputs().make<FlatSerialized<std::vector<Foo>>>({ "TES", "FLAT" });
+        std::vector<Foo> out2;
+        for (size_t i = 0; i < 17; i++) {
+          out1.emplace_back(makeFoo(i));
+          out2.emplace_back(makeFoo(i + 1));
+        }
+        ctx.outputs().snapshot({ "TES", "FLAT2" }, FlatSerialized<decltype(out2)>(out2));
+      } } //
+    },    //
+    DataProcessorSpec{
+      "flat_serialized_consumer", //
+      {
+        InputSpec{ { "make" }, "TES", "FLAT" },      //
+        InputSpec{ { "snapshot" }, "TES", "FLAT2" }, //
+      },                                             //
+      Outputs{},                                     //
+      AlgorithmSpec{
+        [](ProcessingContext& ctx) {
+          for (auto binding : { "make", "snapshot" }) {
+            auto in = ctx.inputs().get<FlatSerialized<std::vector<Foo>>>(binding);
+            size_t first = binding == std::string("make") ? 0 : 1;
+            assert(in.size() == 17);
+            auto bar1 = in.column<0>();
+            auto bar3 = in.column<2>();
+            auto bar4 = in.column<3>();
+            for (size_t i = 0; i < in.size(); i++) {
+              auto check = makeFoo(i + first);
+              assert((bar1[i] == check.fBar1));                                           // fBar1 wrong
+              assert((in.column<1>()[i][1] == check.fBar2[1]));                           // fBar2[1] wrong
+              assert((std::equal(bar3[i].begin(), bar3[i].end(), check.fBar3.begin()))); // fBar3 wrong
+              assert((std::string(bar4[i].begin(), bar4[i].end()) == check.fBar4));      // fBar4 wrong
+              assert((in[i].fBar2[0] == check.fBar2[0]));                                 // fBar2[0] wrong
+            }
+          }
+          ctx.services().get<ControlService>().readyToQuit(true);
+        } //
+      }   //
+    }     //
+  };
+}
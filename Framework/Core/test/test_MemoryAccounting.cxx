@@ -0,0 +1,86 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework MemoryAccounting
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/MemoryAccounting.h"
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestLiveAndPeak)
+{
+  MemoryAccounting accounting;
+  accounting.allocated(MemorySource::Inputs, 1000);
+  accounting.allocated(MemorySource::Outputs, 300);
+  accounting.released(MemorySource::Outputs, 300);
+  accounting.allocated(MemorySource::Outputs, 200);
+  BOOST_CHECK_EQUAL(accounting.live(MemorySource::Inputs), 1000);
+  BOOST_CHECK_EQUAL(accounting.live(MemorySource::Outputs), 200);
+  BOOST_CHECK_EQUAL(accounting.peak(MemorySource::Outputs), 300);
+  BOOST_CHECK_EQUAL(accounting.live(), 1200);
+  BOOST_CHECK_EQUAL(accounting.peak(), 1300);
+
+  accounting.released(MemorySource::Inputs, 1000);
+  accounting.released(MemorySource::Outputs, 200);
+  BOOST_CHECK_EQUAL(accounting.live(), 0);
+  BOOST_CHECK_EQUAL(accounting.peak(MemorySource::Inputs), 1000);
+
+  // the peaks of the next timeslice start from what is still alive
+  accounting.allocated(MemorySource::Deserialized, 50);
+  accounting.resetPeaks();
+  BOOST_CHECK_EQUAL(accounting.peak(MemorySource::Inputs), 0);
+  BOOST_CHECK_EQUAL(accounting.peak(MemorySource::Deserialized), 50);
+  BOOST_CHECK_EQUAL(accounting.peak(), 50);
+
+  BOOST_CHECK_EQUAL(MemoryAccounting::name(MemorySource::User), std::string("user"));
+  BOOST_CHECK_EQUAL(MemoryAccounting::name(MemorySource::Count), std::string("total"));
+}
+
+BOOST_AUTO_TEST_CASE(TestUserResource)
+{
+  MemoryAccounting accounting;
+  {
+    std::vector<int, boost::container::pmr::polymorphic_allocator<int>> v(accounting.resource());
+    v.reserve(1000);
+    BOOST_CHECK_EQUAL(accounting.live(MemorySource::User), 1000 * sizeof(int));
+    v.reserve(2000);
+    BOOST_CHECK_EQUAL(accounting.live(MemorySource::User), 2000 * sizeof(int));
+    BOOST_CHECK_EQUAL(accounting.peak(MemorySource::User), 3000 * sizeof(int));
+  }
+  BOOST_CHECK_EQUAL(accounting.live(MemorySource::User), 0);
+  BOOST_CHECK_EQUAL(accounting.live(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestThreads)
+{
+  MemoryAccounting accounting;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&accounting]() {
+      for (int i = 0; i < 10000; ++i) {
+        accounting.allocated(MemorySource::User, 10);
+        accounting.released(MemorySource::User, 10);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(accounting.live(MemorySource::User), 0);
+  BOOST_CHECK(accounting.peak(MemorySource::User) >= 10);
+  BOOST_CHECK(accounting.peak(MemorySource::User) <= 40);
+}
@@ -0,0 +1,51 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework MetricHandles
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/MetricHandles.h"
+#include <Monitoring/Monitoring.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::framework;
+using Monitoring = o2::monitoring::Monitoring;
+
+BOOST_AUTO_TEST_CASE(TestMetricHandlesRegistration)
+{
+  MetricHandles metrics;
+  BOOST_CHECK_EQUAL(metrics.size(), 0);
+  BOOST_CHECK_EQUAL(metrics.add("malformed_inputs", true), 0);
+  BOOST_CHECK_EQUAL(metrics.addRange("data_relayer/", 4), 1);
+  BOOST_CHECK_EQUAL(metrics.add("relayed_messages", true), 5);
+  BOOST_CHECK_EQUAL(metrics.size(), 6);
+  metrics.set(3, 2);
+  BOOST_CHECK_EQUAL(metrics.get(3), 2);
+  BOOST_CHECK_EQUAL(metrics.get(4), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestMetricHandlesFlush)
+{
+  Monitoring monitoring;
+  MetricHandles metrics;
+  metrics.addRange("data_relayer/", 8);
+
+  // Everything is sent the first time, even with onlyChanged
+  BOOST_CHECK_EQUAL(metrics.flush(monitoring, true), 8);
+  BOOST_CHECK_EQUAL(metrics.flush(monitoring, true), 0);
+  metrics.set(2, 1);
+  metrics.set(5, 3);
+  BOOST_CHECK_EQUAL(metrics.flush(monitoring, true), 2);
+  // Setting back the value which was sent is not a change
+  metrics.set(2, 2);
+  metrics.set(2, 1);
+  BOOST_CHECK_EQUAL(metrics.flush(monitoring, true), 0);
+  BOOST_CHECK_EQUAL(metrics.flush(monitoring), 8);
+}
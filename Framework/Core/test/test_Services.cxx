@@ -55,6 +55,12 @@ BOOST_AUTO_TEST_CASE(TestServiceRegistry) {
   BOOST_CHECK(registry.get<InterfaceC const>().method() == false);
   BOOST_CHECK_THROW(registry.get<InterfaceA const>(), std::runtime_error);
   BOOST_CHECK_THROW(registry.get<InterfaceC>(), std::runtime_error);
+
+  // a type which was never registered
+  struct InterfaceD {
+  };
+  BOOST_CHECK_THROW(registry.get<InterfaceD>(), std::runtime_error);
+  BOOST_CHECK_THROW(registry.get<InterfaceD const>(), std::runtime_error);
 }
 
 BOOST_AUTO_TEST_CASE(TestCallbackService)
@@ -14,6 +14,7 @@
 
 #include "Framework/TMessageSerializer.h"
 #include "TestClasses.h"
+#include <fairmq/FairMQTransportFactory.h>
 #include <boost/test/unit_test.hpp>
 
 using namespace o2::framework;
@@ -81,6 +82,41 @@ BOOST_AUTO_TEST_CASE(TestTMessageSerializer_NonTObject)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestTMessageSerializer_ToMessage)
+{
+  using namespace o2::framework;
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  size_t created = 0;
+  auto creator = [&transport, &created](size_t size) {
+    created++;
+    return transport->CreateMessage(size);
+  };
+
+  // Large enough for the message to grow from the default size
+  std::vector<o2::test::Polymorphic> data;
+  for (unsigned int i = 0; i < 4096; ++i) {
+    data.emplace_back(i);
+  }
+  TClass* cl = TClass::GetClass("std::vector<o2::test::Polymorphic>");
+  BOOST_REQUIRE(cl != nullptr);
+
+  auto msg = TMessageSerializer::SerializeToMessage(creator, &data, cl);
+  BOOST_REQUIRE(msg);
+  BOOST_CHECK(created > 1);
+  auto out = TMessageSerializer::deserialize<std::vector<o2::test::Polymorphic>>(as_span(*msg));
+  BOOST_REQUIRE(out);
+  BOOST_CHECK(*out == data);
+
+  // The size of the previous object is used for the next one of the same class
+  created = 0;
+  auto msg2 = TMessageSerializer::SerializeToMessage(creator, &data, cl);
+  BOOST_CHECK_EQUAL(created, 1);
+  BOOST_CHECK_EQUAL(msg2->GetSize(), msg->GetSize());
+  auto out2 = TMessageSerializer::deserialize<std::vector<o2::test::Polymorphic>>(as_span(*msg2));
+  BOOST_REQUIRE(out2);
+  BOOST_CHECK(*out2 == data);
+}
+
 BOOST_AUTO_TEST_CASE(TestTMessageSerializer_InvalidBuffer)
 {
   const char* buffer = "this is for sure not a serialized ROOT object";
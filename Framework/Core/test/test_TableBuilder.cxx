@@ -82,6 +82,55 @@ BOOST_AUTO_TEST_CASE(TestTableBuilderBulk)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestTableBuilderBulkFill)
+{
+  using namespace o2::framework;
+  std::vector<int> x{ 0, 1, 2, 3, 4, 5, 6, 7 };
+  std::vector<float> y{ 0., 1., 2., 3., 4., 5., 6., 7. };
+
+  TableBuilder builder;
+  builder.bulkFill<int, float>({ "x", "y" }, x, y);
+  BOOST_CHECK_THROW(builder.bulkFill<int>({ "x" }, x), std::runtime_error);
+  auto table = builder.finalize();
+  BOOST_REQUIRE_EQUAL(table->num_columns(), 2);
+  BOOST_REQUIRE_EQUAL(table->num_rows(), 8);
+  BOOST_REQUIRE_EQUAL(table->column(1)->type()->id(), arrow::float32()->id());
+  auto p = std::dynamic_pointer_cast<arrow::NumericArray<arrow::FloatType>>(table->column(1)->data()->chunk(0));
+  for (size_t i = 0; i < 8; ++i) {
+    BOOST_CHECK_EQUAL(p->Value(i), i);
+  }
+
+  TableBuilder mismatching;
+  BOOST_CHECK_THROW((mismatching.bulkFill<int, float>({ "x", "y" }, x, gsl::span<float const>(y.data(), 4))), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(TestTableBuilderAdopt)
+{
+  using namespace o2::framework;
+  auto x = std::make_shared<std::vector<int>>(std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 });
+  std::weak_ptr<std::vector<int>> owner = x;
+
+  std::shared_ptr<arrow::Table> table;
+  {
+    TableBuilder builder;
+    builder.adoptColumns<int>({ "x" }, x, *x);
+    table = builder.finalize();
+  }
+  x.reset();
+  // the table keeps the adopted memory alive
+  BOOST_CHECK(owner.expired() == false);
+  BOOST_REQUIRE_EQUAL(table->num_rows(), 8);
+  BOOST_REQUIRE_EQUAL(table->column(0)->name(), "x");
+  auto p = std::dynamic_pointer_cast<arrow::NumericArray<arrow::Int32Type>>(table->column(0)->data()->chunk(0));
+  BOOST_CHECK(p->raw_values() == owner.lock()->data());
+  for (size_t i = 0; i < 8; ++i) {
+    BOOST_CHECK_EQUAL(p->Value(i), i);
+  }
+  table.reset();
+  p.reset();
+  BOOST_CHECK(owner.expired());
+}
+
 BOOST_AUTO_TEST_CASE(TestTableBuilderMore)
 {
   using namespace o2::framework;
@@ -218,3 +267,28 @@ BOOST_AUTO_TEST_CASE(TestCombinedDS)
   //BOOST_CHECK_EQUAL(*unionDF.Define("s5", sum, {"right_x", "left_x"}).Sum("s5"), 56);
   //BOOST_CHECK_EQUAL(*blockDF.Define("s5", sum, {"right_x", "left_x"}).Sum("s5"), 168);
 }
+
+BOOST_AUTO_TEST_CASE(TestCombinedDSRanges)
+{
+  using ROOT::RDF::RCombinedDSIndexHelpers;
+  // one range per row of the left table, as for the cross join, plus an
+  // empty one, as for an empty category with the block join
+  std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+  for (ULong64_t i = 0; i < 8; ++i) {
+    ranges.emplace_back(8 * i, 8 * (i + 1));
+  }
+  ranges.emplace_back(64, 64);
+  auto split = RCombinedDSIndexHelpers::splitRanges(ranges, 2);
+  BOOST_REQUIRE_EQUAL(split.size(), 8);
+  for (size_t i = 0; i < split.size(); ++i) {
+    BOOST_CHECK_EQUAL(split[i].first, 8 * i);
+    BOOST_CHECK_EQUAL(split[i].second, 8 * (i + 1));
+  }
+  // one large block gets split for all the slots
+  split = RCombinedDSIndexHelpers::splitRanges({ { 0, 1000 } }, 4);
+  BOOST_REQUIRE_EQUAL(split.size(), 16);
+  BOOST_CHECK_EQUAL(split.back().second, 1000);
+  // fewer entries than ranges
+  BOOST_CHECK_EQUAL(RCombinedDSIndexHelpers::splitRanges({ { 0, 3 } }, 4).size(), 3);
+  BOOST_CHECK(RCombinedDSIndexHelpers::splitRanges({}, 4).empty());
+}
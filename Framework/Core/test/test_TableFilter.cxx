@@ -0,0 +1,129 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework TableFilter
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "Framework/TableBuilder.h"
+#include "Framework/TableFilter.h"
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace o2::framework;
+using namespace o2::analysis;
+
+namespace
+{
+std::shared_ptr<arrow::Table> makeTable(int offset, int rows)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, int>({ "pt", "charge" });
+  for (int i = offset; i < offset + rows; ++i) {
+    rowWriter(0, 0.1f * i, i % 2 ? 1 : -1);
+  }
+  return builder.finalize();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestKernels)
+{
+  std::vector<float> values{ 0.1f, 0.5f, 0.7f, 1.f };
+  std::vector<uint8_t> mask(values.size());
+  filter_kernels::compare(values.data(), values.size(), CompareOp::Greater, 0.5f, mask.data());
+  BOOST_CHECK((mask == std::vector<uint8_t>{ 0, 0, 1, 1 }));
+  filter_kernels::compare(values.data(), values.size(), CompareOp::LessEqual, 0.5f, mask.data());
+  BOOST_CHECK((mask == std::vector<uint8_t>{ 1, 1, 0, 0 }));
+  BOOST_CHECK((filter_kernels::toSelection(mask.data(), mask.size()) == SelectionVector{ 0, 1 }));
+
+  // bits 1 to 4 of 0b00011010
+  uint8_t bitmap = 0x1a;
+  mask.assign(4, 1);
+  filter_kernels::applyValidity(&bitmap, 1, 4, mask.data());
+  BOOST_CHECK((mask == std::vector<uint8_t>{ 1, 0, 1, 1 }));
+
+  mask.assign(4, 0);
+  BOOST_CHECK(filter_kernels::toSelection(mask.data(), mask.size()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestSelect)
+{
+  auto table = makeTable(0, 100);
+  auto selected = (column("pt") > 0.5f && column("charge") == 1).select(*table);
+  SelectionVector expected;
+  for (int i = 0; i < 100; ++i) {
+    if (0.1f * i > 0.5f && i % 2) {
+      expected.push_back(i);
+    }
+  }
+  BOOST_CHECK(selected == expected);
+
+  size_t outside = 0;
+  for (int i = 0; i < 100; ++i) {
+    outside += 0.1f * i < 1.f || 0.1f * i >= 9.f;
+  }
+  BOOST_CHECK_EQUAL((column("pt") < 1.f || column("pt") >= 9.f).select(*table).size(), outside);
+  BOOST_CHECK_EQUAL((!(column("charge") != 1)).select(*table).size(), 50);
+  BOOST_CHECK_EQUAL(Filter{}.select(*table).size(), 100);
+  BOOST_CHECK_EQUAL((Filter{} && column("charge") == -1).select(*table).size(), 50);
+
+  BOOST_CHECK_THROW((column("eta") > 0).select(*table), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(TestChunks)
+{
+  std::shared_ptr<arrow::Table> table;
+  BOOST_REQUIRE(arrow::ConcatenateTables({ makeTable(0, 30), makeTable(30, 70) }, &table).ok());
+  BOOST_CHECK_EQUAL(getRecordBatches(table).size(), 2);
+  BOOST_CHECK_EQUAL(getRecordBatches(table, 10).size(), 10);
+
+  // the rows of the table, not of the chunks
+  auto selected = (column("pt") > 2.95f && column("pt") < 3.25f).select(*table);
+  BOOST_CHECK((selected == SelectionVector{ 30, 31, 32 }));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessInParallel)
+{
+  auto table = makeTable(0, 1000);
+  struct Counts {
+    std::vector<int> bins = std::vector<int>(10, 0);
+    int batches = 0;
+  };
+  auto counts = processInParallel(
+    table, 4,
+    []() { return Counts{}; },
+    [](Counts& counts, arrow::RecordBatch const& batch, SelectionVector const& rows) {
+      auto pt = std::static_pointer_cast<arrow::FloatArray>(batch.column(0));
+      for (auto row : rows) {
+        counts.bins[std::min(9, static_cast<int>(pt->Value(row) / 10.f))]++;
+      }
+      counts.batches++;
+    },
+    [](Counts& counts, Counts& other) {
+      for (size_t i = 0; i < counts.bins.size(); ++i) {
+        counts.bins[i] += other.bins[i];
+      }
+      counts.batches += other.batches;
+    },
+    column("charge") == 1, 64);
+
+  BOOST_CHECK_EQUAL(counts.batches, 16);
+  int total = 0;
+  for (auto bin : counts.bins) {
+    total += bin;
+  }
+  BOOST_CHECK_EQUAL(total, 500);
+  BOOST_CHECK_EQUAL(counts.bins[0], 50);
+}
@@ -0,0 +1,92 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework TimerWheel
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/TimerWheel.h"
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <vector>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestTimerWheelOrder)
+{
+  TimerWheel wheel{ 1000, 5000 };
+  std::vector<size_t> fired;
+  auto record = [&fired](size_t id) { fired.push_back(id); };
+
+  wheel.schedule(0, 30000);
+  wheel.schedule(1, 6500);
+  wheel.schedule(2, 2000); // already due
+  BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+  wheel.advance(5000, record);
+  BOOST_REQUIRE_EQUAL(fired.size(), 1);
+  BOOST_CHECK_EQUAL(fired[0], 2);
+  // 6500 is rounded up to the next tick, 7000
+  wheel.advance(6999, record);
+  BOOST_CHECK_EQUAL(fired.size(), 1);
+  wheel.advance(7000, record);
+  BOOST_REQUIRE_EQUAL(fired.size(), 2);
+  BOOST_CHECK_EQUAL(fired[1], 1);
+  wheel.advance(1000000, record);
+  BOOST_REQUIRE_EQUAL(fired.size(), 3);
+  BOOST_CHECK_EQUAL(fired[2], 0);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestTimerWheelReschedule)
+{
+  // A periodic entry, rescheduled from the callback
+  TimerWheel wheel{ 1, 0 };
+  int fired = 0;
+  wheel.schedule(0, 10);
+  for (uint64_t now = 0; now <= 100; ++now) {
+    wheel.advance(now, [&](size_t id) {
+      ++fired;
+      wheel.schedule(id, now + 10);
+    });
+  }
+  BOOST_CHECK_EQUAL(fired, 10);
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestTimerWheelLevels)
+{
+  // Deadlines on all the levels and beyond the span of the wheel, advanced
+  // by random steps: everything fires exactly once, never early and at most
+  // one tick late.
+  std::mt19937 generator{ 42 };
+  std::uniform_int_distribution<uint64_t> deadlines{ 0, uint64_t(1) << 26 };
+  std::uniform_int_distribution<uint64_t> steps{ 1, 100000 };
+  TimerWheel wheel{ 1, 0 };
+  std::vector<uint64_t> deadline(2000);
+  std::vector<int> fired(deadline.size(), 0);
+  for (size_t i = 0; i < deadline.size(); ++i) {
+    deadline[i] = deadlines(generator);
+    wheel.schedule(i, deadline[i]);
+  }
+  uint64_t now = 0;
+  bool onTime = true;
+  while (wheel.size()) {
+    auto previous = now;
+    now += steps(generator);
+    wheel.advance(now, [&](size_t id) {
+      fired[id]++;
+      onTime &= deadline[id] <= now && (previous == 0 || deadline[id] > previous);
+    });
+  }
+  BOOST_CHECK(onTime);
+  for (auto count : fired) {
+    BOOST_CHECK_EQUAL(count, 1);
+  }
+}
@@ -0,0 +1,96 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework TimesliceCredits
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/TimesliceCredits.h"
+#include "Framework/DeviceSpec.h"
+#include <boost/test/unit_test.hpp>
+#include <limits>
+#include <string>
+#include <unistd.h>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestTimesliceCreditsWindow)
+{
+  auto name = std::string("/dpl-test-credits-") + std::to_string(getpid());
+  auto driver = TimesliceCredits::create(name, 4);
+  BOOST_REQUIRE(driver != nullptr);
+  BOOST_CHECK(TimesliceCredits::create(name, 4) == nullptr);
+  auto source = TimesliceCredits::attach(name);
+  auto consumer = TimesliceCredits::attach(name);
+  BOOST_REQUIRE(source != nullptr);
+  BOOST_REQUIRE(consumer != nullptr);
+  BOOST_CHECK_EQUAL(source->size(), 4);
+
+  // Device 0 is the source, 1 and 2 two time pipelined instances of the same
+  // consumer and 3 another consumer.
+  TimesliceCredits::ConsumerGroups groups{ { 1, 2 }, { 3 } };
+  // Nobody advertised a window yet, the source is free to go
+  BOOST_CHECK_EQUAL(source->credit(groups, 10).free, std::numeric_limits<int64_t>::max());
+
+  consumer->advertise(1, 2);
+  consumer->advertise(2, 2);
+  consumer->advertise(3, 1);
+  BOOST_CHECK_EQUAL(source->credit(groups, 0).free, 1);
+  BOOST_CHECK_EQUAL(source->credit(groups, 0).inFlight, 0);
+  // The second consumer holds the only slot it has
+  BOOST_CHECK_EQUAL(source->credit(groups, 1).free, 0);
+  BOOST_CHECK_EQUAL(source->credit(groups, 1).inFlight, 1);
+  consumer->processed(3);
+  BOOST_CHECK_EQUAL(consumer->getProcessed(3), 1);
+  BOOST_CHECK_EQUAL(source->credit(groups, 1).free, 1);
+
+  // The pipelined instances share the timeslices of the source
+  for (int i = 0; i < 4; ++i) {
+    consumer->processed(3);
+  }
+  BOOST_CHECK_EQUAL(source->credit(groups, 5).free, -1);
+  BOOST_CHECK_EQUAL(source->credit(groups, 5).inFlight, 5);
+  consumer->processed(1);
+  consumer->processed(2);
+  consumer->processed(2);
+  BOOST_CHECK_EQUAL(source->credit(groups, 5).free, 1);
+  BOOST_CHECK_EQUAL(source->credit(groups, 5).inFlight, 2);
+}
+
+BOOST_AUTO_TEST_CASE(TestTimesliceCreditsConsumers)
+{
+  auto device = [](std::string const& name, std::string const& id, std::vector<std::string> inputs, std::vector<std::string> outputs) {
+    DeviceSpec spec;
+    spec.name = name;
+    spec.id = id;
+    for (auto& input : inputs) {
+      spec.inputChannels.push_back(InputChannelSpec{ input, ChannelType::Pull, ChannelMethod::Connect, 0 });
+    }
+    for (auto& output : outputs) {
+      spec.outputChannels.push_back(OutputChannelSpec{ output, ChannelType::Push, ChannelMethod::Bind, 0, 1 });
+    }
+    return spec;
+  };
+  std::vector<DeviceSpec> devices{
+    device("A", "A", {}, { "from_A_to_B_t0", "from_A_to_B_t1", "from_A_to_C" }),
+    device("B", "B_t0", { "from_A_to_B_t0" }, { "from_B_t0_to_C" }),
+    device("B", "B_t1", { "from_A_to_B_t1" }, { "from_B_t1_to_C" }),
+    device("C", "C", { "from_A_to_C", "from_B_t0_to_C", "from_B_t1_to_C" }, {})
+  };
+  auto consumers = TimesliceCredits::computeConsumers(devices);
+  BOOST_REQUIRE_EQUAL(consumers.size(), 4);
+  TimesliceCredits::ConsumerGroups expected{ { 1, 2 }, { 3 } };
+  BOOST_CHECK(consumers[0] == expected);
+  BOOST_CHECK(consumers[1].empty());
+  BOOST_CHECK(consumers[3].empty());
+
+  BOOST_CHECK_EQUAL(TimesliceCredits::encodeConsumers(consumers[0]), "1,2;3");
+  BOOST_CHECK(TimesliceCredits::decodeConsumers("1,2;3") == expected);
+  BOOST_CHECK(TimesliceCredits::decodeConsumers("").empty());
+}
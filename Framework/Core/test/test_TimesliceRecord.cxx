@@ -0,0 +1,125 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework TimesliceRecord
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/TimesliceRecord.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Headers/DataHeader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+using DataHeader = o2::header::DataHeader;
+
+namespace
+{
+struct Stack {
+  DataHeader dh;
+  DataProcessingHeader dph;
+};
+
+Stack makeStack(uint32_t subSpec, size_t payloadSize)
+{
+  Stack stack{ DataHeader{ "CLUSTERS", "TPC", subSpec, payloadSize }, DataProcessingHeader{ subSpec, 1 } };
+  stack.dh.flagsNextHeader = 1;
+  return stack;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestRoundTrip)
+{
+  std::string filename = "test_TimesliceRecord.bin";
+  std::vector<char> payload(1000);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = i % 127;
+  }
+  {
+    TimesliceRecordWriter writer(filename);
+    for (uint32_t timeslice = 0; timeslice < 3; ++timeslice) {
+      writer.beginTimeslice(timeslice);
+      for (uint32_t part = 0; part < timeslice; ++part) {
+        auto stack = makeStack(part, part * 100);
+        writer.addPart(reinterpret_cast<char const*>(&stack), sizeof(stack), payload.data(), part * 100);
+      }
+    }
+    BOOST_CHECK_EQUAL(writer.timeslices(), 3);
+    // parts have to be in a timeslice, which has to be complete
+    BOOST_CHECK_THROW(writer.addPart(payload.data(), 0, payload.data(), 0), std::runtime_error);
+    writer.beginTimeslice(2);
+    BOOST_CHECK_THROW(writer.beginTimeslice(1), std::runtime_error);
+  }
+
+  // the last timeslice misses its parts
+  BOOST_CHECK_THROW(TimesliceRecord::read(filename), std::runtime_error);
+
+  {
+    TimesliceRecordWriter writer(filename);
+    for (uint32_t timeslice = 0; timeslice < 3; ++timeslice) {
+      writer.beginTimeslice(timeslice);
+      for (uint32_t part = 0; part < timeslice; ++part) {
+        auto stack = makeStack(part, part * 100);
+        writer.addPart(reinterpret_cast<char const*>(&stack), sizeof(stack), payload.data(), part * 100);
+      }
+    }
+  }
+  auto timeslices = TimesliceRecord::read(filename);
+  BOOST_REQUIRE_EQUAL(timeslices.size(), 3);
+  for (uint32_t timeslice = 0; timeslice < 3; ++timeslice) {
+    BOOST_REQUIRE_EQUAL(timeslices[timeslice].size(), timeslice);
+    for (uint32_t part = 0; part < timeslice; ++part) {
+      auto const& recorded = timeslices[timeslice][part];
+      BOOST_REQUIRE_EQUAL(recorded.header.size(), sizeof(Stack));
+      auto dh = o2::header::get<DataHeader*>(recorded.header.data());
+      BOOST_REQUIRE(dh != nullptr);
+      BOOST_CHECK_EQUAL(dh->subSpecification, part);
+      BOOST_CHECK(dh->dataOrigin == o2::header::DataOrigin("TPC"));
+      auto dph = o2::header::get<DataProcessingHeader*>(recorded.header.data());
+      BOOST_REQUIRE(dph != nullptr);
+      BOOST_CHECK_EQUAL(dph->startTime, part);
+      BOOST_REQUIRE_EQUAL(recorded.payload.size(), part * 100);
+      BOOST_CHECK(std::equal(recorded.payload.begin(), recorded.payload.end(), payload.begin()));
+    }
+  }
+
+  // only the headers
+  auto headers = TimesliceRecord::read(filename, false);
+  BOOST_REQUIRE_EQUAL(headers.size(), 3);
+  BOOST_CHECK_EQUAL(headers[2][1].header.size(), sizeof(Stack));
+  BOOST_CHECK(headers[2][1].payload.empty());
+
+  // a partially written part is detected
+  std::string truncated = filename + ".truncated";
+  {
+    std::ifstream in(filename, std::ios_base::binary);
+    std::vector<char> content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(truncated, std::ios_base::binary);
+    out.write(content.data(), content.size() - 10);
+  }
+  BOOST_CHECK_THROW(TimesliceRecord::read(truncated), std::runtime_error);
+
+  // not a record
+  BOOST_CHECK_THROW(TimesliceRecord::read(truncated + ".none"), std::runtime_error);
+  {
+    std::ofstream out(truncated, std::ios_base::binary);
+    out << "not a timeslice record";
+  }
+  BOOST_CHECK_THROW(TimesliceRecord::read(truncated), std::runtime_error);
+
+  std::remove(filename.c_str());
+  std::remove(truncated.c_str());
+}
@@ -0,0 +1,101 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework TimesliceTrace
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/TimesliceTrace.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Headers/DataHeader.h"
+#include "Headers/Stack.h"
+
+#include <vector>
+
+using namespace o2::framework;
+using DataHeader = o2::header::DataHeader;
+
+BOOST_AUTO_TEST_CASE(TestBreakdown)
+{
+  TimesliceTracer tracer;
+  TimesliceTraceHeader upstream{ 900, 500 };
+  tracer.relayed(1, nullptr, 1000);
+  tracer.relayed(1, &upstream, 1100);
+  tracer.mark(1, TracePoint::ReadyToProcess, 1150);
+  tracer.mark(1, TracePoint::CallbackStart, 1200);
+  tracer.mark(1, TracePoint::CallbackEnd, 1700);
+
+  auto output = tracer.outputHeader(1, 1800);
+  BOOST_CHECK_EQUAL(output.sendTime, 1800);
+  BOOST_CHECK_EQUAL(output.originTime, 500);
+
+  tracer.mark(1, TracePoint::Send, 1800);
+  BOOST_CHECK_EQUAL(tracer.openTraces(), 1);
+  auto breakdown = TimesliceBreakdown::fromTrace(tracer.finish(1));
+  BOOST_CHECK_EQUAL(tracer.openTraces(), 0);
+  BOOST_CHECK_EQUAL(breakdown.transfer, 200);
+  BOOST_CHECK_EQUAL(breakdown.inputWait, 100);
+  BOOST_CHECK_EQUAL(breakdown.queue, 50);
+  BOOST_CHECK_EQUAL(breakdown.dispatch, 50);
+  BOOST_CHECK_EQUAL(breakdown.compute, 500);
+  BOOST_CHECK_EQUAL(breakdown.send, 100);
+  BOOST_CHECK_EQUAL(breakdown.sinceOrigin, 1300);
+}
+
+BOOST_AUTO_TEST_CASE(TestUntracedUpstream)
+{
+  TimesliceTracer tracer;
+  tracer.relayed(2, nullptr, 1000);
+  // a source of the traced topology is the origin of its outputs
+  BOOST_CHECK_EQUAL(tracer.outputHeader(2, 1500).originTime, 1500);
+  BOOST_CHECK_EQUAL(tracer.outputHeader(3, 1500).originTime, 1500);
+  auto breakdown = TimesliceBreakdown::fromTrace(tracer.finish(2));
+  BOOST_CHECK_EQUAL(breakdown.transfer, -1);
+  BOOST_CHECK_EQUAL(breakdown.sinceOrigin, -1);
+  BOOST_CHECK(tracer.get(2) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestMaxOpenTraces)
+{
+  TimesliceTracer tracer{ 2 };
+  tracer.mark(1, TracePoint::ReadyToProcess, 10);
+  tracer.mark(2, TracePoint::ReadyToProcess, 20);
+  tracer.mark(3, TracePoint::ReadyToProcess, 30);
+  BOOST_CHECK_EQUAL(tracer.openTraces(), 2);
+  BOOST_CHECK(tracer.get(1) == nullptr);
+  BOOST_REQUIRE(tracer.get(3) != nullptr);
+  BOOST_CHECK_EQUAL(tracer.get(3)->at(TracePoint::ReadyToProcess), 30);
+}
+
+BOOST_AUTO_TEST_CASE(TestAppendHeader)
+{
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+  dh.subSpecification = 3;
+  o2::header::Stack stack{ dh, DataProcessingHeader{ 7, 1 } };
+
+  std::vector<char> buffer(stack.size() + sizeof(TimesliceTraceHeader));
+  auto size = TimesliceTracer::appendHeader(reinterpret_cast<char const*>(stack.data()), stack.size(), buffer.data(),
+                                            TimesliceTraceHeader{ 42, 21 });
+  BOOST_CHECK_EQUAL(size, buffer.size());
+
+  auto data = reinterpret_cast<o2::byte const*>(buffer.data());
+  auto traced = o2::header::get<TimesliceTraceHeader*>(data);
+  BOOST_REQUIRE(traced != nullptr);
+  BOOST_CHECK_EQUAL(traced->sendTime, 42);
+  BOOST_CHECK_EQUAL(traced->originTime, 21);
+  BOOST_CHECK(traced->flagsNextHeader == 0);
+  auto dph = o2::header::get<DataProcessingHeader*>(data);
+  BOOST_REQUIRE(dph != nullptr);
+  BOOST_CHECK_EQUAL(dph->startTime, 7);
+  BOOST_CHECK_EQUAL(o2::header::get<DataHeader*>(data)->subSpecification, 3);
+}
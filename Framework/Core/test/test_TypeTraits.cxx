@@ -126,3 +126,12 @@ BOOST_AUTO_TEST_CASE(TestHasRootStreamer)
   BOOST_REQUIRE_EQUAL(has_root_dictionary<decltype(f)>::value, true);
   BOOST_REQUIRE_EQUAL(has_root_dictionary<decltype(g)>::value, false);
 }
+
+BOOST_AUTO_TEST_CASE(TestIsPmrVector)
+{
+  using PmrVector = std::vector<Foo, boost::container::pmr::polymorphic_allocator<Foo>>;
+  BOOST_REQUIRE_EQUAL(is_pmr_vector<PmrVector>::value, true);
+  BOOST_REQUIRE_EQUAL(is_pmr_vector<std::vector<Foo>>::value, false);
+  BOOST_REQUIRE_EQUAL(is_pmr_vector<Foo>::value, false);
+  BOOST_REQUIRE_EQUAL(is_pmr_vector<int>::value, false);
+}
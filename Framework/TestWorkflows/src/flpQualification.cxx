@@ -24,7 +24,7 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
   workflowOptions.push_back(
     ConfigParamSpec{ "3-layer-pipelining", VariantType::Int, 1, { timeHelp } });
 
-  std::string inputHelp("Type of input to be used: readout / stfb");
+  std::string inputHelp("Type of input to be used: readout / superpage / stfb");
   workflowOptions.push_back(
     ConfigParamSpec{ "input-type", VariantType::String, "readout", { inputHelp } });
 }
@@ -82,8 +82,15 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   size_t jobs = config.options().get<int>("2-layer-jobs");
   size_t stages = config.options().get<int>("3-layer-pipelining");
   std::string inputType = config.options().get<std::string>("input-type");
-  if (inputType != "readout" && inputType != "stfb") {
-    throw std::runtime_error("Unknown input type " + inputType + ". Available options are `readout' and `stfb'.");
+  if (inputType != "readout" && inputType != "superpage" && inputType != "stfb") {
+    throw std::runtime_error("Unknown input type " + inputType + ". Available options are `readout', `superpage' and `stfb'.");
+  }
+  InjectorFunction adapter = dplModelAdaptor({ "ITS", "RAWDATA" });
+  if (inputType == "readout") {
+    adapter = readoutAdapter({ "ITS", "RAWDATA" });
+  } else if (inputType == "superpage") {
+    // the superpages are forwarded without copy
+    adapter = readoutSuperpageAdapter({ "ITS", "RAWDATA" });
   }
 
   /// The proxy is the component which is responsible to connect to readout and
@@ -97,7 +104,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
     "readout-proxy",
     Outputs{ { "ITS", "RAWDATA" } },
     "type=pair,method=connect,address=ipc:///tmp/readout-pipe-0,rateLogging=1,transport=shmem",
-    inputType == "readout" ? readoutAdapter({ "ITS", "RAWDATA" }) : dplModelAdaptor({ "ITS", "RAWDATA" }));
+    adapter);
 
   // This is an example of how we can parallelize by subSpec.
   // templatedProcessor will be instanciated N times and the lambda function
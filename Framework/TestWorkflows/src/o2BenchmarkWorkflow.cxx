@@ -0,0 +1,229 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ConfigParamSpec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace o2::framework;
+
+// we need to add workflow options before including Framework/runDataProcessing
+void customize(std::vector<ConfigParamSpec>& workflowOptions)
+{
+  workflowOptions.push_back(
+    ConfigParamSpec{ "payload-size", VariantType::Int, 1024, { "size in bytes of the payload of every message" } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "parts", VariantType::Int, 1, { "number of messages per timeslice, each one is processed by its own lane" } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "stages", VariantType::Int, 1, { "number of processing stages of every lane" } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "pipeline", VariantType::Int, 1, { "number of time pipelined instances of every stage" } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "timeslices", VariantType::Int, 1000, { "number of timeslices to process before quitting" } });
+  workflowOptions.push_back(
+    ConfigParamSpec{ "timeslice-rate", VariantType::Int, 0, { "timeslices per second created by the producer, 0 for as fast as possible" } });
+}
+
+#include "Framework/runDataProcessing.h"
+#include "Framework/ControlService.h"
+#include "Framework/DataProcessorSpec.h"
+#include "Framework/DataRefUtils.h"
+#include "Framework/DataSpecUtils.h"
+#include "FairMQLogger.h"
+#include <Monitoring/Monitoring.h>
+
+using DataHeader = o2::header::DataHeader;
+using Monitoring = o2::monitoring::Monitoring;
+using Metric = o2::monitoring::Metric;
+
+namespace
+{
+/// The creation time of a timeslice is stored in the first bytes of every
+/// payload, so that the latency can be measured across all the stages.
+/// The steady clock is the same for all the processes of the host.
+uint64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+o2::header::DataDescription stageDescription(size_t stage)
+{
+  o2::header::DataDescription description;
+  description.runtimeInit(("STAGE" + std::to_string(stage)).c_str());
+  return description;
+}
+
+DataProcessorSpec defineProducer(size_t parts, size_t payloadSize, size_t timeslices, size_t rate)
+{
+  Outputs outputs;
+  for (size_t pi = 0; pi < parts; ++pi) {
+    outputs.emplace_back(OutputSpec{ "BMK", stageDescription(0), pi });
+  }
+  return DataProcessorSpec{
+    "benchmark-producer",
+    Inputs{},
+    outputs,
+    AlgorithmSpec{ [parts, payloadSize, timeslices, rate](InitContext&) {
+      auto produced = std::make_shared<size_t>(0);
+      auto start = std::make_shared<std::chrono::steady_clock::time_point>();
+      return [parts, payloadSize, timeslices, rate, produced, start](ProcessingContext& ctx) {
+        if (*produced >= timeslices) {
+          // wait for the sink to quit
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+          return;
+        }
+        if (*produced == 0) {
+          *start = std::chrono::steady_clock::now();
+        } else if (rate > 0) {
+          std::this_thread::sleep_until(*start + std::chrono::microseconds(*produced * 1000000 / rate));
+        }
+        auto creation = now();
+        for (size_t pi = 0; pi < parts; ++pi) {
+          auto& chunk = ctx.outputs().newChunk(Output{ "BMK", stageDescription(0), pi }, payloadSize);
+          std::memcpy(chunk.data(), &creation, sizeof(creation));
+        }
+        ++*produced;
+      };
+    } }
+  };
+}
+
+/// A stage of a lane, copies its input to its output
+DataProcessorSpec defineStage(size_t stage, size_t pipeline)
+{
+  return timePipeline(
+    DataProcessorSpec{
+      "benchmark-stage" + std::to_string(stage),
+      Inputs{ InputSpec{ "in", "BMK", stageDescription(stage - 1), 0 } },
+      Outputs{ OutputSpec{ "BMK", stageDescription(stage), 0 } },
+      AlgorithmSpec{ [stage](ProcessingContext& ctx) {
+        auto ref = ctx.inputs().get("in");
+        auto header = DataRefUtils::getHeader<DataHeader*>(ref);
+        auto& chunk = ctx.outputs().newChunk(Output{ "BMK", stageDescription(stage), header->subSpecification }, header->payloadSize);
+        std::memcpy(chunk.data(), ref.payload, header->payloadSize);
+      } } },
+    pipeline);
+}
+
+/// Statistics of the timeslices received by the sink
+struct SinkStats {
+  size_t timeslices = 0;
+  size_t messages = 0;
+  size_t bytes = 0;
+  uint64_t first = 0;
+  uint64_t last = 0;
+  std::vector<uint64_t> latencies;
+};
+
+uint64_t percentile(std::vector<uint64_t> const& sorted, double fraction)
+{
+  return sorted[std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()))];
+}
+
+/// The fan-in of all the lanes, reports the statistics once all the
+/// timeslices have been received
+DataProcessorSpec defineSink(size_t parts, size_t stages, size_t timeslices)
+{
+  return DataProcessorSpec{
+    "benchmark-sink",
+    mergeInputs(InputSpec{ "in", "BMK", stageDescription(stages), 0 },
+                parts,
+                [](InputSpec& input, size_t index) {
+                  DataSpecUtils::updateMatchingSubspec(input, index);
+                }),
+    Outputs{},
+    AlgorithmSpec{ [timeslices](InitContext&) {
+      auto stats = std::make_shared<SinkStats>();
+      stats->latencies.reserve(timeslices);
+      return [timeslices, stats](ProcessingContext& ctx) {
+        auto arrival = now();
+        // the latency of a timeslice is the time from its creation by the
+        // producer until all of its messages have arrived
+        uint64_t creation = arrival;
+        for (auto const& ref : ctx.inputs()) {
+          auto header = DataRefUtils::getHeader<DataHeader*>(ref);
+          uint64_t partCreation = 0;
+          std::memcpy(&partCreation, ref.payload, sizeof(partCreation));
+          creation = std::min(creation, partCreation);
+          stats->bytes += header->payloadSize;
+          ++stats->messages;
+        }
+        if (stats->timeslices == 0) {
+          stats->first = arrival;
+        }
+        stats->last = arrival;
+        stats->latencies.push_back(arrival - creation);
+        if (++stats->timeslices < timeslices) {
+          return;
+        }
+
+        std::sort(stats->latencies.begin(), stats->latencies.end());
+        double elapsed = (stats->last - stats->first) * 1e-9;
+        // the first timeslice starts the clock
+        double rate = elapsed > 0 ? (stats->timeslices - 1) / elapsed : 0.;
+        double messageRate = rate * stats->messages / stats->timeslices;
+        double throughput = rate * stats->bytes / stats->timeslices * 1e-9;
+        double p50 = percentile(stats->latencies, 0.5) * 1e-3;
+        double p99 = percentile(stats->latencies, 0.99) * 1e-3;
+        LOG(INFO) << "Benchmark: " << stats->timeslices << " timeslices, " << stats->messages << " messages, "
+                  << stats->bytes << " bytes in " << elapsed << " s";
+        LOG(INFO) << "Benchmark: " << rate << " timeslices/s, " << messageRate << " messages/s, "
+                  << throughput << " GB/s";
+        LOG(INFO) << "Benchmark: latency p50 " << p50 << " us, p99 " << p99 << " us";
+
+        auto& monitoring = ctx.services().get<Monitoring>();
+        monitoring.send(Metric{ messageRate, "benchmark_messages_per_s" });
+        monitoring.send(Metric{ throughput, "benchmark_gb_per_s" });
+        monitoring.send(Metric{ p50, "benchmark_latency_p50_us" });
+        monitoring.send(Metric{ p99, "benchmark_latency_p99_us" });
+        ctx.services().get<ControlService>().readyToQuit(true);
+      };
+    } }
+  };
+}
+} // namespace
+
+// A configurable topology to measure the throughput and the latency of the
+// framework: a producer fans out the messages of every timeslice to one
+// lane per message, every lane is a pipeline of stages copying the message,
+// the sink fans the lanes in and reports the statistics.
+//
+//   producer -> stage1/0 -> ... -> stageN/0 -> sink
+//            -> stage1/1 -> ... -> stageN/1 ->
+//            ...
+//
+// The transport is selected with the --transport option forwarded to the
+// devices, e.g. --transport shmem.
+WorkflowSpec defineDataProcessing(ConfigContext const& config)
+{
+  size_t payloadSize = std::max(config.options().get<int>("payload-size"), (int)sizeof(uint64_t));
+  size_t parts = std::max(config.options().get<int>("parts"), 1);
+  size_t stages = std::max(config.options().get<int>("stages"), 0);
+  size_t pipeline = std::max(config.options().get<int>("pipeline"), 1);
+  size_t timeslices = std::max(config.options().get<int>("timeslices"), 1);
+  size_t rate = std::max(config.options().get<int>("timeslice-rate"), 0);
+
+  WorkflowSpec workflow{ defineProducer(parts, payloadSize, timeslices, rate) };
+  for (size_t stage = 1; stage <= stages; ++stage) {
+    auto lanes = parallel(defineStage(stage, pipeline), parts, [](DataProcessorSpec& spec, size_t index) {
+      DataSpecUtils::updateMatchingSubspec(spec.inputs[0], index);
+      spec.outputs[0].subSpec = index;
+    });
+    workflow.insert(workflow.end(), lanes.begin(), lanes.end());
+  }
+  workflow.push_back(defineSink(parts, stages, timeslices));
+  return workflow;
+}
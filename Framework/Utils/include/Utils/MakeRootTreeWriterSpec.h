@@ -20,6 +20,8 @@
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/CallbackService.h"
 #include "Framework/ControlService.h"
+#include <Monitoring/Monitoring.h>
+#include <TROOT.h>
 #include <algorithm>
 #include <vector>
 #include <string>
@@ -55,6 +57,13 @@ namespace framework
 ///   --treename
 ///   --nevents
 ///   --terminate
+///   --async-queue-depth
+///   --compression-threads
+///
+/// With a non-zero async queue depth, the branches are filled on a writer thread, see
+/// RootTreeWriter::setAsync, and the depth of the queue is reported as metric
+/// 'tree_writer_queue_depth'. The compression threads enable the ROOT implicit
+/// multithreading, the baskets of the branches are then compressed in parallel.
 ///
 /// In addition to that, a custom option can be added for every branch to configure the
 /// branch name, see below.
@@ -289,6 +298,16 @@ class MakeRootTreeWriterSpec
         auto branchName = ic.options().get<std::string>(branchNameOptions[branchIndex].first.c_str());
         processAttributes->writer->setBranchName(branchIndex, branchName.c_str());
       }
+      auto queueDepth = ic.options().get<int>("async-queue-depth");
+      if (queueDepth > 0) {
+        processAttributes->writer->setAsync(queueDepth);
+      }
+#ifdef R__USE_IMT
+      auto compressionThreads = ic.options().get<int>("compression-threads");
+      if (compressionThreads > 0) {
+        ROOT::EnableImplicitMT(compressionThreads);
+      }
+#endif
       processAttributes->writer->init(filename.c_str(), treename.c_str());
 
       // the callback to be set as hook at stop of processing for the framework
@@ -350,6 +369,7 @@ class MakeRootTreeWriterSpec
         if (checkProcessing(pc.inputs())) {
           (*writer)(pc.inputs());
           counter = counter + 1;
+          pc.services().get<o2::monitoring::Monitoring>().send(o2::monitoring::Metric{ static_cast<int>(writer->getQueueDepth()), "tree_writer_queue_depth" });
         }
 
         if ((nEvents >= 0 && counter == nEvents) || checkReady(pc.inputs())) {
@@ -367,6 +387,8 @@ class MakeRootTreeWriterSpec
       { "treename", VariantType::String, mDefaultTreeName.c_str(), { "Name of tree" } },
       { "nevents", VariantType::Int, mDefaultNofEvents, { "Number of events to execute" } },
       { "terminate", VariantType::String, mDefaultTerminationPolicy.c_str(), { "Terminate the 'process' or 'workflow'" } },
+      { "async-queue-depth", VariantType::Int, 0, { "Fill the tree on a writer thread with up to this number of queued input sets, 0 to fill synchronously" } },
+      { "compression-threads", VariantType::Int, 0, { "Number of threads compressing the baskets, 0 to compress on the filling thread" } },
     };
     for (size_t branchIndex = 0; branchIndex < mBranchNameOptions.size(); branchIndex++) {
       // adding option definitions for those ones defined in the branch definition
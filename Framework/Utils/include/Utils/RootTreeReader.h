@@ -21,6 +21,11 @@
 #include <TTree.h>
 #include <TBranch.h>
 #include <TClass.h>
+#include <TROOT.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 #include <stdexcept> // std::runtime_error
@@ -81,6 +86,17 @@ struct DefaultKey {
 ///     (++reader)(pc);
 ///   };
 ///
+/// The reader can be configured by additional constructor arguments among the
+/// file names:
+///   - `CacheSize{bytes}` enables the TTreeCache of the chain for the branches
+///     to be published, such that the baskets of many entries are fetched in
+///     one read. The branches are known up-front, so the learning phase of the
+///     cache is stopped right away.
+///   - `ReadAhead{entries}` reads and decompresses up to this number of entries
+///     on a background thread, while the current entry is being published. All
+///     accesses to the chain then happen on the background thread, files must
+///     not be added after construction.
+///
 /// The reader supports the binary format of the RootTreeWriter as counterpart.
 /// Binary data is stored as vector of char alongside with a branch storing the
 /// size, as both indicator and consistency check.
@@ -104,6 +120,15 @@ class GenericRootTreeReader
     Single,
     Loop,
   };
+  /// size of the TTreeCache in bytes, 0 disables the cache
+  struct CacheSize {
+    long long bytes = 0;
+  };
+  /// number of entries read ahead on a background thread, 0 reads the entries
+  /// on the calling thread when they are published
+  struct ReadAhead {
+    size_t entries = 0;
+  };
   // the key must not be of type const char* to make sure that the variable argument
   // list of the constructor can be parsed
   static_assert(std::is_same<KeyType, const char*>::value == false, "the key type must not be const char*");
@@ -122,6 +147,26 @@ class GenericRootTreeReader
   {
     mInput.SetCacheSize(0);
     parseConstructorArgs(std::forward<Args>(args)...);
+    setupCache();
+    if (mReadAheadEntries > 0) {
+      startReadAhead();
+    }
+  }
+
+  ~GenericRootTreeReader()
+  {
+    if (mReadAhead) {
+      {
+        std::lock_guard<std::mutex> lock(mReadAhead->mutex);
+        mReadAhead->stop = true;
+      }
+      mReadAhead->cond.notify_all();
+      mReadAhead->thread.join();
+      for (auto& entry : mReadAhead->queue) {
+        release(entry);
+      }
+      release(mReadAhead->current);
+    }
   }
 
   /// add a file as source for the tree
@@ -196,33 +241,18 @@ class GenericRootTreeReader
       return false;
     }
 
-    for (auto& spec : mBranchSpecs) {
-      char* data = nullptr;
-      spec.second->branch->SetAddress(&data);
-      spec.second->branch->GetEntry(mReadEntry);
-      if (spec.second->sizebranch == nullptr) {
-        snapshot(spec.first, std::move(ROOTSerializedByClass(*data, spec.second->classinfo)));
-      } else {
-        size_t datasize = 0;
-        spec.second->sizebranch->SetAddress(&datasize);
-        spec.second->sizebranch->GetEntry(mReadEntry);
-        auto* buffer = reinterpret_cast<BinaryDataStoreType*>(data);
-        if (buffer->size() == datasize) {
-          LOG(INFO) << "branch " << spec.second->name << ": publishing binary chunk of " << datasize << " bytes(s)";
-          snapshot(spec.first, std::move(*buffer));
-        } else {
-          LOG(ERROR) << "branch " << spec.second->name << ": inconsitent size of binary chunk "
-                     << buffer->size() << " vs " << datasize;
-          BinaryDataStoreType empty;
-          snapshot(spec.first, empty);
-        }
-      }
-      auto* delfunc = spec.second->classinfo->GetDelete();
-      if (delfunc) {
-        (*delfunc)(data);
+    if (mReadAhead) {
+      auto const* entry = fetch(mNofPublished);
+      if (entry == nullptr) {
+        return false;
       }
-      spec.second->branch->DropBaskets("all");
+      publish(snapshot, *entry);
+      return true;
     }
+    EntryData entry;
+    readEntry(mReadEntry, entry);
+    publish(snapshot, entry);
+    release(entry);
     return true;
   }
 
@@ -240,6 +270,176 @@ class GenericRootTreeReader
     TClass* classinfo = nullptr;
   };
 
+  /// the objects read from the branches for one entry, in the order of the
+  /// branch specs
+  struct BranchData {
+    char* object = nullptr;
+    size_t size = 0;
+  };
+  struct EntryData {
+    /// the publishing count this entry has been read for
+    int sequence = -1;
+    std::vector<BranchData> branches;
+  };
+
+  /// the entries read ahead by the background thread
+  struct ReadAheadQueue {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<EntryData> queue;
+    /// the entry taken last from the queue, kept until the next one is taken
+    EntryData current;
+    bool stop = false;
+    bool done = false;
+    std::thread thread;
+  };
+
+  /// restrict the TTreeCache to the branches to be published
+  void setupCache()
+  {
+    if (mCacheSize <= 0 || mBranchSpecs.empty()) {
+      return;
+    }
+    mInput.SetCacheSize(mCacheSize);
+    for (auto& spec : mBranchSpecs) {
+      mInput.AddBranchToCache(spec.second->name.c_str(), true);
+      if (spec.second->sizebranch) {
+        mInput.AddBranchToCache((spec.second->name + "Size").c_str(), true);
+      }
+    }
+    mInput.StopCacheLearningPhase();
+  }
+
+  /// read the objects of all branches for @a entry
+  void readEntry(int entry, EntryData& data) const
+  {
+    data.branches.resize(mBranchSpecs.size());
+    for (size_t i = 0; i < mBranchSpecs.size(); ++i) {
+      auto& spec = mBranchSpecs[i].second;
+      auto& branchData = data.branches[i];
+      branchData.object = nullptr;
+      spec->branch->SetAddress(&branchData.object);
+      spec->branch->GetEntry(entry);
+      if (spec->sizebranch) {
+        spec->sizebranch->SetAddress(&branchData.size);
+        spec->sizebranch->GetEntry(entry);
+      }
+      spec->branch->DropBaskets("all");
+    }
+  }
+
+  template <typename F>
+  void publish(F& snapshot, EntryData const& data) const
+  {
+    for (size_t i = 0; i < mBranchSpecs.size(); ++i) {
+      auto& key = mBranchSpecs[i].first;
+      auto& spec = mBranchSpecs[i].second;
+      auto* object = data.branches[i].object;
+      if (spec->sizebranch == nullptr) {
+        snapshot(key, std::move(ROOTSerializedByClass(*object, spec->classinfo)));
+      } else {
+        auto datasize = data.branches[i].size;
+        auto* buffer = reinterpret_cast<BinaryDataStoreType*>(object);
+        if (buffer->size() == datasize) {
+          LOG(INFO) << "branch " << spec->name << ": publishing binary chunk of " << datasize << " bytes(s)";
+          snapshot(key, *buffer);
+        } else {
+          LOG(ERROR) << "branch " << spec->name << ": inconsitent size of binary chunk "
+                     << buffer->size() << " vs " << datasize;
+          BinaryDataStoreType empty;
+          snapshot(key, empty);
+        }
+      }
+    }
+  }
+
+  /// delete the objects read for an entry
+  void release(EntryData& data) const
+  {
+    for (size_t i = 0; i < data.branches.size(); ++i) {
+      auto* delfunc = mBranchSpecs[i].second->classinfo->GetDelete();
+      if (delfunc && data.branches[i].object) {
+        (*delfunc)(data.branches[i].object);
+      }
+    }
+    data.branches.clear();
+    data.sequence = -1;
+  }
+
+  void startReadAhead()
+  {
+    // the objects are streamed on the background thread while the published
+    // ones are serialized on the processing thread
+    ROOT::EnableThreadSafety();
+    mReadAhead = std::make_unique<ReadAheadQueue>();
+    mReadAhead->thread = std::thread([this]() { readAhead(); });
+  }
+
+  /// body of the background thread, reads the entries in the order next()
+  /// walks through them
+  void readAhead()
+  {
+    auto& state = *mReadAhead;
+    int entry = -1;
+    for (int sequence = 0;; ++sequence) {
+      if ((entry + 1) >= mNEntries) {
+        if (mPublishingMode == PublishingMode::Single || mNEntries == 0) {
+          break;
+        }
+        entry = -1;
+      }
+      if (mMaxEntries > 0 && sequence >= mMaxEntries) {
+        break;
+      }
+      ++entry;
+      {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.cond.wait(lock, [&state, this]() { return state.stop || state.queue.size() < mReadAheadEntries; });
+        if (state.stop) {
+          break;
+        }
+      }
+      EntryData data;
+      data.sequence = sequence;
+      readEntry(entry, data);
+      {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.queue.emplace_back(std::move(data));
+      }
+      state.cond.notify_all();
+    }
+    {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      state.done = true;
+    }
+    state.cond.notify_all();
+  }
+
+  /// wait for the entry read ahead for publishing count @a sequence, the
+  /// entries which have been skipped are dropped
+  /// @return nullptr if there is no such entry
+  EntryData const* fetch(int sequence) const
+  {
+    auto& state = *mReadAhead;
+    if (state.current.sequence == sequence) {
+      return &state.current;
+    }
+    std::unique_lock<std::mutex> lock(state.mutex);
+    while (true) {
+      state.cond.wait(lock, [&state]() { return state.done || state.queue.empty() == false; });
+      if (state.queue.empty() || state.queue.front().sequence > sequence) {
+        return nullptr;
+      }
+      release(state.current);
+      state.current = std::move(state.queue.front());
+      state.queue.pop_front();
+      state.cond.notify_all();
+      if (state.current.sequence == sequence) {
+        return &state.current;
+      }
+    }
+  }
+
   /// add a new branch definition
   /// we allow for multiple branch definition for the same key
   void addBranchSpec(KeyType key, const char* branchName)
@@ -300,10 +500,31 @@ class GenericRootTreeReader
     parseConstructorArgs(std::forward<Args>(args)...);
   }
 
+  /// helper function to recursively parse constructor arguments
+  /// handles the cache size argument, stops when the first key
+  /// is found
+  template <typename T, typename... Args>
+  typename std::enable_if_t<std::is_same<T, CacheSize>::value == true> parseConstructorArgs(T cacheSize, Args&&... args)
+  {
+    mCacheSize = cacheSize.bytes;
+    parseConstructorArgs(std::forward<Args>(args)...);
+  }
+
+  /// helper function to recursively parse constructor arguments
+  /// handles the read-ahead argument, stops when the first key
+  /// is found
+  template <typename T, typename... Args>
+  typename std::enable_if_t<std::is_same<T, ReadAhead>::value == true> parseConstructorArgs(T readAhead, Args&&... args)
+  {
+    mReadAheadEntries = readAhead.entries;
+    parseConstructorArgs(std::forward<Args>(args)...);
+  }
+
   /// helper function to recursively parse constructor arguments
   /// parse the branch definitions with key and branch name.
   template <typename T, typename... Args>
-  typename std::enable_if_t<std::is_same<T, int>::value == false && std::is_same<T, PublishingMode>::value == false>
+  typename std::enable_if_t<std::is_same<T, int>::value == false && std::is_same<T, PublishingMode>::value == false &&
+                            std::is_same<T, CacheSize>::value == false && std::is_same<T, ReadAhead>::value == false>
   parseConstructorArgs(T key, const char* name, Args&&... args)
   {
     if (name != nullptr && *name != 0) {
@@ -330,6 +551,12 @@ class GenericRootTreeReader
   int mMaxEntries = -1;
   /// publishing mode
   PublishingMode mPublishingMode = PublishingMode::Single;
+  /// size of the TTreeCache in bytes
+  long long mCacheSize = 0;
+  /// number of entries to read ahead
+  size_t mReadAheadEntries = 0;
+  /// the background reading, if enabled
+  std::unique_ptr<ReadAheadQueue> mReadAhead;
 };
 
 using RootTreeReader = GenericRootTreeReader<rtr::DefaultKey>;
@@ -21,6 +21,12 @@
 #include <TTree.h>
 #include <TBranch.h>
 #include <TClass.h>
+#include <TROOT.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <functional>
 #include <string>
@@ -70,6 +76,10 @@ namespace framework
 /// as a std::vector<char>, this ensures separation on event basis as well as having binary
 /// data in parallel to ROOT objects in the same file, e.g. a binary data format from the
 /// reconstruction in parallel to MC labels.
+///
+/// In asynchronous mode, see setAsync, the inputs are extracted on the calling thread
+/// and handed over to a writer thread, which fills the branches. Filling, compression
+/// and writing thus do not block the caller until the hand-over queue is full.
 class RootTreeWriter
 {
  public:
@@ -141,6 +151,11 @@ class RootTreeWriter
     }
   }
 
+  ~RootTreeWriter()
+  {
+    stopWriterThread();
+  }
+
   /// init the output file and tree
   /// After setting up the tree, the branches will be created according to the
   /// branch definition provided to the constructor.
@@ -149,6 +164,34 @@ class RootTreeWriter
     mFile = std::make_unique<TFile>(filename, "RECREATE");
     mTree = std::make_unique<TTree>(treename, treename);
     mTreeStructure->setup(mBranchSpecs, mTree.get());
+    if (mAsync) {
+      mAsync->thread = std::thread([this]() { runWriterThread(); });
+    }
+  }
+
+  /// fill the tree on a writer thread, must be called before init
+  /// @param maxQueueDepth  number of processed input sets waiting to be filled, the
+  ///                       caller blocks when the queue is full
+  void setAsync(size_t maxQueueDepth)
+  {
+    if (mTree) {
+      throw std::runtime_error("asynchronous mode must be set before the writer is initialized");
+    }
+    // the objects are deserialized on the calling thread while the writer thread streams
+    ROOT::EnableThreadSafety();
+    mAsync = std::make_unique<AsyncState>();
+    mAsync->maxDepth = std::max(maxQueueDepth, (size_t)1);
+  }
+
+  /// @return the number of input sets waiting to be filled by the writer thread,
+  /// always 0 in synchronous mode
+  size_t getQueueDepth() const
+  {
+    if (!mAsync) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(mAsync->mutex);
+    return mAsync->queue.size();
   }
 
   /// set the branch name for a branch definition from the constructor argument list
@@ -181,7 +224,21 @@ class RootTreeWriter
       throw std::runtime_error("Writer is invalid state, probably closed previously");
     }
     // execute tree structure handlers and fill the individual branches
-    mTreeStructure->exec(std::forward<ContextType>(context), mBranchSpecs);
+    FillQueue fills;
+    mTreeStructure->exec(std::forward<ContextType>(context), mBranchSpecs, fills, mAsync != nullptr);
+    if (!mAsync) {
+      for (auto& fill : fills) {
+        fill();
+      }
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mAsync->mutex);
+    mAsync->cond.wait(lock, [this]() { return mAsync->error || mAsync->queue.size() < mAsync->maxDepth; });
+    if (mAsync->error) {
+      std::rethrow_exception(mAsync->error);
+    }
+    mAsync->queue.emplace_back(std::move(fills));
+    mAsync->cond.notify_all();
     // Note: number of entries will be set when closing the writer
   }
 
@@ -193,6 +250,8 @@ class RootTreeWriter
     if (!mFile) {
       return;
     }
+    // all queued input sets are filled before the tree is written
+    stopWriterThread();
     // set the number of elements according to branch content and write tree
     mTree->SetEntries();
     mTree->Write();
@@ -225,6 +284,65 @@ class RootTreeWriter
   };
 
   using InputContext = InputRecord;
+  /// the branch fills for one processed input set, extracted inputs are owned by the closures
+  using FillQueue = std::vector<std::function<void()>>;
+
+  /// state shared with the writer thread in asynchronous mode
+  struct AsyncState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<FillQueue> queue;
+    size_t maxDepth = 1;
+    bool stop = false;
+    std::exception_ptr error;
+    std::thread thread;
+  };
+
+  void runWriterThread()
+  {
+    auto& state = *mAsync;
+    std::unique_lock<std::mutex> lock(state.mutex);
+    while (true) {
+      state.cond.wait(lock, [&state]() { return state.stop || state.queue.empty() == false; });
+      if (state.queue.empty()) {
+        // stopped and drained
+        return;
+      }
+      // the entry is kept in the queue while filling, so that it is accounted in the depth
+      lock.unlock();
+      try {
+        for (auto& fill : state.queue.front()) {
+          fill();
+        }
+      } catch (...) {
+        lock.lock();
+        state.error = std::current_exception();
+        state.queue.clear();
+        state.cond.notify_all();
+        return;
+      }
+      lock.lock();
+      state.queue.pop_front();
+      state.cond.notify_all();
+    }
+  }
+
+  /// let the writer thread fill the remaining input sets and wait for it
+  void stopWriterThread()
+  {
+    if (!mAsync || !mAsync->thread.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mAsync->mutex);
+      mAsync->stop = true;
+    }
+    mAsync->cond.notify_all();
+    mAsync->thread.join();
+    if (mAsync->error) {
+      LOG(ERROR) << "writer thread stopped on error, the written tree is incomplete";
+    }
+  }
 
   /// polymorphic interface for the mixin stack of branch type descriptions
   /// it implements the entry point for processing through exec method
@@ -241,8 +359,9 @@ class RootTreeWriter
     /// exec the branch structure
     /// enters at the outermost element and recurses to the base elements
     /// Read the configured inputs from the input context, select the output branch
-    /// and write the object
-    virtual void exec(InputContext&, std::vector<BranchSpec>&) {}
+    /// and add the filling of the object to the fill queue. With @a detach the
+    /// extracted objects are independent of the input context.
+    virtual void exec(InputContext&, std::vector<BranchSpec>&, FillQueue&, bool) {}
     /// get the size of the branch structure, i.e. the number of registered branch
     /// definitions
     virtual size_t size() const { return STAGE; }
@@ -250,9 +369,22 @@ class RootTreeWriter
     // a dummy method called in the recursive processing
     void setupInstance(std::vector<BranchSpec>&, TTree*) {}
     // a dummy method called in the recursive processing
-    void process(InputContext&, std::vector<BranchSpec>&) {}
+    void process(InputContext&, std::vector<BranchSpec>&, FillQueue&, bool) {}
   };
 
+  /// ownership of the objects extracted from the InputRecord, the objects without
+  /// custom deleter are always deserialized copies
+  template <typename T>
+  static bool isOwning(std::unique_ptr<T> const&)
+  {
+    return true;
+  }
+  template <typename T, typename D>
+  static bool isOwning(std::unique_ptr<T, D> const& ptr)
+  {
+    return ptr.get_deleter().isOwning();
+  }
+
   template <typename T = char>
   using BinaryBranchStoreType = std::tuple<std::vector<T>, TBranch*, size_t>;
 
@@ -280,9 +412,9 @@ class RootTreeWriter
 
     // this is the polymorphic entry point for processing of branch specs
     // recursive processing starting from the highest instance
-    void exec(InputContext& context, std::vector<BranchSpec>& specs) override
+    void exec(InputContext& context, std::vector<BranchSpec>& specs, FillQueue& fills, bool detach) override
     {
-      process(context, specs);
+      process(context, specs, fills, detach);
     }
     size_t size() const override { return STAGE; }
 
@@ -340,11 +472,13 @@ class RootTreeWriter
     // specialization for trivial structs or serialized objects without a TClass interface
     // the extracted object is copied to store variable
     template <typename T, typename std::enable_if_t<std::is_same<T, value_type>::value, int> = 0>
-    void fillData(InputContext& context, const char* key, TBranch* branch, size_t branchIdx)
+    std::function<void()> fillData(InputContext& context, const char* key, TBranch* branch, size_t branchIdx, bool)
     {
       auto data = context.get<typename std::add_pointer<value_type>::type>(key);
-      mStore[branchIdx] = *data;
-      branch->Fill();
+      return [this, branch, branchIdx, value = *data]() {
+        mStore[branchIdx] = value;
+        branch->Fill();
+      };
     }
 
     // specialization for objects with ROOT dictionary
@@ -352,34 +486,50 @@ class RootTreeWriter
     // in order to directly use the pointer to extracted object
     // store is a pointer to object
     template <typename T, typename std::enable_if_t<std::is_same<T, value_type*>::value, int> = 0>
-    void fillData(InputContext& context, const char* key, TBranch* branch, size_t branchIdx)
+    std::function<void()> fillData(InputContext& context, const char* key, TBranch* branch, size_t branchIdx, bool detach)
     {
       auto data = context.get<typename std::add_pointer<value_type>::type>(key);
-      // this is ugly but necessary because of the TTree API does not allow a const
-      // object as input. Have to rely on that ROOT treats the object as const
-      mStore[branchIdx] = const_cast<value_type*>(data.get());
-      branch->Fill();
+      std::shared_ptr<value_type const> object;
+      if (detach && isOwning(data) == false) {
+        // the object points into the input message, which is only valid for the
+        // current processing call
+        if constexpr (std::is_copy_constructible<value_type>::value) {
+          object = std::make_shared<value_type const>(*data);
+        } else {
+          throw std::runtime_error(std::string("asynchronous writing requires copy constructible type ") + typeid(value_type).name());
+        }
+      } else {
+        object = std::move(data);
+      }
+      return [this, branch, branchIdx, object]() {
+        // this is ugly but necessary because of the TTree API does not allow a const
+        // object as input. Have to rely on that ROOT treats the object as const
+        mStore[branchIdx] = const_cast<value_type*>(object.get());
+        branch->Fill();
+      };
     }
 
     // specialization for binary buffers using const char*
     // this writes both the data branch and a size branch
     template <typename T, typename std::enable_if_t<std::is_same<T, BinaryBranchStoreType<char>>::value, int> = 0>
-    void fillData(InputContext& context, const char* key, TBranch* branch, size_t branchIdx)
+    std::function<void()> fillData(InputContext& context, const char* key, TBranch* branch, size_t branchIdx, bool)
     {
       auto data = context.get<gsl::span<char>>(key);
-      std::get<2>(mStore.at(branchIdx)) = data.size();
-      std::get<1>(mStore.at(branchIdx))->Fill();
-      std::get<0>(mStore.at(branchIdx)).resize(data.size());
-      memcpy(std::get<0>(mStore.at(branchIdx)).data(), data.data(), data.size());
-      branch->Fill();
+      std::vector<char> buffer(data.begin(), data.end());
+      return [this, branch, branchIdx, buffer = std::move(buffer)]() mutable {
+        std::get<2>(mStore.at(branchIdx)) = buffer.size();
+        std::get<1>(mStore.at(branchIdx))->Fill();
+        std::get<0>(mStore.at(branchIdx)).swap(buffer);
+        branch->Fill();
+      };
     }
 
     // process previous stage and this stage
-    void process(InputContext& context, std::vector<BranchSpec>& specs)
+    void process(InputContext& context, std::vector<BranchSpec>& specs, FillQueue& fills, bool detach)
     {
       // recursing through the tree structure by simply using method of the previous type,
       // i.e. the base class method.
-      PrevT::process(context, specs);
+      PrevT::process(context, specs, fills, detach);
       constexpr size_t SpecIndex = STAGE - 1;
       BranchSpec const& spec = specs[SpecIndex];
       // loop over all defined inputs
@@ -393,7 +543,7 @@ class RootTreeWriter
             continue;
           }
         }
-        fillData<store_type>(context, key.c_str(), spec.branches.at(branchIdx), branchIdx);
+        fills.emplace_back(fillData<store_type>(context, key.c_str(), spec.branches.at(branchIdx), branchIdx, detach));
       }
     }
 
@@ -453,6 +603,8 @@ class RootTreeWriter
   std::unique_ptr<TreeStructureInterface> mTreeStructure;
   /// indicate that the writer has been closed
   bool mIsClosed = false;
+  /// the writer thread state, only in asynchronous mode
+  std::unique_ptr<AsyncState> mAsync;
 };
 
 } // namespace framework
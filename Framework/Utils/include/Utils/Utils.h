@@ -17,6 +17,7 @@
 #define UTILS_H
 
 #include "Framework/DataProcessorSpec.h"
+#include <cstdint>
 #include <functional>
 
 namespace o2f = o2::framework;
@@ -52,6 +53,18 @@ o2f::DataProcessorSpec defineRouter(std::string devName, o2f::Inputs usrInput, o
 // Gatherer implementation
 o2f::DataProcessorSpec defineGatherer(std::string devName, o2f::Inputs usrInputs, o2f::OutputSpec usrOutput);
 
+// Raw link splitter implementation
+// The RAWDataHeader pages of the raw input buffers are distributed to nLanes outputs, which
+// are usrOutput with subSpec 0 to nLanes - 1, according to the lane returned by mappingFunc
+// for feeId and link of each page. Every lane gets one message per computation, empty if no
+// page went to that lane, with its pages in input order and the padding of the pages removed.
+using RawLinkMappingFct = std::function<size_t(uint16_t feeId, uint8_t linkID)>;
+o2f::DataProcessorSpec defineRawLinkSplitter(std::string devName, o2f::InputSpec usrInput, o2f::OutputSpec usrOutput,
+                                             size_t nLanes, RawLinkMappingFct const mappingFunc);
+// Shortcut distributing the links round robin, all pages of one link go to the same lane
+o2f::DataProcessorSpec defineRawLinkSplitter(std::string devName, o2f::InputSpec usrInput, o2f::OutputSpec usrOutput,
+                                             size_t nLanes);
+
 } // namespace workflows
 } // namespace o2
 
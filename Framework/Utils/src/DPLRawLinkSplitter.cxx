@@ -0,0 +1,119 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DPLRawLinkSplitter.cxx
+/// \brief Implementation of a generic DPL splitter of raw data by link
+
+#include "../include/Utils/Utils.h"
+#include "Framework/DataProcessorSpec.h"
+#include "Framework/DataRefUtils.h"
+#include "Algorithm/RawPageScanner.h"
+#include "Headers/DataHeader.h"
+#include "Headers/RAWDataHeader.h"
+#include "FairMQLogger.h"
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace o2f = o2::framework;
+
+namespace o2
+{
+namespace workflows
+{
+
+o2f::DataProcessorSpec defineRawLinkSplitter(std::string devName, o2f::InputSpec usrInput, o2f::OutputSpec usrOutput,
+                                             size_t nLanes, RawLinkMappingFct const mappingFunc)
+{
+  if (nLanes == 0) {
+    throw std::invalid_argument("raw link splitter needs at least one output lane");
+  }
+  using SubSpecificationType = o2::header::DataHeader::SubSpecificationType;
+  o2f::Outputs outputs;
+  for (size_t lane = 0; lane < nLanes; ++lane) {
+    outputs.emplace_back(o2f::OutputSpec{ usrOutput.origin, usrOutput.description, static_cast<SubSpecificationType>(lane),
+                                          usrOutput.lifetime });
+  }
+
+  return { devName,                 // Device name from user
+           o2f::Inputs{ usrInput }, // User defined input as a vector of one InputSpec
+           outputs,                 // one output per lane
+
+           o2f::AlgorithmSpec{ [usrOutput, nLanes, mappingFunc](o2f::InitContext&) {
+             // a page to be copied to a lane, pointing into the input buffer
+             struct LanePage {
+               const char* ptr;
+               size_t size;
+               size_t lane;
+             };
+             auto pages = std::make_shared<std::vector<LanePage>>();
+             auto descriptors = std::make_shared<std::vector<o2::algorithm::RawPageDescriptor>>();
+
+             // Defining the ProcessCallback as returned object of InitCallback
+             return [usrOutput, nLanes, mappingFunc, pages, descriptors](o2f::ProcessingContext& ctx) {
+               // scan all input buffers first to know the size of the lane messages
+               pages->clear();
+               std::vector<size_t> laneSizes(nLanes, 0);
+               for (auto const& ref : ctx.inputs()) {
+                 auto const* dh = o2f::DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+                 if (dh == nullptr || ref.payload == nullptr) {
+                   continue;
+                 }
+                 descriptors->clear();
+                 if (o2::algorithm::scanRawPages(ref.payload, dh->payloadSize, *descriptors) < 0) {
+                   LOG(ERROR) << "inconsistent raw data pages in input " << dh->dataOrigin.as<std::string>() << "/"
+                              << dh->dataDescription.as<std::string>() << "/" << dh->subSpecification << ", skipping";
+                   continue;
+                 }
+                 for (auto const& page : *descriptors) {
+                   auto lane = mappingFunc(page.feeId, page.linkID);
+                   if (lane >= nLanes) {
+                     throw std::runtime_error("raw link splitter: lane out of range for feeId " +
+                                              std::to_string(page.feeId) + " link " + std::to_string(page.linkID));
+                   }
+                   pages->emplace_back(LanePage{ ref.payload + page.offset, page.size, lane });
+                   laneSizes[lane] += page.size;
+                 }
+               }
+
+               // one message per lane, the pages are packed, i.e. without the padding up
+               // to the next page, and the offset to the next page is updated accordingly
+               std::vector<char*> lanePtrs(nLanes, nullptr);
+               for (size_t lane = 0; lane < nLanes; ++lane) {
+                 o2f::Output output{ usrOutput.origin, usrOutput.description, static_cast<SubSpecificationType>(lane),
+                                     usrOutput.lifetime };
+                 lanePtrs[lane] = ctx.outputs().newChunk(output, laneSizes[lane]).data();
+               }
+               for (auto const& page : *pages) {
+                 auto& target = lanePtrs[page.lane];
+                 std::memcpy(target, page.ptr, page.size);
+                 reinterpret_cast<o2::header::RAWDataHeader*>(target)->offsetToNext = page.size;
+                 target += page.size;
+               }
+             };
+           } } };
+}
+
+// This is a shortcut distributing the links round robin to the lanes
+o2f::DataProcessorSpec defineRawLinkSplitter(std::string devName, o2f::InputSpec usrInput, o2f::OutputSpec usrOutput,
+                                             size_t nLanes)
+{
+  // the FEE is the outer index, such that the links of one FEE go to different lanes
+  auto mappingFunc = [nLanes](uint16_t feeId, uint8_t linkID) -> size_t {
+    return (static_cast<size_t>(feeId) * 256 + linkID) % nLanes;
+  };
+  // Callling complete implementation
+  return defineRawLinkSplitter(devName, usrInput, usrOutput, nLanes, mappingFunc);
+}
+
+} // namespace workflows
+} // namespace o2
@@ -0,0 +1,91 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file test_DPLRawLinkSplitter.cxx
+/// \brief Workflow test of the raw link splitter, the pages of 4 links are split to 2 lanes
+
+#include "Framework/runDataProcessing.h"
+#include "Framework/ControlService.h"
+#include "Framework/DataRefUtils.h"
+#include "Utils/Utils.h"
+#include "Algorithm/RawPageScanner.h"
+#include "Headers/DataHeader.h"
+#include "Headers/RAWDataHeader.h"
+#include "FairMQLogger.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace o2::framework;
+using RDH = o2::header::RAWDataHeader;
+
+constexpr size_t nLinks = 4;
+constexpr size_t nLanes = 2;
+constexpr size_t pageSize = 8192;
+
+WorkflowSpec defineDataProcessing(ConfigContext const&)
+{
+  WorkflowSpec workflow;
+  workflow.emplace_back(DataProcessorSpec{
+    "producer",
+    Inputs{},
+    Outputs{ { "TST", "RAWDATA", 0, Lifetime::Timeframe } },
+    AlgorithmSpec{ [](ProcessingContext& ctx) {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      // three pages for each link, the payload is filled with the link id
+      auto& buffer = ctx.outputs().newChunk(Output{ "TST", "RAWDATA", 0 }, 3 * nLinks * pageSize);
+      std::memset(buffer.data(), 0, buffer.size());
+      for (size_t page = 0; page < 3 * nLinks; ++page) {
+        RDH rdh;
+        rdh.feeId = 0;
+        rdh.linkID = page % nLinks;
+        rdh.memorySize = sizeof(RDH) + 100 * (page + 1);
+        rdh.offsetToNext = pageSize;
+        std::memcpy(buffer.data() + page * pageSize, &rdh, sizeof(RDH));
+        std::memset(buffer.data() + page * pageSize + sizeof(RDH), rdh.linkID, rdh.memorySize - sizeof(RDH));
+      }
+      ctx.services().get<ControlService>().readyToQuit(true);
+    } } });
+
+  workflow.emplace_back(o2::workflows::defineRawLinkSplitter("splitter",
+                                                             InputSpec{ "raw", "TST", "RAWDATA", 0, Lifetime::Timeframe },
+                                                             OutputSpec{ "TST", "LINKDATA", 0, Lifetime::Timeframe },
+                                                             nLanes));
+
+  for (size_t lane = 0; lane < nLanes; ++lane) {
+    workflow.emplace_back(DataProcessorSpec{
+      "decoder" + std::to_string(lane),
+      Inputs{ { "lane", "TST", "LINKDATA", static_cast<o2::header::DataHeader::SubSpecificationType>(lane), Lifetime::Timeframe } },
+      Outputs{},
+      AlgorithmSpec{ [lane](ProcessingContext& ctx) {
+        auto ref = ctx.inputs().get("lane");
+        auto const* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+        std::vector<o2::algorithm::RawPageDescriptor> pages;
+        if (o2::algorithm::scanRawPages(ref.payload, dh->payloadSize, pages) != 3 * nLinks / nLanes) {
+          LOG(ERROR) << "lane " << lane << ": wrong number of pages";
+        }
+        for (auto const& page : pages) {
+          if (page.linkID % nLanes != lane) {
+            LOG(ERROR) << "lane " << lane << ": wrong link " << (int)page.linkID;
+          }
+          auto payload = ref.payload + page.offset + sizeof(RDH);
+          for (size_t i = 0; i < page.size - sizeof(RDH); ++i) {
+            if (payload[i] != page.linkID) {
+              LOG(ERROR) << "lane " << lane << ": wrong payload of link " << (int)page.linkID;
+              break;
+            }
+          }
+        }
+        ctx.services().get<ControlService>().readyToQuit(true);
+      } } });
+  }
+  return workflow;
+}
@@ -63,6 +63,8 @@ DataProcessorSpec getSourceSpec()
     constexpr auto persistency = Lifetime::Transient;
     auto reader = std::make_shared<RootTreeReader>("testtree",       // tree name
                                                    fileName.c_str(), // input file name
+                                                   RootTreeReader::CacheSize{ 1024 * 1024 },
+                                                   RootTreeReader::ReadAhead{ 2 },
                                                    Output{ "TST", "ARRAYOFDATA", 0, persistency },
                                                    "dataarray" // name of cluster branch
                                                    );
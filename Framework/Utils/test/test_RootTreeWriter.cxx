@@ -175,6 +175,74 @@ BOOST_AUTO_TEST_CASE(test_RootTreeWriter)
             BranchContent<Container>{ "containerbranch_1", c });
 }
 
+BOOST_AUTO_TEST_CASE(test_RootTreeWriterAsync)
+{
+  std::string filename = "test_RootTreeWriterAsync.root";
+  const char* treename = "testtree";
+
+  using Container = std::vector<o2::test::Polymorphic>;
+  RootTreeWriter writer(nullptr, nullptr, // file and tree name are set in init
+                        RootTreeWriter::BranchDef<int>{ "input1", "intbranch" },
+                        RootTreeWriter::BranchDef<Container>{ "input2", "containerbranch" });
+  writer.setAsync(2);
+  writer.init(filename.c_str(), treename);
+  BOOST_CHECK_THROW(writer.setAsync(1), std::runtime_error);
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  std::vector<FairMQMessagePtr> store;
+  int a = 42;
+  Container b{ { 7 } };
+  {
+    DataHeader dh{ "INT", "TST", 0 };
+    dh.payloadSize = sizeof(a);
+    dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+    o2::header::Stack stack{ dh, DataProcessingHeader{ 0, 1 } };
+    store.emplace_back(transport->CreateMessage(stack.size()));
+    memcpy(store.back()->GetData(), stack.data(), stack.size());
+    store.emplace_back(transport->CreateMessage(sizeof(a)));
+    memcpy(store.back()->GetData(), &a, sizeof(a));
+  }
+  {
+    FairMQMessagePtr payload = transport->CreateMessage();
+    TMessageSerializer().Serialize(*payload, &b, TClass::GetClass(typeid(b)));
+    DataHeader dh{ "CONTAINER", "TST", 0 };
+    dh.payloadSize = payload->GetSize();
+    dh.payloadSerializationMethod = o2::header::gSerializationMethodROOT;
+    o2::header::Stack stack{ dh, DataProcessingHeader{ 0, 1 } };
+    store.emplace_back(transport->CreateMessage(stack.size()));
+    memcpy(store.back()->GetData(), stack.data(), stack.size());
+    store.emplace_back(std::move(payload));
+  }
+
+  std::vector<InputRoute> schema = {
+    { InputSpec{ "input1", "TST", "INT" }, "input1", 0 },       //
+    { InputSpec{ "input2", "TST", "CONTAINER" }, "input2", 0 }, //
+  };
+  auto getter = [&store](size_t i) -> char const* { return static_cast<char const*>(store[i]->GetData()); };
+  InputRecord inputs{
+    schema,
+    InputSpan{ getter, store.size() }
+  };
+
+  constexpr int nEntries = 10;
+  for (int entry = 0; entry < nEntries; entry++) {
+    writer(inputs);
+    BOOST_CHECK(writer.getQueueDepth() <= 2);
+  }
+  writer.close();
+  BOOST_CHECK(writer.getQueueDepth() == 0);
+
+  std::unique_ptr<TFile> file(TFile::Open(filename.c_str()));
+  BOOST_REQUIRE(file != nullptr);
+  auto* tree = reinterpret_cast<TTree*>(file->GetObjectChecked(treename, "TTree"));
+  BOOST_REQUIRE(tree != nullptr);
+  BOOST_CHECK_EQUAL(tree->GetEntries(), nEntries);
+  file->Close();
+  checkTree(filename.c_str(), treename,
+            BranchContent<int>{ "intbranch", 42 },
+            BranchContent<Container>{ "containerbranch", b });
+}
+
 template <typename T>
 using BranchDefinition = MakeRootTreeWriterSpec::BranchDefinition<T>;
 
@@ -14,6 +14,7 @@
 #define ALICEO2_GENERATORFROMFILE_H_
 
 #include "FairGenerator.h"
+#include <vector>
 
 class TBranch;
 class TFile;
@@ -32,6 +33,7 @@ class GeneratorFromFile : public FairGenerator
  public:
   GeneratorFromFile() = default;
   GeneratorFromFile(const char* name);
+  ~GeneratorFromFile() override;
 
   // the FairGenerator interface methods
 
@@ -45,13 +47,28 @@ class GeneratorFromFile : public FairGenerator
   void SetStartEvent(int start);
 
   void SetSkipNonTrackable(bool b) { mSkipNonTrackable = b; }
+
+  // Decode up to nEvents events ahead of ReadEvent on a background thread, which is then the only
+  // user of the file; 0 (default) reads the events in ReadEvent. To be set before the first event.
+  void SetReadAhead(int nEvents) { mReadAheadSize = nEvents; }
+
  private:
+  struct Primary;   // a selected particle of the kinematics, as put on the stack
+  struct ReadAhead; // the reader thread and the buffer of decoded events
+
+  // reads the kinematics of an event and selects the primaries to be put on the stack
+  bool readPrimaries(int event, std::vector<Primary>& primaries) const;
+  // the reader thread: decodes the events from mEventCounter on into the buffer
+  void readAheadLoop(int firstEvent);
+
   TFile* mEventFile = nullptr; //! the file containing the persistent events
   int mEventCounter = 0;
   int mEventsAvailable = 0;
   bool mSkipNonTrackable = true; //! whether to pass non-trackable (decayed particles) to the MC stack
+  int mReadAheadSize = 0;
+  ReadAhead* mReadAhead = nullptr; //! started with the first event
 
-  ClassDefOverride(GeneratorFromFile, 1);
+  ClassDefOverride(GeneratorFromFile, 2);
 };
 
 } // end namespace eventgen
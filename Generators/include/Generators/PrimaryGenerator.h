@@ -14,19 +14,12 @@
 #define ALICEO2_EVENTGEN_PRIMARYGENERATOR_H_
 
 #include "FairPrimaryGenerator.h"
+#include <array>
+#include <string>
+#include <vector>
 
-class TFile;
-class TTree;
 class TString;
 
-namespace o2
-{
-namespace dataformats
-{
-class MCEventHeader;
-}
-} // namespace o2
-
 namespace o2
 {
 namespace eventgen
@@ -84,16 +77,14 @@ class PrimaryGenerator : public FairPrimaryGenerator
   void setInteractionDiamond(const Double_t* xyz, const Double_t* sigmaxyz);
 
   /** set interaction vertex position **/
-  void setInteractionVertex(const o2::dataformats::MCEventHeader* event);
+  void setInteractionVertex(const Double_t* xyz);
 
-  /** embedding members **/
-  TFile* mEmbedFile = nullptr;
-  TTree* mEmbedTree = nullptr;
-  Int_t mEmbedEntries = 0;
+  /** embedding members, the vertices of all background events are read once by embedInto **/
+  std::string mEmbedFileName;
+  std::vector<std::array<Double_t, 3>> mEmbedVertices;
   Int_t mEmbedIndex = 0;
-  o2::dataformats::MCEventHeader* mEmbedEvent = nullptr;
 
-  ClassDefOverride(PrimaryGenerator, 2);
+  ClassDefOverride(PrimaryGenerator, 3);
 
 }; /** class PrimaryGenerator **/
 
@@ -105,6 +105,7 @@ void GeneratorFactory::setPrimaryGenerator(o2::conf::SimConfig const& conf, Fair
     // TODO: make this configurable and check for presence
     auto extGen = new o2::eventgen::GeneratorFromFile(conf.getExtKinematicsFileName().c_str());
     extGen->SetStartEvent(conf.getStartEvent());
+    extGen->SetReadAhead(conf.getExtKinematicsReadAhead());
     primGen->AddGenerator(extGen);
     LOG(INFO) << "using external kinematics";
   } else if (genconfig.compare("pythia8") == 0) {
@@ -16,12 +16,39 @@
 #include <TFile.h>
 #include <TParticle.h>
 #include <TTree.h>
+#include <TROOT.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 namespace o2
 {
 namespace eventgen
 {
+struct GeneratorFromFile::Primary {
+  int pdg;
+  bool wanttracking;
+  double px, py, pz;
+  double vx, vy, vz;
+  double e;
+  double tof;
+  double weight;
+};
+
+// the events decoded by the reader thread, at most capacity of them wait in the buffer
+struct GeneratorFromFile::ReadAhead {
+  std::thread reader;
+  std::mutex mutex;
+  std::condition_variable notFull;
+  std::condition_variable notEmpty;
+  std::deque<std::vector<Primary>> events;
+  int capacity = 1;
+  bool stop = false; // set by the generator to stop the reader
+  bool done = false; // set by the reader after the last event
+};
+
 GeneratorFromFile::GeneratorFromFile(const char* name)
 {
   mEventFile = TFile::Open(name);
@@ -46,6 +73,21 @@ GeneratorFromFile::GeneratorFromFile(const char* name)
   LOG(INFO) << "Found " << mEventsAvailable << " events in this file \n";
 }
 
+GeneratorFromFile::~GeneratorFromFile()
+{
+  if (mReadAhead) {
+    {
+      std::lock_guard<std::mutex> lock(mReadAhead->mutex);
+      mReadAhead->stop = true;
+    }
+    mReadAhead->notFull.notify_all();
+    if (mReadAhead->reader.joinable()) {
+      mReadAhead->reader.join();
+    }
+    delete mReadAhead;
+  }
+}
+
 void GeneratorFromFile::SetStartEvent(int start)
 {
   if (start < mEventsAvailable) {
@@ -66,81 +108,127 @@ bool isOnMassShell(TParticle const& p)
   return std::abs(nominalmass - calculatedmass) < tol;
 }
 
-Bool_t GeneratorFromFile::ReadEvent(FairPrimaryGenerator* primGen)
+bool GeneratorFromFile::readPrimaries(int event, std::vector<Primary>& primaries) const
 {
-  if (mEventCounter < mEventsAvailable) {
-    int particlecounter = 0;
+  primaries.clear();
+
+  // get the tree and the branch
+  std::stringstream treestringstr;
+  treestringstr << "Event" << event << "/TreeK";
+  TTree* tree = (TTree*)mEventFile->Get(treestringstr.str().c_str());
+  if (tree == nullptr) {
+    return false;
+  }
 
-    // get the tree and the branch
-    std::stringstream treestringstr;
-    treestringstr << "Event" << mEventCounter << "/TreeK";
-    TTree* tree = (TTree*)mEventFile->Get(treestringstr.str().c_str());
-    if (tree == nullptr) {
-      return kFALSE;
-    }
+  auto branch = tree->GetBranch("Particles");
+  TParticle* particle = nullptr;
+  branch->SetAddress(&particle);
+  LOG(INFO) << "Reading " << branch->GetEntries() << " particles from Kinematics file";
 
-    auto branch = tree->GetBranch("Particles");
-    TParticle* particle = nullptr;
-    branch->SetAddress(&particle);
-    LOG(INFO) << "Reading " << branch->GetEntries() << " particles from Kinematics file";
+  // read the whole kinematics initially
+  std::vector<TParticle> particles;
+  for (int i = 0; i < branch->GetEntries(); ++i) {
+    branch->GetEntry(i);
+    particles.push_back(*particle);
+  }
+  // the tree is owned by the file, delete it to not accumulate the events in memory
+  delete tree;
+
+  // filter the particles from Kinematics.root originally put by a generator
+  // and which are trackable
+  auto isFirstTrackableDescendant = [](TParticle const& p) {
+    // according to the current understanding in AliRoot, we
+    // have status code:
+    // == 0    <--->   particle is put by transportation
+    // == 1    <--->   particle is trackable
+    // != 1 but different from 0    <--->   particle is not directly trackable
+    // Note: This might have to be refined (using other information such as UniqueID)
+    if (p.GetStatusCode() == 1) {
+      return true;
+    }
+    return false;
+  };
 
-    // read the whole kinematics initially
-    std::vector<TParticle> particles;
-    for (int i = 0; i < branch->GetEntries(); ++i) {
-      branch->GetEntry(i);
-      particles.push_back(*particle);
+  for (auto& p : particles) {
+    if (!isFirstTrackableDescendant(p)) {
+      continue;
     }
 
-    // filter the particles from Kinematics.root originally put by a generator
-    // and which are trackable
-    auto isFirstTrackableDescendant = [](TParticle const& p) {
-      // according to the current understanding in AliRoot, we
-      // have status code:
-      // == 0    <--->   particle is put by transportation
-      // == 1    <--->   particle is trackable
-      // != 1 but different from 0    <--->   particle is not directly trackable
-      // Note: This might have to be refined (using other information such as UniqueID)
-      if (p.GetStatusCode() == 1) {
-        return true;
+    auto pdgid = p.GetPdgCode();
+    // a status of 1 means "trackable" in AliRoot kinematics
+    auto status = p.GetStatusCode();
+    bool wanttracking = status == 1;
+    if (wanttracking || !mSkipNonTrackable) {
+      if (!isOnMassShell(p)) {
+        LOG(WARNING) << "Skipping " << pdgid << " since off-mass shell";
+        continue;
       }
-      return false;
-    };
+      LOG(DEBUG) << "Putting primary " << pdgid << " " << p.GetStatusCode() << " " << p.GetUniqueID();
+      primaries.emplace_back(Primary{ pdgid, wanttracking, p.Px(), p.Py(), p.Pz(), p.Vx(), p.Vy(), p.Vz(), p.Energy(), p.T(), p.GetWeight() });
+    }
+  }
+  return true;
+}
 
-    for (int i = 0; i < branch->GetEntries(); ++i) {
-      auto& p = particles[i];
+void GeneratorFromFile::readAheadLoop(int firstEvent)
+{
+  auto& ahead = *mReadAhead;
+  for (int event = firstEvent; event < mEventsAvailable; ++event) {
+    std::vector<Primary> primaries;
+    bool ok = readPrimaries(event, primaries);
+
+    std::unique_lock<std::mutex> lock(ahead.mutex);
+    ahead.notFull.wait(lock, [&ahead]() { return ahead.stop || (int)ahead.events.size() < ahead.capacity; });
+    if (ahead.stop) {
+      return;
+    }
+    if (!ok) {
+      break;
+    }
+    ahead.events.emplace_back(std::move(primaries));
+    lock.unlock();
+    ahead.notEmpty.notify_one();
+  }
+  {
+    std::lock_guard<std::mutex> lock(ahead.mutex);
+    ahead.done = true;
+  }
+  ahead.notEmpty.notify_one();
+}
 
-      if (!isFirstTrackableDescendant(p)) {
-        continue;
+Bool_t GeneratorFromFile::ReadEvent(FairPrimaryGenerator* primGen)
+{
+  if (mEventCounter < mEventsAvailable) {
+    std::vector<Primary> primaries;
+    if (mReadAheadSize > 0) {
+      if (mReadAhead == nullptr) {
+        // the file is only used by the reader thread from now on, but ROOT keeps global lists of objects
+        ROOT::EnableThreadSafety();
+        mReadAhead = new ReadAhead;
+        mReadAhead->capacity = mReadAheadSize;
+        mReadAhead->reader = std::thread(&GeneratorFromFile::readAheadLoop, this, mEventCounter);
       }
-
-      auto pdgid = p.GetPdgCode();
-      auto px = p.Px();
-      auto py = p.Py();
-      auto pz = p.Pz();
-      auto vx = p.Vx();
-      auto vy = p.Vy();
-      auto vz = p.Vz();
-
-      // a status of 1 means "trackable" in AliRoot kinematics
-      auto status = p.GetStatusCode();
-      bool wanttracking = status == 1;
-      if (wanttracking || !mSkipNonTrackable) {
-        auto parent = -1;
-        auto e = p.Energy();
-        auto tof = p.T();
-        auto weight = p.GetWeight();
-        if (!isOnMassShell(p)) {
-          LOG(WARNING) << "Skipping " << pdgid << " since off-mass shell";
-          continue;
-        }
-        LOG(DEBUG) << "Putting primary " << pdgid << " " << p.GetStatusCode() << " " << p.GetUniqueID();
-        primGen->AddTrack(pdgid, px, py, pz, vx, vy, vz, parent, wanttracking, e, tof, weight);
-        particlecounter++;
+      auto& ahead = *mReadAhead;
+      std::unique_lock<std::mutex> lock(ahead.mutex);
+      ahead.notEmpty.wait(lock, [&ahead]() { return ahead.done || !ahead.events.empty(); });
+      if (ahead.events.empty()) {
+        return kFALSE; // the reader could not read the event
       }
+      primaries = std::move(ahead.events.front());
+      ahead.events.pop_front();
+      lock.unlock();
+      ahead.notFull.notify_one();
+    } else if (!readPrimaries(mEventCounter, primaries)) {
+      return kFALSE;
+    }
+
+    for (auto& p : primaries) {
+      const auto parent = -1;
+      primGen->AddTrack(p.pdg, p.px, p.py, p.pz, p.vx, p.vy, p.vz, parent, p.wanttracking, p.e, p.tof, p.weight);
     }
     mEventCounter++;
 
-    LOG(INFO) << "Event generator put " << particlecounter << " on stack";
+    LOG(INFO) << "Event generator put " << primaries.size() << " on stack";
     return kTRUE;
   } else {
     LOG(ERROR) << "GeneratorFromFile: Ran out of events\n";
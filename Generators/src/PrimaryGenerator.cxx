@@ -16,8 +16,11 @@
 #include "FairLogger.h"
 
 #include "FairGenericStack.h"
+#include "TBranch.h"
 #include "TFile.h"
 #include "TTree.h"
+#include "TString.h"
+#include <memory>
 
 #include "TDatabasePDG.h"
 #include "TVirtualMC.h"
@@ -31,17 +34,7 @@ namespace eventgen
 
 /*****************************************************************/
 
-PrimaryGenerator::~PrimaryGenerator()
-{
-  /** destructor **/
-
-  if (mEmbedFile && mEmbedFile->IsOpen()) {
-    mEmbedFile->Close();
-    delete mEmbedFile;
-  }
-  if (mEmbedEvent)
-    delete mEmbedEvent;
-}
+PrimaryGenerator::~PrimaryGenerator() = default;
 
 /*****************************************************************/
 
@@ -52,9 +45,9 @@ Bool_t PrimaryGenerator::Init()
   LOG(INFO) << "Initialising primary generator";
 
   /** embedding **/
-  if (mEmbedTree) {
-    LOG(INFO) << "Embedding into: " << mEmbedFile->GetName()
-              << " (" << mEmbedEntries << " events)";
+  if (!mEmbedVertices.empty()) {
+    LOG(INFO) << "Embedding into: " << mEmbedFileName
+              << " (" << mEmbedVertices.size() << " events)";
     return FairPrimaryGenerator::Init();
   }
 
@@ -75,14 +68,13 @@ Bool_t PrimaryGenerator::GenerateEvent(FairGenericStack* pStack)
   /** generate event **/
 
   /** normal generation if no embedding **/
-  if (!mEmbedTree)
+  if (mEmbedVertices.empty())
     return FairPrimaryGenerator::GenerateEvent(pStack);
 
   /** this is for embedding **/
 
   /** setup interaction vertex **/
-  mEmbedTree->GetEntry(mEmbedIndex);
-  setInteractionVertex(mEmbedEvent);
+  setInteractionVertex(mEmbedVertices[mEmbedIndex].data());
 
   /** generate event **/
   if (!FairPrimaryGenerator::GenerateEvent(pStack))
@@ -91,13 +83,13 @@ Bool_t PrimaryGenerator::GenerateEvent(FairGenericStack* pStack)
   /** add embedding info to event header **/
   auto o2event = dynamic_cast<MCEventHeader*>(fEvent);
   if (o2event) {
-    o2event->setEmbeddingFileName(mEmbedFile->GetName());
+    o2event->setEmbeddingFileName(mEmbedFileName.c_str());
     o2event->setEmbeddingEventIndex(mEmbedIndex);
   }
 
   /** increment embedding counter **/
   mEmbedIndex++;
-  mEmbedIndex %= mEmbedEntries;
+  mEmbedIndex %= mEmbedVertices.size();
 
   /** success **/
   return kTRUE;
@@ -143,11 +135,10 @@ void PrimaryGenerator::setInteractionDiamond(const Double_t* xyz, const Double_t
 
 /*****************************************************************/
 
-void PrimaryGenerator::setInteractionVertex(const MCEventHeader* event)
+void PrimaryGenerator::setInteractionVertex(const Double_t* xyz)
 {
   /** set interaction vertex **/
 
-  Double_t xyz[3] = { event->GetX(), event->GetY(), event->GetZ() };
   SetBeam(xyz[0], xyz[1], 0., 0.);
   SetTarget(xyz[2], 0.);
   SmearVertexXY(false);
@@ -162,36 +153,50 @@ Bool_t PrimaryGenerator::embedInto(TString fname)
 {
   /** embed into **/
 
-  /** check if a file is already open **/
-  if (mEmbedFile && mEmbedFile->IsOpen()) {
-    LOG(ERROR) << "Another embedding file is currently open";
+  /** check if a file is already used **/
+  if (!mEmbedVertices.empty()) {
+    LOG(ERROR) << "Another embedding file is currently used";
     return kFALSE;
   }
 
   /** open file **/
-  mEmbedFile = TFile::Open(fname);
-  if (!mEmbedFile || !mEmbedFile->IsOpen()) {
+  std::unique_ptr<TFile> file(TFile::Open(fname));
+  if (!file || !file->IsOpen()) {
     LOG(ERROR) << "Cannot open file for embedding: " << fname;
     return kFALSE;
   }
 
   /** get tree **/
-  mEmbedTree = (TTree*)mEmbedFile->Get("o2sim");
-  if (!mEmbedTree) {
+  auto tree = (TTree*)file->Get("o2sim");
+  if (!tree) {
     LOG(ERROR) << R"(Cannot find "o2sim" tree for embedding in )" << fname;
     return kFALSE;
   }
 
   /** get entries **/
-  mEmbedEntries = mEmbedTree->GetEntries();
-  if (mEmbedEntries <= 0) {
-    LOG(ERROR) << "Invalid number of entries found in tree for embedding: " << mEmbedEntries;
+  auto entries = tree->GetEntries();
+  if (entries <= 0) {
+    LOG(ERROR) << "Invalid number of entries found in tree for embedding: " << entries;
     return kFALSE;
   }
 
-  /** connect MC event header **/
-  mEmbedEvent = new MCEventHeader;
-  mEmbedTree->SetBranchAddress("MCEventHeader.", &mEmbedEvent);
+  /** read the vertices of all events, only the event header branch is read **/
+  auto branch = tree->GetBranch("MCEventHeader.");
+  if (!branch) {
+    LOG(ERROR) << R"(Cannot find "MCEventHeader." branch for embedding in )" << fname;
+    return kFALSE;
+  }
+  auto event = new MCEventHeader;
+  branch->SetAddress(&event);
+  mEmbedVertices.resize(entries);
+  for (Long64_t entry = 0; entry < entries; ++entry) {
+    branch->GetEntry(entry);
+    mEmbedVertices[entry] = { event->GetX(), event->GetY(), event->GetZ() };
+  }
+  branch->ResetAddress();
+  delete event;
+  mEmbedFileName = fname.Data();
+  mEmbedIndex = 0;
 
   /** success **/
   return kTRUE;
@@ -16,6 +16,7 @@
 #include "Headers/DataHeader.h"
 #include "TStopwatch.h"
 #include "Steer/HitProcessingManager.h" // for RunContext
+#include "HitReader.h"
 #include "TChain.h"
 
 #include "EMCALSimulation/Digitizer.h"
@@ -32,23 +33,6 @@ namespace o2
 namespace emcal
 {
 
-// helper function which will be offered as a service
-template <typename T>
-void retrieveHits(std::vector<TChain*> const& chains,
-                  const char* brname,
-                  int sourceID,
-                  int entryID,
-                  std::vector<T>* hits)
-{
-  auto br = chains[sourceID]->GetBranch(brname);
-  if (!br) {
-    LOG(ERROR) << "No branch found";
-    return;
-  }
-  br->SetAddress(&hits);
-  br->GetEntry(entryID);
-}
-
 DataProcessorSpec getEMCALDigitizerSpec(int channel)
 {
   // setup of some data structures shared between init and processing functions
@@ -88,10 +72,11 @@ DataProcessorSpec getEMCALDigitizerSpec(int channel)
 
     LOG(INFO) << " CALLING EMCAL DIGITIZATION ";
 
-    static std::vector<o2::emcal::Hit> hits;
+    o2::steer::HitReader<o2::emcal::Hit> hitReader(*simChains.get(), { "EMCHit" });
     o2::dataformats::MCTruthContainer<o2::MCCompLabel> labelAccum;
 
     auto& eventParts = context->getEventParts();
+    hitReader.setEventParts(eventParts);
     // loop over all composite collisions given from context
     // (aka loop over all the interaction records)
     for (int collID = 0; collID < timesview.size(); ++collID) {
@@ -104,8 +89,8 @@ DataProcessorSpec getEMCALDigitizerSpec(int channel)
         digitizer->setCurrSrcID(part.sourceID);
 
         // get the hits for this event and this source
-        hits.clear();
-        retrieveHits(*simChains.get(), "EMCHit", part.sourceID, part.entryID, &hits);
+        auto partHits = hitReader.getHits(part.sourceID, part.entryID);
+        const auto& hits = (*partHits)[0];
 
         LOG(INFO) << "For collision " << collID << " eventID " << part.entryID << " found " << hits.size() << " hits ";
 
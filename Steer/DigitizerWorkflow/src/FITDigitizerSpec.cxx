@@ -108,14 +108,12 @@ class FITDPLDigitizerTask
         // get the hits for this event and this source
         hits.clear();
         retrieveHits(mSimChains, part.sourceID, part.entryID, &hits);
-        LOG(INFO) << "For collision " << collID << " eventID " << part.entryID << " found " << hits.size() << " hits ";
+        LOG(DEBUG) << "For collision " << collID << " eventID " << part.entryID << " found " << hits.size() << " hits ";
 
         // call actual digitization procedure
         labels.clear();
         // digits.clear();
         mDigitizer.process(&hits, &digit);
-        const auto& data = digit.getChDgData();
-        LOG(INFO) << "Have " << data.size() << " fired channels ";
         // copy digits into accumulator
         labelAccum.mergeAtBack(labels);
       }
@@ -123,9 +121,9 @@ class FITDPLDigitizerTask
       mDigitizer.setTriggers(&digit);
       mDigitizer.smearCFDtime(&digit);
       digitAccum.push_back(digit); // we should move it there actually
-      LOG(INFO) << "Have " << digitAccum.back().getChDgData().size() << " fired channels ";
-      digit.printStream(std::cout);
+      LOG(DEBUG) << "Have " << digitAccum.back().getChDgData().size() << " fired channels ";
     }
+    LOG(INFO) << "Have " << digitAccum.size() << " digits from " << timesview.size() << " collisions";
 
     // here we have all digits and we can send them to consumer (aka snapshot it onto output)
     pc.outputs().snapshot(Output{ mOrigin, "DIGITS", 0, Lifetime::Timeframe }, digitAccum);
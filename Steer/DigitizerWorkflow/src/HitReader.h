@@ -0,0 +1,272 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef STEER_DIGITIZERWORKFLOW_HITREADER_H_
+#define STEER_DIGITIZERWORKFLOW_HITREADER_H_
+
+#include "SimulationDataFormat/RunContext.h"
+#include "Steer/HitReaderParam.h"
+#include "CommonUtils/CompactHits.h"
+#include <FairLogger.h>
+#include <TChain.h>
+#include <TROOT.h>
+#include <atomic>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+/// Reader of the hit branches of the simulation chains for the event parts of a collision context.
+/// Knowing the parts in the order the digitizer visits them, the reader
+/// - enables the TTreeCache of the chains for the hit branches only,
+/// - reads (and decompresses) the next part on a background thread while the current one is digitized,
+/// - keeps the hits of the parts used by several collisions (e.g. background events) until their last use.
+/// The kept hits are limited by a memory budget (HitReader.hitCacheSizeMB) shared by all the readers of the
+/// process, the least recently used parts being dropped (and read again when needed) beyond it.
+/// Hits written in the compact format (CommonUtils/CompactHits.h, branch "<name>Compact") are decoded
+/// if the branch of the hit objects is absent.
+/// The chains must only be read through the reader once the context is set. At most one read is in
+/// flight at any time, such that each chain is never accessed concurrently.
+template <typename T>
+class HitReader
+{
+ public:
+  using HitVector = std::vector<T>;
+  /// hits of one event part, one vector per branch
+  using PartHits = std::vector<HitVector>;
+
+  /// \param chains simulation chains, indexed by the source ID
+  /// \param branchNames hit branches to read for each part
+  HitReader(std::vector<TChain*> const& chains, std::vector<std::string> branchNames)
+    : mChains(chains), mBranchNames(std::move(branchNames))
+  {
+    const auto& param = HitReaderParam::Instance();
+    mReadAhead = param.readAhead;
+    const long cacheSize = long(param.treeCacheSizeMB) * 1024 * 1024;
+    if (mReadAhead) {
+      ROOT::EnableThreadSafety();
+    }
+    if (cacheSize > 0) {
+      for (auto chain : mChains) {
+        chain->SetCacheSize(cacheSize);
+        for (auto& name : mBranchNames) {
+          if (chain->GetBranch(name.c_str())) {
+            chain->AddBranchToCache(name.c_str(), true);
+          } else if (CompactHits && chain->GetBranch((name + "Compact").c_str())) {
+            chain->AddBranchToCache((name + "Compact").c_str(), true);
+          }
+        }
+        chain->StopCacheLearningPhase();
+      }
+    }
+  }
+
+  ~HitReader()
+  {
+    waitReadAhead();
+    clearCache();
+    if (mOrder.size()) {
+      LOG(INFO) << "Hits of " << mNReused << " out of " << mOrder.size() << " event parts were reused from memory";
+    }
+  }
+
+  /// Set the event parts (of a RunContext) which will be requested, in order
+  void setEventParts(std::vector<std::vector<o2::steer::EventPart>> const& eventParts)
+  {
+    waitReadAhead();
+    mOrder.clear();
+    mUses.clear();
+    clearCache();
+    for (auto& parts : eventParts) {
+      for (auto& part : parts) {
+        const Key key{ part.sourceID, part.entryID };
+        mOrder.push_back(key);
+        mUses[key]++;
+      }
+    }
+    mPosition = 0;
+    launchReadAhead();
+  }
+
+  /// \return hits of a part, the returned vectors stay valid as long as they are referenced
+  std::shared_ptr<PartHits> getHits(int sourceID, int entryID)
+  {
+    const Key key{ sourceID, entryID };
+    if (mPosition < mOrder.size() && mOrder[mPosition] == key) {
+      mPosition++;
+    } else {
+      LOG(WARNING) << "Hits of source " << sourceID << " entry " << entryID << " requested out of order";
+    }
+    waitReadAhead();
+    std::shared_ptr<PartHits> hits;
+    auto cached = mCache.find(key);
+    if (cached != mCache.end()) {
+      hits = cached->second.hits;
+      mNReused += cached->second.reused;
+      erase(cached);
+    } else {
+      hits = read(key);
+    }
+    // keep the hits only if this part is used again later
+    auto uses = mUses.find(key);
+    if (uses != mUses.end() && --uses->second > 0) {
+      keep(key, hits, true);
+    }
+    launchReadAhead();
+    return hits;
+  }
+
+  /// \return number of requests served from the hits kept after a previous request
+  size_t getNReused() const { return mNReused; }
+
+ private:
+  using Key = std::pair<int, int>; // source ID, entry ID
+  static constexpr bool CompactHits = o2::utils::CompactHitCodec<T>::available;
+
+  struct CacheEntry {
+    std::shared_ptr<PartHits> hits;  ///< kept hits
+    size_t bytes = 0;                ///< memory used by the hits
+    std::list<Key>::iterator lruPos; ///< position in the LRU list
+    bool reused = false;             ///< kept after a request, not read ahead
+  };
+
+  /// memory used by the kept hits of all the readers of the process
+  static std::atomic<size_t>& cacheUsage()
+  {
+    static std::atomic<size_t> usage{ 0 };
+    return usage;
+  }
+
+  /// keep the hits of a part, dropping the least recently used parts beyond the memory budget
+  void keep(Key key, std::shared_ptr<PartHits> hits, bool reused = false)
+  {
+    size_t bytes = 0;
+    for (auto& v : *hits) {
+      bytes += v.capacity() * sizeof(T);
+    }
+    const size_t budget = size_t(HitReaderParam::Instance().hitCacheSizeMB) * 1024 * 1024;
+    while (!mLRU.empty() && cacheUsage() + bytes > budget) {
+      erase(mCache.find(mLRU.back()));
+    }
+    if (cacheUsage() + bytes > budget) {
+      return; // does not fit, will be read again
+    }
+    mLRU.push_front(key);
+    mCache[key] = CacheEntry{ std::move(hits), bytes, mLRU.begin(), reused };
+    cacheUsage() += bytes;
+  }
+
+  void erase(typename std::map<Key, CacheEntry>::iterator entry)
+  {
+    cacheUsage() -= entry->second.bytes;
+    mLRU.erase(entry->second.lruPos);
+    mCache.erase(entry);
+  }
+
+  void clearCache()
+  {
+    while (!mCache.empty()) {
+      erase(mCache.begin());
+    }
+  }
+
+  std::shared_ptr<PartHits> read(Key key) const
+  {
+    auto hits = std::make_shared<PartHits>(mBranchNames.size());
+    auto chain = mChains[key.first];
+    const auto localEntry = chain->LoadTree(key.second);
+    for (size_t ib = 0; ib < mBranchNames.size(); ib++) {
+      auto br = localEntry >= 0 ? chain->GetTree()->GetBranch(mBranchNames[ib].c_str()) : nullptr;
+      if (!br && localEntry >= 0 && readCompact(chain->GetTree(), mBranchNames[ib], localEntry, (*hits)[ib])) {
+        continue;
+      }
+      if (!br) {
+        LOG(ERROR) << "No branch " << mBranchNames[ib] << " found for sourceID=" << key.first << " entryID=" << key.second;
+        continue;
+      }
+      auto hitsPtr = &(*hits)[ib];
+      br->SetAddress(&hitsPtr);
+      br->GetEntry(localEntry);
+      br->ResetAddress();
+    }
+    return hits;
+  }
+
+  /// read and decode the compact hits of a branch, false if there is no such branch
+  static bool readCompact(TTree* tree, std::string const& name, Long64_t entry, HitVector& hits)
+  {
+    if constexpr (CompactHits) {
+      auto br = tree->GetBranch((name + "Compact").c_str());
+      if (!br) {
+        return false;
+      }
+      std::vector<char> buffer;
+      auto bufferPtr = &buffer;
+      br->SetAddress(&bufferPtr);
+      br->GetEntry(entry);
+      br->ResetAddress();
+      if (!o2::utils::decodeHits(buffer.data(), buffer.size(), hits)) {
+        LOG(ERROR) << "Invalid compact hits in branch " << name << "Compact, entry " << entry;
+        hits.clear();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  /// start reading the next part which is not cached yet
+  void launchReadAhead()
+  {
+    if (!mReadAhead) {
+      return;
+    }
+    for (auto pos = mPosition; pos < mOrder.size(); pos++) {
+      const auto key = mOrder[pos];
+      if (mCache.find(key) == mCache.end()) {
+        mPendingKey = key;
+        mPending = std::async(std::launch::async, [this, key]() { return read(key); });
+        return;
+      }
+    }
+  }
+
+  /// wait for the read in flight, if any, and cache its result
+  void waitReadAhead()
+  {
+    if (mPending.valid()) {
+      keep(mPendingKey, mPending.get());
+    }
+  }
+
+  std::vector<TChain*> mChains;                      ///< simulation chains per source ID
+  std::vector<std::string> mBranchNames;             ///< hit branches to read
+  bool mReadAhead = true;                            ///< read the next part on a background thread
+  std::vector<Key> mOrder;                           ///< parts in the order of the requests
+  size_t mPosition = 0;                              ///< position of the next request in mOrder
+  std::map<Key, int> mUses;                          ///< remaining number of requests of each part
+  std::map<Key, CacheEntry> mCache;                  ///< hits of the parts read ahead or used again
+  std::list<Key> mLRU;                               ///< kept parts, most recently used first
+  size_t mNReused = 0;                               ///< number of requests served from hits kept for reuse
+  std::future<std::shared_ptr<PartHits>> mPending;   ///< read in flight
+  Key mPendingKey;                                   ///< part of the read in flight
+};
+
+} // namespace steer
+} // namespace o2
+
+#endif
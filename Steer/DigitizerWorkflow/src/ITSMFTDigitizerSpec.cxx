@@ -16,6 +16,7 @@
 #include "Framework/Task.h"
 #include "Headers/DataHeader.h"
 #include "Steer/HitProcessingManager.h" // for RunContext
+#include "HitReader.h"
 #include "ITSMFTBase/Digit.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include "DetectorsBase/GeometryManager.h"
@@ -117,6 +118,8 @@ class ITSMFTDPLDigitizerTask
     setupQEDChain();
 
     auto& eventParts = context->getEventParts();
+    o2::steer::HitReader<o2::itsmft::Hit> hitReader(mSimChains, { detStr + "Hit" });
+    hitReader.setEventParts(eventParts);
     // loop over all composite collisions given from context (aka loop over all the interaction records)
     for (int collID = 0; collID < timesview.size(); ++collID) {
       auto eventTime = timesview[collID].timeNS;
@@ -132,13 +135,13 @@ class ITSMFTDPLDigitizerTask
       for (auto& part : eventParts[collID]) {
 
         // get the hits for this event and this source
-        mHits.clear();
-        retrieveHits(part.sourceID, part.entryID);
+        auto partHits = hitReader.getHits(part.sourceID, part.entryID);
+        const auto& hits = (*partHits)[0];
 
         LOG(INFO) << "For collision " << collID << " eventID " << part.entryID
-                  << " found " << mHits.size() << " hits " << FairLogger::endl;
+                  << " found " << hits.size() << " hits " << FairLogger::endl;
 
-        mDigitizer.process(&mHits, part.entryID, part.sourceID); // call actual digitization procedure
+        mDigitizer.process(&hits, part.entryID, part.sourceID); // call actual digitization procedure
       }
       mMC2ROFRecordsAccum.emplace_back(collID, -1, mDigitizer.getEventROFrameMin(), mDigitizer.getEventROFrameMax());
       accumulate();
@@ -206,18 +209,6 @@ class ITSMFTDPLDigitizerTask
   }
 
   // helper function which will be offered as a service
-  void retrieveHits(int sourceID, int entryID)
-  {
-    std::string detStr = mID.getName();
-    auto br = mSimChains[sourceID]->GetBranch((detStr + "Hit").c_str());
-    if (!br) {
-      LOG(ERROR) << "No branch " << (detStr + "Hit").c_str() << " found for sourceID=" << sourceID << FairLogger::endl;
-      return;
-    }
-    br->SetAddress(&mHitsP);
-    br->GetEntry(entryID);
-  }
-
   void accumulate()
   {
     // accumulate result of single event processing, called after processing every event supplied
@@ -310,6 +301,7 @@ class ITSDPLDigitizerTask : public ITSMFTDPLDigitizerTask
     digipar.setNoisePerPixel(dopt.noisePerPixel);     // noise level
     digipar.setTimeOffset(dopt.timeOffset);
     digipar.setNSimSteps(dopt.nSimSteps);
+    mDigitizer.setNThreads(dopt.nThreads);
   }
 };
 
@@ -344,6 +336,7 @@ class MFTDPLDigitizerTask : public ITSMFTDPLDigitizerTask
     digipar.setNoisePerPixel(dopt.noisePerPixel);     // noise level
     digipar.setTimeOffset(dopt.timeOffset);
     digipar.setNSimSteps(dopt.nSimSteps);
+    mDigitizer.setNThreads(dopt.nThreads);
   }
 };
 
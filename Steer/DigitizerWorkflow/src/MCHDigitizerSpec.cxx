@@ -73,6 +73,7 @@ class MCHDPLDigitizerTask
     if (!gGeoManager) {
       o2::base::GeometryManager::loadGeometry();
     }
+    mDigitizer.setNThreads(ic.options().get<int>("nThreads"));
   }
 
   void run(framework::ProcessingContext& pc)
@@ -164,7 +165,8 @@ o2::framework::DataProcessorSpec getMCHDigitizerSpec(int channel)
              OutputSpec{ "MCH", "ROMode", 0, Lifetime::Timeframe } },
     AlgorithmSpec{ adaptFromTask<MCHDPLDigitizerTask>() },
     Options{ { "simFile", VariantType::String, "o2sim.root", { "Sim (background) input filename" } },
-             { "simFileS", VariantType::String, "", { "Sim (signal) input filename" } } }
+             { "simFileS", VariantType::String, "", { "Sim (signal) input filename" } },
+             { "nThreads", VariantType::Int, 1, { "number of threads digitizing the detection elements" } } }
   };
 }
 
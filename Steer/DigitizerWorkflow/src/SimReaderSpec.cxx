@@ -33,13 +33,23 @@ namespace o2
 {
 namespace steer
 {
+namespace
+{
+// the part of the work of a TPC digitizer
+struct TPCChunk {
+  int sector = -2; // sector to digitize, -2 for NOP
+  int chunk = 0;   // chunk of the collisions
+  int nchunks = 0; // total number of chunks
+};
+} // namespace
+
 DataProcessorSpec getSimReaderSpec(int fanoutsize, const std::vector<int>& tpcsectors,
                                    std::shared_ptr<std::vector<int>> tpcsubchannels)
 {
-  // this container will contain the TPC sector assignment per subchannel per invocation
+  // this container will contain the TPC sector (and collision chunk) assignment per subchannel per invocation
   // it will allow that we snapshot/send exactly one sector assignment per algorithm invocation
   // to ensure that they all have different timeslice ids
-  auto tpcsectormessages = std::make_shared<std::vector<std::vector<int>>>();
+  auto tpcsectormessages = std::make_shared<std::vector<std::vector<TPCChunk>>>();
   tpcsectormessages->resize(tpcsubchannels->size());
   int tpcchannelcounter = 0;
   uint64_t activeSectors = 0;
@@ -47,30 +57,62 @@ DataProcessorSpec getSimReaderSpec(int fanoutsize, const std::vector<int>& tpcse
     activeSectors |= (uint64_t)0x1 << tpcsector;
     auto actualchannel = (*tpcsubchannels.get())[tpcchannelcounter % tpcsubchannels->size()];
     LOG(DEBUG) << " WILL ASSIGN SECTOR " << tpcsector << " to subchannel " << actualchannel;
-    tpcsectormessages->operator[](actualchannel).emplace_back(tpcsector);
+    tpcsectormessages->operator[](actualchannel).emplace_back(TPCChunk{ tpcsector, 0, 0 });
     tpcchannelcounter++;
   }
 
+  // the contexts of the collision chunks sent to the TPC digitizers, in case of chunking
+  auto tpcchunkcontexts = std::make_shared<std::vector<RunContext>>();
+
   // this is the number of invocations of the algorithm needed for the TPC
-  size_t tpcinvocations = 0;
-  for (int i = 0; i < tpcsubchannels->size(); ++i) {
-    tpcinvocations = std::max(tpcinvocations, tpcsectormessages->operator[](i).size());
-  }
-  // in principle each channel needs to be invoked exactly the same number of times (sigh)
-  // so I am adding some kind of "NOP" sectors in case needed
-  for (int i = 0; i < tpcsubchannels->size(); ++i) {
-    auto size = tpcsectormessages->operator[](i).size();
-    if (size < tpcinvocations) {
-      for (int k = 0; k < tpcinvocations - size; ++k) {
-        tpcsectormessages->operator[](i).emplace_back(-2); // -2 is NOP
-        LOG(INFO) << "ADDING NOP TO CHANNEL " << i << "\n";
+  // (known once the collision context, hence the number of chunks, is set up)
+  auto tpcinvocations = std::make_shared<size_t>(0);
+
+  // split the work of each sector into chunks of collisions and equalize the number of
+  // invocations of the TPC channels
+  auto setupTPCChunks = [tpcsectormessages, tpcchunkcontexts, tpcinvocations](RunContext const& context,
+                                                                               int chunksize) {
+    const int ncollisions = context.getEventRecords().size();
+    if (chunksize > 0 && chunksize < ncollisions) {
+      for (int first = 0; first < ncollisions; first += chunksize) {
+        const int n = std::min(chunksize, ncollisions - first);
+        tpcchunkcontexts->emplace_back(context);
+        auto& chunk = tpcchunkcontexts->back();
+        chunk.setNCollisions(n);
+        auto& records = chunk.getEventRecords();
+        records.assign(context.getEventRecords().begin() + first, context.getEventRecords().begin() + first + n);
+        auto& parts = chunk.getEventParts();
+        parts.assign(context.getEventParts().begin() + first, context.getEventParts().begin() + first + n);
       }
-      assert(tpcsectormessages->operator[](i).size() == tpcinvocations);
+      LOG(INFO) << "TPC collisions will be digitized in " << tpcchunkcontexts->size() << " chunks of " << chunksize;
     }
-  }
-  // at this moment all tpc digitizers should receive the exact same number of messages/invocations
+    const int nchunks = std::max<int>(1, tpcchunkcontexts->size());
+    for (auto& messages : *tpcsectormessages) {
+      std::vector<TPCChunk> chunks;
+      for (auto& sectormessage : messages) {
+        for (int chunk = 0; chunk < nchunks; ++chunk) {
+          chunks.emplace_back(TPCChunk{ sectormessage.sector, chunk, nchunks });
+        }
+      }
+      messages = std::move(chunks);
+      *tpcinvocations = std::max(*tpcinvocations, messages.size());
+    }
+    // in principle each channel needs to be invoked exactly the same number of times (sigh)
+    // so I am adding some kind of "NOP" sectors in case needed
+    for (int i = 0; i < tpcsectormessages->size(); ++i) {
+      auto size = tpcsectormessages->operator[](i).size();
+      if (size < *tpcinvocations) {
+        for (int k = 0; k < *tpcinvocations - size; ++k) {
+          tpcsectormessages->operator[](i).emplace_back(TPCChunk{ -2, 0, 0 }); // -2 is NOP
+          LOG(INFO) << "ADDING NOP TO CHANNEL " << i << "\n";
+        }
+        assert(tpcsectormessages->operator[](i).size() == *tpcinvocations);
+      }
+    }
+    // at this moment all tpc digitizers should receive the exact same number of messages/invocations
+  };
 
-  auto doit = [fanoutsize, tpcsectormessages, tpcinvocations, tpcsubchannels, activeSectors](ProcessingContext& pc) {
+  auto doit = [fanoutsize, tpcsectormessages, tpcchunkcontexts, tpcinvocations, tpcsubchannels, activeSectors](ProcessingContext& pc) {
     auto& mgr = steer::HitProcessingManager::instance();
     auto eventrecords = mgr.getRunContext().getEventRecords();
     const auto& context = mgr.getRunContext();
@@ -103,13 +145,15 @@ DataProcessorSpec getSimReaderSpec(int fanoutsize, const std::vector<int>& tpcse
     for (int tpcchannel = 0; tpcchannel < tpcsubchannels->size(); ++tpcchannel) {
       auto& sectors = tpcsectormessages->operator[](tpcchannel);
       if (counter < sectors.size()) {
-        auto sector = sectors[counter];
-        // send the sectorassign as header with the collision context data
-        o2::TPC::TPCSectorHeader header{ sector };
+        const auto& chunk = sectors[counter];
+        // send the sectorassign as header with the collision context data (of the chunk)
+        o2::TPC::TPCSectorHeader header{ chunk.sector };
         header.activeSectors = activeSectors;
+        header.flags = (chunk.chunk > 0 ? o2::TPC::TPCSectorHeader::ChunkContinued : 0) |
+                       (chunk.chunk + 1 < chunk.nchunks ? o2::TPC::TPCSectorHeader::ChunkHasMore : 0);
         pc.outputs().snapshot(
           OutputRef{ "collisioncontext", static_cast<SubSpecificationType>(tpcchannel), { header } },
-          context);
+          (chunk.sector >= 0 && tpcchunkcontexts->size()) ? tpcchunkcontexts->operator[](chunk.chunk) : context);
       }
     }
 
@@ -126,13 +170,13 @@ DataProcessorSpec getSimReaderSpec(int fanoutsize, const std::vector<int>& tpcse
         context);
     }
     counter++;
-    if (tpcinvocations == 0 || counter == tpcinvocations) {
+    if (*tpcinvocations == 0 || counter == *tpcinvocations) {
       finished = true;
     }
   };
 
   // init function return a lambda taking a ProcessingContext
-  auto initIt = [doit](InitContext& ctx) {
+  auto initIt = [doit, setupTPCChunks](InitContext& ctx) {
     // initialize fundamental objects
     auto& mgr = steer::HitProcessingManager::instance();
     mgr.addInputFile(ctx.options().get<std::string>("simFile").c_str());
@@ -160,6 +204,7 @@ DataProcessorSpec getSimReaderSpec(int fanoutsize, const std::vector<int>& tpcse
       LOG(INFO) << "Serializing Context for later reuse";
       mgr.writeRunContext(ctx.options().get<std::string>("outcontext").c_str());
     }
+    setupTPCChunks(mgr.getRunContext(), ctx.options().get<int>("tpc-chunk-collisions"));
 
     return doit;
   };
@@ -182,6 +227,7 @@ DataProcessorSpec getSimReaderSpec(int fanoutsize, const std::vector<int>& tpcse
       { "simFileQED", VariantType::String, "", { "Sim (QED) input filename" } },
       { "outcontext", VariantType::String, "collisioncontext.root", { "Output file for collision context" } },
       { "incontext", VariantType::String, "", { "Take collision context from this file" } },
+      { "tpc-chunk-collisions", VariantType::Int, 0, { "Send the collisions to the TPC digitizers in chunks of this size, 0 for no chunking" } },
       { "ncollisions,n",
         VariantType::Int,
         0,
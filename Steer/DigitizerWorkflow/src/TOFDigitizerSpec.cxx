@@ -15,11 +15,15 @@
 #include "Framework/Lifetime.h"
 #include "Headers/DataHeader.h"
 #include "TStopwatch.h"
+#include "TRandom.h"
 #include "Steer/HitProcessingManager.h" // for RunContext
+#include "HitReader.h"
 #include "TChain.h"
 #include "DetectorsBase/GeometryManager.h"
 
 #include "TOFSimulation/Digitizer.h"
+#include "CommonUtils/RngHelper.h"
+#include "DetectorsCommonDataFormats/DetID.h"
 #include "DataFormatsParameters/GRPObject.h"
 #include <SimulationDataFormat/MCCompLabel.h>
 #include <SimulationDataFormat/MCTruthContainer.h>
@@ -32,23 +36,6 @@ namespace o2
 namespace tof
 {
 
-// helper function which will be offered as a service
-template <typename T>
-void retrieveHits(std::vector<TChain*> const& chains,
-                  const char* brname,
-                  int sourceID,
-                  int entryID,
-                  std::vector<T>* hits)
-{
-  auto br = chains[sourceID]->GetBranch(brname);
-  if (!br) {
-    LOG(ERROR) << "No branch found";
-    return;
-  }
-  br->SetAddress(&hits);
-  br->GetEntry(entryID);
-}
-
 DataProcessorSpec getTOFDigitizerSpec(int channel)
 {
   // setup of some data structures shared between init and processing functions
@@ -63,9 +50,11 @@ DataProcessorSpec getTOFDigitizerSpec(int channel)
   auto digits = std::make_shared<std::vector<o2::tof::Digit>>();
   auto digitsAccum = std::make_shared<std::vector<o2::tof::Digit>>(); // accumulator for all digits
   auto labels = std::make_shared<o2::dataformats::MCTruthContainer<o2::MCCompLabel>>();
+  // seed of the random streams of the events
+  auto seed = std::make_shared<uint64_t>(0);
 
   // the actual processing function which get called whenever new data is incoming
-  auto process = [simChains, digitizer, digits, digitsAccum, labels, channel](ProcessingContext& pc) {
+  auto process = [simChains, digitizer, digits, digitsAccum, labels, seed, channel](ProcessingContext& pc) {
     static bool finished = false;
     if (finished) {
       return;
@@ -88,10 +77,11 @@ DataProcessorSpec getTOFDigitizerSpec(int channel)
 
     LOG(INFO) << " CALLING TOF DIGITIZATION ";
 
-    static std::vector<o2::tof::HitType> hits;
+    o2::steer::HitReader<o2::tof::HitType> hitReader(*simChains.get(), { "TOFHit" });
     o2::dataformats::MCTruthContainer<o2::MCCompLabel> labelAccum;
 
     auto& eventParts = context->getEventParts();
+    hitReader.setEventParts(eventParts);
     // loop over all composite collisions given from context
     // (aka loop over all the interaction records)
     for (int collID = 0; collID < timesview.size(); ++collID) {
@@ -102,10 +92,12 @@ DataProcessorSpec getTOFDigitizerSpec(int channel)
       for (auto& part : eventParts[collID]) {
         digitizer->setEventID(part.entryID);
         digitizer->setSrcID(part.sourceID);
+        // the numbers of an event do not depend on the events digitized before
+        digitizer->setRandomStream(o2::utils::RngHelper::getStream(*seed, part.entryID, part.sourceID, o2::detectors::DetID::TOF));
 
         // get the hits for this event and this source
-        hits.clear();
-        retrieveHits(*simChains.get(), "TOFHit", part.sourceID, part.entryID, &hits);
+        auto partHits = hitReader.getHits(part.sourceID, part.entryID);
+        const auto& hits = (*partHits)[0];
 
         LOG(INFO) << "For collision " << collID << " eventID " << part.entryID << " found " << hits.size() << " hits ";
 
@@ -133,10 +125,12 @@ DataProcessorSpec getTOFDigitizerSpec(int channel)
     // to be replace once we will be able to write the vector of vectors as different TTree entries
     std::vector<std::vector<Digit>>* digitsVectOfVect = digitizer->getDigitPerTimeFrame();
     std::vector<o2::dataformats::MCTruthContainer<o2::MCCompLabel>>* mcLabVecOfVec = digitizer->getMCTruthPerTimeFrame();
+    std::vector<o2::dataformats::MCTruthContainer<o2::MCCompLabel> const*> labelParts;
     for (Int_t i = 0; i < digitsVectOfVect->size(); i++) {
       std::copy(digitsVectOfVect->at(i).begin(), digitsVectOfVect->at(i).end(), std::back_inserter(*digitsAccum.get()));
-      labelAccum.mergeAtBack(mcLabVecOfVec->at(i));
+      labelParts.push_back(&mcLabVecOfVec->at(i));
     }
+    labelAccum.mergeAll(labelParts);
 
     LOG(INFO) << "Have " << labelAccum.getNElements() << " TOF labels ";
     // here we have all digits and we can send them to consumer (aka snapshot it onto output)
@@ -154,7 +148,7 @@ DataProcessorSpec getTOFDigitizerSpec(int channel)
   };
 
   // init function returning the lambda taking a ProcessingContext
-  auto initIt = [simChains, process, digitizer, labels](InitContext& ctx) {
+  auto initIt = [simChains, process, digitizer, labels, seed](InitContext& ctx) {
     // setup the input chain for the hits
     simChains->emplace_back(new TChain("o2sim"));
 
@@ -175,6 +169,10 @@ DataProcessorSpec getTOFDigitizerSpec(int channel)
 
     // init digitizer
     digitizer->init();
+    *seed = ctx.options().get<int>("seed");
+    if (*seed == 0) {
+      *seed = gRandom->Integer(kMaxUInt);
+    }
     const bool isContinuous = ctx.options().get<int>("pileup");
     LOG(INFO) << "CONTINUOUS " << isContinuous;
     digitizer->setContinuous(isContinuous);
@@ -198,7 +196,8 @@ DataProcessorSpec getTOFDigitizerSpec(int channel)
     AlgorithmSpec{ initIt },
     Options{ { "simFile", VariantType::String, "o2sim.root", { "Sim (background) input filename" } },
              { "simFileS", VariantType::String, "", { "Sim (signal) input filename" } },
-             { "pileup", VariantType::Int, 1, { "whether to run in continuous time mode" } } }
+             { "pileup", VariantType::Int, 1, { "whether to run in continuous time mode" } },
+             { "seed", VariantType::Int, 0, { "seed of the random numbers of the events, 0 to take it from gRandom" } } }
     // I can't use VariantType::Bool as it seems to have a problem
   };
 }
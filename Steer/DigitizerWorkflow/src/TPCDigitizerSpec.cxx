@@ -16,6 +16,7 @@
 #include "Headers/DataHeader.h"
 #include "TStopwatch.h"
 #include "Steer/HitProcessingManager.h" // for RunContext
+#include "HitReader.h"
 #include "TChain.h"
 #include <SimulationDataFormat/MCCompLabel.h>
 #include <SimulationDataFormat/MCTruthContainer.h>
@@ -34,23 +35,6 @@ using namespace o2::framework;
 using SubSpecificationType = o2::framework::DataAllocator::SubSpecificationType;
 using DigiGroupRef = o2::dataformats::RangeReference<int, int>;
 
-// helper function which will be offered as a service
-template <typename T>
-void retrieveHits(std::vector<TChain*> const& chains,
-                  const char* brname,
-                  int sourceID,
-                  int entryID,
-                  std::vector<T>* hits)
-{
-  auto br = chains[sourceID]->GetBranch(brname);
-  if (!br) {
-    LOG(ERROR) << "TPC: No branch found";
-    return;
-  }
-  br->SetAddress(&hits);
-  br->GetEntry(entryID);
-}
-
 namespace o2
 {
 namespace TPC
@@ -129,7 +113,13 @@ class TPCDPLDigitizerTask
 
       mDigitizer.enableSCDistortions(distortionType, hisSCDensity.get(), gridSize[0], gridSize[1], gridSize[2]);
     }
+    auto distortionTable = ic.options().get<std::string>("distortionTable");
+    if (!distortionTable.empty()) {
+      LOG(INFO) << "TPC: Using precomputed space-charge distortions from " << distortionTable << FairLogger::endl;
+      mDigitizer.setSCDistortionLookupTable(o2::TPC::DistortionLookupTable::readFromFile(distortionTable));
+    }
     mDigitizer.setContinuousReadout(!triggeredMode);
+    mDigitizer.setUseBatchedTransport(ic.options().get<bool>("TPCbatchedTransport"));
 
     // setup the input chain for the hits
     mSimChains.emplace_back(new TChain("o2sim"));
@@ -187,28 +177,36 @@ class TPCDPLDigitizerTask
     // the active sectors need to be propagated
     uint64_t activeSectors = 0;
     activeSectors = sectorHeader->activeSectors;
+    // the collisions of a sector may come in several chunks, the digitizer then continues with the
+    // same sector and sends out the digits of the completed time bins for each chunk
+    const uint16_t chunkFlags = sectorHeader->flags;
+    const bool continuedChunk = chunkFlags & TPCSectorHeader::ChunkContinued;
+    const bool lastChunk = !(chunkFlags & TPCSectorHeader::ChunkHasMore);
 
     // lambda that snapshots digits to be sent out; prepares and attaches header with sector information
-    auto snapshotDigits = [this, sector, &pc, activeSectors](std::vector<o2::TPC::Digit> const& digits) {
+    auto snapshotDigits = [this, sector, &pc, activeSectors, chunkFlags](std::vector<o2::TPC::Digit> const& digits) {
       o2::TPC::TPCSectorHeader header{ sector };
       header.activeSectors = activeSectors;
+      header.flags = chunkFlags;
       // note that snapshoting only works with non-const references (to be fixed?)
       pc.outputs().snapshot(Output{ "TPC", "DIGITS", static_cast<SubSpecificationType>(mChannel), Lifetime::Timeframe,
                                     header },
                             const_cast<std::vector<o2::TPC::Digit>&>(digits));
     };
     // lambda that snapshots labels to be sent out; prepares and attaches header with sector information
-    auto snapshotLabels = [this, &sector, &pc, activeSectors](o2::dataformats::MCTruthContainer<o2::MCCompLabel> const& labels) {
+    auto snapshotLabels = [this, &sector, &pc, activeSectors, chunkFlags](o2::dataformats::MCTruthContainer<o2::MCCompLabel> const& labels) {
       o2::TPC::TPCSectorHeader header{ sector };
       header.activeSectors = activeSectors;
+      header.flags = chunkFlags;
       pc.outputs().snapshot(Output{ "TPC", "DIGITSMCTR", static_cast<SubSpecificationType>(mChannel),
                                     Lifetime::Timeframe, header },
                             const_cast<o2::dataformats::MCTruthContainer<o2::MCCompLabel>&>(labels));
     };
     // lambda that snapshots digits grouping (triggers) to be sent out; prepares and attaches header with sector information
-    auto snapshotEvents = [this, sector, &pc, activeSectors](const std::vector<DigiGroupRef>& events) {
+    auto snapshotEvents = [this, sector, &pc, activeSectors, chunkFlags](const std::vector<DigiGroupRef>& events) {
       o2::TPC::TPCSectorHeader header{ sector };
       header.activeSectors = activeSectors;
+      header.flags = chunkFlags;
       LOG(INFO) << "TPC: Send TRIGGERS for sector " << sector << " channel " << mChannel << " | size " << events.size();
       pc.outputs().snapshot(Output{ "TPC", "DIGTRIGGERS", static_cast<SubSpecificationType>(mChannel), Lifetime::Timeframe,
                                     header },
@@ -237,10 +235,14 @@ class TPCDPLDigitizerTask
       return;
     }
 
-    mDigitizer.setSector(sector);
-    mDigitizer.init();
+    if (!continuedChunk) {
+      mDigitizer.setSector(sector);
+      mDigitizer.init();
+    }
 
     auto& eventParts = context->getEventParts();
+    o2::steer::HitReader<o2::TPC::HitGroup> hitReader(mSimChains, { getBranchNameLeft(sector), getBranchNameRight(sector) });
+    hitReader.setEventParts(eventParts);
 
     auto flushDigitsAndLabels = [this, &digitsAccum, &labelAccum](bool finalFlush = false) {
       // flush previous buffer
@@ -253,7 +255,9 @@ class TPCDPLDigitizerTask
     };
 
     static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
-    mDigitizer.setStartTime(sampaProcessing.getTimeBinFromTime(irecords[0].timeNS / 1000.f));
+    if (!continuedChunk) {
+      mDigitizer.setStartTime(sampaProcessing.getTimeBinFromTime(irecords[0].timeNS / 1000.f));
+    }
 
     TStopwatch timer;
     timer.Start();
@@ -276,10 +280,9 @@ class TPCDPLDigitizerTask
         const int sourceID = part.sourceID;
 
         // get the hits for this event and this source
-        std::vector<o2::TPC::HitGroup> hitsLeft;
-        std::vector<o2::TPC::HitGroup> hitsRight;
-        retrieveHits(mSimChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
-        retrieveHits(mSimChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
+        auto partHits = hitReader.getHits(part.sourceID, part.entryID);
+        const auto& hitsLeft = (*partHits)[0];
+        const auto& hitsRight = (*partHits)[1];
         LOG(DEBUG) << "TPC: Found " << hitsLeft.size() << " hit groups left and " << hitsRight.size() << " hit groups right in collision " << collID << " eventID " << part.entryID;
 
         mDigitizer.process(hitsLeft, eventID, sourceID);
@@ -295,8 +298,10 @@ class TPCDPLDigitizerTask
 
     // final flushing step; getting everything not yet written out
     if (isContinuous) {
-      LOG(INFO) << "TPC: Final flush";
-      flushDigitsAndLabels(true);
+      if (lastChunk) {
+        LOG(INFO) << "TPC: Final flush";
+        flushDigitsAndLabels(true);
+      }
       eventAccum.emplace_back(0, digitsAccum.size()); // all digits are grouped to 1 super-event pseudo-triggered mode
     }
 
@@ -347,7 +352,9 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP)
              { "distortionType", VariantType::Int, 0, { "Distortion type to be used. 0 = no distortions (default), 1 = realistic distortions (not implemented yet), 2 = constant distortions" } },
              { "gridSize", VariantType::String, "33,180,33", { "Comma separated list of number of bins in z, phi and r for distortion lookup tables (z and r can only be 2**N + 1, N=1,2,3,...)" } },
              { "initialSpaceChargeDensity", VariantType::String, "", { "Path to root file containing TH3 with initial space-charge density and name of the TH3 (comma separated)" } },
-             { "TPCtriggered", VariantType::Bool, false, { "Impose triggered RO mode (default: continuous)" } } }
+             { "distortionTable", VariantType::String, "", { "Binary file with a precomputed space-charge distortion lookup table (constant distortions)" } },
+             { "TPCtriggered", VariantType::Bool, false, { "Impose triggered RO mode (default: continuous)" } },
+             { "TPCbatchedTransport", VariantType::Bool, false, { "Drift and amplify the electrons of each hit in SIMD batches" } } }
   };
 }
 
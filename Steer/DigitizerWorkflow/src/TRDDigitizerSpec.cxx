@@ -73,6 +73,7 @@ class TRDDPLDigitizerTask
     if (!gGeoManager) {
       o2::base::GeometryManager::loadGeometry();
     }
+    mDigitizer.setNThreads(ic.options().get<int>("nThreads"));
   }
 
   void run(framework::ProcessingContext& pc)
@@ -148,7 +149,8 @@ o2::framework::DataProcessorSpec getTRDDigitizerSpec(int channel)
     AlgorithmSpec{ adaptFromTask<TRDDPLDigitizerTask>() },
 
     Options{ { "simFile", VariantType::String, "o2sim.root", { "Sim (background) input filename" } },
-             { "simFileS", VariantType::String, "", { "Sim (signal) input filename" } } }
+             { "simFileS", VariantType::String, "", { "Sim (signal) input filename" } },
+             { "nThreads", VariantType::Int, 1, { "number of threads digitizing the chambers" } } }
   };
 }
 
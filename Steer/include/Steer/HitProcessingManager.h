@@ -99,9 +99,11 @@ inline void HitProcessingManager::sampleCollisionTimes()
 
 inline void HitProcessingManager::sampleCollisionConstituents()
 {
-  auto getBackgroundRoundRobin = [this]() {
-    static int bgcounter = 0;
-    int numbg = mSimChains[0]->GetEntries();
+  // the entries are assigned round robin from the start of each chain, such that the same
+  // context is obtained for the same input in any process and for any number of calls
+  int bgcounter = 0;
+  const int numbg = mSimChains[0]->GetEntries();
+  auto getBackgroundRoundRobin = [&bgcounter, numbg]() {
     if (bgcounter == numbg) {
       bgcounter = 0;
     }
@@ -109,16 +111,18 @@ inline void HitProcessingManager::sampleCollisionConstituents()
   };
 
   const int nsignalids = mSimChains.size() - 1;
-  auto getSignalRoundRobin = [this, nsignalids]() {
-    static int bgcounter = 0;
-    static int signalid = 0;
-    static std::vector<int> counter(nsignalids, 0);
+  int signalid = 0;
+  std::vector<int> counter(nsignalids, 0);
+  std::vector<int> numentries(nsignalids, 0);
+  for (int i = 0; i < nsignalids; ++i) {
+    numentries[i] = mSimChains[i + 1]->GetEntries();
+  }
+  auto getSignalRoundRobin = [&signalid, &counter, &numentries, nsignalids]() {
     if (signalid == nsignalids) {
       signalid = 0;
     }
     const auto realsourceid = signalid + 1;
-    int numentries = mSimChains[realsourceid]->GetEntries();
-    if (counter[signalid] == numentries) {
+    if (counter[signalid] == numentries[signalid]) {
       counter[signalid] = 0;
     }
     EventPart e(realsourceid, counter[signalid]);
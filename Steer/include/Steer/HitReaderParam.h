@@ -0,0 +1,32 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_STEER_HITREADERPARAM_H_
+#define O2_STEER_HITREADERPARAM_H_
+
+#include "SimConfig/ConfigurableParam.h"
+#include "SimConfig/ConfigurableParamHelper.h"
+
+namespace o2
+{
+namespace steer
+{
+// parameters of the reading of the hits by the digitizers
+struct HitReaderParam : public o2::conf::ConfigurableParamHelper<HitReaderParam> {
+  bool readAhead = true;    // read the hits of the next event part on a background thread
+  int treeCacheSizeMB = 32; // size of the TTreeCache of each simulation chain (0 leaves the cache unchanged)
+  int hitCacheSizeMB = 512; // memory budget of the hits kept for reuse, shared by all the readers of a process
+
+  O2ParamDef(HitReaderParam, "HitReader");
+};
+} // namespace steer
+} // namespace o2
+
+#endif /* O2_STEER_HITREADERPARAM_H_ */
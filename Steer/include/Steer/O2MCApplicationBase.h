@@ -22,9 +22,22 @@
 #include "Rtypes.h" // for Int_t, Bool_t, Double_t, etc
 #include <TVirtualMC.h>
 #include "SimConfig/SimCutParams.h"
+#include "DetectorsBase/ShowerLibrary.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FairVolume;
+class FairDetector;
 
 namespace o2
 {
+namespace base
+{
+class Detector;
+}
 namespace steer
 {
 
@@ -59,6 +72,114 @@ class O2MCApplicationBase : public FairMCApplication
   std::map<int, std::string> mSensitiveVolumes{}; // collection of all sensitive volumes with
                                                   // keeping track of volumeIds and volume names
 
+  /// a copy of a sensitive volume and the detector processing its steps
+  struct SensitiveVolume {
+    int copyNo;
+    FairVolume* volume;
+    FairDetector* detector;
+    int detectorIndex; // index in mDetectorStepStats
+  };
+
+  /// number of steps and time spent in the hit processing of a detector
+  struct DetectorStepStats {
+    std::string name;
+    unsigned long long nSteps = 0;
+    double time = 0.; // in s
+  };
+
+  // dispatch table of the steps, built at InitGeometry from the FairRoot volume map:
+  // the copies of the sensitive volume with ID id are the entries
+  // mVolumeOffsets[id] to mVolumeOffsets[id + 1] - 1 of mSensitiveVolumeCopies
+  std::vector<int> mVolumeOffsets;                     //!
+  std::vector<SensitiveVolume> mSensitiveVolumeCopies; //!
+  std::vector<DetectorStepStats> mDetectorStepStats;   //!
+  bool mUseDispatchTable = false; //! false if the FairRoot stepping is needed (trajectories, radiation maps)
+
+  /// build the dispatch table of the steps
+  void initDispatchTable();
+
+  /// a region (volume or module) in which the tracks are stopped below a kinetic energy threshold
+  struct KillRegion {
+    std::string name;
+    double ekinThreshold;            // in GeV
+    unsigned long long nKilled = 0;  // number of tracks stopped in the current event
+  };
+  std::vector<KillRegion> mKillRegions; //!
+  std::vector<int> mVolumeKillRegion;   //! index of the kill region of each volume ID, -1 if none
+
+  /// build the kill regions from SimCutParams
+  void initKillRegions();
+
+  /// step profile: particle types in which the steps are counted
+  enum ProfileParticle : int {
+    kProfileGamma,
+    kProfileElectron,
+    kProfileMuon,
+    kProfilePion,
+    kProfileKaon,
+    kProfileProton,
+    kProfileNeutron,
+    kProfileIon,
+    kProfileOther,
+    kNProfileParticles
+  };
+  /// step profile of a (volume, particle type)
+  struct StepProfileCell {
+    unsigned long long nSteps = 0;
+    unsigned long long nSecondaries = 0;
+    unsigned long long nTimed = 0; // number of steps whose transport was timed
+    double time = 0.;              // transport time of the timed steps, in s
+  };
+  // the cell of volume ID id and particle type t is mStepProfile[id * kNProfileParticles + t],
+  // the last row collects the steps outside of the known volumes
+  std::vector<StepProfileCell> mStepProfile;               //!
+  int mStepProfileRows = 0;                                //!
+  bool mStepProfileTiming = false;                         //! a sampled step is being timed
+  std::chrono::steady_clock::time_point mStepProfileStart; //!
+
+  /// set up the step profile from SimCutParams
+  void initStepProfile();
+  /// account the current step in the profile, sampling the timing of 1 in @a sampling steps
+  void profileStep(int sampling);
+  /// write the profile table of the run so far
+  void writeStepProfile() const;
+  static int profileParticle(int pdg);
+  static const char* profileParticleName(int type);
+
+  /// fast simulation with shower libraries: the library (or recording) of a detector
+  struct ShowerLibrarySlot {
+    o2::base::Detector* detector = nullptr;
+    std::unique_ptr<o2::base::ShowerLibrary> library;
+    std::string filename;
+    bool record = false;            // recording the showers to the library
+    unsigned long long nShowers = 0; // number of library showers deposited (recorded) in the current event
+  };
+  /// a shower being recorded
+  struct ShowerRecording {
+    int slot;
+    double entry[3];
+    double dir[3];
+    double energy;
+    double time;
+    float angle;
+    float position;
+    o2::base::ShowerLibrary::Shower spots;
+  };
+  std::vector<ShowerLibrarySlot> mShowerLibraries;  //!
+  std::vector<int> mVolumeShowerLibrary;            //! index of the library triggered by each volume ID, -1 if none
+  std::vector<int> mVolumeShowerRecording;          //! index of the recording slot of each volume ID of its detector, -1 if none
+  std::vector<ShowerRecording> mShowerRecordings;   //! showers recorded in the current event
+  std::unordered_map<int, int> mTrackShowerRecording; //! recorded shower of the tracks of the event
+  int mCurrentShowerRecording = -1;                  //! recorded shower of the current track, -1 if none
+
+  /// set up the shower libraries from SimCutParams
+  void initShowerLibraries();
+  /// replace the current track, an eligible track entering a library volume, by a library shower (true)
+  /// or start recording its shower
+  bool processShowerLibraryEntrance(int slot);
+  /// add the recorded showers of the event to their library
+  void finishShowerRecordings();
+
   /// some common parts of finishEvent
   void finishEventCommon();
 
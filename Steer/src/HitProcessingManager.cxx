@@ -111,6 +111,7 @@ bool HitProcessingManager::setupRunFromExistingContext(const char* filename)
   if (incontext) {
     incontext->printCollisionSummary();
     mRunContext = *incontext;
+    delete incontext;
     return true;
   }
   LOG(INFO) << "NO COLLISIONOBJECT FOUND";
@@ -25,7 +25,14 @@
 #include <SimulationDataFormat/MCEventHeader.h>
 #include <TGeoManager.h>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
 #include <FairVolume.h>
+#include <FairDetector.h>
+#include <TRandom.h>
+#include <TVirtualMCStack.h>
+#include <cmath>
+#include <unistd.h>
 
 namespace o2
 {
@@ -49,24 +56,88 @@ void TypedVectorAttach(const char* name, FairMQChannel& channel, FairMQParts& pa
 void O2MCApplicationBase::Stepping()
 {
   mStepCounter++;
-  if (mCutParams.stepFiltering) {
+  auto& cuts = o2::conf::ParamSnapshot<o2::conf::SimCutValues>::get();
+  if (cuts.stepProfiling > 0) {
+    profileStep(cuts.stepProfiling);
+  }
+  if (cuts.stepFiltering) {
     // we can kill tracks here based on our
     // custom detector specificities
 
     float x, y, z;
     fMC->TrackPosition(x, y, z);
 
-    if (z > mCutParams.ZmaxA) {
+    if (z > cuts.ZmaxA) {
       fMC->StopTrack();
       return;
     }
-    if (-z > mCutParams.ZmaxC) {
+    if (-z > cuts.ZmaxC) {
       fMC->StopTrack();
       return;
     }
   }
 
-  // dispatch first to stepping function in FairRoot
+  int copyNo;
+  const int id = fMC->CurrentVolID(copyNo);
+  if (id >= 0 && id < (int)mVolumeKillRegion.size() && mVolumeKillRegion[id] >= 0) {
+    auto& region = mKillRegions[mVolumeKillRegion[id]];
+    double px, py, pz, e;
+    fMC->TrackMomentum(px, py, pz, e);
+    if (e - fMC->TrackMass() < region.ekinThreshold) {
+      fMC->StopTrack();
+      region.nKilled++;
+      return;
+    }
+  }
+
+  // fast simulation: the library showers replace the eligible tracks entering the library volumes
+  if (id >= 0 && id < (int)mVolumeShowerLibrary.size() && mVolumeShowerLibrary[id] >= 0 && fMC->IsTrackEntering()) {
+    if (processShowerLibraryEntrance(mVolumeShowerLibrary[id])) {
+      return;
+    }
+  }
+  if (mCurrentShowerRecording >= 0 && id >= 0 && id < (int)mVolumeShowerRecording.size()) {
+    auto& recording = mShowerRecordings[mCurrentShowerRecording];
+    const double edep = fMC->Edep();
+    if (mVolumeShowerRecording[id] == recording.slot && edep > 0.) {
+      double x[3];
+      fMC->TrackPosition(x[0], x[1], x[2]);
+      auto spot = o2::base::ShowerLibrary::toSpot(x, recording.entry, recording.dir);
+      spot.time = fMC->TrackTime() * 1.e9 - recording.time;
+      spot.energy = edep / recording.energy;
+      recording.spots.push_back(spot);
+    }
+  }
+
+  if (!mUseDispatchTable) {
+    // dispatch first to stepping function in FairRoot
+    FairMCApplication::Stepping();
+    return;
+  }
+
+  // find the sensitive volume copy (if any) and the detector processing the step
+  if (id < 0 || id + 1 >= (int)mVolumeOffsets.size() || mVolumeOffsets[id] == mVolumeOffsets[id + 1]) {
+    return; // not a sensitive volume
+  }
+  for (int i = mVolumeOffsets[id]; i < mVolumeOffsets[id + 1]; ++i) {
+    auto& sens = mSensitiveVolumeCopies[i];
+    if (sens.copyNo != copyNo) {
+      continue;
+    }
+    if (sens.detector) {
+      if (cuts.stepStatistics) {
+        auto& stats = mDetectorStepStats[sens.detectorIndex];
+        const auto start = std::chrono::steady_clock::now();
+        sens.detector->ProcessHits(sens.volume);
+        stats.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats.nSteps++;
+      } else {
+        sens.detector->ProcessHits(sens.volume);
+      }
+    }
+    return;
+  }
+  // unknown copy of a sensitive volume: FairRoot registers it
   FairMCApplication::Stepping();
 }
 
@@ -74,6 +145,163 @@ void O2MCApplicationBase::PreTrack()
 {
   // dispatch first to function in FairRoot
   FairMCApplication::PreTrack();
+
+  // the time up to the first step of a track is not the one of a step
+  mStepProfileTiming = false;
+
+  // the secondaries of a track whose shower is recorded belong to the same shower
+  mCurrentShowerRecording = -1;
+  if (!mTrackShowerRecording.empty()) {
+    auto stack = fMC->GetStack();
+    const int track = stack->GetCurrentTrackNumber();
+    auto iter = mTrackShowerRecording.find(stack->GetCurrentTrack()->GetMother(0));
+    if (iter != mTrackShowerRecording.end()) {
+      mCurrentShowerRecording = iter->second;
+      mTrackShowerRecording[track] = iter->second;
+    }
+  }
+}
+
+void O2MCApplicationBase::initShowerLibraries()
+{
+  mShowerLibraries.clear();
+  mVolumeShowerLibrary.clear();
+  mVolumeShowerRecording.clear();
+  auto parseEdges = [](std::string const& list) {
+    std::vector<float> edges;
+    std::stringstream values(list);
+    std::string token;
+    while (std::getline(values, token, ',')) {
+      edges.push_back(std::stof(token));
+    }
+    return edges;
+  };
+  auto addSlots = [this](std::string const& list, bool record) {
+    std::stringstream tokens(list);
+    std::string token;
+    while (std::getline(tokens, token, ',')) {
+      if (token.empty()) {
+        continue;
+      }
+      const auto colon = token.find(':');
+      if (colon == std::string::npos) {
+        LOG(FATAL) << "Invalid shower library " << token << " (expecting detector:file)";
+      }
+      ShowerLibrarySlot slot;
+      const auto name = token.substr(0, colon);
+      slot.filename = token.substr(colon + 1);
+      slot.record = record;
+      for (int i = 0; i < fModules->GetEntries(); ++i) {
+        auto det = dynamic_cast<o2::base::Detector*>(fModules->At(i));
+        if (det && name == det->GetName()) {
+          slot.detector = det;
+        }
+      }
+      if (!slot.detector) {
+        LOG(FATAL) << "No detector " << name << " for the shower library " << slot.filename;
+      }
+      mShowerLibraries.push_back(std::move(slot));
+    }
+  };
+  addSlots(mCutParams.showerLibraries, false);
+  addSlots(mCutParams.showerLibraryRecord, true);
+
+  for (int index = 0; index < (int)mShowerLibraries.size(); ++index) {
+    auto& slot = mShowerLibraries[index];
+    if (slot.record) {
+      slot.library = std::make_unique<o2::base::ShowerLibrary>(parseEdges(mCutParams.showerLibraryEnergyBins),
+                                                               parseEdges(mCutParams.showerLibraryAngleBins));
+      // the energy deposits are recorded in the sensitive volumes of the detector
+      for (auto& e : fVolMap) {
+        if (e.second->GetDetector() == slot.detector) {
+          if (e.first >= (int)mVolumeShowerRecording.size()) {
+            mVolumeShowerRecording.resize(e.first + 1, -1);
+          }
+          mVolumeShowerRecording[e.first] = index;
+        }
+      }
+    } else {
+      slot.library.reset(o2::base::ShowerLibrary::loadFromFile(slot.filename));
+      if (!slot.library) {
+        LOG(FATAL) << "Cannot load the shower library of " << slot.detector->GetName() << " from " << slot.filename;
+      }
+    }
+    for (auto& volname : slot.detector->getShowerLibraryVolumes()) {
+      auto vol = gGeoManager->GetVolume(volname.c_str());
+      if (!vol) {
+        LOG(FATAL) << "No volume " << volname << " for the shower library of " << slot.detector->GetName();
+      }
+      const int id = vol->GetNumber();
+      if (id >= (int)mVolumeShowerLibrary.size()) {
+        mVolumeShowerLibrary.resize(id + 1, -1);
+      }
+      mVolumeShowerLibrary[id] = index;
+    }
+    LOG(INFO) << (slot.record ? "Recording" : "Using") << " the shower library " << slot.filename << " of "
+              << slot.detector->GetName() << " (" << slot.library->getNShowers() << " showers) above "
+              << mCutParams.showerLibraryEmin << " GeV";
+  }
+}
+
+bool O2MCApplicationBase::processShowerLibraryEntrance(int index)
+{
+  auto& slot = mShowerLibraries[index];
+  const int pdg = fMC->TrackPid();
+  if (pdg != 22 && std::abs(pdg) != 11) {
+    return false;
+  }
+  double p[3], energy;
+  fMC->TrackMomentum(p[0], p[1], p[2], energy);
+  const double ptot = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+  if (energy < mCutParams.showerLibraryEmin || ptot <= 0.) {
+    return false;
+  }
+  double entry[3], dir[3] = { p[0] / ptot, p[1] / ptot, p[2] / ptot };
+  fMC->TrackPosition(entry[0], entry[1], entry[2]);
+  float angle, position;
+  slot.detector->getShowerLibraryCoordinates(dir, angle, position);
+  const double time = fMC->TrackTime() * 1.e9; // in ns
+
+  if (slot.record) {
+    // a track of a shower being recorded (re-entering, or a secondary) is part of this shower
+    if (mCurrentShowerRecording >= 0 || slot.library->getBin(energy, angle, position) < 0) {
+      return false;
+    }
+    mCurrentShowerRecording = mShowerRecordings.size();
+    mShowerRecordings.push_back({ index, { entry[0], entry[1], entry[2] }, { dir[0], dir[1], dir[2] }, energy, time, angle, position, {} });
+    mTrackShowerRecording[fMC->GetStack()->GetCurrentTrackNumber()] = mCurrentShowerRecording;
+    return false;
+  }
+
+  auto shower = slot.library->getShower(energy, angle, position, gRandom->Rndm());
+  if (!shower) {
+    return false; // outside the library, simulated in full
+  }
+  slot.detector->depositLibraryShower(*shower, entry, dir, energy, time);
+  fMC->StopTrack();
+  slot.nShowers++;
+  return true;
+}
+
+void O2MCApplicationBase::finishShowerRecordings()
+{
+  if (mShowerRecordings.empty()) {
+    return;
+  }
+  for (auto& recording : mShowerRecordings) {
+    auto& slot = mShowerLibraries[recording.slot];
+    slot.library->addShower(recording.energy, recording.angle, recording.position, std::move(recording.spots));
+    slot.nShowers++;
+  }
+  mShowerRecordings.clear();
+  mTrackShowerRecording.clear();
+  mCurrentShowerRecording = -1;
+  // the library is rewritten after each event, such that it is complete whenever the run stops
+  for (auto& slot : mShowerLibraries) {
+    if (slot.record) {
+      slot.library->writeToFile(slot.filename);
+    }
+  }
 }
 
 void O2MCApplicationBase::ConstructGeometry()
@@ -112,11 +340,235 @@ void O2MCApplicationBase::InitGeometry()
   for (auto e : mSensitiveVolumes) {
     sensvolfile << e.first << ":" << e.second << "\n";
   }
+  initDispatchTable();
+  initKillRegions();
+  initShowerLibraries();
+  initStepProfile();
+}
+
+void O2MCApplicationBase::initStepProfile()
+{
+  mStepProfile.clear();
+  mStepProfileRows = 0;
+  mStepProfileTiming = false;
+  if (mCutParams.stepProfiling <= 0) {
+    return;
+  }
+  // volume IDs are the volume numbers, plus one row for the unknown ones
+  mStepProfileRows = gGeoManager->GetListOfVolumes()->GetEntries() + 1;
+  mStepProfile.resize(mStepProfileRows * kNProfileParticles);
+  LOG(INFO) << "Profiling the steps in " << mStepProfileRows - 1 << " volumes, timing 1 in "
+            << mCutParams.stepProfiling << " steps";
+}
+
+int O2MCApplicationBase::profileParticle(int pdg)
+{
+  switch (std::abs(pdg)) {
+    case 22:
+      return kProfileGamma;
+    case 11:
+      return kProfileElectron;
+    case 13:
+      return kProfileMuon;
+    case 211:
+      return kProfilePion;
+    case 321:
+      return kProfileKaon;
+    case 2212:
+      return kProfileProton;
+    case 2112:
+      return kProfileNeutron;
+    default:
+      return std::abs(pdg) > 1000000000 ? kProfileIon : kProfileOther;
+  }
+}
+
+const char* O2MCApplicationBase::profileParticleName(int type)
+{
+  static const char* names[kNProfileParticles] = { "gamma", "e", "mu", "pi", "K", "p", "n", "ion", "other" };
+  return names[type];
+}
+
+void O2MCApplicationBase::profileStep(int sampling)
+{
+  if (mStepProfile.empty()) {
+    return;
+  }
+  int copyNo;
+  int id = fMC->CurrentVolID(copyNo);
+  if (id < 0 || id >= mStepProfileRows - 1) {
+    id = mStepProfileRows - 1;
+  }
+  auto& cell = mStepProfile[id * kNProfileParticles + profileParticle(fMC->TrackPid())];
+  cell.nSteps++;
+  cell.nSecondaries += fMC->NSecondaries();
+  // the time since the previous (sampled) step is the one to transport this step
+  if (mStepProfileTiming) {
+    cell.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - mStepProfileStart).count();
+    cell.nTimed++;
+    mStepProfileTiming = false;
+  }
+  if (mStepCounter % sampling == 0) {
+    mStepProfileTiming = true;
+    mStepProfileStart = std::chrono::steady_clock::now();
+  }
+}
+
+void O2MCApplicationBase::writeStepProfile() const
+{
+  struct Row {
+    int id;
+    int type;
+    double time; // estimated from the timed steps
+  };
+  std::vector<Row> rows;
+  double totalTime = 0.;
+  for (int id = 0; id < mStepProfileRows; ++id) {
+    for (int type = 0; type < kNProfileParticles; ++type) {
+      auto& cell = mStepProfile[id * kNProfileParticles + type];
+      if (cell.nSteps == 0) {
+        continue;
+      }
+      const double time = cell.nTimed ? cell.time / cell.nTimed * cell.nSteps : 0.;
+      rows.push_back({ id, type, time });
+      totalTime += time;
+    }
+  }
+  std::sort(rows.begin(), rows.end(), [](Row const& a, Row const& b) { return a.time > b.time; });
+
+  const auto filename = mCutParams.stepProfileFile + "_" + std::to_string(getpid()) + ".dat";
+  std::ofstream out(filename);
+  out << "# module volume particle steps secondaries timed_steps time_per_step[us] estimated_time[s] fraction\n";
+  for (auto& row : rows) {
+    auto& cell = mStepProfile[row.id * kNProfileParticles + row.type];
+    std::string volume = "unknown";
+    std::string module = "unknown";
+    if (row.id < mStepProfileRows - 1) {
+      volume = gGeoManager->GetVolume(row.id)->GetName();
+      auto iter = fModVolMap.find(row.id);
+      if (iter != fModVolMap.end()) {
+        auto name = mModIdToName.find(iter->second);
+        if (name != mModIdToName.end()) {
+          module = name->second;
+        }
+      }
+    }
+    out << module << " " << volume << " " << profileParticleName(row.type) << " " << cell.nSteps << " "
+        << cell.nSecondaries << " " << cell.nTimed << " " << (cell.nTimed ? cell.time / cell.nTimed * 1.e6 : 0.) << " "
+        << row.time << " " << (totalTime > 0. ? row.time / totalTime : 0.) << "\n";
+  }
+  LOG(INFO) << "Step profile of " << rows.size() << " (volume, particle) written to " << filename;
+}
+
+void O2MCApplicationBase::initKillRegions()
+{
+  mKillRegions.clear();
+  mVolumeKillRegion.clear();
+  std::stringstream regions(mCutParams.killRegions);
+  std::string token;
+  while (std::getline(regions, token, ',')) {
+    if (token.empty()) {
+      continue;
+    }
+    const auto colon = token.find(':');
+    if (colon == std::string::npos) {
+      LOG(FATAL) << "Invalid kill region " << token << " (expecting name:threshold)";
+    }
+    KillRegion region;
+    region.name = token.substr(0, colon);
+    region.ekinThreshold = std::stod(token.substr(colon + 1));
+    const int index = mKillRegions.size();
+
+    // the name is either the one of a module (all its volumes) or the one of a volume
+    std::vector<int> volumes;
+    for (auto& e : fModVolMap) {
+      if (mModIdToName[e.second] == region.name) {
+        volumes.push_back(e.first);
+      }
+    }
+    if (volumes.empty()) {
+      auto vol = gGeoManager->GetVolume(region.name.c_str());
+      if (!vol) {
+        LOG(FATAL) << "Kill region " << region.name << " is neither a module nor a volume";
+      }
+      volumes.push_back(vol->GetNumber());
+    }
+    for (auto id : volumes) {
+      if (id >= (int)mVolumeKillRegion.size()) {
+        mVolumeKillRegion.resize(id + 1, -1);
+      }
+      mVolumeKillRegion[id] = index;
+    }
+    LOG(INFO) << "Stopping tracks below " << region.ekinThreshold << " GeV in " << region.name << " ("
+              << volumes.size() << " volumes)";
+    mKillRegions.push_back(region);
+  }
+}
+
+void O2MCApplicationBase::initDispatchTable()
+{
+  // the trajectories and radiation maps are recorded in the stepping of FairRoot
+  mUseDispatchTable = !fTrajFilter && !fRadLenMan && !fRadMapMan && !fRadGridMan;
+  if (!mUseDispatchTable) {
+    LOG(INFO) << "Using FairRoot step dispatch";
+    return;
+  }
+
+  int maxid = -1;
+  for (auto& e : fVolMap) {
+    maxid = std::max(maxid, e.first);
+  }
+  mVolumeOffsets.assign(maxid + 2, 0);
+  for (auto& e : fVolMap) {
+    mVolumeOffsets[e.first + 1]++;
+  }
+  for (int id = 0; id <= maxid; ++id) {
+    mVolumeOffsets[id + 1] += mVolumeOffsets[id];
+  }
+
+  // fVolMap being ordered by volume ID, the copies of a volume are contiguous
+  mSensitiveVolumeCopies.clear();
+  mSensitiveVolumeCopies.reserve(fVolMap.size());
+  mDetectorStepStats.clear();
+  std::vector<FairDetector*> detectors;
+  for (auto& e : fVolMap) {
+    auto vol = e.second;
+    auto det = vol->GetDetector();
+    int detindex = std::find(detectors.begin(), detectors.end(), det) - detectors.begin();
+    if (detindex == (int)detectors.size()) {
+      detectors.push_back(det);
+      mDetectorStepStats.emplace_back();
+      mDetectorStepStats.back().name = det ? det->GetName() : "none";
+    }
+    mSensitiveVolumeCopies.push_back({ vol->getMCid(), vol, det, detindex });
+  }
+  LOG(INFO) << "Step dispatch table of " << mSensitiveVolumeCopies.size() << " sensitive volume copies for "
+            << maxid + 1 << " volume IDs";
 }
 
 void O2MCApplicationBase::finishEventCommon()
 {
   LOG(INFO) << "This event/chunk did " << mStepCounter << " steps";
+  if (mCutParams.stepStatistics) {
+    for (auto& stats : mDetectorStepStats) {
+      LOG(INFO) << "STEPS IN " << stats.name << " : " << stats.nSteps << " ; HIT PROCESSING TOOK " << stats.time << "s";
+      stats.nSteps = 0;
+      stats.time = 0.;
+    }
+  }
+  for (auto& region : mKillRegions) {
+    LOG(INFO) << "TRACKS STOPPED IN " << region.name << " : " << region.nKilled;
+    region.nKilled = 0;
+  }
+  finishShowerRecordings();
+  for (auto& slot : mShowerLibraries) {
+    LOG(INFO) << (slot.record ? "SHOWERS RECORDED FOR " : "LIBRARY SHOWERS IN ") << slot.detector->GetName() << " : " << slot.nShowers;
+    slot.nShowers = 0;
+  }
+  // the profile is cumulated over the run, the table is rewritten after every event
+  if (!mStepProfile.empty()) {
+    writeStepProfile();
+  }
 
   auto header = static_cast<o2::dataformats::MCEventHeader*>(fMCEventHeader);
   header->getMCEventStats().setNSteps(mStepCounter);
@@ -16,6 +16,8 @@
 
 #pragma link C++ class o2::steer::InteractionSampler+;
 #pragma link C++ class o2::steer::HitProcessingManager;
+#pragma link C++ class o2::steer::HitReaderParam + ;
+#pragma link C++ class o2::conf::ConfigurableParamHelper < o2::steer::HitReaderParam > +;
 #pragma link C++ class o2::steer::O2RunSim+;
 #pragma link C++ class o2::steer::O2MCApplicationBase+;
 #pragma link C++ class o2::steer::O2MCApplication+;
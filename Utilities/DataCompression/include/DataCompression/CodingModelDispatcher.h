@@ -24,6 +24,7 @@
 #include "runtime_container.h"
 #include <iostream>
 #include <fstream>
+#include <vector>
 #include <boost/type.hpp>
 #include <boost/mpl/for_each.hpp>
 
@@ -145,8 +146,8 @@ class CodingModelDispatcher
   }
 
   /**
-   * TODO: this is tailored to HuffmanCodec for the moment, some generic interface
-   * has to come
+   * functor calling the generic Generate interface of the models, e.g. building
+   * the Huffman tree or the rANS tables
    */
   class generateFctr
   {
@@ -160,7 +161,7 @@ class CodingModelDispatcher
     return_type operator()(boost::type<T>)
     {
       T& stage = static_cast<T&>(mContainer);
-      return (*stage).GenerateHuffmanTree();
+      return (*stage).Generate();
     }
 
    private:
@@ -260,6 +261,79 @@ class CodingModelDispatcher
     return result;
   }
 
+  /// functor to encode a sequence of values into a stream on runtime container level
+  template <typename InputIt>
+  class encodeStreamFctr
+  {
+   public:
+    encodeStreamFctr(InputIt _begin, InputIt _end, std::vector<uint8_t>& _buffer)
+      : begin(_begin), end(_end), buffer(_buffer)
+    {
+    }
+    ~encodeStreamFctr() {}
+
+    using return_type = size_t;
+
+    template <typename T>
+    return_type operator()(T& stage)
+    {
+      return (*stage).EncodeStream(begin, end, buffer);
+    }
+
+   private:
+    InputIt begin;
+    InputIt end;
+    std::vector<uint8_t>& buffer;
+  };
+
+  /**
+   * Encode a sequence of values of one parameter with the model at position
+   *
+   * Models implementing the stream interface, e.g. HuffmanModel and RANSModel,
+   * can be mixed in the definition, each parameter using its own entropy coder.
+   * @return number of bits of the stream
+   */
+  template <typename InputIt>
+  size_t encodeStream(int position, InputIt begin, InputIt end, std::vector<uint8_t>& buffer)
+  {
+    return mContainer.apply(position, encodeStreamFctr<InputIt>(begin, end, buffer));
+  }
+
+  /// functor to decode a stream on runtime container level
+  template <typename OutputIt>
+  class decodeStreamFctr
+  {
+   public:
+    decodeStreamFctr(const uint8_t* _data, size_t _streamLength, OutputIt _out)
+      : data(_data), streamLength(_streamLength), out(_out)
+    {
+    }
+    ~decodeStreamFctr() {}
+
+    using return_type = size_t;
+
+    template <typename T>
+    return_type operator()(T& stage)
+    {
+      return (*stage).DecodeStream(data, streamLength, out);
+    }
+
+   private:
+    const uint8_t* data;
+    size_t streamLength;
+    OutputIt out;
+  };
+
+  /**
+   * Decode a stream written by encodeStream with the model at position
+   * @return number of decoded values
+   */
+  template <typename OutputIt>
+  size_t decodeStream(int position, const uint8_t* data, size_t streamLength, OutputIt out)
+  {
+    return mContainer.apply(position, decodeStreamFctr<OutputIt>(data, streamLength, out));
+  }
+
   class getCodingDirectionFctr
   {
    public:
@@ -24,6 +24,8 @@
 #include <cerrno>
 #include <stdexcept>
 #include <cassert>
+#include <cstddef>
+#include <functional>
 
 namespace o2
 {
@@ -182,6 +184,201 @@ class DataDeflater
   Codec mCodec;
 };
 
+/**
+ * @class BufferDeflater
+ * A deflater packing bit fields into a preallocated buffer of target words
+ *
+ * Word-at-a-time variant of the DataDeflater: the bits are accumulated in a
+ * 64 bit register and the filled target words are stored directly in the
+ * buffer, without a writer callback. The bit order is the same as for the
+ * DataDeflater, the first bits go to the MSBs of each target word.
+ * Bit fields are at most 32 bits wide.
+ */
+template <typename TargetType>
+class BufferDeflater
+{
+ public:
+  using target_type = TargetType;
+  static const std::size_t TargetBitWidth = 8 * sizeof(target_type);
+  static const std::size_t MaxBitLength = 32;
+  static_assert(TargetBitWidth <= 32, "target words of at most 32 bits are supported");
+
+  BufferDeflater(target_type* buffer, std::size_t size) : mBuffer(buffer), mSize(size) {}
+  ~BufferDeflater()
+  {
+    // check if the deflater is properly terminated, or pending data will be lost
+    assert(mFilledBits == 0);
+  }
+
+  /**
+   * Reset deflater
+   * Drop the pending bits and restart at the beginning of the buffer.
+   */
+  int reset()
+  {
+    mPosition = 0;
+    mAccumulator = 0;
+    mFilledBits = 0;
+    return 0;
+  }
+
+  /**
+   * Write number of bits
+   * value contains number of valid LSBs given by bitlength
+   * @return number of written bits
+   */
+  template <typename ValueType>
+  int writeRaw(ValueType value, uint16_t bitlength)
+  {
+    if (bitlength > MaxBitLength || bitlength > 8 * sizeof(ValueType)) {
+      throw std::runtime_error("bit length exceeds width of the data type");
+    }
+    mAccumulator = (mAccumulator << bitlength) | (uint64_t(value) & ((uint64_t(1) << bitlength) - 1));
+    mFilledBits += bitlength;
+    while (mFilledBits >= TargetBitWidth) {
+      if (mPosition >= mSize) {
+        throw std::runtime_error("target buffer exhausted");
+      }
+      mFilledBits -= TargetBitWidth;
+      mBuffer[mPosition++] = target_type(mAccumulator >> mFilledBits);
+    }
+    return bitlength;
+  }
+
+  /**
+   * Write a sequence of values with the same bit length
+   * @return number of written values
+   */
+  template <typename InputIt>
+  std::size_t write(InputIt begin, InputIt end, uint16_t bitlength)
+  {
+    std::size_t nValues = 0;
+    for (; begin != end; ++begin, ++nValues) {
+      writeRaw(*begin, bitlength);
+    }
+    return nValues;
+  }
+
+  /**
+   * Align bit output to the next target word, the remaining bits are set to 0
+   * @return number of forward bits
+   */
+  int align()
+  {
+    if (mFilledBits == 0) {
+      return 0;
+    }
+    int nBits = TargetBitWidth - mFilledBits;
+    writeRaw(uint32_t(0), nBits);
+    return nBits;
+  }
+
+  /**
+   * Flush and close
+   * Write the pending target word
+   * @return number of target words in the buffer
+   */
+  std::size_t close()
+  {
+    align();
+    return mPosition;
+  }
+
+  /// number of completed target words in the buffer
+  std::size_t size() const { return mPosition; }
+
+ private:
+  /// the target buffer
+  target_type* mBuffer;
+  /// capacity of the target buffer
+  std::size_t mSize;
+  /// position of the next target word
+  std::size_t mPosition = 0;
+  /// bits not yet written to the buffer, in the LSBs
+  uint64_t mAccumulator = 0;
+  /// number of valid bits in the accumulator
+  unsigned mFilledBits = 0;
+};
+
+/**
+ * @class BufferInflater
+ * Reading bit fields from a buffer written by BufferDeflater or DataDeflater
+ */
+template <typename TargetType>
+class BufferInflater
+{
+ public:
+  using target_type = TargetType;
+  static const std::size_t TargetBitWidth = 8 * sizeof(target_type);
+  static const std::size_t MaxBitLength = 32;
+  static_assert(TargetBitWidth <= 32, "target words of at most 32 bits are supported");
+
+  BufferInflater(const target_type* buffer, std::size_t size) : mBuffer(buffer), mSize(size) {}
+  ~BufferInflater() = default;
+
+  /**
+   * Read number of bits into the LSBs of value
+   * @return number of read bits
+   */
+  template <typename ValueType>
+  int readRaw(ValueType& value, uint16_t bitlength)
+  {
+    if (bitlength > MaxBitLength || bitlength > 8 * sizeof(ValueType)) {
+      throw std::runtime_error("bit length exceeds width of the data type");
+    }
+    while (mFilledBits < bitlength) {
+      if (mPosition >= mSize) {
+        throw std::runtime_error("reading beyond the end of the buffer");
+      }
+      mAccumulator = (mAccumulator << TargetBitWidth) | uint64_t(mBuffer[mPosition++]);
+      mFilledBits += TargetBitWidth;
+    }
+    mFilledBits -= bitlength;
+    value = ValueType((mAccumulator >> mFilledBits) & ((uint64_t(1) << bitlength) - 1));
+    return bitlength;
+  }
+
+  /**
+   * Read a sequence of values with the same bit length
+   * @return number of read values
+   */
+  template <typename OutputIt>
+  std::size_t read(OutputIt begin, OutputIt end, uint16_t bitlength)
+  {
+    std::size_t nValues = 0;
+    for (; begin != end; ++begin, ++nValues) {
+      readRaw(*begin, bitlength);
+    }
+    return nValues;
+  }
+
+  /**
+   * Align bit input to the next target word, skipping the remaining bits of the current one
+   * @return number of skipped bits
+   */
+  int align()
+  {
+    int nBits = mFilledBits % TargetBitWidth;
+    mFilledBits -= nBits;
+    return nBits;
+  }
+
+  /// number of bits left in the buffer
+  std::size_t getNBitsLeft() const { return (mSize - mPosition) * TargetBitWidth + mFilledBits; }
+
+ private:
+  /// the source buffer
+  const target_type* mBuffer;
+  /// size of the source buffer
+  std::size_t mSize;
+  /// position of the next target word
+  std::size_t mPosition = 0;
+  /// bits read from the buffer and not yet consumed, in the LSBs
+  uint64_t mAccumulator = 0;
+  /// number of valid bits in the accumulator
+  unsigned mFilledBits = 0;
+};
+
 } // namespace data_compression
 } // namespace o2
 
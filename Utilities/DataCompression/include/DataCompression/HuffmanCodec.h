@@ -20,7 +20,9 @@
 /// @since  2016-08-11
 /// @brief  Implementation of a Huffman codec
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <cerrno>
 #include <set>
 #include <map>
@@ -287,6 +289,24 @@ class HuffmanModel : public _BASE
    * @return value, valid if codeLength > 0
    */
   value_type Decode(code_type code, uint16_t& codeLength) const
+  {
+    if (mDecodingTable.empty()) {
+      return DecodeTree(code, codeLength);
+    }
+    const DecodingTableEntry* entry = &mDecodingTable[tableIndex(code, 0, mTableBits)];
+    if (entry->subBits > 0) {
+      entry = &mDecodingTable[entry->index + tableIndex(code, mTableBits, entry->subBits)];
+    }
+    codeLength = entry->length;
+    return entry->symbol;
+  }
+
+  /**
+   * Decode bit pattern by walking through the Huffman tree bit by bit
+   *
+   * Same as Decode, without using the decoding table.
+   */
+  value_type DecodeTree(code_type code, uint16_t& codeLength) const
   {
     // TODO: need to check if there is a loaded tree, but don't
     // want to check this every time when calling. Maybe its enough
@@ -402,9 +422,215 @@ class HuffmanModel : public _BASE
     // dereference iterator and shared_ptr to get the raw pointer
     // TODO: change method to work on shared instead of raw pointers
     assignCode((*mTreeNodes.begin()).get());
+    GenerateDecodingTable();
+    return true;
+  }
+
+  /// generic interface used by the CodingModelDispatcher
+  bool Generate() { return GenerateHuffmanTree(); }
+
+  /**
+   * Replace the codes by the canonical Huffman code of the same code lengths
+   *
+   * The codes of each length are consecutive numbers, assigned in the order of
+   * the symbol indices, and the shorter codes come first. The Huffman tree is
+   * rebuilt from the new codes and the decoding table is regenerated.
+   */
+  bool GenerateCanonicalCode()
+  {
+    std::vector<std::shared_ptr<node_type>> leaves;
+    for (auto const& leave : mLeaveNodes) {
+      if (leave) {
+        leaves.push_back(leave);
+      }
+    }
+    if (leaves.empty()) {
+      return false;
+    }
+    std::stable_sort(leaves.begin(), leaves.end(), [](auto const& a, auto const& b) {
+      return a->getBinaryCodeLength() < b->getBinaryCodeLength();
+    });
+
+    // codes in reading order, i.e. the first bit to be read is the MSB of the value
+    std::vector<std::pair<uint64_t, std::shared_ptr<node_type>>> codes;
+    uint64_t value = 0;
+    uint16_t previousLength = leaves.front()->getBinaryCodeLength();
+    for (auto const& leave : leaves) {
+      uint16_t length = leave->getBinaryCodeLength();
+      if (length > MaxTableCodeLength) {
+        throw std::range_error("code length exceeds the maximum length of canonical codes");
+      }
+      if (!codes.empty()) {
+        value = (value + 1) << (length - previousLength);
+      }
+      previousLength = length;
+      code_type c = 0;
+      for (uint16_t bit = 0; bit < length; bit++) {
+        if ((value >> (length - 1 - bit)) & 0x1) {
+          c.set(OrderMSB ? length - 1 - bit : bit);
+        }
+      }
+      leave->setBinaryCode(length, c);
+      codes.emplace_back(value, leave);
+    }
+
+    // canonical codes in this order are also sorted lexicographically
+    mTreeNodes.clear();
+    mTreeNodes.insert(buildTree(codes, 0, codes.size(), 0));
+    GenerateDecodingTable();
     return true;
   }
 
+  /**
+   * Generate the lookup table used by Decode
+   *
+   * The primary table is indexed by the first primaryBits bits of the code. The
+   * entries of the codes longer than that refer to a secondary table indexed by
+   * the following bits. Each lookup thus decodes one symbol. The table is
+   * generated after building or reading the Huffman tree.
+   * @return false if the code lengths are not supported, Decode then walks the tree
+   */
+  bool GenerateDecodingTable(uint16_t primaryBits = DecodingTableBits)
+  {
+    mDecodingTable.clear();
+    mTableBits = 0;
+    uint16_t maxLength = 0;
+    for (auto const& leave : mLeaveNodes) {
+      if (leave) {
+        maxLength = std::max(maxLength, leave->getBinaryCodeLength());
+      }
+    }
+    if (maxLength > MaxTableCodeLength || maxLength > code_type().size()) {
+      return false;
+    }
+    const uint16_t tableBits = std::min(primaryBits, maxLength);
+    const uint64_t tableMask = (uint64_t(1) << tableBits) - 1;
+
+    auto primaryIndex = [tableBits, tableMask](uint64_t value, uint16_t length) -> uint64_t {
+      return OrderMSB ? value >> (length - tableBits) : value & tableMask;
+    };
+
+    // the size of the secondary tables is given by the longest code of their prefix
+    std::vector<DecodingTableEntry> table(uint64_t(1) << tableBits);
+    for (auto const& leave : mLeaveNodes) {
+      if (leave && leave->getBinaryCodeLength() > tableBits) {
+        auto& entry = table[primaryIndex(leave->getBinaryCode().to_ullong(), leave->getBinaryCodeLength())];
+        entry.subBits = std::max<uint16_t>(entry.subBits, leave->getBinaryCodeLength() - tableBits);
+      }
+    }
+    for (uint64_t prefix = 0; prefix < (uint64_t(1) << tableBits); prefix++) {
+      if (table[prefix].subBits > 0) {
+        table[prefix].index = table.size();
+        table.resize(table.size() + (uint64_t(1) << table[prefix].subBits));
+      }
+    }
+
+    for (auto const& leave : mLeaveNodes) {
+      if (!leave) {
+        continue;
+      }
+      const uint16_t length = leave->getBinaryCodeLength();
+      const uint64_t value = leave->getBinaryCode().to_ullong();
+      const DecodingTableEntry decoded{ _BASE::alphabet_type::getSymbol(leave->getIndex()), 0, length, 0 };
+      if (length <= tableBits) {
+        // all the entries starting with the code
+        for (uint64_t k = 0; k < (uint64_t(1) << (tableBits - length)); k++) {
+          table[OrderMSB ? (value << (tableBits - length)) | k : value | (k << length)] = decoded;
+        }
+        continue;
+      }
+      const auto& primary = table[primaryIndex(value, length)];
+      const uint16_t restLength = length - tableBits;
+      const uint64_t rest = OrderMSB ? value & ((uint64_t(1) << restLength) - 1) : value >> tableBits;
+      for (uint64_t k = 0; k < (uint64_t(1) << (primary.subBits - restLength)); k++) {
+        table[primary.index + (OrderMSB ? (rest << (primary.subBits - restLength)) | k : rest | (k << restLength))] = decoded;
+      }
+    }
+    mDecodingTable = std::move(table);
+    mTableBits = tableBits;
+    return true;
+  }
+
+  /// Check if Decode uses the lookup table
+  bool hasDecodingTable() const { return !mDecodingTable.empty(); }
+
+  /**
+   * Encode a sequence of symbols into a bit stream
+   *
+   * The codes are written one after the other, from the MSB to the LSB of the
+   * bytes if OrderMSB, from the LSB to the MSB otherwise
+   * @arg begin, end [in]  range of symbols to be encoded
+   * @arg buffer     [OUT] the encoded stream, the last byte being padded with zeros
+   * @return number of bits of the stream
+   */
+  template <typename InputIt>
+  size_t EncodeStream(InputIt begin, InputIt end, std::vector<uint8_t>& buffer) const
+  {
+    buffer.clear();
+    uint64_t bits = 0;
+    uint16_t nBits = 0;
+    size_t streamLength = 0;
+    for (; begin != end; ++begin) {
+      uint16_t codeLength = 0;
+      uint64_t value = Encode(*begin, codeLength).to_ullong();
+      if (codeLength > MaxTableCodeLength) {
+        throw std::range_error("code length exceeds the maximum length of stream codes");
+      }
+      if (OrderMSB) {
+        bits = (bits << codeLength) | value;
+      } else {
+        bits |= value << nBits;
+      }
+      nBits += codeLength;
+      streamLength += codeLength;
+      for (; nBits >= 8; nBits -= 8) {
+        if (OrderMSB) {
+          buffer.push_back(bits >> (nBits - 8));
+        } else {
+          buffer.push_back(bits);
+          bits >>= 8;
+        }
+      }
+    }
+    if (nBits > 0) {
+      buffer.push_back(OrderMSB ? bits << (8 - nBits) : bits);
+    }
+    return streamLength;
+  }
+
+  /**
+   * Decode a bit stream written by EncodeStream, one table lookup per symbol
+   *
+   * @arg data       [in]  the bit stream
+   * @arg streamLength [in] number of bits of the stream
+   * @arg out        [OUT] output iterator of the decoded symbols
+   * @return number of decoded symbols
+   */
+  template <typename OutputIt>
+  size_t DecodeStream(const uint8_t* data, size_t streamLength, OutputIt out) const
+  {
+    if (mDecodingTable.empty()) {
+      throw std::runtime_error("stream decoding requires a decoding table");
+    }
+    const size_t size = (streamLength + 7) / 8;
+    size_t position = 0;
+    size_t nSymbols = 0;
+    while (position < streamLength) {
+      const uint64_t window = peekBits(data, size, position);
+      const DecodingTableEntry* entry = &mDecodingTable[windowIndex(window, 0, mTableBits)];
+      if (entry->subBits > 0) {
+        entry = &mDecodingTable[entry->index + windowIndex(window, mTableBits, entry->subBits)];
+      }
+      if (entry->length == 0 || position + entry->length > streamLength) {
+        break;
+      }
+      *out++ = entry->symbol;
+      position += entry->length;
+      ++nSymbols;
+    }
+    return nSymbols;
+  }
+
   /**
    * assign code to this node loop to right and left nodes
    *
@@ -606,6 +832,7 @@ class HuffmanModel : public _BASE
                 << "; " << treeNodes.size() << " tree nodes(s), expected 1" << std::endl;
     }
     mTreeNodes.insert(treeNodes.begin()->second);
+    GenerateDecodingTable();
     return 0;
   }
 
@@ -622,6 +849,82 @@ class HuffmanModel : public _BASE
   };
 
  private:
+  /// length of the codes in the primary decoding table
+  static constexpr uint16_t DecodingTableBits = 11;
+  /// maximum code length supported by the decoding table and the streams
+  static constexpr uint16_t MaxTableCodeLength = 56;
+
+  /// entry of the decoding table, either a symbol or the reference to a secondary table
+  struct DecodingTableEntry {
+    value_type symbol;
+    uint32_t index;   // position of the secondary table
+    uint16_t length;  // code length, 0 for a reference or an invalid code
+    uint16_t subBits; // length of the index of the secondary table
+  };
+
+  /// index of nBits of the code, after skipping the first skipBits bits to be read
+  static uint64_t tableIndex(code_type const& code, uint16_t skipBits, uint16_t nBits)
+  {
+    const auto codeSize = code.size();
+    if (OrderMSB) {
+      return ((code << skipBits) >> (codeSize - nBits)).to_ullong();
+    }
+    return (((code >> skipBits) << (codeSize - nBits)) >> (codeSize - nBits)).to_ullong();
+  }
+
+  /// same as tableIndex for a window of the bit stream
+  static uint64_t windowIndex(uint64_t window, uint16_t skipBits, uint16_t nBits)
+  {
+    if (nBits == 0) {
+      return 0;
+    }
+    if (OrderMSB) {
+      return (window << skipBits) >> (64 - nBits);
+    }
+    return (window >> skipBits) & ((uint64_t(1) << nBits) - 1);
+  }
+
+  /// 64 bits of the stream starting at bit position, the first one in the MSB if
+  /// OrderMSB, in the LSB otherwise. At least 57 of them are valid.
+  static uint64_t peekBits(const uint8_t* data, size_t size, size_t position)
+  {
+    const size_t byte = position / 8;
+    uint64_t window = 0;
+    if (byte + sizeof(window) <= size) {
+      std::memcpy(&window, data + byte, sizeof(window)); // little endian host
+      if (OrderMSB) {
+        window = __builtin_bswap64(window);
+      }
+    } else {
+      for (size_t i = 0; byte + i < size; i++) {
+        window |= uint64_t(data[byte + i]) << (OrderMSB ? 56 - 8 * i : 8 * i);
+      }
+    }
+    return OrderMSB ? window << (position % 8) : window >> (position % 8);
+  }
+
+  /// build the (sub)tree of the codes in range [begin, end), sorted lexicographically,
+  /// sharing their first depth bits
+  std::shared_ptr<node_type> buildTree(std::vector<std::pair<uint64_t, std::shared_ptr<node_type>>> const& codes,
+                                       size_t begin, size_t end, uint16_t depth)
+  {
+    if (end - begin == 1 && codes[begin].second->getBinaryCodeLength() == depth) {
+      return codes[begin].second;
+    }
+    auto bitAt = [depth](std::pair<uint64_t, std::shared_ptr<node_type>> const& code) {
+      return (code.first >> (code.second->getBinaryCodeLength() - 1 - depth)) & 0x1;
+    };
+    size_t split = begin;
+    while (split < end && codes[split].second->getBinaryCodeLength() > depth && !bitAt(codes[split])) {
+      ++split;
+    }
+    if (split == begin || split == end) {
+      throw std::runtime_error("codes do not form a complete binary tree");
+    }
+    // bit '1' branch to the left, bit '0' branch to the right
+    return std::make_shared<node_type>(buildTree(codes, split, end, depth + 1), buildTree(codes, begin, split, depth + 1));
+  }
+
   /**
    * @brief Recursive write of the node content.
    *
@@ -655,6 +958,10 @@ class HuffmanModel : public _BASE
   std::vector<std::shared_ptr<node_type>> mLeaveNodes;
   // multiset, order determined by less functor working on pointers
   std::multiset<std::shared_ptr<node_type>, isless<std::shared_ptr<node_type>>> mTreeNodes;
+  // primary decoding table followed by the secondary tables
+  std::vector<DecodingTableEntry> mDecodingTable;
+  // length of the codes in the primary decoding table
+  uint16_t mTableBits = 0;
 };
 
 } // namespace data_compression
@@ -0,0 +1,435 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/* Local Variables:  */
+/* mode: c++         */
+/* End:              */
+
+#ifndef RANSCODEC_H
+#define RANSCODEC_H
+
+/// @file   RANSCodec.h
+/// @brief  Implementation of an interleaved rANS entropy coder
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream> // stringstream in configuration parsing
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "CommonUtils/CompStream.h"
+
+namespace o2
+{
+namespace data_compression
+{
+
+/**
+ * @class RANSModel
+ * @brief Probability model implementing range asymmetric numeral system coding
+ * This is a mixin class which extends the ProbabilityModel base, in the same way
+ * as HuffmanModel, such that both can be used for the parameters of a
+ * CodingModelDispatcher.
+ *
+ * The weights of the probability model are quantized to frequencies summing up
+ * to 2^scaleBits. Symbols are coded in streams, NStreams rANS states being
+ * interleaved: symbol i is coded by state i % NStreams. The states are 32 bit
+ * wide, renormalized by 16 bit words, such that the decoding of all the states
+ * is done by the same branchless operations and can be vectorized.
+ *
+ * Stream format: number of symbols (uint32), the final states of the encoder
+ * (NStreams uint32), and the renormalization words (uint16) in decoding order.
+ * All the values are little endian.
+ *
+ * Symbols with zero weight can not be encoded.
+ */
+template <typename _BASE, int NStreams = 4>
+class RANSModel : public _BASE
+{
+ public:
+  RANSModel() : mAlphabet() {}
+  ~RANSModel() = default;
+
+  using base_type = _BASE;
+  using value_type = typename _BASE::value_type;
+  using state_type = uint32_t;
+  /// the model only codes streams, the code type of the dispatcher interface is the state
+  using code_type = state_type;
+  static_assert(NStreams > 0, "at least one rANS state is needed");
+
+  /// minimum and maximum precision of the quantized frequencies
+  static constexpr uint16_t MinScaleBits = 12;
+  static constexpr uint16_t MaxScaleBits = 16;
+
+  int init(double v = 1.) { return _BASE::initWeight(mAlphabet, v); }
+
+  /**
+   * Quantize the weights and generate the coding tables
+   *
+   * The precision is chosen from the number of symbols with non-zero weight,
+   * leaving on average 16 slots per symbol, at least MinScaleBits and at most
+   * MaxScaleBits.
+   */
+  bool GenerateTables()
+  {
+    std::vector<std::pair<unsigned, double>> weights;
+    double totalWeight = 0.;
+    for (auto const& i : static_cast<_BASE&>(*this)) {
+      if (i.second > 0) {
+        weights.emplace_back(_BASE::alphabet_type::getIndex(i.first), i.second);
+        totalWeight += i.second;
+      }
+    }
+    if (weights.empty()) {
+      return false;
+    }
+    uint16_t scaleBits = MinScaleBits;
+    while (scaleBits < MaxScaleBits && (size_t(1) << scaleBits) < 16 * weights.size()) {
+      ++scaleBits;
+    }
+    if ((size_t(1) << scaleBits) < weights.size()) {
+      throw std::range_error("too many symbols for the precision of the rANS frequencies");
+    }
+
+    // every symbol with a weight gets a frequency of at least 1, the rounding
+    // difference is corrected on the most frequent symbols
+    const int64_t totalFrequency = int64_t(1) << scaleBits;
+    std::vector<std::pair<unsigned, int64_t>> frequencies;
+    int64_t sum = 0;
+    for (auto const& w : weights) {
+      int64_t frequency = std::max<int64_t>(1, std::llround(w.second / totalWeight * totalFrequency));
+      frequencies.emplace_back(w.first, frequency);
+      sum += frequency;
+    }
+    std::vector<size_t> order(frequencies.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&frequencies](size_t a, size_t b) { return frequencies[a].second > frequencies[b].second; });
+    for (size_t k = 0; sum != totalFrequency; k = (k + 1) % order.size()) {
+      auto& frequency = frequencies[order[k]].second;
+      if (sum < totalFrequency) {
+        int64_t add = std::min<int64_t>(totalFrequency - sum, std::max<int64_t>(1, frequency / 16));
+        frequency += add;
+        sum += add;
+      } else if (frequency > 1) {
+        int64_t remove = std::min<int64_t>({ sum - totalFrequency, frequency - 1, std::max<int64_t>(1, frequency / 16) });
+        frequency -= remove;
+        sum -= remove;
+      }
+    }
+    setFrequencies(frequencies, scaleBits);
+    return true;
+  }
+
+  /// generic interface used by the CodingModelDispatcher
+  bool Generate() { return GenerateTables(); }
+
+  /// get the precision of the frequencies
+  uint16_t getScaleBits() const { return mScaleBits; }
+
+  /// get the quantized frequency of a symbol, 0 if it can not be coded
+  uint32_t getFrequency(value_type symbol) const
+  {
+    auto index = _BASE::alphabet_type::getIndex(symbol);
+    return index < mFrequencies.size() ? mFrequencies[index] : 0;
+  }
+
+  /// get the quantized frequencies of the symbols which can be coded, ordered by symbol index
+  std::vector<std::pair<value_type, uint32_t>> getFrequencyTable() const
+  {
+    std::vector<std::pair<value_type, uint32_t>> table;
+    for (unsigned index = 0; index < mFrequencies.size(); index++) {
+      if (mFrequencies[index] > 0) {
+        table.emplace_back(_BASE::alphabet_type::getSymbol(index), mFrequencies[index]);
+      }
+    }
+    return table;
+  }
+
+  /**
+   * Set the quantized frequencies, e.g. from a binary configuration
+   * The weights of the probability model are not changed.
+   * @return false if the table is not valid, i.e. the frequencies do not sum up to 2^scaleBits
+   */
+  bool setFrequencyTable(std::vector<std::pair<value_type, uint32_t>> const& table, uint16_t scaleBits)
+  {
+    if (scaleBits < 1 || scaleBits > MaxScaleBits) {
+      return false;
+    }
+    std::vector<std::pair<unsigned, int64_t>> frequencies;
+    int64_t sum = 0;
+    for (auto const& entry : table) {
+      if (entry.second == 0 || !_BASE::alphabet_type::isValid(entry.first)) {
+        return false;
+      }
+      frequencies.emplace_back(_BASE::alphabet_type::getIndex(entry.first), entry.second);
+      sum += entry.second;
+    }
+    if (sum != (int64_t(1) << scaleBits)) {
+      return false;
+    }
+    setFrequencies(frequencies, scaleBits);
+    return true;
+  }
+
+  /**
+   * Encode a sequence of symbols into a stream
+   *
+   * @arg begin, end [in]  range of symbols to be encoded, random access iterators
+   * @arg buffer     [OUT] the encoded stream
+   * @return number of bits of the stream
+   */
+  template <typename InputIt>
+  size_t EncodeStream(InputIt begin, InputIt end, std::vector<uint8_t>& buffer) const
+  {
+    if (mDecodingTable.empty()) {
+      throw std::runtime_error("rANS tables have not been generated");
+    }
+    const size_t nSymbols = std::distance(begin, end);
+    state_type states[NStreams];
+    std::fill(states, states + NStreams, LowerBound);
+    std::vector<uint16_t> words;
+    words.reserve(nSymbols / 2);
+
+    // rANS is last in first out, the symbols are encoded backwards
+    for (size_t i = nSymbols; i-- > 0;) {
+      auto index = _BASE::alphabet_type::getIndex(*(begin + i));
+      const uint32_t frequency = index < mFrequencies.size() ? mFrequencies[index] : 0;
+      if (frequency == 0) {
+        throw std::range_error("symbol without frequency in alphabet " + std::string(_BASE::getName()));
+      }
+      state_type& state = states[i % NStreams];
+      const uint64_t maxState = ((uint64_t(LowerBound) >> mScaleBits) << WordBits) * frequency;
+      if (state >= maxState) {
+        words.push_back(state & WordMask);
+        state >>= WordBits;
+      }
+      state = ((state / frequency) << mScaleBits) + (state % frequency) + mStarts[index];
+    }
+
+    buffer.resize(sizeof(uint32_t) * (1 + NStreams) + sizeof(uint16_t) * words.size());
+    uint8_t* out = buffer.data();
+    const uint32_t n = nSymbols;
+    std::memcpy(out, &n, sizeof(n));
+    out += sizeof(n);
+    std::memcpy(out, states, sizeof(states));
+    out += sizeof(states);
+    std::reverse(words.begin(), words.end());
+    std::memcpy(out, words.data(), sizeof(uint16_t) * words.size());
+    return buffer.size() * 8;
+  }
+
+  /**
+   * Decode a stream written by EncodeStream
+   *
+   * @arg data         [in]  the stream
+   * @arg streamLength [in]  number of bits of the stream
+   * @arg out          [OUT] output iterator of the decoded symbols
+   * @return number of decoded symbols
+   */
+  template <typename OutputIt>
+  size_t DecodeStream(const uint8_t* data, size_t streamLength, OutputIt out) const
+  {
+    const size_t size = streamLength / 8;
+    if (mDecodingTable.empty()) {
+      throw std::runtime_error("rANS tables have not been generated");
+    }
+    if (size < sizeof(uint32_t) * (1 + NStreams)) {
+      throw std::runtime_error("rANS stream too short");
+    }
+    uint32_t nSymbols = 0;
+    std::memcpy(&nSymbols, data, sizeof(nSymbols));
+    state_type states[NStreams];
+    std::memcpy(states, data + sizeof(nSymbols), sizeof(states));
+    const uint8_t* words = data + sizeof(uint32_t) * (1 + NStreams);
+    const size_t nWords = (size - sizeof(uint32_t) * (1 + NStreams)) / sizeof(uint16_t);
+    size_t position = 0;
+
+    // local copies, the output may alias the members
+    const uint16_t scaleBits = mScaleBits;
+    const state_type slotMask = (state_type(1) << scaleBits) - 1;
+    const DecodingTableEntry* table = mDecodingTable.data();
+
+    // the same operations on all the states, without branches; the words are
+    // read without bounds check as long as the stream can not be exhausted
+    auto decode = [&](int nStates, auto checked) {
+      uint32_t slots[NStreams];
+      for (int j = 0; j < nStates; j++) {
+        slots[j] = states[j] & slotMask;
+      }
+      for (int j = 0; j < nStates; j++) {
+        const DecodingTableEntry& entry = table[slots[j]];
+        *out++ = entry.symbol;
+        states[j] = entry.frequency * (states[j] >> scaleBits) + slots[j] - entry.start;
+      }
+      for (int j = 0; j < nStates; j++) {
+        const bool renormalize = states[j] < LowerBound;
+        uint16_t word = 0;
+        if (!decltype(checked)::value || position < nWords) {
+          std::memcpy(&word, words + position * sizeof(uint16_t), sizeof(word));
+        }
+        states[j] = renormalize ? (states[j] << WordBits) | word : states[j];
+        position += renormalize;
+      }
+    };
+    size_t i = 0;
+    for (; i + NStreams <= nSymbols && position + NStreams <= nWords; i += NStreams) {
+      decode(NStreams, std::false_type());
+    }
+    for (; i + NStreams <= nSymbols; i += NStreams) {
+      decode(NStreams, std::true_type());
+    }
+    if (i < nSymbols) {
+      decode(nSymbols - i, std::true_type());
+    }
+    if (position > nWords) {
+      throw std::runtime_error("rANS stream truncated");
+    }
+    return nSymbols;
+  }
+
+  /**
+   * @brief Write the frequency table to file.
+   *
+   * The file can be compressed on-the-fly, supported methods:
+   * gzip, zlib, bzip2, and lzma
+   */
+  int write(const char* filename, std::string method = "zlib") const
+  {
+    o2::io::ocomp_stream out(filename, method);
+    return write(out);
+  }
+
+  /**
+   * @brief Write the frequency table to an output stream
+   * Format: precision in the first line, then one symbol and its frequency per
+   * line.
+   * @return number of written symbols
+   */
+  int write(std::ostream& out) const
+  {
+    if (mDecodingTable.empty()) {
+      return 0;
+    }
+    out << mScaleBits << std::endl;
+    int nSymbols = 0;
+    for (unsigned index = 0; index < mFrequencies.size(); index++) {
+      if (mFrequencies[index] > 0) {
+        out << _BASE::alphabet_type::getSymbol(index) << " " << mFrequencies[index] << std::endl;
+        ++nSymbols;
+      }
+    }
+    return nSymbols;
+  }
+
+  /**
+   * @brief Read configuration from file
+   *
+   * Read configuration text file, can be in compressed format, supported
+   * methods: gzip, zlib, bzip2, and lzma
+   */
+  int read(const char* filename, std::string method = "zlib")
+  {
+    o2::io::icomp_stream in(filename, method);
+    return read(in);
+  }
+
+  /**
+   * @brief Read the frequency table from stream, terminated by a blank line or eof
+   * The previous configuration is discarded, the frequencies are also set as
+   * weights of the probability model.
+   */
+  int read(std::istream& in)
+  {
+    std::string line;
+    if (!std::getline(in, line) || line.empty()) {
+      std::cerr << "Format error: missing precision of the rANS frequencies" << std::endl;
+      return -1;
+    }
+    const int scaleBits = std::stoi(line);
+    if (scaleBits < 1 || scaleBits > MaxScaleBits) {
+      std::cerr << "Format error: invalid precision of the rANS frequencies " << scaleBits << std::endl;
+      return -1;
+    }
+    std::vector<std::pair<unsigned, int64_t>> frequencies;
+    int64_t sum = 0;
+    while (std::getline(in, line) && !line.empty()) {
+      std::stringstream ls(line);
+      typename _BASE::alphabet_type::value_type symbol;
+      int64_t frequency = 0;
+      if (!(ls >> symbol >> frequency) || frequency <= 0) {
+        std::cerr << "Format error: can not read symbol frequency from '" << line << "'" << std::endl;
+        return -1;
+      }
+      frequencies.emplace_back(_BASE::alphabet_type::getIndex(symbol), frequency);
+      _BASE::addWeight(symbol, frequency);
+      sum += frequency;
+    }
+    if (sum != (int64_t(1) << scaleBits)) {
+      std::cerr << "Format error: rANS frequencies sum up to " << sum << ", expected " << (int64_t(1) << scaleBits)
+                << std::endl;
+      return -1;
+    }
+    setFrequencies(frequencies, scaleBits);
+    return 0;
+  }
+
+ private:
+  /// lower bound of the normalized state interval
+  static constexpr state_type LowerBound = state_type(1) << 16;
+  static constexpr uint16_t WordBits = 16;
+  static constexpr state_type WordMask = (state_type(1) << WordBits) - 1;
+
+  /// entry of the decoding table, one per slot of the quantized probability range
+  struct DecodingTableEntry {
+    value_type symbol;
+    uint32_t frequency;
+    uint32_t start;
+  };
+
+  /// set the cumulative frequencies and the decoding table
+  void setFrequencies(std::vector<std::pair<unsigned, int64_t>> frequencies, uint16_t scaleBits)
+  {
+    std::sort(frequencies.begin(), frequencies.end());
+    const unsigned maxIndex = frequencies.empty() ? 0 : frequencies.back().first;
+    mScaleBits = scaleBits;
+    mFrequencies.assign(maxIndex + 1, 0);
+    mStarts.assign(maxIndex + 1, 0);
+    mDecodingTable.resize(size_t(1) << scaleBits);
+    uint32_t start = 0;
+    for (auto const& f : frequencies) {
+      mFrequencies[f.first] = f.second;
+      mStarts[f.first] = start;
+      const DecodingTableEntry entry{ _BASE::alphabet_type::getSymbol(f.first), uint32_t(f.second), start };
+      std::fill(mDecodingTable.begin() + start, mDecodingTable.begin() + start + f.second, entry);
+      start += f.second;
+    }
+  }
+
+  // the alphabet, determined by template parameter
+  typename _BASE::alphabet_type mAlphabet;
+  // precision of the frequencies, which sum up to 2^mScaleBits
+  uint16_t mScaleBits = MinScaleBits;
+  // quantized frequency and cumulative frequency of each symbol, by symbol index
+  std::vector<uint32_t> mFrequencies;
+  std::vector<uint32_t> mStarts;
+  // symbol and its frequencies for each slot
+  std::vector<DecodingTableEntry> mDecodingTable;
+};
+
+} // namespace data_compression
+} // namespace o2
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   benchmark_DataDeflater.cxx
+/// @brief  Benchmark of the bit packing of the DataDeflater and the BufferDeflater
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <vector>
+#include "../include/DataCompression/DataDeflater.h"
+
+using namespace o2::data_compression;
+
+// bit fields of the widths of the TPC cluster parameters
+static const std::vector<uint16_t> sBitLengths = { 6, 14, 15, 8, 8, 16, 10 };
+
+static std::vector<uint32_t> generateValues(size_t nValues)
+{
+  std::vector<uint32_t> values(nValues);
+  uint32_t random = 12345;
+  for (size_t i = 0; i < nValues; i++) {
+    random = random * 1103515245u + 12345u;
+    values[i] = random & ((1u << sBitLengths[i % sBitLengths.size()]) - 1);
+  }
+  return values;
+}
+
+template <typename TargetType>
+static void BM_DataDeflater(benchmark::State& state)
+{
+  auto values = generateValues(7 << 14);
+  std::vector<TargetType> buffer(values.size() * 2);
+  for (auto _ : state) {
+    DataDeflater<TargetType> deflater;
+    size_t position = 0;
+    typename DataDeflater<TargetType>::Writer writer = [&](const TargetType& word) -> bool {
+      buffer[position++] = word;
+      return true;
+    };
+    for (size_t i = 0; i < values.size(); i++) {
+      deflater.writeRaw(values[i], sBitLengths[i % sBitLengths.size()], writer);
+    }
+    deflater.close(writer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * values.size() * sizeof(uint32_t));
+}
+
+template <typename TargetType>
+static void BM_BufferDeflater(benchmark::State& state)
+{
+  auto values = generateValues(7 << 14);
+  std::vector<TargetType> buffer(values.size() * 2);
+  for (auto _ : state) {
+    BufferDeflater<TargetType> deflater(buffer.data(), buffer.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      deflater.writeRaw(values[i], sBitLengths[i % sBitLengths.size()]);
+    }
+    deflater.close();
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * values.size() * sizeof(uint32_t));
+}
+
+template <typename TargetType>
+static void BM_BufferInflater(benchmark::State& state)
+{
+  auto values = generateValues(7 << 14);
+  std::vector<TargetType> buffer(values.size() * 2);
+  BufferDeflater<TargetType> deflater(buffer.data(), buffer.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    deflater.writeRaw(values[i], sBitLengths[i % sBitLengths.size()]);
+  }
+  buffer.resize(deflater.close());
+  std::vector<uint32_t> inflated(values.size());
+  for (auto _ : state) {
+    BufferInflater<TargetType> inflater(buffer.data(), buffer.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      inflater.readRaw(inflated[i], sBitLengths[i % sBitLengths.size()]);
+    }
+    benchmark::DoNotOptimize(inflated.data());
+  }
+  if (inflated != values) {
+    state.SkipWithError("inflating mismatch");
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * values.size() * sizeof(uint32_t));
+}
+
+BENCHMARK_TEMPLATE(BM_DataDeflater, uint8_t);
+BENCHMARK_TEMPLATE(BM_DataDeflater, uint32_t);
+BENCHMARK_TEMPLATE(BM_BufferDeflater, uint8_t);
+BENCHMARK_TEMPLATE(BM_BufferDeflater, uint32_t);
+BENCHMARK_TEMPLATE(BM_BufferInflater, uint8_t);
+BENCHMARK_TEMPLATE(BM_BufferInflater, uint32_t);
+
+BENCHMARK_MAIN();
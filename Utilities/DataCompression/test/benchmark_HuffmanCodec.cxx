@@ -0,0 +1,86 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   benchmark_HuffmanCodec.cxx
+/// @brief  Benchmark of the decoding methods of the Huffman codec
+
+#include <benchmark/benchmark.h>
+#include <bitset>
+#include <iterator>
+#include <vector>
+#include "../include/DataCompression/dc_primitives.h"
+#include "../include/DataCompression/HuffmanCodec.h"
+#include "DataGenerator.h"
+
+using namespace o2::data_compression;
+
+using DataGenerator_t = o2::test::DataGenerator<int16_t, o2::test::normal_distribution<double>>;
+using Alphabet_t = ContiguousAlphabet<int16_t, -100, 100>;
+using HuffmanModel_t = HuffmanModel<ProbabilityModel<Alphabet_t>, std::bitset<32>, true>;
+
+// a model for a wide distribution, with codes longer than the primary decoding table
+static HuffmanModel_t createModel(DataGenerator_t& dg)
+{
+  HuffmanModel_t model;
+  model.init(0.);
+  Alphabet_t alphabet;
+  for (auto s : alphabet) {
+    model.addWeight(s, dg.getProbability(s) + 1.e-6);
+  }
+  model.normalize();
+  model.GenerateHuffmanTree();
+  model.GenerateCanonicalCode();
+  return model;
+}
+
+static void BM_HuffmanDecode(benchmark::State& state)
+{
+  const bool useTable = state.range(0);
+  DataGenerator_t dg(-100, 100, 1, 0., 20.);
+  auto model = createModel(dg);
+  std::vector<HuffmanModel_t::code_type> codes(4096);
+  for (auto& code : codes) {
+    uint16_t codeLength = 0;
+    code = model.Encode(dg(), codeLength);
+    code <<= (code.size() - codeLength);
+  }
+
+  for (auto _ : state) {
+    for (auto const& code : codes) {
+      uint16_t codeLength = 0;
+      benchmark::DoNotOptimize(useTable ? model.Decode(code, codeLength) : model.DecodeTree(code, codeLength));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * codes.size());
+}
+
+static void BM_HuffmanDecodeStream(benchmark::State& state)
+{
+  DataGenerator_t dg(-100, 100, 1, 0., 20.);
+  auto model = createModel(dg);
+  std::vector<int16_t> values(1 << 16);
+  for (auto& value : values) {
+    value = dg();
+  }
+  std::vector<uint8_t> stream;
+  auto streamLength = model.EncodeStream(values.begin(), values.end(), stream);
+  std::vector<int16_t> decoded(values.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(model.DecodeStream(stream.data(), streamLength, decoded.begin()));
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * stream.size());
+}
+
+BENCHMARK(BM_HuffmanDecode)->Arg(0)->Arg(1);
+BENCHMARK(BM_HuffmanDecodeStream);
+
+BENCHMARK_MAIN();
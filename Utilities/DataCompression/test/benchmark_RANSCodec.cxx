@@ -0,0 +1,141 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   benchmark_RANSCodec.cxx
+/// @brief  Benchmark of the rANS and Huffman stream coding of TPC cluster like parameters
+///
+/// The parameters are generated with distributions resembling the TPC cluster
+/// parameters: narrow normal distributions for the cluster widths, wide ones for
+/// the pad and time differences and a geometric one for the charge. The models
+/// are trained on the coded values. The counters report the coded bits per value.
+
+#include <benchmark/benchmark.h>
+#include <bitset>
+#include <map>
+#include <vector>
+#include "../include/DataCompression/dc_primitives.h"
+#include "../include/DataCompression/HuffmanCodec.h"
+#include "../include/DataCompression/RANSCodec.h"
+#include "DataGenerator.h"
+
+using namespace o2::data_compression;
+
+using Alphabet_t = ContiguousAlphabet<int16_t, -1024, 1023>;
+using HuffmanModel_t = HuffmanModel<ProbabilityModel<Alphabet_t>, std::bitset<64>, true>;
+using RANSModel_t = RANSModel<ProbabilityModel<Alphabet_t>>;
+
+enum Parameter { SigmaY2,
+                 PadDifference,
+                 TimeDifference,
+                 Charge };
+
+static std::vector<int16_t> generateValues(int parameter, size_t nValues)
+{
+  std::vector<int16_t> values(nValues);
+  if (parameter == Charge) {
+    o2::test::DataGenerator<int16_t, o2::test::geometric_distribution<int16_t>> dg(0, 1023, 1, 0.02);
+    for (auto& value : values) {
+      value = dg();
+    }
+    return values;
+  }
+  const double sigma = parameter == SigmaY2 ? 3. : parameter == PadDifference ? 40. : 150.;
+  o2::test::DataGenerator<int16_t, o2::test::normal_distribution<double>> dg(-1024, 1023, 1, 0., sigma);
+  for (auto& value : values) {
+    value = dg();
+  }
+  return values;
+}
+
+template <typename ModelT>
+static ModelT createModel(std::vector<int16_t> const& values)
+{
+  std::map<int16_t, double> counts;
+  for (auto value : values) {
+    counts[value] += 1.;
+  }
+  ModelT model;
+  model.init(0.);
+  for (auto const& count : counts) {
+    model.addWeight(count.first, count.second);
+  }
+  model.normalize();
+  model.Generate();
+  return model;
+}
+
+static HuffmanModel_t createHuffmanModel(std::vector<int16_t> const& values)
+{
+  auto model = createModel<HuffmanModel_t>(values);
+  model.GenerateCanonicalCode();
+  return model;
+}
+
+template <typename ModelT>
+static void encode(benchmark::State& state, ModelT const& model, std::vector<int16_t> const& values)
+{
+  std::vector<uint8_t> stream;
+  size_t streamLength = 0;
+  for (auto _ : state) {
+    streamLength = model.EncodeStream(values.begin(), values.end(), stream);
+    benchmark::DoNotOptimize(stream.data());
+  }
+  state.counters["bits/value"] = double(streamLength) / values.size();
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * values.size() * sizeof(int16_t));
+}
+
+template <typename ModelT>
+static void decode(benchmark::State& state, ModelT const& model, std::vector<int16_t> const& values)
+{
+  std::vector<uint8_t> stream;
+  auto streamLength = model.EncodeStream(values.begin(), values.end(), stream);
+  std::vector<int16_t> decoded(values.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(model.DecodeStream(stream.data(), streamLength, decoded.begin()));
+  }
+  if (decoded != values) {
+    state.SkipWithError("decoding mismatch");
+  }
+  state.counters["bits/value"] = double(streamLength) / values.size();
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * values.size() * sizeof(int16_t));
+}
+
+static void BM_HuffmanEncodeStream(benchmark::State& state)
+{
+  auto values = generateValues(state.range(0), 1 << 18);
+  encode(state, createHuffmanModel(values), values);
+}
+
+static void BM_RANSEncodeStream(benchmark::State& state)
+{
+  auto values = generateValues(state.range(0), 1 << 18);
+  encode(state, createModel<RANSModel_t>(values), values);
+}
+
+static void BM_HuffmanDecodeStream(benchmark::State& state)
+{
+  auto values = generateValues(state.range(0), 1 << 18);
+  decode(state, createHuffmanModel(values), values);
+}
+
+static void BM_RANSDecodeStream(benchmark::State& state)
+{
+  auto values = generateValues(state.range(0), 1 << 18);
+  decode(state, createModel<RANSModel_t>(values), values);
+}
+
+BENCHMARK(BM_HuffmanEncodeStream)->DenseRange(SigmaY2, Charge);
+BENCHMARK(BM_RANSEncodeStream)->DenseRange(SigmaY2, Charge);
+BENCHMARK(BM_HuffmanDecodeStream)->DenseRange(SigmaY2, Charge);
+BENCHMARK(BM_RANSDecodeStream)->DenseRange(SigmaY2, Charge);
+
+BENCHMARK_MAIN();
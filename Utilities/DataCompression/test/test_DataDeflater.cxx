@@ -177,3 +177,69 @@ BOOST_AUTO_TEST_CASE(test_TruncatedPrecisionConverter)
   deflater.close(writerfct);
   compare(data, Codec::sMaxLength, targetBuffer);
 }
+
+BOOST_AUTO_TEST_CASE(test_BufferDeflater)
+{
+  using target_type = uint8_t;
+  std::array<char, 8> data = { 'd', 'e', 'a', 'd', 'b', 'e', 'e', 'f' };
+  const auto bitwidth = 7;
+
+  // same bit layout as the DataDeflater
+  std::vector<target_type> targetBuffer(data.size());
+  o2dc::BufferDeflater<target_type> deflater(targetBuffer.data(), targetBuffer.size());
+  deflater.write(data.begin(), data.end(), bitwidth);
+  targetBuffer.resize(deflater.close());
+  BOOST_CHECK_EQUAL(targetBuffer.size(), (data.size() * bitwidth + 7) / 8);
+  compare(data, bitwidth, targetBuffer);
+
+  o2dc::BufferInflater<target_type> inflater(targetBuffer.data(), targetBuffer.size());
+  std::array<char, 8> inflated;
+  inflater.read(inflated.begin(), inflated.end(), bitwidth);
+  BOOST_CHECK(inflated == data);
+  BOOST_CHECK_EQUAL(inflater.align(), targetBuffer.size() * 8 - data.size() * bitwidth);
+  BOOST_CHECK_EQUAL(inflater.getNBitsLeft(), 0);
+  char value = 0;
+  BOOST_CHECK_THROW(inflater.readRaw(value, 1), std::runtime_error);
+
+  // the buffer is not extended
+  std::vector<target_type> smallBuffer(2);
+  o2dc::BufferDeflater<target_type> overflow(smallBuffer.data(), smallBuffer.size());
+  BOOST_CHECK_THROW(overflow.write(data.begin(), data.end(), bitwidth), std::runtime_error);
+  overflow.reset();
+}
+
+BOOST_AUTO_TEST_CASE(test_BufferDeflaterVariableLength)
+{
+  using target_type = uint32_t;
+  std::vector<std::pair<uint32_t, uint16_t>> fields;
+  for (uint32_t i = 0; i < 10000; i++) {
+    uint16_t bitlength = i % 33;
+    fields.emplace_back((i * 2654435761u) & (bitlength < 32 ? (1u << bitlength) - 1 : ~0u), bitlength);
+  }
+  std::vector<target_type> targetBuffer(fields.size());
+  o2dc::BufferDeflater<target_type> deflater(targetBuffer.data(), targetBuffer.size());
+  for (auto const& field : fields) {
+    deflater.writeRaw(field.first, field.second);
+  }
+  targetBuffer.resize(deflater.close());
+
+  // the DataDeflater produces the same buffer
+  o2dc::DataDeflater<target_type> reference;
+  std::vector<target_type> referenceBuffer;
+  auto writerfct = [&](const target_type& value) -> bool {
+    referenceBuffer.emplace_back(value);
+    return true;
+  };
+  for (auto const& field : fields) {
+    reference.writeRaw(uint64_t(field.first), field.second, writerfct);
+  }
+  reference.close(writerfct);
+  BOOST_CHECK(targetBuffer == referenceBuffer);
+
+  o2dc::BufferInflater<target_type> inflater(targetBuffer.data(), targetBuffer.size());
+  for (auto const& field : fields) {
+    uint32_t value = 0;
+    inflater.readRaw(value, field.second);
+    BOOST_REQUIRE_EQUAL(value, field.first);
+  }
+}
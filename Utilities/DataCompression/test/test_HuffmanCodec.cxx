@@ -22,7 +22,9 @@
 #include <iomanip>
 #include <sstream>
 #include <vector>
+#include <map>
 #include <bitset>
+#include <iterator>
 #include <thread>
 #include <stdexcept> // exeptions, runtime_error
 #include "../include/DataCompression/dc_primitives.h"
@@ -225,5 +227,95 @@ BOOST_AUTO_TEST_CASE(test_HuffmanCodec_configuration)
   checkRandom(codec, dg);
 }
 
+BOOST_AUTO_TEST_CASE(test_HuffmanCodec_decodingTable)
+{
+  auto setup = setupCodec();
+  auto& codec = setup.first;
+  auto model = codec.getCodingModel();
+  using ValueT = decltype(setup.first)::value_type;
+  using CodeT = decltype(setup.first)::code_type;
+
+  // the table lookup has to give the same result as the tree walk, also with
+  // secondary tables for the codes longer than the primary table
+  for (uint16_t tableBits : { 11, 3, 1 }) {
+    BOOST_REQUIRE(model.GenerateDecodingTable(tableBits));
+    BOOST_REQUIRE(model.hasDecodingTable());
+    for (auto const& i : model) {
+      uint16_t codeLen = 0;
+      CodeT code = model.Encode(i.first, codeLen);
+      code <<= (code.size() - codeLen);
+      uint16_t tableLen = 0, treeLen = 0;
+      ValueT tableValue = model.Decode(code, tableLen);
+      ValueT treeValue = model.DecodeTree(code, treeLen);
+      BOOST_CHECK(tableValue == i.first && tableLen == codeLen);
+      BOOST_CHECK(treeValue == i.first && treeLen == codeLen);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_HuffmanCodec_canonical)
+{
+  auto setup = setupCodec();
+  auto& dg = setup.second;
+  using CodeT = decltype(setup.first)::code_type;
+  // N.B. the copy shares the nodes with the model of the codec, which is not used afterwards
+  auto model = setup.first.getCodingModel();
+  std::map<int, uint16_t> codeLengths;
+  for (auto const& i : model) {
+    model.Encode(i.first, codeLengths[i.first]);
+  }
+
+  BOOST_REQUIRE(model.GenerateCanonicalCode());
+  // same code lengths, codes of the same length are consecutive
+  uint16_t previousLen = 0;
+  uint64_t previousCode = 0;
+  for (auto const& i : model) {
+    uint16_t codeLen = 0;
+    uint64_t code = model.Encode(i.first, codeLen).to_ullong();
+    BOOST_CHECK(codeLen == codeLengths[i.first]);
+    if (codeLen == previousLen) {
+      BOOST_CHECK(code == previousCode + 1);
+    }
+    previousLen = codeLen;
+    previousCode = code;
+  }
+
+  HuffmanCodec<decltype(model)> codec(model);
+  checkRandom(codec, dg, 100000);
+
+  // the tree has been rebuilt for the canonical codes
+  for (auto const& i : model) {
+    uint16_t codeLen = 0;
+    CodeT code = model.Encode(i.first, codeLen);
+    code <<= (code.size() - codeLen);
+    uint16_t treeLen = 0;
+    BOOST_CHECK(model.DecodeTree(code, treeLen) == i.first && treeLen == codeLen);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_HuffmanCodec_stream)
+{
+  auto setup = setupCodec();
+  auto& dg = setup.second;
+  auto model = setup.first.getCodingModel();
+  using ValueT = decltype(setup.first)::value_type;
+
+  std::vector<ValueT> values(100000);
+  for (auto& value : values) {
+    value = dg();
+  }
+  std::vector<uint8_t> stream;
+  auto streamLength = model.EncodeStream(values.begin(), values.end(), stream);
+  BOOST_CHECK(stream.size() == (streamLength + 7) / 8);
+
+  for (uint16_t tableBits : { 11, 4 }) {
+    model.GenerateDecodingTable(tableBits);
+    std::vector<ValueT> decoded;
+    auto nDecoded = model.DecodeStream(stream.data(), streamLength, std::back_inserter(decoded));
+    BOOST_CHECK(nDecoded == values.size());
+    BOOST_CHECK(decoded == values);
+  }
+}
+
 } // namespace data_compression
 } // namespace o2
@@ -0,0 +1,142 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   test_RANSCodec.cxx
+/// @brief  Test program for the interleaved rANS coding model
+
+#define BOOST_TEST_MODULE RANSCodec unit test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <stdexcept> // exeptions, runtime_error
+#include "../include/DataCompression/dc_primitives.h"
+#include "../include/DataCompression/RANSCodec.h"
+#include "DataGenerator.h"
+
+namespace o2
+{
+namespace data_compression
+{
+
+using DataGenerator_t = o2::test::DataGenerator<int16_t, o2::test::normal_distribution<double>>;
+using Alphabet_t = ContiguousAlphabet<int16_t, -100, 100>;
+using RANSModel_t = RANSModel<ProbabilityModel<Alphabet_t>>;
+
+RANSModel_t createModel(DataGenerator_t& dg)
+{
+  RANSModel_t model;
+  model.init(0.);
+  Alphabet_t alphabet;
+  for (auto s : alphabet) {
+    model.addWeight(s, dg.getProbability(s));
+  }
+  model.normalize();
+  BOOST_REQUIRE(model.GenerateTables());
+  return model;
+}
+
+BOOST_AUTO_TEST_CASE(test_RANSCodec_frequencies)
+{
+  DataGenerator_t dg(-100, 100, 1, 0., 10.);
+  auto model = createModel(dg);
+
+  // the frequencies sum up to the precision and every symbol with a weight can be coded
+  uint32_t sum = 0;
+  for (auto const& i : model) {
+    sum += model.getFrequency(i.first);
+    BOOST_CHECK(i.second <= 0. || model.getFrequency(i.first) > 0);
+  }
+  BOOST_CHECK(model.getScaleBits() >= RANSModel_t::MinScaleBits);
+  BOOST_CHECK(model.getScaleBits() <= RANSModel_t::MaxScaleBits);
+  BOOST_CHECK_EQUAL(sum, uint32_t(1) << model.getScaleBits());
+}
+
+BOOST_AUTO_TEST_CASE(test_RANSCodec_stream)
+{
+  DataGenerator_t dg(-100, 100, 1, 0., 10.);
+  auto model = createModel(dg);
+
+  // lengths which are not multiples of the number of interleaved states
+  for (size_t nValues : { 0, 1, 3, 4, 5, 1000, 100003 }) {
+    std::vector<int16_t> values(nValues);
+    for (auto& value : values) {
+      value = dg();
+    }
+    std::vector<uint8_t> stream;
+    auto streamLength = model.EncodeStream(values.begin(), values.end(), stream);
+    BOOST_CHECK_EQUAL(streamLength, stream.size() * 8);
+
+    std::vector<int16_t> decoded(nValues);
+    BOOST_CHECK_EQUAL(model.DecodeStream(stream.data(), streamLength, decoded.begin()), nValues);
+    BOOST_CHECK(decoded == values);
+  }
+
+  // the coded size is close to the entropy of the distribution
+  std::vector<int16_t> values(100000);
+  double entropy = 0.;
+  for (auto& value : values) {
+    value = dg();
+    entropy -= std::log2(dg.getProbability(value));
+  }
+  std::vector<uint8_t> stream;
+  auto streamLength = model.EncodeStream(values.begin(), values.end(), stream);
+  std::cout << "rANS: " << double(streamLength) / values.size() << " bits per value, entropy "
+            << entropy / values.size() << std::endl;
+  BOOST_CHECK(streamLength < 1.01 * entropy + 256);
+
+  // a truncated stream is detected
+  BOOST_CHECK_THROW(model.DecodeStream(stream.data(), streamLength / 2, values.begin()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_RANSCodec_zeroweight)
+{
+  RANSModel_t model;
+  model.init(0.);
+  model.addWeight(0, 1.);
+  model.addWeight(1, 3.);
+  BOOST_REQUIRE(model.GenerateTables());
+  std::vector<int16_t> values{ 0, 1, 1, 2 };
+  std::vector<uint8_t> stream;
+  BOOST_CHECK_THROW(model.EncodeStream(values.begin(), values.end(), stream), std::range_error);
+
+  RANSModel_t empty;
+  empty.init(0.);
+  BOOST_CHECK(!empty.GenerateTables());
+  BOOST_CHECK_THROW(empty.EncodeStream(values.begin(), values.end(), stream), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_RANSCodec_configuration)
+{
+  DataGenerator_t dg(-100, 100, 1, 0., 10.);
+  auto model = createModel(dg);
+  std::stringstream configuration;
+  BOOST_CHECK(model.write(configuration) > 0);
+
+  RANSModel_t model2;
+  model2.init(0.);
+  BOOST_REQUIRE_EQUAL(model2.read(configuration), 0);
+  BOOST_CHECK_EQUAL(model2.getScaleBits(), model.getScaleBits());
+
+  std::vector<int16_t> values(1000);
+  for (auto& value : values) {
+    value = dg();
+  }
+  std::vector<uint8_t> stream;
+  auto streamLength = model.EncodeStream(values.begin(), values.end(), stream);
+  std::vector<int16_t> decoded(values.size());
+  model2.DecodeStream(stream.data(), streamLength, decoded.begin());
+  BOOST_CHECK(decoded == values);
+}
+
+} // namespace data_compression
+} // namespace o2
@@ -10,10 +10,13 @@
 
 #include "DataCompression/dc_primitives.h"
 #include "DataCompression/HuffmanCodec.h"
+#include "DataCompression/RANSCodec.h"
 #include <bitset>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/string.hpp>
 
+using namespace o2::data_compression;
+
 /**
  * Parameter model definitions
  * - boost mpl vector of alphabets
@@ -33,8 +36,8 @@ using tpccluster_parameter =
  * from the list of alphabet types, but did not manage so far (see below)
  */
 template <typename RepT, int Length, typename Description>
-using Model = o2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<RepT, Length, Description>>,
-                               o2::HuffmanNode<std::bitset<64>>, true>;
+using Model =
+  HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<RepT, Length, Description>>, std::bitset<64>, true>;
 
 using tpccluster_parameter_models =
   boost::mpl::vector<Model<uint16_t, /* */ 6, boost::mpl::string<'p', 'a', 'd', 'r', 'o', 'w'>>,
@@ -45,6 +48,23 @@ using tpccluster_parameter_models =
                      Model<uint16_t, /**/ 16, boost::mpl::string<'c', 'h', 'a', 'r', 'g', 'e'>>,
                      Model<uint16_t, /**/ 10, boost::mpl::string<'q', 'm', 'a', 'x'>>>;
 
+/**
+ * Definition of rANS probability models for the above defined alphabets, to
+ * be used for the parameters with wide alphabets, e.g. pad, time and charge,
+ * where the fractional code lengths of rANS compress better than Huffman codes
+ */
+template <typename RepT, int Length, typename Description>
+using RANSParameterModel = RANSModel<ProbabilityModel<BitRangeContiguousAlphabet<RepT, Length, Description>>>;
+
+using tpccluster_parameter_models_mixed =
+  boost::mpl::vector<Model<uint16_t, /* */ 6, boost::mpl::string<'p', 'a', 'd', 'r', 'o', 'w'>>,
+                     RANSParameterModel<uint16_t, /**/ 14, boost::mpl::string<'p', 'a', 'd'>>,
+                     RANSParameterModel<uint16_t, /**/ 15, boost::mpl::string<'t', 'i', 'm', 'e'>>,
+                     Model<uint16_t, /* */ 8, boost::mpl::string<'s', 'i', 'g', 'm', 'a', 'Y', '2'>>,
+                     Model<uint16_t, /* */ 8, boost::mpl::string<'s', 'i', 'g', 'm', 'a', 'Z', '2'>>,
+                     RANSParameterModel<uint16_t, /**/ 16, boost::mpl::string<'c', 'h', 'a', 'r', 'g', 'e'>>,
+                     RANSParameterModel<uint16_t, /**/ 10, boost::mpl::string<'q', 'm', 'a', 'x'>>>;
+
 /** new approach
   using basemodels = foldtype
     < tpccluster_parameter,
@@ -45,6 +45,9 @@ class EPNReceiverDevice : public FairMQDevice
     /// Discared incomplete timeframes after \p fBufferTimeoutInMs.
     void DiscardIncompleteTimeframes();
 
+    /// Sends the load report to the scheduling flpSender, if any
+    void SendStatus(uint16_t lastTimeframeId);
+
   protected:
     /// Overloads the Run() method of FairMQDevice
     void Run() override;
@@ -55,10 +58,16 @@ class EPNReceiverDevice : public FairMQDevice
     int mNumFLPs = 0; ///< Number of flpSenders
     int mBufferTimeoutInMs = 5000; ///< Time after which incomplete timeframes are dropped
     int mTestMode = 0; ///< Run the device in test mode (only syncSampler+flpSender+epnReceiver)
+    int mIndex = 0; ///< Index of the epnReceiver among other epnReceivers
+    int mBufferSize = 16; ///< Number of timeframes which can be built at the same time
+    int mStatusIntervalInMs = 100; ///< Maximum time between two load reports
+    uint32_t mLatencyInUs = 0; ///< Moving average of the time to build and forward a timeframe
+    std::chrono::steady_clock::time_point mLastStatus;
 
     std::string mInChannelName = "";
     std::string mOutChannelName = "";
     std::string mAckChannelName = "";
+    std::string mStatusChannelName = ""; ///< Load reports, not sent if empty
 };
 
 } // namespace devices
@@ -0,0 +1,81 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_DATAFLOW_EPNSCHEDULER_H_
+#define ALICEO2_DATAFLOW_EPNSCHEDULER_H_
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace o2 {
+namespace data_flow {
+
+/// Load report sent by an epnReceiver to the flpSenders
+struct EPNStatus
+{
+  uint16_t epnIndex = 0;        ///< Index of the epnReceiver
+  uint16_t lastTimeframeId = 0; ///< Id of the last timeframe for which a sub-timeframe was received
+  uint16_t usedSlots = 0;       ///< Timeframes being built
+  uint16_t freeSlots = 0;       ///< Timeframes which can still be buffered
+  uint32_t latencyUs = 0;       ///< Average time to build and forward a timeframe
+};
+
+/// Decision of the scheduling flpSender, shared with the other ones
+struct EPNScheduleDecision
+{
+  uint16_t timeframeId = 0;
+  uint16_t epnIndex = 0;
+};
+
+/// Picks the epnReceiver of each timeframe from their load reports.
+///
+/// The timeframes assigned since the last report of an epnReceiver are
+/// accounted as in flight, so that consecutive timeframes are spread even
+/// if the reports come late. Among the epnReceivers which reported and still
+/// have free slots, the one expected to complete the timeframe first wins,
+/// i.e. the lowest (backlog + 1) * latency, then the one of the round-robin.
+/// Before any report, timeframeId % numEPNs is used.
+class EPNScheduler
+{
+  public:
+    explicit EPNScheduler(int numEPNs);
+
+    /// Accounts a load report
+    void update(const EPNStatus& status);
+
+    /// @return the epnReceiver to which the timeframe has to be sent
+    int assign(uint16_t timeframeId);
+
+    /// @return the number of timeframes queued in or sent to the epnReceiver
+    int backlog(int epn) const;
+
+    /// @return the average latency reported by the epnReceiver, in microseconds
+    uint32_t latency(int epn) const { return mEPNs[epn].status.latencyUs; }
+
+    /// @return true if the epnReceiver sent at least one report
+    bool hasStatus(int epn) const { return mEPNs[epn].hasStatus; }
+
+    int numEPNs() const { return mEPNs.size(); }
+
+  private:
+    struct EPNState {
+      bool hasStatus = false;
+      EPNStatus status;
+      std::deque<uint16_t> inFlight; ///< Timeframes assigned after the last report
+    };
+
+    std::vector<EPNState> mEPNs;
+};
+
+} // namespace data_flow
+} // namespace o2
+
+#endif
@@ -15,9 +15,12 @@
 #include <queue>
 #include <unordered_map>
 #include <chrono>
+#include <memory>
 
 #include <FairMQDevice.h>
 
+#include "DataFlow/EPNScheduler.h"
+
 namespace o2 {
 namespace devices {
 
@@ -26,6 +29,12 @@ namespace devices {
 /// Sub-timeframes are received from the previous step (or generated in test-mode)
 /// and are sent to epnReceivers. Target epnReceiver is determined from the timeframe ID:
 /// targetEpnReceiver = timeframeId % numEPNs (numEPNs is same for every flpSender, although some may be inactive).
+///
+/// With load aware scheduling one flpSender, the leader, receives the load reports of
+/// the epnReceivers, picks the least loaded one for each timeframe and publishes its
+/// decisions. The other flpSenders hold their sub-timeframes until the decision for
+/// them arrives, so that all the sub-timeframes of a timeframe reach the same
+/// epnReceiver. After the schedule timeout they fall back to the round-robin.
 
 class FLPSenderDevice : public FairMQDevice
 {
@@ -45,7 +54,17 @@ class FLPSenderDevice : public FairMQDevice
 
   private:
     /// Sends the "oldest" element from the sub-timeframe container
-    void sendFrontData();
+    /// @return false if the decision for it is not known yet
+    bool sendFrontData();
+
+    /// @return the epnReceiver for the timeframe, -1 if the leader did not decide yet
+    int targetEPN(uint16_t timeframeId, std::chrono::steady_clock::time_point arrival);
+
+    /// Processes the pending load reports (leader) or decisions (followers)
+    void receiveSchedule();
+
+    /// Logs the backlog of each epnReceiver, as seen by the leader
+    void reportBacklog();
 
     std::queue<FairMQParts> mSTFBuffer; ///< Buffer for sub-timeframes
     std::queue<std::chrono::steady_clock::time_point> mArrivalTime; ///< Stores arrival times of sub-timeframes
@@ -61,7 +80,16 @@ class FLPSenderDevice : public FairMQDevice
 
     std::string mInChannelName = "";
     std::string mOutChannelName = "";
+    std::string mStatusChannelName = ""; ///< Load reports of the epnReceivers (leader only)
+    std::string mScheduleChannelName = ""; ///< Decisions of the leader, empty for round-robin
+    bool mScheduleLeader = false; ///< This flpSender takes the scheduling decisions
+    int mScheduleTimeout = 1000; ///< Time after which a follower falls back to round-robin
+    int mBacklogInterval = 5000; ///< Period of the backlog reports (leader only)
     int mLastTimeframeId = -1;
+
+    std::unique_ptr<o2::data_flow::EPNScheduler> mScheduler; ///< Only for the leader
+    std::unordered_map<uint16_t, uint16_t> mDecisions; ///< Decisions received by a follower
+    std::chrono::steady_clock::time_point mLastBacklogReport;
 };
 
 } // namespace devices
@@ -17,13 +17,16 @@
 #include <cstring>
 
 #include <fairmq/FairMQMessage.h>
+#include <fairmq/FairMQParts.h>
+#include <fairmq/FairMQTransportFactory.h>
 
 namespace o2 { namespace dataflow {
 /// Helper class that given a set of FairMQMessage, merges (part of) their
 /// payload into a separate memory area.
 ///
 /// - Append multiple messages via the aggregate method 
-/// - Finalise buffer creation with the finalise call.
+/// - Finalise buffer creation with the finalise call, either into one
+///   buffer or, without copies, into a set of messages.
 template <typename ID>
 class PayloadMerger {
 public:
@@ -104,6 +107,39 @@ public:
     return sum;
   }
 
+  /// Scatter-gather version of the merging above: rather than copying the
+  /// extracted payloads into one buffer, one message per aggregated message
+  /// is added to @out, in the order of aggregation. A message whose payload
+  /// is extracted entirely is moved to @out, otherwise a new message created
+  /// with @transport points to the extracted part and takes ownership of the
+  /// original one, so no payload is copied in either case.
+  /// @return the aggregate size of the payloads, 0 if not complete yet
+  size_t finalise(FairMQParts &out, MergeableId &id, FairMQTransportFactory &transport) {
+    if (mCheckIfComplete(id, mPartsMap) == false) {
+      return 0;
+    }
+    size_t sum = 0;
+    auto range = mPartsMap.equal_range(id);
+    for (auto hi = range.first, he = range.second; hi != he; ++hi) {
+      std::unique_ptr<FairMQMessage> &payload = hi->second;
+      char *data = reinterpret_cast<char *>(payload->GetData());
+      char *part = nullptr;
+      size_t partSize = mExtractPayload(&part, data, payload->GetSize());
+      if (part == data && partSize == payload->GetSize()) {
+        out.AddPart(std::move(payload));
+      } else {
+        // the original message is released when the new one is done
+        out.AddPart(transport.CreateMessage(part, partSize,
+                                            [](void *, void *hint) { delete reinterpret_cast<FairMQMessage *>(hint); },
+                                            payload.release()));
+      }
+      sum += partSize;
+    }
+
+    mPartsMap.erase(id);
+    return sum;
+  }
+
   // Helper method which leaves the payload untouched
   static int64_t fullPayloadExtractor(char **payload,
                                       char *buffer,
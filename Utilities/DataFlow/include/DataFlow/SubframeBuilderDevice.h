@@ -66,6 +66,7 @@ public:
   static constexpr const char* OptionKeyDetector = "detector-name";
   static constexpr const char* OptionKeyFLPId = "flp-id";
   static constexpr const char* OptionKeyStripHBF = "strip-hbf";
+  static constexpr const char* OptionKeyScatterGather = "scatter-gather";
 
   // TODO: this is just a first mockup, remove it
   // Default start time for all the producers is 8/4/1977
@@ -107,6 +108,9 @@ private:
   std::string mOutputChannelName = "";
   size_t mFLPId = 0;
   bool mStripHBF = false;
+  /// send the merged subframes as one header - payload pair per heartbeat
+  /// frame, referring to the received messages, rather than one copy
+  bool mScatterGather = false;
   std::unique_ptr<Merger> mMerger;
 
   uint64_t mHeartbeatStart = DefaultHeartbeatStart;
@@ -25,6 +25,14 @@ void streamTimeframe(std::istream &stream,
                      std::function<void(FairMQParts &parts, char *buffer, size_t size)> onAddPart,
                      std::function<void(FairMQParts &parts)> onSend);
 
+/// Same as above for a timeframe file which is already in memory, e.g.
+/// memory mapped. @a onAddPart gets pointers into @a buffer, nothing is
+/// copied, so the buffer has to outlive the parts created from it.
+/// @return the number of timeframes found in the buffer
+size_t streamTimeframe(const char *buffer, size_t size,
+                       std::function<void(FairMQParts &parts, char *buffer, size_t size)> onAddPart,
+                       std::function<void(FairMQParts &parts)> onSend);
+
 void streamTimeframe(std::ostream &stream, FairMQParts &parts);
 
 } } // end
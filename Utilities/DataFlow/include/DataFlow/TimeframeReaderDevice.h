@@ -12,7 +12,8 @@
 #define ALICEO2_TIMEFRAME_READER_H_
 
 #include "O2Device/O2Device.h"
-#include <fstream>
+#include <string>
+#include <vector>
 
 namespace o2 {
 namespace data_flow {
@@ -38,7 +39,6 @@ public:
 
     std::string      mOutChannelName;
     std::string      mInFileName;
-    std::fstream     mFile;
     std::vector<std::string> mSeen;
 };
 
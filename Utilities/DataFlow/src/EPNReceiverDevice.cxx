@@ -17,6 +17,7 @@
 #include <options/FairMQProgOptions.h>
 
 #include "DataFlow/EPNReceiverDevice.h"
+#include "DataFlow/EPNScheduler.h"
 #include "Headers/DataHeader.h"
 #include "Headers/SubframeMetadata.h"
 #include "O2Device/Compatibility.h"
@@ -40,6 +41,28 @@ void EPNReceiverDevice::InitTask()
   mInChannelName = GetConfig()->GetValue<string>("in-chan-name");
   mOutChannelName = GetConfig()->GetValue<string>("out-chan-name");
   mAckChannelName = GetConfig()->GetValue<string>("ack-chan-name");
+  mIndex = GetConfig()->GetValue<int>("epn-index");
+  mBufferSize = GetConfig()->GetValue<int>("buffer-size");
+  mStatusIntervalInMs = GetConfig()->GetValue<int>("status-interval");
+  mStatusChannelName = GetConfig()->GetValue<string>("status-chan-name");
+}
+
+void EPNReceiverDevice::SendStatus(uint16_t lastTimeframeId)
+{
+  mLastStatus = steady_clock::now();
+  if (mStatusChannelName.empty()) {
+    return;
+  }
+  o2::data_flow::EPNStatus status;
+  status.epnIndex = mIndex;
+  status.lastTimeframeId = lastTimeframeId;
+  status.usedSlots = mTimeframeBuffer.size();
+  status.freeSlots = mBufferSize > (int)mTimeframeBuffer.size() ? mBufferSize - mTimeframeBuffer.size() : 0;
+  status.latencyUs = mLatencyInUs;
+  FairMQMessagePtr msg(NewSimpleMessage(status));
+  if (Send(msg, mStatusChannelName, 0, 0) < 0) {
+    LOG(ERROR) << "Could not send the load report";
+  }
 }
 
 void EPNReceiverDevice::PrintBuffer(const unordered_map<uint16_t, TFBuffer>& buffer) const
@@ -93,6 +116,11 @@ void EPNReceiverDevice::Run()
   std::multimap<TimeframeId, FlpId> flpIds;
 
   while (compatibility::FairMQ13<FairMQDevice>::IsRunning(this)) {
+    // report periodically, so that the schedule knows about idle epnReceivers
+    if (duration_cast<milliseconds>(steady_clock::now() - mLastStatus).count() >= mStatusIntervalInMs) {
+      SendStatus(id);
+    }
+
     FairMQParts subtimeframeParts;
     if (Receive(subtimeframeParts, mInChannelName, 0, 100) <= 0)
       continue;
@@ -176,7 +204,11 @@ void EPNReceiverDevice::Run()
         }
       }
 
+      // the latency includes the time to forward it, so that slow consumers are accounted
+      uint32_t latency = duration_cast<microseconds>(steady_clock::now() - mTimeframeBuffer[id].start).count();
+      mLatencyInUs = mLatencyInUs == 0 ? latency : (7 * mLatencyInUs + latency) / 8;
       mTimeframeBuffer.erase(id);
+      SendStatus(id);
     }
 
     // LOG(WARN) << "Buffer size: " << fTimeframeBuffer.size();
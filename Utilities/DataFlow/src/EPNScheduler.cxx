@@ -0,0 +1,68 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DataFlow/EPNScheduler.h"
+
+#include <tuple>
+
+using namespace o2::data_flow;
+
+EPNScheduler::EPNScheduler(int numEPNs) : mEPNs(numEPNs)
+{
+}
+
+void EPNScheduler::update(const EPNStatus& status)
+{
+  if (status.epnIndex >= mEPNs.size()) {
+    return;
+  }
+  auto& epn = mEPNs[status.epnIndex];
+  epn.hasStatus = true;
+  epn.status = status;
+  // The timeframes up to the last one received are in the reported slots.
+  // Ids are 16 bits and wrap around, hence the signed difference.
+  while (!epn.inFlight.empty() && static_cast<int16_t>(epn.inFlight.front() - status.lastTimeframeId) <= 0) {
+    epn.inFlight.pop_front();
+  }
+}
+
+int EPNScheduler::assign(uint16_t timeframeId)
+{
+  const int numEPNs = mEPNs.size();
+  const int roundRobin = timeframeId % numEPNs;
+  int best = -1;
+  std::tuple<bool, uint64_t> bestLoad;
+  // Start from the round-robin one, so that it wins the ties
+  for (int i = 0; i < numEPNs; ++i) {
+    int candidate = (roundRobin + i) % numEPNs;
+    auto& epn = mEPNs[candidate];
+    if (!epn.hasStatus) {
+      continue;
+    }
+    // Full epnReceivers come last, then by expected time to complete the timeframe
+    bool full = epn.inFlight.size() >= epn.status.freeSlots;
+    uint64_t expected = static_cast<uint64_t>(epn.status.usedSlots + epn.inFlight.size() + 1) * epn.status.latencyUs;
+    auto load = std::make_tuple(full, expected);
+    if (best == -1 || load < bestLoad) {
+      best = candidate;
+      bestLoad = load;
+    }
+  }
+  if (best == -1) {
+    return roundRobin;
+  }
+  mEPNs[best].inFlight.push_back(timeframeId);
+  return best;
+}
+
+int EPNScheduler::backlog(int epn) const
+{
+  return mEPNs[epn].status.usedSlots + mEPNs[epn].inFlight.size();
+}
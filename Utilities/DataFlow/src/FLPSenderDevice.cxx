@@ -35,6 +35,15 @@ void FLPSenderDevice::InitTask()
   mSendDelay = GetConfig()->GetValue<int>("send-delay");
   mInChannelName = GetConfig()->GetValue<string>("in-chan-name");
   mOutChannelName = GetConfig()->GetValue<string>("out-chan-name");
+  mStatusChannelName = GetConfig()->GetValue<string>("status-chan-name");
+  mScheduleChannelName = GetConfig()->GetValue<string>("schedule-chan-name");
+  mScheduleLeader = GetConfig()->GetValue<int>("schedule-leader") != 0;
+  mScheduleTimeout = GetConfig()->GetValue<int>("schedule-timeout");
+  mBacklogInterval = GetConfig()->GetValue<int>("backlog-interval");
+  if (!mScheduleChannelName.empty() && mScheduleLeader) {
+    mScheduler = std::make_unique<o2::data_flow::EPNScheduler>(mNumEPNs);
+  }
+  mLastBacklogReport = steady_clock::now();
 }
 
 
@@ -51,39 +60,123 @@ void FLPSenderDevice::Run()
     // - Add the current FLP id to the SubtimeframeMetadata
     // - Forward to the EPN the whole subtimeframe
     FairMQParts subtimeframeParts;
-    if (Receive(subtimeframeParts, mInChannelName, 0, 100) <= 0)
-      continue;
-
-    assert(subtimeframeParts.Size() != 0);
-    assert(subtimeframeParts.Size() >= 2);
-    const auto* dh = o2::header::get<header::DataHeader*>(subtimeframeParts.At(0)->GetData());
-    assert(strncmp(dh->dataDescription.str, "SUBTIMEFRAMEMD", 16) == 0);
-
-    SubframeMetadata* sfm = reinterpret_cast<SubframeMetadata*>(subtimeframeParts.At(1)->GetData());
-    sfm->flpIndex = mIndex;
+    // do not wait for long when sub-timeframes wait for their decision
+    if (Receive(subtimeframeParts, mInChannelName, 0, mSTFBuffer.empty() ? 100 : 1) > 0) {
+      assert(subtimeframeParts.Size() != 0);
+      assert(subtimeframeParts.Size() >= 2);
+      const auto* dh = o2::header::get<header::DataHeader*>(subtimeframeParts.At(0)->GetData());
+      assert(strncmp(dh->dataDescription.str, "SUBTIMEFRAMEMD", 16) == 0);
+
+      SubframeMetadata* sfm = reinterpret_cast<SubframeMetadata*>(subtimeframeParts.At(1)->GetData());
+      sfm->flpIndex = mIndex;
+
+      mArrivalTime.push(steady_clock::now());
+      mSTFBuffer.push(move(subtimeframeParts));
+    }
 
-    mArrivalTime.push(steady_clock::now());
-    mSTFBuffer.push(move(subtimeframeParts));
+    receiveSchedule();
 
     // if offset is 0 - send data out without staggering.
-    assert(mSTFBuffer.size() > 0);
+    while (!mSTFBuffer.empty()) {
+      if (mSendOffset != 0 && duration_cast<milliseconds>(steady_clock::now() - mArrivalTime.front()).count() < (mSendDelay * mSendOffset)) {
+        // LOG(INFO) << "buffering...";
+        break;
+      }
+      if (!sendFrontData()) {
+        break;
+      }
+    }
 
-    if (mSendOffset == 0 && mSTFBuffer.size() > 0) {
-      sendFrontData();
-    } else if (mSTFBuffer.size() > 0) {
-      if (duration_cast<milliseconds>(steady_clock::now() - mArrivalTime.front()).count() >= (mSendDelay * mSendOffset)) {
-        sendFrontData();
+    if (mScheduler && duration_cast<milliseconds>(steady_clock::now() - mLastBacklogReport).count() >= mBacklogInterval) {
+      reportBacklog();
+    }
+  }
+}
+
+void FLPSenderDevice::receiveSchedule()
+{
+  if (mScheduleChannelName.empty()) {
+    return;
+  }
+  if (mScheduler) {
+    FairMQMessagePtr msg(NewMessage());
+    while (Receive(msg, mStatusChannelName, 0, 0) > 0) {
+      if (msg->GetSize() == sizeof(o2::data_flow::EPNStatus)) {
+        mScheduler->update(*static_cast<o2::data_flow::EPNStatus*>(msg->GetData()));
       } else {
-        // LOG(INFO) << "buffering...";
+        LOG(ERROR) << "Unexpected EPN status of " << msg->GetSize() << " bytes";
       }
+      msg = NewMessage();
+    }
+    return;
+  }
+  FairMQMessagePtr msg(NewMessage());
+  while (Receive(msg, mScheduleChannelName, 0, 0) > 0) {
+    if (msg->GetSize() == sizeof(o2::data_flow::EPNScheduleDecision)) {
+      auto decision = static_cast<o2::data_flow::EPNScheduleDecision*>(msg->GetData());
+      mDecisions[decision->timeframeId] = decision->epnIndex;
+    } else {
+      LOG(ERROR) << "Unexpected schedule decision of " << msg->GetSize() << " bytes";
     }
+    msg = NewMessage();
   }
 }
 
-inline void FLPSenderDevice::sendFrontData()
+int FLPSenderDevice::targetEPN(uint16_t timeframeId, steady_clock::time_point arrival)
+{
+  // round-robin
+  if (mScheduleChannelName.empty()) {
+    return timeframeId % mNumEPNs;
+  }
+  // the leader decides and shares the decision
+  if (mScheduler) {
+    o2::data_flow::EPNScheduleDecision decision;
+    decision.timeframeId = timeframeId;
+    decision.epnIndex = mScheduler->assign(timeframeId);
+    FairMQMessagePtr msg(NewSimpleMessage(decision));
+    if (Send(msg, mScheduleChannelName, 0, 0) < 0) {
+      LOG(ERROR) << "Failed to publish the decision for timeframe #" << timeframeId;
+    }
+    return decision.epnIndex;
+  }
+  // the followers apply it
+  auto decision = mDecisions.find(timeframeId);
+  if (decision != mDecisions.end()) {
+    int direction = decision->second;
+    mDecisions.erase(decision);
+    return direction;
+  }
+  if (duration_cast<milliseconds>(steady_clock::now() - arrival).count() < mScheduleTimeout) {
+    return -1;
+  }
+  LOG(WARN) << "No schedule decision for timeframe #" << timeframeId << " after " << mScheduleTimeout
+            << " milliseconds, falling back to round-robin";
+  return timeframeId % mNumEPNs;
+}
+
+void FLPSenderDevice::reportBacklog()
+{
+  for (int i = 0; i < mScheduler->numEPNs(); ++i) {
+    if (!mScheduler->hasStatus(i)) {
+      LOG(INFO) << "EPN[" << i << "] no status received";
+      continue;
+    }
+    LOG(INFO) << "EPN[" << i << "] backlog: " << mScheduler->backlog(i) << " timeframes, latency: " << mScheduler->latency(i) << " us";
+  }
+  mLastBacklogReport = steady_clock::now();
+}
+
+inline bool FLPSenderDevice::sendFrontData()
 {
   SubframeMetadata *sfm = static_cast<SubframeMetadata*>(mSTFBuffer.front().At(1)->GetData());
   uint16_t currentTimeframeId = o2::data_flow::timeframeIdFromTimestamp(sfm->startTime, sfm->duration);
+
+  // for which EPN is the message?
+  int direction = targetEPN(currentTimeframeId, mArrivalTime.front());
+  if (direction < 0) {
+    return false;
+  }
+
   if (mLastTimeframeId != -1) {
     if (currentTimeframeId == mLastTimeframeId) {
       LOG(ERROR) << "Sent same consecutive timeframe ids\n";
@@ -91,11 +184,10 @@ inline void FLPSenderDevice::sendFrontData()
   }
   mLastTimeframeId = currentTimeframeId;
 
-  // for which EPN is the message?
-  int direction = currentTimeframeId % mNumEPNs;
   if (Send(mSTFBuffer.front(), mOutChannelName, direction, 0) < 0) {
     LOG(ERROR) << "Failed to queue sub-timeframe #" << currentTimeframeId << " to EPN[" << direction << "]";
   }
   mSTFBuffer.pop();
   mArrivalTime.pop();
+  return true;
 }
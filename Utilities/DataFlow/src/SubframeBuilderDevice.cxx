@@ -45,6 +45,7 @@ void o2::data_flow::SubframeBuilderDevice::InitTask()
   mOutputChannelName = GetConfig()->GetValue<std::string>(OptionKeyOutputChannelName);
   mFLPId= GetConfig()->GetValue<size_t>(OptionKeyFLPId);
   mStripHBF= GetConfig()->GetValue<bool>(OptionKeyStripHBF);
+  mScatterGather = GetConfig()->GetValue<bool>(OptionKeyScatterGather);
 
   LOG(INFO) << "Obtaining data from DataPublisher\n";
   // Now that we have all the information lets create the policies to do the 
@@ -83,8 +84,10 @@ bool o2::data_flow::SubframeBuilderDevice::BuildAndSendFrame(FairMQParts &inPart
 {
   auto id = mMerger->aggregate(inParts.At(1));
 
-  char **outBuffer;
-  size_t outSize = mMerger->finalise(outBuffer, id);
+  char *outBuffer = nullptr;
+  FairMQParts outParts;
+  size_t outSize = mScatterGather ? mMerger->finalise(outParts, id, *GetChannel(mOutputChannelName, 0).Transport())
+                                  : mMerger->finalise(&outBuffer, id);
   // In this case we do not have enough subtimeframes for id,
   // so we simply return.
   if (outSize == 0)
@@ -118,10 +121,17 @@ bool o2::data_flow::SubframeBuilderDevice::BuildAndSendFrame(FairMQParts &inPart
   O2Message outgoing;
   o2::base::addDataBlock(outgoing, dh, NewSimpleMessage(md));
 
-  // Add the actual merged payload.
-  o2::base::addDataBlock(outgoing, payloadheader,
-                         NewMessage(*outBuffer, outSize,
-                                    [](void* data, void* hint) { delete[] reinterpret_cast<char*>(hint); }, *outBuffer));
+  // Add the actual merged payload, or the parts of it, each with its own
+  // header, in scatter-gather mode.
+  if (mScatterGather) {
+    for (int i = 0; i < outParts.Size(); ++i) {
+      o2::base::addDataBlock(outgoing, payloadheader, std::move(outParts.At(i)));
+    }
+  } else {
+    o2::base::addDataBlock(outgoing, payloadheader,
+                           NewMessage(outBuffer, outSize,
+                                      [](void* data, void* hint) { delete[] reinterpret_cast<char*>(hint); }, outBuffer));
+  }
   // send message
   Send(outgoing, mOutputChannelName.c_str());
   // FIXME: do we actually need this? outgoing should go out of scope
@@ -168,6 +168,48 @@ void streamTimeframe(std::istream &stream,
   }
 }
 
+size_t streamTimeframe(const char *buffer, size_t size,
+                       std::function<void(FairMQParts &parts, char *buffer, size_t size)> onAddPart,
+                       std::function<void(FairMQParts &parts)> onSend) {
+  // The same sequence as the stream parser above: header - payload pairs,
+  // a timeframe ends with the TIMEFRAMEINDEX pair. The parts point into the
+  // buffer, the DataHeader is copied out only for the checks, as it is not
+  // necessarily aligned in the buffer.
+  size_t position = 0;
+  size_t nTimeframes = 0;
+  FairMQParts parts;
+  DataHeader dh;
+  while (position < size) {
+    if (size - position < sizeof(DataHeader)) {
+      throw std::runtime_error("Premature end of stream");
+    }
+    memcpy(&dh, buffer + position, sizeof(DataHeader));
+    if (dh.headerSize < sizeof(DataHeader)) {
+      std::ostringstream str;
+      str << "Bad header size. Should be greater then "
+          << sizeof(DataHeader)
+          << ". Found " << dh.headerSize << "\n";
+      throw std::runtime_error(str.str());
+    }
+    if (size - position < dh.headerSize + dh.payloadSize) {
+      throw std::runtime_error("Unexpected end of file");
+    }
+    onAddPart(parts, const_cast<char *>(buffer + position), dh.headerSize);
+    position += dh.headerSize;
+    onAddPart(parts, const_cast<char *>(buffer + position), dh.payloadSize);
+    position += dh.payloadSize;
+    if (dh == DataDescription("TIMEFRAMEINDEX")) {
+      onSend(parts);
+      parts.fParts.clear();
+      ++nTimeframes;
+    }
+  }
+  if (parts.Size() != 0) {
+    throw std::runtime_error("Premature end of stream");
+  }
+  return nTimeframes;
+}
+
 void streamTimeframe(std::ostream &stream, FairMQParts &parts) {
   if (parts.Size() < 2)
   {
@@ -15,6 +15,12 @@
 #include "Headers/SubframeMetadata.h"
 #include "Headers/DataHeader.h"
 #include <options/FairMQProgOptions.h>
+#include <memory>
+#include <stdexcept>
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
 
 using DataHeader = o2::header::DataHeader;
 
@@ -23,7 +29,6 @@ namespace o2 { namespace data_flow {
 TimeframeReaderDevice::TimeframeReaderDevice()
   : O2Device{}
   , mOutChannelName{}
-  , mFile{}
 {
 }
 
@@ -34,13 +39,56 @@ void TimeframeReaderDevice::InitTask()
   mSeen.clear();
 }
 
+namespace {
+// A memory mapped timeframe file, unmapped when the device and all the
+// messages referring to it are done with it.
+struct MappedFile {
+  MappedFile(const std::string &filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Unable to open " + filename);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      throw std::runtime_error("Unable to stat " + filename);
+    }
+    if (st.st_size > 0) {
+      void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Unable to map " + filename);
+      }
+      madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+      data = reinterpret_cast<const char *>(mapped);
+      size = st.st_size;
+    }
+    close(fd);
+  }
+  ~MappedFile() {
+    if (data) {
+      munmap(const_cast<char *>(data), size);
+    }
+  }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *data = nullptr;
+  size_t size = 0;
+};
+}
+
 bool TimeframeReaderDevice::ConditionalRun()
 {
-  auto addPartFn = [this](FairMQParts &parts, char *buffer, size_t size) {
+  // The file is memory mapped and the messages refer to its pages, every
+  // message holds a reference to the mapping, which is released by the
+  // transport once the message has been sent.
+  std::shared_ptr<MappedFile> file;
+  auto addPartFn = [this, &file](FairMQParts &parts, char *buffer, size_t size) {
         parts.AddPart(this->NewMessage(buffer,
                                        size,
-                                       [](void* data, void* hint) { delete[] (char*)data; },
-                                       nullptr));
+                                       [](void* data, void* hint) { delete reinterpret_cast<std::shared_ptr<MappedFile>*>(hint); },
+                                       new std::shared_ptr<MappedFile>(file)));
   };
   auto sendFn = [this](FairMQParts &parts) {this->Send(parts, this->mOutChannelName);};
 
@@ -49,14 +97,16 @@ bool TimeframeReaderDevice::ConditionalRun()
   std::vector<std::string> files;
   files.push_back(mInFileName);
   for (auto &&fn : files) {
-    mFile.open(fn, std::ofstream::in | std::ofstream::binary);
     try {
-      streamTimeframe(mFile,
+      file = std::make_shared<MappedFile>(fn);
+      streamTimeframe(file->data,
+                      file->size,
                       addPartFn,
                       sendFn);
     } catch(std::runtime_error &e) {
       LOG(ERROR) << e.what() << "\n";
     }
+    file.reset();
     mSeen.push_back(fn);
   }
 
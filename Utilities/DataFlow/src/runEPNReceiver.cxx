@@ -30,7 +30,11 @@ void addCustomOptions(bpo::options_description& options)
     ("test-mode", bpo::value<int>()->default_value(0), "Run in test mode")
     ("in-chan-name", bpo::value<std::string>()->default_value("stf2"), "Name of the input channel (sub-time frames)")
     ("out-chan-name", bpo::value<std::string>()->default_value("tf"), "Name of the output channel (time frames)")
-    ("ack-chan-name", bpo::value<std::string>()->default_value("ack"), "Name of the acknowledgement channel");
+    ("ack-chan-name", bpo::value<std::string>()->default_value("ack"), "Name of the acknowledgement channel")
+    ("epn-index", bpo::value<int>()->default_value(0), "EPN Index, as seen by the FLP scheduling")
+    ("buffer-size", bpo::value<int>()->default_value(16), "Number of timeframes which can be built at the same time")
+    ("status-interval", bpo::value<int>()->default_value(100), "Maximum time in milliseconds between two load reports")
+    ("status-chan-name", bpo::value<std::string>()->default_value(""), "Name of the channel of the load reports, none if empty");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
@@ -25,7 +25,12 @@ void addCustomOptions(bpo::options_description& options)
     ("send-offset", bpo::value<int>()->default_value(0), "Offset for staggered sending")
     ("send-delay", bpo::value<int>()->default_value(8), "Delay for staggered sending")
     ("in-chan-name", bpo::value<std::string>()->default_value("stf1"), "Name of the input channel (sub-time frames)")
-    ("out-chan-name", bpo::value<std::string>()->default_value("stf2"), "Name of the output channel (sub-time frames)");
+    ("out-chan-name", bpo::value<std::string>()->default_value("stf2"), "Name of the output channel (sub-time frames)")
+    ("status-chan-name", bpo::value<std::string>()->default_value("status"), "Name of the channel of the EPN load reports (schedule leader)")
+    ("schedule-chan-name", bpo::value<std::string>()->default_value(""), "Name of the channel of the schedule decisions, round-robin if empty")
+    ("schedule-leader", bpo::value<int>()->default_value(0), "Take the schedule decisions for all the FLPs")
+    ("schedule-timeout", bpo::value<int>()->default_value(1000), "Time in milliseconds after which a follower falls back to round-robin")
+    ("backlog-interval", bpo::value<int>()->default_value(5000), "Period in milliseconds of the EPN backlog reports (schedule leader)");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
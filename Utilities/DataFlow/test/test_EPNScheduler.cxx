@@ -0,0 +1,94 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Utilities DataFlowTest
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "DataFlow/EPNScheduler.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::data_flow;
+
+EPNStatus makeStatus(uint16_t epn, uint16_t lastTimeframeId, uint16_t usedSlots, uint16_t freeSlots, uint32_t latency)
+{
+  EPNStatus status;
+  status.epnIndex = epn;
+  status.lastTimeframeId = lastTimeframeId;
+  status.usedSlots = usedSlots;
+  status.freeSlots = freeSlots;
+  status.latencyUs = latency;
+  return status;
+}
+
+BOOST_AUTO_TEST_CASE(EPNSchedulerRoundRobin)
+{
+  // Without any report we behave as before
+  EPNScheduler scheduler(4);
+  for (uint16_t id = 0; id < 10; ++id) {
+    BOOST_CHECK_EQUAL(scheduler.assign(id), id % 4);
+  }
+  BOOST_CHECK_EQUAL(scheduler.hasStatus(0), false);
+  BOOST_CHECK_EQUAL(scheduler.backlog(0), 0);
+
+  // Identical epnReceivers get the round-robin
+  for (uint16_t epn = 0; epn < 4; ++epn) {
+    scheduler.update(makeStatus(epn, 9, 0, 8, 100));
+  }
+  for (uint16_t id = 10; id < 14; ++id) {
+    BOOST_CHECK_EQUAL(scheduler.assign(id), id % 4);
+  }
+  // Reports out of range are ignored
+  scheduler.update(makeStatus(7, 9, 0, 8, 100));
+}
+
+BOOST_AUTO_TEST_CASE(EPNSchedulerLoad)
+{
+  EPNScheduler scheduler(3);
+  scheduler.update(makeStatus(0, 100, 6, 2, 1000));
+  scheduler.update(makeStatus(1, 100, 0, 8, 1000));
+  scheduler.update(makeStatus(2, 100, 0, 8, 2000));
+
+  // The busy epnReceiver 0 is skipped and the slow 2 gets half as many
+  // timeframes as 1
+  int counts[3] = { 0, 0, 0 };
+  for (uint16_t id = 101; id < 110; ++id) {
+    counts[scheduler.assign(id)]++;
+  }
+  BOOST_CHECK_EQUAL(counts[0], 0);
+  BOOST_CHECK_EQUAL(counts[1], 6);
+  BOOST_CHECK_EQUAL(counts[2], 3);
+  BOOST_CHECK_EQUAL(scheduler.backlog(1), 6);
+  BOOST_CHECK_EQUAL(scheduler.latency(2), 2000);
+
+  // A report accounts the timeframes received in its slots
+  scheduler.update(makeStatus(1, 105, 2, 6, 1000));
+  BOOST_CHECK_EQUAL(scheduler.backlog(1), 4);
+
+  // Full epnReceivers come last, whatever their latency
+  scheduler.update(makeStatus(0, 109, 8, 0, 10));
+  scheduler.update(makeStatus(2, 109, 8, 0, 10));
+  BOOST_CHECK_EQUAL(scheduler.assign(110), 1);
+  BOOST_CHECK_EQUAL(scheduler.assign(111), 1);
+}
+
+BOOST_AUTO_TEST_CASE(EPNSchedulerWrapAround)
+{
+  // Timeframe ids are 16 bits
+  EPNScheduler scheduler(2);
+  scheduler.update(makeStatus(0, 65530, 0, 8, 100));
+  scheduler.update(makeStatus(1, 65530, 0, 0, 100));
+  for (uint16_t id : { 65534, 65535, 0, 1 }) {
+    BOOST_CHECK_EQUAL(scheduler.assign(id), 0);
+  }
+  BOOST_CHECK_EQUAL(scheduler.backlog(0), 4);
+  scheduler.update(makeStatus(0, 0, 0, 8, 100));
+  BOOST_CHECK_EQUAL(scheduler.backlog(0), 1);
+}
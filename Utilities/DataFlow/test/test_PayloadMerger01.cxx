@@ -79,3 +79,43 @@ BOOST_AUTO_TEST_CASE(PayloadMergerTest) {
     BOOST_CHECK(finalBuf[i] == ((i % partSize) == 0 ? 127 : 1));
   }
 }
+
+BOOST_AUTO_TEST_CASE(PayloadMergerScatterGatherTest) {
+  auto zmq = FairMQTransportFactory::CreateTransportFactory("zeromq");
+
+  auto checkIfComplete = [](SubframeId id, o2::dataflow::PayloadMerger<SubframeId>::MessageMap &m) -> bool {
+    return m.count(id) >= 3;
+  };
+  auto makeId = [](std::unique_ptr<FairMQMessage> &msg) {
+    auto header = reinterpret_cast<o2::header::HeartbeatHeader const*>(msg->GetData());
+    return o2::dataflow::makeIdFromHeartbeatHeader(*header, 0, 2);
+  };
+
+  // One part per aggregated message, referring to the original payloads
+  o2::dataflow::PayloadMerger<SubframeId> merger(makeId, checkIfComplete, o2::dataflow::extractDetectorPayloadStrip);
+  FairMQParts parts;
+  auto id = fakeAddition(merger, zmq, 1);
+  fakeAddition(merger, zmq, 1);
+  BOOST_CHECK(merger.finalise(parts, id, *zmq) == 0); // Not enough parts, not merging yet.
+  id = fakeAddition(merger, zmq, 1);
+  size_t finalSize = merger.finalise(parts, id, *zmq);
+  size_t partSize = (1000-sizeof(HeartbeatHeader) - sizeof(HeartbeatTrailer));
+  BOOST_CHECK(finalSize == 3*partSize);
+  BOOST_REQUIRE(parts.Size() == 3);
+  for (int p = 0; p < parts.Size(); ++p) {
+    BOOST_REQUIRE(parts.At(p)->GetSize() == partSize);
+    auto data = reinterpret_cast<char const*>(parts.At(p)->GetData());
+    for (size_t i = 0; i < partSize; ++i) {
+      BOOST_CHECK(data[i] == (i == 0 ? 127 : 1));
+    }
+  }
+
+  // Without extraction, the messages are moved
+  o2::dataflow::PayloadMerger<SubframeId> fullMerger(makeId, checkIfComplete);
+  FairMQParts fullParts;
+  for (int i = 0; i < 3; ++i) {
+    id = fakeAddition(fullMerger, zmq, 1);
+  }
+  BOOST_CHECK(fullMerger.finalise(fullParts, id, *zmq) == 3000);
+  BOOST_CHECK(fullParts.Size() == 3);
+}
@@ -60,4 +60,35 @@ main(int argc, char **argv) {
     LOG(ERROR) << e.what() << std::endl;
     exit(1);
   }
+
+  // The same timeframe parsed in place, the parts must point into the buffer
+  size_t parsedSize = 0;
+  auto onAddPartsInPlace = [&testBuffer, &testBufferSize, &parsedSize](FairMQParts &p, char *buffer, size_t size) {
+    if (buffer < testBuffer.get() || buffer + size > testBuffer.get() + testBufferSize) {
+      LOG(ERROR) << "Part is not in the input buffer" << std::endl;
+      exit(1);
+    }
+    parsedSize += size;
+  };
+  try {
+    if (o2::data_flow::streamTimeframe(testBuffer.get(), testBufferSize, onAddPartsInPlace, onSend) != 1) {
+      LOG(ERROR) << "Expected one timeframe" << std::endl;
+      exit(1);
+    }
+  } catch(std::runtime_error &e) {
+    LOG(ERROR) << e.what() << std::endl;
+    exit(1);
+  }
+  if (parsedSize != testBufferSize) {
+    LOG(ERROR) << "Timeframe not parsed completely" << std::endl;
+    exit(1);
+  }
+
+  // A truncated timeframe is an error
+  try {
+    o2::data_flow::streamTimeframe(testBuffer.get(), testBufferSize - 1, onAddPartsInPlace, onSend);
+    LOG(ERROR) << "Truncated timeframe not detected" << std::endl;
+    exit(1);
+  } catch(std::runtime_error &e) {
+  }
 }
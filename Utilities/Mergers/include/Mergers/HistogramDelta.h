@@ -0,0 +1,91 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_HISTOGRAMDELTA_H
+#define ALICEO2_HISTOGRAMDELTA_H
+
+/// \file HistogramDelta.h
+/// \brief Definition of the sparse differences of histograms which can be sent to Mergers.
+
+#include <TObject.h>
+#include <TH1.h>
+
+#include <memory>
+#include <vector>
+
+namespace o2
+{
+namespace experimental::mergers
+{
+
+/// \brief Changes of a histogram since the previous HistogramDelta sent by a producer.
+///
+/// The first delta of a producer (the key frame) carries the full histogram, the following ones only
+/// the bins which have changed, with the differences of their contents (and squared weights) and of
+/// the statistics. Mergers receiving deltas rebuild the histograms of their inputs before merging them.
+/// Deltas are produced with HistogramDeltaEncoder.
+class HistogramDelta : public TObject
+{
+ public:
+  HistogramDelta() = default;
+  /// \brief Creates a key frame, taking the ownership of histogram.
+  explicit HistogramDelta(TH1* histogram) : mKeyFrame(histogram) {}
+  ~HistogramDelta() override;
+  HistogramDelta(const HistogramDelta&) = delete;
+  HistogramDelta& operator=(const HistogramDelta&) = delete;
+
+  bool isKeyFrame() const { return mKeyFrame != nullptr; }
+  /// \brief Gives away the histogram of a key frame.
+  TH1* releaseKeyFrame();
+
+  /// \brief Adds the difference of a (global) bin.
+  void addBin(int bin, double content, double sumw2);
+  /// \brief Sets the differences of the statistics and of the number of entries.
+  void setStats(const std::vector<double>& stats, double entries);
+
+  size_t getNBins() const { return mBins.size(); }
+
+  /// \brief Adds the differences to histogram, which must have the binning of the key frame.
+  void applyTo(TH1& histogram) const;
+
+ private:
+  TH1* mKeyFrame = nullptr;      // full histogram of a key frame, owned
+  std::vector<int> mBins;        // global bins which have changed
+  std::vector<double> mContents; // differences of the contents of mBins
+  std::vector<double> mSumw2;    // differences of the squared weights of mBins
+  std::vector<double> mStats;    // differences of the statistics, as in TH1::GetStats
+  double mEntries = 0;           // difference of the number of entries
+
+  ClassDefOverride(HistogramDelta, 1);
+};
+
+/// \brief Producer-side encoder of the successive states of a histogram into HistogramDeltas.
+///
+/// It keeps a copy of the bins of the last encoded state. The histogram must not be reset between
+/// two encodings: the deltas already are differences. A key frame is sent again if the binning changes.
+class HistogramDeltaEncoder
+{
+ public:
+  std::unique_ptr<HistogramDelta> encode(const TH1& histogram);
+
+ private:
+  void keep(const TH1& histogram);
+
+  std::vector<double> mContents;
+  std::vector<double> mSumw2;
+  std::vector<double> mStats;
+  double mEntries = 0;
+  bool mHasState = false;
+};
+
+} // namespace experimental::mergers
+} // namespace o2
+
+#endif //ALICEO2_HISTOGRAMDELTA_H
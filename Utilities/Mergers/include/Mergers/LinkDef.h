@@ -16,5 +16,6 @@
 
 #pragma link C++ class o2::experimental::mergers::MergeInterface + ;
 #pragma link C++ class o2::experimental::mergers::MergeInterfaceOverrideExample + ;
+#pragma link C++ class o2::experimental::mergers::HistogramDelta + ;
 
 #endif
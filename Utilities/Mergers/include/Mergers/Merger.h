@@ -25,6 +25,7 @@
 #include <TObject.h>
 
 #include <memory>
+#include <vector>
 
 namespace o2
 {
@@ -52,6 +53,12 @@ class Merger : public framework::Task
   std::function<void()> prepareTimerCallback(framework::InitContext& ictx) const;
   std::vector<TObject*> unpackObjects(TObject* obj);
   void mergeCache();
+  /// \brief Merges the groups of inputs with updated objects and the partial results of all the groups.
+  void mergeCacheIncrementally();
+  /// \brief Merges objects into target (binwise). Can be called by several threads for different targets.
+  void mergeObjects(TObject* target, const std::vector<TObject*>& objects);
+  /// \brief Merges objects into target, in parallel in groups whose partial results are merged into target.
+  void mergeObjectsInParallel(TObject* target, const std::vector<TObject*>& objects);
   void publish(framework::DataAllocator& allocator);
 
   void cleanCacheAfterMerging();
@@ -64,6 +71,8 @@ class Merger : public framework::Task
   header::DataHeader::SubSpecificationType mSubSpec;
   MergerCache mCache;
   std::unique_ptr<TObject> mMergedObjects;
+  // merged objects of each group of inputs, with ParallelMerging::TreeReduction and OwnershipMode::Full
+  std::vector<std::unique_ptr<TObject>> mPartialResults;
   MergerConfig mConfig;
 };
 
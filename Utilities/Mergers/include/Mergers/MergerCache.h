@@ -19,6 +19,7 @@
 #include <Framework/InputRecord.h>
 
 #include <TObject.h>
+#include <TH1.h>
 
 #include <memory>
 #include <vector>
@@ -29,6 +30,8 @@ namespace o2
 namespace experimental::mergers
 {
 
+class HistogramDelta;
+
 /// \brief Merger cache to store input objects before merging them.
 class MergerCache
 {
@@ -42,6 +45,9 @@ class MergerCache
   struct CacheEntryQueue {
     std::deque<CacheEntry> deque;
     bool was_updated = false;
+    // histogram the HistogramDeltas of this input are applied to, kept when the cache is cleared.
+    // It is the state of the producer's histogram when the cache overwrites, or an empty histogram otherwise.
+    std::unique_ptr<TH1> delta_base;
   };
 
  public:
@@ -76,6 +82,9 @@ class MergerCache
   /// \brief Initializes the cache by seeing the size and contents of DPL's InputRecord
   void init(const framework::InputRecord& inputs);
 
+  /// \brief Rebuilds the histogram of an input from a HistogramDelta.
+  std::unique_ptr<TObject, void (*)(TObject*)> applyDelta(CacheEntryQueue& queue, HistogramDelta& delta);
+
   static void deleteTCollections(TObject* obj);
 
   std::vector<CacheEntryQueue> mCache;
@@ -63,6 +63,13 @@ enum class UnpackingMethod {
   TCollection,       // NOT SUPPORTED YET. Merger treats each object as TCollection and merges each member accordingly. todo
 };
 
+enum class ParallelMerging {
+  Off,          // Objects are merged one after another by the Merger's thread.
+  TreeReduction // Objects are merged in parallel in N groups (param), the partial results being merged together.
+                // With OwnershipMode::Full, the partial results of the groups of inputs are kept and only the groups
+                // with updated inputs are merged again.
+};
+
 template <typename V, typename P = double>
 struct ConfigEntry {
   V value;
@@ -78,6 +85,7 @@ struct MergerConfig {
   ConfigEntry<PublicationDecision> publicationDecision = { PublicationDecision::WhenXInputsUpdated, 0.999999 };
   ConfigEntry<TopologySize, int> topologySize = { TopologySize::NumberOfLayers, 1 };
   ConfigEntry<UnpackingMethod> unpackingMethod = { UnpackingMethod::NoUnpackingNeeded };
+  ConfigEntry<ParallelMerging, int> parallelMerging = { ParallelMerging::Off, 1 };
 };
 
 } // namespace experimental::mergers
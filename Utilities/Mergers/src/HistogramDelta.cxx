@@ -0,0 +1,121 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HistogramDelta.cxx
+/// \brief Implementation of the sparse differences of histograms which can be sent to Mergers.
+
+#include "Mergers/HistogramDelta.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace o2
+{
+namespace experimental::mergers
+{
+
+HistogramDelta::~HistogramDelta()
+{
+  delete mKeyFrame;
+}
+
+TH1* HistogramDelta::releaseKeyFrame()
+{
+  auto keyFrame = mKeyFrame;
+  mKeyFrame = nullptr;
+  return keyFrame;
+}
+
+void HistogramDelta::addBin(int bin, double content, double sumw2)
+{
+  mBins.push_back(bin);
+  mContents.push_back(content);
+  mSumw2.push_back(sumw2);
+}
+
+void HistogramDelta::setStats(const std::vector<double>& stats, double entries)
+{
+  mStats = stats;
+  mEntries = entries;
+}
+
+void HistogramDelta::applyTo(TH1& histogram) const
+{
+  const int nCells = histogram.GetNcells();
+  const bool sumw2 = histogram.GetSumw2N() > 0;
+  for (size_t i = 0; i < mBins.size(); i++) {
+    if (mBins[i] < 0 || mBins[i] >= nCells) {
+      throw std::runtime_error("Bin " + std::to_string(mBins[i]) + " of the delta is out of the histogram '" + histogram.GetName() + "'.");
+    }
+    histogram.AddBinContent(mBins[i], mContents[i]);
+    if (sumw2) {
+      histogram.GetSumw2()->fArray[mBins[i]] += mSumw2[i];
+    }
+  }
+
+  std::vector<double> stats(TH1::kNstat, 0);
+  histogram.GetStats(stats.data());
+  for (size_t i = 0; i < mStats.size() && i < stats.size(); i++) {
+    stats[i] += mStats[i];
+  }
+  histogram.PutStats(stats.data());
+  histogram.SetEntries(histogram.GetEntries() + mEntries);
+}
+
+std::unique_ptr<HistogramDelta> HistogramDeltaEncoder::encode(const TH1& histogram)
+{
+  if (!mHasState || histogram.GetNcells() != int(mContents.size())) {
+    keep(histogram);
+    return std::make_unique<HistogramDelta>(static_cast<TH1*>(histogram.Clone()));
+  }
+
+  auto delta = std::make_unique<HistogramDelta>();
+  const bool sumw2 = histogram.GetSumw2N() > 0;
+  for (int bin = 0; bin < histogram.GetNcells(); bin++) {
+    const double content = histogram.GetBinContent(bin);
+    const double binSumw2 = sumw2 ? histogram.GetSumw2()->fArray[bin] : 0;
+    if (content != mContents[bin] || binSumw2 != mSumw2[bin]) {
+      delta->addBin(bin, content - mContents[bin], binSumw2 - mSumw2[bin]);
+      mContents[bin] = content;
+      mSumw2[bin] = binSumw2;
+    }
+  }
+
+  std::vector<double> stats(TH1::kNstat, 0);
+  histogram.GetStats(stats.data());
+  std::vector<double> statsDelta(TH1::kNstat);
+  for (size_t i = 0; i < stats.size(); i++) {
+    statsDelta[i] = stats[i] - mStats[i];
+  }
+  delta->setStats(statsDelta, histogram.GetEntries() - mEntries);
+  mStats = std::move(stats);
+  mEntries = histogram.GetEntries();
+  return delta;
+}
+
+void HistogramDeltaEncoder::keep(const TH1& histogram)
+{
+  const bool sumw2 = histogram.GetSumw2N() > 0;
+  mContents.resize(histogram.GetNcells());
+  mSumw2.assign(histogram.GetNcells(), 0);
+  for (int bin = 0; bin < histogram.GetNcells(); bin++) {
+    mContents[bin] = histogram.GetBinContent(bin);
+    if (sumw2) {
+      mSumw2[bin] = histogram.GetSumw2()->fArray[bin];
+    }
+  }
+  mStats.assign(TH1::kNstat, 0);
+  histogram.GetStats(mStats.data());
+  mEntries = histogram.GetEntries();
+  mHasState = true;
+}
+
+} // namespace experimental::mergers
+} // namespace o2
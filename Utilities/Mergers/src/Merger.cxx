@@ -21,6 +21,9 @@
 #include <Framework/CallbackService.h>
 
 #include <TObjArray.h>
+#include <TROOT.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
 #include <TH1.h>
 #include <TH2.h>
 #include <TH3.h>
@@ -28,6 +31,9 @@
 #include <TTree.h>
 #include <THnSparse.h>
 
+#include <algorithm>
+#include <future>
+
 using namespace o2::framework;
 using namespace std::chrono;
 
@@ -36,6 +42,82 @@ namespace o2
 namespace experimental::mergers
 {
 
+namespace
+{
+
+bool haveSameBinning(const TAxis* a, const TAxis* b)
+{
+  if (a->GetNbins() != b->GetNbins() || a->GetXmin() != b->GetXmin() || a->GetXmax() != b->GetXmax() || a->GetLabels() || b->GetLabels()) {
+    return false;
+  }
+  const TArrayD* aEdges = a->GetXbins();
+  const TArrayD* bEdges = b->GetXbins();
+  return aEdges->GetSize() == bEdges->GetSize() && std::equal(aEdges->GetArray(), aEdges->GetArray() + aEdges->GetSize(), bEdges->GetArray());
+}
+
+template <typename T>
+void addArrays(T* target, const T* source, size_t size)
+{
+  // simple enough to be vectorised by the compiler
+  for (size_t i = 0; i < size; i++) {
+    target[i] += source[i];
+  }
+}
+
+template <typename ARRAY>
+bool addBinArrays(TH1* target, TH1* source)
+{
+  auto targetArray = dynamic_cast<ARRAY*>(target);
+  auto sourceArray = dynamic_cast<ARRAY*>(source);
+  if (!targetArray || !sourceArray) {
+    return false;
+  }
+  addArrays(targetArray->GetArray(), sourceArray->GetArray(), targetArray->GetSize());
+  return true;
+}
+
+/// Merges TH1, TH2 and TH3 with the same class and binning by adding their bin arrays, which is much faster
+/// than TH1::Merge. Returns false, without modifying target, when the fast path does not apply.
+bool mergeHistogramsFast(TObject* targetObject, TCollection& sources)
+{
+  auto target = dynamic_cast<TH1*>(targetObject);
+  if (!target || target->GetBuffer() || target->InheritsFrom("TProfile") || target->InheritsFrom("TProfile2D") || target->InheritsFrom("TProfile3D") || (!dynamic_cast<TArrayD*>(target) && !dynamic_cast<TArrayF*>(target))) {
+    return false;
+  }
+  const bool sumw2 = target->GetSumw2N() > 0;
+  for (auto sourceObject : sources) {
+    auto source = static_cast<TH1*>(sourceObject);
+    if (sourceObject->IsA() != target->IsA() || source->GetBuffer() || (source->GetSumw2N() > 0) != sumw2 || !haveSameBinning(source->GetXaxis(), target->GetXaxis()) || !haveSameBinning(source->GetYaxis(), target->GetYaxis()) || !haveSameBinning(source->GetZaxis(), target->GetZaxis())) {
+      return false;
+    }
+  }
+
+  std::vector<double> stats(TH1::kNstat, 0);
+  std::vector<double> sourceStats(TH1::kNstat);
+  target->GetStats(stats.data());
+  double entries = target->GetEntries();
+  for (auto sourceObject : sources) {
+    auto source = static_cast<TH1*>(sourceObject);
+    if (!addBinArrays<TArrayD>(target, source)) {
+      addBinArrays<TArrayF>(target, source);
+    }
+    if (sumw2) {
+      addArrays(target->GetSumw2()->GetArray(), source->GetSumw2()->GetArray(), target->GetSumw2N());
+    }
+    std::fill(sourceStats.begin(), sourceStats.end(), 0);
+    source->GetStats(sourceStats.data());
+    for (size_t i = 0; i < stats.size(); i++) {
+      stats[i] += sourceStats[i];
+    }
+    entries += source->GetEntries();
+  }
+  target->PutStats(stats.data());
+  target->SetEntries(entries);
+  return true;
+}
+
+} // namespace
+
 Merger::Merger(MergerConfig config, header::DataHeader::SubSpecificationType subSpec)
   : mConfig(config),
     mSubSpec(subSpec),
@@ -45,6 +127,9 @@ Merger::Merger(MergerConfig config, header::DataHeader::SubSpecificationType sub
 
 void Merger::init(framework::InitContext& ictx)
 {
+  if (mConfig.parallelMerging.value == ParallelMerging::TreeReduction) {
+    ROOT::EnableThreadSafety();
+  }
   if (mConfig.publicationDecision.value == PublicationDecision::EachNSeconds) {
     // Register a device callback which creates timeslice in the TimesliceIndex
     // each N seconds, so it can serve as timer input.
@@ -106,9 +191,11 @@ void Merger::cleanCacheAfterPublishing()
 {
   if (mConfig.timespan.value == Timespan::LastDifference || mConfig.ownershipMode.value == OwnershipMode::Integral) {
     mCache.clear();
+    mPartialResults.clear();
   }
 
-  if (mConfig.ownershipMode.value == OwnershipMode::Full) {
+  // the partial results of the groups of inputs stay valid, only the updated inputs have to be merged again
+  if (mConfig.ownershipMode.value == OwnershipMode::Full && mConfig.parallelMerging.value != ParallelMerging::TreeReduction) {
     mCache.setAllMerged(false);
   }
   mCache.setAllUpdated(false);
@@ -119,6 +206,11 @@ void Merger::mergeCache()
   switch (mConfig.mergingMode.value) {
     case MergingMode::Binwise: {
 
+      if (mConfig.parallelMerging.value == ParallelMerging::TreeReduction && mConfig.ownershipMode.value == OwnershipMode::Full) {
+        mergeCacheIncrementally();
+        break;
+      }
+
       size_t i = 0;
       if (!mMergedObjects) {
         for (; i < mCache.size(); i++) {
@@ -135,55 +227,19 @@ void Merger::mergeCache()
         return;
       }
 
-      auto unpackedMergedObjects = unpackObjects(mMergedObjects.get());
-      std::vector<TObjArray> unpackedCollectionsOfObjects(unpackedMergedObjects.size());
-      // todo: unpack straight to TCollection?
+      std::vector<TObject*> objects;
       for (; i < mCache.size(); i++) {
         for (const auto& entry : mCache[i].deque) {
           if (!entry.is_merged) {
-            auto unpackedCachedObjects = unpackObjects(entry.obj.get());
-            assert(unpackedMergedObjects.size() == unpackedCachedObjects.size());
-
-            for (int j = 0; j < unpackedCachedObjects.size(); j++) {
-              unpackedCollectionsOfObjects[j].Add(unpackedCachedObjects[j]);
-            }
+            objects.push_back(entry.obj.get());
           }
         }
       }
 
-      for (int k = 0; k < unpackedMergedObjects.size(); k++) {
-
-        TObject* mergedObject = unpackedMergedObjects[k];
-        const char* className = mergedObject->ClassName();
-        Long64_t errorCode = 0;
-
-        //todo: investigate -NOCHECK flag for histogram merging
-        auto objectMergeInterface = dynamic_cast<MergeInterface*>(mergedObject);
-        if (objectMergeInterface) {
-          errorCode = objectMergeInterface->merge(&unpackedCollectionsOfObjects[k]);
-        } else if (strncmp(className, "TH1", 3) == 0) {
-          errorCode = reinterpret_cast<TH1*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
-        } else if (strncmp(className, "TH2", 3) == 0) {
-          errorCode = reinterpret_cast<TH2*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
-        } else if (strncmp(className, "TH3", 3) == 0) {
-          errorCode = reinterpret_cast<TH3*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
-        } else if (strncmp(className, "THn", 3) == 0) {
-          errorCode = reinterpret_cast<THn*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
-        } else if (strncmp(className, "THnSparse", 8) == 0) {
-          errorCode = reinterpret_cast<THnSparse*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
-        } else if (strcmp(className, "TTree") == 0) {
-          errorCode = reinterpret_cast<TTree*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
-        } else {
-          //          LOG(ERROR) << "Object with type " << className << " is not one of mergeable type.";
-          throw std::runtime_error("Object with type '" + std::string(className) + "' is not one of mergeable type.");
-          // todo: maybe it is fine to just overwrite?
-        }
-
-        if (errorCode == -1) {
-          throw std::runtime_error("Binwise merging object of type '" + std::string(className) + "' failed.");
-          //          LOG(ERROR) << "Merging object of type " << className << " failed";
-          return;
-        }
+      if (mConfig.parallelMerging.value == ParallelMerging::TreeReduction) {
+        mergeObjectsInParallel(mMergedObjects.get(), objects);
+      } else {
+        mergeObjects(mMergedObjects.get(), objects);
       }
 
       break;
@@ -219,6 +275,144 @@ void Merger::mergeCache()
   }
 }
 
+void Merger::mergeCacheIncrementally()
+{
+  const size_t nInputs = mCache.size();
+  const size_t nGroups = std::max<size_t>(1, std::min<size_t>(mConfig.parallelMerging.param, nInputs));
+  if (mPartialResults.size() != nGroups) {
+    mPartialResults.clear();
+    mPartialResults.resize(nGroups);
+  }
+
+  // the groups with an updated input are merged again, in parallel
+  std::vector<std::future<void>> merges;
+  bool updated = false;
+  for (size_t g = 0; g < nGroups; g++) {
+    std::vector<TObject*> objects;
+    bool groupUpdated = false;
+    for (size_t i = g * nInputs / nGroups; i < (g + 1) * nInputs / nGroups; i++) {
+      for (const auto& entry : mCache[i].deque) {
+        objects.push_back(entry.obj.get());
+        groupUpdated |= !entry.is_merged;
+      }
+    }
+    if (!groupUpdated) {
+      continue;
+    }
+    updated = true;
+    mPartialResults[g].reset(objects[0]->Clone());
+    objects.erase(objects.begin());
+    if (!objects.empty()) {
+      merges.push_back(std::async(std::launch::async, [this, g, objects = std::move(objects)]() {
+        mergeObjects(mPartialResults[g].get(), objects);
+      }));
+    }
+  }
+  for (auto& merge : merges) {
+    merge.get();
+  }
+
+  if (!updated && mMergedObjects) {
+    return;
+  }
+
+  // the merged object is rebuilt from the partial results
+  std::vector<TObject*> partialResults;
+  for (const auto& partialResult : mPartialResults) {
+    if (partialResult) {
+      partialResults.push_back(partialResult.get());
+    }
+  }
+  if (partialResults.empty()) {
+    LOG(INFO) << "mergeCache(): The cache is empty, nothing to merge.";
+    return;
+  }
+  mMergedObjects.reset(partialResults[0]->Clone());
+  mergeObjects(mMergedObjects.get(), { partialResults.begin() + 1, partialResults.end() });
+}
+
+void Merger::mergeObjectsInParallel(TObject* target, const std::vector<TObject*>& objects)
+{
+  const size_t nGroups = std::min<size_t>(mConfig.parallelMerging.param, objects.size() / 2);
+  if (nGroups < 2) {
+    mergeObjects(target, objects);
+    return;
+  }
+
+  // the first object of each group is cloned and the other ones are merged into it
+  std::vector<std::unique_ptr<TObject>> partialResults(nGroups);
+  std::vector<std::future<void>> merges;
+  for (size_t g = 0; g < nGroups; g++) {
+    auto begin = objects.begin() + g * objects.size() / nGroups;
+    auto end = objects.begin() + (g + 1) * objects.size() / nGroups;
+    partialResults[g].reset((*begin)->Clone());
+    merges.push_back(std::async(std::launch::async, [this, partialResult = partialResults[g].get(), group = std::vector<TObject*>(begin + 1, end)]() {
+      mergeObjects(partialResult, group);
+    }));
+  }
+  for (auto& merge : merges) {
+    merge.get();
+  }
+
+  std::vector<TObject*> partialResultsPtrs;
+  for (const auto& partialResult : partialResults) {
+    partialResultsPtrs.push_back(partialResult.get());
+  }
+  mergeObjects(target, partialResultsPtrs);
+}
+
+void Merger::mergeObjects(TObject* target, const std::vector<TObject*>& objects)
+{
+  auto unpackedMergedObjects = unpackObjects(target);
+  std::vector<TObjArray> unpackedCollectionsOfObjects(unpackedMergedObjects.size());
+  // todo: unpack straight to TCollection?
+  for (auto object : objects) {
+    auto unpackedCachedObjects = unpackObjects(object);
+    assert(unpackedMergedObjects.size() == unpackedCachedObjects.size());
+
+    for (int j = 0; j < unpackedCachedObjects.size(); j++) {
+      unpackedCollectionsOfObjects[j].Add(unpackedCachedObjects[j]);
+    }
+  }
+
+  for (int k = 0; k < unpackedMergedObjects.size(); k++) {
+
+    TObject* mergedObject = unpackedMergedObjects[k];
+    const char* className = mergedObject->ClassName();
+    Long64_t errorCode = 0;
+
+    //todo: investigate -NOCHECK flag for histogram merging
+    auto objectMergeInterface = dynamic_cast<MergeInterface*>(mergedObject);
+    if (!objectMergeInterface && mergeHistogramsFast(mergedObject, unpackedCollectionsOfObjects[k])) {
+      continue;
+    }
+    if (objectMergeInterface) {
+      errorCode = objectMergeInterface->merge(&unpackedCollectionsOfObjects[k]);
+    } else if (strncmp(className, "TH1", 3) == 0) {
+      errorCode = reinterpret_cast<TH1*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
+    } else if (strncmp(className, "TH2", 3) == 0) {
+      errorCode = reinterpret_cast<TH2*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
+    } else if (strncmp(className, "TH3", 3) == 0) {
+      errorCode = reinterpret_cast<TH3*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
+    } else if (strncmp(className, "THn", 3) == 0) {
+      errorCode = reinterpret_cast<THn*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
+    } else if (strncmp(className, "THnSparse", 8) == 0) {
+      errorCode = reinterpret_cast<THnSparse*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
+    } else if (strcmp(className, "TTree") == 0) {
+      errorCode = reinterpret_cast<TTree*>(mergedObject)->Merge(&unpackedCollectionsOfObjects[k]);
+    } else {
+      //          LOG(ERROR) << "Object with type " << className << " is not one of mergeable type.";
+      throw std::runtime_error("Object with type '" + std::string(className) + "' is not one of mergeable type.");
+      // todo: maybe it is fine to just overwrite?
+    }
+
+    if (errorCode == -1) {
+      throw std::runtime_error("Binwise merging object of type '" + std::string(className) + "' failed.");
+      //          LOG(ERROR) << "Merging object of type " << className << " failed";
+    }
+  }
+}
+
 void Merger::publish(framework::DataAllocator& allocator)
 {
   if (mMergedObjects) {
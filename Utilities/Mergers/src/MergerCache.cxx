@@ -14,6 +14,9 @@
 /// \author Piotr Konopka, piotr.jan.konopka@cern.ch
 
 #include "Mergers/MergerCache.h"
+#include "Mergers/HistogramDelta.h"
+
+#include <stdexcept>
 
 namespace o2
 {
@@ -60,6 +63,9 @@ void MergerCache::cacheInputRecord(const framework::InputRecord& inputs) //todo:
       queue.was_updated = true;
 
       std::unique_ptr<TObject, void (*)(TObject*)> objPtr(framework::DataRefUtils::as<TObject>(input).release(), deleteTCollections);
+      if (auto delta = dynamic_cast<HistogramDelta*>(objPtr.get())) {
+        objPtr = applyDelta(queue, *delta);
+      }
 
       if (mOverwrite && !queue.deque.empty()) {
         assert(queue.deque.size() == 1);
@@ -130,6 +136,32 @@ void MergerCache::setAllUpdated(bool updated)
   }
 }
 
+std::unique_ptr<TObject, void (*)(TObject*)> MergerCache::applyDelta(CacheEntryQueue& queue, HistogramDelta& delta)
+{
+  if (delta.isKeyFrame()) {
+    std::unique_ptr<TH1> histogram(delta.releaseKeyFrame());
+    queue.delta_base.reset(static_cast<TH1*>(histogram->Clone()));
+    if (mOverwrite) {
+      // the cached object is the state of the producer, updated by the next deltas
+      return { queue.delta_base.get(), [](TObject*) {} };
+    }
+    queue.delta_base->Reset();
+    return { histogram.release(), deleteTCollections };
+  }
+
+  if (!queue.delta_base) {
+    throw std::runtime_error("Received a HistogramDelta before its key frame.");
+  }
+  if (mOverwrite) {
+    delta.applyTo(*queue.delta_base);
+    return { queue.delta_base.get(), [](TObject*) {} };
+  }
+  // only the changed bins are sent, the other ones of the difference are empty
+  std::unique_ptr<TH1> histogram(static_cast<TH1*>(queue.delta_base->Clone()));
+  delta.applyTo(*histogram);
+  return { histogram.release(), deleteTCollections };
+}
+
 void MergerCache::deleteTCollections(TObject* obj)
 {
   // this is not probably the optimal approach, but it should be ok for now
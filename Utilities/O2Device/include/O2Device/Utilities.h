@@ -68,7 +68,7 @@ bool addDataBlock(O2Message& parts, o2::header::Stack&& inputStack, ContainerT&&
 
   //make sure the payload size in DataHeader corresponds to message size
   using o2::header::DataHeader;
-  DataHeader* dataHeader = const_cast<DataHeader*>(o2::header::get<DataHeader*>(inputStack.data()));
+  DataHeader* dataHeader = const_cast<DataHeader*>(inputStack.get<DataHeader>());
   dataHeader->payloadSize = dataMessage->GetSize();
 
   auto headerMessage = getMessage(move(inputStack), targetResource);
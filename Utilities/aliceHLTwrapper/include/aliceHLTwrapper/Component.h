@@ -122,8 +122,13 @@ public:
   /// the AliHLTComponentBlockData header immediately followed by the block
   /// payload. After processing, handles to output blocks are provided in this
   /// list.
+  /// The input blocks refer to the data of the buffers in place. If provided,
+  /// cbOutputBuffer allocates the output buffer of the component, e.g. in the
+  /// shared memory of the transport, such that in O2 output mode the payloads
+  /// of the output blocks are handles into this buffer without copy. The
+  /// internal buffer is used if it returns nullptr.
   int process(std::vector<o2::alice_hlt::MessageFormat::BufferDesc_t>& dataArray,
-              cballoc_signal_t* cbAllocate=nullptr);
+              cballoc_signal_t* cbAllocate=nullptr, cballoc_signal_t* cbOutputBuffer=nullptr);
 
   int getEventCount() const {return mEventCount;}
 
@@ -137,6 +142,8 @@ private:
 
   /// output buffer to receive the data produced by component
   std::vector<uint8_t> mOutputBuffer;
+  /// largest size of the output buffers requested from the caller
+  unsigned mExternalBufferSize;
 
   /// instance of the system interface
   SystemInterface* mpSystem;
@@ -28,6 +28,9 @@
 //  @brief  FairRoot/ALFA device running ALICE HLT code
 
 #include <FairMQDevice.h>
+#include <FairMQUnmanagedRegion.h>
+#include <deque>
+#include <mutex>
 #include <vector>
 #include <boost/program_options.hpp>
 
@@ -46,6 +49,15 @@ class Component;
 /// The device class implements the interface functions of FairMQ, and it
 /// receives and send messages. The data of the messages are processed
 /// using the Component class.
+///
+/// The input blocks are handed to the component as pointers into the received
+/// messages. With option --zero-copy, the output buffer of the component is
+/// allocated in an unmanaged region of the output channel (shared memory with
+/// the shm transport) and, in O2 output mode, the payloads of the output blocks
+/// are sent as messages referring to the region, without copy. The region is
+/// used as a ring buffer, the buffer of an event is released when all its
+/// messages have been released by the receivers; if the region is full, the
+/// device falls back to the internal buffer and the copy.
 class WrapperDevice : public FairMQDevice {
 public:
   /// default constructor
@@ -59,12 +71,16 @@ public:
   enum /*class*/ OptionKeyIds /*: int*/ {
     OptionKeyPollPeriod = 0,
     OptionKeyDryRun,
+    OptionKeyZeroCopy,
+    OptionKeyRegionSize,
     OptionKeyLast
   };
 
   constexpr static const char* OptionKeys[] = {
     "poll-period",
     "dry-run",
+    "zero-copy",
+    "region-size",
     nullptr
   };
 
@@ -86,10 +102,35 @@ private:
 
   /// create a new message with data buffer of specified size
   unsigned char* createMessageBuffer(unsigned size);
+  /// output buffer of the component for the current event in the region,
+  /// nullptr if there is no space; replaces the one of a previous call for
+  /// the same event
+  unsigned char* createRegionBuffer(unsigned size);
+  /// message referring to the data of the current region buffer
+  FairMQMessagePtr createRegionMessage(unsigned char* data, unsigned size);
+  /// close the region buffer of the current event, it is released with its
+  /// last message or immediately if none refers to it
+  void closeRegionBuffer();
+  /// callback of the region for a released message
+  void releaseRegionMessage(void* data);
+
+  /// buffer of an event in the region
+  struct RegionBuffer {
+    size_t offset; // offset in the region
+    size_t size;   // allocated size, trimmed to the used part once closed
+    size_t used;   // end of the data of the messages, relative to offset
+    int refs;      // number of messages not yet released
+    bool closed;   // no more messages will be created
+  };
 
   Component* mComponent;     // component instance
   std::vector<FairMQMessagePtr> mMessages; // array of output messages
 
+  FairMQUnmanagedRegionPtr mRegion;       // region of the output buffers in zero-copy mode
+  size_t mRegionSize;                     // size of the region
+  std::deque<RegionBuffer> mRegionBuffers; // buffers in use, in the order of allocation
+  std::mutex mRegionMutex;                // the region callback runs in a transport thread
+
   int mPollingPeriod;        // period of polling on input sockets in ms
   int mSkipProcessing;       // skip component processing
   int mLastCalcTime;         // start time of current statistic period
@@ -49,6 +49,7 @@ using std::stringstream;
 
 Component::Component()
   : mOutputBuffer()
+  , mExternalBufferSize(0)
   , mpSystem(nullptr)
   , mProcessor(kEmptyHLTComponentHandle)
   , mFormatHandler()
@@ -139,6 +140,7 @@ int Component::init(int argc, char** argv)
       unsigned size = 0;
       stringstream(varmap[OptionKeys[option]].as<string>()) >> size;
       mOutputBuffer.resize(size);
+      mExternalBufferSize = size;
     } break;
     case OptionKeyOutputMode: {
       unsigned mode;
@@ -219,7 +221,7 @@ int Component::init(int argc, char** argv)
 }
 
 int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
-                       cballoc_signal_t* cbAllocate)
+                       cballoc_signal_t* cbAllocate, cballoc_signal_t* cbOutputBuffer)
 {
   if (!mpSystem) return -ENOSYS;
   int iResult = 0;
@@ -272,6 +274,10 @@ int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
 
   // process
   evtData.fBlockCnt = inputBlocks.size();
+  // the output buffer, either provided by the caller or the internal one
+  uint8_t* pOutputBuffer = nullptr;
+  unsigned outputBufferCapacity = 0;
+  bool internalBuffer = true;
   int nofTrials = 2;
   do {
     unsigned long constEventBase = 0;
@@ -280,16 +286,34 @@ int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
     mpSystem->getOutputSize(mProcessor, &constEventBase, &constBlockBase, &inputBlockMultiplier);
     outputBufferSize = constEventBase + nofInputBlocks * constBlockBase + totalInputSize * inputBlockMultiplier;
     outputBufferSize+=sizeof(AliHLTComponentStatistics) + sizeof(AliHLTComponentTableEntry);
-    // take the full available buffer and increase if that
-    // is too little
-    mOutputBuffer.resize(mOutputBuffer.capacity());
-    if (mOutputBuffer.size() < outputBufferSize) {
-      mOutputBuffer.resize(outputBufferSize);
-    } else if (nofTrials < 2) {
-      // component did not update the output size
-      break;
+    pOutputBuffer = nullptr;
+    internalBuffer = false;
+    if (cbOutputBuffer) {
+      // request the largest size so far, and increase if that is too little
+      if (mExternalBufferSize < outputBufferSize) {
+        mExternalBufferSize = outputBufferSize;
+      } else if (nofTrials < 2) {
+        // component did not update the output size
+        break;
+      }
+      outputBufferCapacity = mExternalBufferSize;
+      pOutputBuffer = *(*cbOutputBuffer)(outputBufferCapacity);
+    }
+    if (pOutputBuffer == nullptr) {
+      // take the full available buffer and increase if that
+      // is too little
+      mOutputBuffer.resize(mOutputBuffer.capacity());
+      if (mOutputBuffer.size() < outputBufferSize) {
+        mOutputBuffer.resize(outputBufferSize);
+      } else if (nofTrials < 2 && !cbOutputBuffer) {
+        // component did not update the output size
+        break;
+      }
+      pOutputBuffer = &mOutputBuffer[0];
+      outputBufferCapacity = mOutputBuffer.size();
+      internalBuffer = true;
     }
-    outputBufferSize = mOutputBuffer.size();
+    outputBufferSize = outputBufferCapacity;
     outputBlockCnt = 0;
     // TODO: check if that is working with the corresponding allocation method of the
     // component environment
@@ -299,26 +323,23 @@ int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
     pEventDoneData = nullptr;
 
     iResult = mpSystem->processEvent(mProcessor, &evtData, &inputBlocks[0], &trigData,
-                                     &mOutputBuffer[0], &outputBufferSize,
+                                     pOutputBuffer, &outputBufferSize,
                                      &outputBlockCnt, &pOutputBlocks,
                                      &pEventDoneData);
-    if (outputBufferSize > 0) {
-      if (outputBufferSize > mOutputBuffer.size()) {
-        LOG(ERROR) << "FATAL: fatal error: component writing beyond buffer capacity";
-        return -EFAULT;
-      } else if (outputBufferSize < mOutputBuffer.size()) {
-        mOutputBuffer.resize(outputBufferSize);
-      }
-    } else {
-      mOutputBuffer.clear();
+    if (outputBufferSize > outputBufferCapacity) {
+      LOG(ERROR) << "FATAL: fatal error: component writing beyond buffer capacity";
+      return -EFAULT;
+    }
+    if (internalBuffer) {
+      mOutputBuffer.resize(outputBufferSize);
     }
 
   } while (iResult == ENOSPC && --nofTrials > 0);
 
   // prepare output
   { // keep this after removing condition to preserve formatting
-    uint8_t* pOutputBufferStart = &mOutputBuffer[0];
-    uint8_t* pOutputBufferEnd = pOutputBufferStart + mOutputBuffer.size();
+    uint8_t* pOutputBufferStart = pOutputBuffer;
+    uint8_t* pOutputBufferEnd = pOutputBufferStart + outputBufferSize;
     // consistency check for data blocks
     // 1) all specified data must be either inside the output buffer given
     //    to the component or in one of the input buffers
@@ -342,7 +363,7 @@ int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
 
       // calculate the data reference
       uint8_t* pStart =
-        pOutputBlock->fPtr != nullptr ? reinterpret_cast<uint8_t*>(pOutputBlock->fPtr) : &mOutputBuffer[0];
+        pOutputBlock->fPtr != nullptr ? reinterpret_cast<uint8_t*>(pOutputBlock->fPtr) : pOutputBuffer;
       pStart += pOutputBlock->fOffset;
       uint8_t* pEnd = pStart + pOutputBlock->fSize;
       pOutputBlock->fPtr = pStart;
@@ -375,7 +396,8 @@ int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
 
     // create the messages
     // TODO: for now there is an extra copy of the data, but it should be
-    // handled in place
+    // handled in place; in O2 output mode, the payloads of the blocks in a
+    // buffer provided by the caller are handed over in place
     vector<MessageFormat::BufferDesc_t> outputMessages =
       mFormatHandler.createMessages(pOutputBlocks, validBlocks, totalPayloadSize, &evtData, cbAllocate);
     dataArray.insert(dataArray.end(), outputMessages.begin(), outputMessages.end());
@@ -383,7 +405,7 @@ int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
 
   // cleanup
   // NOTE: don't cleanup mOutputBuffer as the data is going to be used outside the class
-  // until released.
+  // until released, the same for a buffer provided by the caller.
   inputBlocks.clear();
   outputBlockCnt = 0;
   if (pOutputBlocks) delete[] pOutputBlocks;
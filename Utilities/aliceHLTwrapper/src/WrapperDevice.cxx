@@ -35,6 +35,7 @@
 
 #include <boost/thread.hpp>
 #include <boost/bind.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <cerrno>
 #include <cstring>
@@ -51,9 +52,20 @@ using namespace o2::alice_hlt;
 using std::chrono::system_clock;
 using TimeScale = std::chrono::milliseconds;
 
+namespace
+{
+// alignment of the buffers in the output region
+constexpr size_t RegionAlignment = 64;
+size_t alignRegionSize(size_t size) { return (size + RegionAlignment - 1) & ~(RegionAlignment - 1); }
+} // namespace
+
 WrapperDevice::WrapperDevice(int verbosity)
   : mComponent(nullptr)
   , mMessages()
+  , mRegion()
+  , mRegionSize(0)
+  , mRegionBuffers()
+  , mRegionMutex()
   , mPollingPeriod(10)
   , mSkipProcessing(0)
   , mLastCalcTime(-1)
@@ -82,7 +94,13 @@ bpo::options_description WrapperDevice::GetOptionsDescription()
      "polling period")
     ((std::string(OptionKeys[OptionKeyDryRun]) + ",n").c_str(),
      bpo::value<bool>()->zero_tokens()->default_value(false),
-     "skip component processing");
+     "skip component processing")
+    (OptionKeys[OptionKeyZeroCopy],
+     bpo::value<bool>()->zero_tokens()->default_value(false),
+     "component output buffer in a region of the output channel, payloads sent without copy")
+    (OptionKeys[OptionKeyRegionSize],
+     bpo::value<int>()->default_value(256),
+     "size of the output region in MB for --zero-copy");
   od.add(Component::GetOptionsDescription());
   return od;
 }
@@ -129,6 +147,16 @@ void WrapperDevice::InitTask()
     }
     mPollingPeriod = config->GetValue<int>(OptionKeys[OptionKeyPollPeriod]);
     mSkipProcessing = config->GetValue<bool>(OptionKeys[OptionKeyDryRun]);
+    if (config->GetValue<bool>(OptionKeys[OptionKeyZeroCopy])) {
+      if (fChannels.find("data-out") != fChannels.end() && fChannels["data-out"].size() > 0) {
+        mRegionSize = size_t(config->GetValue<int>(OptionKeys[OptionKeyRegionSize])) << 20;
+        mRegion = NewUnmanagedRegionFor("data-out", 0, mRegionSize,
+                                        [this](void* data, size_t /*size*/, void* /*hint*/) { this->releaseRegionMessage(data); });
+        LOG(INFO) << "zero-copy output in a region of " << (mRegionSize >> 20) << " MB";
+      } else {
+        LOG(WARN) << "no output channel, ignoring option " << OptionKeys[OptionKeyZeroCopy];
+      }
+    }
   }
 
   // TODO: probably one can get rid of this option, the instance/device
@@ -259,32 +287,42 @@ void WrapperDevice::Run()
       // can create messages via the callback and writes data directly to buffer
       cballoc_signal_t cbsignal;
       cbsignal.connect([this](unsigned int size){return this->createMessageBuffer(size);} );
+      // the output buffer of the component in the region in zero-copy mode
+      cballoc_signal_t cbregion;
+      cbregion.connect([this](unsigned int size) { return this->createRegionBuffer(size); });
       mMessages.clear();
 
       // call the component
-      if ((iResult=mComponent->process(dataArray, &cbsignal))<0) {
+      if ((iResult=mComponent->process(dataArray, &cbsignal, mRegion ? &cbregion : nullptr))<0) {
         LOG(ERROR) << "component processing failed with error code " << iResult;
       }
 
-      // build messages from output data
+      // build messages from output data, in the order of the buffer descriptors
+      vector<FairMQMessagePtr> outputMessages;
       if (dataArray.size() > 0) {
         if (mVerbosity > 2) {
           LOG(INFO) << "processing " << dataArray.size() << " buffer(s)";
         }
         for (auto opayload : dataArray) {
-          FairMQMessage* omsg=nullptr;
+          FairMQMessagePtr omsg;
           // loop over pre-allocated messages
-          for (auto premsg = begin(mMessages); premsg != end(mMessages); premsg++) {
-            if ((*premsg)->GetData() == opayload.mP &&
-                (*premsg)->GetSize() == opayload.mSize) {
-              omsg=(*premsg).get();
+          for (auto& premsg : mMessages) {
+            if (premsg && premsg->GetData() == opayload.mP &&
+                premsg->GetSize() == opayload.mSize) {
+              omsg = move(premsg);
               if (mVerbosity > 2) {
                 LOG(DEBUG) << "using pre-allocated message of size " << opayload.mSize;
               }
               break;
             }
           }
-          if (omsg==nullptr) {
+          if (!omsg && mRegion) {
+            // payload in the output buffer of the component, sent in place
+            omsg = createRegionMessage(opayload.mP, opayload.mSize);
+          }
+          if (omsg) {
+            outputMessages.emplace_back(move(omsg));
+          } else {
             FairMQMessagePtr msg = NewMessage(opayload.mSize);
             if (msg.get()) {
               if (msg->GetSize() < opayload.mSize) {
@@ -296,7 +334,7 @@ void WrapperDevice::Run()
               }
               uint8_t* pTarget = reinterpret_cast<uint8_t*>(msg->GetData());
               memcpy(pTarget, opayload.mP, opayload.mSize);
-              mMessages.emplace_back(move(msg));
+              outputMessages.emplace_back(move(msg));
             } else {
               if (errorCount == maxError && errorCount++ > 0)
                 LOG(ERROR) << "persistent error, suppressing further output";
@@ -307,6 +345,10 @@ void WrapperDevice::Run()
           }
         }
       }
+      if (mRegion) {
+        closeRegionBuffer();
+      }
+      mMessages.swap(outputMessages);
 
       if (mMessages.size()>0) {
         if (fChannels.find("data-out") != fChannels.end() && fChannels["data-out"].size() > 0) {
@@ -354,3 +396,88 @@ unsigned char* WrapperDevice::createMessageBuffer(unsigned size)
   mMessages.emplace_back(move(msg));
   return reinterpret_cast<uint8_t*>(mMessages.back()->GetData());
 }
+
+unsigned char* WrapperDevice::createRegionBuffer(unsigned size)
+{
+  /// the buffers are allocated one after the other in the region, wrapping
+  /// around at its end, in the space not used by the buffers in flight
+  const size_t alignedSize = std::max<size_t>(alignRegionSize(size), RegionAlignment);
+  std::lock_guard<std::mutex> lock(mRegionMutex);
+  if (!mRegionBuffers.empty() && !mRegionBuffers.back().closed) {
+    // the component is requesting a larger buffer for the same event
+    mRegionBuffers.pop_back();
+  }
+  size_t offset = 0;
+  if (mRegionBuffers.empty()) {
+    if (alignedSize > mRegionSize) {
+      return nullptr;
+    }
+  } else {
+    const size_t head = mRegionBuffers.front().offset;
+    const size_t tail = mRegionBuffers.back().offset + mRegionBuffers.back().size;
+    if (tail > head && tail + alignedSize <= mRegionSize) {
+      offset = tail;
+    } else if (tail > head && alignedSize <= head) {
+      offset = 0;
+    } else if (tail <= head && tail + alignedSize <= head) {
+      offset = tail;
+    } else {
+      if (mVerbosity > 0) {
+        LOG(WARN) << "no space for " << size << " byte(s) in the output region, copying the output";
+      }
+      return nullptr;
+    }
+  }
+  mRegionBuffers.push_back({ offset, alignedSize, 0, 0, false });
+  return reinterpret_cast<unsigned char*>(mRegion->GetData()) + offset;
+}
+
+FairMQMessagePtr WrapperDevice::createRegionMessage(unsigned char* data, unsigned size)
+{
+  auto* base = reinterpret_cast<unsigned char*>(mRegion->GetData());
+  {
+    std::lock_guard<std::mutex> lock(mRegionMutex);
+    if (size == 0 || mRegionBuffers.empty() || mRegionBuffers.back().closed) {
+      return nullptr;
+    }
+    auto& buffer = mRegionBuffers.back();
+    if (data < base + buffer.offset || data + size > base + buffer.offset + buffer.size) {
+      // e.g. a block forwarded from the input
+      return nullptr;
+    }
+    buffer.refs++;
+    buffer.used = std::max<size_t>(buffer.used, data + size - (base + buffer.offset));
+  }
+  if (mVerbosity > 2) {
+    LOG(DEBUG) << "sending " << size << " byte(s) in place from the output region";
+  }
+  return NewMessageFor("data-out", 0, mRegion, data, size);
+}
+
+void WrapperDevice::closeRegionBuffer()
+{
+  std::lock_guard<std::mutex> lock(mRegionMutex);
+  if (!mRegionBuffers.empty() && !mRegionBuffers.back().closed) {
+    // the rest of the buffer is available for the next event
+    mRegionBuffers.back().size = alignRegionSize(mRegionBuffers.back().used);
+    mRegionBuffers.back().closed = true;
+  }
+  mRegionBuffers.erase(std::remove_if(mRegionBuffers.begin(), mRegionBuffers.end(),
+                                      [](const RegionBuffer& buffer) { return buffer.closed && buffer.refs == 0; }),
+                       mRegionBuffers.end());
+}
+
+void WrapperDevice::releaseRegionMessage(void* data)
+{
+  const size_t offset = reinterpret_cast<unsigned char*>(data) - reinterpret_cast<unsigned char*>(mRegion->GetData());
+  std::lock_guard<std::mutex> lock(mRegionMutex);
+  for (auto& buffer : mRegionBuffers) {
+    if (offset >= buffer.offset && offset < buffer.offset + buffer.size) {
+      buffer.refs--;
+      break;
+    }
+  }
+  mRegionBuffers.erase(std::remove_if(mRegionBuffers.begin(), mRegionBuffers.end(),
+                                      [](const RegionBuffer& buffer) { return buffer.closed && buffer.refs == 0; }),
+                       mRegionBuffers.end());
+}
@@ -324,6 +324,7 @@ o2_define_bucket(
     InfoLogger_bucket
     AliceO2::Common
     CURL::libcurl
+    $<$<PLATFORM_ID:Linux>:rt>
 
     SYSTEMINCLUDE_DIRECTORIES
     ${CMAKE_SOURCE_DIR}/Utilities/PCG/include
@@ -357,6 +358,9 @@ o2_define_bucket(
         Core
         Headers
         Framework
+
+        INCLUDE_DIRECTORIES
+        ${CMAKE_SOURCE_DIR}/Algorithm/include
 )
 
 o2_define_bucket(
@@ -382,6 +386,15 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/DataFormats/MemoryResources/include
 )
 
+o2_define_bucket(
+    NAME
+    data_format_headers_benchmark_bucket
+
+    DEPENDENCIES
+    data_format_headers_bucket
+    $<IF:$<BOOL:${benchmark_FOUND}>,benchmark::benchmark,$<0:"">>
+)
+
 # module DataFormats/Detectors/TPC
 o2_define_bucket(
     NAME
@@ -483,6 +496,9 @@ o2_define_bucket(
     ${FAIRROOT_INCLUDE_DIR}
     ${ROOT_INCLUDE_DIR}
     ${CMAKE_SOURCE_DIR}/Common/Constants/include
+
+    SYSTEMINCLUDE_DIRECTORIES
+    ${CMAKE_SOURCE_DIR}/Utilities/PCG/include
 )
 
 o2_define_bucket(
@@ -497,6 +513,7 @@ o2_define_bucket(
     ${FAIRROOT_INCLUDE_DIR}
     ${ROOT_INCLUDE_DIR}
     ${CMAKE_SOURCE_DIR}/Common/MathUtils/include
+    ${MS_GSL_INCLUDE_DIR}
 )
 
 o2_define_bucket(
@@ -559,6 +576,15 @@ if(FairLogger_FOUND)
 endif()
 
 # module DataFormats/MemoryResources
+# the pinned memory resource goes through the GPU runtime when there is one
+if (ENABLE_CUDA)
+  set(pmr_GPU_DEP cudart)
+  set(pmr_GPU_INCDIR ${CMAKE_CUDA_TOOLKIT_INCLUDE_DIRECTORIES})
+elseif (ENABLE_HIP)
+  set(pmr_GPU_DEP hip_hcc)
+  set(pmr_GPU_INCDIR ${HIP_PATH}/include)
+endif()
+
 o2_define_bucket(
     NAME
     pmr_bucket
@@ -566,6 +592,10 @@ o2_define_bucket(
     DEPENDENCIES
     Boost::container
     fairmq_bucket
+    ${pmr_GPU_DEP}
+
+    INCLUDE_DIRECTORIES
+    ${pmr_GPU_INCDIR}
 )
 
 o2_define_bucket(
@@ -694,6 +724,15 @@ o2_define_bucket(
     ${MS_GSL_INCLUDE_DIR}
 )
 
+o2_define_bucket(
+    NAME
+    data_format_reconstruction_benchmark_bucket
+
+    DEPENDENCIES
+    data_format_reconstruction_bucket
+    $<IF:$<BOOL:${benchmark_FOUND}>,benchmark::benchmark,$<0:"">>
+)
+
 o2_define_bucket(
     NAME
     data_format_detectors_common_bucket
@@ -839,6 +878,15 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/Common/Utils/include
 )
 
+o2_define_bucket(
+    NAME
+    itsmft_reconstruction_benchmark_bucket
+
+    DEPENDENCIES
+    itsmft_reconstruction_bucket
+    $<IF:$<BOOL:${benchmark_FOUND}>,benchmark::benchmark,$<0:"">>
+)
+
 o2_define_bucket(
     NAME
     its_base_bucket
@@ -909,6 +957,7 @@ o2_define_bucket(
     DEPENDENCIES
     data_format_its_bucket
     AliTPCCommonBase_bucket
+    common_boost_bucket
     #
     DataFormatsITS
     DetectorsBase
@@ -1107,11 +1156,23 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/DataFormats/Detectors/TPC/include
     ${CMAKE_SOURCE_DIR}/DataFormats/Detectors/Common/include
     ${CMAKE_SOURCE_DIR}/DataFormats/Headers/include
+    ${CMAKE_SOURCE_DIR}/Common/Utils/include
+    ${CMAKE_SOURCE_DIR}/Utilities/DataCompression/include
     ${MS_GSL_INCLUDE_DIR}
 )
 
 include("${ALITPCCOMMON_DIR}/sources/cmake/O2Dependencies.cmake")
 
+o2_define_bucket(
+    NAME
+    tpc_reconstruction_benchmark_bucket
+
+    DEPENDENCIES
+    tpc_reconstruction_bucket
+    TPCReconstruction
+    $<IF:$<BOOL:${benchmark_FOUND}>,benchmark::benchmark,$<0:"">>
+)
+
 o2_define_bucket(
     NAME
     tpc_calibration_bucket
@@ -1161,11 +1222,13 @@ o2_define_bucket(
 
     DEPENDENCIES
     TPCReconstruction
+    TPCCalibration
     Framework
     DPLUtils
 
     INCLUDE_DIRECTORIES
     ${CMAKE_SOURCE_DIR}/Algorithm/include
+    ${CMAKE_SOURCE_DIR}/Detectors/TPC/calibration/include
    )
 
 # base bucket for generators not needing any external stuff
@@ -1254,6 +1317,30 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/Common/Utils/include
 )
 
+o2_define_bucket(
+    NAME
+    mft_tracking_bucket
+
+    DEPENDENCIES
+    its_tracking_bucket
+    mft_base_bucket
+    data_format_mft_bucket
+    #
+    ITStracking
+    DataFormatsITSMFT
+    DataFormatsMFT
+    MFTBase
+
+    INCLUDE_DIRECTORIES
+    ${CMAKE_SOURCE_DIR}/Detectors/Base/include
+    ${CMAKE_SOURCE_DIR}/DataFormats/Detectors/ITSMFT/common/include
+    ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/common/base/include
+    ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/ITS/tracking/include
+    ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/MFT/base/include
+    ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/MFT/tracking/include
+    ${MS_GSL_INCLUDE_DIR}
+)
+
 o2_define_bucket(
     NAME
     mft_reconstruction_bucket
@@ -1262,10 +1349,12 @@ o2_define_bucket(
     mft_base_bucket
     itsmft_reconstruction_bucket
     data_format_mft_bucket
+    mft_tracking_bucket
     ITSMFTBase
     ITSMFTReconstruction
     MFTBase
     MFTSimulation
+    MFTtracking
     DetectorsBase
     DataFormatsITSMFT
 
@@ -1276,6 +1365,7 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/common/reconstruction/include
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/MFT/base/include
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/MFT/simulation/include
+    ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/MFT/tracking/include
 
 )
 
@@ -1421,6 +1511,9 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/Detectors/Base/include
     ${CMAKE_SOURCE_DIR}/Detectors/TOF/base/include
     ${MS_GSL_INCLUDE_DIR}
+
+    SYSTEMINCLUDE_DIRECTORIES
+    ${CMAKE_SOURCE_DIR}/Utilities/PCG/include
 )
 
 o2_define_bucket(
@@ -1630,6 +1723,7 @@ o2_define_bucket(
     DetectorsBase
     SimulationDataFormat
     Core Hist # ROOT
+    SimConfig
 
     INCLUDE_DIRECTORIES
     ${FAIRROOT_INCLUDE_DIR}
@@ -1638,6 +1732,7 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/Detectors/HMPID/simulation/include
     ${CMAKE_SOURCE_DIR}/DataFormats/simulation/include
     ${CMAKE_SOURCE_DIR}/Common/MathUtils/include
+    ${CMAKE_SOURCE_DIR}/Common/SimConfig/include
 )
 
 
@@ -1654,6 +1749,7 @@ o2_define_bucket(
     DetectorsBase
     SimulationDataFormat
     Core
+    SimConfig
 
     INCLUDE_DIRECTORIES
     ${FAIRROOT_INCLUDE_DIR}
@@ -1662,6 +1758,7 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/Detectors/ZDC/simulation/include
     ${CMAKE_SOURCE_DIR}/DataFormats/simulation/include
     ${CMAKE_SOURCE_DIR}/Common/MathUtils/include
+    ${CMAKE_SOURCE_DIR}/Common/SimConfig/include
 )
 
 
@@ -1914,6 +2011,7 @@ o2_define_bucket(
     Framework
     DetectorsCommonDataFormats
     CommonDataFormat
+    CommonUtils
     TPCSimulation
     TPCWorkflow
     DataFormatsTPC
@@ -1933,6 +2031,9 @@ o2_define_bucket(
     TRDBase
     TRDSimulation
     MIDSimulation
+
+    SYSTEMINCLUDE_DIRECTORIES
+    ${CMAKE_SOURCE_DIR}/Utilities/PCG/include
 )
 
 o2_define_bucket(
@@ -2044,7 +2145,11 @@ o2_define_bucket(
   ${ROOT_INCLUDE_DIR}
   ${Boost_INCLUDE_DIR}
   ${CMAKE_SOURCE_DIR}/Common/Utils/include
+  ${CMAKE_SOURCE_DIR}/Common/MathUtils/include
   ${CMAKE_SOURCE_DIR}/include/ReconstructionDataFormats # for test dependency only
+
+  SYSTEMINCLUDE_DIRECTORIES
+  ${CMAKE_SOURCE_DIR}/Utilities/PCG/include
 )
 
 o2_define_bucket(
@@ -2226,6 +2331,29 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/DataFormats/Detectors/TPC/include
 )
 
+o2_define_bucket(
+    NAME
+    global_tracking_benchmark_bucket
+
+    DEPENDENCIES
+    global_tracking_bucket
+    $<IF:$<BOOL:${benchmark_FOUND}>,benchmark::benchmark,$<0:"">>
+)
+
+o2_define_bucket(
+    NAME
+    global_tracking_workflow_bucket
+
+    DEPENDENCIES
+    Framework
+    global_tracking_bucket
+    GlobalTracking
+
+    INCLUDE_DIRECTORIES
+    ${CMAKE_SOURCE_DIR}/Detectors/GlobalTracking/include
+    ${CMAKE_SOURCE_DIR}/Detectors/GlobalTrackingWorkflow/include
+)
+
 o2_define_bucket(
   NAME
   mch_contour_bucket
@@ -2431,6 +2559,15 @@ o2_define_bucket(
     INCLUDE_DIRECTORIES
 )
 
+o2_define_bucket(
+    NAME
+    utility_datacompression_benchmark_bucket
+
+    DEPENDENCIES
+    utility_datacompression_bucket
+    $<IF:$<BOOL:${benchmark_FOUND}>,benchmark::benchmark,$<0:"">>
+)
+
 o2_define_bucket(
     NAME
     mid_simulation_bucket
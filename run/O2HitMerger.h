@@ -23,6 +23,7 @@
 #include <DetectorsCommonDataFormats/DetID.h>
 #include <gsl/gsl>
 #include "TFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 #include <memory>
 #include <TMessage.h>
@@ -89,19 +90,17 @@ class O2HitMerger : public FairMQDevice
   ~O2HitMerger() override
   {
     FairSystemInfo sysinfo;
-    mOutTree->SetEntries(mEntries);
-    mOutTree->Write();
-
-    // TODO: instead of doing this at the end; one
-    // should investigate more asynchronous ways
-    auto merged = mergeEntries();
-
-    mTmpOutFile->Close();
-    if (merged) {
-      std::remove(mTmpOutFileName.c_str());
-    } else {
-      // if no merge was necessary, we simply rename the file
-      std::rename(mTmpOutFileName.c_str(), mOutFileName.c_str());
+    if (mOutFile) {
+      // write the events still pending, e.g. when stopped before all the events were complete
+      for (auto& event : mEvents) {
+        if (!event.second.complete) {
+          LOG(WARNING) << "WRITING INCOMPLETE EVENT " << event.first;
+        }
+        writeEvent(event.first, event.second);
+      }
+      mEvents.clear();
+      mOutTree->Write();
+      mOutFile->Close();
     }
 
     LOG(INFO) << "TIME-STAMP " << mTimer.RealTime() << "\t";
@@ -111,6 +110,17 @@ class O2HitMerger : public FairMQDevice
   }
 
  private:
+  // the data of one event, reassembled in memory from its sub-events as they arrive
+  struct EventData {
+    uint32_t partsChecksum = 0;                             // sum of the part numbers received
+    int trackOffset = 0;                                    // number of persistent tracks of the parts received
+    bool complete = false;                                  // all the parts were received
+    std::unique_ptr<o2::dataformats::MCEventHeader> header; // header with the statistics of all parts
+    std::vector<o2::MCTrack> tracks;
+    std::vector<o2::TrackReference> trackRefs;
+    o2::dataformats::MCTruthContainer<o2::TrackReference> indexedTrackRefs;
+  };
+
   /// Overloads the InitTask() method of FairMQDevice
   void InitTask() final
   {
@@ -119,10 +129,18 @@ class O2HitMerger : public FairMQDevice
     if (o2::devices::O2SimDevice::querySimConfig(fChannels.at("primary-get").at(0))) {
       outfilename = o2::conf::SimConfig::Instance().getOutPrefix() + ".root";
       mNExpectedEvents = o2::conf::SimConfig::Instance().getNEvents();
+      o2::base::Detector::setCompactHits(o2::conf::SimConfig::Instance().useCompactHits());
     }
     mOutFileName = outfilename.c_str();
-    mTmpOutFileName = "o2sim_tmp.root";
-    mTmpOutFile = new TFile(mTmpOutFileName.c_str(), "RECREATE");
+    mOutFile = new TFile(mOutFileName.c_str(), "RECREATE");
+#ifdef R__USE_IMT
+    // the branches of each event are filled by a pool of threads
+    auto nthreads = GetConfig()->GetValue<int>("nthreads");
+    if (nthreads > 1) {
+      ROOT::EnableImplicitMT(nthreads);
+      LOG(INFO) << "FILLING BRANCHES WITH " << nthreads << " THREADS";
+    }
+#endif
     mOutTree = new TTree("o2sim", "o2sim");
 
     // init pipe
@@ -142,28 +160,13 @@ class O2HitMerger : public FairMQDevice
     }
   }
 
-  template <typename T, typename V>
-  V insertAdd(std::map<T, V>& m, T const& key, V value)
-  {
-    const auto iter = m.find(key);
-    V accum{ 0 };
-    if (iter != m.end()) {
-      iter->second += value;
-      accum = iter->second;
-    } else {
-      m.insert(std::make_pair(key, value));
-      accum = value;
-    }
-    return accum;
-  }
-
   template <typename T>
   bool isDataComplete(T checksum, T nparts)
   {
     return checksum == nparts * (nparts + 1) / 2;
   }
 
-  void consumeHits(FairMQParts& data, int& index)
+  void consumeHits(int eventID, int trackoffset, FairMQParts& data, int& index)
   {
     auto detIDmessage = std::move(data.At(index++));
     // this should be a detector ID
@@ -176,41 +179,30 @@ class O2HitMerger : public FairMQDevice
       // get the detector than can interpret it
       auto detector = mDetectorInstances[id].get();
       if (detector) {
-        detector->fillHitBranch(*mOutTree, data, index);
+        detector->collectHits(eventID, data, index, trackoffset);
       }
     }
   }
 
+  // attaches ptr to a branch of the output tree, ptr has to stay valid until the fill
   template <typename T>
-  void fillBranch(std::string const& name, T* ptr)
+  void setBranchAddress(std::string const& name, T*& ptr)
   {
     auto br = o2::base::getOrMakeBranch(*mOutTree, name.c_str(), &ptr);
     br->SetAddress(&ptr);
-    br->Fill();
-    br->ResetAddress();
   }
 
   template <typename T>
-  void consumeData(std::string name, FairMQParts& data, int& index)
+  void consumeData(T& target, FairMQParts& data, int& index)
   {
     auto decodeddata = o2::base::decodeTMessage<T*>(data, index);
-    fillBranch(name, decodeddata);
-    delete decodeddata;
+    if (decodeddata) {
+      backInsert(*decodeddata, target);
+      delete decodeddata;
+    }
     index++;
   }
 
-  // fills a special branch of SubEventInfos in order to keep
-  // track of which entry corresponds to which event etc.
-  // also creates the MCEventHeader branch expected for physics analysis
-  void fillSubEventInfoEntry(o2::data::SubEventInfo& info)
-  {
-    auto infoptr = &info;
-    fillBranch("SubEventInfo", infoptr);
-    // a separate branch for MCEventHeader to be backward compatible
-    auto headerptr = &info.mMCEventHeader;
-    fillBranch("MCEventHeader.", headerptr);
-  }
-
   bool ConditionalRun() override
   {
     auto& channel = fChannels.at("simdata").at(0);
@@ -228,25 +220,34 @@ class O2HitMerger : public FairMQDevice
     LOG(INFO) << "SIMDATA channel got " << data.Size() << " parts\n";
 
     int index = 0;
-    auto infoptr = o2::base::decodeTMessage<o2::data::SubEventInfo*>(data, index++);
+    std::unique_ptr<o2::data::SubEventInfo> infoptr(o2::base::decodeTMessage<o2::data::SubEventInfo*>(data, index++));
     o2::data::SubEventInfo& info = *infoptr;
-    auto accum = insertAdd<uint32_t, uint32_t>(mPartsCheckSum, info.eventID, (uint32_t)info.part);
+    auto& event = mEvents[info.eventID];
+    event.partsChecksum += info.part;
+    if (!event.header) {
+      event.header = std::make_unique<o2::dataformats::MCEventHeader>(info.mMCEventHeader);
+    } else {
+      event.header->getMCEventStats().add(info.mMCEventHeader.getMCEventStats());
+    }
 
-    fillSubEventInfoEntry(info);
-    consumeData<std::vector<o2::MCTrack>>("MCTrack", data, index);
-    consumeData<std::vector<o2::TrackReference>>("TrackRefs", data, index);
-    consumeData<o2::dataformats::MCTruthContainer<o2::TrackReference>>("IndexedTrackRefs", data, index);
+    // the parts are appended in their order of arrival, the trackIDs of the hits being
+    // shifted by the number of persistent tracks of the parts received before
+    consumeData(event.tracks, data, index);
+    consumeData(event.trackRefs, data, index);
+    consumeData(event.indexedTrackRefs, data, index);
     while (index < data.Size()) {
-      consumeHits(data, index);
+      consumeHits(info.eventID, event.trackOffset, data, index);
     }
+    assert(info.npersistenttracks >= 0);
+    event.trackOffset += info.npersistenttracks;
 
-    mEntries++;
-
-    if (isDataComplete<uint32_t>(accum, info.nparts)) {
+    if (isDataComplete<uint32_t>(event.partsChecksum, info.nparts)) {
       LOG(INFO) << "EVERYTHING IS HERE FOR EVENT " << info.eventID << "\n";
+      event.complete = true;
+      writeCompletedEvents();
 
       if (mPipeToDriver != -1) {
-        if (write(mPipeToDriver, &info.eventID, sizeof(info.eventID) == -1)) {
+        if (write(mPipeToDriver, &info.eventID, sizeof(info.eventID)) == -1) {
           LOG(ERROR) << "FAILED WRITING TO PIPE";
         };
       }
@@ -261,188 +262,87 @@ class O2HitMerger : public FairMQDevice
     return true;
   }
 
-  template <typename T>
-  void backInsert(T const& from, T& to)
-  {
-    std::copy(from.begin(), from.end(), std::back_inserter(to));
-  }
-  // specialization for o2::MCTruthContainer<S>
-  template <typename S>
-  void backInsert(o2::dataformats::MCTruthContainer<S> const& from,
-                  o2::dataformats::MCTruthContainer<S>& to)
-  {
-    to.mergeAtBack(from);
-  }
-
-  // this merges several entries from the TBranch brname from the origin TTree
-  // into a single entry in a target TTree / same branch
-  // (assuming T is typically a vector; merging is simply done by appending)
-  template <typename T>
-  void merge(std::string brname, TTree& origin, TTree& target, std::map<int, std::vector<int>> const& entrygroups)
+  // writes the completed events following the last written one, such that the
+  // events are stored in the order of their eventID
+  void writeCompletedEvents()
   {
-    auto originbr = origin.GetBranch(brname.c_str());
-    auto targetdata = new T;
-    T* incomingdata = nullptr;
-    originbr->SetAddress(&incomingdata);
-    for (auto& event_entries_pair : entrygroups) {
-      const auto& entries = event_entries_pair.second;
-      auto currentevent = event_entries_pair.first;
-      LOG(DEBUG) << "MERGING EVENT " << currentevent;
-
-      T* filladdress;
-      if (entries.size() == 1) {
-        // this avoids useless copy in case there was no sub-event splitting; we just use the original data
-        originbr->GetEntry(entries[0]);
-        filladdress = incomingdata;
-      } else {
-        filladdress = targetdata;
-        for (auto& e : entries) {
-          originbr->GetEntry(e);
-          backInsert(*incomingdata, *targetdata);
-          delete incomingdata;
-          incomingdata = nullptr;
-        }
-      }
-
-      // fill target for this event
-      auto targetbr = o2::base::getOrMakeBranch(target, brname.c_str(), &filladdress);
-      targetbr->SetAddress(&filladdress);
-      targetbr->Fill();
-      targetbr->ResetAddress();
-      targetdata->clear();
-      if (incomingdata) {
-        delete incomingdata;
-        incomingdata = nullptr;
-      }
+    for (auto iter = mEvents.begin(); iter != mEvents.end() && iter->second.complete && iter->first == mNextEventID;
+         iter = mEvents.erase(iter)) {
+      writeEvent(iter->first, iter->second);
+      mNextEventID++;
     }
-    delete targetdata;
   }
 
-  // This method goes over the final tree containing the hits
-  // and merges entries (of subevents) into entries corresponding to one event.
-  // (Preference would be not to do this at all and to keep references to sub-events in the MC labels instead;
-  //  ... but method is provided in order to have backward compatibility first)
-  // returns false if no merge is necessary; returns true if otherwise
-  bool mergeEntries()
+  // fills one entry of all the branches with the data of an event
+  void writeEvent(uint32_t eventID, EventData& event)
   {
-    if (mEntries == 0 || mNExpectedEvents == 0) {
-      return false;
-    }
-
-    LOG(INFO) << "ENTERING MERGING HITS STAGE";
-    TStopwatch timer;
-    timer.Start();
-    // a) find out which entries to merge together
-    // we produce a vector<vector<int>>
-    auto infobr = mOutTree->GetBranch("SubEventInfo");
-
     auto& confref = o2::conf::SimConfig::Instance();
-    if (!confref.isFilterOutNoHitEvents() && (infobr->GetEntries() == mNExpectedEvents)) {
-      LOG(INFO) << "NO MERGING NECESSARY";
-      return false;
-    }
-
-    std::map<int, std::vector<int>> entrygroups;  // collecting all entries belonging to an event
-    std::map<int, std::vector<int>> trackoffsets; // collecting trackoffsets to be applied to correct
-
-    std::vector<std::unique_ptr<o2::dataformats::MCEventHeader>> eventheaders; // collecting the event headers
-
-    eventheaders.resize(mNExpectedEvents);
-
-    // the MC labels (trackID) for hits
-    o2::data::SubEventInfo* info = nullptr;
-    infobr->SetAddress(&info);
-    for (int i = 0; i < infobr->GetEntries(); ++i) {
-      infobr->GetEntry(i);
-      assert(info->npersistenttracks >= 0);
-      auto event = info->eventID;
-      entrygroups[event].emplace_back(i);
-      trackoffsets[event].emplace_back(info->npersistenttracks);
-      assert(event <= mNExpectedEvents && event >= 1);
-      LOG(INFO) << event << " " << mNExpectedEvents;
-      if (eventheaders[event - 1] == nullptr) {
-        eventheaders[event - 1] = std::unique_ptr<dataformats::MCEventHeader>(
-          new dataformats::MCEventHeader(info->mMCEventHeader));
-      } else {
-        eventheaders[event - 1]->getMCEventStats().add(info->mMCEventHeader.getMCEventStats());
-      }
-    }
-
-    // now see which events can be discarded in any case due to no hits
-    if (confref.isFilterOutNoHitEvents()) {
-      for (int i = 0; i < info->maxEvents; i++) {
-        if (eventheaders[i] && eventheaders[i]->getMCEventStats().getNHits() == 0) {
-          LOG(INFO) << "Taking out event " << i << " due to no hits";
-          entrygroups.erase(i + 1); // +1 since "eventID"
-          trackoffsets.erase(i + 1);
-          eventheaders[i].reset();
+    if (confref.isFilterOutNoHitEvents() && event.header->getMCEventStats().getNHits() == 0) {
+      LOG(INFO) << "Taking out event " << eventID << " due to no hits";
+      for (auto& det : mDetectorInstances) {
+        if (det) {
+          det->discardHits(eventID);
         }
       }
+      return;
     }
-
-    // create the final output
-    auto mergedOutFile = new TFile(mOutFileName.c_str(), "RECREATE");
-    gFile = mergedOutFile;
-    auto mergedOutTree = new TTree("o2sim", "o2sim");
-
-    //    for (auto& e : entrygroups) {
-    //      LOG(INFO) << "EVENT " << e.first << " HAS " << e.second.size() << " ENTRIES ";
-    //      std::stringstream indices;
-    //      indices << "{";
-    //      for (int index : e.second) {
-    //        indices << index << " , ";
-    //      }
-    //      indices << "}";
-    //      LOG(INFO) << "# " << indices.str();
-    //    }
-
-    mergedOutTree->SetEntries(entrygroups.size());
-
-    // put the event headers into the new TTree
-    o2::dataformats::MCEventHeader header;
-    auto headerbr = o2::base::getOrMakeBranch(*mergedOutTree, "MCEventHeader.", &header);
-    for (int i = 0; i < info->maxEvents; i++) {
-      if (eventheaders[i]) {
-        header = *(eventheaders[i]);
-        headerbr->Fill();
+    mHeaderAddress = event.header.get();
+    mTracksAddress = &event.tracks;
+    mTrackRefsAddress = &event.trackRefs;
+    mIndexedTrackRefsAddress = &event.indexedTrackRefs;
+    setBranchAddress("MCEventHeader.", mHeaderAddress);
+    setBranchAddress("MCTrack", mTracksAddress);
+    // TODO: fix track numbers in TrackRefs
+    setBranchAddress("TrackRefs", mTrackRefsAddress);
+    setBranchAddress("IndexedTrackRefs", mIndexedTrackRefsAddress);
+    // the detectors know about the types and number of their hit branches
+    for (auto& det : mDetectorInstances) {
+      if (det) {
+        det->setHitBranchAddresses(*mOutTree, eventID);
       }
     }
-    // attention: We need to make sure that we write everything in the same event order
-    // but iteration over keys of a standard map in C++ is ordered
-
-    // b) merge the general data
-    merge<std::vector<o2::MCTrack>>("MCTrack", *mOutTree, *mergedOutTree, entrygroups);
-    // TODO: fix track numbers in TrackRefs
-    merge<std::vector<o2::TrackReference>>("TrackRefs", *mOutTree, *mergedOutTree, entrygroups);
-    merge<o2::dataformats::MCTruthContainer<o2::TrackReference>>("IndexedTrackRefs",
-                                                                 *mOutTree, *mergedOutTree, entrygroups);
-
-    // c) do the merge procedure for all hits ... delegate this to detector specific functions
-    // since they know about types; number of branches; etc.
-    // this will also fix the trackIDs inside the hits
+    // one fill for all the branches, such that they are serialized and compressed
+    // in parallel when the implicit multi-threading of ROOT is enabled
+    mOutTree->Fill();
     for (auto& det : mDetectorInstances) {
       if (det) {
-        det->mergeHitEntries(*mOutTree, *mergedOutTree, entrygroups, trackoffsets);
+        det->discardHits(eventID);
       }
     }
+  }
 
-    mergedOutTree->Write();
-    mergedOutFile->Close();
-    gFile = mOutFile;
-    LOG(INFO) << "MERGING HITS TOOK " << timer.RealTime();
-    return true;
+  // appends from to to, moving the data if to is empty
+  template <typename T>
+  void backInsert(T& from, T& to)
+  {
+    if (to.empty()) {
+      std::swap(from, to);
+      return;
+    }
+    std::copy(from.begin(), from.end(), std::back_inserter(to));
+  }
+  // specialization for o2::MCTruthContainer<S>
+  template <typename S>
+  void backInsert(o2::dataformats::MCTruthContainer<S>& from,
+                  o2::dataformats::MCTruthContainer<S>& to)
+  {
+    to.mergeAtBack(from);
   }
 
-  std::map<uint32_t, uint32_t> mPartsCheckSum; //! mapping event id -> part checksum used to detect when all info
+  std::map<uint32_t, EventData> mEvents; //! events being received, by eventID
+  uint32_t mNextEventID = 1;             //! eventID of the next event to write
+
+  // addresses of the branches of the event being written
+  o2::dataformats::MCEventHeader* mHeaderAddress = nullptr;                                  //!
+  std::vector<o2::MCTrack>* mTracksAddress = nullptr;                                        //!
+  std::vector<o2::TrackReference>* mTrackRefsAddress = nullptr;                              //!
+  o2::dataformats::MCTruthContainer<o2::TrackReference>* mIndexedTrackRefsAddress = nullptr; //!
 
-  std::string mOutFileName;    //!
-  std::string mTmpOutFileName; //!
+  std::string mOutFileName; //!
 
-  TFile* mOutFile;    //!
-  TFile* mTmpOutFile; //! temporary IO
-  TTree* mOutTree;    //!
+  TFile* mOutFile = nullptr; //!
+  TTree* mOutTree = nullptr; //!
 
-  int mEntries = 0; //! counts the number of entries in the branches
   int mEventChecksum = 0; //! checksum for events
   int mNExpectedEvents = 0; //! number of events that we expect to receive
   TStopwatch mTimer;
@@ -16,6 +16,7 @@
 namespace bpo = boost::program_options;
 void addCustomOptions(bpo::options_description& options)
 {
+  options.add_options()("nthreads", bpo::value<int>()->default_value(1), "Number of threads filling the output branches");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
@@ -26,9 +26,18 @@
 #include <Generators/PrimaryGenerator.h>
 #include <SimConfig/SimConfig.h>
 #include <SimConfig/ConfigurableParam.h>
+#include <SimConfig/SimChunkParams.h>
 #include <CommonUtils/RngHelper.h>
 #include <typeinfo>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <sstream>
 #include <TROOT.h>
 #include <TStopwatch.h>
 
@@ -49,6 +58,11 @@ class O2PrimaryServerDevice : public FairMQDevice
   /// Default destructor
   ~O2PrimaryServerDevice() final
   {
+    {
+      std::lock_guard<std::mutex> lock(mQueueMutex);
+      mStopGenerator = true;
+    }
+    mQueueNotFull.notify_all();
     if (mGeneratorThread.joinable()) {
       mGeneratorThread.join();
     }
@@ -67,7 +81,6 @@ class O2PrimaryServerDevice : public FairMQDevice
       mPrimGen.embedInto(embedinto_filename);
     }
     mPrimGen.Init();
-    generateEvent(); // generate a first event
   }
 
   // function generating one event
@@ -81,6 +94,133 @@ class O2PrimaryServerDevice : public FairMQDevice
     LOG(INFO) << "Event generation took " << timer.CpuTime() << "s";
   }
 
+  // function run by the generator thread: initializes the generator and generates all the events
+  // ahead of the requests, keeping at most mQueueSize of them in the queue
+  void generatorLoop()
+  {
+    initGenerator();
+    for (int event = 0; event < mMaxEvents; ++event) {
+      generateEvent();
+      GeneratedEvent generated{ mStack.getPrimaries(), mEventHeader };
+
+      std::unique_lock<std::mutex> lock(mQueueMutex);
+      mQueueNotFull.wait(lock, [this]() { return mStopGenerator || (int)mEventQueue.size() < mQueueSize; });
+      if (mStopGenerator) {
+        return;
+      }
+      mEventQueue.emplace_back(std::move(generated));
+      LOG(INFO) << "PRIMARY QUEUE DEPTH " << mEventQueue.size() << " AFTER GENERATION";
+      lock.unlock();
+      mQueueNotEmpty.notify_one();
+    }
+  }
+
+  // splits the primaries of the current event into chunks, by estimated cost or by a fixed number of
+  // primaries (see SimChunkParams); as before the chunks are taken from the end of the primaries on,
+  // the first part of an event holds the last primaries
+  void planChunks()
+  {
+    auto& param = o2::conf::SimChunkParams::Instance();
+    auto& prims = mCurrentEvent.primaries;
+    const int nprims = prims.size();
+    std::vector<double> costs(nprims);
+    double total = 0.;
+    for (int i = 0; i < nprims; ++i) {
+      costs[i] = param.costPerPrimary;
+      if (std::abs(prims[i].Eta()) < param.etaMax) {
+        costs[i] += param.costPerGeV * prims[i].Energy();
+      }
+      total += costs[i];
+    }
+
+    mChunks.clear();
+    mChunkCosts.clear();
+    // a full chunk costs as much as mChunkGranularity primaries of average cost
+    const double fullCost = total * std::min(1., mChunkGranularity / std::max(1., double(nprims)));
+    const int minChunkSize = std::max(1, param.minChunkSize);
+    double remaining = total;
+    int end = nprims;
+    while (end > 0) {
+      int start = end;
+      double cost = 0.;
+      if (param.costModel) {
+        double target = fullCost;
+        if (param.tailFactor > 0) {
+          target = std::min(target, remaining / (param.tailFactor * mNWorkers));
+        }
+        while (start > 0 && end - start < mChunkGranularity && (end - start < minChunkSize || cost < target)) {
+          cost += costs[--start];
+        }
+      } else {
+        while (start > 0 && end - start < mChunkGranularity) {
+          cost += costs[--start];
+        }
+      }
+      mChunks.emplace_back(start, end);
+      mChunkCosts.push_back(cost);
+      remaining -= cost;
+      end = start;
+    }
+    // number of parts should be at least 1 (even if empty)
+    if (mChunks.empty()) {
+      mChunks.emplace_back(0, 0);
+      mChunkCosts.push_back(0.);
+    }
+  }
+
+  // the utilization metrics of a worker
+  struct WorkerStats {
+    int chunks = 0;          // finished chunks
+    double busyTime = 0.;    // time spent transporting the finished chunks (s)
+    double cost = 0.;        // estimated cost of the finished chunks
+    double pendingCost = 0.; // estimated cost of the chunk being transported
+    std::chrono::steady_clock::time_point firstRequest;
+  };
+
+  // books the time the worker spent on its last chunk, the utilization is the fraction of the time
+  // since its first request the worker spent transporting; returns the statistics of the worker
+  WorkerStats* updateWorkerStats(std::string const& request)
+  {
+    std::istringstream tokens(request.substr(std::strlen("primrequest")));
+    int worker = -1;
+    double lastChunkTime = 0.;
+    if (!(tokens >> worker >> lastChunkTime)) {
+      return nullptr; // a worker not reporting
+    }
+    auto now = std::chrono::steady_clock::now();
+    auto inserted = mWorkerStats.emplace(worker, WorkerStats{});
+    auto& stats = inserted.first->second;
+    if (inserted.second) {
+      stats.firstRequest = now;
+      return &stats;
+    }
+    stats.chunks++;
+    stats.busyTime += lastChunkTime;
+    stats.cost += stats.pendingCost;
+    stats.pendingCost = 0.;
+    const double elapsed = std::chrono::duration<double>(now - stats.firstRequest).count();
+    LOG(INFO) << "WORKER " << worker << " UTILIZATION " << (elapsed > 0. ? 100. * stats.busyTime / elapsed : 100.) << "% ("
+              << stats.chunks << " chunks, " << stats.busyTime << "s transporting, "
+              << (stats.cost > 0. ? stats.busyTime / stats.cost : 0.) << "s per cost unit)";
+    return &stats;
+  }
+
+  // takes the next event from the queue, waiting for the generator if needed
+  void nextEvent()
+  {
+    TStopwatch timer;
+    timer.Start();
+    std::unique_lock<std::mutex> lock(mQueueMutex);
+    mQueueNotEmpty.wait(lock, [this]() { return !mEventQueue.empty(); });
+    mCurrentEvent = std::move(mEventQueue.front());
+    mEventQueue.pop_front();
+    const auto depth = mEventQueue.size();
+    lock.unlock();
+    mQueueNotFull.notify_one();
+    timer.Stop();
+    LOG(INFO) << "PRIMARY QUEUE DEPTH " << depth << " AFTER SERVING; WAITED " << timer.RealTime() << "s FOR THE GENERATOR";
+  }
+
   void InitTask() final
   {
     LOG(INFO) << "Init Server device ";
@@ -96,8 +236,9 @@ class O2PrimaryServerDevice : public FairMQDevice
     // MC ENGINE
     LOG(INFO) << "ENGINE SET TO " << vm["mcEngine"].as<std::string>();
     // CHUNK SIZE
-    mChunkGranularity = vm["chunkSize"].as<unsigned int>();
+    mChunkGranularity = std::max(1u, vm["chunkSize"].as<unsigned int>());
     LOG(INFO) << "CHUNK SIZE SET TO " << mChunkGranularity;
+    mNWorkers = std::max(1, conf.getNSimWorkers());
 
     // initial initial seed --> we should store this somewhere
     mInitialSeed = vm["seed"].as<int>();
@@ -106,13 +247,17 @@ class O2PrimaryServerDevice : public FairMQDevice
 
     mMaxEvents = conf.getNEvents();
 
+    // number of events generated in advance
+    mQueueSize = std::max(1, vm["genQueueSize"].as<int>());
+    LOG(INFO) << "GENERATOR QUEUE SIZE SET TO " << mQueueSize;
+
     // need to make ROOT thread-safe since we use ROOT services in all places
     ROOT::EnableThreadSafety();
 
-    // lunch initialization of particle generator asynchronously
+    // lunch initialization of particle generator and event generation asynchronously
     // so that we reach the RUNNING state of the server quickly
     // and do not block here
-    mGeneratorThread = std::thread(&O2PrimaryServerDevice::initGenerator, this);
+    mGeneratorThread = std::thread(&O2PrimaryServerDevice::generatorLoop, this);
 
     // init pipe
     auto pipeenv = getenv("ALICE_O2SIMSERVERTODRIVER_PIPE");
@@ -170,10 +315,11 @@ class O2PrimaryServerDevice : public FairMQDevice
       return HandleConfigRequest(request);
     }
 
-    else if (requeststring.compare("primrequest") != 0) {
+    else if (requeststring.compare(0, std::strlen("primrequest"), "primrequest") != 0) {
       LOG(INFO) << "unknown request\n";
       return true;
     }
+    auto workerStats = updateWorkerStats(requeststring);
 
     static int counter = 0;
     if (counter >= mMaxEvents && mNeedNewEvent) {
@@ -183,18 +329,15 @@ class O2PrimaryServerDevice : public FairMQDevice
     LOG(INFO) << "Received request for work ";
     if (mNeedNewEvent) {
       // we need a newly generated event now
-      if (mGeneratorThread.joinable()) {
-        mGeneratorThread.join();
-      }
+      nextEvent();
       mNeedNewEvent = false;
       mPartCounter = 0;
       counter++;
+      planChunks();
     }
 
-    auto& prims = mStack.getPrimaries();
-    auto numberofparts = (int)std::ceil(prims.size() / (1. * mChunkGranularity));
-    // number of parts should be at least 1 (even if empty)
-    numberofparts = std::max(1, numberofparts);
+    auto& prims = mCurrentEvent.primaries;
+    const int numberofparts = mChunks.size();
 
     o2::data::PrimaryChunk m;
     o2::data::SubEventInfo i;
@@ -204,23 +347,16 @@ class O2PrimaryServerDevice : public FairMQDevice
     i.nparts = numberofparts;
     i.seed = counter + mInitialSeed;
     i.index = m.mParticles.size();
-    i.mMCEventHeader = mEventHeader;
+    i.mMCEventHeader = mCurrentEvent.header;
     m.mSubEventInfo = i;
 
-    int endindex = prims.size() - mPartCounter * mChunkGranularity;
-    int startindex = prims.size() - (mPartCounter + 1) * mChunkGranularity;
-    if (startindex < 0) {
-      startindex = 0;
-    }
-    if (endindex < 0) {
-      endindex = 0;
-    }
-
+    const int startindex = mChunks[mPartCounter].first;
+    const int endindex = mChunks[mPartCounter].second;
     for (int index = startindex; index < endindex; ++index) {
       m.mParticles.emplace_back(prims[index]);
     }
 
-    LOG(INFO) << "Sending " << m.mParticles.size() << " particles\n";
+    LOG(INFO) << "Sending " << m.mParticles.size() << " particles of estimated cost " << mChunkCosts[mPartCounter] << "\n";
     LOG(INFO) << "treating ev " << counter << " part " << i.part << " out of " << i.nparts << "\n";
 
     // feedback to driver if new event started
@@ -229,11 +365,12 @@ class O2PrimaryServerDevice : public FairMQDevice
       }
     }
 
+    if (workerStats) {
+      workerStats->pendingCost = mChunkCosts[mPartCounter];
+    }
     mPartCounter++;
     if (mPartCounter == numberofparts) {
       mNeedNewEvent = true;
-      // start generation of a new event
-      mGeneratorThread = std::thread(&O2PrimaryServerDevice::generateEvent, this);
     }
 
     TMessage* tmsg = new TMessage(kMESS_OBJECT);
@@ -253,6 +390,12 @@ class O2PrimaryServerDevice : public FairMQDevice
   }
 
  private:
+  // the primaries and header of a generated event
+  struct GeneratedEvent {
+    std::vector<TParticle> primaries;
+    o2::dataformats::MCEventHeader header;
+  };
+
   std::string mOutChannelName = "";
   o2::eventgen::PrimaryGenerator mPrimGen;
   o2::dataformats::MCEventHeader mEventHeader;
@@ -266,7 +409,22 @@ class O2PrimaryServerDevice : public FairMQDevice
   int mPipeToDriver = -1; // handle for direct piper to driver (to communicate meta info)
 
   std::thread mGeneratorThread; //! a thread used to concurrently init the particle generator
-                                //  or to generate events
+                                //  and to generate events
+
+  GeneratedEvent mCurrentEvent;           // event being distributed
+  std::deque<GeneratedEvent> mEventQueue; // events generated in advance
+  int mQueueSize = 1;                     // maximal number of events in the queue
+  bool mStopGenerator = false;            // request to the generator thread to stop
+  std::mutex mQueueMutex;
+  std::condition_variable mQueueNotEmpty;
+  std::condition_variable mQueueNotFull;
+
+  // the chunks of the current event, as ranges of primaries, and their estimated costs
+  std::vector<std::pair<int, int>> mChunks;
+  std::vector<double> mChunkCosts;
+  int mNWorkers = 1; // number of workers the tail of the events is shared among
+
+  std::map<int, WorkerStats> mWorkerStats; // by the id the workers send with their requests
 };
 
 } // namespace devices
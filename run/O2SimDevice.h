@@ -25,6 +25,8 @@
 #include <TRandom.h>
 #include <SimConfig/SimConfig.h>
 #include <string.h>
+#include <string>
+#include <unistd.h>
 
 namespace o2
 {
@@ -143,7 +145,8 @@ class O2SimDevice : public FairMQDevice
 
   bool Kernel(FairMQChannel& requestchannel, FairMQChannel& dataoutchannel)
   {
-    auto text = new std::string("primrequest");
+    // the request tells the server who asks and how long the previous chunk took, for its utilization metrics
+    auto text = new std::string("primrequest " + std::to_string(getpid()) + " " + std::to_string(mLastChunkTime));
 
     // create message object with a pointer to the data buffer,
     // its size,
@@ -180,6 +183,8 @@ class O2SimDevice : public FairMQDevice
                   << "part " << info.part << "/" << info.nparts;
         gRandom->SetSeed(chunk->mSubEventInfo.seed);
 
+        TStopwatch chunkTimer;
+        chunkTimer.Start();
         auto& conf = o2::conf::SimConfig::Instance();
         if (strcmp(conf.getMCEngine().c_str(), "TGeant4") == 0) {
           mVMC->ProcessEvent();
@@ -188,6 +193,8 @@ class O2SimDevice : public FairMQDevice
           // as some hooks are not called
           mVMC->ProcessRun(1);
         }
+        chunkTimer.Stop();
+        mLastChunkTime = chunkTimer.RealTime();
 
         FairSystemInfo sysinfo;
         LOG(INFO) << "TIME-STAMP " << mTimer.RealTime() << "\t";
@@ -215,6 +222,7 @@ class O2SimDevice : public FairMQDevice
   void PostRun() final { LOG(INFO) << "Shutting down " << FairLogger::endl; }
  private:
   TStopwatch mTimer;                             //!
+  double mLastChunkTime = 0.;                    //! processing time of the last chunk (s)
   o2::steer::O2MCApplication* mVMCApp = nullptr; //!
   TVirtualMC* mVMC = nullptr;                    //!
   std::unique_ptr<FairRunSim> mSimRun;           //!